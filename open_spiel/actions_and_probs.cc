@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/actions_and_probs.h"
+
+#include <iostream>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+template <typename Prob>
+void NormalizePolicy(BasicActionsAndProbsSoA<Prob>* policy) {
+  absl::Span<Prob> probs = policy->mutable_probs();
+  Prob sum = 0;
+  for (Prob prob : probs) sum += prob;
+  for (Prob& prob : probs) prob /= sum;
+}
+
+template <typename Prob>
+std::pair<Action, double> SampleAction(
+    const BasicActionsAndProbsSoA<Prob>& outcomes, absl::BitGenRef rng) {
+  return SampleAction(outcomes, absl::Uniform(rng, 0.0, 1.0));
+}
+
+template <typename Prob>
+std::pair<Action, double> SampleAction(
+    const BasicActionsAndProbsSoA<Prob>& outcomes, double z) {
+  SPIEL_CHECK_GE(z, 0);
+  SPIEL_CHECK_LT(z, 1);
+
+  // First do a check that this is indeed a proper discrete distribution.
+  absl::Span<const Prob> probs = outcomes.probs();
+  double sum = 0;
+  for (Prob prob : probs) {
+    SPIEL_CHECK_GE(prob, 0);
+    SPIEL_CHECK_LE(prob, 1);
+    sum += prob;
+  }
+  SPIEL_CHECK_FLOAT_EQ(sum, 1.0);
+
+  // Now sample an outcome.
+  sum = 0;
+  for (int i = 0; i < probs.size(); ++i) {
+    if (sum <= z && z < (sum + probs[i])) {
+      return {outcomes.action(i), probs[i]};
+    }
+    sum += probs[i];
+  }
+
+  // If we get here, something has gone wrong
+  std::cerr << "Chance sampling failed; outcomes:" << std::endl;
+  for (int i = 0; i < probs.size(); ++i) {
+    std::cerr << outcomes.action(i) << "  " << probs[i] << std::endl;
+  }
+  SpielFatalError(
+      absl::StrCat("Internal error: failed to sample an outcome; z=", z));
+}
+
+template void NormalizePolicy(ActionsAndProbsSoA* policy);
+template void NormalizePolicy(ActionsAndFloatProbsSoA* policy);
+template std::pair<Action, double> SampleAction(
+    const ActionsAndProbsSoA& outcomes, double z);
+template std::pair<Action, double> SampleAction(
+    const ActionsAndFloatProbsSoA& outcomes, double z);
+template std::pair<Action, double> SampleAction(
+    const ActionsAndProbsSoA& outcomes, absl::BitGenRef rng);
+template std::pair<Action, double> SampleAction(
+    const ActionsAndFloatProbsSoA& outcomes, absl::BitGenRef rng);
+
+}  // namespace open_spiel
@@ -0,0 +1,112 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ACTIONS_AND_PROBS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ACTIONS_AND_PROBS_H_
+
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/inlined_vector.h"
+#include "open_spiel/abseil-cpp/absl/random/bit_gen_ref.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+// The probability of taking each possible action in a particular info state.
+using ActionsAndProbs = std::vector<std::pair<Action, double>>;
+
+// The same distribution as ActionsAndProbs, with the actions and the
+// probabilities in two separate arrays, so that loops over the probabilities
+// (normalizing, summing, sampling) run over contiguous values and can be
+// vectorized. Prob is double or float; the float version halves the size of
+// the probabilities. Up to kInlineSize outcomes are stored inline, which
+// covers the chance nodes and policies of most games without allocating.
+//
+// State::ChanceOutcomes, Policy::GetStatePolicy, SampleAction and
+// NormalizePolicy have overloads taking this type. Their defaults convert
+// from ActionsAndProbs, so they are always correct, and the code on hot paths
+// can fill the arrays directly.
+template <typename Prob>
+class BasicActionsAndProbsSoA {
+ public:
+  static constexpr int kInlineSize = 8;
+
+  BasicActionsAndProbsSoA() = default;
+  explicit BasicActionsAndProbsSoA(const ActionsAndProbs& actions_and_probs) {
+    Assign(actions_and_probs);
+  }
+
+  // Replaces the contents by those of actions_and_probs, keeping the storage.
+  void Assign(const ActionsAndProbs& actions_and_probs) {
+    clear();
+    reserve(actions_and_probs.size());
+    for (const auto& [action, prob] : actions_and_probs) {
+      push_back(action, prob);
+    }
+  }
+
+  ActionsAndProbs ToActionsAndProbs() const {
+    ActionsAndProbs actions_and_probs;
+    actions_and_probs.reserve(size());
+    for (int i = 0; i < size(); ++i) {
+      actions_and_probs.push_back({actions_[i], probs_[i]});
+    }
+    return actions_and_probs;
+  }
+
+  int size() const { return actions_.size(); }
+  bool empty() const { return actions_.empty(); }
+  void clear() {
+    actions_.clear();
+    probs_.clear();
+  }
+  void reserve(int n) {
+    actions_.reserve(n);
+    probs_.reserve(n);
+  }
+  void push_back(Action action, Prob prob) {
+    actions_.push_back(action);
+    probs_.push_back(prob);
+  }
+
+  Action action(int i) const { return actions_[i]; }
+  Prob prob(int i) const { return probs_[i]; }
+  absl::Span<const Action> actions() const { return actions_; }
+  absl::Span<const Prob> probs() const { return probs_; }
+  absl::Span<Prob> mutable_probs() { return absl::MakeSpan(probs_); }
+
+ private:
+  absl::InlinedVector<Action, kInlineSize> actions_;
+  absl::InlinedVector<Prob, kInlineSize> probs_;
+};
+
+using ActionsAndProbsSoA = BasicActionsAndProbsSoA<double>;
+using ActionsAndFloatProbsSoA = BasicActionsAndProbsSoA<float>;
+
+// As the ActionsAndProbs versions in spiel.h: the same z samples the same
+// outcome from both layouts of a distribution.
+template <typename Prob>
+void NormalizePolicy(BasicActionsAndProbsSoA<Prob>* policy);
+template <typename Prob>
+std::pair<Action, double> SampleAction(
+    const BasicActionsAndProbsSoA<Prob>& outcomes, double z);
+template <typename Prob>
+std::pair<Action, double> SampleAction(
+    const BasicActionsAndProbsSoA<Prob>& outcomes, absl::BitGenRef rng);
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ACTIONS_AND_PROBS_H_
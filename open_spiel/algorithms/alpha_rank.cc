@@ -0,0 +1,445 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/alpha_rank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tensor_game.h"
+#include "open_spiel/utils/thread_pool.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The states multiplied by each task.
+constexpr int64_t kBlockSize = 4096;
+
+// As numpy.isclose, which the Python version uses for its comparisons.
+bool IsClose(double a, double b, double atol = 1e-14) {
+  return std::abs(a - b) <= atol + 1e-5 * std::abs(b);
+}
+
+// The probability (1 - e^-u) / (1 - e^-mu) that a mutant with a fitness
+// advantage of u / alpha takes over a population of m, computed without
+// overflowing for large |u|.
+double Fixation(double u, int m) {
+  if (std::abs(u) <= 1e-14) return 1.0 / m;
+  if (u > 0) return std::expm1(-u) / std::expm1(-m * u);
+  return std::exp((m - 1) * u) * std::expm1(u) / std::expm1(m * u);
+}
+
+// Runs fn(begin, end) over blocks of [0, size), on the pool if any.
+void ForBlocks(ThreadPool* pool, int64_t size,
+               const std::function<void(int64_t, int64_t)>& fn) {
+  if (pool == nullptr) {
+    fn(0, size);
+    return;
+  }
+  const int num_blocks = (size + kBlockSize - 1) / kBlockSize;
+  pool->ParallelFor(0, num_blocks, [&](int block) {
+    const int64_t begin = block * kBlockSize;
+    fn(begin, std::min(begin + kBlockSize, size));
+  });
+}
+
+double Dot(const std::vector<double>& a, const std::vector<double>& b) {
+  return std::inner_product(a.begin(), a.end(), b.begin(), 0.);
+}
+
+double Residual(const AlphaRankChain& chain, const std::vector<double>& pi) {
+  std::vector<double> next(pi.size());
+  chain.Multiply(pi, absl::MakeSpan(next));
+  double residual = 0;
+  for (int64_t i = 0; i < pi.size(); ++i) residual += std::abs(next[i] - pi[i]);
+  return residual;
+}
+
+int PowerIteration(const AlphaRankChain& chain,
+                   const AlphaRankOptions& options, std::vector<double>* pi) {
+  std::vector<double> next(pi->size());
+  int iteration = 0;
+  while (iteration < options.max_iterations) {
+    chain.Multiply(*pi, absl::MakeSpan(next));
+    ++iteration;
+    double change = 0;
+    for (int64_t i = 0; i < pi->size(); ++i) {
+      change += std::abs(next[i] - (*pi)[i]);
+    }
+    pi->swap(next);
+    if (change < options.tolerance) break;
+  }
+  return iteration;
+}
+
+// Solves (I - C^T + 1 1^T / n) pi = 1 / n, whose solution is the stationary
+// distribution of an irreducible chain C, the last term replacing the
+// redundant equation of the stationarity by the normalization constraint.
+int Gmres(const AlphaRankChain& chain, const AlphaRankOptions& options,
+          std::vector<double>* pi) {
+  const int64_t n = pi->size();
+  const int restart = options.gmres_restart;
+  SPIEL_CHECK_GE(restart, 1);
+  int iteration = 0;
+  auto apply = [&](const std::vector<double>& v, std::vector<double>* out) {
+    chain.Multiply(v, absl::MakeSpan(*out));
+    const double mean = std::accumulate(v.begin(), v.end(), 0.) / n;
+    for (int64_t i = 0; i < n; ++i) (*out)[i] = v[i] - (*out)[i] + mean;
+    ++iteration;
+  };
+  const double b_norm = 1 / std::sqrt(static_cast<double>(n));
+  std::vector<std::vector<double>> basis(restart + 1,
+                                         std::vector<double>(n));
+  std::vector<std::vector<double>> h(restart + 1,
+                                     std::vector<double>(restart));
+  std::vector<double> cs(restart), sn(restart), g(restart + 1);
+  std::vector<double> w(n);
+  while (iteration < options.max_iterations) {
+    apply(*pi, &w);
+    for (int64_t i = 0; i < n; ++i) w[i] = 1.0 / n - w[i];
+    const double beta = std::sqrt(Dot(w, w));
+    if (beta / b_norm < options.tolerance) break;
+    for (int64_t i = 0; i < n; ++i) basis[0][i] = w[i] / beta;
+    std::fill(g.begin(), g.end(), 0);
+    g[0] = beta;
+
+    // Arnoldi, with modified Gram-Schmidt, and the least squares problem
+    // kept triangular by Givens rotations.
+    int k = 0;
+    while (k < restart && iteration < options.max_iterations) {
+      apply(basis[k], &w);
+      for (int i = 0; i <= k; ++i) {
+        h[i][k] = Dot(w, basis[i]);
+        for (int64_t j = 0; j < n; ++j) w[j] -= h[i][k] * basis[i][j];
+      }
+      const double norm = std::sqrt(Dot(w, w));
+      h[k + 1][k] = norm;
+      for (int i = 0; i < k; ++i) {
+        const double hi = cs[i] * h[i][k] + sn[i] * h[i + 1][k];
+        h[i + 1][k] = -sn[i] * h[i][k] + cs[i] * h[i + 1][k];
+        h[i][k] = hi;
+      }
+      const double denominator = std::hypot(h[k][k], h[k + 1][k]);
+      if (denominator == 0) break;
+      cs[k] = h[k][k] / denominator;
+      sn[k] = h[k + 1][k] / denominator;
+      h[k][k] = denominator;
+      h[k + 1][k] = 0;
+      g[k + 1] = -sn[k] * g[k];
+      g[k] *= cs[k];
+      ++k;
+      if (norm == 0 || std::abs(g[k]) / b_norm < options.tolerance) break;
+      for (int64_t j = 0; j < n; ++j) basis[k][j] = w[j] / norm;
+    }
+
+    std::vector<double> y(k);
+    for (int i = k - 1; i >= 0; --i) {
+      y[i] = g[i];
+      for (int j = i + 1; j < k; ++j) y[i] -= h[i][j] * y[j];
+      y[i] /= h[i][i];
+    }
+    for (int i = 0; i < k; ++i) {
+      for (int64_t j = 0; j < n; ++j) (*pi)[j] += y[i] * basis[i][j];
+    }
+    if (k == 0) break;
+  }
+  return iteration;
+}
+
+std::vector<const std::vector<double>*> PlayerUtilities(
+    const tensor_game::TensorGame& game) {
+  std::vector<const std::vector<double>*> utilities;
+  for (Player p = 0; p < game.NumPlayers(); ++p) {
+    utilities.push_back(&game.PlayerUtilities(p));
+  }
+  return utilities;
+}
+
+AlphaRankResult Result(const AlphaRankChain& chain,
+                       const AlphaRankOptions& options) {
+  StationaryDistribution distribution =
+      ComputeStationaryDistribution(chain, options);
+  AlphaRankResult result;
+  result.num_strategies = chain.NumStrategies();
+  result.num_iterations = distribution.num_iterations;
+  result.residual = distribution.residual;
+  for (int num_strategies : result.num_strategies) {
+    result.marginals.emplace_back(num_strategies, 0);
+  }
+  for (int64_t state = 0; state < chain.NumStates(); ++state) {
+    const std::vector<int> profile = chain.Profile(state);
+    for (int p = 0; p < profile.size(); ++p) {
+      result.marginals[p][profile[p]] += distribution.pi[state];
+    }
+  }
+  result.pi = std::move(distribution.pi);
+  return result;
+}
+
+}  // namespace
+
+AlphaRankChain::AlphaRankChain(
+    std::vector<int> num_strategies,
+    std::vector<const std::vector<double>*> utilities,
+    const AlphaRankOptions& options, bool single_population)
+    : num_strategies_(std::move(num_strategies)),
+      strides_(num_strategies_.size()),
+      utilities_(std::move(utilities)),
+      options_(options),
+      single_population_(single_population) {
+  SPIEL_CHECK_GE(options.population_size, 2);
+  SPIEL_CHECK_GE(options.num_threads, 1);
+  int64_t num_states = 1;
+  for (int p = num_strategies_.size() - 1; p >= 0; --p) {
+    SPIEL_CHECK_GE(num_strategies_[p], 1);
+    strides_[p] = num_states;
+    num_states *= num_strategies_[p];
+    num_successors_ += num_strategies_[p] - 1;
+  }
+  if (num_successors_ > 0) eta_ = 1.0 / num_successors_;
+  if (options.num_threads > 1) {
+    pool_ = std::make_unique<ThreadPool>(options.num_threads);
+  }
+
+  if (single_population_) {
+    // The game is constant-sum if all P[r][s] + P[s][r] are the same.
+    const int n = num_strategies_[0];
+    const std::vector<double>& payoffs = *utilities_[0];
+    payoff_sum_ = 2 * payoffs[0];
+    constant_sum_ = true;
+    for (int r = 0; r < n && constant_sum_; ++r) {
+      for (int s = 0; s < n; ++s) {
+        if (!IsClose(payoffs[r * n + s] + payoffs[s * n + r], payoff_sum_)) {
+          constant_sum_ = false;
+          break;
+        }
+      }
+    }
+  }
+
+  incoming_.resize(num_states * num_successors_);
+  stay_.resize(num_states);
+  ForBlocks(pool_.get(), num_states, [&](int64_t begin, int64_t end) {
+    for (int64_t state = begin; state < end; ++state) {
+      double leaving = 0;
+      int index = 0;
+      for (int p = 0; p < num_strategies_.size(); ++p) {
+        for (int i = 0; i < num_strategies_[p] - 1; ++i, ++index) {
+          const int64_t successor = Successor(state, p, i);
+          leaving += Transition(p, state, successor);
+          incoming_[state * num_successors_ + index] =
+              Transition(p, successor, state);
+        }
+      }
+      stay_[state] = 1 - leaving;
+    }
+  });
+  utilities_.clear();
+}
+
+AlphaRankChain::AlphaRankChain(const matrix_game::MatrixGame& game,
+                               const AlphaRankOptions& options)
+    : AlphaRankChain({game.NumRows(), game.NumCols()},
+                     {&game.RowUtilities(), &game.ColUtilities()}, options,
+                     /*single_population=*/false) {}
+
+AlphaRankChain::AlphaRankChain(const tensor_game::TensorGame& game,
+                               const AlphaRankOptions& options)
+    : AlphaRankChain(game.Shape(), PlayerUtilities(game), options,
+                     /*single_population=*/false) {}
+
+AlphaRankChain AlphaRankChain::SinglePopulation(
+    const matrix_game::MatrixGame& game, const AlphaRankOptions& options) {
+  SPIEL_CHECK_EQ(game.NumRows(), game.NumCols());
+  return AlphaRankChain({game.NumRows()}, {&game.RowUtilities()}, options,
+                        /*single_population=*/true);
+}
+
+std::vector<int> AlphaRankChain::Profile(int64_t state) const {
+  SPIEL_CHECK_GE(state, 0);
+  SPIEL_CHECK_LT(state, NumStates());
+  std::vector<int> profile(num_strategies_.size());
+  for (int p = 0; p < profile.size(); ++p) {
+    profile[p] = (state / strides_[p]) % num_strategies_[p];
+  }
+  return profile;
+}
+
+int64_t AlphaRankChain::ProfileIndex(const std::vector<int>& profile) const {
+  SPIEL_CHECK_EQ(profile.size(), num_strategies_.size());
+  int64_t state = 0;
+  for (int p = 0; p < profile.size(); ++p) {
+    SPIEL_CHECK_GE(profile[p], 0);
+    SPIEL_CHECK_LT(profile[p], num_strategies_[p]);
+    state += profile[p] * strides_[p];
+  }
+  return state;
+}
+
+int64_t AlphaRankChain::Successor(int64_t state, int population,
+                                  int index) const {
+  const int strategy = (state / strides_[population]) %
+                       num_strategies_[population];
+  const int mutant = index < strategy ? index : index + 1;
+  return state + (mutant - strategy) * strides_[population];
+}
+
+double AlphaRankChain::TransitionProbability(int64_t from, int64_t to) const {
+  SPIEL_CHECK_GE(from, 0);
+  SPIEL_CHECK_LT(from, NumStates());
+  SPIEL_CHECK_GE(to, 0);
+  SPIEL_CHECK_LT(to, NumStates());
+  if (from == to) return stay_[to];
+  int index = 0;
+  for (int p = 0; p < num_strategies_.size(); ++p) {
+    for (int i = 0; i < num_strategies_[p] - 1; ++i, ++index) {
+      if (Successor(to, p, i) == from) {
+        return incoming_[to * num_successors_ + index];
+      }
+    }
+  }
+  return 0;
+}
+
+void AlphaRankChain::Multiply(absl::Span<const double> row,
+                              absl::Span<double> product) const {
+  SPIEL_CHECK_EQ(row.size(), NumStates());
+  SPIEL_CHECK_EQ(product.size(), NumStates());
+  ForBlocks(pool_.get(), NumStates(), [&](int64_t begin, int64_t end) {
+    for (int64_t state = begin; state < end; ++state) {
+      const double* incoming = &incoming_[state * num_successors_];
+      double sum = row[state] * stay_[state];
+      for (int p = 0; p < num_strategies_.size(); ++p) {
+        // The successors in the order of Successor(), without its divisions.
+        const int64_t stride = strides_[p];
+        const int strategy = (state / stride) % num_strategies_[p];
+        const double* x = &row[state - strategy * stride];
+        for (int t = 0; t < strategy; ++t) sum += x[t * stride] * *incoming++;
+        for (int t = strategy + 1; t < num_strategies_[p]; ++t) {
+          sum += x[t * stride] * *incoming++;
+        }
+      }
+      product[state] = sum;
+    }
+  });
+}
+
+double AlphaRankChain::Transition(int population, int64_t s,
+                                  int64_t r) const {
+  const std::vector<double>& utilities = *utilities_[population];
+  double f_r, f_s;
+  if (single_population_) {
+    // The payoffs of r against s, and of s against r.
+    const int n = num_strategies_[0];
+    f_r = utilities[r * n + s];
+    f_s = utilities[s * n + r];
+  } else {
+    f_r = utilities[r];
+    f_s = utilities[s];
+  }
+  if (options_.use_inf_alpha) {
+    if (IsClose(f_r, f_s)) return eta_ * 0.5;
+    return eta_ * (f_r > f_s ? 1 - options_.inf_alpha_eps
+                             : options_.inf_alpha_eps);
+  }
+  if (single_population_) return eta_ * SinglePopulationFixation(r, s);
+  return eta_ * Fixation(options_.alpha * (f_r - f_s),
+                         options_.population_size);
+}
+
+double AlphaRankChain::SinglePopulationFixation(int r, int s) const {
+  const std::vector<double>& payoffs = *utilities_[0];
+  const int n = num_strategies_[0];
+  const int m = options_.population_size;
+  const double alpha = options_.alpha;
+  if (options_.use_local_selection_model) {
+    return Fixation(alpha * (payoffs[r * n + s] - payoffs[s * n + r]), m);
+  } else if (constant_sum_) {
+    return Fixation(
+        alpha * m / (m - 1) * (payoffs[r * n + s] - payoff_sum_ / 2), m);
+  }
+  // 1 / (1 + sum_l prod_{k <= l} e^{-alpha (f_r(k) - f_s(m - k))}), where
+  // f_x(k) is the fitness of an x among k x's, the others playing the other
+  // strategy. The products are summed in log space.
+  auto fitness = [&](int x, int y, int k) {
+    return (k - 1.0) / (m - 1) * payoffs[x * n + x] +
+           (m - k) / (m - 1.0) * payoffs[x * n + y];
+  };
+  std::vector<double> logs = {0};
+  double log_product = 0;
+  for (int k = 1; k < m; ++k) {
+    log_product -= alpha * (fitness(r, s, k) - fitness(s, r, m - k));
+    logs.push_back(log_product);
+  }
+  const double max_log = *std::max_element(logs.begin(), logs.end());
+  double sum = 0;
+  for (double log : logs) sum += std::exp(log - max_log);
+  return std::exp(-max_log) / sum;
+}
+
+StationaryDistribution ComputeStationaryDistribution(
+    const AlphaRankChain& chain, const AlphaRankOptions& options) {
+  StationaryDistribution distribution;
+  const int64_t n = chain.NumStates();
+  distribution.pi.assign(n, 1.0 / n);
+  if (n == 1) return distribution;
+  switch (options.solver) {
+    case StationaryDistributionSolver::kPowerIteration:
+      distribution.num_iterations =
+          PowerIteration(chain, options, &distribution.pi);
+      break;
+    case StationaryDistributionSolver::kGmres:
+      distribution.num_iterations = Gmres(chain, options, &distribution.pi);
+      break;
+  }
+  // Remove the rounding errors of the solvers.
+  double sum = 0;
+  for (double& p : distribution.pi) {
+    p = std::max(p, 0.0);
+    sum += p;
+  }
+  SPIEL_CHECK_GT(sum, 0);
+  for (double& p : distribution.pi) p /= sum;
+  distribution.residual = Residual(chain, distribution.pi);
+  return distribution;
+}
+
+AlphaRankResult AlphaRank(const matrix_game::MatrixGame& game,
+                          const AlphaRankOptions& options) {
+  return Result(AlphaRankChain(game, options), options);
+}
+
+AlphaRankResult AlphaRank(const tensor_game::TensorGame& game,
+                          const AlphaRankOptions& options) {
+  return Result(AlphaRankChain(game, options), options);
+}
+
+AlphaRankResult SinglePopulationAlphaRank(const matrix_game::MatrixGame& game,
+                                          const AlphaRankOptions& options) {
+  return Result(AlphaRankChain::SinglePopulation(game, options), options);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,193 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_RANK_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_RANK_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/tensor_game.h"
+#include "open_spiel/utils/thread_pool.h"
+
+// Alpha-rank (Omidshafiei et al., "alpha-Rank: Multi-Agent Evaluation by
+// Evolution", 2019, https://arxiv.org/abs/1903.01373), as in
+// python/egt/alpharank.py, for games with many strategies.
+//
+// The strategies are ranked by the stationary distribution of a Markov chain
+// over the monomorphic profiles, where each population plays a single
+// strategy: from a profile, one population chosen uniformly tries a mutant
+// strategy chosen uniformly, which takes over with its fixation probability.
+// With several populations, one per player of a MatrixGame or TensorGame,
+// the states are the joint actions, indexed in row-major order (the last
+// player fastest). With a single population, playing a symmetric
+// two-player game against itself, they are the strategies.
+//
+// Since each state only leads to the profiles differing in the strategy of
+// one population, the chain is kept sparse, and its stationary distribution
+// is found by iterative methods which only multiply vectors by it, rather
+// than by the dense eigendecomposition of the Python version.
+
+namespace open_spiel {
+namespace algorithms {
+
+enum class StationaryDistributionSolver {
+  // Repeated multiplication by the chain, from the uniform distribution.
+  kPowerIteration,
+  // Restarted GMRES on the stationarity equations with the normalization
+  // constraint added, which converges much faster when the chain mixes
+  // slowly, as for large alphas.
+  kGmres,
+};
+
+struct AlphaRankOptions {
+  // The selection intensity, and the size of each population.
+  double alpha = 100;
+  int population_size = 50;
+  // The limit of infinite alpha, where a mutant better than the resident
+  // strategy takes over with probability 1 - inf_alpha_eps, an equal one with
+  // probability 1/2, and a worse one with probability inf_alpha_eps.
+  bool use_inf_alpha = false;
+  double inf_alpha_eps = 0.01;
+  // With a single population, whether the fitness of a strategy is its payoff
+  // against the other strategy only, rather than against the rest of the
+  // population.
+  bool use_local_selection_model = true;
+
+  StationaryDistributionSolver solver = StationaryDistributionSolver::kGmres;
+  // The solvers stop once the L1 norm of the change of an iteration of the
+  // power method, or the relative residual of GMRES, is below the tolerance,
+  // or after max_iterations multiplications by the chain.
+  double tolerance = 1e-12;
+  int max_iterations = 100000;
+  // The dimension of the Krylov subspaces of GMRES, which keeps
+  // gmres_restart + 1 vectors over the states.
+  int gmres_restart = 30;
+
+  // The chain is built, and multiplied by, on num_threads threads. The
+  // results do not depend on it.
+  int num_threads = 1;
+};
+
+// The Markov chain of alpha-rank. Each state has the same number of
+// successors, one per other strategy of each population, so only the
+// probabilities of the transitions are stored: those into each state from its
+// successors, and that of staying in it.
+class AlphaRankChain {
+ public:
+  // The chains of the populations of a game, one per player. The game is
+  // only read while the chain is built.
+  AlphaRankChain(const matrix_game::MatrixGame& game,
+                 const AlphaRankOptions& options);
+  AlphaRankChain(const tensor_game::TensorGame& game,
+                 const AlphaRankOptions& options);
+
+  // The chain of a single population, whose payoffs are those of the row
+  // player of a symmetric game.
+  static AlphaRankChain SinglePopulation(const matrix_game::MatrixGame& game,
+                                         const AlphaRankOptions& options);
+
+  int64_t NumStates() const { return stay_.size(); }
+  // The number of strategies of each population.
+  const std::vector<int>& NumStrategies() const { return num_strategies_; }
+  std::vector<int> Profile(int64_t state) const;
+  int64_t ProfileIndex(const std::vector<int>& profile) const;
+
+  // The probability of a transition, 0 unless the states differ in the
+  // strategy of at most one population.
+  double TransitionProbability(int64_t from, int64_t to) const;
+
+  // Sets `product` to the product of the row vector `row` by the transition
+  // matrix, on the threads of the options the chain was built with.
+  void Multiply(absl::Span<const double> row,
+                absl::Span<double> product) const;
+
+ private:
+  AlphaRankChain(std::vector<int> num_strategies,
+                 std::vector<const std::vector<double>*> utilities,
+                 const AlphaRankOptions& options, bool single_population);
+
+  // The successor of `state` changing the strategy of `population` to the
+  // `index`-th of its other strategies.
+  int64_t Successor(int64_t state, int population, int index) const;
+  // The probability of the transition from s to r, which differ in the
+  // strategy of `population`.
+  double Transition(int population, int64_t s, int64_t r) const;
+  // The probability that a mutant playing r takes over a population playing
+  // s, with a single population.
+  double SinglePopulationFixation(int r, int s) const;
+
+  std::vector<int> num_strategies_;
+  std::vector<int64_t> strides_;
+  // The row-major utilities of each population, or with a single population
+  // the payoff matrix of the row player, while the chain is built.
+  std::vector<const std::vector<double>*> utilities_;
+  AlphaRankOptions options_;
+  bool single_population_;
+  int num_successors_ = 0;
+  // The probability of choosing a given mutant.
+  double eta_ = 0;
+  // For a single population playing a constant-sum game, the sum of the
+  // payoffs, which gives the fixation probabilities in closed form.
+  bool constant_sum_ = false;
+  double payoff_sum_ = 0;
+
+  // [NumStates(), num_successors_]: the probabilities of the transitions
+  // into each state from its successors, in the order of Successor().
+  std::vector<double> incoming_;
+  std::vector<double> stay_;
+  std::unique_ptr<ThreadPool> pool_;
+};
+
+struct StationaryDistribution {
+  std::vector<double> pi;
+  int num_iterations = 0;
+  // The L1 norm of pi C - pi.
+  double residual = 0;
+};
+
+// Finds the stationary distribution of the chain, which is unique as long
+// as the chain is irreducible, as it is for finite alphas and positive
+// inf_alpha_eps.
+StationaryDistribution ComputeStationaryDistribution(
+    const AlphaRankChain& chain, const AlphaRankOptions& options);
+
+struct AlphaRankResult {
+  std::vector<int> num_strategies;
+  // The stationary distribution over the states of the chain.
+  std::vector<double> pi;
+  // The mass of each strategy of each population.
+  std::vector<std::vector<double>> marginals;
+  int num_iterations = 0;
+  double residual = 0;
+};
+
+// Ranks the joint actions of a game, with a population per player.
+AlphaRankResult AlphaRank(const matrix_game::MatrixGame& game,
+                          const AlphaRankOptions& options = {});
+AlphaRankResult AlphaRank(const tensor_game::TensorGame& game,
+                          const AlphaRankOptions& options = {});
+// Ranks the strategies of a symmetric two-player game, with a single
+// population whose payoffs are those of the row player.
+AlphaRankResult SinglePopulationAlphaRank(const matrix_game::MatrixGame& game,
+                                          const AlphaRankOptions& options = {});
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_RANK_H_
@@ -0,0 +1,267 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/alpha_rank.h"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tensor_game.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+std::shared_ptr<const tensor_game::TensorGame> RandomTensorGame(
+    const std::vector<int>& shape, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  int num_profiles = 1;
+  for (int n : shape) num_profiles *= n;
+  std::vector<std::vector<double>> utilities(shape.size());
+  for (auto& player_utilities : utilities) {
+    for (int i = 0; i < num_profiles; ++i) {
+      player_utilities.push_back(dist(rng));
+    }
+  }
+  return tensor_game::CreateTensorGame(utilities, shape);
+}
+
+// The fixation probabilities as computed in python/egt/alpharank.py.
+double NaiveFixation(double u, int m) {
+  if (std::abs(u) < 1e-14) return 1.0 / m;
+  return (1 - std::exp(-u)) / (1 - std::exp(-m * u));
+}
+
+void MultiPopulationTransitionsTest() {
+  std::shared_ptr<const tensor_game::TensorGame> game =
+      RandomTensorGame({3, 2, 4}, 1);
+  AlphaRankOptions options;
+  options.alpha = 2;
+  options.population_size = 10;
+  AlphaRankChain chain(*game, options);
+  SPIEL_CHECK_EQ(chain.NumStates(), 24);
+  const double eta = 1.0 / (2 + 1 + 3);
+  for (int64_t s = 0; s < chain.NumStates(); ++s) {
+    SPIEL_CHECK_EQ(chain.ProfileIndex(chain.Profile(s)), s);
+    double total = 0;
+    for (int64_t r = 0; r < chain.NumStates(); ++r) {
+      const std::vector<int> from = chain.Profile(s);
+      const std::vector<int> to = chain.Profile(r);
+      std::vector<int> changed;
+      for (int p = 0; p < 3; ++p) {
+        if (from[p] != to[p]) changed.push_back(p);
+      }
+      const double probability = chain.TransitionProbability(s, r);
+      total += probability;
+      if (changed.size() == 1) {
+        const Player p = changed[0];
+        std::vector<Action> from_actions(from.begin(), from.end());
+        std::vector<Action> to_actions(to.begin(), to.end());
+        const double u =
+            options.alpha * (game->PlayerUtility(p, to_actions) -
+                             game->PlayerUtility(p, from_actions));
+        SPIEL_CHECK_FLOAT_NEAR(probability,
+                               eta * NaiveFixation(u, options.population_size),
+                               1e-12);
+      } else if (changed.size() > 1) {
+        SPIEL_CHECK_EQ(probability, 0);
+      }
+    }
+    SPIEL_CHECK_FLOAT_NEAR(total, 1, 1e-12);
+  }
+}
+
+void SinglePopulationTransitionsTest() {
+  // A general-sum symmetric game, where the fitnesses against the whole
+  // population are products over its compositions.
+  const std::vector<std::vector<double>> payoffs = {
+      {1, 2, 0.5}, {0, 3, 1}, {2, 0.5, 1}};
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      matrix_game::CreateMatrixGame(payoffs, payoffs);
+  AlphaRankOptions options;
+  options.alpha = 0.5;
+  options.population_size = 10;
+  options.use_local_selection_model = false;
+  AlphaRankChain chain = AlphaRankChain::SinglePopulation(*game, options);
+  const int m = options.population_size;
+  for (int s = 0; s < 3; ++s) {
+    for (int r = 0; r < 3; ++r) {
+      if (r == s) continue;
+      auto fitness = [&](int x, int y, int k) {
+        return (k - 1.0) / (m - 1) * payoffs[x][x] +
+               (m - k) / (m - 1.0) * payoffs[x][y];
+      };
+      double sum = 0;
+      for (int l = 1; l < m; ++l) {
+        double product = 1;
+        for (int k = 1; k <= l; ++k) {
+          product *= std::exp(-options.alpha *
+                              (fitness(r, s, k) - fitness(s, r, m - k)));
+        }
+        sum += product;
+      }
+      SPIEL_CHECK_FLOAT_NEAR(chain.TransitionProbability(s, r),
+                             0.5 / (1 + sum), 1e-12);
+    }
+  }
+}
+
+void StationaryDistributionTest() {
+  // The payoffs of Han et al., 2013, and the distribution found by
+  // python/egt/alpharank_test.py.
+  const double r = 1, t = 2, p = 0, s = -1, delta = 4, eps = 0.25;
+  const std::vector<std::vector<double>> payoffs = {
+      {r - eps / 2, r - eps, 0, s + delta - eps, r - eps},
+      {r, r, s, s, s},
+      {0, t, p, p, p},
+      {t - delta, t, p, p, p},
+      {r, t, p, p, p}};
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      matrix_game::CreateMatrixGame(payoffs, payoffs);
+  AlphaRankOptions options;
+  options.alpha = 0.1;
+  options.population_size = 20;
+  options.use_local_selection_model = false;
+  const std::vector<double> expected_pi = {0.40966787, 0.07959841, 0.20506998,
+                                           0.08505983, 0.2206039};
+  for (auto solver : {StationaryDistributionSolver::kGmres,
+                      StationaryDistributionSolver::kPowerIteration}) {
+    options.solver = solver;
+    AlphaRankResult result = SinglePopulationAlphaRank(*game, options);
+    for (int i = 0; i < expected_pi.size(); ++i) {
+      SPIEL_CHECK_FLOAT_NEAR(result.pi[i], expected_pi[i], 1e-6);
+    }
+    SPIEL_CHECK_EQ(result.marginals[0], result.pi);
+  }
+}
+
+void RockPaperScissorsTest() {
+  // The strategies beat each other in a cycle, with the same stakes, so
+  // they are ranked equally.
+  const std::vector<std::vector<double>> payoffs = {
+      {0, -1, 1}, {1, 0, -1}, {-1, 1, 0}};
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      matrix_game::CreateMatrixGame(payoffs, payoffs);
+  for (bool local : {true, false}) {
+    AlphaRankOptions options;
+    options.use_local_selection_model = local;
+    AlphaRankResult result = SinglePopulationAlphaRank(*game, options);
+    SPIEL_CHECK_EQ(result.pi.size(), 3);
+    for (double p : result.pi) SPIEL_CHECK_FLOAT_NEAR(p, 1.0 / 3, 1e-9);
+  }
+}
+
+void PrisonersDilemmaTest() {
+  // Defecting dominates, so (defect, defect) is the sink of the chain.
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      matrix_game::CreateMatrixGame({{3, 0}, {5, 1}}, {{3, 5}, {0, 1}});
+  for (bool inf_alpha : {false, true}) {
+    AlphaRankOptions options;
+    options.use_inf_alpha = inf_alpha;
+    options.inf_alpha_eps = 1e-4;
+    AlphaRankResult result = AlphaRank(*game, options);
+    SPIEL_CHECK_EQ(result.pi.size(), 4);
+    SPIEL_CHECK_GT(result.pi[3], 0.999);
+    SPIEL_CHECK_GT(result.marginals[0][1], 0.999);
+    SPIEL_CHECK_GT(result.marginals[1][1], 0.999);
+    SPIEL_CHECK_LT(result.residual, 1e-10);
+  }
+}
+
+void TwoStrategiesTest() {
+  // A two-state chain spends time in each state in proportion to the
+  // probability of entering it.
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      matrix_game::CreateMatrixGame({{1, 0.2}, {0.7, 0.4}},
+                                    {{1, 0.7}, {0.2, 0.4}});
+  AlphaRankOptions options;
+  options.alpha = 3;
+  AlphaRankChain chain = AlphaRankChain::SinglePopulation(*game, options);
+  const double in = chain.TransitionProbability(1, 0);
+  const double out = chain.TransitionProbability(0, 1);
+  AlphaRankResult result = SinglePopulationAlphaRank(*game, options);
+  SPIEL_CHECK_FLOAT_NEAR(result.pi[0], in / (in + out), 1e-10);
+  SPIEL_CHECK_FLOAT_NEAR(result.pi[1], out / (in + out), 1e-10);
+}
+
+void SolversAgreeTest() {
+  std::shared_ptr<const tensor_game::TensorGame> game =
+      RandomTensorGame({6, 5, 4}, 2);
+  AlphaRankOptions options;
+  options.alpha = 1;
+  options.population_size = 20;
+  options.tolerance = 1e-13;
+  AlphaRankResult gmres = AlphaRank(*game, options);
+  options.solver = StationaryDistributionSolver::kPowerIteration;
+  AlphaRankResult power = AlphaRank(*game, options);
+  SPIEL_CHECK_LT(gmres.residual, 1e-10);
+  SPIEL_CHECK_LT(power.residual, 1e-10);
+  SPIEL_CHECK_LT(gmres.num_iterations, power.num_iterations);
+  double total = 0;
+  for (int64_t i = 0; i < gmres.pi.size(); ++i) {
+    SPIEL_CHECK_FLOAT_NEAR(gmres.pi[i], power.pi[i], 1e-9);
+    total += gmres.pi[i];
+  }
+  SPIEL_CHECK_FLOAT_NEAR(total, 1, 1e-12);
+}
+
+void MatrixAndTensorGamesAgreeTest() {
+  // A two-player tensor game is a matrix game, whichever holds it.
+  std::shared_ptr<const tensor_game::TensorGame> tensor_game =
+      RandomTensorGame({4, 3}, 3);
+  std::shared_ptr<const matrix_game::MatrixGame> matrix_game =
+      matrix_game::CreateMatrixGame(
+          "random", "Random", {"a", "b", "c", "d"}, {"a", "b", "c"},
+          tensor_game->PlayerUtilities(0), tensor_game->PlayerUtilities(1));
+  AlphaRankResult tensor_result = AlphaRank(*tensor_game);
+  AlphaRankResult matrix_result = AlphaRank(*matrix_game);
+  SPIEL_CHECK_EQ(tensor_result.pi, matrix_result.pi);
+  SPIEL_CHECK_EQ(tensor_result.marginals, matrix_result.marginals);
+}
+
+void ThreadsTest() {
+  // Each state is computed by a single thread, so the results are the same.
+  std::shared_ptr<const tensor_game::TensorGame> game =
+      RandomTensorGame({20, 20, 15}, 4);
+  AlphaRankOptions options;
+  AlphaRankResult result = AlphaRank(*game, options);
+  options.num_threads = 4;
+  AlphaRankResult threaded_result = AlphaRank(*game, options);
+  SPIEL_CHECK_EQ(result.pi, threaded_result.pi);
+  SPIEL_CHECK_EQ(result.num_iterations, threaded_result.num_iterations);
+  SPIEL_CHECK_LT(result.residual, 1e-10);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::MultiPopulationTransitionsTest();
+  open_spiel::algorithms::SinglePopulationTransitionsTest();
+  open_spiel::algorithms::StationaryDistributionTest();
+  open_spiel::algorithms::RockPaperScissorsTest();
+  open_spiel::algorithms::PrisonersDilemmaTest();
+  open_spiel::algorithms::TwoStrategiesTest();
+  open_spiel::algorithms::SolversAgreeTest();
+  open_spiel::algorithms::MatrixAndTensorGamesAgreeTest();
+  open_spiel::algorithms::ThreadsTest();
+}
@@ -0,0 +1,347 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/alpha_zero.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/circular_buffer.h"
+#include "open_spiel/utils/data_logger.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/json.h"
+#include "open_spiel/utils/lru_cache.h"
+#include "open_spiel/utils/thread.h"
+#include "open_spiel/utils/threaded_queue.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+using Trajectory = std::vector<AlphaZeroExample>;
+
+void ApplyChanceOutcome(State* state, std::mt19937* rng) {
+  const double z = std::uniform_real_distribution<double>(0, 1)(*rng);
+  state->ApplyAction(SampleAction(state->ChanceOutcomes(), z).first);
+}
+
+// Plays a game of self-play, or returns nothing if stopped before its end.
+std::optional<Trajectory> PlayGame(const Game& game,
+                                   const AlphaZeroConfig& config, MCTSBot* bot,
+                                   std::mt19937* rng, const StopToken& stop) {
+  const int input_size = InferenceInputSize(game);
+  const int num_actions = game.NumDistinctActions();
+  std::unique_ptr<State> state = game.NewInitialState();
+  Trajectory trajectory;
+  std::vector<Player> players;
+  while (!state->IsTerminal()) {
+    if (stop.StopRequested()) return std::nullopt;
+    if (state->IsChanceNode()) {
+      ApplyChanceOutcome(state.get(), rng);
+      continue;
+    }
+    std::unique_ptr<SearchNode> root = bot->MCTSearch(*state);
+    AlphaZeroExample& example = trajectory.emplace_back();
+    example.input.resize(input_size);
+    example.legal_mask.resize(num_actions);
+    FillInferenceRow(*state, absl::MakeSpan(example.input),
+                     absl::MakeSpan(example.legal_mask));
+    example.policy.assign(num_actions, 0);
+    double total_visits = 0;
+    for (const SearchNode& child : root->children) {
+      total_visits += child.explore_count;
+    }
+    std::vector<double> weights;
+    weights.reserve(root->children.size());
+    for (const SearchNode& child : root->children) {
+      example.policy[child.action] = child.explore_count / total_visits;
+      weights.push_back(std::pow(child.explore_count, 1 / config.temperature));
+    }
+    Action action;
+    if (players.size() < config.temperature_drop) {
+      std::discrete_distribution<int> dist(weights.begin(), weights.end());
+      action = root->children[dist(*rng)].action;
+    } else {
+      action = root->BestChild().action;
+    }
+    players.push_back(state->CurrentPlayer());
+    state->ApplyAction(action);
+  }
+  const std::vector<double> returns = state->Returns();
+  for (int i = 0; i < trajectory.size(); ++i) {
+    trajectory[i].value = returns[players[i]];
+  }
+  return trajectory;
+}
+
+// The recent returns of the evaluators at each level.
+class EvalResults {
+ public:
+  EvalResults(int num_levels, int window) {
+    results_.reserve(num_levels);
+    for (int i = 0; i < num_levels; ++i) results_.emplace_back(window);
+  }
+
+  // The levels are played in turn.
+  int NextLevel() {
+    absl::MutexLock lock(&mu_);
+    return next_level_++ % results_.size();
+  }
+
+  void Add(int level, double value) {
+    absl::MutexLock lock(&mu_);
+    results_[level].Add(value);
+  }
+
+  // The average return and the number of games of each level.
+  json::Object Summary() {
+    absl::MutexLock lock(&mu_);
+    json::Array averages;
+    json::Array num_games;
+    for (const CircularBuffer<double>& results : results_) {
+      double sum = 0;
+      for (double value : results.Data()) sum += value;
+      averages.push_back(results.Empty() ? 0 : sum / results.Size());
+      num_games.push_back(results.Size());
+    }
+    return {{"results", averages}, {"games", num_games}};
+  }
+
+ private:
+  absl::Mutex mu_;
+  int next_level_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<CircularBuffer<double>> results_ ABSL_GUARDED_BY(mu_);
+};
+
+// Plays the model against MCTSBots with random rollouts, alternating seats.
+void EvaluatorLoop(const Game& game, const AlphaZeroConfig& config, int num,
+                   std::shared_ptr<const InferenceModel> model,
+                   EvalResults* results, const StopToken& stop) {
+  std::mt19937 rng(config.seed + config.actors + num);
+  InferenceEvaluator model_evaluator(std::move(model));
+  RandomRolloutEvaluator rollout_evaluator(1, config.seed + num);
+  for (int game_num = 0; !stop.StopRequested(); ++game_num) {
+    const int level = results->NextLevel();
+    const Player model_player = game_num % 2;
+    const int rollout_simulations =
+        config.evaluation_simulations * std::pow(10, level / 2.0);
+    std::vector<std::unique_ptr<Bot>> bots(2);
+    bots[model_player] = std::make_unique<MCTSBot>(
+        game, &model_evaluator, config.uct_c, config.max_simulations,
+        config.max_memory_mb, /*solve=*/true, rng(), /*verbose=*/false,
+        ChildSelectionPolicy::PUCT);
+    bots[1 - model_player] = std::make_unique<MCTSBot>(
+        game, &rollout_evaluator, config.uct_c, rollout_simulations,
+        config.max_memory_mb, /*solve=*/true, rng(), /*verbose=*/false,
+        ChildSelectionPolicy::UCT);
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal() && !stop.StopRequested()) {
+      if (state->IsChanceNode()) {
+        ApplyChanceOutcome(state.get(), &rng);
+      } else {
+        state->ApplyAction(bots[state->CurrentPlayer()]->Step(*state));
+      }
+    }
+    if (state->IsTerminal()) {
+      results->Add(level, state->PlayerReturn(model_player));
+    }
+  }
+}
+
+}  // namespace
+
+void AlphaZeroActor(const Game& game, const AlphaZeroConfig& config, int num,
+                    std::shared_ptr<const InferenceModel> model,
+                    ThreadedQueue<Trajectory>* trajectories,
+                    const StopToken& stop) {
+  std::mt19937 rng(config.seed + num);
+  InferenceEvaluator evaluator(std::move(model));
+  MCTSBot bot(game, &evaluator, config.uct_c, config.max_simulations,
+              config.max_memory_mb, /*solve=*/false, config.seed + num,
+              /*verbose=*/false, ChildSelectionPolicy::PUCT,
+              config.policy_alpha, config.policy_epsilon, /*num_threads=*/1,
+              /*virtual_loss=*/1, config.mcts_batch_size);
+  while (!stop.StopRequested()) {
+    std::optional<Trajectory> trajectory =
+        PlayGame(game, config, &bot, &rng, stop);
+    if (!trajectory) return;
+    while (!stop.StopRequested() &&
+           !trajectories->Push(*trajectory, absl::Seconds(1))) {
+    }
+  }
+}
+
+int AlphaZero(const AlphaZeroConfig& config, TrainableModel* model,
+              StopToken* stop) {
+  std::shared_ptr<const Game> game = LoadGame(config.game);
+  const GameType& type = game->GetType();
+  if (game->NumPlayers() != 2 ||
+      type.utility != GameType::Utility::kZeroSum ||
+      type.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "AlphaZero requires sequential 2-player zero-sum games.");
+  }
+  SPIEL_CHECK_EQ(model->InputSize(), InferenceInputSize(*game));
+  SPIEL_CHECK_EQ(model->NumActions(), game->NumDistinctActions());
+  SPIEL_CHECK_GT(config.train_batch_size, 0);
+  SPIEL_CHECK_GT(config.replay_buffer_reuse, 0);
+  SPIEL_CHECK_GT(config.checkpoint_freq, 0);
+  if (!file::Exists(config.path) && !file::Mkdirs(config.path)) {
+    SpielFatalError(absl::StrCat("Failed to create the directory ",
+                                 config.path));
+  }
+
+  auto inference = std::make_shared<BatchingInferenceModel>(
+      model->Snapshot(), config.inference_batch_size,
+      config.inference_threads,
+      absl::Milliseconds(config.inference_batch_timeout_ms),
+      config.inference_cache);
+  ThreadedQueue<Trajectory> trajectories(std::max(config.actors, 1) * 8);
+  EvalResults eval_results(config.eval_levels, config.evaluation_window);
+
+  // Stops the threads, whether or not the caller stopped the training.
+  StopToken threads_stop;
+  std::vector<Thread> threads;
+  for (int i = 0; i < config.actors; ++i) {
+    threads.emplace_back([&, i]() {
+      AlphaZeroActor(*game, config, i, inference, &trajectories,
+                     threads_stop);
+    });
+  }
+  for (int i = 0; i < config.evaluators; ++i) {
+    threads.emplace_back([&, i]() {
+      EvaluatorLoop(*game, config, i, inference, &eval_results, threads_stop);
+    });
+  }
+
+  DataLoggerJsonLines logger(config.path, "learner", /*flush=*/true);
+  CircularBuffer<AlphaZeroExample> replay_buffer(config.replay_buffer_size);
+  std::mt19937 rng(config.seed);
+  const int learn_rate =
+      std::max(config.replay_buffer_size / config.replay_buffer_reuse, 1);
+  auto stopped = [stop]() { return stop != nullptr && stop->StopRequested(); };
+
+  int step = 0;
+  int64_t total_trajectories = 0;
+  std::string last_checkpoint;
+  int64_t last_batches = 0;
+  int64_t last_rows = 0;
+  while ((config.max_steps == 0 || step < config.max_steps) && !stopped()) {
+    const absl::Time start = absl::Now();
+    int num_states = 0;
+    int num_trajectories = 0;
+    while (num_states < learn_rate && !stopped()) {
+      std::optional<Trajectory> trajectory =
+          trajectories.Pop(absl::Milliseconds(100));
+      if (!trajectory) continue;
+      for (AlphaZeroExample& example : *trajectory) {
+        replay_buffer.Add(example);
+      }
+      num_states += trajectory->size();
+      ++num_trajectories;
+    }
+    if (stopped()) break;
+    ++step;
+    total_trajectories += num_trajectories;
+    const absl::Time collected = absl::Now();
+
+    const int num_batches =
+        config.train_batches_per_step > 0
+            ? config.train_batches_per_step
+            : std::max(replay_buffer.Size() / config.train_batch_size, 1);
+    double total_loss = 0;
+    for (int b = 0; b < num_batches; ++b) {
+      total_loss +=
+          model->Learn(replay_buffer.Sample(&rng, config.train_batch_size));
+    }
+
+    // Only the checkpoints of every checkpoint_freq steps are kept, besides
+    // the last one.
+    const std::string checkpoint =
+        absl::StrCat(config.path, "/checkpoint-", step);
+    model->SaveCheckpoint(checkpoint);
+    if (!last_checkpoint.empty() && (step - 1) % config.checkpoint_freq != 0) {
+      file::Remove(last_checkpoint);
+    }
+    last_checkpoint = checkpoint;
+
+    // The cache statistics are those of the model being replaced.
+    const LRUCacheInfo cache_info = inference->CacheInfo();
+    const int64_t num_inference_batches = inference->NumBatches();
+    const int64_t num_inference_rows = inference->NumRows();
+    if (config.checkpoint_backend.empty()) {
+      inference->SetModel(model->Snapshot());
+    } else {
+      inference->SetModel(
+          LoadInferenceModel(config.checkpoint_backend, *game, checkpoint));
+    }
+    const int64_t step_batches = num_inference_batches - last_batches;
+    const int64_t step_rows = num_inference_rows - last_rows;
+    last_batches = num_inference_batches;
+    last_rows = num_inference_rows;
+
+    const absl::Time end = absl::Now();
+    logger.Write({
+        {"step", step},
+        {"total_states", replay_buffer.TotalAdded()},
+        {"total_trajectories", total_trajectories},
+        {"states", num_states},
+        {"game_length",
+         num_trajectories == 0
+             ? 0.0
+             : static_cast<double>(num_states) / num_trajectories},
+        {"loss", total_loss / num_batches},
+        {"collect_seconds", absl::ToDoubleSeconds(collected - start)},
+        {"learn_seconds", absl::ToDoubleSeconds(end - collected)},
+        {"cache",
+         json::Object({{"size", cache_info.size},
+                       {"max_size", cache_info.max_size},
+                       {"usage", cache_info.Usage()},
+                       {"requests", cache_info.Total()},
+                       {"hit_rate", cache_info.HitRate()}})},
+        {"inference",
+         json::Object({{"batches", step_batches},
+                       {"batch_size",
+                        step_batches == 0
+                            ? 0.0
+                            : static_cast<double>(step_rows) / step_batches}})},
+        {"eval", eval_results.Summary()},
+    });
+  }
+
+  threads_stop.Stop();
+  trajectories.BlockNewValues();
+  trajectories.Clear();
+  for (Thread& thread : threads) thread.join();
+  return step;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
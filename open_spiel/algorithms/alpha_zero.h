@@ -0,0 +1,153 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_ZERO_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_ZERO_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/utils/thread.h"
+#include "open_spiel/utils/threaded_queue.h"
+
+// An AlphaZero training pipeline in C++, for 2-player zero-sum games, so that
+// a single machine keeps its accelerator busy instead of being bound by the
+// Python interpreter as python/algorithms/alpha_zero/alpha_zero.py is.
+//
+// - Actor threads play games against themselves with MCTSBot, and send the
+//   trajectories (the searched states, the visit counts of their roots and
+//   the final returns) to the learner through a ThreadedQueue.
+// - Evaluator threads play the latest model against MCTSBots with random
+//   rollouts of increasing strength, to follow its progress.
+// - The MCTSBots of the actors and evaluators all evaluate their leaves
+//   through a single BatchingInferenceModel, so that their queries are run
+//   in large batches, and cached.
+// - The learner adds the trajectories to a CircularBuffer replay buffer,
+//   trains the model on batches sampled from it, saves a checkpoint, and
+//   swaps the new weights into the BatchingInferenceModel, while the actors
+//   keep playing.
+//
+// The model is supplied by the caller, for whatever framework it is trained
+// with, as a TrainableModel. Statistics are logged with a DataLogger to
+// `<path>/learner.jsonl`.
+//
+// Reference:
+// - Silver et al., A general reinforcement learning algorithm that masters
+//   chess, shogi, and Go through self-play, 2018.
+
+namespace open_spiel {
+namespace algorithms {
+
+// A training example: the inputs of a state as in FillInferenceRow, and the
+// targets of the policy and value heads.
+struct AlphaZeroExample {
+  std::vector<float> input;
+  std::vector<float> legal_mask;
+  std::vector<float> policy;  // The MCTS visit distribution of the state.
+  float value;  // The final return of the player to move.
+};
+
+// A model that can be trained by the learner. Learn is only called by the
+// learner thread, and the model itself is not used for inference meanwhile:
+// the actors use Snapshots of it.
+class TrainableModel : public InferenceModel {
+ public:
+  // Takes a training step on the batch, and returns its loss.
+  virtual double Learn(absl::Span<const AlphaZeroExample> batch) = 0;
+
+  // An immutable copy of the current model, for inference.
+  virtual std::shared_ptr<const InferenceModel> Snapshot() const = 0;
+
+  // Saves the model to `path`, e.g. to be loaded by LoadInferenceModel.
+  virtual void SaveCheckpoint(const std::string& path) const = 0;
+};
+
+struct AlphaZeroConfig {
+  std::string game;
+  // The directory of the logs and checkpoints, which is created.
+  std::string path;
+
+  // Training.
+  int max_steps = 0;  // 0 trains until stopped.
+  int replay_buffer_size = 1 << 16;
+  // How many times each state is learned from, on average, before it is
+  // replaced: each step waits for replay_buffer_size / replay_buffer_reuse
+  // new states before training.
+  int replay_buffer_reuse = 3;
+  int train_batch_size = 256;
+  // The number of batches of a step, or 0 for replay buffer size / batch
+  // size.
+  int train_batches_per_step = 0;
+  // Keeps the checkpoints of every this many steps, and always the last one.
+  int checkpoint_freq = 100;
+  // If not empty, the actors and evaluators load each checkpoint with
+  // LoadInferenceModel from this backend rather than using a Snapshot, e.g.
+  // to run inference in another framework than training.
+  std::string checkpoint_backend;
+
+  // Search.
+  double uct_c = 2;
+  int max_simulations = 300;
+  // The number of leaves each MCTSBot evaluates together.
+  int mcts_batch_size = 1;
+  double policy_alpha = 1;  // The Dirichlet noise of the actors' roots.
+  double policy_epsilon = 0.25;
+  // The actors play proportionally to the visit counts raised to the power
+  // 1 / temperature before move temperature_drop, and the most visited
+  // action from there.
+  double temperature = 1;
+  int temperature_drop = 10;
+  int64_t max_memory_mb = 1000;  // Per MCTSBot.
+
+  // Inference.
+  int inference_batch_size = 256;
+  int inference_threads = 1;
+  double inference_batch_timeout_ms = 1;
+  int inference_cache = 1 << 18;
+
+  // Threads.
+  int actors = 4;
+  int evaluators = 1;
+  // The evaluators play against MCTSBots with random rollouts and
+  // evaluation_simulations * 10^(level / 2) simulations, for each level in
+  // [0, eval_levels).
+  int evaluation_simulations = 100;
+  int eval_levels = 7;
+  int evaluation_window = 100;  // The games averaged per level.
+
+  int seed = 0;
+};
+
+// Plays games of self-play with MCTSBots evaluating on `model`, configured
+// as the actors of AlphaZero, and pushes their trajectories to the queue
+// until `stop` is requested. `num` seeds the actor.
+void AlphaZeroActor(const Game& game, const AlphaZeroConfig& config, int num,
+                    std::shared_ptr<const InferenceModel> model,
+                    ThreadedQueue<std::vector<AlphaZeroExample>>* trajectories,
+                    const StopToken& stop);
+
+// Trains `model` on config.game until max_steps, or until `stop` is
+// requested. Returns the number of steps taken.
+int AlphaZero(const AlphaZeroConfig& config, TrainableModel* model,
+              StopToken* stop = nullptr);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_ZERO_H_
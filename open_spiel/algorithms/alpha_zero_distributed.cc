@@ -0,0 +1,466 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/alpha_zero_distributed.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/alpha_zero.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/data_logger.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/tcp.h"
+#include "open_spiel/utils/thread.h"
+#include "open_spiel/utils/threaded_queue.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The first byte of the requests to ReplayShardServer.
+constexpr char kAdd = 'A';
+constexpr char kSample = 'S';
+constexpr char kTotalAdded = 'N';
+constexpr char kPutModel = 'P';
+constexpr char kGetModel = 'G';
+
+using tcp::Append;
+using tcp::AppendArray;
+using tcp::Reader;
+
+// Waits up to `duration`, returning early if `stop` is requested.
+void SleepUnlessStopped(absl::Duration duration, const StopToken* stop) {
+  const absl::Time deadline = absl::Now() + duration;
+  while (absl::Now() < deadline &&
+         (stop == nullptr || !stop->StopRequested())) {
+    absl::SleepFor(std::min(deadline - absl::Now(), absl::Milliseconds(50)));
+  }
+}
+
+}  // namespace
+
+std::string EncodeExamples(absl::Span<const AlphaZeroExample> examples) {
+  std::string out;
+  const int input_size = examples.empty() ? 0 : examples[0].input.size();
+  const int num_actions = examples.empty() ? 0 : examples[0].legal_mask.size();
+  Append<int32_t>(examples.size(), &out);
+  Append<int32_t>(input_size, &out);
+  Append<int32_t>(num_actions, &out);
+  std::vector<uint8_t> mask_bits((num_actions + 7) / 8);
+  std::vector<float> policy;
+  std::vector<int32_t> indices;
+  std::vector<float> values;
+  for (const AlphaZeroExample& example : examples) {
+    SPIEL_CHECK_EQ(example.input.size(), input_size);
+    SPIEL_CHECK_EQ(example.legal_mask.size(), num_actions);
+    SPIEL_CHECK_EQ(example.policy.size(), num_actions);
+    Append<float>(example.value, &out);
+    std::fill(mask_bits.begin(), mask_bits.end(), 0);
+    policy.clear();
+    for (int a = 0; a < num_actions; ++a) {
+      if (example.legal_mask[a]) {
+        mask_bits[a / 8] |= 1 << (a % 8);
+        policy.push_back(example.policy[a]);
+      }
+    }
+    AppendArray<uint8_t>(mask_bits, &out);
+    AppendArray<float>(policy, &out);
+    indices.clear();
+    values.clear();
+    for (int i = 0; i < input_size; ++i) {
+      if (example.input[i] != 0) {
+        indices.push_back(i);
+        values.push_back(example.input[i]);
+      }
+    }
+    // Sparse inputs take 8 bytes per nonzero, dense ones 4 per input.
+    const bool sparse = 2 * indices.size() < input_size;
+    Append<uint8_t>(sparse, &out);
+    if (sparse) {
+      Append<int32_t>(indices.size(), &out);
+      AppendArray<int32_t>(indices, &out);
+      AppendArray<float>(values, &out);
+    } else {
+      AppendArray<float>(example.input, &out);
+    }
+  }
+  return out;
+}
+
+std::vector<AlphaZeroExample> DecodeExamples(absl::string_view data) {
+  Reader reader(data);
+  const int num_examples = reader.Read<int32_t>();
+  const int input_size = reader.Read<int32_t>();
+  const int num_actions = reader.Read<int32_t>();
+  std::vector<AlphaZeroExample> examples(num_examples);
+  std::vector<uint8_t> mask_bits((num_actions + 7) / 8);
+  std::vector<int32_t> indices;
+  std::vector<float> values;
+  for (AlphaZeroExample& example : examples) {
+    example.value = reader.Read<float>();
+    reader.ReadArray(absl::MakeSpan(mask_bits));
+    example.legal_mask.assign(num_actions, 0);
+    int num_legal = 0;
+    for (int a = 0; a < num_actions; ++a) {
+      if (mask_bits[a / 8] & (1 << (a % 8))) {
+        example.legal_mask[a] = 1;
+        ++num_legal;
+      }
+    }
+    values.resize(num_legal);
+    reader.ReadArray(absl::MakeSpan(values));
+    example.policy.assign(num_actions, 0);
+    for (int a = 0, l = 0; a < num_actions; ++a) {
+      if (example.legal_mask[a]) example.policy[a] = values[l++];
+    }
+    example.input.resize(input_size);
+    if (reader.Read<uint8_t>()) {
+      const int num_nonzero = reader.Read<int32_t>();
+      indices.resize(num_nonzero);
+      values.resize(num_nonzero);
+      reader.ReadArray(absl::MakeSpan(indices));
+      reader.ReadArray(absl::MakeSpan(values));
+      std::fill(example.input.begin(), example.input.end(), 0);
+      for (int i = 0; i < num_nonzero; ++i) {
+        SPIEL_CHECK_LT(indices[i], input_size);
+        example.input[indices[i]] = values[i];
+      }
+    } else {
+      reader.ReadArray(absl::MakeSpan(example.input));
+    }
+  }
+  SPIEL_CHECK_TRUE(reader.Rest().empty());
+  return examples;
+}
+
+ReplayShardServer::ReplayShardServer(int port, int max_size, int seed)
+    : buffer_(max_size),
+      listener_(port),
+      seed_(seed),
+      accept_thread_([this]() { AcceptLoop(); }) {}
+
+ReplayShardServer::~ReplayShardServer() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+  }
+  listener_.Shutdown();
+  accept_thread_.join();
+  std::vector<Thread> threads;
+  {
+    absl::MutexLock lock(&mu_);
+    for (auto& connection : connections_) connection->Shutdown();
+    threads = std::move(threads_);
+  }
+  for (Thread& thread : threads) thread.join();
+}
+
+void ReplayShardServer::AcceptLoop() {
+  while (std::unique_ptr<tcp::Connection> connection = listener_.Accept()) {
+    absl::MutexLock lock(&mu_);
+    if (stop_) return;
+    tcp::Connection* served = connection.get();
+    const int seed = seed_ + connections_.size();
+    connections_.push_back(std::move(connection));
+    threads_.emplace_back([this, served, seed]() { Serve(served, seed); });
+  }
+}
+
+void ReplayShardServer::Serve(tcp::Connection* connection, int seed) {
+  std::mt19937 rng(seed);
+  while (std::optional<std::string> request = connection->Receive()) {
+    if (request->empty()) return;
+    Reader reader(absl::string_view(*request).substr(1));
+    std::string reply;
+    switch ((*request)[0]) {
+      case kAdd:
+        for (AlphaZeroExample& example : DecodeExamples(reader.Rest())) {
+          buffer_.Add(std::move(example));
+        }
+        break;
+      case kSample:
+        reply = EncodeExamples(buffer_.Sample(&rng, reader.Read<int32_t>()));
+        break;
+      case kTotalAdded:
+        Append<int64_t>(buffer_.TotalAdded(), &reply);
+        break;
+      case kPutModel: {
+        const int64_t version = reader.Read<int64_t>();
+        absl::MutexLock lock(&mu_);
+        if (version > model_version_) {
+          model_version_ = version;
+          model_ = std::string(reader.Rest());
+        }
+        break;
+      }
+      case kGetModel: {
+        const int64_t version = reader.Read<int64_t>();
+        absl::MutexLock lock(&mu_);
+        if (model_version_ > version) {
+          Append<int64_t>(model_version_, &reply);
+          reply.append(model_);
+        }
+        break;
+      }
+      default:
+        // Not a client: drop the connection.
+        return;
+    }
+    if (!connection->Send(reply)) return;
+  }
+}
+
+ReplayShardClient::ReplayShardClient(const std::string& address,
+                                     absl::Duration connect_timeout)
+    : address_(address) {
+  absl::MutexLock lock(&mu_);
+  connection_ = tcp::Connection::Connect(address, connect_timeout);
+}
+
+std::string ReplayShardClient::Call(absl::string_view request) {
+  absl::MutexLock lock(&mu_);
+  std::optional<std::string> reply = connection_->Call(request);
+  if (!reply) {
+    SpielFatalError(absl::StrCat("Lost the connection to ", address_));
+  }
+  return *std::move(reply);
+}
+
+bool ReplayShardClient::Add(absl::Span<const AlphaZeroExample> examples) {
+  std::string request(1, kAdd);
+  request.append(EncodeExamples(examples));
+  absl::MutexLock lock(&mu_);
+  return connection_->Call(request).has_value();
+}
+
+std::vector<AlphaZeroExample> ReplayShardClient::Sample(int num) {
+  std::string request(1, kSample);
+  Append<int32_t>(num, &request);
+  return DecodeExamples(Call(request));
+}
+
+int64_t ReplayShardClient::TotalAdded() {
+  return Reader(Call(std::string(1, kTotalAdded))).Read<int64_t>();
+}
+
+void ReplayShardClient::PutModel(int64_t version,
+                                 absl::string_view checkpoint) {
+  std::string request(1, kPutModel);
+  Append<int64_t>(version, &request);
+  request.append(checkpoint.data(), checkpoint.size());
+  Call(request);
+}
+
+std::optional<std::pair<int64_t, std::string>> ReplayShardClient::GetModel(
+    int64_t version) {
+  std::string request(1, kGetModel);
+  Append<int64_t>(version, &request);
+  const std::string reply = Call(request);
+  if (reply.empty()) return std::nullopt;
+  Reader reader(reply);
+  const int64_t new_version = reader.Read<int64_t>();
+  return std::make_pair(new_version, std::string(reader.Rest()));
+}
+
+void RunRemoteActors(const AlphaZeroConfig& config,
+                     const std::vector<std::string>& shards,
+                     absl::Duration model_poll_interval, StopToken* stop) {
+  SPIEL_CHECK_FALSE(shards.empty());
+  if (config.checkpoint_backend.empty()) {
+    SpielFatalError("Remote actors need a checkpoint_backend.");
+  }
+  std::shared_ptr<const Game> game = LoadGame(config.game);
+  if (!file::Exists(config.path) && !file::Mkdirs(config.path)) {
+    SpielFatalError(absl::StrCat("Failed to create the directory ",
+                                 config.path));
+  }
+  std::vector<std::unique_ptr<ReplayShardClient>> clients;
+  for (const std::string& shard : shards) {
+    clients.push_back(std::make_unique<ReplayShardClient>(shard));
+  }
+  auto stopped = [stop]() { return stop != nullptr && stop->StopRequested(); };
+
+  // Loads a model from the first shard if it has a new one.
+  int64_t version = -1;
+  auto pull_model = [&]() -> std::shared_ptr<const InferenceModel> {
+    std::optional<std::pair<int64_t, std::string>> pulled =
+        clients[0]->GetModel(version);
+    if (!pulled) return nullptr;
+    version = pulled->first;
+    const std::string path = absl::StrCat(config.path, "/model-", version);
+    file::File(path, "w").Write(pulled->second);
+    std::shared_ptr<const InferenceModel> model =
+        LoadInferenceModel(config.checkpoint_backend, *game, path);
+    file::Remove(path);
+    return model;
+  };
+  std::shared_ptr<const InferenceModel> model;
+  while (!stopped() && (model = pull_model()) == nullptr) {
+    SleepUnlessStopped(absl::Milliseconds(100), stop);
+  }
+  if (stopped()) return;
+
+  auto inference = std::make_shared<BatchingInferenceModel>(
+      model, config.inference_batch_size, config.inference_threads,
+      absl::Milliseconds(config.inference_batch_timeout_ms),
+      config.inference_cache);
+  // The actors wait for the sender when the queue is full.
+  ThreadedQueue<std::vector<AlphaZeroExample>> trajectories(
+      std::max(config.actors, 1) * 8);
+  StopToken threads_stop;
+  std::atomic<bool> lost_shard{false};
+  std::vector<Thread> threads;
+  for (int i = 0; i < config.actors; ++i) {
+    threads.emplace_back([&, i]() {
+      AlphaZeroActor(*game, config, i, inference, &trajectories, threads_stop);
+    });
+  }
+  // Sends the trajectories to the shards in turn.
+  threads.emplace_back([&]() {
+    for (int shard = 0; !threads_stop.StopRequested();) {
+      std::optional<std::vector<AlphaZeroExample>> trajectory =
+          trajectories.Pop(absl::Milliseconds(100));
+      if (!trajectory) continue;
+      if (!clients[shard]->Add(*trajectory)) {
+        lost_shard = true;
+        return;
+      }
+      shard = (shard + 1) % clients.size();
+    }
+  });
+
+  while (!stopped() && !lost_shard) {
+    SleepUnlessStopped(model_poll_interval, stop);
+    if (stopped() || lost_shard) break;
+    if (std::shared_ptr<const InferenceModel> new_model = pull_model()) {
+      inference->SetModel(std::move(new_model));
+    }
+  }
+
+  threads_stop.Stop();
+  trajectories.BlockNewValues();
+  trajectories.Clear();
+  for (Thread& thread : threads) thread.join();
+}
+
+int DistributedAlphaZeroLearner(const AlphaZeroConfig& config,
+                                TrainableModel* model,
+                                const std::vector<std::string>& shards,
+                                StopToken* stop) {
+  SPIEL_CHECK_FALSE(shards.empty());
+  std::shared_ptr<const Game> game = LoadGame(config.game);
+  SPIEL_CHECK_EQ(model->InputSize(), InferenceInputSize(*game));
+  SPIEL_CHECK_EQ(model->NumActions(), game->NumDistinctActions());
+  SPIEL_CHECK_GT(config.train_batch_size, 0);
+  SPIEL_CHECK_GT(config.replay_buffer_reuse, 0);
+  SPIEL_CHECK_GT(config.checkpoint_freq, 0);
+  if (!file::Exists(config.path) && !file::Mkdirs(config.path)) {
+    SpielFatalError(absl::StrCat("Failed to create the directory ",
+                                 config.path));
+  }
+  std::vector<std::unique_ptr<ReplayShardClient>> clients;
+  for (const std::string& shard : shards) {
+    clients.push_back(std::make_unique<ReplayShardClient>(shard));
+  }
+  auto stopped = [stop]() { return stop != nullptr && stop->StopRequested(); };
+  auto total_added = [&clients]() {
+    int64_t total = 0;
+    for (auto& client : clients) total += client->TotalAdded();
+    return total;
+  };
+  auto publish = [&](int step) {
+    const std::string checkpoint =
+        absl::StrCat(config.path, "/checkpoint-", step);
+    model->SaveCheckpoint(checkpoint);
+    clients[0]->PutModel(step, file::File(checkpoint, "r").ReadContents());
+    return checkpoint;
+  };
+
+  DataLoggerJsonLines logger(config.path, "learner", /*flush=*/true);
+  const int learn_rate =
+      std::max(config.replay_buffer_size / config.replay_buffer_reuse, 1);
+  const int num_shards = clients.size();
+
+  int step = 0;
+  std::string last_checkpoint = publish(step);
+  int64_t last_total = total_added();
+  while ((config.max_steps == 0 || step < config.max_steps) && !stopped()) {
+    const absl::Time start = absl::Now();
+    int64_t total = total_added();
+    while (total - last_total < learn_rate && !stopped()) {
+      SleepUnlessStopped(absl::Milliseconds(100), stop);
+      total = total_added();
+    }
+    if (stopped()) break;
+    ++step;
+    const absl::Time collected = absl::Now();
+
+    const int buffer_size = std::min<int64_t>(total, config.replay_buffer_size);
+    const int num_batches =
+        config.train_batches_per_step > 0
+            ? config.train_batches_per_step
+            : std::max(buffer_size / config.train_batch_size, 1);
+    double total_loss = 0;
+    for (int b = 0; b < num_batches; ++b) {
+      // Each shard gives an equal part of the batch.
+      std::vector<AlphaZeroExample> batch;
+      batch.reserve(config.train_batch_size);
+      for (int s = 0; s < num_shards; ++s) {
+        const int num = config.train_batch_size / num_shards +
+                        (s < config.train_batch_size % num_shards);
+        std::vector<AlphaZeroExample> part = clients[s]->Sample(num);
+        std::move(part.begin(), part.end(), std::back_inserter(batch));
+      }
+      total_loss += model->Learn(batch);
+    }
+
+    const std::string checkpoint = publish(step);
+    if ((step - 1) % config.checkpoint_freq != 0) {
+      file::Remove(last_checkpoint);
+    }
+    last_checkpoint = checkpoint;
+
+    const absl::Time end = absl::Now();
+    logger.Write({
+        {"step", step},
+        {"total_states", total},
+        {"states", total - last_total},
+        {"loss", total_loss / num_batches},
+        {"collect_seconds", absl::ToDoubleSeconds(collected - start)},
+        {"learn_seconds", absl::ToDoubleSeconds(end - collected)},
+    });
+    last_total = total;
+  }
+  return step;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,155 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_ZERO_DISTRIBUTED_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_ZERO_DISTRIBUTED_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/alpha_zero.h"
+#include "open_spiel/utils/replay_buffer.h"
+#include "open_spiel/utils/tcp.h"
+#include "open_spiel/utils/thread.h"
+
+// AlphaZero self-play spread over several machines, as a variant of
+// AlphaZero() in alpha_zero.h:
+//
+// - ReplayShardServers each hold a shard of the replay buffer, on machines
+//   with enough memory for them.
+// - RunRemoteActors runs actors on any number of machines. They stream their
+//   trajectories to the shards in turn, through a bounded ThreadedQueue and a
+//   single sender, so that actors wait when the shards cannot keep up, and
+//   pull the new versions of the model from the first shard.
+// - DistributedAlphaZeroLearner samples its batches from all the shards, and
+//   publishes each checkpoint to the first shard.
+//
+// The trajectories are sent in a compact binary encoding (see EncodeExamples)
+// and the models as their checkpoint files, which the actors load with
+// config.checkpoint_backend. Shards are given as "host:port".
+
+namespace open_spiel {
+namespace algorithms {
+
+// Encodes examples with inputs and masks of the same sizes, in native byte
+// order: the legal masks as bits, the policies over the legal actions only,
+// and the inputs as (index, value) pairs when that is shorter.
+std::string EncodeExamples(absl::Span<const AlphaZeroExample> examples);
+std::vector<AlphaZeroExample> DecodeExamples(absl::string_view data);
+
+// Serves a shard of a distributed replay buffer, a ReplayBuffer of max_size
+// examples, and the latest model published to it, to any number of
+// ReplayShardClients, each served by its own thread.
+class ReplayShardServer {
+ public:
+  // Listens on `port`, or on a free one if 0.
+  ReplayShardServer(int port, int max_size, int seed = 0);
+
+  // Stops serving and closes the connections.
+  ~ReplayShardServer();
+
+  ReplayShardServer(const ReplayShardServer&) = delete;
+  ReplayShardServer& operator=(const ReplayShardServer&) = delete;
+
+  int Port() const { return listener_.Port(); }
+  int Size() const { return buffer_.Size(); }
+  int64_t TotalAdded() const { return buffer_.TotalAdded(); }
+
+ private:
+  void AcceptLoop();
+  void Serve(tcp::Connection* connection, int seed);
+
+  ReplayBuffer<AlphaZeroExample> buffer_;
+  tcp::Listener listener_;
+  const int seed_;
+
+  absl::Mutex mu_;
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<std::unique_ptr<tcp::Connection>> connections_
+      ABSL_GUARDED_BY(mu_);
+  std::vector<Thread> threads_ ABSL_GUARDED_BY(mu_);
+  // The published model, and its version, or -1 if none.
+  int64_t model_version_ ABSL_GUARDED_BY(mu_) = -1;
+  std::string model_ ABSL_GUARDED_BY(mu_);
+
+  Thread accept_thread_;
+};
+
+// A connection to a ReplayShardServer. Thread-safe: calls from several
+// threads wait for each other. The calls fail fatally if the connection is
+// lost, except Add.
+class ReplayShardClient {
+ public:
+  // Connects to "host:port", retrying until connect_timeout, e.g. for the
+  // servers to start.
+  explicit ReplayShardClient(
+      const std::string& address,
+      absl::Duration connect_timeout = absl::Seconds(60));
+
+  // Adds the examples to the shard. Returns false if the connection is lost.
+  bool Add(absl::Span<const AlphaZeroExample> examples);
+
+  // Returns `num` examples sampled without replacement, or all of them if
+  // there are fewer.
+  std::vector<AlphaZeroExample> Sample(int num);
+
+  int64_t TotalAdded();
+
+  // Publishes a model, given as the contents of its checkpoint, unless a
+  // later version was.
+  void PutModel(int64_t version, absl::string_view checkpoint);
+
+  // Returns the version and checkpoint of the published model if it is later
+  // than `version`.
+  std::optional<std::pair<int64_t, std::string>> GetModel(int64_t version);
+
+ private:
+  std::string Call(absl::string_view request);
+
+  const std::string address_;
+  absl::Mutex mu_;
+  std::unique_ptr<tcp::Connection> connection_ ABSL_GUARDED_BY(mu_);
+};
+
+// Runs config.actors actors on this machine, with config.evaluators ignored,
+// until `stop` is requested or a shard is lost. The models pulled from the
+// first shard every model_poll_interval are written to config.path and
+// loaded with config.checkpoint_backend. The actors start once the learner
+// has published its first model.
+void RunRemoteActors(const AlphaZeroConfig& config,
+                     const std::vector<std::string>& shards,
+                     absl::Duration model_poll_interval, StopToken* stop);
+
+// Trains `model` as AlphaZero() does, on the trajectories sent to the shards
+// by remote actors, and publishes its checkpoints to the first shard, from
+// version 0 for the initial model. config.replay_buffer_size is the total
+// size of the shards. Returns the number of steps taken.
+int DistributedAlphaZeroLearner(const AlphaZeroConfig& config,
+                                TrainableModel* model,
+                                const std::vector<std::string>& shards,
+                                StopToken* stop = nullptr);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ALPHA_ZERO_DISTRIBUTED_H_
@@ -0,0 +1,207 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/alpha_zero_distributed.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/alpha_zero.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// A uniform model counting its training steps, which are its checkpoints.
+class CountingModel : public TrainableModel {
+ public:
+  explicit CountingModel(const Game& game) : uniform_(game) {}
+
+  int InputSize() const override { return uniform_.InputSize(); }
+  int NumActions() const override { return uniform_.NumActions(); }
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override {
+    uniform_.Infer(batch_size, inputs, legal_masks, policies, values);
+  }
+
+  double Learn(absl::Span<const AlphaZeroExample> batch) override {
+    SPIEL_CHECK_FALSE(batch.empty());
+    num_examples_ += batch.size();
+    ++num_steps_;
+    return 0;
+  }
+  std::shared_ptr<const InferenceModel> Snapshot() const override {
+    return std::make_shared<UniformInferenceModel>(uniform_);
+  }
+  void SaveCheckpoint(const std::string& path) const override {
+    file::File(path, "w").Write(std::to_string(num_steps_));
+  }
+
+  int NumSteps() const { return num_steps_; }
+  int NumExamples() const { return num_examples_; }
+
+ private:
+  UniformInferenceModel uniform_;
+  int num_steps_ = 0;
+  int num_examples_ = 0;
+};
+
+InferenceBackendRegisterer counting_registerer(
+    "counting_test", [](const Game& game, const std::string& path) {
+      SPIEL_CHECK_TRUE(file::Exists(path));
+      return std::make_unique<UniformInferenceModel>(game);
+    });
+
+AlphaZeroExample MakeExample(int num, int input_size, int num_actions,
+                             bool sparse) {
+  AlphaZeroExample example;
+  example.input.assign(input_size, 0);
+  for (int i = 0; i < input_size; ++i) {
+    if (!sparse || i % 7 == num % 7) example.input[i] = i * 0.5 + num;
+  }
+  example.legal_mask.assign(num_actions, 0);
+  example.policy.assign(num_actions, 0);
+  for (int a = num % 2; a < num_actions; a += 2) {
+    example.legal_mask[a] = 1;
+    example.policy[a] = 0.1 * a;
+  }
+  example.value = num % 3 - 1;
+  return example;
+}
+
+void CheckEqual(const AlphaZeroExample& a, const AlphaZeroExample& b) {
+  SPIEL_CHECK_TRUE(a.input == b.input);
+  SPIEL_CHECK_TRUE(a.legal_mask == b.legal_mask);
+  SPIEL_CHECK_TRUE(a.policy == b.policy);
+  SPIEL_CHECK_EQ(a.value, b.value);
+}
+
+void EncodesExamples() {
+  std::vector<AlphaZeroExample> examples;
+  for (int i = 0; i < 10; ++i) {
+    examples.push_back(MakeExample(i, 100, 13, /*sparse=*/i % 2));
+  }
+  const std::string encoded = EncodeExamples(examples);
+  std::vector<AlphaZeroExample> decoded = DecodeExamples(encoded);
+  SPIEL_CHECK_EQ(decoded.size(), examples.size());
+  for (int i = 0; i < examples.size(); ++i) CheckEqual(decoded[i], examples[i]);
+  // Smaller than the floats, though half the inputs are dense.
+  SPIEL_CHECK_LT(encoded.size(), examples.size() * (100 + 2 * 13) * 4 * 0.7);
+  SPIEL_CHECK_TRUE(DecodeExamples(EncodeExamples({})).empty());
+}
+
+void ServesShard() {
+  ReplayShardServer server(0, /*max_size=*/8);
+  ReplayShardClient client(absl::StrCat("localhost:", server.Port()));
+  ReplayShardClient other(absl::StrCat("localhost:", server.Port()));
+  SPIEL_CHECK_EQ(client.TotalAdded(), 0);
+  SPIEL_CHECK_TRUE(client.Sample(4).empty());
+  std::vector<AlphaZeroExample> examples;
+  for (int i = 0; i < 6; ++i) examples.push_back(MakeExample(i, 20, 5, true));
+  SPIEL_CHECK_TRUE(client.Add(examples));
+  SPIEL_CHECK_TRUE(other.Add(examples));
+  SPIEL_CHECK_EQ(other.TotalAdded(), 12);
+  SPIEL_CHECK_EQ(server.Size(), 8);
+  std::vector<AlphaZeroExample> sampled = other.Sample(5);
+  SPIEL_CHECK_EQ(sampled.size(), 5);
+  for (const AlphaZeroExample& example : sampled) {
+    SPIEL_CHECK_EQ(example.input.size(), 20);
+  }
+
+  SPIEL_CHECK_FALSE(client.GetModel(-1).has_value());
+  client.PutModel(3, "three");
+  client.PutModel(2, "two");  // Older, so ignored.
+  auto model = other.GetModel(-1);
+  SPIEL_CHECK_TRUE(model.has_value());
+  SPIEL_CHECK_EQ(model->first, 3);
+  SPIEL_CHECK_EQ(model->second, "three");
+  SPIEL_CHECK_FALSE(other.GetModel(3).has_value());
+}
+
+std::string TestDir(const std::string& name) {
+  const char* tmp_dir = std::getenv("TMPDIR");
+  return absl::StrCat(tmp_dir == nullptr ? "/tmp" : tmp_dir,
+                      "/open_spiel-test-", name, "-", std::rand());  // NOLINT
+}
+
+void TrainsWithRemoteActors() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  ReplayShardServer first_shard(0, /*max_size=*/64);
+  ReplayShardServer second_shard(0, /*max_size=*/64);
+  const std::vector<std::string> shards = {
+      absl::StrCat("localhost:", first_shard.Port()),
+      absl::StrCat("localhost:", second_shard.Port())};
+
+  AlphaZeroConfig config;
+  config.game = "tic_tac_toe";
+  config.max_steps = 2;
+  config.replay_buffer_size = 128;
+  config.replay_buffer_reuse = 4;
+  config.train_batch_size = 8;
+  config.train_batches_per_step = 3;
+  config.checkpoint_backend = "counting_test";
+  config.max_simulations = 5;
+  config.inference_batch_size = 4;
+  config.actors = 2;
+
+  // Two machines of actors.
+  StopToken stop_actors;
+  std::vector<Thread> actors;
+  for (int machine = 0; machine < 2; ++machine) {
+    AlphaZeroConfig actor_config = config;
+    actor_config.path = TestDir("alpha_zero_actors");
+    actor_config.seed = machine * 10;
+    actors.emplace_back([actor_config, &shards, &stop_actors]() {
+      RunRemoteActors(actor_config, shards, absl::Milliseconds(20),
+                      &stop_actors);
+    });
+  }
+
+  config.path = TestDir("alpha_zero_learner");
+  CountingModel model(*game);
+  SPIEL_CHECK_EQ(DistributedAlphaZeroLearner(config, &model, shards), 2);
+  stop_actors.Stop();
+  for (Thread& actor : actors) actor.join();
+
+  SPIEL_CHECK_EQ(model.NumSteps(), 6);
+  SPIEL_CHECK_EQ(model.NumExamples(), 6 * 8);
+  SPIEL_CHECK_GE(first_shard.TotalAdded() + second_shard.TotalAdded(), 64);
+  SPIEL_CHECK_GT(first_shard.TotalAdded(), 0);
+  SPIEL_CHECK_GT(second_shard.TotalAdded(), 0);
+  SPIEL_CHECK_TRUE(file::Exists(config.path + "/checkpoint-0"));
+  SPIEL_CHECK_FALSE(file::Exists(config.path + "/checkpoint-1"));
+  SPIEL_CHECK_TRUE(file::Exists(config.path + "/checkpoint-2"));
+  SPIEL_CHECK_TRUE(file::Exists(config.path + "/learner.jsonl"));
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::EncodesExamples();
+  open_spiel::algorithms::ServesShard();
+  open_spiel::algorithms::TrainsWithRemoteActors();
+}
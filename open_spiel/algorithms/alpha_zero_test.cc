@@ -0,0 +1,230 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/alpha_zero.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/json.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// A linear softmax policy and a linear value, trained by gradient descent on
+// the cross-entropy and squared errors, and saved as text.
+class LinearModel : public TrainableModel {
+ public:
+  LinearModel(int input_size, int num_actions)
+      : input_size_(input_size),
+        num_actions_(num_actions),
+        weights_((input_size + 1) * (num_actions + 1), 0) {}
+
+  int InputSize() const override { return input_size_; }
+  int NumActions() const override { return num_actions_; }
+
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override {
+    std::vector<double> outputs;
+    for (int b = 0; b < batch_size; ++b) {
+      Forward(inputs.subspan(b * input_size_, input_size_),
+              legal_masks.subspan(b * num_actions_, num_actions_), &outputs);
+      for (int a = 0; a < num_actions_; ++a) {
+        policies[b * num_actions_ + a] = outputs[a];
+      }
+      if (!values.empty()) values[b] = outputs[num_actions_];
+    }
+  }
+
+  double Learn(absl::Span<const AlphaZeroExample> batch) override {
+    ++num_steps_;
+    std::vector<double> gradient(weights_.size(), 0);
+    std::vector<double> outputs;
+    double loss = 0;
+    for (const AlphaZeroExample& example : batch) {
+      Forward(example.input, example.legal_mask, &outputs);
+      for (int o = 0; o <= num_actions_; ++o) {
+        const double target =
+            o < num_actions_ ? example.policy[o] : example.value;
+        const double error = outputs[o] - target;
+        if (o < num_actions_) {
+          if (target > 0) loss -= target * std::log(outputs[o] + 1e-9);
+        } else {
+          loss += error * error;
+        }
+        for (int i = 0; i <= input_size_; ++i) {
+          gradient[o * (input_size_ + 1) + i] +=
+              error * (i < input_size_ ? example.input[i] : 1);
+        }
+      }
+    }
+    for (int w = 0; w < weights_.size(); ++w) {
+      weights_[w] -= 0.1 * gradient[w] / batch.size();
+    }
+    return loss / batch.size();
+  }
+
+  std::shared_ptr<const InferenceModel> Snapshot() const override {
+    return std::make_shared<LinearModel>(*this);
+  }
+
+  void SaveCheckpoint(const std::string& path) const override {
+    file::File(path, "w").Write(absl::StrJoin(weights_, " "));
+  }
+
+  static std::unique_ptr<LinearModel> Load(const Game& game,
+                                           const std::string& path) {
+    auto model = std::make_unique<LinearModel>(InferenceInputSize(game),
+                                               game.NumDistinctActions());
+    std::vector<std::string> weights =
+        absl::StrSplit(file::File(path, "r").ReadContents(), ' ');
+    SPIEL_CHECK_EQ(weights.size(), model->weights_.size());
+    for (int w = 0; w < weights.size(); ++w) {
+      SPIEL_CHECK_TRUE(absl::SimpleAtod(weights[w], &model->weights_[w]));
+    }
+    return model;
+  }
+
+  int NumSteps() const { return num_steps_; }
+
+ private:
+  // The probabilities of the actions, followed by the value.
+  void Forward(absl::Span<const float> input, absl::Span<const float> mask,
+               std::vector<double>* outputs) const {
+    outputs->assign(num_actions_ + 1, 0);
+    for (int o = 0; o <= num_actions_; ++o) {
+      const double* row = &weights_[o * (input_size_ + 1)];
+      double sum = row[input_size_];
+      for (int i = 0; i < input_size_; ++i) sum += row[i] * input[i];
+      (*outputs)[o] = sum;
+    }
+    double max_logit = -1e300;
+    for (int a = 0; a < num_actions_; ++a) {
+      if (mask[a]) max_logit = std::max(max_logit, (*outputs)[a]);
+    }
+    double total = 0;
+    for (int a = 0; a < num_actions_; ++a) {
+      (*outputs)[a] = mask[a] ? std::exp((*outputs)[a] - max_logit) : 0;
+      total += (*outputs)[a];
+    }
+    for (int a = 0; a < num_actions_; ++a) (*outputs)[a] /= total;
+  }
+
+  int input_size_;
+  int num_actions_;
+  // A row of input weights and a bias for each action, then for the value.
+  std::vector<double> weights_;
+  int num_steps_ = 0;
+};
+
+InferenceBackendRegisterer linear_registerer(
+    "linear_test", [](const Game& game, const std::string& path) {
+      return LinearModel::Load(game, path);
+    });
+
+std::string TestDir(const std::string& name) {
+  const char* tmp_dir = std::getenv("TMPDIR");
+  return absl::StrCat(tmp_dir == nullptr ? "/tmp" : tmp_dir,
+                      "/open_spiel-test-", name, "-", std::rand());  // NOLINT
+}
+
+AlphaZeroConfig SmallConfig(const std::string& game) {
+  AlphaZeroConfig config;
+  config.game = game;
+  config.path = TestDir("alpha_zero");
+  config.max_steps = 3;
+  config.replay_buffer_size = 128;
+  config.replay_buffer_reuse = 4;
+  config.train_batch_size = 16;
+  config.train_batches_per_step = 2;
+  config.checkpoint_freq = 2;
+  config.max_simulations = 10;
+  config.mcts_batch_size = 2;
+  config.max_memory_mb = 10;
+  config.inference_batch_size = 8;
+  config.inference_cache = 1000;
+  config.actors = 3;
+  config.evaluators = 1;
+  config.evaluation_simulations = 2;
+  config.eval_levels = 2;
+  return config;
+}
+
+void TrainsAndLogs(const std::string& game_string,
+                   const std::string& checkpoint_backend) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  AlphaZeroConfig config = SmallConfig(game_string);
+  config.checkpoint_backend = checkpoint_backend;
+  LinearModel model(InferenceInputSize(*game), game->NumDistinctActions());
+  SPIEL_CHECK_EQ(AlphaZero(config, &model), config.max_steps);
+  SPIEL_CHECK_EQ(model.NumSteps(),
+                 config.max_steps * config.train_batches_per_step);
+
+  // The checkpoints of the steps that are multiples of 2, and the last one.
+  SPIEL_CHECK_FALSE(file::Exists(config.path + "/checkpoint-1"));
+  SPIEL_CHECK_TRUE(file::Exists(config.path + "/checkpoint-2"));
+  SPIEL_CHECK_TRUE(file::Exists(config.path + "/checkpoint-3"));
+  LinearModel::Load(*game, config.path + "/checkpoint-3");
+
+  std::vector<std::string> lines = absl::StrSplit(
+      file::File(config.path + "/learner.jsonl", "r").ReadContents(), '\n',
+      absl::SkipEmpty());
+  SPIEL_CHECK_EQ(lines.size(), config.max_steps);
+  for (int i = 0; i < lines.size(); ++i) {
+    json::Object record = json::FromString(lines[i])->GetObject();
+    SPIEL_CHECK_EQ(record["step"], i + 1);
+    SPIEL_CHECK_GE(record["states"].GetInt(), 32);
+    SPIEL_CHECK_TRUE(record["loss"].IsDouble());
+    SPIEL_CHECK_EQ(record["eval"].GetObject()["games"].GetArray().size(), 2);
+  }
+}
+
+// Stopping before the first step returns at once, and stops the threads.
+void StopsEarly() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  AlphaZeroConfig config = SmallConfig("tic_tac_toe");
+  config.max_steps = 0;
+  LinearModel model(InferenceInputSize(*game), game->NumDistinctActions());
+  StopToken stop;
+  stop.Stop();
+  SPIEL_CHECK_EQ(AlphaZero(config, &model, &stop), 0);
+  SPIEL_CHECK_EQ(model.NumSteps(), 0);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TrainsAndLogs("tic_tac_toe", "");
+  open_spiel::algorithms::TrainsAndLogs("tic_tac_toe", "linear_test");
+  open_spiel::algorithms::TrainsAndLogs("connect_four", "");
+  open_spiel::algorithms::StopsEarly();
+}
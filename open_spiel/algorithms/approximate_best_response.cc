@@ -0,0 +1,287 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/approximate_best_response.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+MonteCarloEstimate Estimate(const std::vector<double>& samples) {
+  MonteCarloEstimate estimate;
+  estimate.num_samples = samples.size();
+  if (samples.empty()) return estimate;
+  for (double sample : samples) estimate.mean += sample;
+  estimate.mean /= samples.size();
+  if (samples.size() > 1) {
+    double squares = 0;
+    for (double sample : samples) {
+      squares += (sample - estimate.mean) * (sample - estimate.mean);
+    }
+    estimate.std_error =
+        std::sqrt(squares / (samples.size() - 1) / samples.size());
+  }
+  estimate.lower = estimate.mean - 1.96 * estimate.std_error;
+  estimate.upper = estimate.mean + 1.96 * estimate.std_error;
+  return estimate;
+}
+
+// Runs play(game, rng) for config.num_games games on config.num_threads
+// threads, each game with a generator seeded from the seed, `stream` and its
+// index, and returns the results in the order of the games.
+template <typename T>
+std::vector<T> PlayGames(const LocalBestResponseConfig& config, int stream,
+                         const std::function<T(std::mt19937*)>& play) {
+  SPIEL_CHECK_GE(config.num_games, 0);
+  SPIEL_CHECK_GE(config.num_threads, 1);
+  std::vector<T> results(config.num_games);
+  std::atomic<int> next_game{0};
+  auto run = [&]() {
+    for (int g; (g = next_game++) < config.num_games;) {
+      std::seed_seq seed{config.seed, stream, g};
+      std::mt19937 rng(seed);
+      results[g] = play(&rng);
+    }
+  };
+  if (config.num_threads == 1) {
+    run();
+  } else {
+    std::vector<Thread> threads;
+    for (int t = 0; t < config.num_threads; ++t) threads.emplace_back(run);
+    for (Thread& thread : threads) thread.join();
+  }
+  return results;
+}
+
+// The local best response of a player, playing a game with its own
+// generator.
+class LocalBestResponse {
+ public:
+  LocalBestResponse(const Policy& policy, Player player,
+                    const LocalBestResponseConfig& config, std::mt19937* rng)
+      : policy_(policy), player_(player), config_(config), rng_(rng) {}
+
+  // Plays a game against the policy, returning the player's return.
+  double PlayGame(const Game& game) {
+    std::unique_ptr<State> state = game.NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->CurrentPlayer() == player_) {
+        state->ApplyAction(BestAction(*state, config_.lookahead_depth - 1));
+      } else {
+        state->ApplyAction(SampleAction(*state));
+      }
+    }
+    return state->PlayerReturn(player_);
+  }
+
+ private:
+  // Returns the action with the best estimated value, maximizing over the
+  // next `depth` decisions of the player after it.
+  Action BestAction(const State& state, int depth) {
+    std::vector<std::pair<std::unique_ptr<State>, double>> beliefs =
+        SampleBeliefs(state);
+    const std::vector<Action> legal_actions = state.LegalActions();
+    // The values are weighted sums: their normalization doesn't change the
+    // best action.
+    std::vector<double> values(legal_actions.size(), 0);
+    for (const auto& [history, weight] : beliefs) {
+      for (int i = 0; i < legal_actions.size(); ++i) {
+        for (int r = 0; r < config_.num_rollouts; ++r) {
+          values[i] += weight * Rollout(history->Child(legal_actions[i]),
+                                        depth);
+        }
+      }
+    }
+    int best = 0;
+    for (int i = 1; i < legal_actions.size(); ++i) {
+      if (values[i] > values[best]) best = i;
+    }
+    return legal_actions[best];
+  }
+
+  // Plays until the end of the game, the player maximizing over its next
+  // `depth` decisions and then following the policy.
+  double Rollout(std::unique_ptr<State> state, int depth) {
+    while (!state->IsTerminal()) {
+      if (state->CurrentPlayer() == player_ && depth > 0) {
+        state->ApplyAction(BestAction(*state, depth - 1));
+      } else {
+        state->ApplyAction(SampleAction(*state));
+      }
+    }
+    return state->PlayerReturn(player_);
+  }
+
+  // Returns histories sampled from the player's information state at
+  // `state`, with their weights, the opponents' probabilities of reaching
+  // them, or uniform weights if all are zero.
+  std::vector<std::pair<std::unique_ptr<State>, double>> SampleBeliefs(
+      const State& state) {
+    std::vector<std::pair<std::unique_ptr<State>, double>> beliefs;
+    if (state.GetGame()->GetType().information ==
+        GameType::Information::kPerfectInformation) {
+      beliefs.push_back({state.Clone(), 1.0});
+      return beliefs;
+    }
+    double total = 0;
+    for (int i = 0; i < config_.num_belief_samples; ++i) {
+      std::unique_ptr<State> history =
+          state.ResampleFromInfostate(player_, [this]() { return Uniform(); });
+      const double weight = OpponentReach(*history);
+      total += weight;
+      beliefs.push_back({std::move(history), weight});
+    }
+    if (total == 0) {
+      for (auto& belief : beliefs) belief.second = 1.0;
+    }
+    return beliefs;
+  }
+
+  double OpponentReach(const State& history) {
+    std::unique_ptr<State> state = history.GetGame()->NewInitialState();
+    double reach = 1.0;
+    for (Action action : history.History()) {
+      if (!state->IsChanceNode() && state->CurrentPlayer() != player_) {
+        // GetProb is -1 for actions missing from the policy.
+        reach *= std::max(
+            GetProb(policy_.GetStatePolicy(*state), action), 0.0);
+        if (reach == 0) return 0;
+      }
+      state->ApplyAction(action);
+    }
+    return reach;
+  }
+
+  // Samples a chance outcome, or an action of the policy.
+  Action SampleAction(const State& state) {
+    if (state.IsChanceNode()) return state.SampleChanceOutcome(*rng_).first;
+    return open_spiel::SampleAction(policy_.GetStatePolicy(state), Uniform())
+        .first;
+  }
+
+  double Uniform() {
+    return std::uniform_real_distribution<double>(0, 1)(*rng_);
+  }
+
+  const Policy& policy_;
+  const Player player_;
+  const LocalBestResponseConfig& config_;
+  std::mt19937* rng_;
+};
+
+void CheckGame(const Game& game) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "Local best responses require sequential games. If you're trying to "
+        "run them on a simultaneous (or normal-form) game, please first "
+        "transform it using turn_based_simultaneous_game.");
+  }
+}
+
+}  // namespace
+
+MonteCarloEstimate LocalBestResponseValue(
+    const Game& game, const Policy& policy, Player player,
+    const LocalBestResponseConfig& config) {
+  CheckGame(game);
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, game.NumPlayers());
+  SPIEL_CHECK_GE(config.lookahead_depth, 1);
+  SPIEL_CHECK_GE(config.num_belief_samples, 1);
+  return Estimate(PlayGames<double>(
+      config, player, [&](std::mt19937* rng) {
+        return LocalBestResponse(policy, player, config, rng).PlayGame(game);
+      }));
+}
+
+std::vector<MonteCarloEstimate> OnPolicyValues(
+    const Game& game, const Policy& policy,
+    const LocalBestResponseConfig& config) {
+  CheckGame(game);
+  std::vector<std::vector<double>> returns = PlayGames<std::vector<double>>(
+      config, game.NumPlayers(), [&](std::mt19937* rng) {
+        std::unique_ptr<State> state = game.NewInitialState();
+        while (!state->IsTerminal()) {
+          if (state->IsChanceNode()) {
+            state->ApplyAction(state->SampleChanceOutcome(*rng).first);
+          } else {
+            const double z = std::uniform_real_distribution<double>(0, 1)(*rng);
+            state->ApplyAction(
+                SampleAction(policy.GetStatePolicy(*state), z).first);
+          }
+        }
+        return state->Returns();
+      });
+  std::vector<MonteCarloEstimate> values;
+  for (Player p = 0; p < game.NumPlayers(); ++p) {
+    std::vector<double> player_returns;
+    for (const std::vector<double>& game_returns : returns) {
+      player_returns.push_back(game_returns[p]);
+    }
+    values.push_back(Estimate(player_returns));
+  }
+  return values;
+}
+
+NashConvEstimate ApproximateNashConv(const Game& game, const Policy& policy,
+                                     const LocalBestResponseConfig& config) {
+  NashConvEstimate estimate;
+  double variance = 0;
+  for (Player p = 0; p < game.NumPlayers(); ++p) {
+    estimate.best_response_values.push_back(
+        LocalBestResponseValue(game, policy, p, config));
+    estimate.nash_conv.mean += estimate.best_response_values.back().mean;
+    variance += std::pow(estimate.best_response_values.back().std_error, 2);
+  }
+  const GameType::Utility utility = game.GetType().utility;
+  if (utility == GameType::Utility::kZeroSum ||
+      utility == GameType::Utility::kConstantSum) {
+    estimate.nash_conv.mean -= game.UtilitySum();
+  } else {
+    estimate.on_policy_values = OnPolicyValues(game, policy, config);
+    // The values are estimated from the same games, so the variance of their
+    // sum is not that of the sum of independent estimates: it is bounded by
+    // (sum of std errors)^2, which is used here.
+    double std_error = 0;
+    for (const MonteCarloEstimate& value : estimate.on_policy_values) {
+      estimate.nash_conv.mean -= value.mean;
+      std_error += value.std_error;
+    }
+    variance += std_error * std_error;
+  }
+  estimate.nash_conv.num_samples = game.NumPlayers() * config.num_games;
+  estimate.nash_conv.std_error = std::sqrt(variance);
+  estimate.nash_conv.lower =
+      estimate.nash_conv.mean - 1.96 * estimate.nash_conv.std_error;
+  estimate.nash_conv.upper =
+      estimate.nash_conv.mean + 1.96 * estimate.nash_conv.std_error;
+  return estimate;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
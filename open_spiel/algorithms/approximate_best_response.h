@@ -0,0 +1,101 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_APPROXIMATE_BEST_RESPONSE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_APPROXIMATE_BEST_RESPONSE_H_
+
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// Sampling-based estimates of the exploitability of a policy, for games too
+// large for TabularBestResponse, which needs the whole game tree.
+//
+// They play games between the policy and a local best response (Lisy and
+// Bowling, "Equilibrium Approximation Quality of Current No-Limit Poker Bots",
+// 2017, https://arxiv.org/abs/1612.07547). At each of its decisions,
+// the local best response samples histories of its information state with
+// State::ResampleFromInfostate, weighted by the opponents' probabilities of
+// reaching them under the policy, and picks the action with the best average
+// return over rollouts from them. In the rollouts, the other players follow
+// the policy, and the responder maximizes in the same way over its next
+// lookahead_depth - 1 decisions, then follows the policy too.
+//
+// Since the local best response is a strategy like any other, its value is a
+// lower bound on that of a best response, up to sampling error, and so is the
+// estimated NashConv. ResampleFromInfostate samples the private chance
+// outcomes uniformly, so the beliefs are only exact when they are uniform, as
+// in poker.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct LocalBestResponseConfig {
+  // The number of games played for each estimate.
+  int num_games = 1000;
+  // The histories sampled from the belief at each decision, and the rollouts
+  // from each of them for each action.
+  int num_belief_samples = 32;
+  int num_rollouts = 1;
+  // The number of the responder's decisions maximized over, from the current
+  // one, before it follows the policy.
+  int lookahead_depth = 1;
+  int num_threads = 1;
+  int seed = 0;
+};
+
+// The mean of independent samples, its standard error, and the 95%
+// confidence interval mean +/- 1.96 std_error.
+struct MonteCarloEstimate {
+  int num_samples = 0;
+  double mean = 0;
+  double std_error = 0;
+  double lower = 0;
+  double upper = 0;
+};
+
+// Estimates the value of a local best response of `player` against the
+// policy of the other players. The games are played on config.num_threads
+// threads, so the policy must be thread-safe, and each game uses its own
+// random numbers, so that the estimate does not depend on the number of
+// threads.
+MonteCarloEstimate LocalBestResponseValue(
+    const Game& game, const Policy& policy, Player player,
+    const LocalBestResponseConfig& config);
+
+// Estimates the values of the players under the policy from config.num_games
+// games of self-play.
+std::vector<MonteCarloEstimate> OnPolicyValues(
+    const Game& game, const Policy& policy,
+    const LocalBestResponseConfig& config);
+
+struct NashConvEstimate {
+  std::vector<MonteCarloEstimate> best_response_values;
+  // Empty for constant-sum games, whose values under the policy sum to
+  // Game::UtilitySum().
+  std::vector<MonteCarloEstimate> on_policy_values;
+  // The sum over the players of the gains of their local best responses.
+  MonteCarloEstimate nash_conv;
+};
+
+// Estimates NashConv(game, policy) with local best responses, a lower bound
+// of it up to sampling error.
+NashConvEstimate ApproximateNashConv(const Game& game, const Policy& policy,
+                                     const LocalBestResponseConfig& config);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_APPROXIMATE_BEST_RESPONSE_H_
@@ -0,0 +1,115 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/approximate_best_response.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void PrintEstimate(const std::string& name, const MonteCarloEstimate& value) {
+  std::cout << name << ": " << value.mean << " +/- " << 1.96 * value.std_error
+            << " (" << value.num_samples << " samples)" << std::endl;
+}
+
+// The estimate bounds the exact NashConv from below, and is close to it in
+// Kuhn poker, where two decisions of lookahead cover a whole game.
+void KuhnPokerUniformPolicy() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  const double exact = NashConv(*game, policy);
+  LocalBestResponseConfig config;
+  config.num_games = 2000;
+  config.lookahead_depth = 2;
+  config.num_threads = 4;
+  NashConvEstimate estimate = ApproximateNashConv(*game, policy, config);
+  PrintEstimate("Kuhn uniform NashConv", estimate.nash_conv);
+  std::cout << "Exact: " << exact << std::endl;
+  SPIEL_CHECK_EQ(estimate.best_response_values.size(), 2);
+  SPIEL_CHECK_TRUE(estimate.on_policy_values.empty());
+  SPIEL_CHECK_EQ(estimate.nash_conv.num_samples, 4000);
+  SPIEL_CHECK_GT(estimate.nash_conv.std_error, 0);
+  SPIEL_CHECK_LE(estimate.nash_conv.lower, exact);
+  SPIEL_CHECK_GT(estimate.nash_conv.upper, 0.8 * exact);
+}
+
+// Close to an equilibrium, no local best response gains much.
+void KuhnPokerCFRPolicy() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  for (int i = 0; i < 300; ++i) solver.EvaluateAndUpdatePolicy();
+  TabularPolicy policy(*game, *solver.AveragePolicy());
+  LocalBestResponseConfig config;
+  config.num_games = 2000;
+  NashConvEstimate estimate = ApproximateNashConv(*game, policy, config);
+  PrintEstimate("Kuhn CFR NashConv", estimate.nash_conv);
+  SPIEL_CHECK_LT(estimate.nash_conv.lower, 0.02);
+  SPIEL_CHECK_LT(estimate.nash_conv.mean, 0.1);
+}
+
+// Each game has its own random numbers.
+void DoesNotDependOnThreads() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  LocalBestResponseConfig config;
+  config.num_games = 40;
+  config.num_belief_samples = 8;
+  config.seed = 3;
+  const MonteCarloEstimate serial =
+      LocalBestResponseValue(*game, policy, 1, config);
+  config.num_threads = 3;
+  const MonteCarloEstimate parallel =
+      LocalBestResponseValue(*game, policy, 1, config);
+  SPIEL_CHECK_EQ(serial.mean, parallel.mean);
+  SPIEL_CHECK_EQ(serial.std_error, parallel.std_error);
+  // Uniform play loses a lot in Leduc poker.
+  SPIEL_CHECK_GT(serial.mean, 0);
+}
+
+// In perfect information games, the state is the belief.
+void PerfectInformationGame() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  LocalBestResponseConfig config;
+  config.num_games = 100;
+  config.num_rollouts = 4;
+  const MonteCarloEstimate value =
+      LocalBestResponseValue(*game, policy, 0, config);
+  PrintEstimate("Tic-tac-toe value against uniform", value);
+  const std::vector<MonteCarloEstimate> on_policy =
+      OnPolicyValues(*game, policy, config);
+  SPIEL_CHECK_EQ(on_policy.size(), 2);
+  SPIEL_CHECK_GT(value.mean, on_policy[0].mean);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::KuhnPokerUniformPolicy();
+  open_spiel::algorithms::KuhnPokerCFRPolicy();
+  open_spiel::algorithms::DoesNotDependOnThreads();
+  open_spiel::algorithms::PerfectInformationGame();
+}
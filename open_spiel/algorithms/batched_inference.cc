@@ -0,0 +1,498 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/batched_inference.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/hash/hash.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/lru_cache.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+InferenceBackendRegisterer uniform_registerer(
+    "uniform", [](const Game& game, const std::string& path) {
+      return std::make_unique<UniformInferenceModel>(game);
+    });
+
+// Runs the model on decision nodes, writing their policies and values.
+void InferStates(const InferenceModel& model,
+                 absl::Span<const State* const> states,
+                 std::vector<float>* policies, std::vector<float>* values) {
+  const int input_size = model.InputSize();
+  const int num_actions = model.NumActions();
+  const int batch_size = states.size();
+  std::vector<float> inputs(batch_size * input_size);
+  std::vector<float> legal_masks(batch_size * num_actions);
+  for (int b = 0; b < batch_size; ++b) {
+    FillInferenceRow(
+        *states[b],
+        absl::MakeSpan(inputs).subspan(b * input_size, input_size),
+        absl::MakeSpan(legal_masks).subspan(b * num_actions, num_actions));
+  }
+  policies->resize(batch_size * num_actions);
+  if (values != nullptr) values->resize(batch_size);
+  model.Infer(
+      batch_size, inputs, legal_masks, absl::MakeSpan(*policies),
+      values == nullptr ? absl::Span<float>() : absl::MakeSpan(*values));
+}
+
+// The legal actions of `state` with their probabilities in a policy row.
+ActionsAndProbs RowPolicy(const State& state, absl::Span<const float> row) {
+  ActionsAndProbs policy;
+  for (Action action : state.LegalActions()) {
+    policy.emplace_back(action, row[action]);
+  }
+  return policy;
+}
+}  // namespace
+
+int InferenceInputSize(const Game& game) {
+  return game.GetType().provides_information_state_tensor
+             ? game.InformationStateTensorSize()
+             : game.ObservationTensorSize();
+}
+
+void FillInferenceRow(const State& state, absl::Span<float> input,
+                      absl::Span<float> legal_mask) {
+  const Player player = state.CurrentPlayer();
+  if (state.GetGame()->GetType().provides_information_state_tensor) {
+    state.InformationStateTensor(player, input);
+  } else {
+    state.ObservationTensor(player, input);
+  }
+  state.LegalActionsMask(player, legal_mask);
+}
+
+void UniformInferenceModel::Infer(int batch_size,
+                                  absl::Span<const float> inputs,
+                                  absl::Span<const float> legal_masks,
+                                  absl::Span<float> policies,
+                                  absl::Span<float> values) const {
+  SPIEL_CHECK_EQ(inputs.size(), batch_size * input_size_);
+  SPIEL_CHECK_EQ(legal_masks.size(), batch_size * num_actions_);
+  SPIEL_CHECK_EQ(policies.size(), batch_size * num_actions_);
+  for (int b = 0; b < batch_size; ++b) {
+    absl::Span<const float> mask =
+        legal_masks.subspan(b * num_actions_, num_actions_);
+    float num_legal = 0;
+    for (float legal : mask) num_legal += legal;
+    SPIEL_CHECK_GT(num_legal, 0);
+    for (int a = 0; a < num_actions_; ++a) {
+      policies[b * num_actions_ + a] = mask[a] / num_legal;
+    }
+  }
+  if (!values.empty()) {
+    SPIEL_CHECK_EQ(values.size(), batch_size);
+    std::fill(values.begin(), values.end(), 0);
+  }
+}
+
+InferenceBackendRegisterer::InferenceBackendRegisterer(
+    const std::string& backend, CreateFunc creator) {
+  factories()[backend] = std::move(creator);
+}
+
+std::unique_ptr<InferenceModel> InferenceBackendRegisterer::CreateByName(
+    const std::string& backend, const Game& game, const std::string& path) {
+  auto iter = factories().find(backend);
+  if (iter == factories().end()) {
+    SpielFatalError(absl::StrCat("Unknown inference backend '", backend,
+                                 "'. Available backends are:\n",
+                                 absl::StrJoin(RegisteredNames(), "\n")));
+  }
+  std::unique_ptr<InferenceModel> model = iter->second(game, path);
+  SPIEL_CHECK_EQ(model->InputSize(), InferenceInputSize(game));
+  SPIEL_CHECK_EQ(model->NumActions(), game.NumDistinctActions());
+  return model;
+}
+
+std::vector<std::string> InferenceBackendRegisterer::RegisteredNames() {
+  std::vector<std::string> names;
+  for (const auto& key_val : factories()) names.push_back(key_val.first);
+  return names;
+}
+
+std::unique_ptr<InferenceModel> LoadInferenceModel(const std::string& backend,
+                                                   const Game& game,
+                                                   const std::string& path) {
+  return InferenceBackendRegisterer::CreateByName(backend, game, path);
+}
+
+BatchingInferenceModel::BatchingInferenceModel(
+    std::shared_ptr<const InferenceModel> model, int max_batch_size,
+    int num_servers, absl::Duration batch_timeout, int cache_size,
+    int cache_shards)
+    : input_size_(model->InputSize()),
+      num_actions_(model->NumActions()),
+      max_batch_size_(max_batch_size),
+      batch_timeout_(batch_timeout),
+      model_(std::move(model)) {
+  SPIEL_CHECK_GT(max_batch_size, 0);
+  SPIEL_CHECK_GT(num_servers, 0);
+  if (cache_size > 0) {
+    cache_ = std::make_unique<ShardedLRUCache<uint64_t, std::vector<float>>>(
+        cache_size, cache_shards);
+  }
+  servers_.reserve(num_servers);
+  for (int i = 0; i < num_servers; ++i) {
+    servers_.emplace_back([this]() { ServerLoop(); });
+  }
+}
+
+BatchingInferenceModel::~BatchingInferenceModel() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+    queued_cv_.SignalAll();
+  }
+  for (Thread& server : servers_) server.join();
+}
+
+void BatchingInferenceModel::SetModel(
+    std::shared_ptr<const InferenceModel> model) {
+  SPIEL_CHECK_EQ(model->InputSize(), input_size_);
+  SPIEL_CHECK_EQ(model->NumActions(), num_actions_);
+  absl::MutexLock lock(&mu_);
+  model_ = std::move(model);
+  ++model_version_;
+  if (cache_ != nullptr) cache_->Clear();
+}
+
+std::shared_ptr<const InferenceModel> BatchingInferenceModel::Model() const {
+  absl::MutexLock lock(&mu_);
+  return model_;
+}
+
+LRUCacheInfo BatchingInferenceModel::CacheInfo() const {
+  return cache_ == nullptr ? LRUCacheInfo() : cache_->Info();
+}
+
+void BatchingInferenceModel::ClearCache() {
+  absl::MutexLock lock(&mu_);
+  if (cache_ != nullptr) cache_->Clear();
+}
+
+int64_t BatchingInferenceModel::NumBatches() const {
+  absl::MutexLock lock(&mu_);
+  return num_batches_;
+}
+
+int64_t BatchingInferenceModel::NumRows() const {
+  absl::MutexLock lock(&mu_);
+  return num_rows_;
+}
+
+uint64_t BatchingInferenceModel::RowKey(absl::Span<const float> input,
+                                        absl::Span<const float> legal_mask) {
+  return absl::Hash<std::pair<absl::Span<const float>,
+                              absl::Span<const float>>>()({input, legal_mask});
+}
+
+void BatchingInferenceModel::Infer(int batch_size,
+                                   absl::Span<const float> inputs,
+                                   absl::Span<const float> legal_masks,
+                                   absl::Span<float> policies,
+                                   absl::Span<float> values) const {
+  SPIEL_CHECK_EQ(inputs.size(), batch_size * input_size_);
+  SPIEL_CHECK_EQ(legal_masks.size(), batch_size * num_actions_);
+  SPIEL_CHECK_EQ(policies.size(), batch_size * num_actions_);
+  if (!values.empty()) SPIEL_CHECK_EQ(values.size(), batch_size);
+  if (batch_size == 0) return;
+
+  // The rows missing from the cache.
+  std::vector<int> missing;
+  if (cache_ == nullptr) {
+    missing.resize(batch_size);
+    for (int b = 0; b < batch_size; ++b) missing[b] = b;
+  } else {
+    for (int b = 0; b < batch_size; ++b) {
+      std::optional<const std::vector<float>> cached = cache_->Get(RowKey(
+          inputs.subspan(b * input_size_, input_size_),
+          legal_masks.subspan(b * num_actions_, num_actions_)));
+      if (!cached) {
+        missing.push_back(b);
+        continue;
+      }
+      std::copy(cached->begin(), cached->begin() + num_actions_,
+                policies.begin() + b * num_actions_);
+      if (!values.empty()) values[b] = cached->back();
+    }
+  }
+  if (missing.empty()) return;
+
+  // Only the missing rows are queued, copied together unless they are all of
+  // them.
+  const int num_missing = missing.size();
+  const bool all_missing = num_missing == batch_size;
+  std::vector<float> missing_inputs;
+  std::vector<float> missing_masks;
+  std::vector<float> missing_policies;
+  std::vector<float> missing_values;
+  Request request{num_missing, inputs, legal_masks, policies, values};
+  if (!all_missing) {
+    missing_inputs.reserve(num_missing * input_size_);
+    missing_masks.reserve(num_missing * num_actions_);
+    for (int b : missing) {
+      absl::Span<const float> input =
+          inputs.subspan(b * input_size_, input_size_);
+      absl::Span<const float> mask =
+          legal_masks.subspan(b * num_actions_, num_actions_);
+      missing_inputs.insert(missing_inputs.end(), input.begin(), input.end());
+      missing_masks.insert(missing_masks.end(), mask.begin(), mask.end());
+    }
+    missing_policies.resize(num_missing * num_actions_);
+    if (!values.empty()) missing_values.resize(num_missing);
+    request.inputs = missing_inputs;
+    request.legal_masks = missing_masks;
+    request.policies = absl::MakeSpan(missing_policies);
+    request.values = absl::MakeSpan(missing_values);
+  }
+
+  {
+    absl::MutexLock lock(&mu_);
+    queue_.push_back(&request);
+    queued_rows_ += num_missing;
+    queued_cv_.Signal();
+    while (!request.done) done_cv_.Wait(&mu_);
+  }
+
+  if (!all_missing) {
+    for (int i = 0; i < num_missing; ++i) {
+      std::copy(missing_policies.begin() + i * num_actions_,
+                missing_policies.begin() + (i + 1) * num_actions_,
+                policies.begin() + missing[i] * num_actions_);
+      if (!values.empty()) values[missing[i]] = missing_values[i];
+    }
+  }
+}
+
+void BatchingInferenceModel::ServerLoop() {
+  while (true) {
+    std::vector<Request*> batch;
+    std::shared_ptr<const InferenceModel> model;
+    int64_t version;
+    {
+      absl::MutexLock lock(&mu_);
+      while (queue_.empty() && !stop_) queued_cv_.Wait(&mu_);
+      if (queue_.empty()) return;
+      // Wait a little for more rows to fill the batch.
+      const absl::Time deadline = absl::Now() + batch_timeout_;
+      while (!stop_ && queued_rows_ < max_batch_size_ &&
+             absl::Now() < deadline) {
+        queued_cv_.WaitWithDeadline(&mu_, deadline);
+      }
+      // Another server may have taken them meanwhile.
+      if (queue_.empty()) continue;
+      // The requests of a batch either all want values or none do, as models
+      // without a value head fail if asked for them. A request larger than
+      // max_batch_size is run alone.
+      const bool with_values = !queue_.front()->values.empty();
+      int num_rows = 0;
+      for (auto it = queue_.begin(); it != queue_.end();) {
+        Request* request = *it;
+        if (request->values.empty() == with_values) {
+          ++it;
+          continue;
+        }
+        if (num_rows > 0 && num_rows + request->batch_size > max_batch_size_) {
+          break;
+        }
+        num_rows += request->batch_size;
+        batch.push_back(request);
+        it = queue_.erase(it);
+      }
+      queued_rows_ -= num_rows;
+      model = model_;
+      version = model_version_;
+    }
+    RunBatch(batch, *model, version);
+  }
+}
+
+void BatchingInferenceModel::RunBatch(const std::vector<Request*>& requests,
+                                      const InferenceModel& model,
+                                      int64_t version) {
+  const bool with_values = !requests[0]->values.empty();
+  int num_rows = 0;
+  for (const Request* request : requests) num_rows += request->batch_size;
+  if (requests.size() == 1) {
+    Request& request = *requests[0];
+    model.Infer(num_rows, request.inputs, request.legal_masks,
+                request.policies, request.values);
+  } else {
+    std::vector<float> inputs;
+    std::vector<float> legal_masks;
+    inputs.reserve(num_rows * input_size_);
+    legal_masks.reserve(num_rows * num_actions_);
+    for (const Request* request : requests) {
+      inputs.insert(inputs.end(), request->inputs.begin(),
+                    request->inputs.end());
+      legal_masks.insert(legal_masks.end(), request->legal_masks.begin(),
+                         request->legal_masks.end());
+    }
+    std::vector<float> policies(num_rows * num_actions_);
+    std::vector<float> values(with_values ? num_rows : 0);
+    model.Infer(num_rows, inputs, legal_masks, absl::MakeSpan(policies),
+                absl::MakeSpan(values));
+    int row = 0;
+    for (Request* request : requests) {
+      std::copy(policies.begin() + row * num_actions_,
+                policies.begin() + (row + request->batch_size) * num_actions_,
+                request->policies.begin());
+      if (with_values) {
+        std::copy(values.begin() + row, values.begin() + row +
+                  request->batch_size, request->values.begin());
+      }
+      row += request->batch_size;
+    }
+  }
+
+  absl::MutexLock lock(&mu_);
+  // Only results with values are cached, which serve calls either way.
+  if (cache_ != nullptr && with_values && version == model_version_) {
+    for (const Request* request : requests) {
+      for (int b = 0; b < request->batch_size; ++b) {
+        absl::Span<const float> policy =
+            request->policies.subspan(b * num_actions_, num_actions_);
+        std::vector<float> entry(policy.begin(), policy.end());
+        entry.push_back(request->values[b]);
+        cache_->Set(RowKey(request->inputs.subspan(b * input_size_,
+                                                   input_size_),
+                           request->legal_masks.subspan(b * num_actions_,
+                                                        num_actions_)),
+                    entry);
+      }
+    }
+  }
+  for (Request* request : requests) request->done = true;
+  ++num_batches_;
+  num_rows_ += num_rows;
+  done_cv_.SignalAll();
+}
+
+std::vector<double> InferenceEvaluator::Evaluate(const State& state) {
+  const State* states[] = {&state};
+  return std::move(EvaluateBatch(states)[0]);
+}
+
+std::vector<std::vector<double>> InferenceEvaluator::EvaluateBatch(
+    absl::Span<const State* const> states) {
+  std::vector<std::vector<double>> returns(states.size());
+  // The decision nodes are run in one batch, and the children of the chance
+  // nodes in another, recursively.
+  std::vector<int> decisions;
+  std::vector<const State*> decision_states;
+  std::vector<int> chance_parents;
+  std::vector<double> chance_probs;
+  std::vector<std::unique_ptr<State>> chance_children;
+  for (int i = 0; i < states.size(); ++i) {
+    const State& state = *states[i];
+    if (state.IsTerminal()) {
+      returns[i] = state.Returns();
+    } else if (state.IsChanceNode()) {
+      returns[i].assign(state.NumPlayers(), 0);
+      for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+        chance_parents.push_back(i);
+        chance_probs.push_back(prob);
+        chance_children.push_back(state.Child(outcome));
+      }
+    } else {
+      SPIEL_CHECK_EQ(state.NumPlayers(), 2);
+      decisions.push_back(i);
+      decision_states.push_back(&state);
+    }
+  }
+  if (!decisions.empty()) {
+    std::vector<float> policies;
+    std::vector<float> values;
+    InferStates(*model_, decision_states, &policies, &values);
+    const int num_actions = model_->NumActions();
+    for (int b = 0; b < decisions.size(); ++b) {
+      priors_.Set(decision_states[b]->Hash(),
+                  std::vector<float>(
+                      policies.begin() + b * num_actions,
+                      policies.begin() + (b + 1) * num_actions));
+      const Player player = decision_states[b]->CurrentPlayer();
+      std::vector<double>& state_returns = returns[decisions[b]];
+      state_returns.assign(2, -values[b]);
+      state_returns[player] = values[b];
+    }
+  }
+  if (!chance_children.empty()) {
+    std::vector<const State*> children;
+    children.reserve(chance_children.size());
+    for (const auto& child : chance_children) children.push_back(child.get());
+    std::vector<std::vector<double>> child_returns = EvaluateBatch(children);
+    for (int c = 0; c < children.size(); ++c) {
+      std::vector<double>& state_returns = returns[chance_parents[c]];
+      for (int p = 0; p < state_returns.size(); ++p) {
+        state_returns[p] += chance_probs[c] * child_returns[c][p];
+      }
+    }
+  }
+  return returns;
+}
+
+ActionsAndProbs InferenceEvaluator::Prior(const State& state) {
+  if (state.IsChanceNode()) return state.ChanceOutcomes();
+  std::optional<const std::vector<float>> row = priors_.Get(state.Hash());
+  if (row) return RowPolicy(state, *row);
+  const State* states[] = {&state};
+  std::vector<float> policies;
+  InferStates(*model_, states, &policies, /*values=*/nullptr);
+  return RowPolicy(state, policies);
+}
+
+ActionsAndProbs InferencePolicy::GetStatePolicy(const State& state) const {
+  const State* states[] = {&state};
+  ActionsAndProbs policy;
+  GetStatePolicies(states, absl::MakeSpan(&policy, 1));
+  return policy;
+}
+
+void InferencePolicy::GetStatePolicies(
+    absl::Span<const State* const> states,
+    absl::Span<ActionsAndProbs> policies) const {
+  SPIEL_CHECK_EQ(states.size(), policies.size());
+  if (states.empty()) return;
+  std::vector<float> probs;
+  InferStates(*model_, states, &probs, /*values=*/nullptr);
+  const int num_actions = model_->NumActions();
+  for (int i = 0; i < states.size(); ++i) {
+    policies[i] = RowPolicy(
+        *states[i], absl::MakeConstSpan(probs).subspan(i * num_actions,
+                                                       num_actions));
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,276 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_BATCHED_INFERENCE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_BATCHED_INFERENCE_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/utils/lru_cache.h"
+#include "open_spiel/utils/thread.h"
+
+// A policy and value network run on batches of states in C++, independently
+// of the framework it was trained with, so that self-play, MCTSBot and policy
+// bots can use it without going through Python.
+//
+// A batch is given as contiguous, row-major float buffers: the inputs are the
+// State::InformationStateTensor of the player to move in each state, or the
+// State::ObservationTensor for games without information state tensors, and
+// the legal action masks are the State::LegalActionsMask of that player.
+// Backends
+// for a framework (e.g. TorchScript, ONNX Runtime, or TensorFlow in
+// contrib/tf_trajectories.h) implement InferenceModel, and are registered by
+// name to be loaded with LoadInferenceModel.
+
+namespace open_spiel {
+namespace algorithms {
+
+class InferenceModel {
+ public:
+  virtual ~InferenceModel() = default;
+
+  // The sizes of the rows of the inputs, and of the masks and policies.
+  virtual int InputSize() const = 0;
+  virtual int NumActions() const = 0;
+
+  // Runs the network on batch_size rows: `inputs` is [batch_size,
+  // InputSize()] and `legal_masks` [batch_size, NumActions()]. Writes the
+  // probabilities of the actions, which are 0 for illegal ones, into the
+  // [batch_size, NumActions()] `policies`, and the values of the states for
+  // the player to move into the [batch_size] `values`, unless it is empty.
+  // Models without a value head fail if asked for values.
+  //
+  // This must be thread-safe, as MCTSBot may evaluate from several threads.
+  virtual void Infer(int batch_size, absl::Span<const float> inputs,
+                     absl::Span<const float> legal_masks,
+                     absl::Span<float> policies,
+                     absl::Span<float> values) const = 0;
+};
+
+// Returns the size of the inputs of the game's models.
+int InferenceInputSize(const Game& game);
+
+// Writes the input and legal action mask of the player to move in `state`,
+// a decision node, into rows of the buffers of a batch.
+void FillInferenceRow(const State& state, absl::Span<float> input,
+                      absl::Span<float> legal_mask);
+
+// A model playing uniformly over the legal actions, with values of 0, e.g. to
+// test the code using models, or as a baseline.
+class UniformInferenceModel : public InferenceModel {
+ public:
+  UniformInferenceModel(int input_size, int num_actions)
+      : input_size_(input_size), num_actions_(num_actions) {}
+  explicit UniformInferenceModel(const Game& game)
+      : UniformInferenceModel(InferenceInputSize(game),
+                              game.NumDistinctActions()) {}
+
+  int InputSize() const override { return input_size_; }
+  int NumActions() const override { return num_actions_; }
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override;
+
+ private:
+  int input_size_;
+  int num_actions_;
+};
+
+// Registers the backends of LoadInferenceModel, as GameRegisterer does for
+// games, e.g. with a static
+//   InferenceBackendRegisterer registerer("onnx", CreateOnnxModel);
+// in the file implementing the backend.
+class InferenceBackendRegisterer {
+ public:
+  // Creates the model of `game` stored at `path`, in the format of the
+  // backend.
+  using CreateFunc = std::function<std::unique_ptr<InferenceModel>(
+      const Game& game, const std::string& path)>;
+
+  InferenceBackendRegisterer(const std::string& backend, CreateFunc creator);
+
+  static std::unique_ptr<InferenceModel> CreateByName(
+      const std::string& backend, const Game& game, const std::string& path);
+  static std::vector<std::string> RegisteredNames();
+
+ private:
+  static std::map<std::string, CreateFunc>& factories() {
+    static std::map<std::string, CreateFunc> impl;
+    return impl;
+  }
+};
+
+// Returns the model of `game` at `path`, loaded by a registered backend. The
+// "uniform" backend ignores the path and returns a UniformInferenceModel.
+std::unique_ptr<InferenceModel> LoadInferenceModel(const std::string& backend,
+                                                   const Game& game,
+                                                   const std::string& path);
+
+// A model merging the Infer calls of many threads, e.g. the MCTSBots of
+// self-play actors, into batches of up to max_batch_size rows for another
+// model, so that an accelerator runs them at a useful batch size. Each of
+// num_servers threads takes the calls queued so far, waiting up to
+// batch_timeout for more while the batch is not full, runs them together and
+// wakes their callers. Having a few servers lets a batch be prepared while
+// another runs.
+//
+// With cache_size > 0, the results are cached by their input and legal mask
+// rows, in a ShardedLRUCache shared by all the callers, and only the rows
+// missing from it are queued.
+//
+// SetModel swaps the model for the following batches, e.g. for a new
+// checkpoint of a learner, without stopping the callers, and clears the
+// cache.
+class BatchingInferenceModel : public InferenceModel {
+ public:
+  BatchingInferenceModel(std::shared_ptr<const InferenceModel> model,
+                         int max_batch_size, int num_servers = 1,
+                         absl::Duration batch_timeout = absl::Milliseconds(1),
+                         int cache_size = 0, int cache_shards = 16);
+
+  // Stops the servers once the queued calls are done.
+  ~BatchingInferenceModel() override;
+
+  BatchingInferenceModel(const BatchingInferenceModel&) = delete;
+  BatchingInferenceModel& operator=(const BatchingInferenceModel&) = delete;
+
+  int InputSize() const override { return input_size_; }
+  int NumActions() const override { return num_actions_; }
+
+  // Blocks until the rows have been run in some batch.
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override;
+
+  // The model must have the same sizes.
+  void SetModel(std::shared_ptr<const InferenceModel> model);
+  std::shared_ptr<const InferenceModel> Model() const;
+
+  LRUCacheInfo CacheInfo() const;
+  void ClearCache();
+
+  // The number of batches run by the servers and of the rows in them.
+  int64_t NumBatches() const;
+  int64_t NumRows() const;
+
+ private:
+  // The rows of an Infer call missing from the cache.
+  struct Request {
+    int batch_size;
+    absl::Span<const float> inputs;
+    absl::Span<const float> legal_masks;
+    absl::Span<float> policies;
+    absl::Span<float> values;  // Empty if the call did not want values.
+    bool done = false;
+  };
+
+  void ServerLoop();
+
+  // Runs the requests in one batch with `model`, of the given version, and
+  // writes their results.
+  void RunBatch(const std::vector<Request*>& requests,
+                const InferenceModel& model, int64_t version);
+
+  // The cache key of a row.
+  static uint64_t RowKey(absl::Span<const float> input,
+                         absl::Span<const float> legal_mask);
+
+  const int input_size_;
+  const int num_actions_;
+  const int max_batch_size_;
+  const absl::Duration batch_timeout_;
+
+  mutable absl::Mutex mu_;
+  mutable absl::CondVar queued_cv_;
+  mutable absl::CondVar done_cv_;
+  std::shared_ptr<const InferenceModel> model_ ABSL_GUARDED_BY(mu_);
+  mutable std::deque<Request*> queue_ ABSL_GUARDED_BY(mu_);
+  mutable int queued_rows_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t num_batches_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t num_rows_ ABSL_GUARDED_BY(mu_) = 0;
+  // Incremented by SetModel, so that batches run by an older model are not
+  // cached.
+  int64_t model_version_ ABSL_GUARDED_BY(mu_) = 0;
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+
+  // The policy of each cached row, followed by its value. Only written with
+  // mu_ held, so that SetModel can clear it of the older model's results.
+  std::unique_ptr<ShardedLRUCache<uint64_t, std::vector<float>>> cache_;
+  std::vector<Thread> servers_;
+};
+
+// An evaluator for MCTSBot running a model on the states, with a single call
+// to Infer for the states of an EvaluateBatch. For 2-player zero-sum games:
+// the value of a state is that of the model for the player to move, and its
+// opposite for the other player. Terminal states are valued by their returns,
+// and chance nodes by the chance-weighted values of their children.
+//
+// The policies computed along with the values are kept in an LRU cache of
+// prior_cache_size entries keyed by State::Hash, from which Prior reads them,
+// so that MCTSBot expanding a node it has evaluated does not run the model
+// again. On a miss, Prior runs the model on the state alone. It returns the
+// chance outcomes of a chance node.
+class InferenceEvaluator : public Evaluator {
+ public:
+  explicit InferenceEvaluator(std::shared_ptr<const InferenceModel> model,
+                              int prior_cache_size = 4096)
+      : model_(std::move(model)), priors_(prior_cache_size) {}
+
+  std::vector<double> Evaluate(const State& state) override;
+  std::vector<std::vector<double>> EvaluateBatch(
+      absl::Span<const State* const> states) override;
+  ActionsAndProbs Prior(const State& state) override;
+
+  LRUCacheInfo PriorCacheInfo() { return priors_.Info(); }
+
+ private:
+  std::shared_ptr<const InferenceModel> model_;
+  // The policy row of the model for each cached state.
+  ShardedLRUCache<uint64_t, std::vector<float>> priors_;
+};
+
+// The policy of a model, for decision nodes, e.g. for
+//   MakePolicyBot(game, player, seed,
+//                 std::make_unique<InferencePolicy>(model));
+class InferencePolicy : public Policy {
+ public:
+  explicit InferencePolicy(std::shared_ptr<const InferenceModel> model)
+      : model_(std::move(model)) {}
+
+  ActionsAndProbs GetStatePolicy(const State& state) const override;
+  // Runs the model once on all the states.
+  void GetStatePolicies(absl::Span<const State* const> states,
+                        absl::Span<ActionsAndProbs> policies) const override;
+
+ private:
+  std::shared_ptr<const InferenceModel> model_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_BATCHED_INFERENCE_H_
@@ -0,0 +1,291 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/batched_inference.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// A uniform model valuing the states by the sum of their inputs, so that the
+// states of a batch get different values.
+class InputSumModel : public UniformInferenceModel {
+ public:
+  explicit InputSumModel(const Game& game) : UniformInferenceModel(game) {}
+
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override {
+    UniformInferenceModel::Infer(batch_size, inputs, legal_masks, policies,
+                                 values);
+    for (int b = 0; b < values.size(); ++b) {
+      values[b] = 0;
+      for (float input : inputs.subspan(b * InputSize(), InputSize())) {
+        values[b] += 0.1 * input;
+      }
+    }
+  }
+};
+
+void LoadsUniformBackend() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<InferenceModel> model =
+      LoadInferenceModel("uniform", *game, /*path=*/"");
+  SPIEL_CHECK_EQ(model->InputSize(), InferenceInputSize(*game));
+  SPIEL_CHECK_EQ(model->NumActions(), game->NumDistinctActions());
+}
+
+void InferencePolicyIsUniform() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  InferencePolicy policy(std::make_shared<UniformInferenceModel>(*game));
+  UniformPolicy uniform;
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->LegalActions()[0]);
+      continue;
+    }
+    ActionsAndProbs expected = uniform.GetStatePolicy(*state);
+    ActionsAndProbs actual = policy.GetStatePolicy(*state);
+    const State* states[] = {state.get(), state.get()};
+    std::vector<ActionsAndProbs> batch(2);
+    policy.GetStatePolicies(states, absl::MakeSpan(batch));
+    SPIEL_CHECK_TRUE(batch[0] == actual);
+    SPIEL_CHECK_TRUE(batch[1] == actual);
+    SPIEL_CHECK_EQ(actual.size(), expected.size());
+    for (int i = 0; i < actual.size(); ++i) {
+      SPIEL_CHECK_EQ(actual[i].first, expected[i].first);
+      SPIEL_CHECK_FLOAT_EQ(actual[i].second, expected[i].second);
+    }
+    state->ApplyAction(state->LegalActions().back());
+  }
+}
+
+// The values of a batch must be those of the states evaluated alone, and
+// those of chance nodes the expectation over their children.
+void EvaluateBatchMatchesEvaluate() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  InferenceEvaluator evaluator(std::make_shared<InputSumModel>(*game));
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::vector<std::unique_ptr<State>> leaves;
+  std::vector<double> probs;
+  for (const auto& [first, first_prob] : root->ChanceOutcomes()) {
+    std::unique_ptr<State> dealt = root->Child(first);
+    for (const auto& [second, second_prob] : dealt->ChanceOutcomes()) {
+      leaves.push_back(dealt->Child(second));
+      probs.push_back(first_prob * second_prob);
+    }
+  }
+  std::vector<const State*> states;
+  for (const auto& leaf : leaves) states.push_back(leaf.get());
+  std::vector<std::vector<double>> values = evaluator.EvaluateBatch(states);
+  std::vector<double> expected(2, 0);
+  for (int i = 0; i < states.size(); ++i) {
+    std::vector<double> value = evaluator.Evaluate(*states[i]);
+    SPIEL_CHECK_EQ(value.size(), 2);
+    for (Player p = 0; p < 2; ++p) {
+      SPIEL_CHECK_FLOAT_EQ(values[i][p], value[p]);
+      expected[p] += probs[i] * value[p];
+    }
+    SPIEL_CHECK_FLOAT_EQ(value[0], -value[1]);
+  }
+  std::vector<double> root_value = evaluator.Evaluate(*root);
+  for (Player p = 0; p < 2; ++p) {
+    SPIEL_CHECK_FLOAT_EQ(root_value[p], expected[p]);
+  }
+}
+
+void MCTSBotWithInferenceEvaluator() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  InferenceEvaluator evaluator(std::make_shared<InputSumModel>(*game));
+  MCTSBot bot(*game, &evaluator, /*uct_c=*/2, /*max_simulations=*/100,
+              /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/42,
+              /*verbose=*/false, ChildSelectionPolicy::PUCT,
+              /*dirichlet_alpha=*/0, /*dirichlet_epsilon=*/0,
+              /*num_threads=*/1, /*virtual_loss=*/1, /*batch_size=*/8);
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) state->ApplyAction(bot.Step(*state));
+}
+
+void PolicyBotWithInferencePolicy() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::shared_ptr<const InferenceModel> model =
+      std::make_shared<UniformInferenceModel>(*game);
+  std::unique_ptr<Bot> bot = MakePolicyBot(
+      *game, /*player_id=*/0, /*seed=*/3,
+      std::make_unique<InferencePolicy>(model));
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->LegalActions()[0]);
+    } else {
+      state->ApplyAction(bot->Step(*state));
+    }
+  }
+}
+
+// A model offsetting the values of InputSumModel, and counting its calls.
+class OffsetModel : public InputSumModel {
+ public:
+  OffsetModel(const Game& game, float offset)
+      : InputSumModel(game), offset_(offset) {}
+
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override {
+    num_calls_ += 1;
+    InputSumModel::Infer(batch_size, inputs, legal_masks, policies, values);
+    for (float& value : values) value += offset_;
+  }
+
+  int NumCalls() const { return num_calls_; }
+
+ private:
+  float offset_;
+  mutable std::atomic<int> num_calls_{0};
+};
+
+// Prior reuses the policies of the evaluated states, and only runs the model
+// for the others.
+void PriorReusesEvaluatedPolicies() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  auto model = std::make_shared<OffsetModel>(*game, 0);
+  InferenceEvaluator evaluator(model);
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::vector<std::unique_ptr<State>> children;
+  std::vector<const State*> states;
+  for (Action action : root->LegalActions()) {
+    children.push_back(root->Child(action));
+    states.push_back(children.back().get());
+  }
+  evaluator.EvaluateBatch(states);
+  SPIEL_CHECK_EQ(model->NumCalls(), 1);
+  InferencePolicy policy(std::make_shared<UniformInferenceModel>(*game));
+  for (const State* state : states) {
+    SPIEL_CHECK_TRUE(evaluator.Prior(*state) == policy.GetStatePolicy(*state));
+  }
+  SPIEL_CHECK_EQ(model->NumCalls(), 1);
+  SPIEL_CHECK_EQ(evaluator.PriorCacheInfo().hits, states.size());
+  SPIEL_CHECK_TRUE(evaluator.Prior(*root) == policy.GetStatePolicy(*root));
+  SPIEL_CHECK_EQ(model->NumCalls(), 2);
+}
+
+// The values of the states of a game for the player to move.
+std::vector<float> RowValues(const InferenceModel& model,
+                             absl::Span<const State* const> states) {
+  std::vector<float> inputs(states.size() * model.InputSize());
+  std::vector<float> masks(states.size() * model.NumActions());
+  for (int b = 0; b < states.size(); ++b) {
+    FillInferenceRow(*states[b],
+                     absl::MakeSpan(inputs).subspan(b * model.InputSize(),
+                                                    model.InputSize()),
+                     absl::MakeSpan(masks).subspan(b * model.NumActions(),
+                                                   model.NumActions()));
+  }
+  std::vector<float> policies(states.size() * model.NumActions());
+  std::vector<float> values(states.size());
+  model.Infer(states.size(), inputs, masks, absl::MakeSpan(policies),
+              absl::MakeSpan(values));
+  return values;
+}
+
+// Concurrent calls get the results of the model, in fewer batches.
+void BatchingModelMergesCalls() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  auto inner = std::make_shared<OffsetModel>(*game, 0);
+  auto batching = std::make_shared<BatchingInferenceModel>(
+      inner, /*max_batch_size=*/16, /*num_servers=*/2, absl::Milliseconds(5));
+  InferencePolicy inner_policy(inner);
+  InferencePolicy batching_policy(batching);
+  constexpr int kNumThreads = 8;
+  std::atomic<int> num_rows{0};
+  std::vector<Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::unique_ptr<State> state = game->NewInitialState();
+      while (!state->IsTerminal()) {
+        const std::vector<Action> actions = state->LegalActions();
+        std::unique_ptr<State> child =
+            state->Child(actions[t % actions.size()]);
+        if (child->IsTerminal()) break;
+        const State* states[] = {state.get(), child.get()};
+        std::vector<float> expected = RowValues(*inner, states);
+        std::vector<float> actual = RowValues(*batching, states);
+        for (int b = 0; b < 2; ++b) {
+          SPIEL_CHECK_FLOAT_EQ(actual[b], expected[b]);
+        }
+        // Calls without values are batched separately.
+        SPIEL_CHECK_TRUE(inner_policy.GetStatePolicy(*state) ==
+                         batching_policy.GetStatePolicy(*state));
+        num_rows += 3;
+        state = std::move(child);
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+  SPIEL_CHECK_EQ(batching->NumRows(), num_rows.load());
+  SPIEL_CHECK_GT(batching->NumBatches(), 0);
+  SPIEL_CHECK_LE(batching->NumBatches(), batching->NumRows());
+}
+
+// Cached rows are not run again, until the model is swapped.
+void BatchingModelCachesAndSwaps() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  auto first = std::make_shared<OffsetModel>(*game, 0);
+  auto second = std::make_shared<OffsetModel>(*game, 1);
+  BatchingInferenceModel batching(first, /*max_batch_size=*/8,
+                                  /*num_servers=*/1, absl::ZeroDuration(),
+                                  /*cache_size=*/64);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::unique_ptr<State> child = state->Child(4);
+  const State* states[] = {state.get(), child.get()};
+  std::vector<float> values = RowValues(batching, states);
+  SPIEL_CHECK_EQ(first->NumCalls(), 1);
+  SPIEL_CHECK_TRUE(RowValues(batching, states) == values);
+  SPIEL_CHECK_EQ(first->NumCalls(), 1);
+  SPIEL_CHECK_EQ(batching.CacheInfo().hits, 2);
+
+  batching.SetModel(second);
+  SPIEL_CHECK_EQ(batching.CacheInfo().size, 0);
+  std::vector<float> swapped = RowValues(batching, states);
+  SPIEL_CHECK_EQ(second->NumCalls(), 1);
+  for (int b = 0; b < 2; ++b) SPIEL_CHECK_FLOAT_EQ(swapped[b], values[b] + 1);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::LoadsUniformBackend();
+  open_spiel::algorithms::InferencePolicyIsUniform();
+  open_spiel::algorithms::EvaluateBatchMatchesEvaluate();
+  open_spiel::algorithms::MCTSBotWithInferenceEvaluator();
+  open_spiel::algorithms::PriorReusesEvaluatedPolicies();
+  open_spiel::algorithms::PolicyBotWithInferencePolicy();
+  open_spiel::algorithms::BatchingModelMergesCalls();
+  open_spiel::algorithms::BatchingModelCachesAndSwaps();
+}
@@ -14,76 +14,254 @@
 
 #include "open_spiel/algorithms/best_response.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/profiler.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
 
+namespace {
+
+// Returns the index of the child of `node` reached with `action`.
+int ChildIndex(const CompactHistoryTree& tree,
+               const CompactHistoryTree::Node& node, Action action) {
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
+    if (tree.GetNode(child).action == action) return child;
+  }
+  SpielFatalError(absl::StrCat("Error getting child; action ", action,
+                               " not found."));
+}
+
+}  // namespace
+
 TabularBestResponse::TabularBestResponse(const Game& game,
                                          Player best_responder,
                                          const Policy* policy)
+    : TabularBestResponse(
+          game, best_responder, policy,
+          std::make_shared<CompactHistoryTree>(*game.NewInitialState())) {}
+
+TabularBestResponse::TabularBestResponse(
+    const Game& game, Player best_responder,
+    const std::unordered_map<std::string, ActionsAndProbs>& policy_table)
+    : TabularBestResponse(
+          game, best_responder, /*policy=*/nullptr,
+          std::make_shared<CompactHistoryTree>(*game.NewInitialState())) {
+  tabular_policy_container_ = TabularPolicy(policy_table);
+  SetPolicy(&tabular_policy_container_);
+}
+
+TabularBestResponse::TabularBestResponse(
+    const Game& game, Player best_responder, const Policy* policy,
+    std::shared_ptr<CompactHistoryTree> tree, int num_threads)
     : best_responder_(best_responder),
       tabular_policy_container_(),
       policy_(policy),
-      tree_(HistoryTree(game.NewInitialState(), best_responder_)),
+      tree_(std::move(tree)),
       num_players_(game.NumPlayers()),
-      infosets_(GetAllInfoSets(game.NewInitialState(), best_responder, policy,
-                               &tree_)),
-      root_(game.NewInitialState()),
-      dummy_policy_(new TabularPolicy(GetUniformPolicy(game))) {
+      num_threads_(num_threads),
+      reach_probs_(tree_->NumNodes(),
+                   std::numeric_limits<double>::quiet_NaN()),
+      opponent_policies_(tree_->NumInfoStates()),
+      best_response_actions_(tree_->NumInfoStates(), kInvalidAction),
+      value_cache_(tree_->NumNodes(),
+                   std::numeric_limits<double>::quiet_NaN()),
+      root_(game.NewInitialState()) {
   if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
+  SPIEL_CHECK_GE(num_threads_, 1);
+  if (policy != nullptr) SetPolicy(policy);
 }
 
-TabularBestResponse::TabularBestResponse(
-    const Game& game, Player best_responder,
-    const std::unordered_map<std::string, ActionsAndProbs>& policy_table)
-    : best_responder_(best_responder),
-      tabular_policy_container_(policy_table),
-      policy_(&tabular_policy_container_),
-      tree_(HistoryTree(game.NewInitialState(), best_responder_)),
-      num_players_(game.NumPlayers()),
-      infosets_(GetAllInfoSets(game.NewInitialState(), best_responder, policy_,
-                               &tree_)),
-      root_(game.NewInitialState()),
-      dummy_policy_(new TabularPolicy(GetUniformPolicy(game))) {
-  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
-    SpielFatalError("The game must be turn-based.");
+std::unordered_map<std::string, Action>
+TabularBestResponse::GetBestResponseActions() {
+  // We fill the best_response_actions_ cache by calculating all best
+  // responses, starting at the root. This only computes the ones that are
+  // not cached, e.g. those invalidated by SetPolicy.
+  ComputeBestResponses();
+  NodeValue(tree_->Root());
+  std::unordered_map<std::string, Action> best_response_actions;
+  for (int i = 0; i < best_response_actions_.size(); ++i) {
+    if (best_response_actions_[i] != kInvalidAction) {
+      best_response_actions[tree_->InfoStateString(i)] =
+          best_response_actions_[i];
+    }
+  }
+  return best_response_actions;
+}
+
+void TabularBestResponse::SetPolicy(const Policy* policy) {
+  policy_ = policy;
+  std::vector<int> info_states;
+  for (int i = 0; i < tree_->NumInfoStates(); ++i) {
+    if (tree_->InfoStatePlayer(i) != best_responder_) info_states.push_back(i);
+  }
+  ApplyPolicyChanges(UpdateOpponentPolicies(info_states));
+}
+
+void TabularBestResponse::UpdatePolicy(
+    const std::vector<std::string>& info_states) {
+  SPIEL_CHECK_TRUE(policy_ != nullptr);
+  std::vector<int> indices;
+  indices.reserve(info_states.size());
+  for (const std::string& info_state : info_states) {
+    const int i = tree_->InfoStateIndex(info_state);
+    if (i < 0 || tree_->InfoStatePlayer(i) == best_responder_) {
+      SpielFatalError(absl::StrCat("Infostate ", info_state,
+                                   " is not one of the other players'."));
+    }
+    indices.push_back(i);
   }
+  ApplyPolicyChanges(UpdateOpponentPolicies(indices));
 }
 
-double TabularBestResponse::HandleTerminalCase(const HistoryNode& node) const {
-  return node.GetValue();
+std::vector<int> TabularBestResponse::UpdateOpponentPolicies(
+    const std::vector<int>& info_states) {
+  std::vector<const State*> states;
+  states.reserve(info_states.size());
+  for (int i : info_states) states.push_back(&tree_->InfoStateState(i));
+  std::vector<ActionsAndProbs> state_policies(info_states.size());
+  OPEN_SPIEL_PROFILE(
+      "best_response/GetStatePolicies",
+      policy_->GetStatePolicies(states, absl::MakeSpan(state_policies)));
+  std::vector<int> changed_info_states;
+  for (int k = 0; k < info_states.size(); ++k) {
+    const int i = info_states[k];
+    if (state_policies[k].empty()) {
+      SpielFatalError(tree_->InfoStateString(i) + " not found in policy.");
+    }
+    if (state_policies[k] == opponent_policies_[i]) continue;
+    opponent_policies_[i] = std::move(state_policies[k]);
+    changed_info_states.push_back(i);
+  }
+  return changed_info_states;
 }
 
-double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
-  if (node == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
-  if (node->GetState()->CurrentPlayer() == best_responder_) {
+void TabularBestResponse::ApplyPolicyChanges(
+    const std::vector<int>& changed_info_states) {
+  std::vector<int> dirty_infosets;
+  if (!reach_probs_set_) {
+    // Nothing is cached yet.
+    reach_probs_set_ = true;
+    reach_probs_[tree_->Root()] = 1.0;
+    UpdateReachProbs(tree_->Root(), &dirty_infosets);
+    return;
+  }
+  std::vector<bool> changed(tree_->NumInfoStates(), false);
+  for (int i : changed_info_states) changed[i] = true;
+  for (int i : changed_info_states) {
+    for (int index : tree_->InfoStateNodes(i)) {
+      // The reach probabilities below a changed ancestor are already updated.
+      bool below_change = false;
+      for (int parent = tree_->GetNode(index).parent;
+           !below_change && parent >= 0;
+           parent = tree_->GetNode(parent).parent) {
+        const CompactHistoryTree::Node& node = tree_->GetNode(parent);
+        below_change = node.type == StateType::kDecision &&
+                       changed[node.info_state];
+      }
+      if (!below_change) UpdateReachProbs(index, &dirty_infosets);
+      InvalidateNode(index, &dirty_infosets);
+    }
+  }
+  // The values of all the histories of an information state whose best
+  // response may have changed may change too, and so on up the tree.
+  while (!dirty_infosets.empty()) {
+    const int i = dirty_infosets.back();
+    dirty_infosets.pop_back();
+    for (int index : tree_->InfoStateNodes(i)) {
+      InvalidateNode(index, &dirty_infosets);
+    }
+  }
+}
+
+void TabularBestResponse::UpdateReachProbs(int index,
+                                           std::vector<int>* dirty_infosets) {
+  const CompactHistoryTree::Node& node = tree_->GetNode(index);
+  if (node.type == StateType::kTerminal) return;
+  const ActionsAndProbs* state_policy =
+      node.type == StateType::kDecision && !IsBestResponderNode(node)
+          ? &opponent_policies_[node.info_state]
+          : nullptr;
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
+    const CompactHistoryTree::Node& child_node = tree_->GetNode(child);
+    // Counterfactual probabilities are 1 for the best responder's actions,
+    // and the tree stores the chance probabilities.
+    const double action_prob = state_policy != nullptr
+                                   ? GetProb(*state_policy, child_node.action)
+                                   : child_node.probability;
+    SPIEL_CHECK_GE(action_prob, 0);
+    const double reach_prob = reach_probs_[index] * action_prob;
+    if (reach_prob != reach_probs_[child]) {
+      reach_probs_[child] = reach_prob;
+      // The best response of an information state depends on the
+      // probabilities of its histories.
+      if (IsBestResponderNode(child_node)) {
+        InvalidateBestResponse(child_node.info_state, dirty_infosets);
+      }
+    }
+    UpdateReachProbs(child, dirty_infosets);
+  }
+}
+
+void TabularBestResponse::InvalidateNode(int index,
+                                         std::vector<int>* dirty_infosets) {
+  // A node is only cached if all its children are, and a best response if
+  // all the children of its histories are, so this can stop at the first
+  // node that is not cached.
+  while (index >= 0) {
+    const CompactHistoryTree::Node& node = tree_->GetNode(index);
+    if (IsBestResponderNode(node)) {
+      InvalidateBestResponse(node.info_state, dirty_infosets);
+    }
+    if (std::isnan(value_cache_[index])) return;
+    value_cache_[index] = std::numeric_limits<double>::quiet_NaN();
+    index = node.parent;
+  }
+}
+
+void TabularBestResponse::InvalidateBestResponse(
+    int info_state, std::vector<int>* dirty_infosets) {
+  if (best_response_actions_[info_state] == kInvalidAction) return;
+  best_response_actions_[info_state] = kInvalidAction;
+  dirty_infosets->push_back(info_state);
+}
+
+double TabularBestResponse::HandleDecisionCase(
+    const CompactHistoryTree::Node& node) {
+  if (node.player == best_responder_) {
     // If we're playing as the best responder, we look at every child node,
     // and pick the one with the highest expected utility to play.
-    Action action = BestResponseAction(node->GetInfoState());
-    HistoryNode* child = node->GetChild(action).second;
-    if (child == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
-    return Value(child->GetHistory());
+    Action action = InfoStateBestResponse(node.info_state);
+    return NodeValue(ChildIndex(*tree_, node, action));
   }
   // If the other player is playing, then we can recursively compute the
   // expected utility of that node by looking at their policy.
   // We take child probabilities from the policy as that is what we are
   // calculating a best response to.
-  ActionsAndProbs state_policy = policy_->GetStatePolicy(*node->GetState());
-  if (state_policy.empty())
-    SpielFatalError(absl::StrCat("InfoState ", node->GetInfoState(),
-                                 " not found in policy."));
-  if (state_policy.size() > node->NumChildren()) {
+  const ActionsAndProbs& state_policy = opponent_policies_[node.info_state];
+  if (state_policy.size() > node.num_children) {
     int num_zeros = 0;
     for (const auto& a_and_p : state_policy) {
       if (Near(a_and_p.second, 0.)) ++num_zeros;
@@ -91,7 +269,7 @@ double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
     // We check here that the policy is valid, i.e. that it doesn't contain too
     // many (invalid) actions. This can only happen when the policy is built
     // incorrectly. If this is failing, you are building the policy wrong.
-    if (state_policy.size() > node->NumChildren() + num_zeros) {
+    if (state_policy.size() > node.num_children + num_zeros) {
       std::vector<std::string> action_probs_str_vector;
       action_probs_str_vector.reserve(state_policy.size());
       for (const auto& action_prob : state_policy) {
@@ -103,58 +281,111 @@ double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
           absl::StrJoin(action_probs_str_vector, " ");
 
       SpielFatalError(absl::StrCat(
-          "Policies don't match in size, in state ",
-          node->GetState()->HistoryString(), ".\nThe tree has '",
-          node->NumChildren(), "' valid children, but ", state_policy.size(),
+          "Policies don't match in size, in information state ",
+          tree_->InfoStateString(node.info_state), ".\nThe tree has '",
+          node.num_children, "' valid children, but ", state_policy.size(),
           " valid (action, prob) are available: [", action_probs_str, "]"));
     }
   }
   double value = 0;
-  for (const auto& action : node->GetState()->LegalActions()) {
-    // We discard the probability here that's returned by GetChild as we
-    // immediately load the probability for the given child from the policy.
-    HistoryNode* child = node->GetChild(action).second;
-
-    if (child == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
-
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
     // Finally, we update value by the policy weighted value of the child.
-    const double prob = GetProb(state_policy, action);
+    const double prob = GetProb(state_policy, tree_->GetNode(child).action);
     SPIEL_CHECK_GE(prob, 0);
-    value += prob * Value(child->GetHistory());
+    value += prob * NodeValue(child);
   }
   return value;
 }
 
-double TabularBestResponse::HandleChanceCase(HistoryNode* node) {
+double TabularBestResponse::HandleChanceCase(
+    const CompactHistoryTree::Node& node) {
   double value = 0;
-  double prob_sum = 0;
-  for (const auto& action : node->GetChildActions()) {
-    std::pair<double, HistoryNode*> prob_and_child = node->GetChild(action);
-    double prob = prob_and_child.first;
-    prob_sum += prob;
-    HistoryNode* child = prob_and_child.second;
-    if (child == nullptr) SpielFatalError("Child is null.");
-
-    // Verify that the probability is valid. This should always be true.
-    SPIEL_CHECK_GE(prob, 0.);
-    SPIEL_CHECK_LE(prob, 1.);
-    value += prob * Value(child->GetHistory());
-  }
-
-  // Verify that the sum of the probabilities is 1, within tolerance.
-  SPIEL_CHECK_FLOAT_EQ(prob_sum, 1.0);
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
+    // The tree checked that the probabilities are valid and sum to 1.
+    value += tree_->GetNode(child).probability * NodeValue(child);
+  }
   return value;
 }
 
 double TabularBestResponse::Value(const std::string& history) {
-  auto it = value_cache_.find(history);
-  if (it != value_cache_.end()) return it->second;
-  HistoryNode* node = tree_.GetByHistory(history);
-  if (node == nullptr) SpielFatalError("node returned is null.");
+  OPEN_SPIEL_PROFILE_SCOPE("best_response/Value");
+  const int index = tree_->NodeIndex(history);
+  ComputeBestResponses();
+  return NodeValue(index);
+}
+
+void TabularBestResponse::ComputeBestResponses() {
+  if (num_threads_ == 1) return;
+  if (!info_state_levels_set_) {
+    info_state_levels_set_ = true;
+    std::vector<int> info_state_depths(tree_->NumInfoStates(), -1);
+    if (SetInfoStateDepths(tree_->Root(), 0, &info_state_depths)) {
+      for (int i = 0; i < info_state_depths.size(); ++i) {
+        const int depth = info_state_depths[i];
+        if (depth < 0) continue;
+        if (depth >= info_state_levels_.size()) {
+          info_state_levels_.resize(depth + 1);
+        }
+        info_state_levels_[depth].push_back(i);
+      }
+    }
+  }
+  // The values below the information states of a level only depend on the
+  // best responses of the deeper levels, and their subtrees do not overlap.
+  for (int level = info_state_levels_.size() - 1; level >= 0; --level) {
+    std::vector<int> info_states;
+    for (int i : info_state_levels_[level]) {
+      if (best_response_actions_[i] == kInvalidAction) {
+        info_states.push_back(i);
+      }
+    }
+    const int num_threads =
+        std::min<int>(num_threads_, info_states.size());
+    if (num_threads <= 1) {
+      for (int i : info_states) InfoStateBestResponse(i);
+      continue;
+    }
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([this, &info_states, num_threads, t]() {
+        for (int i = t; i < info_states.size(); i += num_threads) {
+          InfoStateBestResponse(info_states[i]);
+        }
+      });
+    }
+    for (Thread& thread : threads) thread.join();
+  }
+}
+
+bool TabularBestResponse::SetInfoStateDepths(
+    int index, int depth, std::vector<int>* info_state_depths) const {
+  const CompactHistoryTree::Node& node = tree_->GetNode(index);
+  if (node.type == StateType::kTerminal) return true;
+  if (IsBestResponderNode(node)) {
+    int& info_state_depth = (*info_state_depths)[node.info_state];
+    if (info_state_depth >= 0 && info_state_depth != depth) return false;
+    info_state_depth = depth;
+    ++depth;
+  }
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
+    if (!SetInfoStateDepths(child, depth, info_state_depths)) return false;
+  }
+  return true;
+}
+
+double TabularBestResponse::NodeValue(int index) {
+  if (!std::isnan(value_cache_[index])) return value_cache_[index];
+  const CompactHistoryTree::Node& node = tree_->GetNode(index);
   double cache_value = 0;
-  switch (node->GetType()) {
+  switch (node.type) {
     case StateType::kTerminal: {
-      cache_value = HandleTerminalCase(*node);
+      // Conveniently, the game tells us the value of every terminal node, so
+      // we have nothing to do.
+      cache_value = tree_->PlayerReturn(index, best_responder_);
       break;
     }
     case StateType::kDecision: {
@@ -166,27 +397,43 @@ double TabularBestResponse::Value(const std::string& history) {
       break;
     }
   }
-  value_cache_[history] = cache_value;
-  return value_cache_[history];
+  value_cache_[index] = cache_value;
+  return cache_value;
 }
 
 Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
-  auto it = best_response_actions_.find(infostate);
-  if (it != best_response_actions_.end()) return it->second;
-  std::vector<std::pair<HistoryNode*, double>> infoset = infosets_[infostate];
+  const int info_state = tree_->InfoStateIndex(infostate);
+  if (info_state < 0 || tree_->InfoStatePlayer(info_state) != best_responder_) {
+    SpielFatalError(absl::StrCat("Infostate ", infostate,
+                                 " is not one of the best responder's."));
+  }
+  ComputeBestResponses();
+  return InfoStateBestResponse(info_state);
+}
+
+Action TabularBestResponse::InfoStateBestResponse(int info_state) {
+  if (best_response_actions_[info_state] != kInvalidAction) {
+    return best_response_actions_[info_state];
+  }
+  const std::vector<int>& infoset = tree_->InfoStateNodes(info_state);
+  SPIEL_CHECK_FALSE(infoset.empty());
 
   Action best_action = -1;
   double best_value = std::numeric_limits<double>::lowest();
-  // The legal actions are the same for all children, so we arbitrarily pick the
-  // first one to get the legal actions from.
-  for (const auto& action : infoset[0].first->GetChildActions()) {
+  // The legal actions are the same for all histories, and the children are
+  // sorted by action, so the i-th children of all of them have the same
+  // action.
+  const CompactHistoryTree::Node& first_node = tree_->GetNode(infoset[0]);
+  for (int i = 0; i < first_node.num_children; ++i) {
+    const Action action = tree_->GetNode(first_node.first_child + i).action;
     double value = 0;
-    // Prob here is the counterfactual reach-weighted probability.
-    for (const auto& state_and_prob : infoset) {
-      HistoryNode* state_node = state_and_prob.first;
-      HistoryNode* child_node = state_node->GetChild(action).second;
-      SPIEL_CHECK_TRUE(child_node != nullptr);
-      value += state_and_prob.second * Value(child_node->GetHistory());
+    // The value is weighted by the counterfactual reach probabilities.
+    for (int index : infoset) {
+      const CompactHistoryTree::Node& node = tree_->GetNode(index);
+      SPIEL_CHECK_EQ(node.num_children, first_node.num_children);
+      const int child = node.first_child + i;
+      SPIEL_CHECK_EQ(tree_->GetNode(child).action, action);
+      value += reach_probs_[index] * NodeValue(child);
     }
     if (value > best_value) {
       best_value = value;
@@ -194,7 +441,7 @@ Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
     }
   }
   if (best_action == -1) SpielFatalError("No action was chosen.");
-  best_response_actions_[infostate] = best_action;
+  best_response_actions_[info_state] = best_action;
   return best_action;
 }
 
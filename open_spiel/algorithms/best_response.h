@@ -17,8 +17,12 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
@@ -32,6 +36,9 @@ namespace algorithms {
 // policy, where the best responder plays as player_id.
 // This only works for two player, zero- or constant-sum sequential games, and
 // raises a SpielFatalError if an incompatible game is passed to it.
+// The game tree is kept as a CompactHistoryTree, which can be shared between
+// several best responses, and the policy is only looked up once per
+// information state of the other players.
 class TabularBestResponse {
  public:
   TabularBestResponse(const Game& game, Player best_responder,
@@ -39,6 +46,21 @@ class TabularBestResponse {
   TabularBestResponse(
       const Game& game, Player best_responder,
       const std::unordered_map<std::string, ActionsAndProbs>& policy_table);
+  // Uses a tree of the game, e.g. to share it between the best responses of
+  // several players. Only the Value of the root may then be asked for
+  // concurrently with another best response on the same tree.
+  //
+  // With num_threads > 1, the best responses are computed in parallel, bottom
+  // up: the best responder's information states are grouped by the number of
+  // best responder's decisions above them, and the groups are computed from
+  // the deepest one, each information state of a group (and the values below
+  // it) by one thread. This requires perfect recall for the best responder,
+  // without which they are computed serially, and the policy to be
+  // thread-safe.
+  TabularBestResponse(const Game& game, Player best_responder,
+                      const Policy* policy,
+                      std::shared_ptr<CompactHistoryTree> tree,
+                      int num_threads = 1);
 
   TabularBestResponse(TabularBestResponse&&) = default;
 
@@ -52,16 +74,14 @@ class TabularBestResponse {
   // calculated, then we calculate them for every state in the game.
   // When two actions have the same value, we
   // return the action with the lowest number (as an int).
-  std::unordered_map<std::string, Action> GetBestResponseActions() {
-    // If the best_response_actions_ cache is empty, we fill it by calculating
-    // all best responses, starting at the root.
-    if (best_response_actions_.empty()) Value(root_->ToString());
-    return best_response_actions_;
-  }
+  std::unordered_map<std::string, Action> GetBestResponseActions();
 
   // Returns the computed best response as a policy object.
   TabularPolicy GetBestResponsePolicy() {
-    SPIEL_CHECK_TRUE(dummy_policy_ != nullptr);
+    if (dummy_policy_ == nullptr) {
+      dummy_policy_ = std::make_unique<TabularPolicy>(
+          GetUniformPolicy(*root_->GetGame()));
+    }
     return TabularPolicy(*dummy_policy_, GetBestResponseActions());
   }
 
@@ -72,15 +92,18 @@ class TabularBestResponse {
   // Changes the policy that we are calculating a best response to. This is
   // useful as a large amount of the data structures can be reused, causing
   // the calculation to be quicker than if we had to re-initialize the class.
-  void SetPolicy(const Policy* policy) {
-    policy_ = policy;
-    value_cache_.clear();
-    best_response_actions_.clear();
-    // TODO(author1): Replace this with something that traverses the tree
-    // and rebuilds the probabilities.
-    infosets_ =
-        GetAllInfoSets(root_->Clone(), best_responder_, policy_, &tree_);
-  }
+  // The policy is looked up at every information state of the other players,
+  // but only what depends on those where it changed since the last call is
+  // recomputed: the counterfactual reach probabilities below them, and the
+  // values and best responses above them or above histories whose reach
+  // probability changed.
+  void SetPolicy(const Policy* policy);
+
+  // As SetPolicy with the current policy, when it only changed at
+  // `info_states`, information states of the other players. Only the policy
+  // at those is looked up, so the cost is proportional to the size of the
+  // change.
+  void UpdatePolicy(const std::vector<std::string>& info_states);
 
   // Set the policy given a policy table. This stores the table internally.
   void SetPolicy(
@@ -90,20 +113,60 @@ class TabularBestResponse {
   }
 
  private:
+  // Returns the value of the node at `index` of tree_, with the value cache.
+  double NodeValue(int index);
+
+  // Returns the best response at the information state at index `info_state`
+  // of tree_, with the best response cache.
+  Action InfoStateBestResponse(int info_state);
+
   // For chance nodes, we recursively calculate the value of each child node,
   // and weight them by the probability of reaching each child.
-  double HandleChanceCase(HistoryNode* node);
+  double HandleChanceCase(const CompactHistoryTree::Node& node);
 
-  // Calculates the value of the HistoryNode when we have to make a decision.
+  // Calculates the value of the node when we have to make a decision.
   // Does this by calculating the value of each possible child node and then
   // setting the value of the current node equal to the maximum (as we can just
   // choose the best child).
-  double HandleDecisionCase(HistoryNode* node);
-
-  // Calculates the value of the HistoryNode when the node is a terminal node.
-  // Conveniently, the game tells us the value of every terminal node, so we
-  // have nothing to do.
-  double HandleTerminalCase(const HistoryNode& node) const;
+  double HandleDecisionCase(const CompactHistoryTree::Node& node);
+
+  // Stores the policy at the information states at indices `info_states` of
+  // tree_, queried in a single batch, and returns those whose policy changed.
+  std::vector<int> UpdateOpponentPolicies(const std::vector<int>& info_states);
+
+  // Updates the reach probabilities and the caches after the policy changed
+  // at `changed_info_states`, indices of the other players' information
+  // states.
+  void ApplyPolicyChanges(const std::vector<int>& changed_info_states);
+
+  // Recomputes the counterfactual reach probabilities below the node at
+  // `index`, and invalidates the best responses of the information states of
+  // the histories whose probability changed.
+  void UpdateReachProbs(int index, std::vector<int>* dirty_infosets);
+
+  // Invalidates the cached values of the node at `index` and its ancestors,
+  // and the best responses of the best responder's histories among them.
+  void InvalidateNode(int index, std::vector<int>* dirty_infosets);
+
+  // Invalidates the best response of `info_state`, adding it to
+  // `dirty_infosets` if it was cached.
+  void InvalidateBestResponse(int info_state,
+                              std::vector<int>* dirty_infosets);
+
+  // Computes the best responses that are not cached with num_threads_
+  // threads, as described in the constructor.
+  void ComputeBestResponses();
+
+  // Sets the number of best responder's decisions above the nodes of each of
+  // their information states below the node at `index`, at `depth`, in
+  // `info_state_depths`, and returns false if they are not the same for all
+  // the nodes of an information state.
+  bool SetInfoStateDepths(int index, int depth,
+                          std::vector<int>* info_state_depths) const;
+
+  bool IsBestResponderNode(const CompactHistoryTree::Node& node) const {
+    return node.type == StateType::kDecision && node.player == best_responder_;
+  }
 
   Player best_responder_;
 
@@ -113,29 +176,36 @@ class TabularBestResponse {
   // The actual policy that we are computing a best response to.
   const Policy* policy_;
 
-  HistoryTree tree_;
+  std::shared_ptr<CompactHistoryTree> tree_;
   int num_players_;
-
-  // Maps infoset strings (from the State::InformationState method) to
-  // the HistoryNodes that represent all histories with
-  // the same information state, along with the counter-factual probability of
-  // doing so. If the information state is a chance node, the probability comes
-  // from the State::ChanceOutcomes method. If the information state is a
-  // decision node for best_responder, the probability is one, following the
-  // definition of counter-factual probability. Finally, if the information
-  // state is a decision node for a player other than best_responder, the
-  // probabilities come from their policy (i.e. policy_).
-  std::unordered_map<std::string, std::vector<std::pair<HistoryNode*, double>>>
-      infosets_;
-
-  // Caches all best responses calculated so far (for each infostate).
-  std::unordered_map<std::string, Action> best_response_actions_;
-
-  // Caches all values calculated so far (for each history).
-  std::unordered_map<std::string, double> value_cache_;
+  int num_threads_;
+
+  // The best responder's information states, by the number of best
+  // responder's decisions above them, when they are computed in parallel.
+  // Empty if not computed yet or if that number is not the same for all the
+  // nodes of an information state.
+  std::vector<std::vector<int>> info_state_levels_;
+  bool info_state_levels_set_ = false;
+
+  // The counter-factual probability of reaching each node of tree_: the
+  // product of the chance probabilities and the probabilities of the other
+  // players' policies (i.e. policy_) along the history.
+  std::vector<double> reach_probs_;
+  bool reach_probs_set_ = false;
+
+  // The policy at each information state of the other players at the last
+  // SetPolicy call. Empty for best_responder's information states.
+  std::vector<ActionsAndProbs> opponent_policies_;
+
+  // Caches all best responses calculated so far, kInvalidAction if not.
+  std::vector<Action> best_response_actions_;
+
+  // Caches all values calculated so far (for each node), NaN if not.
+  std::vector<double> value_cache_;
   std::unique_ptr<State> root_;
 
-  // Keep a cache of an empty policy to avoid recomputing it.
+  // Keep a cache of an empty policy to avoid recomputing it. It covers every
+  // information state of the game, so it is only built when needed.
   std::unique_ptr<TabularPolicy> dummy_policy_;
 };
 
@@ -18,8 +18,12 @@
 #include <cstddef>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
+#include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/algorithms/minimax.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/goofspiel.h"
@@ -369,6 +373,87 @@ void KuhnPokerUniformBestResponseAfterSwitchingPolicies() {
                                           best_responses);
 }
 
+// Changing the policy at a few information states at a time only updates what
+// depends on them, which must give the same results as a new best response.
+void LeducPokerIncrementalSetPolicy() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  const std::string root_history = game->NewInitialState()->ToString();
+  TabularPolicy policy = GetUniformPolicy(*game);
+  std::vector<std::unique_ptr<TabularBestResponse>> responses;
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    responses.push_back(
+        std::make_unique<TabularBestResponse>(*game, p, &policy));
+    responses[p]->Value(root_history);
+  }
+  // The same, with the changed information states given to UpdatePolicy.
+  std::vector<std::unique_ptr<TabularBestResponse>> updated_responses;
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    updated_responses.push_back(
+        std::make_unique<TabularBestResponse>(*game, p, &policy));
+    updated_responses[p]->Value(root_history);
+  }
+  int changes = 0;
+  for (int step = 0; step < 5; ++step) {
+    std::vector<std::vector<std::string>> changed_info_states(
+        game->NumPlayers());
+    for (auto& [info_state, actions_and_probs] : policy.PolicyTable()) {
+      // Put all the probability on the first action at one information state
+      // in 50.
+      if (++changes % 50 != 0) continue;
+      for (auto& [action, prob] : actions_and_probs) prob = 0;
+      actions_and_probs[0].second = 1;
+      // The information state strings of leduc_poker start with the player.
+      const Player player = info_state.find("[Player: 0]") != std::string::npos
+                                ? Player{0}
+                                : Player{1};
+      changed_info_states[1 - player].push_back(info_state);
+    }
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      responses[p]->SetPolicy(&policy);
+      updated_responses[p]->UpdatePolicy(changed_info_states[p]);
+      TabularBestResponse new_response(*game, p, &policy);
+      SPIEL_CHECK_TRUE(responses[p]->GetBestResponseActions() ==
+                       new_response.GetBestResponseActions());
+      SPIEL_CHECK_TRUE(updated_responses[p]->GetBestResponseActions() ==
+                       new_response.GetBestResponseActions());
+      SPIEL_CHECK_EQ(responses[p]->Value(root_history),
+                     new_response.Value(root_history));
+      SPIEL_CHECK_EQ(updated_responses[p]->Value(root_history),
+                     new_response.Value(root_history));
+    }
+  }
+}
+
+// The parallel best responses, on a shared tree, must match the serial ones,
+// including after SetPolicy.
+void LeducPokerParallelBestResponse() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  const std::string root_history = game->NewInitialState()->ToString();
+  auto tree = std::make_shared<CompactHistoryTree>(*game->NewInitialState());
+  TabularPolicy policy = GetUniformPolicy(*game);
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    TabularBestResponse serial_response(*game, p, &policy);
+    TabularBestResponse parallel_response(*game, p, &policy, tree,
+                                          /*num_threads=*/3);
+    SPIEL_CHECK_EQ(serial_response.Value(root_history),
+                   parallel_response.Value(root_history));
+    SPIEL_CHECK_TRUE(serial_response.GetBestResponseActions() ==
+                     parallel_response.GetBestResponseActions());
+  }
+  TabularPolicy first_action_policy = GetFirstActionPolicy(*game);
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    TabularBestResponse serial_response(*game, p, &first_action_policy);
+    TabularBestResponse parallel_response(*game, p, &policy, tree,
+                                          /*num_threads=*/3);
+    parallel_response.Value(root_history);
+    parallel_response.SetPolicy(&first_action_policy);
+    SPIEL_CHECK_TRUE(serial_response.GetBestResponseActions() ==
+                     parallel_response.GetBestResponseActions());
+    SPIEL_CHECK_EQ(serial_response.Value(root_history),
+                   parallel_response.Value(root_history));
+  }
+}
+
 // The best response values are taken from the existing Python implementation in
 // open_spiel/algorithms/exploitability.py.
 void KuhnPokerOptimalBestResponsePid0() {
@@ -519,4 +604,6 @@ int main(int argc, char** argv) {
   // Verifies that the code automatically generates the best response actions
   // after swapping policies.
   open_spiel::algorithms::KuhnPokerUniformBestResponseAfterSwitchingPolicies();
+  open_spiel::algorithms::LeducPokerIncrementalSetPolicy();
+  open_spiel::algorithms::LeducPokerParallelBestResponse();
 }
@@ -15,32 +15,94 @@
 #include "open_spiel/algorithms/cfr.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/cfr_kernels.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/profiler.h"
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
 
-CFRAveragePolicy::CFRAveragePolicy(
-    const CFRInfoStateValuesTable& info_states,
-    std::shared_ptr<TabularPolicy> default_policy)
-    : info_states_(info_states), default_policy_(default_policy) {}
+constexpr absl::string_view kCheckpointMagic = "OSCFRCK1";
 
-ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
-    const std::string& info_state) const {
-  ActionsAndProbs actions_and_probs;
-  auto entry = info_states_.find(info_state);
-  if (entry == info_states_.end()) {
-    if (default_policy_) {
-      return default_policy_->GetStatePolicy(info_state);
-    } else {
-      return actions_and_probs;
-    }
+// Helpers for the 8-byte aligned checkpoint records.
+void WriteBytes(file::File* file, absl::string_view bytes) {
+  if (!file->Write(bytes)) {
+    SpielFatalError("Could not write CFR checkpoint.");
   }
+}
+
+void WriteInt64(file::File* file, int64_t value) {
+  WriteBytes(file, absl::string_view(reinterpret_cast<const char*>(&value),
+                                     sizeof(value)));
+}
+
+void WritePaddedString(file::File* file, absl::string_view str) {
+  WriteBytes(file, str);
+  WriteBytes(file, std::string((8 - str.size() % 8) % 8, '\0'));
+}
 
-  const CFRInfoStateValues& is_vals = entry->second;
+template <typename T>
+void WriteArray(file::File* file, const std::vector<T>& values) {
+  static_assert(sizeof(T) == 8, "Checkpoint arrays hold 64-bit values.");
+  WriteBytes(file,
+             absl::string_view(reinterpret_cast<const char*>(values.data()),
+                               values.size() * sizeof(T)));
+}
 
+std::string ReadBytes(file::File* file, int64_t size) {
+  std::string bytes = file->Read(size);
+  if (bytes.size() != size) {
+    SpielFatalError("Truncated CFR checkpoint.");
+  }
+  return bytes;
+}
+
+int64_t ReadInt64(file::File* file) {
+  int64_t value;
+  std::memcpy(&value, ReadBytes(file, sizeof(value)).data(), sizeof(value));
+  return value;
+}
+
+std::string ReadPaddedString(file::File* file, int64_t size) {
+  std::string str = ReadBytes(file, size + (8 - size % 8) % 8);
+  str.resize(size);
+  return str;
+}
+
+template <typename T>
+void ReadArray(file::File* file, std::vector<T>* values) {
+  const std::string bytes = ReadBytes(file, values->size() * sizeof(T));
+  std::memcpy(values->data(), bytes.data(), bytes.size());
+}
+
+// Returns the entry of `state` in `indexed_info_states`, or nullptr if there
+// is no index or the state is not a decision node in it.
+const CFRInfoStateValues* IndexedInfoStateValues(
+    const std::vector<CFRInfoStateValues*>* indexed_info_states,
+    const State& state) {
+  if (indexed_info_states == nullptr || state.CurrentPlayer() < 0) {
+    return nullptr;
+  }
+  return (*indexed_info_states)[state.InformationStateIndex(
+      state.CurrentPlayer())];
+}
+
+ActionsAndProbs AverageActionsAndProbs(const CFRInfoStateValues& is_vals) {
+  ActionsAndProbs actions_and_probs;
+  actions_and_probs.reserve(is_vals.num_actions());
   double sum_prob = 0.0;
   for (int aidx = 0; aidx < is_vals.num_actions(); ++aidx) {
     sum_prob += is_vals.cumulative_policy[aidx];
@@ -62,29 +124,140 @@ ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
   return actions_and_probs;
 }
 
-CFRCurrentPolicy::CFRCurrentPolicy(
+ActionsAndProbs CurrentActionsAndProbs(const CFRInfoStateValues& is_vals) {
+  ActionsAndProbs actions_and_probs;
+  actions_and_probs.reserve(is_vals.num_actions());
+  for (int aidx = 0; aidx < is_vals.num_actions(); ++aidx) {
+    actions_and_probs.push_back(
+        {is_vals.legal_actions[aidx], is_vals.current_policy[aidx]});
+  }
+  return actions_and_probs;
+}
+
+// Calls visit on the child of state after action: the undo state itself,
+// after applying the action, if state is the undo state, or otherwise a new
+// child state.
+template <typename Visit>
+void VisitChild(const State& state, State* undo_state, Action action,
+                Visit visit) {
+  if (&state == undo_state) {
+    const Player player = state.CurrentPlayer();
+    undo_state->ApplyAction(action);
+    visit(*undo_state);
+    undo_state->UndoAction(player, action);
+  } else {
+    visit(*OPEN_SPIEL_PROFILE("cfr/Child", state.Child(action)));
+  }
+}
+
+}  // namespace
+
+void SaveCFRCheckpoint(const std::string& filename, int64_t iteration,
+                       const std::string& rng_state,
+                       const CFRInfoStateValuesTable& info_states) {
+  file::File file(filename, "wb");
+  WriteBytes(&file, kCheckpointMagic);
+  WriteInt64(&file, iteration);
+  WriteInt64(&file, info_states.size());
+  WriteInt64(&file, rng_state.size());
+  WritePaddedString(&file, rng_state);
+  for (const auto& [info_state, values] : info_states) {
+    WriteInt64(&file, info_state.size());
+    WriteInt64(&file, values.num_actions());
+    WritePaddedString(&file, info_state);
+    WriteArray(&file, values.legal_actions);
+    WriteArray(&file, values.cumulative_regrets);
+    WriteArray(&file, values.cumulative_policy);
+    WriteArray(&file, values.current_policy);
+  }
+  if (!file.Flush()) {
+    SpielFatalError("Could not write CFR checkpoint.");
+  }
+}
+
+void LoadCFRCheckpoint(
+    const std::string& filename, int64_t* iteration, std::string* rng_state,
+    const std::function<void(const std::string& info_state,
+                             CFRInfoStateValues values)>& restore) {
+  file::File file(filename, "rb");
+  if (ReadBytes(&file, kCheckpointMagic.size()) != kCheckpointMagic) {
+    SpielFatalError(absl::StrCat(filename, " is not a CFR checkpoint."));
+  }
+  *iteration = ReadInt64(&file);
+  const int64_t num_entries = ReadInt64(&file);
+  const int64_t rng_state_size = ReadInt64(&file);
+  *rng_state = ReadPaddedString(&file, rng_state_size);
+  for (int64_t i = 0; i < num_entries; ++i) {
+    const int64_t key_size = ReadInt64(&file);
+    const int64_t num_actions = ReadInt64(&file);
+    const std::string info_state = ReadPaddedString(&file, key_size);
+    CFRInfoStateValues values{std::vector<Action>(num_actions)};
+    ReadArray(&file, &values.legal_actions);
+    ReadArray(&file, &values.cumulative_regrets);
+    ReadArray(&file, &values.cumulative_policy);
+    ReadArray(&file, &values.current_policy);
+    restore(info_state, std::move(values));
+  }
+}
+
+CFRAveragePolicy::CFRAveragePolicy(
     const CFRInfoStateValuesTable& info_states,
-    std::shared_ptr<TabularPolicy> default_policy)
-    : info_states_(info_states), default_policy_(default_policy) {}
+    std::shared_ptr<TabularPolicy> default_policy,
+    const std::vector<CFRInfoStateValues*>* indexed_info_states)
+    : info_states_(info_states),
+      default_policy_(default_policy),
+      indexed_info_states_(indexed_info_states) {}
+
+ActionsAndProbs CFRAveragePolicy::GetStatePolicy(const State& state) const {
+  const CFRInfoStateValues* is_vals =
+      IndexedInfoStateValues(indexed_info_states_, state);
+  if (is_vals == nullptr) {
+    return GetStatePolicy(state.InformationStateString());
+  }
+  return AverageActionsAndProbs(*is_vals);
+}
 
-ActionsAndProbs CFRCurrentPolicy::GetStatePolicy(
+ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
     const std::string& info_state) const {
-  ActionsAndProbs actions_and_probs;
   auto entry = info_states_.find(info_state);
   if (entry == info_states_.end()) {
     if (default_policy_) {
       return default_policy_->GetStatePolicy(info_state);
     } else {
-      return actions_and_probs;
+      return ActionsAndProbs();
     }
   }
+  return AverageActionsAndProbs(entry->second);
+}
 
-  const CFRInfoStateValues& is_vals = entry->second;
-  for (int aidx = 0; aidx < is_vals.num_actions(); ++aidx) {
-    actions_and_probs.push_back(
-        {is_vals.legal_actions[aidx], is_vals.current_policy[aidx]});
+CFRCurrentPolicy::CFRCurrentPolicy(
+    const CFRInfoStateValuesTable& info_states,
+    std::shared_ptr<TabularPolicy> default_policy,
+    const std::vector<CFRInfoStateValues*>* indexed_info_states)
+    : info_states_(info_states),
+      default_policy_(default_policy),
+      indexed_info_states_(indexed_info_states) {}
+
+ActionsAndProbs CFRCurrentPolicy::GetStatePolicy(const State& state) const {
+  const CFRInfoStateValues* is_vals =
+      IndexedInfoStateValues(indexed_info_states_, state);
+  if (is_vals == nullptr) {
+    return GetStatePolicy(state.InformationStateString());
   }
-  return actions_and_probs;
+  return CurrentActionsAndProbs(*is_vals);
+}
+
+ActionsAndProbs CFRCurrentPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  auto entry = info_states_.find(info_state);
+  if (entry == info_states_.end()) {
+    if (default_policy_) {
+      return default_policy_->GetStatePolicy(info_state);
+    } else {
+      return ActionsAndProbs();
+    }
+  }
+  return CurrentActionsAndProbs(entry->second);
 }
 
 CFRSolverBase::CFRSolverBase(const Game& game, bool alternating_updates,
@@ -103,7 +276,24 @@ CFRSolverBase::CFRSolverBase(const Game& game, bool alternating_updates,
         "using turn_based_simultaneous_game.");
   }
 
-  InitializeInfostateNodes(*root_state_);
+  if (game_.NumInformationStates() > 0) {
+    indexed_info_states_.resize(game_.NumInformationStates(), nullptr);
+    info_states_.reserve(game_.NumInformationStates());
+  }
+  if (root_state_->SupportsUndoAction()) undo_state_ = root_state_->Clone();
+  InitializeInfostateNodes(TraversalRoot());
+}
+
+void CFRSolverBase::SetUseUndoAction(bool use_undo_action) {
+  if (!use_undo_action) {
+    undo_state_.reset();
+  } else if (!undo_state_) {
+    if (!root_state_->SupportsUndoAction()) {
+      SpielFatalError(absl::StrCat("The states of ", game_.ToString(),
+                                   " do not support UndoAction."));
+    }
+    undo_state_ = root_state_->Clone();
+  }
 }
 
 void CFRSolverBase::InitializeInfostateNodes(const State& state) {
@@ -112,7 +302,8 @@ void CFRSolverBase::InitializeInfostateNodes(const State& state) {
   }
   if (state.IsChanceNode()) {
     for (const auto& action_prob : state.ChanceOutcomes()) {
-      InitializeInfostateNodes(*state.Child(action_prob.first));
+      VisitChild(state, undo_state_.get(), action_prob.first,
+                 [&](const State& child) { InitializeInfostateNodes(child); });
     }
     return;
   }
@@ -123,26 +314,41 @@ void CFRSolverBase::InitializeInfostateNodes(const State& state) {
 
   CFRInfoStateValues is_vals(legal_actions);
   info_states_[info_state] = is_vals;
+  if (!indexed_info_states_.empty()) {
+    // Pointers to the elements of an unordered_map remain valid on insertion.
+    indexed_info_states_[state.InformationStateIndex(current_player)] =
+        &info_states_[info_state];
+  }
 
   for (const Action& action : legal_actions) {
-    InitializeInfostateNodes(*state.Child(action));
+    VisitChild(state, undo_state_.get(), action,
+               [&](const State& child) { InitializeInfostateNodes(child); });
+  }
+}
+
+LegalActionsIndex CFRSolverBase::InfoStateLegalActions() const {
+  LegalActionsIndex index;
+  for (const auto& [info_state, values] : info_states_) {
+    index.Add(info_state, values.legal_actions);
   }
+  return index;
 }
 
 void CFRSolverBase::EvaluateAndUpdatePolicy() {
+  OPEN_SPIEL_PROFILE_SCOPE("cfr/EvaluateAndUpdatePolicy");
   ++iteration_;
   if (alternating_updates_) {
     for (int player = 0; player < game_.NumPlayers(); player++) {
-      ComputeCounterFactualRegret(*root_state_, player, root_reach_probs_,
-                                  nullptr);
+      ComputeCounterFactualRegret(TraversalRoot(), player,
+                                  root_reach_probs_, nullptr);
       if (regret_matching_plus_) {
         ApplyRegretMatchingPlusReset();
       }
       ApplyRegretMatching();
     }
   } else {
-    ComputeCounterFactualRegret(*root_state_, std::nullopt, root_reach_probs_,
-                                nullptr);
+    ComputeCounterFactualRegret(TraversalRoot(), std::nullopt,
+                                root_reach_probs_, nullptr);
     if (regret_matching_plus_) {
       ApplyRegretMatchingPlusReset();
     }
@@ -180,7 +386,8 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegret(
     return state.Returns();
   }
   if (state.IsChanceNode()) {
-    ActionsAndProbs actions_and_probs = state.ChanceOutcomes();
+    ActionsAndProbs actions_and_probs =
+        OPEN_SPIEL_PROFILE("cfr/ChanceOutcomes", state.ChanceOutcomes());
     std::vector<double> dist(actions_and_probs.size(), 0);
     std::vector<Action> outcomes(actions_and_probs.size(), 0);
     for (int oidx = 0; oidx < actions_and_probs.size(); ++oidx) {
@@ -189,7 +396,7 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegret(
     }
     return ComputeCounterFactualRegretForActionProbs(
         state, alternating_player, reach_probabilities, chance_player_, dist,
-        outcomes, nullptr, policy_overrides);
+        outcomes, nullptr, policy_overrides, /*pruned_is_vals=*/nullptr);
   }
   if (AllPlayersHaveZeroReachProb(reach_probabilities)) {
     // The value returned is not used: if the reach probability for all players
@@ -199,53 +406,88 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegret(
   }
 
   int current_player = state.CurrentPlayer();
-  std::string info_state = state.InformationStateString();
-  std::vector<Action> legal_actions = state.LegalActions(current_player);
+  std::vector<Action> legal_actions = OPEN_SPIEL_PROFILE(
+      "cfr/LegalActions", state.LegalActions(current_player));
+  const Policy* policy_override =
+      policy_overrides ? policy_overrides->at(current_player) : nullptr;
+
+  // Policies are looked up by string, but our own table can use the integer
+  // information state index when the game provides one.
+  // The string is only used before the recursion, so all the nodes share
+  // one buffer.
+  const std::string& info_state = info_state_buffer_;
+  CFRInfoStateValues* is_vals;
+  if (!indexed_info_states_.empty() && policy_override == nullptr) {
+    is_vals =
+        indexed_info_states_[state.InformationStateIndex(current_player)];
+  } else {
+    info_state_buffer_.clear();
+    {
+      OPEN_SPIEL_PROFILE_SCOPE("cfr/InformationStateString");
+      state.AppendInformationStateString(current_player, &info_state_buffer_);
+    }
+    is_vals = &GetInfoStateValues(info_state, legal_actions);
+  }
+  SPIEL_CHECK_TRUE(is_vals != nullptr);
 
   // Load current policy.
   std::vector<double> info_state_policy;
-  if (policy_overrides && policy_overrides->at(current_player)) {
+  if (policy_override) {
     GetInfoStatePolicyFromPolicy(&info_state_policy, legal_actions,
-                                 policy_overrides->at(current_player),
-                                 info_state);
+                                 policy_override, info_state);
   } else {
-    info_state_policy = GetPolicy(info_state, legal_actions);
+    SPIEL_CHECK_FALSE(is_vals->current_policy.empty());
+    info_state_policy = is_vals->current_policy;
   }
 
+  // Regret-based pruning only skips the updating player's own actions.
+  const CFRInfoStateValues* pruned_is_vals =
+      PruningActive() && alternating_player &&
+              *alternating_player == current_player &&
+              policy_override == nullptr
+          ? is_vals
+          : nullptr;
+
   std::vector<double> child_utilities;
   child_utilities.reserve(legal_actions.size());
   const std::vector<double> state_value =
       ComputeCounterFactualRegretForActionProbs(
           state, alternating_player, reach_probabilities, current_player,
-          info_state_policy, legal_actions, &child_utilities, policy_overrides);
+          info_state_policy, legal_actions, &child_utilities, policy_overrides,
+          pruned_is_vals);
 
   // Perform regret and average strategy updates.
   if (!alternating_player || *alternating_player == current_player) {
-    CFRInfoStateValues is_vals = info_states_[info_state];
-    SPIEL_CHECK_FALSE(is_vals.empty());
+    SPIEL_CHECK_FALSE(is_vals->empty());
 
     const double self_reach_prob = reach_probabilities[current_player];
     const double cfr_reach_prob =
         CounterFactualReachProb(reach_probabilities, current_player);
 
-    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      // Update regrets.
-      double cfr_regret = cfr_reach_prob *
-                          (child_utilities[aidx] - state_value[current_player]);
+    const double averaging_weight =
+        linear_averaging_ ? LinearAveragingWeight() * self_reach_prob
+                          : self_reach_prob;
+    if (pruned_is_vals == nullptr) {
+      AddRegrets(absl::MakeSpan(is_vals->cumulative_regrets), cfr_reach_prob,
+                 child_utilities, state_value[current_player]);
+      AddWeightedPolicy(absl::MakeSpan(is_vals->cumulative_policy),
+                        averaging_weight, info_state_policy);
+    } else {
+      for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+        if (IsPruned(*is_vals, aidx, info_state_policy[aidx])) continue;
+
+        // Update regrets.
+        double cfr_regret =
+            cfr_reach_prob *
+            (child_utilities[aidx] - state_value[current_player]);
 
-      is_vals.cumulative_regrets[aidx] += cfr_regret;
+        is_vals->cumulative_regrets[aidx] += cfr_regret;
 
-      // Update average policy.
-      if (linear_averaging_) {
-        is_vals.cumulative_policy[aidx] +=
-            iteration_ * self_reach_prob * info_state_policy[aidx];
-      } else {
-        is_vals.cumulative_policy[aidx] +=
-            self_reach_prob * info_state_policy[aidx];
+        // Update average policy.
+        is_vals->cumulative_policy[aidx] +=
+            averaging_weight * info_state_policy[aidx];
       }
     }
-
-    info_states_[info_state] = is_vals;
   }
 
   return state_value;
@@ -282,6 +524,8 @@ void CFRSolverBase::GetInfoStatePolicyFromPolicy(
 // - action_probs: The action probabilities to use frp this state.
 // - child_values_out: optional output parameter which is filled with the child
 //           utilities for each action, for current_player.
+// - pruned_is_vals: if not null, the values used to skip the actions pruned by
+//           regret-based pruning, whose child utilities are set to 0.
 // Returns:
 //   The value of the state for each player (excluding the chance player).
 std::vector<double> CFRSolverBase::ComputeCounterFactualRegretForActionProbs(
@@ -290,18 +534,26 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegretForActionProbs(
     const std::vector<double>& info_state_policy,
     const std::vector<Action>& legal_actions,
     std::vector<double>* child_values_out,
-    const std::vector<const Policy*>* policy_overrides) {
+    const std::vector<const Policy*>* policy_overrides,
+    const CFRInfoStateValues* pruned_is_vals) {
   std::vector<double> state_value(game_.NumPlayers());
 
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
     const Action action = legal_actions[aidx];
     const double prob = info_state_policy[aidx];
-    const std::unique_ptr<State> new_state = state.Child(action);
+    if (pruned_is_vals != nullptr && IsPruned(*pruned_is_vals, aidx, prob)) {
+      // The action has probability 0, so it does not change the state value.
+      if (child_values_out != nullptr) child_values_out->push_back(0);
+      continue;
+    }
     std::vector<double> new_reach_probabilities(reach_probabilities);
     new_reach_probabilities[current_player] *= prob;
-    std::vector<double> child_value =
-        ComputeCounterFactualRegret(*new_state, alternating_player,
-                                    new_reach_probabilities, policy_overrides);
+    std::vector<double> child_value;
+    VisitChild(state, undo_state_.get(), action, [&](const State& child) {
+      child_value = ComputeCounterFactualRegret(
+          child, alternating_player, new_reach_probabilities,
+          policy_overrides);
+    });
     for (int i = 0; i < state_value.size(); ++i) {
       state_value[i] += prob * child_value[i];
     }
@@ -322,18 +574,17 @@ bool CFRSolverBase::AllPlayersHaveZeroReachProb(
   return true;
 }
 
-std::vector<double> CFRSolverBase::GetPolicy(
+CFRInfoStateValues& CFRSolverBase::GetInfoStateValues(
     const std::string& info_state, const std::vector<Action>& legal_actions) {
   auto entry = info_states_.find(info_state);
   if (entry == info_states_.end()) {
-    info_states_[info_state] = CFRInfoStateValues(legal_actions);
-    entry = info_states_.find(info_state);
+    entry =
+        info_states_.emplace(info_state, CFRInfoStateValues(legal_actions))
+            .first;
   }
 
-  SPIEL_CHECK_FALSE(entry == info_states_.end());
   SPIEL_CHECK_FALSE(entry->second.empty());
-  SPIEL_CHECK_FALSE(entry->second.current_policy.empty());
-  return entry->second.current_policy;
+  return entry->second;
 }
 
 std::string CFRInfoStateValues::ToString() const {
@@ -351,23 +602,7 @@ std::string CFRInfoStateValues::ToString() const {
 }
 
 void CFRInfoStateValues::ApplyRegretMatching() {
-  double sum_positive_regrets = 0.0;
-  for (int aidx = 0; aidx < num_actions(); ++aidx) {
-    if (cumulative_regrets[aidx] > 0) {
-      sum_positive_regrets += cumulative_regrets[aidx];
-    }
-  }
-
-  for (int aidx = 0; aidx < num_actions(); ++aidx) {
-    if (sum_positive_regrets > 0) {
-      current_policy[aidx] =
-          cumulative_regrets[aidx] > 0
-              ? cumulative_regrets[aidx] / sum_positive_regrets
-              : 0;
-    } else {
-      current_policy[aidx] = 1.0 / legal_actions.size();
-    }
-  }
+  RegretMatching(cumulative_regrets, absl::MakeSpan(current_policy));
 }
 
 int CFRInfoStateValues::SampleActionIndex(double epsilon, double z) {
@@ -393,11 +628,7 @@ int CFRInfoStateValues::SampleActionIndex(double epsilon, double z) {
 //  performed as an additional step.
 void CFRSolverBase::ApplyRegretMatchingPlusReset() {
   for (auto& entry : info_states_) {
-    for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
-      if (entry.second.cumulative_regrets[aidx] < 0) {
-        entry.second.cumulative_regrets[aidx] = 0;
-      }
-    }
+    ClampNegative(absl::MakeSpan(entry.second.cumulative_regrets));
   }
 }
 
@@ -407,5 +638,106 @@ void CFRSolverBase::ApplyRegretMatching() {
   }
 }
 
+DenseTabularPolicy CFRSolverBase::DenseAveragePolicy() const {
+  std::vector<std::string> info_states;
+  info_states.reserve(info_states_.size());
+  for (const auto& entry : info_states_) info_states.push_back(entry.first);
+  return DenseTabularPolicy(info_states, *AveragePolicy());
+}
+
+void CFRSolverBase::SaveCheckpoint(const std::string& filename) const {
+  SaveCFRCheckpoint(filename, iteration_, /*rng_state=*/"", info_states_);
+}
+
+void CFRSolverBase::LoadCheckpoint(const std::string& filename) {
+  int64_t iteration;
+  std::string rng_state;
+  int64_t num_restored = 0;
+  // The values are copied into the existing entries, which subclasses may
+  // point to.
+  LoadCFRCheckpoint(
+      filename, &iteration, &rng_state,
+      [this, &num_restored](const std::string& info_state,
+                            CFRInfoStateValues values) {
+        auto entry = info_states_.find(info_state);
+        if (entry == info_states_.end() ||
+            entry->second.legal_actions != values.legal_actions) {
+          SpielFatalError(absl::StrCat(
+              "CFR checkpoint does not match the game at ", info_state));
+        }
+        entry->second = std::move(values);
+        ++num_restored;
+      });
+  SPIEL_CHECK_EQ(num_restored, info_states_.size());
+  iteration_ = iteration;
+}
+
+void CFRSolverBase::SetRegretBasedPruning(double regret_threshold,
+                                          int full_traversal_interval) {
+  SPIEL_CHECK_TRUE(alternating_updates_);
+  SPIEL_CHECK_LT(regret_threshold, 0);
+  SPIEL_CHECK_GT(full_traversal_interval, 0);
+  pruning_threshold_ = regret_threshold;
+  full_traversal_interval_ = full_traversal_interval;
+}
+
+DCFRSolver::DCFRSolver(const Game& game, double alpha, double beta,
+                       double gamma)
+    : CFRSolverBase(game,
+                    /*alternating_updates=*/true,
+                    /*linear_averaging=*/true,
+                    /*regret_matching_plus=*/false),
+      alpha_(alpha),
+      beta_(beta),
+      gamma_(gamma),
+      player_info_states_(game.NumPlayers()) {
+  std::unordered_set<const CFRInfoStateValues*> visited;
+  CollectPlayerInfoStates(TraversalRoot(), &visited);
+}
+
+void DCFRSolver::CollectPlayerInfoStates(
+    const State& state,
+    std::unordered_set<const CFRInfoStateValues*>* visited) {
+  if (state.IsTerminal()) return;
+  if (state.IsChanceNode()) {
+    for (const auto& action_prob : state.ChanceOutcomes()) {
+      VisitChild(state, undo_state_.get(), action_prob.first,
+                 [&](const State& child) {
+                   CollectPlayerInfoStates(child, visited);
+                 });
+    }
+    return;
+  }
+  const int current_player = state.CurrentPlayer();
+  CFRInfoStateValues* is_vals =
+      &info_states_.at(state.InformationStateString(current_player));
+  if (visited->insert(is_vals).second) {
+    player_info_states_[current_player].push_back(is_vals);
+  }
+  for (Action action : is_vals->legal_actions) {
+    VisitChild(state, undo_state_.get(), action, [&](const State& child) {
+      CollectPlayerInfoStates(child, visited);
+    });
+  }
+}
+
+void DCFRSolver::EvaluateAndUpdatePolicy() {
+  OPEN_SPIEL_PROFILE_SCOPE("cfr/EvaluateAndUpdatePolicy");
+  ++iteration_;
+  const double positive_discount =
+      std::pow(iteration_, alpha_) / (std::pow(iteration_, alpha_) + 1);
+  const double negative_discount =
+      std::pow(iteration_, beta_) / (std::pow(iteration_, beta_) + 1);
+  for (int player = 0; player < game_.NumPlayers(); player++) {
+    ComputeCounterFactualRegret(TraversalRoot(), player, root_reach_probs_,
+                                nullptr);
+    for (CFRInfoStateValues* is_vals : player_info_states_[player]) {
+      DiscountRegrets(absl::MakeSpan(is_vals->cumulative_regrets),
+                      positive_discount, negative_discount);
+    }
+    ApplyRegretMatching();
+  }
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
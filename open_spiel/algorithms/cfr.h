@@ -15,6 +15,13 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_H_
 
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+
+#include "open_spiel/algorithms/get_legal_actions_map.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 
@@ -60,14 +67,21 @@ class CFRAveragePolicy : public Policy {
   // If an info state is not found, return the default policy for the info state
   // (or an empty policy if default_policy is nullptr). If an info state has
   // zero cumulative regret for all actions, return a uniform policy.
-  CFRAveragePolicy(const CFRInfoStateValuesTable& info_states,
-                   std::shared_ptr<TabularPolicy> default_policy);
+  // This is a view of the table: the probabilities are normalized on lookup
+  // and reflect the latest iteration. If `indexed_info_states` is not null, it
+  // holds the entries of the table by State::InformationStateIndex, so that
+  // lookups by state do not build and hash information state strings.
+  CFRAveragePolicy(
+      const CFRInfoStateValuesTable& info_states,
+      std::shared_ptr<TabularPolicy> default_policy,
+      const std::vector<CFRInfoStateValues*>* indexed_info_states = nullptr);
+  ActionsAndProbs GetStatePolicy(const State& state) const override;
   ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
 
  private:
   const CFRInfoStateValuesTable& info_states_;
-  bool default_to_uniform_;
   std::shared_ptr<TabularPolicy> default_policy_;
+  const std::vector<CFRInfoStateValues*>* indexed_info_states_;
 };
 
 // A policy that extracts the current policy from the CFR table values.
@@ -75,16 +89,44 @@ class CFRCurrentPolicy : public Policy {
  public:
   // Returns the current policy from the CFR values. If a default policy is
   // passed in, then it means that it is used if the lookup fails (use nullptr
-  // to not use a default policy).
-  CFRCurrentPolicy(const CFRInfoStateValuesTable& info_states,
-                   std::shared_ptr<TabularPolicy> default_policy);
+  // to not use a default policy). `indexed_info_states` is as for
+  // CFRAveragePolicy.
+  CFRCurrentPolicy(
+      const CFRInfoStateValuesTable& info_states,
+      std::shared_ptr<TabularPolicy> default_policy,
+      const std::vector<CFRInfoStateValues*>* indexed_info_states = nullptr);
+  ActionsAndProbs GetStatePolicy(const State& state) const override;
   ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
 
  private:
   const CFRInfoStateValuesTable& info_states_;
   std::shared_ptr<TabularPolicy> default_policy_;
+  const std::vector<CFRInfoStateValues*>* indexed_info_states_;
 };
 
+// Saves a CFR table, with the solver's iteration counter and the state of its
+// random number generator (as written by operator<<, empty if it has none),
+// to a binary checkpoint file so that long runs can be resumed.
+//
+// The file starts with a header (the 8-byte magic "OSCFRCK1", the iteration
+// and the number of entries as 64-bit integers, then the length-prefixed RNG
+// state), followed by one record per information state: its key length and
+// number of actions, the key, then the legal actions, cumulative regrets,
+// cumulative policy and current policy as arrays of 64-bit values. Strings
+// are zero-padded so that every array starts at a multiple of 8 bytes, and
+// integers and doubles are in the machine's native byte order, so the records
+// can be read in place from a memory-mapped file.
+void SaveCFRCheckpoint(const std::string& filename, int64_t iteration,
+                       const std::string& rng_state,
+                       const CFRInfoStateValuesTable& info_states);
+
+// Reads a checkpoint written by SaveCFRCheckpoint, calling `restore` on each
+// of its information states.
+void LoadCFRCheckpoint(
+    const std::string& filename, int64_t* iteration, std::string* rng_state,
+    const std::function<void(const std::string& info_state,
+                             CFRInfoStateValues values)>& restore);
+
 // Base class supporting different flavours of the Counterfactual Regret
 // Minimization (CFR) algorithm.
 //
@@ -111,25 +153,82 @@ class CFRSolverBase {
 
   // Computes the average policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
-  // the CFRSolver object.
+  // the CFRSolver object. It is a view of the solver's table rather than a
+  // copy, so it can be kept across iterations and passed to Exploitability or
+  // TabularBestResponse directly.
   std::unique_ptr<Policy> AveragePolicy() const {
-    return std::unique_ptr<Policy>(new CFRAveragePolicy(info_states_, nullptr));
+    return std::unique_ptr<Policy>(
+        new CFRAveragePolicy(info_states_, nullptr, IndexedInfoStates()));
   }
 
+  // Returns a copy of the average policy, which stays valid after the solver
+  // and does not change with its later iterations, e.g. to keep snapshots.
+  DenseTabularPolicy DenseAveragePolicy() const;
+
   // Computes the current policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
-  // the CFRSolver object.
+  // the CFRSolver object. Like AveragePolicy(), it is a view of the table.
   std::unique_ptr<Policy> CurrentPolicy() const {
-    return std::unique_ptr<Policy>(new CFRCurrentPolicy(info_states_, nullptr));
+    return std::unique_ptr<Policy>(
+        new CFRCurrentPolicy(info_states_, nullptr, IndexedInfoStates()));
   }
 
+  // The legal actions of all the information states, from the table that the
+  // constructor fills, so that other solvers and policies over the same
+  // information states can be set up without traversing the game again.
+  LegalActionsIndex InfoStateLegalActions() const;
+
+  // Enables regret-based pruning: with alternating updates, the subtree of an
+  // action that the updating player plays with probability 0 and whose
+  // cumulative regret is below `regret_threshold` (which must be negative) is
+  // not traversed, and the regret of this action is left unchanged. Every
+  // `full_traversal_interval` iterations, the whole tree is traversed again,
+  // so that these regrets keep being updated. Regrets are never negative with
+  // Regret Matching+, so this has no effect on CFR+.
+  void SetRegretBasedPruning(double regret_threshold,
+                             int full_traversal_interval);
+
+  // Saves the table and iteration counter to a checkpoint file, see
+  // SaveCFRCheckpoint.
+  void SaveCheckpoint(const std::string& filename) const;
+
+  // Restores a checkpoint saved by a solver of the same flavour for the same
+  // game, so that running more iterations continues the saved run.
+  void LoadCheckpoint(const std::string& filename);
+
+  // Whether the tree is walked by applying and undoing actions on a single
+  // state, rather than by cloning a child state per node. This is the default
+  // when the game's states support UndoAction, and it is an error to enable
+  // it otherwise. The results are the same either way.
+  void SetUseUndoAction(bool use_undo_action);
+  bool UseUndoAction() const { return undo_state_ != nullptr; }
+
  protected:
   const Game& game_;
 
   // Iteration to support linear_policy.
   int iteration_ = 0;
   CFRInfoStateValuesTable info_states_;
+  // Entries of info_states_ by State::InformationStateIndex, if the game
+  // provides it; empty otherwise.
+  std::vector<CFRInfoStateValues*> indexed_info_states_;
+  // Reused by the traversals for the information state strings.
+  std::string info_state_buffer_;
   const std::unique_ptr<State> root_state_;
+  // With UseUndoAction(), the state on which the traversals apply and undo
+  // actions. It is back at the root between traversals.
+  std::unique_ptr<State> undo_state_;
+
+  // The state to start traversals from: undo_state_ if set, otherwise
+  // root_state_. Traversals from undo_state_ must only recurse on it.
+  const State& TraversalRoot() const {
+    return undo_state_ ? *undo_state_ : *root_state_;
+  }
+
+  // Returns &indexed_info_states_, or nullptr if the game has no index.
+  const std::vector<CFRInfoStateValues*>* IndexedInfoStates() const {
+    return indexed_info_states_.empty() ? nullptr : &indexed_info_states_;
+  }
   const std::vector<double> root_reach_probs_;
 
   // Compute the counterfactual regret and update the average policy for the
@@ -147,6 +246,17 @@ class CFRSolverBase {
   // Update the current policy for all information states.
   void ApplyRegretMatching();
 
+  // The weight of the current iteration in the average policy, with linear
+  // averaging.
+  virtual double LinearAveragingWeight() const { return iteration_; }
+
+  // Resets negative cumulative regrets to 0, for Regret Matching+.
+  void ApplyRegretMatchingPlusReset();
+
+  const bool regret_matching_plus_;
+  const bool alternating_updates_;
+  const bool linear_averaging_;
+
  private:
   std::vector<double> ComputeCounterFactualRegretForActionProbs(
       const State& state, const std::optional<int>& alternating_player,
@@ -154,7 +264,19 @@ class CFRSolverBase {
       const std::vector<double>& info_state_policy,
       const std::vector<Action>& legal_actions,
       std::vector<double>* child_values_out,
-      const std::vector<const Policy*>* policy_overrides);
+      const std::vector<const Policy*>* policy_overrides,
+      const CFRInfoStateValues* pruned_is_vals);
+
+  // Whether regret-based pruning skips the action at `aidx`, played with
+  // probability `prob`, in this iteration.
+  bool IsPruned(const CFRInfoStateValues& is_vals, int aidx,
+                double prob) const {
+    return prob == 0.0 && is_vals.cumulative_regrets[aidx] < pruning_threshold_;
+  }
+  bool PruningActive() const {
+    return full_traversal_interval_ > 0 &&
+           iteration_ % full_traversal_interval_ != 0;
+  }
 
   void InitializeInfostateNodes(const State& state);
 
@@ -165,12 +287,9 @@ class CFRSolverBase {
                                     const Policy* policy,
                                     const std::string& info_state) const;
 
-  // Get the policy at this information state. The probabilities are ordered in
-  // the same order as legal_actions.
-  std::vector<double> GetPolicy(const std::string& info_state,
-                                const std::vector<Action>& legal_actions);
-
-  void ApplyRegretMatchingPlusReset();
+  // Get the values at this information state, adding them if needed.
+  CFRInfoStateValues& GetInfoStateValues(
+      const std::string& info_state, const std::vector<Action>& legal_actions);
 
   std::vector<double> RegretMatching(const std::string& info_state,
                                      const std::vector<Action>& legal_actions);
@@ -178,11 +297,11 @@ class CFRSolverBase {
   bool AllPlayersHaveZeroReachProb(
       const std::vector<double>& reach_probabilities) const;
 
-  const bool regret_matching_plus_;
-  const bool alternating_updates_;
-  const bool linear_averaging_;
-
   const int chance_player_;
+
+  // Regret-based pruning, disabled if full_traversal_interval_ is 0.
+  double pruning_threshold_ = 0;
+  int full_traversal_interval_ = 0;
 };
 
 // Standard CFR implementation.
@@ -214,6 +333,52 @@ class CFRPlusSolver : public CFRSolverBase {
                       /*regret_matching_plus=*/true) {}
 };
 
+// Discounted CFR (DCFR) implementation.
+//
+// See Brown & Sandholm, "Solving Imperfect-Information Games via Discounted
+// Regret Minimization", 2019, https://arxiv.org/abs/1809.04040, and the Python
+// version: open_spiel/python/algorithms/discounted_cfr.py
+//
+// DCFR(alpha, beta, gamma) is CFR with alternating updates where, at iteration
+// t, after the regrets of a player are updated:
+// - their positive cumulative regrets are multiplied by t^alpha / (t^alpha + 1)
+// - their negative cumulative regrets are multiplied by t^beta / (t^beta + 1)
+// and the contribution of the iteration to the average policy is weighted by
+// t^gamma.
+class DCFRSolver : public CFRSolverBase {
+ public:
+  explicit DCFRSolver(const Game& game, double alpha = 1.5, double beta = 0,
+                      double gamma = 2);
+
+  void EvaluateAndUpdatePolicy() override;
+
+ protected:
+  double LinearAveragingWeight() const override {
+    return std::pow(iteration_, gamma_);
+  }
+
+ private:
+  void CollectPlayerInfoStates(
+      const State& state,
+      std::unordered_set<const CFRInfoStateValues*>* visited);
+
+  const double alpha_;
+  const double beta_;
+  const double gamma_;
+
+  // The information states of each player, which are discounted after that
+  // player's update.
+  std::vector<std::vector<CFRInfoStateValues*>> player_info_states_;
+};
+
+// Linear CFR (LCFR), which is DCFR(1, 1, 1): on iteration t, the updates to
+// the regrets and average policy are given weight t.
+class LCFRSolver : public DCFRSolver {
+ public:
+  explicit LCFRSolver(const Game& game)
+      : DCFRSolver(game, /*alpha=*/1, /*beta=*/1, /*gamma=*/1) {}
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
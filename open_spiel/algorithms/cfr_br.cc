@@ -14,19 +14,27 @@
 
 #include "open_spiel/algorithms/cfr_br.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/policy.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
 
-CFRBRSolver::CFRBRSolver(const Game& game)
+CFRBRSolver::CFRBRSolver(const Game& game, int num_threads)
     : CFRSolverBase(game,
                     /*alternating_updates=*/false,
                     /*linear_averaging=*/false,
                     /*regret_matching_plus=*/false),
       policy_overrides_(game.NumPlayers(), nullptr),
-      uniform_policy_(GetUniformPolicy(game)) {
+      uniform_policy_(GetUniformPolicy(InfoStateLegalActions())),
+      num_threads_(num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
   for (int p = 0; p < game_.NumPlayers(); ++p) {
     best_response_computers_.push_back(std::unique_ptr<TabularBestResponse>(
         new TabularBestResponse(game_, p, &uniform_policy_)));
@@ -39,19 +47,31 @@ void CFRBRSolver::EvaluateAndUpdatePolicy() {
   std::vector<TabularPolicy> br_policies(game_.NumPlayers());
   std::unique_ptr<Policy> current_policy = CurrentPolicy();
 
-  // Set all the player's policies first.
-  for (int p = 0; p < game_.NumPlayers(); ++p) {
+  // Set each player's policy, then compute a best response to it. The current
+  // policy is only read, so the players can be handled concurrently.
+  auto compute_best_response = [this, &br_policies, &current_policy](int p) {
     // Need to have an exception here because the CFR policy objects are
     // wrappers around information that is contained in a table, and those do
     // not exist until there's been a tree traversal to compute regrets below.
     if (iteration_ > 1) {
       best_response_computers_[p]->SetPolicy(current_policy.get());
     }
-  }
-
-  // Now, for each player compute a best response
-  for (int p = 0; p < game_.NumPlayers(); ++p) {
     br_policies[p] = best_response_computers_[p]->GetBestResponsePolicy();
+  };
+  const int num_threads = std::min(num_threads_, game_.NumPlayers());
+  if (num_threads == 1) {
+    for (int p = 0; p < game_.NumPlayers(); ++p) compute_best_response(p);
+  } else {
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([t, num_threads, &compute_best_response, this]() {
+        for (int p = t; p < game_.NumPlayers(); p += num_threads) {
+          compute_best_response(p);
+        }
+      });
+    }
+    for (Thread& thread : threads) thread.join();
   }
 
   for (int p = 0; p < game_.NumPlayers(); ++p) {
@@ -61,7 +81,7 @@ void CFRBRSolver::EvaluateAndUpdatePolicy() {
     }
 
     // Then collect regret and update p's average strategy.
-    ComputeCounterFactualRegret(*root_state_, p, root_reach_probs_,
+    ComputeCounterFactualRegret(TraversalRoot(), p, root_reach_probs_,
                                 &policy_overrides_);
   }
   ApplyRegretMatching();
@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_BR_H_
 
 #include <memory>
+#include <vector>
 
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/cfr.h"
@@ -27,12 +28,17 @@
 // Strategies in Extensive-Form Games", 2012). In CFR-BR, at each iteration,
 // each player minimizes regret against their worst-case opponent (a best
 // response to its current policy).
+//
+// The best responses of the players are independent, so with num_threads > 1
+// they are computed concurrently, which gives the same results. Each player's
+// TabularBestResponse is kept across iterations and only recomputes what
+// depends on the information states whose policy changed.
 namespace open_spiel {
 namespace algorithms {
 
 class CFRBRSolver : public CFRSolverBase {
  public:
-  explicit CFRBRSolver(const Game& game);
+  explicit CFRBRSolver(const Game& game, int num_threads = 1);
 
   void EvaluateAndUpdatePolicy() override;
 
@@ -42,6 +48,7 @@ class CFRBRSolver : public CFRSolverBase {
   std::vector<const Policy*> policy_overrides_;
   TabularPolicy uniform_policy_;
   std::vector<std::unique_ptr<TabularBestResponse>> best_response_computers_;
+  const int num_threads_;
 };
 
 }  // namespace algorithms
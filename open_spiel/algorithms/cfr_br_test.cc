@@ -59,6 +59,19 @@ void CFRBRTest_LeducPoker() {
             << std::endl;
 }
 
+// The best responses computed concurrently are the same.
+void CFRBRTest_Parallel() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRBRSolver solver(*game);
+  CFRBRSolver parallel_solver(*game, /*num_threads=*/2);
+  for (int i = 0; i < 50; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    parallel_solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_EQ(NashConv(*game, *parallel_solver.AveragePolicy()),
+                 NashConv(*game, *solver.AveragePolicy()));
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -68,4 +81,5 @@ namespace algorithms = open_spiel::algorithms;
 int main(int argc, char** argv) {
   algorithms::CFRBRTest_KuhnPoker();
   algorithms::CFRBRTest_LeducPoker();
+  algorithms::CFRBRTest_Parallel();
 }
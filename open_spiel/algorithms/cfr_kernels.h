@@ -0,0 +1,119 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_KERNELS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_KERNELS_H_
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel_utils.h"
+
+// The per-information-state updates shared by the CFR solvers (cfr.cc,
+// external_sampling_mccfr.cc, outcome_sampling_mccfr.cc), over the
+// contiguous arrays of a CFRInfoStateValues. The element-wise kernels are
+// branchless loops which the compiler vectorizes for the target's instruction
+// set. Sums are not vectorized by compilers without reassociating them, so
+// SumPositive has AVX2 and AVX-512 versions, used when the build targets them
+// (see OPEN_SPIEL_NATIVE_ARCH in CMakeLists.txt); their results may then
+// differ from the scalar version's in the last bits.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Returns the sum of max(0, values[i]).
+inline double SumPositive(absl::Span<const double> values) {
+  const double* data = values.data();
+  const int n = values.size();
+  int i = 0;
+  double sum = 0;
+#if defined(__AVX512F__)
+  __m512d sum8 = _mm512_setzero_pd();
+  for (; i + 8 <= n; i += 8) {
+    sum8 = _mm512_add_pd(
+        sum8, _mm512_max_pd(_mm512_loadu_pd(data + i), _mm512_setzero_pd()));
+  }
+  sum = _mm512_reduce_add_pd(sum8);
+#elif defined(__AVX2__)
+  __m256d sum4 = _mm256_setzero_pd();
+  for (; i + 4 <= n; i += 4) {
+    sum4 = _mm256_add_pd(
+        sum4, _mm256_max_pd(_mm256_loadu_pd(data + i), _mm256_setzero_pd()));
+  }
+  const __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4),
+                                  _mm256_extractf128_pd(sum4, 1));
+  sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+#endif
+  for (; i < n; ++i) sum += data[i] > 0 ? data[i] : 0;
+  return sum;
+}
+
+// Regret matching: the policy is proportional to the positive regrets, or
+// uniform if none is positive.
+inline void RegretMatching(absl::Span<const double> regrets,
+                           absl::Span<double> policy) {
+  SPIEL_CHECK_EQ(regrets.size(), policy.size());
+  const int n = regrets.size();
+  const double sum = SumPositive(regrets);
+  if (sum > 0) {
+    for (int i = 0; i < n; ++i) {
+      policy[i] = (regrets[i] > 0 ? regrets[i] : 0) / sum;
+    }
+  } else {
+    for (int i = 0; i < n; ++i) policy[i] = 1.0 / n;
+  }
+}
+
+// The reset of regret matching+: regrets = max(regrets, 0).
+inline void ClampNegative(absl::Span<double> regrets) {
+  for (double& regret : regrets) regret = regret > 0 ? regret : 0;
+}
+
+// The discounting of DCFR: positive regrets, including zeros, are multiplied
+// by `positive_discount` and negative ones by `negative_discount`.
+inline void DiscountRegrets(absl::Span<double> regrets,
+                            double positive_discount,
+                            double negative_discount) {
+  for (double& regret : regrets) {
+    regret *= regret >= 0 ? positive_discount : negative_discount;
+  }
+}
+
+// The regret update: regrets[i] += weight * (action_values[i] - value), with
+// the counterfactual reach probability as the weight.
+inline void AddRegrets(absl::Span<double> regrets, double weight,
+                       absl::Span<const double> action_values, double value) {
+  SPIEL_CHECK_EQ(regrets.size(), action_values.size());
+  for (int i = 0; i < regrets.size(); ++i) {
+    regrets[i] += weight * (action_values[i] - value);
+  }
+}
+
+// The average policy update: cumulative_policy += weight * policy, with the
+// reach probability of the player as the weight, times the iteration for
+// linear averaging.
+inline void AddWeightedPolicy(absl::Span<double> cumulative_policy,
+                              double weight, absl::Span<const double> policy) {
+  SPIEL_CHECK_EQ(cumulative_policy.size(), policy.size());
+  for (int i = 0; i < cumulative_policy.size(); ++i) {
+    cumulative_policy[i] += weight * policy[i];
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_KERNELS_H_
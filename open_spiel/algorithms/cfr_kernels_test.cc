@@ -0,0 +1,101 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/cfr_kernels.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+std::vector<double> RandomValues(int n, std::mt19937* rng) {
+  std::vector<double> values(n);
+  for (double& value : values) value = absl::Uniform(*rng, -1.0, 1.0);
+  return values;
+}
+
+// The sizes cover the vector loops and their scalar remainders.
+void RegretMatchingTest() {
+  std::mt19937 rng(5);
+  for (int n = 1; n <= 19; ++n) {
+    const std::vector<double> regrets = RandomValues(n, &rng);
+    double sum = 0;
+    for (double regret : regrets) sum += regret > 0 ? regret : 0;
+    SPIEL_CHECK_FLOAT_NEAR(SumPositive(regrets), sum, 1e-12);
+
+    std::vector<double> policy(n);
+    RegretMatching(regrets, absl::MakeSpan(policy));
+    double total = 0;
+    for (int i = 0; i < n; ++i) {
+      SPIEL_CHECK_FLOAT_NEAR(policy[i],
+                             sum > 0 ? std::max(regrets[i], 0.0) / sum
+                                     : 1.0 / n,
+                             1e-12);
+      total += policy[i];
+    }
+    SPIEL_CHECK_FLOAT_EQ(total, 1.0);
+  }
+  // No positive regret gives a uniform policy.
+  std::vector<double> policy(4);
+  RegretMatching(std::vector<double>{-1, 0, -2, 0}, absl::MakeSpan(policy));
+  for (double prob : policy) SPIEL_CHECK_EQ(prob, 0.25);
+}
+
+void RegretUpdatesTest() {
+  std::mt19937 rng(7);
+  for (int n = 1; n <= 19; ++n) {
+    const std::vector<double> initial = RandomValues(n, &rng);
+    const std::vector<double> values = RandomValues(n, &rng);
+
+    std::vector<double> regrets = initial;
+    ClampNegative(absl::MakeSpan(regrets));
+    for (int i = 0; i < n; ++i) {
+      SPIEL_CHECK_EQ(regrets[i], std::max(initial[i], 0.0));
+    }
+
+    regrets = initial;
+    DiscountRegrets(absl::MakeSpan(regrets), 0.75, 0.5);
+    for (int i = 0; i < n; ++i) {
+      SPIEL_CHECK_EQ(regrets[i], initial[i] * (initial[i] >= 0 ? 0.75 : 0.5));
+    }
+
+    regrets = initial;
+    AddRegrets(absl::MakeSpan(regrets), 0.5, values, 0.25);
+    for (int i = 0; i < n; ++i) {
+      SPIEL_CHECK_EQ(regrets[i], initial[i] + 0.5 * (values[i] - 0.25));
+    }
+
+    std::vector<double> cumulative_policy = initial;
+    AddWeightedPolicy(absl::MakeSpan(cumulative_policy), 3.0, values);
+    for (int i = 0; i < n; ++i) {
+      SPIEL_CHECK_EQ(cumulative_policy[i], initial[i] + 3.0 * values[i]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::RegretMatchingTest();
+  open_spiel::algorithms::RegretUpdatesTest();
+}
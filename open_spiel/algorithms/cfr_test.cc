@@ -16,6 +16,9 @@
 
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/algorithms/history_tree.h"
@@ -28,6 +31,8 @@
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/utils/file.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -59,6 +64,9 @@ void CFRTest_KuhnPoker() {
   const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
   CheckNashKuhnPoker(*game, *average_policy);
   CheckExploitabilityKuhnPoker(*game, *average_policy);
+  const DenseTabularPolicy dense_policy = solver.DenseAveragePolicy();
+  SPIEL_CHECK_FLOAT_EQ(Exploitability(*game, dense_policy),
+                       Exploitability(*game, *average_policy));
 }
 
 void CFRTest_IIGoof4() {
@@ -102,6 +110,115 @@ void CFRPlusTest_KuhnPoker() {
   CheckExploitabilityKuhnPoker(*game, *average_policy);
 }
 
+void DCFRTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  DCFRSolver solver(*game);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void LCFRTest_LeducPoker() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  LCFRSolver solver(*game);
+  for (int i = 0; i < 200; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.05);
+}
+
+void CFRTest_RegretBasedPruning() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  CFRSolver solver(*game);
+  solver.SetRegretBasedPruning(/*regret_threshold=*/-1.0,
+                               /*full_traversal_interval=*/10);
+  for (int i = 0; i < 200; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.1);
+}
+
+void CFRTest_Checkpoint() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  CFRPlusSolver solver(*game);
+  for (int i = 0; i < 10; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::string filename =
+      testing::TempFilename("cfr", ".ckpt");
+  solver.SaveCheckpoint(filename);
+  CFRPlusSolver restored_solver(*game);
+  restored_solver.LoadCheckpoint(filename);
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+
+  // Both runs continue identically, including the linear averaging weights.
+  for (int i = 0; i < 10; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    restored_solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_EQ(Exploitability(*game, *restored_solver.AveragePolicy()),
+                 Exploitability(*game, *solver.AveragePolicy()));
+}
+
+// Checks that lookups by state, which use the information state index, match
+// lookups by information state string in the subtree of `state`.
+void CheckSameLookupsByState(const State& state, const Policy& policy) {
+  if (state.IsTerminal()) return;
+  if (!state.IsChanceNode()) {
+    SPIEL_CHECK_TRUE(policy.GetStatePolicy(state) ==
+                     policy.GetStatePolicy(state.InformationStateString()));
+  }
+  for (Action action : state.LegalActions()) {
+    CheckSameLookupsByState(*state.Child(action), policy);
+  }
+}
+
+// The policies are views of the table that follow the iterations.
+void CFRTest_PolicyViews() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  const std::unique_ptr<Policy> current_policy = solver.CurrentPolicy();
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  CheckNashKuhnPoker(*game, *average_policy);
+  std::unique_ptr<State> root = game->NewInitialState();
+  CheckSameLookupsByState(*root, *average_policy);
+  CheckSameLookupsByState(*root, *current_policy);
+}
+
+// Traversals applying and undoing actions on a single state give the same
+// policies as traversals on cloned child states.
+void CFRTest_UndoMatchesClone() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  SPIEL_CHECK_TRUE(CFRSolver(*game).UseUndoAction());
+  std::shared_ptr<const Game> tiny_hanabi = LoadGame("tiny_hanabi");
+  SPIEL_CHECK_FALSE(CFRSolver(*tiny_hanabi).UseUndoAction());
+  std::vector<std::unique_ptr<CFRSolverBase>> solvers;
+  solvers.push_back(std::make_unique<CFRSolver>(*game));
+  solvers.push_back(std::make_unique<CFRSolver>(*game));
+  solvers.push_back(std::make_unique<CFRPlusSolver>(*game));
+  solvers.push_back(std::make_unique<CFRPlusSolver>(*game));
+  solvers.push_back(std::make_unique<DCFRSolver>(*game));
+  solvers.push_back(std::make_unique<DCFRSolver>(*game));
+  for (int i = 0; i < solvers.size(); i += 2) {
+    solvers[i + 1]->SetUseUndoAction(false);
+    SPIEL_CHECK_FALSE(solvers[i + 1]->UseUndoAction());
+    for (int j = 0; j < 50; ++j) {
+      solvers[i]->EvaluateAndUpdatePolicy();
+      solvers[i + 1]->EvaluateAndUpdatePolicy();
+    }
+    std::unique_ptr<State> root = game->NewInitialState();
+    SPIEL_CHECK_TRUE(
+        ExpectedReturns(*root, *solvers[i]->AveragePolicy(), -1) ==
+        ExpectedReturns(*root, *solvers[i + 1]->AveragePolicy(), -1));
+  }
+}
+
 void CFRTest_KuhnPokerRunsWithThreePlayers(bool linear_averaging,
                                            bool regret_matching_plus,
                                            bool alternating_updates) {
@@ -192,6 +309,11 @@ int main(int argc, char** argv) {
   algorithms::CFRTest_KuhnPoker();
   algorithms::CFRTest_IIGoof4();
   algorithms::CFRPlusTest_KuhnPoker();
+  algorithms::DCFRTest_KuhnPoker();
+  algorithms::LCFRTest_LeducPoker();
+  algorithms::CFRTest_RegretBasedPruning();
+  algorithms::CFRTest_Checkpoint();
+  algorithms::CFRTest_PolicyViews();
   algorithms::CFRTest_KuhnPokerRunsWithThreePlayers(
       /*linear_averaging=*/false,
       /*regret_matching_plus=*/false,
@@ -235,6 +357,8 @@ int main(int argc, char** argv) {
   //   /*game_name=*/"leduc_poker", /*num_players=*/3, /*num_iterations=*/2,
   //   /*nashconv_upper_bound=*/10.0);
 
+  algorithms::CFRTest_UndoMatchesClone();
+
   // Test a few one-shot games.
   algorithms::CFRTest_OneShotGameTest(1000, "matrix_rps", 1e-6);
   algorithms::CFRTest_OneShotGameTest(1000, "matrix_shapleys_game", 1.0);
@@ -0,0 +1,290 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/deep_cfr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+DeepCFRReservoir::DeepCFRReservoir(int capacity, int input_size,
+                                   int num_actions, int seed)
+    : capacity_(capacity),
+      input_size_(input_size),
+      num_actions_(num_actions),
+      rng_(seed) {
+  SPIEL_CHECK_GT(capacity, 0);
+}
+
+void DeepCFRReservoir::Add(int num, absl::Span<const float> info_states,
+                           absl::Span<const int> iterations,
+                           absl::Span<const float> targets) {
+  SPIEL_CHECK_EQ(info_states.size(), num * input_size_);
+  SPIEL_CHECK_EQ(iterations.size(), num);
+  SPIEL_CHECK_EQ(targets.size(), num * num_actions_);
+  absl::MutexLock lock(&mu_);
+  for (int i = 0; i < num; ++i) {
+    absl::Span<const float> info_state =
+        info_states.subspan(i * input_size_, input_size_);
+    absl::Span<const float> target =
+        targets.subspan(i * num_actions_, num_actions_);
+    const int64_t n = total_added_++;
+    if (n < capacity_) {
+      // The storage grows with the samples, up to the capacity.
+      info_states_.insert(info_states_.end(), info_state.begin(),
+                          info_state.end());
+      iterations_.push_back(iterations[i]);
+      targets_.insert(targets_.end(), target.begin(), target.end());
+      continue;
+    }
+    const int64_t index = std::uniform_int_distribution<int64_t>(0, n)(rng_);
+    if (index >= capacity_) continue;
+    std::copy(info_state.begin(), info_state.end(),
+              info_states_.begin() + index * input_size_);
+    iterations_[index] = iterations[i];
+    std::copy(target.begin(), target.end(),
+              targets_.begin() + index * num_actions_);
+  }
+}
+
+void DeepCFRReservoir::CopyRow(int index, int row, DeepCFRBatch* batch) const {
+  std::copy_n(info_states_.begin() + index * input_size_, input_size_,
+              batch->info_states.begin() + row * input_size_);
+  batch->iterations[row] = iterations_[index];
+  std::copy_n(targets_.begin() + index * num_actions_, num_actions_,
+              batch->targets.begin() + row * num_actions_);
+}
+
+DeepCFRBatch DeepCFRReservoir::Sample(int num, std::mt19937* rng) const {
+  absl::ReaderMutexLock lock(&mu_);
+  const int size = iterations_.size();
+  DeepCFRBatch batch;
+  batch.size = size == 0 ? 0 : num;
+  batch.info_states.resize(batch.size * input_size_);
+  batch.iterations.resize(batch.size);
+  batch.targets.resize(batch.size * num_actions_);
+  std::uniform_int_distribution<int> dist(0, std::max(size - 1, 0));
+  for (int row = 0; row < batch.size; ++row) {
+    CopyRow(dist(*rng), row, &batch);
+  }
+  return batch;
+}
+
+DeepCFRBatch DeepCFRReservoir::Contents() const {
+  absl::ReaderMutexLock lock(&mu_);
+  DeepCFRBatch batch;
+  batch.size = iterations_.size();
+  batch.info_states = info_states_;
+  batch.iterations = iterations_;
+  batch.targets = targets_;
+  return batch;
+}
+
+void DeepCFRReservoir::Clear() {
+  absl::MutexLock lock(&mu_);
+  total_added_ = 0;
+  info_states_.clear();
+  iterations_.clear();
+  targets_.clear();
+}
+
+int DeepCFRReservoir::Size() const {
+  absl::ReaderMutexLock lock(&mu_);
+  return iterations_.size();
+}
+
+int64_t DeepCFRReservoir::TotalAdded() const {
+  absl::ReaderMutexLock lock(&mu_);
+  return total_added_;
+}
+
+void DeepCFRSampler::Samples::Add(absl::Span<const float> info_state,
+                                  int iteration,
+                                  absl::Span<const float> target) {
+  ++size;
+  info_states.insert(info_states.end(), info_state.begin(), info_state.end());
+  iterations.push_back(iteration);
+  targets.insert(targets.end(), target.begin(), target.end());
+}
+
+DeepCFRSampler::DeepCFRSampler(const Game& game, int advantage_capacity,
+                               int strategy_capacity, int seed)
+    : game_(game.shared_from_this()),
+      input_size_(InferenceInputSize(game)),
+      num_actions_(game.NumDistinctActions()),
+      seed_(seed),
+      models_(game.NumPlayers()),
+      strategy_reservoir_(strategy_capacity, input_size_, num_actions_,
+                          seed + game.NumPlayers()) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "Deep CFR requires sequential games. If you're trying to run it "
+        "on a simultaneous (or normal-form) game, please first transform it "
+        "using turn_based_simultaneous_game.");
+  }
+  for (Player p = 0; p < game.NumPlayers(); ++p) {
+    advantage_reservoirs_.push_back(std::make_unique<DeepCFRReservoir>(
+        advantage_capacity, input_size_, num_actions_, seed + p));
+  }
+}
+
+void DeepCFRSampler::SetAdvantageModel(
+    Player player, std::shared_ptr<const InferenceModel> model) {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, models_.size());
+  if (model != nullptr) {
+    SPIEL_CHECK_EQ(model->InputSize(), input_size_);
+    SPIEL_CHECK_EQ(model->NumActions(), num_actions_);
+  }
+  models_[player] = std::move(model);
+}
+
+void DeepCFRSampler::Traverse(Player player, int iteration,
+                              int num_traversals, int num_threads) {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, models_.size());
+  SPIEL_CHECK_GE(num_traversals, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  std::vector<std::shared_ptr<const InferenceModel>> models = models_;
+  if (num_threads > 1) {
+    for (auto& model : models) {
+      if (model != nullptr) {
+        model = std::make_shared<BatchingInferenceModel>(std::move(model),
+                                                         num_threads);
+      }
+    }
+  }
+  const int64_t first_traversal = num_traversals_.fetch_add(num_traversals);
+  std::atomic<int> next_traversal{0};
+  auto run = [&]() {
+    int64_t num_nodes = 0;
+    Samples advantages;
+    Samples strategies;
+    for (int i; (i = next_traversal++) < num_traversals;) {
+      std::seed_seq seed{static_cast<int64_t>(seed_), first_traversal + i};
+      std::mt19937 rng(seed);
+      TraverseState(*game_->NewInitialState(), player, iteration, models,
+                    &rng, &advantages, &strategies, &num_nodes);
+      advantage_reservoirs_[player]->Add(advantages.size,
+                                         advantages.info_states,
+                                         advantages.iterations,
+                                         advantages.targets);
+      strategy_reservoir_.Add(strategies.size, strategies.info_states,
+                              strategies.iterations, strategies.targets);
+      advantages = Samples();
+      strategies = Samples();
+    }
+    num_nodes_visited_ += num_nodes;
+  };
+  if (num_threads == 1) {
+    run();
+    return;
+  }
+  std::vector<Thread> threads;
+  for (int t = 0; t < num_threads; ++t) threads.emplace_back(run);
+  for (Thread& thread : threads) thread.join();
+}
+
+std::vector<float> DeepCFRSampler::Policy(
+    const State& state, const InferenceModel* model,
+    std::vector<float>* info_state) const {
+  info_state->resize(input_size_);
+  std::vector<float> legal_mask(num_actions_);
+  FillInferenceRow(state, absl::MakeSpan(*info_state),
+                   absl::MakeSpan(legal_mask));
+  std::vector<float> advantages(num_actions_, 0);
+  if (model != nullptr) {
+    model->Infer(1, *info_state, legal_mask, absl::MakeSpan(advantages), {});
+  }
+  // Regret matching on the positive advantages of the legal actions.
+  float total = 0;
+  for (int a = 0; a < num_actions_; ++a) {
+    advantages[a] = legal_mask[a] ? std::max(advantages[a], 0.0f) : 0;
+    total += advantages[a];
+  }
+  if (total <= 0) {
+    advantages = legal_mask;
+    total = std::count(legal_mask.begin(), legal_mask.end(), 1.0f);
+  }
+  for (float& prob : advantages) prob /= total;
+  return advantages;
+}
+
+double DeepCFRSampler::TraverseState(
+    const State& state, Player player, int iteration,
+    const std::vector<std::shared_ptr<const InferenceModel>>& models,
+    std::mt19937* rng, Samples* advantages, Samples* strategies,
+    int64_t* num_nodes) const {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(player);
+  } else if (state.IsChanceNode()) {
+    Action action = state.SampleChanceOutcome(*rng).first;
+    return TraverseState(*state.Child(action), player, iteration, models, rng,
+                         advantages, strategies, num_nodes);
+  }
+
+  ++*num_nodes;
+  const Player cur_player = state.CurrentPlayer();
+  std::vector<float> info_state;
+  std::vector<float> policy =
+      Policy(state, models[cur_player].get(), &info_state);
+  const std::vector<Action> legal_actions = state.LegalActions();
+
+  if (cur_player != player) {
+    // Sample at the others' nodes, recording their policy.
+    strategies->Add(info_state, iteration, policy);
+    std::uniform_real_distribution<double> dist(0, 1);
+    const double z = dist(*rng);
+    double sum = 0;
+    Action action = legal_actions.back();
+    for (Action a : legal_actions) {
+      sum += policy[a];
+      if (z < sum) {
+        action = a;
+        break;
+      }
+    }
+    return TraverseState(*state.Child(action), player, iteration, models, rng,
+                         advantages, strategies, num_nodes);
+  }
+
+  // Walk over all the actions at the traverser's nodes.
+  std::vector<double> child_values(num_actions_, 0);
+  double value = 0;
+  for (Action a : legal_actions) {
+    child_values[a] = TraverseState(*state.Child(a), player, iteration, models,
+                                    rng, advantages, strategies, num_nodes);
+    value += policy[a] * child_values[a];
+  }
+  std::vector<float> regrets(num_actions_, 0);
+  for (Action a : legal_actions) regrets[a] = child_values[a] - value;
+  advantages->Add(info_state, iteration, regrets);
+  return value;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,175 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DEEP_CFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DEEP_CFR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+
+// The data generation of Deep CFR (Brown et al., "Deep Counterfactual Regret
+// Minimization", 2019, https://arxiv.org/abs/1811.00164), as in
+// python/algorithms/deep_cfr.py: external sampling traversals of the game
+// following the regret matching policy of advantage networks, producing
+// advantage samples at the traverser's nodes and strategy samples at the
+// others' nodes, kept in reservoir buffers for the networks to be trained on.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Samples drawn from a DeepCFRReservoir, as row-major arrays.
+struct DeepCFRBatch {
+  int size = 0;
+  std::vector<float> info_states;  // [size, input_size]
+  std::vector<int> iterations;     // [size]
+  std::vector<float> targets;      // [size, num_actions]
+};
+
+// A reservoir of up to `capacity` samples, each the input of a network (the
+// information state tensor, as for InferenceModels), the iteration it was
+// produced at and a target over the actions, stored as contiguous row-major
+// arrays. Once it is full, the n-th sample added replaces a random one with
+// probability capacity / n, so that it holds a uniform sample of all those
+// added. Any number of threads can add to it and sample from it at once.
+class DeepCFRReservoir {
+ public:
+  DeepCFRReservoir(int capacity, int input_size, int num_actions,
+                   int seed = 0);
+
+  DeepCFRReservoir(const DeepCFRReservoir&) = delete;
+  DeepCFRReservoir& operator=(const DeepCFRReservoir&) = delete;
+
+  // Adds the rows of [num, InputSize()] info_states, [num] iterations and
+  // [num, NumActions()] targets.
+  void Add(int num, absl::Span<const float> info_states,
+           absl::Span<const int> iterations, absl::Span<const float> targets);
+
+  // Returns `num` samples drawn uniformly with replacement, or none if the
+  // reservoir is empty.
+  DeepCFRBatch Sample(int num, std::mt19937* rng) const;
+
+  // Returns all the samples, in the order of their slots.
+  DeepCFRBatch Contents() const;
+
+  void Clear();
+
+  int Size() const;
+  int64_t TotalAdded() const;
+  int Capacity() const { return capacity_; }
+  int InputSize() const { return input_size_; }
+  int NumActions() const { return num_actions_; }
+
+ private:
+  // Copies row `index` into row `row` of `batch`.
+  void CopyRow(int index, int row, DeepCFRBatch* batch) const
+      ABSL_SHARED_LOCKS_REQUIRED(mu_);
+
+  const int capacity_;
+  const int input_size_;
+  const int num_actions_;
+
+  mutable absl::Mutex mu_;
+  std::mt19937 rng_ ABSL_GUARDED_BY(mu_);
+  int64_t total_added_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<float> info_states_ ABSL_GUARDED_BY(mu_);
+  std::vector<int> iterations_ ABSL_GUARDED_BY(mu_);
+  std::vector<float> targets_ ABSL_GUARDED_BY(mu_);
+};
+
+// Runs the traversals of Deep CFR, with an advantage network per player given
+// as an InferenceModel whose policies are read as the advantages of the
+// actions, and whose values are not used. A network can be a PyInferenceModel
+// calling into Python. The policy at a node is given by regret matching on the
+// advantages of the legal actions: proportional to their positive parts, or
+// uniform if none is positive, as for a player without a network.
+//
+// The advantage samples of each player, whose targets are the sampled regrets
+// of the actions (0 for illegal ones), go to a reservoir per player, and the
+// strategy samples, whose targets are the policies, to a reservoir shared by
+// all players.
+class DeepCFRSampler {
+ public:
+  DeepCFRSampler(const Game& game, int advantage_capacity,
+                 int strategy_capacity, int seed = 0);
+
+  // Sets the advantage network of `player`, or nullptr for none. The network
+  // must not be changed during a Traverse.
+  void SetAdvantageModel(Player player,
+                         std::shared_ptr<const InferenceModel> model);
+
+  // Runs num_traversals traversals for `player`, whose samples are tagged
+  // with `iteration`, on num_threads threads. With several threads, their
+  // concurrent calls to each network are merged into batches of up to
+  // num_threads rows by a BatchingInferenceModel. The k-th traversal ever run
+  // uses a random number generator seeded from the seed and k, so that with
+  // deterministic networks the samples do not depend on num_threads, only
+  // their order in the reservoirs does.
+  void Traverse(Player player, int iteration, int num_traversals,
+                int num_threads = 1);
+
+  DeepCFRReservoir& AdvantageReservoir(Player player) {
+    return *advantage_reservoirs_[player];
+  }
+  DeepCFRReservoir& StrategyReservoir() { return strategy_reservoir_; }
+
+  // The number of traversals run, and of decision nodes they visited.
+  int64_t NumTraversals() const { return num_traversals_; }
+  int64_t NumNodesVisited() const { return num_nodes_visited_; }
+
+ private:
+  // The samples of a traversal, added to the reservoirs at its end.
+  struct Samples {
+    void Add(absl::Span<const float> info_state, int iteration,
+             absl::Span<const float> target);
+
+    int size = 0;
+    std::vector<float> info_states;
+    std::vector<int> iterations;
+    std::vector<float> targets;
+  };
+
+  double TraverseState(
+      const State& state, Player player, int iteration,
+      const std::vector<std::shared_ptr<const InferenceModel>>& models,
+      std::mt19937* rng, Samples* advantages, Samples* strategies,
+      int64_t* num_nodes) const;
+
+  // Returns the policy of the player to move in `state` over all actions,
+  // writing the input of the network into `info_state`.
+  std::vector<float> Policy(const State& state, const InferenceModel* model,
+                            std::vector<float>* info_state) const;
+
+  std::shared_ptr<const Game> game_;
+  const int input_size_;
+  const int num_actions_;
+  const int seed_;
+  std::vector<std::shared_ptr<const InferenceModel>> models_;
+  std::vector<std::unique_ptr<DeepCFRReservoir>> advantage_reservoirs_;
+  DeepCFRReservoir strategy_reservoir_;
+  std::atomic<int64_t> num_traversals_{0};
+  std::atomic<int64_t> num_nodes_visited_{0};
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DEEP_CFR_H_
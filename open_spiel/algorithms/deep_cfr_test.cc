@@ -0,0 +1,215 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/deep_cfr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Advantages given by a fixed linear function of the input.
+class LinearAdvantageModel : public InferenceModel {
+ public:
+  LinearAdvantageModel(int input_size, int num_actions)
+      : input_size_(input_size), num_actions_(num_actions) {}
+
+  int InputSize() const override { return input_size_; }
+  int NumActions() const override { return num_actions_; }
+
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override {
+    SPIEL_CHECK_TRUE(values.empty());
+    for (int b = 0; b < batch_size; ++b) {
+      for (int a = 0; a < num_actions_; ++a) {
+        float sum = a;
+        for (int i = 0; i < input_size_; ++i) {
+          sum += inputs[b * input_size_ + i] * ((i + a) % 3 - 1);
+        }
+        policies[b * num_actions_ + a] = sum;
+      }
+    }
+  }
+
+ private:
+  const int input_size_;
+  const int num_actions_;
+};
+
+void ReservoirKeepsAUniformSample() {
+  DeepCFRReservoir reservoir(/*capacity=*/100, /*input_size=*/2,
+                             /*num_actions=*/3, /*seed=*/7);
+  std::vector<float> info_states;
+  std::vector<int> iterations;
+  std::vector<float> targets;
+  for (int i = 0; i < 1000; ++i) {
+    info_states.insert(info_states.end(), {1.0f * i, 0});
+    iterations.push_back(i);
+    targets.insert(targets.end(), {-1.0f * i, 0, 1});
+  }
+  reservoir.Add(500, absl::MakeSpan(info_states).subspan(0, 1000),
+                absl::MakeSpan(iterations).subspan(0, 500),
+                absl::MakeSpan(targets).subspan(0, 1500));
+  reservoir.Add(500, absl::MakeSpan(info_states).subspan(1000),
+                absl::MakeSpan(iterations).subspan(500),
+                absl::MakeSpan(targets).subspan(1500));
+  SPIEL_CHECK_EQ(reservoir.Size(), 100);
+  SPIEL_CHECK_EQ(reservoir.TotalAdded(), 1000);
+
+  DeepCFRBatch contents = reservoir.Contents();
+  SPIEL_CHECK_EQ(contents.size, 100);
+  double mean = 0;
+  int num_late = 0;
+  for (int row = 0; row < contents.size; ++row) {
+    const int iteration = contents.iterations[row];
+    SPIEL_CHECK_EQ(contents.info_states[2 * row], iteration);
+    SPIEL_CHECK_EQ(contents.targets[3 * row], -iteration);
+    mean += iteration / 100.0;
+    if (iteration >= 500) ++num_late;
+  }
+  // Not just the first or last samples added.
+  SPIEL_CHECK_GT(mean, 300);
+  SPIEL_CHECK_LT(mean, 700);
+  SPIEL_CHECK_GT(num_late, 25);
+
+  std::mt19937 rng(1);
+  DeepCFRBatch batch = reservoir.Sample(300, &rng);
+  SPIEL_CHECK_EQ(batch.size, 300);
+  SPIEL_CHECK_EQ(batch.info_states.size(), 600);
+  for (int row = 0; row < batch.size; ++row) {
+    SPIEL_CHECK_EQ(batch.targets[3 * row], -batch.iterations[row]);
+  }
+
+  reservoir.Clear();
+  SPIEL_CHECK_EQ(reservoir.Size(), 0);
+  SPIEL_CHECK_EQ(reservoir.Sample(10, &rng).size, 0);
+}
+
+// Without networks, the policies are uniform, so that the regrets of the
+// legal actions sum to 0.
+void UniformTraversals() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  DeepCFRSampler sampler(*game, 10000, 10000);
+  sampler.Traverse(/*player=*/0, /*iteration=*/1, /*num_traversals=*/100);
+  sampler.Traverse(/*player=*/1, /*iteration=*/2, /*num_traversals=*/100);
+  SPIEL_CHECK_EQ(sampler.NumTraversals(), 200);
+
+  for (Player player : {0, 1}) {
+    DeepCFRBatch advantages = sampler.AdvantageReservoir(player).Contents();
+    // The first decision, and one after each of the other's actions.
+    SPIEL_CHECK_GE(advantages.size, 100);
+    for (int row = 0; row < advantages.size; ++row) {
+      SPIEL_CHECK_EQ(advantages.iterations[row], player + 1);
+      SPIEL_CHECK_FLOAT_NEAR(
+          advantages.targets[2 * row] + advantages.targets[2 * row + 1], 0,
+          1e-6);
+    }
+  }
+  DeepCFRBatch strategies = sampler.StrategyReservoir().Contents();
+  SPIEL_CHECK_GE(strategies.size, 200);
+  for (int row = 0; row < strategies.size; ++row) {
+    SPIEL_CHECK_EQ(strategies.targets[2 * row], 0.5);
+    SPIEL_CHECK_EQ(strategies.targets[2 * row + 1], 0.5);
+  }
+}
+
+// Sorts the samples of a reservoir, to compare them in any order.
+std::vector<std::tuple<std::vector<float>, int, std::vector<float>>>
+SortedSamples(const DeepCFRReservoir& reservoir) {
+  DeepCFRBatch batch = reservoir.Contents();
+  const int input_size = reservoir.InputSize();
+  const int num_actions = reservoir.NumActions();
+  std::vector<std::tuple<std::vector<float>, int, std::vector<float>>> samples;
+  for (int row = 0; row < batch.size; ++row) {
+    samples.emplace_back(
+        std::vector<float>(batch.info_states.begin() + row * input_size,
+                           batch.info_states.begin() + (row + 1) * input_size),
+        batch.iterations[row],
+        std::vector<float>(batch.targets.begin() + row * num_actions,
+                           batch.targets.begin() + (row + 1) * num_actions));
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples;
+}
+
+// With networks, the samples follow their regret matching policies, and do
+// not depend on the number of threads.
+void TraversalsWithModels(const std::string& game_string) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  auto model = std::make_shared<LinearAdvantageModel>(
+      InferenceInputSize(*game), game->NumDistinctActions());
+  DeepCFRSampler serial(*game, 100000, 100000, /*seed=*/5);
+  DeepCFRSampler parallel(*game, 100000, 100000, /*seed=*/5);
+  for (DeepCFRSampler* sampler : {&serial, &parallel}) {
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      sampler->SetAdvantageModel(p, model);
+    }
+  }
+  serial.Traverse(0, 3, 50);
+  parallel.Traverse(0, 3, 50, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(serial.NumNodesVisited(), parallel.NumNodesVisited());
+  SPIEL_CHECK_GT(serial.AdvantageReservoir(0).Size(), 0);
+  SPIEL_CHECK_TRUE(SortedSamples(serial.AdvantageReservoir(0)) ==
+                   SortedSamples(parallel.AdvantageReservoir(0)));
+  SPIEL_CHECK_TRUE(SortedSamples(serial.StrategyReservoir()) ==
+                   SortedSamples(parallel.StrategyReservoir()));
+
+  // The strategies are the regret matching policies of the model.
+  DeepCFRBatch strategies = serial.StrategyReservoir().Contents();
+  const int input_size = InferenceInputSize(*game);
+  const int num_actions = game->NumDistinctActions();
+  std::vector<float> advantages(num_actions);
+  for (int row = 0; row < strategies.size; ++row) {
+    absl::Span<const float> input = absl::MakeSpan(strategies.info_states)
+                                        .subspan(row * input_size, input_size);
+    absl::Span<const float> policy =
+        absl::MakeSpan(strategies.targets)
+            .subspan(row * num_actions, num_actions);
+    std::vector<float> mask(num_actions, 1);
+    model->Infer(1, input, mask, absl::MakeSpan(advantages), {});
+    float total = 0;
+    for (int a = 0; a < num_actions; ++a) {
+      if (policy[a] > 0) total += std::max(advantages[a], 0.0f);
+    }
+    for (int a = 0; a < num_actions; ++a) {
+      if (policy[a] > 0 && total > 0) {
+        SPIEL_CHECK_FLOAT_NEAR(policy[a], advantages[a] / total, 1e-5);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::ReservoirKeepsAUniformSample();
+  open_spiel::algorithms::UniformTraversals();
+  open_spiel::algorithms::TraversalsWithModels("kuhn_poker");
+  open_spiel::algorithms::TraversalsWithModels("leduc_poker");
+}
@@ -14,6 +14,12 @@
 
 #include "open_spiel/algorithms/deterministic_policy.h"
 
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/algorithms/get_legal_actions_map.h"
 
 namespace open_spiel {
@@ -74,6 +80,36 @@ bool DeterministicTabularPolicy::NextPolicy() {
   return false;
 }
 
+int64_t DeterministicTabularPolicy::NumPolicies() const {
+  int64_t num_policies = 1;
+  for (const auto& info_state_entry : table_) {
+    const int num_actions = info_state_entry.second.legal_actions_.size();
+    SPIEL_CHECK_LE(num_policies,
+                   std::numeric_limits<int64_t>::max() / num_actions);
+    num_policies *= num_actions;
+  }
+  return num_policies;
+}
+
+int64_t DeterministicTabularPolicy::PolicyIndex() const {
+  // Horner's scheme, from the most significant digit.
+  int64_t index = 0;
+  for (auto iter = table_.rbegin(); iter != table_.rend(); ++iter) {
+    index = index * iter->second.legal_actions_.size() + iter->second.index;
+  }
+  return index;
+}
+
+void DeterministicTabularPolicy::SetPolicyIndex(int64_t index) {
+  SPIEL_CHECK_GE(index, 0);
+  for (auto& info_state_entry : table_) {
+    const int num_actions = info_state_entry.second.legal_actions_.size();
+    info_state_entry.second.index = index % num_actions;
+    index /= num_actions;
+  }
+  SPIEL_CHECK_EQ(index, 0);
+}
+
 void DeterministicTabularPolicy::ResetDefaultPolicy() {
   for (auto& info_state_entry : table_) {
     info_state_entry.second.index = 0;
@@ -81,11 +117,11 @@ void DeterministicTabularPolicy::ResetDefaultPolicy() {
 }
 
 void DeterministicTabularPolicy::CreateTable(const Game& game, Player player) {
-  std::unordered_map<std::string, std::vector<Action>> legal_actions_map =
-      GetLegalActionsMap(game, -1, player);
-  for (const auto& info_state_actions : legal_actions_map) {
-    table_[info_state_actions.first] =
-        LegalsWithIndex(info_state_actions.second);
+  const LegalActionsIndex index = GetLegalActionsIndex(game, -1, player);
+  for (int i = 0; i < index.NumInfoStates(); ++i) {
+    absl::Span<const Action> legal_actions = index.LegalActions(i);
+    table_[index.InfoState(i)] = LegalsWithIndex(
+        std::vector<Action>(legal_actions.begin(), legal_actions.end()));
   }
 }
 
@@ -99,5 +135,81 @@ std::string DeterministicTabularPolicy::ToString(
   return str;
 }
 
+DeterministicPolicySpace::DeterministicPolicySpace(const Game& game,
+                                                   Player player)
+    : player_(player), num_policies_(1) {
+  const LegalActionsIndex index = GetLegalActionsIndex(game, -1, player);
+  info_states_.reserve(index.NumInfoStates());
+  for (int i = 0; i < index.NumInfoStates(); ++i) {
+    info_states_.push_back(index.InfoState(i));
+  }
+  std::sort(info_states_.begin(), info_states_.end());
+
+  offsets_.reserve(info_states_.size() + 1);
+  offsets_.push_back(0);
+  place_values_.reserve(info_states_.size());
+  for (const std::string& info_state : info_states_) {
+    absl::Span<const Action> actions =
+        index.LegalActions(index.InfoStateIndex(info_state));
+    SPIEL_CHECK_FALSE(actions.empty());
+    legal_actions_.insert(legal_actions_.end(), actions.begin(),
+                          actions.end());
+    offsets_.push_back(legal_actions_.size());
+    place_values_.push_back(num_policies_);
+    if (num_policies_ == kOverflow ||
+        num_policies_ > std::numeric_limits<int64_t>::max() / actions.size()) {
+      num_policies_ = kOverflow;
+    } else {
+      num_policies_ *= actions.size();
+    }
+  }
+}
+
+int DeterministicPolicySpace::InfoStateIndex(
+    const std::string& info_state) const {
+  auto iter =
+      std::lower_bound(info_states_.begin(), info_states_.end(), info_state);
+  if (iter == info_states_.end() || *iter != info_state) return -1;
+  return iter - info_states_.begin();
+}
+
+int64_t DeterministicPolicySpace::NumPolicies() const {
+  if (num_policies_ == kOverflow) {
+    SpielFatalError(absl::StrCat("Player ", player_,
+                                 " has too many deterministic policies to "
+                                 "number them with an int64_t"));
+  }
+  return num_policies_;
+}
+
+int64_t DeterministicPolicySpace::PolicyIndex(
+    const std::vector<int>& action_indices) const {
+  SPIEL_CHECK_EQ(action_indices.size(), NumInfoStates());
+  int64_t policy = 0;
+  for (int i = 0; i < NumInfoStates(); ++i) {
+    SPIEL_CHECK_GE(action_indices[i], 0);
+    SPIEL_CHECK_LT(action_indices[i], LegalActions(i).size());
+    if (action_indices[i] == 0) continue;
+    SPIEL_CHECK_NE(place_values_[i], kOverflow);
+    SPIEL_CHECK_LE(place_values_[i],
+                   (std::numeric_limits<int64_t>::max() - policy) /
+                       action_indices[i]);
+    policy += action_indices[i] * place_values_[i];
+  }
+  return policy;
+}
+
+std::string DeterministicPolicySpace::PolicyToString(
+    int64_t policy, const std::string& delimiter) const {
+  SPIEL_CHECK_GE(policy, 0);
+  if (num_policies_ != kOverflow) SPIEL_CHECK_LT(policy, num_policies_);
+  std::string str = "";
+  for (int i = 0; i < NumInfoStates(); ++i) {
+    absl::StrAppend(&str, info_states_[i], " ", delimiter, " ",
+                    "action = ", GetAction(policy, i), "\n");
+  }
+  return str;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -16,11 +16,13 @@
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DETERMINISTIC_POLICY_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <string>
 #include <map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -88,6 +90,17 @@ class DeterministicTabularPolicy : public Policy {
   // there exists a next policy in the order), otherwise returns false.
   bool NextPolicy();
 
+  // The number of deterministic policies, i.e. the product of the numbers of
+  // legal actions at all the information states. Fails if it does not fit in
+  // an int64_t.
+  int64_t NumPolicies() const;
+
+  // The position of this policy in the total order above, and a jump to the
+  // policy at `index` there, in time linear in the number of information
+  // states rather than in `index`.
+  int64_t PolicyIndex() const;
+  void SetPolicyIndex(int64_t index);
+
   // Resets the policy to the first one in the total order defined above: all
   // actions set to their first legal action (index = 0 in the legal actions
   // list).
@@ -104,6 +117,69 @@ class DeterministicTabularPolicy : public Policy {
   Player player_;
 };
 
+// The deterministic policies of a player, each represented by its index in
+// the total order of DeterministicTabularPolicy::NextPolicy: a mixed-radix
+// integer whose i-th digit, of base the number of legal actions at the i-th
+// information state (in string order), is the index of the action chosen
+// there. The information states and legal actions are stored once, so that
+// policies are plain integers, and any digit of any policy is computed
+// directly, e.g. to split the policies between threads by index range.
+class DeterministicPolicySpace {
+ public:
+  DeterministicPolicySpace(const Game& game, Player player);
+
+  Player GetPlayer() const { return player_; }
+  int NumInfoStates() const { return info_states_.size(); }
+  const std::string& InfoState(int i) const { return info_states_[i]; }
+  absl::Span<const Action> LegalActions(int i) const {
+    return absl::MakeConstSpan(legal_actions_)
+        .subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+  // The index of the information state, or -1 if the player never sees it.
+  int InfoStateIndex(const std::string& info_state) const;
+
+  // The number of policies. Fails if it does not fit in an int64_t, in
+  // which case the policies up to the largest int64_t can still be used.
+  int64_t NumPolicies() const;
+
+  // The index in LegalActions(info_state) of the action that `policy`
+  // chooses at `info_state`, and that action.
+  int ActionIndex(int64_t policy, int info_state) const {
+    if (place_values_[info_state] == kOverflow) return 0;
+    return policy / place_values_[info_state] %
+           (offsets_[info_state + 1] - offsets_[info_state]);
+  }
+  Action GetAction(int64_t policy, int info_state) const {
+    return legal_actions_[offsets_[info_state] +
+                          ActionIndex(policy, info_state)];
+  }
+
+  // The policy choosing the action at the given index at each information
+  // state.
+  int64_t PolicyIndex(const std::vector<int>& action_indices) const;
+
+  // The same string as DeterministicTabularPolicy::ToString for `policy`.
+  std::string PolicyToString(int64_t policy,
+                             const std::string& delimiter) const;
+
+ private:
+  // The place value of the digits of the policies past the largest int64_t,
+  // which are always 0.
+  static constexpr int64_t kOverflow = -1;
+
+  Player player_;
+  std::vector<std::string> info_states_;
+  // The legal actions of the i-th information state are those from
+  // offsets_[i] to offsets_[i + 1].
+  std::vector<int> offsets_;
+  std::vector<Action> legal_actions_;
+  // The value of a unit of each digit, i.e. the product of the numbers of
+  // legal actions at the information states before it, or kOverflow.
+  std::vector<int64_t> place_values_;
+  // The number of policies, or kOverflow.
+  int64_t num_policies_;
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/deterministic_policy.h"
 
+#include <cstdint>
+#include <vector>
+
 #include "open_spiel/games/kuhn_poker.h"
 
 namespace open_spiel {
@@ -37,6 +40,57 @@ void KuhnDeterministicPolicyTest() {
     p1_policies += 1;
   }
   SPIEL_CHECK_EQ(p1_policies, 64);  // 2^6
+  SPIEL_CHECK_EQ(p1_policy.NumPolicies(), 64);
+}
+
+// Policies by index match the enumeration order of NextPolicy.
+void PolicyIndexTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  for (Player player : {0, 1}) {
+    DeterministicTabularPolicy policy(*game, player);
+    DeterministicTabularPolicy seeker(*game, player);
+    const DeterministicPolicySpace space(*game, player);
+    SPIEL_CHECK_EQ(space.NumInfoStates(), 468);
+    // The policies are too many to enumerate, so check the first ones and
+    // some seeks far into the order.
+    for (int64_t k = 0; k < 1000; ++k) {
+      SPIEL_CHECK_EQ(policy.PolicyIndex(), k);
+      seeker.SetPolicyIndex(k);
+      SPIEL_CHECK_EQ(seeker.ToString("/"), policy.ToString("/"));
+      SPIEL_CHECK_EQ(space.PolicyToString(k, "/"), policy.ToString("/"));
+      SPIEL_CHECK_TRUE(policy.NextPolicy());
+    }
+    for (int64_t k : {int64_t{123456789}, int64_t{1} << 62}) {
+      seeker.SetPolicyIndex(k);
+      SPIEL_CHECK_EQ(seeker.PolicyIndex(), k);
+      std::vector<int> action_indices;
+      for (int i = 0; i < space.NumInfoStates(); ++i) {
+        action_indices.push_back(space.ActionIndex(k, i));
+        SPIEL_CHECK_EQ(space.GetAction(k, i),
+                       seeker.GetAction(space.InfoState(i)));
+      }
+      SPIEL_CHECK_EQ(space.PolicyIndex(action_indices), k);
+    }
+  }
+}
+
+void KuhnPolicySpaceTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  const DeterministicPolicySpace space(*game, Player{0});
+  SPIEL_CHECK_EQ(space.NumPolicies(), 64);
+  SPIEL_CHECK_EQ(space.NumInfoStates(), 6);
+  SPIEL_CHECK_EQ(space.InfoStateIndex("no such state"), -1);
+  for (int i = 0; i < space.NumInfoStates(); ++i) {
+    SPIEL_CHECK_EQ(space.InfoStateIndex(space.InfoState(i)), i);
+    SPIEL_CHECK_EQ(space.LegalActions(i).size(), 2);
+  }
+  // The last policy takes the last action everywhere.
+  for (int i = 0; i < space.NumInfoStates(); ++i) {
+    SPIEL_CHECK_EQ(space.ActionIndex(63, i), 1);
+  }
+  // The first information state is the least significant digit.
+  SPIEL_CHECK_EQ(space.ActionIndex(1, 0), 1);
+  SPIEL_CHECK_EQ(space.ActionIndex(1, 1), 0);
 }
 
 }  // namespace
@@ -45,4 +99,6 @@ void KuhnDeterministicPolicyTest() {
 
 int main(int argc, char** argv) {
   open_spiel::algorithms::KuhnDeterministicPolicyTest();
+  open_spiel::algorithms::PolicyIndexTest();
+  open_spiel::algorithms::KuhnPolicySpaceTest();
 }
@@ -0,0 +1,452 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/distributed_mccfr.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/tcp.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+using tcp::Append;
+using tcp::AppendArray;
+using tcp::Reader;
+
+// The first byte of the requests to MCCFRShardServer.
+constexpr char kUpdate = 'U';
+constexpr char kAveragePolicy = 'A';
+
+void AppendString(absl::string_view value, std::string* out) {
+  Append<int32_t>(value.size(), out);
+  out->append(value.data(), value.size());
+}
+
+absl::string_view ReadString(Reader* reader) {
+  return reader->ReadBytes(reader->Read<int32_t>());
+}
+
+// Writes the legal actions of an entry, as their number followed by them.
+void AppendActions(const std::vector<Action>& actions, std::string* out) {
+  Append<int32_t>(actions.size(), out);
+  for (Action action : actions) Append<int64_t>(action, out);
+}
+
+std::vector<Action> ReadActions(Reader* reader) {
+  std::vector<Action> actions(reader->Read<int32_t>());
+  for (Action& action : actions) action = reader->Read<int64_t>();
+  return actions;
+}
+
+// Normalizes a cumulative policy as CFRAveragePolicy does.
+ActionsAndProbs AverageActionsAndProbs(
+    const std::vector<Action>& legal_actions,
+    const std::vector<double>& cumulative_policy) {
+  const double sum = std::accumulate(cumulative_policy.begin(),
+                                     cumulative_policy.end(), 0.0);
+  ActionsAndProbs actions_and_probs;
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    actions_and_probs.push_back(
+        {legal_actions[aidx], sum == 0.0 ? 1.0 / legal_actions.size()
+                                         : cumulative_policy[aidx] / sum});
+  }
+  return actions_and_probs;
+}
+
+}  // namespace
+
+int MCCFRShardIndex(absl::string_view info_state, int num_shards) {
+  SPIEL_CHECK_GE(num_shards, 1);
+  // 64-bit FNV-1a.
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : info_state) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash % num_shards;
+}
+
+MCCFRShardServer::MCCFRShardServer(int port)
+    : listener_(port), accept_thread_([this]() { AcceptLoop(); }) {}
+
+MCCFRShardServer::~MCCFRShardServer() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+  }
+  listener_.Shutdown();
+  accept_thread_.join();
+  std::vector<Thread> threads;
+  {
+    absl::MutexLock lock(&mu_);
+    for (auto& connection : connections_) connection->Shutdown();
+    threads = std::move(threads_);
+  }
+  for (Thread& thread : threads) thread.join();
+}
+
+int MCCFRShardServer::NumInfoStates() {
+  absl::MutexLock lock(&mu_);
+  return info_states_.size();
+}
+
+int64_t MCCFRShardServer::NumUpdates() {
+  absl::MutexLock lock(&mu_);
+  return num_updates_;
+}
+
+void MCCFRShardServer::SaveCheckpoint(const std::string& filename) {
+  absl::MutexLock lock(&mu_);
+  SaveCFRCheckpoint(filename, num_updates_, /*rng_state=*/"", info_states_);
+}
+
+void MCCFRShardServer::LoadCheckpoint(const std::string& filename) {
+  int64_t num_updates;
+  std::string rng_state;
+  CFRInfoStateValuesTable info_states;
+  LoadCFRCheckpoint(filename, &num_updates, &rng_state,
+                    [&info_states](const std::string& info_state,
+                                   CFRInfoStateValues values) {
+                      info_states[info_state] = std::move(values);
+                    });
+  absl::MutexLock lock(&mu_);
+  info_states_ = std::move(info_states);
+  num_updates_ = num_updates;
+}
+
+void MCCFRShardServer::AcceptLoop() {
+  while (std::unique_ptr<tcp::Connection> connection = listener_.Accept()) {
+    absl::MutexLock lock(&mu_);
+    if (stop_) return;
+    tcp::Connection* served = connection.get();
+    connections_.push_back(std::move(connection));
+    threads_.emplace_back([this, served]() { Serve(served); });
+  }
+}
+
+void MCCFRShardServer::Serve(tcp::Connection* connection) {
+  while (std::optional<std::string> request = connection->Receive()) {
+    if (request->empty()) return;
+    Reader reader(absl::string_view(*request).substr(1));
+    std::string reply;
+    switch ((*request)[0]) {
+      case kUpdate:
+        reply = Update(&reader);
+        break;
+      case kAveragePolicy:
+        reply = EncodeAveragePolicy();
+        break;
+      default:
+        // Not a solver: drop the connection.
+        return;
+    }
+    if (!connection->Send(reply)) return;
+  }
+}
+
+std::string MCCFRShardServer::Update(Reader* reader) {
+  const int num_entries = reader->Read<int32_t>();
+  std::string reply;
+  std::vector<double> regrets;
+  std::vector<double> policy;
+  absl::MutexLock lock(&mu_);
+  for (int i = 0; i < num_entries; ++i) {
+    const std::string info_state(ReadString(reader));
+    std::vector<Action> legal_actions = ReadActions(reader);
+    regrets.resize(legal_actions.size());
+    policy.resize(legal_actions.size());
+    reader->ReadArray(absl::MakeSpan(regrets));
+    reader->ReadArray(absl::MakeSpan(policy));
+    // The insert here only inserts the default value if the key is not found,
+    // as in ExternalSamplingMCCFRSolver.
+    CFRInfoStateValues& values =
+        info_states_
+            .insert({info_state,
+                     CFRInfoStateValues(
+                         legal_actions,
+                         ExternalSamplingMCCFRSolver::kInitialTableValues)})
+            .first->second;
+    SPIEL_CHECK_EQ(values.num_actions(), legal_actions.size());
+    for (int aidx = 0; aidx < values.num_actions(); ++aidx) {
+      values.cumulative_regrets[aidx] += regrets[aidx];
+      values.cumulative_policy[aidx] += policy[aidx];
+    }
+    values.ApplyRegretMatching();
+    AppendArray<double>(values.current_policy, &reply);
+  }
+  SPIEL_CHECK_TRUE(reader->Rest().empty());
+  ++num_updates_;
+  return reply;
+}
+
+std::string MCCFRShardServer::EncodeAveragePolicy() {
+  std::string reply;
+  absl::MutexLock lock(&mu_);
+  Append<int64_t>(info_states_.size(), &reply);
+  for (const auto& [info_state, values] : info_states_) {
+    AppendString(info_state, &reply);
+    AppendActions(values.legal_actions, &reply);
+    AppendArray<double>(values.cumulative_policy, &reply);
+  }
+  return reply;
+}
+
+DistributedMCCFRSolver::DistributedMCCFRSolver(
+    const Game& game, const std::vector<std::string>& shards, int seed,
+    AverageType avg_type, int sync_interval, absl::Duration connect_timeout)
+    : game_(game.Clone()),
+      shards_(shards),
+      rng_(seed),
+      avg_type_(avg_type),
+      sync_interval_(sync_interval) {
+  if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "MCCFR requires sequential games. If you're trying to run it "
+        "on a simultaneous (or normal-form) game, please first transform it "
+        "using turn_based_simultaneous_game.");
+  }
+  SPIEL_CHECK_FALSE(shards_.empty());
+  SPIEL_CHECK_GE(sync_interval_, 1);
+  for (const std::string& shard : shards_) {
+    connections_.push_back(tcp::Connection::Connect(shard, connect_timeout));
+  }
+}
+
+void DistributedMCCFRSolver::RunIteration() {
+  for (auto p = Player{0}; p < game_->NumPlayers(); ++p) {
+    UpdateRegrets(*game_->NewInitialState(), p);
+  }
+
+  if (avg_type_ == AverageType::kFull) {
+    std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
+    FullUpdateAverage(*game_->NewInitialState(), reach_probs);
+  }
+  if (++num_iterations_ % sync_interval_ == 0) Sync();
+}
+
+void DistributedMCCFRSolver::Sync() {
+  std::vector<std::pair<const std::string*, CachedInfoState*>> entries;
+  for (auto iter = cache_.begin(); iter != cache_.end();) {
+    if (iter->second.visited) {
+      iter->second.visited = false;
+      entries.push_back({&iter->first, &iter->second});
+      ++iter;
+    } else {
+      iter = cache_.erase(iter);
+    }
+  }
+  Exchange(entries);
+}
+
+TabularPolicy DistributedMCCFRSolver::AveragePolicy() {
+  const std::string request(1, kAveragePolicy);
+  for (auto& connection : connections_) {
+    if (!connection->Send(request)) {
+      SpielFatalError("Lost the connection to an MCCFR shard.");
+    }
+  }
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  for (int shard = 0; shard < shards_.size(); ++shard) {
+    std::optional<std::string> reply = connections_[shard]->Receive();
+    if (!reply) {
+      SpielFatalError(absl::StrCat("Lost the connection to ", shards_[shard]));
+    }
+    Reader reader(*reply);
+    const int64_t num_entries = reader.Read<int64_t>();
+    for (int64_t i = 0; i < num_entries; ++i) {
+      const std::string info_state(ReadString(&reader));
+      const std::vector<Action> legal_actions = ReadActions(&reader);
+      std::vector<double> cumulative_policy(legal_actions.size());
+      reader.ReadArray(absl::MakeSpan(cumulative_policy));
+      table[info_state] = AverageActionsAndProbs(legal_actions,
+                                                 cumulative_policy);
+    }
+    SPIEL_CHECK_TRUE(reader.Rest().empty());
+  }
+  return TabularPolicy(table);
+}
+
+CFRInfoStateValues* DistributedMCCFRSolver::Lookup(const State& state) {
+  const Player cur_player = state.CurrentPlayer();
+  auto [iter, inserted] =
+      cache_.try_emplace(state.InformationStateString(cur_player));
+  CachedInfoState& entry = iter->second;
+  entry.visited = true;
+  if (inserted) {
+    entry.shard = MCCFRShardIndex(iter->first, shards_.size());
+    entry.values = CFRInfoStateValues(state.LegalActions());
+    Exchange({{&iter->first, &entry}});
+  }
+  return &entry.values;
+}
+
+void DistributedMCCFRSolver::Exchange(
+    const std::vector<std::pair<const std::string*, CachedInfoState*>>&
+        entries) {
+  // The entries of each shard, in the order of their requests.
+  std::vector<std::vector<CFRInfoStateValues*>> shard_entries(shards_.size());
+  std::vector<std::string> requests(shards_.size());
+  for (const auto& [info_state, entry] : entries) {
+    std::string& request = requests[entry->shard];
+    if (request.empty()) {
+      request.push_back(kUpdate);
+      Append<int32_t>(0, &request);
+    }
+    const CFRInfoStateValues& values = entry->values;
+    AppendString(*info_state, &request);
+    AppendActions(values.legal_actions, &request);
+    AppendArray<double>(values.cumulative_regrets, &request);
+    AppendArray<double>(values.cumulative_policy, &request);
+    shard_entries[entry->shard].push_back(&entry->values);
+  }
+  // Send every batch before waiting for the replies, so that the shards
+  // apply them in parallel.
+  for (int shard = 0; shard < shards_.size(); ++shard) {
+    if (requests[shard].empty()) continue;
+    const int32_t num_entries = shard_entries[shard].size();
+    requests[shard].replace(1, sizeof(num_entries),
+                            reinterpret_cast<const char*>(&num_entries),
+                            sizeof(num_entries));
+    if (!connections_[shard]->Send(requests[shard])) {
+      SpielFatalError(absl::StrCat("Lost the connection to ", shards_[shard]));
+    }
+  }
+  for (int shard = 0; shard < shards_.size(); ++shard) {
+    if (requests[shard].empty()) continue;
+    std::optional<std::string> reply = connections_[shard]->Receive();
+    if (!reply) {
+      SpielFatalError(absl::StrCat("Lost the connection to ", shards_[shard]));
+    }
+    Reader reader(*reply);
+    for (CFRInfoStateValues* values : shard_entries[shard]) {
+      reader.ReadArray(absl::MakeSpan(values->current_policy));
+      std::fill(values->cumulative_regrets.begin(),
+                values->cumulative_regrets.end(), 0);
+      std::fill(values->cumulative_policy.begin(),
+                values->cumulative_policy.end(), 0);
+    }
+    SPIEL_CHECK_TRUE(reader.Rest().empty());
+  }
+}
+
+double DistributedMCCFRSolver::UpdateRegrets(const State& state,
+                                             Player player) {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(player);
+  } else if (state.IsChanceNode()) {
+    Action action = state.SampleChanceOutcome(rng_).first;
+    return UpdateRegrets(*state.Child(action), player);
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  ++num_nodes_visited_;
+  Player cur_player = state.CurrentPlayer();
+  std::vector<Action> legal_actions = state.LegalActions();
+  CFRInfoStateValues& info_state = *Lookup(state);
+
+  double value = 0;
+  std::vector<double> child_values(legal_actions.size(), 0);
+
+  if (cur_player != player) {
+    // Sample at opponent nodes.
+    int aidx = info_state.SampleActionIndex(0.0, UniformDouble(rng_));
+    value = UpdateRegrets(*state.Child(legal_actions[aidx]), player);
+  } else {
+    // Walk over all actions at my nodes
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      child_values[aidx] =
+          UpdateRegrets(*state.Child(legal_actions[aidx]), player);
+      value += info_state.current_policy[aidx] * child_values[aidx];
+    }
+  }
+
+  // Now the regret and avg strategy updates, sent at the next Sync.
+  if (cur_player == player) {
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      info_state.cumulative_regrets[aidx] += (child_values[aidx] - value);
+    }
+  }
+  if (avg_type_ == AverageType::kSimple &&
+      cur_player == ((player + 1) % game_->NumPlayers())) {
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      info_state.cumulative_policy[aidx] += info_state.current_policy[aidx];
+    }
+  }
+
+  return value;
+}
+
+void DistributedMCCFRSolver::FullUpdateAverage(
+    const State& state, const std::vector<double>& reach_probs) {
+  if (state.IsTerminal()) {
+    return;
+  } else if (state.IsChanceNode()) {
+    for (Action action : state.LegalActions()) {
+      FullUpdateAverage(*state.Child(action), reach_probs);
+    }
+    return;
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  // If all the probs are zero, no need to keep going.
+  double sum = std::accumulate(reach_probs.begin(), reach_probs.end(), 0.0);
+  if (sum == 0.0) return;
+
+  ++num_nodes_visited_;
+  Player cur_player = state.CurrentPlayer();
+  std::vector<Action> legal_actions = state.LegalActions();
+  CFRInfoStateValues& info_state = *Lookup(state);
+
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    std::vector<double> new_reach_probs = reach_probs;
+    new_reach_probs[cur_player] *= info_state.current_policy[aidx];
+    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs);
+  }
+
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    info_state.cumulative_policy[aidx] +=
+        (reach_probs[cur_player] * info_state.current_policy[aidx]);
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,179 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DISTRIBUTED_MCCFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DISTRIBUTED_MCCFR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/tcp.h"
+#include "open_spiel/utils/thread.h"
+
+// External sampling MCCFR with its table spread over several machines, for
+// games whose regret tables do not fit in the memory of one:
+//
+// - MCCFRShardServers each hold the information states whose keys hash to
+//   them (see MCCFRShardIndex).
+// - DistributedMCCFRSolvers, on any number of machines, run the iterations of
+//   ExternalSamplingMCCFRSolver against the current policies of the states
+//   they visit, as of their last synchronization. They accumulate their
+//   regret and average policy updates locally, and every `sync_interval`
+//   iterations send them to the shards, one batch per shard, and get back the
+//   new current policies.
+//
+// Between synchronizations, the solvers therefore see stale regrets, as
+// threads in ExternalSamplingMCCFRSolver::RunIterationsInParallel see each
+// other's updates late. A solver only keeps the states it visited since its
+// last synchronization, and fetches the others from their shards when it
+// reaches them.
+
+namespace open_spiel {
+namespace algorithms {
+
+// The shard holding `info_state` among `num_shards` shards. This is the same
+// on every machine, unlike std::hash.
+int MCCFRShardIndex(absl::string_view info_state, int num_shards);
+
+// Serves a shard of the table of a distributed MCCFR run to any number of
+// DistributedMCCFRSolvers, each served by its own thread.
+class MCCFRShardServer {
+ public:
+  // Listens on `port`, or on a free one if 0.
+  explicit MCCFRShardServer(int port);
+
+  // Stops serving and closes the connections.
+  ~MCCFRShardServer();
+
+  MCCFRShardServer(const MCCFRShardServer&) = delete;
+  MCCFRShardServer& operator=(const MCCFRShardServer&) = delete;
+
+  int Port() const { return listener_.Port(); }
+  int NumInfoStates();
+
+  // The number of batches of updates applied.
+  int64_t NumUpdates();
+
+  // Saves the shard's table to a checkpoint file, see SaveCFRCheckpoint, with
+  // the number of updates as the iteration.
+  void SaveCheckpoint(const std::string& filename);
+
+  // Replaces the shard's table with a checkpoint saved by a shard at the same
+  // index of the same number of shards.
+  void LoadCheckpoint(const std::string& filename);
+
+ private:
+  void AcceptLoop();
+  void Serve(tcp::Connection* connection);
+
+  // Applies the updates of a request and returns the new current policies.
+  std::string Update(tcp::Reader* reader);
+  std::string EncodeAveragePolicy();
+
+  tcp::Listener listener_;
+
+  absl::Mutex mu_;
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<std::unique_ptr<tcp::Connection>> connections_
+      ABSL_GUARDED_BY(mu_);
+  std::vector<Thread> threads_ ABSL_GUARDED_BY(mu_);
+  CFRInfoStateValuesTable info_states_ ABSL_GUARDED_BY(mu_);
+  int64_t num_updates_ ABSL_GUARDED_BY(mu_) = 0;
+
+  Thread accept_thread_;
+};
+
+// Runs external sampling MCCFR on the tables of shards given as "host:port",
+// with the same updates as ExternalSamplingMCCFRSolver. Several solvers, with
+// different seeds, can share the same shards. Fails if a shard is lost.
+class DistributedMCCFRSolver {
+ public:
+  DistributedMCCFRSolver(const Game& game,
+                         const std::vector<std::string>& shards, int seed = 0,
+                         AverageType avg_type = AverageType::kSimple,
+                         int sync_interval = 10,
+                         absl::Duration connect_timeout = absl::Seconds(60));
+
+  // Performs one iteration of external sampling MCCFR, synchronizing with the
+  // shards after every `sync_interval` iterations.
+  void RunIteration();
+
+  // Sends the pending updates to the shards, and refreshes the current
+  // policies of the states visited since the last synchronization, forgetting
+  // the others. Pending updates are lost if the solver is destroyed first.
+  void Sync();
+
+  // Pulls the average policy of the information states visited so far from
+  // the shards, including the updates of all the solvers up to their last
+  // Sync.
+  TabularPolicy AveragePolicy();
+
+  int64_t NumIterations() const { return num_iterations_; }
+  int64_t NumNodesVisited() const { return num_nodes_visited_; }
+
+  // The number of information states held locally.
+  int NumCachedInfoStates() const { return cache_.size(); }
+
+ private:
+  struct CachedInfoState {
+    int shard;
+    bool visited;
+    // The current policy of the shard as of the last synchronization, and
+    // the regrets and cumulative policy accumulated since.
+    CFRInfoStateValues values;
+  };
+
+  double UpdateRegrets(const State& state, Player player);
+  void FullUpdateAverage(const State& state,
+                         const std::vector<double>& reach_probs);
+
+  // Returns the entry of the current player's information state, fetching it
+  // from its shard if needed.
+  CFRInfoStateValues* Lookup(const State& state);
+
+  // Sends a batch of updates to each shard of `entries`, then reads the new
+  // current policies.
+  void Exchange(const std::vector<std::pair<const std::string*,
+                                            CachedInfoState*>>& entries);
+
+  std::shared_ptr<const Game> game_;
+  std::vector<std::string> shards_;
+  std::vector<std::unique_ptr<tcp::Connection>> connections_;
+  Xoshiro256PlusPlus rng_;
+  AverageType avg_type_;
+  int sync_interval_;
+
+  // Node-based, so that entries stay valid during the traversals.
+  std::unordered_map<std::string, CachedInfoState> cache_;
+
+  int64_t num_iterations_ = 0;
+  int64_t num_nodes_visited_ = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DISTRIBUTED_MCCFR_H_
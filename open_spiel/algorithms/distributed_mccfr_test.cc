@@ -0,0 +1,114 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/distributed_mccfr.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void ShardIndexIsStable() {
+  // The FNV-1a offset basis, and the hash of "a".
+  SPIEL_CHECK_EQ(MCCFRShardIndex("", 1000), 14695981039346656037ULL % 1000);
+  SPIEL_CHECK_EQ(MCCFRShardIndex("a", 1000), 0xaf63dc4c8601ec8cULL % 1000);
+  SPIEL_CHECK_EQ(MCCFRShardIndex("a", 1), 0);
+}
+
+// Two solvers sharing two shards converge on Kuhn poker, with each state held
+// by a single shard.
+void KuhnPokerTwoSolversTwoShards(AverageType avg_type) {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  MCCFRShardServer shard0(0);
+  MCCFRShardServer shard1(0);
+  const std::vector<std::string> shards = {
+      absl::StrCat("localhost:", shard0.Port()),
+      absl::StrCat("localhost:", shard1.Port())};
+  DistributedMCCFRSolver solver0(*game, shards, /*seed=*/1, avg_type,
+                                 /*sync_interval=*/10);
+  DistributedMCCFRSolver solver1(*game, shards, /*seed=*/2, avg_type,
+                                 /*sync_interval=*/7);
+  for (int i = 0; i < 1000; ++i) {
+    solver0.RunIteration();
+    solver1.RunIteration();
+  }
+  solver0.Sync();
+  solver1.Sync();
+  SPIEL_CHECK_EQ(solver0.NumIterations(), 1000);
+  SPIEL_CHECK_GE(solver0.NumNodesVisited(), 1000 * 2 * 2);
+  SPIEL_CHECK_LE(solver0.NumCachedInfoStates(), 12);
+
+  SPIEL_CHECK_GT(shard0.NumInfoStates(), 0);
+  SPIEL_CHECK_GT(shard1.NumInfoStates(), 0);
+  SPIEL_CHECK_EQ(shard0.NumInfoStates() + shard1.NumInfoStates(), 12);
+  TabularPolicy policy = solver1.AveragePolicy();
+  SPIEL_CHECK_EQ(policy.PolicyTable().size(), 12);
+  for (const auto& [info_state, actions_and_probs] : policy.PolicyTable()) {
+    SPIEL_CHECK_EQ(actions_and_probs.size(), 2);
+  }
+  const double nash_conv = NashConv(*game, policy);
+  std::cout << "Kuhn (2 solvers, 2 shards), iters = 2 x 1000, NashConv: "
+            << nash_conv << std::endl;
+  SPIEL_CHECK_LE(nash_conv, 0.1);
+}
+
+// A shard restored from a checkpoint serves the same average policy.
+void ShardCheckpoint() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  auto shard = std::make_unique<MCCFRShardServer>(0);
+  DistributedMCCFRSolver solver(
+      *game, {absl::StrCat("localhost:", shard->Port())}, /*seed=*/3);
+  for (int i = 0; i < 100; ++i) solver.RunIteration();
+  const std::string filename =
+      testing::TempFilename("distributed_mccfr", ".ckpt");
+  shard->SaveCheckpoint(filename);
+  const double nash_conv = NashConv(*game, solver.AveragePolicy());
+  const int64_t num_updates = shard->NumUpdates();
+  shard.reset();
+
+  MCCFRShardServer restored(0);
+  restored.LoadCheckpoint(filename);
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+  SPIEL_CHECK_EQ(restored.NumInfoStates(), 12);
+  SPIEL_CHECK_EQ(restored.NumUpdates(), num_updates);
+  DistributedMCCFRSolver restored_solver(
+      *game, {absl::StrCat("localhost:", restored.Port())});
+  SPIEL_CHECK_EQ(NashConv(*game, restored_solver.AveragePolicy()),
+                 nash_conv);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace algorithms = open_spiel::algorithms;
+
+int main(int argc, char** argv) {
+  algorithms::ShardIndexIsStable();
+  algorithms::KuhnPokerTwoSolversTwoShards(algorithms::AverageType::kSimple);
+  algorithms::KuhnPokerTwoSolversTwoShards(algorithms::AverageType::kFull);
+  algorithms::ShardCheckpoint();
+}
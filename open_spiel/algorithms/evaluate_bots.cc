@@ -14,10 +14,19 @@
 
 #include "open_spiel/algorithms/evaluate_bots.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 
@@ -33,7 +42,7 @@ std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
   }
   while (!state->IsTerminal()) {
     if (state->IsChanceNode()) {
-      Action action = SampleAction(state->ChanceOutcomes(), rng).first;
+      Action action = state->SampleChanceOutcome(rng).first;
       for (auto bot : bots) bot->InformAction(*state, kChancePlayerId, action);
       state->ApplyAction(action);
     } else if (state->IsSimultaneousNode()) {
@@ -61,4 +70,91 @@ std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
   return state->Returns();
 }
 
+void MatchResults::Add(const MatchGame& game) {
+  ++num_games;
+  const double max_return =
+      *std::max_element(game.returns.begin(), game.returns.end());
+  const int num_best =
+      std::count(game.returns.begin(), game.returns.end(), max_return);
+  for (int bot = 0; bot < game.seats.size(); ++bot) {
+    const double bot_return = game.returns[game.seats[bot]];
+    return_sums[bot] += bot_return;
+    squared_return_sums[bot] += bot_return * bot_return;
+    if (bot_return == max_return) {
+      if (num_best == 1) {
+        ++wins[bot];
+      } else {
+        ++draws[bot];
+      }
+    }
+  }
+}
+
+double MatchResults::MeanReturnRadius(int bot, double z) const {
+  if (num_games < 2) return 0;
+  const double mean = MeanReturn(bot);
+  const double variance =
+      std::max(0.0, (squared_return_sums[bot] - num_games * mean * mean) /
+                        (num_games - 1));
+  return z * std::sqrt(variance / num_games);
+}
+
+double MatchResults::WinRateRadius(int bot, double z) const {
+  if (num_games == 0) return 0;
+  const double rate = WinRate(bot);
+  return z * std::sqrt(rate * (1 - rate) / num_games);
+}
+
+MatchResults PlayMatch(const Game& game,
+                       const std::vector<BotFactory>& factories, int num_games,
+                       int seed, int num_threads,
+                       const std::function<void(const MatchGame&)>& on_game) {
+  const int num_players = game.NumPlayers();
+  SPIEL_CHECK_EQ(factories.size(), num_players);
+  SPIEL_CHECK_GE(num_games, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  MatchResults results(num_players);
+  absl::Mutex mutex;
+  std::atomic<int> next_game(0);
+  auto play_games = [&](int thread_index) {
+    // The bots of the thread, by bot and seat, created when first needed.
+    std::vector<std::vector<std::unique_ptr<Bot>>> bots(num_players);
+    for (auto& seats : bots) seats.resize(num_players);
+    std::vector<Bot*> seated_bots(num_players);
+    for (int g = next_game++; g < num_games; g = next_game++) {
+      MatchGame match_game{g, std::vector<Player>(num_players), {}};
+      for (int b = 0; b < num_players; ++b) {
+        const Player seat = (b + g) % num_players;
+        std::unique_ptr<Bot>& bot = bots[b][seat];
+        if (bot == nullptr) {
+          std::seed_seq seed_sequence{seed, thread_index, b, seat};
+          std::mt19937 bot_seeds(seed_sequence);
+          bot = factories[b](seat, bot_seeds());
+        }
+        match_game.seats[b] = seat;
+        seated_bots[seat] = bot.get();
+      }
+      std::seed_seq seed_sequence{seed, g};
+      std::mt19937 game_seeds(seed_sequence);
+      std::unique_ptr<State> state = game.NewInitialState();
+      match_game.returns = EvaluateBots(state.get(), seated_bots, game_seeds());
+      absl::MutexLock lock(&mutex);
+      results.Add(match_game);
+      if (on_game) on_game(match_game);
+    }
+  };
+  num_threads = std::max(1, std::min(num_threads, num_games));
+  if (num_threads == 1) {
+    play_games(0);
+    return results;
+  }
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&play_games, t]() { play_games(t); });
+  }
+  for (Thread& thread : threads) thread.join();
+  return results;
+}
+
 }  // namespace open_spiel
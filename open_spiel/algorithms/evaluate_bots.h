@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -29,6 +31,64 @@ namespace open_spiel {
 std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
                                  int seed);
 
+// Creates a bot playing as `player_id`.
+using BotFactory =
+    std::function<std::unique_ptr<Bot>(Player player_id, int seed)>;
+
+// The outcome of a game of a match: the seat of each bot, and the returns of
+// the seats.
+struct MatchGame {
+  int game_index;
+  std::vector<Player> seats;
+  std::vector<double> returns;
+};
+
+// The statistics of the games of a match, for each bot, in the order of the
+// factories. A bot wins a game if it has the highest return, and draws if it
+// shares it.
+struct MatchResults {
+  explicit MatchResults(int num_bots)
+      : return_sums(num_bots, 0),
+        squared_return_sums(num_bots, 0),
+        wins(num_bots, 0),
+        draws(num_bots, 0) {}
+
+  // Adds the returns of a game.
+  void Add(const MatchGame& game);
+
+  double MeanReturn(int bot) const { return return_sums[bot] / num_games; }
+  double WinRate(int bot) const {
+    return static_cast<double>(wins[bot]) / num_games;
+  }
+  // The radii of the confidence intervals of the mean return and the win
+  // rate, by the normal approximation, with z = 1.96 for 95% confidence.
+  double MeanReturnRadius(int bot, double z = 1.96) const;
+  double WinRateRadius(int bot, double z = 1.96) const;
+
+  int num_games = 0;
+  std::vector<double> return_sums;
+  std::vector<double> squared_return_sums;
+  std::vector<int> wins;
+  std::vector<int> draws;
+};
+
+// Plays num_games games between the bots of the factories, one per player,
+// with num_threads threads, and returns their statistics. Each thread creates
+// its own bots, once for each seat they take, and takes the next game to play
+// when it finishes one. The seats rotate: in game g, bot b plays as player
+// (b + g) % num_players. The chance outcomes of game g are drawn from its own
+// seed, but the bots' random numbers depend on which thread plays which game,
+// so the results are only reproducible with a single thread or deterministic
+// bots.
+//
+// If on_game is not null, it is called with each game as it finishes, one
+// game at a time, e.g. to stream the results.
+MatchResults PlayMatch(const Game& game,
+                       const std::vector<BotFactory>& factories, int num_games,
+                       int seed, int num_threads = 1,
+                       const std::function<void(const MatchGame&)>& on_game =
+                           nullptr);
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
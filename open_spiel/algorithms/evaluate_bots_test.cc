@@ -15,6 +15,7 @@
 #include "open_spiel/algorithms/evaluate_bots.h"
 
 #include <memory>
+#include <vector>
 
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel_bots.h"
@@ -70,10 +71,56 @@ void BotTest_RandomVsRandomPolicy() {
   SPIEL_CHECK_FLOAT_NEAR(average_results[1], -0.125, 0.01);
 }
 
+// With the seats rotating, both random bots must get the mean return of the
+// game, 0.
+void BotTest_PlayMatchRotatesSeats() {
+  auto game = LoadGame("kuhn_poker");
+  std::vector<BotFactory> factories(2, [](Player player_id, int seed) {
+    return MakeUniformRandomBot(player_id, seed);
+  });
+  constexpr int num_games = 40000;
+  std::vector<int> played(num_games, 0);
+  MatchResults results =
+      PlayMatch(*game, factories, num_games, /*seed=*/7, /*num_threads=*/4,
+                [&played](const MatchGame& match_game) {
+                  const int g = match_game.game_index;
+                  SPIEL_CHECK_EQ(match_game.seats[0], g % 2);
+                  ++played[g];
+                });
+  SPIEL_CHECK_EQ(results.num_games, num_games);
+  for (int count : played) SPIEL_CHECK_EQ(count, 1);
+  for (int bot = 0; bot < 2; ++bot) {
+    SPIEL_CHECK_FLOAT_NEAR(results.MeanReturn(bot), 0, 0.05);
+    SPIEL_CHECK_GT(results.MeanReturnRadius(bot), 0);
+    SPIEL_CHECK_LT(results.MeanReturnRadius(bot), 0.05);
+    SPIEL_CHECK_EQ(results.draws[bot], 0);
+  }
+  SPIEL_CHECK_EQ(results.wins[0] + results.wins[1], num_games);
+  SPIEL_CHECK_FLOAT_NEAR(results.WinRate(0), 0.5, 0.02);
+}
+
+void BotTest_PlayMatchIsReproducibleWithOneThread() {
+  auto game = LoadGame("tic_tac_toe");
+  std::vector<BotFactory> factories(2, [](Player player_id, int seed) {
+    return MakeUniformRandomBot(player_id, seed);
+  });
+  MatchResults first = PlayMatch(*game, factories, /*num_games=*/200,
+                                 /*seed=*/3);
+  MatchResults second = PlayMatch(*game, factories, /*num_games=*/200,
+                                  /*seed=*/3);
+  SPIEL_CHECK_EQ(first.return_sums, second.return_sums);
+  SPIEL_CHECK_EQ(first.wins, second.wins);
+  SPIEL_CHECK_EQ(first.draws, second.draws);
+  SPIEL_CHECK_EQ(first.draws[0], first.draws[1]);
+  SPIEL_CHECK_EQ(first.wins[0] + first.wins[1] + first.draws[0], 200);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::BotTest_RandomVsRandom();
   open_spiel::BotTest_RandomVsRandomPolicy();
+  open_spiel::BotTest_PlayMatchRotatesSeats();
+  open_spiel::BotTest_PlayMatchIsReproducibleWithOneThread();
 }
@@ -14,12 +14,21 @@
 
 #include "open_spiel/algorithms/expected_returns.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread_pool.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -54,7 +63,7 @@ std::vector<double> ExpectedReturnsImpl(
   } else if (state.IsSimultaneousNode()) {
     // Walk over all the joint actions, and weight by the product of
     // probabilities to choose them.
-    values = state.Rewards();
+    state.Rewards(absl::MakeSpan(values));
     auto smstate = dynamic_cast<const SimMoveState*>(&state);
     SPIEL_CHECK_TRUE(smstate != nullptr);
     std::vector<ActionsAndProbs> state_policies(num_players);
@@ -96,7 +105,7 @@ std::vector<double> ExpectedReturnsImpl(
     if (state_policy.empty()) {
       SpielFatalError("Error in ExpectedReturnsImpl; infostate not found.");
     }
-    values = state.Rewards();
+    state.Rewards(absl::MakeSpan(values));
     for (const Action action : state.LegalActions()) {
       std::unique_ptr<State> child = state.Child(action);
       double action_prob = GetProb(state_policy, action);
@@ -140,7 +149,7 @@ std::vector<double> ExpectedReturnsImpl(
   } else if (state.IsSimultaneousNode()) {
     // Walk over all the joint actions, and weight by the product of
     // probabilities to choose them.
-    values = state.Rewards();
+    state.Rewards(absl::MakeSpan(values));
     auto smstate = dynamic_cast<const SimMoveState*>(&state);
     SPIEL_CHECK_TRUE(smstate != nullptr);
     std::vector<ActionsAndProbs> state_policies(num_players);
@@ -181,7 +190,7 @@ std::vector<double> ExpectedReturnsImpl(
     if (state_policy.empty()) {
       SpielFatalError("Error in ExpectedReturnsImpl; infostate not found.");
     }
-    values = state.Rewards();
+    state.Rewards(absl::MakeSpan(values));
     for (const Action action : state.LegalActions()) {
       std::unique_ptr<State> child = state.Child(action);
       double action_prob = GetProb(state_policy, action);
@@ -199,6 +208,7 @@ std::vector<double> ExpectedReturnsImpl(
   SPIEL_CHECK_EQ(values.size(), state.NumPlayers());
   return values;
 }
+
 }  // namespace
 
 std::vector<double> ExpectedReturns(const State& state,
@@ -232,5 +242,165 @@ std::vector<double> ExpectedReturns(const State& state,
       depth_limit);
 }
 
+ExpectedReturnsEvaluator::ExpectedReturnsEvaluator(const State& root)
+    : ExpectedReturnsEvaluator(std::make_shared<CompactHistoryTree>(root)) {}
+
+ExpectedReturnsEvaluator::ExpectedReturnsEvaluator(
+    std::shared_ptr<const CompactHistoryTree> tree)
+    : tree_(std::move(tree)),
+      info_state_offsets_(tree_->NumInfoStates()),
+      num_child_probabilities_(tree_->NumPlayers(), 0) {
+  for (int i = 0; i < tree_->NumInfoStates(); ++i) {
+    const Player player = tree_->InfoStatePlayer(i);
+    if (player < 0 || player >= tree_->NumPlayers()) {
+      SpielFatalError("ExpectedReturnsEvaluator needs a turn-based game.");
+    }
+    info_state_offsets_[i] = num_child_probabilities_[player];
+    num_child_probabilities_[player] +=
+        tree_->GetNode(tree_->InfoStateNodes(i)[0]).num_children;
+  }
+}
+
+std::vector<double> ExpectedReturnsEvaluator::Evaluate(
+    const std::vector<const Policy*>& policies) const {
+  return EvaluateProfiles({policies})[0];
+}
+
+std::vector<double> ExpectedReturnsEvaluator::Evaluate(
+    const Policy& joint_policy) const {
+  return Evaluate(
+      std::vector<const Policy*>(tree_->NumPlayers(), &joint_policy));
+}
+
+std::vector<std::vector<double>> ExpectedReturnsEvaluator::EvaluateProfiles(
+    const std::vector<std::vector<const Policy*>>& profiles,
+    int num_threads) const {
+  SPIEL_CHECK_GE(num_threads, 1);
+  const int num_players = tree_->NumPlayers();
+  // The child probabilities of each distinct policy of each player.
+  absl::flat_hash_map<std::pair<const Policy*, Player>, int> lookup_indices;
+  std::vector<std::pair<const Policy*, Player>> lookups;
+  std::vector<std::vector<int>> profile_lookups(
+      profiles.size(), std::vector<int>(num_players));
+  for (int i = 0; i < profiles.size(); ++i) {
+    SPIEL_CHECK_EQ(profiles[i].size(), num_players);
+    for (Player p = 0; p < num_players; ++p) {
+      SPIEL_CHECK_TRUE(profiles[i][p] != nullptr);
+      auto [it, inserted] =
+          lookup_indices.try_emplace({profiles[i][p], p}, lookups.size());
+      if (inserted) lookups.push_back({profiles[i][p], p});
+      profile_lookups[i][p] = it->second;
+    }
+  }
+  std::vector<std::vector<double>> child_probabilities(lookups.size());
+  auto look_up = [&](int i) {
+    child_probabilities[i] =
+        ChildProbabilities(*lookups[i].first, lookups[i].second);
+  };
+  ThreadPool::Default().ParallelFor(0, lookups.size(), look_up,
+                                    /*grain_size=*/1, num_threads);
+
+  std::vector<std::vector<const std::vector<double>*>> probabilities(
+      profiles.size(), std::vector<const std::vector<double>*>(num_players));
+  for (int i = 0; i < profiles.size(); ++i) {
+    for (Player p = 0; p < num_players; ++p) {
+      probabilities[i][p] = &child_probabilities[profile_lookups[i][p]];
+    }
+  }
+  std::vector<std::vector<double>> returns(profiles.size());
+  const int num_sweeps =
+      (profiles.size() + kProfilesPerSweep - 1) / kProfilesPerSweep;
+  auto run_sweep = [&](int sweep) {
+    const int begin = sweep * kProfilesPerSweep;
+    const int end = std::min<int>(begin + kProfilesPerSweep, profiles.size());
+    std::vector<std::vector<double>> sweep_returns = Sweep(
+        absl::MakeConstSpan(probabilities).subspan(begin, end - begin));
+    for (int i = begin; i < end; ++i) {
+      returns[i] = std::move(sweep_returns[i - begin]);
+    }
+  };
+  ThreadPool::Default().ParallelFor(0, num_sweeps, run_sweep, /*grain_size=*/1,
+                                    num_threads);
+  return returns;
+}
+
+std::vector<double> ExpectedReturnsEvaluator::ChildProbabilities(
+    const Policy& policy, Player player) const {
+  std::vector<double> probabilities(num_child_probabilities_[player]);
+  std::vector<int> info_states;
+  std::vector<const State*> states;
+  for (int i = 0; i < tree_->NumInfoStates(); ++i) {
+    if (tree_->InfoStatePlayer(i) != player) continue;
+    info_states.push_back(i);
+    states.push_back(&tree_->InfoStateState(i));
+  }
+  std::vector<ActionsAndProbs> state_policies(states.size());
+  policy.GetStatePolicies(states, absl::MakeSpan(state_policies));
+  for (int k = 0; k < info_states.size(); ++k) {
+    const int i = info_states[k];
+    const ActionsAndProbs& state_policy = state_policies[k];
+    if (state_policy.empty()) {
+      SpielFatalError(tree_->InfoStateString(i) + " not found in policy.");
+    }
+    const CompactHistoryTree::Node& node =
+        tree_->GetNode(tree_->InfoStateNodes(i)[0]);
+    for (int k = 0; k < node.num_children; ++k) {
+      const double prob =
+          GetProb(state_policy, tree_->GetNode(node.first_child + k).action);
+      SPIEL_CHECK_GE(prob, 0.0);
+      SPIEL_CHECK_LE(prob, 1.0);
+      probabilities[info_state_offsets_[i] + k] = prob;
+    }
+  }
+  return probabilities;
+}
+
+std::vector<std::vector<double>> ExpectedReturnsEvaluator::Sweep(
+    absl::Span<const std::vector<const std::vector<double>*>> probabilities)
+    const {
+  const int num_players = tree_->NumPlayers();
+  const int num_profiles = probabilities.size();
+  // The values of the nodes, [node][profile][player]. The children of a node
+  // come after it, so a backward sweep sees them first.
+  const int node_size = num_profiles * num_players;
+  std::vector<double> values(
+      static_cast<int64_t>(tree_->NumNodes()) * node_size, 0.0);
+  for (int index = tree_->NumNodes() - 1; index >= 0; --index) {
+    const CompactHistoryTree::Node& node = tree_->GetNode(index);
+    double* node_values = &values[static_cast<int64_t>(index) * node_size];
+    if (node.type == StateType::kTerminal) {
+      for (int j = 0; j < num_profiles; ++j) {
+        for (Player p = 0; p < num_players; ++p) {
+          node_values[j * num_players + p] = tree_->PlayerReturn(index, p);
+        }
+      }
+      continue;
+    }
+    for (int k = 0; k < node.num_children; ++k) {
+      const int child = node.first_child + k;
+      const double* child_values =
+          &values[static_cast<int64_t>(child) * node_size];
+      for (int j = 0; j < num_profiles; ++j) {
+        const double prob =
+            node.type == StateType::kDecision
+                ? (*probabilities[j][node.player])
+                      [info_state_offsets_[node.info_state] + k]
+                : tree_->GetNode(child).probability;
+        if (prob == 0) continue;
+        for (Player p = 0; p < num_players; ++p) {
+          node_values[j * num_players + p] +=
+              prob * child_values[j * num_players + p];
+        }
+      }
+    }
+  }
+  std::vector<std::vector<double>> returns(num_profiles);
+  for (int j = 0; j < num_profiles; ++j) {
+    returns[j].assign(values.begin() + j * num_players,
+                      values.begin() + (j + 1) * num_players);
+  }
+  return returns;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -15,8 +15,12 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPECTED_RETURNS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPECTED_RETURNS_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 
@@ -41,6 +45,61 @@ std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
                                     int depth_limit);
 
+// Computes the expected returns of many policies on the same game, as
+// ExpectedReturns does with a full traversal, but from a tree of the histories
+// built once, so that evaluating a policy only looks up its policy once per
+// information state, and sweeps the tree without cloning states. The game must
+// be turn-based.
+//
+// Policies appearing in several profiles, e.g. a fixed opponent, are only
+// looked up once per call, and up to 16 profiles are evaluated in each sweep
+// of the tree, with a vector of values per node.
+class ExpectedReturnsEvaluator {
+ public:
+  explicit ExpectedReturnsEvaluator(const State& root);
+  // Shares a tree, e.g. with TabularBestResponse.
+  explicit ExpectedReturnsEvaluator(
+      std::shared_ptr<const CompactHistoryTree> tree);
+
+  // Returns the expected returns of each player, with `policies` holding
+  // the policy of each player, or with a joint policy.
+  std::vector<double> Evaluate(
+      const std::vector<const Policy*>& policies) const;
+  std::vector<double> Evaluate(const Policy& joint_policy) const;
+
+  // Returns the expected returns of each profile of `profiles`, each holding
+  // the policy of each player ([profile][player]). With num_threads > 1, the
+  // policy lookups and the sweeps are split between up to num_threads threads
+  // of ThreadPool::Default(), which requires the policies' GetStatePolicy to
+  // be safe to call concurrently.
+  std::vector<std::vector<double>> EvaluateProfiles(
+      const std::vector<std::vector<const Policy*>>& profiles,
+      int num_threads = 1) const;
+
+  const CompactHistoryTree& Tree() const { return *tree_; }
+
+ private:
+  // Returns the probabilities of the children of the decision nodes of
+  // `player` under `policy`, at info_state_offsets_.
+  std::vector<double> ChildProbabilities(const Policy& policy,
+                                         Player player) const;
+
+  // Returns the expected returns of the profiles whose child probabilities
+  // are `probabilities` ([profile][player]), at most kProfilesPerSweep of
+  // them.
+  std::vector<std::vector<double>> Sweep(
+      absl::Span<const std::vector<const std::vector<double>*>> probabilities)
+      const;
+
+  static constexpr int kProfilesPerSweep = 16;
+
+  std::shared_ptr<const CompactHistoryTree> tree_;
+  // The offset of the children of each information state in the child
+  // probabilities of its player, which are in the order of the children.
+  std::vector<int> info_state_offsets_;
+  std::vector<int> num_child_probabilities_;  // For each player.
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
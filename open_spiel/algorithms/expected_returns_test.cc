@@ -0,0 +1,93 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/expected_returns.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Returns a policy with random probabilities, some of them zero.
+TabularPolicy RandomPolicy(const Game& game, std::mt19937* rng) {
+  TabularPolicy policy = GetUniformPolicy(game);
+  for (auto& [info_state, state_policy] : policy.PolicyTable()) {
+    double sum = 0;
+    for (auto& [action, prob] : state_policy) {
+      prob = absl::Uniform<int>(*rng, 0, 4);
+      sum += prob;
+    }
+    for (auto& [action, prob] : state_policy) {
+      prob = sum > 0 ? prob / sum : 1.0 / state_policy.size();
+    }
+  }
+  return policy;
+}
+
+// The evaluator must match ExpectedReturns for profiles mixing a few shared
+// policies, over several sweeps and with threads.
+void EvaluatorMatchesExpectedReturns(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::mt19937 rng(0);
+  std::vector<TabularPolicy> policies;
+  for (int i = 0; i < 4; ++i) policies.push_back(RandomPolicy(*game, &rng));
+  std::vector<std::vector<const Policy*>> profiles;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 2; ++k) {
+        profiles.push_back({&policies[i], &policies[j]});
+      }
+    }
+  }
+
+  ExpectedReturnsEvaluator evaluator(*root);
+  for (int num_threads : {1, 3}) {
+    std::vector<std::vector<double>> returns =
+        evaluator.EvaluateProfiles(profiles, num_threads);
+    SPIEL_CHECK_EQ(returns.size(), profiles.size());
+    for (int i = 0; i < profiles.size(); ++i) {
+      std::vector<double> expected =
+          ExpectedReturns(*root, profiles[i], /*depth_limit=*/-1);
+      SPIEL_CHECK_EQ(returns[i].size(), expected.size());
+      for (Player p = 0; p < game->NumPlayers(); ++p) {
+        SPIEL_CHECK_FLOAT_NEAR(returns[i][p], expected[p], 1e-9);
+      }
+    }
+  }
+  std::vector<double> joint = evaluator.Evaluate(policies[0]);
+  std::vector<double> expected =
+      ExpectedReturns(*root, policies[0], /*depth_limit=*/-1);
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    SPIEL_CHECK_FLOAT_NEAR(joint[p], expected[p], 1e-9);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::EvaluatorMatchesExpectedReturns("kuhn_poker");
+  open_spiel::algorithms::EvaluatorMatchesExpectedReturns("leduc_poker");
+}
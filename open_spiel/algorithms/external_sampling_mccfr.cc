@@ -14,23 +14,42 @@
 
 #include "open_spiel/algorithms/external_sampling_mccfr.h"
 
+#include <functional>
 #include <numeric>
-#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/cfr_kernels.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
+
+// Copies the values of an entry, under its lock if any.
+CFRInfoStateValues CopyValues(const CFRInfoStateValues& values,
+                              absl::Mutex* mutex) {
+  if (mutex == nullptr) return values;
+  absl::MutexLock lock(mutex);
+  return values;
+}
+
+}  // namespace
 
 ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
                                                          int seed,
                                                          AverageType avg_type)
     : game_(game.Clone()),
-      rng_(new std::mt19937(seed)),
+      rng_(seed),
       avg_type_(avg_type),
-      dist_(0.0, 1.0),
       uniform_policy_(std::shared_ptr<TabularPolicy>(
           new TabularPolicy(GetUniformPolicy(game)))) {
   if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
@@ -41,43 +60,131 @@ ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
   }
 }
 
-void ExternalSamplingMCCFRSolver::RunIteration() { RunIteration(rng_.get()); }
+void ExternalSamplingMCCFRSolver::RunIteration() { RunIteration(&rng_); }
+
+void ExternalSamplingMCCFRSolver::RunIteration(Xoshiro256PlusPlus* rng) {
+  int64_t num_nodes = 0;
+  RunIteration(rng, &num_nodes);
+  num_nodes_visited_ += num_nodes;
+}
 
-void ExternalSamplingMCCFRSolver::RunIteration(std::mt19937* rng) {
+void ExternalSamplingMCCFRSolver::RunIteration(Xoshiro256PlusPlus* rng,
+                                               int64_t* num_nodes) {
   for (auto p = Player{0}; p < game_->NumPlayers(); ++p) {
-    UpdateRegrets(*game_->NewInitialState(), p, rng);
+    UpdateRegrets(*game_->NewInitialState(), p, rng, num_nodes);
   }
 
   if (avg_type_ == AverageType::kFull) {
     std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
-    FullUpdateAverage(*game_->NewInitialState(), reach_probs);
+    FullUpdateAverage(*game_->NewInitialState(), reach_probs, num_nodes);
+  }
+  ++num_iterations_;
+}
+
+void ExternalSamplingMCCFRSolver::RunIterationsInParallel(
+    int num_iterations, int num_threads, MemoryPlacement placement) {
+  SPIEL_CHECK_GE(num_iterations, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  // Non-overlapping streams, leaving the internal one past them all.
+  std::vector<Xoshiro256PlusPlus> rngs;
+  for (int t = 0; t < num_threads; ++t) {
+    rngs.push_back(rng_);
+    rng_.Jump();
+  }
+
+  concurrent_ = true;
+  std::atomic<int> next_iteration{0};
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([this, t, num_iterations, placement, &rngs,
+                          &next_iteration]() {
+      SetThreadMemoryPlacement(placement, t);
+      int64_t num_nodes = 0;
+      while (next_iteration++ < num_iterations) {
+        RunIteration(&rngs[t], &num_nodes);
+      }
+      num_nodes_visited_ += num_nodes;
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+  concurrent_ = false;
+}
+
+void ExternalSamplingMCCFRSolver::SaveCheckpoint(
+    const std::string& filename) const {
+  std::ostringstream rng_state;
+  rng_state << rng_;
+  SaveCFRCheckpoint(filename, num_iterations_, rng_state.str(), info_states_);
+}
+
+void ExternalSamplingMCCFRSolver::LoadCheckpoint(const std::string& filename) {
+  int64_t iteration;
+  std::string rng_state;
+  info_states_.clear();
+  LoadCFRCheckpoint(filename, &iteration, &rng_state,
+                    [this](const std::string& info_state,
+                           CFRInfoStateValues values) {
+                      info_states_[info_state] = std::move(values);
+                    });
+  num_iterations_ = iteration;
+  std::istringstream rng_stream(rng_state);
+  rng_stream >> rng_;
+  SPIEL_CHECK_FALSE(rng_stream.fail());
+}
+
+CFRInfoStateValues* ExternalSamplingMCCFRSolver::GetOrInsertInfoState(
+    const std::string& info_state, const std::vector<Action>& legal_actions) {
+  if (concurrent_) {
+    {
+      absl::ReaderMutexLock lock(&table_mutex_);
+      auto iter = info_states_.find(info_state);
+      if (iter != info_states_.end()) return &iter->second;
+    }
+    absl::WriterMutexLock lock(&table_mutex_);
+    return &info_states_
+                .insert({info_state, CFRInfoStateValues(legal_actions,
+                                                        kInitialTableValues)})
+                .first->second;
   }
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map.
+  return &info_states_
+              .insert({info_state,
+                       CFRInfoStateValues(legal_actions, kInitialTableValues)})
+              .first->second;
+}
+
+absl::Mutex* ExternalSamplingMCCFRSolver::StripeMutex(
+    const CFRInfoStateValues* values) {
+  if (!concurrent_) return nullptr;
+  return &stripe_mutexes_[std::hash<const CFRInfoStateValues*>()(values) %
+                          kNumLockStripes];
 }
 
 double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
                                                   Player player,
-                                                  std::mt19937* rng) {
+                                                  Xoshiro256PlusPlus* rng,
+                                                  int64_t* num_nodes) {
   if (state.IsTerminal()) {
     return state.PlayerReturn(player);
   } else if (state.IsChanceNode()) {
-    Action action = SampleAction(state.ChanceOutcomes(), dist_(*rng)).first;
-    return UpdateRegrets(*state.Child(action), player, rng);
+    Action action = state.SampleChanceOutcome(*rng).first;
+    return UpdateRegrets(*state.Child(action), player, rng, num_nodes);
   } else if (state.IsSimultaneousNode()) {
     SpielFatalError(
         "Simultaneous moves not supported. Use "
         "TurnBasedSimultaneousGame to convert the game first.");
   }
 
+  ++*num_nodes;
   Player cur_player = state.CurrentPlayer();
   std::string is_key = state.InformationStateString(cur_player);
   std::vector<Action> legal_actions = state.LegalActions();
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
-
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues& info_state = *GetOrInsertInfoState(is_key, legal_actions);
+  absl::Mutex* mutex = StripeMutex(&info_state);
+  CFRInfoStateValues info_state_copy = CopyValues(info_state, mutex);
   info_state_copy.ApplyRegretMatching();
 
   double value = 0;
@@ -85,25 +192,25 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
 
   if (cur_player != player) {
     // Sample at opponent nodes.
-    int aidx = info_state_copy.SampleActionIndex(0.0, dist_(*rng));
-    value = UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng);
+    int aidx = info_state_copy.SampleActionIndex(0.0, UniformDouble(*rng));
+    value = UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng,
+                          num_nodes);
   } else {
     // Walk over all actions at my nodes
     for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      child_values[aidx] =
-          UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng);
+      child_values[aidx] = UpdateRegrets(*state.Child(legal_actions[aidx]),
+                                         player, rng, num_nodes);
       value += info_state_copy.current_policy[aidx] * child_values[aidx];
     }
   }
 
   // Now the regret and avg strategy updates.
-  CFRInfoStateValues& info_state = info_states_[is_key];
+  absl::MutexLockMaybe lock(mutex);
 
   if (cur_player == player) {
     // Update regrets
-    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      info_state.cumulative_regrets[aidx] += (child_values[aidx] - value);
-    }
+    AddRegrets(absl::MakeSpan(info_state.cumulative_regrets), 1.0,
+               child_values, value);
   }
 
   // Simple average does averaging on the opponent node. To do this in a game
@@ -111,22 +218,21 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   // which reduces to the standard rule in 2 players.
   if (avg_type_ == AverageType::kSimple &&
       cur_player == ((player + 1) % game_->NumPlayers())) {
-    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      info_state.cumulative_policy[aidx] +=
-          info_state_copy.current_policy[aidx];
-    }
+    AddWeightedPolicy(absl::MakeSpan(info_state.cumulative_policy), 1.0,
+                      info_state_copy.current_policy);
   }
 
   return value;
 }
 
 void ExternalSamplingMCCFRSolver::FullUpdateAverage(
-    const State& state, const std::vector<double>& reach_probs) {
+    const State& state, const std::vector<double>& reach_probs,
+    int64_t* num_nodes) {
   if (state.IsTerminal()) {
     return;
   } else if (state.IsChanceNode()) {
     for (Action action : state.LegalActions()) {
-      FullUpdateAverage(*state.Child(action), reach_probs);
+      FullUpdateAverage(*state.Child(action), reach_probs, num_nodes);
     }
     return;
   } else if (state.IsSimultaneousNode()) {
@@ -139,30 +245,27 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
   double sum = std::accumulate(reach_probs.begin(), reach_probs.end(), 0.0);
   if (sum == 0.0) return;
 
+  ++*num_nodes;
   Player cur_player = state.CurrentPlayer();
   std::string is_key = state.InformationStateString(cur_player);
   std::vector<Action> legal_actions = state.LegalActions();
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
-
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues& info_state = *GetOrInsertInfoState(is_key, legal_actions);
+  absl::Mutex* mutex = StripeMutex(&info_state);
+  CFRInfoStateValues info_state_copy = CopyValues(info_state, mutex);
   info_state_copy.ApplyRegretMatching();
 
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
     std::vector<double> new_reach_probs = reach_probs;
     new_reach_probs[cur_player] *= info_state_copy.current_policy[aidx];
-    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs);
+    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs,
+                      num_nodes);
   }
 
   // Now update the cumulative policy.
-  CFRInfoStateValues& info_state = info_states_[is_key];
-  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-    info_state.cumulative_policy[aidx] +=
-        (reach_probs[cur_player] * info_state_copy.current_policy[aidx]);
-  }
+  absl::MutexLockMaybe lock(mutex);
+  AddWeightedPolicy(absl::MakeSpan(info_state.cumulative_policy),
+                    reach_probs[cur_player], info_state_copy.current_policy);
 }
 
 }  // namespace algorithms
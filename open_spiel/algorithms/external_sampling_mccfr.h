@@ -15,13 +15,18 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXTERNAL_SAMPLING_MCCFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXTERNAL_SAMPLING_MCCFR_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <random>
+#include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/memory_placement.h"
+#include "open_spiel/utils/random.h"
 
 // An implementation of external sampling Monte Carlo Counterfactual Regret
 // Minimization (CFR). See Lanctot 2009 [0] and Chapter 4 of Lanctot 2013 [1]
@@ -68,7 +73,34 @@ class ExternalSamplingMCCFRSolver {
   void RunIteration();
 
   // Same as above, but uses the specified random number generator instead.
-  void RunIteration(std::mt19937* rng);
+  void RunIteration(Xoshiro256PlusPlus* rng);
+
+  // Runs `num_iterations` iterations on `num_threads` threads sharing the
+  // table. Each thread has its own random number generator, a stream jumped
+  // from the internal one, and runs iterations until `num_iterations` have
+  // been started. The structure of the table is protected by a reader-writer
+  // lock (writers only insert new information states), and the values of an
+  // information state by one of kNumLockStripes mutexes, so that threads
+  // only contend when they touch the same states. Iterations therefore see
+  // each other's updates as they happen, like Hogwild-style asynchronous SGD,
+  // and results depend on the scheduling of the threads. On NUMA machines,
+  // `placement` decides where the states inserted by each thread live.
+  void RunIterationsInParallel(
+      int num_iterations, int num_threads,
+      MemoryPlacement placement = MemoryPlacement::kDefault);
+
+  // Throughput counters: the number of iterations run so far, and of
+  // decision nodes they visited.
+  int64_t NumIterations() const { return num_iterations_; }
+  int64_t NumNodesVisited() const { return num_nodes_visited_; }
+
+  // Saves the table, iteration counter and random number generator state to
+  // a checkpoint file, see SaveCFRCheckpoint.
+  void SaveCheckpoint(const std::string& filename) const;
+
+  // Replaces the solver's state with a checkpoint saved for the same game, so
+  // that running more iterations continues the saved run.
+  void LoadCheckpoint(const std::string& filename);
 
   // Computes the average policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
@@ -79,16 +111,39 @@ class ExternalSamplingMCCFRSolver {
   }
 
  private:
-  double UpdateRegrets(const State& state, Player player, std::mt19937* rng);
+  static inline constexpr int kNumLockStripes = 64;
+
+  // Runs an iteration, adding the number of decision nodes visited to
+  // `num_nodes`.
+  void RunIteration(Xoshiro256PlusPlus* rng, int64_t* num_nodes);
+  double UpdateRegrets(const State& state, Player player,
+                       Xoshiro256PlusPlus* rng, int64_t* num_nodes);
   void FullUpdateAverage(const State& state,
-                         const std::vector<double>& reach_probs);
+                         const std::vector<double>& reach_probs,
+                         int64_t* num_nodes);
+
+  // Returns the entry of `info_state` in the table, inserting it if needed.
+  // The entry stays valid when other entries are inserted.
+  CFRInfoStateValues* GetOrInsertInfoState(
+      const std::string& info_state, const std::vector<Action>& legal_actions);
+
+  // The mutex guarding the values of the given entry, or nullptr when
+  // running on a single thread.
+  absl::Mutex* StripeMutex(const CFRInfoStateValues* values);
 
   std::shared_ptr<const Game> game_;
-  std::unique_ptr<std::mt19937> rng_;
+  Xoshiro256PlusPlus rng_;
   AverageType avg_type_;
   CFRInfoStateValuesTable info_states_;
-  std::uniform_real_distribution<double> dist_;
   std::shared_ptr<TabularPolicy> uniform_policy_;
+
+  // Whether the table is being updated by several threads.
+  bool concurrent_ = false;
+  absl::Mutex table_mutex_;
+  absl::Mutex stripe_mutexes_[kNumLockStripes];
+
+  std::atomic<int64_t> num_iterations_{0};
+  std::atomic<int64_t> num_nodes_visited_{0};
 };
 
 }  // namespace algorithms
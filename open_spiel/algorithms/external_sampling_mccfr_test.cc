@@ -16,13 +16,16 @@
 
 #include <cmath>
 #include <iostream>
-#include <random>
+#include <string>
 
 #include "open_spiel/algorithms/tabular_exploitability.h"
 #include "open_spiel/games/kuhn_poker.h"
 #include "open_spiel/games/leduc_poker.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/random.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -30,7 +33,7 @@ namespace {
 
 constexpr int kSeed = 230398247;
 
-void MCCFR_2PGameTest(const std::string& game_name, std::mt19937* rng,
+void MCCFR_2PGameTest(const std::string& game_name, Xoshiro256PlusPlus* rng,
                       int iterations, double nashconv_upperbound) {
   std::shared_ptr<const Game> game = LoadGame(game_name);
   ExternalSamplingMCCFRSolver solver(*game);
@@ -44,7 +47,7 @@ void MCCFR_2PGameTest(const std::string& game_name, std::mt19937* rng,
   SPIEL_CHECK_LE(nash_conv, nashconv_upperbound);
 }
 
-void MCCFR_KuhnPoker3PTest(std::mt19937* rng) {
+void MCCFR_KuhnPoker3PTest(Xoshiro256PlusPlus* rng) {
   std::shared_ptr<const Game> game = LoadGame("kuhn_poker(players=3)");
   ExternalSamplingMCCFRSolver solver(*game);
   for (int i = 0; i < 1000; i++) {
@@ -63,6 +66,53 @@ void MCCFR_KuhnPoker3PTest(std::mt19937* rng) {
             << NashConv(*game, *full_average_policy) << std::endl;
 }
 
+void MCCFR_ParallelKuhnPokerTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+  solver.RunIterationsInParallel(/*num_iterations=*/1000, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(solver.NumIterations(), 1000);
+  // At least the first decision of each player in each pass.
+  SPIEL_CHECK_GE(solver.NumNodesVisited(), 1000 * 2 * 2);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  double nash_conv = NashConv(*game, *average_policy);
+  std::cout << "Kuhn (4 threads), iters = 1000, NashConv: " << nash_conv
+            << std::endl;
+  SPIEL_CHECK_LE(nash_conv, 0.1);
+
+  // The solver can keep running serially on the same table.
+  solver.RunIteration();
+  SPIEL_CHECK_EQ(solver.NumIterations(), 1001);
+
+  // And in parallel again with NUMA-aware placement, a no-op on one node.
+  solver.RunIterationsInParallel(/*num_iterations=*/100, /*num_threads=*/4,
+                                 MemoryPlacement::kPartitioned);
+  SPIEL_CHECK_EQ(solver.NumIterations(), 1101);
+}
+
+// A solver restored from a checkpoint continues exactly like the original.
+void MCCFR_CheckpointTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  ExternalSamplingMCCFRSolver solver(*game, kSeed);
+  for (int i = 0; i < 100; i++) {
+    solver.RunIteration();
+  }
+  const std::string filename =
+      testing::TempFilename("external_sampling_mccfr", ".ckpt");
+  solver.SaveCheckpoint(filename);
+  ExternalSamplingMCCFRSolver restored_solver(*game);
+  restored_solver.LoadCheckpoint(filename);
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+  SPIEL_CHECK_EQ(restored_solver.NumIterations(), 100);
+
+  for (int i = 0; i < 100; i++) {
+    solver.RunIteration();
+    restored_solver.RunIteration();
+  }
+  SPIEL_CHECK_EQ(restored_solver.NumIterations(), solver.NumIterations());
+  SPIEL_CHECK_EQ(NashConv(*game, *restored_solver.AveragePolicy()),
+                 NashConv(*game, *solver.AveragePolicy()));
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -73,9 +123,11 @@ int main(int argc, char** argv) {
   // Values double-checked with the original implementation used in (Lanctot,
   // "Monte Carlo Sampling and Regret Minimization For Equilibrium Computation
   // and Decision-Making in Large Extensive Form Games", 2013).
-  std::mt19937 rng(algorithms::kSeed);
-  algorithms::MCCFR_2PGameTest("kuhn_poker", &rng, 1000, 0.05);
+  open_spiel::Xoshiro256PlusPlus rng(algorithms::kSeed);
+  algorithms::MCCFR_2PGameTest("kuhn_poker", &rng, 2000, 0.05);
   algorithms::MCCFR_2PGameTest("leduc_poker", &rng, 1000, 3.0);
   algorithms::MCCFR_2PGameTest("liars_dice", &rng, 1000, 1.0);
   algorithms::MCCFR_KuhnPoker3PTest(&rng);
+  algorithms::MCCFR_ParallelKuhnPokerTest();
+  algorithms::MCCFR_CheckpointTest();
 }
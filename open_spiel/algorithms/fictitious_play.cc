@@ -0,0 +1,143 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/fictitious_play.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/algorithms/best_response.h"
+#include "open_spiel/algorithms/history_tree.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+XFPSolver::XFPSolver(const Game& game, int num_threads)
+    : game_(game.shared_from_this()),
+      num_threads_(num_threads),
+      tree_(std::make_shared<CompactHistoryTree>(*game.NewInitialState())),
+      average_policy_(GetUniformPolicy(game)),
+      best_responses_(tree_->NumInfoStates(), kInvalidAction) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "XFP requires sequential games. If you're trying to run it "
+        "on a simultaneous (or normal-form) game, please first transform it "
+        "using turn_based_simultaneous_game.");
+  }
+  SPIEL_CHECK_GE(num_threads, 1);
+  for (int i = 0; i < tree_->NumInfoStates(); ++i) {
+    auto iter = average_policy_.PolicyTable().find(tree_->InfoStateString(i));
+    SPIEL_CHECK_TRUE(iter != average_policy_.PolicyTable().end());
+    average_policies_.push_back(&iter->second);
+  }
+  const int num_best_response_threads =
+      std::max(1, num_threads / game.NumPlayers());
+  for (Player p = 0; p < game.NumPlayers(); ++p) {
+    best_response_computers_.push_back(std::make_unique<TabularBestResponse>(
+        game, p, /*policy=*/nullptr, tree_, num_best_response_threads));
+  }
+}
+
+void XFPSolver::ParallelFor(int n, const std::function<void(int)>& fn) const {
+  const int num_threads = std::min(num_threads_, n);
+  if (num_threads <= 1) {
+    for (int i = 0; i < n; ++i) fn(i);
+    return;
+  }
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([t, n, num_threads, &fn]() {
+      for (int i = t; i < n; i += num_threads) fn(i);
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+}
+
+void XFPSolver::RunIteration() {
+  ++iteration_;
+
+  // The best responses to the average policy, which is only read, so the
+  // players can be handled concurrently. Each writes the entries of its own
+  // information states.
+  ParallelFor(game_->NumPlayers(), [this](Player p) {
+    TabularBestResponse& computer = *best_response_computers_[p];
+    computer.SetPolicy(&average_policy_);
+    for (const auto& [info_state, action] :
+         computer.GetBestResponseActions()) {
+      best_responses_[tree_->InfoStateIndex(info_state)] = action;
+    }
+  });
+
+  // The new average at each information state only depends on the previous
+  // average and the best responses above it.
+  const double alpha = 1.0 / (iteration_ + 1);
+  std::vector<ActionsAndProbs> new_policies(tree_->NumInfoStates());
+  ParallelFor(tree_->NumInfoStates(), [&](int info_state) {
+    const Player player = tree_->InfoStatePlayer(info_state);
+    // The probabilities of the player's actions to one of the histories.
+    double average_reach = 1;
+    double best_response_reach = 1;
+    for (int index = tree_->InfoStateNodes(info_state)[0];
+         tree_->GetNode(index).parent >= 0;
+         index = tree_->GetNode(index).parent) {
+      const CompactHistoryTree::Node& parent =
+          tree_->GetNode(tree_->GetNode(index).parent);
+      if (parent.type != StateType::kDecision || parent.player != player) {
+        continue;
+      }
+      const Action action = tree_->GetNode(index).action;
+      average_reach *= GetProb(*average_policies_[parent.info_state], action);
+      if (best_responses_[parent.info_state] != action) {
+        best_response_reach = 0;
+      }
+    }
+    ActionsAndProbs& policy = new_policies[info_state];
+    policy = *average_policies_[info_state];
+    const double normalizer =
+        (1 - alpha) * average_reach + alpha * best_response_reach;
+    if (normalizer <= 0) return;
+    const Action best_response = best_responses_[info_state];
+    for (auto& [action, prob] : policy) {
+      prob += alpha * best_response_reach *
+              ((action == best_response ? 1.0 : 0.0) - prob) / normalizer;
+    }
+  });
+  for (int i = 0; i < new_policies.size(); ++i) {
+    *average_policies_[i] = std::move(new_policies[i]);
+  }
+}
+
+TabularPolicy XFPSolver::BestResponsePolicy() const {
+  std::unordered_map<std::string, Action> actions;
+  for (int i = 0; i < best_responses_.size(); ++i) {
+    if (best_responses_[i] != kInvalidAction) {
+      actions[tree_->InfoStateString(i)] = best_responses_[i];
+    }
+  }
+  return TabularPolicy(GetUniformPolicy(*game_), actions);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
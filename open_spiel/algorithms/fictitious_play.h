@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_FICTITIOUS_PLAY_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_FICTITIOUS_PLAY_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/best_response.h"
+#include "open_spiel/algorithms/history_tree.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// Extensive-form fictitious play (XFP, Algorithm 1 of Heinrich, Lanctot and
+// Silver, "Fictitious Self-Play in Extensive-Form Games", 2015,
+// http://mlanctot.info/files/papers/icml15-fsp.pdf), as in
+// python/algorithms/fictitious_play.py. At each iteration, all the players
+// best respond to the average policy, and the average policy of each player
+// moves towards its best response by 1 / (iteration + 1), each information
+// state weighted by the probabilities of the player reaching it under both,
+// so that it plays as the average of the best responses so far.
+//
+// The game tree is built once, as a CompactHistoryTree shared by the best
+// responses of all the players and the averaging, which works on the indices
+// of its information states. Each player's TabularBestResponse is kept
+// across iterations. The averaging takes the reach probabilities at one of
+// the histories of each information state, which requires perfect recall.
+namespace open_spiel {
+namespace algorithms {
+
+class XFPSolver {
+ public:
+  // With num_threads > 1, the best responses of the players are computed
+  // concurrently, with the threads left over used within them, and the
+  // information states are averaged in parallel, which gives the same
+  // results.
+  explicit XFPSolver(const Game& game, int num_threads = 1);
+
+  XFPSolver(const XFPSolver&) = delete;
+  XFPSolver& operator=(const XFPSolver&) = delete;
+
+  void RunIteration();
+  int NumIterations() const { return iteration_; }
+
+  // The average policy of all the players, uniform before the first
+  // iteration.
+  const TabularPolicy& AveragePolicy() const { return average_policy_; }
+
+  // The best responses of all the players at the last iteration.
+  TabularPolicy BestResponsePolicy() const;
+
+ private:
+  // Runs fn(i) for i in [0, n) on up to num_threads_ threads.
+  void ParallelFor(int n, const std::function<void(int)>& fn) const;
+
+  std::shared_ptr<const Game> game_;
+  const int num_threads_;
+  std::shared_ptr<CompactHistoryTree> tree_;
+  int iteration_ = 0;
+
+  TabularPolicy average_policy_;
+  // The entry of average_policy_ of each information state of tree_.
+  std::vector<ActionsAndProbs*> average_policies_;
+  std::vector<std::unique_ptr<TabularBestResponse>> best_response_computers_;
+  // The best response at each information state of tree_.
+  std::vector<Action> best_responses_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_FICTITIOUS_PLAY_H_
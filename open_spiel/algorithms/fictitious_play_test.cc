@@ -0,0 +1,150 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/fictitious_play.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/algorithms/best_response.h"
+#include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void XFPTest_KuhnPoker() {
+  // As in python/algorithms/fictitious_play_test.py.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  XFPSolver solver(*game);
+  for (int i = 0; i < 100; ++i) solver.RunIteration();
+  SPIEL_CHECK_EQ(solver.NumIterations(), 100);
+  const std::vector<double> values =
+      ExpectedReturns(*game->NewInitialState(), solver.AveragePolicy(), -1);
+  // 1/18 is the Nash value. See https://en.wikipedia.org/wiki/Kuhn_poker
+  SPIEL_CHECK_FLOAT_NEAR(values[0], -1.0 / 18, 1e-3);
+  SPIEL_CHECK_FLOAT_NEAR(values[1], 1.0 / 18, 1e-3);
+  SPIEL_CHECK_LT(NashConv(*game, solver.AveragePolicy()), 0.05);
+}
+
+// The update of python/algorithms/fictitious_play.py, by a traversal of the
+// game with the reach probabilities of all the players.
+void UpdateAveragePolicy(const State& state, double alpha,
+                         const TabularPolicy& average_policy,
+                         const TabularPolicy& best_responses,
+                         std::vector<double> average_reach,
+                         std::vector<double> best_response_reach,
+                         TabularPolicy* new_average_policy) {
+  if (state.IsTerminal()) return;
+  if (state.IsChanceNode()) {
+    for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+      UpdateAveragePolicy(*state.Child(outcome), alpha, average_policy,
+                          best_responses, average_reach, best_response_reach,
+                          new_average_policy);
+    }
+    return;
+  }
+  const Player player = state.CurrentPlayer();
+  const std::string info_state = state.InformationStateString(player);
+  const ActionsAndProbs average = average_policy.GetStatePolicy(info_state);
+  const ActionsAndProbs best_response =
+      best_responses.GetStatePolicy(info_state);
+  for (Action action : state.LegalActions()) {
+    std::vector<double> child_average_reach = average_reach;
+    child_average_reach[player] *= GetProb(average, action);
+    std::vector<double> child_best_response_reach = best_response_reach;
+    child_best_response_reach[player] *= GetProb(best_response, action);
+    UpdateAveragePolicy(*state.Child(action), alpha, average_policy,
+                        best_responses, child_average_reach,
+                        child_best_response_reach, new_average_policy);
+  }
+  ActionsAndProbs& policy = new_average_policy->PolicyTable()[info_state];
+  policy = average;
+  for (auto& [action, prob] : policy) {
+    prob += alpha * best_response_reach[player] *
+            (GetProb(best_response, action) - prob) /
+            ((1 - alpha) * average_reach[player] +
+             alpha * best_response_reach[player]);
+  }
+}
+
+void XFPTest_MatchesRecursiveUpdate() {
+  std::shared_ptr<const Game> game =
+      LoadGame("kuhn_poker", {{"players", GameParameter(3)}});
+  XFPSolver solver(*game);
+  TabularPolicy average_policy = GetUniformPolicy(*game);
+  for (int iteration = 1; iteration <= 5; ++iteration) {
+    solver.RunIteration();
+    std::unordered_map<std::string, Action> actions;
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      TabularBestResponse best_response(*game, p, &average_policy);
+      for (const auto& entry : best_response.GetBestResponseActions()) {
+        actions.insert(entry);
+      }
+    }
+    const TabularPolicy best_responses(average_policy, actions);
+    TabularPolicy new_average_policy = average_policy;
+    const std::vector<double> reach(game->NumPlayers(), 1.0);
+    UpdateAveragePolicy(*game->NewInitialState(), 1.0 / (iteration + 1),
+                        average_policy, best_responses, reach, reach,
+                        &new_average_policy);
+    average_policy = new_average_policy;
+    for (const auto& [info_state, policy] : average_policy.PolicyTable()) {
+      const ActionsAndProbs xfp_policy =
+          solver.AveragePolicy().GetStatePolicy(info_state);
+      SPIEL_CHECK_EQ(xfp_policy.size(), policy.size());
+      for (int i = 0; i < policy.size(); ++i) {
+        SPIEL_CHECK_EQ(xfp_policy[i].first, policy[i].first);
+        SPIEL_CHECK_FLOAT_NEAR(xfp_policy[i].second, policy[i].second, 1e-12);
+      }
+      SPIEL_CHECK_EQ(
+          GetProb(solver.BestResponsePolicy().GetStatePolicy(info_state),
+                  actions.at(info_state)),
+          1.0);
+    }
+  }
+}
+
+void XFPTest_Threads() {
+  // The players and the information states are split between the threads,
+  // which gives the same results.
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  XFPSolver solver(*game);
+  XFPSolver threaded_solver(*game, /*num_threads=*/4);
+  double nash_conv = NashConv(*game, solver.AveragePolicy());
+  for (int i = 0; i < 10; ++i) {
+    solver.RunIteration();
+    threaded_solver.RunIteration();
+  }
+  SPIEL_CHECK_TRUE(solver.AveragePolicy().PolicyTable() ==
+                   threaded_solver.AveragePolicy().PolicyTable());
+  SPIEL_CHECK_LT(NashConv(*game, solver.AveragePolicy()), nash_conv);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::XFPTest_KuhnPoker();
+  open_spiel::algorithms::XFPTest_MatchesRecursiveUpdate();
+  open_spiel::algorithms::XFPTest_Threads();
+}
@@ -0,0 +1,425 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/flat_cfr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+int32_t FixedPoint32::Encode(double value) {
+  const double raw = std::round(value * (int64_t{1} << kFractionBits));
+  if (raw >= std::numeric_limits<int32_t>::max()) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  if (raw <= std::numeric_limits<int32_t>::min()) {
+    return std::numeric_limits<int32_t>::min();
+  }
+  return static_cast<int32_t>(raw);
+}
+
+template <typename ValueType>
+FlatCFRSolverBaseT<ValueType>::FlatCFRSolverBaseT(
+    const Game& game, bool alternating_updates, bool linear_averaging,
+    bool regret_matching_plus, int num_threads, bool store_legal_actions)
+    : game_(game),
+      num_players_(game.NumPlayers()),
+      regret_matching_plus_(regret_matching_plus),
+      alternating_updates_(alternating_updates),
+      linear_averaging_(linear_averaging),
+      num_threads_(num_threads),
+      store_legal_actions_(store_legal_actions) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "CFR requires sequential games. If you're trying to run it "
+        "on a simultaneous (or normal-form) game, please first transform it "
+        "using turn_based_simultaneous_game.");
+  }
+
+  std::unordered_map<std::string, int> info_state_ids;
+  int max_depth = 0;
+  CompileTree(*game.NewInitialState(), /*depth=*/0, &info_state_ids,
+              &max_depth);
+  edge_begin_.push_back(edge_child_.size());
+  info_state_begin_.push_back(legal_actions_.size());
+
+  const int num_actions = legal_actions_.size();
+  if (!store_legal_actions_) {
+    std::vector<Action>().swap(legal_actions_);
+  }
+  cumulative_regrets_.resize(num_actions, 0.0);
+  cumulative_policy_.resize(num_actions, 0.0);
+  current_policy_.resize(num_actions);
+  for (int info_state = 0; info_state < NumInfoStates(); ++info_state) {
+    const int begin = info_state_begin_[info_state];
+    const int end = info_state_begin_[info_state + 1];
+    std::fill(current_policy_.begin() + begin, current_policy_.begin() + end,
+              1.0 / (end - begin));
+  }
+
+  scratch_stride_ = num_players_ + 1 + max_children_ * num_players_;
+  scratch_.resize((max_depth + 1) * scratch_stride_);
+  root_reach_probs_.resize(num_players_ + 1, 1.0);
+  root_values_.resize(num_players_);
+
+  // Parallelism is over the root chance outcomes only.
+  const int num_root_children = edge_begin_[1] - edge_begin_[0];
+  if (num_threads_ > 1 && node_player_[0] == kChancePlayerId &&
+      num_root_children > 1) {
+    thread_buffers_.resize(std::min(num_threads_, num_root_children));
+    for (ThreadBuffers& buffers : thread_buffers_) {
+      buffers.scratch.resize(scratch_.size());
+      buffers.cumulative_regrets.resize(num_actions);
+      buffers.cumulative_policy.resize(num_actions);
+    }
+  }
+}
+
+template <typename ValueType>
+int FlatCFRSolverBaseT<ValueType>::CompileTree(
+    const State& state, int depth,
+    std::unordered_map<std::string, int>* info_state_ids, int* max_depth) {
+  *max_depth = std::max(*max_depth, depth);
+  const int node = node_player_.size();
+  node_player_.push_back(state.IsTerminal()
+                             ? kTerminalPlayerId
+                             : state.IsChanceNode() ? kChancePlayerId
+                                                    : state.CurrentPlayer());
+  edge_begin_.push_back(edge_child_.size());
+
+  if (state.IsTerminal()) {
+    node_data_.push_back(terminal_utilities_.size());
+    const std::vector<double> returns = state.Returns();
+    terminal_utilities_.insert(terminal_utilities_.end(), returns.begin(),
+                               returns.end());
+    return node;
+  }
+
+  std::vector<Action> actions;
+  if (state.IsChanceNode()) {
+    node_data_.push_back(-1);
+    for (const auto& [action, prob] : state.ChanceOutcomes()) {
+      actions.push_back(action);
+      edge_prob_.push_back(prob);
+    }
+  } else {
+    const Player player = state.CurrentPlayer();
+    if (player < 0 || player >= num_players_) {
+      SpielFatalError("CFR requires turn-based decision nodes.");
+    }
+    actions = state.LegalActions();
+    const std::string info_state = state.InformationStateString(player);
+    auto [iter, inserted] =
+        info_state_ids->emplace(info_state, info_state_strings_.size());
+    if (inserted) {
+      info_state_strings_.push_back(info_state);
+      info_state_begin_.push_back(legal_actions_.size());
+      legal_actions_.insert(legal_actions_.end(), actions.begin(),
+                            actions.end());
+    } else {
+      // All the nodes of an information state share its action ordering.
+      const int begin = info_state_begin_[iter->second];
+      SPIEL_CHECK_TRUE(std::equal(actions.begin(), actions.end(),
+                                  legal_actions_.begin() + begin));
+    }
+    node_data_.push_back(iter->second);
+    edge_prob_.resize(edge_prob_.size() + actions.size(), 0.0);
+  }
+
+  // Reserve this node's block of edges before adding the children, so that
+  // the blocks are laid out in node order.
+  max_children_ = std::max<int>(max_children_, actions.size());
+  const int first_edge = edge_child_.size();
+  edge_child_.resize(first_edge + actions.size());
+  for (int i = 0; i < actions.size(); ++i) {
+    edge_child_[first_edge + i] = CompileTree(*state.Child(actions[i]),
+                                              depth + 1, info_state_ids,
+                                              max_depth);
+  }
+  return node;
+}
+
+template <typename ValueType>
+void FlatCFRSolverBaseT<ValueType>::CollectLegalActions(
+    const State& state, int* next_info_state,
+    std::vector<Action>* legal_actions) const {
+  if (state.IsTerminal()) return;
+  std::vector<Action> actions;
+  if (state.IsChanceNode()) {
+    for (const auto& [action, prob] : state.ChanceOutcomes()) {
+      actions.push_back(action);
+    }
+  } else {
+    actions = state.LegalActions();
+    // Information states are numbered in the order of their first visit.
+    if (*next_info_state < NumInfoStates() &&
+        state.InformationStateString() ==
+            info_state_strings_[*next_info_state]) {
+      legal_actions->insert(legal_actions->end(), actions.begin(),
+                            actions.end());
+      ++*next_info_state;
+    }
+  }
+  for (Action action : actions) {
+    CollectLegalActions(*state.Child(action), next_info_state, legal_actions);
+  }
+}
+
+template <typename ValueType>
+std::vector<Action> FlatCFRSolverBaseT<ValueType>::LegalActions() const {
+  if (store_legal_actions_) return legal_actions_;
+  std::vector<Action> legal_actions;
+  legal_actions.reserve(cumulative_regrets_.size());
+  int next_info_state = 0;
+  CollectLegalActions(*game_.NewInitialState(), &next_info_state,
+                      &legal_actions);
+  SPIEL_CHECK_EQ(legal_actions.size(), cumulative_regrets_.size());
+  return legal_actions;
+}
+
+template <typename ValueType>
+int64_t FlatCFRSolverBaseT<ValueType>::TableBytes() const {
+  int64_t bytes = cumulative_regrets_.size() * 3 * sizeof(ValueType) +
+                  legal_actions_.size() * sizeof(Action);
+  // Short strings are stored inline, so this is an upper bound.
+  for (const std::string& info_state : info_state_strings_) {
+    bytes += sizeof(std::string) + info_state.capacity() + 1;
+  }
+  return bytes;
+}
+
+template <typename ValueType>
+void FlatCFRSolverBaseT<ValueType>::EvaluateAndUpdatePolicy() {
+  ++iteration_;
+  if (alternating_updates_) {
+    for (Player player = 0; player < num_players_; player++) {
+      ComputeCounterFactualRegretFromRoot(player);
+      if (regret_matching_plus_) {
+        ApplyRegretMatchingPlusReset();
+      }
+      ApplyRegretMatching();
+    }
+  } else {
+    ComputeCounterFactualRegretFromRoot(kInvalidPlayer);
+    if (regret_matching_plus_) {
+      ApplyRegretMatchingPlusReset();
+    }
+    ApplyRegretMatching();
+  }
+}
+
+template <typename ValueType>
+void FlatCFRSolverBaseT<ValueType>::ComputeCounterFactualRegretFromRoot(
+    Player updating_player) {
+  if (thread_buffers_.empty()) {
+    ComputeCounterFactualRegret(
+        /*node=*/0, /*depth=*/0, updating_player, root_reach_probs_.data(),
+        root_values_.data(),
+        Accumulators<ValueType>{scratch_.data(), cumulative_regrets_.data(),
+                                cumulative_policy_.data()});
+    return;
+  }
+
+  // Each thread handles a contiguous chunk of the root chance outcomes.
+  const int first_edge = edge_begin_[0];
+  const int num_children = edge_begin_[1] - first_edge;
+  const int num_threads = thread_buffers_.size();
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([this, t, num_threads, first_edge, num_children,
+                          updating_player]() {
+      ThreadBuffers& buffers = thread_buffers_[t];
+      std::fill(buffers.cumulative_regrets.begin(),
+                buffers.cumulative_regrets.end(), 0.0);
+      std::fill(buffers.cumulative_policy.begin(),
+                buffers.cumulative_policy.end(), 0.0);
+      const Accumulators<double> accumulators{
+          buffers.scratch.data(), buffers.cumulative_regrets.data(),
+          buffers.cumulative_policy.data()};
+      std::vector<double> child_reach(root_reach_probs_);
+      std::vector<double> child_values(num_players_);
+      for (int i = t * num_children / num_threads;
+           i < (t + 1) * num_children / num_threads; ++i) {
+        child_reach[num_players_] = edge_prob_[first_edge + i];
+        ComputeCounterFactualRegret(edge_child_[first_edge + i], /*depth=*/1,
+                                    updating_player, child_reach.data(),
+                                    child_values.data(), accumulators);
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+
+  for (const ThreadBuffers& buffers : thread_buffers_) {
+    for (int i = 0; i < cumulative_regrets_.size(); ++i) {
+      cumulative_regrets_[i] += buffers.cumulative_regrets[i];
+      cumulative_policy_[i] += buffers.cumulative_policy[i];
+    }
+  }
+}
+
+template <typename ValueType>
+template <typename AccumulatorType>
+void FlatCFRSolverBaseT<ValueType>::ComputeCounterFactualRegret(
+    int node, int depth, Player updating_player,
+    const double* reach_probabilities, double* values,
+    const Accumulators<AccumulatorType>& accumulators) {
+  const Player player = node_player_[node];
+  if (player == kTerminalPlayerId) {
+    std::copy_n(&terminal_utilities_[node_data_[node]], num_players_, values);
+    return;
+  }
+  std::fill_n(values, num_players_, 0.0);
+  if (player != kChancePlayerId &&
+      std::all_of(reach_probabilities, reach_probabilities + num_players_,
+                  [](double prob) { return prob == 0.0; })) {
+    // None of the players can reach this node, so its value does not impact
+    // the parent's; see CFRSolverBase::ComputeCounterFactualRegret.
+    return;
+  }
+
+  const int first_edge = edge_begin_[node];
+  const int num_children = edge_begin_[node + 1] - first_edge;
+  const int reach_index = player == kChancePlayerId ? num_players_ : player;
+  const ValueType* policy =
+      player == kChancePlayerId
+          ? nullptr
+          : &current_policy_[info_state_begin_[node_data_[node]]];
+  double* child_reach = accumulators.scratch + depth * scratch_stride_;
+  double* child_values = child_reach + num_players_ + 1;
+
+  for (int i = 0; i < num_children; ++i) {
+    const double prob = policy == nullptr ? edge_prob_[first_edge + i]
+                                          : static_cast<double>(policy[i]);
+    std::copy_n(reach_probabilities, num_players_ + 1, child_reach);
+    child_reach[reach_index] *= prob;
+    double* child_value = child_values + i * num_players_;
+    ComputeCounterFactualRegret(edge_child_[first_edge + i], depth + 1,
+                                updating_player, child_reach, child_value,
+                                accumulators);
+    for (int p = 0; p < num_players_; ++p) {
+      values[p] += prob * child_value[p];
+    }
+  }
+
+  // Perform regret and average strategy updates.
+  if (player == kChancePlayerId ||
+      (updating_player != kInvalidPlayer && updating_player != player)) {
+    return;
+  }
+  const double self_reach_prob = reach_probabilities[player];
+  double cfr_reach_prob = 1.0;
+  for (int p = 0; p <= num_players_; ++p) {
+    if (p != player) cfr_reach_prob *= reach_probabilities[p];
+  }
+  const int offset = info_state_begin_[node_data_[node]];
+  for (int i = 0; i < num_children; ++i) {
+    accumulators.cumulative_regrets[offset + i] +=
+        cfr_reach_prob * (child_values[i * num_players_ + player] -
+                          values[player]);
+    if (linear_averaging_) {
+      accumulators.cumulative_policy[offset + i] +=
+          iteration_ * self_reach_prob * policy[i];
+    } else {
+      accumulators.cumulative_policy[offset + i] += self_reach_prob * policy[i];
+    }
+  }
+}
+
+template <typename ValueType>
+void FlatCFRSolverBaseT<ValueType>::ApplyRegretMatching() {
+  for (int info_state = 0; info_state < NumInfoStates(); ++info_state) {
+    const int begin = info_state_begin_[info_state];
+    const int end = info_state_begin_[info_state + 1];
+    double sum_positive_regrets = 0.0;
+    for (int i = begin; i < end; ++i) {
+      if (cumulative_regrets_[i] > 0) {
+        sum_positive_regrets += cumulative_regrets_[i];
+      }
+    }
+    for (int i = begin; i < end; ++i) {
+      if (sum_positive_regrets > 0) {
+        current_policy_[i] =
+            cumulative_regrets_[i] > 0
+                ? cumulative_regrets_[i] / sum_positive_regrets
+                : 0;
+      } else {
+        current_policy_[i] = 1.0 / (end - begin);
+      }
+    }
+  }
+}
+
+template <typename ValueType>
+void FlatCFRSolverBaseT<ValueType>::ApplyRegretMatchingPlusReset() {
+  for (ValueType& regret : cumulative_regrets_) {
+    if (regret < 0) regret = 0;
+  }
+}
+
+template <typename ValueType>
+std::unique_ptr<Policy> FlatCFRSolverBaseT<ValueType>::AveragePolicy() const {
+  const std::vector<Action> legal_actions = LegalActions();
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  for (int info_state = 0; info_state < NumInfoStates(); ++info_state) {
+    const int begin = info_state_begin_[info_state];
+    const int end = info_state_begin_[info_state + 1];
+    double sum_prob = 0.0;
+    for (int i = begin; i < end; ++i) sum_prob += cumulative_policy_[i];
+    ActionsAndProbs& actions_and_probs = table[info_state_strings_[info_state]];
+    for (int i = begin; i < end; ++i) {
+      // Uniform if the information state was never reached.
+      actions_and_probs.push_back(
+          {legal_actions[i], sum_prob == 0.0 ? 1.0 / (end - begin)
+                                              : cumulative_policy_[i] /
+                                                    sum_prob});
+    }
+  }
+  return std::unique_ptr<Policy>(new TabularPolicy(table));
+}
+
+template <typename ValueType>
+std::unique_ptr<Policy> FlatCFRSolverBaseT<ValueType>::CurrentPolicy() const {
+  const std::vector<Action> legal_actions = LegalActions();
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  for (int info_state = 0; info_state < NumInfoStates(); ++info_state) {
+    ActionsAndProbs& actions_and_probs = table[info_state_strings_[info_state]];
+    for (int i = info_state_begin_[info_state];
+         i < info_state_begin_[info_state + 1]; ++i) {
+      actions_and_probs.push_back({legal_actions[i], current_policy_[i]});
+    }
+  }
+  return std::unique_ptr<Policy>(new TabularPolicy(table));
+}
+
+template class FlatCFRSolverBaseT<double>;
+template class FlatCFRSolverBaseT<float>;
+template class FlatCFRSolverBaseT<FixedPoint32>;
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,230 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_FLAT_CFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_FLAT_CFR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A signed fixed-point number in 32 bits, with kFractionBits bits after the
+// binary point, for compact CFR tables. Arithmetic goes through double, and
+// values are rounded to the nearest representable one and saturate at the
+// ends of the range (about +/-32768) instead of overflowing.
+class FixedPoint32 {
+ public:
+  static constexpr int kFractionBits = 16;
+
+  FixedPoint32(double value = 0.0) : raw_(Encode(value)) {}  // NOLINT
+  operator double() const {                                 // NOLINT
+    return static_cast<double>(raw_) / (int64_t{1} << kFractionBits);
+  }
+  FixedPoint32& operator+=(double value) {
+    raw_ = Encode(static_cast<double>(*this) + value);
+    return *this;
+  }
+
+ private:
+  static int32_t Encode(double value);
+
+  int32_t raw_;
+};
+
+// CFR on a game tree compiled once into flat arrays.
+//
+// This computes the same iterates as CFRSolverBase (see cfr.h) for the same
+// flavour options, but instead of walking the game with State::Child and
+// looking information states up by string at every node, the constructor
+// enumerates the tree once and records, for each node, its player, its
+// information state (or terminal utilities) and the range of its children,
+// along with chance probabilities. Regrets and policies are stored as
+// structure-of-arrays buffers indexed by information state offset, so an
+// iteration is a sweep over these arrays without allocation or hashing.
+//
+// The whole tree is kept in memory, so this is meant for games that are small
+// enough to be solved exactly by tabular CFR anyway.
+//
+// With num_threads > 1 and a chance node at the root (e.g. the deal in poker
+// games), the subtrees of the root chance outcomes are split into contiguous
+// chunks, one per thread. Each thread accumulates its regret and average
+// policy updates into its own buffers, which are then added to the tables in
+// thread order, so results only depend on the number of threads. They match
+// the single-threaded ones up to floating-point rounding.
+//
+// The regrets and policies are stored as ValueType, which can be double,
+// float or FixedPoint32 to halve the memory of the tables. Updates are still
+// computed in double and rounded when added to the tables. FixedPoint32 has
+// a fixed absolute precision and range, so it suits regrets and policy sums
+// of the order of the utilities, e.g. CFR+ on small games; linearly averaged
+// policy sums grow quadratically and saturate after a few hundred iterations.
+//
+// With store_legal_actions = false, the actions of each information state
+// are not kept either (they are as large as the other tables together with
+// float values), and the policy snapshots walk the game again to get them.
+template <typename ValueType>
+class FlatCFRSolverBaseT {
+ public:
+  FlatCFRSolverBaseT(const Game& game, bool alternating_updates,
+                     bool linear_averaging, bool regret_matching_plus,
+                     int num_threads = 1, bool store_legal_actions = true);
+  virtual ~FlatCFRSolverBaseT() = default;
+
+  // Performs one step of the CFR algorithm.
+  virtual void EvaluateAndUpdatePolicy();
+
+  // Returns a snapshot of the average policy, containing the policy for all
+  // players.
+  std::unique_ptr<Policy> AveragePolicy() const;
+
+  // Returns a snapshot of the current policy, containing the policy for all
+  // players.
+  std::unique_ptr<Policy> CurrentPolicy() const;
+
+  int NumNodes() const { return node_player_.size(); }
+  int NumInfoStates() const { return info_state_strings_.size(); }
+
+  // The memory used by the regret and policy tables, the legal actions and
+  // the information state strings, in bytes.
+  int64_t TableBytes() const;
+
+ protected:
+  // Where a traversal accumulates its updates: scratch space for the
+  // per-depth reach probabilities and child values, and the per-action regret
+  // and average policy sums, either the tables or per-thread buffers.
+  template <typename AccumulatorType>
+  struct Accumulators {
+    double* scratch;
+    AccumulatorType* cumulative_regrets;
+    AccumulatorType* cumulative_policy;
+  };
+
+  // Computes the values of the subtree rooted at `node` into `values`
+  // ([num_players]) and adds the regret and average policy updates of
+  // `updating_player`, or of every player if it is kInvalidPlayer, to
+  // `accumulators`. `reach_probabilities` has one entry per player, followed
+  // by chance.
+  template <typename AccumulatorType>
+  void ComputeCounterFactualRegret(
+      int node, int depth, Player updating_player,
+      const double* reach_probabilities, double* values,
+      const Accumulators<AccumulatorType>& accumulators);
+
+  // Runs ComputeCounterFactualRegret from the root, in parallel if possible.
+  void ComputeCounterFactualRegretFromRoot(Player updating_player);
+
+  // Update the current policy for all information states.
+  void ApplyRegretMatching();
+  void ApplyRegretMatchingPlusReset();
+
+  const Game& game_;
+  const int num_players_;
+  int iteration_ = 0;
+
+ private:
+  // Appends the subtree rooted at `state` to the arrays, returns its node id.
+  int CompileTree(const State& state, int depth,
+                  std::unordered_map<std::string, int>* info_state_ids,
+                  int* max_depth);
+
+  // Appends the legal actions of the information states below `state` that
+  // are first visited there, from `*next_info_state` on, in the order of
+  // CompileTree.
+  void CollectLegalActions(const State& state, int* next_info_state,
+                           std::vector<Action>* legal_actions) const;
+
+  // Returns legal_actions_, or recomputes it if it is not stored.
+  std::vector<Action> LegalActions() const;
+
+  const bool regret_matching_plus_;
+  const bool alternating_updates_;
+  const bool linear_averaging_;
+  const int num_threads_;
+  const bool store_legal_actions_;
+
+  // The tree, one entry per node. node_data_ is the information state for a
+  // decision node and the offset into terminal_utilities_ for a terminal one.
+  // The children of node n are edge_child_[edge_begin_[n]...edge_begin_[n+1]),
+  // in the same order as the actions of its information state, or of its
+  // chance outcomes with probabilities edge_prob_.
+  std::vector<Player> node_player_;
+  std::vector<int> node_data_;
+  std::vector<int> edge_begin_;
+  std::vector<int> edge_child_;
+  std::vector<double> edge_prob_;
+  std::vector<double> terminal_utilities_;
+
+  // The information states. The values for the actions of information state i
+  // are at [info_state_begin_[i], info_state_begin_[i + 1]) of the per-action
+  // arrays. legal_actions_ is empty if !store_legal_actions_.
+  std::vector<std::string> info_state_strings_;
+  std::vector<int> info_state_begin_;
+  std::vector<Action> legal_actions_;
+  std::vector<ValueType> cumulative_regrets_;
+  std::vector<ValueType> cumulative_policy_;
+  std::vector<ValueType> current_policy_;
+
+  // Per-depth scratch space for reach probabilities and child values, so that
+  // the traversal does not allocate.
+  int max_children_ = 0;
+  int scratch_stride_ = 0;
+  std::vector<double> scratch_;
+  std::vector<double> root_reach_probs_;
+  std::vector<double> root_values_;
+
+  // Per-thread scratch space and updates, when running in parallel.
+  struct ThreadBuffers {
+    std::vector<double> scratch;
+    std::vector<double> cumulative_regrets;
+    std::vector<double> cumulative_policy;
+  };
+  std::vector<ThreadBuffers> thread_buffers_;
+};
+
+using FlatCFRSolverBase = FlatCFRSolverBaseT<double>;
+
+// Standard CFR, see CFRSolver.
+class FlatCFRSolver : public FlatCFRSolverBase {
+ public:
+  explicit FlatCFRSolver(const Game& game, int num_threads = 1)
+      : FlatCFRSolverBase(game,
+                          /*alternating_updates=*/true,
+                          /*linear_averaging=*/false,
+                          /*regret_matching_plus=*/false,
+                          num_threads) {}
+};
+
+// CFR+, see CFRPlusSolver.
+class FlatCFRPlusSolver : public FlatCFRSolverBase {
+ public:
+  explicit FlatCFRPlusSolver(const Game& game, int num_threads = 1)
+      : FlatCFRSolverBase(game,
+                          /*alternating_updates=*/true,
+                          /*linear_averaging=*/true,
+                          /*regret_matching_plus=*/true,
+                          num_threads) {}
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_FLAT_CFR_H_
@@ -0,0 +1,163 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/flat_cfr.h"
+
+#include <memory>
+#include <string>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CheckSamePolicies(const Policy& flat_policy, const Policy& policy,
+                       double tolerance = 1e-9) {
+  const auto& table =
+      static_cast<const TabularPolicy&>(flat_policy).PolicyTable();
+  for (const auto& [info_state, actions_and_probs] : table) {
+    const ActionsAndProbs expected = policy.GetStatePolicy(info_state);
+    SPIEL_CHECK_EQ(actions_and_probs.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+      SPIEL_CHECK_EQ(actions_and_probs[i].first, expected[i].first);
+      SPIEL_CHECK_FLOAT_NEAR(actions_and_probs[i].second, expected[i].second,
+                             tolerance);
+    }
+  }
+}
+
+// The flat solver must reproduce the iterates of the tree-walking one.
+void FlatCFRTest_MatchesCFR(const std::string& game_name,
+                            bool alternating_updates, bool linear_averaging,
+                            bool regret_matching_plus) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  CFRSolverBase solver(*game, alternating_updates, linear_averaging,
+                       regret_matching_plus);
+  FlatCFRSolverBase flat_solver(*game, alternating_updates, linear_averaging,
+                                regret_matching_plus);
+  for (int i = 0; i < 20; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    flat_solver.EvaluateAndUpdatePolicy();
+  }
+  CheckSamePolicies(*flat_solver.CurrentPolicy(), *solver.CurrentPolicy());
+  CheckSamePolicies(*flat_solver.AveragePolicy(), *solver.AveragePolicy());
+}
+
+// Parallel iterations match the serial ones, and are deterministic.
+void FlatCFRTest_Parallel(const std::string& game_name, int num_threads) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  FlatCFRPlusSolver solver(*game);
+  FlatCFRPlusSolver parallel_solver(*game, num_threads);
+  FlatCFRPlusSolver other_parallel_solver(*game, num_threads);
+  for (int i = 0; i < 20; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    parallel_solver.EvaluateAndUpdatePolicy();
+    other_parallel_solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy =
+      parallel_solver.AveragePolicy();
+  CheckSamePolicies(*average_policy, *solver.AveragePolicy());
+  SPIEL_CHECK_TRUE(
+      static_cast<const TabularPolicy&>(*average_policy).PolicyTable() ==
+      static_cast<const TabularPolicy&>(*other_parallel_solver.AveragePolicy())
+          .PolicyTable());
+}
+
+// Compact tables converge like double ones, and the policies do not need the
+// stored legal actions.
+template <typename ValueType>
+void FlatCFRTest_CompactTables(const std::string& game_name,
+                               double tolerance) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  FlatCFRPlusSolver solver(*game);
+  FlatCFRSolverBaseT<ValueType> compact_solver(
+      *game, /*alternating_updates=*/true, /*linear_averaging=*/true,
+      /*regret_matching_plus=*/true);
+  FlatCFRSolverBaseT<ValueType> compact_solver_without_actions(
+      *game, /*alternating_updates=*/true, /*linear_averaging=*/true,
+      /*regret_matching_plus=*/true, /*num_threads=*/1,
+      /*store_legal_actions=*/false);
+  // The information state strings are the same for all three.
+  SPIEL_CHECK_LT(compact_solver_without_actions.TableBytes(),
+                 compact_solver.TableBytes());
+  SPIEL_CHECK_LT(compact_solver.TableBytes(), solver.TableBytes());
+  for (int i = 0; i < 50; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    compact_solver.EvaluateAndUpdatePolicy();
+    compact_solver_without_actions.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_FLOAT_NEAR(Exploitability(*game, *compact_solver.AveragePolicy()),
+                         Exploitability(*game, *solver.AveragePolicy()),
+                         tolerance);
+  CheckSamePolicies(*compact_solver_without_actions.AveragePolicy(),
+                    *compact_solver.AveragePolicy(), /*tolerance=*/0.0);
+}
+
+void FlatCFRTest_FixedPointKuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  FlatCFRSolverBaseT<FixedPoint32> solver(*game, /*alternating_updates=*/true,
+                                          /*linear_averaging=*/true,
+                                          /*regret_matching_plus=*/true);
+  for (int i = 0; i < 200; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.01);
+}
+
+void FlatCFRTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  FlatCFRSolver solver(*game);
+  SPIEL_CHECK_EQ(solver.NumInfoStates(), 12);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.05);
+}
+
+void FlatCFRPlusTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  FlatCFRPlusSolver solver(*game);
+  for (int i = 0; i < 200; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.01);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace algorithms = open_spiel::algorithms;
+
+int main(int argc, char** argv) {
+  algorithms::FlatCFRTest_KuhnPoker();
+  algorithms::FlatCFRPlusTest_KuhnPoker();
+  algorithms::FlatCFRTest_FixedPointKuhnPoker();
+  for (const char* game_name : {"kuhn_poker", "leduc_poker"}) {
+    // CFR, CFR+ and simultaneous-update CFR.
+    algorithms::FlatCFRTest_MatchesCFR(game_name, true, false, false);
+    algorithms::FlatCFRTest_MatchesCFR(game_name, true, true, true);
+    algorithms::FlatCFRTest_MatchesCFR(game_name, false, false, false);
+    algorithms::FlatCFRTest_Parallel(game_name, 2);
+    algorithms::FlatCFRTest_Parallel(game_name, 4);
+    algorithms::FlatCFRTest_CompactTables<float>(game_name, 1e-3);
+    algorithms::FlatCFRTest_CompactTables<algorithms::FixedPoint32>(game_name,
+                                                                    1e-2);
+  }
+}
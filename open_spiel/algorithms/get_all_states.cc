@@ -14,6 +14,20 @@
 
 #include "open_spiel/algorithms/get_all_states.h"
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
 namespace open_spiel {
 namespace algorithms {
 namespace {
@@ -60,8 +74,130 @@ void GetSubgameStates(State* state,
   }
 }
 
+// Walks the game for ForEachState.
+class StateWalker {
+ public:
+  StateWalker(const std::function<void(const State&)>& visitor,
+              int depth_limit, bool include_terminals,
+              bool include_chance_states,
+              std::function<uint64_t(const State&)> state_hash)
+      : visitor_(visitor),
+        depth_limit_(depth_limit),
+        include_terminals_(include_terminals),
+        include_chance_states_(include_chance_states),
+        state_hash_(std::move(state_hash)) {}
+
+  // Visits `state` and, if it was not walked yet (at a depth at most
+  // `depth`), returns true for its children to be walked.
+  bool Enter(const State& state, int depth) {
+    if (!state.IsTerminal() && depth_limit_ >= 0 && depth > depth_limit_) {
+      return false;
+    }
+    const uint64_t hash = state_hash_(state);
+    bool visit = false;
+    {
+      // States first reached deeper than the depth limit allows must be
+      // walked again from here, but only visited once.
+      Stripe& stripe = stripes_[hash % kNumStripes];
+      absl::MutexLock lock(&stripe.mutex);
+      auto [it, inserted] = stripe.depths.try_emplace(hash, depth);
+      if (!inserted) {
+        if (it->second <= depth) return false;
+        it->second = depth;
+      }
+      visit = inserted;
+    }
+    if (visit && (state.IsTerminal() ? include_terminals_
+                                     : !state.IsChanceNode() ||
+                                           include_chance_states_)) {
+      ++num_visited_;
+      visitor_(state);
+    }
+    return !state.IsTerminal();
+  }
+
+  // Walks the subgame of `state`, at `depth`.
+  void Walk(const State& state, int depth) {
+    if (!Enter(state, depth)) return;
+    for (Action action : state.LegalActions()) {
+      Walk(*state.Child(action), depth + 1);
+    }
+  }
+
+  int64_t NumVisited() const { return num_visited_; }
+
+ private:
+  static constexpr int kNumStripes = 64;
+
+  struct Stripe {
+    absl::Mutex mutex;
+    // The depth of each state, by hash.
+    absl::flat_hash_map<uint64_t, int> depths;
+  };
+
+  const std::function<void(const State&)>& visitor_;
+  const int depth_limit_;
+  const bool include_terminals_;
+  const bool include_chance_states_;
+  const std::function<uint64_t(const State&)> state_hash_;
+  Stripe stripes_[kNumStripes];
+  std::atomic<int64_t> num_visited_{0};
+};
+
 }  // namespace
 
+int64_t ForEachState(const Game& game,
+                     const std::function<void(const State&)>& visitor,
+                     int depth_limit, bool include_terminals,
+                     bool include_chance_states, int num_threads,
+                     std::function<uint64_t(const State&)> state_hash) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("ForEachState only supports sequential games.");
+  }
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (!state_hash) {
+    state_hash = [](const State& state) {
+      return static_cast<uint64_t>(std::hash<std::string>()(state.ToString()));
+    };
+  }
+  StateWalker walker(visitor, depth_limit, include_terminals,
+                     include_chance_states, std::move(state_hash));
+  std::unique_ptr<State> root = game.NewInitialState();
+  if (num_threads == 1) {
+    walker.Walk(*root, 0);
+    return walker.NumVisited();
+  }
+
+  // Walks the first levels breadth-first, until there are enough states to
+  // keep the threads busy.
+  std::vector<std::unique_ptr<State>> frontier;
+  frontier.push_back(std::move(root));
+  int depth = 0;
+  while (!frontier.empty() && frontier.size() < 8 * num_threads) {
+    std::vector<std::unique_ptr<State>> next_frontier;
+    for (const std::unique_ptr<State>& state : frontier) {
+      if (!walker.Enter(*state, depth)) continue;
+      for (Action action : state->LegalActions()) {
+        next_frontier.push_back(state->Child(action));
+      }
+    }
+    frontier.swap(next_frontier);
+    ++depth;
+  }
+  std::atomic<int> next_state{0};
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&walker, &frontier, &next_state, depth]() {
+      for (int i = next_state++; i < frontier.size(); i = next_state++) {
+        walker.Walk(*frontier[i], depth);
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+  return walker.NumVisited();
+}
+
 std::map<std::string, std::unique_ptr<State>> GetAllStates(
     const Game& game, int depth_limit, bool include_terminals,
     bool include_chance_states) {
@@ -15,6 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GET_ALL_STATES_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GET_ALL_STATES_H_
 
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
 
 #include "open_spiel/spiel.h"
@@ -39,6 +43,27 @@ std::map<std::string, std::unique_ptr<State>> GetAllStates(
     const Game& game, int depth_limit, bool include_terminals,
     bool include_chance_states);
 
+// Calls `visitor` once for each distinct state of the game, with the same
+// arguments as GetAllStates, and returns the number of states visited. Unlike
+// GetAllStates, the states are not kept: only a 64-bit hash of each one, and
+// the subtree of a state is only walked once, so it suits larger games.
+//
+// The states are identified by `state_hash`, by default a hash of ToString()
+// (i.e. the keys of GetAllStates). Games whose State::Hash identifies the
+// positions can pass it to avoid building the strings. A collision of two
+// hashes silently merges the states.
+//
+// With num_threads > 1, the first levels of the game are walked serially,
+// then their states are shared among the threads, which walk them with a
+// shared hash set. The visitor is then called concurrently, so it must be
+// thread-safe, and in an unspecified order.
+int64_t ForEachState(const Game& game,
+                     const std::function<void(const State&)>& visitor,
+                     int depth_limit, bool include_terminals,
+                     bool include_chance_states, int num_threads = 1,
+                     std::function<uint64_t(const State&)> state_hash =
+                         nullptr);
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
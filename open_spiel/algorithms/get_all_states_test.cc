@@ -14,16 +14,64 @@
 
 #include "open_spiel/algorithms/get_all_states.h"
 
+#include <set>
+#include <string>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace algorithms = open_spiel::algorithms;
 namespace ttt = open_spiel::tic_tac_toe;
 
+namespace {
+
+// ForEachState must visit the states of GetAllStates, each once.
+void CheckForEachStateMatchesGetAllStates(const std::string& game_name,
+                                          int depth_limit,
+                                          bool include_terminals,
+                                          bool include_chance_states) {
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame(game_name);
+  auto states = algorithms::GetAllStates(*game, depth_limit, include_terminals,
+                                         include_chance_states);
+  for (int num_threads : {1, 3}) {
+    absl::Mutex mutex;
+    std::set<std::string> visited;
+    int64_t num_visited = algorithms::ForEachState(
+        *game,
+        [&](const open_spiel::State& state) {
+          absl::MutexLock lock(&mutex);
+          SPIEL_CHECK_TRUE(visited.insert(state.ToString()).second);
+        },
+        depth_limit, include_terminals, include_chance_states, num_threads);
+    SPIEL_CHECK_EQ(num_visited, states.size());
+    SPIEL_CHECK_EQ(visited.size(), states.size());
+    for (const auto& [key, state] : states) {
+      SPIEL_CHECK_EQ(visited.count(key), 1);
+    }
+  }
+}
+
+}  // namespace
+
 int main(int argc, char **argv) {
   std::shared_ptr<const open_spiel::Game> game =
       open_spiel::LoadGame("tic_tac_toe");
   auto states = algorithms::GetAllStates(*game, -1, /*include_terminals=*/true,
                                          /*include_chance_states=*/true);
   SPIEL_CHECK_EQ(states.size(), ttt::kNumberStates);
+
+  // tic_tac_toe's State::Hash identifies the positions.
+  int64_t num_states = algorithms::ForEachState(
+      *game, [](const open_spiel::State&) {}, -1,
+      /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/1,
+      [](const open_spiel::State& state) { return state.Hash(); });
+  SPIEL_CHECK_EQ(num_states, ttt::kNumberStates);
+
+  CheckForEachStateMatchesGetAllStates("tic_tac_toe", -1, true, true);
+  CheckForEachStateMatchesGetAllStates("tic_tac_toe", 4, false, true);
+  CheckForEachStateMatchesGetAllStates("kuhn_poker", -1, true, false);
+  CheckForEachStateMatchesGetAllStates("leduc_poker", 5, true, true);
 }
@@ -14,15 +14,20 @@
 
 #include "open_spiel/algorithms/get_legal_actions_map.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace open_spiel {
 namespace algorithms {
 namespace {
 
-// Do the tree traversal to fill the map. This function does a depth-first
-// search of all the subtrees to fill the map for all the information states.
-void FillMap(const State& state,
-             std::unordered_map<std::string, std::vector<Action>>* map,
-             int depth_limit, int depth, Player player) {
+// Adds the information states of the subtree of `state` to `index`, by a
+// depth-first traversal. When `state` is `undo_state`, the traversal applies
+// and undoes the actions of turn-based nodes on it rather than copying it.
+void FillIndex(const State& state, State* undo_state, int depth_limit,
+               int depth, Player player, LegalActionsIndex* index) {
   if (state.IsTerminal()) {
     return;
   }
@@ -37,42 +42,97 @@ void FillMap(const State& state,
     // Many players can play at this node.
     for (auto p = Player{0}; p < state.NumPlayers(); ++p) {
       if (player == kInvalidPlayer || p == player) {
-        std::string info_state = state.InformationStateString(p);
-        if (map->find(info_state) == map->end()) {
-          // Only add it if we don't already have it.
-          std::vector<Action> legal_actions = state.LegalActions(p);
-          (*map)[info_state] = legal_actions;
-        }
+        index->Add(state.InformationStateString(p), state.LegalActions(p));
       }
     }
-  } else {
-    // Regular decision node.
-    if (player == kInvalidPlayer || state.CurrentPlayer() == player) {
-      std::string info_state = state.InformationStateString();
-      if (map->find(info_state) == map->end()) {
-        // Only add it if we don't already have it.
-        std::vector<Action> legal_actions = state.LegalActions();
-        (*map)[info_state] = legal_actions;
-      }
+    for (auto action : state.LegalActions()) {
+      FillIndex(*state.Child(action), undo_state, depth_limit, depth + 1,
+                player, index);
     }
+    return;
   }
 
-  // Recursively fill the map for each subtree below.
-  for (auto action : state.LegalActions()) {
-    std::unique_ptr<State> next_state = state.Child(action);
-    FillMap(*next_state, map, depth_limit, depth + 1, player);
+  // Regular decision or chance node.
+  const Player current_player = state.CurrentPlayer();
+  const std::vector<Action> legal_actions = state.LegalActions();
+  if (!state.IsChanceNode() &&
+      (player == kInvalidPlayer || current_player == player)) {
+    index->Add(state.InformationStateString(), legal_actions);
+  }
+
+  // Recursively fill the index for each subtree below.
+  for (auto action : legal_actions) {
+    if (&state == undo_state) {
+      undo_state->ApplyAction(action);
+      FillIndex(*undo_state, undo_state, depth_limit, depth + 1, player,
+                index);
+      undo_state->UndoAction(current_player, action);
+    } else {
+      FillIndex(*state.Child(action), undo_state, depth_limit, depth + 1,
+                player, index);
+    }
   }
 }
 
 }  // namespace
 
-std::unordered_map<std::string, std::vector<Action>> GetLegalActionsMap(
-    const Game& game, int depth_limit, Player player) {
+int LegalActionsIndex::InfoStateIndex(const std::string& info_state) const {
+  auto iter = indices_.find(info_state);
+  return iter == indices_.end() ? -1 : iter->second;
+}
+
+int LegalActionsIndex::Add(const std::string& info_state,
+                           absl::Span<const Action> legal_actions) {
+  auto [iter, inserted] = indices_.try_emplace(info_state, NumInfoStates());
+  if (inserted) {
+    info_states_.push_back(&iter->first);
+    legal_actions_.insert(legal_actions_.end(), legal_actions.begin(),
+                          legal_actions.end());
+    offsets_.push_back(legal_actions_.size());
+  }
+  return iter->second;
+}
+
+std::unordered_map<std::string, std::vector<Action>> LegalActionsIndex::ToMap()
+    const {
   std::unordered_map<std::string, std::vector<Action>> map;
-  std::unique_ptr<State> initial_state = game.NewInitialState();
-  FillMap(*initial_state, &map, depth_limit, 0, player);
+  map.reserve(NumInfoStates());
+  for (int i = 0; i < NumInfoStates(); ++i) {
+    absl::Span<const Action> legal_actions = LegalActions(i);
+    map.emplace(InfoState(i), std::vector<Action>(legal_actions.begin(),
+                                                  legal_actions.end()));
+  }
   return map;
 }
 
+LegalActionsIndex GetLegalActionsIndex(const Game& game, int depth_limit,
+                                       Player player) {
+  LegalActionsIndex index;
+  std::unique_ptr<State> initial_state = game.NewInitialState();
+  State* undo_state =
+      initial_state->SupportsUndoAction() ? initial_state.get() : nullptr;
+  FillIndex(*initial_state, undo_state, depth_limit, 0, player, &index);
+  return index;
+}
+
+std::unordered_map<std::string, std::vector<Action>> GetLegalActionsMap(
+    const Game& game, int depth_limit, Player player) {
+  return GetLegalActionsIndex(game, depth_limit, player).ToMap();
+}
+
+TabularPolicy GetUniformPolicy(const LegalActionsIndex& index) {
+  std::unordered_map<std::string, ActionsAndProbs> policy;
+  policy.reserve(index.NumInfoStates());
+  for (int i = 0; i < index.NumInfoStates(); ++i) {
+    absl::Span<const Action> legal_actions = index.LegalActions(i);
+    ActionsAndProbs& state_policy = policy[index.InfoState(i)];
+    state_policy.reserve(legal_actions.size());
+    for (Action action : legal_actions) {
+      state_policy.push_back({action, 1.0 / legal_actions.size()});
+    }
+  }
+  return TabularPolicy(policy);
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
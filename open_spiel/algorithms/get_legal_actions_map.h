@@ -19,11 +19,51 @@
 #include <unordered_map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
 namespace algorithms {
 
+// The legal actions of a set of information states, numbered in the order
+// they were added, with the legal actions all in one array rather than in a
+// vector each, and each information state string stored once.
+class LegalActionsIndex {
+ public:
+  int NumInfoStates() const { return info_states_.size(); }
+  const std::string& InfoState(int i) const { return *info_states_[i]; }
+  absl::Span<const Action> LegalActions(int i) const {
+    return absl::MakeConstSpan(legal_actions_)
+        .subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+  // The index of the information state, or -1 if it is not in the index.
+  int InfoStateIndex(const std::string& info_state) const;
+
+  // Adds the information state, unless it is already there, and returns its
+  // index.
+  int Add(const std::string& info_state,
+          absl::Span<const Action> legal_actions);
+
+  std::unordered_map<std::string, std::vector<Action>> ToMap() const;
+
+ private:
+  // Pointers to the keys of indices_, which do not move.
+  std::vector<const std::string*> info_states_;
+  std::vector<int> offsets_ = {0};
+  std::vector<Action> legal_actions_;
+  std::unordered_map<std::string, int> indices_;
+};
+
+// Same as GetLegalActionsMap below, as a LegalActionsIndex. The traversal
+// applies and undoes actions on a single state when the game supports it.
+LegalActionsIndex GetLegalActionsIndex(const Game& game, int depth_limit,
+                                       Player player);
+
+// The uniform random policy over the information states of `index`, e.g. as
+// given by CFRSolverBase::InfoStateLegalActions without another traversal.
+TabularPolicy GetUniformPolicy(const LegalActionsIndex& index);
+
 // Gets a map of information state (string) to vector of legal actions, by doing
 // (depth-limited) tree traversal through the game, for a specific player. To
 // do a tree traversal over the entire game, use a negative depth limit. To
@@ -15,10 +15,14 @@
 #include "open_spiel/algorithms/get_legal_actions_map.h"
 
 #include <unordered_map>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/games/goofspiel.h"
 #include "open_spiel/games/kuhn_poker.h"
 #include "open_spiel/games/leduc_poker.h"
+#include "open_spiel/policy.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace algorithms = open_spiel::algorithms;
@@ -61,6 +65,56 @@ void LeducTest() {
   SPIEL_CHECK_EQ(map_both.size(), leduc_poker::kNumInfoStates);
 }
 
+// The index holds the same legal actions as the map, once each.
+void CheckIndexMatchesMap(const open_spiel::Game& game) {
+  for (open_spiel::Player player :
+       {open_spiel::Player{open_spiel::kInvalidPlayer},
+        open_spiel::Player{0}}) {
+    algorithms::LegalActionsIndex index =
+        algorithms::GetLegalActionsIndex(game, /*depth_limit=*/-1, player);
+    LegalActionsMap map =
+        algorithms::GetLegalActionsMap(game, /*depth_limit=*/-1, player);
+    SPIEL_CHECK_EQ(index.NumInfoStates(), map.size());
+    SPIEL_CHECK_TRUE(index.ToMap() == map);
+    for (int i = 0; i < index.NumInfoStates(); ++i) {
+      SPIEL_CHECK_EQ(index.InfoStateIndex(index.InfoState(i)), i);
+      absl::Span<const open_spiel::Action> legal_actions =
+          index.LegalActions(i);
+      SPIEL_CHECK_TRUE(std::vector<open_spiel::Action>(legal_actions.begin(),
+                                                       legal_actions.end()) ==
+                       map.at(index.InfoState(i)));
+    }
+    SPIEL_CHECK_EQ(index.InfoStateIndex("not an information state"), -1);
+  }
+}
+
+void IndexTest() {
+  // Leduc supports UndoAction, Goofspiel is simultaneous.
+  CheckIndexMatchesMap(*open_spiel::LoadGame("kuhn_poker"));
+  CheckIndexMatchesMap(*open_spiel::LoadGame("leduc_poker"));
+  CheckIndexMatchesMap(*open_spiel::LoadGame("goofspiel(num_cards=3)"));
+
+  // The depth limit is the same as for the map: the first round of Kuhn.
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame("kuhn_poker");
+  SPIEL_CHECK_EQ(algorithms::GetLegalActionsIndex(*game, /*depth_limit=*/2,
+                                                  open_spiel::kInvalidPlayer)
+                     .NumInfoStates(),
+                 algorithms::GetLegalActionsMap(*game, /*depth_limit=*/2,
+                                                open_spiel::kInvalidPlayer)
+                     .size());
+
+  // A CFR solver has the same information states without a traversal.
+  algorithms::CFRSolver solver(*game);
+  SPIEL_CHECK_TRUE(solver.InfoStateLegalActions().ToMap() ==
+                   algorithms::GetLegalActionsMap(
+                       *game, /*depth_limit=*/-1, open_spiel::kInvalidPlayer));
+  open_spiel::TabularPolicy uniform =
+      algorithms::GetUniformPolicy(solver.InfoStateLegalActions());
+  SPIEL_CHECK_TRUE(uniform.PolicyTable() ==
+                   open_spiel::GetUniformPolicy(*game).PolicyTable());
+}
+
 void GoofspielTest() {
   std::shared_ptr<const open_spiel::Game> game = open_spiel::LoadGame(
       "goofspiel", {{"num_cards", open_spiel::GameParameter(3)}});
@@ -75,4 +129,5 @@ int main(int argc, char** argv) {
   KuhnTest();
   LeducTest();
   GoofspielTest();
+  IndexTest();
 }
@@ -0,0 +1,73 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/go_playout_evaluator.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/games/go.h"
+#include "open_spiel/games/go/go_board.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+std::vector<double> GoPlayoutEvaluator::Evaluate(const State& state) {
+  if (state.IsTerminal()) return state.Returns();
+  const auto* go_state = dynamic_cast<const go::GoState*>(&state);
+  SPIEL_CHECK_TRUE(go_state != nullptr);
+
+  SplitMix64 rng;
+  {
+    absl::MutexLock lock(&rng_mutex_);
+    rng = SplitMix64(rng_());
+  }
+  const go::GoBoard& board = go_state->board();
+  const int max_moves = std::max<int>(
+      go::MaxGameLength(board.board_size()) - state.History().size(), 0);
+
+  double black_value = 0;
+  for (int i = 0; i < n_playouts_; ++i) {
+    go::GoBoard playout_board = board;
+    go::PlayRandomPlayout(&playout_board, go_state->to_play(), max_moves,
+                          &rng);
+    const float score = go::TrompTaylorScore(
+        playout_board, go_state->komi(), go_state->handicap());
+    black_value += score > 0   ? go::WinUtility()
+                   : score < 0 ? go::LossUtility()
+                               : go::DrawUtility();
+  }
+  black_value /= n_playouts_;
+
+  std::vector<double> values(2);
+  values[go::ColorToPlayer(go::GoColor::kBlack)] = black_value;
+  values[go::ColorToPlayer(go::GoColor::kWhite)] = -black_value;
+  return values;
+}
+
+ActionsAndProbs GoPlayoutEvaluator::Prior(const State& state) {
+  std::vector<Action> legal_actions = state.LegalActions();
+  ActionsAndProbs prior;
+  prior.reserve(legal_actions.size());
+  for (const Action& action : legal_actions) {
+    prior.emplace_back(action, 1.0 / legal_actions.size());
+  }
+  return prior;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
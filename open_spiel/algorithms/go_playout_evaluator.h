@@ -0,0 +1,55 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GO_PLAYOUT_EVALUATOR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GO_PLAYOUT_EVALUATOR_H_
+
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// An evaluator for MCTSBot on go, valuing states by the average outcome of
+// random playouts played directly on copies of their GoBoard with
+// go::PlayRandomPlayout, without the overhead of GoState, and scored with
+// the komi and handicap of the state. The playouts never fill their own
+// eyes, so they are much shorter and more meaningful than the random games of
+// RandomRolloutEvaluator.
+class GoPlayoutEvaluator : public Evaluator {
+ public:
+  GoPlayoutEvaluator(int n_playouts, int seed)
+      : n_playouts_(n_playouts), rng_(seed) {}
+
+  // `state` must be a go::GoState.
+  std::vector<double> Evaluate(const State& state) override;
+
+  // Returns equal probability for each action.
+  ActionsAndProbs Prior(const State& state) override;
+
+ private:
+  int n_playouts_;
+  absl::Mutex rng_mutex_;
+  SplitMix64 rng_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GO_PLAYOUT_EVALUATOR_H_
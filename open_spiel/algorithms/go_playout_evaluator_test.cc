@@ -0,0 +1,76 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/go_playout_evaluator.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+std::shared_ptr<const Game> LoadGo(int board_size) {
+  return LoadGame("go", {{"board_size", GameParameter(board_size)},
+                         {"komi", GameParameter(0.5)}});
+}
+
+void EvaluatesInitialState() {
+  std::shared_ptr<const Game> game = LoadGo(9);
+  std::unique_ptr<State> state = game->NewInitialState();
+  GoPlayoutEvaluator evaluator(/*n_playouts=*/20, /*seed=*/0);
+  std::vector<double> values = evaluator.Evaluate(*state);
+  SPIEL_CHECK_EQ(values.size(), 2);
+  SPIEL_CHECK_GE(values[0], -1);
+  SPIEL_CHECK_LE(values[0], 1);
+  SPIEL_CHECK_FLOAT_EQ(values[0], -values[1]);
+  SPIEL_CHECK_EQ(evaluator.Prior(*state).size(), 9 * 9 + 1);
+}
+
+void TerminalStatesAreValuedByTheirReturns() {
+  std::shared_ptr<const Game> game = LoadGo(5);
+  std::unique_ptr<State> state = game->NewInitialState();
+  const Action pass = 5 * 5;
+  state->ApplyAction(pass);
+  state->ApplyAction(pass);
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  GoPlayoutEvaluator evaluator(/*n_playouts=*/1, /*seed=*/0);
+  SPIEL_CHECK_EQ(evaluator.Evaluate(*state), state->Returns());
+}
+
+void MCTSPlaysWithPlayouts() {
+  std::shared_ptr<const Game> game = LoadGo(5);
+  GoPlayoutEvaluator evaluator(/*n_playouts=*/2, /*seed=*/0);
+  MCTSBot bot(*game, &evaluator, /*uct_c=*/2, /*max_simulations=*/50,
+              /*max_memory_mb=*/10, /*solve=*/true, /*seed=*/0,
+              /*verbose=*/false);
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (int i = 0; i < 4 && !state->IsTerminal(); ++i) {
+    state->ApplyAction(bot.Step(*state));
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::EvaluatesInitialState();
+  open_spiel::algorithms::TerminalStatesAreValuedByTheirReturns();
+  open_spiel::algorithms::MCTSPlaysWithPlayouts();
+}
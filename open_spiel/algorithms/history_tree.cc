@@ -16,10 +16,15 @@
 
 #include <cmath>
 #include <limits>
+#include <string>
 #include <unordered_set>
+#include <utility>
 
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/profiler.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -161,6 +166,103 @@ HistoryTree::HistoryTree(std::unique_ptr<State> state, Player player_id) {
       RecursivelyBuildGameTree(std::move(state), player_id, &state_to_node_);
 }
 
+CompactHistoryTree::CompactHistoryTree(const State& root)
+    : root_(root.Clone()),
+      root_history_(root.ToString()),
+      num_players_(root.NumPlayers()) {
+  OPEN_SPIEL_PROFILE_SCOPE("history_tree/CompactHistoryTree");
+  nodes_.emplace_back();
+  AddSubtree(root, Root());
+}
+
+void CompactHistoryTree::AddSubtree(const State& state, int index) {
+  nodes_[index].type = state.GetType();
+  nodes_[index].player = state.CurrentPlayer();
+  ActionsAndProbs children;
+  switch (nodes_[index].type) {
+    case StateType::kChance: {
+      children = state.ChanceOutcomes();
+      double probability_sum = 0;
+      for (const auto& [outcome, prob] : children) {
+        SPIEL_CHECK_PROB(prob);
+        probability_sum += prob;
+      }
+      SPIEL_CHECK_FLOAT_EQ(probability_sum, 1.0);
+      break;
+    }
+    case StateType::kDecision: {
+      const Player player = state.CurrentPlayer();
+      std::string info_state =
+          OPEN_SPIEL_PROFILE("history_tree/InformationStateString",
+                             state.InformationStateString(player));
+      auto [it, inserted] = info_state_indices_.try_emplace(
+          std::move(info_state), info_state_strings_.size());
+      if (inserted) {
+        info_state_strings_.push_back(it->first);
+        info_state_states_.push_back(
+            OPEN_SPIEL_PROFILE("history_tree/Clone", state.Clone()));
+        info_state_nodes_.emplace_back();
+      }
+      nodes_[index].info_state = it->second;
+      info_state_nodes_[it->second].push_back(index);
+      // The probabilities are counterfactual ones, or come from the policy.
+      for (Action action :
+           OPEN_SPIEL_PROFILE("history_tree/LegalActions",
+                              state.LegalActions())) {
+        children.push_back({action, 1.});
+      }
+      break;
+    }
+    case StateType::kTerminal: {
+      nodes_[index].first_child = returns_.size();
+      for (double player_return : state.Returns()) {
+        returns_.push_back(player_return);
+      }
+      return;
+    }
+  }
+  absl::c_sort(children);
+  const int first_child = nodes_.size();
+  nodes_[index].first_child = first_child;
+  nodes_[index].num_children = children.size();
+  nodes_.resize(first_child + children.size());
+  for (int i = 0; i < children.size(); ++i) {
+    nodes_[first_child + i].action = children[i].first;
+    nodes_[first_child + i].probability = children[i].second;
+    nodes_[first_child + i].parent = index;
+  }
+  for (int i = 0; i < children.size(); ++i) {
+    AddSubtree(*OPEN_SPIEL_PROFILE("history_tree/Child",
+                                   state.Child(children[i].first)),
+               first_child + i);
+  }
+}
+
+int CompactHistoryTree::InfoStateIndex(const std::string& info_state) const {
+  auto it = info_state_indices_.find(info_state);
+  return it == info_state_indices_.end() ? -1 : it->second;
+}
+
+int CompactHistoryTree::NodeIndex(const std::string& history) {
+  if (history == root_history_) return Root();
+  if (history_indices_.empty()) IndexHistories(*root_, Root());
+  auto it = history_indices_.find(history);
+  if (it == history_indices_.end()) {
+    SpielFatalError(absl::StrCat("Node not found for history: '", history,
+                                 "'"));
+  }
+  return it->second;
+}
+
+void CompactHistoryTree::IndexHistories(const State& state, int index) {
+  history_indices_[state.ToString()] = index;
+  const Node& node = nodes_[index];
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
+    IndexHistories(*state.Child(nodes_[child].action), child);
+  }
+}
+
 ActionsAndProbs GetSuccessorsWithProbs(const State& state,
                                        Player best_responder,
                                        const Policy* policy) {
@@ -17,8 +17,11 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -95,6 +98,86 @@ class HistoryTree {
   std::unordered_map<std::string, HistoryNode*> state_to_node_;
 };
 
+// A compact version of HistoryTree for larger games, which keeps no state or
+// string per node: the nodes are stored in a vector and addressed by index,
+// with the children of each node in a contiguous range sorted by action, and
+// the information states of the decision nodes are numbered. Only the root
+// state and a state of each information state (for policies that need a
+// state) are kept.
+//
+// Unlike HistoryTree, it does not depend on a player: the terminal nodes have
+// the returns of all the players, so that a single tree can be shared by the
+// best responses of all of them.
+class CompactHistoryTree {
+ public:
+  struct Node {
+    StateType type;
+    Player player;  // The current player.
+    // The index of the information state of the player to move, for decision
+    // nodes, or -1.
+    int info_state = -1;
+    // The index of the first child, or for terminal nodes, of their returns.
+    int first_child = 0;
+    int num_children = 0;
+    int parent = -1;  // The index of the parent, -1 for the root.
+    Action action = kInvalidAction;  // The action leading to this node.
+    // The probability of that action if it is a chance outcome, or 1.
+    double probability = 1;
+  };
+
+  explicit CompactHistoryTree(const State& root);
+
+  int Root() const { return 0; }
+  const Node& GetNode(int index) const { return nodes_[index]; }
+  int NumNodes() const { return nodes_.size(); }
+  int NumPlayers() const { return num_players_; }
+
+  // Returns the return of `player` at the terminal node at `index`.
+  double PlayerReturn(int index, Player player) const {
+    return returns_[nodes_[index].first_child + player];
+  }
+
+  int NumInfoStates() const { return info_state_strings_.size(); }
+  const std::string& InfoStateString(int info_state) const {
+    return info_state_strings_[info_state];
+  }
+  Player InfoStatePlayer(int info_state) const {
+    return info_state_states_[info_state]->CurrentPlayer();
+  }
+  // Returns one of the states of an information state.
+  const State& InfoStateState(int info_state) const {
+    return *info_state_states_[info_state];
+  }
+  // Returns the indices of the nodes of an information state, increasing.
+  const std::vector<int>& InfoStateNodes(int info_state) const {
+    return info_state_nodes_[info_state];
+  }
+  // Returns the index of an information state, or -1 if it is not in the tree.
+  int InfoStateIndex(const std::string& info_state) const;
+
+  // Returns the index of the node of a history, as given by State::ToString.
+  // The first call for another history than the root's indexes all of them,
+  // which replays the whole game tree, so it must not be called concurrently.
+  int NodeIndex(const std::string& history);
+
+ private:
+  // Fills in the node at `index` for `state`, and adds its subtree.
+  void AddSubtree(const State& state, int index);
+  void IndexHistories(const State& state, int index);
+
+  std::unique_ptr<State> root_;
+  std::string root_history_;
+  int num_players_;
+  std::vector<Node> nodes_;
+  // The returns of the terminal nodes, for each player.
+  std::vector<double> returns_;
+  std::vector<std::string> info_state_strings_;
+  std::vector<std::unique_ptr<State>> info_state_states_;
+  std::vector<std::vector<int>> info_state_nodes_;
+  std::unordered_map<std::string, int> info_state_indices_;
+  std::unordered_map<std::string, int> history_indices_;
+};
+
 // Returns a map of infostate strings to a vector of history nodes with
 // corresponding counter-factual probabilities, where counter-factual
 // probabilities are calculatd using the passed policy for the opponent's
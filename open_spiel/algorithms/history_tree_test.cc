@@ -17,8 +17,10 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <string>
 #include <unordered_set>
 
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
 #include "open_spiel/algorithms/minimax.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/goofspiel.h"
@@ -128,6 +130,58 @@ void TestGameTree() {
   }
 }
 
+// The compact tree has the same nodes as the HistoryTree.
+void TestCompactHistoryTree() {
+  for (const char* game_name : {"kuhn_poker", "leduc_poker"}) {
+    std::shared_ptr<const Game> game = LoadGame(game_name);
+    CompactHistoryTree compact_tree(*game->NewInitialState());
+    for (Player player_id : {Player{0}, Player{1}}) {
+      HistoryTree tree(game->NewInitialState(), player_id);
+      SPIEL_CHECK_EQ(compact_tree.NumNodes(), tree.NumHistories());
+      for (const std::string& history : tree.GetHistories()) {
+        HistoryNode* node = tree.GetByHistory(history);
+        const CompactHistoryTree::Node& compact_node =
+            compact_tree.GetNode(compact_tree.NodeIndex(history));
+        SPIEL_CHECK_EQ(compact_node.type, node->GetType());
+        SPIEL_CHECK_EQ(compact_node.player, node->GetState()->CurrentPlayer());
+        SPIEL_CHECK_EQ(compact_node.num_children, node->NumChildren());
+        std::vector<Action> child_actions = node->GetChildActions();
+        for (int i = 0; i < compact_node.num_children; ++i) {
+          const CompactHistoryTree::Node& child =
+              compact_tree.GetNode(compact_node.first_child + i);
+          SPIEL_CHECK_EQ(child.action, child_actions[i]);
+          SPIEL_CHECK_EQ(child.probability,
+                         node->GetChild(child_actions[i]).first);
+          SPIEL_CHECK_EQ(child.parent, compact_tree.NodeIndex(history));
+        }
+        if (compact_node.type == StateType::kTerminal) {
+          SPIEL_CHECK_EQ(compact_tree.PlayerReturn(
+                             compact_tree.NodeIndex(history), player_id),
+                         node->GetValue());
+        }
+        if (compact_node.type == StateType::kDecision) {
+          SPIEL_CHECK_EQ(
+              compact_tree.InfoStateString(compact_node.info_state),
+              node->GetInfoState());
+          SPIEL_CHECK_EQ(compact_tree.InfoStateIndex(node->GetInfoState()),
+                         compact_node.info_state);
+          SPIEL_CHECK_EQ(compact_tree.InfoStatePlayer(compact_node.info_state),
+                         compact_node.player);
+          SPIEL_CHECK_EQ(compact_tree.InfoStateState(compact_node.info_state)
+                             .InformationStateString(),
+                         node->GetInfoState());
+          const std::vector<int>& info_state_nodes =
+              compact_tree.InfoStateNodes(compact_node.info_state);
+          SPIEL_CHECK_TRUE(absl::c_binary_search(
+              info_state_nodes, compact_tree.NodeIndex(history)));
+        } else {
+          SPIEL_CHECK_EQ(compact_node.info_state, -1);
+        }
+      }
+    }
+  }
+}
+
 void TestInfoSetsHaveRightNumberOfGameStates() {
   std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
   std::unique_ptr<State> state = game->NewInitialState();
@@ -453,6 +507,7 @@ void TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid1() {
 
 int main(int argc, char** argv) {
   open_spiel::algorithms::TestGameTree();
+  open_spiel::algorithms::TestCompactHistoryTree();
   open_spiel::algorithms::TestInfoSetsHaveRightNumberOfGameStates();
   open_spiel::algorithms::TestGetAllInfoSetsMatchesInfoStates();
   open_spiel::algorithms::TestHistoryTreeIsSubsetOfGetAllInfoSets();
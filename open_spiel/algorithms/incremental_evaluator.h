@@ -0,0 +1,59 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_INCREMENTAL_EVALUATOR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_INCREMENTAL_EVALUATOR_H_
+
+#include <memory>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A heuristic value function that keeps its own summary of the position,
+// updated as a search applies and undoes actions, instead of recomputing it
+// from the whole state at every leaf: material and mobility counters, or the
+// accumulators of an NNUE-style network.
+//
+// A search calls Reset at its root, then ApplyAction before each action it
+// applies to the state, and UndoAction after each one it undoes, in stack
+// order, so that the evaluator always describes the state it is given.
+// Evaluate is only called on non-terminal states. Each search thread works on
+// its own Clone.
+class IncrementalEvaluator {
+ public:
+  virtual ~IncrementalEvaluator() = default;
+
+  // Returns a copy for another thread, in the same position.
+  virtual std::unique_ptr<IncrementalEvaluator> Clone() const = 0;
+
+  // Sets up the summary of `state`, from scratch.
+  virtual void Reset(const State& state) = 0;
+
+  // Called with the state before `action` is applied to it.
+  virtual void ApplyAction(const State& state, Action action) = 0;
+
+  // Called with the state after `action`, taken by `player`, was undone.
+  virtual void UndoAction(const State& state, Player player,
+                          Action action) = 0;
+
+  // The value of `state` for `player`, in the range of the game's utilities.
+  virtual double Evaluate(const State& state, Player player) const = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_INCREMENTAL_EVALUATOR_H_
@@ -0,0 +1,227 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/is_mcts.h"
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+double ISMCTSChild::UCTValue(double uct_c) const {
+  if (explore_count == 0) return std::numeric_limits<double>::infinity();
+  return total_reward / explore_count +
+         uct_c * std::sqrt(std::log(availability_count) / explore_count);
+}
+
+int ISMCTSNode::FindOrAddChild(Action action) {
+  for (int i = 0; i < children.size(); ++i) {
+    if (children[i].action == action) return i;
+  }
+  children.push_back({action});
+  return children.size() - 1;
+}
+
+ISMCTSBot::ISMCTSBot(const Game& game, Evaluator* evaluator, double uct_c,
+                     int max_simulations, int seed, ISMCTSVariant variant,
+                     ISMCTSFinalPolicyType final_policy_type,
+                     int max_world_samples, bool use_observation_string)
+    : evaluator_(evaluator),
+      uct_c_(uct_c),
+      max_simulations_(max_simulations),
+      variant_(variant),
+      final_policy_type_(final_policy_type),
+      max_world_samples_(max_world_samples),
+      use_observation_string_(use_observation_string),
+      perfect_information_(game.GetType().information ==
+                           GameType::Information::kPerfectInformation),
+      rng_(seed) {
+  const GameType& type = game.GetType();
+  if (type.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("IS-MCTS requires sequential games.");
+  }
+  if (use_observation_string ? !type.provides_observation_string
+                             : !type.provides_information_state_string) {
+    SpielFatalError(absl::StrCat(
+        "IS-MCTS keys its nodes by ",
+        use_observation_string ? "observation" : "information state",
+        " strings, which the game does not provide."));
+  }
+  SPIEL_CHECK_GT(max_simulations, 0);
+  SPIEL_CHECK_TRUE(max_world_samples == kUnlimitedNumWorldSamples ||
+                   max_world_samples > 0);
+}
+
+std::unique_ptr<State> ISMCTSBot::SampleWorld(const State& state,
+                                              Player player) {
+  if (perfect_information_) return state.Clone();
+  return state.ResampleFromInfostate(player,
+                                     [this] { return UniformDouble(rng_); });
+}
+
+uint64_t ISMCTSBot::NodeKey(const State& state, Player root_player) const {
+  const Player player = state.CurrentPlayer();
+  const Player observer =
+      variant_ == ISMCTSVariant::kMultiObserver ? player : root_player;
+  const std::string view = use_observation_string_
+                               ? state.ObservationString(observer)
+                               : state.InformationStateString(observer);
+  // The acting player is part of the key, as the nodes of different players
+  // may have the same view.
+  return HashMix(HashMix(std::hash<std::string>()(view)) ^ player);
+}
+
+int ISMCTSBot::SelectChild(ISMCTSNode* node,
+                           const std::vector<Action>& legal_actions) {
+  // The unexplored actions first, uniformly at random, then the best by UCT.
+  int chosen = -1;
+  int num_unexplored = 0;
+  double best_value = -std::numeric_limits<double>::infinity();
+  for (Action action : legal_actions) {
+    const int index = node->FindOrAddChild(action);
+    ISMCTSChild& child = node->children[index];
+    ++child.availability_count;
+    if (child.explore_count == 0) {
+      if (UniformInt(rng_, ++num_unexplored) == 0) chosen = index;
+    } else if (num_unexplored == 0) {
+      const double value = child.UCTValue(uct_c_);
+      if (value > best_value) {
+        best_value = value;
+        chosen = index;
+      }
+    }
+  }
+  SPIEL_CHECK_GE(chosen, 0);
+  return chosen;
+}
+
+void ISMCTSBot::Simulate(std::unique_ptr<State> state, Player root_player) {
+  visit_path_.clear();
+  std::vector<double> returns;
+  while (true) {
+    if (state->IsTerminal()) {
+      returns = state->Returns();
+      break;
+    }
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(rng_).first);
+      continue;
+    }
+    auto [it, inserted] = nodes_.try_emplace(NodeKey(*state, root_player));
+    ISMCTSNode& node = it->second;
+    if (inserted) {
+      // A new leaf, which is evaluated rather than explored further.
+      node.player = state->CurrentPlayer();
+      returns = evaluator_->Evaluate(*state);
+      break;
+    }
+    const int index = SelectChild(&node, state->LegalActions());
+    visit_path_.push_back({&node, index});
+    state->ApplyAction(node.children[index].action);
+  }
+  for (const auto& [node, index] : visit_path_) {
+    ISMCTSChild& child = node->children[index];
+    ++child.explore_count;
+    child.total_reward += returns[node->player];
+  }
+}
+
+ActionsAndProbs ISMCTSBot::FinalPolicy(const State& state,
+                                       const ISMCTSNode& root) const {
+  const std::vector<Action> legal_actions = state.LegalActions();
+  std::vector<const ISMCTSChild*> children(legal_actions.size(), nullptr);
+  int total_explore_count = 0;
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    for (const ISMCTSChild& child : root.children) {
+      if (child.action == legal_actions[i]) {
+        children[i] = &child;
+        total_explore_count += child.explore_count;
+      }
+    }
+  }
+  ActionsAndProbs policy;
+  policy.reserve(legal_actions.size());
+  if (total_explore_count == 0) {
+    // With a single simulation, the root is a leaf.
+    for (Action action : legal_actions) {
+      policy.push_back({action, 1.0 / legal_actions.size()});
+    }
+    return policy;
+  }
+  if (final_policy_type_ == ISMCTSFinalPolicyType::kNormalizedVisitCount) {
+    for (int i = 0; i < legal_actions.size(); ++i) {
+      const int count = children[i] ? children[i]->explore_count : 0;
+      policy.push_back(
+          {legal_actions[i], static_cast<double>(count) / total_explore_count});
+    }
+    return policy;
+  }
+  int best = 0;
+  double best_value = -std::numeric_limits<double>::infinity();
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    if (!children[i] || children[i]->explore_count == 0) continue;
+    const double value =
+        final_policy_type_ == ISMCTSFinalPolicyType::kMaxVisitCount
+            ? children[i]->explore_count
+            : children[i]->total_reward / children[i]->explore_count;
+    if (value > best_value) {
+      best_value = value;
+      best = i;
+    }
+  }
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    policy.push_back({legal_actions[i], i == best ? 1.0 : 0.0});
+  }
+  return policy;
+}
+
+ActionsAndProbs ISMCTSBot::RunSearch(const State& state) {
+  SPIEL_CHECK_FALSE(state.IsTerminal());
+  SPIEL_CHECK_FALSE(state.IsChanceNode());
+  const Player player = state.CurrentPlayer();
+  nodes_.clear();
+  std::vector<std::unique_ptr<State>> worlds;
+  for (int i = 0; i < max_world_samples_; ++i) {
+    worlds.push_back(SampleWorld(state, player));
+  }
+  for (int i = 0; i < max_simulations_; ++i) {
+    Simulate(worlds.empty() ? SampleWorld(state, player)
+                            : worlds[i % worlds.size()]->Clone(),
+             player);
+  }
+  const auto it = nodes_.find(NodeKey(state, player));
+  SPIEL_CHECK_TRUE(it != nodes_.end());
+  return FinalPolicy(state, it->second);
+}
+
+std::pair<ActionsAndProbs, Action> ISMCTSBot::StepWithPolicy(
+    const State& state) {
+  ActionsAndProbs policy = RunSearch(state);
+  const Action action = SampleAction(policy, UniformDouble(rng_)).first;
+  return {std::move(policy), action};
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,182 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_IS_MCTS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_IS_MCTS_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/node_hash_map.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+
+// Information Set Monte Carlo Tree Search (IS-MCTS).
+//
+// MCTSBot searches the tree of histories from the actual state, which in an
+// imperfect-information game the searching player does not know. IS-MCTS
+// instead searches a tree of information states: each simulation starts from
+// a state sampled by State::ResampleFromInfostate from the searching player's
+// information state (a determinization), and the nodes it goes through are
+// found by the hash of the acting player's information state, or of their
+// observation with use_observation_string, so that all the determinizations
+// share their statistics. At a leaf, a new node is added and the evaluator
+// is called on the determinized state.
+//
+// The actions legal at a node vary between determinizations, e.g. the cards
+// an opponent may play. Each child is selected with the UCT formula
+// `Q/N + c * sqrt(log(A) / N)`, where A is the number of times the child was
+// legal when its node was visited rather than the node's visit count, as in
+// the subset-armed bandits of Cowling et al.
+//
+// There are two variants:
+// - kSingleObserver (SO-ISMCTS): all the nodes are keyed by the searching
+//   player's view of the state, so that the other players choose their
+//   actions from what the searching player knows.
+// - kMultiObserver (MO-ISMCTS): the nodes where a player acts are keyed by
+//   that player's own view of the state, as with one tree per player, so that
+//   each player chooses their actions from what they know. This models the
+//   hidden information of the other players better, but shares fewer
+//   statistics.
+//
+// The final policy at the root is either the normalized visit counts of its
+// children, or all on the most visited, or all on the best valued child. Step
+// samples its action from that policy. The tree is built again at each step.
+//
+// With max_world_samples > 0, that many determinizations are sampled at the
+// start of a search and the simulations cycle through them, which saves the
+// cost of ResampleFromInfostate in games where it is slow.
+//
+// The nodes are keyed by 64-bit hashes of the information state strings, so
+// distinct information states could share a node if their hashes collided,
+// which is vanishingly unlikely.
+//
+// References:
+// - Cowling, Powley, and Whitehouse, Information Set Monte Carlo Tree Search,
+//   2012. https://eprints.whiterose.ac.uk/75048/1/CowlingPowleyWhitehouse2012.pdf
+
+namespace open_spiel {
+namespace algorithms {
+
+enum class ISMCTSVariant {
+  kSingleObserver,
+  kMultiObserver,
+};
+
+enum class ISMCTSFinalPolicyType {
+  kNormalizedVisitCount,
+  kMaxVisitCount,
+  kMaxValue,
+};
+
+// The statistics of an action at an information state.
+struct ISMCTSChild {
+  Action action = kInvalidAction;
+  int explore_count = 0;       // Number of times this action was explored.
+  int availability_count = 0;  // Number of visits where it was legal.
+  double total_reward = 0;     // Total reward of the acting player after it.
+
+  double UCTValue(double uct_c) const;
+};
+
+// A node of the search tree: an information state of the acting player.
+struct ISMCTSNode {
+  Player player = kInvalidPlayer;     // The acting player.
+  std::vector<ISMCTSChild> children;  // The actions seen legal here.
+
+  // Returns the index of the child of `action`, adding it if it was never
+  // seen legal.
+  int FindOrAddChild(Action action);
+};
+
+// A SpielBot that uses the IS-MCTS algorithm as its policy. The game must be
+// sequential, and implement ResampleFromInfostate if it has imperfect
+// information.
+class ISMCTSBot : public Bot {
+ public:
+  // The value of max_world_samples for which each simulation samples its own
+  // determinization.
+  static inline constexpr int kUnlimitedNumWorldSamples = -1;
+
+  ISMCTSBot(const Game& game, Evaluator* evaluator, double uct_c,
+            int max_simulations, int seed,
+            ISMCTSVariant variant = ISMCTSVariant::kSingleObserver,
+            ISMCTSFinalPolicyType final_policy_type =
+                ISMCTSFinalPolicyType::kNormalizedVisitCount,
+            int max_world_samples = kUnlimitedNumWorldSamples,
+            bool use_observation_string = false);
+
+  void Restart() override {}
+  void RestartAt(const State& state) override {}
+  Action Step(const State& state) override {
+    return StepWithPolicy(state).second;
+  }
+  bool ProvidesPolicy() override { return true; }
+  ActionsAndProbs GetPolicy(const State& state) override {
+    return RunSearch(state);
+  }
+  std::pair<ActionsAndProbs, Action> StepWithPolicy(
+      const State& state) override;
+
+  // Runs the search from the current player's information state in `state`,
+  // and returns the final policy of its root.
+  ActionsAndProbs RunSearch(const State& state);
+
+  // The number of nodes of the last search.
+  int NumNodes() const { return nodes_.size(); }
+
+ private:
+  // Returns a state sampled from the information state of `player` in
+  // `state`, or a clone of it in perfect-information games.
+  std::unique_ptr<State> SampleWorld(const State& state, Player player);
+
+  // Returns the key of the node of `state`, a decision node, for a search by
+  // `root_player`.
+  uint64_t NodeKey(const State& state, Player root_player) const;
+
+  // Runs a simulation from a determinization of the root, and backs it up.
+  void Simulate(std::unique_ptr<State> state, Player root_player);
+
+  // Returns the index of the child of `node` to explore among the
+  // `legal_actions`, after counting them as available.
+  int SelectChild(ISMCTSNode* node, const std::vector<Action>& legal_actions);
+
+  ActionsAndProbs FinalPolicy(const State& state, const ISMCTSNode& root) const;
+
+  Evaluator* evaluator_;
+  const double uct_c_;
+  const int max_simulations_;
+  const ISMCTSVariant variant_;
+  const ISMCTSFinalPolicyType final_policy_type_;
+  const int max_world_samples_;
+  const bool use_observation_string_;
+  const bool perfect_information_;
+  Xoshiro256PlusPlus rng_;
+
+  // The nodes of the last search, by key.
+  absl::node_hash_map<uint64_t, ISMCTSNode> nodes_;
+  // The nodes visited by a simulation, with the index of the child explored.
+  // A node may be visited twice if its key repeats, e.g. an observation.
+  std::vector<std::pair<ISMCTSNode*, int>> visit_path_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_IS_MCTS_H_
@@ -0,0 +1,139 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/is_mcts.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/algorithms/evaluate_bots.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kUCTC = 2;
+
+void CheckPolicy(const State& state, const ActionsAndProbs& policy) {
+  SPIEL_CHECK_EQ(policy.size(), state.LegalActions().size());
+  double total = 0;
+  for (const auto& [action, prob] : policy) {
+    SPIEL_CHECK_TRUE(absl::c_linear_search(state.LegalActions(), action));
+    SPIEL_CHECK_GE(prob, 0);
+    total += prob;
+  }
+  SPIEL_CHECK_FLOAT_EQ(total, 1.0);
+}
+
+void PlaysGames(const std::string& game_string, ISMCTSVariant variant,
+                ISMCTSFinalPolicyType final_policy_type,
+                int max_world_samples) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  RandomRolloutEvaluator evaluator(/*n_rollouts=*/2, /*seed=*/1);
+  ISMCTSBot bot(*game, &evaluator, kUCTC, /*max_simulations=*/100,
+                /*seed=*/2, variant, final_policy_type, max_world_samples);
+  for (int i = 0; i < 3; ++i) {
+    std::mt19937 rng(i);
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(state->SampleChanceOutcome(rng).first);
+        continue;
+      }
+      auto [policy, action] = bot.StepWithPolicy(*state);
+      CheckPolicy(*state, policy);
+      SPIEL_CHECK_TRUE(absl::c_linear_search(state->LegalActions(), action));
+      state->ApplyAction(action);
+    }
+  }
+}
+
+void PlaysImperfectInformationGames() {
+  for (ISMCTSVariant variant :
+       {ISMCTSVariant::kSingleObserver, ISMCTSVariant::kMultiObserver}) {
+    for (ISMCTSFinalPolicyType final_policy_type :
+         {ISMCTSFinalPolicyType::kNormalizedVisitCount,
+          ISMCTSFinalPolicyType::kMaxVisitCount,
+          ISMCTSFinalPolicyType::kMaxValue}) {
+      PlaysGames("kuhn_poker", variant, final_policy_type,
+                 ISMCTSBot::kUnlimitedNumWorldSamples);
+      PlaysGames("leduc_poker", variant, final_policy_type,
+                 /*max_world_samples=*/5);
+    }
+  }
+  PlaysGames("kuhn_poker(players=3)", ISMCTSVariant::kMultiObserver,
+             ISMCTSFinalPolicyType::kNormalizedVisitCount,
+             ISMCTSBot::kUnlimitedNumWorldSamples);
+  PlaysGames("tic_tac_toe", ISMCTSVariant::kSingleObserver,
+             ISMCTSFinalPolicyType::kMaxVisitCount,
+             ISMCTSBot::kUnlimitedNumWorldSamples);
+}
+
+// The search only depends on the information state of the searching player:
+// the policy is the same whatever the opponent's card.
+void DoesNotSeeHiddenInformation() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  std::vector<ActionsAndProbs> policies;
+  for (Action opponent_card : {1, 2, 3}) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    state->ApplyAction(0);
+    state->ApplyAction(opponent_card);
+    for (ISMCTSVariant variant :
+         {ISMCTSVariant::kSingleObserver, ISMCTSVariant::kMultiObserver}) {
+      RandomRolloutEvaluator evaluator(/*n_rollouts=*/1, /*seed=*/1);
+      ISMCTSBot bot(*game, &evaluator, kUCTC, /*max_simulations=*/50,
+                    /*seed=*/3, variant);
+      policies.push_back(bot.GetPolicy(*state));
+    }
+  }
+  for (int i = 2; i < policies.size(); ++i) {
+    SPIEL_CHECK_TRUE(policies[i] == policies[i % 2]);
+  }
+}
+
+// Beats a random player at Kuhn poker, on average over both seats.
+void BeatsRandomAtKuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  RandomRolloutEvaluator evaluator(/*n_rollouts=*/5, /*seed=*/1);
+  ISMCTSBot bot(*game, &evaluator, kUCTC, /*max_simulations=*/200,
+                /*seed=*/4);
+  constexpr int kNumGames = 200;
+  double total = 0;
+  for (int i = 0; i < kNumGames; ++i) {
+    const Player seat = i % 2;
+    std::unique_ptr<Bot> random_bot = MakeUniformRandomBot(1 - seat, i);
+    std::vector<Bot*> bots = {&bot, random_bot.get()};
+    if (seat == 1) std::swap(bots[0], bots[1]);
+    total += EvaluateBots(game->NewInitialState().get(), bots, i)[seat];
+  }
+  SPIEL_CHECK_GT(total / kNumGames, 0.1);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::PlaysImperfectInformationGames();
+  open_spiel::algorithms::DoesNotSeeHiddenInformation();
+  open_spiel::algorithms::BeatsRandomAtKuhnPoker();
+}
@@ -0,0 +1,36 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mapped_tabular_policy.h"
+
+#include <string>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+void SaveDenseTabularPolicy(const DenseTabularPolicy& policy,
+                            const std::string& filename) {
+  file::File file(filename, "wb");
+  SPIEL_CHECK_TRUE(file.Write(policy.Serialize()));
+}
+
+MappedTabularPolicy::MappedTabularPolicy(const std::string& filename)
+    : file_(filename), view_(file_.Contents()) {}
+
+}  // namespace algorithms
+}  // namespace open_spiel
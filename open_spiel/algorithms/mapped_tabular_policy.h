@@ -0,0 +1,67 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MAPPED_TABULAR_POLICY_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MAPPED_TABULAR_POLICY_H_
+
+#include <string>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Writes a policy to a file that MappedTabularPolicy can serve, in the format
+// of DenseTabularPolicy::Serialize: the information states are sorted, so
+// they are found by binary search without building a table.
+void SaveDenseTabularPolicy(const DenseTabularPolicy& policy,
+                            const std::string& filename);
+
+// A large tabular policy, e.g. a CFR average policy for poker, served from a
+// file saved by SaveDenseTabularPolicy without loading it: the file is memory
+// mapped and read in place, so the policy is ready in constant time, its
+// pages are read from disk as they are first used, and the bot processes
+// serving the same file share them in the page cache. The file must not be
+// changed while it is mapped.
+class MappedTabularPolicy : public Policy {
+ public:
+  explicit MappedTabularPolicy(const std::string& filename);
+
+  // The view points into the mapping, so the policy is neither copied nor
+  // moved.
+  MappedTabularPolicy(const MappedTabularPolicy&) = delete;
+  MappedTabularPolicy& operator=(const MappedTabularPolicy&) = delete;
+
+  const DenseTabularPolicyView& View() const { return view_; }
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override {
+    return view_.GetStatePolicy(info_state);
+  }
+  void GetStatePolicies(absl::Span<const State* const> states,
+                        absl::Span<ActionsAndProbs> policies) const override {
+    view_.GetStatePolicies(states, policies);
+  }
+
+ private:
+  file::MappedFile file_;
+  DenseTabularPolicyView view_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MAPPED_TABULAR_POLICY_H_
@@ -0,0 +1,79 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mapped_tabular_policy.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void MappedTabularPolicyTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  const TabularPolicy policy = GetRandomPolicy(*game);
+  const DenseTabularPolicy dense(policy);
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string path = absl::StrCat(
+      tmp_dir ? tmp_dir : "/tmp", "/open_spiel-mapped-tabular-policy-test.bin");
+  SaveDenseTabularPolicy(dense, path);
+  {
+    const MappedTabularPolicy mapped(path);
+    const DenseTabularPolicyView& view = mapped.View();
+    SPIEL_CHECK_EQ(view.NumInfoStates(), dense.NumInfoStates());
+    for (const auto& [info_state, state_policy] : policy.PolicyTable()) {
+      SPIEL_CHECK_TRUE(mapped.GetStatePolicy(info_state) == state_policy);
+      const int index = view.InfoStateIndex(info_state);
+      SPIEL_CHECK_EQ(view.InfoStateString(index), info_state);
+      SPIEL_CHECK_EQ(view.StateProbs(index).size(), state_policy.size());
+    }
+    SPIEL_CHECK_EQ(view.InfoStateIndex("not an information state"), -1);
+    SPIEL_CHECK_TRUE(
+        mapped.GetStatePolicy("not an information state").empty());
+
+    // The batched policies are those of the states queried one by one.
+    std::vector<std::unique_ptr<State>> states;
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (!state->IsChanceNode()) states.push_back(state->Clone());
+      state->ApplyAction(state->LegalActions().front());
+    }
+    std::vector<const State*> state_pointers;
+    for (const auto& s : states) state_pointers.push_back(s.get());
+    std::vector<ActionsAndProbs> batch(states.size());
+    mapped.GetStatePolicies(state_pointers, absl::MakeSpan(batch));
+    for (int i = 0; i < states.size(); ++i) {
+      SPIEL_CHECK_TRUE(batch[i] == mapped.GetStatePolicy(
+                                      states[i]->InformationStateString()));
+    }
+  }
+  SPIEL_CHECK_TRUE(file::Remove(path));
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::MappedTabularPolicyTest();
+}
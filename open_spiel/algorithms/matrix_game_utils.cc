@@ -14,12 +14,19 @@
 
 #include "open_spiel/algorithms/matrix_game_utils.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "open_spiel/algorithms/deterministic_policy.h"
 #include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -91,43 +98,152 @@ std::shared_ptr<const MatrixGame> AsMatrixGame(const NormalFormGame* game) {
       new MatrixGame(type, {}, row_names, col_names, row_utils, col_utils));
 }
 
-std::shared_ptr<const MatrixGame> ExtensiveToMatrixGame(const Game& game) {
+namespace {
+
+// The returns of both players when they follow the deterministic policies
+// given by the offsets of the chosen children at each information state.
+std::array<double, 2> PolicyPairReturns(
+    const CompactHistoryTree& tree, int index,
+    const std::vector<int>& child_offsets) {
+  const CompactHistoryTree::Node& node = tree.GetNode(index);
+  switch (node.type) {
+    case StateType::kTerminal:
+      return {tree.PlayerReturn(index, 0), tree.PlayerReturn(index, 1)};
+    case StateType::kDecision:
+      return PolicyPairReturns(
+          tree, node.first_child + child_offsets[node.info_state],
+          child_offsets);
+    default: {
+      SPIEL_CHECK_EQ(node.type, StateType::kChance);
+      std::array<double, 2> returns = {0, 0};
+      for (int child = node.first_child;
+           child < node.first_child + node.num_children; ++child) {
+        const double probability = tree.GetNode(child).probability;
+        const std::array<double, 2> child_returns =
+            PolicyPairReturns(tree, child, child_offsets);
+        returns[0] += probability * child_returns[0];
+        returns[1] += probability * child_returns[1];
+      }
+      return returns;
+    }
+  }
+}
+
+}  // namespace
+
+std::shared_ptr<const MatrixGame> ExtensiveToMatrixGame(const Game& game,
+                                                        int num_threads) {
   SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  // The game tree is built once, and every pair of policies is evaluated on
+  // it by following the chosen child at the decision nodes. The tree only
+  // has turn-based nodes, so the policies of simultaneous-move games are
+  // kept and evaluated with ExpectedReturns instead.
+  const bool simultaneous =
+      game.GetType().dynamics == GameType::Dynamics::kSimultaneous;
+  std::unique_ptr<CompactHistoryTree> tree;
+  if (!simultaneous) {
+    tree = std::make_unique<CompactHistoryTree>(*game.NewInitialState());
+  }
 
-  std::vector<std::string> row_names;
-  std::vector<std::string> col_names;
-  std::vector<std::vector<double>> row_player_utils;
-  std::vector<std::vector<double>> col_player_utils;
-
-  GameType type = game.GetType();
-
-  std::vector<DeterministicTabularPolicy> policies = {
-      DeterministicTabularPolicy(game, 0), DeterministicTabularPolicy(game, 1)};
-
-  bool first_row = true;
-  do {
-    policies[1].ResetDefaultPolicy();
-    row_names.push_back(policies[0].ToString(" --- "));
-    std::vector<double> row_utils;
-    std::vector<double> col_utils;
-    do {
-      if (first_row) {
-        col_names.push_back(policies[1].ToString(" --- "));
+  // The policies of each player, numbered in the order of
+  // DeterministicTabularPolicy::NextPolicy.
+  const std::array<DeterministicPolicySpace, 2> spaces = {
+      DeterministicPolicySpace(game, 0), DeterministicPolicySpace(game, 1)};
+  SPIEL_CHECK_LE(spaces[0].NumPolicies(), std::numeric_limits<int>::max());
+  SPIEL_CHECK_LE(spaces[1].NumPolicies(), std::numeric_limits<int>::max());
+  const int num_rows = spaces[0].NumPolicies();
+  const int num_cols = spaces[1].NumPolicies();
+  // Simultaneous-move games evaluate the policies themselves, which each
+  // thread sets from these by index.
+  std::vector<DeterministicTabularPolicy> simultaneous_policies;
+  if (simultaneous) {
+    simultaneous_policies = {DeterministicTabularPolicy(game, 0),
+                             DeterministicTabularPolicy(game, 1)};
+  }
+
+  // For each information state in the tree, its index for its player and the
+  // offset of the child of each of its legal actions.
+  std::vector<int> space_indices;
+  std::vector<std::vector<int>> child_offsets_by_action;
+  if (!simultaneous) {
+    for (int i = 0; i < tree->NumInfoStates(); ++i) {
+      const DeterministicPolicySpace& space = spaces[tree->InfoStatePlayer(i)];
+      const int j = space.InfoStateIndex(tree->InfoStateString(i));
+      SPIEL_CHECK_GE(j, 0);
+      space_indices.push_back(j);
+      const CompactHistoryTree::Node& node =
+          tree->GetNode(tree->InfoStateNodes(i).front());
+      std::vector<int>& action_offsets = child_offsets_by_action.emplace_back();
+      for (Action action : space.LegalActions(j)) {
+        int offset = 0;
+        while (tree->GetNode(node.first_child + offset).action != action) {
+          ++offset;
+          SPIEL_CHECK_LT(offset, node.num_children);
+        }
+        action_offsets.push_back(offset);
       }
-      std::unique_ptr<State> state = game.NewInitialState();
-      std::vector<double> returns =
-          ExpectedReturns(*state, {&policies[0], &policies[1]}, -1);
-      row_utils.push_back(returns[0]);
-      col_utils.push_back(returns[1]);
-    } while (policies[1].NextPolicy());
-    first_row = false;
-    row_player_utils.push_back(row_utils);
-    col_player_utils.push_back(col_utils);
-  } while (policies[0].NextPolicy());
+    }
+  }
+
+  std::array<std::vector<std::string>, 2> names = {
+      std::vector<std::string>(num_rows), std::vector<std::string>(num_cols)};
+  std::vector<double> row_utils(num_rows * num_cols);
+  std::vector<double> col_utils(num_rows * num_cols);
+  // Each thread names and evaluates whole rows, and writes to its own
+  // entries. The policies are decoded from their indices, so that any thread
+  // can take any row.
+  auto evaluate_rows = [&](int first_row, int row_step) {
+    std::unique_ptr<State> initial_state = game.NewInitialState();
+    std::vector<int> child_offsets(tree ? tree->NumInfoStates() : 0);
+    std::vector<DeterministicTabularPolicy> policies = simultaneous_policies;
+    for (int c = first_row; c < num_cols; c += row_step) {
+      names[1][c] = spaces[1].PolicyToString(c, " --- ");
+    }
+    for (int r = first_row; r < num_rows; r += row_step) {
+      names[0][r] = spaces[0].PolicyToString(r, " --- ");
+      if (simultaneous) policies[0].SetPolicyIndex(r);
+      for (int c = 0; c < num_cols; ++c) {
+        if (simultaneous) {
+          policies[1].SetPolicyIndex(c);
+          const std::vector<double> returns = ExpectedReturns(
+              *initial_state, {&policies[0], &policies[1]}, -1);
+          row_utils[r * num_cols + c] = returns[0];
+          col_utils[r * num_cols + c] = returns[1];
+          continue;
+        }
+        for (int i = 0; i < tree->NumInfoStates(); ++i) {
+          const Player player = tree->InfoStatePlayer(i);
+          const int action_index = spaces[player].ActionIndex(
+              player == 0 ? r : c, space_indices[i]);
+          child_offsets[i] = child_offsets_by_action[i][action_index];
+        }
+        const std::array<double, 2> returns =
+            PolicyPairReturns(*tree, tree->Root(), child_offsets);
+        row_utils[r * num_cols + c] = returns[0];
+        col_utils[r * num_cols + c] = returns[1];
+      }
+    }
+  };
+  num_threads = std::min(num_threads, std::max(num_rows, num_cols));
+  if (num_threads == 1) {
+    evaluate_rows(0, 1);
+  } else {
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&evaluate_rows, num_threads, t]() {
+        evaluate_rows(t, num_threads);
+      });
+    }
+    for (Thread& thread : threads) thread.join();
+  }
 
+  const GameType& type = game.GetType();
   return matrix_game::CreateMatrixGame(type.short_name, type.long_name,
-                                       row_names, col_names, row_player_utils,
-                                       col_player_utils);
+                                       names[0], names[1], row_utils,
+                                       col_utils);
 }
 
 }  // namespace algorithms
@@ -51,8 +51,11 @@ std::shared_ptr<const matrix_game::MatrixGame> AsMatrixGame(const Game* game);
 //
 // Hence, this method should only be used for  small games! For example, Kuhn
 // poker has 64 deterministic policies, resulting in a 64-by-64 matrix.
+//
+// The game tree is built once and the pairs of policies are evaluated on it,
+// spreading the rows over num_threads threads.
 std::shared_ptr<const matrix_game::MatrixGame> ExtensiveToMatrixGame(
-    const Game& game);
+    const Game& game, int num_threads = 1);
 
 }  // namespace algorithms
 }  // namespace open_spiel
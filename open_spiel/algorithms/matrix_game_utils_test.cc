@@ -14,6 +14,13 @@
 
 #include "open_spiel/algorithms/matrix_game_utils.h"
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/deterministic_policy.h"
+#include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/games/kuhn_poker.h"
 
 namespace open_spiel {
@@ -35,6 +42,58 @@ void ConvertToMatrixGameTest() {
             << std::endl;
 }
 
+void PayoffKernelsTest() {
+  // The kernels agree with sums over the utilities.
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("blotto");
+  std::vector<double> row_strategy(game->NumRows());
+  std::vector<double> col_strategy(game->NumCols());
+  for (int row = 0; row < game->NumRows(); ++row) {
+    row_strategy[row] = (row % 3) / (game->NumRows() - 1.);
+  }
+  for (int col = 0; col < game->NumCols(); ++col) {
+    col_strategy[col] = (col % 5 == 0) ? 1. / 14 : 0;
+  }
+  std::vector<double> row_values(game->NumRows(), 0);
+  std::vector<double> col_values(game->NumCols(), 0);
+  std::array<double, 2> payoffs = {0, 0};
+  for (int row = 0; row < game->NumRows(); ++row) {
+    for (int col = 0; col < game->NumCols(); ++col) {
+      row_values[row] += col_strategy[col] * game->RowUtility(row, col);
+      col_values[col] += row_strategy[row] * game->ColUtility(row, col);
+      payoffs[0] +=
+          row_strategy[row] * col_strategy[col] * game->RowUtility(row, col);
+      payoffs[1] +=
+          row_strategy[row] * col_strategy[col] * game->ColUtility(row, col);
+    }
+  }
+  const std::array<double, 2> kernel_payoffs =
+      game->ExpectedPayoffs(row_strategy, col_strategy);
+  SPIEL_CHECK_FLOAT_NEAR(kernel_payoffs[0], payoffs[0], 1e-12);
+  SPIEL_CHECK_FLOAT_NEAR(kernel_payoffs[1], payoffs[1], 1e-12);
+  const std::vector<double> kernel_row_values =
+      game->ActionValues(matrix_game::kRowPlayer, col_strategy);
+  for (int row = 0; row < game->NumRows(); ++row) {
+    SPIEL_CHECK_FLOAT_NEAR(kernel_row_values[row], row_values[row], 1e-12);
+  }
+  const std::vector<double> kernel_col_values =
+      game->ActionValues(matrix_game::kColPlayer, row_strategy);
+  for (int col = 0; col < game->NumCols(); ++col) {
+    SPIEL_CHECK_FLOAT_NEAR(kernel_col_values[col], col_values[col], 1e-12);
+  }
+  const Action best_row =
+      game->BestResponse(matrix_game::kRowPlayer, col_strategy);
+  SPIEL_CHECK_FLOAT_EQ(
+      row_values[best_row],
+      *std::max_element(row_values.begin(), row_values.end()));
+
+  // Rock beats scissors.
+  std::shared_ptr<const matrix_game::MatrixGame> rps =
+      LoadMatrixGame("matrix_rps");
+  SPIEL_CHECK_EQ(
+      rps->BestResponse(matrix_game::kColPlayer, {0, 0, 1}), 0);
+}
+
 void ExtensiveToMatrixGameTest() {
   // This just does a conversion and checks the sizes. The real test of this
   // method is currently in python/tests/matrix_utils_test, which solves the
@@ -44,6 +103,47 @@ void ExtensiveToMatrixGameTest() {
       ExtensiveToMatrixGame(*kuhn_game);
   SPIEL_CHECK_EQ(kuhn_matrix_game->NumRows(), 64);
   SPIEL_CHECK_EQ(kuhn_matrix_game->NumCols(), 64);
+
+  // Simultaneous-move games are converted too.
+  std::shared_ptr<const matrix_game::MatrixGame> rps_matrix_game =
+      ExtensiveToMatrixGame(*LoadGame("matrix_rps"), /*num_threads=*/2);
+  SPIEL_CHECK_EQ(rps_matrix_game->NumRows(), 3);
+  SPIEL_CHECK_EQ(rps_matrix_game->NumCols(), 3);
+  SPIEL_CHECK_EQ(rps_matrix_game->PlayerUtility(Player{0}, 0, 1), -1);
+}
+
+void ParallelExtensiveToMatrixGameTest() {
+  // The utilities match the expected returns of the policies of each row and
+  // column, whatever the number of threads.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::shared_ptr<const matrix_game::MatrixGame> matrix_game =
+      ExtensiveToMatrixGame(*game, /*num_threads=*/3);
+  std::shared_ptr<const matrix_game::MatrixGame> serial_matrix_game =
+      ExtensiveToMatrixGame(*game);
+  std::vector<DeterministicTabularPolicy> policies = {
+      DeterministicTabularPolicy(*game, 0),
+      DeterministicTabularPolicy(*game, 1)};
+  int row = 0;
+  do {
+    policies[1].ResetDefaultPolicy();
+    SPIEL_CHECK_EQ(matrix_game->RowActionName(row),
+                   policies[0].ToString(" --- "));
+    int col = 0;
+    do {
+      const std::vector<double> returns = ExpectedReturns(
+          *game->NewInitialState(), {&policies[0], &policies[1]}, -1);
+      for (Player player : {0, 1}) {
+        SPIEL_CHECK_FLOAT_NEAR(matrix_game->PlayerUtility(player, row, col),
+                               returns[player], 1e-12);
+        SPIEL_CHECK_EQ(matrix_game->PlayerUtility(player, row, col),
+                       serial_matrix_game->PlayerUtility(player, row, col));
+      }
+      ++col;
+    } while (policies[1].NextPolicy());
+    SPIEL_CHECK_EQ(col, matrix_game->NumCols());
+    ++row;
+  } while (policies[0].NextPolicy());
+  SPIEL_CHECK_EQ(row, matrix_game->NumRows());
 }
 
 }  // namespace
@@ -52,5 +152,7 @@ void ExtensiveToMatrixGameTest() {
 
 int main(int argc, char** argv) {
   open_spiel::algorithms::ConvertToMatrixGameTest();
+  open_spiel::algorithms::PayoffKernelsTest();
   open_spiel::algorithms::ExtensiveToMatrixGameTest();
+  open_spiel::algorithms::ParallelExtensiveToMatrixGameTest();
 }
@@ -15,54 +15,179 @@
 #include "open_spiel/algorithms/mcts.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
-#include "open_spiel/abseil-cpp/absl/random/distributions.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
 #include "open_spiel/abseil-cpp/absl/time/clock.h"
 #include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/profiler.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
 
 int MIN_GC_LIMIT = 5;
 
-int MemoryUsedMb(int nodes) {
-  return nodes * sizeof(SearchNode) / (1 << 20);
+// The number of slices of a sweep of the garbage collector, and the minimum
+// number of children visited per slice.
+constexpr int kGarbageCollectSlices = 16;
+constexpr int64_t kMinGarbageCollectBudget = 1024;
+
+// The scale of the values in the Gumbel root selection, with the number of
+// visits of the most visited action, from Danihelka et al.
+constexpr double kGumbelVisitOffset = 50;
+constexpr double kGumbelValueScale = 1;
+
+int MemoryUsedMb(int64_t bytes) { return bytes >> 20; }
+
+// The number of nodes in the tree of `node`, as counted by MCTSBot::nodes_.
+int CountNodes(const SearchNode& node) {
+  int nodes = 1 + node.children.capacity() - node.children.size();
+  for (const SearchNode& child : node.children) {
+    nodes += CountNodes(child);
+  }
+  return nodes;
+}
+
+int64_t OutcomeBytes(const SearchNode& node) {
+  return node.outcome.capacity() * sizeof(double);
+}
+
+// The bytes allocated for the descendants of `node` and their outcomes, as
+// counted by MCTSBot::memory_used_.
+int64_t ChildrenBytes(const SearchNode& node) {
+  int64_t bytes = node.children.capacity() * sizeof(SearchNode);
+  for (const SearchNode& child : node.children) {
+    bytes += OutcomeBytes(child) + ChildrenBytes(child);
+  }
+  return bytes;
+}
+
+std::vector<std::vector<double>> Evaluator::EvaluateBatch(
+    absl::Span<const State* const> states) {
+  std::vector<std::vector<double>> values;
+  values.reserve(states.size());
+  for (const State* state : states) {
+    values.push_back(Evaluate(*state));
+  }
+  return values;
+}
+
+CachingEvaluator::CachingEvaluator(Evaluator* evaluator, int cache_size,
+                                   int cache_shards)
+    : evaluator_(evaluator),
+      values_(cache_size, cache_shards),
+      priors_(cache_size, cache_shards) {
+  SPIEL_CHECK_TRUE(evaluator != nullptr);
+}
+
+std::vector<double> CachingEvaluator::Evaluate(const State& state) {
+  const uint64_t hash = state.Hash();
+  if (std::optional<const std::vector<double>> values = values_.Get(hash)) {
+    return *values;
+  }
+  std::vector<double> values = evaluator_->Evaluate(state);
+  values_.Set(hash, values);
+  return values;
+}
+
+std::vector<std::vector<double>> CachingEvaluator::EvaluateBatch(
+    absl::Span<const State* const> states) {
+  std::vector<std::vector<double>> values(states.size());
+  std::vector<uint64_t> hashes(states.size());
+  std::vector<int> missing;
+  std::vector<const State*> missing_states;
+  for (int i = 0; i < states.size(); ++i) {
+    hashes[i] = states[i]->Hash();
+    if (std::optional<const std::vector<double>> cached =
+            values_.Get(hashes[i])) {
+      values[i] = *cached;
+    } else {
+      missing.push_back(i);
+      missing_states.push_back(states[i]);
+    }
+  }
+  if (missing.empty()) return values;
+  std::vector<std::vector<double>> missing_values =
+      evaluator_->EvaluateBatch(missing_states);
+  SPIEL_CHECK_EQ(missing_values.size(), missing.size());
+  for (int j = 0; j < missing.size(); ++j) {
+    values_.Set(hashes[missing[j]], missing_values[j]);
+    values[missing[j]] = std::move(missing_values[j]);
+  }
+  return values;
+}
+
+ActionsAndProbs CachingEvaluator::Prior(const State& state) {
+  const uint64_t hash = state.Hash();
+  if (std::optional<const ActionsAndProbs> prior = priors_.Get(hash)) {
+    return *prior;
+  }
+  ActionsAndProbs prior = evaluator_->Prior(state);
+  priors_.Set(hash, prior);
+  return prior;
+}
+
+void CachingEvaluator::ClearCache() {
+  values_.Clear();
+  priors_.Clear();
 }
 
 std::vector<double> RandomRolloutEvaluator::Evaluate(const State& state) {
   std::vector<double> result;
-  for (int i = 0; i < n_rollouts_; ++i) {
-    std::unique_ptr<State> working_state = state.Clone();
-    while (!working_state->IsTerminal()) {
-      if (working_state->IsChanceNode()) {
-        ActionsAndProbs outcomes = working_state->ChanceOutcomes();
-        working_state->ApplyAction(SampleAction(outcomes, rng_).first);
-      } else {
-        std::vector<Action> actions = working_state->LegalActions();
-        working_state->ApplyAction(
-            actions[absl::Uniform(rng_, 0u, actions.size())]);
-      }
+  const int num_threads = std::min(num_threads_, n_rollouts_);
+  if (num_threads > 1) {
+    std::vector<uint64_t> seeds(num_threads);
+    {
+      absl::MutexLock lock(&seed_mutex_);
+      for (uint64_t& seed : seeds) seed = seed_rng_();
     }
-
-    std::vector<double> returns = working_state->Returns();
-    if (result.empty()) {
-      result.swap(returns);
-    } else {
-      SPIEL_CHECK_EQ(returns.size(), result.size());
+    std::vector<std::vector<double>> thread_results(num_threads);
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([this, &state, &seeds, &thread_results, num_threads,
+                            t]() {
+        SplitMix64 rng(seeds[t]);
+        const int n_rollouts = n_rollouts_ * (t + 1) / num_threads -
+                               n_rollouts_ * t / num_threads;
+        thread_results[t] = SumOfRollouts(state, n_rollouts, &rng);
+      });
+    }
+    for (Thread& thread : threads) thread.join();
+    result = std::move(thread_results[0]);
+    for (int t = 1; t < num_threads; ++t) {
       for (int i = 0; i < result.size(); ++i) {
-        result[i] += returns[i];
+        result[i] += thread_results[t][i];
       }
     }
+  } else if (rng_mutex_.TryLock()) {
+    result = SumOfRollouts(state, n_rollouts_, &rng_);
+    rng_mutex_.Unlock();
+  } else {
+    // Another thread is using rng_.
+    SplitMix64 rng;
+    {
+      absl::MutexLock lock(&seed_mutex_);
+      rng = SplitMix64(seed_rng_());
+    }
+    result = SumOfRollouts(state, n_rollouts_, &rng);
   }
   for (int i = 0; i < result.size(); ++i) {
     result[i] /= n_rollouts_;
@@ -70,12 +195,47 @@ std::vector<double> RandomRolloutEvaluator::Evaluate(const State& state) {
   return result;
 }
 
+std::vector<double> RandomRolloutEvaluator::SumOfRollouts(
+    const State& state, int n_rollouts, SplitMix64* rng) const {
+  std::vector<double> result(state.NumPlayers(), 0.0);
+  std::vector<double> returns(state.NumPlayers());
+  std::vector<Action> actions;
+  actions.reserve(state.GetGame()->ResourceHints().max_legal_actions);
+  std::unique_ptr<State> working_state;
+  for (int i = 0; i < n_rollouts; ++i) {
+    // Recycle the previous rollout's state if the game supports it.
+    if (working_state == nullptr || !working_state->CopyFrom(state)) {
+      working_state = OPEN_SPIEL_PROFILE("mcts/Clone", state.Clone());
+    }
+    while (!working_state->IsTerminal()) {
+      if (working_state->IsChanceNode()) {
+        Action outcome = working_state->SampleChanceOutcome(*rng).first;
+        OPEN_SPIEL_PROFILE("mcts/ApplyAction",
+                           working_state->ApplyAction(outcome));
+      } else {
+        OPEN_SPIEL_PROFILE("mcts/LegalActions",
+                           working_state->LegalActions(&actions));
+        OPEN_SPIEL_PROFILE("mcts/ApplyAction",
+                           working_state->ApplyAction(
+                               actions[UniformInt(*rng, actions.size())]));
+      }
+    }
+
+    working_state->Returns(absl::MakeSpan(returns));
+    for (int p = 0; p < result.size(); ++p) {
+      result[p] += returns[p];
+    }
+  }
+  return result;
+}
+
 ActionsAndProbs RandomRolloutEvaluator::Prior(const State& state) {
   // Returns equal probability for all actions.
   if (state.IsChanceNode()) {
     return state.ChanceOutcomes();
   } else {
-    std::vector<Action> legal_actions = state.LegalActions();
+    std::vector<Action> legal_actions =
+        OPEN_SPIEL_PROFILE("mcts/LegalActions", state.LegalActions());
     ActionsAndProbs prior;
     prior.reserve(legal_actions.size());
     for (const Action& action : legal_actions) {
@@ -175,7 +335,7 @@ std::string SearchNode::ToString(const State& state) const {
 }
 
 std::vector<double> dirichlet_noise(int count, double alpha,
-                                    std::mt19937* rng) {
+                                    Xoshiro256PlusPlus* rng) {
   std::vector<double> noise;
   noise.reserve(count);
 
@@ -195,20 +355,61 @@ MCTSBot::MCTSBot(const Game& game, Evaluator* evaluator,
                  double uct_c, int max_simulations, int64_t max_memory_mb,
                  bool solve, int seed, bool verbose,
                  ChildSelectionPolicy child_selection_policy,
-                 double dirichlet_alpha, double dirichlet_epsilon)
+                 double dirichlet_alpha, double dirichlet_epsilon,
+                 int num_threads, double virtual_loss, int batch_size,
+                 bool reuse_tree, double max_seconds, bool stop_early,
+                 bool use_transpositions, int gumbel_num_actions,
+                 bool ponder)
     : uct_c_{uct_c},
       max_simulations_{max_simulations},
-      max_nodes_((max_memory_mb << 20) / sizeof(SearchNode) + 1),
+      max_memory_((max_memory_mb << 20) / (use_transpositions ? 4 : 1) *
+                  (use_transpositions ? 3 : 1)),
+      gc_threshold_(max_memory_ / 4 * 3),
       nodes_(0),
+      memory_used_(0),
       gc_limit_(MIN_GC_LIMIT),
       verbose_(verbose),
       solve_(solve),
       max_utility_(game.MaxUtility()),
+      min_utility_(game.MinUtility()),
       dirichlet_alpha_(dirichlet_alpha),
       dirichlet_epsilon_(dirichlet_epsilon),
       rng_(seed),
       child_selection_policy_(child_selection_policy),
-      evaluator_{evaluator} {
+      evaluator_{evaluator},
+      num_threads_(num_threads),
+      virtual_loss_(virtual_loss),
+      batch_size_(batch_size),
+      reuse_tree_(reuse_tree),
+      max_seconds_(max_seconds),
+      stop_early_(stop_early),
+      use_transpositions_(use_transpositions),
+      gumbel_num_actions_(gumbel_num_actions),
+      num_players_(game.NumPlayers()),
+      ponder_(ponder) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  SPIEL_CHECK_GE(batch_size, 1);
+  if (use_transpositions && (num_threads > 1 || batch_size > 1)) {
+    SpielFatalError(
+        "Transpositions are only supported by the single-threaded, unbatched "
+        "search.");
+  }
+  SPIEL_CHECK_GE(gumbel_num_actions, 0);
+  if (gumbel_num_actions > 0 &&
+      (num_threads > 1 || batch_size > 1 || stop_early)) {
+    SpielFatalError(
+        "The Gumbel root selection is only supported by the single-threaded, "
+        "unbatched search, without stop_early.");
+  }
+  if (ponder && !reuse_tree) {
+    SpielFatalError("Pondering requires reuse_tree.");
+  }
+  // A quarter of the memory, counting the map's node and slot per position.
+  const int64_t transposition_bytes =
+      sizeof(std::pair<const uint64_t, Transposition>) + sizeof(void*) +
+      num_players_ * sizeof(double);
+  max_transpositions_ =
+      std::max<int64_t>(1, (max_memory_mb << 20) / 4 / transposition_bytes);
   GameType game_type = game.GetType();
   if (game_type.reward_model != GameType::RewardModel::kTerminal)
     SpielFatalError("Game must have terminal rewards.");
@@ -217,11 +418,21 @@ MCTSBot::MCTSBot(const Game& game, Evaluator* evaluator,
 }
 
 Action MCTSBot::Step(const State& state) {
+  OPEN_SPIEL_PROFILE_SCOPE("mcts/Step");
+  if (opening_book_ != nullptr) {
+    ActionsAndProbs book_policy = opening_book_->Policy(state);
+    if (!book_policy.empty()) {
+      ClearTree();
+      return SampleAction(book_policy,
+                          std::uniform_real_distribution<double>()(rng_))
+          .first;
+    }
+  }
   absl::Time start = absl::Now();
   std::unique_ptr<SearchNode> root = MCTSearch(state);
   SPIEL_CHECK_GT(root->children.size(), 0);
 
-  const SearchNode& best = root->BestChild();
+  const SearchNode& best = ChosenChild(*root);
 
   if (verbose_) {
     double seconds = absl::ToDoubleSeconds(absl::Now() - start);
@@ -230,7 +441,7 @@ Action MCTSBot::Step(const State& state) {
                ("Finished %d sims in %.3f secs, %.1f sims/s, "
                 "tree size: %d nodes / %d mb."),
                root->explore_count, seconds, (root->explore_count / seconds),
-               nodes_, MemoryUsedMb(nodes_))
+               nodes_.load(), MemoryUsedMb(memory_used_))
         << std::endl;
     std::cerr << "Root:" << std::endl;
     std::cerr << root->ToString(state) << std::endl;
@@ -244,7 +455,65 @@ Action MCTSBot::Step(const State& state) {
     }
   }
 
-  return best.action;
+  const Action action = best.action;
+  if (reuse_tree_) {
+    tree_ = std::move(root);
+    tree_history_ = state.History();
+    if (ponder_) StartPondering(state, action);
+  }
+  return action;
+}
+
+void MCTSBot::InformAction(const State& state, Player player_id,
+                           Action action) {
+  StopPondering();
+  if (tree_ == nullptr) return;
+  std::unique_ptr<State> child = state.Child(action);
+  tree_ = TakeRoot(*child);
+  tree_history_ = child->History();
+}
+
+void MCTSBot::StartPondering(const State& state, Action action) {
+  auto it = std::find_if(
+      tree_->children.begin(), tree_->children.end(),
+      [action](const SearchNode& c) { return c.action == action; });
+  if (it == tree_->children.end() || !it->outcome.empty()) return;
+  SearchNode* child = &*it;
+  ponder_state_ = state.Clone();
+  stop_pondering_ = false;
+  num_ponder_simulations_ = 0;
+  ponder_thread_ = std::make_unique<Thread>([this, child]() {
+    OPEN_SPIEL_PROFILE_SCOPE("mcts/Ponder");
+    std::vector<SearchNode*> visit_path;
+    std::unique_ptr<State> working_state;
+    visit_path.reserve(64);
+    // Stop rather than garbage collect, which would free the nodes the next
+    // search wants to reuse.
+    while (!stop_pondering_ && child->outcome.empty() &&
+           child->explore_count < max_simulations_ &&
+           (max_memory_ <= 0 || memory_used_ < gc_threshold_)) {
+      Simulate(*ponder_state_, tree_.get(), child, &working_state,
+               &visit_path);
+      ++num_ponder_simulations_;
+    }
+  });
+}
+
+void MCTSBot::StopPondering() {
+  if (ponder_thread_ == nullptr) return;
+  stop_pondering_ = true;
+  ponder_thread_->join();
+  ponder_thread_.reset();
+  ponder_state_.reset();
+}
+
+const SearchNode& MCTSBot::ChosenChild(const SearchNode& root) const {
+  if (gumbel_action_ != kInvalidAction) {
+    for (const SearchNode& child : root.children) {
+      if (child.action == gumbel_action_) return child;
+    }
+  }
+  return root.BestChild();
 }
 
 std::pair<ActionsAndProbs, Action> MCTSBot::StepWithPolicy(const State& state) {
@@ -252,193 +521,654 @@ std::pair<ActionsAndProbs, Action> MCTSBot::StepWithPolicy(const State& state) {
   return {{{action, 1.}}, action};
 }
 
-std::unique_ptr<State> MCTSBot::ApplyTreePolicy(
-    SearchNode* root, const State& state,
-    std::vector<SearchNode*>* visit_path) {
+void MCTSBot::ExpandNode(SearchNode* node, const State& state, bool is_root,
+                         Xoshiro256PlusPlus* rng) {
+  ActionsAndProbs legal_actions =
+      OPEN_SPIEL_PROFILE("mcts/Prior", evaluator_->Prior(state));
+  if (is_root && dirichlet_alpha_ > 0) {
+    std::vector<double> noise =
+        dirichlet_noise(legal_actions.size(), dirichlet_alpha_, rng);
+    for (int i = 0; i < legal_actions.size(); i++) {
+      legal_actions[i].second =
+          (1 - dirichlet_epsilon_) * legal_actions[i].second +
+          dirichlet_epsilon_ * noise[i];
+    }
+  }
+  // Reduce bias from move generation order.
+  std::shuffle(legal_actions.begin(), legal_actions.end(), *rng);
+  Player player = state.CurrentPlayer();
+  node->children.reserve(legal_actions.size());
+  for (auto [action, prior] : legal_actions) {
+    node->children.emplace_back(action, player, prior);
+  }
+  nodes_ += node->children.capacity();
+  memory_used_ += node->children.capacity() * sizeof(SearchNode);
+}
+
+SearchNode* MCTSBot::SelectChild(SearchNode* node, int explore_count,
+                                 const State& state,
+                                 Xoshiro256PlusPlus* rng) const {
+  SearchNode* chosen_child = nullptr;
+  if (state.IsChanceNode()) {
+    // For chance nodes, rollout according to chance node's probability
+    // distribution
+    Action chosen_action = state.SampleChanceOutcome(*rng).first;
+
+    for (SearchNode& child : node->children) {
+      if (child.action == chosen_action) {
+        chosen_child = &child;
+        break;
+      }
+    }
+  } else {
+    // Otherwise choose node with largest UCT value.
+    double max_value = -std::numeric_limits<double>::infinity();
+    for (SearchNode& child : node->children) {
+      double val;
+      switch (child_selection_policy_) {
+        case ChildSelectionPolicy::UCT:
+          val = child.UCTValue(explore_count, uct_c_);
+          break;
+        case ChildSelectionPolicy::PUCT:
+          val = child.PUCTValue(explore_count, uct_c_);
+          break;
+      }
+      if (child.transposition != nullptr && child.outcome.empty() &&
+          child.explore_count > 0) {
+        // Use the mean reward of the position over all the paths to it.
+        const Transposition& transposition = *child.transposition;
+        val += transposition.total_rewards[child.player] /
+                   transposition.explore_count -
+               child.total_reward / child.explore_count;
+      }
+      if (val > max_value) {
+        max_value = val;
+        chosen_child = &child;
+      }
+    }
+  }
+  return chosen_child;
+}
+
+void MCTSBot::ApplyTreePolicy(SearchNode* root, State* working_state,
+                              std::vector<SearchNode*>* visit_path,
+                              SearchNode* root_child) {
   visit_path->push_back(root);
-  std::unique_ptr<State> working_state = state.Clone();
   SearchNode* current_node = root;
   while (!working_state->IsTerminal() && current_node->explore_count > 0) {
     if (current_node->children.empty()) {
       // For a new node, initialize its state, then choose a child as normal.
-      ActionsAndProbs legal_actions = evaluator_->Prior(*working_state);
-      if (current_node == root && dirichlet_alpha_ > 0) {
-        std::vector<double> noise =
-            dirichlet_noise(legal_actions.size(), dirichlet_alpha_, &rng_);
-        for (int i = 0; i < legal_actions.size(); i++) {
-          legal_actions[i].second =
-              (1 - dirichlet_epsilon_) * legal_actions[i].second +
-              dirichlet_epsilon_ * noise[i];
-        }
+      ExpandNode(current_node, *working_state, current_node == root, &rng_);
+    }
+
+    SearchNode* chosen_child =
+        current_node == root && root_child != nullptr
+            ? root_child
+            : SelectChild(current_node, current_node->explore_count,
+                          *working_state, &rng_);
+    OPEN_SPIEL_PROFILE("mcts/ApplyAction",
+                       working_state->ApplyAction(chosen_child->action));
+    if (use_transpositions_ && chosen_child->transposition == nullptr) {
+      chosen_child->transposition = FindTransposition(*working_state);
+    }
+    current_node = chosen_child;
+    visit_path->push_back(current_node);
+  }
+}
+
+std::vector<double> MCTSBot::BackedUpOutcome(const SearchNode& node) const {
+  Player player = node.children[0].player;
+  if (player == kChancePlayerId) {
+    // Only back up chance nodes if all have the same outcome.
+    // An alternative would be to back up the weighted average of
+    // outcomes if all children are solved, but that is less clear.
+    const std::vector<double>& outcome = node.children[0].outcome;
+    if (!outcome.empty() &&
+        std::all_of(node.children.begin() + 1, node.children.end(),
+                    [&outcome](const SearchNode& c) {
+                      return c.outcome == outcome;
+                    })) {
+      return outcome;
+    }
+    return {};
+  }
+  // If any have max utility (won?), or all children are solved,
+  // choose the one best for the player choosing.
+  const SearchNode* best = nullptr;
+  bool all_solved = true;
+  for (const SearchNode& child : node.children) {
+    if (child.outcome.empty()) {
+      all_solved = false;
+    } else if (best == nullptr ||
+               child.outcome[player] > best->outcome[player]) {
+      best = &child;
+    }
+  }
+  if (best != nullptr &&
+      (all_solved || best->outcome[player] == max_utility_)) {
+    return best->outcome;
+  }
+  return {};
+}
+
+std::unique_ptr<SearchNode> MCTSBot::TakeRoot(const State& state) {
+  StopPondering();
+  // The sweep in progress was of the last search's tree.
+  gc_stack_.clear();
+  gc_in_progress_ = false;
+  std::unique_ptr<SearchNode> tree = std::move(tree_);
+  const Player player_id = state.CurrentPlayer();
+  const std::vector<Action> history = state.History();
+  if (tree != nullptr && history.size() >= tree_history_.size() &&
+      std::equal(tree_history_.begin(), tree_history_.end(),
+                 history.begin())) {
+    SearchNode* node = tree.get();
+    for (int i = tree_history_.size(); i < history.size() && node; ++i) {
+      auto child = std::find_if(
+          node->children.begin(), node->children.end(),
+          [&](const SearchNode& c) { return c.action == history[i]; });
+      node = child == node->children.end() ? nullptr : &*child;
+    }
+    if (node != nullptr && !node->children.empty()) {
+      auto root = std::make_unique<SearchNode>(kInvalidAction, player_id, 1);
+      root->explore_count = node->explore_count;
+      root->outcome = std::move(node->outcome);
+      root->children = std::move(node->children);
+      // The node's reward is for the player who moved to it, while those of
+      // its children are for the player to move now.
+      for (const SearchNode& child : root->children) {
+        root->total_reward += child.total_reward;
+      }
+      nodes_ = CountNodes(*root);
+      memory_used_ =
+          sizeof(SearchNode) + OutcomeBytes(*root) + ChildrenBytes(*root);
+      return root;
+    }
+  }
+  nodes_ = 1;
+  memory_used_ = sizeof(SearchNode);
+  transpositions_.clear();
+  return std::make_unique<SearchNode>(kInvalidAction, player_id, 1);
+}
+
+void MCTSBot::ClearTree() {
+  StopPondering();
+  tree_.reset();
+  tree_history_.clear();
+  transpositions_.clear();
+}
+
+Transposition* MCTSBot::FindTransposition(const State& state) {
+  const uint64_t hash = state.Hash();
+  auto it = transpositions_.find(hash);
+  if (it != transpositions_.end()) return &it->second;
+  if (transpositions_.size() >= max_transpositions_) return nullptr;
+  Transposition& transposition = transpositions_[hash];
+  transposition.total_rewards.resize(num_players_, 0.0);
+  return &transposition;
+}
+
+void MCTSBot::StartSearch(const SearchNode& root) {
+  search_start_ = absl::Now();
+  deadline_ = max_seconds_ > 0 ? search_start_ + absl::Seconds(max_seconds_)
+                               : absl::InfiniteFuture();
+  initial_simulations_ = root.explore_count;
+}
+
+bool MCTSBot::ShouldStop(const SearchNode& root, int num_simulations) const {
+  if (max_seconds_ <= 0 && !stop_early_) return false;
+  double simulations_left = max_simulations_ - num_simulations;
+  if (max_seconds_ > 0) {
+    const absl::Time now = absl::Now();
+    if (now >= deadline_) return true;
+    const double elapsed = absl::ToDoubleSeconds(now - search_start_);
+    if (elapsed > 0) {
+      simulations_left = std::min(
+          simulations_left, (num_simulations - initial_simulations_) *
+                                absl::ToDoubleSeconds(deadline_ - now) /
+                                elapsed);
+    }
+  }
+  if (!stop_early_) return false;
+  // Compare the two most explored children.
+  int most_explored = 0;
+  int second_most_explored = 0;
+  for (const SearchNode& child : root.children) {
+    if (!child.outcome.empty()) return false;
+    if (child.explore_count > most_explored) {
+      second_most_explored = most_explored;
+      most_explored = child.explore_count;
+    } else if (child.explore_count > second_most_explored) {
+      second_most_explored = child.explore_count;
+    }
+  }
+  return most_explored - second_most_explored > simulations_left;
+}
+
+std::unique_ptr<SearchNode> MCTSBot::MCTSearch(const State& state) {
+  gc_limit_ = MIN_GC_LIMIT;
+  std::unique_ptr<SearchNode> root = TakeRoot(state);
+  StartSearch(*root);
+  gumbel_action_ = kInvalidAction;
+  if (num_threads_ > 1 || batch_size_ > 1) {
+    MCTSearchInParallel(state, root.get());
+    num_simulations_ = root->explore_count - initial_simulations_;
+    return root;
+  }
+  std::vector<SearchNode*> visit_path;
+  std::unique_ptr<State> working_state;
+  visit_path.reserve(64);
+  if (gumbel_num_actions_ > 0 && !state.IsChanceNode()) {
+    GumbelSearch(state, root.get(), &working_state, &visit_path);
+  } else {
+    for (int i = root->explore_count; i < max_simulations_; ++i) {
+      Simulate(state, root.get(), /*root_child=*/nullptr, &working_state,
+               &visit_path);
+      if (!root->outcome.empty() ||  // Full game tree is solved.
+          root->children.size() == 1) {
+        break;
       }
-      // Reduce bias from move generation order.
-      std::shuffle(legal_actions.begin(), legal_actions.end(), rng_);
-      Player player = working_state->CurrentPlayer();
-      current_node->children.reserve(legal_actions.size());
-      for (auto [action, prior] : legal_actions) {
-        current_node->children.emplace_back(action, player, prior);
+      MaybeGarbageCollect(root.get(), i);
+      if (ShouldStop(*root, i + 1)) break;
+    }
+  }
+
+  num_simulations_ = root->explore_count - initial_simulations_;
+  return root;
+}
+
+void MCTSBot::Simulate(const State& state, SearchNode* root,
+                       SearchNode* root_child,
+                       std::unique_ptr<State>* working_state,
+                       std::vector<SearchNode*>* visit_path) {
+  const Player player_id = state.CurrentPlayer();
+  visit_path->clear();
+
+  // Recycle the previous simulation's state if the game supports it.
+  if (*working_state == nullptr || !(*working_state)->CopyFrom(state)) {
+    *working_state = OPEN_SPIEL_PROFILE("mcts/Clone", state.Clone());
+  }
+  ApplyTreePolicy(root, working_state->get(), visit_path, root_child);
+
+  std::vector<double> values;
+  absl::Span<const double> returns;
+  bool solved;
+  if ((*working_state)->IsTerminal()) {
+    // The outcome of a terminal node is set on its first visit, and backs up
+    // the later ones.
+    SearchNode* leaf = visit_path->back();
+    if (leaf->outcome.empty()) SetOutcome(leaf, (*working_state)->Returns());
+    returns = leaf->outcome;
+    solved = solve_;
+  } else {
+    values = OPEN_SPIEL_PROFILE("mcts/Evaluate",
+                                evaluator_->Evaluate(**working_state));
+    returns = values;
+    solved = false;
+  }
+
+  // Propagate values back.
+  for (auto it = visit_path->rbegin(); it != visit_path->rend(); ++it) {
+    SearchNode* node = *it;
+
+    node->total_reward +=
+        returns[node->player == kChancePlayerId ? player_id : node->player];
+    node->explore_count += 1;
+    if (node->transposition != nullptr) {
+      node->transposition->explore_count += 1;
+      for (Player p = 0; p < num_players_; ++p) {
+        node->transposition->total_rewards[p] += returns[p];
       }
-      nodes_ += current_node->children.capacity();
     }
 
-    SearchNode* chosen_child = nullptr;
-    if (working_state->IsChanceNode()) {
-      // For chance nodes, rollout according to chance node's probability
-      // distribution
-      Action chosen_action =
-          SampleAction(working_state->ChanceOutcomes(), rng_).first;
+    // Back up solved results as well.
+    if (solved && !node->children.empty()) {
+      std::vector<double> outcome = BackedUpOutcome(*node);
+      if (outcome.empty()) {
+        solved = false;
+      } else {
+        SetOutcome(node, std::move(outcome));
+      }
+    }
+  }
+}
 
-      for (SearchNode& child : current_node->children) {
-        if (child.action == chosen_action) {
-          chosen_child = &child;
-          break;
-        }
+void MCTSBot::GumbelSearch(const State& state, SearchNode* root,
+                           std::unique_ptr<State>* working_state,
+                           std::vector<SearchNode*>* visit_path) {
+  // The first simulation evaluates the root, which is then expanded.
+  if (root->explore_count == 0 && max_simulations_ > 0) {
+    Simulate(state, root, /*root_child=*/nullptr, working_state, visit_path);
+  }
+  if (root->children.empty()) {
+    ExpandNode(root, state, /*is_root=*/true, &rng_);
+  }
+  if (root->children.size() == 1) return;
+
+  // The Gumbel-Top-k trick: the actions with the k highest perturbed logits
+  // are a sample without replacement from the prior.
+  std::extreme_value_distribution<double> gumbel_distribution;
+  std::vector<double> perturbed_logits;
+  perturbed_logits.reserve(root->children.size());
+  for (const SearchNode& child : root->children) {
+    perturbed_logits.push_back(std::log(child.prior) +
+                               gumbel_distribution(rng_));
+  }
+  std::vector<int> considered(root->children.size());
+  absl::c_iota(considered, 0);
+  // The rank of the considered actions, given the values of the children.
+  auto sort_considered = [&]() {
+    int max_visits = 0;
+    for (const SearchNode& child : root->children) {
+      max_visits = std::max(max_visits, child.explore_count);
+    }
+    const double root_value =
+        root->explore_count > 0 ? root->total_reward / root->explore_count : 0;
+    std::vector<double> scores(root->children.size());
+    for (int i : considered) {
+      const SearchNode& child = root->children[i];
+      double value = root_value;
+      if (!child.outcome.empty()) {
+        value = child.outcome[child.player];
+      } else if (child.explore_count > 0) {
+        value = child.total_reward / child.explore_count;
       }
-    } else {
-      // Otherwise choose node with largest UCT value.
-      double max_value = -std::numeric_limits<double>::infinity();
-      for (SearchNode& child : current_node->children) {
-        double val;
-        switch (child_selection_policy_) {
-          case ChildSelectionPolicy::UCT:
-            val = child.UCTValue(current_node->explore_count, uct_c_);
-            break;
-          case ChildSelectionPolicy::PUCT:
-            val = child.PUCTValue(current_node->explore_count, uct_c_);
-            break;
+      scores[i] = perturbed_logits[i] +
+                  (kGumbelVisitOffset + max_visits) * kGumbelValueScale *
+                      (value - min_utility_) / (max_utility_ - min_utility_);
+    }
+    std::stable_sort(considered.begin(), considered.end(),
+                     [&scores](int a, int b) { return scores[a] > scores[b]; });
+  };
+  std::stable_sort(considered.begin(), considered.end(),
+                   [&perturbed_logits](int a, int b) {
+                     return perturbed_logits[a] > perturbed_logits[b];
+                   });
+  considered.resize(std::min<int>(considered.size(), gumbel_num_actions_));
+
+  // Sequential halving: the budget is split evenly between ceil(log2(k))
+  // phases, and between the actions considered in each, after which the worse
+  // half of them is dropped. The last phase uses what is left.
+  const int num_simulations = max_simulations_ - root->explore_count;
+  const int num_phases = std::ceil(std::log2(considered.size()));
+  int simulation = root->explore_count;
+  bool stop = false;
+  while (considered.size() > 1 && !stop) {
+    const int num_visits =
+        considered.size() <= 2
+            ? (max_simulations_ - simulation + 1) / 2
+            : std::max<int>(1, num_simulations /
+                                   (num_phases * considered.size()));
+    for (int visit = 0; visit < num_visits && !stop; ++visit) {
+      for (int i : considered) {
+        if (simulation >= max_simulations_) {
+          stop = true;
+          break;
         }
-        if (val > max_value) {
-          max_value = val;
-          chosen_child = &child;
+        Simulate(state, root, &root->children[i], working_state, visit_path);
+        MaybeGarbageCollect(root, simulation);
+        ++simulation;
+        if (!root->outcome.empty() || ShouldStop(*root, simulation)) {
+          stop = true;
+          break;
         }
       }
     }
-
-    working_state->ApplyAction(chosen_child->action);
-    current_node = chosen_child;
-    visit_path->push_back(current_node);
+    sort_considered();
+    if (!stop) considered.resize((considered.size() + 1) / 2);
+  }
+  // A solved root is left to BestChild.
+  if (root->outcome.empty()) {
+    gumbel_action_ = root->children[considered[0]].action;
   }
+}
 
-  return working_state;
+void MCTSBot::MCTSearchInParallel(const State& state, SearchNode* root) {
+  std::atomic<int> num_simulations(root->explore_count);
+  std::atomic<bool> done(false);
+  // Non-overlapping streams, leaving rng_ past them all.
+  std::vector<Xoshiro256PlusPlus> rngs;
+  rngs.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    rngs.push_back(rng_);
+    rng_.Jump();
+  }
+  std::vector<Thread> threads;
+  threads.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    threads.emplace_back([this, &state, root, &rngs, &num_simulations, &done,
+                          t]() {
+      RunSimulations(state, root, &rngs[t], &num_simulations, &done);
+    });
+  }
+  for (Thread& thread : threads) thread.join();
 }
 
-std::unique_ptr<SearchNode> MCTSBot::MCTSearch(const State& state) {
-  Player player_id = state.CurrentPlayer();
-  nodes_ = 1;
-  gc_limit_ = MIN_GC_LIMIT;
-  auto root = std::make_unique<SearchNode>(kInvalidAction, player_id, 1);
-  std::vector<SearchNode*> visit_path;
-  std::vector<double> returns;
-  visit_path.reserve(64);
-  for (int i = 0; i < max_simulations_; ++i) {
-    visit_path.clear();
-    returns.clear();
-
-    std::unique_ptr<State> working_state =
-        ApplyTreePolicy(root.get(), state, &visit_path);
-
-    bool solved;
-    if (working_state->IsTerminal()) {
-      returns = working_state->Returns();
-      visit_path[visit_path.size() - 1]->outcome = returns;
-      solved = solve_;
-    } else {
-      returns = evaluator_->Evaluate(*working_state);
-      solved = false;
-    }
-
-    // Propagate values back.
-    for (auto it = visit_path.rbegin(); it != visit_path.rend(); ++it) {
-      SearchNode* node = *it;
-
-      node->total_reward +=
-          returns[node->player == kChancePlayerId ? player_id : node->player];
-      node->explore_count += 1;
-
-      // Back up solved results as well.
-      if (solved && !node->children.empty()) {
-        Player player = node->children[0].player;
-        if (player == kChancePlayerId) {
-          // Only back up chance nodes if all have the same outcome.
-          // An alternative would be to back up the weighted average of
-          // outcomes if all children are solved, but that is less clear.
-          const std::vector<double>& outcome = node->children[0].outcome;
-          if (!outcome.empty() &&
-              std::all_of(node->children.begin() + 1, node->children.end(),
-                          [&outcome](const SearchNode& c) {
-                            return c.outcome == outcome;
-                          })) {
-            node->outcome = outcome;
-          } else {
-            solved = false;
+void MCTSBot::RunSimulations(const State& state, SearchNode* root,
+                             Xoshiro256PlusPlus* rng,
+                             std::atomic<int>* num_simulations,
+                             std::atomic<bool>* done) {
+  const Player player_id = state.CurrentPlayer();
+  // One visit path and working state per simulation in flight.
+  std::vector<std::vector<SearchNode*>> visit_paths(batch_size_);
+  std::vector<std::unique_ptr<State>> working_states(batch_size_);
+  std::vector<int> pending;  // The simulations waiting for an evaluation.
+  std::vector<const State*> pending_states;
+  std::vector<double> returns(num_players_);
+  while (!*done) {
+    int simulation = 0;
+    {
+      absl::ReaderMutexLock tree_lock(&tree_mutex_);
+      pending.clear();
+      pending_states.clear();
+      for (int i = 0; i < batch_size_ && !*done; ++i) {
+        simulation = (*num_simulations)++;
+        if (simulation >= max_simulations_) {
+          *done = true;
+          break;
+        }
+        std::vector<SearchNode*>& visit_path = visit_paths[i];
+        std::unique_ptr<State>& working_state = working_states[i];
+        visit_path.clear();
+
+        // Recycle the previous simulation's state if the game supports it.
+        if (working_state == nullptr || !working_state->CopyFrom(state)) {
+          working_state = OPEN_SPIEL_PROFILE("mcts/Clone", state.Clone());
+        }
+        ApplyTreePolicyConcurrently(root, working_state.get(), &visit_path,
+                                    rng);
+
+        if (working_state->IsTerminal()) {
+          working_state->Returns(absl::MakeSpan(returns));
+          SearchNode* leaf = visit_path.back();
+          {
+            absl::MutexLock lock(StripeMutex(
+                visit_path.size() > 1 ? visit_path[visit_path.size() - 2]
+                                      : leaf));
+            if (leaf->outcome.empty()) SetOutcome(leaf, returns);
           }
+          BackUpConcurrently(visit_path, returns, solve_, player_id, done);
         } else {
-          // If any have max utility (won?), or all children are solved,
-          // choose the one best for the player choosing.
-          const SearchNode* best = nullptr;
-          bool all_solved = true;
-          for (const SearchNode& child : node->children) {
-            if (child.outcome.empty()) {
-              all_solved = false;
-            } else if (best == nullptr ||
-                       child.outcome[player] > best->outcome[player]) {
-              best = &child;
-            }
-          }
-          if (best != nullptr &&
-              (all_solved || best->outcome[player] == max_utility_)) {
-            node->outcome = best->outcome;
-          } else {
-            solved = false;
-          }
+          pending.push_back(i);
+          pending_states.push_back(working_state.get());
         }
       }
+
+      if (!pending.empty()) {
+        std::vector<std::vector<double>> returns = OPEN_SPIEL_PROFILE(
+            "mcts/EvaluateBatch", evaluator_->EvaluateBatch(pending_states));
+        SPIEL_CHECK_EQ(returns.size(), pending.size());
+        for (int i = 0; i < pending.size(); ++i) {
+          BackUpConcurrently(visit_paths[pending[i]], returns[i],
+                             /*solved=*/false, player_id, done);
+        }
+      }
+
+      absl::MutexLock lock(StripeMutex(root));
+      if (ShouldStop(*root, simulation + 1)) *done = true;
+    }
+    if (GarbageCollectionDue()) {
+      absl::WriterMutexLock tree_lock(&tree_mutex_);
+      MaybeGarbageCollect(root, simulation);
     }
+  }
+}
 
-    if (!root->outcome.empty() ||  // Full game tree is solved.
-        root->children.size() == 1) {
-      break;
-    }
-    if (max_nodes_ > 1 && nodes_ >= max_nodes_) {
-      // Note that actual memory used as counted by ps/top might exceed the
-      // counted value here, possibly by a significant margin (1.5x even!). Part
-      // of that is not counting the outcome array, but most of that is due to
-      // memory fragmentation and is out of our control without writing our own
-      // memory manager.
-      if (verbose_) {
-        std::cerr << absl::StrFormat(
-            ("Approx %d mb in %d nodes after %d sims, garbage collecting with "
-             "limit %d ... "),
-            MemoryUsedMb(nodes_), nodes_, i, gc_limit_);
+void MCTSBot::BackUpConcurrently(const std::vector<SearchNode*>& visit_path,
+                                 const std::vector<double>& returns,
+                                 bool solved, Player player_id,
+                                 std::atomic<bool>* done) {
+  // Propagate values back, replacing the virtual losses.
+  for (int i = visit_path.size() - 1; i >= 0; --i) {
+    SearchNode* node = visit_path[i];
+    std::vector<double> outcome;
+    if (solved) {
+      absl::MutexLock lock(StripeMutex(node));
+      if (!node->children.empty()) {
+        outcome = BackedUpOutcome(*node);
+        solved = !outcome.empty();
       }
-      GarbageCollect(root.get());
-
-      // Slowly increase or decrease to target releasing half the memory.
-      gc_limit_ *= (nodes_ > max_nodes_ / 2 ? 1.25 : 0.9);
-      gc_limit_ = std::max(MIN_GC_LIMIT, gc_limit_);
-      if (verbose_) {
-        std::cerr << absl::StrFormat(
-            "%d mb in %d nodes remaining\n",
-            MemoryUsedMb(nodes_), nodes_);
+    }
+    absl::MutexLock lock(StripeMutex(i > 0 ? visit_path[i - 1] : node));
+    node->total_reward +=
+        returns[node->player == kChancePlayerId ? player_id : node->player] +
+        virtual_loss_;
+    if (!outcome.empty()) SetOutcome(node, std::move(outcome));
+  }
+
+  SearchNode* root = visit_path[0];
+  absl::MutexLock lock(StripeMutex(root));
+  if (!root->outcome.empty() ||  // Full game tree is solved.
+      root->children.size() == 1) {
+    *done = true;
+  }
+}
+
+void MCTSBot::ApplyTreePolicyConcurrently(SearchNode* root,
+                                          State* working_state,
+                                          std::vector<SearchNode*>* visit_path,
+                                          Xoshiro256PlusPlus* rng) {
+  visit_path->push_back(root);
+  SearchNode* current_node = root;
+  // The number of explorations of current_node before this one, including
+  // those in progress.
+  int explore_count;
+  {
+    absl::MutexLock lock(StripeMutex(root));
+    explore_count = root->explore_count++;
+    root->total_reward -= virtual_loss_;
+  }
+  while (!working_state->IsTerminal() && explore_count > 0) {
+    SearchNode* chosen_child;
+    {
+      absl::MutexLock lock(StripeMutex(current_node));
+      if (current_node->children.empty()) {
+        // For a new node, initialize its state, then choose a child as normal.
+        ExpandNode(current_node, *working_state, current_node == root, rng);
       }
+      chosen_child = SelectChild(current_node, explore_count + 1,
+                                 *working_state, rng);
+      // Count this exploration as a loss until it is backed up.
+      explore_count = chosen_child->explore_count++;
+      chosen_child->total_reward -= virtual_loss_;
     }
+    OPEN_SPIEL_PROFILE("mcts/ApplyAction",
+                       working_state->ApplyAction(chosen_child->action));
+    current_node = chosen_child;
+    visit_path->push_back(current_node);
   }
+}
 
-  return root;
+absl::Mutex* MCTSBot::StripeMutex(const SearchNode* node) {
+  return &stripe_mutexes_[std::hash<const SearchNode*>()(node) %
+                          kNumLockStripes];
+}
+
+void MCTSBot::SetOutcome(SearchNode* node, std::vector<double> outcome) {
+  memory_used_ += static_cast<int64_t>(outcome.capacity() * sizeof(double)) -
+                  OutcomeBytes(*node);
+  node->outcome = std::move(outcome);
+}
+
+bool MCTSBot::GarbageCollectionDue() const {
+  return max_memory_ > 0 &&
+         (gc_in_progress_ || memory_used_ >= gc_threshold_);
 }
 
-void MCTSBot::GarbageCollect(SearchNode* node) {
-  if (node->children.empty()) {
-    return;
+MCTSMemoryStats MCTSBot::MemoryStats() const {
+  MCTSMemoryStats stats;
+  stats.bytes = memory_used_;
+  stats.max_bytes = max_memory_;
+  stats.nodes = nodes_;
+  stats.gc_steps = gc_steps_;
+  stats.gc_sweeps = gc_sweeps_;
+  stats.bytes_freed = bytes_freed_;
+  stats.gc_limit = gc_limit_;
+  return stats;
+}
+
+void MCTSBot::MaybeGarbageCollect(SearchNode* root, int num_simulations) {
+  if (!GarbageCollectionDue()) return;
+  // Note that actual memory used as counted by ps/top might exceed the
+  // counted value here, due to the overhead of the allocator and memory
+  // fragmentation, which are out of our control without writing our own
+  // memory manager.
+  if (!gc_in_progress_) {
+    if (verbose_) {
+      std::cerr << absl::StrFormat(
+          ("Approx %d mb in %d nodes after %d sims, garbage collecting with "
+           "limit %d\n"),
+          MemoryUsedMb(memory_used_), nodes_.load(), num_simulations,
+          gc_limit_);
+    }
+    // Each slice visits a fraction of the tree, as it was at the start.
+    gc_budget_ = std::max<int64_t>(kMinGarbageCollectBudget,
+                                   nodes_ / kGarbageCollectSlices);
+    for (SearchNode& child : root->children) gc_stack_.push_back(&child);
+    gc_in_progress_ = true;
   }
-  bool clear_children = node->explore_count < gc_limit_;
-  for (SearchNode& child : node->children) {
-    GarbageCollect(&child);
+  // Past the limit, the rest of the sweep runs now.
+  GarbageCollectStep(memory_used_ >= max_memory_
+                         ? std::numeric_limits<int64_t>::max()
+                         : gc_budget_);
+  if (!gc_stack_.empty()) return;
+  gc_in_progress_ = false;
+  ++gc_sweeps_;
+
+  // Slowly increase or decrease to target releasing half the memory.
+  gc_limit_ *= (memory_used_ > max_memory_ / 2 ? 1.25 : 0.9);
+  gc_limit_ = std::max(MIN_GC_LIMIT, gc_limit_);
+  if (verbose_) {
+    std::cerr << absl::StrFormat(
+        "%d mb in %d nodes remaining after %d sims\n",
+        MemoryUsedMb(memory_used_), nodes_.load(), num_simulations);
   }
-  if (clear_children) {
-    nodes_ -= node->children.capacity();
-    node->children.clear();
-    node->children.shrink_to_fit();  // release the memory
+}
+
+void MCTSBot::GarbageCollectStep(int64_t budget) {
+  ++gc_steps_;
+  // The tree is visited depth first, so the subtree of a pruned node has no
+  // nodes left in gc_stack_. Nodes expanded meanwhile are found when their
+  // parent is visited, as expanding a node does not move the others.
+  for (int64_t visited = 0; visited < budget && !gc_stack_.empty();) {
+    SearchNode* node = gc_stack_.back();
+    gc_stack_.pop_back();
+    if (node->children.empty()) continue;
+    if (node->explore_count < gc_limit_) {
+      const int64_t bytes = ChildrenBytes(*node);
+      const int nodes = CountNodes(*node) - 1;
+      visited += nodes;
+      node->children.clear();
+      node->children.shrink_to_fit();  // release the memory
+      nodes_ -= nodes;
+      memory_used_ -= bytes;
+      bytes_freed_ += bytes;
+    } else {
+      visited += node->children.size();
+      for (SearchNode& child : node->children) {
+        if (!child.children.empty()) gc_stack_.push_back(&child);
+      }
+    }
   }
 }
 
@@ -15,11 +15,22 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <random>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/node_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/opening_book.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/lru_cache.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread.h"
 
 // A vanilla Monte Carlo Tree Search algorithm.
 //
@@ -43,7 +54,8 @@
 // players' rewards. This corresponds to max^n for n-player games. It is the
 // norm for zero-sum games, but doesn't have any special handling for
 // non-zero-sum games. It doesn't have any special handling for imperfect
-// information games.
+// information games: see ISMCTSBot in is_mcts.h for those. It only searches
+// sequential games: see SMMCTSBot in sm_mcts.h for simultaneous-move games.
 //
 // The implementation also supports backing up solved states, i.e. MCTS-Solver.
 // The implementation is general in that it is based on a max^n backup (each
@@ -53,6 +65,76 @@
 // draw games). Also chance nodes are considered proven only if all children
 // have the same value.
 //
+// With num_threads > 1, the simulations are run by several threads on a shared
+// tree (tree parallelization). The children and statistics of the nodes are
+// protected by striped mutexes, and a simulation in progress counts as a visit
+// with a reward of -virtual_loss for every node on its path, so that the
+// threads tend to explore different paths. The result then depends on the
+// scheduling of the threads.
+//
+// With batch_size > 1, each thread keeps up to batch_size simulations in
+// flight: it runs the tree policy for that many simulations, with virtual
+// losses, before evaluating all their leaves with a single call to
+// Evaluator::EvaluateBatch and backing them up. This lets an evaluator like a
+// neural network run on an accelerator at a useful batch size, at the cost of
+// the simulations of a batch not seeing each other's results.
+//
+// With reuse_tree, the tree searched by Step is kept, and the next Step from a
+// later state of the same game continues from the subtree of that state if it
+// was expanded, instead of a new root. The subtree's simulations count towards
+// max_simulations, so fewer new ones are run. The priors of a reused root are
+// not mixed with Dirichlet noise again.
+//
+// With ponder, which requires reuse_tree, Step starts a thread searching the
+// subtree of the chosen action while the other players think, until the bot
+// is called again, informed of an action or restarted. The thread runs the
+// single-threaded search from the root with the chosen child forced, so its
+// simulations are those a later search from that subtree would reuse, which
+// then needs fewer new ones. It stops by itself once the chosen child is
+// solved, has max_simulations simulations or the tree is full. The evaluator
+// is called from the pondering thread, so it must be thread-safe if it is
+// shared with other bots.
+//
+// With max_memory_mb > 0, the bytes allocated for the nodes of the tree and
+// their outcomes are counted, and once they reach three quarters of the
+// limit the garbage collector sweeps the tree incrementally, a slice of it
+// after each simulation, pruning the subtrees of the nodes explored fewer
+// times than a limit adapted to free about half the memory per sweep. If the
+// tree reaches max_memory_mb before the sweep is done, the rest of the sweep
+// runs at once. MemoryStats reports the memory use and the collections.
+//
+// With max_seconds > 0, the search also stops after that many seconds of wall
+// time. With stop_early, it stops as soon as the most explored child of the
+// root is ahead of every other by more than the simulations left, estimated
+// from the search speed so far with a time budget, as further simulations
+// could not change the chosen action. This only applies while none of the
+// root's children is solved.
+//
+// With use_transpositions, the nodes of the same position, as identified by
+// State::Hash, share their rewards: a child is selected using the mean reward
+// of all the simulations that went through its position by any path, while
+// the exploration term still uses its own explore count. This only helps in
+// games where Hash identifies positions rather than histories, like
+// connect_four, hex, breakthrough or chess. The table of positions uses at
+// most a quarter of max_memory_mb, after which new positions are not shared,
+// and the tree the rest.
+// It is only supported by the single-threaded, unbatched search.
+//
+// With gumbel_num_actions > 0, the actions of the root are chosen with the
+// sequential halving of Gumbel MuZero rather than the child selection policy,
+// which makes better use of small simulation budgets: gumbel_num_actions
+// actions are sampled without replacement from the prior, then the budget is
+// split into rounds which visit each remaining action equally and keep the
+// better half of them, ranked by their Gumbel-perturbed prior logit plus a
+// value term that grows with the visit counts. The last one is the chosen
+// action, rather than the most explored. The other nodes still use the child
+// selection policy. It is only supported by the single-threaded, unbatched
+// search, without stop_early.
+//
+// With an opening book, set by SetOpeningBook, Step plays a move of the book
+// instead of searching the positions it has, sampled in proportion to their
+// weights, and drops the tree kept for reuse.
+//
 // Some references:
 // - Sturtevant, An Analysis of UCT in Multi-Player Games,  2008,
 //   https://web.cs.du.edu/~sturtevant/papers/multi-player_UCT.pdf
@@ -62,6 +144,8 @@
 //   https://deepmind.com/blog/article/alphago-zero-starting-scratch
 // - Winands, Bjornsson, and Saito, Monte-Carlo Tree Search Solver, 2008.
 //   https://dke.maastrichtuniversity.nl/m.winands/documents/uctloa.pdf
+// - Danihelka, Guez, Schrittwieser, and Silver, Policy improvement by planning
+//   with Gumbel, 2022. https://openreview.net/forum?id=bERaNdoegnO
 
 namespace open_spiel {
 namespace algorithms {
@@ -75,6 +159,9 @@ enum class ChildSelectionPolicy {
 // The evaluation function takes in an intermediate state in the game and
 // returns an evaluation of that state, which should correlate with chances of
 // winning the game for player 0.
+//
+// With an MCTSBot using several threads, Evaluate, EvaluateBatch and Prior are
+// called concurrently, so they must be thread-safe.
 class Evaluator {
  public:
   virtual ~Evaluator() = default;
@@ -82,6 +169,18 @@ class Evaluator {
   // Return a value of this state for each player.
   virtual std::vector<double> Evaluate(const State& state) = 0;
 
+  // Return the values of several states, e.g. in a single batch on an
+  // accelerator. Defaults to calling Evaluate on each state in turn.
+  //
+  // MCTSBot usually evaluates a node (with EvaluateBatch when searching in
+  // batches) before asking for its Prior, so an evaluator computing the values
+  // and priors together can keep the priors of the batch for the Prior calls.
+  // This is not guaranteed: with several threads or batches in flight, a node
+  // can be expanded while its evaluation is still pending, so Prior must
+  // still work for a state it has not evaluated.
+  virtual std::vector<std::vector<double>> EvaluateBatch(
+      absl::Span<const State* const> states);
+
   // Return a policy: the probability of the current player playing each action.
   virtual ActionsAndProbs Prior(const State& state) = 0;
 };
@@ -89,10 +188,20 @@ class Evaluator {
 // A simple evaluator that returns the average outcome of playing random actions
 // from the given state until the end of the game.
 // n_rollouts is the number of random outcomes to be considered.
+// Concurrent calls to Evaluate roll out with their own random engine, seeded
+// from the evaluator's, rather than waiting for each other.
+//
+// With num_threads > 1, the rollouts of an Evaluate call are split between
+// that many threads, each with its own random engine. The threads are started
+// for every call, so this only pays off for long or many rollouts.
 class RandomRolloutEvaluator : public Evaluator {
  public:
-  explicit RandomRolloutEvaluator(int n_rollouts, int seed)
-      : n_rollouts_(n_rollouts), rng_(seed) {}
+  explicit RandomRolloutEvaluator(int n_rollouts, int seed,
+                                  int num_threads = 1)
+      : n_rollouts_(n_rollouts),
+        num_threads_(num_threads),
+        rng_(seed),
+        seed_rng_(seed) {}
 
   // Runs random games, returning the average returns.
   std::vector<double> Evaluate(const State& state) override;
@@ -101,8 +210,59 @@ class RandomRolloutEvaluator : public Evaluator {
   ActionsAndProbs Prior(const State& state) override;
 
  private:
+  // Returns the sum of the returns of n_rollouts random games from `state`.
+  std::vector<double> SumOfRollouts(const State& state, int n_rollouts,
+                                    SplitMix64* rng) const;
+
   int n_rollouts_;
-  std::mt19937 rng_;
+  int num_threads_;
+  absl::Mutex rng_mutex_;
+  SplitMix64 rng_;
+  absl::Mutex seed_mutex_;
+  SplitMix64 seed_rng_;
+};
+
+// Wraps an evaluator, caching the results of its Evaluate and Prior by
+// State::Hash, so that it is called once per distinct position while the
+// position stays cached, e.g. on the positions revisited by later searches or
+// reached by several move orders. Each cache holds up to cache_size states in
+// a ShardedLRUCache, so concurrent calls rarely wait for each other, and
+// EvaluateBatch only passes the states missing from the cache on to the
+// wrapped evaluator. It is thread-safe if the wrapped evaluator is.
+//
+// The hash must determine the results: the default hash of the history
+// always does, but the hash of a position does not for evaluators that use
+// the history. Caching a random evaluator, like RandomRolloutEvaluator, keeps
+// its first result for each position. The two caches are separate, so the
+// wrapped evaluator can be asked for the Prior of a state whose values came
+// from the cache.
+class CachingEvaluator : public Evaluator {
+ public:
+  // Only keeps a pointer to `evaluator`, which must outlive it.
+  CachingEvaluator(Evaluator* evaluator, int cache_size,
+                   int cache_shards = 16);
+
+  std::vector<double> Evaluate(const State& state) override;
+  std::vector<std::vector<double>> EvaluateBatch(
+      absl::Span<const State* const> states) override;
+  ActionsAndProbs Prior(const State& state) override;
+
+  // The hits, misses and sizes of the caches of the values and of the priors.
+  LRUCacheInfo ValueCacheInfo() { return values_.Info(); }
+  LRUCacheInfo PriorCacheInfo() { return priors_.Info(); }
+
+  void ClearCache();
+
+ private:
+  Evaluator* evaluator_;
+  ShardedLRUCache<uint64_t, std::vector<double>> values_;
+  ShardedLRUCache<uint64_t, ActionsAndProbs> priors_;
+};
+
+// The statistics shared by the search nodes of a position.
+struct Transposition {
+  int explore_count = 0;              // Number of times it was explored.
+  std::vector<double> total_rewards;  // Total reward of each player.
 };
 
 // A node in the search tree for MCTS
@@ -114,6 +274,8 @@ struct SearchNode {
   double total_reward = 0;      // Total reward passing through this node.
   std::vector<double> outcome;  // The reward if each players plays perfectly.
   std::vector<SearchNode> children;  // The successors to this state.
+  // The statistics of this position, with use_transpositions, once explored.
+  Transposition* transposition = nullptr;
 
   SearchNode() {}
 
@@ -136,6 +298,19 @@ struct SearchNode {
   std::string ChildrenStr(const State& state) const;
 };
 
+// The memory use of the tree of an MCTSBot and the work of its garbage
+// collector, since the bot was created.
+struct MCTSMemoryStats {
+  int64_t bytes = 0;      // Allocated for the current tree.
+  int64_t max_bytes = 0;  // The limit of the tree, or 0 for none.
+  int nodes = 0;          // In the current tree.
+  int64_t gc_steps = 0;   // Slices of sweeps run.
+  int64_t gc_sweeps = 0;  // Sweeps completed.
+  int64_t bytes_freed = 0;
+  // The nodes explored fewer times have their children pruned.
+  int gc_limit = 0;
+};
+
 // A SpielBot that uses the MCTS algorithm as its policy.
 class MCTSBot : public Bot {
  public:
@@ -146,11 +321,20 @@ class MCTSBot : public Bot {
       bool solve,             // Whether to back up solved states.
       int seed, bool verbose,
       ChildSelectionPolicy child_selection_policy = ChildSelectionPolicy::UCT,
-      double dirichlet_alpha = 0, double dirichlet_epsilon = 0);
-  ~MCTSBot() = default;
+      double dirichlet_alpha = 0, double dirichlet_epsilon = 0,
+      int num_threads = 1, double virtual_loss = 1, int batch_size = 1,
+      bool reuse_tree = false, double max_seconds = 0,
+      bool stop_early = false, bool use_transpositions = false,
+      int gumbel_num_actions = 0, bool ponder = false);
+  ~MCTSBot() override { StopPondering(); }
 
-  void Restart() override {}
-  void RestartAt(const State& state) override {}
+  // Both drop the tree kept for reuse.
+  void Restart() override { ClearTree(); }
+  void RestartAt(const State& state) override { ClearTree(); }
+  // Stops pondering and keeps only the subtree of `action`, if the tree is
+  // kept for reuse.
+  void InformAction(const State& state, Player player_id,
+                    Action action) override;
   // Run MCTS for one step, choosing the action, and printing some information.
   Action Step(const State& state) override;
 
@@ -160,10 +344,65 @@ class MCTSBot : public Bot {
   std::pair<ActionsAndProbs, Action> StepWithPolicy(
       const State& state) override;
 
-  // Run MCTS on a given state, and return the resulting search tree.
+  // Run MCTS on a given state, and return the resulting search tree. With
+  // reuse_tree, the search starts from the subtree of the tree kept by the last
+  // Step, if any.
   std::unique_ptr<SearchNode> MCTSearch(const State& state);
 
+  // The number of simulations run by the last search, not counting those of a
+  // reused subtree.
+  int NumSimulations() const { return num_simulations_; }
+
+  // The number of positions in the transposition table.
+  int NumTranspositions() const { return transpositions_.size(); }
+
+  MCTSMemoryStats MemoryStats() const;
+
+  // The number of simulations run by the current or last pondering.
+  int NumPonderSimulations() const { return num_ponder_simulations_; }
+
+  // Stops pondering, if the bot is, and waits for the thread to finish.
+  void StopPondering();
+
+  // Consults `book`, which must outlive the bot, before searching, or no book
+  // if nullptr.
+  void SetOpeningBook(const OpeningBook* book) { opening_book_ = book; }
+
  private:
+  // Returns the subtree of tree_ for `state`, as a root, or a new root if it
+  // cannot be reused. Releases the rest of tree_.
+  std::unique_ptr<SearchNode> TakeRoot(const State& state);
+  void ClearTree();
+
+  // Starts pondering on the child of tree_ for `action`, where `state` is the
+  // state of tree_.
+  void StartPondering(const State& state, Action action);
+
+  // Returns the shared statistics of `state`, or nullptr if the table is full.
+  Transposition* FindTransposition(const State& state);
+
+  // Starts the clock of a search from `root`.
+  void StartSearch(const SearchNode& root);
+
+  // Returns whether to stop the search given that the simulation count of
+  // the root reached `num_simulations`. The root's stats must not change
+  // meanwhile.
+  bool ShouldStop(const SearchNode& root, int num_simulations) const;
+
+  // Runs a simulation from `root`, going to `root_child` first if not null,
+  // and backs it up. working_state and visit_path are reused between calls.
+  void Simulate(const State& state, SearchNode* root, SearchNode* root_child,
+                std::unique_ptr<State>* working_state,
+                std::vector<SearchNode*>* visit_path);
+
+  // The search loop with the Gumbel root selection, which sets gumbel_action_.
+  void GumbelSearch(const State& state, SearchNode* root,
+                    std::unique_ptr<State>* working_state,
+                    std::vector<SearchNode*>* visit_path);
+
+  // Returns the child of the root to play after a search.
+  const SearchNode& ChosenChild(const SearchNode& root) const;
+
   // Applies the UCT policy to play the game until reaching a leaf node.
   //
   // A leaf node is defined as a node that is terminal or has not been evaluated
@@ -172,34 +411,131 @@ class MCTSBot : public Bot {
   //
   // Args:
   //   root: The root node in the search tree.
-  //   state: The state of the game at the root node.
+  //   working_state: The state of the game at the root node. It is advanced
+  //     in place, and holds the state of the game at the leaf node on return.
   //   visit_path: A vector of nodes to be filled in descending from the root
   //     node to a leaf node.
-  //
-  // Returns: The state of the game at the leaf node.
-  std::unique_ptr<State> ApplyTreePolicy(SearchNode* root, const State& state,
-                                         std::vector<SearchNode*>* visit_path);
+  //   root_child: The child of the root to go to, or nullptr to select one.
+  void ApplyTreePolicy(SearchNode* root, State* working_state,
+                       std::vector<SearchNode*>* visit_path,
+                       SearchNode* root_child = nullptr);
+
+  // Adds the children of `node`, whose state is `state`, with their priors.
+  void ExpandNode(SearchNode* node, const State& state, bool is_root,
+                  Xoshiro256PlusPlus* rng);
+
+  // Returns the child of `node` to explore, given the number of times `node`
+  // was explored.
+  SearchNode* SelectChild(SearchNode* node, int explore_count,
+                          const State& state, Xoshiro256PlusPlus* rng) const;
+
+  // Returns the outcome of `node` backed up from its children if it is solved,
+  // or an empty vector.
+  std::vector<double> BackedUpOutcome(const SearchNode& node) const;
+
+  // The multi-threaded or batched versions of MCTSearch and ApplyTreePolicy,
+  // and the backup of a simulation given the returns at its leaf. The stats
+  // (explore_count, total_reward and outcome) of a node are guarded by the
+  // stripe mutex of its parent, or of itself for the root, and its children
+  // vector by its own stripe mutex. At most one stripe mutex is held at a
+  // time. MaybeGarbageCollect holds tree_mutex_ exclusively.
+  void MCTSearchInParallel(const State& state, SearchNode* root);
+  void RunSimulations(const State& state, SearchNode* root,
+                      Xoshiro256PlusPlus* rng,
+                      std::atomic<int>* num_simulations,
+                      std::atomic<bool>* done);
+  void ApplyTreePolicyConcurrently(SearchNode* root, State* working_state,
+                                   std::vector<SearchNode*>* visit_path,
+                                   Xoshiro256PlusPlus* rng);
+  void BackUpConcurrently(const std::vector<SearchNode*>& visit_path,
+                          const std::vector<double>& returns, bool solved,
+                          Player player_id, std::atomic<bool>* done);
+  absl::Mutex* StripeMutex(const SearchNode* node);
+
+  // Sets the outcome of `node`, counting its memory.
+  void SetOutcome(SearchNode* node, std::vector<double> outcome);
 
-  void GarbageCollect(SearchNode* node);
+  // Returns whether MaybeGarbageCollect has work to do.
+  bool GarbageCollectionDue() const;
+
+  // Starts a sweep of the tree from `root` if it uses too much memory, and
+  // runs the next slice of the sweep in progress, if any.
+  void MaybeGarbageCollect(SearchNode* root, int num_simulations);
+
+  // Prunes or descends into the nodes of the sweep until `budget` children
+  // were visited.
+  void GarbageCollectStep(int64_t budget);
 
   double uct_c_;
   int max_simulations_;
-  int max_nodes_;  // Max nodes allowed in the tree
-  int nodes_;  // Nodes used in the tree.
+  int64_t max_memory_;    // Max bytes of the tree, or 0 for no limit.
+  int64_t gc_threshold_;  // The bytes from which sweeps start.
+  std::atomic<int> nodes_;  // Nodes used in the tree.
+  std::atomic<int64_t> memory_used_;  // Bytes used by the tree.
   int gc_limit_;
+  // The nodes left to visit by the sweep in progress, the children it visits
+  // per slice, and whether it is in progress, readable without tree_mutex_.
+  std::vector<SearchNode*> gc_stack_;
+  int64_t gc_budget_ = 0;
+  std::atomic<bool> gc_in_progress_{false};
+  int64_t gc_steps_ = 0;
+  int64_t gc_sweeps_ = 0;
+  int64_t bytes_freed_ = 0;
   bool verbose_;
   bool solve_;
   double max_utility_;
+  double min_utility_;
   double dirichlet_alpha_;
   double dirichlet_epsilon_;
-  std::mt19937 rng_;
+  Xoshiro256PlusPlus rng_;
   const ChildSelectionPolicy child_selection_policy_;
   Evaluator* evaluator_;
+  const int num_threads_;
+  const double virtual_loss_;
+  const int batch_size_;
+  const bool reuse_tree_;
+  const double max_seconds_;
+  const bool stop_early_;
+  const bool use_transpositions_;
+  const int gumbel_num_actions_;
+  const int num_players_;
+  const OpeningBook* opening_book_ = nullptr;
+
+  // The positions searched since the tree was last built from scratch, by
+  // hash, with their maximum number.
+  absl::node_hash_map<uint64_t, Transposition> transpositions_;
+  int max_transpositions_;
+
+  // The current or last search: when it started and must end, the root's
+  // simulation count at the start, and the number of simulations it ran.
+  absl::Time search_start_;
+  absl::Time deadline_;
+  int initial_simulations_ = 0;
+  int num_simulations_ = 0;
+  // The action chosen by the Gumbel root selection, if any.
+  Action gumbel_action_ = kInvalidAction;
+
+  // The tree searched by the last Step and the history of its root, if
+  // reuse_tree_.
+  std::unique_ptr<SearchNode> tree_;
+  std::vector<Action> tree_history_;
+
+  // The pondering thread, if any, and the state of tree_ it searches from.
+  const bool ponder_;
+  std::unique_ptr<Thread> ponder_thread_;
+  std::unique_ptr<State> ponder_state_;
+  std::atomic<bool> stop_pondering_{false};
+  std::atomic<int> num_ponder_simulations_{0};
+
+  static inline constexpr int kNumLockStripes = 64;
+  absl::Mutex tree_mutex_;
+  absl::Mutex stripe_mutexes_[kNumLockStripes];
 };
 
 // Returns a vector of noise sampled from a dirichlet distribution. See:
 // https://en.wikipedia.org/wiki/Dirichlet_process
-std::vector<double> dirichlet_noise(int count, double alpha, std::mt19937* rng);
+std::vector<double> dirichlet_noise(int count, double alpha,
+                                    Xoshiro256PlusPlus* rng);
 
 }  // namespace algorithms
 }  // namespace open_spiel
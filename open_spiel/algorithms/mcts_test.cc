@@ -14,10 +14,16 @@
 
 #include "open_spiel/algorithms/mcts.h"
 
+#include <atomic>
+#include <cmath>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
@@ -88,7 +94,8 @@ open_spiel::Action GetAction(const open_spiel::State& state,
 }
 
 std::pair<std::unique_ptr<algorithms::SearchNode>, std::unique_ptr<State>>
-SearchTicTacToeState(const absl::string_view initial_actions) {
+SearchTicTacToeState(const absl::string_view initial_actions,
+                     int num_threads = 1, int batch_size = 1) {
   auto game = LoadGame("tic_tac_toe");
   std::unique_ptr<State> state = game->NewInitialState();
   for (const auto& action_str : absl::StrSplit(initial_actions, ' ')) {
@@ -100,7 +107,13 @@ SearchTicTacToeState(const absl::string_view initial_actions) {
                           /*max_memory_mb=*/ 10,
                           /*solve=*/ true,
                           /*seed=*/ 42,
-                          /*verbose=*/ false);
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          num_threads,
+                          /*virtual_loss=*/ 1,
+                          batch_size);
   return {bot.MCTSearch(*state), std::move(state)};
 }
 
@@ -126,8 +139,9 @@ void MCTSTest_SolveLoss() {
     SPIEL_CHECK_EQ(c.outcome[c.player], -1);  // All losses.
 }
 
-void MCTSTest_SolveWin() {
-  auto [root, state] = SearchTicTacToeState("x(0,1) o(2,2)");
+void MCTSTest_SolveWin(int num_threads, int batch_size) {
+  auto [root, state] =
+      SearchTicTacToeState("x(0,1) o(2,2)", num_threads, batch_size);
   SPIEL_CHECK_EQ(state->ToString(), ".x.\n...\n..o");
   SPIEL_CHECK_EQ(root->outcome[root->player], 1);
   const algorithms::SearchNode& best = root->BestChild();
@@ -150,6 +164,451 @@ void MCTSTest_GarbageCollect() {
                    root->explore_count == 1000000);
 }
 
+// The bytes of the nodes below `node` and of their outcomes.
+int64_t SubtreeBytes(const algorithms::SearchNode& node) {
+  int64_t bytes = node.children.capacity() * sizeof(algorithms::SearchNode);
+  for (const algorithms::SearchNode& child : node.children) {
+    bytes += child.outcome.capacity() * sizeof(double) + SubtreeBytes(child);
+  }
+  return bytes;
+}
+
+// The tree is kept within the limit, and its memory is counted exactly.
+void MCTSTest_MemoryStats(int num_threads) {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(1, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 100000,
+                          /*max_memory_mb=*/ 1,
+                          /*solve=*/ false,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          num_threads);
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  const algorithms::MCTSMemoryStats stats = bot.MemoryStats();
+  SPIEL_CHECK_EQ(stats.max_bytes, 1 << 20);
+  SPIEL_CHECK_EQ(stats.bytes, sizeof(algorithms::SearchNode) +
+                                  root->outcome.capacity() * sizeof(double) +
+                                  SubtreeBytes(*root));
+  // A simulation expands at most a node, so the limit is barely exceeded.
+  SPIEL_CHECK_LE(stats.bytes, stats.max_bytes +
+                                  num_threads * 9 *
+                                      sizeof(algorithms::SearchNode));
+  SPIEL_CHECK_GT(stats.gc_sweeps, 0);
+  SPIEL_CHECK_GE(stats.gc_steps, stats.gc_sweeps);
+  SPIEL_CHECK_GT(stats.bytes_freed, 0);
+  SPIEL_CHECK_GE(stats.gc_limit, 5);
+}
+
+// All the simulations are counted once, and the virtual losses are removed.
+void MCTSTest_ParallelSearch() {
+  auto game = LoadGame("pig(players=3,winscore=20,horizon=30)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(5, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 2000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ true,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          /*num_threads=*/ 4);
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 2000);
+  int children_explore_count = 0;
+  for (const algorithms::SearchNode& child : root->children) {
+    children_explore_count += child.explore_count;
+    // Returns are in [-1, 1].
+    SPIEL_CHECK_LE(std::abs(child.total_reward), child.explore_count);
+  }
+  SPIEL_CHECK_EQ(children_explore_count, 2000 - 1);
+}
+
+// Records the sizes of the batches it evaluates.
+class BatchSizeRecordingEvaluator : public algorithms::RandomRolloutEvaluator {
+ public:
+  BatchSizeRecordingEvaluator(int n_rollouts, int seed)
+      : RandomRolloutEvaluator(n_rollouts, seed) {}
+
+  std::vector<std::vector<double>> EvaluateBatch(
+      absl::Span<const State* const> states) override {
+    batch_sizes_.push_back(states.size());
+    return RandomRolloutEvaluator::EvaluateBatch(states);
+  }
+
+  const std::vector<int>& batch_sizes() const { return batch_sizes_; }
+
+ private:
+  std::vector<int> batch_sizes_;
+};
+
+// The leaves are evaluated in batches of up to batch_size states.
+void MCTSTest_BatchedSearch() {
+  auto game = LoadGame("pig(players=3,winscore=20,horizon=30)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  BatchSizeRecordingEvaluator evaluator(5, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 2000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ true,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          /*num_threads=*/ 1,
+                          /*virtual_loss=*/ 1,
+                          /*batch_size=*/ 16);
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 2000);
+  int children_explore_count = 0;
+  for (const algorithms::SearchNode& child : root->children) {
+    children_explore_count += child.explore_count;
+    SPIEL_CHECK_LE(std::abs(child.total_reward), child.explore_count);
+  }
+  SPIEL_CHECK_EQ(children_explore_count, 2000 - 1);
+
+  const std::vector<int>& batch_sizes = evaluator.batch_sizes();
+  int num_evaluations = 0;
+  for (int batch_size : batch_sizes) {
+    SPIEL_CHECK_GE(batch_size, 1);
+    SPIEL_CHECK_LE(batch_size, 16);
+    num_evaluations += batch_size;
+  }
+  SPIEL_CHECK_LE(num_evaluations, 2000);
+  // Only the simulations reaching a terminal state are not in a batch.
+  SPIEL_CHECK_GT(num_evaluations, 12 * batch_sizes.size());
+}
+
+// Counts the states it evaluates.
+class CountingEvaluator : public algorithms::RandomRolloutEvaluator {
+ public:
+  CountingEvaluator(int n_rollouts, int seed)
+      : RandomRolloutEvaluator(n_rollouts, seed) {}
+
+  std::vector<double> Evaluate(const State& state) override {
+    ++num_evaluations_;
+    return RandomRolloutEvaluator::Evaluate(state);
+  }
+
+  int num_evaluations() const { return num_evaluations_; }
+
+ private:
+  std::atomic<int> num_evaluations_ = 0;
+};
+
+// The subtree of the state after the moves is reused, so the next search runs
+// fewer simulations. Only Step keeps the tree, and restarting drops it.
+void MCTSTest_ReuseTree(int num_threads) {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  CountingEvaluator evaluator(1, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 1000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ false,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          num_threads,
+                          /*virtual_loss=*/ 1,
+                          /*batch_size=*/ 1,
+                          /*reuse_tree=*/ true);
+  state->ApplyAction(bot.Step(*state));
+  state->ApplyAction(state->LegalActions()[0]);
+  int num_evaluations = evaluator.num_evaluations();
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 1000);
+  SPIEL_CHECK_EQ(root->player, state->CurrentPlayer());
+  SPIEL_CHECK_EQ(root->children.size(), state->LegalActions().size());
+  SPIEL_CHECK_LT(evaluator.num_evaluations() - num_evaluations, 1000);
+
+  // The search from the root of the last Step has nothing left to do.
+  bot.Step(*state);
+  num_evaluations = evaluator.num_evaluations();
+  root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 1000);
+  SPIEL_CHECK_EQ(evaluator.num_evaluations(), num_evaluations);
+
+  // The tree was taken by MCTSearch.
+  root = bot.MCTSearch(*state);
+  SPIEL_CHECK_GT(evaluator.num_evaluations(), num_evaluations);
+
+  bot.Step(*state);
+  bot.Restart();
+  num_evaluations = evaluator.num_evaluations();
+  bot.MCTSearch(*state);
+  SPIEL_CHECK_GT(evaluator.num_evaluations(), num_evaluations);
+}
+
+// The simulations run while the opponent thinks are reused by the next Step.
+void MCTSTest_Ponder() {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  CountingEvaluator evaluator(1, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 1000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ false,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          /*num_threads=*/ 1,
+                          /*virtual_loss=*/ 1,
+                          /*batch_size=*/ 1,
+                          /*reuse_tree=*/ true,
+                          /*max_seconds=*/ 0,
+                          /*stop_early=*/ false,
+                          /*use_transpositions=*/ false,
+                          /*gumbel_num_actions=*/ 0,
+                          /*ponder=*/ true);
+  state->ApplyAction(bot.Step(*state));
+  // Pondering stops by itself once the chosen child has max_simulations.
+  absl::SleepFor(absl::Milliseconds(200));
+  const Action reply = state->LegalActions()[0];
+  bot.InformAction(*state, state->CurrentPlayer(), reply);
+  SPIEL_CHECK_GT(bot.NumPonderSimulations(), 0);
+  state->ApplyAction(reply);
+  state->ApplyAction(bot.Step(*state));
+  SPIEL_CHECK_LT(bot.NumSimulations(), 1000);
+
+  // The bot can be restarted and destroyed while pondering.
+  bot.Restart();
+  state = game->NewInitialState();
+  state->ApplyAction(bot.Step(*state));
+}
+
+// Each distinct position is evaluated once, in Evaluate and EvaluateBatch.
+void MCTSTest_CachingEvaluator() {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  CountingEvaluator evaluator(1, 42);
+  algorithms::CachingEvaluator cache(&evaluator, /*cache_size=*/ 1000);
+  const std::vector<double> values = cache.Evaluate(*state);
+  SPIEL_CHECK_TRUE(cache.Evaluate(*state) == values);
+  SPIEL_CHECK_EQ(evaluator.num_evaluations(), 1);
+  SPIEL_CHECK_EQ(cache.ValueCacheInfo().hits, 1);
+  SPIEL_CHECK_EQ(cache.ValueCacheInfo().misses, 1);
+  SPIEL_CHECK_EQ(cache.Prior(*state).size(), 9);
+  SPIEL_CHECK_EQ(cache.Prior(*state).size(), 9);
+  SPIEL_CHECK_EQ(cache.PriorCacheInfo().hits, 1);
+
+  std::unique_ptr<State> child = state->Child(4);
+  std::vector<const State*> batch = {state.get(), child.get(), child.get()};
+  std::vector<std::vector<double>> batch_values = cache.EvaluateBatch(batch);
+  SPIEL_CHECK_EQ(batch_values.size(), 3);
+  SPIEL_CHECK_TRUE(batch_values[0] == values);
+  SPIEL_CHECK_TRUE(batch_values[1] == batch_values[2]);
+  SPIEL_CHECK_EQ(evaluator.num_evaluations(), 3);
+  SPIEL_CHECK_TRUE(cache.Evaluate(*child) == batch_values[1]);
+  SPIEL_CHECK_EQ(evaluator.num_evaluations(), 3);
+
+  cache.ClearCache();
+  cache.Evaluate(*state);
+  SPIEL_CHECK_EQ(evaluator.num_evaluations(), 4);
+
+  // A search calls the wrapped evaluator at most once per position.
+  cache.ClearCache();
+  algorithms::MCTSBot bot(*game, &cache, UCT_C, /*max_simulations=*/ 1000,
+                          /*max_memory_mb=*/ 10, /*solve=*/ true,
+                          /*seed=*/ 42, /*verbose=*/ false);
+  const int num_evaluations = evaluator.num_evaluations();
+  bot.Step(*state);
+  SPIEL_CHECK_EQ(evaluator.num_evaluations() - num_evaluations,
+                 cache.ValueCacheInfo().misses);
+  SPIEL_CHECK_GT(cache.ValueCacheInfo().hits, 0);
+}
+
+// The search stops at the deadline, long before max_simulations.
+void MCTSTest_TimeBudget(int num_threads) {
+  auto game = LoadGame("pig(players=3,winscore=20,horizon=30)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(1, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 1000000000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ false,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          num_threads,
+                          /*virtual_loss=*/ 1,
+                          /*batch_size=*/ 1,
+                          /*reuse_tree=*/ false,
+                          /*max_seconds=*/ 0.2);
+  absl::Time start = absl::Now();
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_LT(absl::ToDoubleSeconds(absl::Now() - start), 10);
+  SPIEL_CHECK_GT(bot.NumSimulations(), 0);
+  SPIEL_CHECK_EQ(bot.NumSimulations(), root->explore_count);
+}
+
+// The search stops once the best move is decided, and still finds it.
+void MCTSTest_StopEarly() {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (const auto& action_str : {"x(0,1)", "o(2,2)"}) {
+    state->ApplyAction(GetAction(*state, action_str));
+  }
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(20, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 10000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ false,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          /*num_threads=*/ 1,
+                          /*virtual_loss=*/ 1,
+                          /*batch_size=*/ 1,
+                          /*reuse_tree=*/ false,
+                          /*max_seconds=*/ 0,
+                          /*stop_early=*/ true);
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_LT(bot.NumSimulations(), 10000);
+  const algorithms::SearchNode& best = root->BestChild();
+  SPIEL_CHECK_EQ(state->ActionToString(best.player, best.action), "x(0,2)");
+}
+
+// With a small budget, sequential halving at the root uses every simulation
+// and still finds the winning move.
+void MCTSTest_GumbelRootSelection() {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (const auto& action_str : {"x(0,0)", "o(1,1)", "x(0,1)", "o(2,2)"}) {
+    state->ApplyAction(GetAction(*state, action_str));
+  }
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(20, 42);
+  for (int seed = 0; seed < 10; ++seed) {
+    algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                            /*max_simulations=*/ 50,
+                            /*max_memory_mb=*/ 10,
+                            /*solve=*/ false,
+                            /*seed=*/ seed,
+                            /*verbose=*/ false,
+                            algorithms::ChildSelectionPolicy::PUCT,
+                            /*dirichlet_alpha=*/ 0,
+                            /*dirichlet_epsilon=*/ 0,
+                            /*num_threads=*/ 1,
+                            /*virtual_loss=*/ 1,
+                            /*batch_size=*/ 1,
+                            /*reuse_tree=*/ false,
+                            /*max_seconds=*/ 0,
+                            /*stop_early=*/ false,
+                            /*use_transpositions=*/ false,
+                            /*gumbel_num_actions=*/ 16);
+    Action action = bot.Step(*state);
+    SPIEL_CHECK_EQ(state->ActionToString(state->CurrentPlayer(), action),
+                   "x(0,2)");
+    SPIEL_CHECK_EQ(bot.NumSimulations(), 50);
+  }
+}
+
+int NumExploredNodes(const algorithms::SearchNode& node) {
+  int num_nodes = node.explore_count > 0;
+  for (const algorithms::SearchNode& child : node.children) {
+    num_nodes += NumExploredNodes(child);
+  }
+  return num_nodes;
+}
+
+// Positions reached by several move orders share a single entry, and the
+// search still finds the winning move.
+void MCTSTest_Transpositions() {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (const auto& action_str : {"x(0,1)", "o(2,2)"}) {
+    state->ApplyAction(GetAction(*state, action_str));
+  }
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(20, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 10000,
+                          /*max_memory_mb=*/ 10,
+                          /*solve=*/ true,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          /*num_threads=*/ 1,
+                          /*virtual_loss=*/ 1,
+                          /*batch_size=*/ 1,
+                          /*reuse_tree=*/ false,
+                          /*max_seconds=*/ 0,
+                          /*stop_early=*/ false,
+                          /*use_transpositions=*/ true);
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->outcome[root->player], 1);
+  const algorithms::SearchNode& best = root->BestChild();
+  SPIEL_CHECK_EQ(state->ActionToString(best.player, best.action), "x(0,2)");
+  SPIEL_CHECK_GT(bot.NumTranspositions(), 0);
+  // The root has no entry.
+  SPIEL_CHECK_LT(bot.NumTranspositions(), NumExploredNodes(*root) - 1);
+
+  // Connect four has many more transpositions.
+  game = LoadGame("connect_four");
+  algorithms::MCTSBot connect_four_bot(
+      *game, &evaluator, UCT_C, /*max_simulations=*/ 2000,
+      /*max_memory_mb=*/ 10, /*solve=*/ true, /*seed=*/ 42,
+      /*verbose=*/ false, algorithms::ChildSelectionPolicy::UCT,
+      /*dirichlet_alpha=*/ 0, /*dirichlet_epsilon=*/ 0, /*num_threads=*/ 1,
+      /*virtual_loss=*/ 1, /*batch_size=*/ 1, /*reuse_tree=*/ false,
+      /*max_seconds=*/ 0, /*stop_early=*/ false,
+      /*use_transpositions=*/ true);
+  state = game->NewInitialState();
+  root = connect_four_bot.MCTSearch(*state);
+  SPIEL_CHECK_EQ(root->explore_count, 2000);
+  SPIEL_CHECK_LT(connect_four_bot.NumTranspositions(),
+                 NumExploredNodes(*root) - 1);
+}
+
+// Random tic-tac-toe games are won by x about 58% of the time and by o about
+// 29% of the time.
+void MCTSTest_RandomRolloutEvaluator(int num_threads) {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  algorithms::RandomRolloutEvaluator evaluator(4000, 42, num_threads);
+  algorithms::RandomRolloutEvaluator other_evaluator(4000, 42, num_threads);
+  const std::vector<double> values = evaluator.Evaluate(*state);
+  SPIEL_CHECK_EQ(values.size(), 2);
+  SPIEL_CHECK_FLOAT_EQ(values[0], -values[1]);
+  SPIEL_CHECK_FLOAT_NEAR(values[0], 0.29, 0.05);
+  SPIEL_CHECK_EQ(other_evaluator.Evaluate(*state), values);
+}
+
+void MCTSTest_ParallelGarbageCollect() {
+  auto game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(1, 42);
+  algorithms::MCTSBot bot(*game, &evaluator, UCT_C,
+                          /*max_simulations=*/ 200000,
+                          /*max_memory_mb=*/ 1,
+                          /*solve=*/ true,
+                          /*seed=*/ 42,
+                          /*verbose=*/ false,
+                          algorithms::ChildSelectionPolicy::UCT,
+                          /*dirichlet_alpha=*/ 0,
+                          /*dirichlet_epsilon=*/ 0,
+                          /*num_threads=*/ 4);
+  std::unique_ptr<algorithms::SearchNode> root = bot.MCTSearch(*state);
+  SPIEL_CHECK_TRUE(root->outcome.size() == 2 ||
+                   root->explore_count == 200000);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
@@ -160,6 +619,25 @@ int main(int argc, char** argv) {
   open_spiel::MCTSTest_CanPlayThreePlayerStochasticGames();
   open_spiel::MCTSTest_SolveDraw();
   open_spiel::MCTSTest_SolveLoss();
-  open_spiel::MCTSTest_SolveWin();
+  open_spiel::MCTSTest_SolveWin(/*num_threads=*/1, /*batch_size=*/1);
   open_spiel::MCTSTest_GarbageCollect();
+  open_spiel::MCTSTest_MemoryStats(/*num_threads=*/1);
+  open_spiel::MCTSTest_MemoryStats(/*num_threads=*/4);
+  open_spiel::MCTSTest_SolveWin(/*num_threads=*/4, /*batch_size=*/1);
+  open_spiel::MCTSTest_SolveWin(/*num_threads=*/1, /*batch_size=*/8);
+  open_spiel::MCTSTest_SolveWin(/*num_threads=*/4, /*batch_size=*/4);
+  open_spiel::MCTSTest_ParallelSearch();
+  open_spiel::MCTSTest_BatchedSearch();
+  open_spiel::MCTSTest_ReuseTree(/*num_threads=*/1);
+  open_spiel::MCTSTest_ReuseTree(/*num_threads=*/4);
+  open_spiel::MCTSTest_Ponder();
+  open_spiel::MCTSTest_CachingEvaluator();
+  open_spiel::MCTSTest_TimeBudget(/*num_threads=*/1);
+  open_spiel::MCTSTest_TimeBudget(/*num_threads=*/4);
+  open_spiel::MCTSTest_StopEarly();
+  open_spiel::MCTSTest_Transpositions();
+  open_spiel::MCTSTest_GumbelRootSelection();
+  open_spiel::MCTSTest_RandomRolloutEvaluator(/*num_threads=*/1);
+  open_spiel::MCTSTest_RandomRolloutEvaluator(/*num_threads=*/4);
+  open_spiel::MCTSTest_ParallelGarbageCollect();
 }
@@ -0,0 +1,105 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mean_field_solvers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+using mean_field_games::BestResponse;
+using mean_field_games::Distribution;
+using mean_field_games::MeanFieldGame;
+using mean_field_games::MeanFieldPolicy;
+using mean_field_games::QValues;
+using mean_field_games::StateActionArray;
+using mean_field_games::UniformPolicy;
+
+MeanFieldFictitiousPlay::MeanFieldFictitiousPlay(const MeanFieldGame& game)
+    : game_(game),
+      cumulative_policy_(game.Horizon(), game.NumStates(), game.NumActions()),
+      cumulative_distribution_(game.Horizon(),
+                               std::vector<double>(game.NumStates(), 0.0)),
+      average_policy_(UniformPolicy(game)) {
+  Accumulate(average_policy_, Distribution(game_, average_policy_));
+}
+
+void MeanFieldFictitiousPlay::RunIteration() {
+  MeanFieldPolicy best_response =
+      BestResponse(game_, Distribution(game_, average_policy_));
+  Accumulate(best_response, Distribution(game_, best_response));
+  ++num_iterations_;
+}
+
+void MeanFieldFictitiousPlay::Accumulate(
+    const MeanFieldPolicy& policy,
+    const std::vector<std::vector<double>>& distribution) {
+  const int num_actions = game_.NumActions();
+  for (int t = 0; t < game_.Horizon(); ++t) {
+    absl::Span<const double> probs = policy.TimeStep(t);
+    absl::Span<double> cumulative = cumulative_policy_.MutableTimeStep(t);
+    absl::Span<double> average = average_policy_.MutableTimeStep(t);
+    for (int s = 0; s < game_.NumStates(); ++s) {
+      const double weight = distribution[t][s];
+      double& total = cumulative_distribution_[t][s];
+      total += weight;
+      for (int a = 0; a < num_actions; ++a) {
+        const int i = s * num_actions + a;
+        cumulative[i] += weight * probs[i];
+        // States nobody reaches keep the policy they had.
+        if (total > 0) average[i] = cumulative[i] / total;
+      }
+    }
+  }
+}
+
+MeanFieldMirrorDescent::MeanFieldMirrorDescent(const MeanFieldGame& game,
+                                               double learning_rate)
+    : game_(game),
+      learning_rate_(learning_rate),
+      cumulative_q_values_(game.Horizon(), game.NumStates(),
+                           game.NumActions()),
+      policy_(UniformPolicy(game)) {
+  SPIEL_CHECK_GT(learning_rate_, 0);
+}
+
+void MeanFieldMirrorDescent::RunIteration() {
+  StateActionArray q_values =
+      QValues(game_, policy_, Distribution(game_, policy_));
+  for (int t = 0; t < game_.Horizon(); ++t) {
+    absl::Span<const double> q = q_values.TimeStep(t);
+    absl::Span<double> y = cumulative_q_values_.MutableTimeStep(t);
+    for (int i = 0; i < y.size(); ++i) y[i] += learning_rate_ * q[i];
+    for (int s = 0; s < game_.NumStates(); ++s) {
+      absl::Span<const double> logits = cumulative_q_values_.At(t, s);
+      absl::Span<double> probs = policy_.MutableAt(t, s);
+      const double max_logit = *std::max_element(logits.begin(), logits.end());
+      double total = 0.0;
+      for (int a = 0; a < logits.size(); ++a) {
+        probs[a] = std::exp(logits[a] - max_logit);
+        total += probs[a];
+      }
+      for (double& p : probs) p /= total;
+    }
+  }
+  ++num_iterations_;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
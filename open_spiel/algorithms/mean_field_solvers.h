@@ -0,0 +1,89 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MEAN_FIELD_SOLVERS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MEAN_FIELD_SOLVERS_H_
+
+#include <vector>
+
+#include "open_spiel/games/mean_field_games/mean_field_game.h"
+
+// Solvers for the tabular mean field games of games/mean_field_games, each
+// iteration of which propagates the population distribution forward and the
+// values backward over all states.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Fictitious play (Perrin et al. 2020, https://arxiv.org/abs/2007.03458):
+// each iteration computes a best response to the population playing the
+// average policy, and adds it to the average. Policies are averaged as the
+// population would mix them: in each state, weighted by how often the agents
+// playing each policy reach it.
+class MeanFieldFictitiousPlay {
+ public:
+  explicit MeanFieldFictitiousPlay(
+      const mean_field_games::MeanFieldGame& game);
+
+  void RunIteration();
+
+  int NumIterations() const { return num_iterations_; }
+  // The average of the uniform policy and of the best responses so far.
+  const mean_field_games::MeanFieldPolicy& AveragePolicy() const {
+    return average_policy_;
+  }
+
+ private:
+  // Adds `policy`, reaching states as per `distribution`, to the average.
+  void Accumulate(const mean_field_games::MeanFieldPolicy& policy,
+                  const std::vector<std::vector<double>>& distribution);
+
+  const mean_field_games::MeanFieldGame& game_;
+  int num_iterations_ = 0;
+  // The policies weighted by their distributions, and the total weights.
+  mean_field_games::StateActionArray cumulative_policy_;
+  std::vector<std::vector<double>> cumulative_distribution_;
+  mean_field_games::MeanFieldPolicy average_policy_;
+};
+
+// Online mirror descent (Perolat et al. 2021,
+// https://arxiv.org/abs/2103.00623): each iteration evaluates the Q-values of
+// the current policy against the population playing it, adds them to a
+// running sum scaled by `learning_rate`, and plays the softmax of that sum.
+// Unlike fictitious play it needs no best response, and it is the current
+// policy, not an average, that converges.
+class MeanFieldMirrorDescent {
+ public:
+  explicit MeanFieldMirrorDescent(const mean_field_games::MeanFieldGame& game,
+                                  double learning_rate = 1.0);
+
+  void RunIteration();
+
+  int NumIterations() const { return num_iterations_; }
+  const mean_field_games::MeanFieldPolicy& CurrentPolicy() const {
+    return policy_;
+  }
+
+ private:
+  const mean_field_games::MeanFieldGame& game_;
+  double learning_rate_;
+  int num_iterations_ = 0;
+  mean_field_games::StateActionArray cumulative_q_values_;
+  mean_field_games::MeanFieldPolicy policy_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MEAN_FIELD_SOLVERS_H_
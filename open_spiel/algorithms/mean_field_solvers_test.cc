@@ -0,0 +1,74 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mean_field_solvers.h"
+
+#include <iostream>
+
+#include "open_spiel/games/mean_field_games/crowd_modelling.h"
+#include "open_spiel/games/mean_field_games/mean_field_game.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+using mean_field_games::CrowdModellingGame;
+using mean_field_games::Exploitability;
+using mean_field_games::UniformPolicy;
+
+void FictitiousPlayCrowdModellingTest() {
+  CrowdModellingGame game;
+  MeanFieldFictitiousPlay solver(game);
+  const double initial = Exploitability(game, solver.AveragePolicy());
+  SPIEL_CHECK_FLOAT_EQ(initial, Exploitability(game, UniformPolicy(game)));
+  for (int i = 0; i < 100; ++i) solver.RunIteration();
+  SPIEL_CHECK_EQ(solver.NumIterations(), 100);
+  const double final = Exploitability(game, solver.AveragePolicy());
+  std::cout << "Crowd modelling fictitious play exploitability: " << initial
+            << " -> " << final << std::endl;
+  SPIEL_CHECK_LT(final, initial / 10);
+}
+
+void MirrorDescentCrowdModellingTest() {
+  CrowdModellingGame game;
+  MeanFieldMirrorDescent solver(game);
+  const double initial = Exploitability(game, solver.CurrentPolicy());
+  for (int i = 0; i < 100; ++i) solver.RunIteration();
+  SPIEL_CHECK_EQ(solver.NumIterations(), 100);
+  const double final = Exploitability(game, solver.CurrentPolicy());
+  std::cout << "Crowd modelling mirror descent exploitability: " << initial
+            << " -> " << final << std::endl;
+  SPIEL_CHECK_LT(final, initial / 10);
+}
+
+// The dense formulation scales to much larger state spaces. The crowd penalty
+// grows with the size, so this needs a smaller learning rate.
+void MirrorDescentLargeCrowdModellingTest() {
+  CrowdModellingGame game(/*size=*/10000, /*horizon=*/100);
+  MeanFieldMirrorDescent solver(game, /*learning_rate=*/0.1);
+  const double initial = Exploitability(game, solver.CurrentPolicy());
+  for (int i = 0; i < 10; ++i) solver.RunIteration();
+  SPIEL_CHECK_LT(Exploitability(game, solver.CurrentPolicy()), initial);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::FictitiousPlayCrowdModellingTest();
+  open_spiel::algorithms::MirrorDescentCrowdModellingTest();
+  open_spiel::algorithms::MirrorDescentLargeCrowdModellingTest();
+}
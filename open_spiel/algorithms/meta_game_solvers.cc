@@ -0,0 +1,240 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/meta_game_solvers.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tensor_game.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The action values of either kind of game, which the solvers share.
+class MetaGame {
+ public:
+  explicit MetaGame(const matrix_game::MatrixGame& game)
+      : matrix_game_(&game), num_actions_{game.NumRows(), game.NumCols()} {}
+  explicit MetaGame(const tensor_game::TensorGame& game)
+      : tensor_game_(&game), num_actions_(game.Shape()) {}
+
+  int NumPlayers() const { return num_actions_.size(); }
+  int NumActions(Player player) const { return num_actions_[player]; }
+
+  // Sets the values of the actions of the player against the strategies of
+  // the others.
+  void ActionValues(Player player, const MixedStrategies& strategies,
+                    std::vector<double>* values) const {
+    values->resize(NumActions(player));
+    if (matrix_game_ != nullptr) {
+      matrix_game_->ActionValues(player, strategies[1 - player],
+                                 absl::MakeSpan(*values));
+    } else {
+      tensor_game_->ActionValues(player,
+                                 {strategies.begin(), strategies.end()},
+                                 absl::MakeSpan(*values));
+    }
+  }
+
+  MixedStrategies UniformStrategies() const {
+    MixedStrategies strategies(NumPlayers());
+    for (Player player = 0; player < NumPlayers(); ++player) {
+      strategies[player].assign(NumActions(player), 1. / NumActions(player));
+    }
+    return strategies;
+  }
+
+  void CheckStrategies(const MixedStrategies& strategies) const {
+    SPIEL_CHECK_EQ(strategies.size(), NumPlayers());
+    for (Player player = 0; player < NumPlayers(); ++player) {
+      SPIEL_CHECK_EQ(strategies[player].size(), NumActions(player));
+    }
+  }
+
+ private:
+  const matrix_game::MatrixGame* matrix_game_ = nullptr;
+  const tensor_game::TensorGame* tensor_game_ = nullptr;
+  std::vector<int> num_actions_;
+};
+
+double Dot(const std::vector<double>& a, const std::vector<double>& b) {
+  return std::inner_product(a.begin(), a.end(), b.begin(), 0.);
+}
+
+void Accumulate(const MixedStrategies& strategies, MixedStrategies* sums) {
+  for (int player = 0; player < strategies.size(); ++player) {
+    for (int a = 0; a < strategies[player].size(); ++a) {
+      (*sums)[player][a] += strategies[player][a];
+    }
+  }
+}
+
+void Normalize(std::vector<double>* strategy) {
+  const double sum = std::accumulate(strategy->begin(), strategy->end(), 0.);
+  for (double& probability : *strategy) probability /= sum;
+}
+
+MixedStrategies ProjectedReplicatorDynamics(
+    const MetaGame& game, int num_iterations, double dt, double gamma,
+    int average_over_last_n, const MixedStrategies& initial_strategies) {
+  SPIEL_CHECK_GT(num_iterations, 0);
+  SPIEL_CHECK_GE(average_over_last_n, 0);
+  if (average_over_last_n == 0 || average_over_last_n > num_iterations) {
+    average_over_last_n = num_iterations;
+  }
+  MixedStrategies strategies = initial_strategies.empty()
+                                   ? game.UniformStrategies()
+                                   : initial_strategies;
+  game.CheckStrategies(strategies);
+  MixedStrategies new_strategies = strategies;
+  MixedStrategies sums = game.UniformStrategies();
+  for (std::vector<double>& sum : sums) absl::c_fill(sum, 0);
+  std::vector<double> values;
+  for (int iteration = 0; iteration < num_iterations; ++iteration) {
+    // All the players move against the strategies of the previous step.
+    for (Player player = 0; player < game.NumPlayers(); ++player) {
+      game.ActionValues(player, strategies, &values);
+      const std::vector<double>& strategy = strategies[player];
+      const double average_value = Dot(values, strategy);
+      std::vector<double>& new_strategy = new_strategies[player];
+      for (int a = 0; a < strategy.size(); ++a) {
+        new_strategy[a] = std::max(
+            gamma,
+            strategy[a] + dt * strategy[a] * (values[a] - average_value));
+      }
+      Normalize(&new_strategy);
+    }
+    std::swap(strategies, new_strategies);
+    if (iteration >= num_iterations - average_over_last_n) {
+      Accumulate(strategies, &sums);
+    }
+  }
+  for (std::vector<double>& sum : sums) {
+    for (double& probability : sum) probability /= average_over_last_n;
+  }
+  return sums;
+}
+
+MixedStrategies RegretMatching(const MetaGame& game, int num_iterations,
+                               const MixedStrategies& initial_strategies) {
+  SPIEL_CHECK_GT(num_iterations, 0);
+  MixedStrategies strategies = initial_strategies.empty()
+                                   ? game.UniformStrategies()
+                                   : initial_strategies;
+  game.CheckStrategies(strategies);
+  MixedStrategies regrets = game.UniformStrategies();
+  for (std::vector<double>& regret : regrets) absl::c_fill(regret, 0);
+  MixedStrategies sums = regrets;
+  MixedStrategies new_strategies = strategies;
+  std::vector<double> values;
+  for (int iteration = 0; iteration < num_iterations; ++iteration) {
+    Accumulate(strategies, &sums);
+    for (Player player = 0; player < game.NumPlayers(); ++player) {
+      game.ActionValues(player, strategies, &values);
+      const double average_value = Dot(values, strategies[player]);
+      std::vector<double>& regret = regrets[player];
+      std::vector<double>& new_strategy = new_strategies[player];
+      double positive_sum = 0;
+      for (int a = 0; a < regret.size(); ++a) {
+        regret[a] += values[a] - average_value;
+        new_strategy[a] = std::max(regret[a], 0.);
+        positive_sum += new_strategy[a];
+      }
+      if (positive_sum > 0) {
+        for (double& probability : new_strategy) probability /= positive_sum;
+      } else {
+        absl::c_fill(new_strategy, 1. / new_strategy.size());
+      }
+    }
+    std::swap(strategies, new_strategies);
+  }
+  for (std::vector<double>& sum : sums) {
+    for (double& probability : sum) probability /= num_iterations;
+  }
+  return sums;
+}
+
+MixedStrategies FictitiousPlay(const MetaGame& game, int num_iterations) {
+  SPIEL_CHECK_GT(num_iterations, 0);
+  // The uniform strategies count as the first iteration.
+  MixedStrategies averages = game.UniformStrategies();
+  std::vector<Action> best_responses(game.NumPlayers());
+  std::vector<double> values;
+  for (int iteration = 1; iteration < num_iterations; ++iteration) {
+    for (Player player = 0; player < game.NumPlayers(); ++player) {
+      game.ActionValues(player, averages, &values);
+      best_responses[player] = absl::c_max_element(values) - values.begin();
+    }
+    const double step = 1. / (iteration + 1);
+    for (Player player = 0; player < game.NumPlayers(); ++player) {
+      std::vector<double>& average = averages[player];
+      for (double& probability : average) probability *= 1 - step;
+      average[best_responses[player]] += step;
+    }
+  }
+  return averages;
+}
+
+}  // namespace
+
+MixedStrategies ProjectedReplicatorDynamics(
+    const matrix_game::MatrixGame& game, int num_iterations, double dt,
+    double gamma, int average_over_last_n,
+    const MixedStrategies& initial_strategies) {
+  return ProjectedReplicatorDynamics(MetaGame(game), num_iterations, dt,
+                                     gamma, average_over_last_n,
+                                     initial_strategies);
+}
+
+MixedStrategies ProjectedReplicatorDynamics(
+    const tensor_game::TensorGame& game, int num_iterations, double dt,
+    double gamma, int average_over_last_n,
+    const MixedStrategies& initial_strategies) {
+  return ProjectedReplicatorDynamics(MetaGame(game), num_iterations, dt,
+                                     gamma, average_over_last_n,
+                                     initial_strategies);
+}
+
+MixedStrategies RegretMatching(const matrix_game::MatrixGame& game,
+                               int num_iterations,
+                               const MixedStrategies& initial_strategies) {
+  return RegretMatching(MetaGame(game), num_iterations, initial_strategies);
+}
+
+MixedStrategies RegretMatching(const tensor_game::TensorGame& game,
+                               int num_iterations,
+                               const MixedStrategies& initial_strategies) {
+  return RegretMatching(MetaGame(game), num_iterations, initial_strategies);
+}
+
+MixedStrategies FictitiousPlay(const matrix_game::MatrixGame& game,
+                               int num_iterations) {
+  return FictitiousPlay(MetaGame(game), num_iterations);
+}
+
+MixedStrategies FictitiousPlay(const tensor_game::TensorGame& game,
+                               int num_iterations) {
+  return FictitiousPlay(MetaGame(game), num_iterations);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
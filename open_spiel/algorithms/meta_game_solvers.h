@@ -0,0 +1,72 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_META_GAME_SOLVERS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_META_GAME_SOLVERS_H_
+
+#include <vector>
+
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/tensor_game.h"
+
+// Iterative solvers of normal-form games, as used for the meta-games of
+// PSRO (Lanctot et al., 2017: https://arxiv.org/abs/1711.00832), working on
+// the utilities of a MatrixGame or TensorGame in place. They return a mixed
+// strategy for each player, as the probabilities of its actions.
+
+namespace open_spiel {
+namespace algorithms {
+
+using MixedStrategies = std::vector<std::vector<double>>;
+
+// Projected replicator dynamics, as in
+// python/algorithms/projected_replicator_dynamics.py: each step moves the
+// strategies along the replicator dynamics by `dt`, then raises the
+// probabilities below `gamma` to it and renormalizes. Returns the average of
+// the strategies of the last `average_over_last_n` steps, or of all of them if
+// it is 0. The initial strategies are uniform if none are given.
+MixedStrategies ProjectedReplicatorDynamics(
+    const matrix_game::MatrixGame& game, int num_iterations = 100000,
+    double dt = 1e-3, double gamma = 1e-6, int average_over_last_n = 0,
+    const MixedStrategies& initial_strategies = {});
+MixedStrategies ProjectedReplicatorDynamics(
+    const tensor_game::TensorGame& game, int num_iterations = 100000,
+    double dt = 1e-3, double gamma = 1e-6, int average_over_last_n = 0,
+    const MixedStrategies& initial_strategies = {});
+
+// Regret matching, where all the players play in proportion to their positive
+// cumulative regrets against each other's current strategies, or uniformly
+// when they have none. Returns the average strategies, which approach a
+// coarse correlated equilibrium, and a Nash equilibrium in two-player
+// zero-sum games.
+MixedStrategies RegretMatching(const matrix_game::MatrixGame& game,
+                               int num_iterations,
+                               const MixedStrategies& initial_strategies = {});
+MixedStrategies RegretMatching(const tensor_game::TensorGame& game,
+                               int num_iterations,
+                               const MixedStrategies& initial_strategies = {});
+
+// Fictitious play, where all the players best respond to each other's
+// average strategies, starting from uniform ones. Returns the average
+// strategies.
+MixedStrategies FictitiousPlay(const matrix_game::MatrixGame& game,
+                               int num_iterations);
+MixedStrategies FictitiousPlay(const tensor_game::TensorGame& game,
+                               int num_iterations);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_META_GAME_SOLVERS_H_
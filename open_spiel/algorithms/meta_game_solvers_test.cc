@@ -0,0 +1,112 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/meta_game_solvers.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/matrix_game_utils.h"
+#include "open_spiel/algorithms/tensor_game_utils.h"
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tensor_game.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CheckNear(const MixedStrategies& strategies,
+               const MixedStrategies& expected, double tolerance) {
+  SPIEL_CHECK_EQ(strategies.size(), expected.size());
+  for (int player = 0; player < strategies.size(); ++player) {
+    SPIEL_CHECK_EQ(strategies[player].size(), expected[player].size());
+    for (int a = 0; a < strategies[player].size(); ++a) {
+      SPIEL_CHECK_FLOAT_NEAR(strategies[player][a], expected[player][a],
+                             tolerance);
+    }
+  }
+}
+
+void ProjectedReplicatorDynamicsTest() {
+  // The first action dominates, as in projected_replicator_dynamics_test.py.
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      matrix_game::CreateMatrixGame({{2, 1, 0}, {0, -1, -2}},
+                                    {{2, 1, 0}, {0, -1, -2}});
+  MixedStrategies strategies = ProjectedReplicatorDynamics(
+      *game, /*num_iterations=*/50000, /*dt=*/1e-3, /*gamma=*/1e-8,
+      /*average_over_last_n=*/10);
+  SPIEL_CHECK_GT(strategies[0][0], 0.999);
+  SPIEL_CHECK_GT(strategies[1][0], 0.999);
+
+  std::vector<double> utilities = {2, 1, 0, 1, 0, -1, 1, 0, -1, 0, -1, -2};
+  std::shared_ptr<const tensor_game::TensorGame> tensor_game =
+      tensor_game::CreateTensorGame({utilities, utilities, utilities},
+                                    {2, 2, 3});
+  strategies = ProjectedReplicatorDynamics(
+      *tensor_game, /*num_iterations=*/50000, /*dt=*/1e-3, /*gamma=*/1e-6,
+      /*average_over_last_n=*/10);
+  SPIEL_CHECK_EQ(strategies.size(), 3);
+  SPIEL_CHECK_GT(strategies[0][0], 0.999);
+
+  // Rock-paper-scissors starting at its equilibrium stays there.
+  strategies =
+      ProjectedReplicatorDynamics(*LoadMatrixGame("matrix_rps"), 1000);
+  CheckNear(strategies, {{1. / 3, 1. / 3, 1. / 3}, {1. / 3, 1. / 3, 1. / 3}},
+            1e-9);
+}
+
+void RegretMatchingTest() {
+  // The average strategies approach the equilibrium of a zero-sum game,
+  // whichever kind of game holds it.
+  const MixedStrategies initial_strategies = {{0.6, 0.3, 0.1},
+                                              {0.2, 0.2, 0.6}};
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("matrix_rps");
+  const MixedStrategies strategies =
+      RegretMatching(*game, 100000, initial_strategies);
+  CheckNear(strategies, {{1. / 3, 1. / 3, 1. / 3}, {1. / 3, 1. / 3, 1. / 3}},
+            1e-2);
+  CheckNear(RegretMatching(*LoadTensorGame("matrix_rps"), 100000,
+                           initial_strategies),
+            strategies, 1e-9);
+}
+
+void FictitiousPlayTest() {
+  std::shared_ptr<const matrix_game::MatrixGame> game =
+      LoadMatrixGame("matrix_rps");
+  const MixedStrategies strategies = FictitiousPlay(*game, 10000);
+  CheckNear(strategies, {{1. / 3, 1. / 3, 1. / 3}, {1. / 3, 1. / 3, 1. / 3}},
+            1e-2);
+  CheckNear(FictitiousPlay(*LoadTensorGame("matrix_rps"), 10000), strategies,
+            1e-9);
+
+  // Against the average of the other, which is uniform at first, the
+  // dominant action is always the best response.
+  std::shared_ptr<const matrix_game::MatrixGame> dominated =
+      matrix_game::CreateMatrixGame({{1, 1}, {0, 0}}, {{0, 1}, {0, 1}});
+  CheckNear(FictitiousPlay(*dominated, 100), {{0.995, 0.005}, {0.005, 0.995}},
+            1e-9);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::ProjectedReplicatorDynamicsTest();
+  open_spiel::algorithms::RegretMatchingTest();
+  open_spiel::algorithms::FictitiousPlayTest();
+}
@@ -15,11 +15,21 @@
 #include "open_spiel/algorithms/minimax.h"
 
 #include <algorithm>  // std::max
+#include <array>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
 
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -115,12 +125,102 @@ double _alpha_beta(State* state, int depth, double alpha, double beta,
     return value;
   }
 }
-}  // namespace
 
-std::pair<double, Action> AlphaBetaSearch(
-    const Game& game, const State* state,
-    std::function<double(const State&)> value_function, int depth_limit,
-    Player maximizing_player) {
+// An expectiminimax algorithm with alpha-beta pruning at the decision nodes
+// and Star1 pruning at the chance nodes, see Ballard, "The *-minimax search
+// procedure for trees containing chance nodes" (1983).
+//
+// The values are assumed to lie in [min_value, max_value], which bounds the
+// contribution of the chance outcomes not searched yet: each outcome is
+// searched with the window that its value must be in for the expectation to
+// end up in (alpha, beta), and the chance node is cut off as soon as the
+// expectation is bound to be outside of it.
+//
+// Arguments are as for _alpha_beta, except that the depth only counts the
+// decision nodes.
+double _expectiminimax(
+    const State& state, int depth, double alpha, double beta, double min_value,
+    double max_value, const std::function<double(const State&)>& value_function,
+    Player maximizing_player, Action* best_action) {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(maximizing_player);
+  }
+
+  if (depth == 0 && !value_function) {
+    SpielFatalError(
+        "We assume we can walk the full depth of the tree. "
+        "Try increasing depth or provide a value_function.");
+  }
+
+  if (depth == 0) {
+    return value_function(state);
+  }
+
+  if (state.IsChanceNode()) {
+    // The expectation over the outcomes searched so far.
+    double value = 0;
+    double remaining_probability = 1;
+    for (const auto& [outcome, probability] : state.ChanceOutcomes()) {
+      if (probability <= 0) continue;
+      remaining_probability -= probability;
+      const double child_alpha = std::max(
+          min_value,
+          (alpha - value - remaining_probability * max_value) / probability);
+      const double child_beta = std::min(
+          max_value,
+          (beta - value - remaining_probability * min_value) / probability);
+      value += probability * _expectiminimax(*state.Child(outcome), depth,
+                                             child_alpha, child_beta,
+                                             min_value, max_value,
+                                             value_function, maximizing_player,
+                                             /*best_action=*/nullptr);
+      const double upper_bound =
+          value + std::max(remaining_probability, 0.0) * max_value;
+      if (upper_bound <= alpha) {
+        return upper_bound;  // alpha cut-off
+      }
+      const double lower_bound =
+          value + std::max(remaining_probability, 0.0) * min_value;
+      if (lower_bound >= beta) {
+        return lower_bound;  // beta cut-off
+      }
+    }
+    return value;
+  }
+
+  const bool maximizing = state.CurrentPlayer() == maximizing_player;
+  double value = maximizing ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+  for (Action action : state.LegalActions()) {
+    const double child_value = _expectiminimax(
+        *state.Child(action), depth - 1, alpha, beta, min_value, max_value,
+        value_function, maximizing_player, /*best_action=*/nullptr);
+    if (maximizing ? child_value > value : child_value < value) {
+      value = child_value;
+      if (best_action != nullptr) {
+        *best_action = action;
+      }
+    }
+    if (maximizing) {
+      alpha = std::max(alpha, value);
+    } else {
+      beta = std::min(beta, value);
+    }
+    if (alpha >= beta) {
+      break;
+    }
+  }
+  return value;
+}
+
+// The number of nodes between two checks of the time.
+constexpr int kTimeCheckInterval = 1024;
+
+// The depth bound of the history scores, so that unlimited searches do not
+// overflow them.
+constexpr int kMaxHistoryDepth = 100;
+
+void CheckAlphaBetaGame(const Game& game) {
   if (game.NumPlayers() != 2) {
     SpielFatalError("Game must be a 2-player game");
   }
@@ -142,6 +242,14 @@ std::pair<double, Action> AlphaBetaSearch(
     SpielFatalError(
         absl::StrCat("The game must be 0-sum, not  ", game_info.utility));
   }
+}
+}  // namespace
+
+std::pair<double, Action> AlphaBetaSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player) {
+  CheckAlphaBetaGame(game);
 
   std::unique_ptr<State> search_root;
   if (state == nullptr) {
@@ -163,5 +271,335 @@ std::pair<double, Action> AlphaBetaSearch(
   return std::pair<double, Action>(value, best_action);
 }
 
+std::pair<double, Action> ExpectiminimaxSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player) {
+  if (game.NumPlayers() != 2) {
+    SpielFatalError("Game must be a 2-player game");
+  }
+  GameType game_info = game.GetType();
+  if (game_info.chance_mode == GameType::ChanceMode::kSampledStochastic) {
+    SpielFatalError("The game must have explicit chance outcomes");
+  }
+  if (game_info.information != GameType::Information::kPerfectInformation) {
+    SpielFatalError(
+        absl::StrCat("The game must be a perfect information one, not ",
+                     game_info.information));
+  }
+  if (game_info.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        absl::StrCat("The game must be turn-based, not ", game_info.dynamics));
+  }
+  if (game_info.utility != GameType::Utility::kZeroSum) {
+    SpielFatalError(
+        absl::StrCat("The game must be 0-sum, not  ", game_info.utility));
+  }
+  SPIEL_CHECK_LT(game.MinUtility(), game.MaxUtility());
+
+  std::unique_ptr<State> search_root;
+  if (state == nullptr) {
+    search_root = game.NewInitialState();
+  } else {
+    search_root = state->Clone();
+  }
+
+  if (maximizing_player == kInvalidPlayer) {
+    maximizing_player = search_root->CurrentPlayer();
+  }
+  SPIEL_CHECK_GE(maximizing_player, 0);
+
+  double infinity = std::numeric_limits<double>::infinity();
+  Action best_action = kInvalidAction;
+  double value = _expectiminimax(
+      *search_root, /*depth=*/depth_limit, /*alpha=*/-infinity,
+      /*beta=*/infinity, game.MinUtility(), game.MaxUtility(), value_function,
+      maximizing_player, &best_action);
+
+  return std::pair<double, Action>(value, best_action);
+}
+
+AlphaBetaSearcher::AlphaBetaSearcher(
+    const Game& game, std::function<double(const State&)> value_function,
+    int transposition_table_mb, int num_threads)
+    : game_(game),
+      value_function_(std::move(value_function)),
+      num_distinct_actions_(game.NumDistinctActions()),
+      num_threads_(num_threads) {
+  Init(transposition_table_mb);
+}
+
+AlphaBetaSearcher::AlphaBetaSearcher(
+    const Game& game, const IncrementalEvaluator& evaluator,
+    int transposition_table_mb, int num_threads)
+    : game_(game),
+      evaluator_(evaluator.Clone()),
+      num_distinct_actions_(game.NumDistinctActions()),
+      num_threads_(num_threads) {
+  Init(transposition_table_mb);
+}
+
+void AlphaBetaSearcher::Init(int transposition_table_mb) {
+  CheckAlphaBetaGame(game_);
+  SPIEL_CHECK_GE(num_threads_, 1);
+  const int64_t max_entries = std::max<int64_t>(
+      1, (int64_t{transposition_table_mb} << 20) / sizeof(TableEntry));
+  int64_t num_entries = 1;
+  while (num_entries * 2 <= max_entries) num_entries *= 2;
+  table_.resize(num_entries);
+  workers_.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    workers_.emplace_back(t);
+    workers_.back().history_scores.resize(2 * num_distinct_actions_, 0);
+    if (evaluator_ != nullptr) workers_.back().evaluator = evaluator_->Clone();
+  }
+}
+
+void AlphaBetaSearcher::ClearTable() {
+  std::fill(table_.begin(), table_.end(), TableEntry());
+  for (Worker& worker : workers_) {
+    std::fill(worker.history_scores.begin(), worker.history_scores.end(), 0);
+    worker.killers.clear();
+  }
+}
+
+std::pair<double, Action> AlphaBetaSearcher::Search(const State& state,
+                                                    int depth_limit,
+                                                    Player maximizing_player,
+                                                    double max_seconds) {
+  if (maximizing_player == kInvalidPlayer) {
+    maximizing_player = state.CurrentPlayer();
+  }
+  // The table holds values for the maximizing player.
+  if (maximizing_player != maximizing_player_) {
+    ClearTable();
+    maximizing_player_ = maximizing_player;
+  }
+  const absl::Time start = absl::Now();
+  if (opening_book_ != nullptr) {
+    const BookMove move = opening_book_->BestMove(state);
+    if (move.action != kInvalidAction) {
+      double value = move.value;
+      // The values of the book are for the player to move.
+      if (state.CurrentPlayer() != maximizing_player) value = -value;
+      last_depth_ = 0;
+      num_nodes_ = 0;
+      seconds_ = absl::ToDoubleSeconds(absl::Now() - start);
+      return {value, move.action};
+    }
+  }
+  deadline_ = max_seconds > 0 ? start + absl::Seconds(max_seconds)
+                              : absl::InfiniteFuture();
+  main_done_ = false;
+  const int max_depth = depth_limit < 0 ? kUnlimitedDepth : depth_limit;
+  for (Worker& worker : workers_) {
+    if (worker.evaluator != nullptr) worker.evaluator->Reset(state);
+  }
+
+  std::vector<Thread> helpers;
+  std::vector<std::unique_ptr<State>> helper_states;
+  helpers.reserve(num_threads_ - 1);
+  helper_states.reserve(num_threads_ - 1);
+  for (int t = 1; t < num_threads_; ++t) {
+    helper_states.push_back(state.Clone());
+    helpers.emplace_back([this, t, &helper_states, max_depth]() {
+      IterativeDeepening(&workers_[t], helper_states[t - 1].get(), max_depth);
+    });
+  }
+  std::unique_ptr<State> search_root = state.Clone();
+  const std::pair<double, Action> result =
+      IterativeDeepening(&workers_[0], search_root.get(), max_depth);
+  main_done_ = true;
+  for (Thread& helper : helpers) helper.join();
+
+  seconds_ = absl::ToDoubleSeconds(absl::Now() - start);
+  last_depth_ = workers_[0].last_depth;
+  num_nodes_ = 0;
+  for (const Worker& worker : workers_) num_nodes_ += worker.num_nodes;
+  return result;
+}
+
+std::pair<double, Action> AlphaBetaSearcher::IterativeDeepening(
+    Worker* worker, State* state, int max_depth) {
+  worker->num_nodes = 0;
+  worker->last_depth = 0;
+  const double infinity = std::numeric_limits<double>::infinity();
+  std::pair<double, Action> result(0, kInvalidAction);
+  // Every other helper searches a ply deeper than the main thread.
+  const int first_depth =
+      HasValueFunction() ? 1 + worker->index % 2 : max_depth;
+  for (int depth = std::min(first_depth, max_depth);; ++depth) {
+    // The first iteration of the main thread always completes, so that there
+    // is an action.
+    worker->can_abort = worker->index > 0 || worker->last_depth > 0;
+    worker->aborted = false;
+    worker->reached_depth_limit = false;
+    Action best_action = kInvalidAction;
+    const double value = AlphaBeta(worker, state, depth, /*ply=*/0, -infinity,
+                                   infinity, &best_action);
+    if (worker->aborted) break;
+    result = {value, best_action};
+    worker->last_depth = depth;
+    if (depth >= max_depth || !worker->reached_depth_limit) break;
+  }
+  return result;
+}
+
+AlphaBetaSearcher::TableEntry AlphaBetaSearcher::LoadEntry(int64_t index) {
+  if (num_threads_ == 1) return table_[index];
+  absl::MutexLock lock(&stripe_mutexes_[index % kNumLockStripes]);
+  return table_[index];
+}
+
+void AlphaBetaSearcher::StoreEntry(int64_t index, const TableEntry& entry) {
+  if (num_threads_ == 1) {
+    table_[index] = entry;
+    return;
+  }
+  absl::MutexLock lock(&stripe_mutexes_[index % kNumLockStripes]);
+  table_[index] = entry;
+}
+
+double AlphaBetaSearcher::AlphaBeta(Worker* worker, State* state, int depth,
+                                    int ply, double alpha, double beta,
+                                    Action* best_action) {
+  ++worker->num_nodes;
+  if (worker->can_abort &&
+      ((worker->index > 0 && main_done_) ||
+       (worker->num_nodes % kTimeCheckInterval == 0 &&
+        absl::Now() >= deadline_))) {
+    worker->aborted = true;
+  }
+  if (worker->aborted) return 0;
+
+  if (state->IsTerminal()) {
+    return state->PlayerReturn(maximizing_player_);
+  }
+
+  if (depth == 0) {
+    if (!HasValueFunction()) {
+      SpielFatalError(
+          "We assume we can walk the full depth of the tree. "
+          "Try increasing depth or provide a value_function.");
+    }
+    worker->reached_depth_limit = true;
+    if (worker->evaluator != nullptr) {
+      return worker->evaluator->Evaluate(*state, maximizing_player_);
+    }
+    return value_function_(*state);
+  }
+
+  // The table gives a value if it was searched as deep with a usable bound,
+  // except at the root which needs the action, and otherwise the action to
+  // try first.
+  const uint64_t hash = state->Hash();
+  const int64_t index = hash & (table_.size() - 1);
+  const TableEntry entry = LoadEntry(index);
+  Action table_action = kInvalidAction;
+  if (entry.depth >= 0 && entry.hash == hash) {
+    table_action = entry.best_action;
+    if (entry.depth >= depth && best_action == nullptr &&
+        (entry.bound == Bound::kExact ||
+         (entry.bound == Bound::kLower && entry.value >= beta) ||
+         (entry.bound == Bound::kUpper && entry.value <= alpha))) {
+      if (entry.depth < kUnlimitedDepth) worker->reached_depth_limit = true;
+      return entry.value;
+    }
+  }
+
+  const Player player = state->CurrentPlayer();
+  const bool maximizing = player == maximizing_player_;
+  std::vector<Action> actions = state->LegalActions();
+  OrderActions(worker, player, ply, table_action, &actions);
+
+  const double initial_alpha = alpha;
+  const double initial_beta = beta;
+  const bool reached_depth_limit = worker->reached_depth_limit;
+  worker->reached_depth_limit = false;
+  const double infinity = std::numeric_limits<double>::infinity();
+  double value = maximizing ? -infinity : infinity;
+  Action best = kInvalidAction;
+  for (Action action : actions) {
+    if (worker->evaluator != nullptr) {
+      worker->evaluator->ApplyAction(*state, action);
+    }
+    state->ApplyAction(action);
+    const double child_value =
+        AlphaBeta(worker, state, depth - 1, ply + 1, alpha, beta, nullptr);
+    state->UndoAction(player, action);
+    if (worker->evaluator != nullptr) {
+      worker->evaluator->UndoAction(*state, player, action);
+    }
+    if (worker->aborted) return 0;
+
+    if (maximizing ? child_value > value : child_value < value) {
+      value = child_value;
+      best = action;
+    }
+    if (maximizing) {
+      alpha = std::max(alpha, value);
+    } else {
+      beta = std::min(beta, value);
+    }
+    if (alpha >= beta) {
+      // Remember the action that caused the cutoff.
+      std::vector<std::array<Action, 2>>& killers = worker->killers;
+      if (ply >= killers.size()) {
+        killers.resize(ply + 1, {kInvalidAction, kInvalidAction});
+      }
+      if (killers[ply][0] != action) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = action;
+      }
+      const int64_t history_depth = std::min(depth, kMaxHistoryDepth);
+      worker->history_scores[player * num_distinct_actions_ + action] +=
+          history_depth * history_depth;
+      break;
+    }
+  }
+
+  // Always replace the entry, keeping only the last position of the slot.
+  const bool subtree_reached_depth_limit = worker->reached_depth_limit;
+  worker->reached_depth_limit =
+      subtree_reached_depth_limit || reached_depth_limit;
+  TableEntry new_entry;
+  new_entry.hash = hash;
+  new_entry.value = value;
+  new_entry.best_action = best;
+  new_entry.depth = subtree_reached_depth_limit ? depth : kUnlimitedDepth;
+  new_entry.bound = value <= initial_alpha  ? Bound::kUpper
+                    : value >= initial_beta ? Bound::kLower
+                                            : Bound::kExact;
+  StoreEntry(index, new_entry);
+
+  if (best_action != nullptr) *best_action = best;
+  return value;
+}
+
+void AlphaBetaSearcher::OrderActions(Worker* worker, Player player, int ply,
+                                     Action table_action,
+                                     std::vector<Action>* actions) {
+  // Helpers shuffle the actions so that they explore the ties differently.
+  if (worker->index > 0) {
+    std::shuffle(actions->begin(), actions->end(), worker->rng);
+  }
+  const std::array<Action, 2> killers =
+      ply < worker->killers.size()
+          ? worker->killers[ply]
+          : std::array<Action, 2>{kInvalidAction, kInvalidAction};
+  const int64_t* history_scores =
+      &worker->history_scores[player * num_distinct_actions_];
+  auto priority = [&](Action action) {
+    constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+    if (action == table_action) return kMax;
+    if (action == killers[0]) return kMax - 1;
+    if (action == killers[1]) return kMax - 2;
+    return history_scores[action];
+  };
+  std::stable_sort(
+      actions->begin(), actions->end(),
+      [&](Action a, Action b) { return priority(a) > priority(b); });
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -15,10 +15,21 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MINMAX_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MINMAX_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/incremental_evaluator.h"
+#include "open_spiel/algorithms/opening_book.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -49,6 +60,167 @@ std::pair<double, Action> AlphaBetaSearch(
     std::function<double(const State&)> value_function, int depth_limit,
     Player maximizing_player);
 
+// Expectiminimax search for 2-players, perfect-information 0-sum games with
+// explicit chance nodes, like backgammon or pig, with the same arguments as
+// AlphaBetaSearch. The value of a chance node is the expectation of the values
+// of its outcomes under ChanceOutcomes(), and depth_limit only counts the
+// decision nodes, so the search must not start before sequences of chance
+// nodes that can go on indefinitely, like the opening roll of backgammon.
+//
+// The chance nodes are pruned with Star1, which needs the values, including
+// those of value_function, to lie in [game.MinUtility(), game.MaxUtility()].
+// The best action is kInvalidAction when the search root is a chance node.
+std::pair<double, Action> ExpectiminimaxSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    Player maximizing_player);
+
+// An alpha-beta search for larger games, with the same requirements on the
+// game and the same arguments as AlphaBetaSearch, adding:
+// - Iterative deepening: the search is run to depth 1, 2, ... up to the depth
+//   limit or, with no limit, until no leaf needed the value function (the
+//   value is then exact). With max_seconds > 0, it stops when the time is up
+//   and returns the result of the deepest completed iteration.
+// - A transposition table keyed by State::Hash, with the value bound, depth
+//   and best action of the positions searched. It is kept between searches
+//   for the same maximizing player, so it pays off most for games where Hash
+//   identifies positions, like connect_four or breakthrough.
+// - Move ordering: the best action from the table first (which is the
+//   principal variation of the previous iteration), then the two killer
+//   actions of the ply, i.e. the last ones to cause a cutoff there, then the
+//   others by decreasing history score (the sum of depth^2 over their
+//   cutoffs).
+// Without a value function, only the unlimited-depth search is run.
+//
+// With num_threads > 1, the search is parallelized with Lazy SMP: helper
+// threads run the same iterative deepening, every other one a ply deeper and
+// with their own killers, history scores and tie-breaking between actions,
+// and only share the transposition table (protected by striped mutexes). The
+// main thread's result is returned, and the helpers stop with it, so they only
+// speed it up by filling the table. The results then depend on the scheduling
+// of the threads.
+class AlphaBetaSearcher {
+ public:
+  // The transposition table uses about transposition_table_mb megabytes.
+  AlphaBetaSearcher(const Game& game,
+                    std::function<double(const State&)> value_function,
+                    int transposition_table_mb = 16, int num_threads = 1);
+
+  // Values the leaves with copies of `evaluator`, one per thread, kept up to
+  // date along the search instead of called on each leaf from scratch.
+  AlphaBetaSearcher(const Game& game, const IncrementalEvaluator& evaluator,
+                    int transposition_table_mb = 16, int num_threads = 1);
+
+  // Searches from `state` and returns the value for the maximizing player
+  // (the player to move if kInvalidPlayer), and the best action.
+  // depth_limit < 0 means no limit.
+  std::pair<double, Action> Search(const State& state, int depth_limit,
+                                   Player maximizing_player = kInvalidPlayer,
+                                   double max_seconds = 0);
+
+  // Statistics of the last search: the depth of the deepest iteration
+  // completed by the main thread, the number of nodes visited by all the
+  // threads in all their iterations, and its wall time.
+  int LastDepth() const { return last_depth_; }
+  int64_t NumNodes() const { return num_nodes_; }
+  double Seconds() const { return seconds_; }
+  double NodesPerSecond() const {
+    return seconds_ > 0 ? num_nodes_ / seconds_ : 0;
+  }
+
+  void ClearTable();
+
+  // Consults `book`, which must outlive the searcher, before searching, or no
+  // book if nullptr. Search then returns the move of the book with the
+  // highest weight for the positions it has, valued with its mean outcome,
+  // without searching: LastDepth and NumNodes are 0.
+  void SetOpeningBook(const OpeningBook* book) { opening_book_ = book; }
+
+ private:
+  // The depth of unlimited searches and of exact values.
+  static constexpr int kUnlimitedDepth = std::numeric_limits<int>::max() / 2;
+
+  enum class Bound : int8_t { kExact, kLower, kUpper };
+
+  struct TableEntry {
+    uint64_t hash = 0;
+    double value = 0;
+    Action best_action = kInvalidAction;
+    // The depth searched, kUnlimitedDepth if no leaf below needed the value
+    // function, or -1 if empty.
+    int depth = -1;
+    Bound bound = Bound::kExact;
+  };
+
+  // The state of a search thread.
+  struct Worker {
+    explicit Worker(int index) : index(index), rng(index) {}
+
+    int index;  // 0 for the main thread.
+    // [ply][2], the killer actions.
+    std::vector<std::array<Action, 2>> killers;
+    // [player * num_distinct_actions + action]
+    std::vector<int64_t> history_scores;
+    // Breaks ties between actions for the helper threads.
+    SplitMix64 rng;
+    bool can_abort = false;
+    bool aborted = false;
+    bool reached_depth_limit = false;
+    int last_depth = 0;
+    int64_t num_nodes = 0;
+    // The thread's copy of the incremental evaluator, if any.
+    std::unique_ptr<IncrementalEvaluator> evaluator;
+  };
+
+  // Sets up the table and the workers.
+  void Init(int transposition_table_mb);
+
+  // Runs the iterative deepening of `worker` from `state`, and returns the
+  // result of its deepest completed iteration.
+  std::pair<double, Action> IterativeDeepening(Worker* worker, State* state,
+                                               int max_depth);
+
+  // Returns the value of `state` searched to `depth`, for the maximizing
+  // player, as in AlphaBetaSearch, with `ply` the distance to the root, and
+  // sets `best_action` if not null. Sets worker->aborted when the time is up
+  // or, for helpers, when the main thread is done, after which values are
+  // meaningless.
+  double AlphaBeta(Worker* worker, State* state, int depth, int ply,
+                   double alpha, double beta, Action* best_action);
+
+  // Sorts `actions` by decreasing priority, with `table_action` first.
+  void OrderActions(Worker* worker, Player player, int ply,
+                    Action table_action, std::vector<Action>* actions);
+
+  bool HasValueFunction() const {
+    return value_function_ != nullptr || evaluator_ != nullptr;
+  }
+
+  TableEntry LoadEntry(int64_t index);
+  void StoreEntry(int64_t index, const TableEntry& entry);
+
+  const Game& game_;
+  const std::function<double(const State&)> value_function_;
+  const std::unique_ptr<IncrementalEvaluator> evaluator_;
+  const int num_distinct_actions_;
+  const int num_threads_;
+
+  // A hash-indexed table, with a power of two size.
+  std::vector<TableEntry> table_;
+  std::vector<Worker> workers_;
+
+  const OpeningBook* opening_book_ = nullptr;
+  Player maximizing_player_ = kInvalidPlayer;
+  absl::Time deadline_;
+  std::atomic<bool> main_done_ = false;
+  int last_depth_ = 0;
+  int64_t num_nodes_ = 0;
+  double seconds_ = 0;
+
+  static inline constexpr int kNumLockStripes = 64;
+  absl::Mutex stripe_mutexes_[kNumLockStripes];
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
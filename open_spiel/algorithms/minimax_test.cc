@@ -14,7 +14,19 @@
 
 #include "open_spiel/algorithms/minimax.h"
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/algorithms/incremental_evaluator.h"
 
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
@@ -64,6 +76,241 @@ void AlphaBetaSearchTest_TicTacToe_Loss() {
   SPIEL_CHECK_EQ(-1.0, value_and_action.first);
 }
 
+// The searcher finds the same exact values as AlphaBetaSearch, with or without
+// a value function to deepen iteratively, and reuses its table.
+void AlphaBetaSearcherTest_TicTacToe() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  AlphaBetaSearcher searcher(*game, nullptr);
+  AlphaBetaSearcher deepening_searcher(
+      *game, [](const State&) { return 0.0; });
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::pair<double, Action> value_and_action = searcher.Search(*state, -1);
+  SPIEL_CHECK_EQ(value_and_action.first, 0.0);
+  const int64_t num_nodes = searcher.NumNodes();
+  SPIEL_CHECK_EQ(searcher.Search(*state, -1).first, 0.0);
+  SPIEL_CHECK_LT(searcher.NumNodes(), num_nodes);
+  SPIEL_CHECK_EQ(deepening_searcher.Search(*state, -1).first, 0.0);
+  SPIEL_CHECK_GT(deepening_searcher.LastDepth(), 1);
+
+  // .o.
+  // .x.
+  // ...
+  state->ApplyAction(4);
+  state->ApplyAction(1);
+  for (AlphaBetaSearcher* s : {&searcher, &deepening_searcher}) {
+    value_and_action = s->Search(*state, -1);
+    SPIEL_CHECK_EQ(value_and_action.first, 1.0);
+    std::unique_ptr<State> child = state->Child(value_and_action.second);
+    SPIEL_CHECK_EQ(AlphaBetaSearch(*game, child.get(), {}, -1, 0).first, 1.0);
+  }
+
+  // The value for the other player.
+  SPIEL_CHECK_EQ(searcher.Search(*state, -1, /*maximizing_player=*/1).first,
+                 -1.0);
+}
+
+// A depth-limited search finds a win within its horizon, and one with a time
+// budget completes at least the first iteration.
+void AlphaBetaSearcherTest_ConnectFour() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  AlphaBetaSearcher searcher(*game, [](const State&) { return 0.0; });
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : {0, 1, 0, 1, 0}) state->ApplyAction(action);
+  // x has three in column 0, so o must block it, or x wins.
+  std::pair<double, Action> value_and_action = searcher.Search(*state, 4);
+  SPIEL_CHECK_EQ(value_and_action.second, 0);
+  SPIEL_CHECK_EQ(searcher.LastDepth(), 4);
+  state->ApplyAction(1);
+  value_and_action = searcher.Search(*state, 4);
+  SPIEL_CHECK_EQ(value_and_action.first, 1.0);
+  SPIEL_CHECK_EQ(value_and_action.second, 0);
+
+  state = game->NewInitialState();
+  value_and_action = searcher.Search(*state, -1, kInvalidPlayer,
+                                     /*max_seconds=*/0.2);
+  SPIEL_CHECK_GE(searcher.LastDepth(), 1);
+  SPIEL_CHECK_TRUE(absl::c_linear_search(state->LegalActions(),
+                                          value_and_action.second));
+}
+
+// With several threads, the values are still exact, and every thread counts
+// its nodes.
+void AlphaBetaSearcherTest_Parallel() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  AlphaBetaSearcher searcher(*game, [](const State&) { return 0.0; },
+                             /*transposition_table_mb=*/1, /*num_threads=*/4);
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(searcher.Search(*state, -1).first, 0.0);
+  SPIEL_CHECK_GT(searcher.NumNodes(), 0);
+  SPIEL_CHECK_GE(searcher.NodesPerSecond(), 0);
+  state->ApplyAction(4);
+  state->ApplyAction(1);
+  std::pair<double, Action> value_and_action = searcher.Search(*state, -1);
+  SPIEL_CHECK_EQ(value_and_action.first, 1.0);
+  std::unique_ptr<State> child = state->Child(value_and_action.second);
+  SPIEL_CHECK_EQ(AlphaBetaSearch(*game, child.get(), {}, -1, 0).first, 1.0);
+
+  // x has three in column 0, so o must block it, or x wins.
+  game = LoadGame("connect_four");
+  AlphaBetaSearcher connect_four_searcher(
+      *game, [](const State&) { return 0.0; }, /*transposition_table_mb=*/1,
+      /*num_threads=*/4);
+  state = game->NewInitialState();
+  for (Action action : {0, 1, 0, 1, 0}) state->ApplyAction(action);
+  SPIEL_CHECK_EQ(connect_four_searcher.Search(*state, 6).second, 0);
+  SPIEL_CHECK_EQ(connect_four_searcher.LastDepth(), 6);
+}
+
+// Counts the pieces of each player in the center column of connect_four as
+// actions are applied and undone, checking that it follows the state.
+class CenterColumnEvaluator : public IncrementalEvaluator {
+ public:
+  std::unique_ptr<IncrementalEvaluator> Clone() const override {
+    return std::make_unique<CenterColumnEvaluator>(*this);
+  }
+
+  void Reset(const State& state) override {
+    path_ = state.History();
+    counts_ = {0, 0};
+    for (int i = 0; i < path_.size(); ++i) {
+      if (path_[i] == kCenter) ++counts_[i % 2];
+    }
+  }
+
+  void ApplyAction(const State& state, Action action) override {
+    SPIEL_CHECK_TRUE(state.History() == path_);
+    if (action == kCenter) ++counts_[state.CurrentPlayer()];
+    path_.push_back(action);
+  }
+
+  void UndoAction(const State& state, Player player, Action action) override {
+    SPIEL_CHECK_EQ(path_.back(), action);
+    path_.pop_back();
+    SPIEL_CHECK_TRUE(state.History() == path_);
+    if (action == kCenter) --counts_[player];
+  }
+
+  double Evaluate(const State& state, Player player) const override {
+    SPIEL_CHECK_TRUE(state.History() == path_);
+    return (counts_[player] - counts_[1 - player]) / 100.0;
+  }
+
+  // The same value, from scratch.
+  static double Value(const State& state, Player player) {
+    CenterColumnEvaluator evaluator;
+    evaluator.Reset(state);
+    return evaluator.Evaluate(state, player);
+  }
+
+ private:
+  static constexpr Action kCenter = 3;
+  std::vector<Action> path_;
+  std::array<int, 2> counts_ = {0, 0};
+};
+
+// An incremental evaluator gives the same search as the equivalent value
+// function, and is kept in sync by every thread.
+void AlphaBetaSearcherTest_IncrementalEvaluator() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : {3, 2, 4}) state->ApplyAction(action);
+  const Player player = state->CurrentPlayer();
+  AlphaBetaSearcher searcher(*game, CenterColumnEvaluator());
+  AlphaBetaSearcher function_searcher(*game, [player](const State& s) {
+    return CenterColumnEvaluator::Value(s, player);
+  });
+  for (int depth = 1; depth <= 5; ++depth) {
+    std::pair<double, Action> value_and_action =
+        searcher.Search(*state, depth);
+    SPIEL_CHECK_TRUE(value_and_action ==
+                     function_searcher.Search(*state, depth));
+    SPIEL_CHECK_EQ(searcher.LastDepth(), depth);
+  }
+
+  AlphaBetaSearcher parallel_searcher(*game, CenterColumnEvaluator(),
+                                      /*transposition_table_mb=*/1,
+                                      /*num_threads=*/2);
+  std::pair<double, Action> value_and_action =
+      parallel_searcher.Search(*state, 6);
+  SPIEL_CHECK_EQ(parallel_searcher.LastDepth(), 6);
+  SPIEL_CHECK_TRUE(absl::c_linear_search(state->LegalActions(),
+                                          value_and_action.second));
+}
+
+// Plain expectiminimax, as in python/algorithms/minimax.py.
+double Expectiminimax(const State& state, int depth,
+                      const std::function<double(const State&)>& value_function,
+                      Player maximizing_player) {
+  if (state.IsTerminal()) return state.PlayerReturn(maximizing_player);
+  if (depth == 0) return value_function(state);
+  if (state.IsChanceNode()) {
+    double value = 0;
+    for (const auto& [outcome, probability] : state.ChanceOutcomes()) {
+      value += probability * Expectiminimax(*state.Child(outcome), depth,
+                                            value_function, maximizing_player);
+    }
+    return value;
+  }
+  std::vector<double> values;
+  for (Action action : state.LegalActions()) {
+    values.push_back(Expectiminimax(*state.Child(action), depth - 1,
+                                    value_function, maximizing_player));
+  }
+  return state.CurrentPlayer() == maximizing_player
+             ? *absl::c_max_element(values)
+             : *absl::c_min_element(values);
+}
+
+// An arbitrary value function in [-1, 1), to exercise the pruning.
+double HashValue(const State& state) {
+  return static_cast<double>(state.Hash() % 1000) / 500 - 1;
+}
+
+// The pruned search finds the same values as the plain one, and an action
+// that achieves it.
+void ExpectiminimaxSearchTest_MatchesExpectiminimax(
+    const std::string& game_name, int max_depth) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::mt19937 rng(0);
+  std::unique_ptr<State> state = game->NewInitialState();
+  // Skips backgammon's opening roll, which is repeated on ties.
+  while (state->IsChanceNode()) {
+    state->ApplyAction(SampleAction(state->ChanceOutcomes(), rng).first);
+  }
+  for (int move = 0; move < 10 && !state->IsTerminal(); ++move) {
+    for (int depth = 1; depth <= max_depth; ++depth) {
+      const Player player =
+          state->IsChanceNode() ? Player{0} : state->CurrentPlayer();
+      std::pair<double, Action> value_and_action = ExpectiminimaxSearch(
+          *game, state.get(), HashValue, depth, player);
+      if (state->IsChanceNode()) {
+        SPIEL_CHECK_EQ(value_and_action.second, kInvalidAction);
+      } else {
+        SPIEL_CHECK_FLOAT_NEAR(
+            Expectiminimax(*state->Child(value_and_action.second), depth - 1,
+                           HashValue, player),
+            value_and_action.first, 1e-9);
+      }
+      SPIEL_CHECK_FLOAT_NEAR(
+          Expectiminimax(*state, depth, HashValue, player),
+          value_and_action.first, 1e-9);
+    }
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[absl::Uniform<int>(rng, 0, actions.size())]);
+  }
+}
+
+// Without a depth limit, short games are solved exactly.
+void ExpectiminimaxSearchTest_PigFullDepth() {
+  std::shared_ptr<const Game> game = LoadGame("pig(horizon=8,winscore=6)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::pair<double, Action> value_and_action =
+      ExpectiminimaxSearch(*game, state.get(), {}, -1, kInvalidPlayer);
+  SPIEL_CHECK_FLOAT_NEAR(Expectiminimax(*state, -1, {}, Player{0}),
+                         value_and_action.first, 1e-9);
+  SPIEL_CHECK_NE(value_and_action.second, kInvalidAction);
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -72,4 +319,13 @@ int main(int argc, char **argv) {
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe();
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_Win();
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_Loss();
+  open_spiel::algorithms::AlphaBetaSearcherTest_TicTacToe();
+  open_spiel::algorithms::AlphaBetaSearcherTest_ConnectFour();
+  open_spiel::algorithms::AlphaBetaSearcherTest_Parallel();
+  open_spiel::algorithms::AlphaBetaSearcherTest_IncrementalEvaluator();
+  open_spiel::algorithms::ExpectiminimaxSearchTest_MatchesExpectiminimax(
+      "pig(winscore=10)", 4);
+  open_spiel::algorithms::ExpectiminimaxSearchTest_MatchesExpectiminimax(
+      "backgammon", 2);
+  open_spiel::algorithms::ExpectiminimaxSearchTest_PigFullDepth();
 }
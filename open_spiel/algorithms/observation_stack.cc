@@ -0,0 +1,71 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/observation_stack.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+ObservationStack::ObservationStack(int num_players, int observation_size,
+                                   int num_frames)
+    : observation_size_(observation_size),
+      num_frames_(num_frames),
+      frames_(num_players * num_frames * observation_size),
+      newest_(num_players) {
+  SPIEL_CHECK_GT(num_players, 0);
+  SPIEL_CHECK_GT(observation_size, 0);
+  SPIEL_CHECK_GT(num_frames, 0);
+  Reset();
+}
+
+void ObservationStack::Reset() {
+  std::fill(frames_.begin(), frames_.end(), 0.0f);
+  // The next frame goes to slot 0.
+  std::fill(newest_.begin(), newest_.end(), num_frames_ - 1);
+}
+
+void ObservationStack::Push(const State& state, Player player) {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, newest_.size());
+  newest_[player] = (newest_[player] + 1) % num_frames_;
+  state.ObservationTensor(
+      player, absl::MakeSpan(frames_).subspan(
+                  (player * num_frames_ + newest_[player]) * observation_size_,
+                  observation_size_));
+}
+
+void ObservationStack::Stacked(Player player, absl::Span<float> stacked) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, newest_.size());
+  SPIEL_CHECK_EQ(stacked.size(), num_frames_ * observation_size_);
+  // The ring from the oldest frame to its end, then from its start to the
+  // newest frame.
+  const float* ring = &frames_[player * num_frames_ * observation_size_];
+  const int oldest = (newest_[player] + 1) % num_frames_;
+  const int num_wrapped = oldest * observation_size_;
+  const int num_unwrapped = num_frames_ * observation_size_ - num_wrapped;
+  std::copy(ring + num_wrapped, ring + num_wrapped + num_unwrapped,
+            stacked.begin());
+  std::copy(ring, ring + num_wrapped, stacked.begin() + num_unwrapped);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,63 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OBSERVATION_STACK_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OBSERVATION_STACK_H_
+
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// The last num_frames observation tensors of each player of an episode, for
+// agents without memory that act on a stack of recent observations, e.g. in
+// phantom_ttt or laser_tag.
+//
+// Each player's frames are kept in a ring buffer, so adding a frame only
+// writes that frame, and Stacked() copies the frames out, oldest first, as one
+// contiguous [num_frames, observation_size] tensor. Until a player has
+// num_frames frames, the oldest ones are zero.
+class ObservationStack {
+ public:
+  ObservationStack(int num_players, int observation_size, int num_frames);
+
+  // Clears the frames of every player, e.g. at the start of an episode.
+  void Reset();
+
+  // Adds the observation of `player` in `state` as their newest frame.
+  void Push(const State& state, Player player);
+
+  // Writes the frames of the player, oldest first, to `stacked`, which must
+  // have num_frames * observation_size values.
+  void Stacked(Player player, absl::Span<float> stacked) const;
+
+  int num_frames() const { return num_frames_; }
+  int observation_size() const { return observation_size_; }
+
+ private:
+  const int observation_size_;
+  const int num_frames_;
+  // [num_players, num_frames, observation_size] frames, where the newest
+  // frame of player p is at index newest_[p] of its ring.
+  std::vector<float> frames_;
+  std::vector<int> newest_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OBSERVATION_STACK_H_
@@ -0,0 +1,118 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/observation_stack.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/vector_env.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kNumFrames = 3;
+
+std::vector<float> Observation(const State& state, Player player) {
+  const std::vector<double> observation = state.ObservationTensor(player);
+  return std::vector<float>(observation.begin(), observation.end());
+}
+
+// Plays random games, checking the stacks against the observations of each
+// player's last turns.
+void StackedFramesTest(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  const int size = game->ObservationTensorSize();
+  ObservationStack stack(game->NumPlayers(), size, kNumFrames);
+  std::mt19937 rng(7);
+  for (int episode = 0; episode < 5; ++episode) {
+    stack.Reset();
+    // The expected frames of each player, oldest first.
+    std::vector<std::vector<std::vector<float>>> frames(
+        game->NumPlayers(),
+        std::vector<std::vector<float>>(kNumFrames,
+                                        std::vector<float>(size, 0.0f)));
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(state->SampleChanceOutcome(rng).first);
+        continue;
+      }
+      const Player player = state->CurrentPlayer();
+      stack.Push(*state, player);
+      frames[player].erase(frames[player].begin());
+      frames[player].push_back(Observation(*state, player));
+
+      std::vector<float> stacked(kNumFrames * size);
+      stack.Stacked(player, absl::MakeSpan(stacked));
+      for (int frame = 0; frame < kNumFrames; ++frame) {
+        for (int i = 0; i < size; ++i) {
+          SPIEL_CHECK_EQ(stacked[frame * size + i], frames[player][frame][i]);
+        }
+      }
+      const std::vector<Action> legal_actions = state->LegalActions();
+      state->ApplyAction(legal_actions[std::uniform_int_distribution<int>(
+          0, legal_actions.size() - 1)(rng)]);
+    }
+  }
+}
+
+// The stacked observations of VectorEnv end with those of the player to act,
+// and start over with each episode.
+void VectorEnvStackedObservationsTest() {
+  std::shared_ptr<const Game> game = LoadGame("phantom_ttt");
+  const int size = game->ObservationTensorSize();
+  constexpr int kNumEnvs = 4;
+  VectorEnv env(game, kNumEnvs, /*seed=*/1, kNumFrames);
+  SPIEL_CHECK_EQ(env.observations().size(), kNumEnvs * kNumFrames * size);
+  std::mt19937 rng(3);
+  for (int step = 0; step < 100; ++step) {
+    for (int i = 0; i < kNumEnvs; ++i) {
+      const float* stacked = &env.observations()[i * kNumFrames * size];
+      const std::vector<float> observation =
+          Observation(env.state(i), env.current_players()[i]);
+      for (int j = 0; j < size; ++j) {
+        SPIEL_CHECK_EQ(stacked[(kNumFrames - 1) * size + j], observation[j]);
+      }
+      // A new episode has a single frame.
+      if (step == 0 || env.dones()[i]) {
+        for (int j = 0; j < (kNumFrames - 1) * size; ++j) {
+          SPIEL_CHECK_EQ(stacked[j], 0.0f);
+        }
+      }
+    }
+    std::vector<Action> actions;
+    for (int i = 0; i < kNumEnvs; ++i) {
+      const std::vector<Action> legal_actions = env.state(i).LegalActions();
+      actions.push_back(legal_actions[std::uniform_int_distribution<int>(
+          0, legal_actions.size() - 1)(rng)]);
+    }
+    env.Step(actions);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::StackedFramesTest("phantom_ttt");
+  open_spiel::algorithms::StackedFramesTest("kuhn_poker");
+  open_spiel::algorithms::VectorEnvStackedObservationsTest();
+}
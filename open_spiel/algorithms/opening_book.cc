@@ -0,0 +1,267 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/opening_book.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/ascii.h"
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr char kBookMagic[8] = {'O', 'S', 'B', 'O', 'O', 'K', '0', '1'};
+
+// A record is the hash, the action, the weight and the value, in native byte
+// order.
+constexpr int kRecordSize =
+    sizeof(uint64_t) + sizeof(int64_t) + 2 * sizeof(double);
+
+// Returns the actions of a line of a log, or fails.
+std::vector<Action> ParseGame(absl::string_view line,
+                              absl::string_view location) {
+  std::vector<Action> history;
+  for (absl::string_view token :
+       absl::StrSplit(line, ' ', absl::SkipWhitespace())) {
+    Action action;
+    if (!absl::SimpleAtoi(token, &action)) {
+      SpielFatalError(absl::StrCat(location, ": bad action '", token, "'"));
+    }
+    history.push_back(action);
+  }
+  return history;
+}
+
+}  // namespace
+
+OpeningBook::OpeningBook(const std::string& filename) : file_(filename) {
+  const absl::string_view contents = file_.Contents();
+  if (contents.size() < sizeof(kBookMagic) ||
+      std::memcmp(contents.data(), kBookMagic, sizeof(kBookMagic)) != 0 ||
+      (contents.size() - sizeof(kBookMagic)) % kRecordSize != 0) {
+    SpielFatalError(absl::StrCat(filename, " is not an opening book."));
+  }
+  size_ = (contents.size() - sizeof(kBookMagic)) / kRecordSize;
+}
+
+uint64_t OpeningBook::Hash(int64_t index) const {
+  uint64_t hash;
+  std::memcpy(&hash,
+              file_.Contents().data() + sizeof(kBookMagic) +
+                  index * kRecordSize,
+              sizeof(hash));
+  return hash;
+}
+
+BookMove OpeningBook::Move(int64_t index) const {
+  const char* record =
+      file_.Contents().data() + sizeof(kBookMagic) + index * kRecordSize;
+  BookMove move;
+  int64_t action;
+  std::memcpy(&action, record + sizeof(uint64_t), sizeof(action));
+  std::memcpy(&move.weight, record + sizeof(uint64_t) + sizeof(int64_t),
+              sizeof(double));
+  std::memcpy(&move.value,
+              record + sizeof(uint64_t) + sizeof(int64_t) + sizeof(double),
+              sizeof(double));
+  move.action = action;
+  return move;
+}
+
+std::vector<BookMove> OpeningBook::Moves(uint64_t hash) const {
+  // The first record of `hash`, by binary search.
+  int64_t lo = 0;
+  int64_t hi = size_;
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (Hash(mid) < hash) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  std::vector<BookMove> moves;
+  for (int64_t i = lo; i < size_ && Hash(i) == hash; ++i) {
+    moves.push_back(Move(i));
+  }
+  return moves;
+}
+
+std::vector<BookMove> OpeningBook::Moves(const State& state) const {
+  if (state.IsTerminal() || state.IsChanceNode()) return {};
+  std::vector<BookMove> moves = Moves(state.Hash());
+  if (moves.empty()) return moves;
+  const std::vector<Action> legal_actions = state.LegalActions();
+  moves.erase(std::remove_if(moves.begin(), moves.end(),
+                             [&legal_actions](const BookMove& move) {
+                               return !std::binary_search(
+                                   legal_actions.begin(), legal_actions.end(),
+                                   move.action);
+                             }),
+              moves.end());
+  return moves;
+}
+
+ActionsAndProbs OpeningBook::Policy(const State& state) const {
+  const std::vector<BookMove> moves = Moves(state);
+  double total_weight = 0;
+  for (const BookMove& move : moves) total_weight += move.weight;
+  ActionsAndProbs policy;
+  if (total_weight <= 0) return policy;
+  policy.reserve(moves.size());
+  for (const BookMove& move : moves) {
+    policy.push_back({move.action, move.weight / total_weight});
+  }
+  return policy;
+}
+
+BookMove OpeningBook::BestMove(const State& state) const {
+  BookMove best;
+  for (const BookMove& move : Moves(state)) {
+    if (best.action == kInvalidAction || move.weight > best.weight) {
+      best = move;
+    }
+  }
+  return best;
+}
+
+void OpeningBookBuilder::AddGame(const Game& game,
+                                 const std::vector<Action>& history,
+                                 int max_plies) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("Opening books require sequential games.");
+  }
+  std::unique_ptr<State> state = game.NewInitialState();
+  std::vector<std::pair<uint64_t, Action>> keys;
+  std::vector<Player> players;
+  for (int ply = 0; ply < history.size(); ++ply) {
+    if (state->IsTerminal()) {
+      SpielFatalError(absl::StrCat("Actions after the end of the game at ply ",
+                                   ply));
+    }
+    if (ply < max_plies && !state->IsChanceNode()) {
+      keys.push_back({state->Hash(), history[ply]});
+      players.push_back(state->CurrentPlayer());
+    }
+    state->ApplyAction(history[ply]);
+  }
+  if (!state->IsTerminal()) SpielFatalError("The game is not over.");
+  const std::vector<double> returns = state->Returns();
+  for (int i = 0; i < keys.size(); ++i) {
+    MoveStats& stats = moves_[keys[i]];
+    stats.weight += 1;
+    stats.total_value += returns[players[i]];
+  }
+}
+
+void OpeningBookBuilder::Merge(const OpeningBookBuilder& other) {
+  for (const auto& [key, other_stats] : other.moves_) {
+    MoveStats& stats = moves_[key];
+    stats.weight += other_stats.weight;
+    stats.total_value += other_stats.total_value;
+  }
+}
+
+void OpeningBookBuilder::Save(const std::string& filename,
+                              double min_weight) const {
+  std::vector<std::pair<std::pair<uint64_t, Action>, MoveStats>> moves;
+  moves.reserve(moves_.size());
+  for (const auto& entry : moves_) {
+    if (entry.second.weight >= min_weight) moves.push_back(entry);
+  }
+  std::sort(moves.begin(), moves.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  file::BufferedWriter writer(filename, "wb");
+  std::string record(kRecordSize, '\0');
+  SPIEL_CHECK_TRUE(
+      writer.Write(absl::string_view(kBookMagic, sizeof(kBookMagic))));
+  for (const auto& [key, stats] : moves) {
+    const uint64_t hash = key.first;
+    const int64_t action = key.second;
+    const double value = stats.total_value / stats.weight;
+    char* out = record.data();
+    std::memcpy(out, &hash, sizeof(hash));
+    std::memcpy(out + sizeof(hash), &action, sizeof(action));
+    std::memcpy(out + sizeof(hash) + sizeof(action), &stats.weight,
+                sizeof(double));
+    std::memcpy(out + sizeof(hash) + sizeof(action) + sizeof(double), &value,
+                sizeof(double));
+    SPIEL_CHECK_TRUE(writer.Write(record));
+  }
+  SPIEL_CHECK_TRUE(writer.Flush());
+}
+
+OpeningBookBuilder BuildOpeningBook(const Game& game,
+                                    const std::vector<std::string>& log_files,
+                                    int max_plies, int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  // The logs stay in memory while the lines point into them.
+  std::vector<std::string> contents;
+  contents.reserve(log_files.size());
+  for (const std::string& log_file : log_files) {
+    contents.push_back(file::File(log_file, "r").ReadContents());
+  }
+  struct Line {
+    absl::string_view text;
+    int file;
+    int number;
+  };
+  std::vector<Line> lines;
+  for (int f = 0; f < contents.size(); ++f) {
+    int number = 0;
+    for (absl::string_view text : absl::StrSplit(contents[f], '\n')) {
+      ++number;
+      if (!absl::StripAsciiWhitespace(text).empty()) {
+        lines.push_back({text, f, number});
+      }
+    }
+  }
+
+  std::vector<OpeningBookBuilder> builders(num_threads);
+  std::vector<Thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = t; i < lines.size(); i += num_threads) {
+        const Line& line = lines[i];
+        builders[t].AddGame(
+            game,
+            ParseGame(line.text,
+                      absl::StrCat(log_files[line.file], ":", line.number)),
+            max_plies);
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+  for (int t = 1; t < num_threads; ++t) builders[0].Merge(builders[t]);
+  return std::move(builders[0]);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,124 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OPENING_BOOK_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OPENING_BOOK_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+// Opening books: the moves played from the early positions of a game, e.g. by
+// self-play, with their weights and mean outcomes, so that bots can play them
+// without searching. Positions are identified by State::Hash, so the book
+// suits the games whose hash identifies positions rather than histories, like
+// chess (ChessBoard::HashValue), go (GoBoard::HashValue) or connect_four, and
+// merges the move orders leading to the same position.
+//
+// A book file holds fixed-size records of (hash, action, weight, value),
+// sorted by hash then action, after a magic string. OpeningBook memory maps
+// it and finds the moves of a position by binary search, so a large book is
+// ready in constant time and shared in the page cache by the bot processes
+// using it. MCTSBot::SetOpeningBook and AlphaBetaSearcher::SetOpeningBook
+// make them consult a book before searching.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct BookMove {
+  Action action = kInvalidAction;
+  double weight = 0;  // The number of games which played it.
+  double value = 0;   // The mean return of the player playing it.
+};
+
+// A book saved by OpeningBookBuilder::Save. The file must not be changed
+// while it is mapped.
+class OpeningBook {
+ public:
+  explicit OpeningBook(const std::string& filename);
+
+  OpeningBook(const OpeningBook&) = delete;
+  OpeningBook& operator=(const OpeningBook&) = delete;
+
+  // The number of moves, over all positions.
+  int64_t Size() const { return size_; }
+
+  // The moves of the positions with this hash, by increasing action.
+  std::vector<BookMove> Moves(uint64_t hash) const;
+
+  // The moves of `state` that are legal in it, which guards against hash
+  // collisions. Empty out of the book, and at chance and terminal nodes.
+  std::vector<BookMove> Moves(const State& state) const;
+
+  // The moves of `state` with probabilities proportional to their weights,
+  // or an empty policy out of the book.
+  ActionsAndProbs Policy(const State& state) const;
+
+  // The move of `state` with the highest weight, the lowest action among
+  // ties, or a move with kInvalidAction out of the book.
+  BookMove BestMove(const State& state) const;
+
+ private:
+  uint64_t Hash(int64_t index) const;
+  BookMove Move(int64_t index) const;
+
+  file::MappedFile file_;
+  int64_t size_;
+};
+
+// Collects the moves of games into a book.
+class OpeningBookBuilder {
+ public:
+  // Adds the moves of the decision nodes among the first max_plies actions
+  // of a whole game given by its history, valued with the game's returns.
+  // Only supports sequential games.
+  void AddGame(const Game& game, const std::vector<Action>& history,
+               int max_plies);
+
+  // Adds the moves of `other`.
+  void Merge(const OpeningBookBuilder& other);
+
+  // The number of distinct moves, over all positions.
+  int64_t Size() const { return moves_.size(); }
+
+  // Writes the moves with a weight of at least min_weight to a book file.
+  void Save(const std::string& filename, double min_weight = 1) const;
+
+ private:
+  struct MoveStats {
+    double weight = 0;
+    double total_value = 0;
+  };
+
+  absl::flat_hash_map<std::pair<uint64_t, Action>, MoveStats> moves_;
+};
+
+// Builds a book from self-play logs: text files with a whole game per line,
+// given as the space-separated numbers of its actions, e.g. as written from
+// State::History. The lines are split between num_threads threads, each
+// collecting its own builder, and the builders are then merged.
+OpeningBookBuilder BuildOpeningBook(const Game& game,
+                                    const std::vector<std::string>& log_files,
+                                    int max_plies, int num_threads = 1);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OPENING_BOOK_H_
@@ -0,0 +1,216 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/opening_book.h"
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+std::string TempFilename(const std::string& name) {
+  const char* tmp_dir = std::getenv("TMPDIR");
+  return absl::StrCat(tmp_dir != nullptr ? tmp_dir : "/tmp", "/open_spiel-",
+                      name, "-", std::rand());  // NOLINT
+}
+
+// A uniformly random game, starting with `prefix`.
+std::vector<Action> RandomGame(const Game& game, std::mt19937* rng,
+                               const std::vector<Action>& prefix = {}) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  for (Action action : prefix) state->ApplyAction(action);
+  while (!state->IsTerminal()) {
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[std::uniform_int_distribution<int>(
+        0, actions.size() - 1)(*rng)]);
+  }
+  return state->History();
+}
+
+// Writes games to a self-play log.
+std::string WriteLog(const std::string& name,
+                     const std::vector<std::vector<Action>>& games) {
+  const std::string filename = TempFilename(name);
+  file::File log(filename, "w");
+  for (const std::vector<Action>& history : games) {
+    SPIEL_CHECK_TRUE(log.Write(absl::StrCat(absl::StrJoin(history, " "),
+                                            "\n")));
+  }
+  return filename;
+}
+
+void BuildsBookFromLogs() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  std::mt19937 rng(42);
+  std::vector<std::vector<Action>> games;
+  for (int i = 0; i < 200; ++i) games.push_back(RandomGame(*game, &rng));
+  const std::string log = WriteLog("book_log", games);
+
+  // The first moves, and the returns of their players.
+  std::map<Action, int> counts;
+  std::map<Action, double> returns;
+  for (const std::vector<Action>& history : games) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    for (Action action : history) state->ApplyAction(action);
+    ++counts[history[0]];
+    returns[history[0]] += state->Returns()[0];
+  }
+
+  const std::string serial_file = TempFilename("book_serial");
+  const std::string parallel_file = TempFilename("book_parallel");
+  BuildOpeningBook(*game, {log}, /*max_plies=*/4).Save(serial_file);
+  BuildOpeningBook(*game, {log, log}, /*max_plies=*/4, /*num_threads=*/4)
+      .Save(parallel_file, /*min_weight=*/2);
+  {
+    OpeningBook book(serial_file);
+    std::unique_ptr<State> state = game->NewInitialState();
+    std::vector<BookMove> moves = book.Moves(*state);
+    SPIEL_CHECK_EQ(moves.size(), counts.size());
+    for (const BookMove& move : moves) {
+      SPIEL_CHECK_EQ(move.weight, counts[move.action]);
+      SPIEL_CHECK_FLOAT_EQ(move.value,
+                           returns[move.action] / counts[move.action]);
+    }
+    double total = 0;
+    for (const auto& [action, prob] : book.Policy(*state)) total += prob;
+    SPIEL_CHECK_FLOAT_EQ(total, 1);
+
+    // Only the first 4 plies are in the book.
+    for (int ply = 0; ply < 4; ++ply) state->ApplyAction(games[0][ply]);
+    SPIEL_CHECK_TRUE(book.Moves(*state).empty());
+    SPIEL_CHECK_EQ(book.BestMove(*state).action, kInvalidAction);
+
+    // The same log twice gives every move a weight of at least 2.
+    OpeningBook parallel_book(parallel_file);
+    SPIEL_CHECK_EQ(parallel_book.Size(), book.Size());
+    for (const BookMove& move :
+         parallel_book.Moves(*game->NewInitialState())) {
+      SPIEL_CHECK_EQ(move.weight, 2 * counts[move.action]);
+    }
+  }
+  SPIEL_CHECK_TRUE(file::Remove(log));
+  SPIEL_CHECK_TRUE(file::Remove(serial_file));
+  SPIEL_CHECK_TRUE(file::Remove(parallel_file));
+}
+
+void MergesTranspositions() {
+  // 0 1 2 and 2 1 0 reach the same connect_four position.
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  std::mt19937 rng(7);
+  OpeningBookBuilder builder;
+  builder.AddGame(*game, RandomGame(*game, &rng, {0, 1, 2, 3}), 4);
+  builder.AddGame(*game, RandomGame(*game, &rng, {2, 1, 0, 3}), 4);
+  const std::string filename = TempFilename("book_transpositions");
+  builder.Save(filename);
+  {
+    OpeningBook book(filename);
+    std::unique_ptr<State> state = game->NewInitialState();
+    for (Action action : {0, 1, 2}) state->ApplyAction(action);
+    std::vector<BookMove> moves = book.Moves(*state);
+    SPIEL_CHECK_EQ(moves.size(), 1);
+    SPIEL_CHECK_EQ(moves[0].action, 3);
+    SPIEL_CHECK_EQ(moves[0].weight, 2);
+  }
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+}
+
+void SupportsGamesHashedByBoard(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::mt19937 rng(1);
+  OpeningBookBuilder builder;
+  std::vector<Action> history = RandomGame(*game, &rng);
+  builder.AddGame(*game, history, 2);
+  const std::string filename = TempFilename("book_board");
+  builder.Save(filename);
+  {
+    OpeningBook book(filename);
+    SPIEL_CHECK_EQ(book.Size(), 2);
+    std::unique_ptr<State> state = game->NewInitialState();
+    SPIEL_CHECK_EQ(book.BestMove(*state).action, history[0]);
+    state->ApplyAction(history[0]);
+    SPIEL_CHECK_EQ(book.BestMove(*state).action, history[1]);
+  }
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+}
+
+void SearchesConsultTheBook() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::mt19937 rng(3);
+  OpeningBookBuilder builder;
+  // x(0,0) twice and x(1,1) once.
+  builder.AddGame(*game, RandomGame(*game, &rng, {0}), 1);
+  builder.AddGame(*game, RandomGame(*game, &rng, {0}), 1);
+  builder.AddGame(*game, RandomGame(*game, &rng, {4}), 1);
+  const std::string filename = TempFilename("book_search");
+  builder.Save(filename);
+  {
+    OpeningBook book(filename);
+    std::unique_ptr<State> state = game->NewInitialState();
+
+    RandomRolloutEvaluator evaluator(10, 42);
+    MCTSBot bot(*game, &evaluator, /*uct_c=*/2, /*max_simulations=*/100,
+                /*max_memory_mb=*/5, /*solve=*/true, /*seed=*/42,
+                /*verbose=*/false);
+    bot.SetOpeningBook(&book);
+    for (int i = 0; i < 10; ++i) {
+      const Action action = bot.Step(*state);
+      SPIEL_CHECK_TRUE(action == 0 || action == 4);
+      SPIEL_CHECK_EQ(bot.NumSimulations(), 0);
+    }
+    // Out of the book, the bot searches.
+    std::unique_ptr<State> child = state->Child(4);
+    bot.Step(*child);
+    SPIEL_CHECK_GT(bot.NumSimulations(), 0);
+
+    AlphaBetaSearcher searcher(*game, /*value_function=*/nullptr);
+    searcher.SetOpeningBook(&book);
+    const BookMove best = book.BestMove(*state);
+    SPIEL_CHECK_EQ(best.action, 0);
+    auto [value, action] = searcher.Search(*state, /*depth_limit=*/-1);
+    SPIEL_CHECK_EQ(action, 0);
+    SPIEL_CHECK_EQ(value, best.value);
+    SPIEL_CHECK_EQ(searcher.NumNodes(), 0);
+    std::tie(value, action) =
+        searcher.Search(*state, /*depth_limit=*/-1, /*maximizing_player=*/1);
+    SPIEL_CHECK_EQ(value, -best.value);
+  }
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::BuildsBookFromLogs();
+  open_spiel::algorithms::MergesTranspositions();
+  open_spiel::algorithms::SupportsGamesHashedByBoard("chess");
+  open_spiel::algorithms::SupportsGamesHashedByBoard("go(board_size=5)");
+  open_spiel::algorithms::SearchesConsultTheBook();
+}
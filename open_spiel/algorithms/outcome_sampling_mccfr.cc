@@ -14,17 +14,36 @@
 
 #include "open_spiel/algorithms/outcome_sampling_mccfr.h"
 
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <numeric>
-#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include "open_spiel/abseil-cpp/absl/random/discrete_distribution.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/cfr_kernels.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
+
+// Resets `state` to `initial_state`, in place if the game supports it.
+void ResetState(const State& initial_state, std::unique_ptr<State>* state) {
+  if (*state == nullptr || !(*state)->CopyFrom(initial_state)) {
+    *state = initial_state.Clone();
+  }
+}
+
+}  // namespace
 
 OutcomeSamplingMCCFRSolver::OutcomeSamplingMCCFRSolver(const Game& game,
                                                        double epsilon, int seed)
@@ -32,15 +51,117 @@ OutcomeSamplingMCCFRSolver::OutcomeSamplingMCCFRSolver(const Game& game,
       epsilon_(epsilon),
       num_players_(game.NumPlayers()),
       update_player_(-1),
-      rng_(seed >= 0 ? seed : std::mt19937::default_seed),
-      dist_(0.0, 1.0),
+      rng_(seed >= 0 ? seed : 0),
       uniform_policy_(std::shared_ptr<TabularPolicy>(
           new TabularPolicy(GetUniformPolicy(game)))) {}
 
-void OutcomeSamplingMCCFRSolver::RunIteration(std::mt19937* rng) {
+void OutcomeSamplingMCCFRSolver::RunIteration(Xoshiro256PlusPlus* rng) {
   update_player_ = (update_player_ + 1) % num_players_;
   std::unique_ptr<State> state = game_.NewInitialState();
-  SampleEpisode(state.get(), rng, 1.0, 1.0, 1.0);
+  SampleEpisode(state.get(), update_player_, rng, 1.0, 1.0, 1.0);
+  ++num_iterations_;
+}
+
+void OutcomeSamplingMCCFRSolver::RunIterations(int num_iterations,
+                                               int num_threads,
+                                               MemoryPlacement placement) {
+  SPIEL_CHECK_GE(num_iterations, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  const std::unique_ptr<State> initial_state = game_.NewInitialState();
+  if (num_threads == 1) {
+    std::unique_ptr<State> state;
+    for (int i = 0; i < num_iterations; ++i) {
+      update_player_ = (update_player_ + 1) % num_players_;
+      ResetState(*initial_state, &state);
+      SampleEpisode(state.get(), update_player_, &rng_, 1.0, 1.0, 1.0);
+      ++num_iterations_;
+    }
+    return;
+  }
+
+  // Non-overlapping streams, leaving the internal one past them all.
+  std::vector<Xoshiro256PlusPlus> rngs;
+  for (int t = 0; t < num_threads; ++t) {
+    rngs.push_back(rng_);
+    rng_.Jump();
+  }
+
+  // Iteration i updates the same player as the i-th call to RunIteration().
+  const int first_update_player = update_player_ + 1;
+  concurrent_ = true;
+  std::atomic<int> next_iteration{0};
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      SetThreadMemoryPlacement(placement, t);
+      std::unique_ptr<State> state;
+      int iteration;
+      while ((iteration = next_iteration++) < num_iterations) {
+        ResetState(*initial_state, &state);
+        SampleEpisode(state.get(),
+                      (first_update_player + iteration) % num_players_,
+                      &rngs[t], 1.0, 1.0, 1.0);
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+  concurrent_ = false;
+  update_player_ = (update_player_ + num_iterations) % num_players_;
+  num_iterations_ += num_iterations;
+}
+
+void OutcomeSamplingMCCFRSolver::SaveCheckpoint(
+    const std::string& filename) const {
+  std::ostringstream rng_state;
+  rng_state << rng_;
+  SaveCFRCheckpoint(filename, num_iterations_, rng_state.str(), info_states_);
+}
+
+void OutcomeSamplingMCCFRSolver::LoadCheckpoint(const std::string& filename) {
+  int64_t iteration;
+  std::string rng_state;
+  info_states_.clear();
+  LoadCFRCheckpoint(filename, &iteration, &rng_state,
+                    [this](const std::string& info_state,
+                           CFRInfoStateValues values) {
+                      info_states_[info_state] = std::move(values);
+                    });
+  num_iterations_ = iteration;
+  // Iterations update the players in turn, starting with player 0.
+  update_player_ = (num_iterations_ + num_players_ - 1) % num_players_;
+  std::istringstream rng_stream(rng_state);
+  rng_stream >> rng_;
+  SPIEL_CHECK_FALSE(rng_stream.fail());
+}
+
+CFRInfoStateValues* OutcomeSamplingMCCFRSolver::GetOrInsertInfoState(
+    const std::string& info_state, const std::vector<Action>& legal_actions) {
+  if (concurrent_) {
+    {
+      absl::ReaderMutexLock lock(&table_mutex_);
+      auto iter = info_states_.find(info_state);
+      if (iter != info_states_.end()) return &iter->second;
+    }
+    absl::WriterMutexLock lock(&table_mutex_);
+    return &info_states_
+                .insert({info_state, CFRInfoStateValues(legal_actions,
+                                                        kInitialTableValues)})
+                .first->second;
+  }
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map.
+  return &info_states_
+              .insert({info_state,
+                       CFRInfoStateValues(legal_actions, kInitialTableValues)})
+              .first->second;
+}
+
+absl::Mutex* OutcomeSamplingMCCFRSolver::StripeMutex(
+    const CFRInfoStateValues* values) {
+  if (!concurrent_) return nullptr;
+  return &stripe_mutexes_[std::hash<const CFRInfoStateValues*>()(values) %
+                          kNumLockStripes];
 }
 
 std::vector<double> OutcomeSamplingMCCFRSolver::SamplePolicy(
@@ -71,19 +192,20 @@ double OutcomeSamplingMCCFRSolver::BaselineCorrectedChildValue(
 }
 
 double OutcomeSamplingMCCFRSolver::SampleEpisode(State* state,
-                                                 std::mt19937* rng,
+                                                 Player update_player,
+                                                 Xoshiro256PlusPlus* rng,
                                                  double my_reach,
                                                  double opp_reach,
                                                  double sample_reach) {
   if (state->IsTerminal()) {
-    return state->PlayerReturn(update_player_);
+    return state->PlayerReturn(update_player);
   } else if (state->IsChanceNode()) {
     std::pair<Action, double> outcome_and_prob =
-        SampleAction(state->ChanceOutcomes(), dist_(*rng));
+        state->SampleChanceOutcome(*rng);
     SPIEL_CHECK_PROB(outcome_and_prob.second);
     SPIEL_CHECK_GT(outcome_and_prob.second, 0);
     state->ApplyAction(outcome_and_prob.first);
-    return SampleEpisode(state, rng, my_reach,
+    return SampleEpisode(state, update_player, rng, my_reach,
                          outcome_and_prob.second * opp_reach,
                          outcome_and_prob.second * sample_reach);
   } else if (state->IsSimultaneousNode()) {
@@ -98,31 +220,41 @@ double OutcomeSamplingMCCFRSolver::SampleEpisode(State* state,
   std::string is_key = state->InformationStateString(player);
   std::vector<Action> legal_actions = state->LegalActions();
 
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
-
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues& info_state = *GetOrInsertInfoState(is_key, legal_actions);
+  absl::Mutex* mutex = StripeMutex(&info_state);
+  CFRInfoStateValues info_state_copy;
+  {
+    absl::MutexLockMaybe lock(mutex);
+    info_state_copy = info_state;
+  }
   info_state_copy.ApplyRegretMatching();
 
   const std::vector<double>& sample_policy =
-      (player == update_player_ ? SamplePolicy(info_state_copy)
+      (player == update_player ? SamplePolicy(info_state_copy)
                                 : info_state_copy.current_policy);
 
-  absl::discrete_distribution<int> action_dist(sample_policy.begin(),
-                                               sample_policy.end());
-  int sampled_aidx = action_dist(*rng);
+  // A scan of the few actions is cheaper than building a distribution.
+  const double z =
+      UniformDouble(*rng) *
+      std::accumulate(sample_policy.begin(), sample_policy.end(), 0.0);
+  int sampled_aidx = -1;
+  double sum = 0;
+  for (int aidx = 0; aidx < sample_policy.size(); ++aidx) {
+    if (sample_policy[aidx] <= 0) continue;
+    sampled_aidx = aidx;
+    sum += sample_policy[aidx];
+    if (z < sum) break;
+  }
   SPIEL_CHECK_PROB(sample_policy[sampled_aidx]);
   SPIEL_CHECK_GT(sample_policy[sampled_aidx], 0);
 
   state->ApplyAction(legal_actions[sampled_aidx]);
   double child_value = SampleEpisode(
-      state, rng,
-      player == update_player_
+      state, update_player, rng,
+      player == update_player
           ? my_reach * info_state_copy.current_policy[sampled_aidx]
           : my_reach,
-      player == update_player_
+      player == update_player
           ? opp_reach
           : opp_reach * info_state_copy.current_policy[sampled_aidx],
       sample_reach * sample_policy[sampled_aidx]);
@@ -142,35 +274,30 @@ double OutcomeSamplingMCCFRSolver::SampleEpisode(State* state,
         info_state_copy.current_policy[sampled_aidx] * child_values[aidx];
   }
 
-  if (player == update_player_) {
+  if (player == update_player) {
     // Now the regret and avg strategy updates.
-    CFRInfoStateValues& info_state = info_states_[is_key];
+    absl::MutexLockMaybe lock(mutex);
     info_state.ApplyRegretMatching();
 
-    // Estimate for the counterfactual value of the policy.
-    double cf_value = value_estimate * opp_reach / sample_reach;
-
-    // Update regrets.
+    // Update regrets: the estimates of the counterfactual values of the
+    // policy, and of the policy replaced by always choosing aidx at this
+    // information state, are value_estimate and child_values[aidx], times
+    // opp_reach / sample_reach.
     //
     // Note: different from Chapter 4 of Lanctot '13 thesis, the utilities
     // coming back from the recursion are already multiplied by the players'
     // tail reaches and divided by the sample tail reach. So when adding regrets
     // to the table, we need only multiply by the opponent reach and divide by
     // the sample reach to this point.
-    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      // Estimate for the counterfactual value of the policy replaced by always
-      // choosing sampled_aidx at this information state.
-      double cf_action_value = child_values[aidx] * opp_reach / sample_reach;
-      info_state.cumulative_regrets[aidx] += (cf_action_value - cf_value);
-    }
+    AddRegrets(absl::MakeSpan(info_state.cumulative_regrets),
+               opp_reach / sample_reach, child_values, value_estimate);
 
     // Update the average policy.
-    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      double increment =
-          my_reach * info_state.current_policy[aidx] / sample_reach;
-      SPIEL_CHECK_FALSE(std::isnan(increment) || std::isinf(increment));
-      info_state.cumulative_policy[aidx] += increment;
-    }
+    const double averaging_weight = my_reach / sample_reach;
+    SPIEL_CHECK_FALSE(std::isnan(averaging_weight) ||
+                      std::isinf(averaging_weight));
+    AddWeightedPolicy(absl::MakeSpan(info_state.cumulative_policy),
+                      averaging_weight, info_state.current_policy);
   }
 
   return value_estimate;
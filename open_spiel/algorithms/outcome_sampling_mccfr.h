@@ -15,14 +15,17 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
 
+#include <cstdint>
 #include <memory>
-#include <random>
+#include <string>
 #include <vector>
 
-#include "open_spiel/abseil-cpp/absl/random/uniform_real_distribution.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/memory_placement.h"
+#include "open_spiel/utils/random.h"
 
 // An implementation of outcome sampling Monte Carlo Counterfactual Regret
 // Minimization (CFR). This version is implemented in a way that is closer to
@@ -49,7 +52,30 @@ class OutcomeSamplingMCCFRSolver {
   void RunIteration() { RunIteration(&rng_); }
 
   // Same as above, but uses the specified random number generator instead.
-  void RunIteration(std::mt19937* rng);
+  void RunIteration(Xoshiro256PlusPlus* rng);
+
+  // Performs `num_iterations` iterations, equivalent to calling RunIteration()
+  // as many times when `num_threads` is 1, but reusing a single state across
+  // episodes. With more threads, each one samples episodes with its own state
+  // and random number generator (a stream jumped from the internal one), and
+  // updates the shared table concurrently: a reader-writer lock protects its
+  // structure and one of kNumLockStripes mutexes the values of each
+  // information state. Results then depend on the scheduling of the threads.
+  // On NUMA machines, `placement` decides where the states inserted by each
+  // thread live.
+  void RunIterations(int num_iterations, int num_threads = 1,
+                     MemoryPlacement placement = MemoryPlacement::kDefault);
+
+  // The number of iterations run so far.
+  int64_t NumIterations() const { return num_iterations_; }
+
+  // Saves the table, iteration counter and random number generator state to
+  // a checkpoint file, see SaveCFRCheckpoint.
+  void SaveCheckpoint(const std::string& filename) const;
+
+  // Replaces the solver's state with a checkpoint saved for the same game, so
+  // that running more iterations continues the saved run.
+  void LoadCheckpoint(const std::string& filename);
 
   // Computes the average policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
@@ -60,7 +86,10 @@ class OutcomeSamplingMCCFRSolver {
   }
 
  private:
-  double SampleEpisode(State* state, std::mt19937* rng, double my_reach,
+  static inline constexpr int kNumLockStripes = 64;
+
+  double SampleEpisode(State* state, Player update_player,
+                       Xoshiro256PlusPlus* rng, double my_reach,
                        double opp_reach, double sample_reach);
   std::vector<double> SamplePolicy(const CFRInfoStateValues& info_state) const;
 
@@ -75,14 +104,28 @@ class OutcomeSamplingMCCFRSolver {
                                      double child_value,
                                      double sample_prob) const;
 
+  // Returns the entry of `info_state` in the table, inserting it if needed.
+  // The entry stays valid when other entries are inserted.
+  CFRInfoStateValues* GetOrInsertInfoState(
+      const std::string& info_state, const std::vector<Action>& legal_actions);
+
+  // The mutex guarding the values of the given entry, or nullptr when
+  // running on a single thread.
+  absl::Mutex* StripeMutex(const CFRInfoStateValues* values);
+
   const Game& game_;
   double epsilon_;
   CFRInfoStateValuesTable info_states_;
   int num_players_;
   int update_player_;
-  std::mt19937 rng_;
-  absl::uniform_real_distribution<double> dist_;
+  int64_t num_iterations_ = 0;
+  Xoshiro256PlusPlus rng_;
   std::shared_ptr<TabularPolicy> uniform_policy_;
+
+  // Whether the table is being updated by several threads.
+  bool concurrent_ = false;
+  absl::Mutex table_mutex_;
+  absl::Mutex stripe_mutexes_[kNumLockStripes];
 };
 
 }  // namespace algorithms
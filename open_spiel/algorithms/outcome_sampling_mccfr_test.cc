@@ -16,21 +16,25 @@
 
 #include <cmath>
 #include <iostream>
-#include <random>
+#include <string>
 
 #include "open_spiel/algorithms/tabular_exploitability.h"
 #include "open_spiel/games/kuhn_poker.h"
 #include "open_spiel/games/leduc_poker.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/random.h"
 
 namespace open_spiel {
 namespace algorithms {
 namespace {
 
 constexpr int kSeed = 230398247;
+constexpr double kEpsilon = OutcomeSamplingMCCFRSolver::kDefaultEpsilon;
 
-void MCCFR_2PGameTest(const std::string& game_name, std::mt19937* rng,
+void MCCFR_2PGameTest(const std::string& game_name, Xoshiro256PlusPlus* rng,
                       int iterations, double nashconv_upperbound) {
   std::shared_ptr<const Game> game = LoadGame(game_name);
   OutcomeSamplingMCCFRSolver solver(*game);
@@ -44,6 +48,69 @@ void MCCFR_2PGameTest(const std::string& game_name, std::mt19937* rng,
   SPIEL_CHECK_LE(nash_conv, nashconv_upperbound);
 }
 
+// Batched iterations on one thread are the same as repeated RunIteration().
+void MCCFR_RunIterationsTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  OutcomeSamplingMCCFRSolver solver(*game, kEpsilon, kSeed);
+  OutcomeSamplingMCCFRSolver batched_solver(*game, kEpsilon, kSeed);
+  for (int i = 0; i < 1001; i++) {
+    solver.RunIteration();
+  }
+  batched_solver.RunIterations(1000);
+  batched_solver.RunIteration();
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  const std::unique_ptr<Policy> batched_average_policy =
+      batched_solver.AveragePolicy();
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    if (!state->IsChanceNode()) {
+      SPIEL_CHECK_TRUE(batched_average_policy->GetStatePolicy(*state) ==
+                       average_policy->GetStatePolicy(*state));
+    }
+    state->ApplyAction(state->LegalActions()[0]);
+  }
+}
+
+void MCCFR_ParallelKuhnPokerTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  OutcomeSamplingMCCFRSolver solver(*game, kEpsilon, kSeed);
+  solver.RunIterations(/*num_iterations=*/10000, /*num_threads=*/4);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  double nash_conv = NashConv(*game, *average_policy);
+  std::cout << "Kuhn (4 threads), iters = 10000, NashConv: " << nash_conv
+            << std::endl;
+  SPIEL_CHECK_LE(nash_conv, 0.2);
+
+  // NUMA-aware placement of the table, a no-op on one node.
+  solver.RunIterations(/*num_iterations=*/1000, /*num_threads=*/4,
+                       MemoryPlacement::kInterleaved);
+  SPIEL_CHECK_EQ(solver.NumIterations(), 11000);
+}
+
+// A solver restored from a checkpoint continues exactly like the original.
+void MCCFR_CheckpointTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  OutcomeSamplingMCCFRSolver solver(*game, kEpsilon, kSeed);
+  for (int i = 0; i < 1000; i++) {
+    solver.RunIteration();
+  }
+  const std::string filename =
+      testing::TempFilename("outcome_sampling_mccfr", ".ckpt");
+  solver.SaveCheckpoint(filename);
+  OutcomeSamplingMCCFRSolver restored_solver(*game);
+  restored_solver.LoadCheckpoint(filename);
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+  SPIEL_CHECK_EQ(restored_solver.NumIterations(), 1000);
+
+  for (int i = 0; i < 1000; i++) {
+    solver.RunIteration();
+    restored_solver.RunIteration();
+  }
+  SPIEL_CHECK_EQ(restored_solver.NumIterations(), solver.NumIterations());
+  SPIEL_CHECK_EQ(NashConv(*game, *restored_solver.AveragePolicy()),
+                 NashConv(*game, *solver.AveragePolicy()));
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -51,11 +118,14 @@ void MCCFR_2PGameTest(const std::string& game_name, std::mt19937* rng,
 namespace algorithms = open_spiel::algorithms;
 
 int main(int argc, char** argv) {
-  std::mt19937 rng(algorithms::kSeed);
+  open_spiel::Xoshiro256PlusPlus rng(algorithms::kSeed);
   // Values double-checked with the original implementation used in (Lanctot,
   // "Monte Carlo Sampling and Regret Minimization For Equilibrium Computation
   // and Decision-Making in Large Extensive Form Games", 2013).
   algorithms::MCCFR_2PGameTest("kuhn_poker", &rng, 10000, 0.1);
   algorithms::MCCFR_2PGameTest("leduc_poker", &rng, 100000, 1.5);
   algorithms::MCCFR_2PGameTest("liars_dice", &rng, 100000, 1);
+  algorithms::MCCFR_RunIterationsTest();
+  algorithms::MCCFR_ParallelKuhnPokerTest();
+  algorithms::MCCFR_CheckpointTest();
 }
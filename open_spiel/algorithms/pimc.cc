@@ -0,0 +1,285 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/pimc.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread_pool.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// The depth limit below a node with the given limit, negative for none.
+int ChildDepth(int depth) { return depth > 0 ? depth - 1 : depth; }
+
+// Returns f(state after action), applying and undoing the action on `state`
+// if the game supports it, and on a child state otherwise.
+template <typename F>
+auto WithChild(State* state, Action action, F f) {
+  if (state->SupportsUndoAction()) {
+    const Player player = state->CurrentPlayer();
+    state->ApplyAction(action);
+    auto result = f(state);
+    state->UndoAction(player, action);
+    return result;
+  }
+  std::unique_ptr<State> child = state->Child(action);
+  return f(child.get());
+}
+
+class AlphaBetaWorldSearch {
+ public:
+  AlphaBetaWorldSearch(
+      const std::function<bool(const State&, Player, Player)>& same_side,
+      const std::function<double(const State&, Player)>& value_function,
+      Player root_player)
+      : same_side_(same_side),
+        value_function_(value_function),
+        root_player_(root_player) {}
+
+  // The value of `state` to the root player, searched to `depth` more actions
+  // if not negative.
+  double Search(State* state, int depth, double alpha, double beta) {
+    if (state->IsTerminal()) return state->PlayerReturn(root_player_);
+    if (depth == 0) return value_function_(*state, root_player_);
+    const int child_depth = ChildDepth(depth);
+    if (state->IsChanceNode()) {
+      double value = 0;
+      for (const auto& [outcome, prob] : state->ChanceOutcomes()) {
+        value += prob * WithChild(state, outcome, [&](State* child) {
+          return Search(child, child_depth, -kInfinity, kInfinity);
+        });
+      }
+      return value;
+    }
+    const bool maximizing =
+        same_side_(*state, state->CurrentPlayer(), root_player_);
+    double best = maximizing ? -kInfinity : kInfinity;
+    for (Action action : state->LegalActions()) {
+      const double value = WithChild(state, action, [&](State* child) {
+        return Search(child, child_depth, alpha, beta);
+      });
+      if (maximizing) {
+        best = std::max(best, value);
+        alpha = std::max(alpha, best);
+      } else {
+        best = std::min(best, value);
+        beta = std::min(beta, best);
+      }
+      if (alpha >= beta) break;
+    }
+    return best;
+  }
+
+ private:
+  const std::function<bool(const State&, Player, Player)>& same_side_;
+  const std::function<double(const State&, Player)>& value_function_;
+  const Player root_player_;
+};
+
+class MaxnWorldSearch {
+ public:
+  explicit MaxnWorldSearch(
+      const std::function<std::vector<double>(const State&)>& value_function)
+      : value_function_(value_function) {}
+
+  // The values of `state` to each player, searched to `depth` more actions if
+  // not negative.
+  std::vector<double> Search(State* state, int depth) {
+    if (state->IsTerminal()) return state->Returns();
+    if (depth == 0) return value_function_(*state);
+    const int child_depth = ChildDepth(depth);
+    if (state->IsChanceNode()) {
+      std::vector<double> values(state->NumPlayers(), 0);
+      for (const auto& [outcome, prob] : state->ChanceOutcomes()) {
+        const std::vector<double> child_values =
+            WithChild(state, outcome, [&](State* child) {
+              return Search(child, child_depth);
+            });
+        for (int p = 0; p < values.size(); ++p) {
+          values[p] += prob * child_values[p];
+        }
+      }
+      return values;
+    }
+    const Player player = state->CurrentPlayer();
+    const double max_utility = state->GetGame()->MaxUtility();
+    std::vector<double> best;
+    for (Action action : state->LegalActions()) {
+      std::vector<double> values = WithChild(
+          state, action,
+          [&](State* child) { return Search(child, child_depth); });
+      if (best.empty() || values[player] > best[player]) {
+        best = std::move(values);
+        // No action can do better for the player.
+        if (best[player] >= max_utility) break;
+      }
+    }
+    return best;
+  }
+
+ private:
+  const std::function<std::vector<double>(const State&)>& value_function_;
+};
+
+}  // namespace
+
+BatchWorldSolver SolveEachWorld(WorldSolver solver, ThreadPool* pool) {
+  return [solver = std::move(solver),
+          pool](absl::Span<const State* const> worlds) {
+    std::vector<std::vector<double>> values(worlds.size());
+    auto solve = [&](int i) { values[i] = solver(*worlds[i]); };
+    if (pool != nullptr) {
+      pool->ParallelFor(0, worlds.size(), solve);
+    } else {
+      for (int i = 0; i < worlds.size(); ++i) solve(i);
+    }
+    return values;
+  };
+}
+
+WorldSolver MakeAlphaBetaWorldSolver(
+    std::function<bool(const State& world, Player a, Player b)> same_side,
+    int depth_limit,
+    std::function<double(const State&, Player)> value_function) {
+  SPIEL_CHECK_TRUE(same_side != nullptr);
+  if (depth_limit >= 0 && value_function == nullptr) {
+    SpielFatalError("A depth-limited search needs a value function.");
+  }
+  return [same_side = std::move(same_side), depth_limit,
+          value_function = std::move(value_function)](const State& world) {
+    const Player player = world.CurrentPlayer();
+    AlphaBetaWorldSearch search(same_side, value_function, player);
+    std::vector<double> values;
+    std::unique_ptr<State> state = world.Clone();
+    // Each action is searched with a full window, since PIMC averages the
+    // exact values of all of them rather than only picking the best.
+    for (Action action : world.LegalActions()) {
+      values.push_back(WithChild(state.get(), action, [&](State* child) {
+        return search.Search(child, ChildDepth(depth_limit),
+                             -kInfinity, kInfinity);
+      }));
+    }
+    return values;
+  };
+}
+
+WorldSolver MakeMaxnWorldSolver(
+    int depth_limit,
+    std::function<std::vector<double>(const State&)> value_function) {
+  if (depth_limit >= 0 && value_function == nullptr) {
+    SpielFatalError("A depth-limited search needs a value function.");
+  }
+  return [depth_limit,
+          value_function = std::move(value_function)](const State& world) {
+    const Player player = world.CurrentPlayer();
+    MaxnWorldSearch search(value_function);
+    std::vector<double> values;
+    std::unique_ptr<State> state = world.Clone();
+    for (Action action : world.LegalActions()) {
+      values.push_back(WithChild(state.get(), action, [&](State* child) {
+        return search.Search(child, ChildDepth(depth_limit))
+            [player];
+      }));
+    }
+    return values;
+  };
+}
+
+PIMCBot::PIMCBot(const Game& game, BatchWorldSolver solver, int num_worlds,
+                 int seed)
+    : solver_(std::move(solver)),
+      num_worlds_(num_worlds),
+      perfect_information_(game.GetType().information ==
+                           GameType::Information::kPerfectInformation),
+      rng_(seed) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("PIMC requires sequential games.");
+  }
+  SPIEL_CHECK_GT(num_worlds, 0);
+}
+
+std::vector<std::pair<Action, double>> PIMCBot::ActionValues(
+    const State& state) {
+  SPIEL_CHECK_FALSE(state.IsTerminal());
+  SPIEL_CHECK_FALSE(state.IsChanceNode());
+  const Player player = state.CurrentPlayer();
+  const std::vector<Action> legal_actions = state.LegalActions();
+
+  // All the worlds would be the same with perfect information.
+  const int num_worlds = perfect_information_ ? 1 : num_worlds_;
+  std::vector<std::unique_ptr<State>> worlds;
+  std::vector<const State*> world_ptrs;
+  worlds.reserve(num_worlds);
+  for (int i = 0; i < num_worlds; ++i) {
+    worlds.push_back(perfect_information_
+                         ? state.Clone()
+                         : state.ResampleFromInfostate(
+                               player, [this] { return UniformDouble(rng_); }));
+    SPIEL_CHECK_EQ(worlds.back()->CurrentPlayer(), player);
+    world_ptrs.push_back(worlds.back().get());
+  }
+
+  const std::vector<std::vector<double>> world_values = solver_(world_ptrs);
+  SPIEL_CHECK_EQ(world_values.size(), num_worlds);
+  std::vector<std::pair<Action, double>> values;
+  values.reserve(legal_actions.size());
+  for (Action action : legal_actions) values.push_back({action, 0.0});
+  for (const std::vector<double>& action_values : world_values) {
+    SPIEL_CHECK_EQ(action_values.size(), legal_actions.size());
+    for (int i = 0; i < legal_actions.size(); ++i) {
+      values[i].second += action_values[i] / num_worlds;
+    }
+  }
+  return values;
+}
+
+std::pair<ActionsAndProbs, Action> PIMCBot::StepWithPolicy(
+    const State& state) {
+  const std::vector<std::pair<Action, double>> values = ActionValues(state);
+  int best = 0;
+  for (int i = 1; i < values.size(); ++i) {
+    if (values[i].second > values[best].second) best = i;
+  }
+  ActionsAndProbs policy;
+  policy.reserve(values.size());
+  for (int i = 0; i < values.size(); ++i) {
+    policy.push_back({values[i].first, i == best ? 1.0 : 0.0});
+  }
+  return {std::move(policy), values[best].first};
+}
+
+Action PIMCBot::Step(const State& state) {
+  return StepWithPolicy(state).second;
+}
+
+ActionsAndProbs PIMCBot::GetPolicy(const State& state) {
+  return StepWithPolicy(state).first;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
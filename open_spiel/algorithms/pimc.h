@@ -0,0 +1,122 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PIMC_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PIMC_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread_pool.h"
+
+// Perfect Information Monte Carlo (PIMC) search, or determinized search.
+//
+// To choose an action, the bot samples worlds consistent with the acting
+// player's information state with State::ResampleFromInfostate, solves each
+// world as if it were a perfect-information game, and plays the action with
+// the best value on average over the worlds. This is far cheaper than
+// equilibrium-based play at inference time, and is strong in trick-taking
+// card games, although it does not value hiding or gathering information.
+//
+// The worlds are solved by a BatchWorldSolver, which returns the value to the
+// acting player of each of their legal actions, in the order of LegalActions,
+// for each world. Games with a fast solver of their own can solve all the
+// worlds in one call, e.g. bridge::DoubleDummyPlaySolver with the double dummy
+// solver's multi-board API. Otherwise SolveEachWorld solves the worlds one by
+// one with a WorldSolver, in parallel on a thread pool, e.g. one of:
+// - MakeAlphaBetaWorldSolver, for games where the players form two sides,
+//   such as the partnerships of bridge or the solo and defenders of skat.
+// - MakeMaxnWorldSolver, where each player maximizes their own return.
+// Both search the whole rest of a world unless given a depth limit and a
+// value function, so they are only practical on small games or endgames.
+//
+// References:
+// - Ginsberg, GIB: Imperfect Information in a Computationally Challenging
+//   Game, 2001. https://arxiv.org/abs/1106.0669
+// - Long, Sturtevant, Buro, and Furtak, Understanding the Success of Perfect
+//   Information Monte Carlo Sampling in Game Tree Search, 2010.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Returns the value to the current player of each of their legal actions in
+// a world, a state in which the hidden information is fixed. Must be
+// thread-safe when used with a thread pool.
+using WorldSolver = std::function<std::vector<double>(const State& world)>;
+
+// Returns the values of the actions for each of the worlds, all with the same
+// current player and legal actions.
+using BatchWorldSolver = std::function<std::vector<std::vector<double>>(
+    absl::Span<const State* const> worlds)>;
+
+// Solves each world with `solver`, in parallel on `pool` if not null.
+BatchWorldSolver SolveEachWorld(WorldSolver solver,
+                                ThreadPool* pool = nullptr);
+
+// Searches a world by alpha-beta, with the players on the side of the
+// current player maximizing its return and the others minimizing it.
+// same_side(world, a, b) tells whether players a and b are on the same side,
+// which they must be when their returns are always equal. Chance nodes
+// average over their outcomes. With depth_limit >= 0, the nodes at that depth
+// are valued by value_function, for the current player at the root.
+WorldSolver MakeAlphaBetaWorldSolver(
+    std::function<bool(const State& world, Player a, Player b)> same_side,
+    int depth_limit = -1,
+    std::function<double(const State&, Player)> value_function = nullptr);
+
+// Searches a world by max^n: each player chooses the action maximizing their
+// own return, the first one on ties. Chance nodes average over their
+// outcomes. With depth_limit >= 0, the nodes at that depth are valued by
+// value_function, which returns a value per player.
+WorldSolver MakeMaxnWorldSolver(
+    int depth_limit = -1,
+    std::function<std::vector<double>(const State&)> value_function = nullptr);
+
+// A SpielBot choosing the action with the best average value over num_worlds
+// worlds. Its policy is all on that action.
+class PIMCBot : public Bot {
+ public:
+  PIMCBot(const Game& game, BatchWorldSolver solver, int num_worlds,
+          int seed);
+
+  Action Step(const State& state) override;
+  bool ProvidesPolicy() override { return true; }
+  ActionsAndProbs GetPolicy(const State& state) override;
+  std::pair<ActionsAndProbs, Action> StepWithPolicy(
+      const State& state) override;
+  void Restart() override {}
+  void RestartAt(const State& state) override {}
+
+  // Returns the legal actions of the current player, with their average
+  // values over freshly sampled worlds.
+  std::vector<std::pair<Action, double>> ActionValues(const State& state);
+
+ private:
+  BatchWorldSolver solver_;
+  const int num_worlds_;
+  const bool perfect_information_;
+  Xoshiro256PlusPlus rng_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PIMC_H_
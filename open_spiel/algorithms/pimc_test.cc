@@ -0,0 +1,205 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/pimc.h"
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/games/skat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread_pool.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+bool SameSideByParity(const State&, Player a, Player b) {
+  return a % 2 == b % 2;
+}
+
+bool SameSideInSkat(const State& state, Player a, Player b) {
+  const Player solo = static_cast<const skat::SkatState&>(state).SoloPlayer();
+  return (a == solo) == (b == solo);
+}
+
+// Plays random actions from the initial state until `num_actions` were
+// applied by players and a player is to act.
+std::unique_ptr<State> RandomPosition(const Game& game, int num_actions,
+                                      std::mt19937* rng) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  while (!state->IsTerminal() &&
+         (state->IsChanceNode() || num_actions > 0)) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(SampleAction(state->ChanceOutcomes(), *rng).first);
+      continue;
+    }
+    const std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[std::uniform_int_distribution<int>(
+        0, actions.size() - 1)(*rng)]);
+    --num_actions;
+  }
+  return state;
+}
+
+void CheckStep(PIMCBot* bot, const State& state) {
+  auto [policy, action] = bot->StepWithPolicy(state);
+  SPIEL_CHECK_TRUE(absl::c_linear_search(state.LegalActions(), action));
+  SPIEL_CHECK_EQ(policy.size(), state.LegalActions().size());
+  for (const auto& [policy_action, prob] : policy) {
+    SPIEL_CHECK_EQ(prob, policy_action == action ? 1.0 : 0.0);
+  }
+}
+
+void AlphaBetaMatchesMaxnInTwoPlayerZeroSumGames() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  WorldSolver alpha_beta = MakeAlphaBetaWorldSolver(
+      [](const State&, Player a, Player b) { return a == b; });
+  WorldSolver maxn = MakeMaxnWorldSolver();
+  std::mt19937 rng(0);
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = RandomPosition(*game, 2, &rng);
+    SPIEL_CHECK_TRUE(alpha_beta(*state) == maxn(*state));
+  }
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : {0, 4}) state->ApplyAction(action);
+  const std::vector<double> values = alpha_beta(*state);
+  const std::vector<Action> actions = state->LegalActions();
+  for (int i = 0; i < actions.size(); ++i) {
+    std::unique_ptr<State> child = state->Child(actions[i]);
+    SPIEL_CHECK_EQ(values[i], AlphaBetaSearch(*game, child.get(), nullptr,
+                                              /*depth_limit=*/-1,
+                                              /*maximizing_player=*/0)
+                                  .first);
+  }
+}
+
+void DepthLimitedSearchUsesValueFunction() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  int num_calls = 0;
+  WorldSolver solver = MakeAlphaBetaWorldSolver(
+      [](const State&, Player a, Player b) { return a == b; },
+      /*depth_limit=*/1, [&num_calls](const State& state, Player player) {
+        ++num_calls;
+        return state.History().back() == 4 ? 1.0 : 0.0;
+      });
+  const std::vector<double> values = solver(*state);
+  SPIEL_CHECK_EQ(num_calls, 9);
+  for (Action action = 0; action < 9; ++action) {
+    SPIEL_CHECK_EQ(values[action], action == 4 ? 1 : 0);
+  }
+}
+
+void ParallelSolvingMatchesSequential() {
+  std::shared_ptr<const Game> game = LoadGame("tiny_bridge_4p");
+  std::mt19937 rng(1);
+  std::unique_ptr<State> state = RandomPosition(*game, 2, &rng);
+  std::vector<std::unique_ptr<State>> worlds;
+  std::vector<const State*> world_ptrs;
+  std::mt19937 world_rng(2);
+  for (int i = 0; i < 8; ++i) {
+    worlds.push_back(state->ResampleFromInfostate(
+        state->CurrentPlayer(), [&world_rng] {
+          return std::uniform_real_distribution<double>()(world_rng);
+        }));
+    world_ptrs.push_back(worlds.back().get());
+  }
+  WorldSolver solver = MakeAlphaBetaWorldSolver(SameSideByParity);
+  ThreadPool pool(3);
+  SPIEL_CHECK_TRUE(SolveEachWorld(solver)(world_ptrs) ==
+                   SolveEachWorld(solver, &pool)(world_ptrs));
+}
+
+void PlaysTinyBridge() {
+  for (const char* name : {"tiny_bridge_2p", "tiny_bridge_4p"}) {
+    std::shared_ptr<const Game> game = LoadGame(name);
+    ThreadPool pool(2);
+    PIMCBot bot(*game,
+                SolveEachWorld(MakeAlphaBetaWorldSolver(SameSideByParity),
+                               &pool),
+                /*num_worlds=*/10, /*seed=*/3);
+    std::mt19937 rng(4);
+    for (int i = 0; i < 3; ++i) {
+      std::unique_ptr<State> state = game->NewInitialState();
+      while (!state->IsTerminal()) {
+        if (state->IsChanceNode()) {
+          state->ApplyAction(
+              SampleAction(state->ChanceOutcomes(), rng).first);
+          continue;
+        }
+        CheckStep(&bot, *state);
+        state->ApplyAction(bot.Step(*state));
+      }
+    }
+  }
+}
+
+void PlaysSkatEndgames() {
+  std::shared_ptr<const Game> game = LoadGame("skat");
+  PIMCBot bot(*game,
+              SolveEachWorld(MakeAlphaBetaWorldSolver(SameSideInSkat),
+                             &ThreadPool::Default()),
+              /*num_worlds=*/5, /*seed=*/5);
+  std::mt19937 rng(6);
+  for (int i = 0; i < 3; ++i) {
+    // Plays random bids and cards until three tricks are left.
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const auto& skat_state = static_cast<const skat::SkatState&>(*state);
+      const Player solo = skat_state.SoloPlayer();
+      if (state->IsChanceNode()) {
+        state->ApplyAction(SampleAction(state->ChanceOutcomes(), rng).first);
+      } else if (solo >= 0 && __builtin_popcount(skat_state.Hand(solo)) <= 3) {
+        CheckStep(&bot, *state);
+        state->ApplyAction(bot.Step(*state));
+      } else {
+        const std::vector<Action> actions = state->LegalActions();
+        state->ApplyAction(actions[std::uniform_int_distribution<int>(
+            0, actions.size() - 1)(rng)]);
+      }
+    }
+  }
+}
+
+void MaxnPlaysThreePlayerKuhnPoker() {
+  std::shared_ptr<const Game> game =
+      LoadGame("kuhn_poker", {{"players", GameParameter(3)}});
+  PIMCBot bot(*game, SolveEachWorld(MakeMaxnWorldSolver()),
+              /*num_worlds=*/4, /*seed=*/7);
+  std::mt19937 rng(8);
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = RandomPosition(*game, i % 3, &rng);
+    if (!state->IsTerminal()) CheckStep(&bot, *state);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::AlphaBetaMatchesMaxnInTwoPlayerZeroSumGames();
+  open_spiel::algorithms::DepthLimitedSearchUsesValueFunction();
+  open_spiel::algorithms::ParallelSolvingMatchesSequential();
+  open_spiel::algorithms::PlaysTinyBridge();
+  open_spiel::algorithms::PlaysSkatEndgames();
+  open_spiel::algorithms::MaxnPlaysThreePlayerKuhnPoker();
+}
@@ -0,0 +1,220 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/policy_aggregator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Number of subtrees the top of the tree is split into, per thread.
+constexpr int kSubtreesPerThread = 16;
+
+// The sums of the reach-weighted probabilities of the legal actions at an
+// information state.
+struct ActionSums {
+  std::vector<Action> actions;
+  std::vector<double> sums;
+};
+
+using SumsTable = std::unordered_map<std::string, ActionSums>;
+
+// reaches[p][k] is the probability that the k-th policy of player p plays
+// player p's actions on the way to a state, times its mixture weight.
+using Reaches = std::vector<std::vector<double>>;
+
+struct Subtree {
+  std::unique_ptr<State> state;
+  Reaches reaches;
+};
+
+// Adds the contributions of a decision node of `player` to `table`, and
+// returns probs[k][i], the probability of the i-th legal action under the
+// player's k-th policy.
+std::vector<std::vector<double>> Accumulate(
+    const State& state, Player player, const std::vector<Action>& legal_actions,
+    const std::vector<const Policy*>& policies,
+    const std::vector<double>& reaches, SumsTable* table) {
+  ActionSums& entry = (*table)[state.InformationStateString(player)];
+  if (entry.actions.empty()) {
+    entry.actions = legal_actions;
+    entry.sums.assign(legal_actions.size(), 0.0);
+  }
+  std::vector<std::vector<double>> probs(policies.size());
+  for (int k = 0; k < policies.size(); ++k) {
+    const ActionsAndProbs state_policy = policies[k]->GetStatePolicy(state);
+    probs[k].resize(legal_actions.size());
+    for (int i = 0; i < legal_actions.size(); ++i) {
+      // GetProb returns -1 for actions missing from the policy.
+      probs[k][i] = std::max(GetProb(state_policy, legal_actions[i]), 0.0);
+      entry.sums[i] += reaches[k] * probs[k][i];
+    }
+  }
+  return probs;
+}
+
+// Adds the contributions of `state` to `table` and returns its children.
+std::vector<Subtree> Expand(
+    const State& state, const Reaches& reaches,
+    const std::vector<std::vector<const Policy*>>& policies,
+    SumsTable* table) {
+  std::vector<Subtree> children;
+  if (state.IsTerminal()) return children;
+  if (state.IsChanceNode()) {
+    for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+      children.push_back({state.Child(outcome), reaches});
+    }
+    return children;
+  }
+  const Player player = state.CurrentPlayer();
+  const std::vector<Action> legal_actions = state.LegalActions();
+  const std::vector<std::vector<double>> probs = Accumulate(
+      state, player, legal_actions, policies[player], reaches[player], table);
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    Reaches child_reaches = reaches;
+    for (int k = 0; k < probs.size(); ++k) {
+      child_reaches[player][k] *= probs[k][i];
+    }
+    children.push_back({state.Child(legal_actions[i]),
+                        std::move(child_reaches)});
+  }
+  return children;
+}
+
+// Adds the contributions of the subtree of `state` to `table`, depth first.
+// The reaches are updated in place and restored before returning.
+void Walk(const State& state, Reaches* reaches,
+          const std::vector<std::vector<const Policy*>>& policies,
+          SumsTable* table) {
+  if (state.IsTerminal()) return;
+  if (state.IsChanceNode()) {
+    for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+      Walk(*state.Child(outcome), reaches, policies, table);
+    }
+    return;
+  }
+  const Player player = state.CurrentPlayer();
+  const std::vector<Action> legal_actions = state.LegalActions();
+  const std::vector<std::vector<double>> probs = Accumulate(
+      state, player, legal_actions, policies[player], (*reaches)[player],
+      table);
+  const std::vector<double> player_reaches = (*reaches)[player];
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    for (int k = 0; k < probs.size(); ++k) {
+      (*reaches)[player][k] = player_reaches[k] * probs[k][i];
+    }
+    Walk(*state.Child(legal_actions[i]), reaches, policies, table);
+  }
+  (*reaches)[player] = player_reaches;
+}
+
+void Merge(SumsTable&& from, SumsTable* into) {
+  for (auto& [info_state, entry] : from) {
+    ActionSums& target = (*into)[info_state];
+    if (target.actions.empty()) {
+      target = std::move(entry);
+      continue;
+    }
+    SPIEL_CHECK_EQ(target.sums.size(), entry.sums.size());
+    for (int i = 0; i < entry.sums.size(); ++i) {
+      target.sums[i] += entry.sums[i];
+    }
+  }
+}
+
+}  // namespace
+
+TabularPolicy AggregatePolicies(
+    const Game& game, const std::vector<std::vector<const Policy*>>& policies,
+    const std::vector<std::vector<double>>& weights, int num_threads) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "AggregatePolicies requires sequential games. Convert simultaneous "
+        "games with turn_based_simultaneous_game first.");
+  }
+  SPIEL_CHECK_EQ(policies.size(), game.NumPlayers());
+  SPIEL_CHECK_EQ(weights.size(), game.NumPlayers());
+  for (Player p = 0; p < game.NumPlayers(); ++p) {
+    SPIEL_CHECK_EQ(policies[p].size(), weights[p].size());
+    for (const Policy* policy : policies[p]) SPIEL_CHECK_TRUE(policy);
+  }
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  SumsTable table;
+  Reaches reaches = weights;
+  if (num_threads == 1) {
+    Walk(*game.NewInitialState(), &reaches, policies, &table);
+  } else {
+    // Expand the top of the tree breadth first into enough subtrees to keep
+    // all the threads busy.
+    std::deque<Subtree> frontier;
+    frontier.push_back({game.NewInitialState(), std::move(reaches)});
+    const int num_subtrees = num_threads * kSubtreesPerThread;
+    while (!frontier.empty() && frontier.size() < num_subtrees) {
+      Subtree subtree = std::move(frontier.front());
+      frontier.pop_front();
+      for (Subtree& child :
+           Expand(*subtree.state, subtree.reaches, policies, &table)) {
+        frontier.push_back(std::move(child));
+      }
+    }
+
+    std::vector<SumsTable> thread_tables(num_threads);
+    std::atomic<int> next_subtree(0);
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int i = next_subtree++; i < frontier.size(); i = next_subtree++) {
+          Walk(*frontier[i].state, &frontier[i].reaches, policies,
+               &thread_tables[t]);
+        }
+      });
+    }
+    for (Thread& thread : threads) thread.join();
+    for (SumsTable& thread_table : thread_tables) {
+      Merge(std::move(thread_table), &table);
+    }
+  }
+
+  std::unordered_map<std::string, ActionsAndProbs> policy_table;
+  policy_table.reserve(table.size());
+  for (const auto& [info_state, entry] : table) {
+    double total = 0;
+    for (double sum : entry.sums) total += sum;
+    ActionsAndProbs& state_policy = policy_table[info_state];
+    state_policy.reserve(entry.actions.size());
+    for (int i = 0; i < entry.actions.size(); ++i) {
+      state_policy.push_back(
+          {entry.actions[i], total > 0 ? entry.sums[i] / total
+                                       : 1.0 / entry.actions.size()});
+    }
+  }
+  return TabularPolicy(policy_table);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,52 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_POLICY_AGGREGATOR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_POLICY_AGGREGATOR_H_
+
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Turns, for each player, a mixture of policies into a single behaviour
+// policy that is realization-equivalent to it, as the Python
+// policy_aggregator does, e.g. for the meta-strategies of PSRO.
+//
+// `policies[p]` are policies of player p and `weights[p]` the probabilities
+// of the mixture. At an information state of player p, the aggregated
+// probability of an action is proportional to
+//
+//   sum_k weights[p][k] * reach_k * policies[p][k](action)
+//
+// where reach_k is the probability that player p's own actions, played
+// according to policies[p][k], lead to the information state. Information
+// states that no policy of the mixture reaches get the uniform policy.
+//
+// The game tree is walked once for all the players. With more than one
+// thread, its top is expanded into subtrees that the threads share, each
+// summing into its own table, so the policies must support concurrent
+// GetStatePolicy calls. Only sequential games are supported: simultaneous
+// ones must first be converted with turn_based_simultaneous_game.
+TabularPolicy AggregatePolicies(
+    const Game& game, const std::vector<std::vector<const Policy*>>& policies,
+    const std::vector<std::vector<double>>& weights, int num_threads = 1);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_POLICY_AGGREGATOR_H_
@@ -0,0 +1,118 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/policy_aggregator.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kFloatTolerance = 1e-10;
+
+// The expected returns are bilinear in the realization plans of the two
+// players, so those of the aggregated policies must equal the mixture of the
+// expected returns of the pure combinations.
+void CheckRealizationEquivalent(const std::string& game_name,
+                                int num_threads) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  const TabularPolicy first = GetFirstActionPolicy(*game);
+  const TabularPolicy uniform = GetUniformPolicy(*game);
+  const TabularPolicy random = GetRandomPolicy(*game, /*seed=*/3);
+  const std::vector<std::vector<const Policy*>> policies = {
+      {&first, &uniform, &random}, {&random, &first}};
+  const std::vector<std::vector<double>> weights = {{0.2, 0.5, 0.3},
+                                                    {0.6, 0.4}};
+
+  TabularPolicy aggregated =
+      AggregatePolicies(*game, policies, weights, num_threads);
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::vector<double> returns =
+      ExpectedReturns(*root, {&aggregated, &aggregated}, -1);
+
+  std::vector<double> mixed_returns(game->NumPlayers(), 0.0);
+  for (int i = 0; i < policies[0].size(); ++i) {
+    for (int j = 0; j < policies[1].size(); ++j) {
+      std::vector<double> pure_returns =
+          ExpectedReturns(*root, {policies[0][i], policies[1][j]}, -1);
+      for (Player p = 0; p < game->NumPlayers(); ++p) {
+        mixed_returns[p] += weights[0][i] * weights[1][j] * pure_returns[p];
+      }
+    }
+  }
+  for (Player p = 0; p < game->NumPlayers(); ++p) {
+    SPIEL_CHECK_FLOAT_NEAR(returns[p], mixed_returns[p], kFloatTolerance);
+  }
+}
+
+void SinglePolicyIsUnchanged() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  const TabularPolicy random = GetRandomPolicy(*game, /*seed=*/7);
+  TabularPolicy aggregated =
+      AggregatePolicies(*game, {{&random}, {&random}}, {{1.0}, {1.0}});
+  SPIEL_CHECK_EQ(aggregated.PolicyTable().size(),
+                 random.PolicyTable().size());
+  for (const auto& [info_state, state_policy] : random.PolicyTable()) {
+    const ActionsAndProbs& aggregated_policy =
+        aggregated.GetStatePolicy(info_state);
+    SPIEL_CHECK_EQ(aggregated_policy.size(), state_policy.size());
+    for (const auto& [action, prob] : state_policy) {
+      SPIEL_CHECK_FLOAT_NEAR(GetProb(aggregated_policy, action), prob,
+                             kFloatTolerance);
+    }
+  }
+}
+
+void ThreadedMatchesSerial() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  const TabularPolicy uniform = GetUniformPolicy(*game);
+  const TabularPolicy random = GetRandomPolicy(*game, /*seed=*/5);
+  const std::vector<std::vector<const Policy*>> policies = {
+      {&uniform, &random}, {&random, &uniform}};
+  const std::vector<std::vector<double>> weights = {{0.25, 0.75},
+                                                    {0.5, 0.5}};
+
+  TabularPolicy serial = AggregatePolicies(*game, policies, weights);
+  TabularPolicy threaded =
+      AggregatePolicies(*game, policies, weights, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(serial.PolicyTable().size(), threaded.PolicyTable().size());
+  for (const auto& [info_state, state_policy] : serial.PolicyTable()) {
+    const ActionsAndProbs& threaded_policy =
+        threaded.GetStatePolicy(info_state);
+    SPIEL_CHECK_EQ(threaded_policy.size(), state_policy.size());
+    for (const auto& [action, prob] : state_policy) {
+      SPIEL_CHECK_FLOAT_NEAR(GetProb(threaded_policy, action), prob,
+                             kFloatTolerance);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::CheckRealizationEquivalent("kuhn_poker", 1);
+  open_spiel::algorithms::CheckRealizationEquivalent("kuhn_poker", 3);
+  open_spiel::algorithms::CheckRealizationEquivalent("leduc_poker", 4);
+  open_spiel::algorithms::SinglePolicyIsUnchanged();
+  open_spiel::algorithms::ThreadedMatchesSerial();
+}
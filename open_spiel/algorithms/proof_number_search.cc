@@ -0,0 +1,249 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/proof_number_search.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint64_t kInfinity = std::numeric_limits<uint64_t>::max();
+constexpr int64_t kNoLimit = std::numeric_limits<int64_t>::max();
+
+uint64_t SaturatedAdd(uint64_t a, uint64_t b) {
+  return a > kInfinity - b ? kInfinity : a + b;
+}
+
+}  // namespace
+
+ProofNumberSearch::ProofNumberSearch(const Game& game, Player prover,
+                                     double target, int64_t max_nodes,
+                                     int max_table_size)
+    : prover_(prover),
+      target_(target),
+      max_nodes_(max_nodes),
+      max_table_size_(max_table_size) {
+  const GameType& type = game.GetType();
+  if (type.dynamics != GameType::Dynamics::kSequential ||
+      type.chance_mode != GameType::ChanceMode::kDeterministic ||
+      type.information != GameType::Information::kPerfectInformation) {
+    SpielFatalError(
+        "Proof-number search requires deterministic sequential games with "
+        "perfect information.");
+  }
+  SPIEL_CHECK_GE(prover, 0);
+  SPIEL_CHECK_LT(prover, game.NumPlayers());
+  SPIEL_CHECK_GT(max_table_size, 0);
+}
+
+std::string ProofNumberSearch::Key(const State& state) {
+  return absl::StrCat(state.CurrentPlayer(), ":", state.ToString());
+}
+
+ProofNumberSearch::Entry ProofNumberSearch::Lookup(const State& state,
+                                                   const std::string& key) {
+  if (state.IsTerminal()) {
+    // Terminal states are not stored, as they cost nothing to evaluate.
+    Entry entry;
+    const bool proven = state.PlayerReturn(prover_) >= target_;
+    entry.proof = proven ? 0 : kInfinity;
+    entry.disproof = proven ? kInfinity : 0;
+    return entry;
+  }
+  const auto it = table_.find(key);
+  return it == table_.end() ? Entry() : it->second;
+}
+
+void ProofNumberSearch::Store(const std::string& key, const Entry& entry) {
+  auto [it, inserted] = table_.try_emplace(key);
+  it->second.proof = entry.proof;
+  it->second.disproof = entry.disproof;
+  it->second.work += entry.work;
+  if (table_.size() > max_table_size_) CollectGarbage();
+}
+
+void ProofNumberSearch::CollectGarbage() {
+  std::vector<int64_t> work;
+  work.reserve(table_.size());
+  for (const auto& [key, entry] : table_) work.push_back(entry.work);
+  const int num_erased = table_.size() / 2;
+  std::nth_element(work.begin(), work.begin() + num_erased, work.end());
+  const int64_t threshold = work[num_erased];
+  int erased = 0;
+  for (auto it = table_.begin(); it != table_.end() && erased < num_erased;) {
+    if (it->second.work <= threshold) {
+      table_.erase(it++);
+      ++erased;
+    } else {
+      ++it;
+    }
+  }
+}
+
+ProofNumberSearch::Entry ProofNumberSearch::Search(
+    const State& state, uint64_t proof_threshold,
+    uint64_t disproof_threshold) {
+  const int64_t start = num_nodes_++;
+  const std::string key = Key(state);
+  // The children's entries are kept here for the whole search, so that it
+  // makes progress even when the table forgets them.
+  std::vector<std::unique_ptr<State>> children;
+  std::vector<Entry> child_entries;
+  for (Action action : state.LegalActions()) {
+    children.push_back(state.Child(action));
+    child_entries.push_back(Lookup(*children.back(), Key(*children.back())));
+  }
+
+  // At the prover's (OR) states, the proof number is the least of the
+  // children's and the disproof number their sum, and the other way around at
+  // the opponent's (AND) states. Each iteration searches the child with the
+  // least of these, until it is no longer the best or this state reaches a
+  // threshold.
+  const bool or_node = state.CurrentPlayer() == prover_;
+  Entry entry;
+  while (true) {
+    int best = -1;
+    uint64_t best_min = kInfinity;
+    uint64_t second_min = kInfinity;
+    uint64_t sum = 0;
+    for (int i = 0; i < children.size(); ++i) {
+      const Entry& child = child_entries[i];
+      const uint64_t min_number = or_node ? child.proof : child.disproof;
+      sum = SaturatedAdd(sum, or_node ? child.disproof : child.proof);
+      if (best < 0 || min_number < best_min) {
+        second_min = best_min;
+        best_min = min_number;
+        best = i;
+      } else if (min_number < second_min) {
+        second_min = min_number;
+      }
+    }
+    entry.proof = or_node ? best_min : sum;
+    entry.disproof = or_node ? sum : best_min;
+    if (entry.proof >= proof_threshold ||
+        entry.disproof >= disproof_threshold || num_nodes_ >= node_limit_) {
+      break;
+    }
+    // The best child is searched until it reaches the second best, or until
+    // this state would reach its threshold on the sum.
+    const uint64_t second_bound = SaturatedAdd(second_min, 1);
+    Entry& best_entry = child_entries[best];
+    uint64_t child_proof_threshold;
+    uint64_t child_disproof_threshold;
+    if (or_node) {
+      child_proof_threshold = std::min(proof_threshold, second_bound);
+      child_disproof_threshold =
+          disproof_threshold == kInfinity
+              ? kInfinity
+              : disproof_threshold - entry.disproof + best_entry.disproof;
+    } else {
+      child_proof_threshold =
+          proof_threshold == kInfinity
+              ? kInfinity
+              : proof_threshold - entry.proof + best_entry.proof;
+      child_disproof_threshold = std::min(disproof_threshold, second_bound);
+    }
+    best_entry = Search(*children[best], child_proof_threshold,
+                        child_disproof_threshold);
+  }
+  entry.work = num_nodes_ - start;
+  Store(key, entry);
+  return entry;
+}
+
+ProofResult ProofNumberSearch::Solve(const State& state) {
+  node_limit_ = max_nodes_ > 0 ? num_nodes_ + max_nodes_ : kNoLimit;
+  const Entry entry = state.IsTerminal()
+                          ? Lookup(state, "")
+                          : Search(state, kInfinity, kInfinity);
+  if (entry.proof == 0) return ProofResult::kProven;
+  if (entry.disproof == 0) return ProofResult::kDisproven;
+  return ProofResult::kUnknown;
+}
+
+ProofNumberSearch::Entry ProofNumberSearch::Resolve(const State& state) {
+  Entry entry = Lookup(state, Key(state));
+  if (entry.proof != 0 && entry.disproof != 0) {
+    node_limit_ = kNoLimit;
+    entry = Search(state, kInfinity, kInfinity);
+  }
+  return entry;
+}
+
+void ProofNumberSearch::BuildProof(
+    const State& state, ProofTreeNode* node,
+    absl::flat_hash_map<std::string, Action>* actions) {
+  if (state.IsTerminal()) return;
+  if (state.CurrentPlayer() == prover_) {
+    // A proving action, preferring one whose proof is still in the table.
+    const std::vector<Action> legal_actions = state.LegalActions();
+    std::vector<std::unique_ptr<State>> children;
+    for (Action action : legal_actions) children.push_back(state.Child(action));
+    int proving = -1;
+    for (int i = 0; i < children.size() && proving < 0; ++i) {
+      if (Lookup(*children[i], Key(*children[i])).proof == 0) proving = i;
+    }
+    for (int i = 0; i < children.size() && proving < 0; ++i) {
+      if (Resolve(*children[i]).proof == 0) proving = i;
+    }
+    SPIEL_CHECK_GE(proving, 0);
+    if (actions != nullptr) (*actions)[Key(state)] = legal_actions[proving];
+    if (node != nullptr) {
+      node->children.emplace_back().action = legal_actions[proving];
+    }
+    BuildProof(*children[proving],
+               node == nullptr ? nullptr : &node->children.back(), actions);
+    return;
+  }
+  for (Action action : state.LegalActions()) {
+    std::unique_ptr<State> child = state.Child(action);
+    SPIEL_CHECK_EQ(Resolve(*child).proof, 0);
+    ProofTreeNode* child_node = nullptr;
+    if (node != nullptr) {
+      child_node = &node->children.emplace_back();
+      child_node->action = action;
+    }
+    BuildProof(*child, child_node, actions);
+  }
+}
+
+ProofTreeNode ProofNumberSearch::ProofTree(const State& state) {
+  if (Resolve(state).proof != 0) SpielFatalError("The state is not proven.");
+  ProofTreeNode root;
+  BuildProof(state, &root, nullptr);
+  return root;
+}
+
+absl::flat_hash_map<std::string, Action> ProofNumberSearch::ProvingActions(
+    const State& state) {
+  if (Resolve(state).proof != 0) SpielFatalError("The state is not proven.");
+  absl::flat_hash_map<std::string, Action> actions;
+  BuildProof(state, nullptr, &actions);
+  return actions;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
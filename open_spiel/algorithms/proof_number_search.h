@@ -0,0 +1,125 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PROOF_NUMBER_SEARCH_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PROOF_NUMBER_SEARCH_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Depth-first proof-number search (df-pn), which proves or disproves that a
+// player, the prover, can guarantee a return of at least some target in a
+// deterministic perfect-information game, such as a win in connect_four,
+// hex, breakthrough or pentago. Proof-number search expands the most-proving
+// node, the one whose proof or disproof needs the fewest further leaves to be
+// solved, which makes it far better than MCTS-Solver at proving positions.
+//
+// The proof and disproof numbers of the states are kept in a transposition
+// table keyed by the state's current player and string, which must therefore
+// determine its future; the games must not repeat positions. When the table
+// exceeds its size, the half of its entries with the least search effort
+// under them are forgotten (SmallTreeGC), so that memory stays bounded at the
+// cost of searching them again.
+//
+// References:
+// - Allis, van der Meulen, and van den Herik, Proof-Number Search, 1994.
+// - Nagai, Df-pn Algorithm for Searching AND/OR Trees and Its Applications,
+//   PhD thesis, 2002.
+// - Kishimoto, Winands, Mueller, and Saito, Game-Tree Search Using Proof
+//   Numbers: The First Twenty Years, 2012.
+
+namespace open_spiel {
+namespace algorithms {
+
+enum class ProofResult {
+  kProven,
+  kDisproven,
+  // The search ran out of nodes.
+  kUnknown,
+};
+
+// A proof tree: the prover's proving action at each of its states, and all
+// the actions at the opponent's, down to terminal states.
+struct ProofTreeNode {
+  Action action = kInvalidAction;  // The action leading here.
+  std::vector<ProofTreeNode> children;
+};
+
+class ProofNumberSearch {
+ public:
+  // Proves that `prover` can guarantee a return of at least `target`, e.g.
+  // the game's maximum utility for a win. Each search stops after max_nodes
+  // expansions if positive, and the transposition table holds at most
+  // max_table_size entries.
+  ProofNumberSearch(const Game& game, Player prover, double target,
+                    int64_t max_nodes = 0, int max_table_size = 1 << 22);
+
+  ProofResult Solve(const State& state);
+
+  // The proof tree of a proven state, searching again the parts of the proof
+  // that have been forgotten.
+  ProofTreeNode ProofTree(const State& state);
+
+  // The proving action at each state of the proof tree of a proven state
+  // where the prover acts, keyed as in the transposition table, for playing
+  // the proof, e.g. by a bot.
+  absl::flat_hash_map<std::string, Action> ProvingActions(const State& state);
+
+  // The key of a state in the transposition table and ProvingActions.
+  static std::string Key(const State& state);
+
+  // The number of expansions of the searches so far.
+  int64_t NumNodes() const { return num_nodes_; }
+  int TableSize() const { return table_.size(); }
+
+ private:
+  struct Entry {
+    uint64_t proof = 1;
+    uint64_t disproof = 1;
+    int64_t work = 0;  // The number of expansions searched under the state.
+  };
+
+  // Searches `state` until its proof number reaches proof_threshold or its
+  // disproof number reaches disproof_threshold, and returns its entry.
+  Entry Search(const State& state, uint64_t proof_threshold,
+               uint64_t disproof_threshold);
+
+  // The entry of a state, evaluated if it is terminal.
+  Entry Lookup(const State& state, const std::string& key);
+  void Store(const std::string& key, const Entry& entry);
+  void CollectGarbage();
+
+  // Solves `state` fully if the entries that make its proof were forgotten.
+  Entry Resolve(const State& state);
+  void BuildProof(const State& state, ProofTreeNode* node,
+                  absl::flat_hash_map<std::string, Action>* actions);
+
+  const Player prover_;
+  const double target_;
+  const int64_t max_nodes_;
+  const int max_table_size_;
+  absl::flat_hash_map<std::string, Entry> table_;
+  int64_t num_nodes_ = 0;
+  int64_t node_limit_ = 0;  // The number of nodes when the search stops.
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PROOF_NUMBER_SEARCH_H_
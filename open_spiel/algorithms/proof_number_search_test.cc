@@ -0,0 +1,142 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/proof_number_search.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void TicTacToeTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  // Both players can draw, and neither can win.
+  for (Player prover : {0, 1}) {
+    ProofNumberSearch draw(*game, prover, 0);
+    SPIEL_CHECK_TRUE(draw.Solve(*state) == ProofResult::kProven);
+    ProofNumberSearch win(*game, prover, 1);
+    SPIEL_CHECK_TRUE(win.Solve(*state) == ProofResult::kDisproven);
+  }
+  // Out of nodes.
+  ProofNumberSearch limited(*game, 0, 0, /*max_nodes=*/10);
+  SPIEL_CHECK_TRUE(limited.Solve(*state) == ProofResult::kUnknown);
+}
+
+// The proving actions must reach the target against every reply.
+void CheckProvingActions(const State& state, Player prover, double target,
+                         const absl::flat_hash_map<std::string, Action>& map) {
+  if (state.IsTerminal()) {
+    SPIEL_CHECK_GE(state.PlayerReturn(prover), target);
+    return;
+  }
+  if (state.CurrentPlayer() == prover) {
+    const auto it = map.find(ProofNumberSearch::Key(state));
+    SPIEL_CHECK_TRUE(it != map.end());
+    CheckProvingActions(*state.Child(it->second), prover, target, map);
+    return;
+  }
+  for (Action action : state.LegalActions()) {
+    CheckProvingActions(*state.Child(action), prover, target, map);
+  }
+}
+
+int ProofTreeSize(const ProofTreeNode& node) {
+  int size = 1;
+  for (const ProofTreeNode& child : node.children) size += ProofTreeSize(child);
+  return size;
+}
+
+void ProofTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  // A table far too small for the search still gives the right answers, and
+  // parts of the proof are searched again.
+  for (int max_table_size : {1 << 20, 64}) {
+    ProofNumberSearch search(*game, 1, 0, 0, max_table_size);
+    SPIEL_CHECK_TRUE(search.Solve(*state) == ProofResult::kProven);
+    SPIEL_CHECK_LE(search.TableSize(), max_table_size);
+    const ProofTreeNode tree = search.ProofTree(*state);
+    // All of the first player's actions, and a single reply to each.
+    SPIEL_CHECK_EQ(tree.children.size(), 9);
+    for (const ProofTreeNode& child : tree.children) {
+      SPIEL_CHECK_EQ(child.children.size(), 1);
+    }
+    SPIEL_CHECK_GT(ProofTreeSize(tree), 9);
+    CheckProvingActions(*state, 1, 0, search.ProvingActions(*state));
+  }
+}
+
+void HexTest() {
+  // The first player wins hex on any board.
+  for (int board_size : {3, 4}) {
+    std::shared_ptr<const Game> game =
+        LoadGame("hex", {{"board_size", GameParameter(board_size)}});
+    std::unique_ptr<State> state = game->NewInitialState();
+    ProofNumberSearch search(*game, 0, game->MaxUtility());
+    SPIEL_CHECK_TRUE(search.Solve(*state) == ProofResult::kProven);
+    CheckProvingActions(*state, 0, game->MaxUtility(),
+                        search.ProvingActions(*state));
+  }
+}
+
+// Checks the proofs of won, drawn and lost positions against alpha-beta, on
+// positions small enough for an exhaustive search.
+void MatchesAlphaBeta(const std::string& game_string, int num_moves,
+                      int num_positions) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  std::mt19937 rng(1234);
+  int num_compared = 0;
+  for (int i = 0; i < num_positions; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    for (int move = 0; move < num_moves && !state->IsTerminal(); ++move) {
+      const std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[absl::Uniform<int>(rng, 0, actions.size())]);
+    }
+    if (state->IsTerminal()) continue;
+    const Player player = state->CurrentPlayer();
+    const double value =
+        AlphaBetaSearch(*game, state.get(), {}, -1, player).first;
+    ProofNumberSearch win(*game, player, game->MaxUtility());
+    SPIEL_CHECK_EQ(win.Solve(*state) == ProofResult::kProven,
+                   value >= game->MaxUtility());
+    ProofNumberSearch draw(*game, player, 0);
+    SPIEL_CHECK_EQ(draw.Solve(*state) == ProofResult::kProven, value >= 0);
+    ++num_compared;
+  }
+  SPIEL_CHECK_GT(num_compared, 0);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TicTacToeTest();
+  open_spiel::algorithms::ProofTest();
+  open_spiel::algorithms::HexTest();
+  for (int num_moves = 1; num_moves <= 6; ++num_moves) {
+    open_spiel::algorithms::MatchesAlphaBeta("tic_tac_toe", num_moves, 10);
+  }
+}
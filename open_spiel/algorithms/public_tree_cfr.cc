@@ -0,0 +1,307 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/public_tree_cfr.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Appends the histories at the end of the initial chance nodes below `state`,
+// with their probabilities.
+void CollectDeals(const State& state, double prob,
+                  std::vector<std::unique_ptr<State>>* deals,
+                  std::vector<double>* deal_probs) {
+  if (!state.IsChanceNode()) {
+    deals->push_back(state.Clone());
+    deal_probs->push_back(prob);
+    return;
+  }
+  for (const auto& [outcome, outcome_prob] : state.ChanceOutcomes()) {
+    CollectDeals(*state.Child(outcome), prob * outcome_prob, deals,
+                 deal_probs);
+  }
+}
+
+}  // namespace
+
+PublicTreeCFRSolverBase::PublicTreeCFRSolverBase(const Game& game,
+                                                 bool alternating_updates,
+                                                 bool linear_averaging,
+                                                 bool regret_matching_plus,
+                                                 bool sample_public_chance,
+                                                 int seed)
+    : CFRSolverBase(game, alternating_updates, linear_averaging,
+                    regret_matching_plus),
+      num_players_(game.NumPlayers()),
+      sample_public_chance_(sample_public_chance),
+      rng_(seed) {
+  std::vector<std::unique_ptr<State>> deals;
+  std::vector<double> deal_probs;
+  CollectDeals(*root_state_, 1.0, &deals, &deal_probs);
+
+  // Deals giving a player the same information state give them the same hand.
+  deal_hands_.resize(deals.size() * num_players_);
+  hand_offsets_.push_back(0);
+  for (Player player = 0; player < num_players_; ++player) {
+    std::unordered_map<std::string, int> hands;
+    for (int deal = 0; deal < deals.size(); ++deal) {
+      const auto [iter, inserted] = hands.emplace(
+          deals[deal]->InformationStateString(player), hands.size());
+      deal_hands_[deal * num_players_ + player] =
+          hand_offsets_.back() + iter->second;
+    }
+    hand_offsets_.push_back(hand_offsets_.back() + hands.size());
+  }
+
+  std::vector<int> deal_ids(deals.size());
+  std::iota(deal_ids.begin(), deal_ids.end(), 0);
+  CompilePublicNode(std::move(deals), deal_ids, deal_probs);
+}
+
+int PublicTreeCFRSolverBase::CompilePublicNode(
+    std::vector<std::unique_ptr<State>> states, const std::vector<int>& deals,
+    const std::vector<double>& chance_probs) {
+  const State& state = *states[0];
+  const Player player = state.CurrentPlayer();
+  const std::vector<Action> actions =
+      state.IsTerminal() ? std::vector<Action>() : state.LegalActions();
+  for (const auto& other : states) {
+    if (other->CurrentPlayer() != player ||
+        (player >= 0 && other->LegalActions() != actions)) {
+      SpielFatalError(absl::StrCat(
+          "Public tree CFR: histories ", state.HistoryString(), " and ",
+          other->HistoryString(),
+          " only differ by the deal but are not in the same public state."));
+    }
+  }
+
+  const int index = nodes_.size();
+  nodes_.emplace_back();
+  nodes_[index].player = player;
+
+  if (state.IsTerminal()) {
+    PublicNode& node = nodes_[index];
+    node.deals = deals;
+    node.chance_probs = chance_probs;
+    for (const auto& terminal : states) {
+      const std::vector<double> returns = terminal->Returns();
+      node.returns.insert(node.returns.end(), returns.begin(), returns.end());
+    }
+    return index;
+  }
+
+  std::vector<int> children;
+  if (state.IsChanceNode()) {
+    // Group the histories by outcome, as they may have different ones.
+    struct Outcome {
+      std::vector<std::unique_ptr<State>> states;
+      std::vector<int> deals;
+      std::vector<double> chance_probs;
+      double total_prob = 0;
+    };
+    std::map<Action, Outcome> outcomes;
+    double total_prob = 0;
+    for (int i = 0; i < states.size(); ++i) {
+      for (const auto& [action, prob] : states[i]->ChanceOutcomes()) {
+        Outcome& outcome = outcomes[action];
+        outcome.states.push_back(states[i]->Child(action));
+        outcome.deals.push_back(deals[i]);
+        outcome.chance_probs.push_back(chance_probs[i] * prob);
+        outcome.total_prob += chance_probs[i] * prob;
+        total_prob += chance_probs[i] * prob;
+      }
+    }
+    std::vector<double> outcome_probs;
+    for (auto& [action, outcome] : outcomes) {
+      outcome_probs.push_back(outcome.total_prob / total_prob);
+      children.push_back(CompilePublicNode(
+          std::move(outcome.states), outcome.deals, outcome.chance_probs));
+    }
+    nodes_[index].outcome_probs = std::move(outcome_probs);
+  } else {
+    std::vector<CFRInfoStateValues*> info_states(NumHands(player), nullptr);
+    for (int i = 0; i < states.size(); ++i) {
+      const int hand =
+          deal_hands_[deals[i] * num_players_ + player] - hand_offsets_[player];
+      const std::string info_state = states[i]->InformationStateString(player);
+      auto entry = info_states_.find(info_state);
+      SPIEL_CHECK_TRUE(entry != info_states_.end());
+      if (info_states[hand] == nullptr) {
+        info_states[hand] = &entry->second;
+      } else if (info_states[hand] != &entry->second) {
+        SpielFatalError(absl::StrCat(
+            "Public tree CFR: histories with the same hand are in different "
+            "information states, e.g. ",
+            info_state));
+      }
+    }
+    nodes_[index].info_states = std::move(info_states);
+    for (Action action : actions) {
+      std::vector<std::unique_ptr<State>> child_states;
+      child_states.reserve(states.size());
+      for (const auto& parent : states) {
+        child_states.push_back(parent->Child(action));
+      }
+      children.push_back(
+          CompilePublicNode(std::move(child_states), deals, chance_probs));
+    }
+  }
+  nodes_[index].children = std::move(children);
+  return index;
+}
+
+void PublicTreeCFRSolverBase::EvaluateAndUpdatePolicy() {
+  ++iteration_;
+  const std::vector<double> root_reach_probs(hand_offsets_.back(), 1.0);
+  std::vector<double> values(hand_offsets_.back());
+  if (alternating_updates_) {
+    for (int player = 0; player < num_players_; player++) {
+      ComputeCounterFactualRegret(/*node=*/0, player, root_reach_probs,
+                                  &values);
+      if (regret_matching_plus_) {
+        ApplyRegretMatchingPlusReset();
+      }
+      ApplyRegretMatching();
+    }
+  } else {
+    ComputeCounterFactualRegret(/*node=*/0, std::nullopt, root_reach_probs,
+                                &values);
+    if (regret_matching_plus_) {
+      ApplyRegretMatchingPlusReset();
+    }
+    ApplyRegretMatching();
+  }
+}
+
+void PublicTreeCFRSolverBase::ComputeCounterFactualRegret(
+    int node_index, const std::optional<int>& alternating_player,
+    const std::vector<double>& reach_probabilities,
+    std::vector<double>* values) {
+  const PublicNode& node = nodes_[node_index];
+  std::fill(values->begin(), values->end(), 0.0);
+
+  if (node.player == kTerminalPlayerId) {
+    for (int i = 0; i < node.deals.size(); ++i) {
+      const int* hands = &deal_hands_[node.deals[i] * num_players_];
+      for (Player player = 0; player < num_players_; ++player) {
+        double cfr_reach_prob = node.chance_probs[i];
+        for (Player other = 0; other < num_players_; ++other) {
+          if (other != player) {
+            cfr_reach_prob *= reach_probabilities[hands[other]];
+          }
+        }
+        (*values)[hands[player]] +=
+            cfr_reach_prob * node.returns[i * num_players_ + player];
+      }
+    }
+    return;
+  }
+
+  std::vector<double> child_values(values->size());
+  if (node.player == kChancePlayerId) {
+    // The chance probabilities are already in the terminal values.
+    if (sample_public_chance_) {
+      std::discrete_distribution<int> dist(node.outcome_probs.begin(),
+                                           node.outcome_probs.end());
+      const int outcome = dist(rng_);
+      ComputeCounterFactualRegret(node.children[outcome], alternating_player,
+                                  reach_probabilities, values);
+      for (double& value : *values) value /= node.outcome_probs[outcome];
+      return;
+    }
+    for (int child : node.children) {
+      ComputeCounterFactualRegret(child, alternating_player,
+                                  reach_probabilities, &child_values);
+      for (int i = 0; i < values->size(); ++i) {
+        (*values)[i] += child_values[i];
+      }
+    }
+    return;
+  }
+
+  const Player player = node.player;
+  const int begin = hand_offsets_[player];
+  const int end = hand_offsets_[player + 1];
+  const int num_hands = end - begin;
+  const int num_actions = node.children.size();
+
+  // [num_actions, num_hands] current policy and values of the player.
+  std::vector<double> policy(num_actions * num_hands, 0.0);
+  for (int hand = 0; hand < num_hands; ++hand) {
+    if (node.info_states[hand] == nullptr) continue;
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      policy[aidx * num_hands + hand] =
+          node.info_states[hand]->current_policy[aidx];
+    }
+  }
+  std::vector<double> action_values(num_actions * num_hands);
+
+  std::vector<double> child_reach_probs(reach_probabilities);
+  for (int aidx = 0; aidx < num_actions; ++aidx) {
+    const double* action_policy = &policy[aidx * num_hands];
+    for (int hand = 0; hand < num_hands; ++hand) {
+      child_reach_probs[begin + hand] =
+          reach_probabilities[begin + hand] * action_policy[hand];
+    }
+    ComputeCounterFactualRegret(node.children[aidx], alternating_player,
+                                child_reach_probs, &child_values);
+
+    // The other players' reach probabilities are the same in all children.
+    for (int i = 0; i < begin; ++i) (*values)[i] += child_values[i];
+    for (int i = end; i < values->size(); ++i) (*values)[i] += child_values[i];
+    for (int hand = 0; hand < num_hands; ++hand) {
+      (*values)[begin + hand] +=
+          action_policy[hand] * child_values[begin + hand];
+    }
+    std::copy(child_values.begin() + begin, child_values.begin() + end,
+              action_values.begin() + aidx * num_hands);
+  }
+
+  // Perform regret and average strategy updates. The values are already
+  // weighted by the counterfactual reach probabilities.
+  if (alternating_player && *alternating_player != player) return;
+  for (int hand = 0; hand < num_hands; ++hand) {
+    CFRInfoStateValues* is_vals = node.info_states[hand];
+    if (is_vals == nullptr) continue;
+    const double self_reach_prob = reach_probabilities[begin + hand];
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      is_vals->cumulative_regrets[aidx] +=
+          action_values[aidx * num_hands + hand] - (*values)[begin + hand];
+      if (linear_averaging_) {
+        is_vals->cumulative_policy[aidx] +=
+            iteration_ * self_reach_prob * policy[aidx * num_hands + hand];
+      } else {
+        is_vals->cumulative_policy[aidx] +=
+            self_reach_prob * policy[aidx * num_hands + hand];
+      }
+    }
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,166 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PUBLIC_TREE_CFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PUBLIC_TREE_CFR_H_
+
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Vectorized CFR over the public tree, for games where the private
+// information is dealt by chance at the start, like kuhn_poker, leduc_poker
+// and universal_poker.
+//
+// CFRSolverBase walks every history, so the betting tree is traversed once
+// per deal. Here, the initial chance nodes (the deal) are enumerated once, and
+// each player's private hand is identified by their information state right
+// after it. Histories that only differ by the deal are merged into a single
+// public node, and an iteration visits each public node once, carrying for
+// every player a contiguous vector of reach probabilities over their hands
+// and computing the counterfactual values of all hands at once. Terminal
+// nodes sum over the deals that reach them.
+//
+// Regrets and policies are stored in the CFRSolverBase table, so regret
+// matching, AveragePolicy() and CurrentPolicy() are shared with it, and the
+// iterates are the same as CFRSolverBase's up to floating-point rounding.
+//
+// All the histories of a public node must have the same player to act and
+// the same legal actions, and at a decision node all those of a given hand
+// must be in the same information state (later chance outcomes, like the
+// public card in leduc_poker, can depend on the deal). This is checked at
+// construction. Every deal and public node is kept in memory.
+//
+// With `sample_public_chance`, this is public chance sampling (PCS) CFR:
+// instead of visiting all the outcomes of the chance nodes after the deal,
+// like the public card of leduc_poker, an iteration samples one of them from
+// their probability given the public history and divides its values by that
+// probability, so the values stay unbiased. The deal is still enumerated with
+// the per-hand vectors, which keeps the variance low while an iteration only
+// walks one public chance outcome per public chance node.
+class PublicTreeCFRSolverBase : public CFRSolverBase {
+ public:
+  PublicTreeCFRSolverBase(const Game& game, bool alternating_updates,
+                          bool linear_averaging, bool regret_matching_plus,
+                          bool sample_public_chance = false, int seed = 0);
+
+  void EvaluateAndUpdatePolicy() override;
+
+  int NumPublicNodes() const { return nodes_.size(); }
+  int NumDeals() const { return deal_hands_.size() / num_players_; }
+  int NumHands(Player player) const {
+    return hand_offsets_[player + 1] - hand_offsets_[player];
+  }
+
+ private:
+  struct PublicNode {
+    // kTerminalPlayerId, kChancePlayerId or the player to act.
+    Player player;
+    // The public nodes reached by each legal action or chance outcome.
+    std::vector<int> children;
+    // Chance nodes: the probability of each child given the public history.
+    std::vector<double> outcome_probs;
+    // Decision nodes: the values of the information state of each hand of
+    // the player, or nullptr if the hand cannot reach the node.
+    std::vector<CFRInfoStateValues*> info_states;
+    // Terminal nodes: the deals reaching the node, with the probability of
+    // all their chance outcomes and their [num_players] returns.
+    std::vector<int> deals;
+    std::vector<double> chance_probs;
+    std::vector<double> returns;
+  };
+
+  // Adds the public node of `states`, which are histories of the given deals
+  // reached with the given chance probabilities, and its subtree. Returns its
+  // index.
+  int CompilePublicNode(std::vector<std::unique_ptr<State>> states,
+                        const std::vector<int>& deals,
+                        const std::vector<double>& chance_probs);
+
+  // Fills `values` with the counterfactual values of the subtree of
+  // `node` for every hand of every player, and updates the regrets and
+  // average policy of `alternating_player` (or of all players if not set).
+  // Both vectors are indexed like hand_offsets_.
+  void ComputeCounterFactualRegret(
+      int node, const std::optional<int>& alternating_player,
+      const std::vector<double>& reach_probabilities,
+      std::vector<double>* values);
+
+  const int num_players_;
+  const bool sample_public_chance_;
+  std::mt19937 rng_;
+
+  // The per-hand vectors are the concatenation of the hands of each player:
+  // those of player p are at [hand_offsets_[p], hand_offsets_[p + 1]).
+  std::vector<int> hand_offsets_;
+  // [num_deals, num_players], the index of each player's hand in a deal in
+  // the per-hand vectors.
+  std::vector<int> deal_hands_;
+  // The root is nodes_[0].
+  std::vector<PublicNode> nodes_;
+};
+
+// Standard CFR over the public tree, see CFRSolver.
+class PublicTreeCFRSolver : public PublicTreeCFRSolverBase {
+ public:
+  explicit PublicTreeCFRSolver(const Game& game)
+      : PublicTreeCFRSolverBase(game,
+                                /*alternating_updates=*/true,
+                                /*linear_averaging=*/false,
+                                /*regret_matching_plus=*/false) {}
+};
+
+// CFR+ over the public tree, see CFRPlusSolver.
+class PublicTreeCFRPlusSolver : public PublicTreeCFRSolverBase {
+ public:
+  explicit PublicTreeCFRPlusSolver(const Game& game)
+      : PublicTreeCFRSolverBase(game,
+                                /*alternating_updates=*/true,
+                                /*linear_averaging=*/true,
+                                /*regret_matching_plus=*/true) {}
+};
+
+// Public chance sampling CFR, see PublicTreeCFRSolverBase.
+class PublicChanceSamplingCFRSolver : public PublicTreeCFRSolverBase {
+ public:
+  explicit PublicChanceSamplingCFRSolver(const Game& game, int seed = 0)
+      : PublicTreeCFRSolverBase(game,
+                                /*alternating_updates=*/true,
+                                /*linear_averaging=*/false,
+                                /*regret_matching_plus=*/false,
+                                /*sample_public_chance=*/true, seed) {}
+};
+
+// Public chance sampling CFR+, see PublicTreeCFRSolverBase.
+class PublicChanceSamplingCFRPlusSolver : public PublicTreeCFRSolverBase {
+ public:
+  explicit PublicChanceSamplingCFRPlusSolver(const Game& game, int seed = 0)
+      : PublicTreeCFRSolverBase(game,
+                                /*alternating_updates=*/true,
+                                /*linear_averaging=*/true,
+                                /*regret_matching_plus=*/true,
+                                /*sample_public_chance=*/true, seed) {}
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PUBLIC_TREE_CFR_H_
@@ -0,0 +1,136 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/public_tree_cfr.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/get_all_states.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CheckSamePolicies(const Game& game, const Policy& policy,
+                       const Policy& expected_policy) {
+  for (const auto& [history, state] :
+       GetAllStates(game, /*depth_limit=*/-1, /*include_terminals=*/false,
+                    /*include_chance_states=*/false)) {
+    const ActionsAndProbs actions_and_probs = policy.GetStatePolicy(*state);
+    const ActionsAndProbs expected = expected_policy.GetStatePolicy(*state);
+    SPIEL_CHECK_EQ(actions_and_probs.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+      SPIEL_CHECK_EQ(actions_and_probs[i].first, expected[i].first);
+      SPIEL_CHECK_FLOAT_NEAR(actions_and_probs[i].second, expected[i].second,
+                             1e-9);
+    }
+  }
+}
+
+// The public tree solver must reproduce the iterates of the history one.
+void PublicTreeCFRTest_MatchesCFR(const std::string& game_name,
+                                  bool alternating_updates,
+                                  bool linear_averaging,
+                                  bool regret_matching_plus) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  CFRSolverBase solver(*game, alternating_updates, linear_averaging,
+                       regret_matching_plus);
+  PublicTreeCFRSolverBase public_tree_solver(
+      *game, alternating_updates, linear_averaging, regret_matching_plus);
+  for (int i = 0; i < 20; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    public_tree_solver.EvaluateAndUpdatePolicy();
+  }
+  CheckSamePolicies(*game, *public_tree_solver.CurrentPolicy(),
+                    *solver.CurrentPolicy());
+  CheckSamePolicies(*game, *public_tree_solver.AveragePolicy(),
+                    *solver.AveragePolicy());
+}
+
+void PublicTreeCFRTest_KuhnPoker() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  PublicTreeCFRSolver solver(*game);
+  // 3 * 2 deals, and the 4 decision and 5 terminal betting sequences.
+  SPIEL_CHECK_EQ(solver.NumDeals(), 6);
+  SPIEL_CHECK_EQ(solver.NumHands(0), 3);
+  SPIEL_CHECK_EQ(solver.NumHands(1), 3);
+  SPIEL_CHECK_EQ(solver.NumPublicNodes(), 9);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.05);
+}
+
+void PublicTreeCFRPlusTest_LeducPoker() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  PublicTreeCFRPlusSolver solver(*game);
+  SPIEL_CHECK_EQ(solver.NumDeals(), 30);
+  for (int i = 0; i < 100; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.05);
+}
+
+// Kuhn poker has no chance node after the deal, so there is nothing to
+// sample.
+void PublicChanceSamplingCFRTest_MatchesPublicTreeCFRWithoutPublicChance() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  PublicTreeCFRSolver solver(*game);
+  PublicChanceSamplingCFRSolver sampling_solver(*game);
+  for (int i = 0; i < 20; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    sampling_solver.EvaluateAndUpdatePolicy();
+  }
+  CheckSamePolicies(*game, *sampling_solver.AveragePolicy(),
+                    *solver.AveragePolicy());
+}
+
+void PublicChanceSamplingCFRTest_LeducPoker() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  PublicChanceSamplingCFRSolver solver(*game, /*seed=*/1);
+  PublicChanceSamplingCFRPlusSolver plus_solver(*game, /*seed=*/1);
+  for (int i = 0; i < 5000; i++) {
+    solver.EvaluateAndUpdatePolicy();
+    plus_solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LE(Exploitability(*game, *solver.AveragePolicy()), 0.1);
+  SPIEL_CHECK_LE(Exploitability(*game, *plus_solver.AveragePolicy()), 0.1);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace algorithms = open_spiel::algorithms;
+
+int main(int argc, char** argv) {
+  algorithms::PublicTreeCFRTest_KuhnPoker();
+  algorithms::PublicTreeCFRPlusTest_LeducPoker();
+  algorithms::
+      PublicChanceSamplingCFRTest_MatchesPublicTreeCFRWithoutPublicChance();
+  algorithms::PublicChanceSamplingCFRTest_LeducPoker();
+  for (const char* game_name : {"kuhn_poker", "leduc_poker"}) {
+    // CFR, CFR+ and simultaneous-update CFR.
+    algorithms::PublicTreeCFRTest_MatchesCFR(game_name, true, false, false);
+    algorithms::PublicTreeCFRTest_MatchesCFR(game_name, true, true, true);
+    algorithms::PublicTreeCFRTest_MatchesCFR(game_name, false, false, false);
+  }
+}
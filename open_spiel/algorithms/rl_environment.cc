@@ -0,0 +1,145 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/rl_environment.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+bool UseObservationTensor(const Game& game, bool use_observation_tensor) {
+  const GameType& type = game.GetType();
+  if (!use_observation_tensor && type.provides_information_state_tensor) {
+    return false;
+  }
+  if (!type.provides_observation_tensor) {
+    SpielFatalError(use_observation_tensor
+                        ? "observation_tensor not supported by the game."
+                        : "The game provides neither information state nor "
+                          "observation tensors.");
+  }
+  return true;
+}
+
+}  // namespace
+
+RLEnvironment::RLEnvironment(std::shared_ptr<const Game> game, int num_envs,
+                             int seed, bool use_observation_tensor,
+                             double discount)
+    : game_(std::move(game)),
+      initial_state_(game_->NewInitialState()),
+      rng_(seed),
+      num_players_(game_->NumPlayers()),
+      num_distinct_actions_(game_->NumDistinctActions()),
+      use_observation_tensor_(
+          UseObservationTensor(*game_, use_observation_tensor)),
+      info_state_size_(use_observation_tensor_
+                           ? game_->ObservationTensorSize()
+                           : game_->InformationStateTensorSize()),
+      discount_(discount),
+      info_states_(num_envs * num_players_ * info_state_size_),
+      legal_actions_masks_(num_envs * num_players_ * num_distinct_actions_),
+      rewards_(num_envs * num_players_),
+      discounts_(num_envs * num_players_),
+      current_players_(num_envs),
+      step_types_(num_envs) {
+  SPIEL_CHECK_GT(num_envs, 0);
+  if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("RLEnvironment only supports sequential games.");
+  }
+  states_.reserve(num_envs);
+  for (int env = 0; env < num_envs; ++env) {
+    states_.push_back(initial_state_->Clone());
+  }
+  Reset();
+}
+
+void RLEnvironment::Reset() {
+  for (int env = 0; env < states_.size(); ++env) {
+    ResetEnv(env);
+    WriteObservations(env);
+  }
+}
+
+void RLEnvironment::Step(absl::Span<const Action> actions) {
+  SPIEL_CHECK_EQ(actions.size(), states_.size());
+  for (int env = 0; env < states_.size(); ++env) {
+    if (step_types_[env] == static_cast<int>(StepType::kLast)) {
+      ResetEnv(env);
+    } else {
+      State* state = states_[env].get();
+      state->ApplyAction(actions[env]);
+      SampleChanceOutcomes(env);
+      step_types_[env] = static_cast<int>(state->IsTerminal() ? StepType::kLast
+                                                              : StepType::kMid);
+      // Rewards are not defined at chance nodes, so they are those of the
+      // decision (or terminal) node we end up at.
+      const std::vector<double> rewards = state->Rewards();
+      std::copy(rewards.begin(), rewards.end(), &rewards_[env * num_players_]);
+      std::fill_n(&discounts_[env * num_players_], num_players_, discount_);
+    }
+    WriteObservations(env);
+  }
+}
+
+void RLEnvironment::ResetEnv(int env) {
+  // Recycle the state in place when the game supports it.
+  if (!states_[env]->CopyFrom(*initial_state_)) {
+    states_[env] = initial_state_->Clone();
+  }
+  SampleChanceOutcomes(env);
+  step_types_[env] = static_cast<int>(StepType::kFirst);
+  std::fill_n(&rewards_[env * num_players_], num_players_, 0.0f);
+  std::fill_n(&discounts_[env * num_players_], num_players_, 0.0f);
+}
+
+void RLEnvironment::SampleChanceOutcomes(int env) {
+  State* state = states_[env].get();
+  while (state->IsChanceNode()) {
+    state->ApplyAction(state->SampleChanceOutcome(rng_).first);
+  }
+}
+
+void RLEnvironment::WriteObservations(int env) {
+  const State& state = *states_[env];
+  current_players_[env] = state.CurrentPlayer();
+  absl::Span<float> info_states = absl::MakeSpan(info_states_).subspan(
+      env * num_players_ * info_state_size_, num_players_ * info_state_size_);
+  absl::Span<float> masks = absl::MakeSpan(legal_actions_masks_).subspan(
+      env * num_players_ * num_distinct_actions_,
+      num_players_ * num_distinct_actions_);
+  for (Player player = 0; player < num_players_; ++player) {
+    absl::Span<float> info_state =
+        info_states.subspan(player * info_state_size_, info_state_size_);
+    if (use_observation_tensor_) {
+      state.ObservationTensor(player, info_state);
+    } else {
+      state.InformationStateTensor(player, info_state);
+    }
+    state.LegalActionsMask(
+        player,
+        masks.subspan(player * num_distinct_actions_, num_distinct_actions_));
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
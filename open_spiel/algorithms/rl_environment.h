@@ -0,0 +1,108 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_RL_ENVIRONMENT_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_RL_ENVIRONMENT_H_
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// The same values as StepType in python/rl_environment.py.
+enum class StepType { kFirst = 0, kMid = 1, kLast = 2 };
+
+// A batch of environments with the semantics of the Environment of
+// python/rl_environment.py, for agents like DQN and NFSP written against its
+// TimeStep, but computed in C++ for the whole batch at once.
+//
+// Unlike VectorEnv, every player gets their own information state (or
+// observation) and legal actions mask at every step, as agents need to see the
+// last step of an episode whether they are to play or not. Chance outcomes are
+// sampled as soon as they are reached. Stepping an environment whose last step
+// was kLast starts a new episode there and ignores its action, as in Python.
+//
+// The fields of the TimeStep of the whole batch are contiguous row-major
+// arrays indexed by environment first. Rewards and discounts are 0 on kFirst
+// steps, where Python has None.
+class RLEnvironment {
+ public:
+  // Observations are information state tensors if the game provides them,
+  // unless use_observation_tensor is set, and observation tensors otherwise.
+  RLEnvironment(std::shared_ptr<const Game> game, int num_envs, int seed,
+                bool use_observation_tensor = false, double discount = 1.0);
+
+  // Starts a new episode in every environment.
+  void Reset();
+
+  // Applies actions[i] in environment i, or starts a new episode there if its
+  // previous one ended. The actions must be legal for the current players.
+  void Step(absl::Span<const Action> actions);
+
+  int num_envs() const { return states_.size(); }
+  int num_players() const { return num_players_; }
+  int info_state_size() const { return info_state_size_; }
+  const State& state(int env) const { return *states_[env]; }
+
+  // [num_envs, num_players, info_state_size()].
+  const std::vector<float>& info_states() const { return info_states_; }
+
+  // [num_envs, num_players, NumDistinctActions()], 1 for the legal actions of
+  // each player and 0 otherwise.
+  const std::vector<float>& legal_actions_masks() const {
+    return legal_actions_masks_;
+  }
+
+  // [num_envs, num_players].
+  const std::vector<float>& rewards() const { return rewards_; }
+  const std::vector<float>& discounts() const { return discounts_; }
+
+  // [num_envs], the player to act, or kTerminalPlayerId.
+  const std::vector<int>& current_players() const { return current_players_; }
+
+  // [num_envs], the StepType values as ints.
+  const std::vector<int>& step_types() const { return step_types_; }
+
+ private:
+  void ResetEnv(int env);
+  void SampleChanceOutcomes(int env);
+  void WriteObservations(int env);
+
+  std::shared_ptr<const Game> game_;
+  std::unique_ptr<State> initial_state_;
+  std::vector<std::unique_ptr<State>> states_;
+  std::mt19937 rng_;
+  const int num_players_;
+  const int num_distinct_actions_;
+  const bool use_observation_tensor_;
+  const int info_state_size_;
+  const float discount_;
+
+  std::vector<float> info_states_;
+  std::vector<float> legal_actions_masks_;
+  std::vector<float> rewards_;
+  std::vector<float> discounts_;
+  std::vector<int> current_players_;
+  std::vector<int> step_types_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_RL_ENVIRONMENT_H_
@@ -0,0 +1,143 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/rl_environment.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kNumEnvs = 8;
+constexpr int kNumSteps = 200;
+
+// Checks that the batched outputs of env match its states.
+void CheckOutputs(const Game& game, const RLEnvironment& env,
+                  bool use_observation_tensor) {
+  const int num_players = game.NumPlayers();
+  const int size = env.info_state_size();
+  const int num_actions = game.NumDistinctActions();
+  for (int i = 0; i < env.num_envs(); ++i) {
+    const State& state = env.state(i);
+    SPIEL_CHECK_FALSE(state.IsChanceNode());
+    SPIEL_CHECK_EQ(env.current_players()[i], state.CurrentPlayer());
+    SPIEL_CHECK_EQ(env.step_types()[i] == static_cast<int>(StepType::kLast),
+                   state.IsTerminal());
+    for (Player p = 0; p < num_players; ++p) {
+      std::vector<double> info_state = use_observation_tensor
+                                           ? state.ObservationTensor(p)
+                                           : state.InformationStateTensor(p);
+      for (int j = 0; j < size; ++j) {
+        SPIEL_CHECK_FLOAT_EQ(
+            env.info_states()[(i * num_players + p) * size + j],
+            info_state[j]);
+      }
+      std::vector<float> mask(num_actions, 0.0f);
+      for (Action action : state.LegalActions(p)) mask[action] = 1.0f;
+      for (int a = 0; a < num_actions; ++a) {
+        SPIEL_CHECK_EQ(
+            env.legal_actions_masks()[(i * num_players + p) * num_actions + a],
+            mask[a]);
+      }
+    }
+  }
+}
+
+void RandomStepsTest(const std::string& game_name,
+                     bool use_observation_tensor) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  const int num_players = game->NumPlayers();
+  RLEnvironment env(game, kNumEnvs, /*seed=*/1234, use_observation_tensor,
+                    /*discount=*/0.9);
+  CheckOutputs(*game, env, use_observation_tensor);
+  for (int i = 0; i < kNumEnvs; ++i) {
+    SPIEL_CHECK_EQ(env.step_types()[i], static_cast<int>(StepType::kFirst));
+  }
+
+  std::mt19937 rng;
+  std::vector<double> returns(kNumEnvs * num_players, 0.0);
+  int num_episodes = 0;
+  for (int step = 0; step < kNumSteps; ++step) {
+    std::vector<int> previous_step_types = env.step_types();
+    std::vector<Action> actions;
+    for (int i = 0; i < kNumEnvs; ++i) {
+      std::vector<Action> legal_actions = env.state(i).LegalActions();
+      if (legal_actions.empty()) {
+        // The action of an environment that has ended is ignored.
+        actions.push_back(kInvalidAction);
+        continue;
+      }
+      std::uniform_int_distribution<int> dis(0, legal_actions.size() - 1);
+      actions.push_back(legal_actions[dis(rng)]);
+    }
+    env.Step(actions);
+    CheckOutputs(*game, env, use_observation_tensor);
+
+    for (int i = 0; i < kNumEnvs; ++i) {
+      const float* rewards = &env.rewards()[i * num_players];
+      const float* discounts = &env.discounts()[i * num_players];
+      if (previous_step_types[i] == static_cast<int>(StepType::kLast)) {
+        SPIEL_CHECK_EQ(env.step_types()[i],
+                       static_cast<int>(StepType::kFirst));
+        for (Player p = 0; p < num_players; ++p) {
+          SPIEL_CHECK_EQ(rewards[p], 0.0f);
+          SPIEL_CHECK_EQ(discounts[p], 0.0f);
+        }
+        continue;
+      }
+      double sum = 0;
+      for (Player p = 0; p < num_players; ++p) {
+        SPIEL_CHECK_FLOAT_EQ(discounts[p], 0.9f);
+        returns[i * num_players + p] += rewards[p];
+        sum += returns[i * num_players + p];
+      }
+      if (env.step_types()[i] == static_cast<int>(StepType::kLast)) {
+        // Both games are zero-sum.
+        SPIEL_CHECK_FLOAT_EQ(sum, 0.0);
+        for (Player p = 0; p < num_players; ++p) {
+          SPIEL_CHECK_FLOAT_EQ(returns[i * num_players + p],
+                               env.state(i).PlayerReturn(p));
+          returns[i * num_players + p] = 0;
+        }
+        ++num_episodes;
+      }
+    }
+  }
+  SPIEL_CHECK_GT(num_episodes, 0);
+
+  env.Reset();
+  CheckOutputs(*game, env, use_observation_tensor);
+  for (int i = 0; i < kNumEnvs; ++i) {
+    SPIEL_CHECK_EQ(env.step_types()[i], static_cast<int>(StepType::kFirst));
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::RandomStepsTest("tic_tac_toe",
+                                          /*use_observation_tensor=*/true);
+  open_spiel::algorithms::RandomStepsTest("kuhn_poker",
+                                          /*use_observation_tensor=*/false);
+  open_spiel::algorithms::RandomStepsTest("kuhn_poker",
+                                          /*use_observation_tensor=*/true);
+}
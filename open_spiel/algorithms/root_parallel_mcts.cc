@@ -0,0 +1,264 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/root_parallel_mcts.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/tcp.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+using tcp::Append;
+using tcp::AppendArray;
+using tcp::Reader;
+
+// The first byte of the requests to RootParallelMCTSServer.
+constexpr char kSearch = 'S';
+
+SearchNode ToSearchNode(const RootChildStats& stats) {
+  SearchNode node(stats.action, stats.player, /*prior_=*/0);
+  node.explore_count = stats.explore_count;
+  node.total_reward = stats.total_reward;
+  node.outcome = stats.outcome;
+  return node;
+}
+
+// Runs the search of a bot from `state`.
+std::vector<RootChildStats> SearchWith(const MCTSBotFactory& factory,
+                                       int seed, const State& state) {
+  std::unique_ptr<MCTSBot> bot = factory(seed);
+  return RootStats(*bot->MCTSearch(state));
+}
+
+}  // namespace
+
+std::vector<RootChildStats> RootStats(const SearchNode& root) {
+  std::vector<RootChildStats> stats;
+  stats.reserve(root.children.size());
+  for (const SearchNode& child : root.children) {
+    stats.push_back({child.action, child.player, child.explore_count,
+                     child.total_reward, child.outcome});
+  }
+  return stats;
+}
+
+void MergeRootStats(const std::vector<RootChildStats>& stats,
+                    std::vector<RootChildStats>* merged) {
+  for (const RootChildStats& child : stats) {
+    auto it = std::find_if(
+        merged->begin(), merged->end(),
+        [&child](const RootChildStats& m) { return m.action == child.action; });
+    if (it == merged->end()) {
+      merged->push_back(child);
+      continue;
+    }
+    SPIEL_CHECK_EQ(it->player, child.player);
+    it->explore_count += child.explore_count;
+    it->total_reward += child.total_reward;
+    // Proven outcomes are exact, so any search's is everyone's.
+    if (it->outcome.empty()) it->outcome = child.outcome;
+  }
+}
+
+const RootChildStats& BestRootChild(const std::vector<RootChildStats>& stats) {
+  SPIEL_CHECK_FALSE(stats.empty());
+  return *std::max_element(
+      stats.begin(), stats.end(),
+      [](const RootChildStats& a, const RootChildStats& b) {
+        return ToSearchNode(a).CompareFinal(ToSearchNode(b));
+      });
+}
+
+std::string EncodeRootStats(const std::vector<RootChildStats>& stats) {
+  std::string out;
+  Append<int32_t>(stats.size(), &out);
+  for (const RootChildStats& child : stats) {
+    Append<int64_t>(child.action, &out);
+    Append<int32_t>(child.player, &out);
+    Append<int32_t>(child.explore_count, &out);
+    Append<double>(child.total_reward, &out);
+    Append<int32_t>(child.outcome.size(), &out);
+    AppendArray<double>(child.outcome, &out);
+  }
+  return out;
+}
+
+std::vector<RootChildStats> DecodeRootStats(absl::string_view data) {
+  Reader reader(data);
+  std::vector<RootChildStats> stats(reader.Read<int32_t>());
+  for (RootChildStats& child : stats) {
+    child.action = reader.Read<int64_t>();
+    child.player = reader.Read<int32_t>();
+    child.explore_count = reader.Read<int32_t>();
+    child.total_reward = reader.Read<double>();
+    child.outcome.resize(reader.Read<int32_t>());
+    reader.ReadArray<double>(absl::MakeSpan(child.outcome));
+  }
+  SPIEL_CHECK_TRUE(reader.Rest().empty());
+  return stats;
+}
+
+RootParallelMCTSServer::RootParallelMCTSServer(const Game& game,
+                                               MCTSBotFactory factory,
+                                               int port)
+    : game_(game.shared_from_this()),
+      factory_(std::move(factory)),
+      listener_(port),
+      accept_thread_([this]() { AcceptLoop(); }) {}
+
+RootParallelMCTSServer::~RootParallelMCTSServer() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+  }
+  listener_.Shutdown();
+  accept_thread_.join();
+  std::vector<Thread> threads;
+  {
+    absl::MutexLock lock(&mu_);
+    for (auto& connection : connections_) connection->Shutdown();
+    threads = std::move(threads_);
+  }
+  for (Thread& thread : threads) thread.join();
+}
+
+int64_t RootParallelMCTSServer::NumSearches() {
+  absl::MutexLock lock(&mu_);
+  return num_searches_;
+}
+
+void RootParallelMCTSServer::AcceptLoop() {
+  while (std::unique_ptr<tcp::Connection> connection = listener_.Accept()) {
+    absl::MutexLock lock(&mu_);
+    if (stop_) return;
+    tcp::Connection* served = connection.get();
+    connections_.push_back(std::move(connection));
+    threads_.emplace_back([this, served]() { Serve(served); });
+  }
+}
+
+void RootParallelMCTSServer::Serve(tcp::Connection* connection) {
+  while (std::optional<std::string> request = connection->Receive()) {
+    // Not a bot: drop the connection.
+    if (request->empty() || (*request)[0] != kSearch) return;
+    Reader reader(absl::string_view(*request).substr(1));
+    if (!connection->Send(Search(&reader))) return;
+  }
+}
+
+std::string RootParallelMCTSServer::Search(Reader* reader) {
+  const int seed = reader->Read<int32_t>();
+  std::vector<int64_t> history(reader->Read<int32_t>());
+  reader->ReadArray<int64_t>(absl::MakeSpan(history));
+  SPIEL_CHECK_TRUE(reader->Rest().empty());
+  std::unique_ptr<State> state = game_->NewInitialState();
+  for (Action action : history) state->ApplyAction(action);
+  std::string reply = EncodeRootStats(SearchWith(factory_, seed, *state));
+  absl::MutexLock lock(&mu_);
+  ++num_searches_;
+  return reply;
+}
+
+RootParallelMCTSBot::RootParallelMCTSBot(
+    const Game& game, MCTSBotFactory factory, int num_local_searches,
+    const std::vector<std::string>& workers, int seed,
+    absl::Duration connect_timeout)
+    : game_(game.shared_from_this()),
+      factory_(std::move(factory)),
+      num_local_searches_(num_local_searches),
+      workers_(workers),
+      rng_(seed) {
+  SPIEL_CHECK_GE(num_local_searches_, 0);
+  SPIEL_CHECK_GE(num_local_searches_ + workers_.size(), 1);
+  for (const std::string& worker : workers_) {
+    connections_.push_back(tcp::Connection::Connect(worker, connect_timeout));
+  }
+}
+
+std::vector<RootChildStats> RootParallelMCTSBot::Search(const State& state) {
+  std::vector<int> seeds(num_local_searches_ + workers_.size());
+  for (int& seed : seeds) seed = static_cast<int>(rng_() >> 33);
+
+  // Start the remote searches first, so that they run during the local ones.
+  const std::vector<Action> history = state.History();
+  for (int w = 0; w < workers_.size(); ++w) {
+    std::string request(1, kSearch);
+    Append<int32_t>(seeds[num_local_searches_ + w], &request);
+    Append<int32_t>(history.size(), &request);
+    for (Action action : history) Append<int64_t>(action, &request);
+    if (!connections_[w]->Send(request)) {
+      SpielFatalError(absl::StrCat("Lost the connection to ", workers_[w]));
+    }
+  }
+
+  std::vector<std::vector<RootChildStats>> local(num_local_searches_);
+  {
+    std::vector<Thread> threads;
+    for (int i = 1; i < num_local_searches_; ++i) {
+      threads.emplace_back([this, &local, &seeds, &state, i]() {
+        local[i] = SearchWith(factory_, seeds[i], state);
+      });
+    }
+    if (num_local_searches_ > 0) {
+      local[0] = SearchWith(factory_, seeds[0], state);
+    }
+    for (Thread& thread : threads) thread.join();
+  }
+
+  std::vector<RootChildStats> merged;
+  for (const std::vector<RootChildStats>& stats : local) {
+    MergeRootStats(stats, &merged);
+  }
+  for (int w = 0; w < workers_.size(); ++w) {
+    std::optional<std::string> reply = connections_[w]->Receive();
+    if (!reply) {
+      SpielFatalError(absl::StrCat("Lost the connection to ", workers_[w]));
+    }
+    MergeRootStats(DecodeRootStats(*reply), &merged);
+  }
+  return merged;
+}
+
+Action RootParallelMCTSBot::Step(const State& state) {
+  std::vector<RootChildStats> stats = Search(state);
+  SPIEL_CHECK_FALSE(stats.empty());
+  return BestRootChild(stats).action;
+}
+
+std::pair<ActionsAndProbs, Action> RootParallelMCTSBot::StepWithPolicy(
+    const State& state) {
+  Action action = Step(state);
+  return {{{action, 1.}}, action};
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
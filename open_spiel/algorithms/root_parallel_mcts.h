@@ -0,0 +1,161 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ROOT_PARALLEL_MCTS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ROOT_PARALLEL_MCTS_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/tcp.h"
+#include "open_spiel/utils/thread.h"
+
+// Root parallelization of MCTS: several independent searches from the same
+// state, with different seeds, whose statistics of the children of the root
+// are summed before choosing the action, as SearchNode::BestChild does from
+// the sums. Unlike the tree parallelization of MCTSBot, the searches share
+// nothing while they run, so each keeps its tree local to its thread, process
+// or machine, and they only exchange the root's children at the end.
+//
+// - RootParallelMCTSServers each serve searches to any number of bots, one
+//   thread per connection, e.g. one server per machine of a rack.
+// - RootParallelMCTSBot runs some of the searches itself, in threads, and
+//   sends the others to servers given as "host:port". A server listed several
+//   times runs that many searches at once.
+//
+// Every search runs an MCTSBot made by the factory given its seed, so the
+// bots of a factory sharing an evaluator must be able to call it from several
+// threads. The searches start from a new root each move: reuse_tree, ponder
+// and the Gumbel root selection of the bots are not used.
+//
+// Reference:
+// - Chaslot, Winands, and van den Herik, Parallel Monte-Carlo Tree Search,
+//   2008.
+
+namespace open_spiel {
+namespace algorithms {
+
+// The statistics of a child of the root after one or several searches.
+struct RootChildStats {
+  Action action = 0;
+  Player player = 0;
+  int explore_count = 0;
+  double total_reward = 0;
+  // The proven reward of each player, if any search solved the child.
+  std::vector<double> outcome;
+};
+
+// The statistics of the children of `root`, in order.
+std::vector<RootChildStats> RootStats(const SearchNode& root);
+
+// Adds `stats` to the statistics of the same actions in `merged`, and appends
+// those of the actions it does not have yet.
+void MergeRootStats(const std::vector<RootChildStats>& stats,
+                    std::vector<RootChildStats>* merged);
+
+// Returns the child SearchNode::BestChild would choose among children with
+// these statistics.
+const RootChildStats& BestRootChild(const std::vector<RootChildStats>& stats);
+
+// Encodes statistics to send them to other machines, and decodes them.
+std::string EncodeRootStats(const std::vector<RootChildStats>& stats);
+std::vector<RootChildStats> DecodeRootStats(absl::string_view data);
+
+// Makes the MCTSBot running a search with the given seed.
+using MCTSBotFactory = std::function<std::unique_ptr<MCTSBot>(int seed)>;
+
+// Serves the searches of RootParallelMCTSBots, each connection served by its
+// own thread, which calls the factory for each search.
+class RootParallelMCTSServer {
+ public:
+  // Listens on `port`, or on a free one if 0.
+  RootParallelMCTSServer(const Game& game, MCTSBotFactory factory, int port);
+
+  // Stops serving and closes the connections.
+  ~RootParallelMCTSServer();
+
+  RootParallelMCTSServer(const RootParallelMCTSServer&) = delete;
+  RootParallelMCTSServer& operator=(const RootParallelMCTSServer&) = delete;
+
+  int Port() const { return listener_.Port(); }
+
+  // The number of searches run.
+  int64_t NumSearches();
+
+ private:
+  void AcceptLoop();
+  void Serve(tcp::Connection* connection);
+
+  // Runs the search of a request and returns the root's statistics.
+  std::string Search(tcp::Reader* reader);
+
+  std::shared_ptr<const Game> game_;
+  MCTSBotFactory factory_;
+  tcp::Listener listener_;
+
+  absl::Mutex mu_;
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<std::unique_ptr<tcp::Connection>> connections_
+      ABSL_GUARDED_BY(mu_);
+  std::vector<Thread> threads_ ABSL_GUARDED_BY(mu_);
+  int64_t num_searches_ ABSL_GUARDED_BY(mu_) = 0;
+
+  Thread accept_thread_;
+};
+
+// A bot choosing its actions from the merged roots of num_local_searches
+// searches run in threads and one search per worker. Fails if a worker is
+// lost.
+class RootParallelMCTSBot : public Bot {
+ public:
+  RootParallelMCTSBot(const Game& game, MCTSBotFactory factory,
+                      int num_local_searches,
+                      const std::vector<std::string>& workers = {},
+                      int seed = 0,
+                      absl::Duration connect_timeout = absl::Seconds(60));
+
+  Action Step(const State& state) override;
+
+  // Returns the chosen action with probability 1, as MCTSBot does.
+  std::pair<ActionsAndProbs, Action> StepWithPolicy(
+      const State& state) override;
+
+  // Runs the searches from `state` and returns the merged statistics of the
+  // children of the root.
+  std::vector<RootChildStats> Search(const State& state);
+
+ private:
+  std::shared_ptr<const Game> game_;
+  MCTSBotFactory factory_;
+  int num_local_searches_;
+  std::vector<std::string> workers_;
+  std::vector<std::unique_ptr<tcp::Connection>> connections_;
+  SplitMix64 rng_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_ROOT_PARALLEL_MCTS_H_
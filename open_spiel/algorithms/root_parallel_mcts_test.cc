@@ -0,0 +1,124 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/root_parallel_mcts.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/algorithms/evaluate_bots.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+MCTSBotFactory TicTacToeFactory(const Game& game, Evaluator* evaluator,
+                                int max_simulations) {
+  return [&game, evaluator, max_simulations](int seed) {
+    return std::make_unique<MCTSBot>(game, evaluator, /*uct_c=*/2,
+                                     max_simulations, /*max_memory_mb=*/5,
+                                     /*solve=*/true, seed, /*verbose=*/false);
+  };
+}
+
+void MergeSumsStatsTest() {
+  std::vector<RootChildStats> merged;
+  MergeRootStats({{3, 0, 10, 4.0, {}}, {5, 0, 2, -1.0, {}}}, &merged);
+  MergeRootStats({{5, 0, 20, 6.0, {}}, {7, 0, 1, 1.0, {1, -1}}}, &merged);
+  SPIEL_CHECK_EQ(merged.size(), 3);
+  SPIEL_CHECK_EQ(merged[0].action, 3);
+  SPIEL_CHECK_EQ(merged[0].explore_count, 10);
+  SPIEL_CHECK_EQ(merged[1].action, 5);
+  SPIEL_CHECK_EQ(merged[1].explore_count, 22);
+  SPIEL_CHECK_FLOAT_EQ(merged[1].total_reward, 5.0);
+  SPIEL_CHECK_EQ(merged[2].outcome, std::vector<double>({1, -1}));
+
+  // A proven win beats the most explored child, as in BestChild.
+  SPIEL_CHECK_EQ(BestRootChild(merged).action, 7);
+  merged.pop_back();
+  SPIEL_CHECK_EQ(BestRootChild(merged).action, 5);
+}
+
+void EncodeDecodeTest() {
+  std::vector<RootChildStats> stats = {{3, 1, 10, 4.5, {}},
+                                       {8, 1, 2, -1.0, {0.5, -0.5}}};
+  std::vector<RootChildStats> decoded =
+      DecodeRootStats(EncodeRootStats(stats));
+  SPIEL_CHECK_EQ(decoded.size(), stats.size());
+  for (int i = 0; i < stats.size(); ++i) {
+    SPIEL_CHECK_EQ(decoded[i].action, stats[i].action);
+    SPIEL_CHECK_EQ(decoded[i].player, stats[i].player);
+    SPIEL_CHECK_EQ(decoded[i].explore_count, stats[i].explore_count);
+    SPIEL_CHECK_EQ(decoded[i].total_reward, stats[i].total_reward);
+    SPIEL_CHECK_EQ(decoded[i].outcome, stats[i].outcome);
+  }
+}
+
+void LocalSearchesTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  RandomRolloutEvaluator evaluator(10, 42);
+  RootParallelMCTSBot bot(*game, TicTacToeFactory(*game, &evaluator, 100),
+                          /*num_local_searches=*/4);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<RootChildStats> stats = bot.Search(*state);
+  SPIEL_CHECK_EQ(stats.size(), 9);
+  int explore_count = 0;
+  for (const RootChildStats& child : stats) {
+    explore_count += child.explore_count;
+  }
+  // Each search expands its root, then runs its simulations through it.
+  SPIEL_CHECK_EQ(explore_count, 4 * 99);
+
+  // Finds the winning move of ".x.\n...\n..o".
+  RootParallelMCTSBot strong_bot(*game,
+                                 TicTacToeFactory(*game, &evaluator, 2000),
+                                 /*num_local_searches=*/4);
+  state->ApplyAction(1);
+  state->ApplyAction(8);
+  SPIEL_CHECK_EQ(strong_bot.Step(*state), 2);
+}
+
+void RemoteSearchesTest() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  RandomRolloutEvaluator evaluator(10, 42);
+  RootParallelMCTSServer server(
+      *game, TicTacToeFactory(*game, &evaluator, 100), /*port=*/0);
+  const std::string address = absl::StrCat("localhost:", server.Port());
+  RootParallelMCTSBot bot0(*game, TicTacToeFactory(*game, &evaluator, 100),
+                           /*num_local_searches=*/1, {address, address},
+                           /*seed=*/1);
+  RootParallelMCTSBot bot1(*game, TicTacToeFactory(*game, &evaluator, 100),
+                           /*num_local_searches=*/0, {address}, /*seed=*/2);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<double> returns =
+      EvaluateBots(state.get(), {&bot0, &bot1}, /*seed=*/42);
+  SPIEL_CHECK_EQ(returns[0] + returns[1], 0);
+  SPIEL_CHECK_GE(server.NumSearches(), 9);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::MergeSumsStatsTest();
+  open_spiel::algorithms::EncodeDecodeTest();
+  open_spiel::algorithms::LocalSearchesTest();
+  open_spiel::algorithms::RemoteSearchesTest();
+}
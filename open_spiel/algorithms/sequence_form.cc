@@ -0,0 +1,318 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sequence_form.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+SparseMatrix::SparseMatrix(int num_rows, int num_cols,
+                           std::vector<std::tuple<int, int, double>> entries)
+    : num_rows_(num_rows), num_cols_(num_cols), row_starts_(num_rows + 1, 0) {
+  absl::c_sort(entries);
+  for (int i = 0; i < entries.size(); ++i) {
+    const auto& [row, col, value] = entries[i];
+    SPIEL_CHECK_GE(row, 0);
+    SPIEL_CHECK_LT(row, num_rows);
+    SPIEL_CHECK_GE(col, 0);
+    SPIEL_CHECK_LT(col, num_cols);
+    if (i > 0 && std::get<0>(entries[i - 1]) == row &&
+        std::get<1>(entries[i - 1]) == col) {
+      values_.back() += value;
+      continue;
+    }
+    ++row_starts_[row + 1];
+    cols_.push_back(col);
+    values_.push_back(value);
+  }
+  for (int row = 0; row < num_rows; ++row) {
+    row_starts_[row + 1] += row_starts_[row];
+  }
+}
+
+SparseMatrix SparseMatrix::Transpose() const {
+  SparseMatrix transpose;
+  transpose.num_rows_ = num_cols_;
+  transpose.num_cols_ = num_rows_;
+  transpose.row_starts_.assign(num_cols_ + 1, 0);
+  for (int col : cols_) ++transpose.row_starts_[col + 1];
+  for (int col = 0; col < num_cols_; ++col) {
+    transpose.row_starts_[col + 1] += transpose.row_starts_[col];
+  }
+  // Going through the rows in order keeps the columns of the transpose sorted.
+  std::vector<int> next = transpose.row_starts_;
+  transpose.cols_.resize(cols_.size());
+  transpose.values_.resize(values_.size());
+  for (int row = 0; row < num_rows_; ++row) {
+    for (int i = row_starts_[row]; i < row_starts_[row + 1]; ++i) {
+      const int j = next[cols_[i]]++;
+      transpose.cols_[j] = row;
+      transpose.values_[j] = values_[i];
+    }
+  }
+  return transpose;
+}
+
+std::vector<double> SparseMatrix::Multiply(
+    absl::Span<const double> vector, int num_threads) const {
+  SPIEL_CHECK_EQ(vector.size(), num_cols_);
+  SPIEL_CHECK_GE(num_threads, 1);
+  std::vector<double> product(num_rows_);
+  auto multiply_rows = [this, vector, &product](int begin, int end) {
+    for (int row = begin; row < end; ++row) {
+      double sum = 0;
+      for (int i = row_starts_[row]; i < row_starts_[row + 1]; ++i) {
+        sum += values_[i] * vector[cols_[i]];
+      }
+      product[row] = sum;
+    }
+  };
+  num_threads = std::min(num_threads, num_rows_);
+  if (num_threads <= 1) {
+    multiply_rows(0, num_rows_);
+    return product;
+  }
+  // Contiguous blocks of rows, so that the threads write separate cache lines.
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    const int begin = static_cast<int64_t>(num_rows_) * t / num_threads;
+    const int end = static_cast<int64_t>(num_rows_) * (t + 1) / num_threads;
+    threads.emplace_back(
+        [&multiply_rows, begin, end]() { multiply_rows(begin, end); });
+  }
+  for (Thread& thread : threads) thread.join();
+  return product;
+}
+
+SequenceForm::SequenceForm(const Game& game) {
+  const GameType game_type = game.GetType();
+  if (game.NumPlayers() != 2) {
+    SpielFatalError("The sequence form needs a 2-player game.");
+  }
+  if (game_type.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("The sequence form needs a turn-based game.");
+  }
+  if (game_type.utility != GameType::Utility::kZeroSum) {
+    SpielFatalError("The sequence form needs a zero-sum game.");
+  }
+  for (PlayerSequences& player : players_) {
+    player.sequence_actions.push_back(kInvalidAction);
+  }
+  std::vector<std::tuple<int, int, double>> payoffs;
+  AddSubtree(*game.NewInitialState(), {0, 0}, 1.0, &payoffs);
+
+  for (PlayerSequences& player : players_) {
+    const int num_sequences = player.sequence_actions.size();
+    player.first_sequences.push_back(num_sequences);
+    std::vector<std::tuple<int, int, double>> constraints = {{0, 0, 1.0}};
+    for (int i = 0; i < player.info_states.size(); ++i) {
+      constraints.push_back({i + 1, player.parent_sequences[i], -1.0});
+      for (int s = player.first_sequences[i]; s < player.first_sequences[i + 1];
+           ++s) {
+        constraints.push_back({i + 1, s, 1.0});
+      }
+    }
+    player.constraint_matrix =
+        SparseMatrix(player.info_states.size() + 1, num_sequences,
+                     std::move(constraints));
+  }
+  payoff_matrix_ = SparseMatrix(NumSequences(0), NumSequences(1),
+                                std::move(payoffs));
+  transposed_payoff_matrix_ = payoff_matrix_.Transpose();
+}
+
+void SequenceForm::AddSubtree(
+    const State& state, std::array<int, 2> sequences, double chance,
+    std::vector<std::tuple<int, int, double>>* payoffs) {
+  if (state.IsTerminal()) {
+    const double value = chance * state.PlayerReturn(0);
+    if (value != 0) payoffs->push_back({sequences[0], sequences[1], value});
+    return;
+  }
+  if (state.IsChanceNode()) {
+    for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+      if (prob > 0) {
+        AddSubtree(*state.Child(outcome), sequences, chance * prob, payoffs);
+      }
+    }
+    return;
+  }
+  const Player player = state.CurrentPlayer();
+  PlayerSequences& sequences_of_player = players_[player];
+  const std::vector<Action> legal_actions = state.LegalActions();
+  auto [it, inserted] = sequences_of_player.info_state_indices.try_emplace(
+      state.InformationStateString(player),
+      sequences_of_player.info_states.size());
+  const int info_state = it->second;
+  if (inserted) {
+    sequences_of_player.info_states.push_back(it->first);
+    sequences_of_player.states.push_back(state.Clone());
+    sequences_of_player.parent_sequences.push_back(sequences[player]);
+    sequences_of_player.first_sequences.push_back(
+        sequences_of_player.sequence_actions.size());
+    for (Action action : legal_actions) {
+      sequences_of_player.sequence_actions.push_back(action);
+    }
+  } else if (sequences_of_player.parent_sequences[info_state] !=
+             sequences[player]) {
+    SpielFatalError("The sequence form needs a game with perfect recall.");
+  }
+  const int first_sequence = sequences_of_player.first_sequences[info_state];
+  for (int a = 0; a < legal_actions.size(); ++a) {
+    std::array<int, 2> child_sequences = sequences;
+    child_sequences[player] = first_sequence + a;
+    AddSubtree(*state.Child(legal_actions[a]), child_sequences, chance,
+               payoffs);
+  }
+}
+
+int SequenceForm::InfoStateIndex(Player player,
+                                 const std::string& info_state) const {
+  const auto& indices = players_[player].info_state_indices;
+  auto it = indices.find(info_state);
+  return it == indices.end() ? -1 : it->second;
+}
+
+std::vector<double> SequenceForm::UniformRealizationPlan(Player player) const {
+  std::vector<double> plan(NumSequences(player));
+  plan[0] = 1;
+  for (int i = 0; i < NumInfoStates(player); ++i) {
+    const double prob = plan[ParentSequence(player, i)] / NumActions(player, i);
+    for (int a = 0; a < NumActions(player, i); ++a) {
+      plan[FirstSequence(player, i) + a] = prob;
+    }
+  }
+  return plan;
+}
+
+std::vector<double> SequenceForm::RealizationPlan(Player player,
+                                                  const Policy& policy) const {
+  std::vector<const State*> states;
+  states.reserve(NumInfoStates(player));
+  for (const auto& state : players_[player].states) {
+    states.push_back(state.get());
+  }
+  std::vector<ActionsAndProbs> policies(states.size());
+  policy.GetStatePolicies(states, absl::MakeSpan(policies));
+
+  std::vector<double> plan(NumSequences(player));
+  plan[0] = 1;
+  for (int i = 0; i < NumInfoStates(player); ++i) {
+    const ActionsAndProbs& state_policy = policies[i];
+    if (state_policy.empty()) {
+      SpielFatalError(InfoStateString(player, i) + " not found in policy.");
+    }
+    for (int a = 0; a < NumActions(player, i); ++a) {
+      const int sequence = FirstSequence(player, i) + a;
+      const double prob =
+          GetProb(state_policy, SequenceAction(player, sequence));
+      SPIEL_CHECK_PROB(prob);
+      plan[sequence] = plan[ParentSequence(player, i)] * prob;
+    }
+  }
+  return plan;
+}
+
+TabularPolicy SequenceForm::BehavioralPolicy(
+    absl::Span<const double> plan0, absl::Span<const double> plan1) const {
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  for (Player player = 0; player < 2; ++player) {
+    absl::Span<const double> plan = player == 0 ? plan0 : plan1;
+    SPIEL_CHECK_EQ(plan.size(), NumSequences(player));
+    for (int i = 0; i < NumInfoStates(player); ++i) {
+      const int first_sequence = FirstSequence(player, i);
+      const int num_actions = NumActions(player, i);
+      double sum = 0;
+      for (int a = 0; a < num_actions; ++a) sum += plan[first_sequence + a];
+      ActionsAndProbs& state_policy = table[InfoStateString(player, i)];
+      for (int a = 0; a < num_actions; ++a) {
+        const int sequence = first_sequence + a;
+        state_policy.push_back(
+            {SequenceAction(player, sequence),
+             sum > 0 ? plan[sequence] / sum : 1.0 / num_actions});
+      }
+    }
+  }
+  return TabularPolicy(table);
+}
+
+double SequenceForm::Value(absl::Span<const double> plan0,
+                           absl::Span<const double> plan1,
+                           int num_threads) const {
+  SPIEL_CHECK_EQ(plan0.size(), NumSequences(0));
+  const std::vector<double> payoffs =
+      payoff_matrix_.Multiply(plan1, num_threads);
+  double value = 0;
+  for (int s = 0; s < payoffs.size(); ++s) value += plan0[s] * payoffs[s];
+  return value;
+}
+
+double SequenceForm::BestResponseValue(Player player,
+                                       absl::Span<const double> gradient,
+                                       std::vector<double>* plan) const {
+  SPIEL_CHECK_EQ(gradient.size(), NumSequences(player));
+  // The values of the sequences, adding those of the best actions of the
+  // information states they lead to, which come later.
+  std::vector<double> values(gradient.begin(), gradient.end());
+  std::vector<int> best_sequences(NumInfoStates(player));
+  for (int i = NumInfoStates(player) - 1; i >= 0; --i) {
+    int best_sequence = FirstSequence(player, i);
+    for (int a = 1; a < NumActions(player, i); ++a) {
+      const int sequence = FirstSequence(player, i) + a;
+      if (values[sequence] > values[best_sequence]) best_sequence = sequence;
+    }
+    best_sequences[i] = best_sequence;
+    values[ParentSequence(player, i)] += values[best_sequence];
+  }
+  if (plan != nullptr) {
+    plan->assign(NumSequences(player), 0.0);
+    (*plan)[0] = 1;
+    for (int i = 0; i < NumInfoStates(player); ++i) {
+      (*plan)[best_sequences[i]] = (*plan)[ParentSequence(player, i)];
+    }
+  }
+  return values[0];
+}
+
+double SequenceForm::NashConv(absl::Span<const double> plan0,
+                              absl::Span<const double> plan1,
+                              int num_threads) const {
+  const std::vector<double> payoffs0 =
+      payoff_matrix_.Multiply(plan1, num_threads);
+  std::vector<double> payoffs1 =
+      transposed_payoff_matrix_.Multiply(plan0, num_threads);
+  for (double& payoff : payoffs1) payoff = -payoff;
+  return BestResponseValue(0, payoffs0) + BestResponseValue(1, payoffs1);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
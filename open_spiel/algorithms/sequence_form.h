@@ -0,0 +1,176 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_H_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A sparse matrix in compressed sparse row format.
+class SparseMatrix {
+ public:
+  // Builds a matrix from (row, column, value) entries, summing the values of
+  // repeated entries.
+  SparseMatrix(int num_rows, int num_cols,
+               std::vector<std::tuple<int, int, double>> entries);
+
+  int NumRows() const { return num_rows_; }
+  int NumCols() const { return num_cols_; }
+  int NumNonZeros() const { return values_.size(); }
+  SparseMatrix Transpose() const;
+
+  // Returns the product of the matrix and `vector`. With num_threads > 1, the
+  // rows are split between threads, which only pays off for large matrices.
+  std::vector<double> Multiply(absl::Span<const double> vector,
+                               int num_threads = 1) const;
+
+ private:
+  SparseMatrix() = default;
+
+  int num_rows_ = 0;
+  int num_cols_ = 0;
+  // The entries of row r are at [row_starts_[r], row_starts_[r + 1]), by
+  // increasing column.
+  std::vector<int> row_starts_;
+  std::vector<int> cols_;
+  std::vector<double> values_;
+};
+
+// The sequence form of a 2-player, zero-sum, turn-based game with perfect
+// recall, as in the LPs of python/algorithms/sequence_form_lp.py, for
+// first-order solvers working on realization plans.
+//
+// The sequences of a player are the empty sequence, 0, and one per action of
+// each of its information states. A realization plan x gives the probability
+// of each sequence being played by the player, i.e. the product of its action
+// probabilities along the sequence, and is a vector satisfying E x = e, x >= 0,
+// with E the constraint matrix of the player and e the first unit vector. The
+// expected return of player 0 (and minus that of player 1) is x^T A y, with A
+// the payoff matrix, summing the chance-weighted returns of the terminal
+// histories reached by each pair of sequences.
+class SequenceForm {
+ public:
+  explicit SequenceForm(const Game& game);
+
+  int NumSequences(Player player) const {
+    return players_[player].sequence_actions.size();
+  }
+  int NumInfoStates(Player player) const {
+    return players_[player].info_states.size();
+  }
+  const std::string& InfoStateString(Player player, int info_state) const {
+    return players_[player].info_states[info_state];
+  }
+  // Returns the index of an information state, or -1 if it is not one of the
+  // player's.
+  int InfoStateIndex(Player player, const std::string& info_state) const;
+  // Returns the sequence leading to the information state. The information
+  // states are numbered such that this sequence comes from an earlier one.
+  int ParentSequence(Player player, int info_state) const {
+    return players_[player].parent_sequences[info_state];
+  }
+  // The sequences of the actions of an information state are consecutive,
+  // from FirstSequence, in the order of the legal actions.
+  int FirstSequence(Player player, int info_state) const {
+    return players_[player].first_sequences[info_state];
+  }
+  int NumActions(Player player, int info_state) const {
+    return players_[player].first_sequences[info_state + 1] -
+           players_[player].first_sequences[info_state];
+  }
+  // Returns the last action of a sequence, or kInvalidAction for the empty
+  // sequence.
+  Action SequenceAction(Player player, int sequence) const {
+    return players_[player].sequence_actions[sequence];
+  }
+
+  // The payoff matrix A of player 0, [player 0 sequence][player 1 sequence],
+  // and its transpose, for A y and A^T x.
+  const SparseMatrix& PayoffMatrix() const { return payoff_matrix_; }
+  const SparseMatrix& TransposedPayoffMatrix() const {
+    return transposed_payoff_matrix_;
+  }
+  // The constraint matrix with 1 + NumInfoStates(player) rows: x[0] = 1, and
+  // for each information state, the sum of its sequences equals its parent.
+  const SparseMatrix& ConstraintMatrix(Player player) const {
+    return players_[player].constraint_matrix;
+  }
+
+  // Returns the realization plan of playing uniformly at random, or
+  // following the player's part of `policy`, which is looked up by state.
+  std::vector<double> UniformRealizationPlan(Player player) const;
+  std::vector<double> RealizationPlan(Player player,
+                                      const Policy& policy) const;
+  // Returns the behavioral policy of both players' realization plans. The
+  // information states that a plan does not reach are played uniformly.
+  TabularPolicy BehavioralPolicy(absl::Span<const double> plan0,
+                                 absl::Span<const double> plan1) const;
+
+  // Returns x^T A y, the expected return of player 0.
+  double Value(absl::Span<const double> plan0, absl::Span<const double> plan1,
+               int num_threads = 1) const;
+
+  // Returns max g^T x over the realization plans x of `player`, by dynamic
+  // programming from the last information states up, and sets `plan` to one
+  // of the pure plans reaching it if not null. With g = A y for player 0, or
+  // -A^T x for player 1, this is the value of a best response.
+  double BestResponseValue(Player player, absl::Span<const double> gradient,
+                           std::vector<double>* plan = nullptr) const;
+
+  // Returns the sum of the values of the best responses to both plans, which
+  // is zero exactly at equilibria.
+  double NashConv(absl::Span<const double> plan0,
+                  absl::Span<const double> plan1, int num_threads = 1) const;
+
+ private:
+  struct PlayerSequences {
+    std::vector<std::string> info_states;
+    std::unordered_map<std::string, int> info_state_indices;
+    // A state of each information state, to look policies up by state, which
+    // policies with integer tables do through State::InformationStateIndex.
+    std::vector<std::unique_ptr<State>> states;
+    std::vector<int> parent_sequences;
+    // With a last element of NumSequences.
+    std::vector<int> first_sequences;
+    std::vector<Action> sequence_actions;
+    SparseMatrix constraint_matrix{0, 0, {}};
+  };
+
+  // Adds the sequences and payoffs of the subtree of `state`, reached with
+  // `sequences` of each player and a chance reach probability `chance`.
+  void AddSubtree(const State& state, std::array<int, 2> sequences,
+                  double chance,
+                  std::vector<std::tuple<int, int, double>>* payoffs);
+
+  std::array<PlayerSequences, 2> players_;
+  SparseMatrix payoff_matrix_{0, 0, {}};
+  SparseMatrix transposed_payoff_matrix_{0, 0, {}};
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_H_
@@ -0,0 +1,140 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sequence_form.h"
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "open_spiel/algorithms/best_response.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void SparseMatrixMultiplies() {
+  SparseMatrix matrix(3, 2, {{0, 1, 2.0}, {2, 0, 1.0}, {0, 1, 1.0}});
+  SPIEL_CHECK_EQ(matrix.NumNonZeros(), 2);
+  SPIEL_CHECK_EQ(matrix.Multiply({1.0, 2.0}),
+                 std::vector<double>({6.0, 0.0, 1.0}));
+  SPIEL_CHECK_EQ(matrix.Multiply({1.0, 2.0}, /*num_threads=*/2),
+                 std::vector<double>({6.0, 0.0, 1.0}));
+  SPIEL_CHECK_EQ(matrix.Transpose().Multiply({1.0, 2.0, 3.0}),
+                 std::vector<double>({3.0, 3.0}));
+}
+
+void KuhnSequenceForm() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  SequenceForm sequence_form(*game);
+  for (Player player = 0; player < 2; ++player) {
+    SPIEL_CHECK_EQ(sequence_form.NumInfoStates(player), 6);
+    SPIEL_CHECK_EQ(sequence_form.NumSequences(player), 13);
+  }
+}
+
+// The uniform plans must satisfy the constraints and give the values of the
+// tabular algorithms, and best responses must be as good as theirs.
+void SequenceFormMatchesTabularAlgorithms(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  SequenceForm sequence_form(*game);
+  TabularPolicy uniform = GetUniformPolicy(*game);
+  std::vector<std::vector<double>> plans;
+  for (Player player = 0; player < 2; ++player) {
+    std::vector<double> plan = sequence_form.UniformRealizationPlan(player);
+    std::vector<double> policy_plan =
+        sequence_form.RealizationPlan(player, uniform);
+    // UniformPolicy can only be looked up by state.
+    std::vector<double> state_policy_plan =
+        sequence_form.RealizationPlan(player, UniformPolicy());
+    for (int s = 0; s < plan.size(); ++s) {
+      SPIEL_CHECK_FLOAT_EQ(plan[s], policy_plan[s]);
+      SPIEL_CHECK_FLOAT_EQ(plan[s], state_policy_plan[s]);
+    }
+    std::vector<double> constraints =
+        sequence_form.ConstraintMatrix(player).Multiply(plan);
+    SPIEL_CHECK_FLOAT_EQ(constraints[0], 1.0);
+    for (int i = 1; i < constraints.size(); ++i) {
+      SPIEL_CHECK_FLOAT_NEAR(constraints[i], 0.0, 1e-12);
+    }
+    plans.push_back(plan);
+  }
+
+  std::unique_ptr<State> root = game->NewInitialState();
+  SPIEL_CHECK_FLOAT_NEAR(sequence_form.Value(plans[0], plans[1]),
+                         ExpectedReturns(*root, uniform, -1)[0], 1e-9);
+  SPIEL_CHECK_FLOAT_NEAR(
+      sequence_form.NashConv(plans[0], plans[1], /*num_threads=*/4),
+      NashConv(*game, uniform), 1e-9);
+
+  std::vector<double> gradient =
+      sequence_form.PayoffMatrix().Multiply(plans[1]);
+  std::vector<double> best_response_plan;
+  const double value =
+      sequence_form.BestResponseValue(0, gradient, &best_response_plan);
+  TabularBestResponse best_response(*game, 0, &uniform);
+  SPIEL_CHECK_FLOAT_NEAR(value, best_response.Value(root->ToString()), 1e-9);
+  SPIEL_CHECK_FLOAT_NEAR(sequence_form.Value(best_response_plan, plans[1]),
+                         value, 1e-9);
+
+  // The behavioral policy of the plans is the uniform policy again.
+  TabularPolicy behavioral = sequence_form.BehavioralPolicy(plans[0], plans[1]);
+  for (const auto& [info_state, state_policy] : uniform.PolicyTable()) {
+    ActionsAndProbs behavioral_policy = behavioral.GetStatePolicy(info_state);
+    SPIEL_CHECK_EQ(behavioral_policy.size(), state_policy.size());
+    for (const auto& [action, prob] : state_policy) {
+      SPIEL_CHECK_FLOAT_EQ(GetProb(behavioral_policy, action), prob);
+    }
+  }
+}
+
+// The CFR policies, which Kuhn poker's information state indices look up
+// without strings, give the plans of their tabular copies.
+void CFRPolicyRealizationPlans() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  SequenceForm sequence_form(*game);
+  CFRSolver solver(*game);
+  for (int i = 0; i < 10; ++i) solver.EvaluateAndUpdatePolicy();
+  std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  const TabularPolicy tabular_policy =
+      solver.DenseAveragePolicy().ToTabularPolicy();
+  for (Player player = 0; player < 2; ++player) {
+    std::vector<double> plan =
+        sequence_form.RealizationPlan(player, *average_policy);
+    std::vector<double> tabular_plan =
+        sequence_form.RealizationPlan(player, tabular_policy);
+    for (int s = 0; s < plan.size(); ++s) {
+      SPIEL_CHECK_FLOAT_NEAR(plan[s], tabular_plan[s], 1e-12);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::SparseMatrixMultiplies();
+  open_spiel::algorithms::KuhnSequenceForm();
+  open_spiel::algorithms::CFRPolicyRealizationPlans();
+  open_spiel::algorithms::SequenceFormMatchesTabularAlgorithms("kuhn_poker");
+  open_spiel::algorithms::SequenceFormMatchesTabularAlgorithms("leduc_poker");
+}
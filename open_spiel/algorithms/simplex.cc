@@ -0,0 +1,237 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/simplex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kEpsilon = 1e-9;
+
+// A simplex tableau of the constraints, with a column for each variable and
+// the right-hand sides last, and the objective row of the reduced costs,
+// whose last entry is the value of the objective.
+class Tableau {
+ public:
+  Tableau(int num_rows, int num_cols)
+      : rows_(num_rows, std::vector<double>(num_cols + 1, 0)),
+        objective_(num_cols + 1, 0),
+        basis_(num_rows),
+        rhs_(num_cols) {}
+
+  std::vector<double>& Row(int row) { return rows_[row]; }
+  std::vector<double>& Objective() { return objective_; }
+  double Rhs(int row) const { return rows_[row][rhs_]; }
+  int Basic(int row) const { return basis_[row]; }
+  void SetBasic(int row, int col) { basis_[row] = col; }
+  int NumRows() const { return rows_.size(); }
+
+  void Pivot(int row, int col) {
+    std::vector<double>& pivot_row = rows_[row];
+    const double pivot = pivot_row[col];
+    for (double& entry : pivot_row) entry /= pivot;
+    auto eliminate = [&](std::vector<double>& other) {
+      const double factor = other[col];
+      if (factor == 0) return;
+      for (int j = 0; j <= rhs_; ++j) other[j] -= factor * pivot_row[j];
+    };
+    for (int r = 0; r < rows_.size(); ++r) {
+      if (r != row) eliminate(rows_[r]);
+    }
+    eliminate(objective_);
+    basis_[row] = col;
+  }
+
+  // Maximizes the objective by entering only the first num_entering columns,
+  // with Bland's rule. Returns false if it is unbounded.
+  bool Maximize(int num_entering) {
+    while (true) {
+      int col = 0;
+      while (col < num_entering && objective_[col] >= -kEpsilon) ++col;
+      if (col == num_entering) return true;
+      int row = -1;
+      double best_ratio = 0;
+      for (int r = 0; r < rows_.size(); ++r) {
+        if (rows_[r][col] <= kEpsilon) continue;
+        const double ratio = rows_[r][rhs_] / rows_[r][col];
+        if (row < 0 || ratio < best_ratio - kEpsilon ||
+            (ratio <= best_ratio + kEpsilon && basis_[r] < basis_[row])) {
+          row = r;
+          best_ratio = ratio;
+        }
+      }
+      if (row < 0) return false;
+      Pivot(row, col);
+    }
+  }
+
+ private:
+  std::vector<std::vector<double>> rows_;
+  std::vector<double> objective_;
+  std::vector<int> basis_;
+  const int rhs_;
+};
+
+}  // namespace
+
+LinearProgramSolution MaximizeLinearProgram(
+    const std::vector<std::vector<double>>& a, const std::vector<double>& b,
+    const std::vector<double>& c) {
+  const int num_rows = a.size();
+  const int num_vars = c.size();
+  SPIEL_CHECK_EQ(b.size(), num_rows);
+  int num_artificial = 0;
+  for (double bound : b) num_artificial += bound < 0;
+
+  // The columns are the variables, then a slack for each constraint, then an
+  // artificial variable for each constraint with a negative bound, which is
+  // negated so that the initial basis is feasible.
+  const int num_real = num_vars + num_rows;
+  Tableau tableau(num_rows, num_real + num_artificial);
+  const int rhs = num_real + num_artificial;
+  int artificial = num_real;
+  for (int i = 0; i < num_rows; ++i) {
+    SPIEL_CHECK_EQ(a[i].size(), num_vars);
+    std::vector<double>& row = tableau.Row(i);
+    const double sign = b[i] < 0 ? -1 : 1;
+    for (int j = 0; j < num_vars; ++j) row[j] = sign * a[i][j];
+    row[num_vars + i] = sign;
+    row[rhs] = sign * b[i];
+    if (b[i] < 0) {
+      row[artificial] = 1;
+      tableau.SetBasic(i, artificial++);
+    } else {
+      tableau.SetBasic(i, num_vars + i);
+    }
+  }
+
+  LinearProgramSolution solution;
+  std::vector<double>& objective = tableau.Objective();
+  if (num_artificial > 0) {
+    // Phase one maximizes minus the sum of the artificial variables.
+    for (int i = 0; i < num_rows; ++i) {
+      if (tableau.Basic(i) < num_real) continue;
+      const std::vector<double>& row = tableau.Row(i);
+      for (int j = 0; j <= rhs; ++j) objective[j] -= row[j];
+      objective[tableau.Basic(i)] = 0;
+    }
+    tableau.Maximize(rhs);
+    if (objective[rhs] < -kEpsilon) {
+      solution.status = LinearProgramStatus::kInfeasible;
+      return solution;
+    }
+    // Drives the artificial variables left in the basis, which are zero, out
+    // of it. A row without any other variable is redundant and stays.
+    for (int i = 0; i < num_rows; ++i) {
+      if (tableau.Basic(i) < num_real) continue;
+      const std::vector<double>& row = tableau.Row(i);
+      for (int j = 0; j < num_real; ++j) {
+        if (std::abs(row[j]) > kEpsilon) {
+          tableau.Pivot(i, j);
+          break;
+        }
+      }
+    }
+  }
+
+  // Phase two, from the feasible basis, never entering artificial variables.
+  std::fill(objective.begin(), objective.end(), 0);
+  for (int j = 0; j < num_vars; ++j) objective[j] = -c[j];
+  for (int i = 0; i < num_rows; ++i) {
+    const double factor = objective[tableau.Basic(i)];
+    if (factor == 0) continue;
+    const std::vector<double>& row = tableau.Row(i);
+    for (int j = 0; j <= rhs; ++j) objective[j] -= factor * row[j];
+  }
+  if (!tableau.Maximize(num_real)) {
+    solution.status = LinearProgramStatus::kUnbounded;
+    return solution;
+  }
+
+  solution.status = LinearProgramStatus::kOptimal;
+  solution.objective = objective[rhs];
+  solution.x.assign(num_vars, 0);
+  for (int i = 0; i < num_rows; ++i) {
+    if (tableau.Basic(i) < num_vars) {
+      solution.x[tableau.Basic(i)] = tableau.Rhs(i);
+    }
+  }
+  // The reduced costs of the slacks, which row operations leave unchanged.
+  solution.duals.assign(objective.begin() + num_vars,
+                        objective.begin() + num_real);
+  return solution;
+}
+
+ZeroSumSolution SolveZeroSumMatrixGame(
+    const std::vector<std::vector<double>>& utilities) {
+  SPIEL_CHECK_FALSE(utilities.empty());
+  const int num_cols = utilities[0].size();
+  SPIEL_CHECK_GT(num_cols, 0);
+  double min_utility = utilities[0][0];
+  for (const std::vector<double>& row : utilities) {
+    SPIEL_CHECK_EQ(row.size(), num_cols);
+    for (double utility : row) min_utility = std::min(min_utility, utility);
+  }
+
+  // With positive utilities, the column player's strategy q, scaled by the
+  // inverse of the value v, is the y maximizing sum(y) subject to A y <= 1
+  // and y >= 0, where sum(y) = 1 / v. The row player's strategy is the dual
+  // solution scaled by v.
+  const double shift = 1 - min_utility;
+  std::vector<std::vector<double>> a = utilities;
+  for (std::vector<double>& row : a) {
+    for (double& utility : row) utility += shift;
+  }
+  const LinearProgramSolution lp = MaximizeLinearProgram(
+      a, std::vector<double>(a.size(), 1), std::vector<double>(num_cols, 1));
+  SPIEL_CHECK_TRUE(lp.status == LinearProgramStatus::kOptimal);
+  SPIEL_CHECK_GT(lp.objective, 0);
+
+  auto normalize = [](std::vector<double> weights) {
+    double total = 0;
+    for (double& weight : weights) {
+      weight = std::max(weight, 0.0);
+      total += weight;
+    }
+    for (double& weight : weights) weight /= total;
+    return weights;
+  };
+  return {1 / lp.objective - shift, normalize(lp.duals), normalize(lp.x)};
+}
+
+ZeroSumSolution SolveZeroSumMatrixGame(const matrix_game::MatrixGame& game) {
+  if (game.GetType().utility != GameType::Utility::kZeroSum) {
+    SpielFatalError("SolveZeroSumMatrixGame requires a zero-sum game.");
+  }
+  std::vector<std::vector<double>> utilities(
+      game.NumRows(), std::vector<double>(game.NumCols()));
+  for (int row = 0; row < game.NumRows(); ++row) {
+    for (int col = 0; col < game.NumCols(); ++col) {
+      utilities[row][col] = game.RowUtility(row, col);
+    }
+  }
+  return SolveZeroSumMatrixGame(utilities);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
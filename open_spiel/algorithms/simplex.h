@@ -0,0 +1,70 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SIMPLEX_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SIMPLEX_H_
+
+#include <vector>
+
+#include "open_spiel/matrix_game.h"
+
+// A dense two-phase simplex method, for the small linear programs solved at
+// each node of a search, such as the matrix games of simultaneous-move
+// games. It pivots with Bland's rule, so it cannot cycle, and it is exact up
+// to a tolerance of 1e-9; it is meant for tens of variables, not thousands.
+
+namespace open_spiel {
+namespace algorithms {
+
+enum class LinearProgramStatus {
+  kOptimal,
+  kInfeasible,
+  kUnbounded,
+};
+
+struct LinearProgramSolution {
+  LinearProgramStatus status;
+  // The following are only set when the status is kOptimal.
+  double objective = 0;
+  std::vector<double> x;
+  // The dual solution, i.e. the value of relaxing each constraint.
+  std::vector<double> duals;
+};
+
+// Maximizes c.x subject to A x <= b and x >= 0, where A has a row for each
+// constraint and a column for each variable. The bounds b may be negative.
+LinearProgramSolution MaximizeLinearProgram(
+    const std::vector<std::vector<double>>& a, const std::vector<double>& b,
+    const std::vector<double>& c);
+
+// The solution of a two-player zero-sum matrix game: its value to the row
+// player, and a maximin strategy for each player.
+struct ZeroSumSolution {
+  double value;
+  std::vector<double> row_strategy;
+  std::vector<double> col_strategy;
+};
+
+// Solves the zero-sum game where the row player gets utilities[row][col] and
+// the column player its opposite, with a single linear program.
+ZeroSumSolution SolveZeroSumMatrixGame(
+    const std::vector<std::vector<double>>& utilities);
+// The same for the row player's utilities of a MatrixGame, which must be
+// zero-sum.
+ZeroSumSolution SolveZeroSumMatrixGame(const matrix_game::MatrixGame& game);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SIMPLEX_H_
@@ -0,0 +1,88 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/simplex.h"
+
+#include <vector>
+
+#include "open_spiel/algorithms/matrix_game_utils.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kTolerance = 1e-9;
+
+void MaximizeLinearProgramTest() {
+  // max 3x + 2y s.t. x + y <= 4, x + 3y <= 6, x <= 3: at (3, 1).
+  LinearProgramSolution lp =
+      MaximizeLinearProgram({{1, 1}, {1, 3}, {1, 0}}, {4, 6, 3}, {3, 2});
+  SPIEL_CHECK_TRUE(lp.status == LinearProgramStatus::kOptimal);
+  SPIEL_CHECK_FLOAT_NEAR(lp.objective, 11, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.x[0], 3, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.x[1], 1, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.duals[0], 2, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.duals[1], 0, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.duals[2], 1, kTolerance);
+
+  // Negative bounds need the first phase: min x + y s.t. x + 2y >= 4 and
+  // 3x + y >= 6, at (8/5, 6/5).
+  lp = MaximizeLinearProgram({{-1, -2}, {-3, -1}}, {-4, -6}, {-1, -1});
+  SPIEL_CHECK_TRUE(lp.status == LinearProgramStatus::kOptimal);
+  SPIEL_CHECK_FLOAT_NEAR(lp.objective, -14.0 / 5, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.x[0], 8.0 / 5, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(lp.x[1], 6.0 / 5, kTolerance);
+
+  // An equality, as two inequalities: max x - y s.t. x + y = 1.
+  lp = MaximizeLinearProgram({{1, 1}, {-1, -1}}, {1, -1}, {1, -1});
+  SPIEL_CHECK_TRUE(lp.status == LinearProgramStatus::kOptimal);
+  SPIEL_CHECK_FLOAT_NEAR(lp.objective, 1, kTolerance);
+
+  lp = MaximizeLinearProgram({{1, 1}, {-1, -1}}, {1, -2}, {1, 1});
+  SPIEL_CHECK_TRUE(lp.status == LinearProgramStatus::kInfeasible);
+  lp = MaximizeLinearProgram({{1, -1}}, {1}, {1, 0});
+  SPIEL_CHECK_TRUE(lp.status == LinearProgramStatus::kUnbounded);
+}
+
+void SolveZeroSumMatrixGameTest() {
+  // The value and strategies of a 2x2 game without a saddle point.
+  ZeroSumSolution solution = SolveZeroSumMatrixGame({{3, -1}, {-2, 1}});
+  SPIEL_CHECK_FLOAT_NEAR(solution.value, 1.0 / 7, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(solution.row_strategy[0], 3.0 / 7, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(solution.col_strategy[0], 2.0 / 7, kTolerance);
+
+  // A saddle point, where the second column is dominated.
+  solution = SolveZeroSumMatrixGame({{2, 5}, {1, 7}, {0, 3}});
+  SPIEL_CHECK_FLOAT_NEAR(solution.value, 2, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(solution.row_strategy[0], 1, kTolerance);
+  SPIEL_CHECK_FLOAT_NEAR(solution.col_strategy[0], 1, kTolerance);
+
+  solution = SolveZeroSumMatrixGame(*LoadMatrixGame("matrix_rps"));
+  SPIEL_CHECK_FLOAT_NEAR(solution.value, 0, kTolerance);
+  for (int i = 0; i < 3; ++i) {
+    SPIEL_CHECK_FLOAT_NEAR(solution.row_strategy[i], 1.0 / 3, kTolerance);
+    SPIEL_CHECK_FLOAT_NEAR(solution.col_strategy[i], 1.0 / 3, kTolerance);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::MaximizeLinearProgramTest();
+  open_spiel::algorithms::SolveZeroSumMatrixGameTest();
+}
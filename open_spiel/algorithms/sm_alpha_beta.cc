@@ -0,0 +1,274 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sm_alpha_beta.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/simplex.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+class SMAlphaBetaSearch {
+ public:
+  SMAlphaBetaSearch(const Game& game, bool prune)
+      : prune_(prune),
+        min_utility_(game.MinUtility()),
+        max_utility_(game.MaxUtility()) {}
+
+  // The value of `state` to player 0 if it is within (alpha, beta), and
+  // otherwise a bound on it no better than the window's end it is beyond.
+  // Fills `policies` with the strategies at `state` if not null.
+  double Search(const State& state, double alpha, double beta,
+                std::vector<ActionsAndProbs>* policies) {
+    ++num_nodes_;
+    if (state.IsTerminal()) return state.PlayerReturn(0);
+    if (state.IsChanceNode()) {
+      double value = 0;
+      for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+        value += prob * Search(*state.Child(outcome), min_utility_,
+                               max_utility_, nullptr);
+      }
+      return value;
+    }
+
+    // The rows are player 0's actions and the columns player 1's, with a
+    // single placeholder for a player who does not act.
+    const bool simultaneous = state.IsSimultaneousNode();
+    const Player player = state.CurrentPlayer();
+    std::vector<Action> rows{kInvalidAction};
+    std::vector<Action> cols{kInvalidAction};
+    if (simultaneous || player == 0) rows = state.LegalActions(0);
+    if (simultaneous || player == 1) cols = state.LegalActions(1);
+    if (rows.empty()) rows = {kInvalidAction};
+    if (cols.empty()) cols = {kInvalidAction};
+    auto child = [&](int row, int col) {
+      if (simultaneous) {
+        std::unique_ptr<State> child = state.Clone();
+        child->ApplyActions({rows[row], cols[col]});
+        return child;
+      }
+      return state.Child(player == 0 ? rows[row] : cols[col]);
+    };
+
+    const int num_rows = rows.size();
+    const int num_cols = cols.size();
+    // The bounds on the values of the entries of the matrix game.
+    std::vector<std::vector<double>> lower(
+        num_rows, std::vector<double>(num_cols, min_utility_));
+    std::vector<std::vector<double>> upper(
+        num_rows, std::vector<double>(num_cols, max_utility_));
+    std::vector<bool> row_alive(num_rows, true);
+    std::vector<bool> col_alive(num_cols, true);
+    for (int i = 0; i < num_rows; ++i) {
+      for (int j = 0; j < num_cols && row_alive[i]; ++j) {
+        if (!col_alive[j]) continue;
+        if (!prune_) {
+          lower[i][j] = upper[i][j] =
+              Search(*child(i, j), min_utility_, max_utility_, nullptr);
+          continue;
+        }
+        const double row_bound =
+            RowDominationBound(lower, upper, row_alive, col_alive, i, j, alpha);
+        const double col_bound =
+            ColDominationBound(lower, upper, row_alive, col_alive, i, j, beta);
+        if (row_bound >= upper[i][j]) {
+          row_alive[i] = false;
+        } else if (col_bound <= lower[i][j]) {
+          col_alive[j] = false;
+        } else {
+          const double value =
+              Search(*child(i, j), std::max(row_bound, lower[i][j]),
+                     std::min(col_bound, upper[i][j]), nullptr);
+          if (value <= row_bound) {
+            row_alive[i] = false;
+          } else if (value >= col_bound) {
+            col_alive[j] = false;
+          } else {
+            lower[i][j] = upper[i][j] = value;
+          }
+        }
+      }
+    }
+
+    // The values of the remaining entries are all exact.
+    std::vector<int> alive_rows;
+    std::vector<int> alive_cols;
+    for (int i = 0; i < num_rows; ++i) {
+      if (row_alive[i]) alive_rows.push_back(i);
+    }
+    for (int j = 0; j < num_cols; ++j) {
+      if (col_alive[j]) alive_cols.push_back(j);
+    }
+    if (alive_rows.empty()) return alpha;
+    if (alive_cols.empty()) return beta;
+    std::vector<std::vector<double>> values(
+        alive_rows.size(), std::vector<double>(alive_cols.size()));
+    for (int i = 0; i < alive_rows.size(); ++i) {
+      for (int j = 0; j < alive_cols.size(); ++j) {
+        values[i][j] = lower[alive_rows[i]][alive_cols[j]];
+      }
+    }
+    const ZeroSumSolution solution = SolveZeroSumMatrixGame(values);
+    if (policies != nullptr) {
+      policies->assign(2, {});
+      auto fill = [](const std::vector<Action>& actions,
+                     const std::vector<int>& alive,
+                     const std::vector<double>& strategy,
+                     ActionsAndProbs* policy) {
+        if (actions[0] == kInvalidAction) return;
+        for (Action action : actions) policy->push_back({action, 0.0});
+        for (int k = 0; k < alive.size(); ++k) {
+          (*policy)[alive[k]].second = strategy[k];
+        }
+      };
+      fill(rows, alive_rows, solution.row_strategy, &(*policies)[0]);
+      fill(cols, alive_cols, solution.col_strategy, &(*policies)[1]);
+    }
+    // Removing the dominated rows and columns preserves the value clamped to
+    // the window, but not beyond it.
+    return std::clamp(solution.value, alpha, beta);
+  }
+
+  int64_t NumNodes() const { return num_nodes_; }
+
+ private:
+  // The highest value of the (i, j) entry below which row i is dominated:
+  // the best that a mixture of the other live rows' lower bounds and of
+  // alpha gets in column j, while getting at least the upper bounds of row i
+  // in the other live columns. Minus infinity if there is no such mixture.
+  double RowDominationBound(const std::vector<std::vector<double>>& lower,
+                            const std::vector<std::vector<double>>& upper,
+                            const std::vector<bool>& row_alive,
+                            const std::vector<bool>& col_alive, int i, int j,
+                            double alpha) const {
+    std::vector<int> others;
+    for (int k = 0; k < row_alive.size(); ++k) {
+      if (k != i && row_alive[k]) others.push_back(k);
+    }
+    // No mixture dominates row i if no row does in some column, which is
+    // the common case while row i's bounds are loose and spares the LP.
+    for (int l = 0; l < col_alive.size(); ++l) {
+      if (l == j || !col_alive[l]) continue;
+      double best = alpha;
+      for (int k : others) best = std::max(best, lower[k][l]);
+      if (best < upper[i][l]) return -kInfinity;
+    }
+    const int num_vars = others.size() + 1;  // The last is alpha.
+    std::vector<std::vector<double>> a;
+    std::vector<double> b;
+    for (int l = 0; l < col_alive.size(); ++l) {
+      if (l == j || !col_alive[l]) continue;
+      std::vector<double>& row = a.emplace_back(num_vars);
+      for (int k = 0; k < others.size(); ++k) row[k] = -lower[others[k]][l];
+      row.back() = -alpha;
+      b.push_back(-upper[i][l]);
+    }
+    a.emplace_back(num_vars, 1);
+    b.push_back(1);
+    a.emplace_back(num_vars, -1);
+    b.push_back(-1);
+    std::vector<double> c(num_vars);
+    for (int k = 0; k < others.size(); ++k) c[k] = lower[others[k]][j];
+    c.back() = alpha;
+    const LinearProgramSolution lp = MaximizeLinearProgram(a, b, c);
+    if (lp.status != LinearProgramStatus::kOptimal) return -kInfinity;
+    return lp.objective;
+  }
+
+  // The lowest value of the (i, j) entry above which column j is dominated,
+  // as above for the column player with the upper bounds and beta.
+  double ColDominationBound(const std::vector<std::vector<double>>& lower,
+                            const std::vector<std::vector<double>>& upper,
+                            const std::vector<bool>& row_alive,
+                            const std::vector<bool>& col_alive, int i, int j,
+                            double beta) const {
+    std::vector<int> others;
+    for (int l = 0; l < col_alive.size(); ++l) {
+      if (l != j && col_alive[l]) others.push_back(l);
+    }
+    for (int k = 0; k < row_alive.size(); ++k) {
+      if (k == i || !row_alive[k]) continue;
+      double best = beta;
+      for (int l : others) best = std::min(best, upper[k][l]);
+      if (best > lower[k][j]) return kInfinity;
+    }
+    const int num_vars = others.size() + 1;  // The last is beta.
+    std::vector<std::vector<double>> a;
+    std::vector<double> b;
+    for (int k = 0; k < row_alive.size(); ++k) {
+      if (k == i || !row_alive[k]) continue;
+      std::vector<double>& row = a.emplace_back(num_vars);
+      for (int l = 0; l < others.size(); ++l) row[l] = upper[k][others[l]];
+      row.back() = beta;
+      b.push_back(lower[k][j]);
+    }
+    a.emplace_back(num_vars, 1);
+    b.push_back(1);
+    a.emplace_back(num_vars, -1);
+    b.push_back(-1);
+    std::vector<double> c(num_vars);
+    for (int l = 0; l < others.size(); ++l) c[l] = -upper[i][others[l]];
+    c.back() = -beta;
+    const LinearProgramSolution lp = MaximizeLinearProgram(a, b, c);
+    if (lp.status != LinearProgramStatus::kOptimal) return kInfinity;
+    return -lp.objective;
+  }
+
+  const bool prune_;
+  const double min_utility_;
+  const double max_utility_;
+  int64_t num_nodes_ = 0;
+};
+
+}  // namespace
+
+SMAlphaBetaResult SimultaneousAlphaBetaSearch(const Game& game,
+                                              const State* state, bool prune) {
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  const GameType::Utility utility = game.GetType().utility;
+  if (utility != GameType::Utility::kZeroSum &&
+      utility != GameType::Utility::kConstantSum) {
+    SpielFatalError("SimultaneousAlphaBetaSearch requires a zero-sum game.");
+  }
+  std::unique_ptr<State> initial_state;
+  if (state == nullptr) {
+    initial_state = game.NewInitialState();
+    state = initial_state.get();
+  }
+  SPIEL_CHECK_FALSE(state->IsChanceNode());
+
+  // A window strictly wider than the utilities, so that no action is
+  // dominated by the window at the root and the strategies are complete.
+  SMAlphaBetaSearch search(game, prune);
+  SMAlphaBetaResult result;
+  result.policies.resize(2);
+  result.value = search.Search(*state, game.MinUtility() - 1,
+                               game.MaxUtility() + 1, &result.policies);
+  result.num_nodes = search.NumNodes();
+  return result;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
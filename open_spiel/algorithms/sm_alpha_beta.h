@@ -0,0 +1,66 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SM_ALPHA_BETA_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SM_ALPHA_BETA_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Backward induction for two-player zero-sum games with simultaneous moves,
+// such as goofspiel and oshi_zumo, which are perfect-information but for the
+// simultaneity of the moves. The value of a simultaneous node is that of the
+// matrix game of its children's values, solved with a linear program (see
+// simplex.h); a node where a single player acts is a max or min node, and a
+// chance node is valued by expectation. This solves such games exactly.
+//
+// With pruning, this is simultaneous move alpha-beta (SMAB): each node is
+// searched with a window of values, and the bounds already known on the
+// entries of its matrix game give, by a linear program, the value below which
+// a row is dominated by a mixture of the other rows and of the window's lower
+// end, and above which a column is dominated. Each child is searched with
+// the window between these values, and a failing child removes its row or
+// column without solving it exactly. At a node where a single player acts,
+// this reduces to alpha-beta.
+//
+// Reference: Saffidine, Finnsson, and Buro, Alpha-Beta Pruning for Games with
+// Simultaneous Moves, AAAI 2012.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct SMAlphaBetaResult {
+  // The value of the state to player 0.
+  double value;
+  // A maximin strategy for each player at the state, over their legal
+  // actions, or empty for a player who does not act there.
+  std::vector<ActionsAndProbs> policies;
+  // The number of states searched.
+  int64_t num_nodes;
+};
+
+// Solves the game from `state`, or from its initial state if null, which must
+// not be a chance node. Without pruning, this solves the matrix game of every
+// simultaneous node in full.
+SMAlphaBetaResult SimultaneousAlphaBetaSearch(const Game& game,
+                                              const State* state = nullptr,
+                                              bool prune = true);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SM_ALPHA_BETA_H_
@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sm_alpha_beta.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr double kTolerance = 1e-6;
+
+// The value of a state to player 0, by expectation at chance nodes.
+double Value(const Game& game, const State& state) {
+  if (!state.IsChanceNode()) {
+    return SimultaneousAlphaBetaSearch(game, &state, /*prune=*/false).value;
+  }
+  double value = 0;
+  for (const auto& [outcome, prob] : state.ChanceOutcomes()) {
+    value += prob * Value(game, *state.Child(outcome));
+  }
+  return value;
+}
+
+void MatrixGameTest() {
+  for (const std::string name : {"matrix_rps", "matrix_mp"}) {
+    std::shared_ptr<const Game> game = LoadGame(name);
+    SMAlphaBetaResult result = SimultaneousAlphaBetaSearch(*game);
+    SPIEL_CHECK_FLOAT_NEAR(result.value, 0, kTolerance);
+    for (const ActionsAndProbs& policy : result.policies) {
+      for (const auto& [action, prob] : policy) {
+        SPIEL_CHECK_FLOAT_NEAR(prob, 1.0 / policy.size(), kTolerance);
+      }
+    }
+  }
+}
+
+// Checks that pruning does not change the value, and that the strategies
+// guarantee it against every action of the opponent.
+void SolvesExactly(const std::string& game_string,
+                   const std::vector<Action>& joint_action) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  std::unique_ptr<State> state = game->NewInitialState();
+  if (state->IsChanceNode()) state->ApplyAction(state->LegalActions()[0]);
+  if (!joint_action.empty()) state->ApplyActions(joint_action);
+  const SMAlphaBetaResult full =
+      SimultaneousAlphaBetaSearch(*game, state.get(), /*prune=*/false);
+  const SMAlphaBetaResult pruned =
+      SimultaneousAlphaBetaSearch(*game, state.get());
+  SPIEL_CHECK_FLOAT_NEAR(pruned.value, full.value, kTolerance);
+  SPIEL_CHECK_LT(pruned.num_nodes, full.num_nodes);
+
+  const ActionsAndProbs& row_policy = pruned.policies[0];
+  const ActionsAndProbs& col_policy = pruned.policies[1];
+  std::vector<std::vector<double>> values;
+  for (const auto& [row, row_prob] : row_policy) {
+    std::vector<double>& row_values = values.emplace_back();
+    for (const auto& [col, col_prob] : col_policy) {
+      std::unique_ptr<State> child = state->Clone();
+      child->ApplyActions({row, col});
+      row_values.push_back(Value(*game, *child));
+    }
+  }
+  for (int j = 0; j < col_policy.size(); ++j) {
+    double value = 0;
+    for (int i = 0; i < row_policy.size(); ++i) {
+      value += row_policy[i].second * values[i][j];
+    }
+    SPIEL_CHECK_GE(value, pruned.value - kTolerance);
+  }
+  for (int i = 0; i < row_policy.size(); ++i) {
+    double value = 0;
+    for (int j = 0; j < col_policy.size(); ++j) {
+      value += col_policy[j].second * values[i][j];
+    }
+    SPIEL_CHECK_LE(value, pruned.value + kTolerance);
+  }
+}
+
+void SequentialGameTest() {
+  // A turn-based game is solved as by alpha-beta.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : {4, 0, 8}) state->ApplyAction(action);
+  const SMAlphaBetaResult result =
+      SimultaneousAlphaBetaSearch(*game, state.get());
+  SPIEL_CHECK_FLOAT_NEAR(
+      result.value,
+      AlphaBetaSearch(*game, state.get(), {}, -1, 0).first, kTolerance);
+  SPIEL_CHECK_TRUE(result.policies[0].empty());
+  SPIEL_CHECK_FALSE(result.policies[1].empty());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::MatrixGameTest();
+  open_spiel::algorithms::SolvesExactly(
+      "goofspiel(num_cards=4,points_order=descending)", {});
+  open_spiel::algorithms::SolvesExactly(
+      "goofspiel(num_cards=4,points_order=descending)", {3, 1});
+  open_spiel::algorithms::SolvesExactly(
+      "goofspiel(num_cards=4,points_order=random)", {});
+  open_spiel::algorithms::SolvesExactly(
+      "oshi_zumo(coins=5,size=1,horizon=6)", {});
+  open_spiel::algorithms::SolvesExactly(
+      "oshi_zumo(coins=5,size=1,horizon=6)", {2, 1});
+  open_spiel::algorithms::SequentialGameTest();
+}
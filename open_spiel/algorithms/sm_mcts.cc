@@ -0,0 +1,272 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sm_mcts.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+SMMCTSBot::SMMCTSBot(const Game& game, Evaluator* evaluator, Player player_id,
+                     int max_simulations, int seed, SMMCTSSelection selection,
+                     double uct_c, double exploration)
+    : evaluator_(evaluator),
+      player_id_(player_id),
+      max_simulations_(max_simulations),
+      selection_(selection),
+      uct_c_(uct_c),
+      exploration_(exploration),
+      min_utility_(game.MinUtility()),
+      max_utility_(game.MaxUtility()),
+      rng_(seed) {
+  SPIEL_CHECK_GE(player_id, 0);
+  SPIEL_CHECK_LT(player_id, game.NumPlayers());
+  SPIEL_CHECK_GT(max_simulations, 0);
+  SPIEL_CHECK_GT(exploration, 0);
+  SPIEL_CHECK_LE(exploration, 1);
+  SPIEL_CHECK_LT(min_utility_, max_utility_);
+}
+
+void SMMCTSBot::InitNode(const State& state, SMMCTSNode* node) const {
+  if (state.IsChanceNode()) return;
+  auto add_player = [node](Player player, const std::vector<Action>& actions) {
+    node->players.push_back(player);
+    node->stats.emplace_back(actions.size());
+    for (int i = 0; i < actions.size(); ++i) {
+      node->stats.back()[i].action = actions[i];
+    }
+  };
+  if (state.IsSimultaneousNode()) {
+    for (Player player = 0; player < state.NumPlayers(); ++player) {
+      std::vector<Action> actions = state.LegalActions(player);
+      if (!actions.empty()) add_player(player, actions);
+    }
+  } else {
+    add_player(state.CurrentPlayer(), state.LegalActions());
+  }
+}
+
+std::vector<double> SMMCTSBot::SelectionPolicy(const SMMCTSNode& node,
+                                               int index) const {
+  const std::vector<SMMCTSActionStats>& stats = node.stats[index];
+  const int num_actions = stats.size();
+  std::vector<double> policy(num_actions);
+  double total = 0;
+  if (selection_ == SMMCTSSelection::kExp3) {
+    // Softmax of the cumulative rewards with temperature K / gamma, shifted
+    // by their maximum, which leaves it unchanged.
+    double max_cumulative = -std::numeric_limits<double>::infinity();
+    for (const SMMCTSActionStats& action : stats) {
+      max_cumulative = std::max(max_cumulative, action.cumulative);
+    }
+    const double eta = exploration_ / num_actions;
+    for (int i = 0; i < num_actions; ++i) {
+      policy[i] = std::exp(eta * (stats[i].cumulative - max_cumulative));
+      total += policy[i];
+    }
+  } else {
+    for (int i = 0; i < num_actions; ++i) {
+      policy[i] = std::max(stats[i].cumulative, 0.0);
+      total += policy[i];
+    }
+  }
+  for (int i = 0; i < num_actions; ++i) {
+    const double exploited = total > 0 ? policy[i] / total : 1.0 / num_actions;
+    policy[i] = (1 - exploration_) * exploited + exploration_ / num_actions;
+  }
+  return policy;
+}
+
+int SMMCTSBot::SelectAction(SMMCTSNode* node, int index,
+                            double* probability) {
+  std::vector<SMMCTSActionStats>& stats = node->stats[index];
+  if (selection_ == SMMCTSSelection::kDecoupledUCT) {
+    // The unexplored actions first, uniformly at random, then the best by
+    // UCT.
+    *probability = 1;
+    int chosen = -1;
+    int num_unexplored = 0;
+    double best_value = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < stats.size(); ++i) {
+      if (stats[i].explore_count == 0) {
+        if (UniformInt(rng_, ++num_unexplored) == 0) chosen = i;
+      } else if (num_unexplored == 0) {
+        const double value =
+            stats[i].total_reward / stats[i].explore_count +
+            uct_c_ * std::sqrt(std::log(node->explore_count) /
+                               stats[i].explore_count);
+        if (value > best_value) {
+          best_value = value;
+          chosen = i;
+        }
+      }
+    }
+    return chosen;
+  }
+  const std::vector<double> policy = SelectionPolicy(*node, index);
+  if (selection_ == SMMCTSSelection::kRegretMatching) {
+    for (int i = 0; i < stats.size(); ++i) stats[i].strategy_sum += policy[i];
+  }
+  double z = UniformDouble(rng_);
+  int chosen = 0;
+  while (chosen + 1 < policy.size() && z >= policy[chosen]) {
+    z -= policy[chosen++];
+  }
+  *probability = policy[chosen];
+  return chosen;
+}
+
+void SMMCTSBot::Update(SMMCTSNode* node, int index, int choice,
+                       double probability, double value) {
+  std::vector<SMMCTSActionStats>& stats = node->stats[index];
+  ++stats[choice].explore_count;
+  stats[choice].total_reward += value;
+  const double reward =
+      (value - min_utility_) / (max_utility_ - min_utility_);
+  if (selection_ == SMMCTSSelection::kExp3) {
+    stats[choice].cumulative += reward / probability;
+  } else if (selection_ == SMMCTSSelection::kRegretMatching) {
+    // The sampled regret of each action against the one played: its
+    // importance-weighted reward estimate, less the reward received.
+    for (SMMCTSActionStats& action : stats) action.cumulative -= reward;
+    stats[choice].cumulative += reward / probability;
+  }
+}
+
+void SMMCTSBot::Simulate(std::unique_ptr<State> state, SMMCTSNode* root) {
+  struct Visit {
+    SMMCTSNode* node;
+    std::vector<int> choices;
+    std::vector<double> probabilities;
+  };
+  std::vector<Visit> visit_path;
+  std::vector<double> returns;
+  std::vector<Action> joint_action;
+  SMMCTSNode* node = root;
+  while (!state->IsTerminal()) {
+    int64_t key;
+    if (state->IsChanceNode()) {
+      key = state->SampleChanceOutcome(rng_).first;
+      state->ApplyAction(key);
+    } else {
+      ++node->explore_count;
+      Visit& visit = visit_path.emplace_back();
+      visit.node = node;
+      key = 0;
+      int64_t stride = 1;
+      for (int i = 0; i < node->players.size(); ++i) {
+        double probability;
+        const int choice = SelectAction(node, i, &probability);
+        visit.choices.push_back(choice);
+        visit.probabilities.push_back(probability);
+        key += choice * stride;
+        stride *= node->stats[i].size();
+      }
+      if (state->IsSimultaneousNode()) {
+        joint_action.assign(state->NumPlayers(), kInvalidAction);
+        for (int i = 0; i < node->players.size(); ++i) {
+          joint_action[node->players[i]] =
+              node->stats[i][visit.choices[i]].action;
+        }
+        state->ApplyActions(joint_action);
+      } else {
+        state->ApplyAction(node->stats[0][visit.choices[0]].action);
+      }
+    }
+    auto [it, inserted] = node->children.try_emplace(key);
+    if (inserted) {
+      // A new leaf, which is evaluated rather than explored further.
+      it->second = std::make_unique<SMMCTSNode>();
+      ++num_nodes_;
+      if (!state->IsTerminal()) {
+        InitNode(*state, it->second.get());
+        returns = evaluator_->Evaluate(*state);
+      }
+      break;
+    }
+    node = it->second.get();
+  }
+  if (returns.empty()) returns = state->Returns();
+  for (const Visit& visit : visit_path) {
+    for (int i = 0; i < visit.choices.size(); ++i) {
+      Update(visit.node, i, visit.choices[i], visit.probabilities[i],
+             returns[visit.node->players[i]]);
+    }
+  }
+}
+
+ActionsAndProbs SMMCTSBot::FinalPolicy(const SMMCTSNode& root) const {
+  const auto it =
+      std::find(root.players.begin(), root.players.end(), player_id_);
+  SPIEL_CHECK_TRUE(it != root.players.end());
+  const std::vector<SMMCTSActionStats>& stats =
+      root.stats[it - root.players.begin()];
+  std::vector<double> weights(stats.size());
+  for (int i = 0; i < stats.size(); ++i) {
+    switch (selection_) {
+      case SMMCTSSelection::kDecoupledUCT:
+      case SMMCTSSelection::kExp3:
+        weights[i] = stats[i].explore_count;
+        break;
+      case SMMCTSSelection::kRegretMatching:
+        weights[i] = stats[i].strategy_sum;
+        break;
+    }
+  }
+  if (selection_ == SMMCTSSelection::kDecoupledUCT) {
+    const int best = std::max_element(weights.begin(), weights.end()) -
+                     weights.begin();
+    for (int i = 0; i < weights.size(); ++i) weights[i] = i == best;
+  }
+  double total = 0;
+  for (double weight : weights) total += weight;
+  ActionsAndProbs policy;
+  policy.reserve(stats.size());
+  for (int i = 0; i < stats.size(); ++i) {
+    policy.push_back({stats[i].action, total > 0 ? weights[i] / total
+                                                 : 1.0 / stats.size()});
+  }
+  return policy;
+}
+
+ActionsAndProbs SMMCTSBot::RunSearch(const State& state) {
+  SPIEL_CHECK_FALSE(state.IsTerminal());
+  SPIEL_CHECK_FALSE(state.IsChanceNode());
+  SMMCTSNode root;
+  InitNode(state, &root);
+  num_nodes_ = 1;
+  for (int i = 0; i < max_simulations_; ++i) Simulate(state.Clone(), &root);
+  return FinalPolicy(root);
+}
+
+std::pair<ActionsAndProbs, Action> SMMCTSBot::StepWithPolicy(
+    const State& state) {
+  ActionsAndProbs policy = RunSearch(state);
+  const Action action = SampleAction(policy, UniformDouble(rng_)).first;
+  return {std::move(policy), action};
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,164 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SM_MCTS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SM_MCTS_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/random.h"
+
+// Simultaneous-move Monte Carlo Tree Search (SM-MCTS).
+//
+// MCTSBot only searches sequential games, so a simultaneous-move game has to
+// be wrapped in a TurnBasedSimultaneousGame, which doubles the depth of the
+// tree and lets the second player of each turn search as if they knew the
+// first player's action. SM-MCTS instead searches the simultaneous game
+// directly: at each node, every acting player selects their own action with
+// their own statistics (the selection is decoupled), the joint action leads
+// to the child, and each player's return is backed up into their own
+// statistics. Nodes where a single player acts, and chance nodes, are
+// handled as in MCTS.
+//
+// Each simulation adds one node at the leaf it reaches, which is valued by
+// the evaluator, e.g. a RandomRolloutEvaluator. The tree is built again at
+// each step.
+//
+// The selection of each player at a node is one of:
+// - kDecoupledUCT: UCT on the player's own actions and returns, playing each
+//   action once first, with exploration constant uct_c as in MCTSBot. The
+//   final policy is all on the most visited action.
+// - kExp3: the Exp3 bandit, with exploration rate `exploration`. The final
+//   policy is the normalized visit counts.
+// - kRegretMatching: regret matching on sampled rewards, mixed with uniform
+//   exploration at rate `exploration`. The final policy is the average of
+//   the strategies played.
+// The rewards of Exp3 and regret matching are the returns scaled to [0, 1]
+// by the game's utility range. Unlike decoupled UCT, both are Hannan
+// consistent, so that their final policies approach a Nash equilibrium in
+// two-player zero-sum games with enough simulations.
+//
+// References:
+// - Lanctot, Lisy, and Winands, Monte Carlo Tree Search in Simultaneous Move
+//   Games with Applications to Goofspiel, 2013.
+// - Lisy, Kovarik, Lanctot, and Bosansky, Convergence of Monte Carlo Tree
+//   Search in Simultaneous Move Games, 2013. https://arxiv.org/abs/1310.8613
+
+namespace open_spiel {
+namespace algorithms {
+
+enum class SMMCTSSelection {
+  kDecoupledUCT,
+  kExp3,
+  kRegretMatching,
+};
+
+// The statistics of an action of one of the players acting at a node.
+struct SMMCTSActionStats {
+  Action action = kInvalidAction;
+  int explore_count = 0;
+  double total_reward = 0;  // The player's total return after this action.
+  // Exp3: the cumulative importance-weighted reward. Regret matching: the
+  // cumulative regret.
+  double cumulative = 0;
+  double strategy_sum = 0;  // Regret matching: the sum of the strategies.
+};
+
+// A node of the search tree, i.e. a history.
+struct SMMCTSNode {
+  int explore_count = 0;
+  // The players acting here, and their actions' statistics, unless this is a
+  // chance node.
+  std::vector<Player> players;
+  std::vector<std::vector<SMMCTSActionStats>> stats;
+  // The children by (joint) action. The joint action of the choices of the
+  // acting players, say c_i out of n_i actions, is sum_i c_i * prod_{j<i} n_j.
+  absl::flat_hash_map<int64_t, std::unique_ptr<SMMCTSNode>> children;
+};
+
+// A SpielBot that plays player_id with SM-MCTS. The game may have
+// simultaneous, sequential and chance nodes, and must have perfect
+// information but for the simultaneity of the moves.
+class SMMCTSBot : public Bot {
+ public:
+  SMMCTSBot(const Game& game, Evaluator* evaluator, Player player_id,
+            int max_simulations, int seed,
+            SMMCTSSelection selection = SMMCTSSelection::kDecoupledUCT,
+            double uct_c = 2, double exploration = 0.1);
+
+  void Restart() override {}
+  void RestartAt(const State& state) override {}
+  Action Step(const State& state) override {
+    return StepWithPolicy(state).second;
+  }
+  bool ProvidesPolicy() override { return true; }
+  ActionsAndProbs GetPolicy(const State& state) override {
+    return RunSearch(state);
+  }
+  std::pair<ActionsAndProbs, Action> StepWithPolicy(
+      const State& state) override;
+
+  // Runs the search from `state`, where player_id acts, and returns the final
+  // policy of player_id at the root.
+  ActionsAndProbs RunSearch(const State& state);
+
+  // The number of nodes of the last search.
+  int NumNodes() const { return num_nodes_; }
+
+ private:
+  // Fills the acting players and their statistics of a new node.
+  void InitNode(const State& state, SMMCTSNode* node) const;
+
+  // Returns the index of the action selected by the index-th player acting
+  // at a node, and sets `probability` to the probability it had.
+  int SelectAction(SMMCTSNode* node, int index, double* probability);
+
+  // Updates the statistics of the index-th player at a node with the
+  // player's return after selecting `choice` with `probability`.
+  void Update(SMMCTSNode* node, int index, int choice, double probability,
+              double value);
+
+  // Returns the probabilities with which Exp3 or regret matching select the
+  // actions of the index-th player at a node.
+  std::vector<double> SelectionPolicy(const SMMCTSNode& node, int index) const;
+
+  // Runs a simulation from `state`, a clone of the root, and backs it up.
+  void Simulate(std::unique_ptr<State> state, SMMCTSNode* root);
+
+  ActionsAndProbs FinalPolicy(const SMMCTSNode& root) const;
+
+  Evaluator* evaluator_;
+  const Player player_id_;
+  const int max_simulations_;
+  const SMMCTSSelection selection_;
+  const double uct_c_;
+  const double exploration_;
+  const double min_utility_;
+  const double max_utility_;
+  Xoshiro256PlusPlus rng_;
+  int num_nodes_ = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SM_MCTS_H_
@@ -0,0 +1,140 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sm_mcts.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/algorithms/evaluate_bots.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr SMMCTSSelection kSelections[] = {SMMCTSSelection::kDecoupledUCT,
+                                           SMMCTSSelection::kExp3,
+                                           SMMCTSSelection::kRegretMatching};
+
+void CheckPolicy(const State& state, Player player,
+                 const ActionsAndProbs& policy) {
+  SPIEL_CHECK_EQ(policy.size(), state.LegalActions(player).size());
+  double total = 0;
+  for (const auto& [action, prob] : policy) {
+    SPIEL_CHECK_TRUE(
+        absl::c_linear_search(state.LegalActions(player), action));
+    SPIEL_CHECK_GE(prob, 0);
+    total += prob;
+  }
+  SPIEL_CHECK_FLOAT_NEAR(total, 1.0, 1e-9);
+}
+
+void PlaysSimultaneousGames() {
+  const std::vector<std::string> names = {
+      "goofspiel(num_cards=4)", "oshi_zumo(coins=10,horizon=20)",
+      "markov_soccer(horizon=20)", "laser_tag(horizon=10)"};
+  for (const std::string& name : names) {
+    std::shared_ptr<const Game> game = LoadGame(name);
+    for (SMMCTSSelection selection : kSelections) {
+      RandomRolloutEvaluator evaluator(1, 0);
+      std::vector<std::unique_ptr<SMMCTSBot>> bots;
+      std::vector<Bot*> bot_ptrs;
+      for (Player player = 0; player < game->NumPlayers(); ++player) {
+        bots.push_back(std::make_unique<SMMCTSBot>(
+            *game, &evaluator, player, /*max_simulations=*/50,
+            /*seed=*/player, selection));
+        bot_ptrs.push_back(bots.back().get());
+      }
+      std::mt19937 rng(0);
+      std::unique_ptr<State> state = game->NewInitialState();
+      while (state->IsChanceNode()) {
+        state->ApplyAction(SampleAction(state->ChanceOutcomes(), rng).first);
+      }
+      for (Player player = 0; player < game->NumPlayers(); ++player) {
+        if (state->LegalActions(player).empty()) continue;
+        CheckPolicy(*state, player, bots[player]->GetPolicy(*state));
+        SPIEL_CHECK_GT(bots[player]->NumNodes(), 1);
+      }
+      EvaluateBots(state.get(), bot_ptrs, /*seed=*/1);
+      SPIEL_CHECK_TRUE(state->IsTerminal());
+    }
+  }
+}
+
+void ApproachesEquilibriumOfRockPaperScissors() {
+  std::shared_ptr<const Game> game = LoadGame("matrix_rps");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (SMMCTSSelection selection :
+       {SMMCTSSelection::kExp3, SMMCTSSelection::kRegretMatching}) {
+    RandomRolloutEvaluator evaluator(1, 0);
+    SMMCTSBot bot(*game, &evaluator, /*player_id=*/0,
+                  /*max_simulations=*/20000, /*seed=*/2, selection);
+    const ActionsAndProbs policy = bot.GetPolicy(*state);
+    CheckPolicy(*state, 0, policy);
+    for (const auto& [action, prob] : policy) {
+      SPIEL_CHECK_FLOAT_NEAR(prob, 1.0 / 3, 0.1);
+    }
+  }
+}
+
+void DefectsInPrisonersDilemma() {
+  std::shared_ptr<const Game> game = LoadGame("matrix_pd");
+  std::unique_ptr<State> state = game->NewInitialState();
+  // Not decoupled UCT, whose players explore in lockstep in a symmetric game,
+  // and so only try defecting when the other one does too.
+  for (SMMCTSSelection selection :
+       {SMMCTSSelection::kExp3, SMMCTSSelection::kRegretMatching}) {
+    RandomRolloutEvaluator evaluator(1, 0);
+    for (Player player : {0, 1}) {
+      SMMCTSBot bot(*game, &evaluator, player, /*max_simulations=*/1000,
+                    /*seed=*/3, selection);
+      // The second action, Defect, dominates.
+      const ActionsAndProbs policy = bot.GetPolicy(*state);
+      SPIEL_CHECK_GT(policy[1].second, 0.8);
+    }
+  }
+}
+
+void BeatsRandomAtGoofspiel() {
+  std::shared_ptr<const Game> game = LoadGame("goofspiel(num_cards=5)");
+  RandomRolloutEvaluator evaluator(2, 0);
+  SMMCTSBot bot(*game, &evaluator, /*player_id=*/0, /*max_simulations=*/200,
+                /*seed=*/4);
+  std::unique_ptr<Bot> random_bot = MakeUniformRandomBot(1, 5);
+  constexpr int kNumGames = 20;
+  double total = 0;
+  for (int i = 0; i < kNumGames; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    total += EvaluateBots(state.get(), {&bot, random_bot.get()}, i)[0];
+  }
+  SPIEL_CHECK_GT(total / kNumGames, 0.3);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::PlaysSimultaneousGames();
+  open_spiel::algorithms::ApproachesEquilibriumOfRockPaperScissors();
+  open_spiel::algorithms::DefectsInPrisonersDilemma();
+  open_spiel::algorithms::BeatsRandomAtGoofspiel();
+}
@@ -15,7 +15,6 @@
 #include "open_spiel/algorithms/state_distribution.h"
 
 #include <algorithm>
-#include <functional>
 #include <map>
 #include <memory>
 #include <numeric>
@@ -26,6 +25,7 @@
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/thread_pool.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -64,7 +64,7 @@ HistoryDistribution GetStateDistribution(const State& state,
   // Generate the (info state, action) map for the current player using
   // the state's history.
   std::map<std::string, Action> infostate_action_map;
-  std::vector<Action> history = state.History();
+  const std::vector<Action>& history = state.History();
   std::unique_ptr<State> tmp_state = game->NewInitialState();
   for (Action action : history) {
     if (tmp_state->CurrentPlayer() == player) {
@@ -155,9 +155,61 @@ HistoryDistribution GetStateDistribution(const State& state,
   return {std::move(final_states), Normalize(final_probs)};
 }
 
+namespace {
+
+// Multiplies `prob` by the probability of `action` at `parent`, as seen by
+// player_id, and returns false if `action` cannot follow `parent`.
+bool UpdateProb(const State& parent, Action action,
+                const Policy* opponent_policy, int player_id, double* prob) {
+  switch (parent.GetType()) {
+    case StateType::kChance: {
+      open_spiel::ActionsAndProbs outcomes = parent.ChanceOutcomes();
+      double action_prob = GetProb(outcomes, action);
+
+      // If we don't find the chance outcome, then the state we're in is
+      // impossible.
+      if (action_prob == -1) return false;
+      SPIEL_CHECK_PROB(action_prob);
+      *prob *= action_prob;
+      return true;
+    }
+    case StateType::kDecision: {
+      if (parent.CurrentPlayer() == player_id) return true;
+      open_spiel::ActionsAndProbs policy =
+          opponent_policy->GetStatePolicy(parent);
+      double action_prob = GetProb(policy, action);
+      SPIEL_CHECK_PROB(action_prob);
+      *prob *= action_prob;
+      return true;
+    }
+    case StateType::kTerminal:
+      ABSL_FALLTHROUGH_INTENDED;
+    default:
+      SpielFatalError("Unknown state type.");
+  }
+}
+
+// Returns whether history i is kept after an update: if it is possible and,
+// unless none has, if it has a non-zero probability.
+std::vector<bool> KeptHistories(const std::vector<char>& possible,
+                                const std::vector<double>& probs) {
+  bool any_positive = false;
+  for (int i = 0; i < probs.size(); ++i) {
+    if (possible[i] && probs[i] > 0) any_positive = true;
+  }
+  std::vector<bool> kept(probs.size());
+  for (int i = 0; i < probs.size(); ++i) {
+    kept[i] = possible[i] && (!any_positive || probs[i] > 0);
+  }
+  return kept;
+}
+
+}  // namespace
+
 std::unique_ptr<HistoryDistribution> UpdateIncrementalStateDistribution(
     const State& state, const Policy* opponent_policy, int player_id,
-    std::unique_ptr<HistoryDistribution> previous) {
+    std::unique_ptr<HistoryDistribution> previous, int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
   if (previous == nullptr) previous = std::make_unique<HistoryDistribution>();
   if (previous->first.empty()) {
     // If the previous pair is empty, then we have to do a BFS to find all
@@ -166,48 +218,99 @@ std::unique_ptr<HistoryDistribution> UpdateIncrementalStateDistribution(
         GetStateDistribution(state, opponent_policy));
   }
   // The current state must be one action ahead of the dist ones.
-  const std::vector<Action> history = state.History();
-  Action action = history.back();
-  for (int i = 0; i < previous->first.size(); ++i) {
-    std::unique_ptr<State>& parent = previous->first[i];
-    double& prob = previous->second[i];
-    if (Near(prob, 0.)) continue;
-    SPIEL_CHECK_EQ(history.size(), parent->History().size() + 1);
-    switch (parent->GetType()) {
-      case StateType::kChance: {
-        open_spiel::ActionsAndProbs outcomes = parent->ChanceOutcomes();
-        double action_prob = GetProb(outcomes, action);
-
-        // If we don't find the chance outcome, then the state we're in is
-        // impossible, so we set it to zero.
-        if (action_prob == -1) {
-          prob = 0;
-          continue;
-        }
-        SPIEL_CHECK_PROB(action_prob);
-        prob *= action_prob;
-        break;
-      }
-      case StateType::kDecision: {
-        if (parent->CurrentPlayer() == player_id) break;
-        open_spiel::ActionsAndProbs policy =
-            opponent_policy->GetStatePolicy(*parent);
-        double action_prob = GetProb(policy, action);
-        SPIEL_CHECK_PROB(action_prob);
-        prob *= action_prob;
-        break;
-      }
-      case StateType::kTerminal:
-        ABSL_FALLTHROUGH_INTENDED;
-      default:
-        SpielFatalError("Unknown state type.");
+  const std::vector<Action>& history = state.History();
+  const Action action = history.back();
+  std::vector<std::unique_ptr<State>>& states = previous->first;
+  std::vector<double>& probs = previous->second;
+  // Not a vector<bool>, which the threads could not write concurrently.
+  std::vector<char> possible(states.size(), false);
+  auto update = [&](int i) {
+    SPIEL_CHECK_EQ(history.size(), states[i]->History().size() + 1);
+    if (UpdateProb(*states[i], action, opponent_policy, player_id,
+                   &probs[i])) {
+      states[i]->ApplyAction(action);
+      possible[i] = true;
     }
-    if (prob == 0) continue;
-    parent->ApplyAction(action);
+  };
+  ThreadPool::Default().ParallelFor(0, states.size(), update, /*grain_size=*/1,
+                                    num_threads);
+  std::vector<bool> kept = KeptHistories(possible, probs);
+  int num_kept = 0;
+  for (int i = 0; i < states.size(); ++i) {
+    if (!kept[i]) continue;
+    states[num_kept] = std::move(states[i]);
+    probs[num_kept] = probs[i];
+    ++num_kept;
   }
-  previous->second = Normalize(previous->second);
+  states.resize(num_kept);
+  probs.resize(num_kept);
+  probs = Normalize(probs);
   return previous;
 }
 
+CompactHistoryDistribution::CompactHistoryDistribution(
+    const HistoryDistribution& distribution) {
+  const auto& [states, probs] = distribution;
+  SPIEL_CHECK_FALSE(states.empty());
+  SPIEL_CHECK_EQ(states.size(), probs.size());
+  game_ = states[0]->GetGame();
+  history_length_ = states[0]->History().size();
+  std::vector<bool> kept =
+      KeptHistories(std::vector<char>(states.size(), true), probs);
+  for (int i = 0; i < states.size(); ++i) {
+    if (!kept[i]) continue;
+    const std::vector<Action>& history = states[i]->History();
+    SPIEL_CHECK_EQ(history.size(), history_length_);
+    actions_.insert(actions_.end(), history.begin(), history.end());
+    probs_.push_back(probs[i]);
+  }
+  probs_ = Normalize(probs_);
+}
+
+std::unique_ptr<State> CompactHistoryDistribution::GetState(int i) const {
+  std::unique_ptr<State> state = game_->NewInitialState();
+  for (Action action : History(i)) state->ApplyAction(action);
+  return state;
+}
+
+HistoryDistribution CompactHistoryDistribution::ToHistoryDistribution() const {
+  HistoryDistribution distribution;
+  for (int i = 0; i < NumHistories(); ++i) {
+    distribution.first.push_back(GetState(i));
+  }
+  distribution.second = probs_;
+  return distribution;
+}
+
+void CompactHistoryDistribution::Update(const State& state,
+                                        const Policy* opponent_policy,
+                                        int player_id, int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  const std::vector<Action>& history = state.History();
+  SPIEL_CHECK_EQ(history.size(), history_length_ + 1);
+  const Action action = history.back();
+  std::vector<char> possible(NumHistories(), false);
+  auto update = [&](int i) {
+    possible[i] = UpdateProb(*GetState(i), action, opponent_policy, player_id,
+                             &probs_[i]);
+  };
+  ThreadPool::Default().ParallelFor(0, NumHistories(), update, /*grain_size=*/1,
+                                    num_threads);
+  std::vector<bool> kept = KeptHistories(possible, probs_);
+  std::vector<Action> actions;
+  std::vector<double> probs;
+  for (int i = 0; i < NumHistories(); ++i) {
+    if (!kept[i]) continue;
+    absl::Span<const Action> parent_history = History(i);
+    actions.insert(actions.end(), parent_history.begin(),
+                   parent_history.end());
+    actions.push_back(action);
+    probs.push_back(probs_[i]);
+  }
+  ++history_length_;
+  actions_.swap(actions);
+  probs_ = Normalize(probs);
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -15,8 +15,11 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STATE_DISTRIBUTION_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STATE_DISTRIBUTION_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 
@@ -53,9 +56,50 @@ HistoryDistribution GetStateDistribution(const State& state,
 // previous is empty, calls the non-incremental version. This must be called for
 // each state in order, starting from the first non-chance node, or it will be
 // wrong.
+//
+// The histories whose probability becomes zero are dropped, unless they all
+// do. With num_threads > 1, the histories are updated in parallel, on up to
+// num_threads threads of ThreadPool::Default(), so the opponent policy must be
+// thread-safe.
 std::unique_ptr<HistoryDistribution> UpdateIncrementalStateDistribution(
     const State& state, const Policy* opponent_policy, int player_id,
-    std::unique_ptr<HistoryDistribution> previous);
+    std::unique_ptr<HistoryDistribution> previous, int num_threads = 1);
+
+// A compact HistoryDistribution, e.g. for the beliefs of a search bot over a
+// whole game: the histories are kept as their actions, contiguously, instead
+// of states, and only the histories with a non-zero probability are kept (or
+// all of them, if none has). The states are rebuilt from the initial state
+// when needed, which trades time for memory.
+class CompactHistoryDistribution {
+ public:
+  // All the histories must have the same length.
+  explicit CompactHistoryDistribution(const HistoryDistribution& distribution);
+
+  int NumHistories() const { return probs_.size(); }
+  absl::Span<const Action> History(int i) const {
+    return absl::MakeConstSpan(actions_).subspan(i * history_length_,
+                                                 history_length_);
+  }
+  double Prob(int i) const { return probs_[i]; }
+  const std::vector<double>& Probs() const { return probs_; }
+
+  // Returns the state of history i.
+  std::unique_ptr<State> GetState(int i) const;
+  HistoryDistribution ToHistoryDistribution() const;
+
+  // As UpdateIncrementalStateDistribution, with `state` one action after the
+  // histories.
+  void Update(const State& state, const Policy* opponent_policy,
+              int player_id, int num_threads = 1);
+
+ private:
+  std::shared_ptr<const Game> game_;
+  int history_length_ = 0;
+  // The actions of history i are [i * history_length_, (i + 1) *
+  // history_length_).
+  std::vector<Action> actions_;
+  std::vector<double> probs_;
+};
 
 }  // namespace algorithms
 }  // namespace open_spiel
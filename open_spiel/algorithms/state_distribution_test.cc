@@ -141,6 +141,43 @@ void LeducStateDistributionTest() {
   CompareDists(dist, *incremental_dist);
 }
 
+// The compact distributions and the threaded updates must match the serial
+// incremental ones, which drop the histories that have become impossible.
+void LeducCompactStateDistributionTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  std::unique_ptr<State> state = game->NewInitialState();
+  TabularPolicy policy = GetUniformPolicy(*game);
+  state->ApplyAction(0);  // p0 card: jack of first suit
+  state->ApplyAction(1);  // p1 card: queen of first suit
+  state->ApplyAction(2);  // player 0 raises
+  std::unique_ptr<HistoryDistribution> dist =
+      UpdateIncrementalStateDistribution(*state, &policy, /*player_id=*/1,
+                                         nullptr);
+  std::unique_ptr<HistoryDistribution> threaded_dist =
+      UpdateIncrementalStateDistribution(*state, &policy, /*player_id=*/1,
+                                         nullptr);
+  CompactHistoryDistribution compact_dist(*dist);
+  for (Action action : {1, 3, 2, 2}) {
+    // Player 1 calls, the public card is dealt, player 0 and 1 raise.
+    state->ApplyAction(action);
+    dist = UpdateIncrementalStateDistribution(*state, &policy,
+                                              /*player_id=*/1,
+                                              std::move(dist));
+    threaded_dist = UpdateIncrementalStateDistribution(
+        *state, &policy, /*player_id=*/1, std::move(threaded_dist),
+        /*num_threads=*/3);
+    compact_dist.Update(*state, &policy, /*player_id=*/1, /*num_threads=*/2);
+    CheckDistHasSameInfostate(*dist, *state, /*player_id=*/1);
+    SPIEL_CHECK_EQ(threaded_dist->first.size(), dist->first.size());
+    SPIEL_CHECK_EQ(compact_dist.NumHistories(), dist->first.size());
+    CompareDists(*dist, *threaded_dist);
+    CompareDists(*dist, compact_dist.ToHistoryDistribution());
+    for (double prob : dist->second) SPIEL_CHECK_GT(prob, 0);
+  }
+  // The histories where player 0 has the public card were dropped.
+  SPIEL_CHECK_EQ(dist->first.size(), 4);
+}
+
 constexpr absl::string_view kHUNLGameString =
     ("universal_poker(betting=limit,numPlayers=2,numRounds=4,stack=1200 "
      "1200,blind=50 100,firstPlayer=2 "
@@ -177,6 +214,7 @@ namespace algorithms = open_spiel::algorithms;
 int main(int argc, char** argv) {
   algorithms::KuhnStateDistributionTest();
   algorithms::LeducStateDistributionTest();
+  algorithms::LeducCompactStateDistributionTest();
 
   // ACPC is an optional dependency. Only test HUNL if it is registered.
   if (open_spiel::IsGameRegistered(std::string(algorithms::kHUNLGameString))) {
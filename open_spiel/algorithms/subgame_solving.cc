@@ -0,0 +1,287 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/subgame_solving.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+SubgameSolver::SubgameSolver(const HistoryDistribution& beliefs,
+                             std::shared_ptr<Evaluator> evaluator,
+                             const SubgameSolverConfig& config)
+    : evaluator_(std::move(evaluator)), config_(config), start_(absl::Now()) {
+  const std::vector<std::unique_ptr<State>>& histories = beliefs.first;
+  SPIEL_CHECK_FALSE(histories.empty());
+  SPIEL_CHECK_EQ(histories.size(), beliefs.second.size());
+  SPIEL_CHECK_GE(config.max_iterations, 1);
+  SPIEL_CHECK_GE(config.evaluation_batch_size, 1);
+  std::shared_ptr<const Game> game = histories[0]->GetGame();
+  if (game->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "Subgame solving requires sequential games. If you're trying to run "
+        "it on a simultaneous (or normal-form) game, please first transform "
+        "it using turn_based_simultaneous_game.");
+  }
+  num_players_ = game->NumPlayers();
+  info_state_begin_.push_back(0);
+
+  double total = 0;
+  for (double prob : beliefs.second) {
+    SPIEL_CHECK_GE(prob, 0);
+    total += prob;
+  }
+  // The root chance node, over the histories.
+  node_player_.push_back(kChancePlayerId);
+  node_data_.push_back(-1);
+  edge_begin_.push_back(0);
+  edge_child_.resize(histories.size());
+  for (int i = 0; i < histories.size(); ++i) {
+    SPIEL_CHECK_FALSE(histories[i]->IsTerminal());
+    edge_prob_.push_back(total > 0 ? beliefs.second[i] / total
+                                   : 1.0 / histories.size());
+  }
+  for (int i = 0; i < histories.size(); ++i) {
+    edge_child_[i] = CompileTree(histories[i]->Clone(), 0);
+  }
+  EvaluatePendingLeaves();
+  edge_begin_.push_back(edge_child_.size());
+}
+
+int SubgameSolver::CompileTree(std::unique_ptr<State> state, int depth) {
+  const int node = node_player_.size();
+  edge_begin_.push_back(edge_child_.size());
+  if (state->IsTerminal() ||
+      (config_.max_depth >= 0 && depth >= config_.max_depth)) {
+    node_player_.push_back(kTerminalPlayerId);
+    node_data_.push_back(node_values_.size());
+    if (state->IsTerminal()) {
+      const std::vector<double> returns = state->Returns();
+      node_values_.insert(node_values_.end(), returns.begin(), returns.end());
+    } else {
+      ++num_leaves_;
+      pending_offsets_.push_back(node_values_.size());
+      pending_leaves_.push_back(std::move(state));
+      node_values_.resize(node_values_.size() + num_players_);
+      if (pending_leaves_.size() >= config_.evaluation_batch_size) {
+        EvaluatePendingLeaves();
+      }
+    }
+    return node;
+  }
+
+  if (state->IsChanceNode()) {
+    const ActionsAndProbs outcomes = state->ChanceOutcomes();
+    node_player_.push_back(kChancePlayerId);
+    node_data_.push_back(-1);
+    const int first_edge = edge_child_.size();
+    edge_child_.resize(first_edge + outcomes.size());
+    edge_prob_.resize(first_edge + outcomes.size());
+    for (int i = 0; i < outcomes.size(); ++i) {
+      edge_prob_[first_edge + i] = outcomes[i].second;
+    }
+    for (int i = 0; i < outcomes.size(); ++i) {
+      edge_child_[first_edge + i] =
+          CompileTree(state->Child(outcomes[i].first), depth);
+    }
+    return node;
+  }
+
+  const Player player = state->CurrentPlayer();
+  const std::vector<Action> legal_actions = state->LegalActions();
+  const std::string info_state = state->InformationStateString(player);
+  auto [it, inserted] =
+      info_state_ids_.emplace(info_state, info_state_strings_.size());
+  if (inserted) {
+    info_state_strings_.push_back(info_state);
+    info_state_player_.push_back(player);
+    info_state_begin_.push_back(info_state_begin_.back() +
+                                legal_actions.size());
+    legal_actions_.insert(legal_actions_.end(), legal_actions.begin(),
+                          legal_actions.end());
+    cumulative_regrets_.resize(legal_actions_.size(), 0);
+    cumulative_policy_.resize(legal_actions_.size(), 0);
+    current_policy_.resize(legal_actions_.size(),
+                           1.0 / legal_actions.size());
+  }
+  node_player_.push_back(player);
+  node_data_.push_back(it->second);
+  const int first_edge = edge_child_.size();
+  edge_child_.resize(first_edge + legal_actions.size());
+  // Chance edges only have probabilities, but edge_prob_ is kept aligned.
+  edge_prob_.resize(first_edge + legal_actions.size(), 0);
+  for (int i = 0; i < legal_actions.size(); ++i) {
+    edge_child_[first_edge + i] =
+        CompileTree(state->Child(legal_actions[i]), depth + 1);
+  }
+  return node;
+}
+
+void SubgameSolver::EvaluatePendingLeaves() {
+  if (pending_leaves_.empty()) return;
+  std::vector<const State*> states;
+  for (const auto& state : pending_leaves_) states.push_back(state.get());
+  const std::vector<std::vector<double>> values =
+      evaluator_->EvaluateBatch(absl::MakeConstSpan(states));
+  SPIEL_CHECK_EQ(values.size(), states.size());
+  for (int i = 0; i < values.size(); ++i) {
+    SPIEL_CHECK_EQ(values[i].size(), num_players_);
+    std::copy(values[i].begin(), values[i].end(),
+              node_values_.begin() + pending_offsets_[i]);
+  }
+  pending_leaves_.clear();
+  pending_offsets_.clear();
+}
+
+void SubgameSolver::RunIteration() {
+  ++iteration_;
+  std::vector<double> values(num_players_);
+  for (Player player = 0; player < num_players_; ++player) {
+    ComputeCounterFactualRegret(0, player,
+                                std::vector<double>(num_players_ + 1, 1.0),
+                                values.data());
+    ApplyRegretMatchingPlus(player);
+  }
+}
+
+int SubgameSolver::Solve() {
+  int num_iterations = 0;
+  while (iteration_ < config_.max_iterations &&
+         (iteration_ == 0 || absl::Now() - start_ < config_.time_budget)) {
+    RunIteration();
+    ++num_iterations;
+  }
+  return num_iterations;
+}
+
+void SubgameSolver::ComputeCounterFactualRegret(
+    int node, Player updating_player, const std::vector<double>& reach,
+    double* values) {
+  const Player player = node_player_[node];
+  if (player == kTerminalPlayerId) {
+    std::copy_n(&node_values_[node_data_[node]], num_players_, values);
+    return;
+  }
+  std::fill_n(values, num_players_, 0.0);
+  if (player != kChancePlayerId &&
+      std::all_of(reach.begin(), reach.begin() + num_players_,
+                  [](double prob) { return prob == 0.0; })) {
+    return;
+  }
+
+  const int first_edge = edge_begin_[node];
+  const int num_children = edge_begin_[node + 1] - first_edge;
+  const int reach_index = player == kChancePlayerId ? num_players_ : player;
+  const double* policy =
+      player == kChancePlayerId
+          ? &edge_prob_[first_edge]
+          : &current_policy_[info_state_begin_[node_data_[node]]];
+  std::vector<double> child_reach = reach;
+  std::vector<double> child_values(num_children * num_players_);
+  for (int i = 0; i < num_children; ++i) {
+    child_reach[reach_index] = reach[reach_index] * policy[i];
+    double* child_value = &child_values[i * num_players_];
+    ComputeCounterFactualRegret(edge_child_[first_edge + i], updating_player,
+                                child_reach, child_value);
+    for (int p = 0; p < num_players_; ++p) {
+      values[p] += policy[i] * child_value[p];
+    }
+  }
+
+  if (player != updating_player) return;
+  double cfr_reach_prob = 1.0;
+  for (int p = 0; p <= num_players_; ++p) {
+    if (p != player) cfr_reach_prob *= reach[p];
+  }
+  const int offset = info_state_begin_[node_data_[node]];
+  for (int i = 0; i < num_children; ++i) {
+    cumulative_regrets_[offset + i] +=
+        cfr_reach_prob *
+        (child_values[i * num_players_ + player] - values[player]);
+    // Linear averaging, as in CFR+.
+    cumulative_policy_[offset + i] += iteration_ * reach[player] * policy[i];
+  }
+}
+
+void SubgameSolver::ApplyRegretMatchingPlus(Player player) {
+  for (int info_state = 0; info_state < NumInfoStates(); ++info_state) {
+    if (info_state_player_[info_state] != player) continue;
+    const int begin = info_state_begin_[info_state];
+    const int end = info_state_begin_[info_state + 1];
+    double sum_positive_regrets = 0.0;
+    for (int i = begin; i < end; ++i) {
+      cumulative_regrets_[i] = std::max(cumulative_regrets_[i], 0.0);
+      sum_positive_regrets += cumulative_regrets_[i];
+    }
+    for (int i = begin; i < end; ++i) {
+      current_policy_[i] = sum_positive_regrets > 0
+                               ? cumulative_regrets_[i] / sum_positive_regrets
+                               : 1.0 / (end - begin);
+    }
+  }
+}
+
+ActionsAndProbs SubgameSolver::AveragePolicy(
+    const std::string& info_state) const {
+  auto it = info_state_ids_.find(info_state);
+  if (it == info_state_ids_.end()) {
+    SpielFatalError(absl::StrCat("Information state not in the subgame: ",
+                                 info_state));
+  }
+  const int begin = info_state_begin_[it->second];
+  const int end = info_state_begin_[it->second + 1];
+  double total = 0;
+  for (int i = begin; i < end; ++i) total += cumulative_policy_[i];
+  ActionsAndProbs policy;
+  for (int i = begin; i < end; ++i) {
+    policy.push_back({legal_actions_[i], total > 0
+                                             ? cumulative_policy_[i] / total
+                                             : 1.0 / (end - begin)});
+  }
+  return policy;
+}
+
+TabularPolicy SubgameSolver::AveragePolicy() const {
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  for (const std::string& info_state : info_state_strings_) {
+    table[info_state] = AveragePolicy(info_state);
+  }
+  return TabularPolicy(table);
+}
+
+TabularPolicy SolveSubgame(const HistoryDistribution& beliefs,
+                           std::shared_ptr<Evaluator> evaluator,
+                           const SubgameSolverConfig& config) {
+  SubgameSolver solver(beliefs, std::move(evaluator), config);
+  solver.Solve();
+  return solver.AveragePolicy();
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
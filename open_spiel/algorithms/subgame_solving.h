@@ -0,0 +1,150 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SUBGAME_SOLVING_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SUBGAME_SOLVING_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// Depth-limited re-solving of a subgame at decision time, for playing games
+// too large for a precomputed equilibrium.
+//
+// The subgame starts with a chance node over the histories of a
+// HistoryDistribution, e.g. a GetStateDistribution of the current information
+// state of the player to move, with their probabilities. Below them, it
+// follows the game for max_depth actions of the players, where its leaves are
+// valued by an Evaluator (e.g. a value network, or rollouts of a blueprint
+// policy), and it is compiled once into flat arrays as in FlatCFRSolverBase
+// (see flat_cfr.h), the leaves being evaluated in batches. CFR+ then runs on
+// it until a number of iterations or a time budget is reached.
+//
+// The beliefs are taken as given: this is unsafe subgame solving, whose
+// policy may be more exploitable than the one it refines if the beliefs or
+// leaf values are poor (see Brown and Sandholm, "Safe and Nested Subgame
+// Solving for Imperfect-Information Games", 2017,
+// https://arxiv.org/abs/1705.02955). It only needs the subgame in memory,
+// though, and the information states of the players are those of the game,
+// so the policy can be played directly.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct SubgameSolverConfig {
+  // The number of actions of the players from the root to the leaves, or a
+  // negative number to expand the subgame to the end of the game.
+  int max_depth = 2;
+  int max_iterations = 300;
+  // The time after which no new iteration is started, counted from the
+  // construction of the solver, so including the compilation and evaluation
+  // of the subgame. At least one iteration is always run.
+  absl::Duration time_budget = absl::InfiniteDuration();
+  // The maximum number of leaves passed to Evaluator::EvaluateBatch at once.
+  int evaluation_batch_size = 64;
+};
+
+class SubgameSolver {
+ public:
+  // The histories must not be terminal. Their probabilities are normalized,
+  // and taken as uniform if they are all zero.
+  SubgameSolver(const HistoryDistribution& beliefs,
+                std::shared_ptr<Evaluator> evaluator,
+                const SubgameSolverConfig& config);
+
+  // Runs one iteration of CFR+.
+  void RunIteration();
+
+  // Runs iterations until config.max_iterations of them have been run in all,
+  // or the time budget is spent, and returns the number run by this call.
+  int Solve();
+
+  // The average policy of the information states of the subgame, excluding
+  // the leaves.
+  TabularPolicy AveragePolicy() const;
+  ActionsAndProbs AveragePolicy(const std::string& info_state) const;
+
+  int NumIterations() const { return iteration_; }
+  int NumNodes() const { return node_player_.size(); }
+  int NumLeaves() const { return num_leaves_; }
+  int NumInfoStates() const { return info_state_strings_.size(); }
+
+ private:
+  // Appends the subtree of `state` to the arrays and returns its node id.
+  // Leaves get their node, and are added to `pending_leaves` to be
+  // evaluated.
+  int CompileTree(std::unique_ptr<State> state, int depth);
+  void EvaluatePendingLeaves();
+
+  // As FlatCFRSolverBase::ComputeCounterFactualRegret, with alternating
+  // updates.
+  void ComputeCounterFactualRegret(int node, Player updating_player,
+                                   const std::vector<double>& reach,
+                                   double* values);
+  void ApplyRegretMatchingPlus(Player player);
+
+  std::shared_ptr<Evaluator> evaluator_;
+  const SubgameSolverConfig config_;
+  const absl::Time start_;
+  int num_players_ = 0;
+  int iteration_ = 0;
+  int num_leaves_ = 0;
+
+  // The tree, one entry per node, with node 0 the root chance node.
+  // node_data_ is the information state of a decision node, and the offset of
+  // the values in node_values_ for terminal nodes and leaves, which are
+  // kTerminalPlayerId nodes. The children of node n are
+  // edge_child_[edge_begin_[n]...edge_begin_[n+1]), in the order of the
+  // actions of its information state or of its chance outcomes, whose
+  // probabilities are edge_prob_.
+  std::vector<Player> node_player_;
+  std::vector<int> node_data_;
+  std::vector<int> edge_begin_;
+  std::vector<int> edge_child_;
+  std::vector<double> edge_prob_;
+  std::vector<double> node_values_;
+
+  // The leaves waiting for their evaluation, and their offsets in
+  // node_values_.
+  std::vector<std::unique_ptr<State>> pending_leaves_;
+  std::vector<int> pending_offsets_;
+
+  // The information states, whose per-action values are at
+  // [info_state_begin_[i], info_state_begin_[i + 1]).
+  std::unordered_map<std::string, int> info_state_ids_;
+  std::vector<std::string> info_state_strings_;
+  std::vector<Player> info_state_player_;
+  std::vector<int> info_state_begin_;
+  std::vector<Action> legal_actions_;
+  std::vector<double> cumulative_regrets_;
+  std::vector<double> cumulative_policy_;
+  std::vector<double> current_policy_;
+};
+
+// Builds and solves a subgame with a SubgameSolver, and returns its average
+// policy.
+TabularPolicy SolveSubgame(const HistoryDistribution& beliefs,
+                           std::shared_ptr<Evaluator> evaluator,
+                           const SubgameSolverConfig& config);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SUBGAME_SOLVING_H_
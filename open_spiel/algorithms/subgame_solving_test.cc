@@ -0,0 +1,164 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/subgame_solving.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/state_distribution.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Values a state by its last action: 1 for the player who just moved if it
+// was `good_action`, -1 otherwise. Counts the leaves it is asked to value.
+class LastActionEvaluator : public Evaluator {
+ public:
+  explicit LastActionEvaluator(Action good_action)
+      : good_action_(good_action) {}
+
+  std::vector<double> Evaluate(const State& state) override {
+    ++num_evaluated_;
+    const double value = state.History().back() == good_action_ ? 1 : -1;
+    // In tic-tac-toe, player 1 moves next after player 0.
+    return {state.CurrentPlayer() == 1 ? value : -value,
+            state.CurrentPlayer() == 1 ? -value : value};
+  }
+
+  std::vector<std::vector<double>> EvaluateBatch(
+      absl::Span<const State* const> states) override {
+    ++num_batches_;
+    return Evaluator::EvaluateBatch(states);
+  }
+
+  ActionsAndProbs Prior(const State& state) override {
+    SpielFatalError("Not used by subgame solving.");
+  }
+
+  int num_evaluated_ = 0;
+  int num_batches_ = 0;
+
+ private:
+  const Action good_action_;
+};
+
+HistoryDistribution SingleHistory(const State& state) {
+  HistoryDistribution distribution;
+  distribution.first.push_back(state.Clone());
+  distribution.second.push_back(1.0);
+  return distribution;
+}
+
+// A subgame covering the whole game is solved like the game.
+void SolvesWholeGame() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  SubgameSolverConfig config;
+  config.max_depth = -1;
+  config.max_iterations = 300;
+  SubgameSolver solver(SingleHistory(*game->NewInitialState()),
+                       /*evaluator=*/nullptr, config);
+  SPIEL_CHECK_EQ(solver.NumLeaves(), 0);
+  SPIEL_CHECK_EQ(solver.NumInfoStates(), 12);
+  SPIEL_CHECK_EQ(solver.Solve(), 300);
+  SPIEL_CHECK_EQ(solver.Solve(), 0);
+  SPIEL_CHECK_LT(NashConv(*game, solver.AveragePolicy()), 1e-2);
+}
+
+// Player 1 holding the king always calls a bet, whatever player 0 holds.
+void ResolvesFromBeliefs() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(0);  // p0 card: jack
+  state->ApplyAction(2);  // p1 card: king
+  state->ApplyAction(1);  // player 0 bet
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  SubgameSolverConfig config;
+  config.max_depth = -1;
+  config.max_iterations = 100;
+  TabularPolicy policy =
+      SolveSubgame(GetStateDistribution(*state, &uniform_policy),
+                   /*evaluator=*/nullptr, config);
+  SPIEL_CHECK_EQ(policy.PolicyTable().size(), 1);
+  SPIEL_CHECK_GT(
+      GetProb(policy.GetStatePolicy(state->InformationStateString()), 1),
+      0.99);
+}
+
+// The leaves below the depth limit are valued by the evaluator, in batches.
+void UsesLeafValues() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  auto evaluator = std::make_shared<LastActionEvaluator>(/*good_action=*/4);
+  SubgameSolverConfig config;
+  config.max_depth = 1;
+  config.max_iterations = 100;
+  config.evaluation_batch_size = 4;
+  SubgameSolver solver(SingleHistory(*state), evaluator, config);
+  SPIEL_CHECK_EQ(solver.NumNodes(), 11);
+  SPIEL_CHECK_EQ(solver.NumLeaves(), 9);
+  SPIEL_CHECK_EQ(evaluator->num_evaluated_, 9);
+  SPIEL_CHECK_EQ(evaluator->num_batches_, 3);
+  solver.Solve();
+  const ActionsAndProbs policy =
+      solver.AveragePolicy(state->InformationStateString());
+  SPIEL_CHECK_EQ(policy.size(), 9);
+  SPIEL_CHECK_GT(GetProb(policy, 4), 0.99);
+}
+
+// The iterations stop once the time budget is spent.
+void StopsAtTimeBudget() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(0);
+  state->ApplyAction(3);
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  SubgameSolverConfig config;
+  config.max_depth = 4;
+  config.max_iterations = 1000000;
+  config.time_budget = absl::Milliseconds(100);
+  const absl::Time start = absl::Now();
+  SubgameSolver solver(GetStateDistribution(*state, &uniform_policy),
+                       std::make_shared<RandomRolloutEvaluator>(1, 0), config);
+  const int num_iterations = solver.Solve();
+  SPIEL_CHECK_GE(num_iterations, 1);
+  SPIEL_CHECK_LT(num_iterations, config.max_iterations);
+  SPIEL_CHECK_LT(absl::Now() - start, absl::Seconds(10));
+  SPIEL_CHECK_GT(solver.NumLeaves(), 0);
+  const ActionsAndProbs policy =
+      solver.AveragePolicy(state->InformationStateString());
+  double total = 0;
+  for (const auto& [action, prob] : policy) total += prob;
+  SPIEL_CHECK_FLOAT_NEAR(total, 1.0, 1e-9);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::SolvesWholeGame();
+  open_spiel::algorithms::ResolvesFromBeliefs();
+  open_spiel::algorithms::UsesLeafValues();
+  open_spiel::algorithms::StopsAtTimeBudget();
+}
@@ -0,0 +1,297 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tablebase.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The file starts with this magic, then the number of positions as 8 bytes,
+// then the outcomes as in memory.
+constexpr char kMagic[8] = {'O', 'S', 'T', 'B', 'A', 'S', 'E', '1'};
+constexpr int kHeaderSize = sizeof(kMagic) + sizeof(int64_t);
+
+using Outcome = Tablebase::Outcome;
+
+int64_t DataSize(int64_t num_positions) { return (num_positions + 3) / 4; }
+
+Outcome WinFor(Player player) {
+  return player == Player{0} ? Outcome::kWin : Outcome::kLoss;
+}
+
+// The retrograde analysis of Tablebase::Build, over the positions numbered
+// in the order they are reached.
+class RetrogradeSolver {
+ public:
+  RetrogradeSolver(int64_t num_positions,
+                   const Tablebase::IndexFunction& index_function)
+      : num_positions_(num_positions), index_function_(index_function) {}
+
+  // Adds the positions reachable from `state`, and returns the number of
+  // `state`.
+  int AddPositions(const State& state) {
+    const int64_t index = index_function_(state);
+    if (index < 0 || index >= num_positions_) {
+      SpielFatalError(absl::StrCat("Index ", index, " of position:\n",
+                                   state.ToString(), "\nnot in [0, ",
+                                   num_positions_, ")."));
+    }
+    auto [it, inserted] = numbers_.try_emplace(index, indices_.size());
+    if (!inserted) return it->second;
+    const int number = it->second;
+    indices_.push_back(index);
+    players_.push_back(state.CurrentPlayer());
+    outcomes_.push_back(Outcome::kUnknown);
+    num_unsolved_successors_.push_back(0);
+    has_drawn_successor_.push_back(false);
+    if (state.IsTerminal()) {
+      const double player_return = state.PlayerReturn(Player{0});
+      outcomes_[number] = player_return > 0   ? Outcome::kWin
+                          : player_return < 0 ? Outcome::kLoss
+                                              : Outcome::kDraw;
+      return number;
+    }
+    if (state.IsChanceNode()) {
+      SpielFatalError("Tablebases need deterministic games.");
+    }
+    for (Action action : state.LegalActions()) {
+      const int successor = AddPositions(*state.Child(action));
+      edges_.push_back({successor, number});
+      ++num_unsolved_successors_[number];
+    }
+    return number;
+  }
+
+  // Solves all the positions added, and stores their outcomes in `set`.
+  void Solve(const std::function<void(int64_t, Outcome)>& set) {
+    const int num_positions = indices_.size();
+    // The predecessors of position p are predecessors[first[p], first[p+1]).
+    std::vector<int> first(num_positions + 1, 0);
+    for (const auto& [successor, predecessor] : edges_) ++first[successor + 1];
+    for (int p = 0; p < num_positions; ++p) first[p + 1] += first[p];
+    std::vector<int> predecessors(edges_.size());
+    std::vector<int> next(first.begin(), first.end() - 1);
+    for (const auto& [successor, predecessor] : edges_) {
+      predecessors[next[successor]++] = predecessor;
+    }
+    edges_.clear();
+    edges_.shrink_to_fit();
+
+    std::vector<int> solved;
+    for (int p = 0; p < num_positions; ++p) {
+      if (outcomes_[p] != Outcome::kUnknown) solved.push_back(p);
+    }
+    while (!solved.empty()) {
+      const int successor = solved.back();
+      solved.pop_back();
+      const Outcome outcome = outcomes_[successor];
+      for (int i = first[successor]; i < first[successor + 1]; ++i) {
+        const int p = predecessors[i];
+        if (outcomes_[p] != Outcome::kUnknown) continue;
+        if (outcome == WinFor(players_[p])) {
+          outcomes_[p] = outcome;
+          solved.push_back(p);
+          continue;
+        }
+        if (outcome == Outcome::kDraw) has_drawn_successor_[p] = true;
+        if (--num_unsolved_successors_[p] == 0) {
+          // All the successors are losses or draws for the player to move.
+          outcomes_[p] = has_drawn_successor_[p] ? Outcome::kDraw : outcome;
+          solved.push_back(p);
+        }
+      }
+    }
+    for (int p = 0; p < num_positions; ++p) {
+      set(indices_[p], outcomes_[p] == Outcome::kUnknown ? Outcome::kDraw
+                                                         : outcomes_[p]);
+    }
+  }
+
+ private:
+  const int64_t num_positions_;
+  const Tablebase::IndexFunction& index_function_;
+  // The number of each position, by index.
+  absl::flat_hash_map<int64_t, int> numbers_;
+  // By number.
+  std::vector<int64_t> indices_;
+  std::vector<Player> players_;
+  std::vector<Outcome> outcomes_;
+  std::vector<int> num_unsolved_successors_;
+  std::vector<bool> has_drawn_successor_;
+  // The (successor, predecessor) moves.
+  std::vector<std::pair<int, int>> edges_;
+};
+
+}  // namespace
+
+Tablebase::Tablebase(int64_t num_positions, IndexFunction index_function)
+    : num_positions_(num_positions),
+      index_function_(std::move(index_function)) {
+  SPIEL_CHECK_GT(num_positions_, 0);
+}
+
+Tablebase::~Tablebase() {
+#ifndef _WIN32
+  if (mapped_data_ != nullptr) munmap(mapped_data_, mapped_size_);
+#endif
+}
+
+std::unique_ptr<Tablebase> Tablebase::Build(
+    const std::vector<const State*>& roots, int64_t num_positions,
+    IndexFunction index_function) {
+  SPIEL_CHECK_FALSE(roots.empty());
+  const GameType game_type = roots[0]->GetGame()->GetType();
+  SPIEL_CHECK_EQ(roots[0]->NumPlayers(), 2);
+  SPIEL_CHECK_EQ(game_type.dynamics, GameType::Dynamics::kSequential);
+  SPIEL_CHECK_EQ(game_type.chance_mode, GameType::ChanceMode::kDeterministic);
+  SPIEL_CHECK_EQ(game_type.information,
+                 GameType::Information::kPerfectInformation);
+  SPIEL_CHECK_EQ(game_type.utility, GameType::Utility::kZeroSum);
+
+  std::unique_ptr<Tablebase> tablebase(
+      new Tablebase(num_positions, std::move(index_function)));
+  tablebase->owned_data_.assign(DataSize(num_positions), 0);
+  tablebase->data_ = tablebase->owned_data_.data();
+  RetrogradeSolver solver(num_positions, tablebase->index_function_);
+  for (const State* root : roots) solver.AddPositions(*root);
+  solver.Solve([&tablebase](int64_t index, Outcome outcome) {
+    tablebase->SetIndexOutcome(index, outcome);
+  });
+  return tablebase;
+}
+
+void Tablebase::Save(const std::string& path) const {
+  file::File file(path, "wb");
+  std::string header(kMagic, sizeof(kMagic));
+  header.append(reinterpret_cast<const char*>(&num_positions_),
+                sizeof(num_positions_));
+  SPIEL_CHECK_TRUE(file.Write(header));
+  SPIEL_CHECK_TRUE(file.Write(absl::string_view(
+      reinterpret_cast<const char*>(data_), DataSize(num_positions_))));
+}
+
+std::unique_ptr<Tablebase> Tablebase::Load(const std::string& path,
+                                           IndexFunction index_function) {
+  std::string header;
+  {
+    file::File file(path, "rb");
+    header = file.Read(kHeaderSize);
+  }
+  if (header.size() != kHeaderSize ||
+      std::memcmp(header.data(), kMagic, sizeof(kMagic)) != 0) {
+    SpielFatalError(absl::StrCat(path, " is not a tablebase."));
+  }
+  int64_t num_positions;
+  std::memcpy(&num_positions, header.data() + sizeof(kMagic),
+              sizeof(num_positions));
+  std::unique_ptr<Tablebase> tablebase(
+      new Tablebase(num_positions, std::move(index_function)));
+  const int64_t size = kHeaderSize + DataSize(num_positions);
+#ifdef _WIN32
+  std::string contents = file::File(path, "rb").ReadContents();
+  SPIEL_CHECK_EQ(contents.size(), size);
+  tablebase->owned_data_.assign(contents.begin() + kHeaderSize,
+                                contents.end());
+  tablebase->data_ = tablebase->owned_data_.data();
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  SPIEL_CHECK_GE(fd, 0);
+  struct stat file_stat;
+  SPIEL_CHECK_EQ(fstat(fd, &file_stat), 0);
+  SPIEL_CHECK_EQ(file_stat.st_size, size);
+  void* mapped_data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped_data == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Could not map ", path, "."));
+  }
+  tablebase->mapped_data_ = mapped_data;
+  tablebase->mapped_size_ = size;
+  tablebase->data_ = static_cast<const uint8_t*>(mapped_data) + kHeaderSize;
+#endif
+  return tablebase;
+}
+
+std::vector<double> Tablebase::ProbeReturns(const State& state) const {
+  const double max_utility = state.GetGame()->MaxUtility();
+  switch (Probe(state)) {
+    case Outcome::kWin:
+      return {max_utility, -max_utility};
+    case Outcome::kLoss:
+      return {-max_utility, max_utility};
+    case Outcome::kDraw:
+      return {0, 0};
+    case Outcome::kUnknown:
+      return {};
+  }
+  SpielFatalError("Unknown outcome.");
+}
+
+std::ostream& operator<<(std::ostream& os, Tablebase::Outcome outcome) {
+  switch (outcome) {
+    case Outcome::kUnknown:
+      return os << "Unknown";
+    case Outcome::kWin:
+      return os << "Win";
+    case Outcome::kLoss:
+      return os << "Loss";
+    case Outcome::kDraw:
+      return os << "Draw";
+  }
+  SpielFatalError("Unknown outcome.");
+}
+
+std::vector<double> TablebaseEvaluator::Evaluate(const State& state) {
+  std::vector<double> returns = tablebase_->ProbeReturns(state);
+  return returns.empty() ? fallback_->Evaluate(state) : returns;
+}
+
+std::function<double(const State&)> TablebaseValueFunction(
+    const Tablebase* tablebase, Player player,
+    std::function<double(const State&)> fallback) {
+  return [tablebase, player, fallback](const State& state) {
+    std::vector<double> returns = tablebase->ProbeReturns(state);
+    if (!returns.empty()) return returns[player];
+    if (!fallback) {
+      SpielFatalError(absl::StrCat("Position not in the tablebase:\n",
+                                   state.ToString()));
+    }
+    return fallback(state);
+  };
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
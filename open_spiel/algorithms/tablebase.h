@@ -0,0 +1,140 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABLEBASE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABLEBASE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A perfect-play database of the win/loss/draw outcome of positions of a
+// deterministic, 2-player, perfect-information, zero-sum, sequential game,
+// e.g. endgames of connect_four, oware or pentago.
+//
+// The positions are numbered by an index function, mapping every position
+// that can be stored to a distinct integer in [0, num_positions), and the
+// others to -1. It must distinguish everything that matters for the rest of
+// the game (e.g. the player to move), and is given both to build and to load
+// a tablebase. Each
+// outcome takes 2 bits, so a tablebase takes num_positions / 4 bytes, in
+// memory or in its file.
+class Tablebase {
+ public:
+  // The outcome of a position, for player 0. kUnknown for positions that
+  // are not in the tablebase.
+  enum class Outcome : uint8_t { kUnknown = 0, kWin = 1, kLoss = 2, kDraw = 3 };
+
+  using IndexFunction = std::function<int64_t(const State&)>;
+
+  // Solves the positions reachable from the `roots` by retrograde analysis:
+  // the terminal positions are solved first, by the sign of player 0's
+  // return, and the solved positions then solve their predecessors, as
+  // wins if the player to move can reach a win, and as losses or draws once
+  // all their successors are solved. The positions left in cycles that
+  // neither player can force an end to are draws.
+  //
+  // Only the outcomes are kept, but the enumeration needs a few tens of
+  // bytes per position reachable from the roots.
+  static std::unique_ptr<Tablebase> Build(
+      const std::vector<const State*>& roots, int64_t num_positions,
+      IndexFunction index_function);
+
+  // Maps a tablebase written by Save into memory, read-only.
+  static std::unique_ptr<Tablebase> Load(const std::string& path,
+                                         IndexFunction index_function);
+
+  ~Tablebase();
+  Tablebase(const Tablebase&) = delete;
+  Tablebase& operator=(const Tablebase&) = delete;
+
+  void Save(const std::string& path) const;
+
+  int64_t NumPositions() const { return num_positions_; }
+
+  // Returns the outcome of the position at `index` or of `state`.
+  Outcome IndexOutcome(int64_t index) const {
+    SPIEL_CHECK_GE(index, 0);
+    SPIEL_CHECK_LT(index, num_positions_);
+    return static_cast<Outcome>((data_[index >> 2] >> ((index & 3) * 2)) & 3);
+  }
+  Outcome Probe(const State& state) const {
+    const int64_t index = index_function_(state);
+    return index < 0 ? Outcome::kUnknown : IndexOutcome(index);
+  }
+
+  // Returns the returns of the players for the outcome of `state`: the
+  // maximum and minimum utilities of the game for a win, and 0 for a draw,
+  // or an empty vector if it is not in the tablebase.
+  std::vector<double> ProbeReturns(const State& state) const;
+
+ private:
+  Tablebase(int64_t num_positions, IndexFunction index_function);
+
+  void SetIndexOutcome(int64_t index, Outcome outcome) {
+    uint8_t& byte = owned_data_[index >> 2];
+    const int shift = (index & 3) * 2;
+    byte = (byte & ~(3 << shift)) | (static_cast<int>(outcome) << shift);
+  }
+
+  int64_t num_positions_;
+  IndexFunction index_function_;
+  // The outcomes, 4 per byte by increasing index, from the lowest bits. They
+  // are either in owned_data_, or mapped from a file.
+  const uint8_t* data_ = nullptr;
+  std::vector<uint8_t> owned_data_;
+  void* mapped_data_ = nullptr;
+  int64_t mapped_size_ = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, Tablebase::Outcome outcome);
+
+// An evaluator for MCTSBot that returns the outcome of the positions in the
+// tablebase, and otherwise the evaluation and prior of another evaluator.
+class TablebaseEvaluator : public Evaluator {
+ public:
+  TablebaseEvaluator(const Tablebase* tablebase, Evaluator* fallback)
+      : tablebase_(tablebase), fallback_(fallback) {}
+
+  std::vector<double> Evaluate(const State& state) override;
+  ActionsAndProbs Prior(const State& state) override {
+    return fallback_->Prior(state);
+  }
+
+ private:
+  const Tablebase* tablebase_;
+  Evaluator* fallback_;
+};
+
+// Returns a value function for AlphaBetaSearch or AlphaBetaSearcher
+// maximizing for `player`, which returns the outcome of the positions in the
+// tablebase, and otherwise the value of `fallback` (which may be null for
+// searches that only reach positions in the tablebase).
+std::function<double(const State&)> TablebaseValueFunction(
+    const Tablebase* tablebase, Player player,
+    std::function<double(const State&)> fallback);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABLEBASE_H_
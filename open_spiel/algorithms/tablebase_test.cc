@@ -0,0 +1,161 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tablebase.h"
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/algorithms/get_all_states.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/algorithms/value_iteration.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+Tablebase::Outcome OutcomeOfValue(double value) {
+  return value > 0   ? Tablebase::Outcome::kWin
+         : value < 0 ? Tablebase::Outcome::kLoss
+                     : Tablebase::Outcome::kDraw;
+}
+
+// Indexes the tic_tac_toe boards in base 3.
+int64_t TicTacToeIndex(const State& state) {
+  int64_t index = 0;
+  for (char c : state.ToString()) {
+    if (c == '\n') continue;
+    index = 3 * index + (c == '.' ? 0 : c == 'x' ? 1 : 2);
+  }
+  return index;
+}
+
+void TicTacToeTablebase() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::unique_ptr<Tablebase> tablebase =
+      Tablebase::Build({root.get()}, /*num_positions=*/19683, TicTacToeIndex);
+  SPIEL_CHECK_EQ(tablebase->Probe(*root), Tablebase::Outcome::kDraw);
+
+  // The outcomes of all the positions are those of value iteration.
+  std::map<std::string, double> values =
+      ValueIteration(*game, /*depth_limit=*/-1, /*threshold=*/0.01);
+  auto states = GetAllStates(*game, /*depth_limit=*/-1,
+                             /*include_terminals=*/true,
+                             /*include_chance_states=*/false);
+  for (const auto& [key, state] : states) {
+    SPIEL_CHECK_EQ(tablebase->Probe(*state), OutcomeOfValue(values[key]));
+  }
+
+  // The loaded tablebase is the same.
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string path = absl::StrCat(tmp_dir ? tmp_dir : "/tmp",
+                                        "/open_spiel-tablebase-test.bin");
+  tablebase->Save(path);
+  std::unique_ptr<Tablebase> loaded = Tablebase::Load(path, TicTacToeIndex);
+  SPIEL_CHECK_EQ(loaded->NumPositions(), tablebase->NumPositions());
+  for (int64_t index = 0; index < tablebase->NumPositions(); ++index) {
+    SPIEL_CHECK_EQ(loaded->IndexOutcome(index), tablebase->IndexOutcome(index));
+  }
+  loaded.reset();
+  SPIEL_CHECK_TRUE(file::Remove(path));
+
+  // The probes of the evaluator and the value function.
+  RandomRolloutEvaluator rollouts(/*n_rollouts=*/1, /*seed=*/0);
+  TablebaseEvaluator evaluator(tablebase.get(), &rollouts);
+  SPIEL_CHECK_EQ(evaluator.Evaluate(*root), std::vector<double>({0, 0}));
+  std::unique_ptr<State> state = root->Child(4);
+  state->ApplyAction(1);
+  // o in the middle of a side loses.
+  SPIEL_CHECK_EQ(evaluator.Evaluate(*state), std::vector<double>({1, -1}));
+  std::pair<double, Action> value_and_action = AlphaBetaSearch(
+      *game, state.get(),
+      TablebaseValueFunction(tablebase.get(), Player{0}, nullptr),
+      /*depth_limit=*/1, Player{0});
+  SPIEL_CHECK_EQ(value_and_action.first, 1);
+}
+
+// Indexes the states reachable from a root, for games whose positions do not
+// fit an int64_t.
+class EnumeratedIndex {
+ public:
+  explicit EnumeratedIndex(const State& root) { Add(root); }
+
+  int64_t operator()(const State& state) const {
+    auto it = indices_->find(state.ToString());
+    return it == indices_->end() ? -1 : it->second;
+  }
+  int64_t NumPositions() const { return indices_->size(); }
+
+ private:
+  void Add(const State& state) {
+    if (!indices_->emplace(state.ToString(), indices_->size()).second) return;
+    if (state.IsTerminal()) return;
+    for (Action action : state.LegalActions()) Add(*state.Child(action));
+  }
+
+  std::shared_ptr<std::unordered_map<std::string, int64_t>> indices_ =
+      std::make_shared<std::unordered_map<std::string, int64_t>>();
+};
+
+// A connect_four endgame, checked against alpha-beta.
+void ConnectFourEndgameTablebase() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  // Plays random moves until 30 of the 42 cells are filled.
+  std::mt19937 rng(0);
+  std::unique_ptr<State> root;
+  do {
+    root = game->NewInitialState();
+    while (!root->IsTerminal() && root->History().size() < 30) {
+      std::vector<Action> actions = root->LegalActions();
+      root->ApplyAction(actions[absl::Uniform<int>(rng, 0, actions.size())]);
+    }
+  } while (root->IsTerminal());
+  SPIEL_CHECK_FALSE(root->IsTerminal());
+  EnumeratedIndex index(*root);
+  std::unique_ptr<Tablebase> tablebase =
+      Tablebase::Build({root.get()}, index.NumPositions(), index);
+  std::vector<std::unique_ptr<State>> states;
+  states.push_back(root->Clone());
+  for (Action action : root->LegalActions()) {
+    states.push_back(root->Child(action));
+  }
+  for (const std::unique_ptr<State>& state : states) {
+    const double value =
+        AlphaBetaSearch(*game, state.get(), nullptr, /*depth_limit=*/-1,
+                        Player{0})
+            .first;
+    SPIEL_CHECK_EQ(tablebase->Probe(*state), OutcomeOfValue(value));
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TicTacToeTablebase();
+  open_spiel::algorithms::ConnectFourEndgameTablebase();
+}
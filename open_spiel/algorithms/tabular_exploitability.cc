@@ -14,21 +14,58 @@
 
 #include "open_spiel/algorithms/tabular_exploitability.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
 
-double Exploitability(const Game& game, const Policy& policy) {
+namespace {
+
+// Adds the returns of the terminal nodes below the node at `index` of `tree`,
+// reached with probability `prob`, weighted by their probability under
+// `policies`, the policy at each information state of the tree, to
+// `expected_returns`.
+void AddExpectedReturns(const CompactHistoryTree& tree, int index, double prob,
+                        const std::vector<ActionsAndProbs>& policies,
+                        std::vector<double>* expected_returns) {
+  const CompactHistoryTree::Node& node = tree.GetNode(index);
+  if (node.type == StateType::kTerminal) {
+    for (Player p = 0; p < tree.NumPlayers(); ++p) {
+      (*expected_returns)[p] += prob * tree.PlayerReturn(index, p);
+    }
+    return;
+  }
+  for (int child = node.first_child;
+       child < node.first_child + node.num_children; ++child) {
+    const double child_prob =
+        node.type == StateType::kDecision
+            ? GetProb(policies[node.info_state], tree.GetNode(child).action)
+            : tree.GetNode(child).probability;
+    SPIEL_CHECK_GE(child_prob, 0.0);
+    SPIEL_CHECK_LE(child_prob, 1.0);
+    if (child_prob > 0) {
+      AddExpectedReturns(tree, child, prob * child_prob, policies,
+                         expected_returns);
+    }
+  }
+}
+
+void CheckExploitabilityGame(const Game& game) {
   GameType game_type = game.GetType();
   if (game_type.dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
@@ -37,12 +74,73 @@ double Exploitability(const Game& game, const Policy& policy) {
       game_type.utility != GameType::Utility::kConstantSum) {
     SpielFatalError("The game must have zero- or constant-sum utility.");
   }
+}
+
+}  // namespace
 
+std::vector<double> BestResponseValues(const Game& game, const Policy& policy,
+                                       int num_threads,
+                                       std::vector<double>* expected_returns) {
+  SPIEL_CHECK_GE(num_threads, 1);
   std::unique_ptr<State> root = game.NewInitialState();
+  const std::string root_history = root->ToString();
+  auto tree = std::make_shared<CompactHistoryTree>(*root);
+  const int num_players = game.NumPlayers();
+  std::vector<double> values(num_players);
+  // The best response of each player, and the expected returns.
+  const int num_tasks = num_players + (expected_returns != nullptr);
+  // The threads left when there are more than tasks are used within the best
+  // responses.
+  const int num_best_response_threads = std::max(1, num_threads / num_tasks);
+  auto run_task = [&](int task) {
+    if (task < num_players) {
+      TabularBestResponse best_response(game, task, &policy, tree,
+                                        num_best_response_threads);
+      values[task] = best_response.Value(root_history);
+      return;
+    }
+    std::vector<ActionsAndProbs> policies(tree->NumInfoStates());
+    std::vector<const State*> states(tree->NumInfoStates());
+    for (int i = 0; i < states.size(); ++i) {
+      states[i] = &tree->InfoStateState(i);
+    }
+    policy.GetStatePolicies(states, absl::MakeSpan(policies));
+    for (int i = 0; i < policies.size(); ++i) {
+      if (policies[i].empty()) {
+        SpielFatalError(tree->InfoStateString(i) + " not found in policy.");
+      }
+    }
+    expected_returns->assign(num_players, 0.0);
+    AddExpectedReturns(*tree, tree->Root(), 1.0, policies, expected_returns);
+  };
+  num_threads = std::min(num_threads, num_tasks);
+  if (num_threads == 1) {
+    for (int task = 0; task < num_tasks; ++task) run_task(task);
+  } else {
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&run_task, num_tasks, num_threads, t]() {
+        for (int task = t; task < num_tasks; task += num_threads) {
+          run_task(task);
+        }
+      });
+    }
+    for (Thread& thread : threads) thread.join();
+  }
+  return values;
+}
+
+double Exploitability(const Game& game, const Policy& policy) {
+  return Exploitability(game, policy, /*num_threads=*/1);
+}
+
+double Exploitability(const Game& game, const Policy& policy,
+                      int num_threads) {
+  CheckExploitabilityGame(game);
   double nash_conv = 0;
-  for (auto i = Player{0}; i < game.NumPlayers(); ++i) {
-    TabularBestResponse best_response(game, i, &policy);
-    nash_conv += best_response.Value(root->ToString());
+  for (double value : BestResponseValues(game, policy, num_threads)) {
+    nash_conv += value;
   }
   return (nash_conv - game.UtilitySum()) / game.NumPlayers();
 }
@@ -55,18 +153,16 @@ double Exploitability(
 }
 
 double NashConv(const Game& game, const Policy& policy) {
-  GameType game_type = game.GetType();
-  if (game_type.dynamics != GameType::Dynamics::kSequential) {
-    SpielFatalError("The game must be turn-based.");
-  }
+  return NashConv(game, policy, /*num_threads=*/1);
+}
 
-  std::unique_ptr<State> root = game.NewInitialState();
-  std::vector<double> best_response_values(game.NumPlayers());
-  for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
-    TabularBestResponse best_response(game, p, &policy);
-    best_response_values[p] = best_response.Value(root->ToString());
+double NashConv(const Game& game, const Policy& policy, int num_threads) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("The game must be turn-based.");
   }
-  std::vector<double> on_policy_values = ExpectedReturns(*root, policy, -1);
+  std::vector<double> on_policy_values;
+  std::vector<double> best_response_values =
+      BestResponseValues(game, policy, num_threads, &on_policy_values);
   SPIEL_CHECK_EQ(best_response_values.size(), on_policy_values.size());
   double nash_conv = 0;
   for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
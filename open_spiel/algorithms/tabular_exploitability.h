@@ -17,8 +17,10 @@
 
 #include <iostream>
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
@@ -40,6 +42,10 @@ double Exploitability(
     const Game& game,
     const std::unordered_map<std::string, ActionsAndProbs>& policy);
 
+// As Exploitability, with the best responses of the players computed by
+// num_threads threads, in which case the policy must be thread-safe.
+double Exploitability(const Game& game, const Policy& policy, int num_threads);
+
 // Calculates a measure of how far the given policy is from a Nash equilibrium
 // by returning the sum of the improvements in the value that each player could
 // obtain by unilaterally changing their strategy while the opposing player
@@ -52,6 +58,22 @@ double NashConv(const Game& game, const Policy& policy);
 double NashConv(const Game& game,
                 const std::unordered_map<std::string, ActionsAndProbs>& policy);
 
+// As NashConv, with the best responses of the players and the expected returns
+// of the policy computed by num_threads threads, in which case the policy must
+// be thread-safe.
+double NashConv(const Game& game, const Policy& policy, int num_threads);
+
+// Returns the value of the best response of each player to `policy`. The game
+// tree is built once for all the players, and the best responses are computed
+// by num_threads threads, in which case the policy must be thread-safe: one
+// per player, and the others within the best responses. If
+// `expected_returns` is not null, it is set to the expected returns of
+// `policy`, computed on the same tree.
+std::vector<double> BestResponseValues(const Game& game, const Policy& policy,
+                                       int num_threads = 1,
+                                       std::vector<double>* expected_returns =
+                                           nullptr);
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -481,6 +481,26 @@ void TestNashConv(const std::string& game_name,
   }
 }
 
+void TestThreadedNashConv(
+    const std::string& game_name,
+    std::function<TabularPolicy(const Game&)> policy_factory,
+    double expected_nash_conv) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  TabularPolicy policy = policy_factory(*game);
+  for (int num_threads : {1, 2, 3}) {
+    double nash_conv = NashConv(*game, policy, num_threads);
+    double exploitability = Exploitability(*game, policy, num_threads);
+    if (!Near(nash_conv, expected_nash_conv) ||
+        !Near(exploitability, expected_nash_conv / game->NumPlayers())) {
+      SpielFatalError(absl::StrCat("In game ", game_name, " with ",
+                                   num_threads, " threads NashConv was ",
+                                   nash_conv, " and exploitability was ",
+                                   exploitability, " but expected NashConv ",
+                                   expected_nash_conv));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -508,6 +528,10 @@ int main(int argc, char** argv) {
       "kuhn_poker", open_spiel::GetUniformPolicy, 0.916666666666667);
   open_spiel::algorithms::TestNashConv(
       "leduc_poker", open_spiel::GetUniformPolicy, 4.747222222222222);
+  open_spiel::algorithms::TestThreadedNashConv(
+      "kuhn_poker", open_spiel::GetUniformPolicy, 0.916666666666667);
+  open_spiel::algorithms::TestThreadedNashConv(
+      "leduc_poker", open_spiel::GetUniformPolicy, 4.747222222222222);
 
   // The first action policy is AlwaysFold in poker. If you always fold, you win
   // 0 chips, but if you switch to AlwaysBet, you win 1 chip every time if
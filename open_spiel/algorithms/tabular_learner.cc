@@ -0,0 +1,196 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/tabular_learner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/vector_env.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+std::string ObservationKey(absl::Span<const float> observation) {
+  return std::string(reinterpret_cast<const char*>(observation.data()),
+                     observation.size() * sizeof(float));
+}
+
+}  // namespace
+
+TabularLearner::TabularLearner(std::shared_ptr<const Game> game,
+                               const TabularLearnerConfig& config)
+    : game_(std::move(game)),
+      config_(config),
+      num_players_(game_->NumPlayers()),
+      num_actions_(game_->NumDistinctActions()),
+      observation_size_(game_->ObservationTensorSize()),
+      env_(game_, config.num_envs, config.seed),
+      rng_(config.seed),
+      indices_(num_players_),
+      q_values_(num_players_),
+      experiences_(config.num_envs * num_players_),
+      actions_(config.num_envs) {
+  SPIEL_CHECK_GE(config.epsilon, 0);
+  SPIEL_CHECK_LE(config.epsilon, 1);
+}
+
+int TabularLearner::Intern(Player player,
+                           absl::Span<const float> observation) {
+  auto [iter, inserted] = indices_[player].try_emplace(
+      ObservationKey(observation), indices_[player].size());
+  if (inserted) {
+    q_values_[player].resize(q_values_[player].size() + num_actions_, 0);
+  }
+  return iter->second;
+}
+
+int TabularLearner::Find(Player player,
+                         absl::Span<const float> observation) const {
+  auto iter = indices_[player].find(ObservationKey(observation));
+  return iter == indices_[player].end() ? -1 : iter->second;
+}
+
+Action TabularLearner::SampleAction(Player player, int state,
+                                    absl::Span<const float> legal_mask) {
+  const double* q = &q_values_[player][state * num_actions_];
+  double best = std::numeric_limits<double>::lowest();
+  int num_legal = 0;
+  int num_best = 0;
+  for (int a = 0; a < num_actions_; ++a) {
+    if (!legal_mask[a]) continue;
+    ++num_legal;
+    if (q[a] > best) {
+      best = q[a];
+      num_best = 1;
+    } else if (q[a] == best) {
+      ++num_best;
+    }
+  }
+  SPIEL_CHECK_GT(num_legal, 0);
+  // A uniform legal action with probability epsilon, otherwise a uniform
+  // greedy one, as in Python.
+  const bool explore =
+      std::uniform_real_distribution<double>(0, 1)(rng_) < config_.epsilon;
+  int k = std::uniform_int_distribution<int>(
+      0, (explore ? num_legal : num_best) - 1)(rng_);
+  for (int a = 0; a < num_actions_; ++a) {
+    if (!legal_mask[a] || (!explore && q[a] != best)) continue;
+    if (k-- == 0) return a;
+  }
+  SpielFatalError("No action sampled.");
+}
+
+double TabularLearner::MaxQ(Player player, int state,
+                            absl::Span<const float> legal_mask) const {
+  const double* q = &q_values_[player][state * num_actions_];
+  double best = std::numeric_limits<double>::lowest();
+  for (int a = 0; a < num_actions_; ++a) {
+    if (legal_mask[a]) best = std::max(best, q[a]);
+  }
+  return best;
+}
+
+void TabularLearner::Update(Player player, const Experience& experience,
+                            double target) {
+  double& q =
+      q_values_[player][experience.state * num_actions_ + experience.action];
+  q += config_.step_size * (target - q);
+}
+
+void TabularLearner::Train(int num_steps) {
+  const int num_envs = env_.num_envs();
+  for (int step = 0; step < num_steps; ++step) {
+    // Choose the actions of the batch, learning from the previous decision of
+    // each player to act.
+    for (int env = 0; env < num_envs; ++env) {
+      const Player player = env_.current_players()[env];
+      absl::Span<const float> observation =
+          absl::MakeConstSpan(env_.observations())
+              .subspan(env * observation_size_, observation_size_);
+      absl::Span<const float> legal_mask =
+          absl::MakeConstSpan(env_.legal_actions_masks())
+              .subspan(env * num_actions_, num_actions_);
+      const int state = Intern(player, observation);
+      const Action action = SampleAction(player, state, legal_mask);
+      Experience& experience = experiences_[env * num_players_ + player];
+      if (experience.state >= 0) {
+        const double next_value =
+            config_.algorithm == TabularAlgorithm::kQLearning
+                ? MaxQ(player, state, legal_mask)
+                : q_values_[player][state * num_actions_ + action];
+        Update(player, experience,
+               experience.reward + config_.discount_factor * next_value);
+      }
+      experience = {state, action, 0};
+      actions_[env] = action;
+    }
+
+    env_.Step(actions_);
+    num_steps_ += num_envs;
+
+    // Collect the rewards, and learn from the ends of the episodes, whose
+    // Q-values are 0.
+    for (int env = 0; env < num_envs; ++env) {
+      const bool done = env_.dones()[env];
+      num_episodes_ += done;
+      for (Player p = 0; p < num_players_; ++p) {
+        Experience& experience = experiences_[env * num_players_ + p];
+        if (experience.state < 0) continue;
+        experience.reward += env_.rewards()[env * num_players_ + p];
+        if (done) {
+          Update(p, experience, experience.reward);
+          experience = Experience();
+        }
+      }
+    }
+  }
+}
+
+std::vector<double> TabularLearner::QValues(const State& state) const {
+  const Player player = state.CurrentPlayer();
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  std::vector<float> observation(observation_size_);
+  state.ObservationTensor(player, absl::MakeSpan(observation));
+  const int row = Find(player, observation);
+  if (row < 0) return std::vector<double>(num_actions_, 0);
+  return {q_values_[player].begin() + row * num_actions_,
+          q_values_[player].begin() + (row + 1) * num_actions_};
+}
+
+Action TabularLearner::GreedyAction(const State& state) const {
+  const std::vector<double> q_values = QValues(state);
+  Action best = kInvalidAction;
+  for (Action action : state.LegalActions()) {
+    if (best == kInvalidAction || q_values[action] > q_values[best]) {
+      best = action;
+    }
+  }
+  return best;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
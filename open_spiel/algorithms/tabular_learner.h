@@ -0,0 +1,124 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABULAR_LEARNER_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABULAR_LEARNER_H_
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/vector_env.h"
+#include "open_spiel/spiel.h"
+
+// Tabular Q-learning and SARSA with epsilon-greedy exploration, as in
+// python/algorithms/tabular_qlearner.py, learning from a VectorEnv whose
+// environments are all stepped at once.
+//
+// Each player has a dense [num_states, NumDistinctActions()] array of
+// Q-values, whose rows are the observations (tensors, from the player's point
+// of view) met so far, in the order they were met. Observations are looked up
+// by their bytes in a hash map, so nothing is formatted as a string, and the
+// actions of the whole batch are chosen in a single pass over the rows of
+// its observations. The observations must be Markov for the player, as in
+// catch, cliff_walking, deep_sea or tic_tac_toe.
+//
+// A player's experience in an environment runs from one of its decisions to
+// the next, or to the end of the episode, and its reward is the sum of the
+// rewards received in between, whoever acted.
+namespace open_spiel {
+namespace algorithms {
+
+enum class TabularAlgorithm {
+  // Bootstraps from the best Q-value of the next observation.
+  kQLearning,
+  // Bootstraps from the Q-value of the action taken there.
+  kSarsa,
+};
+
+struct TabularLearnerConfig {
+  TabularAlgorithm algorithm = TabularAlgorithm::kQLearning;
+  double step_size = 0.5;
+  double epsilon = 0.2;
+  double discount_factor = 1.0;
+  int num_envs = 16;
+  int seed = 0;
+};
+
+class TabularLearner {
+ public:
+  TabularLearner(std::shared_ptr<const Game> game,
+                 const TabularLearnerConfig& config);
+
+  // Steps all the environments num_steps times, learning from each step.
+  void Train(int num_steps);
+
+  // The Q-values of the actions of the player to act in `state`, all 0 for
+  // observations that were never met.
+  std::vector<double> QValues(const State& state) const;
+  // The legal action with the best Q-value, the lowest one on ties.
+  Action GreedyAction(const State& state) const;
+
+  // The number of observations met by a player.
+  int NumStates(Player player) const { return indices_[player].size(); }
+  // The number of steps of single environments, and of episodes they ended.
+  int64_t NumSteps() const { return num_steps_; }
+  int64_t NumEpisodes() const { return num_episodes_; }
+
+ private:
+  // The last decision of a player in an environment, not yet learnt from.
+  struct Experience {
+    int state = -1;
+    Action action = kInvalidAction;
+    double reward = 0;
+  };
+
+  // Returns the row of the observation in the Q-values of the player, adding
+  // one if it was never met.
+  int Intern(Player player, absl::Span<const float> observation);
+  // Returns the row of the observation, or -1 if it was never met.
+  int Find(Player player, absl::Span<const float> observation) const;
+  // The epsilon-greedy action at a row.
+  Action SampleAction(Player player, int state,
+                      absl::Span<const float> legal_mask);
+  double MaxQ(Player player, int state,
+              absl::Span<const float> legal_mask) const;
+  void Update(Player player, const Experience& experience, double target);
+
+  std::shared_ptr<const Game> game_;
+  const TabularLearnerConfig config_;
+  const int num_players_;
+  const int num_actions_;
+  const int observation_size_;
+  VectorEnv env_;
+  std::mt19937 rng_;
+
+  std::vector<absl::flat_hash_map<std::string, int>> indices_;
+  std::vector<std::vector<double>> q_values_;
+  // [num_envs, num_players].
+  std::vector<Experience> experiences_;
+  std::vector<Action> actions_;
+  int64_t num_steps_ = 0;
+  int64_t num_episodes_ = 0;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TABULAR_LEARNER_H_
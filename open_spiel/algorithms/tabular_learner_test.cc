@@ -0,0 +1,124 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "open_spiel/algorithms/tabular_learner.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// The return of player 0 in an episode where the players follow the greedy
+// policy of the learner, or uniform random actions for those in `random`.
+double GreedyReturn(const Game& game, const TabularLearner& learner,
+                    std::mt19937* rng,
+                    const std::vector<Player>& random = {}) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(*rng).first);
+    } else if (absl::c_linear_search(random, state->CurrentPlayer())) {
+      const std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[std::uniform_int_distribution<int>(
+          0, actions.size() - 1)(*rng)]);
+    } else {
+      state->ApplyAction(learner.GreedyAction(*state));
+    }
+  }
+  return state->PlayerReturn(0);
+}
+
+void CatchTest() {
+  std::shared_ptr<const Game> game = LoadGame("catch");
+  TabularLearner learner(game, {});
+  learner.Train(2000);
+  SPIEL_CHECK_EQ(learner.NumSteps(), 2000 * 16);
+  SPIEL_CHECK_GT(learner.NumEpisodes(), 0);
+  std::mt19937 rng(0);
+  for (int i = 0; i < 20; ++i) {
+    SPIEL_CHECK_EQ(GreedyReturn(*game, learner, &rng), 1);
+  }
+}
+
+void CliffWalkingTest() {
+  std::shared_ptr<const Game> game = LoadGame("cliff_walking");
+  std::mt19937 rng(0);
+  // Q-learning finds the shortest path, along the cliff. SARSA, which learns
+  // the values of its exploration, keeps further from it.
+  TabularLearner q_learner(game, {});
+  q_learner.Train(3000);
+  SPIEL_CHECK_EQ(GreedyReturn(*game, q_learner, &rng), -9);
+  TabularLearnerConfig config;
+  config.algorithm = TabularAlgorithm::kSarsa;
+  config.step_size = 0.1;
+  config.epsilon = 0.1;
+  TabularLearner sarsa_learner(game, config);
+  sarsa_learner.Train(20000);
+  const double sarsa_return = GreedyReturn(*game, sarsa_learner, &rng);
+  SPIEL_CHECK_LT(sarsa_return, -9);
+  SPIEL_CHECK_GT(sarsa_return, -20);
+}
+
+void DeepSeaTest() {
+  std::shared_ptr<const Game> game =
+      LoadGame("deep_sea", {{"size", GameParameter(5)}});
+  // The reward is too deep for epsilon-greedy exploration to find it, but
+  // Q-learning is off-policy, so it learns the optimal policy from uniform
+  // random play, which reaches the reward every 2^5 episodes.
+  TabularLearnerConfig config;
+  config.epsilon = 1;
+  TabularLearner learner(game, config);
+  learner.Train(2000);
+  std::mt19937 rng(0);
+  SPIEL_CHECK_FLOAT_NEAR(GreedyReturn(*game, learner, &rng), 0.99, 1e-9);
+  // The observations are the positions of the diver.
+  SPIEL_CHECK_LE(learner.NumStates(0), 5 * 5);
+}
+
+void TicTacToeTest() {
+  // Q-learning in self-play, whose greedy policy should not lose against
+  // random play too often.
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  TabularLearnerConfig config;
+  config.num_envs = 64;
+  TabularLearner learner(game, config);
+  learner.Train(20000);
+  SPIEL_CHECK_GT(learner.NumStates(0), 0);
+  SPIEL_CHECK_GT(learner.NumStates(1), 0);
+  std::mt19937 rng(0);
+  int num_losses = 0;
+  for (int i = 0; i < 100; ++i) {
+    num_losses += GreedyReturn(*game, learner, &rng, {1}) < 0;
+  }
+  SPIEL_CHECK_LT(num_losses, 10);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::CatchTest();
+  open_spiel::algorithms::CliffWalkingTest();
+  open_spiel::algorithms::DeepSeaTest();
+  open_spiel::algorithms::TicTacToeTest();
+}
@@ -14,6 +14,15 @@
 
 #include "open_spiel/algorithms/tensor_game_utils.h"
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/tensor_game.h"
+
 namespace open_spiel {
 namespace algorithms {
 namespace {
@@ -33,10 +42,131 @@ void ConvertToTensorGameTest() {
             << tensor_blotto->PlayerUtility(Player{2}, {0, 15, 3}) << std::endl;
 }
 
+void PayoffKernelsTest() {
+  // The kernels agree with sums over the joint actions.
+  std::shared_ptr<const tensor_game::TensorGame> game =
+      LoadTensorGame("blotto(players=3,coins=6)");
+  const int num_players = game->NumPlayers();
+  std::vector<std::vector<double>> strategies(num_players);
+  for (Player player = 0; player < num_players; ++player) {
+    const int num_actions = game->Shape()[player];
+    for (int a = 0; a < num_actions; ++a) {
+      strategies[player].push_back((a + player) % 4 == 0 ? 1 : 0.5);
+    }
+    const double sum = std::accumulate(strategies[player].begin(),
+                                       strategies[player].end(), 0.);
+    for (double& probability : strategies[player]) probability /= sum;
+  }
+  std::vector<absl::Span<const double>> spans(strategies.begin(),
+                                              strategies.end());
+
+  std::vector<double> payoffs(num_players, 0);
+  std::vector<std::vector<double>> values(num_players);
+  for (Player player = 0; player < num_players; ++player) {
+    values[player].resize(game->Shape()[player], 0);
+  }
+  std::vector<Action> actions(num_players, 0);
+  while (true) {
+    for (Player player = 0; player < num_players; ++player) {
+      double others_probability = 1;
+      for (Player other = 0; other < num_players; ++other) {
+        if (other != player) {
+          others_probability *= strategies[other][actions[other]];
+        }
+      }
+      const double utility = game->PlayerUtility(player, actions);
+      values[player][actions[player]] += others_probability * utility;
+      payoffs[player] +=
+          others_probability * strategies[player][actions[player]] * utility;
+    }
+    Player player = num_players - 1;
+    for (; player >= 0; --player) {
+      if (++actions[player] < game->Shape()[player]) break;
+      actions[player] = 0;
+    }
+    if (player < 0) break;
+  }
+
+  const std::vector<double> kernel_payoffs = game->ExpectedPayoffs(spans);
+  for (Player player = 0; player < num_players; ++player) {
+    SPIEL_CHECK_FLOAT_NEAR(kernel_payoffs[player], payoffs[player], 1e-12);
+    const std::vector<double> kernel_values =
+        game->ActionValues(player, spans);
+    for (int a = 0; a < game->Shape()[player]; ++a) {
+      SPIEL_CHECK_FLOAT_NEAR(kernel_values[a], values[player][a], 1e-12);
+    }
+    const Action best_response = game->BestResponse(player, spans);
+    SPIEL_CHECK_FLOAT_EQ(values[player][best_response],
+                         *std::max_element(values[player].begin(),
+                                           values[player].end()));
+  }
+}
+
+void LazyTensorGameTest() {
+  // A game of six players with twenty actions each, whose utilities are only
+  // computed for the joint actions that are played.
+  constexpr int kNumPlayers = 6;
+  constexpr int kNumActions = 20;
+  std::vector<std::vector<std::string>> action_names(kNumPlayers);
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    for (int a = 0; a < kNumActions; ++a) {
+      action_names[player].push_back(absl::StrCat("a", a));
+    }
+  }
+  int num_oracle_calls = 0;
+  auto oracle = [&num_oracle_calls](const std::vector<Action>& actions) {
+    ++num_oracle_calls;
+    std::vector<double> utilities(actions.size());
+    for (int player = 0; player < actions.size(); ++player) {
+      utilities[player] = actions[player] - actions[(player + 1) % kNumPlayers];
+    }
+    return utilities;
+  };
+  std::shared_ptr<tensor_game::LazyTensorGame> game =
+      tensor_game::CreateLazyTensorGame("lazy", "Lazy", action_names, oracle,
+                                        -kNumActions, kNumActions,
+                                        /*num_oracle_samples=*/2,
+                                        GameType::Utility::kZeroSum);
+  SPIEL_CHECK_EQ(game->NumPlayers(), kNumPlayers);
+  SPIEL_CHECK_EQ(game->NumEntries(), 0);
+
+  const std::vector<Action> actions = {3, 1, 4, 1, 5, 9};
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyActions(actions);
+  SPIEL_CHECK_EQ(state->Returns(), oracle(actions));
+  SPIEL_CHECK_EQ(state->Returns(), game->Utilities(actions));
+  // The entry was sampled twice, when first asked for.
+  SPIEL_CHECK_EQ(num_oracle_calls, 2 + 1);
+  SPIEL_CHECK_EQ(game->NumSamples(actions), 2);
+  SPIEL_CHECK_EQ(game->NumEntries(), 1);
+
+  // Added samples are averaged, and the oracle is not asked for them.
+  const std::vector<Action> other_actions = {0, 0, 0, 0, 0, 1};
+  game->AddSample(other_actions, {1, 0, 0, 0, 0, -1});
+  game->AddSample(other_actions, {0, 0, 0, 0, -1, 1});
+  SPIEL_CHECK_EQ(game->Utilities(other_actions),
+                 (std::vector<double>{0.5, 0, 0, 0, -0.5, 0}));
+  SPIEL_CHECK_EQ(num_oracle_calls, 3);
+  SPIEL_CHECK_EQ(game->NumEntries(), 2);
+
+  // The clone keeps the samples.
+  std::shared_ptr<const Game> clone = game->Clone();
+  SPIEL_CHECK_EQ(
+      static_cast<const tensor_game::LazyTensorGame&>(*clone).NumEntries(), 2);
+
+  state = clone->NewInitialState();
+  SPIEL_CHECK_EQ(state->LegalActions(2).size(), kNumActions);
+  SPIEL_CHECK_EQ(state->ActionToString(2, 7), "a7");
+  state->ApplyActions(other_actions);
+  SPIEL_CHECK_EQ(state->Returns(), game->Utilities(other_actions));
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::algorithms::ConvertToTensorGameTest();
+  open_spiel::algorithms::PayoffKernelsTest();
+  open_spiel::algorithms::LazyTensorGameTest();
 }
@@ -14,16 +14,32 @@
 
 #include "open_spiel/algorithms/trajectories.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <array>
 #include <chrono>  // NOLINT
 #include <cstdint>
+#include <cstring>
 #include <random>
 #include <unordered_map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/random.h"
+#include "open_spiel/utils/thread_pool.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -39,6 +55,237 @@ std::string StateKey(const Game& game, const State& state,
   }
   return state.ToString();
 }
+
+// The steps of one episode, in flat buffers.
+struct Episode {
+  std::vector<float> observations;
+  std::vector<int> state_indices;
+  std::vector<uint8_t> legal_actions;
+  std::vector<Action> actions;
+  std::vector<float> player_policies;
+  std::vector<int> player_ids;
+  std::vector<double> returns;
+};
+
+// Plays an episode into `episode`, recording the observations if
+// record_observations, and otherwise the state indices. At each decision,
+// step(state, player, legal_actions, probs, state_index) writes the
+// probabilities of the actions into the zeroed `probs`, sets the state index
+// if it is not null, and returns the sampled action.
+template <typename Rng, typename StepFunction>
+void PlayEpisode(const Game& game, const State& initial_state,
+                 bool record_observations, Rng* rng,
+                 const StepFunction& step, Episode* episode) {
+  const int num_distinct_actions = game.NumDistinctActions();
+  const int observation_size =
+      record_observations ? game.InformationStateTensorSize() : 0;
+  std::unique_ptr<State> state = initial_state.Clone();
+  while (!state->IsTerminal()) {
+    Action action = kInvalidAction;
+    if (state->IsChanceNode()) {
+      action = SampleAction(
+                   state->ChanceOutcomes(),
+                   std::uniform_real_distribution<double>(0.0, 1.0)(*rng))
+                   .first;
+    } else if (state->IsSimultaneousNode()) {
+      SpielFatalError("We do not support games with simultaneous actions.");
+    } else {
+      const Player player = state->CurrentPlayer();
+      const std::vector<Action> legal_actions = state->LegalActions();
+      const int step_index = episode->actions.size();
+      const int first_action = step_index * num_distinct_actions;
+      episode->legal_actions.resize(first_action + num_distinct_actions, 0);
+      for (Action legal_action : legal_actions) {
+        episode->legal_actions[first_action + legal_action] = 1;
+      }
+      if (record_observations) {
+        episode->observations.resize((step_index + 1) * observation_size);
+        state->InformationStateTensor(
+            player,
+            absl::MakeSpan(episode->observations)
+                .subspan(step_index * observation_size, observation_size));
+      }
+      episode->player_policies.resize(first_action + num_distinct_actions, 0);
+      int state_index = 0;
+      action = step(*state, player, legal_actions,
+                    absl::MakeSpan(episode->player_policies)
+                        .subspan(first_action, num_distinct_actions),
+                    record_observations ? nullptr : &state_index);
+      if (!record_observations) episode->state_indices.push_back(state_index);
+      episode->player_ids.push_back(player);
+      episode->actions.push_back(action);
+    }
+    SPIEL_CHECK_NE(action, kInvalidAction);
+    state->ApplyAction(action);
+  }
+  episode->returns = state->Returns();
+}
+
+// Plays an episode as RecordTrajectory does, drawing the same random numbers.
+template <typename Rng>
+void RecordEpisode(const Game& game, const std::vector<TabularPolicy>& policies,
+                   const State& initial_state,
+                   const std::unordered_map<std::string, int>& state_to_index,
+                   Rng* rng, Episode* episode) {
+  auto step = [&](const State& state, Player player,
+                  const std::vector<Action>& legal_actions,
+                  absl::Span<float> probs, int* state_index) {
+    if (state_index != nullptr) {
+      auto it = state_to_index.find(StateKey(game, state));
+      SPIEL_CHECK_TRUE(it != state_to_index.end());
+      *state_index = it->second;
+    }
+    ActionsAndProbs policy =
+        policies.at(player).GetStatePolicy(state.InformationStateString());
+    if (policy.size() > legal_actions.size()) {
+      SpielFatalError(absl::StrCat(
+          "There are more actions than legal actions from ",
+          typeid(policies.at(player)).name(),
+          "\n Legal actions are: ", absl::StrJoin(legal_actions, " ")));
+    }
+    for (const auto& [action, prob] : policy) probs[action] = prob;
+    return SampleAction(policy, *rng).first;
+  };
+  PlayEpisode(game, initial_state, state_to_index.empty(), rng, step, episode);
+}
+
+// Plays an episode following a dense policy matrix, indexing the states by
+// State::InformationStateIndex. The actions are sampled as by SampleAction,
+// so a matrix of the same policies as RecordEpisode's gives the same episode.
+void RecordIndexedEpisode(const Game& game,
+                          absl::Span<const double> policy_matrix,
+                          const State& initial_state, bool record_observations,
+                          std::mt19937* rng, Episode* episode) {
+  const int num_distinct_actions = game.NumDistinctActions();
+  auto step = [&](const State& state, Player player,
+                  const std::vector<Action>& legal_actions,
+                  absl::Span<float> probs, int* state_index) {
+    const int64_t info_state = state.InformationStateIndex(player);
+    if (state_index != nullptr) *state_index = info_state;
+    const double* row = &policy_matrix[info_state * num_distinct_actions];
+    const double z = absl::Uniform(*rng, 0.0, 1.0);
+    double sum = 0;
+    Action sampled_action = kInvalidAction;
+    for (Action action : legal_actions) {
+      probs[action] = row[action];
+      if (sampled_action == kInvalidAction && z < sum + row[action]) {
+        sampled_action = action;
+      }
+      sum += row[action];
+    }
+    SPIEL_CHECK_FLOAT_EQ(sum, 1.0);
+    // Rounding can leave z above the sum of the probabilities.
+    if (sampled_action == kInvalidAction) sampled_action = legal_actions.back();
+    return sampled_action;
+  };
+  PlayEpisode(game, initial_state, record_observations, rng, step, episode);
+}
+
+// Copies the episodes into the padded fields of a trajectory, one episode per
+// task.
+ContiguousBatchedTrajectory PackEpisodes(const Game& game,
+                                         bool has_observations,
+                                         const std::vector<Episode>& episodes,
+                                         int max_unroll_length,
+                                         int num_threads) {
+  const int batch_size = episodes.size();
+  int max_length = 0;
+  for (const Episode& episode : episodes) {
+    max_length = std::max<int>(max_length, episode.actions.size());
+  }
+  if (max_unroll_length > 0) {
+    SPIEL_CHECK_GE(max_unroll_length, max_length);
+    max_length = max_unroll_length;
+  }
+
+  ContiguousBatchedTrajectory trajectory;
+  trajectory.batch_size = batch_size;
+  trajectory.max_trajectory_length = max_length;
+  trajectory.observation_size =
+      has_observations ? game.InformationStateTensorSize() : 0;
+  trajectory.num_distinct_actions = game.NumDistinctActions();
+  trajectory.num_players = game.NumPlayers();
+  const int num_steps = batch_size * max_length;
+  const int num_actions = trajectory.num_distinct_actions;
+  // The padding is the same as that of ResizeFields.
+  trajectory.observations.resize(num_steps * trajectory.observation_size, 0);
+  trajectory.state_indices.resize(has_observations ? 0 : num_steps, 0);
+  trajectory.legal_actions.resize(num_steps * num_actions, 1);
+  trajectory.actions.resize(num_steps, 0);
+  trajectory.player_policies.resize(num_steps * num_actions, 1);
+  trajectory.player_ids.resize(num_steps, 0);
+  trajectory.rewards.resize(batch_size * trajectory.num_players);
+  trajectory.valid.resize(num_steps, false);
+  trajectory.next_is_terminal.resize(num_steps, false);
+  auto pack = [&](int b) {
+    const Episode& episode = episodes[b];
+    const int length = episode.actions.size();
+    const int first_step = b * max_length;
+    absl::c_copy(episode.observations,
+                 trajectory.observations.begin() +
+                     first_step * trajectory.observation_size);
+    absl::c_copy(episode.state_indices,
+                 trajectory.state_indices.begin() + first_step);
+    absl::c_copy(episode.legal_actions,
+                 trajectory.legal_actions.begin() + first_step * num_actions);
+    absl::c_copy(episode.actions, trajectory.actions.begin() + first_step);
+    absl::c_copy(episode.player_policies,
+                 trajectory.player_policies.begin() + first_step * num_actions);
+    absl::c_copy(episode.player_ids,
+                 trajectory.player_ids.begin() + first_step);
+    absl::c_copy(episode.returns,
+                 trajectory.rewards.begin() + b * trajectory.num_players);
+    std::fill_n(trajectory.valid.begin() + first_step, length, true);
+    if (length > 0) {
+      trajectory.next_is_terminal[first_step + length - 1] = true;
+    }
+  };
+  ThreadPool::Default().ParallelFor(0, batch_size, pack, /*grain_size=*/1,
+                                    num_threads);
+  return trajectory;
+}
+
+// The header of trajectory files: the magic string, then the observation
+// size, number of distinct actions, number of players and steps per chunk as
+// int32, the numbers of steps and episodes as int64, and padding.
+constexpr char kTrajectoryMagic[8] = {'O', 'S', 'T', 'R', 'A', 'J', '0', '1'};
+constexpr int kTrajectoryHeaderSize = 64;
+constexpr int kNumTrajectoryColumns = 8;
+
+// Returns the widths of the records of the columns of trajectory files, in
+// the order of TrajectoryReader::Column, widest types first for alignment.
+std::array<int64_t, kNumTrajectoryColumns> TrajectoryColumnWidths(
+    int observation_size, int num_distinct_actions, int num_players) {
+  return {sizeof(int64_t),
+          static_cast<int64_t>(sizeof(float)) * std::max(observation_size, 1),
+          sizeof(int32_t),
+          static_cast<int64_t>(sizeof(float)) * num_distinct_actions,
+          sizeof(int32_t),
+          static_cast<int64_t>(sizeof(float)) * num_players,
+          num_distinct_actions,
+          1};
+}
+
+// Returns the offsets of the columns in a chunk, and sets chunk_size.
+std::array<int64_t, kNumTrajectoryColumns> TrajectoryColumnOffsets(
+    const std::array<int64_t, kNumTrajectoryColumns>& widths,
+    int steps_per_chunk, int64_t* chunk_size) {
+  std::array<int64_t, kNumTrajectoryColumns> offsets;
+  int64_t offset = 0;
+  for (int c = 0; c < kNumTrajectoryColumns; ++c) {
+    offsets[c] = offset;
+    offset += widths[c] * steps_per_chunk;
+  }
+  *chunk_size = offset;
+  return offsets;
+}
+
+void AppendInt32(int32_t value, std::string* header) {
+  header->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+void AppendInt64(int64_t value, std::string* header) {
+  header->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
 }  // namespace
 
 // Initializes a BatchedTrajectory of size [batch_size, T].
@@ -131,6 +378,194 @@ BatchedTrajectory RecordBatchedTrajectory(
   return batched_trajectory;
 }
 
+ContiguousBatchedTrajectory RecordContiguousBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, std::mt19937* rng_ptr,
+    int max_unroll_length) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
+  std::vector<Episode> episodes(batch_size);
+  for (Episode& episode : episodes) {
+    RecordEpisode(game, policies, initial_state, state_to_index, rng_ptr,
+                  &episode);
+  }
+  return PackEpisodes(game, state_to_index.empty(), episodes,
+                      max_unroll_length, /*num_threads=*/1);
+}
+
+ContiguousBatchedTrajectory RecordContiguousBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, int seed, int max_unroll_length) {
+  std::mt19937 rng(seed);
+  std::unique_ptr<State> state = game.NewInitialState();
+  return RecordContiguousBatchedTrajectory(
+      game, policies, *state, state_to_index, batch_size,
+      include_full_observations, &rng, max_unroll_length);
+}
+
+std::vector<double> DensePolicyMatrix(
+    const Game& game, const std::vector<TabularPolicy>& policies) {
+  const int64_t num_info_states = game.NumInformationStates();
+  if (num_info_states <= 0) {
+    SpielFatalError("The game does not provide information state indices.");
+  }
+  const int num_distinct_actions = game.NumDistinctActions();
+  std::vector<double> policy_matrix(num_info_states * num_distinct_actions, 0);
+  std::vector<char> filled(num_info_states, false);
+  std::vector<std::unique_ptr<State>> to_visit;
+  to_visit.push_back(game.NewInitialState());
+  while (!to_visit.empty()) {
+    std::unique_ptr<State> state = std::move(to_visit.back());
+    to_visit.pop_back();
+    if (state->IsTerminal()) continue;
+    if (!state->IsChanceNode()) {
+      const Player player = state->CurrentPlayer();
+      const int64_t info_state = state->InformationStateIndex(player);
+      if (!filled[info_state]) {
+        filled[info_state] = true;
+        for (const auto& [action, prob] : policies.at(player).GetStatePolicy(
+                 state->InformationStateString(player))) {
+          policy_matrix[info_state * num_distinct_actions + action] = prob;
+        }
+      }
+    }
+    for (Action action : state->LegalActions()) {
+      to_visit.push_back(state->Child(action));
+    }
+  }
+  return policy_matrix;
+}
+
+ContiguousBatchedTrajectory RecordIndexedBatchedTrajectory(
+    const Game& game, absl::Span<const double> policy_matrix,
+    const State& initial_state, int batch_size, bool include_full_observations,
+    std::mt19937* rng_ptr, int max_unroll_length) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_EQ(policy_matrix.size(),
+                 game.NumInformationStates() * game.NumDistinctActions());
+  std::vector<Episode> episodes(batch_size);
+  for (Episode& episode : episodes) {
+    RecordIndexedEpisode(game, policy_matrix, initial_state,
+                         include_full_observations, rng_ptr, &episode);
+  }
+  return PackEpisodes(game, include_full_observations, episodes,
+                      max_unroll_length, /*num_threads=*/1);
+}
+
+ContiguousBatchedTrajectory RecordInferenceBatchedTrajectory(
+    const Game& game, const InferenceModel& model, const State& initial_state,
+    int batch_size, std::mt19937* rng_ptr, int max_unroll_length) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  const int input_size = game.InformationStateTensorSize();
+  const int num_actions = game.NumDistinctActions();
+  SPIEL_CHECK_EQ(model.InputSize(), input_size);
+  SPIEL_CHECK_EQ(model.NumActions(), num_actions);
+  std::vector<std::unique_ptr<State>> states(batch_size);
+  for (auto& state : states) state = initial_state.Clone();
+  std::vector<Episode> episodes(batch_size);
+  // The episodes at a decision node, in the rows of the buffers.
+  std::vector<int> rows;
+  std::vector<float> inputs;
+  std::vector<float> legal_masks;
+  std::vector<float> policies;
+  while (true) {
+    rows.clear();
+    for (int b = 0; b < batch_size; ++b) {
+      State& state = *states[b];
+      while (state.IsChanceNode()) {
+        state.ApplyAction(state.SampleChanceOutcome(*rng_ptr).first);
+      }
+      if (state.IsTerminal()) continue;
+      if (state.IsSimultaneousNode()) {
+        SpielFatalError("We do not support games with simultaneous actions.");
+      }
+      rows.push_back(b);
+    }
+    if (rows.empty()) break;
+    const int num_rows = rows.size();
+    inputs.resize(num_rows * input_size);
+    legal_masks.resize(num_rows * num_actions);
+    policies.resize(num_rows * num_actions);
+    for (int r = 0; r < num_rows; ++r) {
+      FillInferenceRow(
+          *states[rows[r]],
+          absl::MakeSpan(inputs).subspan(r * input_size, input_size),
+          absl::MakeSpan(legal_masks).subspan(r * num_actions, num_actions));
+    }
+    model.Infer(num_rows, inputs, legal_masks, absl::MakeSpan(policies),
+                /*values=*/{});
+    for (int r = 0; r < num_rows; ++r) {
+      State& state = *states[rows[r]];
+      Episode& episode = episodes[rows[r]];
+      const float* input = &inputs[r * input_size];
+      const float* mask = &legal_masks[r * num_actions];
+      const float* policy = &policies[r * num_actions];
+      episode.observations.insert(episode.observations.end(), input,
+                                  input + input_size);
+      episode.legal_actions.insert(episode.legal_actions.end(), mask,
+                                   mask + num_actions);
+      episode.player_policies.insert(episode.player_policies.end(), policy,
+                                     policy + num_actions);
+      episode.player_ids.push_back(state.CurrentPlayer());
+      const double z = absl::Uniform(*rng_ptr, 0.0, 1.0);
+      double sum = 0;
+      Action action = kInvalidAction;
+      for (Action a = 0; a < num_actions; ++a) {
+        if (mask[a] == 0) continue;
+        if (action == kInvalidAction && z < sum + policy[a]) action = a;
+        sum += policy[a];
+      }
+      // Rounding can leave z above the sum of the probabilities.
+      for (Action a = num_actions - 1; action == kInvalidAction; --a) {
+        if (mask[a] != 0) action = a;
+      }
+      episode.actions.push_back(action);
+      state.ApplyAction(action);
+    }
+  }
+  for (int b = 0; b < batch_size; ++b) {
+    episodes[b].returns = states[b]->Returns();
+  }
+  return PackEpisodes(game, /*has_observations=*/true, episodes,
+                      max_unroll_length, /*num_threads=*/1);
+}
+
+ContiguousBatchedTrajectory RecordParallelBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, int seed, int max_unroll_length,
+    int num_threads) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
+  std::vector<Episode> episodes(batch_size);
+  auto record = [&](int b) {
+    // Seeding an std::mt19937 would cost more than many episodes.
+    Xoshiro256PlusPlus rng = Xoshiro256PlusPlus::Stream(seed, b);
+    RecordEpisode(game, policies, initial_state, state_to_index, &rng,
+                  &episodes[b]);
+  };
+  ThreadPool::Default().ParallelFor(0, batch_size, record, /*grain_size=*/1,
+                                    num_threads);
+  return PackEpisodes(game, state_to_index.empty(), episodes,
+                      max_unroll_length, num_threads);
+}
+
+ContiguousBatchedTrajectory RecordParallelBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, int seed, int max_unroll_length,
+    int num_threads) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  return RecordParallelBatchedTrajectory(
+      game, policies, *state, state_to_index, batch_size,
+      include_full_observations, seed, max_unroll_length, num_threads);
+}
+
 BatchedTrajectory RecordTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const State& initial_state,
@@ -230,5 +665,166 @@ BatchedTrajectory RecordTrajectory(
                           include_full_observations, rng_ptr);
 }
 
+TrajectoryWriter::TrajectoryWriter(const std::string& path, const Game& game,
+                                   bool include_observations,
+                                   int steps_per_chunk)
+    : file_(path, "wb"),
+      observation_size_(
+          include_observations ? game.InformationStateTensorSize() : 0),
+      num_distinct_actions_(game.NumDistinctActions()),
+      num_players_(game.NumPlayers()),
+      steps_per_chunk_(steps_per_chunk) {
+  SPIEL_CHECK_GT(steps_per_chunk, 0);
+  SPIEL_CHECK_EQ(steps_per_chunk % 8, 0);
+  int64_t chunk_size;
+  TrajectoryColumnOffsets(
+      TrajectoryColumnWidths(observation_size_, num_distinct_actions_,
+                             num_players_),
+      steps_per_chunk_, &chunk_size);
+  chunk_.assign(chunk_size, 0);
+  // The header is written again with the numbers of steps by Close.
+  SPIEL_CHECK_TRUE(file_.Write(std::string(kTrajectoryHeaderSize, 0)));
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+  if (!closed_) Close();
+}
+
+void TrajectoryWriter::Append(const ContiguousBatchedTrajectory& trajectory) {
+  SPIEL_CHECK_FALSE(closed_);
+  SPIEL_CHECK_EQ(trajectory.observation_size, observation_size_);
+  SPIEL_CHECK_EQ(trajectory.num_distinct_actions, num_distinct_actions_);
+  SPIEL_CHECK_EQ(trajectory.num_players, num_players_);
+  const std::array<int64_t, kNumTrajectoryColumns> widths =
+      TrajectoryColumnWidths(observation_size_, num_distinct_actions_,
+                             num_players_);
+  int64_t chunk_size;
+  const std::array<int64_t, kNumTrajectoryColumns> offsets =
+      TrajectoryColumnOffsets(widths, steps_per_chunk_, &chunk_size);
+  // Copies a record of column c from `data`.
+  auto write = [&](int c, const void* data) {
+    std::memcpy(&chunk_[offsets[c] + num_chunk_steps_ * widths[c]], data,
+                widths[c]);
+  };
+  const int length = trajectory.max_trajectory_length;
+  const int num_actions = num_distinct_actions_;
+  for (int b = 0; b < trajectory.batch_size; ++b) {
+    for (int t = 0; t < length; ++t) {
+      const int step = b * length + t;
+      if (!trajectory.valid[step]) continue;
+      write(0, &num_episodes_);
+      if (observation_size_ > 0) {
+        write(1, &trajectory.observations[step * observation_size_]);
+      } else {
+        const int32_t state_index = trajectory.state_indices[step];
+        write(1, &state_index);
+      }
+      const int32_t action = trajectory.actions[step];
+      write(2, &action);
+      write(3, &trajectory.player_policies[step * num_actions]);
+      const int32_t player = trajectory.player_ids[step];
+      write(4, &player);
+      write(5, &trajectory.rewards[b * num_players_]);
+      write(6, &trajectory.legal_actions[step * num_actions]);
+      write(7, &trajectory.next_is_terminal[step]);
+      ++num_steps_;
+      if (++num_chunk_steps_ == steps_per_chunk_) WriteChunk();
+    }
+    ++num_episodes_;
+  }
+}
+
+void TrajectoryWriter::WriteChunk() {
+  SPIEL_CHECK_TRUE(file_.Write(absl::string_view(chunk_.data(),
+                                                 chunk_.size())));
+  std::fill(chunk_.begin(), chunk_.end(), 0);
+  num_chunk_steps_ = 0;
+}
+
+void TrajectoryWriter::Close() {
+  SPIEL_CHECK_FALSE(closed_);
+  closed_ = true;
+  if (num_chunk_steps_ > 0) WriteChunk();
+  std::string header(kTrajectoryMagic, sizeof(kTrajectoryMagic));
+  AppendInt32(observation_size_, &header);
+  AppendInt32(num_distinct_actions_, &header);
+  AppendInt32(num_players_, &header);
+  AppendInt32(steps_per_chunk_, &header);
+  AppendInt64(num_steps_, &header);
+  AppendInt64(num_episodes_, &header);
+  header.resize(kTrajectoryHeaderSize, 0);
+  SPIEL_CHECK_TRUE(file_.Seek(0));
+  SPIEL_CHECK_TRUE(file_.Write(header));
+  SPIEL_CHECK_TRUE(file_.Flush());
+}
+
+std::unique_ptr<TrajectoryReader> TrajectoryReader::Open(
+    const std::string& path) {
+  std::string header;
+  {
+    file::File file(path, "rb");
+    header = file.Read(kTrajectoryHeaderSize);
+  }
+  if (header.size() != kTrajectoryHeaderSize ||
+      std::memcmp(header.data(), kTrajectoryMagic,
+                  sizeof(kTrajectoryMagic)) != 0) {
+    SpielFatalError(absl::StrCat(path, " is not a trajectory file."));
+  }
+  std::unique_ptr<TrajectoryReader> reader(new TrajectoryReader());
+  const char* fields = header.data() + sizeof(kTrajectoryMagic);
+  int32_t sizes[4];
+  std::memcpy(sizes, fields, sizeof(sizes));
+  reader->observation_size_ = sizes[0];
+  reader->num_distinct_actions_ = sizes[1];
+  reader->num_players_ = sizes[2];
+  reader->steps_per_chunk_ = sizes[3];
+  std::memcpy(&reader->num_steps_, fields + sizeof(sizes), sizeof(int64_t));
+  std::memcpy(&reader->num_episodes_, fields + sizeof(sizes) + sizeof(int64_t),
+              sizeof(int64_t));
+  SPIEL_CHECK_GT(reader->steps_per_chunk_, 0);
+  const std::array<int64_t, kNumTrajectoryColumns> widths =
+      TrajectoryColumnWidths(reader->observation_size_,
+                             reader->num_distinct_actions_,
+                             reader->num_players_);
+  const std::array<int64_t, kNumTrajectoryColumns> offsets =
+      TrajectoryColumnOffsets(widths, reader->steps_per_chunk_,
+                              &reader->chunk_size_);
+  for (int c = 0; c < kNumColumns; ++c) {
+    reader->column_widths_[c] = widths[c];
+    reader->column_offsets_[c] = offsets[c];
+  }
+  const int64_t num_chunks =
+      (reader->num_steps_ + reader->steps_per_chunk_ - 1) /
+      reader->steps_per_chunk_;
+  const int64_t size = kTrajectoryHeaderSize + num_chunks * reader->chunk_size_;
+#ifdef _WIN32
+  std::string contents = file::File(path, "rb").ReadContents();
+  SPIEL_CHECK_EQ(contents.size(), size);
+  reader->owned_data_ = contents.substr(kTrajectoryHeaderSize);
+  reader->data_ = reader->owned_data_.data();
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  SPIEL_CHECK_GE(fd, 0);
+  struct stat file_stat;
+  SPIEL_CHECK_EQ(fstat(fd, &file_stat), 0);
+  SPIEL_CHECK_EQ(file_stat.st_size, size);
+  void* mapped_data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped_data == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Could not map ", path, "."));
+  }
+  reader->mapped_data_ = mapped_data;
+  reader->mapped_size_ = size;
+  reader->data_ = static_cast<const char*>(mapped_data) + kTrajectoryHeaderSize;
+#endif
+  return reader;
+}
+
+TrajectoryReader::~TrajectoryReader() {
+#ifndef _WIN32
+  if (mapped_data_ != nullptr) munmap(mapped_data_, mapped_size_);
+#endif
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -15,14 +15,21 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORIES_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORIES_H_
 
+#include <array>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <random>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/batched_inference.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -72,6 +79,43 @@ struct BatchedTrajectory {
   uint64_t max_trajectory_length = 0;
 };
 
+// The fields of a BatchedTrajectory in contiguous, row-major buffers, padded
+// in the same way as by ResizeFields, so that they can be handed to ML
+// frameworks without copies. With B the batch size, T the maximum trajectory
+// length, N the size of the information state tensor and A the number of
+// distinct actions, the fields have shapes:
+//   observations, player_policies: [B, T, N] and [B, T, A] floats
+//   legal_actions: a [B, T, A] mask
+//   state_indices, actions, player_ids, valid, next_is_terminal: [B, T]
+//   rewards: [B, num_players] floats
+struct ContiguousBatchedTrajectory {
+  int batch_size = 0;
+  int max_trajectory_length = 0;
+  // 0 when the state indices are recorded instead of the observations.
+  int observation_size = 0;
+  int num_distinct_actions = 0;
+  int num_players = 0;
+
+  std::vector<float> observations;
+  std::vector<int> state_indices;
+  std::vector<uint8_t> legal_actions;
+  std::vector<Action> actions;
+  std::vector<float> player_policies;
+  std::vector<int> player_ids;
+  std::vector<float> rewards;
+  std::vector<uint8_t> valid;
+  std::vector<uint8_t> next_is_terminal;
+
+  // The shape of a [B, T, step_size] field, and its strides, in elements.
+  std::vector<int64_t> FieldShape(int step_size) const {
+    return {batch_size, max_trajectory_length, step_size};
+  }
+  std::vector<int64_t> FieldStrides(int step_size) const {
+    return {static_cast<int64_t>(max_trajectory_length) * step_size,
+            step_size, 1};
+  }
+};
+
 // If include_full_observations is true, then we record the result of
 // open_spiel::State::InformationStateTensor(); otherwise, we store
 // the index (taken from state_to_index).
@@ -104,6 +148,67 @@ BatchedTrajectory RecordBatchedTrajectory(
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, int seed, int max_unroll_length = -1);
 
+// Same as RecordBatchedTrajectory, with the same use of the random numbers,
+// but writing the steps straight into flat buffers, and then in a single copy
+// into the contiguous fields.
+ContiguousBatchedTrajectory RecordContiguousBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, std::mt19937* rng_ptr,
+    int max_unroll_length = -1);
+
+ContiguousBatchedTrajectory RecordContiguousBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, int seed, int max_unroll_length = -1);
+
+// Records the episodes of the batch on up to num_threads threads of
+// ThreadPool::Default(), each episode with its own random number generator,
+// seeded from `seed` and the index of the episode in the batch. The result thus does not depend on num_threads,
+// but differs from that of RecordContiguousBatchedTrajectory with the same
+// seed. The policies are read concurrently.
+ContiguousBatchedTrajectory RecordParallelBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, int seed, int max_unroll_length,
+    int num_threads);
+
+ContiguousBatchedTrajectory RecordParallelBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index, int batch_size,
+    bool include_full_observations, int seed, int max_unroll_length,
+    int num_threads);
+
+// Returns the policies of the players as a dense, row-major
+// [Game::NumInformationStates(), Game::NumDistinctActions()] matrix of action
+// probabilities, by State::InformationStateIndex, for games providing them.
+// The whole game tree is walked, so this is for small games.
+std::vector<double> DensePolicyMatrix(
+    const Game& game, const std::vector<TabularPolicy>& policies);
+
+// Same as RecordContiguousBatchedTrajectory, following a dense policy matrix
+// such as DensePolicyMatrix returns, so each step takes an array lookup
+// instead of building and hashing information state strings. Unless
+// include_full_observations, the state indices are the
+// State::InformationStateIndex of the player to move. The random numbers are
+// drawn in the same way, so the matrix of `policies` gives the same
+// trajectories as RecordContiguousBatchedTrajectory with `policies`.
+ContiguousBatchedTrajectory RecordIndexedBatchedTrajectory(
+    const Game& game, absl::Span<const double> policy_matrix,
+    const State& initial_state, int batch_size, bool include_full_observations,
+    std::mt19937* rng_ptr, int max_unroll_length = -1);
+
+// Records the episodes of the batch in lockstep, following the policy of
+// `model`: at each step, the decision nodes of all the episodes still running
+// are run in a single call to InferenceModel::Infer, on their observations,
+// which are recorded. The actions are then sampled from the policies as by
+// SampleAction, in the order of the episodes.
+ContiguousBatchedTrajectory RecordInferenceBatchedTrajectory(
+    const Game& game, const InferenceModel& model, const State& initial_state,
+    int batch_size, std::mt19937* rng_ptr, int max_unroll_length = -1);
+
 // Stateful version of RecordTrajectory. There are several optimisations that
 // this allows. Currently, the only optimisation is preventing making multiple
 // copies of the state_to_index class. When state_to_index.empty() is false,
@@ -127,6 +232,43 @@ class TrajectoryRecorder {
                                    max_unroll_length);
   }
 
+  ContiguousBatchedTrajectory RecordContiguousBatch(
+      const std::vector<TabularPolicy>& policies, int batch_size,
+      int max_unroll_length) {
+    const bool include_full_observations = state_to_index_.empty();
+    std::unique_ptr<State> root = game_->NewInitialState();
+    return RecordContiguousBatchedTrajectory(
+        *game_, policies, *root, state_to_index_, batch_size,
+        include_full_observations, &rng_, max_unroll_length);
+  }
+
+  // Same as above, following a dense policy matrix indexed by
+  // State::InformationStateIndex instead of the state_to_index map.
+  ContiguousBatchedTrajectory RecordIndexedBatch(
+      absl::Span<const double> policy_matrix, int batch_size,
+      int max_unroll_length) {
+    const bool include_full_observations = state_to_index_.empty();
+    std::unique_ptr<State> root = game_->NewInitialState();
+    return RecordIndexedBatchedTrajectory(*game_, policy_matrix, *root,
+                                          batch_size, include_full_observations,
+                                          &rng_, max_unroll_length);
+  }
+
+  // Same as RecordContiguousBatch with num_threads threads, each batch
+  // drawing the seed of RecordParallelBatchedTrajectory from the recorder's
+  // generator.
+  ContiguousBatchedTrajectory RecordParallelBatch(
+      const std::vector<TabularPolicy>& policies, int batch_size,
+      int max_unroll_length, int num_threads) {
+    const bool include_full_observations = state_to_index_.empty();
+    std::unique_ptr<State> root = game_->NewInitialState();
+    const int seed = std::uniform_int_distribution<int>(
+        0, std::numeric_limits<int>::max())(rng_);
+    return RecordParallelBatchedTrajectory(
+        *game_, policies, *root, state_to_index_, batch_size,
+        include_full_observations, seed, max_unroll_length, num_threads);
+  }
+
  private:
   std::shared_ptr<const Game> game_;
 
@@ -137,6 +279,151 @@ class TrajectoryRecorder {
   std::mt19937 rng_;
 };
 
+// Appends the steps of trajectories to a file, for datasets larger than the
+// memory, to be read back by TrajectoryReader. The file is columnar and
+// chunked: after a header, each chunk holds steps_per_chunk steps, as one
+// column of fixed-width records per field (the episode number, observation or
+// state index, action, policy, player, episode returns, legal actions mask
+// and next_is_terminal), so that any step can be read without decoding. The
+// fields are stored as int32, float or uint8 rather than compressed, which
+// would prevent the random access. Only the last chunk is padded.
+class TrajectoryWriter {
+ public:
+  // Creates the file at `path`, for the trajectories of `game` with the
+  // information state tensors if include_observations, and otherwise the
+  // state indices. steps_per_chunk must be a multiple of 8, which keeps the
+  // wider columns aligned.
+  TrajectoryWriter(const std::string& path, const Game& game,
+                   bool include_observations, int steps_per_chunk = 4096);
+  // Closes the file if Close was not called.
+  ~TrajectoryWriter();
+  TrajectoryWriter(const TrajectoryWriter&) = delete;
+  TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+  // Appends the valid steps of each episode of `trajectory`, recorded with
+  // the same game and kind of observations.
+  void Append(const ContiguousBatchedTrajectory& trajectory);
+
+  // Writes the last chunk and the header. Nothing can be appended after.
+  void Close();
+
+  int64_t NumSteps() const { return num_steps_; }
+  int64_t NumEpisodes() const { return num_episodes_; }
+
+ private:
+  void WriteChunk();
+
+  file::File file_;
+  const int observation_size_;
+  const int num_distinct_actions_;
+  const int num_players_;
+  const int steps_per_chunk_;
+  // The chunk being filled, with num_chunk_steps_ steps.
+  std::vector<char> chunk_;
+  int num_chunk_steps_ = 0;
+  int64_t num_steps_ = 0;
+  int64_t num_episodes_ = 0;
+  bool closed_ = false;
+};
+
+// Reads a file written by TrajectoryWriter, mapped into memory, so that the
+// steps are only read from the disk when accessed. The spans returned point
+// into the mapping, and are valid as long as the reader.
+class TrajectoryReader {
+ public:
+  static std::unique_ptr<TrajectoryReader> Open(const std::string& path);
+
+  ~TrajectoryReader();
+  TrajectoryReader(const TrajectoryReader&) = delete;
+  TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+  int64_t NumSteps() const { return num_steps_; }
+  int64_t NumEpisodes() const { return num_episodes_; }
+  // 0 if the file holds state indices.
+  int ObservationSize() const { return observation_size_; }
+  int NumDistinctActions() const { return num_distinct_actions_; }
+  int NumPlayers() const { return num_players_; }
+
+  // The fields of a step, in [0, NumSteps()). The steps of an episode are
+  // consecutive, numbered by Episode from 0.
+  int64_t Episode(int64_t step) const {
+    return *Field<int64_t>(step, Column::kEpisode);
+  }
+  absl::Span<const float> Observation(int64_t step) const {
+    SPIEL_CHECK_GT(observation_size_, 0);
+    return absl::MakeConstSpan(Field<float>(step, Column::kObservation),
+                               observation_size_);
+  }
+  int StateIndex(int64_t step) const {
+    SPIEL_CHECK_EQ(observation_size_, 0);
+    return *Field<int32_t>(step, Column::kObservation);
+  }
+  Action StepAction(int64_t step) const {
+    return *Field<int32_t>(step, Column::kAction);
+  }
+  absl::Span<const float> Policy(int64_t step) const {
+    return absl::MakeConstSpan(Field<float>(step, Column::kPolicy),
+                               num_distinct_actions_);
+  }
+  Player StepPlayer(int64_t step) const {
+    return *Field<int32_t>(step, Column::kPlayer);
+  }
+  // The returns of the episode of the step.
+  absl::Span<const float> Returns(int64_t step) const {
+    return absl::MakeConstSpan(Field<float>(step, Column::kReturns),
+                               num_players_);
+  }
+  absl::Span<const uint8_t> LegalActions(int64_t step) const {
+    return absl::MakeConstSpan(Field<uint8_t>(step, Column::kLegalActions),
+                               num_distinct_actions_);
+  }
+  bool NextIsTerminal(int64_t step) const {
+    return *Field<uint8_t>(step, Column::kNextIsTerminal);
+  }
+
+ private:
+  enum class Column {
+    kEpisode,
+    kObservation,
+    kAction,
+    kPolicy,
+    kPlayer,
+    kReturns,
+    kLegalActions,
+    kNextIsTerminal,
+  };
+  static constexpr int kNumColumns = 8;
+
+  TrajectoryReader() = default;
+
+  template <typename T>
+  const T* Field(int64_t step, Column column) const {
+    SPIEL_CHECK_GE(step, 0);
+    SPIEL_CHECK_LT(step, num_steps_);
+    const int c = static_cast<int>(column);
+    const char* chunk = data_ + (step / steps_per_chunk_) * chunk_size_;
+    return reinterpret_cast<const T*>(
+        chunk + column_offsets_[c] +
+        (step % steps_per_chunk_) * column_widths_[c]);
+  }
+
+  int observation_size_ = 0;
+  int num_distinct_actions_ = 0;
+  int num_players_ = 0;
+  int steps_per_chunk_ = 0;
+  int64_t num_steps_ = 0;
+  int64_t num_episodes_ = 0;
+  // The width of the records and the offset in the chunks of each column.
+  std::array<int64_t, kNumColumns> column_widths_;
+  std::array<int64_t, kNumColumns> column_offsets_;
+  int64_t chunk_size_ = 0;
+  // The chunks, either in owned_data_ or mapped from the file.
+  const char* data_ = nullptr;
+  std::string owned_data_;
+  void* mapped_data_ = nullptr;
+  int64_t mapped_size_ = 0;
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -14,10 +14,16 @@
 
 #include "open_spiel/algorithms/trajectories.h"
 
+#include <cstdlib>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -253,6 +259,246 @@ void BatchedTrajectoryResizesCorrectly(const std::string& game_name) {
   }
 }
 
+// The contiguous fields must hold the same trajectories as
+// RecordBatchedTrajectory with the same seed, with the same padding.
+void ContiguousTrajectoryMatchesBatchedTrajectory(const std::string& game_name,
+                                                  bool use_state_indices) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices;
+  if (use_state_indices) states_to_indices = GetStatesToIndices(*game);
+  const int max_unroll_length = 20;
+  BatchedTrajectory trajectory = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/!use_state_indices, /*seed=*/1,
+      max_unroll_length);
+  ContiguousBatchedTrajectory contiguous = RecordContiguousBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/!use_state_indices, /*seed=*/1,
+      max_unroll_length);
+  SPIEL_CHECK_EQ(contiguous.max_trajectory_length, max_unroll_length);
+  const int num_actions = contiguous.num_distinct_actions;
+  const int observation_size = contiguous.observation_size;
+  SPIEL_CHECK_EQ(observation_size == 0, use_state_indices);
+  SPIEL_CHECK_EQ(contiguous.FieldStrides(num_actions)[0],
+                 max_unroll_length * num_actions);
+  for (int b = 0; b < kBatchSize; ++b) {
+    for (int t = 0; t < max_unroll_length; ++t) {
+      const int step = b * max_unroll_length + t;
+      SPIEL_CHECK_EQ(contiguous.actions[step], trajectory.actions[b][t]);
+      SPIEL_CHECK_EQ(contiguous.player_ids[step], trajectory.player_ids[b][t]);
+      SPIEL_CHECK_EQ(contiguous.valid[step], trajectory.valid[b][t]);
+      SPIEL_CHECK_EQ(contiguous.next_is_terminal[step],
+                     trajectory.next_is_terminal[b][t]);
+      for (int a = 0; a < num_actions; ++a) {
+        SPIEL_CHECK_EQ(contiguous.legal_actions[step * num_actions + a],
+                       trajectory.legal_actions[b][t][a]);
+        SPIEL_CHECK_FLOAT_EQ(contiguous.player_policies[step * num_actions + a],
+                             trajectory.player_policies[b][t][a]);
+      }
+      if (use_state_indices) {
+        SPIEL_CHECK_EQ(contiguous.state_indices[step],
+                       trajectory.state_indices[b][t]);
+      }
+      for (int i = 0; i < observation_size; ++i) {
+        SPIEL_CHECK_FLOAT_EQ(
+            contiguous.observations[step * observation_size + i],
+            trajectory.observations[b][t][i]);
+      }
+    }
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      SPIEL_CHECK_FLOAT_EQ(contiguous.rewards[b * game->NumPlayers() + p],
+                           trajectory.rewards[b][p]);
+    }
+  }
+}
+
+// The parallel recording must not depend on the number of threads, and must
+// record valid trajectories.
+void ParallelTrajectoryIsDeterministic(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  ContiguousBatchedTrajectory serial = RecordParallelBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*seed=*/3,
+      /*max_unroll_length=*/-1, /*num_threads=*/1);
+  ContiguousBatchedTrajectory parallel = RecordParallelBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*seed=*/3,
+      /*max_unroll_length=*/-1, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(serial.max_trajectory_length, parallel.max_trajectory_length);
+  SPIEL_CHECK_EQ(serial.actions, parallel.actions);
+  SPIEL_CHECK_EQ(serial.state_indices, parallel.state_indices);
+  SPIEL_CHECK_EQ(serial.legal_actions, parallel.legal_actions);
+  SPIEL_CHECK_EQ(serial.rewards, parallel.rewards);
+  SPIEL_CHECK_EQ(serial.valid, parallel.valid);
+
+  const int length = parallel.max_trajectory_length;
+  for (int b = 0; b < kBatchSize; ++b) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    for (int t = 0; t < length && parallel.valid[b * length + t]; ++t) {
+      // The chance outcomes are not recorded, so any is taken.
+      while (state->IsChanceNode()) {
+        state->ApplyAction(state->LegalActions()[0]);
+      }
+      SPIEL_CHECK_EQ(parallel.player_ids[b * length + t],
+                     state->CurrentPlayer());
+      state->ApplyAction(parallel.actions[b * length + t]);
+      SPIEL_CHECK_EQ(state->IsTerminal(),
+                     parallel.next_is_terminal[b * length + t]);
+    }
+  }
+}
+
+// Following the dense matrix of the policies must give the same trajectories
+// as following the policies, with the information state indices.
+void IndexedTrajectoryMatchesContiguousTrajectory(
+    const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  policies[0] = GetFirstActionPolicy(*game);
+  std::vector<double> policy_matrix = DensePolicyMatrix(*game, policies);
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::mt19937 rng(5);
+  ContiguousBatchedTrajectory contiguous = RecordContiguousBatchedTrajectory(
+      *game, policies, *root, /*state_to_index=*/{}, kBatchSize,
+      /*include_full_observations=*/true, &rng);
+  rng.seed(5);
+  ContiguousBatchedTrajectory indexed = RecordIndexedBatchedTrajectory(
+      *game, policy_matrix, *root, kBatchSize,
+      /*include_full_observations=*/true, &rng);
+  SPIEL_CHECK_EQ(indexed.actions, contiguous.actions);
+  SPIEL_CHECK_EQ(indexed.player_policies, contiguous.player_policies);
+  SPIEL_CHECK_EQ(indexed.observations, contiguous.observations);
+  SPIEL_CHECK_EQ(indexed.rewards, contiguous.rewards);
+
+  rng.seed(5);
+  indexed = RecordIndexedBatchedTrajectory(
+      *game, policy_matrix, *root, kBatchSize,
+      /*include_full_observations=*/false, &rng);
+  SPIEL_CHECK_EQ(indexed.actions, contiguous.actions);
+  // The chance outcomes are not recorded, but each state index must have the
+  // policy of its row of the matrix.
+  const int num_actions = game->NumDistinctActions();
+  for (int step = 0; step < indexed.valid.size(); ++step) {
+    if (!indexed.valid[step]) continue;
+    const int info_state = indexed.state_indices[step];
+    SPIEL_CHECK_GE(info_state, 0);
+    SPIEL_CHECK_LT(info_state, game->NumInformationStates());
+    for (int a = 0; a < num_actions; ++a) {
+      SPIEL_CHECK_FLOAT_EQ(indexed.player_policies[step * num_actions + a],
+                           policy_matrix[info_state * num_actions + a]);
+    }
+  }
+}
+
+// The uniform model must play uniformly over the recorded legal actions.
+void InferenceTrajectoryIsUniform(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  UniformInferenceModel model(*game);
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::mt19937 rng(7);
+  ContiguousBatchedTrajectory trajectory = RecordInferenceBatchedTrajectory(
+      *game, model, *root, kBatchSize, &rng);
+  SPIEL_CHECK_EQ(trajectory.batch_size, kBatchSize);
+  SPIEL_CHECK_EQ(trajectory.observation_size,
+                 game->InformationStateTensorSize());
+  const int num_actions = game->NumDistinctActions();
+  for (int b = 0; b < kBatchSize; ++b) {
+    int length = 0;
+    for (int t = 0; t < trajectory.max_trajectory_length; ++t) {
+      const int step = b * trajectory.max_trajectory_length + t;
+      if (!trajectory.valid[step]) continue;
+      ++length;
+      int num_legal = 0;
+      for (int a = 0; a < num_actions; ++a) {
+        num_legal += trajectory.legal_actions[step * num_actions + a];
+      }
+      for (int a = 0; a < num_actions; ++a) {
+        SPIEL_CHECK_FLOAT_EQ(
+            trajectory.player_policies[step * num_actions + a],
+            trajectory.legal_actions[step * num_actions + a] /
+                static_cast<float>(num_legal));
+      }
+      SPIEL_CHECK_EQ(trajectory.legal_actions[step * num_actions +
+                                              trajectory.actions[step]],
+                     1);
+    }
+    SPIEL_CHECK_GT(length, 0);
+    SPIEL_CHECK_TRUE(trajectory.next_is_terminal[
+        b * trajectory.max_trajectory_length + length - 1]);
+  }
+}
+
+// The steps read back must be those written, over several batches and chunks.
+void TrajectoryFileRoundTrip(const std::string& game_name,
+                             bool include_observations) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices;
+  if (!include_observations) states_to_indices = GetStatesToIndices(*game);
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string path =
+      absl::StrCat(tmp_dir ? tmp_dir : "/tmp", "/open_spiel-trajectories-",
+                   game_name, "-", include_observations, ".bin");
+  std::vector<ContiguousBatchedTrajectory> batches;
+  {
+    TrajectoryWriter writer(path, *game, include_observations,
+                            /*steps_per_chunk=*/8);
+    for (int seed = 0; seed < 3; ++seed) {
+      batches.push_back(RecordContiguousBatchedTrajectory(
+          *game, policies, states_to_indices, kBatchSize,
+          include_observations, seed));
+      writer.Append(batches.back());
+    }
+  }
+
+  std::unique_ptr<TrajectoryReader> reader = TrajectoryReader::Open(path);
+  SPIEL_CHECK_EQ(reader->NumEpisodes(), 3 * kBatchSize);
+  SPIEL_CHECK_EQ(reader->NumPlayers(), game->NumPlayers());
+  const int num_actions = reader->NumDistinctActions();
+  const int observation_size = reader->ObservationSize();
+  SPIEL_CHECK_EQ(observation_size > 0, include_observations);
+  int64_t step = 0;
+  int64_t episode = 0;
+  for (const ContiguousBatchedTrajectory& batch : batches) {
+    const int length = batch.max_trajectory_length;
+    for (int b = 0; b < batch.batch_size; ++b, ++episode) {
+      for (int t = 0; t < length && batch.valid[b * length + t];
+           ++t, ++step) {
+        const int i = b * length + t;
+        SPIEL_CHECK_EQ(reader->Episode(step), episode);
+        SPIEL_CHECK_EQ(reader->StepAction(step), batch.actions[i]);
+        SPIEL_CHECK_EQ(reader->StepPlayer(step), batch.player_ids[i]);
+        SPIEL_CHECK_EQ(reader->NextIsTerminal(step), batch.next_is_terminal[i]);
+        if (include_observations) {
+          for (int j = 0; j < observation_size; ++j) {
+            SPIEL_CHECK_EQ(reader->Observation(step)[j],
+                           batch.observations[i * observation_size + j]);
+          }
+        } else {
+          SPIEL_CHECK_EQ(reader->StateIndex(step), batch.state_indices[i]);
+        }
+        for (int a = 0; a < num_actions; ++a) {
+          SPIEL_CHECK_EQ(reader->Policy(step)[a],
+                         batch.player_policies[i * num_actions + a]);
+          SPIEL_CHECK_EQ(reader->LegalActions(step)[a],
+                         batch.legal_actions[i * num_actions + a]);
+        }
+        for (Player p = 0; p < game->NumPlayers(); ++p) {
+          SPIEL_CHECK_EQ(reader->Returns(step)[p],
+                         batch.rewards[b * game->NumPlayers() + p]);
+        }
+      }
+    }
+  }
+  SPIEL_CHECK_EQ(reader->NumSteps(), step);
+  reader.reset();
+  SPIEL_CHECK_TRUE(file::Remove(path));
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -276,5 +522,15 @@ int main() {
     alg::RecordBatchedTrajectoryPlayerIdsIsCorrect(game_name);
     alg::RecordBatchedTrajectoryNextIsTerminalIsCorrect(game_name);
     alg::BatchedTrajectoryResizesCorrectly(game_name);
+    alg::ContiguousTrajectoryMatchesBatchedTrajectory(game_name, true);
+    alg::ContiguousTrajectoryMatchesBatchedTrajectory(game_name, false);
+    alg::ParallelTrajectoryIsDeterministic(game_name);
   }
+  // These games provide information state indices.
+  alg::IndexedTrajectoryMatchesContiguousTrajectory("kuhn_poker");
+  alg::IndexedTrajectoryMatchesContiguousTrajectory("liars_dice");
+  alg::InferenceTrajectoryIsUniform("kuhn_poker");
+  alg::InferenceTrajectoryIsUniform("leduc_poker");
+  alg::TrajectoryFileRoundTrip("kuhn_poker", /*include_observations=*/false);
+  alg::TrajectoryFileRoundTrip("leduc_poker", /*include_observations=*/true);
 }
@@ -15,8 +15,15 @@
 #include "open_spiel/algorithms/value_iteration.h"
 
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -28,6 +35,20 @@ using state_pointer = std::unique_ptr<State>;
 using state_action = std::pair<std::string, Action>;
 using state_prob = std::pair<std::string, double>;
 
+void CheckValueIterationGame(const Game& game) {
+  // Currently only supports 1-player or 2-player zero sum games
+  SPIEL_CHECK_TRUE(game.NumPlayers() == 1 || game.NumPlayers() == 2);
+  if (game.NumPlayers() == 2) {
+    SPIEL_CHECK_EQ(game.GetType().utility, GameType::Utility::kZeroSum);
+  }
+
+  // No support for simultaneous games (needs an LP solver). And so also must
+  // be a perfect information game.
+  SPIEL_CHECK_EQ(game.GetType().dynamics, GameType::Dynamics::kSequential);
+  SPIEL_CHECK_EQ(game.GetType().information,
+                 GameType::Information::kPerfectInformation);
+}
+
 // Adds transitions and transition probability from a given state
 void AddTransition(map<state_action, vector<state_prob>>* transitions,
                    std::string key, const state_pointer& state) {
@@ -75,17 +96,7 @@ std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
   using state_action = std::pair<std::string, Action>;
   using state_prob = std::pair<std::string, double>;
 
-  // Currently only supports 1-player or 2-player zero sum games
-  SPIEL_CHECK_TRUE(game.NumPlayers() == 1 || game.NumPlayers() == 2);
-  if (game.NumPlayers() == 2) {
-    SPIEL_CHECK_EQ(game.GetType().utility, GameType::Utility::kZeroSum);
-  }
-
-  // No support for simultaneous games (needs an LP solver). And so also must
-  // be a perfect information game.
-  SPIEL_CHECK_EQ(game.GetType().dynamics, GameType::Dynamics::kSequential);
-  SPIEL_CHECK_EQ(game.GetType().information,
-                 GameType::Information::kPerfectInformation);
+  CheckValueIterationGame(game);
 
   auto states = GetAllStates(game, depth_limit, /*include_terminals=*/true,
                              /*include_chance_states=*/false);
@@ -133,5 +144,136 @@ std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
   return values;
 }
 
+ValueIterationGraph::ValueIterationGraph(const Game& game, int depth_limit)
+    : min_utility_(game.MinUtility()) {
+  CheckValueIterationGame(game);
+  ForEachState(
+      game,
+      [this](const State& state) {
+        const int index = AddState(state.ToString());
+        if (state.IsTerminal()) {
+          // For both 1-player and 2-player zero sum games, suffices to look at
+          // player 0's utility
+          values_[index] = state.PlayerReturn(Player{0});
+        } else {
+          kinds_[index] = state.CurrentPlayer() == Player{1}
+                              ? StateKind::kMinimizing
+                              : StateKind::kMaximizing;
+          AddTransitions(state, index);
+        }
+      },
+      depth_limit, /*include_terminals=*/true,
+      /*include_chance_states=*/false);
+  first_outcome_.push_back(outcome_states_.size());
+  next_values_ = values_;
+}
+
+int ValueIterationGraph::AddState(const std::string& state) {
+  auto [it, inserted] = state_indices_.try_emplace(state, NumStates());
+  if (inserted) {
+    state_strings_.push_back(state);
+    // The states that are not enumerated, i.e. those past the depth limit,
+    // keep a value of 0, as in ValueIteration.
+    kinds_.push_back(StateKind::kFixed);
+    first_action_.push_back(0);
+    num_actions_.push_back(0);
+    values_.push_back(0);
+  }
+  return it->second;
+}
+
+void ValueIterationGraph::AddTransitions(const State& state, int index) {
+  first_action_[index] = first_outcome_.size();
+  for (Action action : state.LegalActions()) {
+    first_outcome_.push_back(outcome_states_.size());
+    std::unique_ptr<State> next_state = state.Child(action);
+    if (next_state->IsChanceNode()) {
+      // For a chance node, record the transition probabilities
+      for (const auto& [outcome, prob] : next_state->ChanceOutcomes()) {
+        outcome_states_.push_back(
+            AddState(next_state->Child(outcome)->ToString()));
+        outcome_probs_.push_back(prob);
+      }
+    } else {
+      // A non-chance node is equivalent to transition with probability 1
+      outcome_states_.push_back(AddState(next_state->ToString()));
+      outcome_probs_.push_back(1.0);
+    }
+    ++num_actions_[index];
+  }
+}
+
+int ValueIterationGraph::StateIndex(const std::string& state) const {
+  auto it = state_indices_.find(state);
+  return it == state_indices_.end() ? -1 : it->second;
+}
+
+std::map<std::string, double> ValueIterationGraph::ValueMap() const {
+  std::map<std::string, double> values;
+  for (int s = 0; s < NumStates(); ++s) values[state_strings_[s]] = values_[s];
+  return values;
+}
+
+double ValueIterationGraph::Sweep(int begin, int end, bool gauss_seidel) {
+  double error = 0;
+  // The states are added before their successors, so the sweep goes
+  // backwards, and with gauss_seidel reads the values of [s + 1, end) from
+  // this sweep.
+  for (int s = end - 1; s >= begin; --s) {
+    if (kinds_[s] == StateKind::kFixed) {
+      next_values_[s] = values_[s];
+      continue;
+    }
+    const bool maximizing = kinds_[s] == StateKind::kMaximizing;
+    // Initialize value to be the minimum utility if current player
+    // is the maximizing player (i.e. player 0), and to maximum utility
+    // if current player is the minimizing player (i.e. player 1).
+    double value = maximizing ? min_utility_ : -min_utility_;
+    for (int a = first_action_[s]; a < first_action_[s] + num_actions_[s];
+         ++a) {
+      double q_value = 0;
+      for (int o = first_outcome_[a]; o < first_outcome_[a + 1]; ++o) {
+        const int next = outcome_states_[o];
+        q_value += outcome_probs_[o] * (gauss_seidel && next > s && next < end
+                                            ? next_values_[next]
+                                            : values_[next]);
+      }
+      value = maximizing ? std::max(value, q_value) : std::min(value, q_value);
+    }
+    error = std::max(std::abs(value - values_[s]), error);
+    next_values_[s] = value;
+  }
+  return error;
+}
+
+int ValueIterationGraph::Solve(double threshold, bool gauss_seidel,
+                               int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  num_threads = std::max(1, std::min(num_threads, NumStates()));
+  int num_sweeps = 0;
+  double error;
+  do {
+    ++num_sweeps;
+    if (num_threads == 1) {
+      error = Sweep(0, NumStates(), gauss_seidel);
+    } else {
+      std::vector<double> errors(num_threads);
+      std::vector<Thread> threads;
+      threads.reserve(num_threads);
+      for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([this, &errors, gauss_seidel, num_threads, t]() {
+          const int64_t num_states = NumStates();
+          errors[t] = Sweep(num_states * t / num_threads,
+                            num_states * (t + 1) / num_threads, gauss_seidel);
+        });
+      }
+      for (Thread& thread : threads) thread.join();
+      error = *std::max_element(errors.begin(), errors.end());
+    }
+    values_.swap(next_values_);
+  } while (error > threshold);
+  return num_sweeps;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
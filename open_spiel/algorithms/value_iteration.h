@@ -15,6 +15,12 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VALUE_ITERATION_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VALUE_ITERATION_H_
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "open_spiel/algorithms/get_all_states.h"
 #include "open_spiel/spiel.h"
 
@@ -33,6 +39,67 @@ namespace algorithms {
 std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
                                              double threshold);
 
+// The states and transitions of ValueIteration, numbered once and stored in
+// arrays, so that the sweeps run over dense vectors of values instead of
+// looking up strings in maps. The strings of the states are only used to
+// export the values. The states are enumerated with ForEachState, so they are
+// not all kept in memory, on the same games as ValueIteration.
+class ValueIterationGraph {
+ public:
+  ValueIterationGraph(const Game& game, int depth_limit);
+
+  // Runs sweeps until no value changes by more than threshold, and returns
+  // their number. With gauss_seidel, the values updated in a sweep are used
+  // by the rest of the sweep, which usually converges in fewer sweeps. With
+  // num_threads > 1, the states are split into as many blocks, each swept by
+  // a thread, and with gauss_seidel only the updates of the same block are
+  // used during a sweep.
+  int Solve(double threshold, bool gauss_seidel = true, int num_threads = 1);
+
+  int NumStates() const { return state_strings_.size(); }
+  int NumTransitions() const { return outcome_states_.size(); }
+
+  // Returns the index of a state, as given by State::ToString, or -1 if it is
+  // not in the graph.
+  int StateIndex(const std::string& state) const;
+  const std::string& StateString(int state) const {
+    return state_strings_[state];
+  }
+  double Value(int state) const { return values_[state]; }
+  const std::vector<double>& Values() const { return values_; }
+
+  // Returns the values by state string, as ValueIteration.
+  std::map<std::string, double> ValueMap() const;
+
+ private:
+  enum class StateKind : int8_t { kFixed, kMaximizing, kMinimizing };
+
+  // Returns the index of a state, adding it if needed.
+  int AddState(const std::string& state);
+
+  // Adds the transitions of a decision state, at `index`.
+  void AddTransitions(const State& state, int index);
+
+  // Runs a sweep over the states in [begin, end), reading values_ and
+  // writing next_values_, and returns the largest change of value.
+  double Sweep(int begin, int end, bool gauss_seidel);
+
+  double min_utility_;
+  std::vector<std::string> state_strings_;
+  std::unordered_map<std::string, int> state_indices_;
+  std::vector<StateKind> kinds_;
+  // The actions of state s are num_actions_[s] consecutive ones from
+  // first_action_[s], since the states are not added in index order.
+  std::vector<int> first_action_;
+  std::vector<int> num_actions_;
+  // The outcomes of action a are in [first_outcome_[a], first_outcome_[a + 1]).
+  std::vector<int> first_outcome_;
+  std::vector<int> outcome_states_;
+  std::vector<double> outcome_probs_;
+  std::vector<double> values_;
+  std::vector<double> next_values_;
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -0,0 +1,72 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/value_iteration.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void ValueIterationGraphSolvesTicTacToe() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  ValueIterationGraph graph(*game, /*depth_limit=*/-1);
+  graph.Solve(/*threshold=*/0.01);
+  std::map<std::string, double> values = graph.ValueMap();
+  SPIEL_CHECK_EQ(values["...\n...\n..."], 0);
+  SPIEL_CHECK_EQ(values["...\n...\n.ox"], 1);
+  SPIEL_CHECK_EQ(values["x..\noo.\nxx."], -1);
+}
+
+// All the variants of the sweeps must converge to the values of
+// ValueIteration, including past a depth limit and with chance nodes.
+void ValueIterationGraphMatchesValueIteration(const std::string& game_name,
+                                              int depth_limit) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  const double threshold = 1e-8;
+  std::map<std::string, double> expected_values =
+      ValueIteration(*game, depth_limit, threshold);
+  ValueIterationGraph graph(*game, depth_limit);
+  SPIEL_CHECK_EQ(graph.NumStates(), expected_values.size());
+  for (bool gauss_seidel : {false, true}) {
+    for (int num_threads : {1, 3}) {
+      ValueIterationGraph graph(*game, depth_limit);
+      graph.Solve(threshold, gauss_seidel, num_threads);
+      for (const auto& [state, value] : expected_values) {
+        SPIEL_CHECK_FLOAT_NEAR(graph.Value(graph.StateIndex(state)), value,
+                               1e-6);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::ValueIterationGraphSolvesTicTacToe();
+  open_spiel::algorithms::ValueIterationGraphMatchesValueIteration(
+      "tic_tac_toe", -1);
+  open_spiel::algorithms::ValueIterationGraphMatchesValueIteration(
+      "tic_tac_toe", 5);
+  open_spiel::algorithms::ValueIterationGraphMatchesValueIteration(
+      "pig(winscore=10)", 6);
+}
@@ -0,0 +1,138 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/vector_env.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+VectorEnv::VectorEnv(std::shared_ptr<const Game> game, int num_envs, int seed,
+                     int num_stacked_frames)
+    : game_(std::move(game)),
+      initial_state_(game_->NewInitialState()),
+      rng_(seed),
+      num_players_(game_->NumPlayers()),
+      observation_size_(game_->ObservationTensorSize()),
+      num_distinct_actions_(game_->NumDistinctActions()),
+      num_stacked_frames_(num_stacked_frames),
+      observations_(num_envs * num_stacked_frames * observation_size_),
+      legal_actions_masks_(num_envs * num_distinct_actions_),
+      rewards_(num_envs * num_players_),
+      returns_(num_envs * num_players_),
+      current_players_(num_envs),
+      dones_(num_envs) {
+  SPIEL_CHECK_GT(num_envs, 0);
+  SPIEL_CHECK_GT(num_stacked_frames, 0);
+  if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("VectorEnv only supports sequential games.");
+  }
+  if (!game_->GetType().provides_observation_tensor) {
+    SpielFatalError("VectorEnv requires games with observation tensors.");
+  }
+  states_.reserve(num_envs);
+  for (int env = 0; env < num_envs; ++env) {
+    states_.push_back(initial_state_->Clone());
+  }
+  if (num_stacked_frames_ > 1) {
+    stacks_.reserve(num_envs);
+    for (int env = 0; env < num_envs; ++env) {
+      stacks_.emplace_back(num_players_, observation_size_,
+                           num_stacked_frames_);
+    }
+  }
+  Reset();
+}
+
+void VectorEnv::Reset() {
+  std::fill(rewards_.begin(), rewards_.end(), 0.0f);
+  std::fill(dones_.begin(), dones_.end(), 0);
+  for (int env = 0; env < states_.size(); ++env) {
+    ResetEnv(env);
+    WriteObservationAndMask(env);
+  }
+}
+
+void VectorEnv::Step(absl::Span<const Action> actions) {
+  SPIEL_CHECK_EQ(actions.size(), states_.size());
+  std::fill(rewards_.begin(), rewards_.end(), 0.0f);
+  for (int env = 0; env < states_.size(); ++env) {
+    ApplyAction(env, actions[env]);
+    dones_[env] = states_[env]->IsTerminal();
+    if (dones_[env]) ResetEnv(env);
+    WriteObservationAndMask(env);
+  }
+}
+
+void VectorEnv::ApplyAction(int env, Action action) {
+  states_[env]->ApplyAction(action);
+  SampleChanceOutcomes(env);
+  // Rewards() is not defined at the chance nodes in between, so the rewards
+  // of the step are the change in returns, which sums those of the action
+  // and of the chance outcomes.
+  const std::vector<double> returns = states_[env]->Returns();
+  for (Player p = 0; p < num_players_; ++p) {
+    double& previous = returns_[env * num_players_ + p];
+    rewards_[env * num_players_ + p] = returns[p] - previous;
+    previous = returns[p];
+  }
+}
+
+void VectorEnv::ResetEnv(int env) {
+  // Recycle the state in place when the game supports it.
+  if (!states_[env]->CopyFrom(*initial_state_)) {
+    states_[env] = initial_state_->Clone();
+  }
+  if (!stacks_.empty()) stacks_[env].Reset();
+  SampleChanceOutcomes(env);
+  SPIEL_CHECK_FALSE(states_[env]->IsTerminal());
+  const std::vector<double> returns = states_[env]->Returns();
+  std::copy(returns.begin(), returns.end(), &returns_[env * num_players_]);
+}
+
+void VectorEnv::SampleChanceOutcomes(int env) {
+  State* state = states_[env].get();
+  while (state->IsChanceNode()) {
+    state->ApplyAction(state->SampleChanceOutcome(rng_).first);
+  }
+}
+
+void VectorEnv::WriteObservationAndMask(int env) {
+  const State& state = *states_[env];
+  const Player player = state.CurrentPlayer();
+  current_players_[env] = player;
+  const int size = num_stacked_frames_ * observation_size_;
+  absl::Span<float> observation =
+      absl::MakeSpan(observations_).subspan(env * size, size);
+  if (stacks_.empty()) {
+    state.ObservationTensor(player, observation);
+  } else {
+    stacks_[env].Push(state, player);
+    stacks_[env].Stacked(player, observation);
+  }
+
+  state.LegalActionsMask(
+      player, absl::MakeSpan(legal_actions_masks_)
+                  .subspan(env * num_distinct_actions_, num_distinct_actions_));
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,111 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_ENV_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_ENV_H_
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/observation_stack.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A batch of environments of the same sequential game that are stepped
+// together, so that RL actors pay the per-step overhead (e.g. of a Python
+// call) once per batch rather than once per state.
+//
+// Every environment is always at a decision node: chance outcomes are sampled
+// as soon as they are reached, and an episode that ends is immediately
+// replaced by a new one, with done set for that step. After Reset() and
+// Step(), the observations (from the point of view of the player to act),
+// legal actions masks and step rewards of the whole batch are available as
+// contiguous row-major arrays, indexed by environment first.
+//
+// With num_stacked_frames > 1, the observation of an environment is instead
+// the stack of the last num_stacked_frames observations of the player to act
+// in the episode, one per turn of theirs, oldest first and zero before the
+// first ones (see ObservationStack). It is assembled in place from a ring
+// buffer per environment and player.
+class VectorEnv {
+ public:
+  VectorEnv(std::shared_ptr<const Game> game, int num_envs, int seed,
+            int num_stacked_frames = 1);
+
+  // Starts a new episode in every environment.
+  void Reset();
+
+  // Applies actions[i], which must be legal, in environment i.
+  void Step(absl::Span<const Action> actions);
+
+  int num_envs() const { return states_.size(); }
+  const State& state(int env) const { return *states_[env]; }
+
+  // [num_envs, num_stacked_frames * ObservationTensorSize()].
+  const std::vector<float>& observations() const { return observations_; }
+  int num_stacked_frames() const { return num_stacked_frames_; }
+
+  // [num_envs, NumDistinctActions()], 1 for legal actions and 0 otherwise.
+  const std::vector<float>& legal_actions_masks() const {
+    return legal_actions_masks_;
+  }
+
+  // [num_envs, NumPlayers()], the rewards received during the last step,
+  // both for the action and for the chance outcomes sampled after it,
+  // including at the end of the episode. All zero after Reset().
+  const std::vector<float>& rewards() const { return rewards_; }
+
+  // [num_envs], the player to act.
+  const std::vector<int>& current_players() const { return current_players_; }
+
+  // [num_envs], 1 if the last step ended the episode (the environment then
+  // holds the initial state of the next one), 0 otherwise.
+  const std::vector<int>& dones() const { return dones_; }
+
+ private:
+  // Applies the action and any following chance outcomes, and records the
+  // rewards.
+  void ApplyAction(int env, Action action);
+  void ResetEnv(int env);
+  void SampleChanceOutcomes(int env);
+  void WriteObservationAndMask(int env);
+
+  std::shared_ptr<const Game> game_;
+  std::unique_ptr<State> initial_state_;
+  std::vector<std::unique_ptr<State>> states_;
+  std::mt19937 rng_;
+  const int num_players_;
+  const int observation_size_;
+  const int num_distinct_actions_;
+  const int num_stacked_frames_;
+  // One per environment if num_stacked_frames_ > 1.
+  std::vector<ObservationStack> stacks_;
+
+  std::vector<float> observations_;
+  std::vector<float> legal_actions_masks_;
+  std::vector<float> rewards_;
+  // [num_envs, NumPlayers()], the returns of the current states.
+  std::vector<double> returns_;
+  std::vector<int> current_players_;
+  std::vector<int> dones_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_VECTOR_ENV_H_
@@ -0,0 +1,215 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/vector_env.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kNumEnvs = 8;
+constexpr int kNumSteps = 200;
+
+// One-player game of kNumRounds rounds with intermediate rewards: each round
+// the player picks a reward of 0 or 1, then a coin flip adds 0 or 10.
+constexpr int kNumRounds = 3;
+
+class CoinRewardsGame : public Game {
+ public:
+  CoinRewardsGame()
+      : Game(GameType{"coin_rewards", "Coin Rewards",
+                      GameType::Dynamics::kSequential,
+                      GameType::ChanceMode::kExplicitStochastic,
+                      GameType::Information::kPerfectInformation,
+                      GameType::Utility::kGeneralSum,
+                      GameType::RewardModel::kRewards,
+                      /*max_num_players=*/1,
+                      /*min_num_players=*/1,
+                      /*provides_information_state_string=*/false,
+                      /*provides_information_state_tensor=*/false,
+                      /*provides_observation_string=*/false,
+                      /*provides_observation_tensor=*/true},
+             {}) {}
+  int NumDistinctActions() const override { return 2; }
+  std::unique_ptr<State> NewInitialState() const override;
+  int MaxChanceOutcomes() const override { return 2; }
+  int NumPlayers() const override { return 1; }
+  double MinUtility() const override { return 0; }
+  double MaxUtility() const override { return 11 * kNumRounds; }
+  std::shared_ptr<const Game> Clone() const override {
+    return std::make_shared<CoinRewardsGame>();
+  }
+  std::vector<int> ObservationTensorShape() const override { return {1}; }
+  int MaxGameLength() const override { return kNumRounds; }
+};
+
+class CoinRewardsState : public State {
+ public:
+  explicit CoinRewardsState(std::shared_ptr<const Game> game)
+      : State(std::move(game)) {}
+  Player CurrentPlayer() const override {
+    if (IsTerminal()) return kTerminalPlayerId;
+    return history_.size() % 2 == 0 ? 0 : kChancePlayerId;
+  }
+  std::vector<Action> LegalActions() const override {
+    if (IsTerminal()) return {};
+    return {0, 1};
+  }
+  ActionsAndProbs ChanceOutcomes() const override {
+    return {{0, 0.5}, {1, 0.5}};
+  }
+  std::string ActionToString(Player player, Action action) const override {
+    return std::to_string(player == kChancePlayerId ? 10 * action : action);
+  }
+  std::string ToString() const override { return std::to_string(return_); }
+  bool IsTerminal() const override {
+    return history_.size() == 2 * kNumRounds;
+  }
+  std::vector<double> Rewards() const override { return {reward_}; }
+  std::vector<double> Returns() const override { return {return_}; }
+  void ObservationTensor(Player player,
+                         std::vector<double>* values) const override {
+    *values = {static_cast<double>(history_.size() / 2)};
+  }
+  std::unique_ptr<State> Clone() const override {
+    return std::make_unique<CoinRewardsState>(*this);
+  }
+
+ protected:
+  void DoApplyAction(Action action) override {
+    reward_ = IsChanceNode() ? 10 * action : action;
+    return_ += reward_;
+  }
+
+ private:
+  double reward_ = 0;
+  double return_ = 0;
+};
+
+std::unique_ptr<State> CoinRewardsGame::NewInitialState() const {
+  return std::make_unique<CoinRewardsState>(shared_from_this());
+}
+
+// Checks that the batched outputs of env match its states.
+void CheckOutputs(const Game& game, const VectorEnv& env) {
+  const int observation_size = game.ObservationTensorSize();
+  const int num_actions = game.NumDistinctActions();
+  for (int i = 0; i < env.num_envs(); ++i) {
+    const State& state = env.state(i);
+    SPIEL_CHECK_FALSE(state.IsChanceNode());
+    SPIEL_CHECK_FALSE(state.IsTerminal());
+    SPIEL_CHECK_EQ(env.current_players()[i], state.CurrentPlayer());
+
+    std::vector<double> observation = state.ObservationTensor();
+    for (int j = 0; j < observation_size; ++j) {
+      SPIEL_CHECK_FLOAT_EQ(env.observations()[i * observation_size + j],
+                           observation[j]);
+    }
+    std::vector<int> mask = state.LegalActionsMask();
+    mask.resize(num_actions, 0);
+    for (int a = 0; a < num_actions; ++a) {
+      SPIEL_CHECK_EQ(env.legal_actions_masks()[i * num_actions + a], mask[a]);
+    }
+  }
+}
+
+void RandomStepsTest(const std::string& game_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  VectorEnv env(game, kNumEnvs, /*seed=*/1234);
+  CheckOutputs(*game, env);
+
+  std::mt19937 rng;
+  std::vector<double> returns(kNumEnvs * game->NumPlayers(), 0.0);
+  int num_episodes = 0;
+  for (int step = 0; step < kNumSteps; ++step) {
+    std::vector<Action> actions;
+    for (int i = 0; i < kNumEnvs; ++i) {
+      std::vector<Action> legal_actions = env.state(i).LegalActions();
+      std::uniform_int_distribution<int> dis(0, legal_actions.size() - 1);
+      actions.push_back(legal_actions[dis(rng)]);
+    }
+    env.Step(actions);
+    CheckOutputs(*game, env);
+
+    for (int i = 0; i < kNumEnvs; ++i) {
+      double sum = 0;
+      for (Player p = 0; p < game->NumPlayers(); ++p) {
+        returns[i * game->NumPlayers() + p] +=
+            env.rewards()[i * game->NumPlayers() + p];
+        sum += returns[i * game->NumPlayers() + p];
+      }
+      if (env.dones()[i]) {
+        // Both games are zero-sum.
+        SPIEL_CHECK_FLOAT_EQ(sum, 0.0);
+        for (Player p = 0; p < game->NumPlayers(); ++p) {
+          returns[i * game->NumPlayers() + p] = 0;
+        }
+        ++num_episodes;
+      }
+    }
+  }
+  SPIEL_CHECK_GT(num_episodes, 0);
+
+  env.Reset();
+  CheckOutputs(*game, env);
+  for (int i = 0; i < kNumEnvs; ++i) {
+    SPIEL_CHECK_EQ(env.dones()[i], 0);
+    for (Player p = 0; p < game->NumPlayers(); ++p) {
+      SPIEL_CHECK_EQ(env.rewards()[i * game->NumPlayers() + p], 0.0f);
+    }
+  }
+}
+
+// The rewards of a step include those earned before the chance outcomes
+// sampled after the action.
+void RewardsBeforeChanceTest() {
+  std::shared_ptr<const Game> game = std::make_shared<CoinRewardsGame>();
+  VectorEnv env(game, kNumEnvs, /*seed=*/1234);
+  std::vector<double> returns(kNumEnvs, 0.0);
+  int num_episodes = 0;
+  for (int step = 0; step < kNumSteps; ++step) {
+    env.Step(std::vector<Action>(kNumEnvs, 1));
+    for (int i = 0; i < kNumEnvs; ++i) {
+      const float reward = env.rewards()[i];
+      SPIEL_CHECK_TRUE(reward == 1 || reward == 11);
+      returns[i] += reward;
+      if (env.dones()[i]) {
+        SPIEL_CHECK_GE(returns[i], kNumRounds);
+        returns[i] = 0;
+        ++num_episodes;
+      } else {
+        SPIEL_CHECK_FLOAT_EQ(returns[i], env.state(i).Returns()[0]);
+      }
+    }
+  }
+  SPIEL_CHECK_GT(num_episodes, 0);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::RandomStepsTest("tic_tac_toe");
+  open_spiel::algorithms::RandomStepsTest("kuhn_poker");
+  open_spiel::algorithms::RewardsBeforeChanceTest();
+}
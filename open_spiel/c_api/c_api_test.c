@@ -0,0 +1,159 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Written in C to check that the header is usable from C.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "open_spiel/c_api/open_spiel_c.h"
+
+#define CHECK(x)                                                         \
+  do {                                                                   \
+    if (!(x)) {                                                          \
+      fprintf(stderr, "%s:%d CHECK(%s) failed, last error: %s\n",        \
+              __FILE__, __LINE__, #x,                                    \
+              OpenSpielLastError() ? OpenSpielLastError() : "none");     \
+      exit(1);                                                           \
+    }                                                                    \
+  } while (0)
+
+static void PlayTicTacToeTest(void) {
+  OpenSpielGame* game = OpenSpielLoadGame("tic_tac_toe");
+  CHECK(game != NULL);
+  CHECK(OpenSpielGameNumPlayers(game) == 2);
+  CHECK(OpenSpielGameNumDistinctActions(game) == 9);
+  OpenSpielState* state = OpenSpielGameNewInitialState(game);
+  // The game is kept alive by its states.
+  OpenSpielDeleteGame(game);
+
+  int64_t actions[9];
+  CHECK(OpenSpielStateLegalActions(state, 0, NULL, 0) == 9);
+  while (!OpenSpielStateIsTerminal(state)) {
+    int player = OpenSpielStateCurrentPlayer(state);
+    int num_actions = OpenSpielStateLegalActions(state, player, actions, 9);
+    CHECK(num_actions > 0 && num_actions <= 9);
+    float mask[9];
+    OpenSpielStateLegalActionsMask(state, player, mask, 9);
+    CHECK(mask[actions[0]] == 1.0f);
+    OpenSpielStateApplyAction(state, actions[0]);
+    CHECK(OpenSpielLastError() == NULL);
+  }
+  double returns[2];
+  CHECK(OpenSpielStateReturns(state, returns, 2) == 2);
+  CHECK(returns[0] + returns[1] == 0.0);
+
+  char* str = OpenSpielStateSerialize(state);
+  CHECK(str != NULL);
+  OpenSpielFreeString(str);
+  OpenSpielDeleteState(state);
+}
+
+static void ErrorTest(void) {
+  CHECK(OpenSpielLoadGame("not_a_game") == NULL);
+  CHECK(OpenSpielLastError() != NULL);
+  CHECK(strstr(OpenSpielLastError(), "not_a_game") != NULL);
+
+  OpenSpielGame* game = OpenSpielLoadGame("tic_tac_toe");
+  CHECK(OpenSpielLastError() == NULL);
+  OpenSpielState* state = OpenSpielGameNewInitialState(game);
+  OpenSpielStateApplyAction(state, 100);
+  CHECK(OpenSpielLastError() != NULL);
+  float tensor[1];
+  OpenSpielStateObservationTensor(state, 0, tensor, 1);
+  CHECK(OpenSpielLastError() != NULL);
+  OpenSpielDeleteState(state);
+  OpenSpielDeleteGame(game);
+}
+
+static void KuhnPokerTensorsTest(void) {
+  OpenSpielGame* game = OpenSpielLoadGame("kuhn_poker");
+  int size = OpenSpielGameInformationStateTensorSize(game);
+  CHECK(size > 0);
+  OpenSpielState* state = OpenSpielGameNewInitialState(game);
+  CHECK(OpenSpielStateIsChanceNode(state));
+  int64_t outcomes[3];
+  double probabilities[3];
+  CHECK(OpenSpielStateChanceOutcomes(state, outcomes, probabilities, 3) == 3);
+  CHECK(fabs(probabilities[0] - 1.0 / 3) < 1e-9);
+  OpenSpielStateApplyAction(state, outcomes[0]);
+  OpenSpielStateApplyAction(state, outcomes[1]);
+
+  float* tensor = malloc(size * sizeof(float));
+  OpenSpielStateInformationStateTensor(state, 0, tensor, size);
+  CHECK(OpenSpielLastError() == NULL);
+  // Player 0 is the first to play and holds the first card dealt.
+  CHECK(tensor[0] == 1.0f);
+  CHECK(tensor[2] == 1.0f);
+  free(tensor);
+
+  char* info_state = OpenSpielStateInformationStateString(state, 0);
+  CHECK(info_state != NULL && strlen(info_state) > 0);
+  OpenSpielFreeString(info_state);
+  OpenSpielDeleteState(state);
+  OpenSpielDeleteGame(game);
+}
+
+static void CFRTest(void) {
+  OpenSpielGame* game = OpenSpielLoadGame("kuhn_poker");
+  OpenSpielCFRSolver* solver = OpenSpielNewCFRPlusSolver(game);
+  OpenSpielCFRSolverRunIterations(solver, 200);
+  OpenSpielPolicy* policy = OpenSpielCFRSolverAveragePolicy(solver);
+  CHECK(OpenSpielExploitability(game, policy) < 0.05);
+  CHECK(OpenSpielLastError() == NULL);
+
+  OpenSpielState* state = OpenSpielGameNewInitialState(game);
+  OpenSpielStateApplyAction(state, 0);
+  OpenSpielStateApplyAction(state, 1);
+  int64_t actions[2];
+  double probabilities[2];
+  CHECK(OpenSpielPolicyStatePolicy(policy, state, actions, probabilities, 2) ==
+        2);
+  CHECK(fabs(probabilities[0] + probabilities[1] - 1.0) < 1e-9);
+
+  OpenSpielDeleteState(state);
+  OpenSpielDeletePolicy(policy);
+  OpenSpielDeleteCFRSolver(solver);
+  OpenSpielDeleteGame(game);
+}
+
+static void MCTSTest(void) {
+  OpenSpielGame* game = OpenSpielLoadGame("tic_tac_toe");
+  OpenSpielMCTSBot* bot = OpenSpielNewMCTSBot(game, /*uct_c=*/2,
+                                              /*max_simulations=*/10000,
+                                              /*num_rollouts=*/1,
+                                              /*solve=*/1, /*seed=*/42);
+  CHECK(bot != NULL);
+  OpenSpielState* state = OpenSpielGameNewInitialState(game);
+  // X to play and win at 2.
+  OpenSpielStateApplyAction(state, 0);
+  OpenSpielStateApplyAction(state, 3);
+  OpenSpielStateApplyAction(state, 1);
+  OpenSpielStateApplyAction(state, 4);
+  CHECK(OpenSpielMCTSBotStep(bot, state) == 2);
+  OpenSpielDeleteState(state);
+  OpenSpielDeleteMCTSBot(bot);
+  OpenSpielDeleteGame(game);
+}
+
+int main(int argc, char** argv) {
+  PlayTicTacToeTest();
+  ErrorTest();
+  KuhnPokerTensorsTest();
+  CFRTest();
+  MCTSTest();
+  return 0;
+}
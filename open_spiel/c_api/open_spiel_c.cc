@@ -0,0 +1,406 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/c_api/open_spiel_c.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// The opaque types of the header. Games are shared, so that the objects made
+// from them keep them alive.
+struct OpenSpielGame {
+  std::shared_ptr<const open_spiel::Game> game;
+};
+
+struct OpenSpielState {
+  std::unique_ptr<open_spiel::State> state;
+};
+
+struct OpenSpielPolicy {
+  std::unique_ptr<open_spiel::Policy> policy;
+};
+
+struct OpenSpielCFRSolver {
+  std::shared_ptr<const open_spiel::Game> game;
+  std::unique_ptr<open_spiel::algorithms::CFRSolverBase> solver;
+};
+
+struct OpenSpielMCTSBot {
+  std::shared_ptr<const open_spiel::Game> game;
+  std::unique_ptr<open_spiel::algorithms::RandomRolloutEvaluator> evaluator;
+  std::unique_ptr<open_spiel::algorithms::MCTSBot> bot;
+};
+
+namespace open_spiel {
+namespace {
+
+class CApiError : public std::runtime_error {
+ public:
+  explicit CApiError(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+// Turns SpielFatalErrors into exceptions, which Guarded catches at the
+// boundary so that they never reach the C caller.
+[[noreturn]] void ThrowingErrorHandler(const std::string& error_msg) {
+  throw CApiError(error_msg);
+}
+
+thread_local std::string last_error;
+thread_local bool has_error = false;
+
+// Runs f, returning its result, or a value-initialized one after recording
+// the message of any exception it throws.
+template <typename F>
+auto Guarded(F&& f) -> decltype(f()) {
+  static const bool error_handler_set = [] {
+    SetErrorHandler(ThrowingErrorHandler);
+    return true;
+  }();
+  (void)error_handler_set;
+  has_error = false;
+  try {
+    return f();
+  } catch (const std::exception& e) {
+    last_error = e.what();
+    has_error = true;
+  } catch (...) {
+    last_error = "Unknown error.";
+    has_error = true;
+  }
+  return decltype(f())();
+}
+
+char* CopyString(const std::string& str) {
+  char* copy = static_cast<char*>(std::malloc(str.size() + 1));
+  std::memcpy(copy, str.c_str(), str.size() + 1);
+  return copy;
+}
+
+// Writes the first capacity values to out, returning their full number.
+template <typename T, typename U>
+int CopyValues(const std::vector<T>& values, U* out, int capacity) {
+  SPIEL_CHECK_GE(capacity, 0);
+  const int size = values.size();
+  if (capacity > 0) SPIEL_CHECK_TRUE(out != nullptr);
+  std::copy_n(values.begin(), std::min(size, capacity), out);
+  return size;
+}
+
+// The same for pairs of actions and probabilities.
+int CopyActionsAndProbs(const ActionsAndProbs& values, int64_t* actions,
+                        double* probabilities, int capacity) {
+  SPIEL_CHECK_GE(capacity, 0);
+  const int size = values.size();
+  if (capacity > 0) {
+    SPIEL_CHECK_TRUE(actions != nullptr);
+    SPIEL_CHECK_TRUE(probabilities != nullptr);
+  }
+  for (int i = 0; i < std::min(size, capacity); ++i) {
+    actions[i] = values[i].first;
+    probabilities[i] = values[i].second;
+  }
+  return size;
+}
+
+OpenSpielCFRSolver* NewCFRSolver(const OpenSpielGame* game, bool plus) {
+  return Guarded([&]() -> OpenSpielCFRSolver* {
+    auto solver = std::make_unique<OpenSpielCFRSolver>();
+    solver->game = game->game;
+    if (plus) {
+      solver->solver =
+          std::make_unique<algorithms::CFRPlusSolver>(*solver->game);
+    } else {
+      solver->solver = std::make_unique<algorithms::CFRSolver>(*solver->game);
+    }
+    return solver.release();
+  });
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+using open_spiel::Guarded;
+
+extern "C" {
+
+const char* OpenSpielLastError(void) {
+  return open_spiel::has_error ? open_spiel::last_error.c_str() : nullptr;
+}
+
+void OpenSpielFreeString(char* str) { std::free(str); }
+
+OpenSpielGame* OpenSpielLoadGame(const char* game_string) {
+  return Guarded([&]() -> OpenSpielGame* {
+    return new OpenSpielGame{open_spiel::LoadGame(game_string)};
+  });
+}
+
+void OpenSpielDeleteGame(OpenSpielGame* game) { delete game; }
+
+char* OpenSpielGameToString(const OpenSpielGame* game) {
+  return Guarded([&] {
+    return open_spiel::CopyString(game->game->ToString());
+  });
+}
+
+int OpenSpielGameNumPlayers(const OpenSpielGame* game) {
+  return Guarded([&] { return game->game->NumPlayers(); });
+}
+
+int OpenSpielGameNumDistinctActions(const OpenSpielGame* game) {
+  return Guarded([&] { return game->game->NumDistinctActions(); });
+}
+
+int OpenSpielGameMaxGameLength(const OpenSpielGame* game) {
+  return Guarded([&] { return game->game->MaxGameLength(); });
+}
+
+int OpenSpielGameInformationStateTensorSize(const OpenSpielGame* game) {
+  return Guarded([&] { return game->game->InformationStateTensorSize(); });
+}
+
+int OpenSpielGameObservationTensorSize(const OpenSpielGame* game) {
+  return Guarded([&] { return game->game->ObservationTensorSize(); });
+}
+
+OpenSpielState* OpenSpielGameNewInitialState(const OpenSpielGame* game) {
+  return Guarded([&]() -> OpenSpielState* {
+    return new OpenSpielState{game->game->NewInitialState()};
+  });
+}
+
+OpenSpielState* OpenSpielGameDeserializeState(const OpenSpielGame* game,
+                                              const char* str) {
+  return Guarded([&]() -> OpenSpielState* {
+    return new OpenSpielState{game->game->DeserializeState(str)};
+  });
+}
+
+OpenSpielState* OpenSpielStateClone(const OpenSpielState* state) {
+  return Guarded([&]() -> OpenSpielState* {
+    return new OpenSpielState{state->state->Clone()};
+  });
+}
+
+void OpenSpielDeleteState(OpenSpielState* state) { delete state; }
+
+char* OpenSpielStateToString(const OpenSpielState* state) {
+  return Guarded([&] {
+    return open_spiel::CopyString(state->state->ToString());
+  });
+}
+
+char* OpenSpielStateSerialize(const OpenSpielState* state) {
+  return Guarded([&] {
+    return open_spiel::CopyString(state->state->Serialize());
+  });
+}
+
+int OpenSpielStateCurrentPlayer(const OpenSpielState* state) {
+  return Guarded([&] { return state->state->CurrentPlayer(); });
+}
+
+int OpenSpielStateIsTerminal(const OpenSpielState* state) {
+  return Guarded([&] { return static_cast<int>(state->state->IsTerminal()); });
+}
+
+int OpenSpielStateIsChanceNode(const OpenSpielState* state) {
+  return Guarded(
+      [&] { return static_cast<int>(state->state->IsChanceNode()); });
+}
+
+int OpenSpielStateIsSimultaneousNode(const OpenSpielState* state) {
+  return Guarded(
+      [&] { return static_cast<int>(state->state->IsSimultaneousNode()); });
+}
+
+void OpenSpielStateApplyAction(OpenSpielState* state, int64_t action) {
+  Guarded([&] { state->state->ApplyAction(action); });
+}
+
+void OpenSpielStateApplyActions(OpenSpielState* state, const int64_t* actions,
+                                int num_actions) {
+  Guarded([&] {
+    state->state->ApplyActions(
+        std::vector<open_spiel::Action>(actions, actions + num_actions));
+  });
+}
+
+char* OpenSpielStateActionToString(const OpenSpielState* state, int player,
+                                   int64_t action) {
+  return Guarded([&] {
+    return open_spiel::CopyString(state->state->ActionToString(player, action));
+  });
+}
+
+int OpenSpielStateLegalActions(const OpenSpielState* state, int player,
+                               int64_t* actions, int capacity) {
+  return Guarded([&] {
+    return open_spiel::CopyValues(state->state->LegalActions(player), actions,
+                                  capacity);
+  });
+}
+
+int OpenSpielStateChanceOutcomes(const OpenSpielState* state,
+                                 int64_t* actions, double* probabilities,
+                                 int capacity) {
+  return Guarded([&] {
+    return open_spiel::CopyActionsAndProbs(state->state->ChanceOutcomes(),
+                                           actions, probabilities, capacity);
+  });
+}
+
+int OpenSpielStateReturns(const OpenSpielState* state, double* returns,
+                          int capacity) {
+  return Guarded([&] {
+    return open_spiel::CopyValues(state->state->Returns(), returns, capacity);
+  });
+}
+
+int OpenSpielStateRewards(const OpenSpielState* state, double* rewards,
+                          int capacity) {
+  return Guarded([&] {
+    return open_spiel::CopyValues(state->state->Rewards(), rewards, capacity);
+  });
+}
+
+char* OpenSpielStateInformationStateString(const OpenSpielState* state,
+                                           int player) {
+  return Guarded([&] {
+    return open_spiel::CopyString(
+        state->state->InformationStateString(player));
+  });
+}
+
+char* OpenSpielStateObservationString(const OpenSpielState* state,
+                                      int player) {
+  return Guarded([&] {
+    return open_spiel::CopyString(state->state->ObservationString(player));
+  });
+}
+
+void OpenSpielStateLegalActionsMask(const OpenSpielState* state, int player,
+                                    float* mask, int size) {
+  Guarded([&] {
+    state->state->LegalActionsMask(player, absl::MakeSpan(mask, size));
+  });
+}
+
+void OpenSpielStateInformationStateTensor(const OpenSpielState* state,
+                                          int player, float* tensor,
+                                          int size) {
+  Guarded([&] {
+    state->state->InformationStateTensor(player, absl::MakeSpan(tensor, size));
+  });
+}
+
+void OpenSpielStateObservationTensor(const OpenSpielState* state, int player,
+                                     float* tensor, int size) {
+  Guarded([&] {
+    state->state->ObservationTensor(player, absl::MakeSpan(tensor, size));
+  });
+}
+
+void OpenSpielDeletePolicy(OpenSpielPolicy* policy) { delete policy; }
+
+int OpenSpielPolicyStatePolicy(const OpenSpielPolicy* policy,
+                               const OpenSpielState* state, int64_t* actions,
+                               double* probabilities, int capacity) {
+  return Guarded([&] {
+    return open_spiel::CopyActionsAndProbs(
+        policy->policy->GetStatePolicy(*state->state), actions, probabilities,
+        capacity);
+  });
+}
+
+double OpenSpielExploitability(const OpenSpielGame* game,
+                               const OpenSpielPolicy* policy) {
+  return Guarded([&] {
+    return open_spiel::algorithms::Exploitability(*game->game,
+                                                  *policy->policy);
+  });
+}
+
+double OpenSpielNashConv(const OpenSpielGame* game,
+                         const OpenSpielPolicy* policy) {
+  return Guarded([&] {
+    return open_spiel::algorithms::NashConv(*game->game, *policy->policy);
+  });
+}
+
+OpenSpielCFRSolver* OpenSpielNewCFRSolver(const OpenSpielGame* game) {
+  return open_spiel::NewCFRSolver(game, /*plus=*/false);
+}
+
+OpenSpielCFRSolver* OpenSpielNewCFRPlusSolver(const OpenSpielGame* game) {
+  return open_spiel::NewCFRSolver(game, /*plus=*/true);
+}
+
+void OpenSpielDeleteCFRSolver(OpenSpielCFRSolver* solver) { delete solver; }
+
+void OpenSpielCFRSolverRunIterations(OpenSpielCFRSolver* solver,
+                                     int num_iterations) {
+  Guarded([&] {
+    for (int i = 0; i < num_iterations; ++i) {
+      solver->solver->EvaluateAndUpdatePolicy();
+    }
+  });
+}
+
+OpenSpielPolicy* OpenSpielCFRSolverAveragePolicy(
+    const OpenSpielCFRSolver* solver) {
+  return Guarded([&]() -> OpenSpielPolicy* {
+    return new OpenSpielPolicy{solver->solver->AveragePolicy()};
+  });
+}
+
+OpenSpielMCTSBot* OpenSpielNewMCTSBot(const OpenSpielGame* game, double uct_c,
+                                      int max_simulations, int num_rollouts,
+                                      int solve, int seed) {
+  return Guarded([&]() -> OpenSpielMCTSBot* {
+    auto bot = std::make_unique<OpenSpielMCTSBot>();
+    bot->game = game->game;
+    bot->evaluator =
+        std::make_unique<open_spiel::algorithms::RandomRolloutEvaluator>(
+            num_rollouts, seed);
+    bot->bot = std::make_unique<open_spiel::algorithms::MCTSBot>(
+        *bot->game, bot->evaluator.get(), uct_c, max_simulations,
+        /*max_memory_mb=*/1000, solve != 0, seed, /*verbose=*/false);
+    return bot.release();
+  });
+}
+
+void OpenSpielDeleteMCTSBot(OpenSpielMCTSBot* bot) { delete bot; }
+
+int64_t OpenSpielMCTSBotStep(OpenSpielMCTSBot* bot,
+                             const OpenSpielState* state) {
+  return Guarded([&] { return bot->bot->Step(*state->state); });
+}
+
+}  // extern "C"
@@ -0,0 +1,139 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_C_API_OPEN_SPIEL_C_H_
+#define THIRD_PARTY_OPEN_SPIEL_C_API_OPEN_SPIEL_C_H_
+
+// A C interface to the games and some of the algorithms of OpenSpiel, for
+// languages which can call C but not C++, like Swift (see module.modulemap).
+//
+// All the objects are opaque and owned by the caller, who must release them
+// with the matching Delete function. Games outlive the states and algorithms
+// created from them as needed, so they can be deleted at any time.
+//
+// Errors (the SpielFatalErrors of the C++ code) do not abort the process: the
+// function returns 0 or NULL, and OpenSpielLastError returns the message until
+// the next call on the same thread.
+//
+// Functions returning variable-length arrays take a buffer and its capacity,
+// write at most capacity elements, and return the full length, so that they
+// can be called with a capacity of 0 to size the buffer. Tensors are instead
+// written to buffers of exactly the size of the game's tensors. Strings are
+// allocated with malloc and must be released with OpenSpielFreeString.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OpenSpielGame OpenSpielGame;
+typedef struct OpenSpielState OpenSpielState;
+typedef struct OpenSpielPolicy OpenSpielPolicy;
+typedef struct OpenSpielCFRSolver OpenSpielCFRSolver;
+typedef struct OpenSpielMCTSBot OpenSpielMCTSBot;
+
+// The message of the error raised by the last call on this thread, or NULL if
+// it succeeded. Valid until the next call.
+const char* OpenSpielLastError(void);
+void OpenSpielFreeString(char* str);
+
+// Games, loaded from strings like "kuhn_poker" or "go(board_size=9)".
+OpenSpielGame* OpenSpielLoadGame(const char* game_string);
+void OpenSpielDeleteGame(OpenSpielGame* game);
+char* OpenSpielGameToString(const OpenSpielGame* game);
+int OpenSpielGameNumPlayers(const OpenSpielGame* game);
+int OpenSpielGameNumDistinctActions(const OpenSpielGame* game);
+int OpenSpielGameMaxGameLength(const OpenSpielGame* game);
+int OpenSpielGameInformationStateTensorSize(const OpenSpielGame* game);
+int OpenSpielGameObservationTensorSize(const OpenSpielGame* game);
+OpenSpielState* OpenSpielGameNewInitialState(const OpenSpielGame* game);
+OpenSpielState* OpenSpielGameDeserializeState(const OpenSpielGame* game,
+                                              const char* str);
+
+// States.
+OpenSpielState* OpenSpielStateClone(const OpenSpielState* state);
+void OpenSpielDeleteState(OpenSpielState* state);
+char* OpenSpielStateToString(const OpenSpielState* state);
+char* OpenSpielStateSerialize(const OpenSpielState* state);
+int OpenSpielStateCurrentPlayer(const OpenSpielState* state);
+int OpenSpielStateIsTerminal(const OpenSpielState* state);
+int OpenSpielStateIsChanceNode(const OpenSpielState* state);
+int OpenSpielStateIsSimultaneousNode(const OpenSpielState* state);
+void OpenSpielStateApplyAction(OpenSpielState* state, int64_t action);
+// Applies the actions of all the players at a simultaneous node.
+void OpenSpielStateApplyActions(OpenSpielState* state, const int64_t* actions,
+                                int num_actions);
+char* OpenSpielStateActionToString(const OpenSpielState* state, int player,
+                                   int64_t action);
+int OpenSpielStateLegalActions(const OpenSpielState* state, int player,
+                               int64_t* actions, int capacity);
+// Writes the chance outcomes and their probabilities at a chance node.
+int OpenSpielStateChanceOutcomes(const OpenSpielState* state,
+                                 int64_t* actions, double* probabilities,
+                                 int capacity);
+int OpenSpielStateReturns(const OpenSpielState* state, double* returns,
+                          int capacity);
+int OpenSpielStateRewards(const OpenSpielState* state, double* rewards,
+                          int capacity);
+char* OpenSpielStateInformationStateString(const OpenSpielState* state,
+                                           int player);
+char* OpenSpielStateObservationString(const OpenSpielState* state,
+                                      int player);
+
+// Writes size = OpenSpielGameNumDistinctActions floats, 1 for the legal
+// actions of player and 0 otherwise.
+void OpenSpielStateLegalActionsMask(const OpenSpielState* state, int player,
+                                    float* mask, int size);
+// Write size = OpenSpielGame*TensorSize floats.
+void OpenSpielStateInformationStateTensor(const OpenSpielState* state,
+                                          int player, float* tensor,
+                                          int size);
+void OpenSpielStateObservationTensor(const OpenSpielState* state, int player,
+                                     float* tensor, int size);
+
+// Policies, for now the average policies of solvers. They are views of the
+// solver's tables, so they must be deleted before it.
+void OpenSpielDeletePolicy(OpenSpielPolicy* policy);
+// Writes the actions and probabilities of the policy at state.
+int OpenSpielPolicyStatePolicy(const OpenSpielPolicy* policy,
+                               const OpenSpielState* state, int64_t* actions,
+                               double* probabilities, int capacity);
+double OpenSpielExploitability(const OpenSpielGame* game,
+                               const OpenSpielPolicy* policy);
+double OpenSpielNashConv(const OpenSpielGame* game,
+                         const OpenSpielPolicy* policy);
+
+// Tabular CFR and CFR+, see algorithms/cfr.h.
+OpenSpielCFRSolver* OpenSpielNewCFRSolver(const OpenSpielGame* game);
+OpenSpielCFRSolver* OpenSpielNewCFRPlusSolver(const OpenSpielGame* game);
+void OpenSpielDeleteCFRSolver(OpenSpielCFRSolver* solver);
+void OpenSpielCFRSolverRunIterations(OpenSpielCFRSolver* solver,
+                                     int num_iterations);
+OpenSpielPolicy* OpenSpielCFRSolverAveragePolicy(
+    const OpenSpielCFRSolver* solver);
+
+// MCTS with random rollouts, see algorithms/mcts.h.
+OpenSpielMCTSBot* OpenSpielNewMCTSBot(const OpenSpielGame* game, double uct_c,
+                                      int max_simulations, int num_rollouts,
+                                      int solve, int seed);
+void OpenSpielDeleteMCTSBot(OpenSpielMCTSBot* bot);
+int64_t OpenSpielMCTSBotStep(OpenSpielMCTSBot* bot,
+                             const OpenSpielState* state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_C_API_OPEN_SPIEL_C_H_
@@ -0,0 +1,100 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/chance_distribution.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+ChanceDistribution::ChanceDistribution(ActionsAndProbs outcomes)
+    : outcomes_(std::move(outcomes)) {
+  const int n = outcomes_.size();
+  SPIEL_CHECK_GT(n, 0);
+  double sum = 0;
+  for (const auto& [action, prob] : outcomes_) {
+    SPIEL_CHECK_GE(prob, 0);
+    SPIEL_CHECK_LE(prob, 1);
+    sum += prob;
+  }
+  SPIEL_CHECK_FLOAT_EQ(sum, 1.0);
+
+  threshold_.resize(n);
+  alias_.resize(n);
+  std::vector<int> small;
+  std::vector<int> large;
+  for (int i = 0; i < n; ++i) {
+    threshold_[i] = outcomes_[i].second * n;
+    alias_[i] = i;
+    (threshold_[i] < 1 ? small : large).push_back(i);
+  }
+  // Each small column is topped up to 1 by a large one, which then goes in
+  // either list for what it has left.
+  while (!small.empty() && !large.empty()) {
+    const int s = small.back();
+    small.pop_back();
+    const int l = large.back();
+    alias_[s] = l;
+    threshold_[l] -= 1 - threshold_[s];
+    if (threshold_[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // What is left is 1 up to rounding.
+  for (int i : small) threshold_[i] = 1;
+  for (int i : large) threshold_[i] = 1;
+}
+
+std::pair<Action, double> ChanceDistribution::Sample(double z) const {
+  SPIEL_CHECK_GE(z, 0);
+  SPIEL_CHECK_LT(z, 1);
+  const int n = outcomes_.size();
+  const double u = z * n;
+  const int column = std::min(static_cast<int>(u), n - 1);
+  return u - column < threshold_[column] ? outcomes_[column]
+                                         : outcomes_[alias_[column]];
+}
+
+std::pair<Action, double> ChanceDistribution::Sample(
+    absl::BitGenRef rng) const {
+  return Sample(absl::Uniform(rng, 0.0, 1.0));
+}
+
+const ChanceDistribution& ChanceDistributionCache::Get(
+    int64_t context, const std::function<ActionsAndProbs()>& build) const {
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    auto it = distributions_.find(context);
+    if (it != distributions_.end()) return *it->second;
+  }
+  // Built outside the lock; if another thread got there first, its
+  // distribution is kept.
+  auto distribution = std::make_unique<ChanceDistribution>(build());
+  absl::MutexLock lock(&mutex_);
+  return *distributions_.try_emplace(context, std::move(distribution))
+              .first->second;
+}
+
+int ChanceDistributionCache::size() const {
+  absl::ReaderMutexLock lock(&mutex_);
+  return distributions_.size();
+}
+
+}  // namespace open_spiel
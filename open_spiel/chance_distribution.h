@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_CHANCE_DISTRIBUTION_H_
+#define THIRD_PARTY_OPEN_SPIEL_CHANCE_DISTRIBUTION_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/random/bit_gen_ref.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/spiel.h"
+
+// Precomputed chance distributions, for the games whose chance nodes share a
+// few distributions (dice rolls, deals from a deck), to be used by their
+// State::SampleChanceOutcome overrides instead of building the outcomes and
+// scanning them at every node.
+
+namespace open_spiel {
+
+// A fixed distribution over chance outcomes, sampled in constant time with
+// Walker's alias method (in Vose's construction).
+class ChanceDistribution {
+ public:
+  // The probabilities must sum to 1, as for SampleAction.
+  explicit ChanceDistribution(ActionsAndProbs outcomes);
+
+  const ActionsAndProbs& outcomes() const { return outcomes_; }
+
+  // Returns the sampled outcome and its probability, from a single uniform
+  // draw z in [0, 1) like SampleAction, so that both consume the same random
+  // numbers. For uniform distributions they also return the same outcomes,
+  // up to rounding.
+  std::pair<Action, double> Sample(double z) const;
+  std::pair<Action, double> Sample(absl::BitGenRef rng) const;
+
+ private:
+  ActionsAndProbs outcomes_;
+  // Column i of the table returns outcome i if the fractional part of the
+  // draw is below threshold_[i] and outcome alias_[i] otherwise.
+  std::vector<double> threshold_;
+  std::vector<int> alias_;
+};
+
+// The distributions of a game, keyed by a game-defined chance context (e.g.
+// the set of cards left in the deck) and built on first use. It is meant to
+// be a mutable member of the Game, shared by its states, and is thread-safe.
+// Entries are never evicted, so the contexts should be few.
+class ChanceDistributionCache {
+ public:
+  ChanceDistributionCache() = default;
+  // Copies start empty, so that the games owning a cache can be copied.
+  ChanceDistributionCache(const ChanceDistributionCache&) {}
+
+  // Returns the distribution of context, calling build to make it if needed.
+  // The reference stays valid for the lifetime of the cache.
+  const ChanceDistribution& Get(
+      int64_t context, const std::function<ActionsAndProbs()>& build) const;
+
+  int size() const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  mutable absl::flat_hash_map<int64_t, std::unique_ptr<ChanceDistribution>>
+      distributions_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_CHANCE_DISTRIBUTION_H_
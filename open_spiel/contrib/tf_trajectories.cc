@@ -23,8 +23,10 @@
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "third_party/eigen3/unsupported/Eigen/CXX11/src/Tensor/TensorMap.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace algorithms {
@@ -33,8 +35,16 @@ namespace tf = tensorflow;
 using Tensor = Eigen::Tensor<float, 2, Eigen::RowMajor>;
 using TensorMap = Eigen::TensorMap<Tensor, Eigen::Aligned>;
 
+namespace {
+InferenceBackendRegisterer tensorflow_registerer(
+    "tensorflow", [](const Game& game, const std::string& path) {
+      return std::make_unique<TFInferenceModel>(game, path);
+    });
+}  // namespace
+
 TFBatchTrajectoryRecorder::TFBatchTrajectoryRecorder(
-    const Game& game, const std::string& graph_filename, int batch_size)
+    const Game& game, const std::string& graph_filename, int batch_size,
+    int num_threads)
     : batch_size_(batch_size),
       states_(),
       terminal_flags_(std::vector<int>(batch_size, 0)),
@@ -44,7 +54,10 @@ TFBatchTrajectoryRecorder::TFBatchTrajectoryRecorder(
       rng_(),
       dist_(0.0, 1.0),
       flat_input_size_(game_->InformationStateTensorSize()),
-      num_actions_(game_->NumDistinctActions()) {
+      num_actions_(game_->NumDistinctActions()),
+      num_threads_(num_threads),
+      half_bounds_({0, batch_size / 2, batch_size}) {
+  SPIEL_CHECK_GE(num_threads, 1);
   TF_CHECK_OK(
       ReadBinaryProto(tf::Env::Default(), graph_filename_, &graph_def_));
   InitTF();
@@ -96,6 +109,13 @@ void TFBatchTrajectoryRecorder::InitTF() {
                           tf::TensorShape({batch_size_, flat_input_size_}));
   tf_legal_mask_ =
       tf::Tensor(tf::DT_FLOAT, tf::TensorShape({batch_size_, num_actions_}));
+  for (int h = 0; h < 2; ++h) {
+    const int num_rows = half_bounds_[h + 1] - half_bounds_[h];
+    half_inputs_[h] = tf::Tensor(
+        tf::DT_FLOAT, tf::TensorShape({num_rows, flat_input_size_}));
+    half_legal_masks_[h] =
+        tf::Tensor(tf::DT_FLOAT, tf::TensorShape({num_rows, num_actions_}));
+  }
 
   // Set GPU options
   tf::graph::SetDefaultDevice("/cpu:0", &graph_def_);
@@ -115,36 +135,61 @@ void TFBatchTrajectoryRecorder::InitTF() {
 }
 
 void TFBatchTrajectoryRecorder::FillInputsAndMasks() {
-  TensorMap inputs_matrix = tf_inputs_.matrix<float>();
-  TensorMap mask_matrix = tf_legal_mask_.matrix<float>();
+  FillInputsAndMasks(0, batch_size_, &tf_inputs_, &tf_legal_mask_);
+}
 
-  std::vector<double> info_state_vector;
-  for (int b = 0; b < batch_size_; ++b) {
-    if (!terminal_flags_[b]) {
-      std::vector<int> mask = states_[b]->LegalActionsMask();
-      // Is there a way to use a vector operation here?
-      for (int a = 0; a < mask.size(); ++a) {
-        mask_matrix(b, a) = mask[a];
-      }
-
-      states_[b]->InformationStateTensor(states_[b]->CurrentPlayer(),
-                                         &info_state_vector);
-      for (int i = 0; i < info_state_vector.size(); ++i) {
-        inputs_matrix(b, i) = info_state_vector[i];
-      }
+void TFBatchTrajectoryRecorder::FillInputsAndMasks(int begin, int end,
+                                                   tf::Tensor* inputs,
+                                                   tf::Tensor* legal_mask) {
+  float* inputs_data = inputs->flat<float>().data();
+  float* mask_data = legal_mask->flat<float>().data();
+  // The rows are written in place, and split between the threads in
+  // contiguous blocks.
+  auto fill_rows = [&](int first_row, int last_row) {
+    for (int b = first_row; b < last_row; ++b) {
+      if (terminal_flags_[b]) continue;
+      const State& state = *states_[b];
+      const Player player = state.CurrentPlayer();
+      state.LegalActionsMask(
+          player, absl::MakeSpan(mask_data + (b - begin) * num_actions_,
+                                 num_actions_));
+      state.InformationStateTensor(
+          player, absl::MakeSpan(inputs_data + (b - begin) * flat_input_size_,
+                                 flat_input_size_));
     }
+  };
+  const int num_threads = std::min(num_threads_, end - begin);
+  if (num_threads <= 1) {
+    fill_rows(begin, end);
+    return;
   }
+  std::vector<Thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    const int first_row = begin + (end - begin) * t / num_threads;
+    const int last_row = begin + (end - begin) * (t + 1) / num_threads;
+    threads.emplace_back([&fill_rows, first_row, last_row]() {
+      fill_rows(first_row, last_row);
+    });
+  }
+  for (Thread& thread : threads) thread.join();
 }
 
 void TFBatchTrajectoryRecorder::ApplyActions() {
-  std::vector<double> prob_dist(num_actions_, 0.0);
-  auto sampled_action = tf_outputs_[1].matrix<int64>();
-  for (int b = 0; b < batch_size_; ++b) {
+  ApplyActions(0, batch_size_, tf_legal_mask_, tf_outputs_);
+}
+
+void TFBatchTrajectoryRecorder::ApplyActions(
+    int begin, int end, const tf::Tensor& legal_mask,
+    const std::vector<tf::Tensor>& outputs) {
+  auto sampled_action = outputs[1].matrix<int64>();
+  auto mask_matrix = legal_mask.matrix<float>();
+  for (int b = begin; b < end; ++b) {
     if (!terminal_flags_[b]) {
-      Action action = sampled_action(b);
+      Action action = sampled_action(b - begin);
       SPIEL_CHECK_GE(action, 0);
       SPIEL_CHECK_LT(action, num_actions_);
-      SPIEL_CHECK_EQ(tf_legal_mask_.matrix<float>()(b, action), 1);
+      SPIEL_CHECK_EQ(mask_matrix(b - begin, action), 1);
       states_[b]->ApplyAction(action);
       SampleChance(b);
     }
@@ -152,9 +197,15 @@ void TFBatchTrajectoryRecorder::ApplyActions() {
 }
 
 void TFBatchTrajectoryRecorder::RunInference() {
+  RunInference(tf_inputs_, tf_legal_mask_, &tf_outputs_);
+}
+
+void TFBatchTrajectoryRecorder::RunInference(
+    const tf::Tensor& inputs, const tf::Tensor& legal_mask,
+    std::vector<tf::Tensor>* outputs) {
   TF_CHECK_OK(tf_session_->Run(
-      {{"input", tf_inputs_}, {"legals_mask", tf_legal_mask_}},
-      {"policy_softmax", "sampled_actions/Multinomial"}, {}, &tf_outputs_));
+      {{"input", inputs}, {"legals_mask", legal_mask}},
+      {"policy_softmax", "sampled_actions/Multinomial"}, {}, outputs));
 }
 
 void TFBatchTrajectoryRecorder::GetNextStatesTF() {
@@ -172,5 +223,95 @@ void TFBatchTrajectoryRecorder::Record() {
   }
 }
 
+bool TFBatchTrajectoryRecorder::AllTerminal(int begin, int end) const {
+  for (int b = begin; b < end; ++b) {
+    if (!terminal_flags_[b]) return false;
+  }
+  return true;
+}
+
+void TFBatchTrajectoryRecorder::RecordPipelined() {
+  SPIEL_CHECK_GE(batch_size_, 2);
+  Reset();
+  auto half_done = [this](int h) {
+    return AllTerminal(half_bounds_[h], half_bounds_[h + 1]);
+  };
+  auto fill = [this](int h) {
+    FillInputsAndMasks(half_bounds_[h], half_bounds_[h + 1], &half_inputs_[h],
+                       &half_legal_masks_[h]);
+  };
+  // The half whose inference runs, or -1. The others that are not done have
+  // their inputs filled and wait for the session.
+  int running = -1;
+  std::unique_ptr<Thread> inference;
+  auto start_inference = [&](int h) {
+    running = h;
+    inference = std::make_unique<Thread>([this, h]() {
+      RunInference(half_inputs_[h], half_legal_masks_[h], &half_outputs_[h]);
+    });
+  };
+  fill(0);
+  fill(1);
+  if (!half_done(0)) {
+    start_inference(0);
+  } else if (!half_done(1)) {
+    start_inference(1);
+  }
+  while (running >= 0) {
+    const int h = running;
+    inference->join();
+    running = -1;
+    if (!half_done(1 - h)) start_inference(1 - h);
+    ApplyActions(half_bounds_[h], half_bounds_[h + 1], half_legal_masks_[h],
+                 half_outputs_[h]);
+    if (!half_done(h)) {
+      fill(h);
+      if (running < 0) start_inference(h);
+    }
+  }
+}
+
+TFInferenceModel::TFInferenceModel(const Game& game,
+                                   const std::string& graph_filename)
+    : input_size_(game.InformationStateTensorSize()),
+      num_actions_(game.NumDistinctActions()) {
+  TF_CHECK_OK(ReadBinaryProto(tf::Env::Default(), graph_filename, &graph_def_));
+  tf::graph::SetDefaultDevice("/cpu:0", &graph_def_);
+  TF_CHECK_OK(NewSession(tf::SessionOptions(), &tf_session_));
+  TF_CHECK_OK(tf_session_->Create(graph_def_));
+  TF_CHECK_OK(tf_session_->Run({}, {}, {"init_all_vars_op"}, nullptr));
+}
+
+TFInferenceModel::~TFInferenceModel() {
+  if (tf_session_ != nullptr) {
+    TF_CHECK_OK(tf_session_->Close());
+    delete tf_session_;
+  }
+}
+
+void TFInferenceModel::Infer(int batch_size, absl::Span<const float> inputs,
+                             absl::Span<const float> legal_masks,
+                             absl::Span<float> policies,
+                             absl::Span<float> values) const {
+  if (!values.empty()) SpielFatalError("The graph has no value head.");
+  SPIEL_CHECK_EQ(inputs.size(), batch_size * input_size_);
+  SPIEL_CHECK_EQ(legal_masks.size(), batch_size * num_actions_);
+  SPIEL_CHECK_EQ(policies.size(), batch_size * num_actions_);
+  tf::Tensor tf_inputs(tf::DT_FLOAT,
+                       tf::TensorShape({batch_size, input_size_}));
+  tf::Tensor tf_legal_mask(tf::DT_FLOAT,
+                           tf::TensorShape({batch_size, num_actions_}));
+  std::memcpy(tf_inputs.flat<float>().data(), inputs.data(),
+              inputs.size() * sizeof(float));
+  std::memcpy(tf_legal_mask.flat<float>().data(), legal_masks.data(),
+              legal_masks.size() * sizeof(float));
+  std::vector<tf::Tensor> outputs;
+  TF_CHECK_OK(tf_session_->Run(
+      {{"input", tf_inputs}, {"legals_mask", tf_legal_mask}},
+      {"policy_softmax"}, {}, &outputs));
+  std::memcpy(policies.data(), outputs[0].flat<float>().data(),
+              policies.size() * sizeof(float));
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
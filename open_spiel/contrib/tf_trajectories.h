@@ -15,8 +15,12 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_CONTRIB_TF_TRAJECTORIES_H_
 #define THIRD_PARTY_OPEN_SPIEL_CONTRIB_TF_TRAJECTORIES_H_
 
+#include <array>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "open_spiel/algorithms/batched_inference.h"
 #include "open_spiel/spiel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/default_device.h"
@@ -42,8 +46,10 @@ namespace algorithms {
 
 class TFBatchTrajectoryRecorder {
  public:
+  // With num_threads > 1, the inputs and masks are filled by that many
+  // threads.
   TFBatchTrajectoryRecorder(const Game& game, const std::string& graph_filename,
-                            int batch_size);
+                            int batch_size, int num_threads = 1);
 
   // Reset all the games to their initial states and clears the terminal flags.
   // The random number generator is *not* reset.
@@ -54,6 +60,13 @@ class TFBatchTrajectoryRecorder {
   // structures (see algorithms/trajectories.{h,cc}).
   void Record();
 
+  // Same as Record, with the batch split into two halves, which have their
+  // own input tensors: while the inference runs on one half, the other half
+  // applies its actions and fills its next inputs, so that neither the
+  // session nor the CPU waits for the other. This needs a batch size of at
+  // least 2.
+  void RecordPipelined();
+
  protected:
   void ApplyActions();
 
@@ -70,6 +83,15 @@ class TFBatchTrajectoryRecorder {
   void FillInputsAndMasks();
   void RunInference();
   void GetNextStatesTF();
+  // Same as above for the rows [begin, end) of the batch, with their own
+  // tensors, of end - begin rows.
+  void FillInputsAndMasks(int begin, int end, tensorflow::Tensor* inputs,
+                          tensorflow::Tensor* legal_mask);
+  void RunInference(const tensorflow::Tensor& inputs,
+                    const tensorflow::Tensor& legal_mask,
+                    std::vector<tensorflow::Tensor>* outputs);
+  void ApplyActions(int begin, int end, const tensorflow::Tensor& legal_mask,
+                    const std::vector<tensorflow::Tensor>& outputs);
   int num_terminals_;
   std::vector<tensorflow::Tensor> tf_outputs_;
 
@@ -79,6 +101,8 @@ class TFBatchTrajectoryRecorder {
   void GetNextStatesUniform();
 
   void InitTF();
+  // Whether the states of the rows [begin, end) are all terminal.
+  bool AllTerminal(int begin, int end) const;
 
   std::shared_ptr<const Game> game_;
   std::string graph_filename_;
@@ -89,11 +113,40 @@ class TFBatchTrajectoryRecorder {
   // Tensorflow variables
   int flat_input_size_;
   int num_actions_;
+  int num_threads_;
+  // The bounds and tensors of the halves of the batch for RecordPipelined.
+  std::array<int, 3> half_bounds_;
+  std::array<tensorflow::Tensor, 2> half_inputs_;
+  std::array<tensorflow::Tensor, 2> half_legal_masks_;
+  std::array<std::vector<tensorflow::Tensor>, 2> half_outputs_;
   tensorflow::Session* tf_session_ = nullptr;
   tensorflow::GraphDef graph_def_;
   tensorflow::SessionOptions tf_opts_;
 };
 
+// The policy of a graph exported as for TFBatchTrajectoryRecorder, as an
+// InferenceModel, e.g. for RecordInferenceBatchedTrajectory, InferenceEvaluator
+// or InferencePolicy (see algorithms/batched_inference.h). It is registered as
+// the "tensorflow" backend of LoadInferenceModel. The graph has no value head.
+class TFInferenceModel : public InferenceModel {
+ public:
+  TFInferenceModel(const Game& game, const std::string& graph_filename);
+  ~TFInferenceModel() override;
+
+  int InputSize() const override { return input_size_; }
+  int NumActions() const override { return num_actions_; }
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override;
+
+ private:
+  int input_size_;
+  int num_actions_;
+  tensorflow::GraphDef graph_def_;
+  // Session::Run is thread-safe.
+  tensorflow::Session* tf_session_ = nullptr;
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -0,0 +1,239 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the CFR family of solvers on a set of games: each solver runs on
+// each game for a time budget, and the NashConv of its average policy is
+// recorded at geometrically spaced iterations, giving convergence against
+// wall-clock time. The results, including iterations per second and peak
+// memory, are written as JSON.
+//
+// Evaluation time is excluded from the solver time. The peak memory is that
+// of the process during the run, which on Linux is reset between runs, but
+// can include memory the allocator kept from earlier runs: run a single
+// solver and game per process for precise numbers.
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/match.h"
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/strings/strip.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/cfr_br.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/algorithms/outcome_sampling_mccfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/json.h"
+
+ABSL_FLAG(std::string, games,
+          "kuhn_poker;leduc_poker;liars_dice;"
+          "turn_based_simultaneous_game(game=goofspiel(imp_info=True,"
+          "num_cards=3,points_order=random));"
+          "turn_based_simultaneous_game(game=goofspiel(imp_info=True,"
+          "num_cards=4,points_order=descending))",
+          "The games to run the solvers on, separated by ';'.");
+ABSL_FLAG(std::string, solvers,
+          "cfr;cfr_plus;cfr_br;external_sampling_mccfr;outcome_sampling_mccfr",
+          "The solvers to run, separated by ';'.");
+ABSL_FLAG(double, max_seconds, 10,
+          "The solver time, evaluations excluded, after which runs stop.");
+ABSL_FLAG(int, max_iterations, 1000000,
+          "The number of iterations after which runs stop.");
+ABSL_FLAG(double, eval_growth, 2,
+          "The factor between the iterations at which NashConv is computed.");
+ABSL_FLAG(int, seed, 0, "The seed of the sampling solvers.");
+ABSL_FLAG(std::string, output, "",
+          "The file to write the JSON results to, or stdout if empty.");
+
+namespace open_spiel {
+namespace {
+
+// Lets the benchmark skip the solvers which do not support a game rather than
+// exiting.
+class BenchmarkError : public std::runtime_error {
+ public:
+  explicit BenchmarkError(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+[[noreturn]] void ThrowingErrorHandler(const std::string& error_msg) {
+  throw BenchmarkError(error_msg);
+}
+
+// Resets the peak resident memory of the process, where supported.
+void ResetPeakMemory() {
+#ifdef __linux__
+  std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+// The peak resident memory of the process in MB, or -1 if unknown.
+double PeakMemoryMb() {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    absl::string_view value = line;
+    if (absl::ConsumePrefix(&value, "VmHWM:")) {
+      int64_t kb;
+      if (absl::SimpleAtoi(absl::StripSuffix(absl::StripAsciiWhitespace(value),
+                                             "kB"),
+                           &kb)) {
+        return kb / 1024.0;
+      }
+    }
+  }
+#endif
+  return -1;
+}
+
+// A type-erased solver: runs one iteration, or returns its average policy.
+struct Solver {
+  std::function<void()> run_iteration;
+  std::function<std::unique_ptr<Policy>()> average_policy;
+};
+
+// The solver objects are owned by the closures.
+Solver MakeSolver(const std::string& name, const Game& game, int seed) {
+  if (name == "cfr" || name == "cfr_plus" || name == "cfr_br") {
+    std::shared_ptr<algorithms::CFRSolverBase> solver;
+    if (name == "cfr") {
+      solver = std::make_shared<algorithms::CFRSolver>(game);
+    } else if (name == "cfr_plus") {
+      solver = std::make_shared<algorithms::CFRPlusSolver>(game);
+    } else {
+      solver = std::make_shared<algorithms::CFRBRSolver>(game);
+    }
+    return {[solver] { solver->EvaluateAndUpdatePolicy(); },
+            [solver] { return solver->AveragePolicy(); }};
+  } else if (name == "external_sampling_mccfr") {
+    auto solver =
+        std::make_shared<algorithms::ExternalSamplingMCCFRSolver>(game, seed);
+    return {[solver] { solver->RunIteration(); },
+            [solver] { return solver->AveragePolicy(); }};
+  } else if (name == "outcome_sampling_mccfr") {
+    auto solver = std::make_shared<algorithms::OutcomeSamplingMCCFRSolver>(
+        game, algorithms::OutcomeSamplingMCCFRSolver::kDefaultEpsilon, seed);
+    return {[solver] { solver->RunIteration(); },
+            [solver] { return solver->AveragePolicy(); }};
+  }
+  SpielFatalError(absl::StrCat("Unknown solver: ", name));
+}
+
+json::Object RunBenchmark(const std::string& game_string,
+                          const std::string& solver_name) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  ResetPeakMemory();
+  Solver solver = MakeSolver(solver_name, *game, absl::GetFlag(FLAGS_seed));
+
+  const double max_seconds = absl::GetFlag(FLAGS_max_seconds);
+  const int max_iterations = absl::GetFlag(FLAGS_max_iterations);
+  const double eval_growth = absl::GetFlag(FLAGS_eval_growth);
+  SPIEL_CHECK_GT(eval_growth, 1);
+  json::Array curve;
+  absl::Duration solver_time;
+  int iterations = 0;
+  double next_eval = 1;
+  while (true) {
+    const absl::Time start = absl::Now();
+    solver.run_iteration();
+    solver_time += absl::Now() - start;
+    ++iterations;
+    const bool done = iterations >= max_iterations ||
+                      absl::ToDoubleSeconds(solver_time) >= max_seconds;
+    if (iterations >= next_eval || done) {
+      const double nash_conv =
+          algorithms::NashConv(*game, *solver.average_policy());
+      curve.push_back(json::Object({
+          {"iteration", iterations},
+          {"seconds", absl::ToDoubleSeconds(solver_time)},
+          {"nash_conv", nash_conv},
+      }));
+      std::cerr << game_string << " " << solver_name << " iteration "
+                << iterations << " seconds "
+                << absl::ToDoubleSeconds(solver_time) << " nash_conv "
+                << nash_conv << std::endl;
+      while (next_eval <= iterations) next_eval *= eval_growth;
+    }
+    if (done) break;
+  }
+
+  const double seconds = absl::ToDoubleSeconds(solver_time);
+  return json::Object({
+      {"game", game_string},
+      {"solver", solver_name},
+      {"iterations", iterations},
+      {"seconds", seconds},
+      {"iterations_per_second", iterations / seconds},
+      {"peak_memory_mb", PeakMemoryMb()},
+      {"nash_conv", curve.back().GetObject().at("nash_conv")},
+      {"curve", curve},
+  });
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  open_spiel::SetErrorHandler(open_spiel::ThrowingErrorHandler);
+
+  const std::vector<std::string> games =
+      absl::StrSplit(absl::GetFlag(FLAGS_games), ';');
+  const std::vector<std::string> solvers =
+      absl::StrSplit(absl::GetFlag(FLAGS_solvers), ';');
+  open_spiel::json::Array runs;
+  for (const std::string& game : games) {
+    for (const std::string& solver : solvers) {
+      try {
+        runs.push_back(open_spiel::RunBenchmark(game, solver));
+      } catch (const open_spiel::BenchmarkError& e) {
+        std::cerr << game << " " << solver << " skipped: " << e.what()
+                  << std::endl;
+      }
+    }
+  }
+
+  open_spiel::json::Object context = {
+      {"date", absl::FormatTime(absl::Now())},
+      {"max_seconds", absl::GetFlag(FLAGS_max_seconds)},
+      {"max_iterations", absl::GetFlag(FLAGS_max_iterations)},
+      {"seed", absl::GetFlag(FLAGS_seed)},
+  };
+  const std::string out =
+      open_spiel::json::ToString(
+          open_spiel::json::Object({{"context", context}, {"runs", runs}}),
+          /*wrap=*/true) +
+      "\n";
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (output.empty()) {
+    std::cout << out;
+  } else {
+    open_spiel::file::File(output, "w").Write(out);
+  }
+}
@@ -41,6 +41,10 @@ int RandomSimulation(std::mt19937* rng, const Game& game, bool verbose) {
   bool provides_info_state = game.GetType().provides_information_state_tensor;
   bool provides_observations = game.GetType().provides_observation_tensor;
 
+  // Reused across moves to avoid allocating a new vector of legal actions at
+  // every step.
+  std::vector<Action> actions;
+
   int game_length = 0;
   while (!state->IsTerminal()) {
     if (provides_observations && state->CurrentPlayer() >= 0) {
@@ -63,7 +67,6 @@ int RandomSimulation(std::mt19937* rng, const Game& game, bool verbose) {
       // Sample an action for each player
       std::vector<Action> joint_action;
       for (int p = 0; p < game.NumPlayers(); p++) {
-        std::vector<Action> actions;
         actions = state->LegalActions(p);
         std::uniform_int_distribution<int> dis(0, actions.size() - 1);
         Action action = actions[dis(*rng)];
@@ -77,7 +80,7 @@ int RandomSimulation(std::mt19937* rng, const Game& game, bool verbose) {
       state->ApplyActions(joint_action);
     } else {
       // Sample an action uniformly.
-      std::vector<Action> actions = state->LegalActions();
+      state->LegalActions(&actions);
       std::uniform_int_distribution<int> dis(0, actions.size() - 1);
       Action action = actions[dis(*rng)];
       if (verbose) {
@@ -0,0 +1,290 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Micro-benchmarks of the State operations of each game, for tracking their
+// costs across releases. Unlike benchmark_game, which times whole random
+// games, every operation is timed on its own, on a fixed set of states
+// sampled from random games, and the results can be written as JSON (in the
+// layout of Google Benchmark's) or CSV.
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/json.h"
+
+ABSL_FLAG(std::string, games, "",
+          "The games to benchmark, separated by ';', or all the registered "
+          "games without mandatory parameters if empty.");
+ABSL_FLAG(int, num_states, 100,
+          "How many states to sample from random games for each game.");
+ABSL_FLAG(int, max_game_length, 1000,
+          "The number of actions after which random games are cut short.");
+ABSL_FLAG(double, min_time, 0.1,
+          "The minimum time in seconds to spend timing each operation.");
+ABSL_FLAG(int, seed, 0, "The seed of the random games.");
+ABSL_FLAG(std::string, format, "console", "One of console, json or csv.");
+ABSL_FLAG(std::string, output, "",
+          "The file to write the results to, or stdout if empty.");
+
+namespace open_spiel {
+namespace {
+
+// Lets the benchmarks skip the games and operations which fail, e.g. because
+// they are not implemented, rather than exiting.
+class BenchmarkError : public std::runtime_error {
+ public:
+  explicit BenchmarkError(const std::string& message)
+      : std::runtime_error(message) {}
+};
+
+[[noreturn]] void ThrowingErrorHandler(const std::string& error_msg) {
+  throw BenchmarkError(error_msg);
+}
+
+struct Result {
+  std::string game;
+  std::string operation;
+  int64_t iterations;
+  double ns_per_op;
+};
+
+// A state sampled from a random game, with the action taken there.
+struct Sample {
+  std::unique_ptr<State> state;
+  Player player;
+  Action action;
+};
+
+// Samples non-terminal decision (or simultaneous) states from random games,
+// keeping each one visited with a fixed probability.
+std::vector<Sample> SampleStates(const Game& game, int num_states,
+                                 int max_game_length, std::mt19937* rng) {
+  std::vector<Sample> samples;
+  for (int games = 0; samples.size() < num_states; ++games) {
+    if (games >= 100 * num_states) {
+      SpielFatalError("Too few decision states in random games.");
+    }
+    std::unique_ptr<State> state = game.NewInitialState();
+    for (int i = 0; i < max_game_length && !state->IsTerminal(); ++i) {
+      Action action;
+      if (state->IsChanceNode()) {
+        action = state->SampleChanceOutcome(*rng).first;
+      } else {
+        std::vector<Action> actions = state->LegalActions();
+        std::uniform_int_distribution<int> dis(0, actions.size() - 1);
+        action = actions[dis(*rng)];
+        if (std::uniform_real_distribution<double>()(*rng) < 0.2 &&
+            samples.size() < num_states) {
+          samples.push_back({state->Clone(), state->CurrentPlayer(), action});
+        }
+      }
+      state->ApplyAction(action);
+    }
+  }
+  return samples;
+}
+
+// Runs op(i) on every sample i until at least min_time has been spent in it,
+// calling prepare() untimed before each pass over the samples.
+template <typename Prepare, typename Op>
+Result Measure(const std::string& game, const std::string& operation,
+               int num_samples, double min_time, Prepare prepare, Op op) {
+  int64_t iterations = 0;
+  absl::Duration elapsed;
+  do {
+    prepare();
+    const absl::Time start = absl::Now();
+    for (int i = 0; i < num_samples; ++i) op(i);
+    elapsed += absl::Now() - start;
+    iterations += num_samples;
+  } while (absl::ToDoubleSeconds(elapsed) < min_time);
+  return {game, operation, iterations,
+          absl::ToDoubleNanoseconds(elapsed) / iterations};
+}
+
+// Keeps the compiler from optimizing the operations away.
+volatile int64_t sink = 0;
+
+std::vector<Result> BenchmarkGame(const std::string& game_string,
+                                  int num_states, int max_game_length,
+                                  double min_time, int seed) {
+  std::shared_ptr<const Game> game = LoadGame(game_string);
+  const GameType& type = game->GetType();
+  std::mt19937 rng(seed);
+  std::vector<Sample> samples =
+      SampleStates(*game, num_states, max_game_length, &rng);
+  const int n = samples.size();
+  auto no_prepare = [] {};
+  // Mutable copies of the samples, refreshed untimed between passes.
+  std::vector<std::unique_ptr<State>> copies(n);
+  auto copy_samples = [&] {
+    for (int i = 0; i < n; ++i) copies[i] = samples[i].state->Clone();
+  };
+
+  std::vector<Result> results;
+  auto run = [&](const std::string& operation, auto prepare, auto op) {
+    try {
+      results.push_back(
+          Measure(game_string, operation, n, min_time, prepare, op));
+    } catch (const BenchmarkError& e) {
+      std::cerr << game_string << " " << operation
+                << " skipped: " << e.what() << std::endl;
+    }
+  };
+
+  run("Clone", no_prepare, [&](int i) {
+    sink += samples[i].state->Clone()->IsTerminal();
+  });
+  run("LegalActions", no_prepare, [&](int i) {
+    sink += samples[i].state->LegalActions().size();
+  });
+  run("ApplyAction", copy_samples,
+      [&](int i) { copies[i]->ApplyAction(samples[i].action); });
+  run("UndoAction",
+      [&] {
+        copy_samples();
+        for (int i = 0; i < n; ++i) copies[i]->ApplyAction(samples[i].action);
+      },
+      [&](int i) {
+        copies[i]->UndoAction(samples[i].player, samples[i].action);
+      });
+  if (type.provides_observation_tensor) {
+    std::vector<float> tensor(game->ObservationTensorSize());
+    run("ObservationTensor", no_prepare, [&](int i) {
+      samples[i].state->ObservationTensor(std::max(samples[i].player, 0),
+                                          absl::MakeSpan(tensor));
+      sink += tensor.empty() ? 0 : tensor[0];
+    });
+  }
+  if (type.provides_information_state_string) {
+    run("InformationStateString", no_prepare, [&](int i) {
+      sink += samples[i]
+                  .state->InformationStateString(
+                      std::max(samples[i].player, 0))
+                  .size();
+    });
+  }
+  run("Serialize", no_prepare,
+      [&](int i) { sink += samples[i].state->Serialize().size(); });
+  return results;
+}
+
+std::vector<std::string> GamesToBenchmark(const std::string& games) {
+  if (!games.empty()) return absl::StrSplit(games, ';');
+  std::vector<std::string> names;
+  for (const GameType& type : RegisteredGameTypes()) {
+    bool mandatory_parameters = false;
+    for (const auto& [name, parameter] : type.parameter_specification) {
+      mandatory_parameters |= parameter.is_mandatory();
+    }
+    if (!mandatory_parameters) names.push_back(type.short_name);
+  }
+  return names;
+}
+
+std::string FormatResults(const std::vector<Result>& results,
+                          const std::string& format) {
+  std::string out;
+  if (format == "console") {
+    absl::StrAppendFormat(&out, "%-40s %-24s %12s %14s\n", "Game",
+                          "Operation", "Iterations", "ns/op");
+    for (const Result& result : results) {
+      absl::StrAppendFormat(&out, "%-40s %-24s %12d %14.1f\n", result.game,
+                            result.operation, result.iterations,
+                            result.ns_per_op);
+    }
+  } else if (format == "csv") {
+    out = "name,game,operation,iterations,ns_per_op\n";
+    for (const Result& result : results) {
+      absl::StrAppendFormat(&out, "\"%s/%s\",\"%s\",%s,%d,%.1f\n",
+                            result.game, result.operation, result.game,
+                            result.operation, result.iterations,
+                            result.ns_per_op);
+    }
+  } else if (format == "json") {
+    json::Array benchmarks;
+    for (const Result& result : results) {
+      benchmarks.push_back(json::Object({
+          {"name", absl::StrCat(result.game, "/", result.operation)},
+          {"game", result.game},
+          {"operation", result.operation},
+          {"iterations", result.iterations},
+          {"real_time", result.ns_per_op},
+          {"time_unit", "ns"},
+      }));
+    }
+    json::Object context = {
+        {"date", absl::FormatTime(absl::Now())},
+        {"num_states", absl::GetFlag(FLAGS_num_states)},
+        {"min_time", absl::GetFlag(FLAGS_min_time)},
+        {"seed", absl::GetFlag(FLAGS_seed)},
+    };
+    out = json::ToString(
+              json::Object({{"context", context}, {"benchmarks", benchmarks}}),
+              /*wrap=*/true) +
+          "\n";
+  } else {
+    SpielFatalError(absl::StrCat("Unknown format: ", format));
+  }
+  return out;
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  const std::string format = absl::GetFlag(FLAGS_format);
+  // Fail early rather than after running the benchmarks.
+  open_spiel::FormatResults({}, format);
+
+  open_spiel::SetErrorHandler(open_spiel::ThrowingErrorHandler);
+  std::vector<open_spiel::Result> results;
+  for (const std::string& game :
+       open_spiel::GamesToBenchmark(absl::GetFlag(FLAGS_games))) {
+    try {
+      std::vector<open_spiel::Result> game_results =
+          open_spiel::BenchmarkGame(game, absl::GetFlag(FLAGS_num_states),
+                                    absl::GetFlag(FLAGS_max_game_length),
+                                    absl::GetFlag(FLAGS_min_time),
+                                    absl::GetFlag(FLAGS_seed));
+      results.insert(results.end(), game_results.begin(), game_results.end());
+    } catch (const open_spiel::BenchmarkError& e) {
+      std::cerr << game << " skipped: " << e.what() << std::endl;
+    }
+  }
+
+  const std::string out = open_spiel::FormatResults(results, format);
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (output.empty()) {
+    std::cout << out;
+  } else {
+    open_spiel::file::File(output, "w").Write(out);
+  }
+}
@@ -0,0 +1,63 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Builds an opening book for MCTSBot or AlphaBetaSearcher from self-play
+// logs, one game per line given as the numbers of its actions, e.g.:
+//
+//   build_opening_book --game=connect_four --logs=games1.txt,games2.txt
+//     --output=connect_four.book --max_plies=8 --min_weight=10 --threads=8
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/opening_book.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+ABSL_FLAG(std::string, game, "connect_four", "The game of the logs.");
+ABSL_FLAG(std::string, logs, "", "Comma-separated self-play log files.");
+ABSL_FLAG(std::string, output, "", "Where to write the book.");
+ABSL_FLAG(int, max_plies, 10, "How many plies of each game to add.");
+ABSL_FLAG(double, min_weight, 1,
+          "Only keep the moves played in at least this many games.");
+ABSL_FLAG(int, threads, 1, "How many threads to read the logs with.");
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (output.empty()) open_spiel::SpielFatalError("--output is required.");
+  const std::vector<std::string> logs =
+      absl::StrSplit(absl::GetFlag(FLAGS_logs), ',', absl::SkipEmpty());
+
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame(absl::GetFlag(FLAGS_game));
+  const absl::Time start = absl::Now();
+  open_spiel::algorithms::OpeningBookBuilder builder =
+      open_spiel::algorithms::BuildOpeningBook(
+          *game, logs, absl::GetFlag(FLAGS_max_plies),
+          absl::GetFlag(FLAGS_threads));
+  builder.Save(output, absl::GetFlag(FLAGS_min_weight));
+  const open_spiel::algorithms::OpeningBook book(output);
+  std::cout << "Wrote " << book.Size() << " of " << builder.Size()
+            << " moves to " << output << " in "
+            << absl::ToDoubleSeconds(absl::Now() - start) << " s."
+            << std::endl;
+}
@@ -0,0 +1,186 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Counts the leaves of the move tree of chess positions to a given depth
+// ("perft"), to check and time ChessBoard::GenerateLegalMoves and
+// ChessBoard::ApplyMove in isolation from the rest of the game.
+//
+// Without --fen, runs the standard positions of
+// https://www.chessprogramming.org/Perft_Results and checks their counts at
+// each depth up to --depth. With --fen, counts the moves of that position
+// only, and --divide prints the count under each of its moves, e.g. to
+// compare with another engine.
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/games/chess/chess_board.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+ABSL_FLAG(std::string, fen, "",
+          "The position to count, or empty for the standard positions.");
+ABSL_FLAG(int, depth, 4, "The depth to count to.");
+ABSL_FLAG(int, threads, 1, "How many threads to split the root moves over.");
+ABSL_FLAG(bool, divide, false, "Print the count under each root move.");
+
+namespace open_spiel {
+namespace chess {
+namespace {
+
+struct PerftPosition {
+  std::string name;
+  std::string fen;
+  // The counts at depths 1, 2, ...
+  std::vector<uint64_t> counts;
+};
+
+const std::vector<PerftPosition>& StandardPositions() {
+  static const auto* positions = new std::vector<PerftPosition>{
+      {"start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+       {20, 400, 8902, 197281, 4865609}},
+      {"kiwipete",
+       "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+       {48, 2039, 97862, 4085603}},
+      {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+       {14, 191, 2812, 43238, 674624}},
+      {"position 4",
+       "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+       {6, 264, 9467, 422333}},
+      {"position 5",
+       "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+       {44, 1486, 62379, 2103487}},
+  };
+  return *positions;
+}
+
+// The leaves at `depth` below `board`. At depth 1 the legal moves are counted
+// without being applied, as usual for perft.
+uint64_t Perft(const StandardChessBoard& board, int depth) {
+  uint64_t num_leaves = 0;
+  board.GenerateLegalMoves([&board, &num_leaves, depth](const Move& move) {
+    if (depth == 1) {
+      ++num_leaves;
+    } else {
+      StandardChessBoard child = board;
+      child.ApplyMove(move);
+      num_leaves += Perft(child, depth - 1);
+    }
+    return true;
+  });
+  return num_leaves;
+}
+
+// Returns the leaves under each root move, which are split between the
+// threads.
+std::vector<uint64_t> DividedPerft(const StandardChessBoard& board,
+                                   const std::vector<Move>& moves, int depth,
+                                   int num_threads) {
+  std::vector<uint64_t> num_leaves(moves.size(), 0);
+  std::atomic<int> next_move(0);
+  const auto work = [&]() {
+    for (int i = next_move++; i < moves.size(); i = next_move++) {
+      if (depth == 1) {
+        num_leaves[i] = 1;
+      } else {
+        StandardChessBoard child = board;
+        child.ApplyMove(moves[i]);
+        num_leaves[i] = Perft(child, depth - 1);
+      }
+    }
+  };
+  std::vector<Thread> threads;
+  for (int i = 1; i < num_threads; ++i) threads.emplace_back(work);
+  work();
+  for (Thread& thread : threads) thread.join();
+  return num_leaves;
+}
+
+// Counts the leaves of `board` at `depth`, printing the count and speed, and
+// returns the count.
+uint64_t RunPerft(const StandardChessBoard& board, int depth, int num_threads,
+                  bool divide) {
+  std::vector<Move> moves;
+  board.GenerateLegalMoves([&moves](const Move& move) {
+    moves.push_back(move);
+    return true;
+  });
+
+  absl::Time start = absl::Now();
+  std::vector<uint64_t> divided =
+      DividedPerft(board, moves, depth, num_threads);
+  double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+
+  uint64_t num_leaves = 0;
+  for (int i = 0; i < moves.size(); ++i) {
+    num_leaves += divided[i];
+    if (divide) {
+      std::cout << absl::StrFormat("  %s: %d", moves[i].ToLAN(), divided[i])
+                << std::endl;
+    }
+  }
+  std::cout << absl::StrFormat(
+                   "  depth %d: %d nodes in %.1f ms, %.0f nodes/s", depth,
+                   num_leaves, seconds * 1000, num_leaves / seconds)
+            << std::endl;
+  return num_leaves;
+}
+
+StandardChessBoard BoardFromFENOrDie(const std::string& fen) {
+  std::optional<StandardChessBoard> board =
+      StandardChessBoard::BoardFromFEN(fen);
+  if (!board) SpielFatalError(absl::StrCat("Invalid FEN: ", fen));
+  return *board;
+}
+
+}  // namespace
+}  // namespace chess
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  using open_spiel::chess::RunPerft;
+  absl::ParseCommandLine(argc, argv);
+  const int depth = absl::GetFlag(FLAGS_depth);
+  const int num_threads = absl::GetFlag(FLAGS_threads);
+  SPIEL_CHECK_GE(depth, 1);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  const std::string fen = absl::GetFlag(FLAGS_fen);
+  if (!fen.empty()) {
+    std::cout << fen << std::endl;
+    RunPerft(open_spiel::chess::BoardFromFENOrDie(fen), depth, num_threads,
+             absl::GetFlag(FLAGS_divide));
+    return 0;
+  }
+
+  for (const auto& position : open_spiel::chess::StandardPositions()) {
+    std::cout << position.name << ": " << position.fen << std::endl;
+    const auto board = open_spiel::chess::BoardFromFENOrDie(position.fen);
+    for (int d = 1; d <= depth && d <= position.counts.size(); ++d) {
+      SPIEL_CHECK_EQ(RunPerft(board, d, num_threads, /*divide=*/false),
+                     position.counts[d - 1]);
+    }
+  }
+}
@@ -0,0 +1,342 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Walks the whole tree of a game to count its histories and information
+// states, to gauge which solvers are practical before running them. Unlike
+// GetAllStates or GetAllInfoSets it keeps no states: the tree is searched
+// depth first on several threads, and information states are deduplicated by
+// the 64-bit hashes of their strings, so memory grows with the number of
+// information states only, at 8 bytes each (plus hash set slack).
+//
+// Reports the histories at each depth by kind and their branching, the
+// information states and the actions in them for each player, and an
+// estimate of the memory of a tabular CFR solver's table.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_set.h"
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/hash/hash.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+ABSL_FLAG(std::string, game, "kuhn_poker", "The game to count.");
+ABSL_FLAG(int, threads, 1, "How many threads to search the tree with.");
+ABSL_FLAG(int, max_depth, -1,
+          "Only count histories up to this depth, or -1 for all.");
+ABSL_FLAG(bool, per_depth, true, "Print the counts at each depth.");
+
+namespace open_spiel {
+namespace {
+
+// Subtrees handed out to each thread: more balance the load better, at the
+// cost of holding their roots in memory.
+constexpr int kSubtreesPerThread = 64;
+
+// Bytes of a CFR table entry beyond its key and value: the hash table node's
+// next pointer and cached hash, the bucket pointer, and the allocator headers
+// of the node, the key and the four vectors.
+constexpr int kEntryOverhead = 3 * sizeof(void*) + 6 * 16;
+// Strings up to this length are stored inline (libstdc++).
+constexpr int kInlineStringLength = 15;
+
+struct DepthStats {
+  int64_t histories = 0;
+  int64_t terminal = 0;
+  int64_t chance = 0;
+  int64_t decision = 0;
+  int64_t simultaneous = 0;
+  // The children of the non-terminal histories, to average the branching.
+  int64_t children = 0;
+  int64_t max_children = 0;
+
+  void Add(const DepthStats& other) {
+    histories += other.histories;
+    terminal += other.terminal;
+    chance += other.chance;
+    decision += other.decision;
+    simultaneous += other.simultaneous;
+    children += other.children;
+    max_children = std::max(max_children, other.max_children);
+  }
+};
+
+// The information states of one player, as a set of string hashes split in
+// shards with their own lock.
+class InfoStateCensus {
+ public:
+  // Records the information state with string `info_state` and
+  // `num_actions` legal actions, if new.
+  void Add(const std::string& info_state, int num_actions) {
+    const uint64_t hash = absl::Hash<std::string>()(info_state);
+    Shard& shard = shards_[hash % kNumShards];
+    absl::MutexLock lock(&shard.mu);
+    if (!shard.hashes.insert(hash).second) return;
+    ++shard.info_states;
+    shard.actions += num_actions;
+    shard.max_actions = std::max<int64_t>(shard.max_actions, num_actions);
+    if (info_state.size() > kInlineStringLength) {
+      shard.string_bytes += info_state.size() + 1;
+    }
+  }
+
+  int64_t InfoStates() const { return Sum(&Shard::info_states); }
+  int64_t Actions() const { return Sum(&Shard::actions); }
+  int64_t StringBytes() const { return Sum(&Shard::string_bytes); }
+  int64_t MaxActions() const {
+    int64_t max_actions = 0;
+    for (const Shard& shard : shards_) {
+      max_actions = std::max(max_actions, shard.max_actions);
+    }
+    return max_actions;
+  }
+
+  // Approximately the bytes a CFRInfoStateValuesTable would take to hold
+  // these information states.
+  int64_t CFRTableBytes() const {
+    return InfoStates() * (sizeof(std::string) +
+                           sizeof(algorithms::CFRInfoStateValues) +
+                           kEntryOverhead) +
+           StringBytes() +
+           Actions() * (sizeof(Action) + 3 * sizeof(double));
+  }
+
+ private:
+  static constexpr int kNumShards = 64;
+
+  struct Shard {
+    absl::Mutex mu;
+    absl::flat_hash_set<uint64_t> hashes;
+    int64_t info_states = 0;
+    int64_t actions = 0;
+    int64_t max_actions = 0;
+    int64_t string_bytes = 0;
+  };
+
+  int64_t Sum(int64_t Shard::*field) const {
+    int64_t total = 0;
+    for (const Shard& shard : shards_) total += shard.*field;
+    return total;
+  }
+
+  Shard shards_[kNumShards];
+};
+
+class TreeCounter {
+ public:
+  TreeCounter(const Game& game, int max_depth)
+      : max_depth_(max_depth),
+        count_info_states_(game.GetType().provides_information_state_string),
+        census_(game.NumPlayers()) {}
+
+  // Counts `state`, at `depth`, in `stats`, and returns its children, unless
+  // it is terminal or at the maximum depth.
+  std::vector<std::unique_ptr<State>> Visit(const State& state, int depth,
+                                            std::vector<DepthStats>* stats) {
+    if (stats->size() <= depth) stats->resize(depth + 1);
+    DepthStats& at_depth = (*stats)[depth];
+    ++at_depth.histories;
+    std::vector<std::unique_ptr<State>> children;
+    if (state.IsTerminal()) {
+      ++at_depth.terminal;
+      return children;
+    }
+
+    std::vector<Action> actions;
+    if (state.IsChanceNode()) {
+      ++at_depth.chance;
+      for (const auto& [action, prob] : state.ChanceOutcomes()) {
+        if (prob > 0) actions.push_back(action);
+      }
+    } else {
+      if (state.IsSimultaneousNode()) {
+        ++at_depth.simultaneous;
+        for (Player p = 0; p < census_.size(); ++p) {
+          const int num_actions = state.LegalActions(p).size();
+          if (num_actions > 0) CountInfoState(state, p, num_actions);
+        }
+        // The joint actions.
+        actions = state.LegalActions();
+      } else {
+        ++at_depth.decision;
+        actions = state.LegalActions();
+        CountInfoState(state, state.CurrentPlayer(), actions.size());
+      }
+    }
+    at_depth.children += actions.size();
+    at_depth.max_children =
+        std::max<int64_t>(at_depth.max_children, actions.size());
+
+    if (max_depth_ >= 0 && depth >= max_depth_) return children;
+    children.reserve(actions.size());
+    for (Action action : actions) children.push_back(state.Child(action));
+    return children;
+  }
+
+  // Counts the subtree of `state`, at `depth`, depth first.
+  void CountSubtree(const State& state, int depth,
+                    std::vector<DepthStats>* stats) {
+    for (const std::unique_ptr<State>& child : Visit(state, depth, stats)) {
+      CountSubtree(*child, depth + 1, stats);
+    }
+  }
+
+  const std::vector<InfoStateCensus>& Census() const { return census_; }
+  bool CountsInfoStates() const { return count_info_states_; }
+
+ private:
+  void CountInfoState(const State& state, Player player, int num_actions) {
+    if (count_info_states_) {
+      census_[player].Add(state.InformationStateString(player), num_actions);
+    }
+  }
+
+  const int max_depth_;
+  const bool count_info_states_;
+  std::vector<InfoStateCensus> census_;
+};
+
+// Counts the tree of `game` on `num_threads` threads. The top of the tree is
+// expanded breadth first until it has enough subtrees to share between the
+// threads, which then take subtrees until there are none left.
+std::vector<DepthStats> CountTree(const Game& game, TreeCounter* counter,
+                                  int num_threads) {
+  std::vector<DepthStats> stats;
+  std::deque<std::pair<std::unique_ptr<State>, int>> frontier;
+  frontier.emplace_back(game.NewInitialState(), 0);
+  const int num_subtrees =
+      num_threads == 1 ? 1 : num_threads * kSubtreesPerThread;
+  while (!frontier.empty() && frontier.size() < num_subtrees) {
+    auto [state, depth] = std::move(frontier.front());
+    frontier.pop_front();
+    for (std::unique_ptr<State>& child :
+         counter->Visit(*state, depth, &stats)) {
+      frontier.emplace_back(std::move(child), depth + 1);
+    }
+  }
+
+  std::vector<std::vector<DepthStats>> thread_stats(num_threads);
+  std::atomic<int> next_subtree(0);
+  const auto work = [&](int t) {
+    for (int i = next_subtree++; i < frontier.size(); i = next_subtree++) {
+      counter->CountSubtree(*frontier[i].first, frontier[i].second,
+                            &thread_stats[t]);
+      frontier[i].first.reset();
+    }
+  };
+  std::vector<Thread> threads;
+  for (int t = 1; t < num_threads; ++t) {
+    threads.emplace_back([&work, t]() { work(t); });
+  }
+  work(0);
+  for (Thread& thread : threads) thread.join();
+
+  for (const std::vector<DepthStats>& partial : thread_stats) {
+    if (stats.size() < partial.size()) stats.resize(partial.size());
+    for (int d = 0; d < partial.size(); ++d) stats[d].Add(partial[d]);
+  }
+  return stats;
+}
+
+void PrintStats(const Game& game, const TreeCounter& counter,
+                const std::vector<DepthStats>& stats, bool per_depth,
+                double seconds) {
+  DepthStats total;
+  for (const DepthStats& at_depth : stats) total.Add(at_depth);
+  const int64_t internal = total.histories - total.terminal;
+  std::cout << absl::StrFormat(
+                   "%d histories in %.1f s: %d terminal, %d chance, %d "
+                   "decision, %d simultaneous",
+                   total.histories, seconds, total.terminal, total.chance,
+                   total.decision, total.simultaneous)
+            << std::endl;
+  std::cout << absl::StrFormat(
+                   "Depth %d, branching %.2f on average and %d at most",
+                   stats.size() - 1,
+                   internal > 0 ? static_cast<double>(total.children) / internal
+                                : 0.0,
+                   total.max_children)
+            << std::endl;
+
+  if (counter.CountsInfoStates()) {
+    int64_t table_bytes = 0;
+    for (Player p = 0; p < game.NumPlayers(); ++p) {
+      const InfoStateCensus& census = counter.Census()[p];
+      std::cout << absl::StrFormat(
+                       "Player %d: %d information states, %d actions in "
+                       "them, %d at most",
+                       p, census.InfoStates(), census.Actions(),
+                       census.MaxActions())
+                << std::endl;
+      table_bytes += census.CFRTableBytes();
+    }
+    std::cout << absl::StrFormat("Estimated CFR table memory: %.1f KiB",
+                                 table_bytes / 1024.0)
+              << std::endl;
+  } else {
+    std::cout << "The game has no information state strings to count."
+              << std::endl;
+  }
+
+  if (!per_depth) return;
+  std::cout << absl::StrFormat("%6s %14s %14s %14s %14s %10s", "depth",
+                               "histories", "terminal", "chance", "decision",
+                               "branching")
+            << std::endl;
+  for (int d = 0; d < stats.size(); ++d) {
+    const DepthStats& at_depth = stats[d];
+    const int64_t at_internal = at_depth.histories - at_depth.terminal;
+    std::cout << absl::StrFormat(
+                     "%6d %14d %14d %14d %14d %10.2f", d, at_depth.histories,
+                     at_depth.terminal, at_depth.chance,
+                     at_depth.decision + at_depth.simultaneous,
+                     at_internal > 0
+                         ? static_cast<double>(at_depth.children) / at_internal
+                         : 0.0)
+              << std::endl;
+  }
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  const int num_threads = absl::GetFlag(FLAGS_threads);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  std::shared_ptr<const open_spiel::Game> game =
+      open_spiel::LoadGame(absl::GetFlag(FLAGS_game));
+  std::cout << "Game: " << game->ToString() << std::endl;
+  open_spiel::TreeCounter counter(*game, absl::GetFlag(FLAGS_max_depth));
+  absl::Time start = absl::Now();
+  std::vector<open_spiel::DepthStats> stats =
+      open_spiel::CountTree(*game, &counter, num_threads);
+  open_spiel::PrintStats(*game, counter, stats, absl::GetFlag(FLAGS_per_depth),
+                         absl::ToDoubleSeconds(absl::Now() - start));
+}
@@ -27,6 +27,8 @@
 #include "open_spiel/spiel_utils.h"
 
 ABSL_FLAG(std::string, game, "tic_tac_toe", "The name of the game to play.");
+ABSL_FLAG(bool, ponder, true,
+          "Whether the bot keeps searching while waiting for the opponent.");
 
 std::string Success() { return "=\n\n"; }
 std::string Success(const std::string& s) {
@@ -41,7 +43,13 @@ std::unique_ptr<open_spiel::Bot> MakeBot(
     open_spiel::algorithms::Evaluator* evaluator) {
   return std::make_unique<open_spiel::algorithms::MCTSBot>(
       game, evaluator, /*uct_c=*/2, /*max_simulations=*/1000,
-      /*max_memory_mb=*/0, /*solve=*/true, /*seed=*/0, /*verbose=*/false);
+      /*max_memory_mb=*/0, /*solve=*/true, /*seed=*/0, /*verbose=*/false,
+      open_spiel::algorithms::ChildSelectionPolicy::UCT,
+      /*dirichlet_alpha=*/0, /*dirichlet_epsilon=*/0, /*num_threads=*/1,
+      /*virtual_loss=*/1, /*batch_size=*/1,
+      /*reuse_tree=*/absl::GetFlag(FLAGS_ponder), /*max_seconds=*/0,
+      /*stop_early=*/false, /*use_transpositions=*/false,
+      /*gumbel_num_actions=*/0, /*ponder=*/absl::GetFlag(FLAGS_ponder));
 }
 
 // Implements the Go Text Protocol, GTP, which is a text based protocol for
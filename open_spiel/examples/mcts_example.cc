@@ -26,6 +26,7 @@
 #include "open_spiel/abseil-cpp/absl/time/clock.h"
 #include "open_spiel/abseil-cpp/absl/time/time.h"
 #include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/opening_book.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -36,9 +37,15 @@ ABSL_FLAG(double, uct_c, 2, "UCT exploration constant.");
 ABSL_FLAG(int, rollout_count, 10, "How many rollouts per evaluation.");
 ABSL_FLAG(int, max_simulations, 10000, "How many simulations to run.");
 ABSL_FLAG(int, num_games, 1, "How many games to play.");
+ABSL_FLAG(int, num_threads, 1, "How many threads to search with.");
+ABSL_FLAG(int, gumbel_num_actions, 0,
+          "How many root actions to consider with Gumbel sequential halving, "
+          "or 0 to use UCT at the root.");
 ABSL_FLAG(int, max_memory_mb, 1000,
           "The maximum memory used before cutting the search short.");
 ABSL_FLAG(bool, solve, true, "Whether to use MCTS-Solver.");
+ABSL_FLAG(std::string, opening_book, "",
+          "An opening book for MCTS, see build_opening_book.");
 ABSL_FLAG(uint_fast32_t, seed, 0, "Seed for MCTS.");
 ABSL_FLAG(bool, verbose, false, "Show the MCTS stats of possible moves.");
 ABSL_FLAG(bool, quiet, false, "Show the MCTS stats of possible moves.");
@@ -50,17 +57,26 @@ uint_fast32_t Seed() {
 
 std::unique_ptr<open_spiel::Bot> InitBot(
     std::string type, const open_spiel::Game& game, open_spiel::Player player,
-    open_spiel::algorithms::Evaluator* evaluator) {
+    open_spiel::algorithms::Evaluator* evaluator,
+    const open_spiel::algorithms::OpeningBook* book) {
   if (type == "random") {
     return open_spiel::MakeUniformRandomBot(player, Seed());
   }
 
   if (type == "mcts") {
-    return std::make_unique<open_spiel::algorithms::MCTSBot>(
+    auto bot = std::make_unique<open_spiel::algorithms::MCTSBot>(
         game, evaluator, absl::GetFlag(FLAGS_uct_c),
         absl::GetFlag(FLAGS_max_simulations),
         absl::GetFlag(FLAGS_max_memory_mb), absl::GetFlag(FLAGS_solve), Seed(),
-        absl::GetFlag(FLAGS_verbose));
+        absl::GetFlag(FLAGS_verbose),
+        open_spiel::algorithms::ChildSelectionPolicy::UCT,
+        /*dirichlet_alpha=*/0, /*dirichlet_epsilon=*/0,
+        absl::GetFlag(FLAGS_num_threads), /*virtual_loss=*/1,
+        /*batch_size=*/1, /*reuse_tree=*/false, /*max_seconds=*/0,
+        /*stop_early=*/false, /*use_transpositions=*/false,
+        absl::GetFlag(FLAGS_gumbel_num_actions));
+    bot->SetOpeningBook(book);
+    return bot;
   }
   open_spiel::SpielFatalError("Bad player type. Known types: mcts, random");
 }
@@ -152,9 +168,17 @@ int main(int argc, char** argv) {
   open_spiel::algorithms::RandomRolloutEvaluator evaluator(
       absl::GetFlag(FLAGS_rollout_count), Seed());
 
+  std::unique_ptr<open_spiel::algorithms::OpeningBook> book;
+  if (!absl::GetFlag(FLAGS_opening_book).empty()) {
+    book = std::make_unique<open_spiel::algorithms::OpeningBook>(
+        absl::GetFlag(FLAGS_opening_book));
+  }
+
   std::vector<std::unique_ptr<open_spiel::Bot>> bots;
-  bots.push_back(InitBot(absl::GetFlag(FLAGS_player1), *game, 0, &evaluator));
-  bots.push_back(InitBot(absl::GetFlag(FLAGS_player2), *game, 1, &evaluator));
+  bots.push_back(InitBot(absl::GetFlag(FLAGS_player1), *game, 0, &evaluator,
+                         book.get()));
+  bots.push_back(InitBot(absl::GetFlag(FLAGS_player2), *game, 1, &evaluator,
+                         book.get()));
 
   std::vector<std::string> initial_actions;
   for (int i = 1; i < positional_args.size(); ++i) {
@@ -16,7 +16,11 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_COOP_TO_1P_H_
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/game_transforms/game_wrapper.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -85,24 +89,19 @@ struct PlayerPrivate {
 // This is a single player game.
 inline constexpr Player kPlayerId = 0;
 
-// The state is mostly a wrapper over the imperfect information state.
-class CoopTo1pState : public State {
+// The state is mostly a wrapper over the imperfect information state, which
+// is held by a WrappedStateHolder<InnerState> (see game_wrapper.h).
+template <typename InnerState = State>
+class BasicCoopTo1pState : public State {
  public:
-  CoopTo1pState(std::shared_ptr<const Game> game, int num_privates,
-                std::unique_ptr<State> state)
+  BasicCoopTo1pState(std::shared_ptr<const Game> game, int num_privates,
+                     WrappedStateHolder<InnerState> state)
       : State(game),
         state_(std::move(state)),
         num_privates_(num_privates),
         prev_player_(kInvalidPlayer),
         prev_action_(kInvalidAction) {}
-  CoopTo1pState(const CoopTo1pState& other)
-      : State(other),
-        state_(other.state_->Clone()),
-        num_privates_(other.num_privates_),
-        privates_(other.privates_),
-        actual_private_(other.actual_private_),
-        prev_player_(other.prev_player_),
-        prev_action_(other.prev_action_) {}
+  BasicCoopTo1pState(const BasicCoopTo1pState& other) = default;
   Player CurrentPlayer() const override {
     Player underlying_player = state_->CurrentPlayer();
     return underlying_player < 0 ? underlying_player : kPlayerId;
@@ -126,7 +125,14 @@ class CoopTo1pState : public State {
   std::vector<double> Returns() const override {
     return {state_->Returns().front()};
   }
-  std::unique_ptr<State> Clone() const override;
+  std::unique_ptr<State> Clone() const override {
+    return std::unique_ptr<State>(new BasicCoopTo1pState(*this));
+  }
+  bool CopyFrom(const State& other) override {
+    SPIEL_CHECK_EQ(other.GetGame(), game_);
+    *this = static_cast<const BasicCoopTo1pState&>(other);
+    return true;
+  }
   std::string ActionToString(Player player, Action action_id) const override;
   std::string ToString() const override;
   std::string ObservationString(Player player) const override;
@@ -143,7 +149,9 @@ class CoopTo1pState : public State {
   void DoApplyAction(Action action_id) override;
 
  private:
-  std::unique_ptr<State> state_;
+  BasicCoopTo1pState& operator=(const BasicCoopTo1pState& other) = default;
+
+  WrappedStateHolder<InnerState> state_;
   int num_privates_;
   std::vector<PlayerPrivate> privates_;
   std::vector<Action> actual_private_;
@@ -155,6 +163,8 @@ class CoopTo1pState : public State {
   std::string AssignmentToString(Player player, Action assignment) const;
 };
 
+using CoopTo1pState = BasicCoopTo1pState<State>;
+
 class CoopTo1pGame : public Game {
  public:
   CoopTo1pGame(std::shared_ptr<const Game> game, GameType game_type,
@@ -177,11 +187,195 @@ class CoopTo1pGame : public Game {
   double MaxUtility() const override { return game_->MaxUtility(); }
   double UtilitySum() const override { return game_->UtilitySum(); }
 
- private:
+ protected:
   std::shared_ptr<const Game> game_;
   int NumPrivates() const { return game_->MaxChanceOutcomes(); }
 };
 
+// The game whose states are BasicCoopTo1pState<InnerState>, holding the states
+// of the underlying game by value.
+template <typename InnerState>
+class StaticCoopTo1pGame : public CoopTo1pGame {
+ public:
+  using CoopTo1pGame::CoopTo1pGame;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    return std::unique_ptr<State>(new BasicCoopTo1pState<InnerState>(
+        shared_from_this(), NumPrivates(), game_->NewInitialState()));
+  }
+
+  std::shared_ptr<const Game> Clone() const override {
+    return std::shared_ptr<const Game>(new StaticCoopTo1pGame(*this));
+  }
+};
+
+// The type of the 1-player version of a game.
+GameType CoopTo1pGameType(GameType underlying_game_type);
+
+// Returns the 1-player version of a game whose states are InnerStates, e.g.
+// MakeStaticCoopTo1pGame<tiny_hanabi::TinyHanabiState>(
+//     LoadGame("tiny_hanabi")).
+template <typename InnerState>
+std::shared_ptr<const Game> MakeStaticCoopTo1pGame(
+    std::shared_ptr<const Game> game) {
+  GameType game_type = CoopTo1pGameType(game->GetType());
+  GameParameters params = game->GetParameters();
+  params["name"] = GameParameter(game->GetType().short_name);
+  GameParameters game_parameters = {{"game", GameParameter(params)}};
+  return std::shared_ptr<const Game>(new StaticCoopTo1pGame<InnerState>(
+      std::move(game), std::move(game_type), std::move(game_parameters)));
+}
+
+template <typename InnerState>
+std::string BasicCoopTo1pState<InnerState>::ActionToString(
+    Player player, Action action_id) const {
+  if (player == kChancePlayerId) {
+    return state_->ActionToString(player, action_id);
+  } else {
+    Player pl = state_->CurrentPlayer();
+    return absl::StrCat(privates_[pl].names[privates_[pl].next_unassigned],
+                        "->", state_->ActionToString(pl, action_id));
+  }
+}
+
+template <typename InnerState>
+std::string BasicCoopTo1pState<InnerState>::AssignmentToString(
+    Player player, Action assignment) const {
+  switch (assignment) {
+    case PlayerPrivate::kImpossible:
+      return "impossible";
+    case PlayerPrivate::kUnassigned:
+      return "unassigned";
+    default:
+      return state_->ActionToString(player, assignment);
+  }
+}
+
+// String representation of the current possible hands for every player and the
+// assignment of hands to actions for the current player.
+template <typename InnerState>
+std::string BasicCoopTo1pState<InnerState>::Assignments() const {
+  std::string str = "";
+  Player current_player = state_->CurrentPlayer();
+  for (int player = 0; player < privates_.size(); ++player) {
+    auto possible_assignments = state_->LegalActions(player);
+    possible_assignments.push_back(PlayerPrivate::kUnassigned);
+    for (auto asignment : possible_assignments) {
+      absl::StrAppend(&str, "Player ", player);
+      if (player == current_player) {
+        absl::StrAppend(&str, " ", AssignmentToString(player, asignment), ":");
+      } else {
+        absl::StrAppend(&str, " possible:");
+      }
+      bool found = false;
+      for (int pvt = 0; pvt < privates_[player].assignments.size(); ++pvt) {
+        if (privates_[player].assignments[pvt] == asignment) {
+          absl::StrAppend(&str, " ", privates_[player].names[pvt]);
+          found = true;
+        }
+      }
+      if (!found) absl::StrAppend(&str, " none");
+      absl::StrAppend(&str, "\n");
+    }
+  }
+  return str;
+}
+
+// For debug purposes only. This reveals the state of the underlying game, which
+// should be hidden from the player in the 1p game.
+template <typename InnerState>
+std::string BasicCoopTo1pState<InnerState>::ToString() const {
+  return absl::StrCat(state_->ToString(), "\n", Assignments());
+}
+
+// The relevant public Markov state of the underlying game (i.e. the last action
+// if any).
+template <typename InnerState>
+std::string BasicCoopTo1pState<InnerState>::PublicStateString() const {
+  if (prev_action_ == kInvalidAction) {
+    return "New Game";
+  } else {
+    return state_->ActionToString(prev_player_, prev_action_);
+  }
+}
+
+// Represents a decision point; contains the last action (if any) in the
+// underlying game and the current valid hands and their assignments.
+template <typename InnerState>
+std::string BasicCoopTo1pState<InnerState>::ObservationString(
+    Player player) const {
+  return absl::StrCat("Player ", player, "\n", PublicStateString(), "\n",
+                      Assignments());
+}
+
+template <typename InnerState>
+void BasicCoopTo1pState<InnerState>::ObservationTensor(
+    Player unused_player, std::vector<double>* values) const {
+  const int num_actions = state_->NumDistinctActions();
+  const int num_players = state_->NumPlayers();
+  values->resize(num_privates_ * (num_players + num_actions + 1) + num_actions);
+  std::fill(values->begin(), values->end(), 0);
+  if (IsChanceNode()) return;
+
+  // Last action in the underlying game
+  int base = 0;
+  if (prev_action_ != kInvalidAction) values->at(prev_action_) = 1;
+  base += num_actions;
+
+  // Possible privates for every player (multi-hot)
+  for (int p = 0; p < num_players; ++p) {
+    const auto& pvt = privates_[p];
+    for (int i = 0; i < num_privates_; ++i) {
+      values->at(base + i) = (pvt.assignments[i] != PlayerPrivate::kImpossible);
+    }
+    base += num_privates_;
+  }
+
+  // For terminal states, we don't need anything else.
+  if (state_->IsTerminal()) return;
+
+  // Currently-assigned privates for every action (multi-hot)
+  Player current_player = state_->CurrentPlayer();
+  const auto& pvt = privates_[current_player];
+  for (Action a = 0; a < num_actions; ++a) {
+    for (int i = 0; i < num_privates_; ++i) {
+      values->at(base + i) = (pvt.assignments[i] == a);
+    }
+    base += num_privates_;
+  }
+
+  // The private we are currently considering (one-hot)
+  if (!pvt.AssignmentsComplete()) values->at(base + pvt.next_unassigned) = 1;
+  base += num_privates_;
+}
+
+template <typename InnerState>
+void BasicCoopTo1pState<InnerState>::DoApplyAction(Action action_id) {
+  if (IsChanceNode()) {
+    // Assume this is the dealing of a private state. Capture info on possible
+    // privates here.
+    privates_.push_back(PlayerPrivate(num_privates_));
+    actual_private_.push_back(action_id);
+    for (int i = 0; i < num_privates_; ++i) {
+      privates_.back().names[i] = state_->ActionToString(kChancePlayerId, i);
+    }
+    state_->ApplyAction(action_id);
+  } else {
+    // Update the assignment and maybe act in the underlying game.
+    Player player = state_->CurrentPlayer();
+    privates_[player].Assign(action_id);
+    if (privates_[player].AssignmentsComplete()) {
+      Action underlying_action =
+          privates_[player].assignments[actual_private_[player]];
+      state_->ApplyAction(underlying_action);
+      prev_player_ = player;
+      prev_action_ = underlying_action;
+      privates_[player].Reset(underlying_action);
+    }
+  }
+}
+
+
 }  // namespace coop_to_1p
 }  // namespace open_spiel
 
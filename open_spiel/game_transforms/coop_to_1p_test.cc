@@ -14,7 +14,9 @@
 
 #include "open_spiel/game_transforms/coop_to_1p.h"
 
+#include "open_spiel/games/tiny_hanabi.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -29,8 +31,37 @@ void BasicTests() {
                          100);
 }
 
+// The static wrapper plays exactly as the dynamic one.
+void StaticWrapperTest() {
+  std::shared_ptr<const Game> game = LoadGame("coop_to_1p(game=tiny_hanabi())");
+  std::shared_ptr<const Game> static_game =
+      MakeStaticCoopTo1pGame<tiny_hanabi::TinyHanabiState>(
+          LoadGame("tiny_hanabi"));
+  testing::RandomSimTest(*static_game, 10);
+  std::mt19937 rng;
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    std::unique_ptr<State> static_state = static_game->NewInitialState();
+    while (!state->IsTerminal()) {
+      SPIEL_CHECK_EQ(state->ToString(), static_state->ToString());
+      if (!state->IsChanceNode()) {
+        SPIEL_CHECK_EQ(state->ObservationTensor(),
+                       static_state->ObservationTensor());
+      }
+      const std::vector<Action> actions = state->LegalActions();
+      const Action action = actions[rng() % actions.size()];
+      state->ApplyAction(action);
+      static_state = static_state->Child(action);
+    }
+    SPIEL_CHECK_EQ(state->Returns(), static_state->Returns());
+  }
+}
+
 }  // namespace
 }  // namespace coop_to_1p
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::coop_to_1p::BasicTests(); }
+int main(int argc, char** argv) {
+  open_spiel::coop_to_1p::BasicTests();
+  open_spiel::coop_to_1p::StaticWrapperTest();
+}
@@ -15,19 +15,85 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_GAME_WRAPPER_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_GAME_WRAPPER_H_
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 
 // Wraps a game, forwarding everything to the original implementation.
 // Transforms can inherit from this, overriding only what they need.
+//
+// The wrapped state is held by a WrappedStateHolder<InnerState>. With the
+// default InnerState = State, it is any game's state, on the heap and cloned
+// with the wrapper, and every call goes through its virtual methods. When the
+// concrete type of the wrapped states is known at compile time, e.g.
+// WrappedStateHolder<TicTacToeState>, the state is held by value instead: a
+// clone of the wrapper is a single allocation, and the forwarding calls can
+// be devirtualized and inlined, so the wrapper costs next to nothing over the
+// game itself.
 
 namespace open_spiel {
 
-class WrappedState : public State {
+// Holds a wrapped state of type InnerState by value.
+template <typename InnerState = State>
+class WrappedStateHolder {
+ public:
+  explicit WrappedStateHolder(InnerState state) : state_(std::move(state)) {}
+  // Takes a copy of a state of the wrapped game, which must be an InnerState.
+  WrappedStateHolder(std::unique_ptr<State> state)  // NOLINT
+      : state_(Downcast(*state)) {}
+
+  // The state is accessed through the State interface, which the game's
+  // overloads may hide in InnerState. As the dynamic type of state_ is known,
+  // the compiler can still devirtualize these calls.
+  State* operator->() { return &state_; }
+  const State* operator->() const { return &state_; }
+  InnerState& operator*() { return state_; }
+  const InnerState& operator*() const { return state_; }
+
+ private:
+  static const InnerState& Downcast(const State& state) {
+    const auto* inner_state = dynamic_cast<const InnerState*>(&state);
+    SPIEL_CHECK_TRUE(inner_state != nullptr);
+    return *inner_state;
+  }
+
+  InnerState state_;
+};
+
+// Holds any game's wrapped state on the heap.
+template <>
+class WrappedStateHolder<State> {
+ public:
+  WrappedStateHolder(std::unique_ptr<State> state)  // NOLINT
+      : state_(std::move(state)) {}
+  WrappedStateHolder(const WrappedStateHolder& other)
+      : state_(other.state_->Clone()) {}
+  WrappedStateHolder& operator=(const WrappedStateHolder& other) {
+    // Copies in place if the wrapped game supports it.
+    if (!state_->CopyFrom(*other.state_)) state_ = other.state_->Clone();
+    return *this;
+  }
+
+  State* operator->() { return state_.get(); }
+  const State* operator->() const { return state_.get(); }
+  State& operator*() { return *state_; }
+  const State& operator*() const { return *state_; }
+
+ private:
+  std::unique_ptr<State> state_;
+};
+
+template <typename InnerState = State>
+class BasicWrappedState : public State {
  public:
-  WrappedState(std::shared_ptr<const Game> game, std::unique_ptr<State> state)
+  BasicWrappedState(std::shared_ptr<const Game> game,
+                    WrappedStateHolder<InnerState> state)
       : State(game), state_(std::move(state)) {}
-  WrappedState(const WrappedState& other)
-      : State(other), state_(other.state_->Clone()) {}
+  BasicWrappedState(const BasicWrappedState& other) = default;
 
   Player CurrentPlayer() const override { return state_->CurrentPlayer(); }
 
@@ -65,7 +131,7 @@ class WrappedState : public State {
   }
 
   void ObservationTensor(Player player,
-                                 std::vector<double>* values) const override{
+                         std::vector<double>* values) const override {
     state_->ObservationTensor(player, values);
   }
 
@@ -84,7 +150,12 @@ class WrappedState : public State {
     return state_->LegalChanceOutcomes();
   }
 
+  // The wrapped state, e.g. for debugging and in tests.
+  const InnerState& WrappedGameState() const { return *state_; }
+
  protected:
+  BasicWrappedState& operator=(const BasicWrappedState& other) = default;
+
   void DoApplyAction(Action action_id) override {
     state_->ApplyAction(action_id);
   }
@@ -93,9 +164,11 @@ class WrappedState : public State {
     state_->ApplyActions(actions);
   }
 
-  std::unique_ptr<State> state_;
+  WrappedStateHolder<InnerState> state_;
 };
 
+using WrappedState = BasicWrappedState<State>;
+
 class WrappedGame : public Game {
  public:
   WrappedGame(std::shared_ptr<const Game> game, GameType game_type,
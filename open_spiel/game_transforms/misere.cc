@@ -34,12 +34,6 @@ const GameType kGameType{/*short_name=*/"misere",
                          {{"game", GameParameter(GameParameter::Type::kGame,
                                                  /*is_mandatory=*/true)}}};
 
-GameType MisereGameType(GameType game_type) {
-  game_type.short_name = kGameType.short_name;
-  game_type.long_name = absl::StrCat("Misere ", game_type.long_name);
-  return game_type;
-}
-
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
   auto game = LoadGame(params.at("game").game_value());
   GameType game_type = MisereGameType(game->GetType());
@@ -50,6 +44,18 @@ REGISTER_SPIEL_GAME(kGameType, Factory);
 
 }  // namespace
 
+GameType MisereGameType(GameType game_type) {
+  game_type.short_name = kGameType.short_name;
+  game_type.long_name = absl::StrCat("Misere ", game_type.long_name);
+  return game_type;
+}
+
+GameParameters MisereGameParameters(const Game& game) {
+  GameParameters params = game.GetParameters();
+  params["name"] = GameParameter(game.GetType().short_name);
+  return {{"game", GameParameter(params)}};
+}
+
 MisereGame::MisereGame(std::shared_ptr<const Game> game, GameType game_type,
                        GameParameters game_parameters)
     : WrappedGame(game, game_type, game_parameters) {}
@@ -15,6 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_MISERE_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_MISERE_H_
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "open_spiel/game_transforms/game_wrapper.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -22,35 +26,49 @@
 // Transforms a game into its Misere version by inverting the sign of the
 // rewards / utilities. This is a self-inverse operation.
 // https://en.wikipedia.org/wiki/Mis%C3%A8re
+//
+// When the state type of the underlying game is known where the game is
+// loaded, MakeStaticMisereGame<StateType> wraps it with no per-call overhead
+// (see game_wrapper.h).
 
 namespace open_spiel {
 
-// Flips the sign of a vector.
+// Flips the sign of a vector, keeping zeros +0.0.
 inline std::vector<double> Negative(std::vector<double>&& vector) {
   std::vector<double> neg = std::move(vector);
-  for (auto& item : neg) item = -item;
+  for (auto& item : neg) item = 0.0 - item;
   return neg;
 }
 
-class MisereState : public WrappedState {
+template <typename InnerState = State>
+class BasicMisereState : public BasicWrappedState<InnerState> {
  public:
-  MisereState(std::shared_ptr<const Game> game, std::unique_ptr<State> state)
-      : WrappedState(game, std::move(state)) {}
-  MisereState(const MisereState& other) = default;
+  BasicMisereState(std::shared_ptr<const Game> game,
+                   WrappedStateHolder<InnerState> state)
+      : BasicWrappedState<InnerState>(game, std::move(state)) {}
+  BasicMisereState(const BasicMisereState& other) = default;
 
   std::vector<double> Rewards() const override {
-    return Negative(state_->Rewards());
+    return Negative(this->state_->Rewards());
   }
 
   std::vector<double> Returns() const override {
-    return Negative(state_->Returns());
+    return Negative(this->state_->Returns());
   }
 
   std::unique_ptr<State> Clone() const override {
-    return std::unique_ptr<State>(new MisereState(*this));
+    return std::unique_ptr<State>(new BasicMisereState(*this));
+  }
+
+  bool CopyFrom(const State& other) override {
+    SPIEL_CHECK_EQ(other.GetGame(), this->game_);
+    *this = static_cast<const BasicMisereState&>(other);
+    return true;
   }
 };
 
+using MisereState = BasicMisereState<State>;
+
 class MisereGame : public WrappedGame {
  public:
   MisereGame(std::shared_ptr<const Game> game, GameType game_type,
@@ -68,9 +86,41 @@ class MisereGame : public WrappedGame {
 
   double MinUtility() const override { return -game_->MaxUtility(); }
   double MaxUtility() const override { return -game_->MinUtility(); }
-  double UtilitySum() const override { return -game_->UtilitySum(); }
+  double UtilitySum() const override { return 0.0 - game_->UtilitySum(); }
 };
 
+// The misere game whose states are BasicMisereState<InnerState>, holding the
+// states of the underlying game by value.
+template <typename InnerState>
+class StaticMisereGame : public MisereGame {
+ public:
+  using MisereGame::MisereGame;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    return std::unique_ptr<State>(new BasicMisereState<InnerState>(
+        shared_from_this(), game_->NewInitialState()));
+  }
+
+  std::shared_ptr<const Game> Clone() const override {
+    return std::shared_ptr<const Game>(new StaticMisereGame(*this));
+  }
+};
+
+// The type and parameters of the misere version of a game.
+GameType MisereGameType(GameType game_type);
+GameParameters MisereGameParameters(const Game& game);
+
+// Returns the misere version of a game whose states are InnerStates, e.g.
+// MakeStaticMisereGame<tic_tac_toe::TicTacToeState>(LoadGame("tic_tac_toe")).
+template <typename InnerState>
+std::shared_ptr<const Game> MakeStaticMisereGame(
+    std::shared_ptr<const Game> game) {
+  GameType game_type = MisereGameType(game->GetType());
+  GameParameters game_parameters = MisereGameParameters(*game);
+  return std::shared_ptr<const Game>(new StaticMisereGame<InnerState>(
+      std::move(game), std::move(game_type), std::move(game_parameters)));
+}
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_MISERE_H_
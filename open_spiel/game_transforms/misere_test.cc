@@ -14,7 +14,10 @@
 
 #include "open_spiel/game_transforms/misere.h"
 
+#include "open_spiel/games/leduc_poker.h"
+#include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -29,8 +32,42 @@ void BasicMisereTests() {
   testing::RandomSimTest(*LoadGame("misere(game=leduc_poker())"), 100);
 }
 
+// The static wrappers play exactly as the dynamic ones.
+void StaticMisereTest(std::shared_ptr<const Game> game,
+                      std::shared_ptr<const Game> static_game) {
+  testing::RandomSimTest(*static_game, 10);
+  std::mt19937 rng;
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    std::unique_ptr<State> static_state = static_game->NewInitialState();
+    while (!state->IsTerminal()) {
+      SPIEL_CHECK_EQ(state->ToString(), static_state->ToString());
+      SPIEL_CHECK_EQ(state->LegalActions(), static_state->LegalActions());
+      const std::vector<Action> actions = state->LegalActions();
+      const Action action = actions[rng() % actions.size()];
+      state->ApplyAction(action);
+      static_state = static_state->Child(action);
+      if (!state->IsChanceNode()) {
+        SPIEL_CHECK_EQ(state->Rewards(), static_state->Rewards());
+      }
+    }
+    SPIEL_CHECK_TRUE(static_state->IsTerminal());
+    SPIEL_CHECK_EQ(state->Returns(), static_state->Returns());
+  }
+}
+
 }  // namespace
 }  // namespace misere
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::misere::BasicMisereTests(); }
+int main(int argc, char** argv) {
+  open_spiel::misere::BasicMisereTests();
+  open_spiel::misere::StaticMisereTest(
+      open_spiel::LoadGame("misere(game=tic_tac_toe())"),
+      open_spiel::MakeStaticMisereGame<open_spiel::tic_tac_toe::TicTacToeState>(
+          open_spiel::LoadGame("tic_tac_toe")));
+  open_spiel::misere::StaticMisereTest(
+      open_spiel::LoadGame("misere(game=leduc_poker())"),
+      open_spiel::MakeStaticMisereGame<open_spiel::leduc_poker::LeducState>(
+          open_spiel::LoadGame("leduc_poker")));
+}
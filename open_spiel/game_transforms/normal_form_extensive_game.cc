@@ -14,6 +14,17 @@
 
 #include "open_spiel/game_transforms/normal_form_extensive_game.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
 #include "open_spiel/algorithms/deterministic_policy.h"
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/spiel.h"
@@ -42,15 +53,44 @@ const GameType kGameType{
     /*provides_observation_string=*/true,
     /*provides_observation_tensor=*/true,
     {{"game",
-      GameParameter(GameParameter::Type::kGame, /*is_mandatory=*/true)}}};
+      GameParameter(GameParameter::Type::kGame, /*is_mandatory=*/true)},
+     {"reduced", GameParameter(false)},
+     {"lazy", GameParameter(false)}}};
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
-  return ExtensiveToTensorGame(*LoadGame(params.at("game").game_value()));
+  std::shared_ptr<const Game> game =
+      LoadGame(params.at("game").game_value());
+  const auto bool_param = [&params](const std::string& name) {
+    const auto it = params.find(name);
+    return it != params.end() && it->second.bool_value();
+  };
+  if (bool_param("lazy")) {
+    return ExtensiveToNormalFormGame(*game, bool_param("reduced"));
+  }
+  return ExtensiveToTensorGame(*game, bool_param("reduced"));
 }
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
-std::shared_ptr<const TensorGame> ExtensiveToTensorGame(const Game& game) {
+namespace {
+
+// The numbers of choices saturate there, as the strategies are numbered by
+// actions.
+constexpr int64_t kMaxNumChoices =
+    int64_t{std::numeric_limits<int>::max()} + 1;
+
+GameParameters NormalFormExtensiveGameParameters(const Game& game,
+                                                 bool reduced) {
+  GameParameters params = game.GetParameters();
+  params["name"] = GameParameter(game.GetType().short_name);
+  return {{"game", GameParameter(params)},
+          {"reduced", GameParameter(reduced)},
+          {"lazy", GameParameter(true)}};
+}
+
+// The tensor game of a simultaneous-move game, whose policies are evaluated
+// with ExpectedReturns.
+std::shared_ptr<const TensorGame> SimultaneousToTensorGame(const Game& game) {
   std::vector<std::vector<std::string>> action_names(game.NumPlayers());
 
   GameType type = game.GetType();
@@ -93,4 +133,364 @@ std::shared_ptr<const TensorGame> ExtensiveToTensorGame(const Game& game) {
                                        action_names, utils);
 }
 
+
+}  // namespace
+
+std::shared_ptr<const TensorGame> ExtensiveToTensorGame(const Game& game,
+                                                        bool reduced) {
+  if (game.GetType().dynamics == GameType::Dynamics::kSimultaneous) {
+    SPIEL_CHECK_FALSE(reduced);
+    return SimultaneousToTensorGame(game);
+  }
+  const NormalFormExtensiveGame normal_form_game(game.shared_from_this(),
+                                                 reduced);
+  const std::vector<int>& shape = normal_form_game.Shape();
+  std::vector<std::vector<std::string>> action_names(game.NumPlayers());
+  int size = 1;
+  for (Player player = 0; player < game.NumPlayers(); ++player) {
+    for (Action action = 0; action < shape[player]; ++action) {
+      action_names[player].push_back(
+          normal_form_game.ActionName(player, action));
+    }
+    size *= shape[player];
+  }
+
+  // The joint strategies in row-major order.
+  std::vector<std::vector<double>> utils(game.NumPlayers(),
+                                         std::vector<double>(size));
+  std::vector<Action> actions(game.NumPlayers(), 0);
+  for (int i = 0; i < size; ++i) {
+    const std::vector<double> returns =
+        normal_form_game.ComputeUtilities(actions);
+    for (Player player = 0; player < game.NumPlayers(); ++player) {
+      utils[player][i] = returns[player];
+    }
+    for (Player player = game.NumPlayers() - 1; player >= 0; --player) {
+      if (++actions[player] < shape[player]) break;
+      actions[player] = 0;
+    }
+  }
+
+  return tensor_game::CreateTensorGame(
+      kGameType.short_name, "Normal-form " + game.GetType().long_name,
+      action_names, utils);
+}
+
+NormalFormExtensiveGame::NormalFormExtensiveGame(
+    std::shared_ptr<const Game> game, bool reduced)
+    : NormalFormGame(
+          GameType{
+              /*short_name=*/kGameType.short_name,
+              /*long_name=*/"Normal-form " + game->GetType().long_name,
+              GameType::Dynamics::kSimultaneous,
+              GameType::ChanceMode::kDeterministic,
+              GameType::Information::kOneShot,
+              game->GetType().utility,
+              GameType::RewardModel::kTerminal,
+              /*max_num_players=*/game->NumPlayers(),
+              /*min_num_players=*/game->NumPlayers(),
+              /*provides_information_state_string=*/true,
+              /*provides_information_state_tensor=*/true,
+              /*provides_observation_string=*/false,
+              /*provides_observation_tensor=*/false,
+              kGameType.parameter_specification},
+          NormalFormExtensiveGameParameters(*game, reduced)),
+      game_(std::move(game)),
+      reduced_(reduced) {
+  if (game_->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError(
+        "NormalFormExtensiveGame requires a turn-based game, see "
+        "turn_based_simultaneous_game.");
+  }
+  tree_ = std::make_shared<algorithms::CompactHistoryTree>(
+      *game_->NewInitialState());
+  player_info_states_.resize(game_->NumPlayers());
+  for (Player player = 0; player < game_->NumPlayers(); ++player) {
+    AddPlayerInfoStates(player);
+    const int64_t num_strategies = NumChoices(
+        player_info_states_[player], player_info_states_[player].first);
+    if (num_strategies >= kMaxNumChoices) {
+      SpielFatalError(absl::StrCat("Player ", player,
+                                   " has too many strategies to number."));
+    }
+    shape_.push_back(num_strategies);
+  }
+}
+
+void NormalFormExtensiveGame::AddPlayerInfoStates(Player player) {
+  PlayerInfoStates& player_info_states = player_info_states_[player];
+  std::vector<int>& info_states = player_info_states.info_states;
+  for (int i = 0; i < tree_->NumInfoStates(); ++i) {
+    if (tree_->InfoStatePlayer(i) == player) info_states.push_back(i);
+  }
+  absl::c_sort(info_states, [this](int a, int b) {
+    return tree_->InfoStateString(a) < tree_->InfoStateString(b);
+  });
+  std::vector<int> positions(tree_->NumInfoStates(), -1);
+  for (int j = 0; j < info_states.size(); ++j) {
+    positions[info_states[j]] = j;
+  }
+  const int num_info_states = info_states.size();
+  player_info_states.next.resize(num_info_states);
+  for (int j = 0; j < num_info_states; ++j) {
+    const int num_actions =
+        tree_->GetNode(tree_->InfoStateNodes(info_states[j]).front())
+            .num_children;
+    player_info_states.next[j].resize(num_actions);
+  }
+
+  if (!reduced_) {
+    player_info_states.first.resize(num_info_states);
+    absl::c_iota(player_info_states.first, 0);
+  } else {
+    // The last information state and action of the player before each of
+    // its information states, which must be the same at all of its nodes.
+    constexpr std::pair<int, int> kUnset = {-2, -2};
+    std::vector<std::pair<int, int>> parents(num_info_states, kUnset);
+    std::vector<std::pair<int, std::pair<int, int>>> stack = {
+        {tree_->Root(), {-1, -1}}};
+    while (!stack.empty()) {
+      const auto [index, parent] = stack.back();
+      stack.pop_back();
+      const algorithms::CompactHistoryTree::Node& node =
+          tree_->GetNode(index);
+      std::pair<int, int> child_parent = parent;
+      const bool is_player_node = node.type == StateType::kDecision &&
+                                  node.player == player;
+      const int j = is_player_node ? positions[node.info_state] : -1;
+      if (is_player_node) {
+        if (parents[j] == kUnset) {
+          parents[j] = parent;
+        } else if (parents[j] != parent) {
+          SpielFatalError(absl::StrCat(
+              "The reduced normal form requires perfect recall, but player ",
+              player, " can reach ", tree_->InfoStateString(node.info_state),
+              " after different choices."));
+        }
+      }
+      for (int offset = 0; offset < node.num_children; ++offset) {
+        if (is_player_node) child_parent = {j, offset};
+        stack.push_back({node.first_child + offset, child_parent});
+      }
+    }
+    for (int j = 0; j < num_info_states; ++j) {
+      const auto [parent, offset] = parents[j];
+      if (parent < 0) {
+        player_info_states.first.push_back(j);
+      } else {
+        player_info_states.next[parent][offset].push_back(j);
+      }
+    }
+  }
+
+  // The choices after an action only depend on later information states,
+  // which have been discovered later in the tree.
+  player_info_states.num_choices.resize(num_info_states);
+  player_info_states.num_next_choices.resize(num_info_states);
+  std::vector<int> order(num_info_states);
+  absl::c_iota(order, 0);
+  absl::c_sort(order, [&info_states](int a, int b) {
+    return info_states[a] > info_states[b];
+  });
+  for (int j : order) {
+    int64_t num_choices = 0;
+    for (const std::vector<int>& next : player_info_states.next[j]) {
+      const int64_t num_next_choices = NumChoices(player_info_states, next);
+      player_info_states.num_next_choices[j].push_back(num_next_choices);
+      num_choices += num_next_choices;
+    }
+    player_info_states.num_choices[j] =
+        std::min(num_choices, kMaxNumChoices);
+  }
+}
+
+int64_t NormalFormExtensiveGame::NumChoices(
+    const PlayerInfoStates& player_info_states,
+    const std::vector<int>& info_states) const {
+  int64_t num_choices = 1;
+  for (int j : info_states) {
+    num_choices = std::min(kMaxNumChoices,
+                           num_choices * player_info_states.num_choices[j]);
+  }
+  return num_choices;
+}
+
+void NormalFormExtensiveGame::SetChildOffsets(
+    const PlayerInfoStates& player_info_states,
+    const std::vector<int>& info_states, int64_t choice,
+    std::vector<int>* child_offsets) const {
+  for (int j : info_states) {
+    int64_t info_state_choice = choice % player_info_states.num_choices[j];
+    choice /= player_info_states.num_choices[j];
+    const std::vector<int64_t>& num_next_choices =
+        player_info_states.num_next_choices[j];
+    int offset = 0;
+    while (info_state_choice >= num_next_choices[offset]) {
+      info_state_choice -= num_next_choices[offset];
+      ++offset;
+    }
+    (*child_offsets)[player_info_states.info_states[j]] = offset;
+    SetChildOffsets(player_info_states, player_info_states.next[j][offset],
+                    info_state_choice, child_offsets);
+  }
+}
+
+int NormalFormExtensiveGame::NumDistinctActions() const {
+  return *absl::c_max_element(shape_);
+}
+
+std::unique_ptr<State> NormalFormExtensiveGame::NewInitialState() const {
+  return std::make_unique<NormalFormExtensiveState>(shared_from_this());
+}
+
+std::vector<double> NormalFormExtensiveGame::Utilities(
+    const std::vector<Action>& actions) const {
+  {
+    absl::MutexLock lock(&mutex_);
+    const auto it = utilities_.find(actions);
+    if (it != utilities_.end()) return it->second;
+  }
+  std::vector<double> utilities = ComputeUtilities(actions);
+  absl::MutexLock lock(&mutex_);
+  utilities_.try_emplace(actions, utilities);
+  return utilities;
+}
+
+double NormalFormExtensiveGame::PlayerUtility(
+    Player player, const std::vector<Action>& actions) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, NumPlayers());
+  return Utilities(actions)[player];
+}
+
+int NormalFormExtensiveGame::NumCachedUtilities() const {
+  absl::MutexLock lock(&mutex_);
+  return utilities_.size();
+}
+
+std::string NormalFormExtensiveGame::ActionName(Player player,
+                                                Action action) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, NumPlayers());
+  SPIEL_CHECK_GE(action, 0);
+  SPIEL_CHECK_LT(action, shape_[player]);
+  const PlayerInfoStates& player_info_states = player_info_states_[player];
+  std::vector<int> child_offsets(tree_->NumInfoStates(), -1);
+  SetChildOffsets(player_info_states, player_info_states.first, action,
+                  &child_offsets);
+  std::string name;
+  for (int i : player_info_states.info_states) {
+    if (child_offsets[i] < 0) continue;
+    const algorithms::CompactHistoryTree::Node& node =
+        tree_->GetNode(tree_->InfoStateNodes(i).front());
+    absl::StrAppend(&name, tree_->InfoStateString(i), " ", " --- ", " ",
+                    "action = ",
+                    tree_->GetNode(node.first_child + child_offsets[i]).action,
+                    "\n");
+  }
+  return name;
+}
+
+std::vector<double> NormalFormExtensiveGame::ComputeUtilities(
+    const std::vector<Action>& actions) const {
+  SPIEL_CHECK_EQ(actions.size(), NumPlayers());
+  std::vector<int> child_offsets(tree_->NumInfoStates(), -1);
+  for (Player player = 0; player < NumPlayers(); ++player) {
+    SPIEL_CHECK_GE(actions[player], 0);
+    SPIEL_CHECK_LT(actions[player], shape_[player]);
+    SetChildOffsets(player_info_states_[player],
+                    player_info_states_[player].first, actions[player],
+                    &child_offsets);
+  }
+  return NodeReturns(tree_->Root(), child_offsets);
+}
+
+std::vector<double> NormalFormExtensiveGame::NodeReturns(
+    int index, const std::vector<int>& child_offsets) const {
+  const algorithms::CompactHistoryTree::Node& node = tree_->GetNode(index);
+  switch (node.type) {
+    case StateType::kTerminal: {
+      std::vector<double> returns(NumPlayers());
+      for (Player player = 0; player < NumPlayers(); ++player) {
+        returns[player] = tree_->PlayerReturn(index, player);
+      }
+      return returns;
+    }
+    case StateType::kDecision: {
+      // The strategies choose at every information state that they reach.
+      const int offset = child_offsets[node.info_state];
+      SPIEL_CHECK_GE(offset, 0);
+      return NodeReturns(node.first_child + offset, child_offsets);
+    }
+    default: {
+      SPIEL_CHECK_EQ(node.type, StateType::kChance);
+      std::vector<double> returns(NumPlayers(), 0);
+      for (int child = node.first_child;
+           child < node.first_child + node.num_children; ++child) {
+        const double probability = tree_->GetNode(child).probability;
+        const std::vector<double> child_returns =
+            NodeReturns(child, child_offsets);
+        for (Player player = 0; player < NumPlayers(); ++player) {
+          returns[player] += probability * child_returns[player];
+        }
+      }
+      return returns;
+    }
+  }
+}
+
+NormalFormExtensiveState::NormalFormExtensiveState(
+    std::shared_ptr<const Game> game)
+    : NFGState(game),
+      normal_form_game_(
+          static_cast<const NormalFormExtensiveGame*>(game.get())) {}
+
+std::vector<Action> NormalFormExtensiveState::LegalActions(
+    Player player) const {
+  if (IsTerminal()) return {};
+  if (player == kSimultaneousPlayerId) return LegalFlatJointActions();
+  std::vector<Action> moves(normal_form_game_->Shape()[player]);
+  absl::c_iota(moves, 0);
+  return moves;
+}
+
+std::string NormalFormExtensiveState::ActionToString(Player player,
+                                                     Action action_id) const {
+  if (player == kSimultaneousPlayerId) {
+    return FlatJointActionToString(action_id);
+  }
+  return normal_form_game_->ActionName(player, action_id);
+}
+
+std::string NormalFormExtensiveState::ToString() const {
+  std::string result = "";
+  absl::StrAppend(&result, "Terminal? ", IsTerminal() ? "true" : "false", "\n");
+  if (IsTerminal()) {
+    absl::StrAppend(&result, "History: ", HistoryString(), "\n");
+    absl::StrAppend(&result, "Returns: ", absl::StrJoin(Returns(), ","), "\n");
+  }
+  return result;
+}
+
+std::vector<double> NormalFormExtensiveState::Returns() const {
+  if (!IsTerminal()) return std::vector<double>(NumPlayers(), 0);
+  return normal_form_game_->Utilities(joint_move_);
+}
+
+void NormalFormExtensiveState::DoApplyActions(
+    const std::vector<Action>& moves) {
+  SPIEL_CHECK_EQ(moves.size(), NumPlayers());
+  for (Player player = 0; player < NumPlayers(); player++) {
+    SPIEL_CHECK_GE(moves[player], 0);
+    SPIEL_CHECK_LT(moves[player], normal_form_game_->Shape()[player]);
+  }
+  joint_move_ = moves;
+}
+
+std::shared_ptr<const NormalFormExtensiveGame> ExtensiveToNormalFormGame(
+    const Game& game, bool reduced) {
+  return std::make_shared<NormalFormExtensiveGame>(game.shared_from_this(),
+                                                   reduced);
+}
+
 }  // namespace open_spiel
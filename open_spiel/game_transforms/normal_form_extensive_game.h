@@ -15,6 +15,14 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_NORMAL_FORM_EXTENSIVE_GAME_H
 #define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_NORMAL_FORM_EXTENSIVE_GAME_H
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/algorithms/history_tree.h"
+#include "open_spiel/normal_form_game.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tensor_game.h"
 
@@ -35,9 +43,120 @@ namespace open_spiel {
 //
 // Hence, this method should only be used for  small games! For example, Kuhn
 // poker has 64 deterministic policies, resulting in a 64-by-64 matrix.
-
+//
+// If `reduced`, the game has instead a strategy for each reduced pure
+// strategy of the extensive-form game, which only chooses actions at the
+// information states that its earlier choices do not make unreachable (Kuhn
+// poker has 27 and 64). This requires perfect recall.
 std::shared_ptr<const tensor_game::TensorGame> ExtensiveToTensorGame(
-    const Game& game);
+    const Game& game, bool reduced = false);
+
+// The normal form of a turn-based extensive-form game, as in
+// ExtensiveToTensorGame, but which only enumerates the strategies of each
+// player implicitly and computes the utilities of a joint strategy when they
+// are first asked for, so that games with too many joint strategies for a
+// tensor game can still be queried. The game tree is built once, and the
+// utilities of a joint strategy are those of the branches that it follows.
+class NormalFormExtensiveGame : public NormalFormGame {
+ public:
+  NormalFormExtensiveGame(std::shared_ptr<const Game> game, bool reduced);
+
+  int NumDistinctActions() const override;
+  std::unique_ptr<State> NewInitialState() const override;
+  int NumPlayers() const override { return shape_.size(); }
+  // The bounds of the utilities of the extensive-form game.
+  double MinUtility() const override { return game_->MinUtility(); }
+  double MaxUtility() const override { return game_->MaxUtility(); }
+  std::shared_ptr<const Game> Clone() const override {
+    return std::make_shared<NormalFormExtensiveGame>(game_, reduced_);
+  }
+
+  // The number of strategies of each player.
+  const std::vector<int>& Shape() const { return shape_; }
+  // The utilities of all the players for a joint strategy, cached.
+  std::vector<double> Utilities(const std::vector<Action>& actions) const;
+  double PlayerUtility(Player player,
+                       const std::vector<Action>& actions) const;
+  // The information states of the player with the action that the strategy
+  // chooses there, as DeterministicTabularPolicy::ToString(" --- ").
+  std::string ActionName(Player player, Action action) const;
+  int NumCachedUtilities() const;
+
+ private:
+  friend std::shared_ptr<const tensor_game::TensorGame> ExtensiveToTensorGame(
+      const Game& game, bool reduced);
+
+  // The information states of a player in the tree are numbered by their
+  // strings, and each strategy is a mixed-radix number of choices at the
+  // information states that can be reached first, the choices of an
+  // information state in turn being numbered by action then by the choices
+  // at the information states that can be reached first after that action.
+  // In the full normal form, all the information states can be reached
+  // first, which gives the order of DeterministicTabularPolicy::NextPolicy.
+  struct PlayerInfoStates {
+    // The tree index of each information state.
+    std::vector<int> info_states;
+    // The information states that can be reached first.
+    std::vector<int> first;
+    // For each information state and action, the information states that can
+    // be reached first after it.
+    std::vector<std::vector<std::vector<int>>> next;
+    // The number of choices at each information state, and after each of its
+    // actions.
+    std::vector<int64_t> num_choices;
+    std::vector<std::vector<int64_t>> num_next_choices;
+  };
+
+  void AddPlayerInfoStates(Player player);
+  int64_t NumChoices(const PlayerInfoStates& player_info_states,
+                     const std::vector<int>& info_states) const;
+  // Sets the child offsets in the tree that the choices at the information
+  // states make.
+  void SetChildOffsets(const PlayerInfoStates& player_info_states,
+                       const std::vector<int>& info_states, int64_t choice,
+                       std::vector<int>* child_offsets) const;
+  std::vector<double> ComputeUtilities(
+      const std::vector<Action>& actions) const;
+  std::vector<double> NodeReturns(int index,
+                                  const std::vector<int>& child_offsets) const;
+
+  const std::shared_ptr<const Game> game_;
+  const bool reduced_;
+  std::shared_ptr<const algorithms::CompactHistoryTree> tree_;
+  std::vector<PlayerInfoStates> player_info_states_;
+  std::vector<int> shape_;
+
+  mutable absl::Mutex mutex_;
+  mutable absl::flat_hash_map<std::vector<Action>, std::vector<double>>
+      utilities_ ABSL_GUARDED_BY(mutex_);
+};
+
+class NormalFormExtensiveState : public NFGState {
+ public:
+  explicit NormalFormExtensiveState(std::shared_ptr<const Game> game);
+  NormalFormExtensiveState(const NormalFormExtensiveState&) = default;
+
+  std::vector<Action> LegalActions(Player player) const override;
+  std::string ActionToString(Player player, Action action_id) const override;
+  std::string ToString() const override;
+  bool IsTerminal() const override { return !joint_move_.empty(); }
+  std::vector<double> Returns() const override;
+  std::unique_ptr<State> Clone() const override {
+    return std::unique_ptr<State>(new NormalFormExtensiveState(*this));
+  }
+
+ protected:
+  void DoApplyActions(const std::vector<Action>& moves) override;
+
+ private:
+  std::vector<Action> joint_move_;
+  const NormalFormExtensiveGame* normal_form_game_;
+};
+
+// Returns the normal form of a turn-based game, with its utilities computed
+// on demand. See NormalFormExtensiveGame.
+std::shared_ptr<const NormalFormExtensiveGame> ExtensiveToNormalFormGame(
+    const Game& game, bool reduced = false);
 
 }  // namespace open_spiel
 
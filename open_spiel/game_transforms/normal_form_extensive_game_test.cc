@@ -14,6 +14,13 @@
 
 #include "open_spiel/game_transforms/normal_form_extensive_game.h"
 
+#include <memory>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+
 namespace open_spiel {
 namespace {
 
@@ -28,9 +35,87 @@ void ExtensiveToTensorGameTest() {
   SPIEL_CHECK_EQ(auction_tensor_game->Shape()[2], 24);
 }
 
+void LazyNormalFormGameTest() {
+  // The utilities computed on demand are those of the tensor game.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::shared_ptr<const tensor_game::TensorGame> tensor_game =
+      ExtensiveToTensorGame(*game);
+  std::shared_ptr<const NormalFormExtensiveGame> normal_form_game =
+      ExtensiveToNormalFormGame(*game);
+  SPIEL_CHECK_EQ(normal_form_game->Shape(), tensor_game->Shape());
+  SPIEL_CHECK_EQ(normal_form_game->NumCachedUtilities(), 0);
+  for (Player player = 0; player < 2; ++player) {
+    for (Action action = 0; action < tensor_game->Shape()[player]; ++action) {
+      SPIEL_CHECK_EQ(normal_form_game->ActionName(player, action),
+                     tensor_game->ActionName(player, action));
+    }
+  }
+  for (Action row = 0; row < tensor_game->Shape()[0]; row += 7) {
+    for (Action col = 0; col < tensor_game->Shape()[1]; col += 5) {
+      for (Player player = 0; player < 2; ++player) {
+        SPIEL_CHECK_FLOAT_NEAR(
+            normal_form_game->PlayerUtility(player, {row, col}),
+            tensor_game->PlayerUtility(player, {row, col}), 1e-12);
+      }
+    }
+  }
+  SPIEL_CHECK_EQ(normal_form_game->NumCachedUtilities(), 10 * 13);
+
+  // Three-player Kuhn poker has too many joint strategies for a tensor game.
+  normal_form_game =
+      ExtensiveToNormalFormGame(*LoadGame("kuhn_poker(players=3)"));
+  SPIEL_CHECK_GT(
+      static_cast<double>(normal_form_game->Shape()[0]) *
+          normal_form_game->Shape()[1] * normal_form_game->Shape()[2],
+      1e9);
+  std::unique_ptr<State> state = normal_form_game->NewInitialState();
+  state->ApplyActions({0, 1, 2});
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_FLOAT_NEAR(state->Returns()[0] + state->Returns()[1] +
+                             state->Returns()[2],
+                         0, 1e-12);
+  SPIEL_CHECK_EQ(normal_form_game->NumCachedUtilities(), 1);
+}
+
+void ReducedNormalFormGameTest() {
+  // In Kuhn poker, the first player only chooses after passing whether to
+  // call a bet, and the second player's choices are all reachable.
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::shared_ptr<const tensor_game::TensorGame> tensor_game =
+      ExtensiveToTensorGame(*game, /*reduced=*/true);
+  SPIEL_CHECK_EQ(tensor_game->Shape(), (std::vector<int>{27, 64}));
+  // Betting at once with every card.
+  SPIEL_CHECK_EQ(tensor_game->ActionName(0, 26),
+                 "0  ---  action = 1\n1  ---  action = 1\n"
+                 "2  ---  action = 1\n");
+
+  // The reduced strategies have the utilities of any of their full
+  // strategies, here choosing to pass and fold with every card.
+  std::shared_ptr<const tensor_game::TensorGame> full_tensor_game =
+      ExtensiveToTensorGame(*game);
+  SPIEL_CHECK_EQ(full_tensor_game->ActionName(0, 0),
+                 "0  ---  action = 0\n0pb  ---  action = 0\n1  ---  "
+                 "action = 0\n1pb  ---  action = 0\n2  ---  action = 0\n"
+                 "2pb  ---  action = 0\n");
+  SPIEL_CHECK_EQ(tensor_game->ActionName(0, 0),
+                 full_tensor_game->ActionName(0, 0));
+  for (Action col = 0; col < 64; ++col) {
+    SPIEL_CHECK_FLOAT_NEAR(tensor_game->PlayerUtility(0, {0, col}),
+                           full_tensor_game->PlayerUtility(0, {0, col}),
+                           1e-12);
+  }
+
+  testing::RandomSimTest(
+      *LoadGame("normal_form_extensive_game(game=kuhn_poker(),reduced=true,"
+                "lazy=true)"),
+      10);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::ExtensiveToTensorGameTest();
+  open_spiel::LazyNormalFormGameTest();
+  open_spiel::ReducedNormalFormGameTest();
 }
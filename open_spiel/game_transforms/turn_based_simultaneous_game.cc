@@ -19,6 +19,7 @@
 #include <string>
 #include <utility>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
@@ -70,10 +71,13 @@ void TurnBasedSimultaneousState::DetermineWhoseTurn() {
     // rolled out as turn-based, starting with player 0.
     current_player_ = Player{0};
     rollout_mode_ = true;
+    rollout_info_states_ =
+        std::make_shared<InformationStateStrings>(num_players_);
   } else {
     // Otherwise, just execute it normally.
     current_player_ = state_->CurrentPlayer();
     rollout_mode_ = false;
+    rollout_info_states_.reset();
   }
 }
 
@@ -102,7 +106,8 @@ void TurnBasedSimultaneousState::DoApplyAction(Action action_id) {
       RolloutModeIncrementCurrentPlayer();
       // Check if we then need to apply it.
       if (current_player_ == num_players_) {
-        state_->ApplyActions(action_vector_);
+        state_->ApplyActions(
+            std::vector<Action>(action_vector_.begin(), action_vector_.end()));
         DetermineWhoseTurn();
       }
     } else {
@@ -113,6 +118,31 @@ void TurnBasedSimultaneousState::DoApplyAction(Action action_id) {
   }
 }
 
+void TurnBasedSimultaneousState::UndoAction(Player player, Action action) {
+  if (player == kChancePlayerId) {
+    state_->UndoAction(player, action);
+    DetermineWhoseTurn();
+  } else if (rollout_mode_ && player < current_player_) {
+    // The action was only buffered.
+    current_player_ = player;
+  } else if (state_->GetGame()->GetType().dynamics ==
+             GameType::Dynamics::kSimultaneous) {
+    // The action completed the rollout of the previous node.
+    const std::vector<Action>& history = state_->History();
+    const std::vector<Action> actions(history.end() - num_players_,
+                                      history.end());
+    state_->UndoActions(actions);
+    DetermineWhoseTurn();
+    SPIEL_CHECK_TRUE(rollout_mode_);
+    std::copy(actions.begin(), actions.end(), action_vector_.begin());
+    current_player_ = player;
+  } else {
+    state_->UndoAction(player, action);
+    DetermineWhoseTurn();
+  }
+  history_.pop_back();
+}
+
 std::vector<std::pair<Action, double>>
 TurnBasedSimultaneousState::ChanceOutcomes() const {
   return state_->ChanceOutcomes();
@@ -148,73 +178,77 @@ std::vector<double> TurnBasedSimultaneousState::Returns() const {
   return state_->Returns();
 }
 
-std::string TurnBasedSimultaneousState::InformationStateString(
-    Player player) const {
-  SPIEL_CHECK_GE(player, 0);
-  SPIEL_CHECK_LT(player, num_players_);
-
-  std::string extra_info = "";
-  extra_info = "Current player: ";
-  absl::StrAppend(&extra_info, current_player_);
-  extra_info.push_back('\n');
+std::string TurnBasedSimultaneousState::ExtraInfo(Player player) const {
+  std::string extra_info = absl::StrCat("Current player: ", current_player_,
+                                        "\n");
   if (rollout_mode_) {
     // Include the player's action if they have take one already.
     if (player < current_player_) {
-      absl::StrAppend(&extra_info, "Observer's action this turn: ");
-      absl::StrAppend(&extra_info, action_vector_[player]);
-      extra_info.push_back('\n');
+      absl::StrAppend(&extra_info, "Observer's action this turn: ",
+                      action_vector_[player], "\n");
     }
   }
-  return extra_info + state_->InformationStateString(player);
+  return extra_info;
 }
 
-void TurnBasedSimultaneousState::InformationStateTensor(
-    Player player, std::vector<double>* values) const {
+std::string TurnBasedSimultaneousState::InformationStateString(
+    Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
-  values->reserve(game_->InformationStateTensorSize());
-
-  // First, get the 2 * num_players bits to encode whose turn it is and who
-  // the observer is.
-  for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == current_player_ ? 1 : 0);
+  if (rollout_info_states_ == nullptr) {
+    return ExtraInfo(player) + state_->InformationStateString(player);
+  }
+  InformationStateStrings& cache = *rollout_info_states_;
+  {
+    absl::MutexLock lock(&cache.mutex);
+    if (cache.strings[player].has_value()) {
+      return ExtraInfo(player) + *cache.strings[player];
+    }
   }
+  std::string info_state = state_->InformationStateString(player);
+  std::string result = ExtraInfo(player) + info_state;
+  absl::MutexLock lock(&cache.mutex);
+  cache.strings[player] = std::move(info_state);
+  return result;
+}
+
+void TurnBasedSimultaneousState::WritePlayers(Player player,
+                                              absl::Span<float> values) const {
   for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == player ? 1 : 0);
+    values[p] = p == current_player_ ? 1 : 0;
+    values[num_players_ + p] = p == player ? 1 : 0;
   }
+}
 
-  // Then get the underlying info set
-  std::vector<double> infoset;
-  state_->InformationStateTensor(player, &infoset);
+// The tensors are the 2 * num_players bits encoding whose turn it is and who
+// the observer is, followed by those of the wrapped state, which write theirs
+// in place.
+void TurnBasedSimultaneousState::InformationStateTensor(
+    Player player, std::vector<double>* values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
 
-  int offset = values->size();
-  values->resize(values->size() + infoset.size());
+  values->reserve(game_->InformationStateTensorSize());
+  state_->InformationStateTensor(player, values);
+  values->insert(values->begin(), 2 * num_players_, 0);
+  if (current_player_ >= 0) (*values)[current_player_] = 1;
+  (*values)[num_players_ + player] = 1;
+}
 
-  // Now copy it over.
-  for (int i = 0; i < infoset.size(); i++) {
-    (*values)[offset + i] = infoset[i];
-  }
+void TurnBasedSimultaneousState::InformationStateTensor(
+    Player player, absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  SPIEL_CHECK_EQ(values.size(), game_->InformationStateTensorSize());
+  WritePlayers(player, values);
+  state_->InformationStateTensor(player, values.subspan(2 * num_players_));
 }
 
 std::string TurnBasedSimultaneousState::ObservationString(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
-
-  std::string extra_info = "";
-  extra_info = "Current player: ";
-  absl::StrAppend(&extra_info, current_player_);
-  extra_info.push_back('\n');
-  if (rollout_mode_) {
-    // Include the player's action if they have take one already.
-    if (player < current_player_) {
-      absl::StrAppend(&extra_info, "Observer's action this turn: ");
-      absl::StrAppend(&extra_info, action_vector_[player]);
-      extra_info.push_back('\n');
-    }
-  }
-  return extra_info + state_->ObservationString(player);
+  return ExtraInfo(player) + state_->ObservationString(player);
 }
 
 void TurnBasedSimultaneousState::ObservationTensor(
@@ -222,29 +256,20 @@ void TurnBasedSimultaneousState::ObservationTensor(
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->clear();
   values->reserve(game_->ObservationTensorSize());
+  state_->ObservationTensor(player, values);
+  values->insert(values->begin(), 2 * num_players_, 0);
+  if (current_player_ >= 0) (*values)[current_player_] = 1;
+  (*values)[num_players_ + player] = 1;
+}
 
-  // First, get the 2 * num_players bits to encode whose turn it is and who
-  // the observer is.
-  for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == current_player_ ? 1 : 0);
-  }
-  for (auto p = Player{0}; p < num_players_; ++p) {
-    values->push_back(p == player ? 1 : 0);
-  }
-
-  // Then get the underlying observation
-  std::vector<double> observation;
-  state_->ObservationTensor(player, &observation);
-
-  int offset = values->size();
-  values->resize(values->size() + observation.size());
-
-  // Now copy it over.
-  for (int i = 0; i < observation.size(); i++) {
-    (*values)[offset + i] = observation[i];
-  }
+void TurnBasedSimultaneousState::ObservationTensor(
+    Player player, absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorSize());
+  WritePlayers(player, values);
+  state_->ObservationTensor(player, values.subspan(2 * num_players_));
 }
 
 TurnBasedSimultaneousState::TurnBasedSimultaneousState(
@@ -252,6 +277,7 @@ TurnBasedSimultaneousState::TurnBasedSimultaneousState(
     : State(other),
       state_(other.state_->Clone()),
       action_vector_(other.action_vector_),
+      rollout_info_states_(other.rollout_info_states_),
       current_player_(other.current_player_),
       rollout_mode_(other.rollout_mode_) {}
 
@@ -259,6 +285,19 @@ std::unique_ptr<State> TurnBasedSimultaneousState::Clone() const {
   return std::unique_ptr<State>(new TurnBasedSimultaneousState(*this));
 }
 
+bool TurnBasedSimultaneousState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  const auto& state = static_cast<const TurnBasedSimultaneousState&>(other);
+  // The wrapped state is recycled too, if its game supports it.
+  if (!state_->CopyFrom(*state.state_)) return false;
+  State::operator=(state);
+  action_vector_ = state.action_vector_;
+  rollout_info_states_ = state.rollout_info_states_;
+  current_player_ = state.current_player_;
+  rollout_mode_ = state.rollout_mode_;
+  return true;
+}
+
 namespace {
 GameType ConvertType(GameType type) {
   type.dynamics = GameType::Dynamics::kSequential;
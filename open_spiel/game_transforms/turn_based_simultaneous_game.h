@@ -16,9 +16,13 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_TURN_BASED_SIMULTANEOUS_GAME_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/inlined_vector.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 
 // This wrapper turns any n-player simultaneous move game into an equivalent
@@ -47,10 +51,22 @@ class TurnBasedSimultaneousState : public State {
   std::string InformationStateString(Player player) const override;
   void InformationStateTensor(Player player,
                               std::vector<double>* values) const override;
+  void InformationStateTensor(Player player,
+                              absl::Span<float> values) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  // The last action of a rollout is undone with UndoActions on the wrapped
+  // state, when it is simultaneous. This requires the simultaneous games
+  // supporting undo to only have chance and simultaneous move nodes.
+  void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override {
+    return state_->SupportsUndoAction();
+  }
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
 
   // Access to the wrapped state, used for debugging and in the tests.
@@ -61,15 +77,30 @@ class TurnBasedSimultaneousState : public State {
   void DoApplyAction(Action action_id) override;
 
  private:
+  // The information state strings of the wrapped state, for each player,
+  // which do not change while a simultaneous move node is rolled out. The
+  // states of the rollout share them, so each is only computed once.
+  struct InformationStateStrings {
+    explicit InformationStateStrings(int num_players) : strings(num_players) {}
+    absl::Mutex mutex;
+    std::vector<std::optional<std::string>> strings ABSL_GUARDED_BY(mutex);
+  };
+
   void DetermineWhoseTurn();
   void RolloutModeIncrementCurrentPlayer();
+  // Writes the one-hot current and observing players.
+  void WritePlayers(Player player, absl::Span<float> values) const;
+  std::string ExtraInfo(Player player) const;
 
   std::unique_ptr<State> state_;
 
   // A vector of actions that is used primarily to store the intermediate
   // actions taken by the players when extending the simultaneous move nodes
-  // to be turn-based.
-  std::vector<Action> action_vector_;
+  // to be turn-based. It is inlined, so that clones do not allocate it.
+  absl::InlinedVector<Action, 4> action_vector_;
+
+  // Set in rollout mode only.
+  std::shared_ptr<InformationStateStrings> rollout_info_states_;
 
   // The current player (which will never be kSimultaneousPlayerId).
   Player current_player_;
@@ -18,11 +18,16 @@
 #include <string>
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
 namespace {
 
+namespace testing = open_spiel::testing;
+
 void SimulateGames(std::mt19937* rng, const Game& game, State* sim_state,
                    State* turn_based_state) {
   while (!sim_state->IsTerminal()) {
@@ -123,9 +128,40 @@ void BasicTurnBasedSimultaneousTests() {
   }
 }
 
+// The states of a rollout share the wrapped state's information state strings,
+// which must not leak between the rollouts of different nodes.
+void RolloutInformationStatesTest() {
+  const GameParameters params = {
+      {"num_cards", GameParameter(4)},
+      {"points_order", GameParameter(std::string("descending"))}};
+  std::shared_ptr<const Game> game = LoadGameAsTurnBased("goofspiel", params);
+  testing::RandomSimTest(*game, 10);
+
+  std::unique_ptr<State> state = game->NewInitialState();
+  const std::string info_state = state->InformationStateString(1);
+  std::unique_ptr<State> low_bid = state->Child(0);
+  std::unique_ptr<State> high_bid = state->Child(3);
+  SPIEL_CHECK_EQ(low_bid->InformationStateString(1),
+                 high_bid->InformationStateString(1));
+  SPIEL_CHECK_EQ(low_bid->InformationStateString(1),
+                 absl::StrCat("Current player: 1\n",
+                              static_cast<const TurnBasedSimultaneousState&>(
+                                  *state)
+                                  .SimultaneousGameState()
+                                  ->InformationStateString(1)));
+
+  // After the joint action, player 1 sees the outcome of the bids.
+  low_bid->ApplyAction(1);
+  high_bid->ApplyAction(1);
+  SPIEL_CHECK_NE(low_bid->InformationStateString(1),
+                 high_bid->InformationStateString(1));
+  SPIEL_CHECK_NE(low_bid->InformationStateString(1), info_state);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::BasicTurnBasedSimultaneousTests();
+  open_spiel::RolloutInformationStatesTest();
 }
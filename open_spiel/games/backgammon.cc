@@ -15,12 +15,13 @@
 #include "open_spiel/games/backgammon.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdlib>
-#include <set>
 #include <utility>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -59,6 +60,9 @@ const std::vector<std::pair<Action, double>> kChanceOutcomes = {
     std::pair<Action, double>(20, 1.0 / 36),
 };
 
+// Every chance node is a roll of the two dice.
+const ChanceDistribution kRollDistribution(kChanceOutcomes);
+
 const std::vector<std::vector<int>> kChanceOutcomeValues = {
     {1, 2}, {1, 3}, {1, 4}, {1, 5}, {1, 6}, {2, 3}, {2, 4},
     {2, 5}, {2, 6}, {3, 4}, {3, 5}, {3, 6}, {4, 5}, {4, 6},
@@ -88,6 +92,96 @@ static std::shared_ptr<const Game> Factory(const GameParameters& params) {
 }
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
+
+// A checker move of the legal move search: from a point, numbered as seen by
+// the player to move, or from the bar (-1), with a die.
+struct SearchMove {
+  int from;
+  int die;
+};
+
+// Checkers on at most 15 points can move with each of two dice.
+constexpr int kMaxSearchMoves = 2 * kNumCheckersPerPlayer;
+
+// A copy of the board for the legal move search, which needs no allocation.
+// The points are numbered from the player to move's side, so that its
+// checkers move from 0 up to 23, then off the board.
+class MoveSearchBoard {
+ public:
+  explicit MoveSearchBoard(const BackgammonState& state)
+      : player_(state.CurrentPlayer()), bar_(state.bar(player_)) {
+    const Player opponent = state.Opponent(player_);
+    for (int point = 0; point < kNumPoints; ++point) {
+      mine_[point] = state.board(player_, AbsolutePosition(point));
+      theirs_[point] = state.board(opponent, AbsolutePosition(point));
+    }
+    for (int i = 0; i < 2; ++i) {
+      const int die = state.dice(i);
+      dice_[i] = die >= 1 && die <= 6 ? die : 0;
+    }
+  }
+
+  // The position of a point, or of the bar, in the usual numbering.
+  int AbsolutePosition(int point) const {
+    if (point < 0) return kBarPos;
+    return player_ == kXPlayerId ? point : kNumPoints - 1 - point;
+  }
+
+  // Writes the distinct legal moves of a single checker into `moves`, and
+  // returns how many there are.
+  int LegalMoves(std::array<SearchMove, kMaxSearchMoves>* moves) const {
+    int num_moves = 0;
+    int nearest = 0;  // The checker furthest from home.
+    while (nearest < kNumPoints && mine_[nearest] == 0) ++nearest;
+    const bool all_in_home = bar_ == 0 && nearest >= kNumPoints - 6;
+    for (int i = 0; i < 2; ++i) {
+      const int die = dice_[i];
+      // Doubles allow the same moves with either die.
+      if (die == 0 || (i == 1 && die == dice_[0])) continue;
+      if (bar_ > 0) {
+        // Checkers on the bar must enter first.
+        if (theirs_[die - 1] <= 1) (*moves)[num_moves++] = {-1, die};
+        continue;
+      }
+      for (int point = nearest; point < kNumPoints; ++point) {
+        if (mine_[point] == 0) continue;
+        const int to = point + die;
+        if (to < kNumPoints) {
+          if (theirs_[to] <= 1) (*moves)[num_moves++] = {point, die};
+        } else if (all_in_home && (to == kNumPoints || point == nearest)) {
+          // Bearing off takes the exact die, or a higher one for the
+          // furthest checkers.
+          (*moves)[num_moves++] = {point, die};
+        }
+      }
+    }
+    return num_moves;
+  }
+
+  void Apply(const SearchMove& move) {
+    if (move.from < 0) {
+      --bar_;
+    } else {
+      --mine_[move.from];
+    }
+    const int to = move.from + move.die;
+    if (to < kNumPoints) {
+      ++mine_[to];
+      // A hit checker goes to the opponent's bar, which does not matter here.
+      theirs_[to] = 0;
+    }
+    dice_[dice_[0] == move.die ? 0 : 1] = 0;
+  }
+
+ private:
+  Player player_;
+  int bar_;
+  std::array<int, kNumPoints> mine_;
+  std::array<int, kNumPoints> theirs_;
+  // The unused dice, or 0.
+  std::array<int, 2> dice_;
+};
+
 }  // namespace
 
 ScoringType ParseScoringType(const std::string& st_str) {
@@ -305,8 +399,7 @@ BackgammonState::BackgammonState(std::shared_ptr<const Game> game,
       dice_({}),
       bar_({0, 0}),
       scores_({0, 0}),
-      board_(
-          {std::vector<int>(kNumPoints, 0), std::vector<int>(kNumPoints, 0)}),
+      board_(),
       turn_history_info_({}) {
   // Setup the board. First, XPlayer.
   board_[kXPlayerId][0] = 2;
@@ -522,31 +615,31 @@ Action BackgammonState::EncodedPassMove() const { return 25; }
 Action BackgammonState::CheckerMovesToSpielMove(
     const std::vector<CheckerMove>& moves) const {
   SPIEL_CHECK_LE(moves.size(), 2);
+  return EncodeCheckerMoves(moves.empty() ? kPassPos : moves[0].pos,
+                            moves.empty() ? -1 : moves[0].num,
+                            moves.size() > 1 ? moves[1].pos : kPassPos);
+}
+
+Action BackgammonState::EncodeCheckerMoves(int pos1, int num1,
+                                           int pos2) const {
   int dig0 = EncodedPassMove();
   int dig1 = EncodedPassMove();
   bool high_roll_first = false;
   int high_roll = DiceValue(0) >= DiceValue(1) ? DiceValue(0) : DiceValue(1);
 
-  if (!moves.empty()) {
-    int pos1 = moves[0].pos;
-    if (pos1 == kBarPos) {
-      pos1 = EncodedBarMove();
-    }
-    if (pos1 != kPassPos) {
-      int num1 = moves[0].num;
-      dig0 = pos1;
-      high_roll_first = num1 == high_roll;
-    }
+  if (pos1 == kBarPos) {
+    pos1 = EncodedBarMove();
+  }
+  if (pos1 != kPassPos) {
+    dig0 = pos1;
+    high_roll_first = num1 == high_roll;
   }
 
-  if (moves.size() > 1) {
-    int pos2 = moves[1].pos;
-    if (pos2 == kBarPos) {
-      pos2 = EncodedBarMove();
-    }
-    if (pos2 != kPassPos) {
-      dig1 = pos2;
-    }
+  if (pos2 == kBarPos) {
+    pos2 = EncodedBarMove();
+  }
+  if (pos2 != kPassPos) {
+    dig1 = pos2;
   }
 
   Action move = dig1 * 26 + dig0;
@@ -857,58 +950,6 @@ int BackgammonState::IsBackgammoned(int player) const {
   return false;
 }
 
-std::set<CheckerMove> BackgammonState::LegalCheckerMoves(int player) const {
-  std::set<CheckerMove> moves;
-
-  if (bar_[player] > 0) {
-    // If there are any checkers are the bar, must move them out first.
-    for (int outcome : dice_) {
-      if (UsableDiceOutcome(outcome)) {
-        int pos = PositionFromBar(player, outcome);
-        if (NumOppCheckers(player, pos) <= 1) {
-          bool hit = NumOppCheckers(player, pos) == 1;
-          moves.insert(CheckerMove(kBarPos, outcome, hit));
-        }
-      }
-    }
-    return moves;
-  }
-
-  // Regular board moves.
-  bool all_in_home = AllInHome(player);
-  for (int i = 0; i < kNumPoints; ++i) {
-    if (board_[player][i] > 0) {
-      for (int outcome : dice_) {
-        if (UsableDiceOutcome(outcome)) {
-          int pos = PositionFrom(player, i, outcome);
-          if (pos == kScorePos && all_in_home) {
-            // Check whether a bear off move is legal.
-
-            // It is ok to bear off if all the checkers are at home and the
-            // point being used to move from exactly matches the distance from
-            // just stepping off the board.
-            if ((player == kXPlayerId && i + outcome == 24) ||
-                (player == kOPlayerId && i - outcome == -1)) {
-              moves.insert(CheckerMove(i, outcome, false));
-            } else {
-              // Otherwise, a die can only be used to move a checker off if
-              // there are no checkers further than it in the player's home.
-              if (i == FurthestCheckerInHome(player)) {
-                moves.insert(CheckerMove(i, outcome, false));
-              }
-            }
-          } else if (pos != kScorePos && NumOppCheckers(player, pos) <= 1) {
-            // Regular move.
-            bool hit = NumOppCheckers(player, pos) == 1;
-            moves.insert(CheckerMove(i, outcome, hit));
-          }
-        }
-      }
-    }
-  }
-  return moves;
-}
-
 bool BackgammonState::ApplyCheckerMove(int player, const CheckerMove& move) {
   // Pass does nothing.
   if (move.pos < 0) {
@@ -1001,45 +1042,29 @@ void BackgammonState::UndoCheckerMove(int player, const CheckerMove& move) {
   }
 }
 
-// Returns the maximum move size (2, 1, or 0)
-int BackgammonState::RecLegalMoves(
-    std::vector<CheckerMove> moveseq,
-    std::set<std::vector<CheckerMove>>* movelist) {
-  if (moveseq.size() == 2) {
-    movelist->insert(moveseq);
-    return moveseq.size();
-  }
-
-  std::set<CheckerMove> moves_here = LegalCheckerMoves(cur_player_);
-
-  if (moves_here.empty()) {
-    movelist->insert(moveseq);
-    return moveseq.size();
-  }
+std::vector<Action> BackgammonState::LegalActions() const {
+  std::vector<Action> legal_actions;
+  LegalActions(&legal_actions);
+  return legal_actions;
+}
 
-  int max_moves = -1;
-  for (const auto& move : moves_here) {
-    moveseq.push_back(move);
-    ApplyCheckerMove(cur_player_, move);
-    int child_max = RecLegalMoves(moveseq, movelist);
-    UndoCheckerMove(cur_player_, move);
-    max_moves = std::max(child_max, max_moves);
-    moveseq.pop_back();
+void BackgammonState::LegalActions(std::vector<Action>* actions) const {
+  actions->clear();
+  if (IsChanceNode()) {
+    actions->reserve(kChanceOutcomes.size());
+    for (const auto& outcome : kChanceOutcomes) {
+      actions->push_back(outcome.first);
+    }
+    return;
   }
+  if (IsTerminal()) return;
 
-  return max_moves;
-}
-
-std::vector<Action> BackgammonState::ProcessLegalMoves(
-    int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const {
-  if (max_moves == 0) {
-    SPIEL_CHECK_EQ(movelist.size(), 1);
-    SPIEL_CHECK_TRUE(movelist.begin()->empty());
+  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
+  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
 
-    // Passing is always a legal move!
-    return {CheckerMovesToSpielMove(
-        {{kPassPos, -1, false}, {kPassPos, -1, false}})};
-  }
+  const MoveSearchBoard board(*this);
+  std::array<SearchMove, kMaxSearchMoves> first_moves;
+  const int num_first_moves = board.LegalMoves(&first_moves);
 
   // Rule 2 in Movement of Checkers:
   // A player must use both numbers of a roll if this is legally possible (or
@@ -1048,49 +1073,39 @@ std::vector<Action> BackgammonState::ProcessLegalMoves(
   // both, the player must play the larger one. When neither number can be used,
   // the player loses his turn. In the case of doubles, when all four numbers
   // cannot be played, the player must play as many numbers as he can.
-  std::vector<Action> legal_actions;
-  int max_roll = -1;
-  for (const auto& move : movelist) {
-    if (max_moves == 2) {
-      // Only add moves that are size 2.
-      if (move.size() == 2) {
-        legal_actions.push_back(CheckerMovesToSpielMove(move));
+  //
+  // The moves with the same die from the same point are the same, so each
+  // pair of moves is a distinct action.
+  bool can_move_twice = false;
+  int max_single_roll = -1;
+  std::array<SearchMove, kMaxSearchMoves> second_moves;
+  for (int i = 0; i < num_first_moves; ++i) {
+    const SearchMove& first = first_moves[i];
+    MoveSearchBoard child = board;
+    child.Apply(first);
+    const int num_second_moves = child.LegalMoves(&second_moves);
+    if (num_second_moves > 0) {
+      if (!can_move_twice) actions->clear();
+      can_move_twice = true;
+      for (int j = 0; j < num_second_moves; ++j) {
+        actions->push_back(EncodeCheckerMoves(
+            board.AbsolutePosition(first.from), first.die,
+            board.AbsolutePosition(second_moves[j].from)));
       }
-    } else if (max_moves == 1) {
-      // We are just finding the maximum roll.
-      max_roll = std::max(max_roll, move[0].num);
+    } else if (!can_move_twice && first.die >= max_single_roll) {
+      // Only the moves with the highest die are kept.
+      if (first.die > max_single_roll) actions->clear();
+      max_single_roll = first.die;
+      actions->push_back(EncodeCheckerMoves(board.AbsolutePosition(first.from),
+                                            first.die, kPassPos));
     }
   }
 
-  if (max_moves == 1) {
-    // Another round to add those that have the max die roll.
-    for (const auto& move : movelist) {
-      if (move[0].num == max_roll) {
-        legal_actions.push_back(CheckerMovesToSpielMove(move));
-      }
-    }
+  if (actions->empty()) {
+    // Passing is always a legal move!
+    actions->push_back(EncodeCheckerMoves(kPassPos, -1, kPassPos));
   }
-
-  SPIEL_CHECK_FALSE(legal_actions.empty());
-  return legal_actions;
-}
-
-std::vector<Action> BackgammonState::LegalActions() const {
-  if (IsChanceNode()) return LegalChanceOutcomes();
-  if (IsTerminal()) return {};
-
-  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
-  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
-
-  std::unique_ptr<State> cstate = this->Clone();
-  BackgammonState* state = dynamic_cast<BackgammonState*>(cstate.get());
-  std::set<std::vector<CheckerMove>> movelist;
-  int max_moves = state->RecLegalMoves({}, &movelist);
-  SPIEL_CHECK_GE(max_moves, 0);
-  SPIEL_CHECK_LE(max_moves, 2);
-  std::vector<Action> legal_actions = ProcessLegalMoves(max_moves, movelist);
-  std::sort(legal_actions.begin(), legal_actions.end());
-  return legal_actions;
+  std::sort(actions->begin(), actions->end());
 }
 
 std::vector<std::pair<Action, double>> BackgammonState::ChanceOutcomes() const {
@@ -1098,6 +1113,12 @@ std::vector<std::pair<Action, double>> BackgammonState::ChanceOutcomes() const {
   return kChanceOutcomes;
 }
 
+std::pair<Action, double> BackgammonState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  return kRollDistribution.Sample(rng);
+}
+
 std::string BackgammonState::ToString() const {
   std::vector<std::string> board_array = {
       "+------|------+", "|......|......|", "|......|......|",
@@ -1208,6 +1229,12 @@ std::unique_ptr<State> BackgammonState::Clone() const {
   return std::unique_ptr<State>(new BackgammonState(*this));
 }
 
+bool BackgammonState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const BackgammonState&>(other);
+  return true;
+}
+
 void BackgammonState::SetState(int cur_player, bool double_turn,
                                const std::vector<int>& dice,
                                const std::vector<int>& bar,
@@ -1216,9 +1243,16 @@ void BackgammonState::SetState(int cur_player, bool double_turn,
   cur_player_ = cur_player;
   double_turn_ = double_turn;
   dice_ = dice;
-  bar_ = bar;
-  scores_ = scores;
-  board_ = board;
+  SPIEL_CHECK_EQ(bar.size(), kNumPlayers);
+  SPIEL_CHECK_EQ(scores.size(), kNumPlayers);
+  SPIEL_CHECK_EQ(board.size(), kNumPlayers);
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    bar_[player] = bar[player];
+    scores_[player] = scores[player];
+    SPIEL_CHECK_EQ(board[player].size(), kNumPoints);
+    std::copy(board[player].begin(), board[player].end(),
+              board_[player].begin());
+  }
 
   SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
   SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
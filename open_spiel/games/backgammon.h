@@ -17,7 +17,6 @@
 
 #include <array>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -116,9 +115,13 @@ class BackgammonState : public State {
 
   Player CurrentPlayer() const override;
   void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<Action> LegalActions() const override;
+  void LegalActions(std::vector<Action>* actions) const override;
   std::string ActionToString(Player player, Action move_id) const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
@@ -126,6 +129,7 @@ class BackgammonState : public State {
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
 
   // Setter function used for debugging and tests. Note: this does not set the
   // historical information properly, so Undo likely will not work on states
@@ -211,13 +215,12 @@ class BackgammonState : public State {
   // Returns -1 if none found.
   int FurthestCheckerInHome(int player) const;
 
+  // Encodes playing from pos1 with num1 pips then from pos2 with the other
+  // die, where either position may be kPassPos.
+  Action EncodeCheckerMoves(int pos1, int num1, int pos2) const;
+
   bool ApplyCheckerMove(int player, const CheckerMove& move);
   void UndoCheckerMove(int player, const CheckerMove& move);
-  std::set<CheckerMove> LegalCheckerMoves(int player) const;
-  int RecLegalMoves(std::vector<CheckerMove> moveseq,
-                    std::set<std::vector<CheckerMove>>* movelist);
-  std::vector<Action> ProcessLegalMoves(
-      int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const;
 
   ScoringType scoring_type_;  // Which rules apply when scoring the game.
 
@@ -227,10 +230,11 @@ class BackgammonState : public State {
   int x_turns_;
   int o_turns_;
   bool double_turn_;
-  std::vector<int> dice_;    // Current dice.
-  std::vector<int> bar_;     // Checkers of each player in the bar.
-  std::vector<int> scores_;  // Checkers returned home by each player.
-  std::vector<std::vector<int>> board_;  // Checkers for each player on points.
+  std::vector<int> dice_;  // Current dice.
+  // Checkers of each player in the bar, returned home, and on points.
+  std::array<int, kNumPlayers> bar_;
+  std::array<int, kNumPlayers> scores_;
+  std::array<std::array<int, kNumPoints>, kNumPlayers> board_;
   std::vector<TurnHistoryInfo> turn_history_info_;  // Info needed for Undo.
 };
 
@@ -15,7 +15,11 @@
 #include "open_spiel/games/backgammon.h"
 
 #include <algorithm>
+#include <array>
+#include <memory>
 #include <random>
+#include <set>
+#include <vector>
 
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -522,6 +526,200 @@ void HumanReadableNotation() {
   SPIEL_CHECK_EQ(notation, absl::StrCat(legal_actions[0], " - 24/18 Pass"));
 }
 
+// LegalActions(std::vector<Action>*) fills the caller's buffer in place, so a
+// buffer large enough for any position is never reallocated.
+void LegalActionsFillBufferInPlace() {
+  std::shared_ptr<const Game> game = LoadGame("backgammon");
+  std::mt19937 rng(7);
+  std::vector<Action> buffer;
+  buffer.reserve(game->NumDistinctActions());
+  const Action* data = buffer.data();
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      state->LegalActions(&buffer);
+      SPIEL_CHECK_EQ(buffer.data(), data);
+      SPIEL_CHECK_EQ(buffer, state->LegalActions());
+      state->ApplyAction(buffer[std::uniform_int_distribution<int>(
+          0, buffer.size() - 1)(rng)]);
+    }
+  }
+}
+
+// The position searched by the original, set-based move generation, which
+// ReferenceLegalActions ports as a reference for LegalActions.
+struct ReferencePosition {
+  int player;
+  std::array<int, 2> dice;
+  std::array<int, kNumPlayers> bar;
+  std::array<std::array<int, kNumPoints>, kNumPlayers> board;
+};
+
+int ReferencePositionFrom(int player, int pos, int spaces) {
+  if (pos == kBarPos) {
+    return player == kXPlayerId ? -1 + spaces : 24 - spaces;
+  }
+  const int new_pos = player == kXPlayerId ? pos + spaces : pos - spaces;
+  return new_pos < 0 || new_pos > 23 ? kScorePos : new_pos;
+}
+
+bool ReferenceAllInHome(const ReferencePosition& position) {
+  if (position.bar[position.player] > 0) return false;
+  const int start = position.player == kXPlayerId ? 0 : 6;
+  const int end = position.player == kXPlayerId ? 17 : 23;
+  for (int i = start; i <= end; ++i) {
+    if (position.board[position.player][i] > 0) return false;
+  }
+  return true;
+}
+
+int ReferenceFurthestCheckerInHome(const ReferencePosition& position) {
+  const int player = position.player;
+  const int start = player == kXPlayerId ? 23 : 0;
+  const int end = player == kXPlayerId ? 17 : 6;
+  const int inc = player == kXPlayerId ? -1 : 1;
+  int furthest = -1;
+  for (int i = start; i != end; i += inc) {
+    if (position.board[player][i] > 0) furthest = i;
+  }
+  return furthest;
+}
+
+std::set<CheckerMove> ReferenceCheckerMoves(const ReferencePosition& position) {
+  const int player = position.player;
+  const int opponent = 1 - player;
+  std::set<CheckerMove> moves;
+  if (position.bar[player] > 0) {
+    for (int outcome : position.dice) {
+      if (outcome < 1 || outcome > 6) continue;
+      const int pos = ReferencePositionFrom(player, kBarPos, outcome);
+      if (position.board[opponent][pos] <= 1) {
+        moves.insert(
+            CheckerMove(kBarPos, outcome, position.board[opponent][pos] == 1));
+      }
+    }
+    return moves;
+  }
+  const bool all_in_home = ReferenceAllInHome(position);
+  for (int i = 0; i < kNumPoints; ++i) {
+    if (position.board[player][i] == 0) continue;
+    for (int outcome : position.dice) {
+      if (outcome < 1 || outcome > 6) continue;
+      const int pos = ReferencePositionFrom(player, i, outcome);
+      if (pos == kScorePos && all_in_home) {
+        if ((player == kXPlayerId && i + outcome == 24) ||
+            (player == kOPlayerId && i - outcome == -1) ||
+            i == ReferenceFurthestCheckerInHome(position)) {
+          moves.insert(CheckerMove(i, outcome, false));
+        }
+      } else if (pos != kScorePos && position.board[opponent][pos] <= 1) {
+        moves.insert(
+            CheckerMove(i, outcome, position.board[opponent][pos] == 1));
+      }
+    }
+  }
+  return moves;
+}
+
+void ReferenceApplyCheckerMove(const CheckerMove& move,
+                               ReferencePosition* position) {
+  const int player = position->player;
+  const int opponent = 1 - player;
+  if (move.pos == kBarPos) {
+    --position->bar[player];
+  } else {
+    --position->board[player][move.pos];
+  }
+  for (int& die : position->dice) {
+    if (die == move.num) {
+      die += 6;
+      break;
+    }
+  }
+  const int next_pos = ReferencePositionFrom(player, move.pos, move.num);
+  if (next_pos == kScorePos) return;
+  ++position->board[player][next_pos];
+  if (position->board[opponent][next_pos] == 1) {
+    --position->board[opponent][next_pos];
+    ++position->bar[opponent];
+  }
+}
+
+// Returns the maximum number of checker moves of the sequences.
+int ReferenceMoveSequences(const ReferencePosition& position,
+                           std::vector<CheckerMove>* sequence,
+                           std::set<std::vector<CheckerMove>>* sequences) {
+  const std::set<CheckerMove> moves =
+      sequence->size() == 2 ? std::set<CheckerMove>()
+                            : ReferenceCheckerMoves(position);
+  if (moves.empty()) {
+    sequences->insert(*sequence);
+    return sequence->size();
+  }
+  int max_moves = -1;
+  for (const CheckerMove& move : moves) {
+    ReferencePosition child = position;
+    ReferenceApplyCheckerMove(move, &child);
+    sequence->push_back(move);
+    max_moves =
+        std::max(max_moves, ReferenceMoveSequences(child, sequence, sequences));
+    sequence->pop_back();
+  }
+  return max_moves;
+}
+
+std::vector<Action> ReferenceLegalActions(const BackgammonState& state) {
+  ReferencePosition position;
+  position.player = state.CurrentPlayer();
+  position.dice = {state.dice(0), state.dice(1)};
+  for (int player = 0; player < kNumPlayers; ++player) {
+    position.bar[player] = state.bar(player);
+    for (int pos = 0; pos < kNumPoints; ++pos) {
+      position.board[player][pos] = state.board(player, pos);
+    }
+  }
+  std::vector<CheckerMove> sequence;
+  std::set<std::vector<CheckerMove>> sequences;
+  const int max_moves = ReferenceMoveSequences(position, &sequence, &sequences);
+  if (max_moves == 0) return {state.CheckerMovesToSpielMove({})};
+
+  // Both dice must be used if possible, and otherwise the higher one.
+  int max_roll = -1;
+  for (const auto& moves : sequences) {
+    if (max_moves == 1) max_roll = std::max(max_roll, moves[0].num);
+  }
+  std::vector<Action> actions;
+  for (const auto& moves : sequences) {
+    if ((max_moves == 2 && moves.size() == 2) ||
+        (max_moves == 1 && moves[0].num == max_roll)) {
+      actions.push_back(state.CheckerMovesToSpielMove(moves));
+    }
+  }
+  std::sort(actions.begin(), actions.end());
+  return actions;
+}
+
+// The legal actions match those of the original move generation.
+void LegalActionsMatchReference() {
+  std::shared_ptr<const Game> game = LoadGame("backgammon");
+  std::mt19937 rng(11);
+  for (int i = 0; i < 300; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(state->SampleChanceOutcome(rng).first);
+        continue;
+      }
+      const std::vector<Action> legal_actions = state->LegalActions();
+      SPIEL_CHECK_EQ(
+          legal_actions,
+          ReferenceLegalActions(static_cast<const BackgammonState&>(*state)));
+      state->ApplyAction(legal_actions[std::uniform_int_distribution<int>(
+          0, legal_actions.size() - 1)(rng)]);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace backgammon
 }  // namespace open_spiel
@@ -536,4 +734,6 @@ int main(int argc, char** argv) {
   open_spiel::backgammon::DoublesBearOffOutsideHome();
   open_spiel::backgammon::BasicBackgammonTestsVaryScoring();
   open_spiel::backgammon::HumanReadableNotation();
+  open_spiel::backgammon::LegalActionsFillBufferInPlace();
+  open_spiel::backgammon::LegalActionsMatchReference();
 }
@@ -14,10 +14,15 @@
 
 #include "open_spiel/games/blotto.h"
 
+#include <limits>
+#include <numeric>
 #include <set>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 namespace blotto {
@@ -53,15 +58,59 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 REGISTER_SPIEL_GAME(kGameType, Factory);
 }  // namespace
 
+int64_t NumAllocations(int coins, int fields) {
+  SPIEL_CHECK_GE(coins, 0);
+  SPIEL_CHECK_GE(fields, 1);
+  // Each partial product is itself a binomial coefficient, so the divisions
+  // are exact.
+  int64_t num = 1;
+  for (int i = 1; i < fields; ++i) num = num * (coins + i) / i;
+  return num;
+}
+
+std::vector<int> ActionToAllocation(Action action, int coins, int fields) {
+  SPIEL_CHECK_GE(action, 0);
+  SPIEL_CHECK_LT(action, NumAllocations(coins, fields));
+  // The allocations are ordered by the coins on the first field, then on the
+  // second, and so on: skip over the blocks of those with fewer coins on each
+  // field than the action's.
+  std::vector<int> allocation(fields);
+  int coins_left = coins;
+  for (int f = 0; f < fields - 1; ++f) {
+    int num_coins = 0;
+    int64_t block = NumAllocations(coins_left, fields - f - 1);
+    while (action >= block) {
+      action -= block;
+      ++num_coins;
+      block = NumAllocations(coins_left - num_coins, fields - f - 1);
+    }
+    allocation[f] = num_coins;
+    coins_left -= num_coins;
+  }
+  allocation[fields - 1] = coins_left;
+  return allocation;
+}
+
+Action AllocationToAction(absl::Span<const int> allocation, int coins) {
+  const int fields = allocation.size();
+  Action action = 0;
+  int coins_left = coins;
+  for (int f = 0; f < fields - 1; ++f) {
+    for (int num_coins = 0; num_coins < allocation[f]; ++num_coins) {
+      action += NumAllocations(coins_left - num_coins, fields - f - 1);
+    }
+    coins_left -= allocation[f];
+  }
+  SPIEL_CHECK_EQ(allocation[fields - 1], coins_left);
+  return action;
+}
+
 BlottoState::BlottoState(std::shared_ptr<const Game> game, int coins,
-                         int fields, const ActionMap* action_map,
-                         const std::vector<Action>* legal_actions)
+                         int fields)
     : NFGState(game),
       coins_(coins),
       fields_(fields),
       joint_action_({}),
-      action_map_(action_map),
-      legal_actions_(legal_actions),
       returns_({}) {}
 
 void BlottoState::DoApplyActions(const std::vector<Action>& actions) {
@@ -80,7 +129,8 @@ void BlottoState::DoApplyActions(const std::vector<Action>& actions) {
     for (auto p = Player{0}; p < num_players_; ++p) {
       // Get the expanded action if necessary.
       if (p >= player_actions.size()) {
-        player_actions.push_back(action_map_->at(joint_action_[p]));
+        player_actions.push_back(
+            ActionToAllocation(joint_action_[p], coins_, fields_));
       }
 
       if (player_actions[p][f] > max_value) {
@@ -128,11 +178,15 @@ void BlottoState::DoApplyActions(const std::vector<Action>& actions) {
 
 std::vector<Action> BlottoState::LegalActions(Player player) const {
   if (IsTerminal()) return {};
-  return (*legal_actions_);
+  std::vector<Action> actions(num_distinct_actions_);
+  std::iota(actions.begin(), actions.end(), 0);
+  return actions;
 }
 
 std::string BlottoState::ActionToString(Player player, Action move_id) const {
-  return "[" + absl::StrJoin(action_map_->at(move_id), ",") + "]";
+  return absl::StrCat(
+      "[", absl::StrJoin(ActionToAllocation(move_id, coins_, fields_), ","),
+      "]");
 }
 
 std::string BlottoState::ToString() const {
@@ -155,41 +209,14 @@ std::unique_ptr<State> BlottoState::Clone() const {
 
 int BlottoGame::NumDistinctActions() const { return num_distinct_actions_; }
 
-void BlottoGame::CreateActionMapRec(int* count, int coins_left,
-                                    const std::vector<int>& action) {
-  if (action.size() == fields_) {
-    if (coins_left == 0) {
-      // All coins used, valid move.
-      (*action_map_)[*count] = action;
-      (*count)++;
-      return;
-    } else {
-      // Not all coins used, invalid move.
-      return;
-    }
-  } else {
-    for (int num_coins = 0; num_coins <= coins_left; ++num_coins) {
-      std::vector<int> new_action = action;
-      new_action.push_back(num_coins);
-      CreateActionMapRec(count, coins_left - num_coins, new_action);
-    }
-  }
-}
-
 BlottoGame::BlottoGame(const GameParameters& params)
     : NormalFormGame(kGameType, params),
-      num_distinct_actions_(0),  // Set properly after CreateActionMap.
       coins_(ParameterValue<int>("coins")),
       fields_(ParameterValue<int>("fields")),
       players_(ParameterValue<int>("players")) {
-  action_map_.reset(new ActionMap());
-  CreateActionMapRec(&num_distinct_actions_, coins_, {});
-
-  // The action set is static for all states, so create it only once.
-  legal_actions_.reset(new std::vector<Action>(num_distinct_actions_));
-  for (Action action = 0; action < num_distinct_actions_; ++action) {
-    (*legal_actions_)[action] = action;
-  }
+  const int64_t num_allocations = NumAllocations(coins_, fields_);
+  SPIEL_CHECK_LE(num_allocations, std::numeric_limits<int>::max());
+  num_distinct_actions_ = num_allocations;
 }
 
 }  // namespace blotto
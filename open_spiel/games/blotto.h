@@ -15,11 +15,12 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_BLOTTO_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BLOTTO_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/normal_form_game.h"
 
 // An implementation of the Blotto: https://en.wikipedia.org/wiki/Blotto_game
@@ -40,13 +41,21 @@
 namespace open_spiel {
 namespace blotto {
 
-using ActionMap = std::unordered_map<Action, std::vector<int>>;
+// The actions are the allocations of the coins to the fields, numbered in
+// lexicographic order, and are converted to and from allocations on the fly
+// rather than enumerated, so that the game takes constant memory.
+
+// The number of allocations of `coins` coins to `fields` fields, i.e.
+// (coins + fields - 1) choose (fields - 1).
+int64_t NumAllocations(int coins, int fields);
+
+// The number of coins on each field for an action, and its inverse.
+std::vector<int> ActionToAllocation(Action action, int coins, int fields);
+Action AllocationToAction(absl::Span<const int> allocation, int coins);
 
 class BlottoState : public NFGState {
  public:
-  BlottoState(std::shared_ptr<const Game> game, int coins, int fields,
-              const ActionMap* action_map,
-              const std::vector<Action>* legal_actions_);
+  BlottoState(std::shared_ptr<const Game> game, int coins, int fields);
 
   std::vector<Action> LegalActions(Player player) const override;
   std::string ActionToString(Player player, Action move_id) const override;
@@ -62,30 +71,17 @@ class BlottoState : public NFGState {
   int coins_;
   int fields_;
   std::vector<Action> joint_action_;  // The action taken by all the players.
-  const ActionMap* action_map_;
-  const std::vector<Action>* legal_actions_;
   std::vector<double> returns_;
 };
 
 class BlottoGame : public NormalFormGame {
  public:
   explicit BlottoGame(const GameParameters& params);
-  BlottoGame(const BlottoGame& other)
-      : NormalFormGame(other),
-        num_distinct_actions_(other.num_distinct_actions_),
-        coins_(other.coins_),
-        fields_(other.fields_),
-        players_(other.players_),
-        action_map_(
-            std::unique_ptr<ActionMap>(new ActionMap(*other.action_map_))),
-        legal_actions_(std::unique_ptr<std::vector<Action>>(
-            new std::vector<Action>(*other.legal_actions_))) {}
 
   int NumDistinctActions() const override;
   std::unique_ptr<State> NewInitialState() const override {
-    return std::unique_ptr<State>(new BlottoState(shared_from_this(), coins_,
-                                                  fields_, action_map_.get(),
-                                                  legal_actions_.get()));
+    return std::unique_ptr<State>(
+        new BlottoState(shared_from_this(), coins_, fields_));
   }
 
   int NumPlayers() const override { return players_; }
@@ -97,15 +93,10 @@ class BlottoGame : public NormalFormGame {
   }
 
  private:
-  void CreateActionMapRec(int* count, int coins_left,
-                          const std::vector<int>& action);
-
   int num_distinct_actions_;
   int coins_;
   int fields_;
   int players_;
-  std::unique_ptr<ActionMap> action_map_;
-  std::unique_ptr<std::vector<Action>> legal_actions_;
 };
 
 }  // namespace blotto
@@ -12,7 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/games/blotto.h"
+
+#include <memory>
+#include <vector>
+
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -21,6 +27,52 @@ namespace {
 
 namespace testing = open_spiel::testing;
 
+// The allocations in lexicographic order, as the actions are numbered.
+void EnumerateAllocations(int coins_left, int fields,
+                          std::vector<int>* allocation,
+                          std::vector<std::vector<int>>* allocations) {
+  if (allocation->size() == fields - 1) {
+    allocation->push_back(coins_left);
+    allocations->push_back(*allocation);
+    allocation->pop_back();
+    return;
+  }
+  for (int num_coins = 0; num_coins <= coins_left; ++num_coins) {
+    allocation->push_back(num_coins);
+    EnumerateAllocations(coins_left - num_coins, fields, allocation,
+                         allocations);
+    allocation->pop_back();
+  }
+}
+
+void AllocationRankingTests() {
+  for (int coins = 0; coins <= 6; ++coins) {
+    for (int fields = 1; fields <= 4; ++fields) {
+      std::vector<int> allocation;
+      std::vector<std::vector<int>> allocations;
+      EnumerateAllocations(coins, fields, &allocation, &allocations);
+      SPIEL_CHECK_EQ(NumAllocations(coins, fields), allocations.size());
+      for (Action action = 0; action < allocations.size(); ++action) {
+        SPIEL_CHECK_EQ(ActionToAllocation(action, coins, fields),
+                       allocations[action]);
+        SPIEL_CHECK_EQ(AllocationToAction(allocations[action], coins),
+                       action);
+      }
+    }
+  }
+
+  // Large games are created without enumerating their actions.
+  std::shared_ptr<const Game> game =
+      LoadGame("blotto", {{"coins", GameParameter(100)},
+                          {"fields", GameParameter(6)}});
+  SPIEL_CHECK_EQ(game->NumDistinctActions(), 96560646);
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(state->ActionToString(0, 0), "[0,0,0,0,0,100]");
+  SPIEL_CHECK_EQ(state->ActionToString(0, 96560645), "[100,0,0,0,0,0]");
+  const Action action = AllocationToAction({10, 20, 30, 0, 25, 15}, 100);
+  SPIEL_CHECK_EQ(state->ActionToString(0, action), "[10,20,30,0,25,15]");
+}
+
 void BasicBlottoTests() {
   testing::LoadGameTest("blotto");
   testing::NoChanceOutcomesTest(*LoadGame("blotto"));
@@ -35,4 +87,7 @@ void BasicBlottoTests() {
 }  // namespace blotto
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::blotto::BasicBlottoTests(); }
+int main(int argc, char** argv) {
+  open_spiel::blotto::AllocationRankingTests();
+  open_spiel::blotto::BasicBlottoTests();
+}
@@ -15,6 +15,7 @@
 #include "open_spiel/games/breakthrough.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -114,6 +115,34 @@ std::string ColLabel(int col) {
   return label;
 }
 
+// The parts of an action, which ranks (r1, c1, dir, capture) in the mixed
+// base (rows, cols, kNumDirections, 2).
+struct DecodedAction {
+  int r1;
+  int c1;
+  int dir;
+  bool capture;
+  int r2;
+  int c2;
+};
+
+DecodedAction DecodeAction(Action action, int cols) {
+  DecodedAction decoded;
+  decoded.capture = action % 2 == 1;
+  action /= 2;
+  decoded.dir = action % kNumDirections;
+  action /= kNumDirections;
+  decoded.c1 = action % cols;
+  decoded.r1 = action / cols;
+  decoded.r2 = decoded.r1 + kDirRowOffsets[decoded.dir];
+  decoded.c2 = decoded.c1 + kDirColOffsets[decoded.dir];
+  return decoded;
+}
+
+Action EncodeAction(int r, int c, int dir, bool capture, int cols) {
+  return ((r * cols + c) * kNumDirections + dir) * 2 + (capture ? 1 : 0);
+}
+
 }  // namespace
 
 BreakthroughState::BreakthroughState(std::shared_ptr<const Game> game, int rows,
@@ -122,7 +151,9 @@ BreakthroughState::BreakthroughState(std::shared_ptr<const Game> game, int rows,
   SPIEL_CHECK_GT(rows_, 1);
   SPIEL_CHECK_GT(cols_, 1);
 
-  board_ = std::vector<CellState>(rows_ * cols_, CellState::kEmpty);
+  SPIEL_CHECK_LE(cols_, kMaxColumns);
+
+  row_bits_ = std::vector<uint64_t>(kNumPlayers * rows_, 0);
   for (int r = 0; r < rows_; r++) {
     for (int c = 0; c < cols_; c++) {
       // Only use two rows if there are at least 6 rows.
@@ -141,6 +172,19 @@ BreakthroughState::BreakthroughState(std::shared_ptr<const Game> game, int rows,
   total_moves_ = 0;
 }
 
+void BreakthroughState::SetBoard(int r, int c, CellState cs) {
+  const uint64_t bit = uint64_t{1} << c;
+  row_bits_[r] &= ~bit;
+  row_bits_[rows_ + r] &= ~bit;
+  if (cs != CellState::kEmpty) row_bits_[StateToPlayer(cs) * rows_ + r] |= bit;
+}
+
+CellState BreakthroughState::board(int row, int col) const {
+  if ((RowBits(0, row) >> col) & 1) return CellState::kBlack;
+  if ((RowBits(1, row) >> col) & 1) return CellState::kWhite;
+  return CellState::kEmpty;
+}
+
 int BreakthroughState::CurrentPlayer() const {
   if (IsTerminal()) {
     return kTerminalPlayerId;
@@ -150,14 +194,7 @@ int BreakthroughState::CurrentPlayer() const {
 }
 
 void BreakthroughState::DoApplyAction(Action action) {
-  std::vector<int> values(4, -1);
-  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2}, &values);
-  int r1 = values[0];
-  int c1 = values[1];
-  int dir = values[2];
-  bool capture = values[3] == 1;
-  int r2 = r1 + kDirRowOffsets[dir];
-  int c2 = c1 + kDirColOffsets[dir];
+  const auto [r1, c1, dir, capture, r2, c2] = DecodeAction(action, cols_);
 
   SPIEL_CHECK_TRUE(InBounds(r1, c1));
   SPIEL_CHECK_TRUE(InBounds(r2, c2));
@@ -193,14 +230,7 @@ void BreakthroughState::DoApplyAction(Action action) {
 
 std::string BreakthroughState::ActionToString(Player player,
                                               Action action) const {
-  std::vector<int> values(4, -1);
-  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2}, &values);
-  int r1 = values[0];
-  int c1 = values[1];
-  int dir = values[2];
-  bool capture = values[3] == 1;
-  int r2 = r1 + kDirRowOffsets[dir];
-  int c2 = c1 + kDirColOffsets[dir];
+  const auto [r1, c1, dir, capture, r2, c2] = DecodeAction(action, cols_);
 
   std::string action_string = "";
   absl::StrAppend(&action_string, ColLabel(c1));
@@ -216,43 +246,45 @@ std::string BreakthroughState::ActionToString(Player player,
 
 std::vector<Action> BreakthroughState::LegalActions() const {
   std::vector<Action> movelist;
-  if (IsTerminal()) return movelist;
+  LegalActions(&movelist);
+  return movelist;
+}
+
+void BreakthroughState::LegalActions(std::vector<Action>* movelist) const {
+  movelist->clear();
+  if (IsTerminal()) return;
   const Player player = CurrentPlayer();
-  CellState mystate = PlayerToState(player);
-  std::vector<int> action_bases = {rows_, cols_, kNumDirections, 2};
-  std::vector<int> action_values = {0, 0, 0, 0};
+  const int row_offset = kDirRowOffsets[player * kNumDirections / 2];
+  const uint64_t all_columns =
+      cols_ == kMaxColumns ? ~uint64_t{0} : (uint64_t{1} << cols_) - 1;
 
+  // The moves of the pieces of each row, to the next one, in the order of
+  // their actions: by column, then direction.
   for (int r = 0; r < rows_; r++) {
-    for (int c = 0; c < cols_; c++) {
-      if (board(r, c) == mystate) {
-        for (int o = 0; o < kNumDirections / 2; o++) {
-          int dir = player * kNumDirections / 2 + o;
-          int rp = r + kDirRowOffsets[dir];
-          int cp = c + kDirColOffsets[dir];
-
-          if (InBounds(rp, cp)) {
-            action_values[0] = r;
-            action_values[1] = c;
-            action_values[2] = dir;
-            if (board(rp, cp) == CellState::kEmpty) {
-              // Regular move.
-              action_values[3] = 0;
-              movelist.push_back(
-                  RankActionMixedBase(action_bases, action_values));
-            } else if ((o == 0 || o == 2) &&
-                       board(rp, cp) == OpponentState(mystate)) {
-              // Capture move (can only capture diagonally)
-              action_values[3] = 1;
-              movelist.push_back(
-                  RankActionMixedBase(action_bases, action_values));
-            }
+    const int rp = r + row_offset;
+    const uint64_t mine = RowBits(player, r);
+    if (mine == 0 || rp < 0 || rp >= rows_) continue;
+    const uint64_t theirs = RowBits(1 - player, rp);
+    const uint64_t empty = all_columns & ~(RowBits(player, rp) | theirs);
+    // [o][capture], the pieces that can move in direction o, to column c - 1,
+    // c and c + 1, and capture diagonally.
+    const uint64_t moves[3][2] = {{mine & (empty << 1), mine & (theirs << 1)},
+                                  {mine & empty, 0},
+                                  {mine & (empty >> 1), mine & (theirs >> 1)}};
+    uint64_t movable = 0;
+    for (const auto& dir_moves : moves) movable |= dir_moves[0] | dir_moves[1];
+    for (; movable != 0; movable &= movable - 1) {
+      const int c = __builtin_ctzll(movable);
+      for (int o = 0; o < kNumDirections / 2; o++) {
+        const int dir = player * kNumDirections / 2 + o;
+        for (int capture = 0; capture < 2; capture++) {
+          if ((moves[o][capture] >> c) & 1) {
+            movelist->push_back(EncodeAction(r, c, dir, capture, cols_));
           }
         }
       }
     }
   }
-
-  return movelist;
 }
 
 bool BreakthroughState::InBounds(int r, int c) const {
@@ -308,13 +340,17 @@ bool BreakthroughState::IsTerminal() const {
 }
 
 std::vector<double> BreakthroughState::Returns() const {
-  if (winner_ == 0 || pieces_[1] == 0) {
-    return {1.0, -1.0};
-  } else if (winner_ == 1 || pieces_[0] == 0) {
-    return {-1.0, 1.0};
-  } else {
-    return {0.0, 0.0};
-  }
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void BreakthroughState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  const bool won0 = winner_ == 0 || pieces_[1] == 0;
+  const bool won1 = !won0 && (winner_ == 1 || pieces_[0] == 0);
+  returns[0] = won0 ? 1.0 : won1 ? -1.0 : 0.0;
+  returns[1] = won1 ? 1.0 : won0 ? -1.0 : 0.0;
 }
 
 std::string BreakthroughState::ObservationString(Player player) const {
@@ -323,13 +359,9 @@ std::string BreakthroughState::ObservationString(Player player) const {
   return ToString();
 }
 
-void BreakthroughState::ObservationTensor(Player player,
-                                          std::vector<double>* values) const {
-  SPIEL_CHECK_GE(player, 0);
-  SPIEL_CHECK_LT(player, num_players_);
-
-  TensorView<3> view(values, {kCellStates, rows_, cols_}, true);
-
+template <class T>
+void BreakthroughState::WriteObservationTensor(Player player,
+                                               TensorView<3, T>& view) const {
   for (int r = 0; r < rows_; r++) {
     for (int c = 0; c < cols_; c++) {
       int plane = observation_plane(r, c);
@@ -339,15 +371,26 @@ void BreakthroughState::ObservationTensor(Player player,
   }
 }
 
+void BreakthroughState::ObservationTensor(Player player,
+                                          std::vector<double>* values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<3> view(values, {kCellStates, rows_, cols_}, true);
+  WriteObservationTensor(player, view);
+}
+
+void BreakthroughState::ObservationTensor(Player player,
+                                          absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<3, float> view(values, {kCellStates, rows_, cols_}, true);
+  WriteObservationTensor(player, view);
+}
+
 void BreakthroughState::UndoAction(Player player, Action action) {
-  std::vector<int> values(4, -1);
-  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2}, &values);
-  int r1 = values[0];
-  int c1 = values[1];
-  int dir = values[2];
-  bool capture = values[3] == 1;
-  int r2 = r1 + kDirRowOffsets[dir];
-  int c2 = c1 + kDirColOffsets[dir];
+  const auto [r1, c1, dir, capture, r2, c2] = DecodeAction(action, cols_);
 
   cur_player_ = PreviousPlayerRoundRobin(cur_player_, 2);
   total_moves_--;
@@ -377,10 +420,34 @@ std::unique_ptr<State> BreakthroughState::Clone() const {
   return std::unique_ptr<State>(new BreakthroughState(*this));
 }
 
+bool BreakthroughState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const BreakthroughState&>(other);
+  return true;
+}
+
+uint64_t BreakthroughState::Hash() const {
+  // The winner and piece counts follow from the board, but the player to move
+  // does not.
+  uint64_t hash = 0;
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    const int cell_state = static_cast<int>(PlayerToState(player));
+    for (int r = 0; r < rows_; r++) {
+      for (uint64_t bits = RowBits(player, r); bits != 0; bits &= bits - 1) {
+        const int cell = r * cols_ + __builtin_ctzll(bits);
+        hash ^= HashMix(cell * 3 + cell_state);
+      }
+    }
+  }
+  return HashMix(hash ^ cur_player_);
+}
+
 BreakthroughGame::BreakthroughGame(const GameParameters& params)
     : Game(kGameType, params),
       rows_(ParameterValue<int>("rows")),
-      cols_(ParameterValue<int>("columns")) {}
+      cols_(ParameterValue<int>("columns")) {
+  SPIEL_CHECK_LE(cols_, kMaxColumns);
+}
 
 int BreakthroughGame::NumDistinctActions() const {
   return rows_ * cols_ * kNumDirections * 2;
@@ -16,12 +16,15 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BREAKTHROUGH_H_
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // Breakthrough, a game used in the general game-play competition
 // http://en.wikipedia.org/wiki/Breakthrough_%28board_game%29
@@ -29,6 +32,9 @@
 // Parameters:
 //       "columns"    int     number of columns on the board   (default = 8)
 //       "rows"       int     number of rows on the board      (default = 8)
+//
+// The board is held as a bitboard per row and player, so there can be up to
+// 64 columns, and moves are generated a row at a time by shifting them.
 
 namespace open_spiel {
 namespace breakthrough {
@@ -40,6 +46,7 @@ inline constexpr int kCellStates =
     1 + kNumPlayers;  // player 0, player 1, empty.
 inline constexpr int kDefaultRows = 8;
 inline constexpr int kDefaultColumns = 8;
+inline constexpr int kMaxColumns = 64;
 
 // State of a cell.
 enum class CellState {
@@ -57,28 +64,44 @@ class BreakthroughState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  uint64_t Hash() const override;
   void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
 
   bool InBounds(int r, int c) const;
-  void SetBoard(int r, int c, CellState cs) { board_[r * cols_ + c] = cs; }
+  void SetBoard(int r, int c, CellState cs);
   void SetPieces(int idx, int value) { pieces_[idx] = value; }
-  CellState board(int row, int col) const { return board_[row * cols_ + col]; }
+  CellState board(int row, int col) const;
   int pieces(int idx) const { return pieces_[idx]; }
   int rows() const { return rows_; }
   int cols() const { return cols_; }
   std::vector<Action> LegalActions() const override;
+  void LegalActions(std::vector<Action>* actions) const override;
   std::string Serialize() const override;
 
  protected:
   void DoApplyAction(Action action) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<3, T>& view) const;
   int observation_plane(int r, int c) const;
 
+  // The columns of the pieces of `player` in `row`, as bits.
+  uint64_t RowBits(Player player, int row) const {
+    return row_bits_[player * rows_ + row];
+  }
+
   // Fields sets to bad/invalid values. Use Game::NewInitialState().
   Player cur_player_ = kInvalidPlayer;
   int winner_ = kInvalidPlayer;
@@ -86,7 +109,9 @@ class BreakthroughState : public State {
   std::array<int, 2> pieces_;
   int rows_ = -1;
   int cols_ = -1;
-  std::vector<CellState> board_;  // for (row,col) we use row*cols_ + col.
+  // [player * rows_ + row], the bitboard of the player's pieces in the row,
+  // with bit c set for a piece in column c.
+  std::vector<uint64_t> row_bits_;
 };
 
 class BreakthroughGame : public Game {
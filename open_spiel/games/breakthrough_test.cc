@@ -14,6 +14,11 @@
 
 #include "open_spiel/games/breakthrough.h"
 
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -36,6 +41,63 @@ void BasicBreakthroughTests() {
   testing::RandomSimTest(*LoadGame("breakthrough"), 100);
 }
 
+// The legal actions of `state` found by scanning its cells.
+std::vector<Action> ScannedLegalActions(const BreakthroughState& state) {
+  std::vector<Action> actions;
+  const Player player = state.CurrentPlayer();
+  const CellState mine = player == 0 ? CellState::kBlack : CellState::kWhite;
+  const CellState theirs = player == 0 ? CellState::kWhite : CellState::kBlack;
+  const int dr = player == 0 ? 1 : -1;
+  for (int r = 0; r < state.rows(); r++) {
+    for (int c = 0; c < state.cols(); c++) {
+      if (state.board(r, c) != mine) continue;
+      for (int o = 0; o < 3; o++) {
+        const int rp = r + dr;
+        const int cp = c + o - 1;
+        if (!state.InBounds(rp, cp)) continue;
+        const bool capture = o != 1 && state.board(rp, cp) == theirs;
+        if (state.board(rp, cp) == CellState::kEmpty || capture) {
+          actions.push_back(
+              RankActionMixedBase({state.rows(), state.cols(), 6, 2},
+                                  {r, c, 3 * player + o, capture ? 1 : 0}));
+        }
+      }
+    }
+  }
+  return actions;
+}
+
+// The moves generated from the bitboards are those of the cells, including
+// on boards as wide as they can be, and undoing them restores the state.
+void BitboardMoveGenerationTest() {
+  std::mt19937 rng(0);
+  const std::vector<std::string> games = {"breakthrough",
+                                         "breakthrough(rows=6,columns=13)",
+                                         "breakthrough(rows=5,columns=64)"};
+  for (const std::string& params : games) {
+    std::shared_ptr<const Game> game = LoadGame(params);
+    for (int i = 0; i < 20; ++i) {
+      std::unique_ptr<State> state = game->NewInitialState();
+      while (!state->IsTerminal()) {
+        const auto& bstate = static_cast<const BreakthroughState&>(*state);
+        std::vector<Action> actions = state->LegalActions();
+        SPIEL_CHECK_TRUE(actions == ScannedLegalActions(bstate));
+        const Action action = actions[std::uniform_int_distribution<int>(
+            0, actions.size() - 1)(rng)];
+        const std::string before = state->ToString();
+        const uint64_t hash = state->Hash();
+        const Player player = state->CurrentPlayer();
+        state->ApplyAction(action);
+        std::unique_ptr<State> child = state->Clone();
+        state->UndoAction(player, action);
+        SPIEL_CHECK_EQ(state->ToString(), before);
+        SPIEL_CHECK_EQ(state->Hash(), hash);
+        state = std::move(child);
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace breakthrough
 }  // namespace open_spiel
@@ -43,4 +105,5 @@ void BasicBreakthroughTests() {
 int main(int argc, char** argv) {
   open_spiel::breakthrough::BasicSerializationTest();
   open_spiel::breakthrough::BasicBreakthroughTests();
+  open_spiel::breakthrough::BitboardMoveGenerationTest();
 }
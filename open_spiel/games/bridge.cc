@@ -14,24 +14,25 @@
 
 #include "open_spiel/games/bridge.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/inlined_vector.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
-
-// Our preferred version of the double_dummy_solver defines a DDS_EXTERNAL
-// macro to add a prefix to the exported symbols to avoid name clashes.
-// In order to compile with versions of the double_dummy_solver which do not
-// do this, we define DDS_EXTERNAL as an identity if it isn't already defined.
-#ifndef DDS_EXTERNAL
-#define DDS_EXTERNAL(x) x
-#endif
+#include "open_spiel/utils/card_deal.h"
 
 namespace open_spiel {
 namespace bridge {
@@ -61,6 +62,18 @@ const GameType kGameType{/*short_name=*/"bridge",
                              {"dealer_vul", GameParameter(false)},
                              // If true, the non-dealer's side is vulnerable.
                              {"non_dealer_vul", GameParameter(false)},
+                             // If true, the double dummy results are cached
+                             // by deal, in BridgeGame::DoubleDummyResults.
+                             {"cache_double_dummy_results",
+                              GameParameter(false)},
+                             // If set, the path of a DealDataset to deal the
+                             // states from, with their double dummy results.
+                             {"deal_dataset", GameParameter(std::string(""))},
+                             // If true, the deals are drawn at random from
+                             // the dataset, rather than in its order.
+                             {"random_deal_order", GameParameter(false)},
+                             // The seed of the random deal order.
+                             {"rng_seed", GameParameter(0)},
                          }};
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
@@ -97,6 +110,15 @@ constexpr char kSuitChar[] = "CDHS";
 constexpr std::array<absl::string_view, kNumPlayers> kRelativePlayer{
     "Us", "LH", "Pd", "RH"};
 
+// The cards of a suit, i.e. every kNumSuits-th card from the suit.
+constexpr uint64_t SuitMask(Suit suit) {
+  uint64_t mask = 0;
+  for (int rank = 0; rank < kNumCardsPerSuit; ++rank) {
+    mask |= uint64_t{1} << (rank * kNumSuits + static_cast<int>(suit));
+  }
+  return mask;
+}
+
 std::string CardString(int card) {
   return {kSuitChar[static_cast<int>(CardSuit(card))],
           kRankChar[CardRank(card)]};
@@ -117,7 +139,37 @@ int Partnership(Player player) { return player & 1; }
 }  // namespace
 
 BridgeGame::BridgeGame(const GameParameters& params)
-    : Game(kGameType, params) {}
+    : Game(kGameType, params) {
+  if (ParameterValue<bool>("cache_double_dummy_results", false)) {
+    double_dummy_results_ = std::make_shared<DoubleDummyCache>();
+  }
+  const std::string deal_dataset = ParameterValue<std::string>("deal_dataset");
+  if (!deal_dataset.empty()) {
+    deal_dataset_ = std::make_shared<const DealDataset>(
+        deal_dataset,
+        ParameterValue<bool>("random_deal_order")
+            ? DealDataset::Order::kRandom
+            : DealDataset::Order::kSequential,
+        ParameterValue<int>("rng_seed"));
+  }
+}
+
+std::unique_ptr<State> BridgeGame::NewInitialState() const {
+  if (deal_dataset_) return NewInitialStateForDeal(deal_dataset_->NextIndex());
+  return std::unique_ptr<State>(
+      new BridgeState(shared_from_this(), UseDoubleDummyResult(),
+                      IsDealerVulnerable(), IsNonDealerVulnerable()));
+}
+
+std::unique_ptr<State> BridgeGame::NewInitialStateForDeal(
+    int64_t index) const {
+  SPIEL_CHECK_TRUE(deal_dataset_ != nullptr);
+  auto state = std::make_unique<BridgeState>(
+      shared_from_this(), UseDoubleDummyResult(), IsDealerVulnerable(),
+      IsNonDealerVulnerable());
+  state->SetDeal(deal_dataset_->Deal(index), deal_dataset_->Results(index));
+  return state;
+}
 
 BridgeState::BridgeState(std::shared_ptr<const Game> game,
                          bool use_double_dummy_result,
@@ -459,14 +511,123 @@ void BridgeState::ComputeDoubleDummyTricks() {
       dd_table_deal.cards[player][suit] += 1 << (2 + rank);
     }
   }
-  DDS_EXTERNAL(SetMaxThreads)(0);
-  const int return_code =
-      DDS_EXTERNAL(CalcDDtable)(dd_table_deal, &double_dummy_results_);
-  if (return_code != RETURN_NO_FAULT) {
-    char error_message[80];
-    DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
-    SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
+  DoubleDummyCache* cache =
+      static_cast<const BridgeGame&>(*game_).DoubleDummyResults();
+  double_dummy_results_ =
+      cache ? cache->Solve(dd_table_deal) : SolveDeal(dd_table_deal);
+}
+
+deal BridgeState::DoubleDummyPosition() const {
+  SPIEL_CHECK_TRUE(phase_ == Phase::kPlay);
+  deal position{};
+  position.trump = contract_.trumps;
+  const int num_cards_in_trick = num_cards_played_ % kNumPlayers;
+  position.first =
+      num_cards_in_trick == 0 ? current_player_ : CurrentTrick().Leader();
+  for (int i = 0; i < num_cards_in_trick; ++i) {
+    const int card = history_[history_.size() - num_cards_in_trick + i];
+    position.currentTrickSuit[i] = static_cast<int>(CardSuit(card));
+    position.currentTrickRank[i] = 2 + CardRank(card);
+  }
+  // The suits are numbered as in ComputeDoubleDummyTricks, the solver being
+  // indifferent to their order.
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    for (uint64_t cards = hands_[player]; cards != 0; cards &= cards - 1) {
+      const int card = __builtin_ctzll(cards);
+      position.remainCards[player][static_cast<int>(CardSuit(card))] |=
+          1 << (2 + CardRank(card));
+    }
+  }
+  return position;
+}
+
+std::vector<double> BridgeState::DoubleDummyCardValues(
+    const futureTricks& solution) const {
+  const bool declarer_to_play =
+      Partnership(current_player_) == Partnership(contract_.declarer);
+  const int tricks_left = kNumTricks - num_cards_played_ / kNumPlayers;
+  const bool is_vulnerable = is_vulnerable_[Partnership(contract_.declarer)];
+  std::vector<double> values;
+  for (Action card : PlayLegalActions()) {
+    const int suit = static_cast<int>(CardSuit(card));
+    const int rank = 2 + CardRank(card);
+    // Each solution stands for a card and the lower ones it equals.
+    auto stands_for_card = [&](int i) {
+      return solution.suit[i] == suit &&
+             (solution.rank[i] == rank || ((solution.equals[i] >> rank) & 1));
+    };
+    int i = 0;
+    while (i < solution.cards && !stands_for_card(i)) ++i;
+    SPIEL_CHECK_LT(i, solution.cards);
+    const int declarer_tricks =
+        num_declarer_tricks_ +
+        (declarer_to_play ? solution.score[i]
+                          : tricks_left - solution.score[i]);
+    const int declarer_score = Score(contract_, declarer_tricks, is_vulnerable);
+    values.push_back(declarer_to_play ? declarer_score : -declarer_score);
+  }
+  return values;
+}
+
+std::unique_ptr<State> BridgeState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  SPIEL_CHECK_FALSE(IsTerminal());
+  // The hands of the other players, but for the dummy once it is shown, are
+  // dealt again, keeping from each the suits they did not follow.
+  const Player dummy = contract_.declarer ^ 2;
+  std::array<uint64_t, kNumPlayers> played{};
+  std::array<uint64_t, kNumPlayers> excluded{};
+  const int play_start = history_.size() - num_cards_played_;
+  for (int i = 0; i < num_cards_played_; ++i) {
+    const Trick& trick = tricks_[i / kNumPlayers];
+    const Player player = (trick.Leader() + i % kNumPlayers) % kNumPlayers;
+    const int card = history_[play_start + i];
+    played[player] |= uint64_t{1} << card;
+    if (CardSuit(card) != trick.LedSuit()) {
+      excluded[player] |= SuitMask(trick.LedSuit());
+    }
+  }
+  uint64_t hidden_cards = 0;
+  absl::InlinedVector<Player, kNumPlayers> hidden_players;
+  absl::InlinedVector<int, kNumPlayers> sizes;
+  absl::InlinedVector<uint64_t, kNumPlayers> exclusions;
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    if (player == player_id || (num_cards_played_ > 0 && player == dummy)) {
+      continue;
+    }
+    hidden_cards |= hands_[player];
+    hidden_players.push_back(player);
+    sizes.push_back(__builtin_popcountll(hands_[player]));
+    exclusions.push_back(excluded[player]);
+  }
+  const absl::InlinedVector<uint64_t, 4> dealt =
+      DealCards(hidden_cards, sizes, exclusions, rng);
+
+  auto state = std::make_unique<BridgeState>(*this);
+  // The deal gives the cards to the players in turn (see ApplyDealAction).
+  std::array<uint64_t, kNumPlayers> deal{};
+  std::array<bool, kNumPlayers> changed{};
+  for (int i = 0; i < hidden_players.size(); ++i) {
+    const Player player = hidden_players[i];
+    state->hands_[player] = dealt[i];
+    for (uint64_t cards = dealt[i]; cards != 0; cards &= cards - 1) {
+      state->holder_[__builtin_ctzll(cards)] = player;
+    }
+    deal[player] = dealt[i] | played[player];
+    changed[player] = true;
+  }
+  const int num_dealt = std::min<int>(history_.size(), kNumCards);
+  for (int i = 0; i < num_dealt; ++i) {
+    const Player player = i % kNumPlayers;
+    if (!changed[player]) continue;
+    SPIEL_CHECK_NE(deal[player], 0);
+    state->history_[i] = __builtin_ctzll(deal[player]);
+    deal[player] &= deal[player] - 1;
   }
+  if (use_double_dummy_result_ && num_dealt == kNumCards) {
+    state->ComputeDoubleDummyTricks();
+  }
+  return state;
 }
 
 std::vector<Action> BridgeState::LegalActions() const {
@@ -483,6 +644,7 @@ std::vector<Action> BridgeState::LegalActions() const {
 }
 
 std::vector<Action> BridgeState::DealLegalActions() const {
+  if (DealingGivenDeal()) return {given_deal_[history_.size()]};
   std::vector<Action> legal_actions;
   legal_actions.reserve(kNumCards - history_.size());
   for (int i = 0; i < kNumCards; ++i) {
@@ -513,28 +675,24 @@ std::vector<Action> BridgeState::BiddingLegalActions() const {
 }
 
 std::vector<Action> BridgeState::PlayLegalActions() const {
-  std::vector<Action> legal_actions;
-  legal_actions.reserve(kNumCardsPerHand - num_cards_played_ / kNumPlayers);
-
-  // Check if we can follow suit.
+  uint64_t cards = hands_[current_player_];
+  // Follow suit if we can, otherwise we can play any of our cards.
   if (num_cards_played_ % kNumPlayers != 0) {
-    auto suit = CurrentTrick().LedSuit();
-    for (int rank = 0; rank < kNumCardsPerSuit; ++rank) {
-      if (holder_[Card(suit, rank)] == current_player_) {
-        legal_actions.push_back(Card(suit, rank));
-      }
-    }
+    const uint64_t following_cards =
+        cards & SuitMask(CurrentTrick().LedSuit());
+    if (following_cards != 0) cards = following_cards;
   }
-  if (!legal_actions.empty()) return legal_actions;
 
-  // Otherwise, we can play any of our cards.
-  for (int card = 0; card < kNumCards; ++card) {
-    if (holder_[card] == current_player_) legal_actions.push_back(card);
+  std::vector<Action> legal_actions;
+  legal_actions.reserve(__builtin_popcountll(cards));
+  for (; cards != 0; cards &= cards - 1) {
+    legal_actions.push_back(__builtin_ctzll(cards));
   }
   return legal_actions;
 }
 
 std::vector<std::pair<Action, double>> BridgeState::ChanceOutcomes() const {
+  if (DealingGivenDeal()) return {{given_deal_[history_.size()], 1.0}};
   std::vector<std::pair<Action, double>> outcomes;
   int num_cards_remaining = kNumCards - history_.size();
   outcomes.reserve(num_cards_remaining);
@@ -558,10 +716,44 @@ void BridgeState::DoApplyAction(Action action) {
   }
 }
 
+void BridgeState::SetDeal(const ddTableDeal& deal,
+                          const ddTableResults& results) {
+  SPIEL_CHECK_TRUE(history_.empty());
+  std::array<std::vector<Action>, kNumPlayers> hands;
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    for (int suit = 0; suit < kNumSuits; ++suit) {
+      for (int rank = 0; rank < kNumCardsPerSuit; ++rank) {
+        if (deal.cards[player][suit] & (1 << (2 + rank))) {
+          hands[player].push_back(Card(Suit(suit), rank));
+        }
+      }
+    }
+    SPIEL_CHECK_EQ(hands[player].size(), kNumCardsPerHand);
+  }
+  // The deal gives the cards to the players in turn.
+  given_deal_.resize(kNumCards);
+  for (int i = 0; i < kNumCards; ++i) {
+    given_deal_[i] = hands[i % kNumPlayers][i / kNumPlayers];
+  }
+  given_double_dummy_results_ = results;
+}
+
+bool BridgeState::DealingGivenDeal() const {
+  return !given_deal_.empty() && history_.size() < kNumCards &&
+         std::equal(history_.begin(), history_.end(), given_deal_.begin());
+}
+
 void BridgeState::ApplyDealAction(int card) {
   holder_[card] = (history_.size() % kNumPlayers);
+  hands_[*holder_[card]] |= uint64_t{1} << card;
   if (history_.size() == kNumCards - 1) {
-    if (use_double_dummy_result_) ComputeDoubleDummyTricks();
+    if (use_double_dummy_result_) {
+      if (DealingGivenDeal() && card == given_deal_.back()) {
+        double_dummy_results_ = given_double_dummy_results_;
+      } else {
+        ComputeDoubleDummyTricks();
+      }
+    }
     phase_ = Phase::kAuction;
     current_player_ = kFirstPlayer;
   }
@@ -617,6 +809,7 @@ void BridgeState::ApplyBiddingAction(int call) {
 void BridgeState::ApplyPlayAction(int card) {
   SPIEL_CHECK_TRUE(holder_[card] == current_player_);
   holder_[card] = std::nullopt;
+  hands_[current_player_] &= ~(uint64_t{1} << card);
   if (num_cards_played_ % kNumPlayers == 0) {
     CurrentTrick() = Trick(current_player_, contract_.trumps, card);
   } else {
@@ -637,9 +830,75 @@ void BridgeState::ApplyPlayAction(int card) {
   }
 }
 
+void BridgeState::UndoAction(Player player, Action action) {
+  if (phase_ == Phase::kDeal ||
+      (phase_ == Phase::kAuction && history_.size() == kNumCards)) {
+    UndoDealAction(action);
+  } else if (num_cards_played_ == 0) {
+    UndoBiddingAction();
+  } else {
+    UndoPlayAction(action);
+  }
+  history_.pop_back();
+}
+
+void BridgeState::UndoDealAction(int card) {
+  hands_[*holder_[card]] &= ~(uint64_t{1} << card);
+  holder_[card] = std::nullopt;
+  if (phase_ == Phase::kAuction) {
+    phase_ = Phase::kDeal;
+    current_player_ = 0;
+    double_dummy_results_ = {};
+  }
+}
+
+void BridgeState::UndoBiddingAction() {
+  num_passes_ = 0;
+  num_declarer_tricks_ = 0;
+  current_player_ = kFirstPlayer;
+  phase_ = Phase::kAuction;
+  contract_ = {0, kNoTrump, kUndoubled, kInvalidPlayer};
+  first_bidder_ = {};
+  std::fill(returns_.begin(), returns_.end(), 0);
+  for (int i = kNumCards; i < history_.size() - 1; ++i) {
+    ApplyBiddingAction(history_[i] - kBiddingActionBase);
+  }
+}
+
+void BridgeState::UndoPlayAction(int card) {
+  const int trick = (num_cards_played_ - 1) / kNumPlayers;
+  const int position = (num_cards_played_ - 1) % kNumPlayers;
+  const Player leader = tricks_[trick].Leader();
+  const Player player = (leader + position) % kNumPlayers;
+  if (phase_ == Phase::kGameOver) {
+    phase_ = Phase::kPlay;
+    std::fill(returns_.begin(), returns_.end(), 0);
+  }
+  if (position == kNumPlayers - 1 &&
+      Partnership(tricks_[trick].Winner()) == Partnership(contract_.declarer)) {
+    --num_declarer_tricks_;
+  }
+  --num_cards_played_;
+  holder_[card] = player;
+  hands_[player] |= uint64_t{1} << card;
+  current_player_ = player;
+  if (position == 0) {
+    tricks_[trick] = Trick();
+  } else {
+    // Play the trick again without the card.
+    const int first = history_.size() - 1 - position;
+    tricks_[trick] = Trick(leader, contract_.trumps, history_[first]);
+    for (int i = 1; i < position; ++i) {
+      tricks_[trick].Play((leader + i) % kNumPlayers, history_[first + i]);
+    }
+  }
+}
+
 Player BridgeState::CurrentPlayer() const {
   if (phase_ == Phase::kDeal) {
     return kChancePlayerId;
+  } else if (phase_ == Phase::kGameOver) {
+    return kTerminalPlayerId;
   } else if (phase_ == Phase::kPlay &&
              Partnership(current_player_) == Partnership(contract_.declarer)) {
     // Declarer chooses cards for both players.
@@ -659,6 +918,27 @@ void BridgeState::ScoreUp() {
   }
 }
 
+std::function<std::vector<std::vector<double>>(absl::Span<const State* const>)>
+DoubleDummyPlaySolver(int num_threads) {
+  return [num_threads](absl::Span<const State* const> states) {
+    std::vector<deal> positions;
+    positions.reserve(states.size());
+    for (const State* state : states) {
+      positions.push_back(
+          static_cast<const BridgeState*>(state)->DoubleDummyPosition());
+    }
+    const std::vector<futureTricks> solutions =
+        SolvePlays(positions, num_threads);
+    std::vector<std::vector<double>> values;
+    values.reserve(states.size());
+    for (int i = 0; i < states.size(); ++i) {
+      values.push_back(static_cast<const BridgeState*>(states[i])
+                           ->DoubleDummyCardValues(solutions[i]));
+    }
+    return values;
+  };
+}
+
 Trick::Trick(Player leader, Denomination trumps, int card)
     : trumps_(trumps),
       led_suit_(CardSuit(card)),
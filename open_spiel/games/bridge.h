@@ -35,6 +35,11 @@
 // We support an option to replace the play phase with a perfect-information
 // solution (the 'double dummy result' in bridge jargon).
 //
+// The deals can also come from a DealDataset of pre-dealt hands with their
+// double dummy results (the 'deal_dataset' parameter). Each initial state
+// then has the chance nodes deal the cards of its deal from the dataset, one
+// outcome each, and the solver is not run.
+//
 // The action space is as follows:
 //   0..51   Cards, used for both dealing (chance events) and play;
 //   52+     Calls (Pass, Dbl, RDbl, and bids), used during the auction phase.
@@ -43,10 +48,17 @@
 // partner). There will thus be 26 turns for declarer, and 13 turns for each
 // of the defenders during the play.
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
@@ -139,8 +151,31 @@ class BridgeState : public State {
   std::unique_ptr<State> Clone() const override {
     return std::unique_ptr<State>(new BridgeState(*this));
   }
+  void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<Action> LegalActions() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
+
+  // Makes the deal chance nodes deal the cards of `deal`, whose double dummy
+  // results are given so that the solver is not run. The state must not have
+  // been dealt to yet. If other cards are dealt anyway, e.g. when replaying a
+  // history, their results are computed as usual.
+  void SetDeal(const ddTableDeal& deal, const ddTableResults& results);
+
+  // The cards remaining in the hand of a player, with bit `card` set for each
+  // card.
+  uint64_t Hand(Player player) const { return hands_[player]; }
+
+  // The position of the play for the double dummy solver: the cards left in
+  // each hand and those played to the current trick.
+  deal DoubleDummyPosition() const;
+  // The value to the current player of each of their legal cards, i.e. the
+  // final score if both sides then play double dummy, given the solver's
+  // results for DoubleDummyPosition().
+  std::vector<double> DoubleDummyCardValues(
+      const futureTricks& solution) const;
 
  protected:
   void DoApplyAction(Action action) override;
@@ -152,8 +187,15 @@ class BridgeState : public State {
   std::vector<Action> BiddingLegalActions() const;
   std::vector<Action> PlayLegalActions() const;
   void ApplyDealAction(int card);
+  // Whether the cards dealt so far are those of the given deal, if any.
+  bool DealingGivenDeal() const;
   void ApplyBiddingAction(int call);
   void ApplyPlayAction(int card);
+  // These leave history_ to UndoAction. The auction is replayed from the
+  // history, the play only within the current trick.
+  void UndoDealAction(int card);
+  void UndoBiddingAction();
+  void UndoPlayAction(int card);
   void ComputeDoubleDummyTricks();
   void ScoreUp();
   Trick& CurrentTrick() { return tricks_[num_cards_played_ / kNumPlayers]; }
@@ -176,7 +218,13 @@ class BridgeState : public State {
   std::array<Trick, kNumTricks> tricks_{};
   std::vector<double> returns_ = std::vector<double>(kNumPlayers);
   std::array<std::optional<Player>, kNumCards> holder_{};
+  // The cards held by each player, kept in sync with holder_.
+  std::array<uint64_t, kNumPlayers> hands_{};
   ddTableResults double_dummy_results_{};
+  // The cards of the deal given by SetDeal, in the order they are dealt, and
+  // its results. Empty if there is none.
+  std::vector<Action> given_deal_;
+  ddTableResults given_double_dummy_results_{};
 };
 
 class BridgeGame : public Game {
@@ -185,11 +233,10 @@ class BridgeGame : public Game {
   int NumDistinctActions() const override {
     return kBiddingActionBase + kNumCalls;
   }
-  std::unique_ptr<State> NewInitialState() const override {
-    return std::unique_ptr<State>(
-        new BridgeState(shared_from_this(), UseDoubleDummyResult(),
-                        IsDealerVulnerable(), IsNonDealerVulnerable()));
-  }
+  // With a deal dataset, the states deal its deals, see NextIndex.
+  std::unique_ptr<State> NewInitialState() const override;
+  // The initial state dealing the deal of the given index of the dataset.
+  std::unique_ptr<State> NewInitialStateForDeal(int64_t index) const;
   int NumPlayers() const override { return kNumPlayers; }
   double MinUtility() const override { return -kMaxScore; }
   double MaxUtility() const override { return kMaxScore; }
@@ -204,6 +251,18 @@ class BridgeGame : public Game {
                                   : kMaxAuctionLength + kNumCards;
   }
 
+  // The cache of the double dummy results of the deals, shared by the states
+  // and clones of the game, or null unless cache_double_dummy_results is set.
+  // It can be filled in batches ahead of play, or saved and loaded with the
+  // results of previous runs.
+  DoubleDummyCache* DoubleDummyResults() const {
+    return double_dummy_results_.get();
+  }
+
+  // The deal dataset loaded from the deal_dataset parameter, shared by the
+  // clones of the game, or null if it is not set.
+  const DealDataset* Deals() const { return deal_dataset_.get(); }
+
  private:
   bool UseDoubleDummyResult() const {
     return ParameterValue<bool>("use_double_dummy_result", true);
@@ -214,8 +273,18 @@ class BridgeGame : public Game {
   bool IsNonDealerVulnerable() const {
     return ParameterValue<bool>("non_dealer_vul", false);
   }
+
+  std::shared_ptr<DoubleDummyCache> double_dummy_results_;
+  std::shared_ptr<const DealDataset> deal_dataset_;
 };
 
+// Solves the play of a batch of bridge states, e.g. the worlds sampled by
+// algorithms::PIMCBot, all at once with SolvePlays. Returns the
+// DoubleDummyCardValues of each state, which must be in the play phase and
+// not use_double_dummy_result.
+std::function<std::vector<std::vector<double>>(absl::Span<const State* const>)>
+DoubleDummyPlaySolver(int num_threads = 0);
+
 }  // namespace bridge
 }  // namespace open_spiel
 
@@ -0,0 +1,308 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/bridge/double_dummy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+// For compatibility with versions of the double dummy solver code which
+// don't amend exported names.
+#ifndef DDS_EXTERNAL
+#define DDS_EXTERNAL(x) x
+#endif
+
+namespace open_spiel {
+namespace bridge {
+namespace {
+
+constexpr int kNumCardsPerSuit = 13;
+constexpr char kCacheMagic[] = "DDCACHE1";
+
+void CheckReturnCode(int return_code) {
+  if (return_code != RETURN_NO_FAULT) {
+    char error_message[80];
+    DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
+    SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
+  }
+}
+
+// The solver's thread settings are global, so deals and batches are solved
+// one at a time.
+absl::Mutex* BatchMutex() {
+  static auto* mutex = new absl::Mutex();
+  return mutex;
+}
+
+}  // namespace
+
+ddTableResults SolveDeal(const ddTableDeal& deal) {
+  ddTableResults results;
+  absl::MutexLock lock(BatchMutex());
+  DDS_EXTERNAL(SetMaxThreads)(0);
+  CheckReturnCode(DDS_EXTERNAL(CalcDDtable)(deal, &results));
+  return results;
+}
+
+std::vector<ddTableResults> SolveDeals(absl::Span<const ddTableDeal> deals,
+                                       int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 0);
+  // Each deal takes a board per denomination.
+  constexpr int kMaxBatchSize = MAXNOOFBOARDS / DDS_STRAINS;
+  std::vector<ddTableResults> results(deals.size());
+  int trump_filter[DDS_STRAINS] = {0, 0, 0, 0, 0};
+  auto batch = std::make_unique<ddTableDeals>();
+  auto batch_results = std::make_unique<ddTablesRes>();
+  auto par_results = std::make_unique<allParResults>();
+
+  absl::MutexLock lock(BatchMutex());
+  DDS_EXTERNAL(SetMaxThreads)(num_threads);
+  for (int start = 0; start < deals.size(); start += kMaxBatchSize) {
+    const int batch_size =
+        std::min<int>(kMaxBatchSize, deals.size() - start);
+    batch->noOfTables = batch_size;
+    std::copy(deals.begin() + start, deals.begin() + start + batch_size,
+              batch->deals);
+    // A mode of -1 skips the par calculation.
+    CheckReturnCode(DDS_EXTERNAL(CalcAllTables)(
+        batch.get(), /*mode=*/-1, trump_filter, batch_results.get(),
+        par_results.get()));
+    std::copy(batch_results->results, batch_results->results + batch_size,
+              results.begin() + start);
+  }
+  return results;
+}
+
+std::vector<futureTricks> SolvePlays(absl::Span<const deal> positions,
+                                     int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 0);
+  std::vector<futureTricks> results(positions.size());
+  auto batch = std::make_unique<boards>();
+  auto batch_results = std::make_unique<solvedBoards>();
+  // Finds the tricks of every card, searching even when there is only one.
+  std::fill(batch->target, batch->target + MAXNOOFBOARDS, -1);
+  std::fill(batch->solutions, batch->solutions + MAXNOOFBOARDS, 3);
+  std::fill(batch->mode, batch->mode + MAXNOOFBOARDS, 1);
+
+  absl::MutexLock lock(BatchMutex());
+  DDS_EXTERNAL(SetMaxThreads)(num_threads);
+  for (int start = 0; start < positions.size(); start += MAXNOOFBOARDS) {
+    const int batch_size =
+        std::min<int>(MAXNOOFBOARDS, positions.size() - start);
+    batch->noOfBoards = batch_size;
+    std::copy(positions.begin() + start,
+              positions.begin() + start + batch_size, batch->deals);
+    CheckReturnCode(
+        DDS_EXTERNAL(SolveAllBoardsBin)(batch.get(), batch_results.get()));
+    std::copy(batch_results->solvedBoard,
+              batch_results->solvedBoard + batch_size,
+              results.begin() + start);
+  }
+  return results;
+}
+
+DoubleDummyCache::Key DoubleDummyCache::DealKey(const ddTableDeal& deal) {
+  Key key{0, 0};
+  for (uint64_t hand = 0; hand < DDS_HANDS; ++hand) {
+    for (int suit = 0; suit < DDS_SUITS; ++suit) {
+      for (int rank = 0; rank < kNumCardsPerSuit; ++rank) {
+        if (deal.cards[hand][suit] & (1 << (2 + rank))) {
+          const int card = suit * kNumCardsPerSuit + rank;
+          key[card / 32] |= hand << (2 * (card % 32));
+        }
+      }
+    }
+  }
+  return key;
+}
+
+DoubleDummyCache::Tricks DoubleDummyCache::ResultsTricks(
+    const ddTableResults& results) {
+  Tricks tricks;
+  for (int strain = 0; strain < DDS_STRAINS; ++strain) {
+    for (int hand = 0; hand < DDS_HANDS; ++hand) {
+      tricks[strain * DDS_HANDS + hand] = results.resTable[strain][hand];
+    }
+  }
+  return tricks;
+}
+
+ddTableDeal DoubleDummyCache::KeyDeal(const Key& key) {
+  ddTableDeal deal{};
+  for (int card = 0; card < DDS_SUITS * kNumCardsPerSuit; ++card) {
+    const int hand = (key[card / 32] >> (2 * (card % 32))) & 3;
+    deal.cards[hand][card / kNumCardsPerSuit] |=
+        1 << (2 + card % kNumCardsPerSuit);
+  }
+  return deal;
+}
+
+ddTableResults DoubleDummyCache::TricksResults(const Tricks& tricks) {
+  ddTableResults results;
+  for (int strain = 0; strain < DDS_STRAINS; ++strain) {
+    for (int hand = 0; hand < DDS_HANDS; ++hand) {
+      results.resTable[strain][hand] = tricks[strain * DDS_HANDS + hand];
+    }
+  }
+  return results;
+}
+
+ddTableResults DoubleDummyCache::Solve(const ddTableDeal& deal) {
+  if (std::optional<ddTableResults> results = Find(deal)) return *results;
+  const ddTableResults results = SolveDeal(deal);
+  Insert(deal, results);
+  return results;
+}
+
+std::vector<ddTableResults> DoubleDummyCache::Solve(
+    absl::Span<const ddTableDeal> deals, int num_threads) {
+  std::vector<ddTableResults> results(deals.size());
+  std::vector<ddTableDeal> unsolved_deals;
+  std::vector<int> unsolved_indices;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (int i = 0; i < deals.size(); ++i) {
+      const auto it = results_.find(DealKey(deals[i]));
+      if (it == results_.end()) {
+        unsolved_deals.push_back(deals[i]);
+        unsolved_indices.push_back(i);
+      } else {
+        results[i] = TricksResults(it->second);
+      }
+    }
+  }
+  if (unsolved_deals.empty()) return results;
+
+  // The lock is not held while solving, so that other threads can still use
+  // the cache.
+  const std::vector<ddTableResults> solved =
+      SolveDeals(unsolved_deals, num_threads);
+  absl::MutexLock lock(&mutex_);
+  for (int i = 0; i < solved.size(); ++i) {
+    results[unsolved_indices[i]] = solved[i];
+    results_[DealKey(unsolved_deals[i])] = ResultsTricks(solved[i]);
+  }
+  return results;
+}
+
+std::optional<ddTableResults> DoubleDummyCache::Find(
+    const ddTableDeal& deal) const {
+  const Key key = DealKey(deal);
+  absl::MutexLock lock(&mutex_);
+  const auto it = results_.find(key);
+  if (it == results_.end()) return std::nullopt;
+  return TricksResults(it->second);
+}
+
+void DoubleDummyCache::Insert(const ddTableDeal& deal,
+                              const ddTableResults& results) {
+  const Key key = DealKey(deal);
+  absl::MutexLock lock(&mutex_);
+  results_[key] = ResultsTricks(results);
+}
+
+int DoubleDummyCache::Size() const {
+  absl::MutexLock lock(&mutex_);
+  return results_.size();
+}
+
+void DoubleDummyCache::Save(const std::string& path) const {
+  std::string contents(kCacheMagic, sizeof(kCacheMagic));
+  {
+    absl::MutexLock lock(&mutex_);
+    contents.reserve(contents.size() +
+                     results_.size() * (sizeof(Key) + sizeof(Tricks)));
+    for (const auto& [key, tricks] : results_) {
+      contents.append(reinterpret_cast<const char*>(key.data()), sizeof(key));
+      contents.append(reinterpret_cast<const char*>(tricks.data()),
+                      sizeof(tricks));
+    }
+  }
+  file::File file(path, "wb");
+  SPIEL_CHECK_TRUE(file.Write(contents));
+}
+
+void DoubleDummyCache::Load(const std::string& path) {
+  const std::string contents = file::File(path, "rb").ReadContents();
+  constexpr int kEntrySize = sizeof(Key) + sizeof(Tricks);
+  if (contents.size() < sizeof(kCacheMagic) ||
+      std::memcmp(contents.data(), kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+      (contents.size() - sizeof(kCacheMagic)) % kEntrySize != 0) {
+    SpielFatalError(absl::StrCat(path, " is not a double dummy cache."));
+  }
+  absl::MutexLock lock(&mutex_);
+  for (int i = sizeof(kCacheMagic); i < contents.size(); i += kEntrySize) {
+    Key key;
+    Tricks tricks;
+    std::memcpy(key.data(), contents.data() + i, sizeof(key));
+    std::memcpy(tricks.data(), contents.data() + i + sizeof(key),
+                sizeof(tricks));
+    results_[key] = tricks;
+  }
+}
+
+DealDataset::DealDataset(const std::string& path, Order order, uint64_t seed)
+    : file_(path), order_(order), seed_(seed) {
+  const absl::string_view contents = file_.Contents();
+  if (contents.size() < sizeof(kCacheMagic) ||
+      std::memcmp(contents.data(), kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+      (contents.size() - sizeof(kCacheMagic)) % kRecordSize != 0) {
+    SpielFatalError(absl::StrCat(path, " is not a deal dataset."));
+  }
+  size_ = (contents.size() - sizeof(kCacheMagic)) / kRecordSize;
+  if (size_ == 0) SpielFatalError(absl::StrCat(path, " has no deals."));
+}
+
+const char* DealDataset::Record(int64_t index) const {
+  SPIEL_CHECK_GE(index, 0);
+  SPIEL_CHECK_LT(index, size_);
+  return file_.Contents().data() + sizeof(kCacheMagic) + index * kRecordSize;
+}
+
+ddTableDeal DealDataset::Deal(int64_t index) const {
+  DoubleDummyCache::Key key;
+  std::memcpy(key.data(), Record(index), sizeof(key));
+  return DoubleDummyCache::KeyDeal(key);
+}
+
+ddTableResults DealDataset::Results(int64_t index) const {
+  DoubleDummyCache::Tricks tricks;
+  std::memcpy(tricks.data(), Record(index) + sizeof(DoubleDummyCache::Key),
+              sizeof(tricks));
+  return DoubleDummyCache::TricksResults(tricks);
+}
+
+int64_t DealDataset::NextIndex() const {
+  const uint64_t n = num_drawn_.fetch_add(1, std::memory_order_relaxed);
+  if (order_ == Order::kSequential) return n % size_;
+  // The splitmix64 hash of the draw number, so that draws need no lock.
+  uint64_t x = seed_ + (n + 1) * 0x9e3779b97f4a7c15;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  x ^= x >> 31;
+  return x % size_;
+}
+
+}  // namespace bridge
+}  // namespace open_spiel
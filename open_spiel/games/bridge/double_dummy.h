@@ -0,0 +1,135 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_DOUBLE_DUMMY_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_DOUBLE_DUMMY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
+#include "open_spiel/utils/file.h"
+
+// Double dummy analysis of bridge deals through the double_dummy_solver: the
+// tricks that the declarer in each seat takes in each denomination when all
+// four hands are known, or that the side to play takes from a position of the
+// play with each of its cards.
+
+namespace open_spiel {
+namespace bridge {
+
+// Returns the double dummy results of a deal, solved alone.
+ddTableResults SolveDeal(const ddTableDeal& deal);
+
+// Returns the double dummy results of the deals, solved in batches through
+// the solver's multi-deal API, which spreads the deals of a batch over
+// num_threads threads, or as many as the solver deems useful if 0. This is
+// much faster than solving the deals one by one when there are many.
+std::vector<ddTableResults> SolveDeals(absl::Span<const ddTableDeal> deals,
+                                       int num_threads = 0);
+
+// Returns the tricks that the side to play takes from each of the positions
+// with each of the cards it may play, solved in batches as SolveDeals does.
+// Cards whose results would be the same are grouped by the solver, see the
+// `equals` field of futureTricks.
+std::vector<futureTricks> SolvePlays(absl::Span<const deal> positions,
+                                     int num_threads = 0);
+
+// A thread-safe cache of double dummy results keyed by the deal, which can be
+// saved and loaded, so that repeated or pre-generated deals are only solved
+// once.
+class DoubleDummyCache {
+ public:
+  // Returns the results of a deal, solving it if it is not in the cache.
+  ddTableResults Solve(const ddTableDeal& deal);
+  // Returns the results of the deals, solving those that are not in the
+  // cache with SolveDeals.
+  std::vector<ddTableResults> Solve(absl::Span<const ddTableDeal> deals,
+                                    int num_threads = 0);
+
+  // Returns the cached results of a deal, if any.
+  std::optional<ddTableResults> Find(const ddTableDeal& deal) const;
+  void Insert(const ddTableDeal& deal, const ddTableResults& results);
+  int Size() const;
+
+  // Writes the cache to a file, or adds the results in a file to it.
+  void Save(const std::string& path) const;
+  void Load(const std::string& path);
+
+ private:
+  // The seat of each card, in 2 bits.
+  using Key = std::array<uint64_t, 2>;
+  // The tricks of each denomination and declarer, as in resTable.
+  using Tricks = std::array<uint8_t, DDS_STRAINS * DDS_HANDS>;
+
+  static Key DealKey(const ddTableDeal& deal);
+  static ddTableDeal KeyDeal(const Key& key);
+  static Tricks ResultsTricks(const ddTableResults& results);
+  static ddTableResults TricksResults(const Tricks& tricks);
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<Key, Tricks> results_ ABSL_GUARDED_BY(mutex_);
+
+  friend class DealDataset;
+};
+
+// A read-only dataset of deals with their double dummy results, e.g. for
+// training bidding agents without running the solver. The file has the format
+// of DoubleDummyCache::Save, so a dataset is made by solving deals with
+// DoubleDummyCache::Solve and saving the cache. It is memory mapped, and each
+// deal is decoded from its fixed-size record when it is used.
+//
+// The deals are handed out in a stream, see NextIndex, which is thread-safe
+// so that the states of a game can be created concurrently.
+class DealDataset {
+ public:
+  enum class Order {
+    kSequential,  // The deals in the file order, starting over at the end.
+    kRandom,      // Deals drawn uniformly, with replacement, from the seed.
+  };
+
+  explicit DealDataset(const std::string& path,
+                       Order order = Order::kSequential, uint64_t seed = 0);
+
+  int64_t Size() const { return size_; }
+  ddTableDeal Deal(int64_t index) const;
+  ddTableResults Results(int64_t index) const;
+
+  // Returns the index of the next deal of the stream.
+  int64_t NextIndex() const;
+
+ private:
+  static constexpr int kRecordSize =
+      sizeof(DoubleDummyCache::Key) + sizeof(DoubleDummyCache::Tricks);
+
+  const char* Record(int64_t index) const;
+
+  file::MappedFile file_;
+  int64_t size_;
+  const Order order_;
+  const uint64_t seed_;
+  mutable std::atomic<uint64_t> num_drawn_{0};
+};
+
+}  // namespace bridge
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_DOUBLE_DUMMY_H_
@@ -12,7 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/games/bridge.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/games/bridge_uncontested_bidding.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -33,6 +42,10 @@ void BasicGameTests() {
   testing::LoadGameTest("bridge_uncontested_bidding");
   testing::NoChanceOutcomesTest(*LoadGame("bridge_uncontested_bidding"));
   testing::RandomSimTest(*LoadGame("bridge_uncontested_bidding"), 3);
+  testing::RandomSimTestWithUndo(
+      *LoadGame("bridge(use_double_dummy_result=false)"), 3);
+  testing::ResampleInfostateTest(
+      *LoadGame("bridge(use_double_dummy_result=false)"), /*num_sims=*/3);
 }
 
 void DeserializeStateTest() {
@@ -41,6 +54,174 @@ void DeserializeStateTest() {
   SPIEL_CHECK_EQ(state->ToString(), "AKQJ.543.QJ8.T92 97532.A2.9.QJ853 ");
 }
 
+// Returns a deal of the cards in order, shifted by `offset` seats.
+ddTableDeal OrderedDeal(int offset) {
+  ddTableDeal deal{};
+  for (int card = 0; card < kNumCards; ++card) {
+    const int suit = card % kNumSuits;
+    const int rank = card / kNumSuits;
+    deal.cards[(card + offset) % kNumPlayers][suit] += 1 << (2 + rank);
+  }
+  return deal;
+}
+
+void DoubleDummyCacheTest() {
+  std::vector<ddTableDeal> deals = {OrderedDeal(0), OrderedDeal(1),
+                                    OrderedDeal(0)};
+  const std::vector<ddTableResults> solved = SolveDeals(deals);
+  SPIEL_CHECK_EQ(solved.size(), deals.size());
+
+  DoubleDummyCache cache;
+  SPIEL_CHECK_FALSE(cache.Find(deals[0]).has_value());
+  const std::vector<ddTableResults> cached = cache.Solve(deals);
+  SPIEL_CHECK_EQ(cache.Size(), 2);
+  for (int i = 0; i < deals.size(); ++i) {
+    const ddTableResults single = SolveDeal(deals[i]);
+    for (int strain = 0; strain < DDS_STRAINS; ++strain) {
+      for (int hand = 0; hand < DDS_HANDS; ++hand) {
+        SPIEL_CHECK_EQ(solved[i].resTable[strain][hand],
+                       single.resTable[strain][hand]);
+        SPIEL_CHECK_EQ(cached[i].resTable[strain][hand],
+                       single.resTable[strain][hand]);
+      }
+    }
+  }
+
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string path =
+      absl::StrCat(tmp_dir ? tmp_dir : "/tmp", "/double_dummy_cache_test");
+  cache.Save(path);
+  DoubleDummyCache loaded;
+  loaded.Load(path);
+  SPIEL_CHECK_EQ(loaded.Size(), 2);
+  SPIEL_CHECK_EQ(loaded.Find(deals[1])->resTable[kNoTrump][0],
+                 cached[1].resTable[kNoTrump][0]);
+}
+
+void DealDatasetTest() {
+  const std::vector<ddTableDeal> deals = {OrderedDeal(0), OrderedDeal(1),
+                                          OrderedDeal(2)};
+  DoubleDummyCache cache;
+  cache.Solve(deals);
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string path =
+      absl::StrCat(tmp_dir ? tmp_dir : "/tmp", "/deal_dataset_test");
+  cache.Save(path);
+
+  DealDataset dataset(path);
+  SPIEL_CHECK_EQ(dataset.Size(), 3);
+  for (int i = 0; i < dataset.Size(); ++i) {
+    const std::optional<ddTableResults> cached =
+        cache.Find(dataset.Deal(i));
+    SPIEL_CHECK_TRUE(cached.has_value());
+    const ddTableResults results = dataset.Results(i);
+    for (int strain = 0; strain < DDS_STRAINS; ++strain) {
+      for (int hand = 0; hand < DDS_HANDS; ++hand) {
+        SPIEL_CHECK_EQ(results.resTable[strain][hand],
+                       cached->resTable[strain][hand]);
+      }
+    }
+  }
+  for (int i = 0; i < 5; ++i) SPIEL_CHECK_EQ(dataset.NextIndex(), i % 3);
+  DealDataset random_dataset(path, DealDataset::Order::kRandom, /*seed=*/7);
+  for (int i = 0; i < 5; ++i) {
+    const int64_t index = random_dataset.NextIndex();
+    SPIEL_CHECK_GE(index, 0);
+    SPIEL_CHECK_LT(index, 3);
+  }
+
+  // The states are dealt from the dataset and scored with its results: here
+  // North declares 1NT.
+  std::shared_ptr<const Game> game =
+      LoadGame("bridge", {{"deal_dataset", GameParameter(path)}});
+  testing::RandomSimTest(*game, 3);
+  std::unique_ptr<State> state =
+      static_cast<const BridgeGame&>(*game).NewInitialStateForDeal(1);
+  while (state->IsChanceNode()) {
+    SPIEL_CHECK_EQ(state->ChanceOutcomes().size(), 1);
+    state->ApplyAction(state->ChanceOutcomes()[0].first);
+  }
+  const ddTableDeal deal = dataset.Deal(1);
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    const uint64_t hand = static_cast<const BridgeState&>(*state).Hand(player);
+    for (int card = 0; card < kNumCards; ++card) {
+      const bool held =
+          deal.cards[player][card % kNumSuits] & (1 << (2 + card / kNumSuits));
+      SPIEL_CHECK_EQ(((hand >> card) & 1) == 1, held);
+    }
+  }
+  for (const char* call : {"1N", "Pass", "Pass", "Pass"}) {
+    for (Action action : state->LegalActions()) {
+      if (state->ActionToString(state->CurrentPlayer(), action) == call) {
+        state->ApplyAction(action);
+        break;
+      }
+    }
+  }
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_EQ(state->Returns()[0],
+                 Score({1, kNoTrump, kUndoubled},
+                       dataset.Results(1).resTable[kNoTrump][0], false));
+
+  // The uncontested bidding players are seats 0 and 2 of the deals: here
+  // the second one declares 1NT.
+  game = LoadGame("bridge_uncontested_bidding",
+                  {{"deal_dataset", GameParameter(path)}});
+  state = game->NewInitialState();
+  state->ApplyAction(0);
+  for (const char* call : {"Pass", "1N", "Pass"}) {
+    for (Action action : state->LegalActions()) {
+      if (state->ActionToString(state->CurrentPlayer(), action) == call) {
+        state->ApplyAction(action);
+        break;
+      }
+    }
+  }
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_EQ(state->Returns()[0],
+                 Score({1, kNoTrump, kUndoubled},
+                       dataset.Results(0).resTable[kNoTrump][2], false));
+}
+
+void CachedDoubleDummyResultsTest() {
+  std::shared_ptr<const Game> game =
+      LoadGame("bridge(cache_double_dummy_results=true)");
+  testing::RandomSimTest(*game, 3);
+  const auto& bridge_game = static_cast<const BridgeGame&>(*game);
+  SPIEL_CHECK_TRUE(bridge_game.DoubleDummyResults() != nullptr);
+  SPIEL_CHECK_GE(bridge_game.DoubleDummyResults()->Size(), 1);
+  SPIEL_CHECK_TRUE(static_cast<const BridgeGame&>(*LoadGame("bridge"))
+                       .DoubleDummyResults() == nullptr);
+}
+
+void DoubleDummyPlaySolverTest() {
+  std::shared_ptr<const Game> game =
+      LoadGame("bridge(use_double_dummy_result=false)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  // Each player gets a whole suit, then North declares 1NT. East leads and
+  // takes every trick with their diamonds.
+  for (Action card = 0; card < kNumCards; ++card) state->ApplyAction(card);
+  for (const char* call : {"1N", "Pass", "Pass", "Pass"}) {
+    for (Action action : state->LegalActions()) {
+      if (state->ActionToString(state->CurrentPlayer(), action) == call) {
+        state->ApplyAction(action);
+        break;
+      }
+    }
+  }
+  SPIEL_CHECK_EQ(state->CurrentPlayer(), 1);
+  const std::vector<const State*> states = {state.get(), state.get()};
+  const std::vector<std::vector<double>> values =
+      DoubleDummyPlaySolver()(states);
+  SPIEL_CHECK_EQ(values.size(), 2);
+  for (const std::vector<double>& card_values : values) {
+    SPIEL_CHECK_EQ(card_values.size(), state->LegalActions().size());
+    for (double value : card_values) {
+      SPIEL_CHECK_EQ(value, -Score({1, kNoTrump, kUndoubled}, 0, false));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace bridge
 }  // namespace open_spiel
@@ -49,4 +230,8 @@ int main(int argc, char** argv) {
   open_spiel::bridge::DeserializeStateTest();
   open_spiel::bridge::ScoringTests();
   open_spiel::bridge::BasicGameTests();
+  open_spiel::bridge::DoubleDummyCacheTest();
+  open_spiel::bridge::DealDatasetTest();
+  open_spiel::bridge::CachedDoubleDummyResultsTest();
+  open_spiel::bridge::DoubleDummyPlaySolverTest();
 }
@@ -14,21 +14,19 @@
 
 #include "open_spiel/games/bridge_uncontested_bidding.h"
 
+#include <array>
 #include <cstring>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
-// For compatibility with versions of the double dummy solver code which
-// don't amend exported names.
-#ifndef DDS_EXTERNAL
-#define DDS_EXTERNAL(x) x
-#endif
-
 namespace open_spiel {
 namespace bridge_uncontested_bidding {
 namespace {
@@ -62,6 +60,11 @@ const GameType kGameType{
         {"subgame", GameParameter(static_cast<std::string>(""))},
         {"rng_seed", GameParameter(0)},
         {"relative_scoring", GameParameter(false)},
+        // If set, the path of a bridge::DealDataset to take the deals from.
+        {"deal_dataset", GameParameter(static_cast<std::string>(""))},
+        // If true, the deals are drawn at random from the dataset, from
+        // rng_seed, rather than in its order.
+        {"random_deal_order", GameParameter(false)},
     }};
 
 std::shared_ptr<const Game> Factory(const GameParameters& params) {
@@ -245,6 +248,44 @@ void UncontestedBiddingState::ScoreDeal() {
     }
   }
 
+  // Analyze the deal from the dataset, or several layouts of the opponents'
+  // hands together.
+  std::vector<ddTableResults> deal_results;
+  if (double_dummy_results_.has_value()) {
+    deal_results.push_back(*double_dummy_results_);
+  } else {
+    deal_results = open_spiel::bridge::SolveDeals(Redeals());
+  }
+
+  // Initialize scores to zero
+  score_ = 0;
+  reference_scores_.resize(reference_contracts_.size());
+  std::fill(reference_scores_.begin(), reference_scores_.end(), 0);
+
+  for (const ddTableResults& results : deal_results) {
+    // Compute the score and update the total.
+    if (!passed_out) {
+      const int declarer_tricks =
+          results.resTable[contract.trumps][2 * contract.declarer];
+      const int declarer_score =
+          Score(contract, declarer_tricks, /*is_vulnerable=*/false);
+      score_ += static_cast<double>(declarer_score) / deal_results.size();
+    }
+
+    // Compute the scores for reference contracts.
+    for (int i = 0; i < reference_contracts_.size(); ++i) {
+      const int declarer_tricks =
+          results.resTable[reference_contracts_[i].trumps]
+                          [2 * reference_contracts_[i].declarer];
+      const int declarer_score = Score(reference_contracts_[i], declarer_tricks,
+                                       /*is_vulnerable=*/false);
+      reference_scores_[i] +=
+          static_cast<double>(declarer_score) / deal_results.size();
+    }
+  }
+}
+
+std::vector<ddTableDeal> UncontestedBiddingState::Redeals() const {
   // Populate East-West cards
   ddTableDeal dd_table_deal{};
   for (Player player = 0; player < kNumPlayers; ++player) {
@@ -255,12 +296,9 @@ void UncontestedBiddingState::ScoreDeal() {
     }
   }
 
-  // Initialize scores to zero
-  score_ = 0;
-  reference_scores_.resize(reference_contracts_.size());
-  std::fill(reference_scores_.begin(), reference_scores_.end(), 0);
-
   // For each redeal
+  std::vector<ddTableDeal> redeals;
+  redeals.reserve(kNumRedeals);
   for (int ideal = 0; ideal < kNumRedeals; ++ideal) {
     if (ideal > 0) deal_.Shuffle(&rng_, kNumCardsPerHand * 2, kNumCards);
 
@@ -274,44 +312,39 @@ void UncontestedBiddingState::ScoreDeal() {
             1 << (2 + deal_.Rank(i));
       }
     }
+    redeals.push_back(dd_table_deal);
+  }
 
-    // Analyze the deal.
-    DDS_EXTERNAL(SetMaxThreads)(0);
-    struct ddTableResults results;
-    const int return_code = DDS_EXTERNAL(CalcDDtable)(dd_table_deal, &results);
-
-    // Check for errors.
-    if (return_code != RETURN_NO_FAULT) {
-      char error_message[80];
-      DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
-      SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
-    }
-
-    // Compute the score and update the total.
-    if (!passed_out) {
-      const int declarer_tricks =
-          results.resTable[contract.trumps][2 * contract.declarer];
-      const int declarer_score =
-          Score(contract, declarer_tricks, /*is_vulnerable=*/false);
-      score_ += static_cast<double>(declarer_score) / kNumRedeals;
-    }
+  return redeals;
+}
 
-    // Compute the scores for reference contracts.
-    for (int i = 0; i < reference_contracts_.size(); ++i) {
-      const int declarer_tricks =
-          results.resTable[reference_contracts_[i].trumps]
-                          [2 * reference_contracts_[i].declarer];
-      const int declarer_score = Score(reference_contracts_[i], declarer_tricks,
-                                       /*is_vulnerable=*/false);
-      reference_scores_[i] += static_cast<double>(declarer_score) / kNumRedeals;
+void UncontestedBiddingState::DealFromDataset(const ddTableDeal& deal) {
+  std::array<int, kNumCards> cards;
+  int i = 0;
+  for (int hand : {0, 2, 1, 3}) {
+    for (int suit = 0; suit < kNumSuits; ++suit) {
+      for (int rank = 0; rank < kNumCardsPerSuit; ++rank) {
+        if (deal.cards[hand][suit] & (1 << (2 + rank))) {
+          SPIEL_CHECK_LT(i, kNumCards);
+          cards[i++] = rank * kNumSuits + suit;
+        }
+      }
     }
+    SPIEL_CHECK_EQ(i % kNumCardsPerHand, 0);
   }
+  SPIEL_CHECK_EQ(i, kNumCards);
+  deal_ = Deal(cards);
 }
 
 void UncontestedBiddingState::DoApplyAction(Action action_id) {
   if (dealt_) {
     actions_.push_back(action_id);
     if (IsTerminal()) ScoreDeal();
+  } else if (deal_dataset_ != nullptr) {
+    const int64_t index = deal_dataset_->NextIndex();
+    DealFromDataset(deal_dataset_->Deal(index));
+    double_dummy_results_ = deal_dataset_->Results(index);
+    dealt_ = true;
   } else {
     do {
       deal_.Shuffle(&rng_);
@@ -330,6 +363,15 @@ UncontestedBiddingGame::UncontestedBiddingGame(const GameParameters& params)
       forced_actions_{},
       deal_filter_{NoFilter},
       rng_seed_(ParameterValue<int>("rng_seed")) {
+  const std::string deal_dataset = ParameterValue<std::string>("deal_dataset");
+  if (!deal_dataset.empty()) {
+    deal_dataset_ = std::make_shared<const bridge::DealDataset>(
+        deal_dataset,
+        ParameterValue<bool>("random_deal_order")
+            ? bridge::DealDataset::Order::kRandom
+            : bridge::DealDataset::Order::kSequential,
+        rng_seed_);
+  }
   std::string subgame = ParameterValue<std::string>("subgame");
   if (subgame == "2NT") {
     deal_filter_ = Is2NTDeal;
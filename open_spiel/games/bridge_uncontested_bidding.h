@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BRIDGE_UNCONTESTED_BIDDING_H_
 
 #include <array>
+#include <optional>
 
 // Uncontested bridge bidding. A two-player purely cooperative game.
 //
@@ -91,8 +92,16 @@
 // for player 1 will be the score relative to the best-scoring of the possible
 // contracts (so 0 if the contract reached is the best-scoring contract,
 // otherwise negative).
+//
+// If the parameter `deal_dataset` is set, the deals are taken from that
+// bridge::DealDataset, in order or at random (`random_deal_order`), and
+// scored with its double dummy results rather than by solving redeals of the
+// opponents' hands. The two players hold the hands of seats 0 and 2 of the
+// dataset's deals, which are used as they are: the subgame's deal filter is
+// not applied, so the dataset should only hold suitable deals.
 
 #include "open_spiel/games/bridge/bridge_scoring.h"
+#include "open_spiel/games/bridge/double_dummy.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
@@ -143,11 +152,13 @@ class UncontestedBiddingState : public State {
   UncontestedBiddingState(std::shared_ptr<const Game> game,
                           std::vector<Contract> reference_contracts,
                           std::function<bool(const Deal&)> deal_filter,
-                          std::vector<Action> actions, int rng_seed)
+                          std::vector<Action> actions, int rng_seed,
+                          const bridge::DealDataset* deal_dataset = nullptr)
       : State(game),
         reference_contracts_(std::move(reference_contracts)),
         actions_(std::move(actions)),
         deal_filter_(deal_filter),
+        deal_dataset_(deal_dataset),
         rng_(rng_seed),
         dealt_(false) {}
   UncontestedBiddingState(std::shared_ptr<const Game> game,
@@ -181,6 +192,10 @@ class UncontestedBiddingState : public State {
  protected:
   void DoApplyAction(Action action_id) override;
   void ScoreDeal();
+  // The deal with kNumRedeals layouts of the opponents' hands.
+  std::vector<ddTableDeal> Redeals() const;
+  // Sets deal_ from a deal of the dataset, whose seats 0 and 2 are ours.
+  void DealFromDataset(const ddTableDeal& deal);
 
  private:
   // If non-empty, the score for player 1 will be relative to the best-scoring
@@ -193,6 +208,9 @@ class UncontestedBiddingState : public State {
   // filtering is required, or it may check that the opening bidder has a
   // balanced hand with 20-21 HCP (a 2NT opener - see above).
   std::function<bool(const Deal&)> deal_filter_;
+  // If not null, the deals are taken from it instead, with their results.
+  const bridge::DealDataset* deal_dataset_ = nullptr;
+  std::optional<ddTableResults> double_dummy_results_;
   mutable std::mt19937 rng_;
   mutable Deal deal_;
   bool dealt_;
@@ -207,7 +225,7 @@ class UncontestedBiddingGame : public Game {
   std::unique_ptr<State> NewInitialState() const override {
     return std::unique_ptr<State>(new UncontestedBiddingState(
         shared_from_this(), reference_contracts_, deal_filter_, forced_actions_,
-        ++rng_seed_));
+        ++rng_seed_, deal_dataset_.get()));
   }
   int NumPlayers() const override { return kNumPlayers; }
   double MinUtility() const override {
@@ -231,6 +249,7 @@ class UncontestedBiddingGame : public Game {
   std::vector<Action> forced_actions_;
   std::function<bool(const Deal&)> deal_filter_;
   mutable int rng_seed_;
+  std::shared_ptr<const bridge::DealDataset> deal_dataset_;
 };
 
 }  // namespace bridge_uncontested_bidding
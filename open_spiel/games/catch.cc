@@ -15,6 +15,7 @@
 #include "open_spiel/games/catch.h"
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "open_spiel/game_parameters.h"
@@ -63,6 +64,14 @@ std::string StateToString(CellState state) {
   }
 }
 
+const CatchGame& AsCatchGame(const Game& game) {
+  const auto* catch_game = dynamic_cast<const CatchGame*>(&game);
+  if (catch_game == nullptr) {
+    SpielFatalError("CatchVectorEnv requires a catch game.");
+  }
+  return *catch_game;
+}
+
 }  // namespace
 
 CatchState::CatchState(std::shared_ptr<const Game> game) : State(game) {
@@ -157,15 +166,29 @@ std::string CatchState::ObservationString(Player player) const {
   return ToString();
 }
 
+template <class T>
+void CatchState::WriteObservationTensor(Player player,
+                                        TensorView<2, T>& view) const {
+  if (initialized_) {
+    view[{ball_row_, ball_col_}] = 1.0;
+    view[{num_rows_ - 1, paddle_col_}] = 1.0;
+  }
+}
+
 void CatchState::ObservationTensor(Player player,
                                    std::vector<double>* values) const {
   SPIEL_CHECK_EQ(player, 0);
 
   TensorView<2> view(values, {num_rows_, num_columns_}, true);
-  if (initialized_) {
-    view[{ball_row_, ball_col_}] = 1.0;
-    view[{num_rows_ - 1, paddle_col_}] = 1.0;
-  }
+  WriteObservationTensor(player, view);
+}
+
+void CatchState::ObservationTensor(Player player,
+                                   absl::Span<float> values) const {
+  SPIEL_CHECK_EQ(player, 0);
+
+  TensorView<2, float> view(values, {num_rows_, num_columns_}, true);
+  WriteObservationTensor(player, view);
 }
 
 void CatchState::InformationStateTensor(Player player,
@@ -218,5 +241,72 @@ CatchGame::CatchGame(const GameParameters& params)
       num_rows_(ParameterValue<int>("rows")),
       num_columns_(ParameterValue<int>("columns")) {}
 
+CatchVectorEnv::CatchVectorEnv(std::shared_ptr<const Game> game,
+                               int num_envs, int seed)
+    : game_(std::move(game)),
+      num_rows_(AsCatchGame(*game_).NumRows()),
+      num_columns_(AsCatchGame(*game_).NumColumns()),
+      rng_(seed),
+      ball_rows_(num_envs),
+      ball_cols_(num_envs),
+      paddle_cols_(num_envs),
+      observations_(num_envs * num_rows_ * num_columns_),
+      legal_actions_masks_(num_envs * kNumActions, 1.0f),
+      rewards_(num_envs),
+      current_players_(num_envs, 0),
+      dones_(num_envs) {
+  SPIEL_CHECK_GT(num_envs, 0);
+  Reset();
+}
+
+void CatchVectorEnv::Reset() {
+  std::fill(observations_.begin(), observations_.end(), 0.0f);
+  std::fill(rewards_.begin(), rewards_.end(), 0.0f);
+  std::fill(dones_.begin(), dones_.end(), 0);
+  for (int env = 0; env < num_envs(); ++env) {
+    ResetEnv(env);
+    WriteObservation(env, 1.0f);
+  }
+}
+
+void CatchVectorEnv::Step(absl::Span<const Action> actions) {
+  const int num_envs = this->num_envs();
+  SPIEL_CHECK_EQ(actions.size(), num_envs);
+  for (int env = 0; env < num_envs; ++env) {
+    if (actions[env] < 0 || actions[env] >= kNumActions) {
+      SpielFatalError(absl::StrCat("Invalid action ", actions[env]));
+    }
+    WriteObservation(env, 0.0f);
+  }
+  // The games are independent and branch-free, so this loop vectorizes.
+  const int last_row = num_rows_ - 1;
+  const int last_col = num_columns_ - 1;
+  for (int env = 0; env < num_envs; ++env) {
+    const int paddle_col = paddle_cols_[env] + actions[env] - 1;
+    paddle_cols_[env] = std::min(std::max(paddle_col, 0), last_col);
+    const int ball_row = ++ball_rows_[env];
+    const int done = ball_row >= last_row;
+    dones_[env] = done;
+    rewards_[env] = done * (ball_cols_[env] == paddle_cols_[env] ? 1 : -1);
+  }
+  for (int env = 0; env < num_envs; ++env) {
+    if (dones_[env]) ResetEnv(env);
+    WriteObservation(env, 1.0f);
+  }
+}
+
+void CatchVectorEnv::ResetEnv(int env) {
+  ball_rows_[env] = 0;
+  ball_cols_[env] =
+      std::uniform_int_distribution<int>(0, num_columns_ - 1)(rng_);
+  paddle_cols_[env] = num_columns_ / 2;
+}
+
+void CatchVectorEnv::WriteObservation(int env, float value) {
+  float* observation = &observations_[env * num_rows_ * num_columns_];
+  observation[ball_rows_[env] * num_columns_ + ball_cols_[env]] = value;
+  observation[(num_rows_ - 1) * num_columns_ + paddle_cols_[env]] = value;
+}
+
 }  // namespace catch_
 }  // namespace open_spiel
@@ -16,10 +16,13 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_CATCH_H_
 
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // Catch is a single player game, often used for unit testing RL algorithms.
 //
@@ -73,10 +76,13 @@ class CatchState : public State {
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   void InformationStateTensor(Player player,
                               std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action move) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<Action> LegalActions() const override;
   ActionsAndProbs ChanceOutcomes() const override;
   CellState BoardAt(int row, int column) const;
@@ -85,6 +91,10 @@ class CatchState : public State {
   void DoApplyAction(Action move) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
   int num_rows_ = -1;
   int num_columns_ = -1;
   bool initialized_ = false;
@@ -124,6 +134,66 @@ class CatchGame : public Game {
   const int num_columns_;
 };
 
+// A batch of catch games stepped together, for RL smoke tests where stepping
+// the environment costs more than the network. It behaves like
+// algorithms::VectorEnv (see vector_env.h), with the same buffers, but keeps
+// the games as arrays of ball and paddle positions, which are updated by
+// simple loops over the whole batch rather than through a State per game.
+class CatchVectorEnv {
+ public:
+  CatchVectorEnv(std::shared_ptr<const Game> game, int num_envs, int seed);
+
+  // Starts a new game in every environment.
+  void Reset();
+
+  // Applies actions[i] (left, stay or right) in environment i.
+  void Step(absl::Span<const Action> actions);
+
+  int num_envs() const { return ball_rows_.size(); }
+  const std::vector<int>& ball_rows() const { return ball_rows_; }
+  const std::vector<int>& ball_cols() const { return ball_cols_; }
+  const std::vector<int>& paddle_cols() const { return paddle_cols_; }
+
+  // [num_envs, rows * columns], as CatchState::ObservationTensor.
+  const std::vector<float>& observations() const { return observations_; }
+
+  // [num_envs, kNumActions], all 1 as every action is always legal.
+  const std::vector<float>& legal_actions_masks() const {
+    return legal_actions_masks_;
+  }
+
+  // [num_envs], the rewards received during the last step. All zero after
+  // Reset().
+  const std::vector<float>& rewards() const { return rewards_; }
+
+  // [num_envs], all 0.
+  const std::vector<int>& current_players() const { return current_players_; }
+
+  // [num_envs], 1 if the last step ended the game (the environment then holds
+  // the initial state of the next one), 0 otherwise.
+  const std::vector<int>& dones() const { return dones_; }
+
+ private:
+  void ResetEnv(int env);
+  // Sets the cells of the ball and paddle of env in its observation to value.
+  void WriteObservation(int env, float value);
+
+  std::shared_ptr<const Game> game_;
+  const int num_rows_;
+  const int num_columns_;
+  std::mt19937 rng_;
+
+  std::vector<int> ball_rows_;
+  std::vector<int> ball_cols_;
+  std::vector<int> paddle_cols_;
+
+  std::vector<float> observations_;
+  std::vector<float> legal_actions_masks_;
+  std::vector<float> rewards_;
+  std::vector<int> current_players_;
+  std::vector<int> dones_;
+};
+
 }  // namespace catch_
 }  // namespace open_spiel
 
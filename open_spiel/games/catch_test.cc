@@ -14,6 +14,11 @@
 
 #include "open_spiel/games/catch.h"
 
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "open_spiel/algorithms/get_all_states.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -102,6 +107,54 @@ void ToStringTest() {
                  "..x..\n");
 }
 
+// Starts a game with the ball of environment env of the batch.
+std::unique_ptr<State> NewShadowState(const Game& game,
+                                      const CatchVectorEnv& env, int i) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  state->ApplyAction(env.ball_cols()[i]);
+  return state;
+}
+
+void CheckObservation(const State& state, const CatchVectorEnv& env, int i) {
+  const std::vector<double> observation = state.ObservationTensor();
+  for (int j = 0; j < observation.size(); ++j) {
+    SPIEL_CHECK_EQ(env.observations()[i * observation.size() + j],
+                   observation[j]);
+  }
+}
+
+void VectorEnvTest(const std::string& game_name) {
+  constexpr int kNumEnvs = 16;
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  CatchVectorEnv env(game, kNumEnvs, /*seed=*/4321);
+  std::vector<std::unique_ptr<State>> states;
+  for (int i = 0; i < kNumEnvs; ++i) {
+    states.push_back(NewShadowState(*game, env, i));
+    CheckObservation(*states[i], env, i);
+  }
+
+  std::mt19937 rng;
+  int num_episodes = 0;
+  std::vector<Action> actions(kNumEnvs);
+  for (int step = 0; step < 100; ++step) {
+    for (Action& action : actions) {
+      action = std::uniform_int_distribution<int>(0, kNumActions - 1)(rng);
+    }
+    env.Step(actions);
+    for (int i = 0; i < kNumEnvs; ++i) {
+      states[i]->ApplyAction(actions[i]);
+      SPIEL_CHECK_EQ(env.dones()[i], states[i]->IsTerminal());
+      SPIEL_CHECK_EQ(env.rewards()[i], states[i]->PlayerReturn(0));
+      if (states[i]->IsTerminal()) {
+        states[i] = NewShadowState(*game, env, i);
+        ++num_episodes;
+      }
+      CheckObservation(*states[i], env, i);
+    }
+  }
+  SPIEL_CHECK_GT(num_episodes, 0);
+}
+
 }  // namespace
 }  // namespace catch_
 }  // namespace open_spiel
@@ -111,4 +164,6 @@ int main(int argc, char** argv) {
   open_spiel::catch_::GetAllStatesTest();
   open_spiel::catch_::PlayAndWinTest();
   open_spiel::catch_::ToStringTest();
+  open_spiel::catch_::VectorEnvTest("catch");
+  open_spiel::catch_::VectorEnvTest("catch(rows=4,columns=7)");
 }
@@ -14,9 +14,11 @@
 
 #include "open_spiel/games/chess.h"
 
+#include <algorithm>
 #include <optional>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/chess/chess_board.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -52,33 +54,19 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
-// Adds a plane to the information state vector corresponding to the presence
-// and absence of the given piece type and colour at each square.
-void AddPieceTypePlane(Color color, PieceType piece_type,
-                       const StandardChessBoard& board,
-                       std::vector<double>* values) {
-  for (int8_t y = 0; y < BoardSize(); ++y) {
-    for (int8_t x = 0; x < BoardSize(); ++x) {
-      Piece piece_on_board = board.at(Square{x, y});
-      values->push_back(piece_on_board.color == color &&
-                                piece_on_board.type == piece_type
-                            ? 1.0
-                            : 0.0);
-    }
-  }
+constexpr int kNumSquares = BoardSize() * BoardSize();
+constexpr int kNumPiecePlanes = 2 * kPieceTypes.size() + 1;
+
+// Returns the plane of ObservationTensor for the presence of a piece: the
+// planes of each piece type are white then black, and the last is for empty
+// squares.
+int PiecePlane(const Piece& piece) {
+  if (piece.type == PieceType::kEmpty) return kNumPiecePlanes - 1;
+  const int type_index = absl::c_find(kPieceTypes, piece.type) -
+                         kPieceTypes.begin();
+  return 2 * type_index + (piece.color == Color::kBlack ? 1 : 0);
 }
 
-// Adds a uniform scalar plane scaled with min and max.
-template <typename T>
-void AddScalarPlane(T val, T min, T max, std::vector<double>* values) {
-  double normalized_val = static_cast<double>(val - min) / (max - min);
-  values->insert(values->end(), BoardSize() * BoardSize(), normalized_val);
-}
-
-// Adds a binary scalar plane.
-void AddBinaryPlane(bool val, std::vector<double>* values) {
-  AddScalarPlane<int>(val ? 1 : 0, 0, 1, values);
-}
 }  // namespace
 
 ChessState::ChessState(std::shared_ptr<const Game> game)
@@ -86,6 +74,7 @@ ChessState::ChessState(std::shared_ptr<const Game> game)
       start_board_(MakeDefaultBoard()),
       current_board_(start_board_) {
   repetitions_[current_board_.HashValue()] = 1;
+  UpdatePiecePlanes();
 }
 
 ChessState::ChessState(std::shared_ptr<const Game> game, const std::string& fen)
@@ -95,33 +84,82 @@ ChessState::ChessState(std::shared_ptr<const Game> game, const std::string& fen)
   start_board_ = *maybe_board;
   current_board_ = start_board_;
   repetitions_[current_board_.HashValue()] = 1;
+  UpdatePiecePlanes();
 }
 
 void ChessState::DoApplyAction(Action action) {
-  Move move = ActionToMove(action, Board());
+  const Move* legal_move = CachedLegalMove(action);
+  Move move =
+      legal_move != nullptr ? *legal_move : ActionToMove(action, Board());
   moves_history_.push_back(move);
   Board().ApplyMove(move);
   ++repetitions_[current_board_.HashValue()];
   cached_legal_actions_.reset();
+  cached_legal_moves_.clear();
+  UpdatePiecePlanes();
+}
+
+void ChessState::UpdatePiecePlanes() {
+  if (piece_planes_.empty()) {
+    observed_pieces_.fill(kEmptyPiece);
+    piece_planes_.resize(kNumPiecePlanes * kNumSquares, 0);
+    std::fill(piece_planes_.end() - kNumSquares, piece_planes_.end(), 1);
+  }
+  const auto& pieces = Board().pieces();
+  for (int square = 0; square < kNumSquares; ++square) {
+    if (pieces[square] != observed_pieces_[square]) {
+      piece_planes_[PiecePlane(observed_pieces_[square]) * kNumSquares +
+                    square] = 0;
+      piece_planes_[PiecePlane(pieces[square]) * kNumSquares + square] = 1;
+      observed_pieces_[square] = pieces[square];
+    }
+  }
 }
 
 void ChessState::MaybeGenerateLegalActions() const {
   if (!cached_legal_actions_) {
-    cached_legal_actions_ = std::vector<Action>();
-    Board().GenerateLegalMoves([this](const Move& move) -> bool {
-      cached_legal_actions_->push_back(MoveToAction(move));
+    std::vector<std::pair<Action, Move>> legal_moves;
+    Board().GenerateLegalMoves([&legal_moves](const Move& move) -> bool {
+      legal_moves.emplace_back(MoveToAction(move), move);
       return true;
     });
-    absl::c_sort(*cached_legal_actions_);
+    absl::c_sort(legal_moves, [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    cached_legal_actions_ = std::vector<Action>();
+    cached_legal_actions_->reserve(legal_moves.size());
+    cached_legal_moves_.clear();
+    cached_legal_moves_.reserve(legal_moves.size());
+    for (const auto& [action, move] : legal_moves) {
+      cached_legal_actions_->push_back(action);
+      cached_legal_moves_.push_back(move);
+    }
   }
 }
 
+const Move* ChessState::CachedLegalMove(Action action) const {
+  if (!cached_legal_actions_) return nullptr;
+  auto it = absl::c_lower_bound(*cached_legal_actions_, action);
+  if (it == cached_legal_actions_->end() || *it != action) return nullptr;
+  return &cached_legal_moves_[it - cached_legal_actions_->begin()];
+}
+
 std::vector<Action> ChessState::LegalActions() const {
   MaybeGenerateLegalActions();
   if (IsTerminal()) return {};
   return *cached_legal_actions_;
 }
 
+void ChessState::LegalActions(std::vector<Action>* actions) const {
+  MaybeGenerateLegalActions();
+  if (IsTerminal()) {
+    actions->clear();
+  } else {
+    actions->assign(cached_legal_actions_->begin(),
+                    cached_legal_actions_->end());
+  }
+}
+
 int EncodeMove(const Square& from_square, int destination_index, int board_size,
                int num_actions_destinations) {
   return (from_square.x * board_size + from_square.y) *
@@ -138,8 +176,106 @@ Color PlayerToColor(Player p) {
   return static_cast<Color>(p);
 }
 
+namespace {
+
+// The squares of an action for the player of `color`, and its
+// underpromotion, which don't depend on the rest of the board.
+struct ActionSquares {
+  Square from;
+  Square to;
+  PieceType under_promotion = PieceType::kEmpty;
+};
+
+ActionSquares ComputeActionSquares(Action action, Color color) {
+  ActionSquares squares;
+  auto [from_square, destination_index] =
+      ActionToDestination(action, BoardSize(), kNumActionDestinations);
+  SPIEL_CHECK_LT(destination_index, kNumActionDestinations);
+
+  Offset offset;
+  if (destination_index < kNumUnderPromotions) {
+    int promotion_index = destination_index / 3;
+    int direction_index = destination_index % 3;
+    squares.under_promotion = kUnderPromotionIndexToType[promotion_index];
+    offset = kUnderPromotionDirectionToOffset[direction_index];
+  } else {
+    destination_index -= kNumUnderPromotions;
+    offset = DestinationIndexToOffset(destination_index, kKnightOffsets,
+                                      BoardSize());
+  }
+  Square to_square = from_square + offset;
+
+  from_square.y = ReflectRank(color, BoardSize(), from_square.y);
+  to_square.y = ReflectRank(color, BoardSize(), to_square.y);
+  squares.from = from_square;
+  squares.to = to_square;
+  return squares;
+}
+
+using ActionSquaresTable =
+    std::array<std::array<ActionSquares, NumDistinctActions()>, 2>;
+
+// [color][action]
+const ActionSquaresTable& GetActionSquaresTable() {
+  static const ActionSquaresTable* table = [] {
+    auto* table = new ActionSquaresTable();
+    for (Color color : {Color::kBlack, Color::kWhite}) {
+      for (Action action = 0; action < NumDistinctActions(); ++action) {
+        (*table)[static_cast<int>(color)][action] =
+            ComputeActionSquares(action, color);
+      }
+    }
+    return table;
+  }();
+  return *table;
+}
+
+constexpr int kNumSquaresOnBoard = BoardSize() * BoardSize();
+using MoveActionTable = std::array<
+    std::array<std::array<int16_t, kNumSquaresOnBoard>, kNumSquaresOnBoard>,
+    2>;
+
+// [color][from][to] the action of a move which is not an underpromotion, or
+// -1 if there is none.
+const MoveActionTable& GetMoveActionTable() {
+  static const MoveActionTable* table = [] {
+    auto* table = new MoveActionTable();
+    for (auto& from_table : *table) {
+      for (auto& to_table : from_table) to_table.fill(-1);
+    }
+    const ActionSquaresTable& squares_table = GetActionSquaresTable();
+    for (int color = 0; color < 2; ++color) {
+      for (Action action = 0; action < NumDistinctActions(); ++action) {
+        const ActionSquares& squares = squares_table[color][action];
+        if (squares.under_promotion != PieceType::kEmpty ||
+            !StandardChessBoard::InBoardArea(squares.to)) {
+          continue;
+        }
+        (*table)[color][SquareToIndex(squares.from)]
+                [SquareToIndex(squares.to)] = action;
+      }
+    }
+    return table;
+  }();
+  return *table;
+}
+
+}  // namespace
+
 Action MoveToAction(const Move& move) {
   Color color = move.piece.color;
+  bool is_under_promotion = move.promotion_type != PieceType::kEmpty &&
+                            move.promotion_type != PieceType::kQueen;
+  if (!is_under_promotion) {
+    // For the normal moves, the action only depends on the starting and
+    // destination squares, and is looked up.
+    const int action = GetMoveActionTable()[static_cast<int>(color)]
+                                           [SquareToIndex(move.from)]
+                                           [SquareToIndex(move.to)];
+    SPIEL_CHECK_GE(action, 0);
+    return action;
+  }
+
   // We rotate the move to be from player p's perspective.
   Move player_move(move);
 
@@ -160,47 +296,37 @@ Action MoveToAction(const Move& move) {
   int8_t x_diff = player_move.to.x - player_move.from.x;
   int8_t y_diff = player_move.to.y - player_move.from.y;
   Offset offset{x_diff, y_diff};
-  bool is_under_promotion = move.promotion_type != PieceType::kEmpty &&
-                            move.promotion_type != PieceType::kQueen;
-  if (is_under_promotion) {
-    // We have to indicate underpromotions as special moves, because in terms of
-    // from/to they are identical to queen promotions.
-    // For a given starting square, an underpromotion can have 3 possible
-    // destination squares (straight, left diagonal, right diagonal) and 3
-    // possible piece types.
-    SPIEL_CHECK_EQ(move.piece.type, PieceType::kPawn);
-    SPIEL_CHECK_TRUE((move.piece.color == color &&
-                      player_move.from.y == BoardSize() - 2 &&
-                      player_move.to.y == BoardSize() - 1) ||
-                     (move.piece.color == OppColor(color) &&
-                      player_move.from.y == 1 && player_move.to.y == 0));
-
-    int promotion_index;
-    {
-      auto itr = absl::c_find(kUnderPromotionIndexToType, move.promotion_type);
-      SPIEL_CHECK_TRUE(itr != kUnderPromotionIndexToType.end());
-      promotion_index = std::distance(kUnderPromotionIndexToType.begin(), itr);
-    }
+  // We have to indicate underpromotions as special moves, because in terms of
+  // from/to they are identical to queen promotions.
+  // For a given starting square, an underpromotion can have 3 possible
+  // destination squares (straight, left diagonal, right diagonal) and 3
+  // possible piece types.
+  SPIEL_CHECK_EQ(move.piece.type, PieceType::kPawn);
+  SPIEL_CHECK_TRUE((move.piece.color == color &&
+                    player_move.from.y == BoardSize() - 2 &&
+                    player_move.to.y == BoardSize() - 1) ||
+                   (move.piece.color == OppColor(color) &&
+                    player_move.from.y == 1 && player_move.to.y == 0));
+
+  int promotion_index;
+  {
+    auto itr = absl::c_find(kUnderPromotionIndexToType, move.promotion_type);
+    SPIEL_CHECK_TRUE(itr != kUnderPromotionIndexToType.end());
+    promotion_index = std::distance(kUnderPromotionIndexToType.begin(), itr);
+  }
 
-    int direction_index;
-    {
-      auto itr = absl::c_find_if(
-          kUnderPromotionDirectionToOffset,
-          [offset](Offset o) { return o.x_offset == offset.x_offset; });
-      SPIEL_CHECK_NE(itr, kUnderPromotionDirectionToOffset.end());
-      direction_index =
-          std::distance(kUnderPromotionDirectionToOffset.begin(), itr);
-    }
-    return starting_index +
-           kUnderPromotionDirectionToOffset.size() * promotion_index +
-           direction_index;
-  } else {
-    // For the normal moves, we simply encode starting and destination square.
-    int destination_index =
-        OffsetToDestinationIndex(offset, kKnightOffsets, BoardSize());
-    SPIEL_CHECK_TRUE(destination_index >= 0 && destination_index < 64);
-    return starting_index + kNumUnderPromotions + destination_index;
+  int direction_index;
+  {
+    auto itr = absl::c_find_if(
+        kUnderPromotionDirectionToOffset,
+        [offset](Offset o) { return o.x_offset == offset.x_offset; });
+    SPIEL_CHECK_NE(itr, kUnderPromotionDirectionToOffset.end());
+    direction_index =
+        std::distance(kUnderPromotionDirectionToOffset.begin(), itr);
   }
+  return starting_index +
+         kUnderPromotionDirectionToOffset.size() * promotion_index +
+         direction_index;
 }
 
 std::pair<Square, int> ActionToDestination(int action, int board_size,
@@ -222,34 +348,18 @@ Move ActionToMove(const Action& action, const StandardChessBoard& board) {
 
   // The encoded action represents an action encoded from color's perspective.
   Color color = board.ToPlay();
-  PieceType promotion_type = PieceType::kEmpty;
+  const ActionSquares& squares =
+      GetActionSquaresTable()[static_cast<int>(color)][action];
+  const Square& from_square = squares.from;
+  const Square& to_square = squares.to;
+  PieceType promotion_type = squares.under_promotion;
   bool is_castling = false;
-  auto [from_square, destination_index] =
-      ActionToDestination(action, BoardSize(), kNumActionDestinations);
-  SPIEL_CHECK_LT(destination_index, kNumActionDestinations);
-
-  bool is_under_promotion = destination_index < kNumUnderPromotions;
-  Offset offset;
-  if (is_under_promotion) {
-    int promotion_index = destination_index / 3;
-    int direction_index = destination_index % 3;
-    promotion_type = kUnderPromotionIndexToType[promotion_index];
-    offset = kUnderPromotionDirectionToOffset[direction_index];
-  } else {
-    destination_index -= kNumUnderPromotions;
-    offset = DestinationIndexToOffset(destination_index, kKnightOffsets,
-                                      BoardSize());
-  }
-  Square to_square = from_square + offset;
-
-  from_square.y = ReflectRank(color, BoardSize(), from_square.y);
-  to_square.y = ReflectRank(color, BoardSize(), to_square.y);
 
   // This uses the current state to infer the piece type.
   Piece piece = {board.ToPlay(), board.at(from_square).type};
 
   // Check for queen promotion.
-  if (!is_under_promotion && piece.type == PieceType::kPawn &&
+  if (promotion_type == PieceType::kEmpty && piece.type == PieceType::kPawn &&
       ReflectRank(color, BoardSize(), from_square.y) == BoardSize() - 2 &&
       ReflectRank(color, BoardSize(), to_square.y) == BoardSize() - 1) {
     promotion_type = PieceType::kQueen;
@@ -259,7 +369,8 @@ Move ActionToMove(const Action& action, const StandardChessBoard& board) {
   // by 2 spaces.
   // TODO(b/149092677): Chess no longer supports chess960. Distinguish between
   // left/right castle.
-  if (piece.type == PieceType::kKing && std::abs(offset.x_offset) == 2) {
+  if (piece.type == PieceType::kKing &&
+      std::abs(to_square.x - from_square.x) == 2) {
     is_castling = true;
   }
   Move move(from_square, to_square, piece, promotion_type, is_castling);
@@ -267,8 +378,12 @@ Move ActionToMove(const Action& action, const StandardChessBoard& board) {
 }
 
 std::string ChessState::ActionToString(Player player, Action action) const {
-  Move move = ActionToMove(action, Board());
-  return move.ToSAN(Board());
+  MaybeGenerateLegalActions();
+  const Move* legal_move = CachedLegalMove(action);
+  if (legal_move == nullptr) {
+    return ActionToMove(action, Board()).ToSAN(Board());
+  }
+  return legal_move->ToSAN(Board(), cached_legal_moves_);
 }
 
 std::string ChessState::ToString() const { return Board().ToFEN(); }
@@ -290,52 +405,65 @@ std::string ChessState::ObservationString(Player player) const {
   return ToString();
 }
 
-void ChessState::ObservationTensor(Player player,
-                                   std::vector<double>* values) const {
-  SPIEL_CHECK_NE(player, kChancePlayerId);
-
-  values->clear();
-  values->reserve(game_->ObservationTensorSize());
+template <typename T>
+void ChessState::WriteObservation(absl::Span<T> values) const {
+  SPIEL_CHECK_EQ(values.size(), game_->ObservationTensorSize());
 
-  // Piece cconfiguration.
-  for (const auto& piece_type : kPieceTypes) {
-    AddPieceTypePlane(Color::kWhite, piece_type, Board(), values);
-    AddPieceTypePlane(Color::kBlack, piece_type, Board(), values);
-  }
+  // Piece configuration.
+  auto plane = std::copy(piece_planes_.begin(), piece_planes_.end(),
+                         values.begin());
 
-  AddPieceTypePlane(Color::kEmpty, PieceType::kEmpty, Board(), values);
+  // Adds a uniform scalar plane scaled with min and max.
+  const auto add_scalar_plane = [&plane](int val, int min, int max) {
+    plane = std::fill_n(plane, kNumSquares,
+                        static_cast<double>(val - min) / (max - min));
+  };
 
   const auto entry = repetitions_.find(Board().HashValue());
   SPIEL_CHECK_FALSE(entry == repetitions_.end());
   int repetitions = entry->second;
 
   // Num repetitions for the current board.
-  AddScalarPlane(repetitions, 1, 3, values);
+  add_scalar_plane(repetitions, 1, 3);
 
   // Side to play.
-  AddScalarPlane(ColorToPlayer(Board().ToPlay()), 0, 1, values);
+  add_scalar_plane(ColorToPlayer(Board().ToPlay()), 0, 1);
 
   // Irreversible move counter.
-  AddScalarPlane(Board().IrreversibleMoveCounter(), 0, 101, values);
+  add_scalar_plane(Board().IrreversibleMoveCounter(), 0, 101);
 
   // Castling rights.
-  AddBinaryPlane(Board().CastlingRight(Color::kWhite, CastlingDirection::kLeft),
-                 values);
-
-  AddBinaryPlane(
-      Board().CastlingRight(Color::kWhite, CastlingDirection::kRight), values);
+  for (Color color : {Color::kWhite, Color::kBlack}) {
+    for (CastlingDirection direction :
+         {CastlingDirection::kLeft, CastlingDirection::kRight}) {
+      add_scalar_plane(Board().CastlingRight(color, direction), 0, 1);
+    }
+  }
+}
 
-  AddBinaryPlane(Board().CastlingRight(Color::kBlack, CastlingDirection::kLeft),
-                 values);
+void ChessState::ObservationTensor(Player player,
+                                   std::vector<double>* values) const {
+  SPIEL_CHECK_NE(player, kChancePlayerId);
+  values->resize(game_->ObservationTensorSize());
+  WriteObservation(absl::MakeSpan(*values));
+}
 
-  AddBinaryPlane(
-      Board().CastlingRight(Color::kBlack, CastlingDirection::kRight), values);
+void ChessState::ObservationTensor(Player player,
+                                   absl::Span<float> values) const {
+  SPIEL_CHECK_NE(player, kChancePlayerId);
+  WriteObservation(values);
 }
 
 std::unique_ptr<State> ChessState::Clone() const {
   return std::unique_ptr<State>(new ChessState(*this));
 }
 
+bool ChessState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const ChessState&>(other);
+  return true;
+}
+
 void ChessState::UndoAction(Player player, Action action) {
   // TODO: Make this fast by storing undo info in another stack.
   SPIEL_CHECK_GE(moves_history_.size(), 1);
@@ -346,6 +474,9 @@ void ChessState::UndoAction(Player player, Action action) {
   for (const Move& move : moves_history_) {
     current_board_.ApplyMove(move);
   }
+  cached_legal_actions_.reset();
+  cached_legal_moves_.clear();
+  UpdatePiecePlanes();
 }
 
 bool ChessState::IsRepetitionDraw() const {
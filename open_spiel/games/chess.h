@@ -23,6 +23,7 @@
 #include <vector>
 #include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/chess/chess_board.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -45,6 +46,10 @@ inline constexpr int BoardSize() { return 8; }
 // See action encoding below.
 inline constexpr int NumDistinctActions() { return 4672; }
 
+// The most legal moves known in a legal position, and the usual average.
+inline constexpr int MaxLegalActions() { return 218; }
+inline constexpr int TypicalBranching() { return 35; }
+
 // https://math.stackexchange.com/questions/194008/how-many-turns-can-a-chess-game-take-at-maximum
 inline constexpr int MaxGameLength() { return 17695; }
 
@@ -154,6 +159,7 @@ class ChessState : public State {
     return IsTerminal() ? kTerminalPlayerId : ColorToPlayer(Board().ToPlay());
   }
   std::vector<Action> LegalActions() const override;
+  void LegalActions(std::vector<Action>* actions) const override;
   std::string ActionToString(Player player, Action action) const override;
   std::string ToString() const override;
 
@@ -166,8 +172,13 @@ class ChessState : public State {
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  uint64_t Hash() const override { return Board().HashValue(); }
   void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
 
   // Current board.
   StandardChessBoard& Board() { return current_board_; }
@@ -180,6 +191,11 @@ class ChessState : public State {
   std::vector<Move>& MovesHistory() { return moves_history_; }
   const std::vector<Move>& MovesHistory() const { return moves_history_; }
 
+  // The piece planes at the start of ObservationTensor (one per colour and
+  // piece type, and one for empty squares). They are kept up to date as moves
+  // are applied and undone, rather than rebuilt for every observation.
+  absl::Span<const float> PiecePlanes() const { return piece_planes_; }
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -192,10 +208,23 @@ class ChessState : public State {
   // LegalActions() as there are a number of other methods that need the value
   // of LegalActions. This is a separate method as it's called from
   // IsTerminal(), which is also called by LegalActions().
+  // The moves are cached with the actions, and reused by DoApplyAction and
+  // ActionToString instead of being decoded and generated again.
   void MaybeGenerateLegalActions() const;
 
+  // Returns the cached legal move of `action`, or nullptr if the legal moves
+  // are not cached or it is not legal.
+  const Move* CachedLegalMove(Action action) const;
+
   std::optional<std::vector<double>> MaybeFinalReturns() const;
 
+  // Updates piece_planes_ for the squares whose pieces differ from
+  // observed_pieces_, which are only a few after a move.
+  void UpdatePiecePlanes();
+
+  template <typename T>
+  void WriteObservation(absl::Span<T> values) const;
+
   // We have to store every move made to check for repetitions and to implement
   // undo. We store the current board position as an optimization.
   std::vector<Move> moves_history_;
@@ -218,6 +247,12 @@ class ChessState : public State {
   using RepetitionTable = absl::flat_hash_map<uint64_t, int, PassthroughHash>;
   RepetitionTable repetitions_;
   mutable std::optional<std::vector<Action>> cached_legal_actions_;
+  // The moves of cached_legal_actions_, in the same order.
+  mutable std::vector<Move> cached_legal_moves_;
+
+  // The pieces of the board that piece_planes_ was last updated for.
+  std::array<Piece, BoardSize() * BoardSize()> observed_pieces_;
+  std::vector<float> piece_planes_;
 };
 
 // Game object.
@@ -244,6 +279,9 @@ class ChessGame : public Game {
     return chess::ObservationTensorShape();
   }
   int MaxGameLength() const override { return chess::MaxGameLength(); }
+  GameResourceHints ResourceHints() const override {
+    return {chess::MaxLegalActions(), 0, chess::TypicalBranching()};
+  }
 };
 
 }  // namespace chess
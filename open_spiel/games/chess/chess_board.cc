@@ -14,7 +14,9 @@
 
 #include "open_spiel/games/chess/chess_board.h"
 
+#include <array>
 #include <cctype>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -182,6 +184,16 @@ std::string Move::ToLAN() const {
 }
 
 std::string Move::ToSAN(const StandardChessBoard &board) const {
+  std::vector<Move> legal_moves;
+  board.GenerateLegalMoves([&](const Move &move) -> bool {
+    legal_moves.push_back(move);
+    return true;
+  });
+  return ToSAN(board, legal_moves);
+}
+
+std::string Move::ToSAN(const StandardChessBoard &board,
+                        absl::Span<const Move> legal_moves) const {
   std::string move_text;
   PieceType piece_type = board.at(from).type;
   if (is_castling) {
@@ -206,20 +218,20 @@ std::string Move::ToSAN(const StandardChessBoard &board) const {
         std::cerr << "Move doesn't have a piece type" << std::endl;
     }
 
-    // Now we generate all moves from this position, and see if our file and
+    // Now we go through all moves from this position, and see if our file and
     // rank are unique.
     bool file_unique = true;
     bool rank_unique = true;
     bool disambiguation_required = false;
 
-    board.GenerateLegalMoves([&](const Move &move) -> bool {
+    for (const Move &move : legal_moves) {
       if (move.to != to) {
-        return true;
+        continue;
       }
       if (move.from == from) {
         // This is either us, or a promotion to a different type. We don't count
         // them as ambiguous in either case.
-        return true;
+        continue;
       }
       disambiguation_required = true;
       if (move.from.x == from.x) {
@@ -227,8 +239,7 @@ std::string Move::ToSAN(const StandardChessBoard &board) const {
       } else if (move.from.y == from.y) {
         rank_unique = false;
       }
-      return true;
-    });
+    }
 
     bool file_required = false;
     bool rank_required = false;
@@ -312,6 +323,131 @@ std::string Move::ToSAN(const StandardChessBoard &board) const {
   return move_text;
 }
 
+namespace {
+
+uint64_t Bit(int index) { return uint64_t{1} << index; }
+
+// The attack tables of the bitboards of ChessBoard<kBoardSize>, in which the
+// square {x, y} is bit y * kBoardSize + x.
+template <uint32_t kBoardSize>
+struct BitboardTables {
+  static constexpr int kNumSquares = kBoardSize * kBoardSize;
+
+  BitboardTables();
+
+  // The squares attacked from a square by a knight, a king, or a pawn of
+  // each color, by ToInt(color).
+  std::array<uint64_t, kNumSquares> knight;
+  std::array<uint64_t, kNumSquares> king;
+  std::array<std::array<uint64_t, kNumSquares>, 2> pawn;
+  // The squares along each direction from a square, on an empty board. The
+  // square indices increase along the first 4 directions, and decrease along
+  // the last 4, which are their opposites.
+  std::array<std::array<uint64_t, kNumSquares>, 8> rays;
+  // The squares strictly between two squares, and the whole line through
+  // them, if they are on a line (and 0 otherwise).
+  std::array<std::array<uint64_t, kNumSquares>, kNumSquares> between;
+  std::array<std::array<uint64_t, kNumSquares>, kNumSquares> line;
+};
+
+template <uint32_t kBoardSize>
+BitboardTables<kBoardSize>::BitboardTables() {
+  constexpr Offset kDirections[] = {{1, 0},  {0, 1},   {1, 1},   {-1, 1},
+                                    {-1, 0}, {0, -1}, {-1, -1}, {1, -1}};
+  constexpr Offset kKnightOffsets[] = {{1, 2},   {2, 1},   {2, -1}, {1, -2},
+                                       {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+  const auto in_board = [](const Square &sq) {
+    return sq.x >= 0 && sq.x < kBoardSize && sq.y >= 0 && sq.y < kBoardSize;
+  };
+  const auto index = [](const Square &sq) { return sq.y * kBoardSize + sq.x; };
+  const auto offset_bit = [&](const Square &sq, const Offset &offset) {
+    const Square to = sq + offset;
+    return in_board(to) ? Bit(index(to)) : uint64_t{0};
+  };
+
+  for (auto &squares : between) squares.fill(0);
+  for (auto &squares : line) squares.fill(0);
+  for (int8_t y = 0; y < kBoardSize; ++y) {
+    for (int8_t x = 0; x < kBoardSize; ++x) {
+      const Square sq{x, y};
+      const int from = index(sq);
+      knight[from] = 0;
+      king[from] = 0;
+      for (const Offset &offset : kKnightOffsets) {
+        knight[from] |= offset_bit(sq, offset);
+      }
+      for (const Offset &offset : kDirections) {
+        king[from] |= offset_bit(sq, offset);
+      }
+      pawn[ToInt(Color::kWhite)][from] =
+          offset_bit(sq, {-1, 1}) | offset_bit(sq, {1, 1});
+      pawn[ToInt(Color::kBlack)][from] =
+          offset_bit(sq, {-1, -1}) | offset_bit(sq, {1, -1});
+
+      for (int direction = 0; direction < 8; ++direction) {
+        uint64_t ray = 0;
+        for (Square to = sq + kDirections[direction]; in_board(to);
+             to += kDirections[direction]) {
+          between[from][index(to)] = ray;
+          ray |= Bit(index(to));
+        }
+        rays[direction][from] = ray;
+      }
+    }
+  }
+  for (int from = 0; from < kNumSquares; ++from) {
+    for (int direction = 0; direction < 4; ++direction) {
+      const uint64_t full_line =
+          rays[direction][from] | rays[direction + 4][from] | Bit(from);
+      for (uint64_t squares = full_line & ~Bit(from); squares != 0;
+           squares &= squares - 1) {
+        line[from][__builtin_ctzll(squares)] = full_line;
+      }
+    }
+  }
+}
+
+template <uint32_t kBoardSize>
+const BitboardTables<kBoardSize> &GetBitboardTables() {
+  static const auto *tables = new BitboardTables<kBoardSize>();
+  return *tables;
+}
+
+// Returns the squares attacked along a direction from the square at `index`,
+// up to and including the first occupied one.
+template <uint32_t kBoardSize>
+uint64_t RayAttacks(const BitboardTables<kBoardSize> &tables, int direction,
+                    int index, uint64_t occupancy) {
+  uint64_t attacks = tables.rays[direction][index];
+  const uint64_t blockers = attacks & occupancy;
+  if (blockers != 0) {
+    const int blocker = direction < 4 ? __builtin_ctzll(blockers)
+                                      : 63 - __builtin_clzll(blockers);
+    attacks &= ~tables.rays[direction][blocker];
+  }
+  return attacks;
+}
+
+template <uint32_t kBoardSize>
+uint64_t RookAttacks(const BitboardTables<kBoardSize> &tables, int index,
+                     uint64_t occupancy) {
+  return RayAttacks(tables, 0, index, occupancy) |
+         RayAttacks(tables, 1, index, occupancy) |
+         RayAttacks(tables, 4, index, occupancy) |
+         RayAttacks(tables, 5, index, occupancy);
+}
+
+template <uint32_t kBoardSize>
+uint64_t BishopAttacks(const BitboardTables<kBoardSize> &tables, int index,
+                       uint64_t occupancy) {
+  return RayAttacks(tables, 2, index, occupancy) |
+         RayAttacks(tables, 3, index, occupancy) |
+         RayAttacks(tables, 6, index, occupancy) |
+         RayAttacks(tables, 7, index, occupancy);
+}
+
+}  // namespace
+
 template <uint32_t kBoardSize>
 ChessBoard<kBoardSize>::ChessBoard()
     : to_play_(Color::kWhite),
@@ -439,6 +575,16 @@ ChessBoard<kBoardSize>::BoardFromFEN(const std::string &fen) {
 
 template <uint32_t kBoardSize>
 Square ChessBoard<kBoardSize>::find(const Piece &piece) const {
+  if (piece.type != PieceType::kEmpty) {
+    const uint64_t squares = Pieces_(piece.color, piece.type);
+    if (squares == 0) {
+      return InvalidSquare();
+    }
+    const int index = __builtin_ctzll(squares);
+    return Square{static_cast<int8_t>(index % kBoardSize),
+                  static_cast<int8_t>(index / kBoardSize)};
+  }
+
   for (int8_t y = 0; y < kBoardSize; ++y) {
     for (int8_t x = 0; x < kBoardSize; ++x) {
       Square sq{x, y};
@@ -454,25 +600,80 @@ Square ChessBoard<kBoardSize>::find(const Piece &piece) const {
 template <uint32_t kBoardSize>
 void ChessBoard<kBoardSize>::GenerateLegalMoves(
     const MoveYieldFn &yield) const {
-  auto king_square = find(Piece{to_play_, PieceType::kKing});
-
-  GeneratePseudoLegalMoves([this, &king_square, &yield](const Move &move) {
-    // See if the move is legal by applying, checking whether the king is
-    // under attack, and undoing the move.
-    // TODO: Optimize this.
-    auto board_copy = *this;
-    board_copy.ApplyMove(move);
-
-    auto ks = at(move.from).type == PieceType::kKing ? move.to : king_square;
+  const uint64_t kings = Pieces_(to_play_, PieceType::kKing);
+  if (kings == 0) {
+    GeneratePseudoLegalMoves([this, &yield](const Move &move) {
+      return LeavesKingInCheck_(move) || yield(move);
+    });
+    return;
+  }
+
+  // Instead of making every move to see whether it leaves the king in check,
+  // we find the pieces checking the king and the pieces pinned to it. A king
+  // move is then legal if its destination is not attacked, once the king has
+  // left its square. Another move is legal if it does not take a pinned
+  // piece off the line of its pin, and blocks or captures the checker if
+  // there is one (and none is legal in double check). Castling and en
+  // passant, which move or remove two pieces, are still tested by making
+  // them.
+  const auto &tables = GetBitboardTables<kBoardSize>();
+  const Color opponent_color = OppColor(to_play_);
+  const int king = __builtin_ctzll(kings);
+  const uint64_t occupancy = Occupancy_();
+  const uint64_t checkers = Attackers_(king, opponent_color, occupancy);
+
+  const uint64_t queens = type_bitboards_[static_cast<int>(PieceType::kQueen)];
+  uint64_t snipers =
+      color_bitboards_[ToInt(opponent_color)] &
+      ((RookAttacks(tables, king, 0) &
+        (type_bitboards_[static_cast<int>(PieceType::kRook)] | queens)) |
+       (BishopAttacks(tables, king, 0) &
+        (type_bitboards_[static_cast<int>(PieceType::kBishop)] | queens)));
+  uint64_t pinned = 0;
+  for (; snipers != 0; snipers &= snipers - 1) {
+    const uint64_t blockers =
+        tables.between[king][__builtin_ctzll(snipers)] & occupancy;
+    if (blockers != 0 && (blockers & (blockers - 1)) == 0) {
+      pinned |= blockers & color_bitboards_[ToInt(to_play_)];
+    }
+  }
 
-    if (board_copy.UnderAttack(ks, to_play_)) {
-      return true;
+  // The destinations of the moves other than the king's that get out of
+  // check.
+  uint64_t evasions = ~uint64_t{0};
+  if (checkers != 0) {
+    evasions = (checkers & (checkers - 1)) != 0
+                   ? 0
+                   : tables.between[king][__builtin_ctzll(checkers)] | checkers;
+  }
+
+  GeneratePseudoLegalMoves([&](const Move &move) {
+    const int from = SquareToIndex_(move.from);
+    const int to = SquareToIndex_(move.to);
+    bool legal;
+    if (move.is_castling ||
+        (move.piece.type == PieceType::kPawn && move.from.x != move.to.x &&
+         IsEmpty(move.to))) {
+      legal = !LeavesKingInCheck_(move);
+    } else if (from == king) {
+      legal = Attackers_(to, opponent_color, occupancy & ~Bit(from)) == 0;
     } else {
-      return yield(move);
+      legal = (evasions & Bit(to)) != 0 &&
+              ((pinned & Bit(from)) == 0 ||
+               (tables.line[king][from] & Bit(to)) != 0);
     }
+    return !legal || yield(move);
   });
 }
 
+template <uint32_t kBoardSize>
+bool ChessBoard<kBoardSize>::LeavesKingInCheck_(const Move &move) const {
+  auto board_copy = *this;
+  board_copy.ApplyMove(move);
+  return board_copy.UnderAttack(
+      board_copy.find(Piece{to_play_, PieceType::kKing}), to_play_);
+}
+
 template <uint32_t kBoardSize>
 void ChessBoard<kBoardSize>::GeneratePseudoLegalMoves(
     const MoveYieldFn &yield) const {
@@ -1007,75 +1208,29 @@ template <uint32_t kBoardSize>
 bool ChessBoard<kBoardSize>::UnderAttack(const Square &sq,
                                          Color our_color) const {
   SPIEL_CHECK_NE(sq, InvalidSquare());
+  return Attackers_(SquareToIndex_(sq), OppColor(our_color), Occupancy_()) !=
+         0;
+}
 
-  bool under_attack = false;
-  Color opponent_color = OppColor(our_color);
-
-  // We do this by pretending we are a piece of different types, and seeing if
-  // we can attack opponent pieces. Eg. if we pretend we are a knight, and can
-  // attack an opponent knight, that means the knight can also attack us.
-
-  // King moves (this is possible because we use this function for checking
-  // whether we are moving into check, and we can be trying to move the king
-  // into a square attacked by opponent king).
-  GenerateKingDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if (at(to) == Piece{opponent_color, PieceType::kKing}) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
-    return true;
-  }
-
-  // Rook moves (for rooks and queens)
-  GenerateRookDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if ((at(to) == Piece{opponent_color, PieceType::kRook}) ||
-            (at(to) == Piece{opponent_color, PieceType::kQueen})) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
-    return true;
-  }
-
-  // Bishop moves (for bishops and queens)
-  GenerateBishopDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if ((at(to) == Piece{opponent_color, PieceType::kBishop}) ||
-            (at(to) == Piece{opponent_color, PieceType::kQueen})) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
-    return true;
-  }
-
-  // Knight moves
-  GenerateKnightDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if (at(to) == Piece{opponent_color, PieceType::kKnight}) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
-    return true;
-  }
-
-  // Pawn captures.
-  GeneratePawnCaptureDestinations_(
-      sq, our_color, false /* no ep */,
-      [this, &under_attack, &opponent_color](const Square &to) {
-        if (at(to) == Piece{opponent_color, PieceType::kPawn}) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
-    return true;
-  }
-
-  return false;
+template <uint32_t kBoardSize>
+uint64_t ChessBoard<kBoardSize>::Attackers_(int index, Color color,
+                                            uint64_t occupancy) const {
+  const auto &tables = GetBitboardTables<kBoardSize>();
+  const auto pieces = [this](PieceType type) {
+    return type_bitboards_[static_cast<int>(type)];
+  };
+  const uint64_t queens = pieces(PieceType::kQueen);
+  return color_bitboards_[ToInt(color)] &
+         ((tables.knight[index] & pieces(PieceType::kKnight)) |
+          (tables.king[index] & pieces(PieceType::kKing)) |
+          // The pawns of `color` attacking a square are on the squares that
+          // a pawn of the other color attacks from it.
+          (tables.pawn[ToInt(OppColor(color))][index] &
+           pieces(PieceType::kPawn)) |
+          (RookAttacks(tables, index, occupancy) &
+           (pieces(PieceType::kRook) | queens)) |
+          (BishopAttacks(tables, index, occupancy) &
+           (pieces(PieceType::kBishop) | queens)));
 }
 
 template <uint32_t kBoardSize>
@@ -1456,6 +1611,15 @@ void ChessBoard<kBoardSize>::set_square(Square sq, Piece piece) {
   zobrist_hash_ ^= kZobristValues[position][static_cast<int>(piece.color)]
                                  [static_cast<int>(piece.type)];
 
+  if (current_piece.type != PieceType::kEmpty) {
+    color_bitboards_[ToInt(current_piece.color)] &= ~Bit(position);
+    type_bitboards_[static_cast<int>(current_piece.type)] &= ~Bit(position);
+  }
+  if (piece.type != PieceType::kEmpty) {
+    color_bitboards_[ToInt(piece.color)] |= Bit(position);
+    type_bitboards_[static_cast<int>(piece.type)] |= Bit(position);
+  }
+
   board_[position] = piece;
 }
 
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/chess/chess_common.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -208,6 +209,11 @@ struct Move {
   //                novelty that gives white a clear but not winning advantage)
   std::string ToSAN(const StandardChessBoard& board) const;
 
+  // The same, disambiguated against `legal_moves`, which must be the legal
+  // moves of `board`, instead of generating them.
+  std::string ToSAN(const StandardChessBoard& board,
+                    absl::Span<const Move> legal_moves) const;
+
   bool operator==(const Move& other) const {
     return from == other.from && to == other.to && piece == other.piece &&
            promotion_type == other.promotion_type &&
@@ -429,7 +435,31 @@ class ChessBoard {
   void SetIrreversibleMoveCounter(int c);
   void SetMovenumber(int move_number);
 
+  // The squares of the pieces of a color and type, as bitboards of the
+  // square indices.
+  uint64_t Pieces_(Color color, PieceType type) const {
+    return color_bitboards_[ToInt(color)] &
+           type_bitboards_[static_cast<int>(type)];
+  }
+  uint64_t Occupancy_() const {
+    return color_bitboards_[0] | color_bitboards_[1];
+  }
+
+  // Returns the pieces of `color` attacking the square at `index`, with the
+  // squares in `occupancy` occupied, e.g. without a king that moves away.
+  uint64_t Attackers_(int index, Color color, uint64_t occupancy) const;
+
+  // Whether a pseudo-legal move leaves the king in check, by applying it to
+  // a copy of the board.
+  bool LeavesKingInCheck_(const Move& move) const;
+
   std::array<Piece, kBoardSize * kBoardSize> board_;
+  // The squares of each color and piece type, by ToInt(color) and PieceType,
+  // kept in sync with board_ by set_square.
+  static_assert(kBoardSize * kBoardSize <= 64,
+                "The bitboards only have 64 squares.");
+  uint64_t color_bitboards_[2] = {0, 0};
+  uint64_t type_bitboards_[7] = {0, 0, 0, 0, 0, 0, 0};
   Color to_play_;
   Square ep_square_;
   int32_t irreversible_move_counter_;
@@ -15,8 +15,13 @@
 #include "open_spiel/games/chess.h"
 
 #include <memory>
+#include <optional>
+#include <random>
 #include <string>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/chess/chess_board.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -37,6 +42,25 @@ int CountNumLegalMoves(const StandardChessBoard& board) {
   return num_legal_moves;
 }
 
+int Perft(const StandardChessBoard& board, int depth) {
+  if (depth == 0) return 1;
+  int num_nodes = 0;
+  board.GenerateLegalMoves([&board, &num_nodes, depth](const Move& move) {
+    StandardChessBoard child = board;
+    child.ApplyMove(move);
+    num_nodes += Perft(child, depth - 1);
+    return true;
+  });
+  return num_nodes;
+}
+
+int Perft(const char* fen, int depth) {
+  std::optional<StandardChessBoard> board =
+      StandardChessBoard::BoardFromFEN(fen);
+  SPIEL_CHECK_TRUE(board);
+  return Perft(*board, depth);
+}
+
 void CheckUndo(const char* fen, const char* move_san, const char* fen_after) {
   std::shared_ptr<const Game> game = LoadGame("chess");
   ChessState state(game, fen);
@@ -66,6 +90,22 @@ void BasicChessTests() {
 void MoveGenerationTests() {
   StandardChessBoard start_pos = MakeDefaultBoard();
   SPIEL_CHECK_EQ(CountNumLegalMoves(start_pos), 20);
+
+  // Perft counts from https://www.chessprogramming.org/Perft_Results, for
+  // positions with checks, pins, castling, en passant and promotions.
+  SPIEL_CHECK_EQ(Perft(start_pos, 3), 8902);
+  SPIEL_CHECK_EQ(
+      Perft("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+            3),
+      97862);
+  SPIEL_CHECK_EQ(Perft("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -", 4), 43238);
+  SPIEL_CHECK_EQ(
+      Perft("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            3),
+      9467);
+  SPIEL_CHECK_EQ(
+      Perft("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3),
+      62379);
 }
 
 void TerminalReturnTests() {
@@ -213,6 +253,34 @@ void ObservationTensorTests() {
   SPIEL_CHECK_EQ(ValueAt(v, shape, 19, 3, 3), 1.0);
 }
 
+void IncrementalObservationTests() {
+  std::shared_ptr<const Game> game = LoadGame("chess");
+  ChessState state(game);
+  std::mt19937 rng(0);
+  std::vector<double> v;
+  std::vector<float> floats(game->ObservationTensorSize());
+  for (int i = 0; i < 200 && !state.IsTerminal(); ++i) {
+    std::vector<Action> actions = state.LegalActions();
+    std::uniform_int_distribution<int> dis(0, actions.size() - 1);
+    state.ApplyAction(actions[dis(rng)]);
+    if (std::uniform_int_distribution<int>(0, 9)(rng) == 0) {
+      state.UndoAction(state.History().size() % 2, state.History().back());
+    }
+
+    // The planes must match those of the position from scratch.
+    ChessState from_scratch(game, state.Board().ToFEN());
+    SPIEL_CHECK_TRUE(absl::c_equal(state.PiecePlanes(),
+                                   from_scratch.PiecePlanes()));
+    state.ObservationTensor(state.CurrentPlayer(), &v);
+    state.ObservationTensor(state.CurrentPlayer(), absl::MakeSpan(floats));
+    SPIEL_CHECK_TRUE(absl::c_equal(std::vector<float>(v.begin(), v.end()),
+                                   floats));
+    SPIEL_CHECK_TRUE(absl::c_equal(
+        absl::MakeConstSpan(v).subspan(0, state.PiecePlanes().size()),
+        state.PiecePlanes()));
+  }
+}
+
 void MoveConversionTests() {
   auto game = LoadGame("chess");
   std::mt19937 rng(23);
@@ -236,6 +304,17 @@ void MoveConversionTests() {
       SPIEL_CHECK_EQ(board.ToFEN(), fresh_board.ToFEN());
       Action action_from_lan = MoveToAction(*board.ParseLANMove(move.ToLAN()));
       SPIEL_CHECK_EQ(action, action_from_lan);
+      // The legal moves, which the state caches, are those decoded from their
+      // actions, and give the same SAN strings.
+      if (i < 10) {
+        board.GenerateLegalMoves([&](const Move& legal_move) -> bool {
+          const Action legal_action = MoveToAction(legal_move);
+          SPIEL_CHECK_TRUE(ActionToMove(legal_action, board) == legal_move);
+          SPIEL_CHECK_EQ(state->ActionToString(legal_action),
+                         legal_move.ToSAN(board));
+          return true;
+        });
+      }
       state->ApplyAction(action);
     }
   }
@@ -251,5 +330,6 @@ int main(int argc, char** argv) {
   open_spiel::chess::UndoTests();
   open_spiel::chess::TerminalReturnTests();
   open_spiel::chess::ObservationTensorTests();
+  open_spiel::chess::IncrementalObservationTests();
   open_spiel::chess::MoveConversionTests();
 }
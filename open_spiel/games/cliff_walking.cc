@@ -123,7 +123,7 @@ std::vector<double> CliffWalkingState::Rewards() const {
 
 std::vector<double> CliffWalkingState::Returns() const {
   if (IsCliff(player_row_, player_col_)) return {-100.0 - time_counter_ + 1};
-  return {time_counter_ * -1.0};
+  return {static_cast<double>(-time_counter_)};
 }
 
 std::string CliffWalkingState::InformationStateString(Player player) const {
@@ -72,6 +72,12 @@ std::string StateToString(CellState state) {
       return "This will never return.";
   }
 }
+
+// Zobrist key of a (non-empty) cell state, used to update the hash
+// incrementally.
+uint64_t CellKey(int cell, CellState state) {
+  return HashMix(cell * kCellStates + static_cast<int>(state));
+}
 }  // namespace
 
 CellState& ConnectFourState::CellAt(int row, int col) {
@@ -92,9 +98,11 @@ int ConnectFourState::CurrentPlayer() const {
 
 void ConnectFourState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(CellAt(kRows - 1, move), CellState::kEmpty);
-  int row = 0;
-  while (CellAt(row, move) != CellState::kEmpty) ++row;
+  const uint64_t column = (stones_[0] | stones_[1]) >> (move * kColumnBits);
+  const int row = __builtin_ctzll(~column);
   CellAt(row, move) = PlayerToState(CurrentPlayer());
+  stones_[current_player_] |= CellBit(row, move);
+  hash_ ^= CellKey(row * kCols + move, CellAt(row, move));
 
   if (HasLine(current_player_)) {
     outcome_ = static_cast<Outcome>(current_player_);
@@ -105,14 +113,30 @@ void ConnectFourState::DoApplyAction(Action move) {
   current_player_ = 1 - current_player_;
 }
 
+void ConnectFourState::UndoAction(Player player, Action move) {
+  int row = kRows - 1;
+  while (CellAt(row, move) == CellState::kEmpty) --row;
+  hash_ ^= CellKey(row * kCols + move, CellAt(row, move));
+  CellAt(row, move) = CellState::kEmpty;
+  stones_[player] &= ~CellBit(row, move);
+  current_player_ = player;
+  outcome_ = Outcome::kUnknown;
+  history_.pop_back();
+}
+
 std::vector<Action> ConnectFourState::LegalActions() const {
-  // Can move in any non-full column.
   std::vector<Action> moves;
-  if (IsTerminal()) return moves;
+  LegalActions(&moves);
+  return moves;
+}
+
+void ConnectFourState::LegalActions(std::vector<Action>* moves) const {
+  // Can move in any non-full column.
+  moves->clear();
+  if (IsTerminal()) return;
   for (int col = 0; col < kCols; ++col) {
-    if (CellAt(kRows - 1, col) == CellState::kEmpty) moves.push_back(col);
+    if (CellAt(kRows - 1, col) == CellState::kEmpty) moves->push_back(col);
   }
-  return moves;
 }
 
 std::string ConnectFourState::ActionToString(Player player,
@@ -120,42 +144,28 @@ std::string ConnectFourState::ActionToString(Player player,
   return absl::StrCat(StateToString(PlayerToState(player)), action_id);
 }
 
-bool ConnectFourState::HasLineFrom(Player player, int row, int col) const {
-  return HasLineFromInDirection(player, row, col, 0, 1) ||
-         HasLineFromInDirection(player, row, col, -1, -1) ||
-         HasLineFromInDirection(player, row, col, -1, 0) ||
-         HasLineFromInDirection(player, row, col, -1, 1);
-}
-
-bool ConnectFourState::HasLineFromInDirection(Player player, int row, int col,
-                                              int drow, int dcol) const {
-  if (row + 3 * drow >= kRows || col + 3 * dcol >= kCols ||
-      row + 3 * drow < 0 || col + 3 * dcol < 0)
-    return false;
-  CellState c = PlayerToState(player);
-  for (int i = 0; i < 4; ++i) {
-    if (CellAt(row, col) != c) return false;
-    row += drow;
-    col += dcol;
-  }
-  return true;
-}
-
-bool ConnectFourState::HasLine(Player player) const {
-  CellState c = PlayerToState(player);
-  for (int col = 0; col < kCols; ++col) {
-    for (int row = 0; row < kRows; ++row) {
-      if (CellAt(row, col) == c && HasLineFrom(player, row, col)) return true;
+void ConnectFourState::BitboardsFromBoard() {
+  stones_ = {0, 0};
+  for (int row = 0; row < kRows; ++row) {
+    for (int col = 0; col < kCols; ++col) {
+      if (CellAt(row, col) == CellState::kCross) {
+        stones_[0] |= CellBit(row, col);
+      } else if (CellAt(row, col) == CellState::kNought) {
+        stones_[1] |= CellBit(row, col);
+      }
     }
   }
-  return false;
 }
 
-bool ConnectFourState::IsFull() const {
-  for (int col = 0; col < kCols; ++col) {
-    if (CellAt(kRows - 1, col) == CellState::kEmpty) return false;
+Outcome ConnectFourState::OutcomeFromBoard() const {
+  if (HasLine(0)) {
+    return Outcome::kPlayer1;
+  } else if (HasLine(1)) {
+    return Outcome::kPlayer2;
+  } else if (IsFull()) {
+    return Outcome::kDraw;
   }
-  return true;
+  return Outcome::kUnknown;
 }
 
 ConnectFourState::ConnectFourState(std::shared_ptr<const Game> game)
@@ -178,9 +188,19 @@ bool ConnectFourState::IsTerminal() const {
 }
 
 std::vector<double> ConnectFourState::Returns() const {
-  if (outcome_ == Outcome::kPlayer1) return {1.0, -1.0};
-  if (outcome_ == Outcome::kPlayer2) return {-1.0, 1.0};
-  return {0.0, 0.0};
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void ConnectFourState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  returns[0] = outcome_ == Outcome::kPlayer1   ? 1.0
+               : outcome_ == Outcome::kPlayer2 ? -1.0
+                                               : 0.0;
+  returns[1] = outcome_ == Outcome::kPlayer2   ? 1.0
+               : outcome_ == Outcome::kPlayer1 ? -1.0
+                                               : 0.0;
 }
 
 std::string ConnectFourState::InformationStateString(Player player) const {
@@ -206,24 +226,74 @@ int PlayerRelative(CellState state, Player current) {
   }
 }
 
+template <class T>
+void ConnectFourState::WriteObservationTensor(Player player,
+                                              TensorView<2, T>& view) const {
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    view[{PlayerRelative(board_[cell], player), cell}] = 1.0;
+  }
+}
+
 void ConnectFourState::ObservationTensor(Player player,
                                          std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   TensorView<2> view(values, {kCellStates, kNumCells}, true);
+  WriteObservationTensor(player, view);
+}
 
-  for (int cell = 0; cell < kNumCells; ++cell) {
-    view[{PlayerRelative(board_[cell], player), cell}] = 1.0;
-  }
+void ConnectFourState::ObservationTensor(Player player,
+                                         absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(values, {kCellStates, kNumCells}, true);
+  WriteObservationTensor(player, view);
 }
 
 std::unique_ptr<State> ConnectFourState::Clone() const {
   return std::unique_ptr<State>(new ConnectFourState(*this));
 }
 
+bool ConnectFourState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const ConnectFourState&>(other);
+  return true;
+}
+
 std::string ConnectFourState::Serialize() const { return ToString(); }
 
+std::string ConnectFourState::BinarySnapshot() const {
+  // One byte per cell; everything else follows from the board.
+  std::string snapshot(kNumCells, '\0');
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    snapshot[cell] = static_cast<char>(board_[cell]);
+  }
+  return snapshot;
+}
+
+void ConnectFourState::RestoreBinarySnapshot(const std::vector<Action>& history,
+                                             absl::string_view snapshot) {
+  SPIEL_CHECK_EQ(snapshot.size(), kNumCells);
+  int num_stones = 0;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    const int value = snapshot[cell];
+    SPIEL_CHECK_GE(value, 0);
+    SPIEL_CHECK_LT(value, kCellStates);
+    board_[cell] = static_cast<CellState>(value);
+    if (board_[cell] != CellState::kEmpty) {
+      hash_ ^= CellKey(cell, board_[cell]);
+      ++num_stones;
+    }
+  }
+  SPIEL_CHECK_EQ(num_stones, history.size());
+  BitboardsFromBoard();
+  history_ = history;
+  current_player_ = num_stones % 2;
+  outcome_ = OutcomeFromBoard();
+}
+
 ConnectFourGame::ConnectFourGame(const GameParameters& params)
     : Game(kGameType, params) {}
 
@@ -266,14 +336,11 @@ ConnectFourState::ConnectFourState(std::shared_ptr<const Game> game,
   SPIEL_CHECK_TRUE(c == 0 &&
                    ("Problem parsing state (column value should be 0)"));
   current_player_ = (xs == os) ? 0 : 1;
-
-  if (HasLine(0)) {
-    outcome_ = Outcome::kPlayer1;
-  } else if (HasLine(1)) {
-    outcome_ = Outcome::kPlayer2;
-  } else if (IsFull()) {
-    outcome_ = Outcome::kDraw;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    if (board_[cell] != CellState::kEmpty) hash_ ^= CellKey(cell, board_[cell]);
   }
+  BitboardsFromBoard();
+  outcome_ = OutcomeFromBoard();
 }
 
 }  // namespace connect_four
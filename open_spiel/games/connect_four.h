@@ -16,12 +16,15 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_H_
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // Simple game of Connect Four
 // https://en.wikipedia.org/wiki/Connect_Four
@@ -42,6 +45,35 @@ inline constexpr int kNumCells = kRows * kCols;
 inline constexpr int kCellStates =
     1 + kNumPlayers;  // player 0, player 1, empty
 
+// The stones of a player are also kept in a bitboard, with the cell (row, col)
+// at bit col * kColumnBits + row. The extra bit on top of each column stays
+// empty, so that lines can be found by shifts without wrapping to the next
+// column.
+inline constexpr int kColumnBits = kRows + 1;
+static_assert(kColumnBits * kCols <= 64, "The board must fit in 64 bits");
+
+inline constexpr uint64_t CellBit(int row, int col) {
+  return uint64_t{1} << (col * kColumnBits + row);
+}
+inline constexpr uint64_t BottomRowMask() {
+  uint64_t mask = 0;
+  for (int col = 0; col < kCols; ++col) mask |= CellBit(0, col);
+  return mask;
+}
+inline constexpr uint64_t BoardMask() {
+  return BottomRowMask() * ((uint64_t{1} << kRows) - 1);
+}
+
+// Returns whether the stones in the bitboard include four in a row.
+inline bool HasFourInARow(uint64_t stones) {
+  // Vertically, horizontally and along both diagonals.
+  for (int shift : {1, kColumnBits, kColumnBits + 1, kColumnBits - 1}) {
+    const uint64_t pairs = stones & (stones >> shift);
+    if (pairs & (pairs >> (2 * shift))) return true;
+  }
+  return false;
+}
+
 // Outcome of the game.
 enum class Outcome {
   kPlayer1 = 0,
@@ -67,31 +99,56 @@ class ConnectFourState : public State {
 
   Player CurrentPlayer() const override;
   std::vector<Action> LegalActions() const override;
+  void LegalActions(std::vector<Action>* actions) const override;
   std::string ActionToString(Player player, Action action_id) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
+  void UndoAction(Player player, Action move) override;
+  bool SupportsUndoAction() const override { return true; }
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  // The player to move and the outcome follow from the board, so this is just
+  // a Zobrist hash of the cells, updated incrementally.
+  uint64_t Hash() const override { return hash_; }
   std::string Serialize() const override;
+  std::string BinarySnapshot() const override;
+  void RestoreBinarySnapshot(const std::vector<Action>& history,
+                             absl::string_view snapshot) override;
+
+  // The bitboard of the stones of a player.
+  uint64_t Bitboard(Player player) const { return stones_[player]; }
 
  protected:
   void DoApplyAction(Action move) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
   CellState& CellAt(int row, int col);
   CellState CellAt(int row, int col) const;
-  bool HasLine(Player player) const;  // Does this player have a line?
-  bool HasLineFrom(Player player, int row, int col) const;
-  bool HasLineFromInDirection(Player player, int row, int col, int drow,
-                              int dcol) const;
-  bool IsFull() const;         // Is the board full?
+  bool HasLine(Player player) const {  // Does this player have a line?
+    return HasFourInARow(stones_[player]);
+  }
+  bool IsFull() const {  // Is the board full?
+    return (stones_[0] | stones_[1]) == BoardMask();
+  }
+  Outcome OutcomeFromBoard() const;
+  void BitboardsFromBoard();
   Player current_player_ = 0;  // Player zero goes first
   Outcome outcome_ = Outcome::kUnknown;
   std::array<CellState, kNumCells> board_;
+  std::array<uint64_t, kNumPlayers> stones_ = {0, 0};
+  uint64_t hash_ = 0;
 };
 
 // Game object.
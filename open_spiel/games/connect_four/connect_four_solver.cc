@@ -0,0 +1,328 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/connect_four/connect_four_solver.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace connect_four {
+namespace {
+
+// The columns from the center out, as better moves tend to be there.
+constexpr std::array<int, kCols> ColumnOrder() {
+  std::array<int, kCols> order{};
+  for (int i = 0; i < kCols; ++i) {
+    order[i] = kCols / 2 + (1 - 2 * (i % 2)) * (i + 1) / 2;
+  }
+  return order;
+}
+constexpr std::array<int, kCols> kColumnOrder = ColumnOrder();
+
+// The score of winning with the next stone.
+int WinScore(const Position& position) {
+  return (kNumCells + 1 - position.NumMoves()) / 2;
+}
+
+constexpr char kBookMagic[] = "C4BOOK1";
+constexpr int kBookEntrySize = sizeof(uint64_t) + 1;
+
+}  // namespace
+
+Position::Position(const ConnectFourState& state) {
+  const Player player = state.CurrentPlayer();
+  SPIEL_CHECK_GE(player, 0);
+  current_ = state.Bitboard(player);
+  mask_ = state.Bitboard(0) | state.Bitboard(1);
+  num_moves_ = __builtin_popcountll(mask_);
+}
+
+uint64_t Position::WinningCells(uint64_t stones, uint64_t mask) {
+  // Vertically, only the cell above three stones.
+  uint64_t cells = (stones << 1) & (stones << 2) & (stones << 3);
+  // In the other directions, the cell may be at either end of the line or in
+  // between.
+  for (int shift : {kColumnBits, kColumnBits - 1, kColumnBits + 1}) {
+    uint64_t pairs = (stones << shift) & (stones << (2 * shift));
+    cells |= pairs & (stones << (3 * shift));
+    cells |= pairs & (stones >> shift);
+    pairs = (stones >> shift) & (stones >> (2 * shift));
+    cells |= pairs & (stones << shift);
+    cells |= pairs & (stones >> (3 * shift));
+  }
+  return cells & (BoardMask() ^ mask);
+}
+
+uint64_t Position::NonLosingMoves() const {
+  uint64_t moves = Playable();
+  const uint64_t opponent_wins = OpponentWinningCells();
+  const uint64_t forced_moves = moves & opponent_wins;
+  if (forced_moves) {
+    // The opponent wins next unless we block it, which we can only do once.
+    if (forced_moves & (forced_moves - 1)) return 0;
+    moves = forced_moves;
+  }
+  // Do not play below a cell where the opponent would win.
+  return moves & ~(opponent_wins >> 1);
+}
+
+int Position::MoveScore(uint64_t move) const {
+  return __builtin_popcountll(WinningCells(current_ | move, mask_));
+}
+
+uint64_t Position::MirroredKey() const {
+  const uint64_t key = Key();
+  const uint64_t column_bits = (uint64_t{1} << kColumnBits) - 1;
+  uint64_t mirrored = 0;
+  for (int col = 0; col < kCols; ++col) {
+    mirrored |= ((key >> (col * kColumnBits)) & column_bits)
+                << ((kCols - 1 - col) * kColumnBits);
+  }
+  return mirrored;
+}
+
+ConnectFourSolver::ConnectFourSolver(int log2_table_size)
+    : table_shift_(64 - log2_table_size),
+      table_keys_(uint64_t{1} << log2_table_size, 0),
+      table_values_(uint64_t{1} << log2_table_size, 0) {
+  SPIEL_CHECK_GT(log2_table_size, 0);
+  SPIEL_CHECK_LT(log2_table_size, 40);
+}
+
+void ConnectFourSolver::ClearTranspositionTable() {
+  std::fill(table_keys_.begin(), table_keys_.end(), 0);
+  std::fill(table_values_.begin(), table_values_.end(), 0);
+}
+
+int ConnectFourSolver::Negamax(const Position& position, int alpha,
+                               int beta) {
+  // The player to move cannot win at once, as the callers check it first.
+  ++num_nodes_;
+  const int num_moves = position.NumMoves();
+  const uint64_t moves = position.NonLosingMoves();
+  if (moves == 0) return -(kNumCells - num_moves) / 2;
+  if (num_moves >= kNumCells - 2) return 0;
+
+  // The opponent cannot win with its next stone, nor we with ours.
+  int min = -(kNumCells - 2 - num_moves) / 2;
+  if (alpha < min) {
+    alpha = min;
+    if (alpha >= beta) return alpha;
+  }
+  int max = (kNumCells - 1 - num_moves) / 2;
+  if (beta > max) {
+    beta = max;
+    if (alpha >= beta) return beta;
+  }
+
+  const uint64_t key = position.Key();
+  if (const int value = LoadBound(key)) {
+    if (value > kMaxScore - kMinScore + 1) {
+      min = value + 2 * kMinScore - kMaxScore - 2;
+      if (alpha < min) {
+        alpha = min;
+        if (alpha >= beta) return alpha;
+      }
+    } else {
+      max = value + kMinScore - 1;
+      if (beta > max) {
+        beta = max;
+        if (alpha >= beta) return beta;
+      }
+    }
+  }
+  if (num_moves <= book_depth_) {
+    const auto it = book_.find(std::min(key, position.MirroredKey()));
+    if (it != book_.end()) return it->second;
+  }
+
+  // Sorts the moves by increasing score, keeping those nearer the center
+  // after the others on ties, and searches them from the last.
+  std::array<uint64_t, kCols> sorted_moves;
+  std::array<int, kCols> scores;
+  int num_sorted = 0;
+  for (int i = kCols - 1; i >= 0; --i) {
+    const uint64_t move = moves & Position::ColumnMask(kColumnOrder[i]);
+    if (!move) continue;
+    const int score = position.MoveScore(move);
+    int j = num_sorted++;
+    for (; j > 0 && scores[j - 1] > score; --j) {
+      sorted_moves[j] = sorted_moves[j - 1];
+      scores[j] = scores[j - 1];
+    }
+    sorted_moves[j] = move;
+    scores[j] = score;
+  }
+
+  while (num_sorted > 0) {
+    Position child = position;
+    child.PlayCell(sorted_moves[--num_sorted]);
+    const int score = -Negamax(child, -beta, -alpha);
+    if (score >= beta) {
+      StoreBound(key, score + kMaxScore - 2 * kMinScore + 2);
+      return score;
+    }
+    if (score > alpha) alpha = score;
+  }
+  StoreBound(key, alpha - kMinScore + 1);
+  return alpha;
+}
+
+int ConnectFourSolver::Solve(const Position& position, bool weak) {
+  if (position.CanWinNext()) return weak ? 1 : WinScore(position);
+  if (position.NumMoves() <= book_depth_) {
+    const auto it =
+        book_.find(std::min(position.Key(), position.MirroredKey()));
+    if (it != book_.end()) {
+      return weak ? (it->second > 0) - (it->second < 0) : it->second;
+    }
+  }
+
+  // Narrows the range of the score by null window searches, which are the
+  // fastest, starting from the middle and otherwise from the half of the
+  // bound nearest to 0, as the scores are more often small.
+  int min = -(kNumCells - position.NumMoves()) / 2;
+  int max = WinScore(position);
+  if (weak) {
+    min = -1;
+    max = 1;
+  }
+  while (min < max) {
+    int middle = min + (max - min) / 2;
+    if (middle <= 0 && min / 2 < middle) {
+      middle = min / 2;
+    } else if (middle >= 0 && max / 2 > middle) {
+      middle = max / 2;
+    }
+    const int score = Negamax(position, middle, middle + 1);
+    if (score <= middle) {
+      max = score;
+    } else {
+      min = score;
+    }
+  }
+  return weak ? (min > 0) - (min < 0) : min;
+}
+
+int ConnectFourSolver::Solve(const State& state, bool weak) {
+  SPIEL_CHECK_EQ(state.GetGame()->GetType().short_name, "connect_four");
+  SPIEL_CHECK_FALSE(state.IsTerminal());
+  return Solve(Position(static_cast<const ConnectFourState&>(state)), weak);
+}
+
+std::vector<int> ConnectFourSolver::MoveScores(const Position& position) {
+  std::vector<int> scores(kCols, kInvalidScore);
+  for (int col = 0; col < kCols; ++col) {
+    if (!position.CanPlay(col)) continue;
+    if (position.IsWinningMove(col)) {
+      scores[col] = WinScore(position);
+    } else {
+      Position child = position;
+      child.Play(col);
+      scores[col] = -Solve(child);
+    }
+  }
+  return scores;
+}
+
+void ConnectFourSolver::AddToOpeningBook(const Position& position,
+                                         int depth) {
+  const uint64_t key = std::min(position.Key(), position.MirroredKey());
+  if (book_.count(key)) return;
+  if (position.CanWinNext()) {
+    book_[key] = WinScore(position);
+    return;
+  }
+  // The children are solved first, so that their parents find them.
+  if (position.NumMoves() < depth) {
+    for (int col = 0; col < kCols; ++col) {
+      if (position.CanPlay(col)) {
+        Position child = position;
+        child.Play(col);
+        AddToOpeningBook(child, depth);
+      }
+    }
+  }
+  book_[key] = Solve(position);
+}
+
+void ConnectFourSolver::BuildOpeningBook(int depth, const Position& root) {
+  SPIEL_CHECK_GE(depth, root.NumMoves());
+  SPIEL_CHECK_LT(depth, kNumCells);
+  book_.clear();
+  book_depth_ = depth;
+  AddToOpeningBook(root, depth);
+}
+
+void ConnectFourSolver::SaveOpeningBook(const std::string& path) const {
+  std::string contents(kBookMagic, sizeof(kBookMagic));
+  contents.push_back(static_cast<char>(book_depth_));
+  for (const auto& [key, score] : book_) {
+    contents.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    contents.push_back(static_cast<char>(score));
+  }
+  file::File file(path, "wb");
+  SPIEL_CHECK_TRUE(file.Write(contents));
+}
+
+void ConnectFourSolver::LoadOpeningBook(const std::string& path) {
+  const std::string contents = file::File(path, "rb").ReadContents();
+  const int header_size = sizeof(kBookMagic) + 1;
+  if (contents.size() < header_size ||
+      std::memcmp(contents.data(), kBookMagic, sizeof(kBookMagic)) != 0 ||
+      (contents.size() - header_size) % kBookEntrySize != 0) {
+    SpielFatalError(absl::StrCat(path, " is not a connect_four book."));
+  }
+  book_.clear();
+  book_depth_ = contents[sizeof(kBookMagic)];
+  for (int i = header_size; i < contents.size(); i += kBookEntrySize) {
+    uint64_t key;
+    std::memcpy(&key, contents.data() + i, sizeof(key));
+    book_[key] = static_cast<int8_t>(contents[i + sizeof(key)]);
+  }
+}
+
+Action ConnectFourSolverBot::Step(const State& state) {
+  SPIEL_CHECK_EQ(state.GetGame()->GetType().short_name, "connect_four");
+  const std::vector<int> scores = solver_->MoveScores(
+      Position(static_cast<const ConnectFourState&>(state)));
+  Action best_action = kInvalidAction;
+  for (int col : kColumnOrder) {
+    if (scores[col] != ConnectFourSolver::kInvalidScore &&
+        (best_action == kInvalidAction || scores[col] > scores[best_action])) {
+      best_action = col;
+    }
+  }
+  SPIEL_CHECK_NE(best_action, kInvalidAction);
+  return best_action;
+}
+
+std::unique_ptr<Bot> MakeConnectFourSolverBot(int log2_table_size) {
+  return std::make_unique<ConnectFourSolverBot>(
+      std::make_shared<ConnectFourSolver>(log2_table_size));
+}
+
+}  // namespace connect_four
+}  // namespace open_spiel
@@ -0,0 +1,176 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_CONNECT_FOUR_SOLVER_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_CONNECT_FOUR_SOLVER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/games/connect_four.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_bots.h"
+
+// A perfect-play solver for connect_four, after Pascal Pons' solver
+// (http://blog.gamesolver.org): a negamax search with alpha-beta pruning over
+// bitboards, searching the moves that do not lose at once from the center out
+// and by the number of threats they create, with a transposition table and an
+// optional opening book of solved early positions.
+
+namespace open_spiel {
+namespace connect_four {
+
+// A position from the point of view of the player to move: the bitboards
+// (laid out as in ConnectFourState) of the stones of that player and of all
+// stones.
+class Position {
+ public:
+  Position() = default;
+  explicit Position(const ConnectFourState& state);
+
+  int NumMoves() const { return num_moves_; }
+  bool CanPlay(int col) const { return (mask_ & CellBit(kRows - 1, col)) == 0; }
+  void Play(int col) { PlayCell((mask_ + CellBit(0, col)) & ColumnMask(col)); }
+  // Plays at a playable cell, given by its bit.
+  void PlayCell(uint64_t move) {
+    current_ ^= mask_;
+    mask_ |= move;
+    ++num_moves_;
+  }
+  // Whether playing in the column makes four in a row.
+  bool IsWinningMove(int col) const {
+    return WinningCells() & Playable() & ColumnMask(col);
+  }
+  bool CanWinNext() const { return WinningCells() & Playable(); }
+
+  // The cells where the player to move can play without letting the opponent
+  // win at once, unless no move avoids it.
+  uint64_t NonLosingMoves() const;
+  // The number of cells that would complete four in a row of the player to
+  // move after playing at `move`.
+  int MoveScore(uint64_t move) const;
+
+  // A unique key of the position.
+  uint64_t Key() const { return current_ + mask_; }
+  // The key of the mirrored position.
+  uint64_t MirroredKey() const;
+
+  static constexpr uint64_t ColumnMask(int col) {
+    return ((uint64_t{1} << kRows) - 1) << (col * kColumnBits);
+  }
+
+ private:
+  uint64_t Playable() const { return (mask_ + BottomRowMask()) & BoardMask(); }
+  uint64_t WinningCells() const { return WinningCells(current_, mask_); }
+  uint64_t OpponentWinningCells() const {
+    return WinningCells(current_ ^ mask_, mask_);
+  }
+  // The empty cells that would complete four in a row of `stones`.
+  static uint64_t WinningCells(uint64_t stones, uint64_t mask);
+
+  uint64_t current_ = 0;
+  uint64_t mask_ = 0;
+  int num_moves_ = 0;
+};
+
+// The score of a position for the player to move is positive if it wins,
+// negative if it loses and 0 for a draw. Wins score 1 more for each of the
+// player's stones left unplayed, i.e. (kNumCells + 1 - n) / 2 if the game is
+// won by the n-th stone, and losses the opposite.
+inline constexpr int kMinScore = -kNumCells / 2 + 3;
+inline constexpr int kMaxScore = (kNumCells + 1) / 2 - 3;
+
+class ConnectFourSolver {
+ public:
+  // The transposition table keeps 2^log2_table_size positions, which take 9
+  // bytes each.
+  explicit ConnectFourSolver(int log2_table_size = 22);
+
+  // Returns the score of the position. A weak solve only tells whether it is
+  // a win (1), a loss (-1) or a draw (0), and is faster.
+  int Solve(const Position& position, bool weak = false);
+  int Solve(const State& state, bool weak = false);
+
+  // Returns the scores of the moves of a position, or kInvalidScore for full
+  // columns.
+  static constexpr int kInvalidScore = -1000;
+  std::vector<int> MoveScores(const Position& position);
+
+  // Solves the positions reachable from `root` with at most `depth` stones
+  // into the opening book, which is then used by the searches. Mirrored
+  // positions share their entry, of 9 bytes. Solving the early positions
+  // takes long, so books are meant to be built once and saved.
+  void BuildOpeningBook(int depth, const Position& root = Position());
+  void SaveOpeningBook(const std::string& path) const;
+  void LoadOpeningBook(const std::string& path);
+  int OpeningBookDepth() const { return book_depth_; }
+  int OpeningBookSize() const { return book_.size(); }
+
+  // The positions searched since the solver was created.
+  int64_t NumNodes() const { return num_nodes_; }
+  void ClearTranspositionTable();
+
+ private:
+  int Negamax(const Position& position, int alpha, int beta);
+  void AddToOpeningBook(const Position& position, int depth);
+
+  // The scores are stored shifted to be positive, so that 0 marks an empty
+  // entry: lower bounds as score + kMaxScore - 2 * kMinScore + 2, and upper
+  // bounds as score - kMinScore + 1.
+  // The keys are spread over the table by a multiplicative hash.
+  uint64_t TableIndex(uint64_t key) const {
+    return (key * uint64_t{0x9E3779B97F4A7C15}) >> table_shift_;
+  }
+  void StoreBound(uint64_t key, int value) {
+    const uint64_t index = TableIndex(key);
+    table_keys_[index] = key;
+    table_values_[index] = value;
+  }
+  int LoadBound(uint64_t key) const {
+    const uint64_t index = TableIndex(key);
+    return table_keys_[index] == key ? table_values_[index] : 0;
+  }
+
+  int table_shift_;
+  std::vector<uint64_t> table_keys_;
+  std::vector<int8_t> table_values_;
+  int book_depth_ = -1;
+  // Indexed by the smaller of the keys of a position and its mirror.
+  std::unordered_map<uint64_t, int8_t> book_;
+  int64_t num_nodes_ = 0;
+};
+
+// A bot playing a move of the best score, i.e. winning as fast as possible,
+// or losing as late as possible. Ties are broken towards the center.
+class ConnectFourSolverBot : public Bot {
+ public:
+  explicit ConnectFourSolverBot(std::shared_ptr<ConnectFourSolver> solver)
+      : solver_(std::move(solver)) {}
+
+  Action Step(const State& state) override;
+
+ private:
+  std::shared_ptr<ConnectFourSolver> solver_;
+};
+
+std::unique_ptr<Bot> MakeConnectFourSolverBot(int log2_table_size = 22);
+
+}  // namespace connect_four
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_CONNECT_FOUR_SOLVER_H_
@@ -14,6 +14,15 @@
 
 #include "open_spiel/games/connect_four.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/games/connect_four/connect_four_solver.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -28,6 +37,7 @@ void BasicConnectFourTests() {
   testing::LoadGameTest("connect_four");
   testing::NoChanceOutcomesTest(*LoadGame("connect_four"));
   testing::RandomSimTest(*LoadGame("connect_four"), 100);
+  testing::RandomSimTestWithUndo(*LoadGame("connect_four"), 10);
 }
 
 void FastLoss() {
@@ -79,6 +89,131 @@ void DeserializeDraw() {
   SPIEL_CHECK_EQ(state->Returns(), (std::vector<double>{0, 0}));
 }
 
+// Returns the solver's score of a position by a full search of its subtree.
+int BruteForceScore(State* state) {
+  const int num_moves = state->History().size();
+  int best_score = -kNumCells;
+  for (Action action : state->LegalActions()) {
+    const Player player = state->CurrentPlayer();
+    state->ApplyAction(action);
+    int score;
+    if (state->IsTerminal()) {
+      score = state->PlayerReturn(player) > 0 ? (kNumCells + 1 - num_moves) / 2
+                                              : 0;
+    } else {
+      score = -BruteForceScore(state);
+    }
+    state->UndoAction(player, action);
+    best_score = std::max(best_score, score);
+  }
+  return best_score;
+}
+
+// Plays randomly until `num_moves` stones are on the board, or returns null
+// if the game ends first.
+std::unique_ptr<State> RandomPosition(const Game& game, int num_moves,
+                                      std::mt19937* rng) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  while (state->History().size() < num_moves) {
+    if (state->IsTerminal()) return nullptr;
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[std::uniform_int_distribution<int>(
+        0, actions.size() - 1)(*rng)]);
+  }
+  if (state->IsTerminal()) return nullptr;
+  return state;
+}
+
+void SolverMatchesBruteForce() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  ConnectFourSolver solver(/*log2_table_size=*/16);
+  std::mt19937 rng(0);
+  for (int num_positions = 0; num_positions < 20;) {
+    std::unique_ptr<State> state = RandomPosition(*game, 32, &rng);
+    if (!state) continue;
+    ++num_positions;
+    const int score = BruteForceScore(state.get());
+    SPIEL_CHECK_EQ(solver.Solve(*state), score);
+    SPIEL_CHECK_EQ(solver.Solve(*state, /*weak=*/true),
+                   (score > 0) - (score < 0));
+  }
+}
+
+void SolverFindsQuickestWin() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : {3, 3, 4, 4}) state->ApplyAction(action);
+  // x wins with its 4th stone by playing 2 or 5, and o has no defence.
+  ConnectFourSolver solver(/*log2_table_size=*/16);
+  SPIEL_CHECK_EQ(solver.Solve(*state), (kNumCells + 1 - 6) / 2);
+  SPIEL_CHECK_EQ(solver.Solve(*state, /*weak=*/true), 1);
+}
+
+void SolverBotPlaysPerfectly() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  ConnectFourSolver solver(/*log2_table_size=*/16);
+  std::unique_ptr<Bot> bot = MakeConnectFourSolverBot(16);
+  std::mt19937 rng(2);
+  for (int num_positions = 0; num_positions < 10;) {
+    std::unique_ptr<State> state = RandomPosition(*game, 30, &rng);
+    if (!state) continue;
+    ++num_positions;
+    const int score = solver.Solve(*state);
+    // The bot keeps the score until the end of the game.
+    while (!state->IsTerminal()) {
+      const Player player = state->CurrentPlayer();
+      const int num_moves = state->History().size();
+      state->ApplyAction(bot->Step(*state));
+      if (state->IsTerminal()) {
+        SPIEL_CHECK_EQ(score, state->PlayerReturn(player) > 0
+                                  ? (kNumCells + 1 - num_moves) / 2
+                                  : 0);
+        break;
+      }
+      SPIEL_CHECK_EQ(solver.Solve(*state), -score);
+      state->ApplyAction(bot->Step(*state));
+      if (!state->IsTerminal()) SPIEL_CHECK_EQ(solver.Solve(*state), score);
+    }
+  }
+}
+
+void MirroredPositionsShareKeys() {
+  Position position, mirrored;
+  for (int col : {0, 1, 1, 3, 6}) {
+    position.Play(col);
+    mirrored.Play(kCols - 1 - col);
+  }
+  SPIEL_CHECK_EQ(position.MirroredKey(), mirrored.Key());
+  SPIEL_CHECK_EQ(mirrored.MirroredKey(), position.Key());
+}
+
+void OpeningBookTest() {
+  std::shared_ptr<const Game> game = LoadGame("connect_four");
+  std::mt19937 rng(1);
+  std::unique_ptr<State> state;
+  while (!state || Position(static_cast<const ConnectFourState&>(*state))
+                       .CanWinNext()) {
+    state = RandomPosition(*game, 28, &rng);
+  }
+  const Position root(static_cast<const ConnectFourState&>(*state));
+
+  ConnectFourSolver solver(/*log2_table_size=*/16);
+  solver.BuildOpeningBook(/*depth=*/30, root);
+  SPIEL_CHECK_GT(solver.OpeningBookSize(), 1);
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string path =
+      absl::StrCat(tmp_dir ? tmp_dir : "/tmp", "/connect_four_book_test");
+  solver.SaveOpeningBook(path);
+
+  ConnectFourSolver loaded(/*log2_table_size=*/16);
+  loaded.LoadOpeningBook(path);
+  SPIEL_CHECK_EQ(loaded.OpeningBookDepth(), 30);
+  SPIEL_CHECK_EQ(loaded.OpeningBookSize(), solver.OpeningBookSize());
+  // The book answers the root without a search.
+  SPIEL_CHECK_EQ(loaded.Solve(root), solver.Solve(root));
+  SPIEL_CHECK_EQ(loaded.NumNodes(), 0);
+}
+
 }  // namespace
 }  // namespace connect_four
 }  // namespace open_spiel
@@ -88,4 +223,9 @@ int main(int argc, char **argv) {
   open_spiel::connect_four::FastLoss();
   open_spiel::connect_four::BasicSerializationTest();
   open_spiel::connect_four::DeserializeDraw();
+  open_spiel::connect_four::SolverMatchesBruteForce();
+  open_spiel::connect_four::SolverFindsQuickestWin();
+  open_spiel::connect_four::SolverBotPlaysPerfectly();
+  open_spiel::connect_four::MirroredPositionsShareKeys();
+  open_spiel::connect_four::OpeningBookTest();
 }
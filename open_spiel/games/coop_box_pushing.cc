@@ -506,18 +506,23 @@ int CoopBoxPushingState::ObservationPlane(std::pair<int, int> coord,
   return plane;
 }
 
+template <class T>
+void CoopBoxPushingState::WriteObservationTensor(
+    Player player, TensorView<3, T>& view) const {
+  for (int r = 0; r < kRows; r++) {
+    for (int c = 0; c < kCols; c++) {
+      int plane = ObservationPlane({r, c}, player);
+      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
+      view[{plane, r, c}] = 1.0;
+    }
+  }
+}
+
 void CoopBoxPushingState::ObservationTensor(Player player,
                                             std::vector<double>* values) const {
   if (fully_observable_) {
     TensorView<3> view(values, {kCellStates, kRows, kCols}, true);
-
-    for (int r = 0; r < kRows; r++) {
-      for (int c = 0; c < kCols; c++) {
-        int plane = ObservationPlane({r, c}, player);
-        SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
-        view[{plane, r, c}] = 1.0;
-      }
-    }
+    WriteObservationTensor(player, view);
   } else {
     values->resize(kNumObservations);
     std::fill(values->begin(), values->end(), 0);
@@ -526,6 +531,19 @@ void CoopBoxPushingState::ObservationTensor(Player player,
   }
 }
 
+void CoopBoxPushingState::ObservationTensor(Player player,
+                                            absl::Span<float> values) const {
+  if (fully_observable_) {
+    TensorView<3, float> view(values, {kCellStates, kRows, kCols}, true);
+    WriteObservationTensor(player, view);
+  } else {
+    SPIEL_CHECK_EQ(values.size(), kNumObservations);
+    std::fill(values.begin(), values.end(), 0);
+    ObservationType obs = PartialObservation(player);
+    values[obs] = 1;
+  }
+}
+
 std::unique_ptr<State> CoopBoxPushingState::Clone() const {
   return std::unique_ptr<State>(new CoopBoxPushingState(*this));
 }
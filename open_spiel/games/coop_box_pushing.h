@@ -20,8 +20,10 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // This is the cooperative box-pushing domain presented by Seuken & Zilberstein
 // in their paper "Improved Memory-Bounded Dynamic Programming for Dec-POMDPs"
@@ -77,6 +79,8 @@ class CoopBoxPushingState : public SimMoveState {
   std::vector<double> Rewards() const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::string ObservationString(Player player) const override;
 
   Player CurrentPlayer() const override {
@@ -94,6 +98,10 @@ class CoopBoxPushingState : public SimMoveState {
   void DoApplyActions(const std::vector<Action>& actions) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<3, T>& view) const;
   void SetField(std::pair<int, int> coord, char v);
   void SetPlayer(std::pair<int, int> coord, Player player,
                  OrientationType orientation);
@@ -73,6 +73,7 @@ class DeepSeaState : public State {
                               std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action move) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<Action> LegalActions() const override;
 
  protected:
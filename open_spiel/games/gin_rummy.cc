@@ -15,7 +15,10 @@
 #include "open_spiel/games/gin_rummy.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <utility>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
@@ -24,6 +27,7 @@
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/gin_rummy/gin_rummy_utils.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/card_deal.h"
 
 namespace open_spiel {
 namespace gin_rummy {
@@ -77,6 +81,20 @@ int GinRummyState::CurrentPlayer() const {
 }
 
 void GinRummyState::DoApplyAction(Action action) {
+  undo_info_.push_back(
+      {phase_,
+       cur_player_,
+       prev_player_,
+       finished_layoffs_,
+       upcard_,
+       prev_upcard_,
+       repeated_move_,
+       num_draw_upcard_actions_,
+       knock_card_,
+       {deadwood_[0], deadwood_[1]},
+       {knocked_[0], knocked_[1]},
+       {pass_on_first_upcard_[0], pass_on_first_upcard_[1]},
+       {}});
   switch (phase_) {
     case Phase::kDeal:
       return ApplyDealAction(action);
@@ -248,7 +266,7 @@ void GinRummyState::ApplyKnockAction(Action action) {
     SPIEL_CHECK_GE(action - kMeldActionBase, 0);
     layed_melds_[cur_player_].push_back(action - kMeldActionBase);
     // Upon laying a meld the cards are removed from the player's hand.
-    for (int card : int_to_meld.at(action - kMeldActionBase)) {
+    for (int card : IntToMeldMap().at(action - kMeldActionBase)) {
       RemoveFromHand(cur_player_, card);
     }
     deadwood_[cur_player_] = TotalCardValue(hands_[cur_player_]);
@@ -279,7 +297,7 @@ void GinRummyState::ApplyLayoffAction(Action action) {
       SPIEL_CHECK_GE(action - kMeldActionBase, 0);
       layed_melds_[cur_player_].push_back(action - kMeldActionBase);
       // Upon laying a meld the cards are removed from the player's hand.
-      for (int card : int_to_meld.at(action - kMeldActionBase))
+      for (int card : IntToMeldMap().at(action - kMeldActionBase))
         RemoveFromHand(cur_player_, card);
       deadwood_[cur_player_] = TotalCardValue(hands_[cur_player_]);
       phase_ = Phase::kLayoff;
@@ -453,7 +471,7 @@ std::string GinRummyState::ActionToString(Player player, Action action) const {
     } else if (action == kKnockAction) {
       action_str = "Knock";
     } else if (action < kMeldActionBase + kNumMeldActions) {
-      std::vector<int> meld = int_to_meld.at(action - kMeldActionBase);
+      std::vector<int> meld = IntToMeldMap().at(action - kMeldActionBase);
       std::vector<std::string> meld_str = CardIntsToCardStrings(meld);
       action_str = absl::StrJoin(meld_str, "");
     } else {
@@ -481,7 +499,7 @@ std::string GinRummyState::ToString() const {
     absl::StrAppend(&rv, "\nLayed melds:");
     for (int meld_id : layed_melds_[1]) {
       absl::StrAppend(&rv, " ");
-      std::vector<int> meld = int_to_meld.at(meld_id);
+      std::vector<int> meld = IntToMeldMap().at(meld_id);
       for (int card : meld) absl::StrAppend(&rv, CardString(card));
     }
   }
@@ -499,7 +517,7 @@ std::string GinRummyState::ToString() const {
     absl::StrAppend(&rv, "\nLayed melds:");
     for (int meld_id : layed_melds_[0]) {
       absl::StrAppend(&rv, " ");
-      std::vector<int> meld = int_to_meld.at(meld_id);
+      std::vector<int> meld = IntToMeldMap().at(meld_id);
       for (int card : meld) absl::StrAppend(&rv, CardString(card));
     }
   }
@@ -556,15 +574,183 @@ void GinRummyState::UpcardToHand(Player player) {
 }
 
 void GinRummyState::RemoveFromHand(Player player, Action card) {
-  hands_[player].erase(
-      std::remove(hands_[player].begin(), hands_[player].end(), card),
-      hands_[player].end());
+  std::vector<int>& hand = hands_[player];
+  auto it = std::find(hand.begin(), hand.end(), card);
+  SPIEL_CHECK_TRUE(it != hand.end());
+  undo_info_.back().removed_cards.emplace_back(card, it - hand.begin());
+  hand.erase(it);
+}
+
+void GinRummyState::RestoreToHand(Player player) {
+  const auto& removed_cards = undo_info_.back().removed_cards;
+  for (auto it = removed_cards.rbegin(); it != removed_cards.rend(); ++it) {
+    hands_[player].insert(hands_[player].begin() + it->second, it->first);
+  }
+}
+
+void GinRummyState::UndoAction(Player player, Action action) {
+  const UndoInfo& info = undo_info_.back();
+  const Player actor = info.cur_player;
+  switch (info.phase) {
+    case Phase::kDeal:
+      deck_[action] = true;
+      ++stock_size_;
+      // All but the first upcard were dealt to a hand.
+      if (stock_size_ != kNumCards - 2 * kHandSize) {
+        const Player receiver = stock_size_ > kNumCards - kHandSize ? 0
+                                : stock_size_ > kNumCards - 2 * kHandSize
+                                    ? 1
+                                    : info.prev_player;
+        hands_[receiver].pop_back();
+      }
+      break;
+    case Phase::kFirstUpcard:
+    case Phase::kDraw:
+      if (action == kDrawUpcardAction) {
+        // Unless the game ended on too many upcard draws.
+        if (phase_ != Phase::kGameOver) hands_[actor].pop_back();
+      } else if (action == kDrawStockAction) {
+        if (info.upcard.has_value()) discard_pile_.pop_back();
+      }
+      break;
+    case Phase::kDiscard:
+      if (action != kKnockAction) RestoreToHand(actor);
+      break;
+    case Phase::kKnock:
+      if (action < kNumCards) {
+        discard_pile_.pop_back();
+      } else if (action != kPassAction) {
+        layed_melds_[actor].pop_back();
+      }
+      RestoreToHand(actor);
+      break;
+    case Phase::kLayoff:
+      if (action != kPassAction) {
+        if (info.finished_layoffs) {
+          layed_melds_[actor].pop_back();
+        } else {
+          layoffs_.pop_back();
+        }
+      }
+      RestoreToHand(actor);
+      break;
+    case Phase::kWall:
+      if (action == kKnockAction) hands_[actor].pop_back();
+      break;
+    case Phase::kGameOver:
+      SpielFatalError("No action is taken in terminal states");
+  }
+  phase_ = info.phase;
+  cur_player_ = info.cur_player;
+  prev_player_ = info.prev_player;
+  finished_layoffs_ = info.finished_layoffs;
+  upcard_ = info.upcard;
+  prev_upcard_ = info.prev_upcard;
+  repeated_move_ = info.repeated_move;
+  num_draw_upcard_actions_ = info.num_draw_upcard_actions;
+  knock_card_ = info.knock_card;
+  for (int i = 0; i < kNumPlayers; ++i) {
+    deadwood_[i] = info.deadwood[i];
+    knocked_[i] = info.knocked[i];
+    pass_on_first_upcard_[i] = info.pass_on_first_upcard[i];
+  }
+  undo_info_.pop_back();
+  history_.pop_back();
 }
 
 std::unique_ptr<State> GinRummyState::Clone() const {
   return std::unique_ptr<State>(new GinRummyState(*this));
 }
 
+std::unique_ptr<State> GinRummyState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  SPIEL_CHECK_FALSE(IsTerminal());
+  const Player opponent = Opponent(player_id);
+  // Once the opponent has knocked, which cards they can lay down depends on
+  // their deadwood, and is not sampled: the state is kept as it is.
+  if (knocked_[opponent]) return Clone();
+
+  // Walks the history for the cards dealt to the opponent, which are hidden,
+  // and the cards the opponent showed since. A card shown which the
+  // opponent did not take from the upcard was dealt to them earlier.
+  std::unique_ptr<State> walk = game_->NewInitialState();
+  const auto& walk_state = static_cast<const GinRummyState&>(*walk);
+  std::vector<int> hidden_deals;  // Their positions in the history.
+  uint64_t seen_cards = 0;        // Dealt to the player or the upcard.
+  uint64_t upcards_held = 0;      // Taken by the opponent from the upcard.
+  // Each card shown, with the number of hidden deals before it was shown.
+  std::vector<std::pair<int, int>> shown_cards;
+  auto show = [&](int card) {
+    const uint64_t bit = uint64_t{1} << card;
+    if (upcards_held & bit) {
+      upcards_held &= ~bit;
+    } else {
+      SPIEL_CHECK_FALSE(hidden_deals.empty());
+      shown_cards.push_back({hidden_deals.size(), card});
+    }
+  };
+  for (int i = 0; i < history_.size(); ++i) {
+    const Action action = history_[i];
+    if (walk->IsChanceNode()) {
+      // As in ApplyDealAction.
+      const int num_dealt = kNumCards - walk_state.stock_size_;
+      Player receiver = walk_state.prev_player_;
+      if (num_dealt < kHandSize) {
+        receiver = 0;
+      } else if (num_dealt < 2 * kHandSize) {
+        receiver = 1;
+      } else if (num_dealt == 2 * kHandSize) {
+        receiver = kChancePlayerId;  // The first upcard.
+      }
+      if (receiver == opponent) {
+        hidden_deals.push_back(i);
+      } else {
+        seen_cards |= uint64_t{1} << action;
+      }
+    } else if (walk->CurrentPlayer() == opponent) {
+      if (action == kDrawUpcardAction) {
+        upcards_held |= uint64_t{1} << walk_state.upcard_.value();
+      } else if (action < kNumCards) {
+        show(action);
+      } else if (action >= kMeldActionBase) {
+        for (int card : IntToMeldMap().at(action - kMeldActionBase)) show(card);
+      }
+    }
+    walk->ApplyAction(action);
+  }
+
+  // Deals each card shown to the opponent before it was shown, in order of
+  // the deadlines, then the others from the cards never seen: this is
+  // uniform among the deals consistent with what the player saw.
+  SPIEL_CHECK_LE(hidden_deals.size(), 64);
+  uint64_t unseen_cards = ((uint64_t{1} << kNumCards) - 1) & ~seen_cards;
+  absl::c_sort(shown_cards);
+  std::vector<Action> cards(hidden_deals.size(), kInvalidAction);
+  uint64_t free_deals = hidden_deals.size() == 64
+                            ? ~uint64_t{0}
+                            : (uint64_t{1} << hidden_deals.size()) - 1;
+  for (const auto& [num_deals, card] : shown_cards) {
+    uint64_t candidates = free_deals & ((uint64_t{1} << num_deals) - 1);
+    const uint64_t deal = TakeRandomCards(&candidates, 1, rng);
+    free_deals &= ~deal;
+    cards[__builtin_ctzll(deal)] = card;
+    unseen_cards &= ~(uint64_t{1} << card);
+  }
+  for (Action& card : cards) {
+    if (card == kInvalidAction) {
+      card = __builtin_ctzll(TakeRandomCards(&unseen_cards, 1, rng));
+    }
+  }
+
+  std::vector<Action> history = history_;
+  for (int i = 0; i < hidden_deals.size(); ++i) {
+    history[hidden_deals[i]] = cards[i];
+  }
+  std::unique_ptr<State> state = game_->NewInitialState();
+  for (Action action : history) state->ApplyAction(action);
+  return state;
+}
+
 std::string GinRummyState::ObservationString(Player player) const {
   // Built from ObservationTensor to provide an extra check.
   std::vector<double> tensor(game_->ObservationTensorSize());
@@ -607,7 +793,7 @@ std::string GinRummyState::ObservationString(Player player) const {
   if (!layed_melds.empty()) {
     absl::StrAppend(&rv, "\nOpponent melds: ");
     for (int meld_id : layed_melds) {
-      std::vector<int> meld = int_to_meld.at(meld_id);
+      std::vector<int> meld = IntToMeldMap().at(meld_id);
       for (int card : meld) absl::StrAppend(&rv, CardString(card));
       absl::StrAppend(&rv, " ");
     }
@@ -36,11 +36,15 @@
 //  "gin_bonus"       int    bonus for getting gin         (default = 25)
 //  "undercut_bonus"  int    bonus for an undercut         (default = 25)
 
+#include <array>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/inlined_vector.h"
 #include "open_spiel/games/gin_rummy/gin_rummy_utils.h"
 #include "open_spiel/spiel.h"
 
@@ -85,8 +89,12 @@ class GinRummyState : public State {
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<Action> LegalActions() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
 
  protected:
   void DoApplyAction(Action action) override;
@@ -127,7 +135,10 @@ class GinRummyState : public State {
   void StockToUpcard(Action card);
   void UpcardToHand(Player player);
   void HandToUpcard(Player player, Action card);
+  // Records where the card was in undo_info_.back().
   void RemoveFromHand(Player player, Action card);
+  // Puts back the cards removed by the last action, in their places.
+  void RestoreToHand(Player player);
 
   int Opponent(int player) const { return 1 - player; }
 
@@ -175,6 +186,27 @@ class GinRummyState : public State {
       std::vector<std::vector<int>>(kNumPlayers, std::vector<int>());
   // Cards that have been layed off onto knocking player's layed melds.
   std::vector<int> layoffs_{};
+
+  // The fixed-size fields before an action, and where the cards it removed
+  // from the hand were, kept for UndoAction. The cards the action moved are
+  // moved back according to the phase.
+  struct UndoInfo {
+    Phase phase;
+    Player cur_player;
+    Player prev_player;
+    bool finished_layoffs;
+    std::optional<int> upcard;
+    std::optional<int> prev_upcard;
+    bool repeated_move;
+    int num_draw_upcard_actions;
+    int knock_card;
+    std::array<int, kNumPlayers> deadwood;
+    std::array<bool, kNumPlayers> knocked;
+    std::array<bool, kNumPlayers> pass_on_first_upcard;
+    // The removed cards with their indices in the hand, in removal order.
+    absl::InlinedVector<std::pair<int, int>, 5> removed_cards;
+  };
+  std::vector<UndoInfo> undo_info_;
 };
 
 class GinRummyGame : public Game {
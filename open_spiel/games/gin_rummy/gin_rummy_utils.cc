@@ -15,8 +15,11 @@
 #include "open_spiel/games/gin_rummy/gin_rummy_utils.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
 #include "open_spiel/spiel.h"
@@ -306,33 +309,108 @@ VecVecInt BestMeldGroup(const VecInt &cards) {
   return best_meld_group;
 }
 
-// Minimum deadwood count over all meld groups.
-int MinDeadwood(VecInt hand, std::optional<int> card) {
-  if (card.has_value()) hand.push_back(card.value());
-  return MinDeadwood(hand);
+namespace {
+
+struct MeldTables {
+  MeldTables();
+  std::array<CardMask, kNumMelds> melds;
+  // The melds of each card that is their lowest card.
+  std::array<std::vector<CardMask>, kNumCards> melds_by_lowest_card;
+};
+
+MeldTables::MeldTables() {
+  VecInt full_deck;
+  for (int i = 0; i < kNumCards; ++i) full_deck.push_back(i);
+  for (const VecInt &meld : AllMelds(full_deck)) {
+    const CardMask mask = CardsToMask(meld);
+    melds[MeldToInt(meld)] = mask;
+    melds_by_lowest_card[__builtin_ctzll(mask)].push_back(mask);
+  }
 }
 
-// Minimum deadwood count over all meld groups.
-int MinDeadwood(const VecInt &hand) {
-  VecInt deadwood = hand;
-  VecVecInt best_melds = BestMeldGroup(hand);
+const MeldTables &GetMeldTables() {
+  static const auto *tables = new MeldTables();
+  return *tables;
+}
 
-  for (auto meld : best_melds) {
-    for (auto card : meld) {
-      deadwood.erase(std::remove(deadwood.begin(), deadwood.end(), card),
-                     deadwood.end());
-    }
+// Finds the minimum deadwood of the sub-hands of a hand. A sub-hand splits on
+// its lowest card, which is either deadwood, discarded, or the lowest card of
+// one of its melds, and the results are memoized by sub-hand.
+class DeadwoodSolver {
+ public:
+  explicit DeadwoodSolver(CardMask hand) : hand_(hand) {
+    SPIEL_CHECK_LE(__builtin_popcountll(hand), kMaxHandSize);
+    memo_.fill(-1);
   }
-  // If we have 11 cards we can discard one.
-  if (hand.size() == kMaxHandSize && !deadwood.empty()) {
-    absl::c_sort(deadwood, CompareRanks);
-    deadwood.pop_back();
+
+  int Solve(CardMask cards, bool can_discard);
+
+ private:
+  // The index of a sub-hand among the subsets of the hand.
+  int SubsetIndex(CardMask cards) const;
+
+  CardMask hand_;
+  // By sub-hand and whether a card can still be discarded.
+  std::array<int8_t, 2 << kMaxHandSize> memo_;
+};
+
+int DeadwoodSolver::SubsetIndex(CardMask cards) const {
+  int index = 0;
+  int bit = 0;
+  for (CardMask rest = hand_; rest; rest &= rest - 1, ++bit) {
+    if (cards & rest & -rest) index |= 1 << bit;
   }
-  int deadwood_total = 0;
-  for (int card : deadwood) deadwood_total += CardValue(card);
-  return deadwood_total;
+  return index;
+}
+
+int DeadwoodSolver::Solve(CardMask cards, bool can_discard) {
+  if (!cards) return 0;
+  const int key = (SubsetIndex(cards) << 1) | can_discard;
+  if (memo_[key] >= 0) return memo_[key];
+  const int card = __builtin_ctzll(cards);
+  const CardMask rest = cards & (cards - 1);
+  int deadwood = CardValue(card) + Solve(rest, can_discard);
+  if (can_discard) deadwood = std::min(deadwood, Solve(rest, false));
+  for (CardMask meld : GetMeldTables().melds_by_lowest_card[card]) {
+    if ((cards & meld) == meld) {
+      deadwood = std::min(deadwood, Solve(cards & ~meld, can_discard));
+    }
+  }
+  memo_[key] = deadwood;
+  return deadwood;
+}
+
+// The minimum deadwood of a hand without discarding.
+int MeldedDeadwood(CardMask hand) {
+  return DeadwoodSolver(hand).Solve(hand, /*can_discard=*/false);
 }
 
+}  // namespace
+
+CardMask CardsToMask(const VecInt &cards) {
+  CardMask mask = 0;
+  for (int card : cards) mask |= CardMask{1} << card;
+  return mask;
+}
+
+const std::array<CardMask, kNumMelds> &MeldMasks() {
+  return GetMeldTables().melds;
+}
+
+int MinDeadwood(CardMask hand) {
+  return DeadwoodSolver(hand).Solve(
+      hand, /*can_discard=*/__builtin_popcountll(hand) == kMaxHandSize);
+}
+
+// Minimum deadwood count over all meld groups.
+int MinDeadwood(VecInt hand, std::optional<int> card) {
+  if (card.has_value()) hand.push_back(card.value());
+  return MinDeadwood(CardsToMask(hand));
+}
+
+// Minimum deadwood count over all meld groups.
+int MinDeadwood(const VecInt &hand) { return MinDeadwood(CardsToMask(hand)); }
+
 // Returns the one card that can be layed off on a three card rank meld.
 int RankMeldLayoff(const VecInt &meld) {
   SPIEL_CHECK_EQ(meld.size(), 3);
@@ -365,19 +443,18 @@ VecInt SuitMeldLayoffs(const VecInt &meld) {
 // melds leaves only the 8d for 8 points.
 // Returns vector of meld_ids (see MeldToInt).
 VecInt LegalMelds(const VecInt &hand, int knock_card) {
-  int total_hand_value = TotalCardValue(hand);
-  std::set<int> meld_set;
-  VecInt hand_(hand);
-  VecVecVecInt all_meld_groups = AllMeldGroups(hand_);
-  for (auto meld_group : all_meld_groups) {
-    int meld_group_total_value = TotalCardValue(meld_group);
-    if (total_hand_value - meld_group_total_value <= knock_card) {
-      for (auto meld : meld_group) {
-        meld_set.insert(meld_to_int.at(meld));
-      }
+  // A meld can be layed if the rest of the hand can be arranged to leave
+  // little enough deadwood.
+  const CardMask hand_mask = CardsToMask(hand);
+  VecInt legal_melds;
+  for (int meld_id = 0; meld_id < kNumMelds; ++meld_id) {
+    const CardMask meld = MeldMasks()[meld_id];
+    if ((hand_mask & meld) == meld &&
+        MeldedDeadwood(hand_mask & ~meld) <= knock_card) {
+      legal_melds.push_back(meld_id);
     }
   }
-  return VecInt(meld_set.begin(), meld_set.end());
+  return legal_melds;
 }
 
 // Returns the legal discards when a player has knocked. Normally a player can
@@ -385,22 +462,21 @@ VecInt LegalMelds(const VecInt &hand, int knock_card) {
 // discard a card that preseves the ability to arrange the hand so that the
 // total deadwood is less than the knock card.
 VecInt LegalDiscards(const VecInt &hand, int knock_card) {
-  std::set<int> legal_discards;
-  for (int i = 0; i < hand.size(); ++i) {
-    VecInt hand_(hand);
-    hand_.erase(hand_.begin() + i);
-    int deadwood = MinDeadwood(hand_);
-    if (deadwood <= knock_card) {
-      legal_discards.insert(hand[i]);
+  const CardMask hand_mask = CardsToMask(hand);
+  VecInt legal_discards;
+  for (CardMask rest = hand_mask; rest; rest &= rest - 1) {
+    const CardMask card = rest & -rest;
+    if (MinDeadwood(hand_mask & ~card) <= knock_card) {
+      legal_discards.push_back(__builtin_ctzll(card));
     }
   }
-  return VecInt(legal_discards.begin(), legal_discards.end());
+  return legal_discards;
 }
 
 VecInt AllLayoffs(const VecInt &layed_melds, const VecInt &previous_layoffs) {
   std::set<int> layoffs;
   for (int meld_id : layed_melds) {
-    VecInt meld = int_to_meld.at(meld_id);
+    VecInt meld = IntToMeldMap().at(meld_id);
     if (IsRankMeld(meld) && meld.size() == 3) {
       layoffs.insert(RankMeldLayoff(meld));
     } else if (IsSuitMeld(meld)) {
@@ -452,6 +528,18 @@ std::map<int, VecInt> BuildIntToMeldMap() {
   return rv;
 }
 
+const std::map<int, VecInt> &IntToMeldMap() {
+  static const auto *int_to_meld =
+      new std::map<int, VecInt>(BuildIntToMeldMap());
+  return *int_to_meld;
+}
+
+const std::map<VecInt, int> &MeldToIntMap() {
+  static const auto *meld_to_int =
+      new std::map<VecInt, int>(BuildMeldToIntMap());
+  return *meld_to_int;
+}
+
 // Defines a mapping from melds to ints.
 // There are 185 distinct melds in total, 65 rank melds and 120 suit melds.
 // Rank melds are ordered by ascending rank. For each rank, there are 5 melds.
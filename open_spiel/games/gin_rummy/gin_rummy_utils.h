@@ -15,7 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_GIN_RUMMY_UTILS_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_GIN_RUMMY_UTILS_H_
 
+#include <array>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,11 +29,15 @@ inline constexpr int kNumSuits = 4;
 inline constexpr int kNumRanks = 13;
 inline constexpr int kNumCards = kNumSuits * kNumRanks;
 inline constexpr int kMaxHandSize = 11;
+inline constexpr int kNumMelds = 185;
 
 using VecInt = std::vector<int>;
 using VecVecInt = std::vector<std::vector<int>>;
 using VecVecVecInt = std::vector<std::vector<std::vector<int>>>;
 
+// A set of cards as a bitmask, with bit i set for card i.
+using CardMask = uint64_t;
+
 std::string CardString(std::optional<int> card);
 std::string HandToString(const VecInt &cards);
 
@@ -66,6 +73,14 @@ VecVecVecInt AllMeldGroups(const VecInt &cards);
 
 VecVecInt BestMeldGroup(const VecInt &cards);
 
+CardMask CardsToMask(const VecInt &cards);
+// The cards of each meld, indexed by meld id (see MeldToInt).
+const std::array<CardMask, kNumMelds> &MeldMasks();
+
+// The minimum deadwood over all meld groups of a hand. A hand of kMaxHandSize
+// cards discards one card first. The hand is split by a memoized search over
+// its sub-hands, rather than by enumerating the meld groups.
+int MinDeadwood(CardMask hand);
 int MinDeadwood(VecInt hand, std::optional<int> card);
 int MinDeadwood(const VecInt &hand);
 
@@ -82,8 +97,10 @@ int MeldToInt(VecInt meld);
 std::map<VecInt, int> BuildMeldToIntMap();
 std::map<int, VecInt> BuildIntToMeldMap();
 
-static const std::map<int, VecInt> int_to_meld = BuildIntToMeldMap();
-static const std::map<VecInt, int> meld_to_int = BuildMeldToIntMap();
+// The maps built by the functions above, built on first use rather than when
+// the library is loaded.
+const std::map<int, VecInt> &IntToMeldMap();
+const std::map<VecInt, int> &MeldToIntMap();
 
 }  // namespace gin_rummy
 }  // namespace open_spiel
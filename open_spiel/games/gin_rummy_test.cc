@@ -28,6 +28,8 @@ namespace testing = open_spiel::testing;
 void BasicGameTests() {
   testing::LoadGameTest("gin_rummy");
   testing::RandomSimTest(*LoadGame("gin_rummy"), 10);
+  testing::RandomSimTestWithUndo(*LoadGame("gin_rummy"), 10);
+  testing::ResampleInfostateTest(*LoadGame("gin_rummy"), /*num_sims=*/5);
 }
 
 void MeldTests() {
@@ -61,28 +63,28 @@ void MeldTests() {
   SPIEL_CHECK_FALSE(IsRankMeld(CardStringsToCardInts(cards)));
   SPIEL_CHECK_FALSE(IsSuitMeld(CardStringsToCardInts(cards)));
 
-  // Check that the meld_to_int and int_to_meld maps work correctly.
+  // Check that the MeldToIntMap and IntToMeldMap maps work correctly.
   int meld_id;
   cards = {"Ks", "Kc", "Kd", "Kh"};
-  meld_id = meld_to_int.at(CardStringsToCardInts(cards));
+  meld_id = MeldToIntMap().at(CardStringsToCardInts(cards));
   SPIEL_CHECK_EQ(meld_id, 64);
-  SPIEL_CHECK_EQ(meld_to_int.at(int_to_meld.at(64)), 64);
+  SPIEL_CHECK_EQ(MeldToIntMap().at(IntToMeldMap().at(64)), 64);
   cards = {"As", "2s", "3s"};
-  meld_id = meld_to_int.at(CardStringsToCardInts(cards));
+  meld_id = MeldToIntMap().at(CardStringsToCardInts(cards));
   SPIEL_CHECK_EQ(meld_id, 65);
-  SPIEL_CHECK_EQ(meld_to_int.at(int_to_meld.at(65)), 65);
+  SPIEL_CHECK_EQ(MeldToIntMap().at(IntToMeldMap().at(65)), 65);
   cards = {"As", "2s", "3s", "4s"};
-  meld_id = meld_to_int.at(CardStringsToCardInts(cards));
+  meld_id = MeldToIntMap().at(CardStringsToCardInts(cards));
   SPIEL_CHECK_EQ(meld_id, 109);
-  SPIEL_CHECK_EQ(meld_to_int.at(int_to_meld.at(109)), 109);
+  SPIEL_CHECK_EQ(MeldToIntMap().at(IntToMeldMap().at(109)), 109);
   cards = {"As", "2s", "3s", "4s", "5s"};
-  meld_id = meld_to_int.at(CardStringsToCardInts(cards));
+  meld_id = MeldToIntMap().at(CardStringsToCardInts(cards));
   SPIEL_CHECK_EQ(meld_id, 149);
-  SPIEL_CHECK_EQ(meld_to_int.at(int_to_meld.at(149)), 149);
+  SPIEL_CHECK_EQ(MeldToIntMap().at(IntToMeldMap().at(149)), 149);
   cards = {"9h", "Th", "Jh", "Qh", "Kh"};
-  meld_id = meld_to_int.at(CardStringsToCardInts(cards));
+  meld_id = MeldToIntMap().at(CardStringsToCardInts(cards));
   SPIEL_CHECK_EQ(meld_id, 184);
-  SPIEL_CHECK_EQ(meld_to_int.at(int_to_meld.at(184)), 184);
+  SPIEL_CHECK_EQ(MeldToIntMap().at(IntToMeldMap().at(184)), 184);
 
   // Should find five rank melds and one suit meld.
   // +--------------------------+
@@ -123,6 +125,28 @@ void MeldTests() {
     std::cout << CardIntsToCardStrings(meld) << std::endl;
   int deadwood = MinDeadwood(card_ints);
   SPIEL_CHECK_EQ(deadwood, 3);
+
+  // +--------------------------+
+  // |          6s              |
+  // |      4c      8c  Tc      |
+  // |          6d  8d9dTd      |
+  // |              8h9hTh      |
+  // +--------------------------+
+  // Melding 8d9dTd, 8h9hTh leaves as much deadwood as 8c8d8h, TcTdTh, but
+  // the Tc can then be discarded, leaving 24 deadwood rather than 25.
+  cards = {"6s", "4c", "8c", "Tc", "6d", "8d", "9d", "Td", "8h", "9h", "Th"};
+  card_ints = CardStringsToCardInts(cards);
+  SPIEL_CHECK_EQ(MinDeadwood(card_ints), 24);
+  SPIEL_CHECK_EQ(MinDeadwood(CardsToMask(card_ints)), 24);
+  for (int card : card_ints) {
+    std::vector<int> hand = card_ints;
+    hand.erase(absl::c_find(hand, card));
+    SPIEL_CHECK_GE(MinDeadwood(hand), 24);
+  }
+  for (int meld_id = 0; meld_id < kNumMelds; ++meld_id) {
+    SPIEL_CHECK_EQ(MeldMasks()[meld_id],
+                   CardsToMask(IntToMeldMap().at(meld_id)));
+  }
 }
 
 // An extremely rare situation, but one that does arise in actual gameplay.
@@ -14,7 +14,10 @@
 
 #include "open_spiel/games/go.h"
 
+#include <algorithm>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/games/go/go_board.h"
@@ -99,32 +102,55 @@ void GoState::ObservationTensor(int player, std::vector<double>* values) const {
 
   int num_cells = board_.board_size() * board_.board_size();
   values->resize(num_cells * (CellStates() + 1));
-  std::fill(values->begin(), values->end(), 0.);
 
   // Add planes: black, white, empty.
-  int cell = 0;
-  for (VirtualPoint p : BoardPoints(board_.board_size())) {
-    int color_val = static_cast<int>(board_.PointColor(p));
-    (*values)[num_cells * color_val + cell] = 1.0;
-    ++cell;
-  }
-  SPIEL_CHECK_EQ(cell, num_cells);
+  std::copy(point_planes_.begin(), point_planes_.end(), values->begin());
 
   // Add a fourth binary plane for komi (whether white is to play).
   std::fill(values->begin() + (CellStates() * num_cells), values->end(),
             (to_play_ == GoColor::kWhite ? 1.0 : 0.0));
 }
 
+void GoState::ObservationTensor(int player, absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  int num_cells = board_.board_size() * board_.board_size();
+  SPIEL_CHECK_EQ(values.size(), num_cells * (CellStates() + 1));
+
+  // Same planes as the std::vector<double> version above.
+  std::copy(point_planes_.begin(), point_planes_.end(), values.begin());
+  std::fill(values.begin() + (CellStates() * num_cells), values.end(),
+            (to_play_ == GoColor::kWhite ? 1.0f : 0.0f));
+}
+
+bool GoState::UpdatePointPlanes(VirtualPoint p) {
+  const int num_cells = board_.board_size() * board_.board_size();
+  const std::pair<int, int> row_col = VirtualPointTo2DPoint(p);
+  const int cell = row_col.first * board_.board_size() + row_col.second;
+  const int color_val = static_cast<int>(board_.PointColor(p));
+  if (point_planes_[num_cells * color_val + cell] == 1.0f) return false;
+  for (int c = 0; c < CellStates(); ++c) {
+    point_planes_[num_cells * c + cell] = c == color_val ? 1.0f : 0.0f;
+  }
+  return true;
+}
+
 std::vector<Action> GoState::LegalActions() const {
-  std::vector<Action> actions{};
-  if (IsTerminal()) return actions;
+  std::vector<Action> actions;
+  LegalActions(&actions);
+  return actions;
+}
+
+void GoState::LegalActions(std::vector<Action>* actions) const {
+  actions->clear();
+  if (IsTerminal()) return;
   for (VirtualPoint p : BoardPoints(board_.board_size())) {
     if (board_.IsLegalMove(p, to_play_)) {
-      actions.push_back(board_.VirtualActionToAction(p));
+      actions->push_back(board_.VirtualActionToAction(p));
     }
   }
-  actions.push_back(board_.pass_action());
-  return actions;
+  actions->push_back(board_.pass_action());
 }
 
 std::string GoState::ActionToString(Player player, Action action) const {
@@ -180,6 +206,35 @@ std::unique_ptr<State> GoState::Clone() const {
   return std::unique_ptr<State>(new GoState(*this));
 }
 
+bool GoState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const GoState&>(other);
+  State::operator=(state);
+  board_ = state.board_;
+  point_planes_ = state.point_planes_;
+  repetitions_ = state.repetitions_;
+  to_play_ = state.to_play_;
+  superko_ = state.superko_;
+  return true;
+}
+
+uint64_t GoState::Hash() const {
+  // Besides the stones, the continuation depends on the player to move and on
+  // trailing passes (two consecutive passes end the game).
+  int trailing_passes = 0;
+  for (auto it = history_.rbegin();
+       it != history_.rend() && *it == board_.pass_action() &&
+       trailing_passes < 2;
+       ++it) {
+    ++trailing_passes;
+  }
+  uint64_t extra = (static_cast<int>(to_play_) * 3 + trailing_passes) * 2 +
+                   (IsTerminal() ? 1 : 0);
+  return board_.HashValue() ^ HashMix(extra);
+}
+
 void GoState::UndoAction(Player player, Action action) {
   // We don't have direct undo functionality, but copying the board and
   // replaying all actions is still pretty fast (> 1 million undos/second).
@@ -191,10 +246,26 @@ void GoState::UndoAction(Player player, Action action) {
 }
 
 void GoState::DoApplyAction(Action action) {
-  SPIEL_CHECK_TRUE(
-      board_.PlayMove(board_.ActionToVirtualAction(action), to_play_));
+  const VirtualPoint point = board_.ActionToVirtualAction(action);
+  SPIEL_CHECK_TRUE(board_.PlayMove(point, to_play_));
   to_play_ = OppColor(to_play_);
 
+  // Besides the point played, a move only changes the stones it captures,
+  // which are connected to it through changed points.
+  if (action != board_.pass_action() && UpdatePointPlanes(point)) {
+    std::vector<VirtualPoint> changed = {point};
+    while (!changed.empty()) {
+      const VirtualPoint p = changed.back();
+      changed.pop_back();
+      for (VirtualPoint n : {p - 1, p + 1, p - kVirtualBoardSize,
+                             p + kVirtualBoardSize}) {
+        if (board_.IsInBoardArea(n) && UpdatePointPlanes(n)) {
+          changed.push_back(n);
+        }
+      }
+    }
+  }
+
   bool was_inserted = repetitions_.insert(board_.HashValue()).second;
   if (!was_inserted && action != board_.pass_action()) {
     // We have encountered this position before.
@@ -216,6 +287,16 @@ void GoState::ResetBoard() {
   repetitions_.clear();
   repetitions_.insert(board_.HashValue());
   superko_ = false;
+
+  const int num_cells = board_.board_size() * board_.board_size();
+  point_planes_.assign(num_cells * CellStates(), 0.0f);
+  int cell = 0;
+  for (VirtualPoint p : BoardPoints(board_.board_size())) {
+    int color_val = static_cast<int>(board_.PointColor(p));
+    point_planes_[num_cells * color_val + cell] = 1.0f;
+    ++cell;
+  }
+  SPIEL_CHECK_EQ(cell, num_cells);
 }
 
 GoGame::GoGame(const GameParameters& params)
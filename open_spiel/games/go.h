@@ -20,9 +20,10 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_set.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/games/go/go_board.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -74,6 +75,7 @@ class GoState : public State {
     return IsTerminal() ? kTerminalPlayerId : ColorToPlayer(to_play_);
   }
   std::vector<Action> LegalActions() const override;
+  void LegalActions(std::vector<Action>* actions) const override;
   std::string ActionToString(Player player, Action action) const override;
   std::string ToString() const override;
 
@@ -86,13 +88,24 @@ class GoState : public State {
   // (whether white is to play).
   void ObservationTensor(int player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(int player, absl::Span<float> values) const override;
 
   std::vector<double> Returns() const override;
 
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  uint64_t Hash() const override;
   void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
 
   const GoBoard& board() const { return board_; }
+  float komi() const { return komi_; }
+  int handicap() const { return handicap_; }
+  GoColor to_play() const { return to_play_; }
+
+  // The black, white and empty planes at the start of ObservationTensor. They
+  // are kept up to date as moves are played, for the points each one changes.
+  absl::Span<const float> PointPlanes() const { return point_planes_; }
 
  protected:
   void DoApplyAction(Action action) override;
@@ -100,18 +113,25 @@ class GoState : public State {
  private:
   void ResetBoard();
 
+  // Sets the planes of a point to its color on the board, and returns whether
+  // they changed.
+  bool UpdatePointPlanes(VirtualPoint p);
+
   GoBoard board_;
+  std::vector<float> point_planes_;
 
-  // RepetitionTable records which positions we have already encountered.
-  // We are already indexing by board hash, so there is no need to hash that
-  // hash again, so we use a custom passthrough hasher.
+  // RepetitionTable records which positions we have already encountered, for
+  // positional superko. It is an open-addressing set of the board hashes,
+  // which are copied with the state. We are already indexing by board hash,
+  // so there is no need to hash that hash again, so we use a custom
+  // passthrough hasher.
   class PassthroughHash {
    public:
     std::size_t operator()(uint64_t x) const {
       return static_cast<std::size_t>(x);
     }
   };
-  using RepetitionTable = std::unordered_set<uint64_t, PassthroughHash>;
+  using RepetitionTable = absl::flat_hash_set<uint64_t, PassthroughHash>;
   RepetitionTable repetitions_;
 
   const float komi_;
@@ -14,8 +14,10 @@
 
 #include "open_spiel/games/go/go_board.h"
 
+#include <bitset>
 #include <iomanip>
 
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
 #include "open_spiel/games/chess/chess_common.h"
 #include "open_spiel/spiel_utils.h"
@@ -37,6 +39,53 @@ void Neighbours(VirtualPoint p, const F& f) {
   f(p - kVirtualBoardSize);
 }
 
+// The neighbours of a point in the order of the pairs of bits of
+// GoBoard::Pattern3x3: the 4 direct ones, then the diagonal ones. The
+// opposite of the neighbour at index i is at index i ^ 2.
+constexpr int kPatternOffsets[8] = {
+    kVirtualBoardSize,     1, -kVirtualBoardSize,     -1,
+    kVirtualBoardSize + 1, -kVirtualBoardSize + 1, -kVirtualBoardSize - 1,
+    kVirtualBoardSize - 1};
+
+GoColor PatternColor(uint16_t pattern, int neighbour) {
+  return static_cast<GoColor>((pattern >> (2 * neighbour)) & 3);
+}
+
+// Whether the point at the center of each pattern is an eye of a color, see
+// GoBoard::IsEyeLike.
+class EyeTable {
+ public:
+  EyeTable() {
+    for (int pattern = 0; pattern < (1 << 16); ++pattern) {
+      for (GoColor color : {GoColor::kBlack, GoColor::kWhite}) {
+        eyes_[static_cast<int>(color)][pattern] = IsEye(pattern, color);
+      }
+    }
+  }
+
+  bool operator()(uint16_t pattern, GoColor color) const {
+    return eyes_[static_cast<int>(color)][pattern];
+  }
+
+ private:
+  static bool IsEye(uint16_t pattern, GoColor color) {
+    for (int i = 0; i < 4; ++i) {
+      GoColor n = PatternColor(pattern, i);
+      if (n != color && n != GoColor::kGuard) return false;
+    }
+    int num_bad_diagonals = 0;
+    bool at_edge = false;
+    for (int i = 4; i < 8; ++i) {
+      GoColor n = PatternColor(pattern, i);
+      num_bad_diagonals += n == OppColor(color);
+      at_edge |= n == GoColor::kGuard;
+    }
+    return num_bad_diagonals + (at_edge ? 1 : 0) < 2;
+  }
+
+  std::bitset<1 << 16> eyes_[2];
+};
+
 std::vector<VirtualPoint> MakeBoardPoints(int board_size) {
   std::vector<VirtualPoint> points;
   points.reserve(board_size * board_size);
@@ -227,6 +276,7 @@ GoBoard::GoBoard(int board_size)
 
 void GoBoard::Clear() {
   zobrist_hash_ = 0;
+  num_stones_ = {0, 0};
 
   for (int i = 0; i < board_.size(); ++i) {
     Vertex& v = board_[i];
@@ -251,6 +301,14 @@ void GoBoard::Clear() {
     last_captures_[i] = kInvalidPoint;
   }
 
+  patterns_.fill(0);
+  for (VirtualPoint p : BoardPoints(board_size_)) {
+    for (int i = 0; i < 8; ++i) {
+      patterns_[p] |= static_cast<int>(PointColor(p + kPatternOffsets[i]))
+                      << (2 * i);
+    }
+  }
+
   last_ko_point_ = kInvalidPoint;
 }
 
@@ -295,6 +353,17 @@ void GoBoard::SetStone(VirtualPoint p, GoColor c) {
   zobrist_hash_ ^= zobrist_values[p][static_cast<int>(
       c == GoColor::kEmpty ? PointColor(p) : c)];
 
+  if (PointColor(p) != GoColor::kEmpty) {
+    --num_stones_[static_cast<int>(PointColor(p))];
+  }
+  if (c != GoColor::kEmpty) ++num_stones_[static_cast<int>(c)];
+
+  // p is the neighbour i ^ 2 of its neighbour i.
+  const int change = static_cast<int>(PointColor(p)) ^ static_cast<int>(c);
+  for (int i = 0; i < 8; ++i) {
+    patterns_[p + kPatternOffsets[i]] ^= change << (2 * (i ^ 2));
+  }
+
   board_[p].color = c;
 }
 
@@ -407,6 +476,23 @@ void GoBoard::InitNewChain(VirtualPoint p) {
   });
 }
 
+int GoBoard::RealLiberty(VirtualPoint p) const {
+  std::bitset<kVirtualBoardPoints> liberties;
+  VirtualPoint cur = p;
+  do {
+    Neighbours(cur, [this, &liberties](VirtualPoint n) {
+      if (IsEmpty(n)) liberties.set(n);
+    });
+    cur = board_[cur].chain_next;
+  } while (cur != p);
+  return liberties.count();
+}
+
+bool GoBoard::IsEyeLike(VirtualPoint p, GoColor c) const {
+  static const EyeTable* eye_table = new EyeTable();
+  return IsEmpty(p) && (*eye_table)(patterns_[p], c);
+}
+
 bool GoBoard::IsInBoardArea(VirtualPoint p) const {
   auto rc = VirtualPointTo2DPoint(p);
   return rc.first >= 0 && rc.first < board_size() && rc.second >= 0 &&
@@ -521,71 +607,80 @@ void GoBoard::GroupIter::step() {
   }
 }
 
-// Returns the number of points surrounded entirely by one color.
-// Aborts early and returns 0 if the area borders both black and white stones.
-int NumSurroundedPoints(const GoBoard& board, const VirtualPoint p,
-                        std::array<bool, kVirtualBoardPoints>* marked,
-                        bool* reached_black, bool* reached_white) {
-  if ((*marked)[p] || (*reached_black && *reached_white)) return 0;
-  (*marked)[p] = true;
-
-  int num_points = 1;
-  Neighbours(p, [&board, &num_points, marked, reached_black,
-                 reached_white](VirtualPoint n) {
-    switch (board.PointColor(n)) {
-      case GoColor::kBlack:
-        *reached_black = true;
-        break;
-      case GoColor::kWhite:
-        *reached_white = true;
-        break;
-      case GoColor::kEmpty:
-        num_points +=
-            NumSurroundedPoints(board, n, marked, reached_black, reached_white);
-        break;
-      case GoColor::kGuard:
-        // Ignore the border.
+void PlayRandomPlayout(GoBoard* board, GoColor to_play, int max_moves,
+                       SplitMix64* rng) {
+  std::vector<VirtualPoint> candidates;
+  candidates.reserve(board->board_size() * board->board_size());
+  int num_passes = 0;
+  for (int move = 0; move < max_moves && num_passes < 2; ++move) {
+    candidates.clear();
+    for (VirtualPoint p : BoardPoints(board->board_size())) {
+      if (board->IsEmpty(p)) candidates.push_back(p);
+    }
+    // Draws empty points until one is a playable move, removing the others,
+    // which gives each playable move the same probability.
+    VirtualPoint chosen = kVirtualPass;
+    while (!candidates.empty()) {
+      const int i = absl::Uniform<int>(*rng, 0, candidates.size());
+      if (board->IsLegalNonEyeFillingMove(candidates[i], to_play)) {
+        chosen = candidates[i];
         break;
+      }
+      candidates[i] = candidates.back();
+      candidates.pop_back();
     }
-  });
-
-  return num_points;
+    num_passes = chosen == kVirtualPass ? num_passes + 1 : 0;
+    board->PlayMove(chosen, to_play);
+    to_play = OppColor(to_play);
+  }
 }
 
 float TrompTaylorScore(const GoBoard& board, float komi, int handicap) {
   // The delta of how many points on the board black and white have occupied,
-  // from black's point of view.
-  int occupied_delta = 0;
+  // from black's point of view. The stones are counted by the board, so only
+  // the empty regions are walked, each once.
+  int occupied_delta =
+      board.NumStones(GoColor::kBlack) - board.NumStones(GoColor::kWhite);
 
-  // We need to keep track of which empty points we've already counted as part
-  // of a larger territory.
   std::array<bool, kVirtualBoardPoints> marked;
   marked.fill(false);
-
+  std::array<VirtualPoint, kVirtualBoardPoints> stack;
   for (VirtualPoint p : BoardPoints(board.board_size())) {
-    switch (board.PointColor(p)) {
-      case GoColor::kBlack:
-        ++occupied_delta;
-        break;
-      case GoColor::kWhite:
-        --occupied_delta;
-        break;
-      case GoColor::kEmpty: {
-        if (marked[p]) continue;
-        // If some empty points are surrounded entirely by one player, they
-        // count as that player's territory.
-        bool reached_black = false, reached_white = false;
-        int n = NumSurroundedPoints(board, p, &marked, &reached_black,
-                                    &reached_white);
-        if (reached_black && !reached_white) {
-          occupied_delta += n;
-        } else if (!reached_black && reached_white) {
-          occupied_delta -= n;
+    if (!board.IsEmpty(p) || marked[p]) continue;
+    // If a region of empty points is surrounded entirely by one player, it
+    // counts as that player's territory.
+    bool reached_black = false, reached_white = false;
+    int num_points = 0;
+    int stack_size = 0;
+    stack[stack_size++] = p;
+    marked[p] = true;
+    while (stack_size > 0) {
+      const VirtualPoint q = stack[--stack_size];
+      ++num_points;
+      Neighbours(q, [&](VirtualPoint n) {
+        switch (board.PointColor(n)) {
+          case GoColor::kBlack:
+            reached_black = true;
+            break;
+          case GoColor::kWhite:
+            reached_white = true;
+            break;
+          case GoColor::kEmpty:
+            if (!marked[n]) {
+              marked[n] = true;
+              stack[stack_size++] = n;
+            }
+            break;
+          case GoColor::kGuard:
+            // Ignore the border.
+            break;
         }
-        break;
-      }
-      case GoColor::kGuard:
-        SpielFatalError("unexpected color");
+      });
+    }
+    if (reached_black && !reached_white) {
+      occupied_delta += num_points;
+    } else if (!reached_black && reached_white) {
+      occupied_delta -= num_points;
     }
   }
 
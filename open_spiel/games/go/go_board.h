@@ -125,15 +125,31 @@ class GoBoard {
 
   inline uint64_t HashValue() const { return zobrist_hash_; }
 
+  // The number of stones of c (black or white) on the board, kept up to date
+  // as stones are played and captured.
+  inline int NumStones(GoColor c) const {
+    return num_stones_[static_cast<int>(c)];
+  }
+
   // Actual liberty count, i.e. each liberty is counted exactly once.
-  // This is computed on the fly by actually walking the group and checking the
-  // neighbouring stones.
-  inline int RealLiberty(VirtualPoint p) const {
-    int num_lib = 0;
-    for (auto it = LibIter(p); it; ++it) {
-      ++num_lib;
-    }
-    return num_lib;
+  // This is computed on the fly by walking the stones of the group and
+  // marking their empty neighbours in a bitset.
+  int RealLiberty(VirtualPoint p) const;
+
+  // The colors of the 8 points around p, 2 bits each (the 4 direct
+  // neighbours first), e.g. to index the 3x3 pattern tables of rollout
+  // policies. This is kept up to date as stones are played and captured.
+  inline uint16_t Pattern3x3(VirtualPoint p) const { return patterns_[p]; }
+
+  // Whether the empty point p is an eye of c for light playouts: its direct
+  // neighbours are stones of c or the edge, and at most one of its diagonal
+  // neighbours is an opponent stone, or none at the edge of the board.
+  bool IsEyeLike(VirtualPoint p, GoColor c) const;
+
+  // Whether c can play at p without filling one of its own eyes, the usual
+  // filter of the moves of light playouts.
+  bool IsLegalNonEyeFillingMove(VirtualPoint p, GoColor c) const {
+    return p == kVirtualPass || (IsLegalMove(p, c) && !IsEyeLike(p, c));
   }
 
   // Head of a chain; each chain has exactly one head that can be used to
@@ -220,8 +236,12 @@ class GoBoard {
 
   std::array<Vertex, kVirtualBoardPoints> board_;
   std::array<Chain, kVirtualBoardPoints> chains_;
+  // By point, see Pattern3x3.
+  std::array<uint16_t, kVirtualBoardPoints> patterns_;
 
   uint64_t zobrist_hash_;
+  // By color, see NumStones.
+  std::array<int, 2> num_stones_;
 
   // Chains captured in the last move, kInvalidPoint otherwise.
   std::array<VirtualPoint, 4> last_captures_;
@@ -237,6 +257,14 @@ std::ostream &operator<<(std::ostream &os, const GoBoard &board);
 // Score according to https://senseis.xmp.net/?TrompTaylorRules.
 float TrompTaylorScore(const GoBoard &board, float komi, int handicap = 0);
 
+// Plays a random game on the board from `to_play`, for the playouts of
+// rollout-based bots: each move is uniformly random among the legal moves
+// that do not fill the player's own eyes, or a pass if there are none. Stops
+// after two passes in a row, or max_moves moves. This skips the history and
+// superko bookkeeping of GoState, so only the simple ko rule is enforced.
+void PlayRandomPlayout(GoBoard *board, GoColor to_play, int max_moves,
+                       SplitMix64 *rng);
+
 }  // namespace go
 }  // namespace open_spiel
 
@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/go.h"
 
+#include <random>
+#include <vector>
+
 #include "open_spiel/games/go/go_board.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -63,6 +66,180 @@ void ConcreteActionsAreUsedInTheAPI() {
   }
 }
 
+void ObservationPlanesFollowCaptures() {
+  int board_size = 9;
+  std::shared_ptr<const Game> game =
+      LoadGame("go", {{"board_size", open_spiel::GameParameter(board_size)}});
+  GoState state(game, board_size, kKomi, 0);
+  std::mt19937 rng(0);
+  const int num_cells = board_size * board_size;
+  std::vector<float> observation(game->ObservationTensorSize());
+  while (!state.IsTerminal()) {
+    std::vector<Action> actions = state.LegalActions();
+    std::uniform_int_distribution<int> dis(0, actions.size() - 1);
+    state.ApplyAction(actions[dis(rng)]);
+    if (std::uniform_int_distribution<int>(0, 9)(rng) == 0) {
+      state.UndoAction(-1, state.History().back());
+    }
+
+    state.ObservationTensor(0, absl::MakeSpan(observation));
+    int cell = 0;
+    for (VirtualPoint p : BoardPoints(board_size)) {
+      const int color_val = static_cast<int>(state.board().PointColor(p));
+      for (int c = 0; c < CellStates(); ++c) {
+        SPIEL_CHECK_EQ(observation[c * num_cells + cell],
+                       c == color_val ? 1.0f : 0.0f);
+      }
+      ++cell;
+    }
+  }
+}
+
+void CopyFromCopiesObservations() {
+  int board_size = 9;
+  std::shared_ptr<const Game> game =
+      LoadGame("go", {{"board_size", open_spiel::GameParameter(board_size)}});
+  std::mt19937 rng(1);
+  std::unique_ptr<State> recycled = game->NewInitialState();
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(
+        actions[std::uniform_int_distribution<int>(0, actions.size() - 1)(
+            rng)]);
+    // Recycle a state from the previous position.
+    SPIEL_CHECK_TRUE(recycled->CopyFrom(*state));
+    SPIEL_CHECK_EQ(recycled->ObservationTensor(0), state->ObservationTensor(0));
+    if (!recycled->IsTerminal()) {
+      recycled->ApplyAction(recycled->LegalActions()[0]);
+    }
+  }
+}
+
+void PatternsAndLibertiesFollowMoves() {
+  int board_size = 9;
+  GoBoard board(board_size);
+  std::mt19937 rng(0);
+  GoColor to_play = GoColor::kBlack;
+  for (int move = 0; move < 200; ++move) {
+    std::vector<VirtualPoint> moves;
+    for (VirtualPoint p : BoardPoints(board_size)) {
+      if (board.IsLegalNonEyeFillingMove(p, to_play)) moves.push_back(p);
+    }
+    if (moves.empty()) break;
+    std::uniform_int_distribution<int> dis(0, moves.size() - 1);
+    board.PlayMove(moves[dis(rng)], to_play);
+    to_play = OppColor(to_play);
+
+    for (VirtualPoint p : BoardPoints(board_size)) {
+      int num_liberties = 0;
+      for (auto it = board.LibIter(p); it; ++it) ++num_liberties;
+      SPIEL_CHECK_EQ(board.RealLiberty(p), num_liberties);
+      uint16_t pattern = 0;
+      const int offsets[8] = {
+          kVirtualBoardSize,      1, -kVirtualBoardSize,     -1,
+          kVirtualBoardSize + 1,  -kVirtualBoardSize + 1,
+          -kVirtualBoardSize - 1, kVirtualBoardSize - 1};
+      for (int i = 0; i < 8; ++i) {
+        const auto neighbour = static_cast<VirtualPoint>(p + offsets[i]);
+        pattern |= static_cast<int>(board.PointColor(neighbour)) << (2 * i);
+      }
+      SPIEL_CHECK_EQ(board.Pattern3x3(p), pattern);
+    }
+  }
+}
+
+void EyeLikeTest() {
+  GoBoard board(9);
+  for (const char* p : {"a2", "b1", "b3", "c2", "d2", "c3"}) {
+    board.PlayMove(MakePoint(p), GoColor::kBlack);
+  }
+  // An opponent diagonal makes an eye at the edge false, and two do inside.
+  SPIEL_CHECK_TRUE(board.IsEyeLike(MakePoint("a1"), GoColor::kBlack));
+  SPIEL_CHECK_FALSE(board.IsEyeLike(MakePoint("a1"), GoColor::kWhite));
+  SPIEL_CHECK_FALSE(board.IsLegalNonEyeFillingMove(MakePoint("a1"),
+                                                   GoColor::kBlack));
+  SPIEL_CHECK_TRUE(board.IsEyeLike(MakePoint("b2"), GoColor::kBlack));
+  board.PlayMove(MakePoint("a3"), GoColor::kWhite);
+  SPIEL_CHECK_TRUE(board.IsEyeLike(MakePoint("b2"), GoColor::kBlack));
+  board.PlayMove(MakePoint("c1"), GoColor::kWhite);
+  SPIEL_CHECK_FALSE(board.IsEyeLike(MakePoint("b2"), GoColor::kBlack));
+  SPIEL_CHECK_TRUE(board.IsLegalNonEyeFillingMove(MakePoint("b2"),
+                                                  GoColor::kBlack));
+}
+
+void RandomPlayoutsFillTheBoard() {
+  int board_size = 9;
+  SplitMix64 rng(0);
+  for (int i = 0; i < 10; ++i) {
+    GoBoard board(board_size);
+    PlayRandomPlayout(&board, GoColor::kBlack, MaxGameLength(board_size),
+                      &rng);
+    // Playouts end when neither player has a move other than filling its
+    // own eyes.
+    int num_playable = 0;
+    for (VirtualPoint p : BoardPoints(board_size)) {
+      for (GoColor c : {GoColor::kBlack, GoColor::kWhite}) {
+        num_playable += board.IsLegalNonEyeFillingMove(p, c);
+      }
+    }
+    SPIEL_CHECK_EQ(num_playable, 0);
+    SPIEL_CHECK_NE(TrompTaylorScore(board, kKomi), 0);
+  }
+}
+
+// Tromp-Taylor scores from scratch: each point counts for a color if it has
+// a stone of it, or is empty and only reaches stones of it through empty
+// points.
+float ReferenceScore(const GoBoard& board, float komi) {
+  float score = -komi;
+  for (VirtualPoint p : BoardPoints(board.board_size())) {
+    if (board.PointColor(p) == GoColor::kBlack) ++score;
+    if (board.PointColor(p) == GoColor::kWhite) --score;
+    if (!board.IsEmpty(p)) continue;
+    std::vector<bool> seen(kVirtualBoardPoints, false);
+    std::vector<VirtualPoint> to_visit = {p};
+    seen[p] = true;
+    bool reached_black = false, reached_white = false;
+    while (!to_visit.empty()) {
+      const VirtualPoint q = to_visit.back();
+      to_visit.pop_back();
+      for (VirtualPoint n : {q - 1, q + 1, q - kVirtualBoardSize,
+                             q + kVirtualBoardSize}) {
+        const GoColor color = board.PointColor(n);
+        reached_black |= color == GoColor::kBlack;
+        reached_white |= color == GoColor::kWhite;
+        if (color == GoColor::kEmpty && !seen[n]) {
+          seen[n] = true;
+          to_visit.push_back(n);
+        }
+      }
+    }
+    if (reached_black != reached_white) score += reached_black ? 1 : -1;
+  }
+  return score;
+}
+
+// The stone counts follow the captures, and the score matches the reference
+// in positions with large empty regions, partway through random playouts.
+void TrompTaylorScoreTest() {
+  int board_size = 9;
+  SplitMix64 rng(0);
+  for (int i = 0; i < 100; ++i) {
+    GoBoard board(board_size);
+    PlayRandomPlayout(&board, GoColor::kBlack, i, &rng);
+    int num_stones[2] = {0, 0};
+    for (VirtualPoint p : BoardPoints(board_size)) {
+      const GoColor color = board.PointColor(p);
+      if (color != GoColor::kEmpty) ++num_stones[static_cast<int>(color)];
+    }
+    SPIEL_CHECK_EQ(board.NumStones(GoColor::kBlack), num_stones[0]);
+    SPIEL_CHECK_EQ(board.NumStones(GoColor::kWhite), num_stones[1]);
+    SPIEL_CHECK_EQ(TrompTaylorScore(board, kKomi),
+                   ReferenceScore(board, kKomi));
+  }
+}
+
 }  // namespace
 }  // namespace go
 }  // namespace open_spiel
@@ -71,4 +248,10 @@ int main(int argc, char** argv) {
   open_spiel::go::BasicGoTests();
   open_spiel::go::HandicapTest();
   open_spiel::go::ConcreteActionsAreUsedInTheAPI();
+  open_spiel::go::ObservationPlanesFollowCaptures();
+  open_spiel::go::CopyFromCopiesObservations();
+  open_spiel::go::PatternsAndLibertiesFollowMoves();
+  open_spiel::go::EyeLikeTest();
+  open_spiel::go::RandomPlayoutsFillTheBoard();
+  open_spiel::go::TrompTaylorScoreTest();
 }
@@ -74,25 +74,25 @@ GoofspielState::GoofspielState(std::shared_ptr<const Game> game, int num_cards,
       points_order_(points_order),
       impinfo_(impinfo),
       current_player_(kInvalidPlayer),
-      winners_({}),
+      winners_(0),
       turns_(0),
       point_card_index_(-1),
       point_card_sequence_({}),
       win_sequence_({}),
       actions_history_({}) {
+  EnableLegalActionsCache();
   // Points and point-card deck.
   points_.resize(num_players_);
   std::fill(points_.begin(), points_.end(), 0);
-  point_deck_.resize(num_cards_);
-  for (int point_value = 1; point_value <= num_cards_; ++point_value) {
-    point_deck_[point_value - 1] = point_value;
-  }
+  const uint64_t all_cards =
+      num_cards_ == kMaxNumCards ? ~uint64_t{0}
+                                 : (uint64_t{1} << num_cards_) - 1;
+  point_deck_ = all_cards;
 
   // Player hands.
-  player_hands_.clear();
+  player_hands_.fill(0);
   for (auto p = Player{0}; p < num_players_; ++p) {
-    std::vector<bool> hand(num_cards_, true);
-    player_hands_.push_back(hand);
+    player_hands_[p] = all_cards;
   }
 
   // Set the points card index.
@@ -116,27 +116,36 @@ int GoofspielState::CurrentPlayer() const {
   }
 }
 
+int GoofspielState::PointCardValue() const {
+  // Drops the lower cards of the deck, in increasing order.
+  uint64_t deck = point_deck_;
+  for (int i = 0; i < point_card_index_; ++i) deck &= deck - 1;
+  return __builtin_ctzll(deck) + 1;
+}
+
 void GoofspielState::DoApplyAction(Action action_id) {
   if (IsSimultaneousNode()) {
     ApplyFlatJointAction(action_id);
     return;
   }
   SPIEL_CHECK_TRUE(IsChanceNode());
+  InvalidateLegalActionsCache();
   point_card_index_ = action_id;
   SPIEL_CHECK_GE(point_card_index_, 0);
-  SPIEL_CHECK_LT(point_card_index_, point_deck_.size());
-  point_card_sequence_.push_back(point_deck_[point_card_index_]);
+  SPIEL_CHECK_LT(point_card_index_, __builtin_popcountll(point_deck_));
+  point_card_sequence_.push_back(PointCardValue());
   current_player_ = kSimultaneousPlayerId;
 }
 
 void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
+  InvalidateLegalActionsCache();
   // Check the actions are valid.
   SPIEL_CHECK_EQ(actions.size(), num_players_);
   for (auto p = Player{0}; p < num_players_; ++p) {
     const int action = actions[p];
     SPIEL_CHECK_GE(action, 0);
     SPIEL_CHECK_LT(action, num_cards_);
-    SPIEL_CHECK_TRUE(player_hands_[p][action]);
+    SPIEL_CHECK_TRUE(HasCard(p, action));
   }
 
   // Find the highest bid
@@ -154,9 +163,10 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
     }
   }
 
+  const int point_card_value = PointCardValue();
   if (num_max_bids == 1) {
     // Winner takes the point card.
-    points_[max_bidder] += point_deck_[point_card_index_];
+    points_[max_bidder] += point_card_value;
     win_sequence_.push_back(max_bidder);
   } else {
     // Tied among several players: discarded.
@@ -164,17 +174,18 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
   }
 
   // Add these actions to the history.
-  actions_history_.push_back(actions);
+  actions_history_.insert(actions_history_.end(), actions.begin(),
+                          actions.end());
 
   // Remove the cards from the player's hands.
   for (auto p = Player{0}; p < num_players_; ++p) {
-    player_hands_[p][actions[p]] = false;
+    player_hands_[p] &= ~(uint64_t{1} << actions[p]);
   }
 
   // Next player's turn.
   if (points_order_ == PointsOrder::kRandom) {
     current_player_ = kChancePlayerId;
-    point_deck_.erase(point_deck_.begin() + point_card_index_);
+    point_deck_ &= ~(uint64_t{1} << (point_card_value - 1));
     point_card_index_ = -1;
   } else if (points_order_ == PointsOrder::kAscending) {
     point_card_index_++;
@@ -208,21 +219,70 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
     int max_points = -1;
     for (auto p = Player{0}; p < num_players_; ++p) {
       if (points_[p] > max_points) {
-        winners_.clear();
         max_points = points_[p];
-        winners_.insert(p);
+        winners_ = uint32_t{1} << p;
       } else if (points_[p] == max_points) {
-        winners_.insert(p);
+        winners_ |= uint32_t{1} << p;
       }
     }
   }
 }
 
+void GoofspielState::UndoAction(Player player, Action action) {
+  SPIEL_CHECK_EQ(player, kChancePlayerId);
+  InvalidateLegalActionsCache();
+  UndoPointCard();
+  history_.pop_back();
+}
+
+void GoofspielState::UndoActions(const std::vector<Action>& actions) {
+  SPIEL_CHECK_EQ(actions.size(), num_players_);
+  InvalidateLegalActionsCache();
+  if (IsTerminal()) {
+    winners_ = 0;
+    // The last turn, which leaves no choice, was played along with this one.
+    if (num_cards_ > 1) {
+      UndoTurn();
+      if (points_order_ == PointsOrder::kRandom) UndoPointCard();
+    }
+  }
+  UndoTurn();
+  history_.resize(history_.size() - actions.size());
+}
+
+void GoofspielState::UndoPointCard() {
+  point_card_sequence_.pop_back();
+  point_card_index_ = -1;
+  current_player_ = kChancePlayerId;
+}
+
+void GoofspielState::UndoTurn() {
+  turns_--;
+  if (points_order_ == PointsOrder::kRandom) {
+    const uint64_t card = uint64_t{1} << (point_card_sequence_.back() - 1);
+    point_deck_ |= card;
+    point_card_index_ = __builtin_popcountll(point_deck_ & (card - 1));
+    current_player_ = kSimultaneousPlayerId;
+  } else if (points_order_ == PointsOrder::kAscending) {
+    point_card_index_--;
+  } else if (points_order_ == PointsOrder::kDescending) {
+    point_card_index_++;
+  }
+  const Player winner = win_sequence_.back();
+  win_sequence_.pop_back();
+  if (winner != kInvalidPlayer) points_[winner] -= PointCardValue();
+  for (auto p = Player{0}; p < num_players_; ++p) {
+    player_hands_[p] |= uint64_t{1} << HistoryAction(turns_, p);
+  }
+  actions_history_.resize(turns_ * num_players_);
+}
+
 std::vector<std::pair<Action, double>> GoofspielState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
-  std::vector<std::pair<Action, double>> outcomes(point_deck_.size());
-  for (int i = 0; i < point_deck_.size(); i++) {
-    outcomes[i] = std::pair<Action, double>(i, 1.0 / point_deck_.size());
+  const int deck_size = __builtin_popcountll(point_deck_);
+  std::vector<std::pair<Action, double>> outcomes(deck_size);
+  for (int i = 0; i < deck_size; i++) {
+    outcomes[i] = std::pair<Action, double>(i, 1.0 / deck_size);
   }
   return outcomes;
 }
@@ -235,10 +295,9 @@ std::vector<Action> GoofspielState::LegalActions(Player player) const {
   SPIEL_CHECK_LT(player, num_players_);
 
   std::vector<Action> movelist;
-  for (int bid = 0; bid < player_hands_[player].size(); ++bid) {
-    if (player_hands_[player][bid]) {
-      movelist.push_back(bid);
-    }
+  movelist.reserve(__builtin_popcountll(player_hands_[player]));
+  for (uint64_t hand = player_hands_[player]; hand; hand &= hand - 1) {
+    movelist.push_back(__builtin_ctzll(hand));
   }
   return movelist;
 }
@@ -265,7 +324,7 @@ std::string GoofspielState::ToString() const {
     absl::StrAppend(&result, p);
     absl::StrAppend(&result, " hand: ");
     for (int c = 0; c < num_cards_; ++c) {
-      if (player_hands_[p][c]) {
+      if (HasCard(p, c)) {
         absl::StrAppend(&result, c + 1);
         absl::StrAppend(&result, " ");
       }
@@ -277,8 +336,8 @@ std::string GoofspielState::ToString() const {
   if (impinfo_) {
     for (auto p = Player{0}; p < num_players_; ++p) {
       absl::StrAppend(&result, "P", p, " actions: ");
-      for (int i = 0; i < actions_history_.size(); ++i) {
-        absl::StrAppend(&result, actions_history_[i][p]);
+      for (int i = 0; i < turns_; ++i) {
+        absl::StrAppend(&result, HistoryAction(i, p));
         absl::StrAppend(&result, " ");
       }
       absl::StrAppend(&result, "\n");
@@ -301,15 +360,15 @@ std::vector<double> GoofspielState::Returns() const {
     return std::vector<double>(num_players_, 0.0);
   }
 
-  if (winners_.size() == num_players_) {
+  const int num_winners = __builtin_popcount(winners_);
+  if (num_winners == num_players_) {
     // All players have same number of points? This is a draw.
     return std::vector<double>(num_players_, 0.0);
   } else {
-    int num_winners = winners_.size();
     int num_losers = num_players_ - num_winners;
     std::vector<double> returns(num_players_, (-1.0 / num_losers));
-    for (const auto& winner : winners_) {
-      returns[winner] = 1.0 / num_winners;
+    for (auto p = Player{0}; p < num_players_; ++p) {
+      if ((winners_ >> p) & 1) returns[p] = 1.0 / num_winners;
     }
     return returns;
   }
@@ -340,7 +399,7 @@ std::string GoofspielState::InformationStateString(Player player) const {
         absl::StrAppend(&result, p);
         absl::StrAppend(&result, " hand: ");
         for (int c = 0; c < num_cards_; ++c) {
-          if (player_hands_[p][c]) {
+          if (HasCard(p, c)) {
             absl::StrAppend(&result, c + 1);
             absl::StrAppend(&result, " ");
           }
@@ -353,8 +412,8 @@ std::string GoofspielState::InformationStateString(Player player) const {
         absl::StrAppend(&result, "P");
         absl::StrAppend(&result, p);
         absl::StrAppend(&result, " action sequence: ");
-        for (int i = 0; i < actions_history_.size(); ++i) {
-          absl::StrAppend(&result, actions_history_[i][p]);
+        for (int i = 0; i < turns_; ++i) {
+          absl::StrAppend(&result, HistoryAction(i, p));
           absl::StrAppend(&result, " ");
         }
         absl::StrAppend(&result, "\n");
@@ -405,7 +464,7 @@ std::string GoofspielState::ObservationString(Player player) const {
     // Only my hand
     absl::StrAppend(&hands, "P", player, " hand: ");
     for (int c = 0; c < num_cards_; ++c) {
-      if (player_hands_[player][c]) {
+      if (HasCard(player, c)) {
         absl::StrAppend(&hands, c + 1, " ");
       }
     }
@@ -422,7 +481,7 @@ std::string GoofspielState::ObservationString(Player player) const {
     for (auto p = Player{0}; p < num_players_; ++p) {
       absl::StrAppend(&hands, "P", p, " hand: ");
       for (int c = 0; c < num_cards_; ++c) {
-        if (player_hands_[p][c]) {
+        if (HasCard(p, c)) {
           absl::StrAppend(&hands, c + 1, " ");
         }
       }
@@ -458,7 +517,7 @@ void GoofspielState::InformationStateTensor(Player player,
   if (impinfo_) {
     // Bit vector of observing player's hand.
     for (int c = 0; c < num_cards_; ++c) {
-      values->push_back(player_hands_[player][c] ? 1 : 0);
+      values->push_back(HasCard(player, c) ? 1 : 0);
     }
 
     // Sequence of who won each trick.
@@ -486,10 +545,7 @@ void GoofspielState::InformationStateTensor(Player player,
     // The observing player's action sequence.
     for (int i = 0; i < num_cards_; ++i) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(i < actions_history_.size() &&
-                                  actions_history_[i][player] == c
-                              ? 1
-                              : 0);
+        values->push_back(i < turns_ && HistoryAction(i, player) == c ? 1 : 0);
       }
     }
 
@@ -509,7 +565,7 @@ void GoofspielState::InformationStateTensor(Player player,
     p = player;
     for (int n = 0; n < num_players_; NextPlayer(&n, &p)) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(player_hands_[p][c] ? 1 : 0);
+        values->push_back(HasCard(p, c) ? 1 : 0);
       }
     }
   }
@@ -553,7 +609,7 @@ void GoofspielState::ObservationTensor(Player player,
   if (impinfo_) {
     // Bit vector of observing player's hand.
     for (int c = 0; c < num_cards_; ++c) {
-      values->push_back(player_hands_[player][c] ? 1 : 0);
+      values->push_back(HasCard(player, c) ? 1 : 0);
     }
 
     // Sequence of who won each trick.
@@ -571,7 +627,7 @@ void GoofspielState::ObservationTensor(Player player,
     p = player;
     for (int n = 0; n < num_players_; NextPlayer(&n, &p)) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(player_hands_[p][c] ? 1 : 0);
+        values->push_back(HasCard(p, c) ? 1 : 0);
       }
     }
   }
@@ -589,7 +645,11 @@ GoofspielGame::GoofspielGame(const GameParameters& params)
       num_players_(ParameterValue<int>("players")),
       points_order_(
           ParsePointsOrder(ParameterValue<std::string>("points_order"))),
-      impinfo_(ParameterValue<bool>("imp_info")) {}
+      impinfo_(ParameterValue<bool>("imp_info")) {
+  SPIEL_CHECK_GE(num_cards_, 1);
+  SPIEL_CHECK_LE(num_cards_, kMaxNumCards);
+  SPIEL_CHECK_LE(num_players_, kMaxNumPlayers);
+}
 
 std::unique_ptr<State> GoofspielGame::NewInitialState() const {
   return std::unique_ptr<State>(new GoofspielState(
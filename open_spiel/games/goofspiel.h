@@ -15,8 +15,9 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_GOOFSPIEL_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_GOOFSPIEL_H_
 
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -40,7 +41,8 @@
 //
 // Parameters:
 //   "imp_info"      bool     Enable the imperfect info variant (default: false)
-//   "num_cards"     int      The highest bid card, and point card (default: 13)
+//   "num_cards"     int      The highest bid card, and point card (default: 13,
+//                            at most 64)
 //   "players"       int      number of players (default: 2)
 //   "points_order"  string   "random" (default), "descending", or "ascending"
 
@@ -51,6 +53,9 @@ inline constexpr int kDefaultNumPlayers = 2;
 inline constexpr int kDefaultNumCards = 13;
 inline constexpr const char* kDefaultPointsOrder = "random";
 inline constexpr const bool kDefaultImpInfo = false;
+inline constexpr int kMaxNumPlayers = 10;
+// Hands and the point deck are sets of cards in a 64-bit mask.
+inline constexpr int kMaxNumCards = 64;
 
 enum class PointsOrder {
   kRandom,
@@ -78,6 +83,10 @@ class GoofspielState : public SimMoveState {
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  // Undoes chance outcomes; joint actions are undone with UndoActions.
+  void UndoAction(Player player, Action action) override;
+  void UndoActions(const std::vector<Action>& actions) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
 
   std::vector<Action> LegalActions(Player player) const override;
@@ -87,23 +96,41 @@ class GoofspielState : public SimMoveState {
   void DoApplyActions(const std::vector<Action>& actions) override;
 
  private:
+  // Put back the last point card drawn, or the last turn's bids and point
+  // card, leaving history_ as it is.
+  void UndoPointCard();
+  void UndoTurn();
+
   // Increments the count and increments the player mod num_players_.
   void NextPlayer(int* count, Player* player) const;
 
+  bool HasCard(Player player, int card) const {
+    return (player_hands_[player] >> card) & 1;
+  }
+  // The value of the point card at point_card_index_ in the deck.
+  int PointCardValue() const;
+  // The bid of the player on the given turn.
+  Action HistoryAction(int turn, Player player) const {
+    return actions_history_[turn * num_players_ + player];
+  }
+
   int num_cards_;
   PointsOrder points_order_;
   bool impinfo_;
 
   Player current_player_;
-  std::set<int> winners_;
+  uint32_t winners_;  // Bit p is set if player p won.
   int turns_;
   int point_card_index_;
   std::vector<int> points_;
-  std::vector<int> point_deck_;                  // Current point deck.
-  std::vector<std::vector<bool>> player_hands_;  // true if card is in hand.
+  // The cards of the current point deck, where bit i is the card of value
+  // i + 1, and those of each player's hand.
+  uint64_t point_deck_;
+  std::array<uint64_t, kMaxNumPlayers> player_hands_;
   std::vector<int> point_card_sequence_;
   std::vector<int> win_sequence_;  // Which player won
-  std::vector<std::vector<Action>> actions_history_;
+  // The bids of every player, turn after turn.
+  std::vector<Action> actions_history_;
 };
 
 class GoofspielGame : public Game {
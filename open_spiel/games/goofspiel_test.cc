@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/goofspiel.h"
 
+#include <string>
+#include <vector>
+
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/spiel_utils.h"
@@ -35,6 +38,20 @@ void BasicGoofspielTests() {
   }
 }
 
+void UndoTests() {
+  for (const std::string& points_order :
+       std::vector<std::string>{"random", "ascending"}) {
+    GameParameters params;
+    params["points_order"] = GameParameter(points_order);
+    testing::RandomSimTestWithUndo(*LoadGame("goofspiel", params), 10);
+    params["players"] = GameParameter(3);
+    testing::RandomSimTestWithUndo(*LoadGame("goofspiel", params), 10);
+    params["imp_info"] = GameParameter(true);
+    testing::RandomSimTestWithUndo(*LoadGameAsTurnBased("goofspiel", params),
+                                   10);
+  }
+}
+
 void LegalActionsValidAtEveryState() {
   GameParameters params;
   params["imp_info"] = GameParameter(true);
@@ -50,5 +67,6 @@ void LegalActionsValidAtEveryState() {
 
 int main(int argc, char **argv) {
   open_spiel::goofspiel::BasicGoofspielTests();
+  open_spiel::goofspiel::UndoTests();
   open_spiel::goofspiel::LegalActionsValidAtEveryState();
 }
@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/hanabi.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -208,6 +211,14 @@ void OpenSpielHanabiState::ObservationTensor(
   for (int i = 0; i < obs.size(); ++i) values->at(i) = obs[i];
 }
 
+void OpenSpielHanabiState::ObservationTensor(Player player,
+                                             absl::Span<float> values) const {
+  const std::vector<int> obs = game_->Encoder().Encode(
+      hanabi_learning_env::HanabiObservation(state_, player));
+  SPIEL_CHECK_EQ(values.size(), obs.size());
+  std::copy(obs.begin(), obs.end(), values.begin());
+}
+
 std::unique_ptr<State> OpenSpielHanabiState::Clone() const {
   return std::unique_ptr<State>(new OpenSpielHanabiState(*this));
 }
@@ -235,5 +246,100 @@ OpenSpielHanabiState::OpenSpielHanabiState(std::shared_ptr<const Game> game)
       game_(static_cast<const OpenSpielHanabiGame*>(game.get())),
       prev_state_score_(0.) {}
 
+HanabiVectorEnv::HanabiVectorEnv(std::shared_ptr<const Game> game,
+                                 int num_envs, int seed)
+    : game_(std::move(game)),
+      hanabi_game_(dynamic_cast<const OpenSpielHanabiGame*>(game_.get())),
+      rng_(seed),
+      num_players_(game_->NumPlayers()),
+      observation_size_(game_->ObservationTensorSize()),
+      num_distinct_actions_(game_->NumDistinctActions()),
+      observations_(num_envs * observation_size_),
+      legal_actions_masks_(num_envs * num_distinct_actions_),
+      rewards_(num_envs * num_players_),
+      current_players_(num_envs),
+      dones_(num_envs) {
+  SPIEL_CHECK_GT(num_envs, 0);
+  if (hanabi_game_ == nullptr) {
+    SpielFatalError("HanabiVectorEnv requires a hanabi game.");
+  }
+  states_.reserve(num_envs);
+  for (int env = 0; env < num_envs; ++env) {
+    states_.emplace_back(&hanabi_game_->HanabiGame());
+  }
+  Reset();
+}
+
+void HanabiVectorEnv::Reset() {
+  std::fill(rewards_.begin(), rewards_.end(), 0.0f);
+  std::fill(dones_.begin(), dones_.end(), 0);
+  for (int env = 0; env < states_.size(); ++env) {
+    ResetEnv(env);
+    WriteObservationAndMask(env);
+  }
+}
+
+void HanabiVectorEnv::Step(absl::Span<const Action> actions) {
+  SPIEL_CHECK_EQ(actions.size(), states_.size());
+  const hanabi_learning_env::HanabiGame& game = hanabi_game_->HanabiGame();
+  for (int env = 0; env < states_.size(); ++env) {
+    hanabi_learning_env::HanabiState& state = states_[env];
+    const hanabi_learning_env::HanabiMove move = game.GetMove(actions[env]);
+    if (!state.MoveIsLegal(move)) {
+      SpielFatalError(absl::StrCat("Invalid move ", move.ToString()));
+    }
+    const int previous_score = state.Score();
+    state.ApplyMove(move);
+    SampleChanceOutcomes(env);
+    // The players share the score.
+    std::fill_n(&rewards_[env * num_players_], num_players_,
+                state.Score() - previous_score);
+    dones_[env] = state.IsTerminal();
+    if (dones_[env]) ResetEnv(env);
+    WriteObservationAndMask(env);
+  }
+}
+
+void HanabiVectorEnv::ResetEnv(int env) {
+  // A new state, rather than a copy of an initial one, so that the start
+  // player is drawn again when it is random.
+  states_[env] =
+      hanabi_learning_env::HanabiState(&hanabi_game_->HanabiGame());
+  SampleChanceOutcomes(env);
+  SPIEL_CHECK_FALSE(states_[env].IsTerminal());
+}
+
+void HanabiVectorEnv::SampleChanceOutcomes(int env) {
+  hanabi_learning_env::HanabiState& state = states_[env];
+  while (!state.IsTerminal() &&
+         state.CurPlayer() == kChancePlayerId) {
+    const auto outcomes_and_probs = state.ChanceOutcomes();
+    double z = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    int i = 0;
+    for (; i + 1 < outcomes_and_probs.second.size(); ++i) {
+      z -= outcomes_and_probs.second[i];
+      if (z < 0) break;
+    }
+    state.ApplyMove(outcomes_and_probs.first[i]);
+  }
+}
+
+void HanabiVectorEnv::WriteObservationAndMask(int env) {
+  const hanabi_learning_env::HanabiState& state = states_[env];
+  const hanabi_learning_env::HanabiGame& game = hanabi_game_->HanabiGame();
+  const Player player = state.CurPlayer();
+  current_players_[env] = player;
+
+  const std::vector<int> obs = hanabi_game_->Encoder().Encode(
+      hanabi_learning_env::HanabiObservation(state, player));
+  SPIEL_CHECK_EQ(obs.size(), observation_size_);
+  std::copy(obs.begin(), obs.end(), &observations_[env * observation_size_]);
+
+  float* mask = &legal_actions_masks_[env * num_distinct_actions_];
+  for (int uid = 0; uid < num_distinct_actions_; ++uid) {
+    mask[uid] = state.MoveIsLegal(game.GetMove(uid));
+  }
+}
+
 }  // namespace hanabi
 }  // namespace open_spiel
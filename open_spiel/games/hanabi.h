@@ -30,7 +30,10 @@
 // (TLDR: Set the environment variable BUILD_WITH_HANABI to ON).
 
 #include <memory>
+#include <random>
+#include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "hanabi_lib/canonical_encoders.h"
 #include "hanabi_lib/hanabi_game.h"
@@ -80,6 +83,8 @@ class OpenSpielHanabiState : public State {
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
 
   std::unique_ptr<State> Clone() const override;
   ActionsAndProbs ChanceOutcomes() const override;
@@ -95,6 +100,67 @@ class OpenSpielHanabiState : public State {
   double prev_state_score_;
 };
 
+// A batch of Hanabi games stepped together, for actors running thousands of
+// games. It behaves like algorithms::VectorEnv (see vector_env.h), with the
+// same buffers, but steps the Hanabi Learning Environment states directly:
+// there is no OpenSpiel state, history or virtual call per game, legal moves
+// are masked without building move lists, and the canonical encoder's
+// observations are copied straight into the batch buffer.
+class HanabiVectorEnv {
+ public:
+  HanabiVectorEnv(std::shared_ptr<const Game> game, int num_envs, int seed);
+
+  // Starts a new game in every environment.
+  void Reset();
+
+  // Applies actions[i], which must be legal, in environment i.
+  void Step(absl::Span<const Action> actions);
+
+  int num_envs() const { return states_.size(); }
+  const hanabi_learning_env::HanabiState& state(int env) const {
+    return states_[env];
+  }
+
+  // [num_envs, ObservationTensorSize()], from the point of view of the
+  // player to act.
+  const std::vector<float>& observations() const { return observations_; }
+
+  // [num_envs, NumDistinctActions()], 1 for legal actions and 0 otherwise.
+  const std::vector<float>& legal_actions_masks() const {
+    return legal_actions_masks_;
+  }
+
+  // [num_envs, NumPlayers()], the rewards received during the last step. All
+  // zero after Reset().
+  const std::vector<float>& rewards() const { return rewards_; }
+
+  // [num_envs], the player to act.
+  const std::vector<int>& current_players() const { return current_players_; }
+
+  // [num_envs], 1 if the last step ended the game (the environment then holds
+  // the initial state of the next one), 0 otherwise.
+  const std::vector<int>& dones() const { return dones_; }
+
+ private:
+  void ResetEnv(int env);
+  void SampleChanceOutcomes(int env);
+  void WriteObservationAndMask(int env);
+
+  std::shared_ptr<const Game> game_;
+  const OpenSpielHanabiGame* hanabi_game_;
+  std::vector<hanabi_learning_env::HanabiState> states_;
+  std::mt19937 rng_;
+  const int num_players_;
+  const int observation_size_;
+  const int num_distinct_actions_;
+
+  std::vector<float> observations_;
+  std::vector<float> legal_actions_masks_;
+  std::vector<float> rewards_;
+  std::vector<int> current_players_;
+  std::vector<int> dones_;
+};
+
 }  // namespace hanabi
 }  // namespace open_spiel
 
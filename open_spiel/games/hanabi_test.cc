@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/hanabi.h"
 
+#include <random>
+#include <vector>
+
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -34,8 +37,47 @@ void BasicHanabiTests() {
   }
 }
 
+void HanabiVectorEnvTest() {
+  std::shared_ptr<const Game> game =
+      LoadGame("hanabi", {{"players", GameParameter(3)}});
+  constexpr int kNumEnvs = 8;
+  HanabiVectorEnv env(game, kNumEnvs, /*seed=*/0);
+  const int num_actions = game->NumDistinctActions();
+  const int observation_size = game->ObservationTensorSize();
+  const auto& encoder =
+      static_cast<const OpenSpielHanabiGame&>(*game).Encoder();
+  std::mt19937 rng(0);
+  int num_games = 0;
+  for (int step = 0; step < 1000; ++step) {
+    std::vector<Action> actions(kNumEnvs);
+    for (int i = 0; i < kNumEnvs; ++i) {
+      SPIEL_CHECK_EQ(env.current_players()[i], env.state(i).CurPlayer());
+      const std::vector<int> obs =
+          encoder.Encode(hanabi_learning_env::HanabiObservation(
+              env.state(i), env.state(i).CurPlayer()));
+      for (int j = 0; j < observation_size; ++j) {
+        SPIEL_CHECK_EQ(env.observations()[i * observation_size + j], obs[j]);
+      }
+      std::vector<Action> legal_actions;
+      for (Action action = 0; action < num_actions; ++action) {
+        if (env.legal_actions_masks()[i * num_actions + action]) {
+          legal_actions.push_back(action);
+        }
+      }
+      SPIEL_CHECK_FALSE(legal_actions.empty());
+      actions[i] = legal_actions[rng() % legal_actions.size()];
+    }
+    env.Step(actions);
+    for (int done : env.dones()) num_games += done;
+  }
+  SPIEL_CHECK_GT(num_games, 0);
+}
+
 }  // namespace
 }  // namespace hanabi
 }  // namespace open_spiel
 
-int main(int argc, char **argv) { open_spiel::hanabi::BasicHanabiTests(); }
+int main(int argc, char **argv) {
+  open_spiel::hanabi::BasicHanabiTests();
+  open_spiel::hanabi::HanabiVectorEnvTest();
+}
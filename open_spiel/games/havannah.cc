@@ -70,9 +70,6 @@ constexpr std::array<Move, kMaxNeighbors> neighbor_offsets = {
     Move(0, 1, kMoveOffset),   Move(-1, 0, kMoveOffset),
 };
 
-// Precomputed list of neighbors per board_size: [board_size][cell][direction]
-std::vector<NeighborList> neighbor_list;
-
 NeighborList gen_neighbors(int board_size) {
   int diameter = board_size * 2 - 1;
   NeighborList out;
@@ -89,16 +86,6 @@ NeighborList gen_neighbors(int board_size) {
   return out;
 }
 
-const NeighborList& get_neighbors(int board_size) {
-  if (board_size >= neighbor_list.size()) {
-    neighbor_list.resize(board_size + 1);
-  }
-  if (neighbor_list[board_size].empty()) {
-    neighbor_list[board_size] = gen_neighbors(board_size);
-  }
-  return neighbor_list[board_size];
-}
-
 // Number of set bits in each 6-bit integer.
 // Python code to compute these values: [bin(i).count("1") for i in range(64)]
 constexpr int kBitsSetTable64[] = {
@@ -157,7 +144,7 @@ HavannahState::HavannahState(std::shared_ptr<const Game> game, int board_size,
       board_diameter_(board_size * 2 - 1),
       valid_cells_((board_size * 2 - 1) * (board_size * 2 - 1) -
                    board_size * (board_size - 1)),  // diameter^2 - corners
-      neighbors_(get_neighbors(board_size)),
+      neighbors_(static_cast<const HavannahGame&>(*game).Neighbors()),
       ansi_color_output_(ansi_color_output) {
   board_.resize(board_diameter_ * board_diameter_);
   for (int i = 0; i < board_.size(); i++) {
@@ -266,10 +253,16 @@ std::string HavannahState::ToString() const {
 }
 
 std::vector<double> HavannahState::Returns() const {
-  if (outcome_ == kPlayer1) return {1, -1};
-  if (outcome_ == kPlayer2) return {-1, 1};
-  if (outcome_ == kPlayerDraw) return {0, 0};
-  return {0, 0};  // Unfinished
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void HavannahState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  // Draws and unfinished games are worth 0.
+  returns[0] = outcome_ == kPlayer1 ? 1.0 : outcome_ == kPlayer2 ? -1.0 : 0.0;
+  returns[1] = outcome_ == kPlayer2 ? 1.0 : outcome_ == kPlayer1 ? -1.0 : 0.0;
 }
 
 std::string HavannahState::InformationStateString(Player player) const {
@@ -295,6 +288,16 @@ int PlayerRelative(HavannahPlayer state, Player current) {
   }
 }
 
+template <class T>
+void HavannahState::WriteObservationTensor(Player player,
+                                           TensorView<2, T>& view) const {
+  for (int i = 0; i < board_.size(); ++i) {
+    if (board_[i].player < kCellStates) {
+      view[{PlayerRelative(board_[i].player, player), i}] = 1.0;
+    }
+  }
+}
+
 void HavannahState::ObservationTensor(Player player,
                                       std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
@@ -302,11 +305,17 @@ void HavannahState::ObservationTensor(Player player,
 
   TensorView<2> view(values, {kCellStates, static_cast<int>(board_.size())},
                      true);
-  for (int i = 0; i < board_.size(); ++i) {
-    if (board_[i].player < kCellStates) {
-      view[{PlayerRelative(board_[i].player, player), i}] = 1.0;
-    }
-  }
+  WriteObservationTensor(player, view);
+}
+
+void HavannahState::ObservationTensor(Player player,
+                                      absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(
+      values, {kCellStates, static_cast<int>(board_.size())}, true);
+  WriteObservationTensor(player, view);
 }
 
 void HavannahState::DoApplyAction(Action action) {
@@ -401,10 +410,25 @@ std::unique_ptr<State> HavannahState::Clone() const {
   return std::unique_ptr<State>(new HavannahState(*this));
 }
 
+bool HavannahState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const HavannahState&>(other);
+  State::operator=(state);
+  board_ = state.board_;
+  current_player_ = state.current_player_;
+  outcome_ = state.outcome_;
+  moves_made_ = state.moves_made_;
+  last_move_ = state.last_move_;
+  return true;
+}
+
 HavannahGame::HavannahGame(const GameParameters& params)
     : Game(kGameType, params),
       board_size_(ParameterValue<int>("board_size")),
-      ansi_color_output_(ParameterValue<bool>("ansi_color_output")) {}
+      ansi_color_output_(ParameterValue<bool>("ansi_color_output")),
+      neighbors_(gen_neighbors(board_size_)) {}
 
 }  // namespace havannah
 }  // namespace open_spiel
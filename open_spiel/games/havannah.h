@@ -22,7 +22,9 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // https://en.wikipedia.org/wiki/Havannah
 // Does not implement pie rule to balance the game
@@ -146,6 +148,7 @@ class HavannahState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override { return outcome_ != kPlayerNone; }
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
 
@@ -153,7 +156,10 @@ class HavannahState : public State {
   // specified player, the other player, and empty.
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
   std::vector<Action> LegalActions() const override;
 
  protected:
@@ -179,6 +185,10 @@ class HavannahState : public State {
   Move ActionToMove(Action action_id) const;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
   std::vector<Cell> board_;
   HavannahPlayer current_player_ = kPlayer1;
   HavannahPlayer outcome_ = kPlayerNone;
@@ -222,10 +232,14 @@ class HavannahGame : public Game {
     return Diameter() * Diameter() - board_size_ * (board_size_ - 1);
   }
 
+  // The neighbors of the cells, shared by the states of the game.
+  const NeighborList& Neighbors() const { return neighbors_; }
+
  private:
   int Diameter() const { return board_size_ * 2 - 1; }
   const int board_size_;
   const bool ansi_color_output_ = false;
+  const NeighborList neighbors_;
 };
 
 }  // namespace havannah
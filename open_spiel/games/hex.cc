@@ -15,6 +15,7 @@
 #include "open_spiel/games/hex.h"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -63,63 +64,93 @@ CellState HexState::PlayerAndActionToState(Player player, Action move) const {
   // We know the colour from the argument player
   // For connectedness to the edges, we check if the move is in first/last
   // row/column, or if any of the neighbours are the same colour and connected.
-  switch (player) {
-    case 0: {
-      bool north_connected = false;
-      bool south_connected = false;
-      if (move < board_size_) {  // First row
-        north_connected = true;
-      } else if (move >= board_size_ * (board_size_ - 1)) {  // Last row
-        south_connected = true;
-      }
-      for (int neighbour : AdjacentCells(move)) {
-        if (board_[neighbour] == CellState::kBlackNorth) {
-          north_connected = true;
-        } else if (board_[neighbour] == CellState::kBlackSouth) {
-          south_connected = true;
-        }
-      }
-      if (north_connected && south_connected) {
-        return CellState::kBlackWin;
-      } else if (north_connected) {
-        return CellState::kBlackNorth;
-      } else if (south_connected) {
-        return CellState::kBlackSouth;
-      } else {
-        return CellState::kBlack;
-      }
+  const CellState colour = player == 0 ? CellState::kBlack : CellState::kWhite;
+  int edges = CellEdges(player, move);
+  for (int neighbour : AdjacentCells(move)) {
+    if (board_[neighbour] == colour) {
+      edges |= groups_[FindGroupLeader(neighbour)].edges;
     }
-    case 1: {
-      bool west_connected = false;
-      bool east_connected = false;
-      if (move % board_size_ == 0) {  // First column
-        west_connected = true;
-      } else if (move % board_size_ == board_size_ - 1) {  // Last column
-        east_connected = true;
-      }
-      for (int neighbour : AdjacentCells(move)) {
-        if (board_[neighbour] == CellState::kWhiteWest) {
-          west_connected = true;
-        } else if (board_[neighbour] == CellState::kWhiteEast) {
-          east_connected = true;
-        }
+  }
+  switch (player) {
+    case 0:
+      switch (edges) {
+        case kFirstEdge | kSecondEdge:
+          return CellState::kBlackWin;
+        case kFirstEdge:
+          return CellState::kBlackNorth;
+        case kSecondEdge:
+          return CellState::kBlackSouth;
+        default:
+          return CellState::kBlack;
       }
-      if (west_connected && east_connected) {
-        return CellState::kWhiteWin;
-      } else if (west_connected) {
-        return CellState::kWhiteWest;
-      } else if (east_connected) {
-        return CellState::kWhiteEast;
-      } else {
-        return CellState::kWhite;
+    case 1:
+      switch (edges) {
+        case kFirstEdge | kSecondEdge:
+          return CellState::kWhiteWin;
+        case kFirstEdge:
+          return CellState::kWhiteWest;
+        case kSecondEdge:
+          return CellState::kWhiteEast;
+        default:
+          return CellState::kWhite;
       }
-    }
     default:
       SpielFatalError(absl::StrCat("Invalid player id ", player));
       return CellState::kEmpty;
   }
 }
 
+int HexState::CellEdges(Player player, int cell) const {
+  if (player == 0) {
+    if (cell < board_size_) {  // First row
+      return kFirstEdge;
+    } else if (cell >= board_size_ * (board_size_ - 1)) {  // Last row
+      return kSecondEdge;
+    }
+  } else {
+    if (cell % board_size_ == 0) {  // First column
+      return kFirstEdge;
+    } else if (cell % board_size_ == board_size_ - 1) {  // Last column
+      return kSecondEdge;
+    }
+  }
+  return 0;
+}
+
+int HexState::FindGroupLeader(int cell) const {
+  while (groups_[cell].parent != cell) cell = groups_[cell].parent;
+  return cell;
+}
+
+bool HexState::JoinGroups(int cell_a, int cell_b) {
+  int leader_a = FindGroupLeader(cell_a);
+  int leader_b = FindGroupLeader(cell_b);
+  if (leader_a == leader_b) return false;
+  if (groups_[leader_a].size < groups_[leader_b].size) {
+    std::swap(leader_a, leader_b);
+  }
+  joins_.push_back({leader_b, leader_a, groups_[leader_a].edges});
+  groups_[leader_b].parent = leader_a;
+  groups_[leader_a].size += groups_[leader_b].size;
+  groups_[leader_a].edges |= groups_[leader_b].edges;
+  return true;
+}
+
+CellState HexState::BoardAt(int cell) const {
+  if (board_[cell] == CellState::kEmpty) return CellState::kEmpty;
+  const Player player = board_[cell] == CellState::kBlack ? 0 : 1;
+  switch (groups_[FindGroupLeader(cell)].edges) {
+    case kFirstEdge | kSecondEdge:
+      return player == 0 ? CellState::kBlackWin : CellState::kWhiteWin;
+    case kFirstEdge:
+      return player == 0 ? CellState::kBlackNorth : CellState::kWhiteWest;
+    case kSecondEdge:
+      return player == 0 ? CellState::kBlackSouth : CellState::kWhiteEast;
+    default:
+      return board_[cell];
+  }
+}
+
 std::string StateToString(CellState state) {
   switch (state) {
     case CellState::kEmpty:
@@ -149,50 +180,60 @@ std::string StateToString(CellState state) {
 void HexState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(board_[move], CellState::kEmpty);
   CellState move_cell_state = PlayerAndActionToState(CurrentPlayer(), move);
-  board_[move] = move_cell_state;
-
-  if (move_cell_state == CellState::kBlackWin) {
-    result_black_perspective_ = 1;
-  } else if (move_cell_state == CellState::kWhiteWin) {
-    result_black_perspective_ = -1;
-  } else if (move_cell_state != CellState::kBlack &&
-             move_cell_state != CellState::kWhite) {
-    // Move is connected to an edge but not winning.
-    // Update edge-connected groups with a flood-fill, to maintain that all edge
-    // connected nodes are known about.
-    // We don't do flood fill if a player has won, so it's impossible for a cell
-    // connected to an edge to be changed by the flood-fill.
-    CellState cell_state_to_change =
-        (current_player_ == 0 ? CellState::kBlack : CellState::kWhite);
-    // We assume that move can safely be cast to int
-    std::vector<int> flood_stack = {static_cast<int>(move)};
-    int latest_cell;
-    while (!flood_stack.empty()) {
-      latest_cell = flood_stack.back();
-      flood_stack.pop_back();
-      for (int neighbour : AdjacentCells(latest_cell)) {
-        if (board_[neighbour] == cell_state_to_change) {
-          // We make the change before putting the cell on the queue to avoid
-          // putting the same cell on the queue multiple times
-          board_[neighbour] = move_cell_state;
-          flood_stack.push_back(neighbour);
-        }
+  const CellState colour =
+      current_player_ == 0 ? CellState::kBlack : CellState::kWhite;
+  board_[move] = colour;
+  groups_[move] = {static_cast<int>(move), 1,
+                   CellEdges(current_player_, move)};
+
+  int num_joins = 0;
+  if (move_cell_state == CellState::kBlackWin ||
+      move_cell_state == CellState::kWhiteWin) {
+    // The winning stone is not joined to its neighbours: it is the only one
+    // shown as winning, and the others keep the edges they had.
+    result_black_perspective_ = current_player_ == 0 ? 1 : -1;
+    groups_[move].edges = kFirstEdge | kSecondEdge;
+  } else {
+    for (int neighbour : AdjacentCells(move)) {
+      if (board_[neighbour] == colour) {
+        num_joins += JoinGroups(move, neighbour);
       }
     }
   }
+  num_joins_.push_back(num_joins);
   current_player_ = 1 - current_player_;
 }
 
+void HexState::UndoAction(Player player, Action move) {
+  for (int i = 0; i < num_joins_.back(); ++i) {
+    const Join& join = joins_.back();
+    groups_[join.parent].size -= groups_[join.child].size;
+    groups_[join.parent].edges = join.parent_edges;
+    groups_[join.child].parent = join.child;
+    joins_.pop_back();
+  }
+  num_joins_.pop_back();
+  board_[move] = CellState::kEmpty;
+  result_black_perspective_ = 0;
+  current_player_ = player;
+  history_.pop_back();
+}
+
 std::vector<Action> HexState::LegalActions() const {
-  // Can move in any empty cell.
   std::vector<Action> moves;
-  if (IsTerminal()) return moves;
+  LegalActions(&moves);
+  return moves;
+}
+
+void HexState::LegalActions(std::vector<Action>* moves) const {
+  // Can move in any empty cell.
+  moves->clear();
+  if (IsTerminal()) return;
   for (int cell = 0; cell < board_.size(); ++cell) {
     if (board_[cell] == CellState::kEmpty) {
-      moves.push_back(cell);
+      moves->push_back(cell);
     }
   }
-  return moves;
 }
 
 std::string HexState::ActionToString(Player player, Action action_id) const {
@@ -203,27 +244,14 @@ std::string HexState::ActionToString(Player player, Action action_id) const {
                       action_id / board_size_, ")");
 }
 
-std::vector<int> HexState::AdjacentCells(int cell) const {
-  std::vector<int> neighbours = {
-      cell - board_size_, cell - board_size_ + 1, cell - 1,
-      cell + 1,           cell + board_size_ - 1, cell + board_size_};
-  for (int i = kMaxNeighbours - 1; i >= 0; i--) {
-    // Check for invalid neighbours and remove
-    // Iterating in reverse to avoid changing the index of a candidate neighbour
-    if (neighbours[i] < 0 || (neighbours[i] >= board_size_ * board_size_) ||
-        (neighbours[i] % board_size_ == 0 &&
-         cell % board_size_ == board_size_ - 1) ||
-        (neighbours[i] % board_size_ == board_size_ - 1 &&
-         cell % board_size_ == 0)) {
-      neighbours.erase(neighbours.begin() + i);
-    }
-  }
-  return neighbours;
+absl::Span<const int> HexState::AdjacentCells(int cell) const {
+  return static_cast<const HexGame&>(*game_).AdjacentCells(cell);
 }
 
 HexState::HexState(std::shared_ptr<const Game> game, int board_size)
     : State(game), board_size_(board_size) {
   board_.resize(board_size * board_size, CellState::kEmpty);
+  groups_.resize(board_size * board_size);
 }
 
 std::string HexState::ToString() const {
@@ -239,7 +267,7 @@ std::string HexState::ToString() const {
       line_num++;
       absl::StrAppend(&str, std::string(line_num, ' '));
     }
-    absl::StrAppend(&str, StateToString(board_[cell]));
+    absl::StrAppend(&str, StateToString(BoardAt(cell)));
     absl::StrAppend(&str, " ");
   }
   return str;
@@ -248,7 +276,20 @@ std::string HexState::ToString() const {
 bool HexState::IsTerminal() const { return result_black_perspective_ != 0; }
 
 std::vector<double> HexState::Returns() const {
-  return {result_black_perspective_, -result_black_perspective_};
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void HexState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  // Set each value directly: negating a 0 would give -0.0.
+  returns[0] = result_black_perspective_ > 0 ? 1.0
+               : result_black_perspective_ < 0 ? -1.0
+                                               : 0.0;
+  returns[1] = result_black_perspective_ < 0 ? 1.0
+               : result_black_perspective_ > 0 ? -1.0
+                                               : 0.0;
 }
 
 std::string HexState::InformationStateString(Player player) const {
@@ -261,24 +302,93 @@ std::string HexState::ObservationString(Player player) const {
   return ToString();
 }
 
+template <class T>
+void HexState::WriteObservationTensor(Player player,
+                                      TensorView<2, T>& view) const {
+  // TODO(author8): Make an option to not expose connection info
+  for (int cell = 0; cell < board_.size(); ++cell) {
+    view[{static_cast<int>(BoardAt(cell)) - kMinValueCellState, cell}] = 1.0;
+  }
+}
+
 void HexState::ObservationTensor(Player player,
                                  std::vector<double>* values) const {
-  // TODO(author8): Make an option to not expose connection info
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   TensorView<2> view(values, {kCellStates, static_cast<int>(board_.size())},
                      true);
-  for (int cell = 0; cell < board_.size(); ++cell) {
-    view[{static_cast<int>(board_[cell]) - kMinValueCellState, cell}] = 1.0;
-  }
+  WriteObservationTensor(player, view);
+}
+
+void HexState::ObservationTensor(Player player,
+                                 absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(
+      values, {kCellStates, static_cast<int>(board_.size())}, true);
+  WriteObservationTensor(player, view);
 }
 
 std::unique_ptr<State> HexState::Clone() const {
   return std::unique_ptr<State>(new HexState(*this));
 }
 
+bool HexState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const HexState&>(other);
+  State::operator=(state);
+  board_ = state.board_;
+  groups_ = state.groups_;
+  joins_ = state.joins_;
+  num_joins_ = state.num_joins_;
+  current_player_ = state.current_player_;
+  result_black_perspective_ = state.result_black_perspective_;
+  return true;
+}
+
+uint64_t HexState::Hash() const {
+  uint64_t hash = 0;
+  for (int cell = 0; cell < board_.size(); ++cell) {
+    if (board_[cell] != CellState::kEmpty) {
+      hash ^= HashMix(cell * kCellStates +
+                      (static_cast<int>(BoardAt(cell)) - kMinValueCellState));
+    }
+  }
+  return HashMix(hash ^ current_player_);
+}
+
 HexGame::HexGame(const GameParameters& params)
-    : Game(kGameType, params), board_size_(ParameterValue<int>("board_size")) {}
+    : Game(kGameType, params), board_size_(ParameterValue<int>("board_size")) {
+  const int num_cells = board_size_ * board_size_;
+  adjacent_cell_offsets_.reserve(num_cells + 1);
+  adjacent_cell_offsets_.push_back(0);
+  for (int cell = 0; cell < num_cells; ++cell) {
+    const int column = cell % board_size_;
+    const std::array<int, kMaxNeighbours> neighbours = {
+        cell - board_size_, cell - board_size_ + 1, cell - 1,
+        cell + 1,           cell + board_size_ - 1, cell + board_size_};
+    for (int neighbour : neighbours) {
+      // Skip the neighbours off the board, and those wrapping around from one
+      // side of it to the other.
+      if (neighbour < 0 || neighbour >= num_cells ||
+          (neighbour % board_size_ == 0 && column == board_size_ - 1) ||
+          (neighbour % board_size_ == board_size_ - 1 && column == 0)) {
+        continue;
+      }
+      adjacent_cells_.push_back(neighbour);
+    }
+    adjacent_cell_offsets_.push_back(adjacent_cells_.size());
+  }
+}
+
+absl::Span<const int> HexGame::AdjacentCells(int cell) const {
+  return absl::MakeConstSpan(adjacent_cells_)
+      .subspan(adjacent_cell_offsets_[cell],
+               adjacent_cell_offsets_[cell + 1] - adjacent_cell_offsets_[cell]);
+}
 }  // namespace hex
 }  // namespace open_spiel
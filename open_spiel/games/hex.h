@@ -21,7 +21,9 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // The classic game of Hex: https://en.wikipedia.org/wiki/Hex_(board_game)
 // Does not implement pie rule to balance the game
@@ -74,23 +76,67 @@ class HexState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  uint64_t Hash() const override;
   std::vector<Action> LegalActions() const override;
-  CellState BoardAt(int cell) const { return board_[cell]; }
+  void LegalActions(std::vector<Action>* actions) const override;
+  void UndoAction(Player player, Action move) override;
+  bool SupportsUndoAction() const override { return true; }
+  // The state of the cell, with the edges its group is connected to.
+  CellState BoardAt(int cell) const;
 
  protected:
+  // The colour of the stone on each cell: kEmpty, kBlack or kWhite. The
+  // edges they are connected to are those of their groups.
   std::vector<CellState> board_;
   void DoApplyAction(Action move) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
+  // The groups of connected stones are kept in a disjoint-set forest, with
+  // union by size, so that each move finds the edges its neighbours are
+  // connected to in near-constant time, instead of relabelling the cells of
+  // the groups it joins. Without path compression, joins can be undone.
+  struct Group {
+    int parent;
+    int size;
+    int edges;  // The bits of kFirstEdge and kSecondEdge.
+  };
+  // For black, the north and south edges. For white, west and east.
+  static constexpr int kFirstEdge = 1;
+  static constexpr int kSecondEdge = 2;
+  // A join of two groups, with the group joined to the other.
+  struct Join {
+    int child;
+    int parent;
+    int parent_edges;
+  };
+
   CellState PlayerAndActionToState(Player player, Action move) const;
+  // The edges a stone of the player touches at the cell.
+  int CellEdges(Player player, int cell) const;
+  int FindGroupLeader(int cell) const;
+  // Joins the groups of the cells, and returns whether they were different.
+  bool JoinGroups(int cell_a, int cell_b);
+
   Player current_player_ = 0;                      // Player zero goes first
   double result_black_perspective_ = 0;            // 1 if Black (player 0) wins
-  std::vector<int> AdjacentCells(int cell) const;  // Cells adjacent to cell
+  // Cells adjacent to cell, from the table of the game.
+  absl::Span<const int> AdjacentCells(int cell) const;
+  std::vector<Group> groups_;  // By cell, for the cells with stones.
+  std::vector<Join> joins_;
+  std::vector<int> num_joins_;  // The number of joins of each move.
   const int board_size_;
 };
 
@@ -115,8 +161,16 @@ class HexGame : public Game {
   }
   int MaxGameLength() const override { return board_size_ * board_size_; }
 
+  // The cells adjacent to `cell`, from a table built with the game and
+  // shared by its states.
+  absl::Span<const int> AdjacentCells(int cell) const;
+
  private:
   const int board_size_;
+  // The adjacent cells of all the cells, those of cell c being in
+  // [adjacent_cell_offsets_[c], adjacent_cell_offsets_[c + 1]).
+  std::vector<int> adjacent_cells_;
+  std::vector<int> adjacent_cell_offsets_;
 };
 
 std::string StateToString(CellState state);
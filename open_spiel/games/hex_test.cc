@@ -12,6 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/games/hex.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -26,10 +32,81 @@ void BasicHexTests() {
   testing::NoChanceOutcomesTest(*LoadGame("hex(board_size=5)"));
   testing::RandomSimTest(*LoadGame("hex(board_size=5)"), 100);
   testing::RandomSimTest(*LoadGame("hex"), 5);
+  testing::RandomSimTestWithUndo(*LoadGame("hex(board_size=5)"), 10);
+}
+
+// Returns the edges connected to the stone on the cell, by a flood fill.
+std::pair<bool, bool> ConnectedEdges(const HexState& state, int board_size,
+                                     int cell) {
+  const bool black = state.BoardAt(cell) > CellState::kEmpty;
+  std::vector<bool> visited(board_size * board_size, false);
+  std::vector<int> stack = {cell};
+  visited[cell] = true;
+  std::pair<bool, bool> edges = {false, false};
+  while (!stack.empty()) {
+    const int c = stack.back();
+    stack.pop_back();
+    const int row = c / board_size, col = c % board_size;
+    edges.first |= black ? row == 0 : col == 0;
+    edges.second |= black ? row == board_size - 1 : col == board_size - 1;
+    const int offsets[6][2] = {{-1, 0}, {-1, 1}, {0, -1},
+                               {0, 1},  {1, -1}, {1, 0}};
+    for (const auto& offset : offsets) {
+      const int r = row + offset[0], q = col + offset[1];
+      if (r < 0 || r >= board_size || q < 0 || q >= board_size) continue;
+      const int n = r * board_size + q;
+      if (!visited[n] && state.BoardAt(n) != CellState::kEmpty &&
+          (state.BoardAt(n) > CellState::kEmpty) == black) {
+        visited[n] = true;
+        stack.push_back(n);
+      }
+    }
+  }
+  return edges;
+}
+
+void EdgeConnectionsMatchFloodFill() {
+  const int board_size = 7;
+  std::shared_ptr<const Game> game =
+      LoadGame("hex", {{"board_size", GameParameter(board_size)}});
+  std::mt19937 rng(0);
+  for (int game_index = 0; game_index < 20; ++game_index) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(
+          actions[std::uniform_int_distribution<int>(0, actions.size() - 1)(
+              rng)]);
+      if (state->IsTerminal()) break;
+      const auto& hex_state = static_cast<const HexState&>(*state);
+      for (int cell = 0; cell < board_size * board_size; ++cell) {
+        const CellState cell_state = hex_state.BoardAt(cell);
+        if (cell_state == CellState::kEmpty) continue;
+        const std::pair<bool, bool> edges =
+            ConnectedEdges(hex_state, board_size, cell);
+        SPIEL_CHECK_FALSE(edges.first && edges.second);
+        SPIEL_CHECK_EQ(edges.first, cell_state == CellState::kBlackNorth ||
+                                        cell_state == CellState::kWhiteWest);
+        SPIEL_CHECK_EQ(edges.second, cell_state == CellState::kBlackSouth ||
+                                         cell_state == CellState::kWhiteEast);
+      }
+    }
+    // Exactly the winning stone is shown as such.
+    const auto& hex_state = static_cast<const HexState&>(*state);
+    int num_winning = 0;
+    for (int cell = 0; cell < board_size * board_size; ++cell) {
+      num_winning += hex_state.BoardAt(cell) == CellState::kBlackWin ||
+                     hex_state.BoardAt(cell) == CellState::kWhiteWin;
+    }
+    SPIEL_CHECK_EQ(num_winning, 1);
+  }
 }
 
 }  // namespace
 }  // namespace hex
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::hex::BasicHexTests(); }
+int main(int argc, char** argv) {
+  open_spiel::hex::BasicHexTests();
+  open_spiel::hex::EdgeConnectionsMatchFloodFill();
+}
@@ -19,6 +19,7 @@
 #include <string>
 #include <utility>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
 
@@ -52,6 +53,13 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 }
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
+
+// Number of betting sequences seen by a player: either j <= num_players
+// passes, or k < num_players passes followed by a bet and fewer than
+// num_players responses.
+int64_t NumBettingSequences(int num_players) {
+  return num_players + 1 + num_players * ((int64_t{1} << num_players) - 1);
+}
 }  // namespace
 
 KuhnState::KuhnState(std::shared_ptr<const Game> game)
@@ -155,97 +163,176 @@ std::string KuhnState::ToString() const {
 bool KuhnState::IsTerminal() const { return winner_ != kInvalidPlayer; }
 
 std::vector<double> KuhnState::Returns() const {
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void KuhnState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
   if (!IsTerminal()) {
-    return {0.0, 0.0};
+    std::fill(returns.begin(), returns.end(), 0.0);
+    return;
   }
-
-  std::vector<double> returns(num_players_);
   for (auto player = Player{0}; player < num_players_; ++player) {
     const int bet = DidBet(player) ? 2 : 1;
     returns[player] = (player == winner_) ? (pot_ - bet) : -bet;
   }
-  return returns;
 }
 
 // Information state is card then bets, e.g. 1pb
 std::string KuhnState::InformationStateString(Player player) const {
+  std::string str;
+  AppendInformationStateString(player, &str);
+  return str;
+}
+
+void KuhnState::AppendInformationStateString(Player player,
+                                             std::string* str) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  if (history_.size() <= player) return "";
-  std::string str = std::to_string(history_[player]);
+  if (history_.size() <= player) return;
+  absl::StrAppend(str, history_[player]);
   for (int i = num_players_; i < history_.size(); ++i)
-    str.push_back(history_[i] ? 'b' : 'p');
-  return str;
+    str->push_back(history_[i] ? 'b' : 'p');
+}
+
+int64_t KuhnState::InformationStateIndex(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  // Index 0 is the empty information state before the player's card is dealt.
+  if (history_.size() <= player) return 0;
+  int num_passes = 0;
+  while (num_players_ + num_passes < history_.size() &&
+         history_[num_players_ + num_passes] == ActionType::kPass) {
+    ++num_passes;
+  }
+  int64_t sequence = num_passes;
+  if (num_players_ + num_passes < history_.size()) {
+    // Someone bet; the responses so far are encoded as binary digits.
+    int num_responses = history_.size() - num_players_ - num_passes - 1;
+    int64_t responses = 0;
+    for (int i = history_.size() - num_responses; i < history_.size(); ++i) {
+      responses = 2 * responses + history_[i];
+    }
+    sequence = num_players_ + 1 +
+               num_passes * ((int64_t{1} << num_players_) - 1) +
+               (int64_t{1} << num_responses) - 1 + responses;
+  }
+  return 1 + history_[player] * NumBettingSequences(num_players_) + sequence;
 }
 
 // Observation is card then contributions to the pot, e.g. 111
 std::string KuhnState::ObservationString(Player player) const {
+  std::string str;
+  AppendObservationString(player, &str);
+  return str;
+}
+
+void KuhnState::AppendObservationString(Player player,
+                                        std::string* str) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  if (history_.size() <= player) return "";
-  std::string str = std::to_string(history_[player]);
+  if (history_.size() <= player) return;
+  absl::StrAppend(str, history_[player]);
 
   // Adding the contribution of each players to the pot. These values are not
   // between 0 and 1.
   for (auto p = Player{0}; p < num_players_; p++) {
-    str += std::to_string(ante_[p]);
+    absl::StrAppend(str, ante_[p]);
   }
-  return str;
 }
 
-void KuhnState::InformationStateTensor(Player player,
-                                       std::vector<double>* values) const {
+template <typename SetValue>
+void KuhnState::EncodeInformationStateTensor(Player player,
+                                             SetValue set_value) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  // Initialize the vector with zeroes.
-  values->resize(6 * num_players_ - 1);
-  std::fill(values->begin(), values->end(), 0.);
-
   // The current player
-  (*values)[player] = 1;
+  set_value(player, 1);
 
   // The player's card, if one has been dealt.
-  if (history_.size() > player) (*values)[num_players_ + history_[player]] = 1;
+  if (history_.size() > player) set_value(num_players_ + history_[player], 1);
 
   // Betting sequence.
   for (int i = num_players_; i < history_.size(); ++i) {
-    (*values)[1 + 2 * i + history_[i]] = 1;
+    set_value(1 + 2 * i + history_[i], 1);
   }
 }
 
-void KuhnState::ObservationTensor(Player player,
-                                  std::vector<double>* values) const {
+template <typename SetValue>
+void KuhnState::EncodeObservationTensor(Player player,
+                                        SetValue set_value) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
   // The format is described in ObservationTensorShape
   // The last elements of this vector contain the contribution to the pot of
   // each player. These values are thus not normalized.
 
-  // Initialize the vector with zeroes.
-  values->resize(3 * num_players_ + 1);
-  std::fill(values->begin(), values->end(), 0.);
-
   // The current player
-  (*values)[player] = 1;
+  set_value(player, 1);
 
   // The player's card, if one has been dealt.
-  if (history_.size() > player) (*values)[num_players_ + history_[player]] = 1;
+  if (history_.size() > player) set_value(num_players_ + history_[player], 1);
 
   int offset = 2 * num_players_ + 1;
   // Adding the contribution of each players to the pot. These values are not
   // between 0 and 1.
   for (auto p = Player{0}; p < num_players_; p++) {
-    (*values)[offset + p] = ante_[p];
+    set_value(offset + p, ante_[p]);
   }
 }
 
+void KuhnState::InformationStateTensor(Player player,
+                                       std::vector<double>* values) const {
+  // Initialize the vector with zeroes.
+  values->resize(6 * num_players_ - 1);
+  std::fill(values->begin(), values->end(), 0.);
+  EncodeInformationStateTensor(
+      player, [values](int index, double value) { (*values)[index] = value; });
+}
+
+void KuhnState::ObservationTensor(Player player,
+                                  std::vector<double>* values) const {
+  // Initialize the vector with zeroes.
+  values->resize(3 * num_players_ + 1);
+  std::fill(values->begin(), values->end(), 0.);
+  EncodeObservationTensor(
+      player, [values](int index, double value) { (*values)[index] = value; });
+}
+
+void KuhnState::SparseInformationStateTensor(Player player,
+                                             SparseTensor* tensor) const {
+  tensor->Clear();
+  EncodeInformationStateTensor(
+      player, [tensor](int index, float value) {
+        if (value != 0) tensor->Add(index, value);
+      });
+}
+
+void KuhnState::SparseObservationTensor(Player player,
+                                        SparseTensor* tensor) const {
+  tensor->Clear();
+  EncodeObservationTensor(
+      player, [tensor](int index, float value) {
+        if (value != 0) tensor->Add(index, value);
+      });
+}
+
 std::unique_ptr<State> KuhnState::Clone() const {
   return std::unique_ptr<State>(new KuhnState(*this));
 }
 
+bool KuhnState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const KuhnState&>(other);
+  return true;
+}
+
 void KuhnState::UndoAction(Player player, Action move) {
   if (history_.size() <= num_players_) {
     // Undoing a deal move.
@@ -262,13 +349,31 @@ void KuhnState::UndoAction(Player player, Action move) {
 }
 
 std::vector<std::pair<Action, double>> KuhnState::ChanceOutcomes() const {
+  return DealDistribution().outcomes();
+}
+
+std::pair<Action, double> KuhnState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  return DealDistribution().Sample(rng);
+}
+
+const ChanceDistribution& KuhnState::DealDistribution() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
-  std::vector<std::pair<Action, double>> outcomes;
-  const double p = 1.0 / (num_players_ + 1 - history_.size());
+  int64_t dealt = 0;
   for (int card = 0; card < card_dealt_.size(); ++card) {
-    if (card_dealt_[card] == kInvalidPlayer) outcomes.push_back({card, p});
+    if (card_dealt_[card] != kInvalidPlayer) dealt |= int64_t{1} << card;
   }
-  return outcomes;
+  return static_cast<const KuhnGame&>(*game_).deal_distributions().Get(
+      dealt, [this]() {
+        std::vector<std::pair<Action, double>> outcomes;
+        const double p = 1.0 / (num_players_ + 1 - history_.size());
+        for (int card = 0; card < card_dealt_.size(); ++card) {
+          if (card_dealt_[card] == kInvalidPlayer) {
+            outcomes.push_back({card, p});
+          }
+        }
+        return outcomes;
+      });
 }
 
 bool KuhnState::DidBet(Player player) const {
@@ -317,6 +422,11 @@ std::unique_ptr<State> KuhnGame::NewInitialState() const {
   return std::unique_ptr<State>(new KuhnState(shared_from_this()));
 }
 
+int64_t KuhnGame::NumInformationStates() const {
+  // The empty information state, then one per card and betting sequence.
+  return 1 + (num_players_ + 1) * NumBettingSequences(num_players_);
+}
+
 std::vector<int> KuhnGame::InformationStateTensorShape() const {
   // One-hot for whose turn it is.
   // One-hot encoding for the single private card. (n+1 cards = n+1 bits)
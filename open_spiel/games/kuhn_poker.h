@@ -20,6 +20,8 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/spiel.h"
 
 // A simple game that includes chance and imperfect information
@@ -55,15 +57,28 @@ class KuhnState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string InformationStateString(Player player) const override;
+  void AppendInformationStateString(Player player,
+                                    std::string* str) const override;
+  int64_t InformationStateIndex(Player player) const override;
   std::string ObservationString(Player player) const override;
+  void AppendObservationString(Player player, std::string* str) const override;
   void InformationStateTensor(Player player,
                               std::vector<double>* values) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void SparseInformationStateTensor(Player player,
+                                    SparseTensor* tensor) const override;
+  void SparseObservationTensor(Player player,
+                               SparseTensor* tensor) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
   void UndoAction(Player player, Action move) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
   std::vector<Action> LegalActions() const override;
   std::vector<int> hand() const { return {card_dealt_[CurrentPlayer()]}; }
   std::unique_ptr<State> ResampleFromInfostate(
@@ -76,6 +91,17 @@ class KuhnState : public State {
   // Whether the specified player made a bet
   bool DidBet(Player player) const;
 
+  // The distribution of the next card dealt, shared by the states of the game
+  // with the same cards dealt.
+  const ChanceDistribution& DealDistribution() const;
+
+  // Call set_value(index, value) for the elements of the tensors that may be
+  // nonzero, which are shared by the dense and sparse versions.
+  template <typename SetValue>
+  void EncodeInformationStateTensor(Player player, SetValue set_value) const;
+  template <typename SetValue>
+  void EncodeObservationTensor(Player player, SetValue set_value) const;
+
   // The move history and number of players are sufficient information to
   // specify the state of the game. We keep track of more information to make
   // extracting legal actions and utilities easier.
@@ -103,13 +129,22 @@ class KuhnGame : public Game {
   std::shared_ptr<const Game> Clone() const override {
     return std::shared_ptr<const Game>(new KuhnGame(*this));
   }
+  int64_t NumInformationStates() const override;
   std::vector<int> InformationStateTensorShape() const override;
   std::vector<int> ObservationTensorShape() const override;
+  bool InformationStateTensorIsSparse() const override { return true; }
+  bool ObservationTensorIsSparse() const override { return true; }
   int MaxGameLength() const override { return num_players_ * 2 - 1; }
 
+  // The distributions of the deals, keyed by the set of cards dealt.
+  const ChanceDistributionCache& deal_distributions() const {
+    return deal_distributions_;
+  }
+
  private:
   // Number of players.
   int num_players_;
+  ChanceDistributionCache deal_distributions_;
 };
 
 }  // namespace kuhn_poker
@@ -34,6 +34,26 @@ void BasicKuhnTests() {
   }
 }
 
+void DealDistributionsTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  const auto& kuhn = static_cast<const KuhnGame&>(*game);
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(state->ChanceOutcomes().size(), 3);
+  SPIEL_CHECK_EQ(kuhn.deal_distributions().size(), 1);
+  // The deals with the same cards dealt share a distribution.
+  for (Action card : {0, 1, 2}) {
+    std::unique_ptr<State> child = state->Child(card);
+    SPIEL_CHECK_EQ(child->ChanceOutcomes().size(), 2);
+    SPIEL_CHECK_FLOAT_EQ(child->ChanceOutcomes()[0].second, 0.5);
+    SPIEL_CHECK_EQ(state->ChanceOutcomes().size(), 3);
+  }
+  SPIEL_CHECK_EQ(kuhn.deal_distributions().size(), 4);
+  // Copies of the game start with an empty cache.
+  std::shared_ptr<const Game> copy = game->Clone();
+  SPIEL_CHECK_EQ(
+      static_cast<const KuhnGame&>(*copy).deal_distributions().size(), 0);
+}
+
 void CountStates() {
   std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
   auto states = algorithms::GetAllStates(*game, /*depth_limit=*/-1,
@@ -50,10 +70,15 @@ void CountStates() {
 int main(int argc, char **argv) {
   open_spiel::kuhn_poker::BasicKuhnTests();
   open_spiel::kuhn_poker::CountStates();
+  open_spiel::kuhn_poker::DealDistributionsTest();
   open_spiel::testing::CheckChanceOutcomes(*open_spiel::LoadGame(
       "kuhn_poker", {{"players", open_spiel::GameParameter(3)}}));
   open_spiel::testing::RandomSimTest(*open_spiel::LoadGame("kuhn_poker"),
                                      /*num_sims=*/10);
+  open_spiel::testing::CheckInformationStateIndices(
+      *open_spiel::LoadGame("kuhn_poker"));
+  open_spiel::testing::CheckInformationStateIndices(*open_spiel::LoadGame(
+      "kuhn_poker", {{"players", open_spiel::GameParameter(4)}}));
   open_spiel::testing::ResampleInfostateTest(
       *open_spiel::LoadGame("kuhn_poker"),
       /*num_sims=*/10);
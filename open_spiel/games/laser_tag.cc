@@ -116,7 +116,9 @@ constexpr std::array<std::array<int, 10>, 4> col_offsets = {
 }  // namespace
 
 LaserTagState::LaserTagState(std::shared_ptr<const Game> game, const Grid& grid)
-    : SimMoveState(game), grid_(grid) {}
+    : SimMoveState(game), grid_(grid) {
+  EnableLegalActionsCache();
+}
 
 std::string LaserTagState::ActionToString(int player, Action action_id) const {
   if (player == kSimultaneousPlayerId)
@@ -182,6 +184,7 @@ char LaserTagState::field(int r, int c) const {
 }
 
 void LaserTagState::Reset(int horizon, bool zero_sum) {
+  InvalidateLegalActionsCache();
   num_tags_ = 0;
   horizon_ = horizon;
   zero_sum_rewards_ = zero_sum;
@@ -200,6 +203,7 @@ void LaserTagState::Reset(int horizon, bool zero_sum) {
 }
 
 void LaserTagState::DoApplyActions(const std::vector<Action>& moves) {
+  InvalidateLegalActionsCache();
   SPIEL_CHECK_EQ(moves.size(), 2);
   SPIEL_CHECK_EQ(cur_player_, kSimultaneousPlayerId);
   moves_[0] = moves[0];
@@ -329,6 +333,7 @@ void LaserTagState::DoApplyAction(Action action_id) {
     return;
   }
   SPIEL_CHECK_TRUE(IsChanceNode());
+  InvalidateLegalActionsCache();
   SPIEL_CHECK_GE(action_id, 0);
   SPIEL_CHECK_LT(action_id, game_->MaxChanceOutcomes());
 
@@ -467,6 +472,18 @@ int LaserTagState::observation_plane(int r, int c) const {
   return plane;
 }
 
+template <class T>
+void LaserTagState::WriteObservationTensor(Player player,
+                                           TensorView<3, T>& view) const {
+  for (int r = 0; r < grid_.num_rows; r++) {
+    for (int c = 0; c < grid_.num_cols; c++) {
+      int plane = observation_plane(r, c);
+      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
+      view[{plane, r, c}] = 1.0;
+    }
+  }
+}
+
 void LaserTagState::ObservationTensor(int player,
                                       std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
@@ -474,14 +491,17 @@ void LaserTagState::ObservationTensor(int player,
 
   TensorView<3> view(values, {kCellStates, grid_.num_rows, grid_.num_cols},
                      true);
+  WriteObservationTensor(player, view);
+}
 
-  for (int r = 0; r < grid_.num_rows; r++) {
-    for (int c = 0; c < grid_.num_cols; c++) {
-      int plane = observation_plane(r, c);
-      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
-      view[{plane, r, c}] = 1.0;
-    }
-  }
+void LaserTagState::ObservationTensor(int player,
+                                      absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<3, float> view(
+      values, {kCellStates, grid_.num_rows, grid_.num_cols}, true);
+  WriteObservationTensor(player, view);
 }
 
 std::unique_ptr<State> LaserTagState::Clone() const {
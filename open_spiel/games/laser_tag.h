@@ -20,8 +20,10 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // A fully observable version of the first-person gridworld laser tag game from
 // [1,2]. This version is not first-person and not partially observable, but
@@ -92,6 +94,8 @@ class LaserTagState : public SimMoveState {
   }
   void ObservationTensor(int player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(int player,
+                         absl::Span<float> values) const override;
   int CurrentPlayer() const override {
     return IsTerminal() ? kTerminalPlayerId : cur_player_;
   }
@@ -107,6 +111,10 @@ class LaserTagState : public SimMoveState {
   void DoApplyActions(const std::vector<Action>& moves) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<3, T>& view) const;
   void SetField(int r, int c, char v);
   char field(int r, int c) const;
   bool ResolveMove(int player, int move);  // Return true if there was a tag
@@ -19,6 +19,7 @@
 #include <numeric>
 #include <utility>
 
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
 #include "open_spiel/game_parameters.h"
@@ -52,6 +53,15 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// Appends the values separated by spaces, as absl::StrJoin(values, " ").
+template <typename T>
+void AppendJoined(const std::vector<T>& values, std::string* str) {
+  for (int i = 0; i < values.size(); ++i) {
+    if (i > 0) str->push_back(' ');
+    absl::StrAppend(str, values[i]);
+  }
+}
+
 }  // namespace
 LeducState::LeducState(std::shared_ptr<const Game> game)
     : State(game),
@@ -115,6 +125,8 @@ void LeducState::DoApplyAction(Action move) {
     }
   } else if (move == ActionType::kFold) {
     SPIEL_CHECK_NE(cur_player_, kChancePlayerId);
+    bet_undo_info_.push_back(
+        {num_calls_, num_raises_, round_, stakes_, ante_[cur_player_]});
     SequenceAppendMove(ActionType::kFold);
 
     // Player is now out.
@@ -136,6 +148,8 @@ void LeducState::DoApplyAction(Action move) {
     // off. Note: this action also acts as a 'check' where the stakes are equal
     // to each player's ante.
     SPIEL_CHECK_GE(stakes_, ante_[cur_player_]);
+    bet_undo_info_.push_back(
+        {num_calls_, num_raises_, round_, stakes_, ante_[cur_player_]});
     int amount = stakes_ - ante_[cur_player_];
     Ante(cur_player_, amount);
     num_calls_++;
@@ -153,6 +167,8 @@ void LeducState::DoApplyAction(Action move) {
 
     // This player matches the current stakes and then brings the stakes up.
     SPIEL_CHECK_LT(num_raises_, kMaxRaises);
+    bet_undo_info_.push_back(
+        {num_calls_, num_raises_, round_, stakes_, ante_[cur_player_]});
     int call_amount = stakes_ - ante_[cur_player_];
 
     // First, match the current stakes if necessary
@@ -180,6 +196,54 @@ void LeducState::DoApplyAction(Action move) {
   }
 }
 
+void LeducState::UndoAction(Player player, Action move) {
+  if (player == kChancePlayerId) {
+    if (public_card_ != kInvalidCard) {
+      // Undoing the public card.
+      deck_[move] = public_card_;
+      public_card_ = kInvalidCard;
+    } else {
+      // Undoing a private card.
+      --private_cards_dealt_;
+      deck_[move] = private_cards_[private_cards_dealt_];
+      private_cards_[private_cards_dealt_] = kInvalidCard;
+    }
+    ++deck_size_;
+    cur_player_ = kChancePlayerId;
+  } else {
+    const bool terminal = IsTerminal();
+    const BetUndoInfo& info = bet_undo_info_.back();
+    if (info.round == 1) {
+      round1_sequence_.pop_back();
+    } else {
+      round2_sequence_.pop_back();
+    }
+    if (move == ActionType::kFold) {
+      folded_[player] = false;
+      remaining_players_++;
+    }
+    Ante(player, info.ante - ante_[player]);
+    num_calls_ = info.num_calls;
+    num_raises_ = info.num_raises;
+    round_ = info.round;
+    stakes_ = info.stakes;
+    cur_player_ = player;
+    bet_undo_info_.pop_back();
+    if (terminal) {
+      // Take back the pot from the winners: until then, every player's money
+      // is what they did not put in.
+      num_winners_ = kInvalidPlayer;
+      std::fill(winner_.begin(), winner_.end(), false);
+      pot_ = 0;
+      for (auto p = Player{0}; p < num_players_; p++) {
+        pot_ += ante_[p];
+        money_[p] = kStartingMoney - ante_[p];
+      }
+    }
+  }
+  history_.pop_back();
+}
+
 std::vector<Action> LeducState::LegalActions() const {
   if (IsTerminal()) return {};
   std::vector<Action> movelist;
@@ -251,65 +315,79 @@ bool LeducState::IsTerminal() const {
 }
 
 std::vector<double> LeducState::Returns() const {
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void LeducState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
   if (!IsTerminal()) {
-    return std::vector<double>(num_players_, 0.0);
+    std::fill(returns.begin(), returns.end(), 0.0);
+    return;
   }
-
-  std::vector<double> returns(num_players_);
   for (auto player = Player{0}; player < num_players_; ++player) {
     // Money vs money at start.
     returns[player] = money_[player] - kStartingMoney;
   }
-
-  return returns;
 }
 
 // Information state is card then bets.
 std::string LeducState::InformationStateString(Player player) const {
+  std::string str;
+  AppendInformationStateString(player, &str);
+  return str;
+}
 
+void LeducState::AppendInformationStateString(Player player,
+                                              std::string* str) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
   // TODO(author1): Fix typos in InformationState string.
-  return absl::StrFormat(
-      "[Round %i][Player: %i][Pot: %i][Money: %s[Private: %i]][Round1]: "
-      "%s[Public: %i]\nRound 2 sequence: %s",
-      round_, cur_player_, pot_, absl::StrJoin(money_, " "),
-      private_cards_[player], absl::StrJoin(round1_sequence_, " "),
-      public_card_, absl::StrJoin(round2_sequence_, " "));
+  absl::StrAppend(str, "[Round ", round_, "][Player: ", cur_player_,
+                  "][Pot: ", pot_, "][Money: ");
+  AppendJoined(money_, str);
+  absl::StrAppend(str, "[Private: ", private_cards_[player], "]][Round1]: ");
+  AppendJoined(round1_sequence_, str);
+  absl::StrAppend(str, "[Public: ", public_card_, "]\nRound 2 sequence: ");
+  AppendJoined(round2_sequence_, str);
 }
 
 // Observation is card then contribution of each players to the pot.
 std::string LeducState::ObservationString(Player player) const {
+  std::string str;
+  AppendObservationString(player, &str);
+  return str;
+}
+
+void LeducState::AppendObservationString(Player player,
+                                         std::string* str) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
-  std::string result;
 
-  absl::StrAppend(&result, "[Round ", round_, "][Player: ", cur_player_,
+  absl::StrAppend(str, "[Round ", round_, "][Player: ", cur_player_,
                   "][Pot: ", pot_, "][Money:");
   for (auto p = Player{0}; p < num_players_; p++) {
-    absl::StrAppend(&result, " ", money_[p]);
+    absl::StrAppend(str, " ", money_[p]);
   }
   // Add the player's private cards
   if (player != kChancePlayerId) {
-    absl::StrAppend(&result, "[Private: ", private_cards_[player], "]");
+    absl::StrAppend(str, "[Private: ", private_cards_[player], "]");
   }
   // Adding the contribution of each players to the pot
-  absl::StrAppend(&result, "[Ante:");
+  absl::StrAppend(str, "[Ante:");
   for (auto p = Player{0}; p < num_players_; p++) {
-    absl::StrAppend(&result, " ", ante_[p]);
+    absl::StrAppend(str, " ", ante_[p]);
   }
-  absl::StrAppend(&result, "]");
-
-  return result;
+  absl::StrAppend(str, "]");
 }
 
-void LeducState::InformationStateTensor(Player player,
-                                        std::vector<double>* values) const {
+template <typename SetValue>
+void LeducState::EncodeInformationStateTensor(Player player,
+                                              SetValue set_value) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
-
-  values->resize(game_->InformationStateTensorShape()[0]);
-  std::fill(values->begin(), values->end(), 0.);
+  const int size = game_->InformationStateTensorShape()[0];
 
   // Layout of observation:
   //   my player number: num_players bits
@@ -321,16 +399,16 @@ void LeducState::InformationStateTensor(Player player,
   int offset = 0;
 
   // Mark who I am.
-  (*values)[player] = 1;
+  set_value(player, 1);
   offset += num_players_;
 
   if (private_cards_[player] >= 0) {
-    (*values)[offset + private_cards_[player]] = 1;
+    set_value(offset + private_cards_[player], 1);
   }
   offset += deck_.size();
 
   if (public_card_ >= 0) {
-    (*values)[offset + public_card_] = 1;
+    set_value(offset + public_card_, 1);
   }
   offset += deck_.size();
 
@@ -339,20 +417,15 @@ void LeducState::InformationStateTensor(Player player,
         (r == 1 ? round1_sequence_ : round2_sequence_);
 
     for (int i = 0; i < round_sequence.size(); ++i) {
-      SPIEL_CHECK_LT(offset + i + 1, values->size());
+      SPIEL_CHECK_LT(offset + i + 1, size);
       if (round_sequence[i] == ActionType::kCall) {
         // Encode call as 10.
-        (*values)[offset + (2 * i)] = 1;
-        (*values)[offset + (2 * i) + 1] = 0;
+        set_value(offset + (2 * i), 1);
       } else if (round_sequence[i] == ActionType::kRaise) {
         // Encode raise as 01.
-        (*values)[offset + (2 * i)] = 0;
-        (*values)[offset + (2 * i) + 1] = 1;
-      } else {
-        // Encode fold as 00.
-        (*values)[offset + (2 * i)] = 0;
-        (*values)[offset + (2 * i) + 1] = 0;
+        set_value(offset + (2 * i) + 1, 1);
       }
+      // Fold is encoded as 00.
     }
 
     // Move offset up to the next round: 2 bits per move.
@@ -360,14 +433,12 @@ void LeducState::InformationStateTensor(Player player,
   }
 }
 
-void LeducState::ObservationTensor(Player player,
-                                   std::vector<double>* values) const {
+template <typename SetValue>
+void LeducState::EncodeObservationTensor(Player player,
+                                         SetValue set_value) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->resize(game_->ObservationTensorShape()[0]);
-  std::fill(values->begin(), values->end(), 0.);
-
   // Layout of observation:
   //   my player number: num_players bits
   //   my card: deck_.size() bits
@@ -377,38 +448,94 @@ void LeducState::ObservationTensor(Player player,
   int offset = 0;
 
   // Mark who I am.
-  (*values)[player] = 1;
+  set_value(player, 1);
   offset += num_players_;
 
   if (private_cards_[player] >= 0) {
-    (*values)[offset + private_cards_[player]] = 1;
+    set_value(offset + private_cards_[player], 1);
   }
   offset += deck_.size();
 
   if (public_card_ >= 0) {
-    (*values)[offset + public_card_] = 1;
+    set_value(offset + public_card_, 1);
   }
   offset += deck_.size();
   // Adding the contribution of each players to the pot.
   for (auto p = Player{0}; p < num_players_; p++) {
-    (*values)[offset + p] = ante_[p];
+    set_value(offset + p, ante_[p]);
   }
 }
 
+void LeducState::InformationStateTensor(Player player,
+                                        std::vector<double>* values) const {
+  values->resize(game_->InformationStateTensorShape()[0]);
+  std::fill(values->begin(), values->end(), 0.);
+  EncodeInformationStateTensor(
+      player, [values](int index, double value) { (*values)[index] = value; });
+}
+
+void LeducState::ObservationTensor(Player player,
+                                   std::vector<double>* values) const {
+  values->resize(game_->ObservationTensorShape()[0]);
+  std::fill(values->begin(), values->end(), 0.);
+  EncodeObservationTensor(
+      player, [values](int index, double value) { (*values)[index] = value; });
+}
+
+void LeducState::SparseInformationStateTensor(Player player,
+                                              SparseTensor* tensor) const {
+  tensor->Clear();
+  EncodeInformationStateTensor(
+      player, [tensor](int index, float value) {
+        if (value != 0) tensor->Add(index, value);
+      });
+}
+
+void LeducState::SparseObservationTensor(Player player,
+                                         SparseTensor* tensor) const {
+  tensor->Clear();
+  EncodeObservationTensor(
+      player, [tensor](int index, float value) {
+        if (value != 0) tensor->Add(index, value);
+      });
+}
+
 std::unique_ptr<State> LeducState::Clone() const {
   return std::unique_ptr<State>(new LeducState(*this));
 }
 
+bool LeducState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const LeducState&>(other);
+  return true;
+}
+
 std::vector<std::pair<Action, double>> LeducState::ChanceOutcomes() const {
-  SPIEL_CHECK_TRUE(IsChanceNode());
-  std::vector<std::pair<Action, double>> outcomes;
+  return DealDistribution().outcomes();
+}
 
-  const double p = 1.0 / deck_size_;
+std::pair<Action, double> LeducState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  return DealDistribution().Sample(rng);
+}
+
+const ChanceDistribution& LeducState::DealDistribution() const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  SPIEL_CHECK_LE(deck_.size(), 64);
+  int64_t deck = 0;
   for (int card = 0; card < deck_.size(); card++) {
-    // This card is still in the deck, prob is 1/decksize.
-    if (deck_[card] != kInvalidCard) outcomes.push_back({card, p});
+    if (deck_[card] != kInvalidCard) deck |= int64_t{1} << card;
   }
-  return outcomes;
+  return static_cast<const LeducGame&>(*game_).deal_distributions().Get(
+      deck, [this]() {
+        std::vector<std::pair<Action, double>> outcomes;
+        const double p = 1.0 / deck_size_;
+        for (int card = 0; card < deck_.size(); card++) {
+          // This card is still in the deck, prob is 1/decksize.
+          if (deck_[card] != kInvalidCard) outcomes.push_back({card, p});
+        }
+        return outcomes;
+      });
 }
 
 int LeducState::NextPlayer() const {
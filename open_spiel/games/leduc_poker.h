@@ -35,6 +35,8 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/spiel.h"
 
 namespace open_spiel {
@@ -68,15 +70,28 @@ class LeducState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string InformationStateString(Player player) const override;
+  void AppendInformationStateString(Player player,
+                                    std::string* str) const override;
   std::string ObservationString(Player player) const override;
+  void AppendObservationString(Player player, std::string* str) const override;
   void InformationStateTensor(Player player,
                               std::vector<double>* values) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void SparseInformationStateTensor(Player player,
+                                    SparseTensor* tensor) const override;
+  void SparseObservationTensor(Player player,
+                               SparseTensor* tensor) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  void UndoAction(Player player, Action move) override;
+  bool SupportsUndoAction() const override { return true; }
   // The probability of taking each possible action in a particular info state.
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
 
   // Additional methods
   int round() const { return round_; }
@@ -112,6 +127,9 @@ class LeducState : public State {
   void DoApplyAction(Action move) override;
 
  private:
+  // The distribution of the next card dealt, shared by the states of the game
+  // with the same cards left in the deck.
+  const ChanceDistribution& DealDistribution() const;
   int NextPlayer() const;
   void ResolveWinner();
   bool ReadyForNextRound() const;
@@ -121,6 +139,13 @@ class LeducState : public State {
   void Ante(Player player, int amount);
   void SetPrivate(Player player, Action move);
 
+  // Call set_value(index, value) for the elements of the tensors that may be
+  // nonzero, which are shared by the dense and sparse versions.
+  template <typename SetValue>
+  void EncodeInformationStateTensor(Player player, SetValue set_value) const;
+  template <typename SetValue>
+  void EncodeObservationTensor(Player player, SetValue set_value) const;
+
   // Fields sets to bad/invalid values. Use Game::NewInitialState().
   Player cur_player_;
 
@@ -151,6 +176,18 @@ class LeducState : public State {
   // Sequence of actions for each round. Needed to report information state.
   std::vector<int> round1_sequence_;
   std::vector<int> round2_sequence_;
+
+  // What a betting action changed and cannot be recomputed, pushed by
+  // DoApplyAction and popped by UndoAction. Chance outcomes are undone from
+  // the deck alone.
+  struct BetUndoInfo {
+    int num_calls;
+    int num_raises;
+    int round;
+    int stakes;
+    int ante;  // Of the player who acted.
+  };
+  std::vector<BetUndoInfo> bet_undo_info_;
 };
 
 class LeducGame : public Game {
@@ -169,6 +206,8 @@ class LeducGame : public Game {
   }
   std::vector<int> InformationStateTensorShape() const override;
   std::vector<int> ObservationTensorShape() const override;
+  bool InformationStateTensorIsSparse() const override { return true; }
+  bool ObservationTensorIsSparse() const override { return true; }
   int MaxGameLength() const override {
     // 2 rounds. Longest one for e.g. 4-player is, e.g.:
     //   check, check, check, raise, call, call, raise, call, call, call
@@ -176,9 +215,16 @@ class LeducGame : public Game {
     return 2 * (2 + (num_players_ - 1) * 2 + (num_players_ - 2));
   }
 
+  // The distributions of the deals, keyed by the set of cards left in the
+  // deck.
+  const ChanceDistributionCache& deal_distributions() const {
+    return deal_distributions_;
+  }
+
  private:
   int num_players_;  // Number of players.
   int total_cards_;  // Number of cards total cards in the game.
+  ChanceDistributionCache deal_distributions_;
 };
 
 }  // namespace leduc_poker
@@ -25,9 +25,12 @@ void BasicLeducTests() {
   testing::LoadGameTest("leduc_poker");
   testing::ChanceOutcomesTest(*LoadGame("leduc_poker"));
   testing::RandomSimTest(*LoadGame("leduc_poker"), 100);
+  testing::RandomSimTestWithUndo(*LoadGame("leduc_poker"), 100);
   for (Player players = 3; players <= 5; players++) {
     testing::RandomSimTest(
         *LoadGame("leduc_poker", {{"players", GameParameter(players)}}), 100);
+    testing::RandomSimTestWithUndo(
+        *LoadGame("leduc_poker", {{"players", GameParameter(players)}}), 100);
   }
   testing::ResampleInfostateTest(*LoadGame("leduc_poker"), /*num_sims=*/100);
 }
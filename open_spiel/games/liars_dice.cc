@@ -18,6 +18,7 @@
 #include <array>
 #include <utility>
 
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/game_parameters.h"
 
 namespace open_spiel {
@@ -27,10 +28,34 @@ namespace {
 // Default Parameters.
 constexpr int kDefaultPlayers = 2;
 constexpr int kDefaultNumDice = 1;
-constexpr int kDiceSides = 6;  // Number of sides on the dice.
 constexpr int kInvalidOutcome = -1;
 constexpr int kInvalidBid = -1;
 
+// Information state indices are only provided when they fit in this many
+// bits, which covers the smallest variants that tabular methods can solve.
+constexpr int kMaxInfoStateIndexBits = 24;
+
+// Bits used by an information state index: three for each of the player's
+// dice (absent, not yet rolled or a face) and one for each bid, including
+// "liar".
+int InfoStateIndexBits(int total_num_dice, int max_dice_per_player) {
+  return 3 * max_dice_per_player + total_num_dice * kDiceSides + 1;
+}
+
+std::vector<std::pair<Action, double>> DieOutcomes() {
+  std::vector<std::pair<Action, double>> outcomes;
+
+  // A chance node is a single die roll.
+  outcomes.reserve(kDiceSides);
+  for (int i = 0; i < kDiceSides; i++) {
+    outcomes.emplace_back(1 + i, 1.0 / kDiceSides);
+  }
+
+  return outcomes;
+}
+
+const ChanceDistribution kDieDistribution(DieOutcomes());
+
 // Facts about the game
 const GameType kGameType{/*short_name=*/"liars_dice",
                          /*long_name=*/"Liars Dice",
@@ -73,8 +98,8 @@ LiarsDiceState::LiarsDiceState(std::shared_ptr<const Game> game,
       dice_outcomes_(),
       num_dice_(num_dice),
       num_dice_rolled_(game->NumPlayers(), 0),
-      bidseq_(),
-      bidseq_str_() {
+      face_counts_(),
+      bids_() {
   for (int const& num_dices : num_dice_) {
     std::vector<int> initial_outcomes(num_dices, kInvalidOutcome);
     dice_outcomes_.push_back(initial_outcomes);
@@ -106,17 +131,11 @@ void LiarsDiceState::ResolveWinner() {
   std::pair<int, int> bid =
       LiarsDiceGame::GetQuantityFace(current_bid_, total_num_dice_);
   int quantity = bid.first, face = bid.second;
-  int matches = 0;
 
   // Count all the matches among all dice from all the players
   // kDiceSides (e.g. 6) is wild, so it always matches.
-  for (auto p = Player{0}; p < num_players_; p++) {
-    for (int d = 0; d < num_dice_[p]; d++) {
-      if (dice_outcomes_[p][d] == face || dice_outcomes_[p][d] == kDiceSides) {
-        matches++;
-      }
-    }
-  }
+  int matches = face_counts_[kDiceSides];
+  if (face != kDiceSides) matches += face_counts_[face];
 
   // If the number of matches are at least the quantity bid, then the bidder
   // wins. Otherwise, the caller wins.
@@ -141,6 +160,7 @@ void LiarsDiceState::DoApplyAction(Action action) {
     // Assign the roll.
     dice_outcomes_[cur_roller_][slot] = action;
     num_dice_rolled_[cur_roller_]++;
+    face_counts_[action]++;
 
     // Check to see if we must change the roller.
     if (num_dice_rolled_[cur_roller_] == num_dice_[cur_roller_]) {
@@ -156,19 +176,18 @@ void LiarsDiceState::DoApplyAction(Action action) {
     }
   } else {
     // Check for legal actions.
-    if (!bidseq_.empty() && action <= bidseq_.back()) {
+    if (action <= current_bid_) {
       SpielFatalError(absl::StrCat("Illegal action. ", action,
                                    " should be strictly higher than ",
-                                   bidseq_.back()));
+                                   current_bid_));
     }
+    bids_.set(action);
     if (action == total_num_dice_ * kDiceSides) {
       // This was the calling bid, game is over.
-      bidseq_.push_back(action);
       calling_player_ = cur_player_;
       ResolveWinner();
     } else {
       // Up the bid and move to the next player.
-      bidseq_.push_back(action);
       current_bid_ = action;
       bidding_player_ = cur_player_;
       cur_player_ = NextPlayerRoundRobin(cur_player_, num_players_);
@@ -178,6 +197,52 @@ void LiarsDiceState::DoApplyAction(Action action) {
   }
 }
 
+void LiarsDiceState::UndoAction(Player player, Action action) {
+  if (player == kChancePlayerId) {
+    if (cur_roller_ == num_players_) {
+      // Undoing the last roll, after which the rolls were sorted: put them
+      // back in the order they were rolled in.
+      int roll = 0;
+      for (auto p = Player{0}; p < num_players_; p++) {
+        for (int d = 0; d < num_dice_[p]; d++) {
+          dice_outcomes_[p][d] = history_[roll++];
+        }
+      }
+      cur_player_ = kChancePlayerId;
+    }
+    if (cur_roller_ == num_players_ || num_dice_rolled_[cur_roller_] == 0) {
+      cur_roller_--;
+    }
+    num_dice_rolled_[cur_roller_]--;
+    dice_outcomes_[cur_roller_][num_dice_rolled_[cur_roller_]] =
+        kInvalidOutcome;
+    face_counts_[action]--;
+  } else {
+    bids_.reset(action);
+    if (action == total_num_dice_ * kDiceSides) {
+      winner_ = kInvalidPlayer;
+      loser_ = kInvalidPlayer;
+      calling_player_ = 0;
+    } else {
+      // Bids are strictly increasing and made in turn, so the previous bid
+      // is the highest one left, made by the previous player.
+      current_bid_ = kInvalidBid;
+      for (int bid = action - 1; bid >= 0; bid--) {
+        if (bids_[bid]) {
+          current_bid_ = bid;
+          break;
+        }
+      }
+      bidding_player_ = current_bid_ == kInvalidBid
+                            ? 0
+                            : (player + num_players_ - 1) % num_players_;
+    }
+    cur_player_ = player;
+    total_moves_--;
+  }
+  history_.pop_back();
+}
+
 std::vector<Action> LiarsDiceState::LegalActions() const {
   if (IsTerminal()) return {};
   // A chance node is a single die roll.
@@ -206,16 +271,40 @@ std::vector<Action> LiarsDiceState::LegalActions() const {
 
 std::vector<std::pair<Action, double>> LiarsDiceState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
+  return DieOutcomes();
+}
 
-  std::vector<std::pair<Action, double>> outcomes;
+std::pair<Action, double> LiarsDiceState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  return kDieDistribution.Sample(rng);
+}
 
-  // A chance node is a single die roll.
-  outcomes.reserve(kDiceSides);
-  for (int i = 0; i < kDiceSides; i++) {
-    outcomes.emplace_back(1 + i, 1.0 / kDiceSides);
+std::unique_ptr<State> LiarsDiceState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  // The bids say nothing of the dice, so the other players' dice are rolled
+  // again, in the history and in place.
+  SPIEL_CHECK_FALSE(IsTerminal());
+  auto state = std::make_unique<LiarsDiceState>(*this);
+  int roll = 0;
+  for (auto p = Player{0}; p < num_players_; p++) {
+    if (p == player_id) {
+      roll += num_dice_rolled_[p];
+      continue;
+    }
+    for (int d = 0; d < num_dice_rolled_[p]; d++, roll++) {
+      const int outcome = kDieDistribution.Sample(rng()).first;
+      state->face_counts_[history_[roll]]--;
+      state->face_counts_[outcome]++;
+      state->history_[roll] = outcome;
+      state->dice_outcomes_[p][d] = outcome;
+    }
+    if (cur_roller_ == num_players_) {
+      std::sort(state->dice_outcomes_[p].begin(),
+                state->dice_outcomes_[p].end());
+    }
   }
-
-  return outcomes;
+  return state;
 }
 
 std::string LiarsDiceState::InformationStateString(Player player) const {
@@ -223,17 +312,38 @@ std::string LiarsDiceState::InformationStateString(Player player) const {
   SPIEL_CHECK_LT(player, num_players_);
 
   std::string result = absl::StrJoin(dice_outcomes_[player], "");
-  for (int b = 0; b < bidseq_.size(); b++) {
-    if (bidseq_[b] == total_num_dice_ * kDiceSides) {
-      absl::StrAppend(&result, " Liar");
-    } else {
-      auto bid = LiarsDiceGame::GetQuantityFace(bidseq_[b], total_num_dice_);
-      absl::StrAppend(&result, " ", bid.first, "-", bid.second);
-    }
+  absl::StrAppend(&result, BidSequenceString());
+  return result;
+}
+
+std::string LiarsDiceState::BidSequenceString() const {
+  const auto& game = static_cast<const LiarsDiceGame&>(*game_);
+  std::string result;
+  for (int b = 0; b <= total_num_dice_ * kDiceSides; b++) {
+    if (bids_[b]) absl::StrAppend(&result, game.BidString(b));
   }
   return result;
 }
 
+int64_t LiarsDiceState::InformationStateIndex(Player player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  SPIEL_CHECK_LE(InfoStateIndexBits(total_num_dice_, max_dice_per_player_),
+                 kMaxInfoStateIndexBits);
+
+  int64_t index = 0;
+  for (int die = max_dice_per_player_ - 1; die >= 0; --die) {
+    int digit = 0;
+    if (die < dice_outcomes_[player].size()) {
+      const int outcome = dice_outcomes_[player][die];
+      digit = outcome == kInvalidOutcome ? 1 : 1 + outcome;
+    }
+    index = 8 * index + digit;
+  }
+  index <<= total_num_dice_ * kDiceSides + 1;
+  return index | bids_.to_ullong();
+}
+
 std::string LiarsDiceState::ToString() const {
   std::string result = "";
 
@@ -249,14 +359,7 @@ std::string LiarsDiceState::ToString() const {
                         cur_roller_);
   }
 
-  for (int b = 0; b < bidseq_.size(); b++) {
-    if (bidseq_[b] == total_num_dice_ * kDiceSides) {
-      absl::StrAppend(&result, " Liar");
-    } else {
-      auto bid = LiarsDiceGame::GetQuantityFace(bidseq_[b], total_num_dice_);
-      absl::StrAppend(&result, " ", bid.first, "-", bid.second);
-    }
-  }
+  absl::StrAppend(&result, BidSequenceString());
   return result;
 }
 
@@ -309,10 +412,8 @@ void LiarsDiceState::InformationStateTensor(Player player,
   // players, all the remaining entries are 0 for those dice.
   offset = num_players_ + max_dice_per_player_ * kDiceSides;
 
-  for (int b = 0; b < bidseq_.size(); b++) {
-    SPIEL_CHECK_GE(bidseq_[b], 0);
-    SPIEL_CHECK_LE(bidseq_[b], total_num_dice_ * kDiceSides);
-    (*values)[offset + bidseq_[b]] = 1;
+  for (int b = 0; b <= total_num_dice_ * kDiceSides; b++) {
+    if (bids_[b]) (*values)[offset + b] = 1;
   }
 }
 
@@ -350,12 +451,13 @@ void LiarsDiceState::ObservationTensor(
   offset = num_players_ + max_dice_per_player_ * kDiceSides;
 
   // We only show the num_players_ last bids
-  int size_bid = bidseq_.size();
-  int bid_offset = std::max(0, size_bid - num_players_);
-  for (int b = bid_offset; b < size_bid; b++) {
-    SPIEL_CHECK_GE(bidseq_[b], 0);
-    SPIEL_CHECK_LE(bidseq_[b], total_num_dice_ * kDiceSides);
-    (*values)[offset + bidseq_[b]] = 1;
+  int num_shown = 0;
+  for (int b = total_num_dice_ * kDiceSides; b >= 0 && num_shown < num_players_;
+       b--) {
+    if (bids_[b]) {
+      (*values)[offset + b] = 1;
+      num_shown++;
+    }
   }
 }
 
@@ -388,6 +490,8 @@ LiarsDiceGame::LiarsDiceGame(const GameParameters& params)
     total_num_dice_ += my_num_dice;
   }
 
+  SPIEL_CHECK_LE(total_num_dice_, kMaxTotalNumDice);
+
   // Compute max dice per player (used for observations.)
   max_dice_per_player_ = -1;
   for (int nd : num_dice_) {
@@ -395,6 +499,13 @@ LiarsDiceGame::LiarsDiceGame(const GameParameters& params)
       max_dice_per_player_ = nd;
     }
   }
+
+  bid_strings_.reserve(NumDistinctActions());
+  for (int b = 0; b < total_num_dice_ * kDiceSides; b++) {
+    auto bid = GetQuantityFace(b, total_num_dice_);
+    bid_strings_.push_back(absl::StrCat(" ", bid.first, "-", bid.second));
+  }
+  bid_strings_.push_back(" Liar");
 }
 
 int LiarsDiceGame::NumDistinctActions() const {
@@ -417,6 +528,11 @@ int LiarsDiceGame::MaxGameLength() const {
   return total_num_dice_ * kDiceSides + 1;
 }
 
+int64_t LiarsDiceGame::NumInformationStates() const {
+  const int bits = InfoStateIndexBits(total_num_dice_, max_dice_per_player_);
+  return bits <= kMaxInfoStateIndexBits ? int64_t{1} << bits : 0;
+}
+
 std::vector<int> LiarsDiceGame::InformationStateTensorShape() const {
   // One-hot encoding for the player number.
   // One-hot encoding for each die (max_dice_per_player_ * sides).
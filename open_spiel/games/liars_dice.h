@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_LIARS_DICE_H_
 
 #include <array>
+#include <bitset>
 #include <memory>
 #include <string>
 #include <vector>
@@ -35,6 +36,11 @@
 namespace open_spiel {
 namespace liars_dice {
 
+inline constexpr int kDiceSides = 6;  // Number of sides on the dice.
+inline constexpr int kMaxTotalNumDice = 32;
+// Bids for each quantity and face, and "liar".
+inline constexpr int kMaxNumBids = kMaxTotalNumDice * kDiceSides + 1;
+
 class LiarsDiceGame;
 
 class LiarsDiceState : public State {
@@ -51,13 +57,20 @@ class LiarsDiceState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationStateString(Player player) const override;
+  int64_t InformationStateIndex(Player player) const override;
   void InformationStateTensor(
       Player player, std::vector<double>* values) const override;
   void ObservationTensor(
       Player player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
   std::vector<Action> LegalActions() const override;
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
 
  protected:
   void DoApplyAction(Action action_id) override;
@@ -82,9 +95,13 @@ class LiarsDiceState : public State {
   std::vector<int> num_dice_;         // How many dice each player has.
   std::vector<int> num_dice_rolled_;  // Number of dice currently rolled.
 
-  // Used to encode the information state.
-  std::vector<int> bidseq_;
-  std::string bidseq_str_;
+  // How many dice rolled each face, indexed by face.
+  std::array<int, kDiceSides + 1> face_counts_;
+
+  // Used to encode the information state: bids are strictly increasing, so
+  // the bid sequence is the set of bids made.
+  std::bitset<kMaxNumBids> bids_;
+  std::string BidSequenceString() const;
 };
 
 class LiarsDiceGame : public Game {
@@ -100,6 +117,7 @@ class LiarsDiceGame : public Game {
   std::shared_ptr<const Game> Clone() const override {
     return std::shared_ptr<const Game>(new LiarsDiceGame(*this));
   }
+  int64_t NumInformationStates() const override;
   std::vector<int> InformationStateTensorShape() const override;
   std::vector<int> ObservationTensorShape() const override;
   int MaxGameLength() const override;
@@ -115,6 +133,9 @@ class LiarsDiceGame : public Game {
   // The bids starts at 1 and go to total_dice*6+1.
   static std::pair<int, int> GetQuantityFace(int bid, int total_dice);
 
+  // The string of a bid in information states, e.g. " 2-3" or " Liar".
+  const std::string& BidString(int bid) const { return bid_strings_[bid]; }
+
  private:
   // Number of players.
   int num_players_;
@@ -124,6 +145,7 @@ class LiarsDiceGame : public Game {
 
   std::vector<int> num_dice_;  // How many dice each player has.
   int max_dice_per_player_;    // Maximum value in num_dice_ vector.
+  std::vector<std::string> bid_strings_;
 };
 
 }  // namespace liars_dice
@@ -25,6 +25,12 @@ void BasicLiarsDiceTests() {
   testing::LoadGameTest("liars_dice");
   testing::ChanceOutcomesTest(*LoadGame("liars_dice"));
   testing::RandomSimTest(*LoadGame("liars_dice"), 100);
+  testing::RandomSimTestWithUndo(*LoadGame("liars_dice"), 100);
+  testing::CheckInformationStateIndices(*LoadGame("liars_dice"));
+  testing::ResampleInfostateTest(*LoadGame("liars_dice"), /*num_sims=*/100);
+  testing::ResampleInfostateTest(
+      *LoadGame("liars_dice", {{"numdice", GameParameter(2)}}),
+      /*num_sims=*/100);
 }
 
 }  // namespace
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/ludii/chunk_set.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
@@ -21,10 +23,8 @@ ChunkSet::ChunkSet(JNIEnv *env, jobject chunkset)
     : env(env), chunkset(chunkset) {}
 
 std::string ChunkSet::Print() const {
-  jclass chunkSetClass = env->FindClass("util/ChunkSet");
-  jmethodID tostring_id =
-      env->GetMethodID(chunkSetClass, "toString", "()Ljava/lang/String;");
-  jstring string_obj = (jstring)env->CallObjectMethod(chunkset, tostring_id);
+  jstring string_obj = (jstring)env->CallObjectMethod(
+      chunkset, JNIUtils::Handles().chunk_set_to_string);
 
   const char *rawString = env->GetStringUTFChars(string_obj, 0);
   std::string cppString(rawString);
@@ -34,11 +34,8 @@ std::string ChunkSet::Print() const {
 }
 
 std::string ChunkSet::ToChunkString() const {
-  jclass chunkSetClass = env->FindClass("util/ChunkSet");
-  jmethodID toChunkString_id =
-      env->GetMethodID(chunkSetClass, "toChunkString", "()Ljava/lang/String;");
-  jstring string_obj =
-      (jstring)env->CallObjectMethod(chunkset, toChunkString_id);
+  jstring string_obj = (jstring)env->CallObjectMethod(
+      chunkset, JNIUtils::Handles().chunk_set_to_chunk_string);
 
   const char *rawString = env->GetStringUTFChars(string_obj, 0);
   std::string cppString(rawString);
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/ludii/container_state.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
@@ -21,31 +23,22 @@ ContainerState::ContainerState(JNIEnv *env, jobject container_state)
     : env(env), container_state(container_state) {}
 
 Region ContainerState::Empty() const {
-  jclass ContainerStateClass =
-      env->FindClass("util/state/containerState/ContainerState");
-  jmethodID empty_id =
-      env->GetMethodID(ContainerStateClass, "empty", "()Lutil/Region;");
-  jobject region_obj = env->CallObjectMethod(container_state, empty_id);
+  jobject region_obj = env->CallObjectMethod(
+      container_state, JNIUtils::Handles().container_state_empty);
 
   return Region(env, region_obj);
 }
 
 ChunkSet ContainerState::CloneWho() const {
-  jclass ContainerStateClass =
-      env->FindClass("util/state/containerState/ContainerState");
-  jmethodID cloneWho_id =
-      env->GetMethodID(ContainerStateClass, "cloneWho", "()Lutil/ChunkSet;");
-  jobject chunkset_obj = env->CallObjectMethod(container_state, cloneWho_id);
+  jobject chunkset_obj = env->CallObjectMethod(
+      container_state, JNIUtils::Handles().container_state_clone_who);
 
   return ChunkSet(env, chunkset_obj);
 }
 
 ChunkSet ContainerState::CloneWhat() const {
-  jclass ContainerStateClass =
-      env->FindClass("util/state/containerState/ContainerState");
-  jmethodID cloneWhat_id =
-      env->GetMethodID(ContainerStateClass, "cloneWhat", "()Lutil/ChunkSet;");
-  jobject chunkset_obj = env->CallObjectMethod(container_state, cloneWhat_id);
+  jobject chunkset_obj = env->CallObjectMethod(
+      container_state, JNIUtils::Handles().container_state_clone_what);
 
   return ChunkSet(env, chunkset_obj);
 }
@@ -15,16 +15,16 @@
 #include "open_spiel/games/ludii/context.h"
 
 #include "open_spiel/games/ludii/game.h"
+#include "open_spiel/games/ludii/jni_utils.h"
 
 namespace open_spiel {
 namespace ludii {
 
 Context::Context(JNIEnv *env, Game game, Trial trial) : env(env) {
-  jclass context_class = env->FindClass("util/Context");
-  jmethodID context_const_id =
-      env->GetMethodID(context_class, "<init>", "(Lgame/Game;Lutil/Trial;)V");
-  jobject context_obj = env->NewObject(context_class, context_const_id,
-                                       game.GetObj(), trial.GetObj());
+  const JNIHandles &handles = JNIUtils::Handles();
+  jobject context_obj =
+      env->NewObject(handles.context_class, handles.context_init,
+                     game.GetObj(), trial.GetObj());
 
   context = context_obj;
 }
@@ -15,6 +15,7 @@
 #include "open_spiel/games/ludii/game.h"
 
 #include "open_spiel/games/ludii/context.h"
+#include "open_spiel/games/ludii/jni_utils.h"
 
 namespace open_spiel {
 namespace ludii {
@@ -27,10 +28,8 @@ std::string Game::GetPath() const { return game_path; }
 jobject Game::GetObj() const { return game; }
 
 std::string Game::GetName() const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID name_id =
-      env->GetMethodID(gameClass, "name", "()Ljava/lang/String;");
-  jstring stringArray = (jstring)env->CallObjectMethod(game, name_id);
+  jstring stringArray =
+      (jstring)env->CallObjectMethod(game, JNIUtils::Handles().game_name);
 
   // convert jstring game name to char array
   const char *strReturn = env->GetStringUTFChars(stringArray, 0);
@@ -41,50 +40,66 @@ std::string Game::GetName() const {
 }
 
 void Game::Create(int viewSize) const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID create_id = env->GetMethodID(gameClass, "create", "(I)V");
-  env->CallVoidMethod(game, create_id, viewSize);
+  env->CallVoidMethod(game, JNIUtils::Handles().game_create, viewSize);
 }
 
 int Game::StateFlags() const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID stateFlags_id = env->GetMethodID(gameClass, "stateFlags", "()I");
-  return (int)env->CallIntMethod(game, stateFlags_id);
+  return (int)env->CallIntMethod(game, JNIUtils::Handles().game_state_flags);
 }
 
 Mode Game::GetMode() const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID mode_id = env->GetMethodID(gameClass, "mode", "()Lgame/mode/Mode;");
-  jobject mode = env->CallObjectMethod(game, mode_id);
+  jobject mode = env->CallObjectMethod(game, JNIUtils::Handles().game_mode);
   return Mode(env, mode);
 }
 
 void Game::Start(Context context) const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID start_id =
-      env->GetMethodID(gameClass, "start", "(Lutil/Context;)V");
-  env->CallVoidMethod(game, start_id, context.GetObj());
+  env->CallVoidMethod(game, JNIUtils::Handles().game_start, context.GetObj());
 }
 
 Moves Game::GetMoves(Context context) const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID moves_id = env->GetMethodID(
-      gameClass, "moves", "(Lutil/Context;)Lgame/rules/play/moves/Moves;");
-  jobject moves_obj = env->CallObjectMethod(game, moves_id, context.GetObj());
-  jclass clsObj = env->GetObjectClass(context.GetObj());
+  jobject moves_obj = env->CallObjectMethod(
+      game, JNIUtils::Handles().game_moves, context.GetObj());
 
   return Moves(env, moves_obj);
 }
 
 Move Game::Apply(Context context, Move move) const {
-  jclass gameClass = env->FindClass("game/Game");
-  jmethodID apply_id = env->GetMethodID(
-      gameClass, "apply", "(Lutil/Context;Lutil/Move;)Lutil/Move;");
-  jobject move_obj =
-      env->CallObjectMethod(game, apply_id, context.GetObj(), move.GetObj());
+  jobject move_obj = env->CallObjectMethod(
+      game, JNIUtils::Handles().game_apply, context.GetObj(), move.GetObj());
 
   return Move(env, move_obj);
 }
 
+std::vector<int> Game::NumMoves(const std::vector<Context> &contexts) const {
+  const JNIHandles &handles = JNIUtils::Handles();
+  std::vector<int> num_moves;
+  num_moves.reserve(contexts.size());
+  for (const Context &context : contexts) {
+    env->PushLocalFrame(2);
+    jobject moves_obj =
+        env->CallObjectMethod(game, handles.game_moves, context.GetObj());
+    num_moves.push_back(Moves(env, moves_obj).NumMoves());
+    env->PopLocalFrame(nullptr);
+  }
+  return num_moves;
+}
+
+void Game::ApplyMoves(const std::vector<Context> &contexts,
+                      const std::vector<int> &move_indices) const {
+  const JNIHandles &handles = JNIUtils::Handles();
+  for (int i = 0; i < contexts.size(); ++i) {
+    env->PushLocalFrame(4);
+    jobject context_obj = contexts[i].GetObj();
+    jobject moves_obj =
+        env->CallObjectMethod(game, handles.game_moves, context_obj);
+    jobject move_list_obj = env->CallObjectMethod(moves_obj,
+                                                  handles.moves_moves);
+    jobject move_obj = env->CallObjectMethod(
+        move_list_obj, handles.fast_array_list_get, move_indices[i]);
+    env->CallObjectMethod(game, handles.game_apply, context_obj, move_obj);
+    env->PopLocalFrame(nullptr);
+  }
+}
+
 }  // namespace ludii
 }  // namespace open_spiel
@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_LUDII_GAME_H_
 
 #include <string>
+#include <vector>
 
 #include "jni.h"  // NOLINT
 #include "open_spiel/games/ludii/mode.h"
@@ -49,6 +50,15 @@ class Game {
 
   Move Apply(Context context, Move move) const;
 
+  // Batched versions of GetMoves and Apply over several contexts of this
+  // game, e.g. for playing many games at once. The local references made for
+  // each context are released before the next, so that long batches do not
+  // fill the JVM's local reference table.
+  std::vector<int> NumMoves(const std::vector<Context> &contexts) const;
+  // Applies the move_indices[i]-th legal move in contexts[i].
+  void ApplyMoves(const std::vector<Context> &contexts,
+                  const std::vector<int> &move_indices) const;
+
  private:
   JNIEnv *env;
   jobject game;
@@ -17,6 +17,8 @@
 #include <cstring>
 #include <string>
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
@@ -25,11 +27,9 @@ GameLoader::GameLoader(JNIEnv *env) : env(env) {}
 std::vector<std::string> GameLoader::ListGames() const {
   std::vector<std::string> gamesVector;
 
-  jclass gameLoader = env->FindClass("player/GameLoader");
-  jmethodID mid =
-      env->GetStaticMethodID(gameLoader, "listGames", "()[Ljava/lang/String;");
-  jobjectArray stringArray =
-      (jobjectArray)env->CallStaticObjectMethod(gameLoader, mid);
+  const JNIHandles &handles = JNIUtils::Handles();
+  jobjectArray stringArray = (jobjectArray)env->CallStaticObjectMethod(
+      handles.game_loader_class, handles.game_loader_list_games);
 
   int stringCount = env->GetArrayLength(stringArray);
 
@@ -48,13 +48,13 @@ std::vector<std::string> GameLoader::ListGames() const {
 }
 
 Game GameLoader::LoadGame(std::string game_name) const {
-  jclass gameLoader = env->FindClass("player/GameLoader");
-  jmethodID mid = env->GetStaticMethodID(gameLoader, "loadGameFromName",
-                                         "(Ljava/lang/String;)Lgame/Game;");
+  const JNIHandles &handles = JNIUtils::Handles();
 
   // convert game name to java string
   jstring j_game_name = env->NewStringUTF(game_name.c_str());
-  jobject game_obj = env->CallStaticObjectMethod(gameLoader, mid, j_game_name);
+  jobject game_obj = env->CallStaticObjectMethod(
+      handles.game_loader_class, handles.game_loader_load_game_from_name,
+      j_game_name);
 
   return Game(env, game_obj, game_name);
 }
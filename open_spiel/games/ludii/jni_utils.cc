@@ -14,12 +14,129 @@
 
 #include "open_spiel/games/ludii/jni_utils.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <string>
 
 namespace open_spiel {
 namespace ludii {
+namespace {
+
+JavaVM *global_jvm = nullptr;
+JNIHandles global_handles;
+
+void FailedLookup(const char *kind, const char *name) {
+  std::cerr << "Ludii " << kind << " not found: " << name << std::endl;
+  std::exit(EXIT_FAILURE);
+}
+
+jclass FindClass(JNIEnv *env, const char *name) {
+  jclass local_class = env->FindClass(name);
+  if (local_class == nullptr) FailedLookup("class", name);
+  jclass global_class = static_cast<jclass>(env->NewGlobalRef(local_class));
+  env->DeleteLocalRef(local_class);
+  return global_class;
+}
+
+jmethodID GetMethodID(JNIEnv *env, jclass cls, const char *name,
+                      const char *signature) {
+  jmethodID method = env->GetMethodID(cls, name, signature);
+  if (method == nullptr) FailedLookup("method", name);
+  return method;
+}
+
+jmethodID GetStaticMethodID(JNIEnv *env, jclass cls, const char *name,
+                            const char *signature) {
+  jmethodID method = env->GetStaticMethodID(cls, name, signature);
+  if (method == nullptr) FailedLookup("method", name);
+  return method;
+}
+
+void InitHandles(JNIEnv *env) {
+  JNIHandles &h = global_handles;
+  h.game_class = FindClass(env, "game/Game");
+  h.game_name =
+      GetMethodID(env, h.game_class, "name", "()Ljava/lang/String;");
+  h.game_create = GetMethodID(env, h.game_class, "create", "(I)V");
+  h.game_state_flags = GetMethodID(env, h.game_class, "stateFlags", "()I");
+  h.game_mode =
+      GetMethodID(env, h.game_class, "mode", "()Lgame/mode/Mode;");
+  h.game_start =
+      GetMethodID(env, h.game_class, "start", "(Lutil/Context;)V");
+  h.game_moves =
+      GetMethodID(env, h.game_class, "moves",
+                  "(Lutil/Context;)Lgame/rules/play/moves/Moves;");
+  h.game_apply = GetMethodID(env, h.game_class, "apply",
+                             "(Lutil/Context;Lutil/Move;)Lutil/Move;");
+
+  h.mode_class = FindClass(env, "game/mode/Mode");
+  h.mode_num_players = GetMethodID(env, h.mode_class, "numPlayers", "()I");
+
+  h.context_class = FindClass(env, "util/Context");
+  h.context_init = GetMethodID(env, h.context_class, "<init>",
+                               "(Lgame/Game;Lutil/Trial;)V");
+
+  h.trial_class = FindClass(env, "util/Trial");
+  h.trial_init = GetMethodID(env, h.trial_class, "<init>", "(Lgame/Game;)V");
+  h.trial_state =
+      GetMethodID(env, h.trial_class, "state", "()Lutil/state/State;");
+  h.trial_over = GetMethodID(env, h.trial_class, "over", "()Z");
+
+  h.state_class = FindClass(env, "util/state/State");
+  h.state_container_states =
+      GetMethodID(env, h.state_class, "containerStates",
+                  "()[Lutil/state/containerState/ContainerState;");
+  h.state_mover = GetMethodID(env, h.state_class, "mover", "()I");
+
+  h.container_state_class =
+      FindClass(env, "util/state/containerState/ContainerState");
+  h.container_state_empty = GetMethodID(env, h.container_state_class,
+                                        "empty", "()Lutil/Region;");
+  h.container_state_clone_who = GetMethodID(env, h.container_state_class,
+                                            "cloneWho", "()Lutil/ChunkSet;");
+  h.container_state_clone_what = GetMethodID(
+      env, h.container_state_class, "cloneWhat", "()Lutil/ChunkSet;");
+
+  h.region_class = FindClass(env, "util/Region");
+  h.region_bit_set =
+      GetMethodID(env, h.region_class, "bitSet", "()Lutil/ChunkSet;");
+
+  h.chunk_set_class = FindClass(env, "util/ChunkSet");
+  h.chunk_set_to_string = GetMethodID(env, h.chunk_set_class, "toString",
+                                      "()Ljava/lang/String;");
+  h.chunk_set_to_chunk_string = GetMethodID(
+      env, h.chunk_set_class, "toChunkString", "()Ljava/lang/String;");
+
+  h.moves_class = FindClass(env, "game/rules/play/moves/Moves");
+  h.moves_moves =
+      GetMethodID(env, h.moves_class, "moves", "()Lmain/FastArrayList;");
+
+  h.fast_array_list_class = FindClass(env, "main/FastArrayList");
+  h.fast_array_list_size =
+      GetMethodID(env, h.fast_array_list_class, "size", "()I");
+  h.fast_array_list_get = GetMethodID(env, h.fast_array_list_class, "get",
+                                      "(I)Ljava/lang/Object;");
+
+  h.game_loader_class = FindClass(env, "player/GameLoader");
+  h.game_loader_list_games =
+      GetStaticMethodID(env, h.game_loader_class, "listGames",
+                        "()[Ljava/lang/String;");
+  h.game_loader_load_game_from_name =
+      GetStaticMethodID(env, h.game_loader_class, "loadGameFromName",
+                        "(Ljava/lang/String;)Lgame/Game;");
+}
+
+// Detaches the thread from the JVM when it exits, if it was attached by
+// AttachCurrentThread.
+struct ThreadDetacher {
+  ~ThreadDetacher() {
+    if (attached && global_jvm != nullptr) global_jvm->DetachCurrentThread();
+  }
+  bool attached = false;
+};
+
+}  // namespace
 
 JNIUtils::JNIUtils(std::string jar_location) { InitJVM(jar_location); }
 
@@ -54,12 +171,33 @@ void JNIUtils::InitJVM(std::string jar_location) {
   res = JNI_CreateJavaVM(&jvm, &env, &vm_args);
   free(c_classpath);
 #endif /* JNI_VERSION_1_2 */
+  if (res != JNI_OK) {
+    std::cerr << "failed to create the JVM: " << res << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  global_jvm = jvm;
+  InitHandles(env);
 }
 
 void JNIUtils::CloseJVM() {
   std::cout << "destroying JVM" << std::endl;
+  global_jvm = nullptr;
   jvm->DestroyJavaVM();
 }
 
+const JNIHandles &JNIUtils::Handles() { return global_handles; }
+
+JNIEnv *JNIUtils::AttachCurrentThread() {
+  thread_local ThreadDetacher detacher;
+  JNIEnv *thread_env = nullptr;
+  if (global_jvm->GetEnv(reinterpret_cast<void **>(&thread_env),
+                         JNI_VERSION_1_2) == JNI_EDETACHED) {
+    global_jvm->AttachCurrentThreadAsDaemon(
+        reinterpret_cast<void **>(&thread_env), nullptr);
+    detacher.attached = true;
+  }
+  return thread_env;
+}
+
 }  // namespace ludii
 }  // namespace open_spiel
@@ -23,16 +23,80 @@
 namespace open_spiel {
 namespace ludii {
 
+// The Ludii classes and methods used by the wrapper. They are looked up once,
+// when the JVM is created, rather than on every call. The classes are held by
+// global references, so that they and their method ids are valid from any
+// thread.
+struct JNIHandles {
+  jclass game_class;
+  jmethodID game_name;
+  jmethodID game_create;
+  jmethodID game_state_flags;
+  jmethodID game_mode;
+  jmethodID game_start;
+  jmethodID game_moves;
+  jmethodID game_apply;
+
+  jclass mode_class;
+  jmethodID mode_num_players;
+
+  jclass context_class;
+  jmethodID context_init;
+
+  jclass trial_class;
+  jmethodID trial_init;
+  jmethodID trial_state;
+  jmethodID trial_over;
+
+  jclass state_class;
+  jmethodID state_container_states;
+  jmethodID state_mover;
+
+  jclass container_state_class;
+  jmethodID container_state_empty;
+  jmethodID container_state_clone_who;
+  jmethodID container_state_clone_what;
+
+  jclass region_class;
+  jmethodID region_bit_set;
+
+  jclass chunk_set_class;
+  jmethodID chunk_set_to_string;
+  jmethodID chunk_set_to_chunk_string;
+
+  jclass moves_class;
+  jmethodID moves_moves;
+
+  jclass fast_array_list_class;
+  jmethodID fast_array_list_size;
+  jmethodID fast_array_list_get;
+
+  jclass game_loader_class;
+  jmethodID game_loader_list_games;
+  jmethodID game_loader_load_game_from_name;
+};
+
 class JNIUtils {
  public:
   JNIUtils(const std::string jar_location);
   ~JNIUtils();
 
+  // The environment of the thread that created the JVM.
   JNIEnv *GetEnv() const;
 
   void InitJVM(std::string jar_location);
   void CloseJVM();
 
+  // Returns the handles, once a JNIUtils has created the JVM.
+  static const JNIHandles &Handles();
+
+  // Returns the environment of the calling thread, attaching it to the JVM
+  // first if needed, so that several native threads can run Ludii games at
+  // once. Threads attached this way are detached when they exit. The objects
+  // of a thread's environment (e.g. Game, Trial, Context) must only be used
+  // by that thread.
+  static JNIEnv *AttachCurrentThread();
+
  private:
   JavaVM *jvm;
   JNIEnv *env;
@@ -14,15 +14,16 @@
 
 #include "open_spiel/games/ludii/mode.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
 Mode::Mode(JNIEnv *env, jobject mode) : env(env), mode(mode) {}
 
 int Mode::NumPlayers() const {
-  jclass gameClass = env->FindClass("game/mode/Mode");
-  jmethodID stateFlags_id = env->GetMethodID(gameClass, "numPlayers", "()I");
-  return (int)env->CallIntMethod(mode, stateFlags_id);
+  return (int)env->CallIntMethod(mode,
+                                 JNIUtils::Handles().mode_num_players);
 }
 
 }  // namespace ludii
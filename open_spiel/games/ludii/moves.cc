@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/ludii/moves.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
@@ -22,26 +24,29 @@ Moves::Moves(JNIEnv *env, jobject moves) : env(env), moves(moves) {}
 std::vector<Move> Moves::GetMoves() const {
   std::vector<Move> moveVector;
 
-  jclass moves_class = env->FindClass("game/rules/play/moves/Moves");
-  jmethodID moves_id =
-      env->GetMethodID(moves_class, "moves", "()Lmain/FastArrayList;");
-  jobject moveFastArray_obj = env->CallObjectMethod(moves, moves_id);
-
-  jclass fastArray_class = env->FindClass("main/FastArrayList");
-  jmethodID fastArraySize_id = env->GetMethodID(fastArray_class, "size", "()I");
-  jmethodID fastArrayGet_id =
-      env->GetMethodID(fastArray_class, "get", "(I)Ljava/lang/Object;");
-
-  jint fastArraySize = env->CallIntMethod(moveFastArray_obj, fastArraySize_id);
+  const JNIHandles &handles = JNIUtils::Handles();
+  jobject moveFastArray_obj = env->CallObjectMethod(moves, handles.moves_moves);
+  jint fastArraySize =
+      env->CallIntMethod(moveFastArray_obj, handles.fast_array_list_size);
+  moveVector.reserve(fastArraySize);
 
   for (int i = 0; i < fastArraySize; i++) {
-    jobject move_obj =
-        env->CallObjectMethod(moveFastArray_obj, fastArrayGet_id, i);
+    jobject move_obj = env->CallObjectMethod(
+        moveFastArray_obj, handles.fast_array_list_get, i);
     moveVector.push_back(Move(env, move_obj));
   }
 
   return moveVector;
 }
 
+int Moves::NumMoves() const {
+  const JNIHandles &handles = JNIUtils::Handles();
+  jobject moveFastArray_obj = env->CallObjectMethod(moves, handles.moves_moves);
+  const int num_moves =
+      env->CallIntMethod(moveFastArray_obj, handles.fast_array_list_size);
+  env->DeleteLocalRef(moveFastArray_obj);
+  return num_moves;
+}
+
 }  // namespace ludii
 }  // namespace open_spiel
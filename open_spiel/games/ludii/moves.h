@@ -30,6 +30,9 @@ class Moves {
 
   std::vector<Move> GetMoves() const;
 
+  // The number of moves, without making a local reference for each.
+  int NumMoves() const;
+
  private:
   JNIEnv *env;
   jobject moves;
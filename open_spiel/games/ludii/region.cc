@@ -14,16 +14,16 @@
 
 #include "open_spiel/games/ludii/region.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
 Region::Region(JNIEnv *env, jobject region) : env(env), region(region) {}
 
 ChunkSet Region::BitSet() const {
-  jclass regionClass = env->FindClass("util/Region");
-  jmethodID bitSet_id =
-      env->GetMethodID(regionClass, "bitSet", "()Lutil/ChunkSet;");
-  jobject chunkset_obj = env->CallObjectMethod(region, bitSet_id);
+  jobject chunkset_obj =
+      env->CallObjectMethod(region, JNIUtils::Handles().region_bit_set);
 
   return ChunkSet(env, chunkset_obj);
 }
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/ludii/state.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
@@ -22,12 +24,8 @@ State::State(JNIEnv *env, jobject state) : env(env), state(state) {}
 std::vector<ContainerState> State::ContainerStates() const {
   std::vector<ContainerState> containerStateVector;
 
-  jclass stateClass = env->FindClass("util/state/State");
-  jmethodID containerStates_id =
-      env->GetMethodID(stateClass, "containerStates",
-                       "()[Lutil/state/containerState/ContainerState;");
-  jobjectArray containerStateArray =
-      (jobjectArray)env->CallObjectMethod(state, containerStates_id);
+  jobjectArray containerStateArray = (jobjectArray)env->CallObjectMethod(
+      state, JNIUtils::Handles().state_container_states);
   int containerStateCount = env->GetArrayLength(containerStateArray);
 
   for (int i = 0; i < containerStateCount; i++) {
@@ -40,10 +38,7 @@ std::vector<ContainerState> State::ContainerStates() const {
 }
 
 int State::Mover() const {
-  jclass stateClass = env->FindClass("util/state/State");
-  jmethodID mover_id = env->GetMethodID(stateClass, "mover", "()I");
-
-  return (int)env->CallIntMethod(state, mover_id);
+  return (int)env->CallIntMethod(state, JNIUtils::Handles().state_mover);
 }
 
 }  // namespace ludii
@@ -14,15 +14,15 @@
 
 #include "open_spiel/games/ludii/trial.h"
 
+#include "open_spiel/games/ludii/jni_utils.h"
+
 namespace open_spiel {
 namespace ludii {
 
 Trial::Trial(JNIEnv *env, Game game) : env(env) {
-  jclass trial_class = env->FindClass("util/Trial");
-  jmethodID trial_const_id =
-      env->GetMethodID(trial_class, "<init>", "(Lgame/Game;)V");
+  const JNIHandles &handles = JNIUtils::Handles();
   jobject trial_obj =
-      env->NewObject(trial_class, trial_const_id, game.GetObj());
+      env->NewObject(handles.trial_class, handles.trial_init, game.GetObj());
 
   trial = trial_obj;
 }
@@ -30,19 +30,14 @@ Trial::Trial(JNIEnv *env, Game game) : env(env) {
 jobject Trial::GetObj() const { return trial; }
 
 State Trial::GetState() const {
-  jclass trial_class = env->FindClass("util/Trial");
-  jmethodID state_id =
-      env->GetMethodID(trial_class, "state", "()Lutil/state/State;");
-  jobject state_obj = env->CallObjectMethod(trial, state_id);
+  jobject state_obj =
+      env->CallObjectMethod(trial, JNIUtils::Handles().trial_state);
 
   return State(env, state_obj);
 }
 
 bool Trial::Over() const {
-  jclass trial_class = env->FindClass("util/Trial");
-  jmethodID over_id = env->GetMethodID(trial_class, "over", "()Z");
-
-  return (bool)env->CallObjectMethod(trial, over_id);
+  return env->CallBooleanMethod(trial, JNIUtils::Handles().trial_over);
 }
 
 }  // namespace ludii
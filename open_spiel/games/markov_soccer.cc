@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/markov_soccer.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -72,11 +73,26 @@ constexpr int kNumMovementActions = 5;
 
 constexpr std::array<int, 5> row_offsets = {{-1, 1, 0, 0, 0}};
 constexpr std::array<int, 5> col_offsets = {{0, 0, -1, 1, 0}};
+
+// The observation planes of the pieces, in the order of observation_plane.
+constexpr int kPlayerPlane = 0;  // kPlayerPlane + 2 * player + has the ball.
+constexpr int kBallPlane = 4;
+constexpr int kEmptyPlane = 5;
+
+const MarkovSoccerGame& AsMarkovSoccerGame(const Game& game) {
+  const auto* soccer_game = dynamic_cast<const MarkovSoccerGame*>(&game);
+  if (soccer_game == nullptr) {
+    SpielFatalError("MarkovSoccerVectorEnv requires a markov_soccer game.");
+  }
+  return *soccer_game;
+}
 }  // namespace
 
 MarkovSoccerState::MarkovSoccerState(std::shared_ptr<const Game> game,
                                      const Grid& grid)
-    : SimMoveState(game), grid_(grid) {}
+    : SimMoveState(game), grid_(grid) {
+  EnableLegalActionsCache();
+}
 
 std::string MarkovSoccerState::ActionToString(Player player,
                                               Action action_id) const {
@@ -139,6 +155,7 @@ char MarkovSoccerState::field(int r, int c) const {
 }
 
 void MarkovSoccerState::Reset(int horizon) {
+  InvalidateLegalActionsCache();
   horizon_ = horizon;
   field_.resize(grid_.num_rows * grid_.num_cols, '.');
 
@@ -151,6 +168,7 @@ void MarkovSoccerState::Reset(int horizon) {
 }
 
 void MarkovSoccerState::DoApplyActions(const std::vector<Action>& moves) {
+  InvalidateLegalActionsCache();
   SPIEL_CHECK_EQ(moves.size(), 2);
   SPIEL_CHECK_EQ(cur_player_, kSimultaneousPlayerId);
 
@@ -229,6 +247,7 @@ void MarkovSoccerState::DoApplyAction(Action action_id) {
     return;
   }
   SPIEL_CHECK_TRUE(IsChanceNode());
+  InvalidateLegalActionsCache();
   SPIEL_CHECK_GE(action_id, 0);
   SPIEL_CHECK_LT(action_id, game_->MaxChanceOutcomes());
 
@@ -346,6 +365,18 @@ int MarkovSoccerState::observation_plane(int r, int c) const {
   return plane;
 }
 
+template <class T>
+void MarkovSoccerState::WriteObservationTensor(Player player,
+                                               TensorView<3, T>& view) const {
+  for (int r = 0; r < grid_.num_rows; r++) {
+    for (int c = 0; c < grid_.num_cols; c++) {
+      int plane = observation_plane(r, c);
+      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
+      view[{plane, r, c}] = 1.0;
+    }
+  }
+}
+
 void MarkovSoccerState::ObservationTensor(Player player,
                                           std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
@@ -353,14 +384,17 @@ void MarkovSoccerState::ObservationTensor(Player player,
 
   TensorView<3> view(values, {kCellStates, grid_.num_rows, grid_.num_cols},
                      true);
+  WriteObservationTensor(player, view);
+}
 
-  for (int r = 0; r < grid_.num_rows; r++) {
-    for (int c = 0; c < grid_.num_cols; c++) {
-      int plane = observation_plane(r, c);
-      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
-      view[{plane, r, c}] = 1.0;
-    }
-  }
+void MarkovSoccerState::ObservationTensor(Player player,
+                                          absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<3, float> view(
+      values, {kCellStates, grid_.num_rows, grid_.num_cols}, true);
+  WriteObservationTensor(player, view);
 }
 
 std::unique_ptr<State> MarkovSoccerState::Clone() const {
@@ -437,5 +471,129 @@ MarkovSoccerGame::MarkovSoccerGame(const GameParameters& params)
       grid_(ParseGrid(ParameterValue<std::string>("grid"))),
       horizon_(ParameterValue<int>("horizon")) {}
 
+MarkovSoccerVectorEnv::MarkovSoccerVectorEnv(std::shared_ptr<const Game> game,
+                                             int num_envs, int seed)
+    : game_(std::move(game)),
+      grid_(AsMarkovSoccerGame(*game_).grid()),
+      horizon_(AsMarkovSoccerGame(*game_).horizon()),
+      observation_size_(game_->ObservationTensorSize()),
+      rng_(seed),
+      player_rows_({std::vector<int>(num_envs), std::vector<int>(num_envs)}),
+      player_cols_({std::vector<int>(num_envs), std::vector<int>(num_envs)}),
+      ball_owners_(num_envs),
+      ball_rows_(num_envs),
+      ball_cols_(num_envs),
+      total_moves_(num_envs),
+      observations_(num_envs * observation_size_),
+      rewards_(num_envs * 2),
+      dones_(num_envs) {
+  SPIEL_CHECK_GT(num_envs, 0);
+  // The initial state, after placing the ball, must not be terminal.
+  SPIEL_CHECK_GT(horizon_, 1);
+  Reset();
+}
+
+void MarkovSoccerVectorEnv::Reset() {
+  std::fill(rewards_.begin(), rewards_.end(), 0.0f);
+  std::fill(dones_.begin(), dones_.end(), 0);
+  for (int env = 0; env < num_envs(); ++env) {
+    ResetEnv(env);
+    WriteObservation(env);
+  }
+}
+
+void MarkovSoccerVectorEnv::Step(absl::Span<const Action> actions) {
+  SPIEL_CHECK_EQ(actions.size(), num_envs() * 2);
+  for (Action action : actions) {
+    if (action < 0 || action >= kNumMovementActions) {
+      SpielFatalError(absl::StrCat("Invalid move ", action));
+    }
+  }
+  std::bernoulli_distribution initiative;
+  for (int env = 0; env < num_envs(); ++env) {
+    // As kChanceInit0Action and kChanceInit1Action.
+    const Player first = initiative(rng_) ? 1 : 0;
+    Player winner = ResolveMove(env, first, actions[env * 2 + first]);
+    // Only the player with the ball can score, so at most one does.
+    if (winner == kInvalidPlayer) {
+      winner = ResolveMove(env, 1 - first, actions[env * 2 + 1 - first]);
+    }
+    // A goal on the last move is a draw, as in MarkovSoccerState::Returns.
+    if (++total_moves_[env] >= horizon_) winner = kInvalidPlayer;
+    for (Player player = 0; player < 2; ++player) {
+      rewards_[env * 2 + player] =
+          winner == kInvalidPlayer ? 0 : (winner == player ? 1 : -1);
+    }
+    dones_[env] = winner != kInvalidPlayer || total_moves_[env] >= horizon_;
+    if (dones_[env]) ResetEnv(env);
+    WriteObservation(env);
+  }
+}
+
+void MarkovSoccerVectorEnv::ResetEnv(int env) {
+  for (Player player = 0; player < 2; ++player) {
+    const std::pair<int, int>& start =
+        player == 0 ? grid_.a_start : grid_.b_start;
+    player_rows_[player][env] = start.first;
+    player_cols_[player][env] = start.second;
+  }
+  const int ball_start = std::uniform_int_distribution<int>(
+      0, grid_.ball_start_points.size() - 1)(rng_);
+  ball_owners_[env] = kInvalidPlayer;
+  ball_rows_[env] = grid_.ball_start_points[ball_start].first;
+  ball_cols_[env] = grid_.ball_start_points[ball_start].second;
+  total_moves_[env] = 1;
+}
+
+Player MarkovSoccerVectorEnv::ResolveMove(int env, Player player, int move) {
+  // As MarkovSoccerState::ResolveMove.
+  if (move == kStand) return kInvalidPlayer;
+  const bool has_ball = ball_owners_[env] == player;
+  const int new_row = player_rows_[player][env] + row_offsets[move];
+  const int new_col = player_cols_[player][env] + col_offsets[move];
+  if (new_row < 0 || new_col < 0 || new_row >= grid_.num_rows ||
+      new_col >= grid_.num_cols) {
+    const int goal_col = player == 0 ? grid_.num_cols : -1;
+    if (has_ball && (new_row == 1 || new_row == 2) && new_col == goal_col) {
+      return player;
+    }
+    return kInvalidPlayer;
+  }
+  const Player opponent = 1 - player;
+  if (new_row == player_rows_[opponent][env] &&
+      new_col == player_cols_[opponent][env]) {
+    // The opponent takes the ball, if the player has it, and neither moves.
+    if (has_ball) ball_owners_[env] = opponent;
+    return kInvalidPlayer;
+  }
+  if (ball_owners_[env] == kInvalidPlayer && new_row == ball_rows_[env] &&
+      new_col == ball_cols_[env]) {
+    ball_owners_[env] = player;
+  }
+  player_rows_[player][env] = new_row;
+  player_cols_[player][env] = new_col;
+  return kInvalidPlayer;
+}
+
+void MarkovSoccerVectorEnv::WriteObservation(int env) {
+  const int plane_size = grid_.num_rows * grid_.num_cols;
+  float* observation = &observations_[env * observation_size_];
+  std::fill(observation, observation + observation_size_, 0.0f);
+  float* empty_plane = observation + kEmptyPlane * plane_size;
+  std::fill(empty_plane, empty_plane + plane_size, 1.0f);
+  auto set_cell = [&](int plane, int row, int col) {
+    const int cell = row * grid_.num_cols + col;
+    observation[plane * plane_size + cell] = 1.0f;
+    empty_plane[cell] = 0.0f;
+  };
+  for (Player player = 0; player < 2; ++player) {
+    set_cell(kPlayerPlane + 2 * player + (ball_owners_[env] == player),
+             player_rows_[player][env], player_cols_[player][env]);
+  }
+  if (ball_owners_[env] == kInvalidPlayer) {
+    set_cell(kBallPlane, ball_rows_[env], ball_cols_[env]);
+  }
+}
+
 }  // namespace markov_soccer
 }  // namespace open_spiel
@@ -17,11 +17,14 @@
 
 #include <array>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/simultaneous_move_game.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // This is the soccer game from the MinimaxQ paper. See
 // "Markov Games as a Framework for Reinforcement Learning", Littman '94.
@@ -80,6 +83,8 @@ class MarkovSoccerState : public SimMoveState {
   }
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   Player CurrentPlayer() const override {
     return IsTerminal() ? kTerminalPlayerId : cur_player_;
   }
@@ -95,6 +100,10 @@ class MarkovSoccerState : public SimMoveState {
   void DoApplyActions(const std::vector<Action>& moves) override;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<3, T>& view) const;
   void SetField(int r, int c, char v);
   char field(int r, int c) const;
   void ResolveMove(Player player, int move);
@@ -131,12 +140,74 @@ class MarkovSoccerGame : public SimMoveGame {
   }
   std::vector<int> ObservationTensorShape() const override;
   int MaxGameLength() const override { return horizon_; }
+  const Grid& grid() const { return grid_; }
+  int horizon() const { return horizon_; }
 
  private:
   Grid grid_;
   int horizon_;
 };
 
+// A batch of soccer games stepped together, for RL smoke tests where stepping
+// the environment costs more than the network. It follows
+// algorithms::VectorEnv (see vector_env.h), but for this simultaneous game:
+// both players act at every step, and as every move is always legal and the
+// players observe the same field, there are no legal actions masks or current
+// players, and a single observation per environment. The games are kept as
+// arrays of player and ball positions rather than as a State per game.
+class MarkovSoccerVectorEnv {
+ public:
+  MarkovSoccerVectorEnv(std::shared_ptr<const Game> game, int num_envs,
+                        int seed);
+
+  // Starts a new game in every environment.
+  void Reset();
+
+  // [num_envs, 2], the moves of both players in each environment.
+  void Step(absl::Span<const Action> actions);
+
+  int num_envs() const { return total_moves_.size(); }
+
+  // [num_envs, ObservationTensorSize()], as MarkovSoccerState's.
+  const std::vector<float>& observations() const { return observations_; }
+
+  // [num_envs, 2], the rewards received during the last step. All zero after
+  // Reset().
+  const std::vector<float>& rewards() const { return rewards_; }
+
+  // [num_envs], 1 if the last step ended the game (the environment then holds
+  // the initial state of the next one), 0 otherwise.
+  const std::vector<int>& dones() const { return dones_; }
+
+ private:
+  void ResetEnv(int env);
+  // Returns the player who scored, if any.
+  Player ResolveMove(int env, Player player, int move);
+  void WriteObservation(int env);
+
+  std::shared_ptr<const Game> game_;
+  const Grid& grid_;
+  const int horizon_;
+  const int observation_size_;
+  std::mt19937 rng_;
+
+  // The position of each player, indexed by player first.
+  std::array<std::vector<int>, 2> player_rows_;
+  std::array<std::vector<int>, 2> player_cols_;
+  // The player holding the ball, or kInvalidPlayer if it is on the field at
+  // (ball_rows_, ball_cols_).
+  std::vector<Player> ball_owners_;
+  std::vector<int> ball_rows_;
+  std::vector<int> ball_cols_;
+  // As MarkovSoccerState::total_moves_, which counts the chance node placing
+  // the ball.
+  std::vector<int> total_moves_;
+
+  std::vector<float> observations_;
+  std::vector<float> rewards_;
+  std::vector<int> dones_;
+};
+
 }  // namespace markov_soccer
 }  // namespace open_spiel
 
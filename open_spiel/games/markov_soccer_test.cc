@@ -14,6 +14,12 @@
 
 #include "open_spiel/games/markov_soccer.h"
 
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -47,10 +53,78 @@ void BasicMarkovSoccerTests() {
       100);
 }
 
+bool ObservationMatches(const State& state, const MarkovSoccerVectorEnv& env,
+                        int i) {
+  const std::vector<double> observation = state.ObservationTensor(0);
+  for (int j = 0; j < observation.size(); ++j) {
+    if (env.observations()[i * observation.size() + j] != observation[j]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the child of the chance node state for which matches is true.
+std::unique_ptr<State> MatchingChild(
+    const State& state, const std::function<bool(const State&)>& matches) {
+  for (Action outcome : state.LegalActions()) {
+    std::unique_ptr<State> child = state.Child(outcome);
+    if (matches(*child)) return child;
+  }
+  SpielFatalError("No chance outcome matches the environment.");
+}
+
+// Replays the environments of the batch with states, inferring the chance
+// outcomes from the observations.
+void VectorEnvTest(const std::string& game_name) {
+  constexpr int kNumEnvs = 16;
+  std::shared_ptr<const Game> game = LoadGame(game_name);
+  MarkovSoccerVectorEnv env(game, kNumEnvs, /*seed=*/4321);
+  auto new_state = [&](int i) {
+    return MatchingChild(*game->NewInitialState(), [&](const State& state) {
+      return ObservationMatches(state, env, i);
+    });
+  };
+  std::vector<std::unique_ptr<State>> states;
+  for (int i = 0; i < kNumEnvs; ++i) states.push_back(new_state(i));
+
+  std::mt19937 rng;
+  int num_episodes = 0;
+  int num_goals = 0;
+  std::vector<Action> actions(kNumEnvs * 2);
+  for (int step = 0; step < 500; ++step) {
+    for (Action& action : actions) {
+      action = std::uniform_int_distribution<int>(0, 4)(rng);
+    }
+    env.Step(actions);
+    for (int i = 0; i < kNumEnvs; ++i) {
+      states[i]->ApplyActions({actions[2 * i], actions[2 * i + 1]});
+      states[i] = MatchingChild(*states[i], [&](const State& state) {
+        if (state.IsTerminal() != env.dones()[i]) return false;
+        if (state.IsTerminal()) {
+          return state.PlayerReturn(0) == env.rewards()[2 * i] &&
+                 state.PlayerReturn(1) == env.rewards()[2 * i + 1];
+        }
+        return ObservationMatches(state, env, i);
+      });
+      if (env.dones()[i]) {
+        num_goals += env.rewards()[2 * i] != 0;
+        ++num_episodes;
+        states[i] = new_state(i);
+      } else {
+        SPIEL_CHECK_EQ(env.rewards()[2 * i], 0);
+      }
+    }
+  }
+  SPIEL_CHECK_GT(num_episodes, 0);
+  SPIEL_CHECK_GT(num_goals, 0);
+}
+
 }  // namespace
 }  // namespace markov_soccer
 }  // namespace open_spiel
 
 int main(int argc, char **argv) {
   open_spiel::markov_soccer::BasicMarkovSoccerTests();
+  open_spiel::markov_soccer::VectorEnvTest("markov_soccer(horizon=50)");
 }
@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/mean_field_games/crowd_modelling.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace mean_field_games {
+namespace {
+
+// Keeps the crowd penalty finite where nobody is.
+constexpr double kEpsilon = 1e-25;
+
+std::vector<std::vector<std::pair<int, double>>> Transitions(int size) {
+  std::vector<std::vector<std::pair<int, double>>> transitions(
+      size * kCrowdModellingNumActions);
+  for (int x = 0; x < size; ++x) {
+    for (int a = 0; a < kCrowdModellingNumActions; ++a) {
+      for (int noise = -1; noise <= 1; ++noise) {
+        int next = (x + CrowdModellingGame::Move(a) + noise + 2 * size) % size;
+        transitions[x * kCrowdModellingNumActions + a].push_back(
+            {next, 1.0 / 3});
+      }
+    }
+  }
+  return transitions;
+}
+
+}  // namespace
+
+CrowdModellingGame::CrowdModellingGame(int size, int horizon)
+    : MeanFieldGame(size, kCrowdModellingNumActions, horizon,
+                    std::vector<double>(size, 1.0 / size), Transitions(size)),
+      size_(size) {
+  SPIEL_CHECK_GE(size_, 2);
+}
+
+void CrowdModellingGame::Rewards(int t, absl::Span<const double> distribution,
+                                 absl::Span<double> rewards) const {
+  SPIEL_CHECK_EQ(distribution.size(), size_);
+  SPIEL_CHECK_EQ(rewards.size(), size_ * kCrowdModellingNumActions);
+  const double half = size_ / 2;
+  for (int x = 0; x < size_; ++x) {
+    const double r_x = 1.0 - std::abs(x - size_ / 2) / half;
+    const double r_mu = -std::log(distribution[x] + kEpsilon);
+    for (int a = 0; a < kCrowdModellingNumActions; ++a) {
+      const double r_a = -1.0 * std::abs(Move(a)) / size_;
+      rewards[x * kCrowdModellingNumActions + a] = r_x + r_a + r_mu;
+    }
+  }
+}
+
+std::string CrowdModellingGame::ActionToString(int action) const {
+  switch (action) {
+    case 0:
+      return "left";
+    case 1:
+      return "stay";
+    case 2:
+      return "right";
+    default:
+      SpielFatalError(absl::StrCat("Invalid action: ", action));
+  }
+}
+
+}  // namespace mean_field_games
+}  // namespace open_spiel
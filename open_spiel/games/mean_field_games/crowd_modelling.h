@@ -0,0 +1,61 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_MEAN_FIELD_GAMES_CROWD_MODELLING_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_MEAN_FIELD_GAMES_CROWD_MODELLING_H_
+
+#include <string>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/mean_field_games/mean_field_game.h"
+
+// A crowd modelling mean field game on a ring of positions, after Perrin et
+// al. 2020 (https://arxiv.org/abs/2007.03458). The population starts spread
+// uniformly. At each step every agent moves left, stays or moves right, and
+// is then pushed one position left or right, or not at all, uniformly at
+// random. An agent at position x that took action a is rewarded
+//
+//   1 - |x - size / 2| / (size / 2)  -  |move(a)| / size  -  log(mu(x))
+//
+// for being near the middle, for not moving, and for avoiding the crowd, so
+// that at equilibrium the population concentrates around the middle of the
+// ring without all gathering there.
+
+namespace open_spiel {
+namespace mean_field_games {
+
+inline constexpr int kCrowdModellingNumActions = 3;
+inline constexpr int kCrowdModellingDefaultSize = 10;
+inline constexpr int kCrowdModellingDefaultHorizon = 10;
+
+class CrowdModellingGame : public MeanFieldGame {
+ public:
+  explicit CrowdModellingGame(int size = kCrowdModellingDefaultSize,
+                              int horizon = kCrowdModellingDefaultHorizon);
+
+  void Rewards(int t, absl::Span<const double> distribution,
+               absl::Span<double> rewards) const override;
+  std::string ActionToString(int action) const override;
+
+  // The displacement chosen by `action`: -1, 0 or 1.
+  static int Move(int action) { return action - 1; }
+
+ private:
+  int size_;
+};
+
+}  // namespace mean_field_games
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_MEAN_FIELD_GAMES_CROWD_MODELLING_H_
@@ -0,0 +1,212 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/mean_field_games/mean_field_game.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace mean_field_games {
+namespace {
+
+void CheckPolicy(const MeanFieldGame& game, const MeanFieldPolicy& policy) {
+  SPIEL_CHECK_EQ(policy.Horizon(), game.Horizon());
+  SPIEL_CHECK_EQ(policy.NumStates(), game.NumStates());
+  SPIEL_CHECK_EQ(policy.NumActions(), game.NumActions());
+}
+
+void CheckDistribution(const MeanFieldGame& game,
+                       const std::vector<std::vector<double>>& distribution) {
+  SPIEL_CHECK_EQ(distribution.size(), game.Horizon());
+  for (const std::vector<double>& mu : distribution) {
+    SPIEL_CHECK_EQ(mu.size(), game.NumStates());
+  }
+}
+
+// Sets q to the Q-values at time t given the values of the states at time
+// t + 1, i.e. the rewards plus the expected next value.
+void Backup(const MeanFieldGame& game, int t,
+            const std::vector<double>& distribution,
+            const std::vector<double>& next_values, absl::Span<double> q) {
+  const int num_actions = game.NumActions();
+  game.Rewards(t, distribution, q);
+  if (t + 1 == game.Horizon()) return;
+  for (int s = 0; s < game.NumStates(); ++s) {
+    for (int a = 0; a < num_actions; ++a) {
+      absl::Span<const int> next_states = game.NextStates(s, a);
+      absl::Span<const double> probs = game.NextStateProbabilities(s, a);
+      double expected = 0.0;
+      for (int i = 0; i < next_states.size(); ++i) {
+        expected += probs[i] * next_values[next_states[i]];
+      }
+      q[s * num_actions + a] += expected;
+    }
+  }
+}
+
+double InitialValue(const MeanFieldGame& game,
+                    const std::vector<double>& values) {
+  double value = 0.0;
+  for (int s = 0; s < game.NumStates(); ++s) {
+    value += game.InitialDistribution()[s] * values[s];
+  }
+  return value;
+}
+
+}  // namespace
+
+MeanFieldGame::MeanFieldGame(
+    int num_states, int num_actions, int horizon,
+    std::vector<double> initial_distribution,
+    const std::vector<std::vector<std::pair<int, double>>>& transitions)
+    : num_states_(num_states),
+      num_actions_(num_actions),
+      horizon_(horizon),
+      initial_distribution_(std::move(initial_distribution)) {
+  SPIEL_CHECK_GT(num_states_, 0);
+  SPIEL_CHECK_GT(num_actions_, 0);
+  SPIEL_CHECK_GT(horizon_, 0);
+  SPIEL_CHECK_EQ(initial_distribution_.size(), num_states_);
+  SPIEL_CHECK_EQ(transitions.size(), num_states_ * num_actions_);
+  offsets_.reserve(transitions.size() + 1);
+  offsets_.push_back(0);
+  for (const std::vector<std::pair<int, double>>& outcomes : transitions) {
+    for (const auto& [next_state, prob] : outcomes) {
+      SPIEL_CHECK_GE(next_state, 0);
+      SPIEL_CHECK_LT(next_state, num_states_);
+      SPIEL_CHECK_PROB(prob);
+      next_states_.push_back(next_state);
+      next_state_probabilities_.push_back(prob);
+    }
+    offsets_.push_back(next_states_.size());
+  }
+}
+
+std::string MeanFieldGame::StateToString(int state) const {
+  return absl::StrCat(state);
+}
+
+std::string MeanFieldGame::ActionToString(int action) const {
+  return absl::StrCat(action);
+}
+
+MeanFieldPolicy UniformPolicy(const MeanFieldGame& game) {
+  return MeanFieldPolicy(game.Horizon(), game.NumStates(), game.NumActions(),
+                         1.0 / game.NumActions());
+}
+
+std::vector<std::vector<double>> Distribution(const MeanFieldGame& game,
+                                              const MeanFieldPolicy& policy) {
+  CheckPolicy(game, policy);
+  const int num_actions = game.NumActions();
+  std::vector<std::vector<double>> distribution;
+  distribution.reserve(game.Horizon());
+  distribution.push_back(game.InitialDistribution());
+  for (int t = 0; t + 1 < game.Horizon(); ++t) {
+    const std::vector<double>& mu = distribution.back();
+    absl::Span<const double> probs = policy.TimeStep(t);
+    std::vector<double> next(game.NumStates(), 0.0);
+    for (int s = 0; s < game.NumStates(); ++s) {
+      if (mu[s] == 0.0) continue;
+      for (int a = 0; a < num_actions; ++a) {
+        const double mass = mu[s] * probs[s * num_actions + a];
+        if (mass == 0.0) continue;
+        absl::Span<const int> next_states = game.NextStates(s, a);
+        absl::Span<const double> next_probs =
+            game.NextStateProbabilities(s, a);
+        for (int i = 0; i < next_states.size(); ++i) {
+          next[next_states[i]] += mass * next_probs[i];
+        }
+      }
+    }
+    distribution.push_back(std::move(next));
+  }
+  return distribution;
+}
+
+StateActionArray QValues(const MeanFieldGame& game,
+                         const MeanFieldPolicy& policy,
+                         const std::vector<std::vector<double>>& distribution) {
+  CheckPolicy(game, policy);
+  CheckDistribution(game, distribution);
+  const int num_actions = game.NumActions();
+  StateActionArray q_values(game.Horizon(), game.NumStates(), num_actions);
+  std::vector<double> values(game.NumStates(), 0.0);
+  for (int t = game.Horizon() - 1; t >= 0; --t) {
+    absl::Span<double> q = q_values.MutableTimeStep(t);
+    Backup(game, t, distribution[t], values, q);
+    absl::Span<const double> probs = policy.TimeStep(t);
+    for (int s = 0; s < game.NumStates(); ++s) {
+      double value = 0.0;
+      for (int a = 0; a < num_actions; ++a) {
+        value += probs[s * num_actions + a] * q[s * num_actions + a];
+      }
+      values[s] = value;
+    }
+  }
+  return q_values;
+}
+
+double PolicyValue(const MeanFieldGame& game, const MeanFieldPolicy& policy,
+                   const std::vector<std::vector<double>>& distribution) {
+  StateActionArray q_values = QValues(game, policy, distribution);
+  const int num_actions = game.NumActions();
+  absl::Span<const double> probs = policy.TimeStep(0);
+  absl::Span<const double> q = q_values.TimeStep(0);
+  std::vector<double> values(game.NumStates(), 0.0);
+  for (int s = 0; s < game.NumStates(); ++s) {
+    for (int a = 0; a < num_actions; ++a) {
+      values[s] += probs[s * num_actions + a] * q[s * num_actions + a];
+    }
+  }
+  return InitialValue(game, values);
+}
+
+MeanFieldPolicy BestResponse(
+    const MeanFieldGame& game,
+    const std::vector<std::vector<double>>& distribution, double* value) {
+  CheckDistribution(game, distribution);
+  const int num_actions = game.NumActions();
+  MeanFieldPolicy policy(game.Horizon(), game.NumStates(), num_actions);
+  std::vector<double> q(game.NumStates() * num_actions);
+  std::vector<double> values(game.NumStates(), 0.0);
+  for (int t = game.Horizon() - 1; t >= 0; --t) {
+    Backup(game, t, distribution[t], values, absl::MakeSpan(q));
+    for (int s = 0; s < game.NumStates(); ++s) {
+      const auto begin = q.begin() + s * num_actions;
+      const auto best = std::max_element(begin, begin + num_actions);
+      values[s] = *best;
+      policy.MutableAt(t, s)[best - begin] = 1.0;
+    }
+  }
+  if (value != nullptr) *value = InitialValue(game, values);
+  return policy;
+}
+
+double Exploitability(const MeanFieldGame& game,
+                      const MeanFieldPolicy& policy) {
+  std::vector<std::vector<double>> distribution = Distribution(game, policy);
+  double best_response_value;
+  BestResponse(game, distribution, &best_response_value);
+  return best_response_value - PolicyValue(game, policy, distribution);
+}
+
+}  // namespace mean_field_games
+}  // namespace open_spiel
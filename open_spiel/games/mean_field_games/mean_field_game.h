@@ -0,0 +1,189 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_MEAN_FIELD_GAMES_MEAN_FIELD_GAME_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_MEAN_FIELD_GAMES_MEAN_FIELD_GAME_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+
+// Finite-horizon mean field games with finitely many states, played by a
+// population of identical agents that each only see their own state. The game
+// is given by tables rather than by State objects, so that the population
+// distribution, policies and values are dense arrays and the usual solvers
+// (fictitious play, online mirror descent) can propagate them over all states
+// at once instead of walking a game tree one state at a time:
+//
+// - The distribution at time t is a vector over states; at time 0 it is the
+//   initial distribution of the game.
+// - A policy gives, for each time t and state s, probabilities over actions.
+// - An agent in state s taking action a at time t receives r_t(s, a, mu_t),
+//   which depends on the distribution mu_t of the whole population, and then
+//   moves to s' with probability P(s' | s, a).
+//
+// References:
+// - Lasry & Lions, Mean field games, 2007.
+// - Perrin et al., Fictitious play for mean field games: continuous time
+//   analysis and applications, 2020. https://arxiv.org/abs/2007.03458
+// - Perolat et al., Scaling up mean field games with online mirror descent,
+//   2021. https://arxiv.org/abs/2103.00623
+
+namespace open_spiel {
+namespace mean_field_games {
+
+class MeanFieldGame {
+ public:
+  virtual ~MeanFieldGame() = default;
+
+  int NumStates() const { return num_states_; }
+  int NumActions() const { return num_actions_; }
+  // The number of time steps at which the agents act.
+  int Horizon() const { return horizon_; }
+
+  const std::vector<double>& InitialDistribution() const {
+    return initial_distribution_;
+  }
+
+  // The states reached from `state` by taking `action`, and with what
+  // probability, as parallel arrays.
+  absl::Span<const int> NextStates(int state, int action) const {
+    int i = state * num_actions_ + action;
+    return absl::MakeConstSpan(next_states_).subspan(
+        offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+  absl::Span<const double> NextStateProbabilities(int state,
+                                                  int action) const {
+    int i = state * num_actions_ + action;
+    return absl::MakeConstSpan(next_state_probabilities_)
+        .subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+
+  // Sets rewards[state * NumActions() + action] to the reward of taking
+  // `action` in `state` at time `t`, when the population is distributed as
+  // `distribution` at that time.
+  virtual void Rewards(int t, absl::Span<const double> distribution,
+                       absl::Span<double> rewards) const = 0;
+
+  virtual std::string StateToString(int state) const;
+  virtual std::string ActionToString(int action) const;
+
+ protected:
+  // `transitions[state * num_actions + action]` lists the states reached
+  // from `state` by taking `action`, with their probabilities.
+  MeanFieldGame(
+      int num_states, int num_actions, int horizon,
+      std::vector<double> initial_distribution,
+      const std::vector<std::vector<std::pair<int, double>>>& transitions);
+
+ private:
+  int num_states_;
+  int num_actions_;
+  int horizon_;
+  std::vector<double> initial_distribution_;
+  // The transitions in compressed sparse row form: those of the i-th
+  // (state, action) pair are at offsets_[i] to offsets_[i + 1].
+  std::vector<int> offsets_;
+  std::vector<int> next_states_;
+  std::vector<double> next_state_probabilities_;
+};
+
+// A value for each time step, state and action, in one contiguous array.
+class StateActionArray {
+ public:
+  StateActionArray(int horizon, int num_states, int num_actions,
+                   double value = 0.0)
+      : horizon_(horizon),
+        num_states_(num_states),
+        num_actions_(num_actions),
+        values_(static_cast<size_t>(horizon) * num_states * num_actions,
+                value) {}
+
+  int Horizon() const { return horizon_; }
+  int NumStates() const { return num_states_; }
+  int NumActions() const { return num_actions_; }
+
+  // The values of the actions in `state` at time `t`.
+  absl::Span<const double> At(int t, int state) const {
+    return absl::MakeConstSpan(values_).subspan(
+        (static_cast<size_t>(t) * num_states_ + state) * num_actions_,
+        num_actions_);
+  }
+  absl::Span<double> MutableAt(int t, int state) {
+    return absl::MakeSpan(values_).subspan(
+        (static_cast<size_t>(t) * num_states_ + state) * num_actions_,
+        num_actions_);
+  }
+
+  // All values at time `t`, indexed by state * num_actions + action.
+  absl::Span<const double> TimeStep(int t) const {
+    return absl::MakeConstSpan(values_).subspan(
+        static_cast<size_t>(t) * num_states_ * num_actions_,
+        static_cast<size_t>(num_states_) * num_actions_);
+  }
+  absl::Span<double> MutableTimeStep(int t) {
+    return absl::MakeSpan(values_).subspan(
+        static_cast<size_t>(t) * num_states_ * num_actions_,
+        static_cast<size_t>(num_states_) * num_actions_);
+  }
+
+ private:
+  int horizon_;
+  int num_states_;
+  int num_actions_;
+  std::vector<double> values_;
+};
+
+// A time-dependent policy, as action probabilities.
+using MeanFieldPolicy = StateActionArray;
+
+// The policy playing all actions with equal probability.
+MeanFieldPolicy UniformPolicy(const MeanFieldGame& game);
+
+// The distribution of the population at each time step when every agent
+// plays `policy`, by forward propagation from the initial distribution.
+std::vector<std::vector<double>> Distribution(const MeanFieldGame& game,
+                                              const MeanFieldPolicy& policy);
+
+// The expected return of each action, for an agent playing `policy` from the
+// next time step on while the population is distributed as `distribution`,
+// by backward induction from the horizon.
+StateActionArray QValues(const MeanFieldGame& game,
+                         const MeanFieldPolicy& policy,
+                         const std::vector<std::vector<double>>& distribution);
+
+// The expected return of an agent drawn from the initial distribution and
+// playing `policy`, while the population is distributed as `distribution`.
+double PolicyValue(const MeanFieldGame& game, const MeanFieldPolicy& policy,
+                   const std::vector<std::vector<double>>& distribution);
+
+// A deterministic best response to a population distributed as
+// `distribution`. If `value` is not null, it is set to the expected return of
+// the best response, as for PolicyValue.
+MeanFieldPolicy BestResponse(
+    const MeanFieldGame& game,
+    const std::vector<std::vector<double>>& distribution,
+    double* value = nullptr);
+
+// How much an agent could gain by deviating from `policy` when the whole
+// population plays it; zero exactly at a mean field Nash equilibrium.
+double Exploitability(const MeanFieldGame& game,
+                      const MeanFieldPolicy& policy);
+
+}  // namespace mean_field_games
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_MEAN_FIELD_GAMES_MEAN_FIELD_GAME_H_
@@ -0,0 +1,136 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/mean_field_games/mean_field_game.h"
+
+#include <cmath>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/games/mean_field_games/crowd_modelling.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace mean_field_games {
+namespace {
+
+void CheckIsDistribution(const std::vector<double>& mu) {
+  double total = 0.0;
+  for (double p : mu) {
+    SPIEL_CHECK_GE(p, 0.0);
+    total += p;
+  }
+  SPIEL_CHECK_FLOAT_NEAR(total, 1.0, 1e-12);
+}
+
+void TestTransitions() {
+  CrowdModellingGame game(/*size=*/5, /*horizon=*/3);
+  SPIEL_CHECK_EQ(game.NumStates(), 5);
+  SPIEL_CHECK_EQ(game.NumActions(), 3);
+  // Moving left from 0 wraps around, then the noise spreads the agent.
+  absl::Span<const int> left = game.NextStates(0, 0);
+  SPIEL_CHECK_EQ(std::vector<int>(left.begin(), left.end()),
+                 std::vector<int>({3, 4, 0}));
+  absl::Span<const int> right = game.NextStates(4, 2);
+  SPIEL_CHECK_EQ(std::vector<int>(right.begin(), right.end()),
+                 std::vector<int>({4, 0, 1}));
+  for (double p : game.NextStateProbabilities(2, 1)) {
+    SPIEL_CHECK_FLOAT_EQ(p, 1.0 / 3);
+  }
+  SPIEL_CHECK_EQ(game.ActionToString(0), "left");
+}
+
+void TestUniformPolicyKeepsUniformDistribution() {
+  CrowdModellingGame game;
+  std::vector<std::vector<double>> distribution =
+      Distribution(game, UniformPolicy(game));
+  SPIEL_CHECK_EQ(distribution.size(), game.Horizon());
+  for (const std::vector<double>& mu : distribution) {
+    CheckIsDistribution(mu);
+    for (double p : mu) SPIEL_CHECK_FLOAT_NEAR(p, 0.1, 1e-12);
+  }
+}
+
+// Three cells in a row, where agents start on the left and either stay or
+// step right.
+class WalkGame : public MeanFieldGame {
+ public:
+  WalkGame()
+      : MeanFieldGame(/*num_states=*/3, /*num_actions=*/2, /*horizon=*/3,
+                      {1.0, 0.0, 0.0},
+                      {{{0, 1.0}}, {{1, 1.0}},
+                       {{1, 1.0}}, {{2, 1.0}},
+                       {{2, 1.0}}, {{2, 1.0}}}) {}
+  void Rewards(int t, absl::Span<const double> distribution,
+               absl::Span<double> rewards) const override {
+    for (double& reward : rewards) reward = 0.0;
+  }
+};
+
+void TestDistributionFollowsPolicy() {
+  WalkGame game;
+  std::vector<std::vector<double>> distribution =
+      Distribution(game, UniformPolicy(game));
+  SPIEL_CHECK_EQ(distribution,
+                 std::vector<std::vector<double>>(
+                     {{1.0, 0.0, 0.0}, {0.5, 0.5, 0.0}, {0.25, 0.5, 0.25}}));
+
+  MeanFieldPolicy right(game.Horizon(), game.NumStates(), game.NumActions());
+  for (int t = 0; t < game.Horizon(); ++t) {
+    for (int s = 0; s < game.NumStates(); ++s) right.MutableAt(t, s)[1] = 1.0;
+  }
+  SPIEL_CHECK_EQ(Distribution(game, right).back(),
+                 std::vector<double>({0.0, 0.0, 1.0}));
+}
+
+void TestValues() {
+  CrowdModellingGame game(/*size=*/6, /*horizon=*/1);
+  std::vector<std::vector<double>> distribution = {
+      {0.5, 0.1, 0.1, 0.1, 0.1, 0.1}};
+  // With a single step, the value of staying put is the immediate reward.
+  MeanFieldPolicy policy = UniformPolicy(game);
+  StateActionArray q = QValues(game, policy, distribution);
+  SPIEL_CHECK_FLOAT_NEAR(q.At(0, 3)[1], 1.0 - std::log(0.1), 1e-9);
+  SPIEL_CHECK_FLOAT_NEAR(q.At(0, 0)[0], -1.0 / 6 - std::log(0.5), 1e-9);
+
+  double best_value;
+  MeanFieldPolicy best_response = BestResponse(game, distribution, &best_value);
+  SPIEL_CHECK_EQ(best_response.At(0, 3)[1], 1.0);
+  SPIEL_CHECK_GE(best_value, PolicyValue(game, policy, distribution));
+  SPIEL_CHECK_FLOAT_NEAR(best_value,
+                         PolicyValue(game, best_response, distribution), 1e-9);
+}
+
+void TestExploitability() {
+  CrowdModellingGame game;
+  const double uniform = Exploitability(game, UniformPolicy(game));
+  SPIEL_CHECK_GT(uniform, 0.0);
+  // A best response to the uniform population is also exploitable, since
+  // everybody playing it crowds the middle.
+  MeanFieldPolicy best_response =
+      BestResponse(game, Distribution(game, UniformPolicy(game)));
+  SPIEL_CHECK_GT(Exploitability(game, best_response), 0.0);
+}
+
+}  // namespace
+}  // namespace mean_field_games
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::mean_field_games::TestTransitions();
+  open_spiel::mean_field_games::TestUniformPolicyKeepsUniformDistribution();
+  open_spiel::mean_field_games::TestDistributionFollowsPolicy();
+  open_spiel::mean_field_games::TestValues();
+  open_spiel::mean_field_games::TestExploitability();
+}
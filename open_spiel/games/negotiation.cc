@@ -84,8 +84,8 @@ std::string NegotiationState::ActionToString(Player player,
       if (move_id == parent_game_.NumDistinctProposals() - 1) {
         absl::StrAppend(&action_string, "Proposal: Agreement reached!");
       } else {
-        std::vector<int> proposal = DecodeProposal(move_id);
-        std::string prop_str = absl::StrJoin(proposal, ", ");
+        std::string prop_str =
+            absl::StrJoin(parent_game_.ProposalItems(move_id), ", ");
         absl::StrAppend(&action_string, "Proposal: [", prop_str, "]");
       }
     } else {
@@ -113,7 +113,8 @@ std::vector<double> NegotiationState::Returns() const {
 
   int proposing_player = proposals_.size() % 2 == 1 ? 0 : 1;
   int other_player = 1 - proposing_player;
-  const std::vector<int>& final_proposal = proposals_.back();
+  absl::Span<const int> final_proposal =
+      parent_game_.ProposalItems(proposals_.back());
 
   std::vector<double> returns(num_players_, 0.0);
   for (int j = 0; j < num_items_; ++j) {
@@ -144,13 +145,16 @@ std::string NegotiationState::ObservationString(Player player) const {
   absl::StrAppend(&str, "Turn Type: ", TurnTypeToString(turn_type_), "\n");
 
   if (!proposals_.empty()) {
-    absl::StrAppend(&str, "Most recent proposal: [",
-                    absl::StrJoin(proposals_.back(), ", "), "]\n");
+    absl::StrAppend(
+        &str, "Most recent proposal: [",
+        absl::StrJoin(parent_game_.ProposalItems(proposals_.back()), ", "),
+        "]\n");
   }
 
   if (!utterances_.empty()) {
     absl::StrAppend(&str, "Most recent utterance: [",
-                    absl::StrJoin(utterances_.back(), ", "), "]\n");
+                    absl::StrJoin(DecodeUtterance(utterances_.back()), ", "),
+                    "]\n");
   }
 
   return str;
@@ -227,8 +231,10 @@ void NegotiationState::ObservationTensor(Player player,
 
   // Last proposal.
   if (!proposals_.empty()) {
+    absl::Span<const int> last_proposal =
+        parent_game_.ProposalItems(proposals_.back());
     for (int item = 0; item < num_items_; ++item) {
-      (*values)[offset + proposals_.back()[item]] = 1;
+      (*values)[offset + last_proposal[item]] = 1;
       offset += kMaxQuantity + 1;
     }
   } else {
@@ -238,8 +244,10 @@ void NegotiationState::ObservationTensor(Player player,
   // Last utterance.
   if (enable_utterances_) {
     if (!utterances_.empty()) {
+      const std::vector<int> last_utterance =
+          DecodeUtterance(utterances_.back());
       for (int dim = 0; dim < utterance_dim_; ++dim) {
-        (*values)[offset + utterances_.back()[dim]] = 1;
+        (*values)[offset + last_utterance[dim]] = 1;
         offset += num_symbols_;
       }
     } else {
@@ -325,8 +333,7 @@ void NegotiationState::DoApplyAction(Action move_id) {
         // Agreement!
         agreement_reached_ = true;
       } else {
-        std::vector<int> proposal = DecodeProposal(move_id);
-        proposals_.push_back(proposal);
+        proposals_.push_back(move_id);
       }
 
       if (enable_utterances_) {
@@ -338,31 +345,13 @@ void NegotiationState::DoApplyAction(Action move_id) {
       }
     } else {
       SPIEL_CHECK_TRUE(enable_utterances_);
-      std::vector<int> utterance = DecodeUtterance(move_id);
-      utterances_.push_back(utterance);
+      utterances_.push_back(move_id);
       turn_type_ = TurnType::kProposal;
       cur_player_ = 1 - cur_player_;
     }
   }
 }
 
-bool NegotiationState::NextProposal(std::vector<int>* proposal) const {
-  // Starting from the right, move left trying to increase the value. When
-  // successful, increment the value and set all the right digits back to 0.
-  for (int i = num_items_ - 1; i >= 0; --i) {
-    if ((*proposal)[i] + 1 <= item_pool_[i]) {
-      // Success!
-      (*proposal)[i]++;
-      for (int j = i + 1; j < num_items_; ++j) {
-        (*proposal)[j] = 0;
-      }
-      return true;
-    }
-  }
-
-  return false;
-}
-
 std::vector<int> NegotiationState::DecodeInteger(int encoded_value,
                                                  int dimensions,
                                                  int num_digit_values) const {
@@ -387,12 +376,6 @@ int NegotiationState::EncodeInteger(const std::vector<int>& container,
   return encoded_value;
 }
 
-Action NegotiationState::EncodeProposal(
-    const std::vector<int>& proposal) const {
-  SPIEL_CHECK_EQ(proposal.size(), num_items_);
-  return EncodeInteger(proposal, kMaxQuantity + 1);
-}
-
 Action NegotiationState::EncodeUtterance(
     const std::vector<int>& utterance) const {
   SPIEL_CHECK_EQ(utterance.size(), utterance_dim_);
@@ -401,10 +384,6 @@ Action NegotiationState::EncodeUtterance(
          EncodeInteger(utterance, num_symbols_);
 }
 
-std::vector<int> NegotiationState::DecodeProposal(int encoded_proposal) const {
-  return DecodeInteger(encoded_proposal, num_items_, kMaxQuantity + 1);
-}
-
 std::vector<int> NegotiationState::DecodeUtterance(
     int encoded_utterance) const {
   // Utterance ids are offset from zero (starting at NumDistinctProposals()).
@@ -420,12 +399,28 @@ std::vector<Action> NegotiationState::LegalActions() const {
   } else if (turn_type_ == TurnType::kProposal) {
     std::vector<Action> legal_actions;
 
-    // Proposals are always enabled, so first contruct them.
+    // Proposals are always enabled, so first contruct them: those of at most
+    // the pool's quantity of each item, counting in base kMaxQuantity + 1.
     std::vector<int> proposal(num_items_, 0);
-    legal_actions.push_back(EncodeProposal(proposal));
-
-    while (NextProposal(&proposal)) {
-      legal_actions.push_back(EncodeProposal(proposal));
+    Action encoded_proposal = 0;
+    legal_actions.push_back(encoded_proposal);
+    // Starting from the right, move left trying to increase the value. When
+    // successful, increment the value and set all the right digits back to 0.
+    int i = num_items_ - 1;
+    Action digit_value = 1;
+    while (i >= 0) {
+      if (proposal[i] < item_pool_[i]) {
+        proposal[i]++;
+        encoded_proposal += digit_value;
+        legal_actions.push_back(encoded_proposal);
+        i = num_items_ - 1;
+        digit_value = 1;
+      } else {
+        encoded_proposal -= proposal[i] * digit_value;
+        proposal[i] = 0;
+        digit_value *= kMaxQuantity + 1;
+        --i;
+      }
     }
 
     if (!proposals_.empty()) {
@@ -470,9 +465,12 @@ std::string NegotiationState::ToString() const {
 
   for (int i = 0; i < proposals_.size(); ++i) {
     absl::StrAppend(&str, "Player ", i % 2, " proposes: [",
-                    absl::StrJoin(proposals_[i], ", "), "]");
+                    absl::StrJoin(parent_game_.ProposalItems(proposals_[i]),
+                                  ", "),
+                    "]");
     if (enable_utterances_ && i < utterances_.size()) {
-      absl::StrAppend(&str, " utters: [", absl::StrJoin(utterances_[i], ", "),
+      absl::StrAppend(&str, " utters: [",
+                      absl::StrJoin(DecodeUtterance(utterances_[i]), ", "),
                       "]");
     }
     absl::StrAppend(&str, "\n");
@@ -503,6 +501,7 @@ NegotiationGame::NegotiationGame(const GameParameters& params)
       legal_utterances_({}),
       rng_(new std::mt19937(seed_ >= 0 ? seed_ : std::mt19937::default_seed)) {
   ConstructLegalUtterances();
+  ConstructProposalItems();
 }
 
 // Need to provide a custom copy constructor to clone the RNG.
@@ -515,6 +514,7 @@ NegotiationGame::NegotiationGame(const NegotiationGame& other)
       utterance_dim_(other.utterance_dim_),
       seed_(other.seed_),
       legal_utterances_(other.legal_utterances_),
+      proposal_items_(other.proposal_items_),
       rng_(new std::mt19937(*other.rng_)) {}
 
 void NegotiationGame::ConstructLegalUtterances() {
@@ -526,6 +526,20 @@ void NegotiationGame::ConstructLegalUtterances() {
   }
 }
 
+void NegotiationGame::ConstructProposalItems() {
+  // The agreement action has no items.
+  const int num_proposals = NumDistinctProposals() - 1;
+  proposal_items_.resize(num_proposals * num_items_);
+  for (int proposal = 0; proposal < num_proposals; ++proposal) {
+    int encoded_value = proposal;
+    for (int item = num_items_ - 1; item >= 0; --item) {
+      proposal_items_[proposal * num_items_ + item] =
+          encoded_value % (kMaxQuantity + 1);
+      encoded_value /= kMaxQuantity + 1;
+    }
+  }
+}
+
 int NegotiationGame::MaxGameLength() const {
   if (enable_utterances_) {
     return 2 * kMaxSteps;  // Every step is two turns: proposal, then utterance.
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 
 // A simple negotiation game where agents propose splits of a group of items,
@@ -110,17 +111,12 @@ class NegotiationState : public State {
   // Initialize state variables to start an episode.
   void InitializeEpisode();
 
-  // Get the next valid proposal; returns false when there are no more.
-  bool NextProposal(std::vector<int>* proposal) const;
-
   // Action encoding and decoding helpers. Actions are encoded as follows:
   // the first values { 0, 1, ... , NumDistinctProposals() - 1 } are reserved
   // for proposals, encoded in the usual way (fixed base). The next
   // NumDistinctUtterances() values are reserved for utterances, so these begin
-  // at an offset of NumDistinctProposals().
-  Action EncodeProposal(const std::vector<int>& proposal) const;
+  // at an offset of NumDistinctProposals(). The game decodes the proposals.
   Action EncodeUtterance(const std::vector<int>& utterance) const;
-  std::vector<int> DecodeProposal(int encoded_proposal) const;
   std::vector<int> DecodeUtterance(int encoded_utterance) const;
 
   std::vector<int> DecodeInteger(int encoded_value, int dimensions,
@@ -147,11 +143,11 @@ class NegotiationState : public State {
   // player i's utility for the jth item.
   std::vector<std::vector<int>> agent_utils_;
 
-  // History of proposals.
-  std::vector<std::vector<int>> proposals_;
+  // History of proposals, whose items are in the game's table.
+  std::vector<Action> proposals_;
 
   // History of utterances.
-  std::vector<std::vector<int>> utterances_;
+  std::vector<Action> utterances_;
 };
 
 class NegotiationGame : public Game {
@@ -195,8 +191,15 @@ class NegotiationGame : public Game {
     return legal_utterances_;
   }
 
+  // The quantity of each item in a proposal, other than the agreement.
+  absl::Span<const int> ProposalItems(Action proposal) const {
+    return absl::MakeConstSpan(proposal_items_).subspan(proposal * num_items_,
+                                                        num_items_);
+  }
+
  private:
   void ConstructLegalUtterances();
+  void ConstructProposalItems();
 
   bool enable_proposals_;
   bool enable_utterances_;
@@ -205,6 +208,9 @@ class NegotiationGame : public Game {
   int utterance_dim_;
   int seed_;
   std::vector<Action> legal_utterances_;
+  // The items of every proposal, num_items_ per proposal, shared by the
+  // states so that they only keep the proposal ids.
+  std::vector<int> proposal_items_;
   std::unique_ptr<std::mt19937> rng_;
 };
 
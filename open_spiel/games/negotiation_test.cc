@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/games/negotiation.h"
+
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -49,10 +52,34 @@ void BasicNegotiationTests() {
       100);
 }
 
+// The legal proposals are those of at most the pool's quantity of each item.
+void LegalProposalsTest() {
+  std::shared_ptr<const Game> game = LoadGame("negotiation");
+  const auto& negotiation_game = static_cast<const NegotiationGame&>(*game);
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    state->ApplyAction(0);
+    const std::vector<int>& item_pool =
+        static_cast<const NegotiationState&>(*state).ItemPool();
+    int num_proposals = 1;
+    for (int quantity : item_pool) num_proposals *= quantity + 1;
+
+    const std::vector<Action> legal_actions = state->LegalActions();
+    SPIEL_CHECK_EQ(legal_actions.size(), num_proposals);
+    for (Action action : legal_actions) {
+      absl::Span<const int> items = negotiation_game.ProposalItems(action);
+      for (int item = 0; item < item_pool.size(); ++item) {
+        SPIEL_CHECK_LE(items[item], item_pool[item]);
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace negotiation
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::negotiation::BasicNegotiationTests();
+  open_spiel::negotiation::LegalProposalsTest();
 }
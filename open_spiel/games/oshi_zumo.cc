@@ -70,22 +70,18 @@ OshiZumoState::OshiZumoState(std::shared_ptr<const Game> game)
       // Fields set to bad values. Use Game::NewInitialState().
       winner_(kNoWinner),
       total_moves_(0),
-      horizon_(parent_game_.horizon()),
-      starting_coins_(parent_game_.starting_coins()),
-      size_(parent_game_.size()),
-      alesia_(parent_game_.alesia()),
-      min_bid_(parent_game_.min_bid()),
-      // pos 0 and pos 2*size_+2 are "off the edge".
-      wrestler_pos_(size_ + 1),
-      coins_({{starting_coins_, starting_coins_}})
-
-{}
+      // pos 0 and pos 2*size+2 are "off the edge".
+      wrestler_pos_(parent_game_.size() + 1),
+      coins_({{parent_game_.starting_coins(), parent_game_.starting_coins()}}) {
+  EnableLegalActionsCache();
+}
 
 int OshiZumoState::CurrentPlayer() const {
   return IsTerminal() ? kTerminalPlayerId : kSimultaneousPlayerId;
 }
 
 void OshiZumoState::DoApplyActions(const std::vector<Action>& actions) {
+  InvalidateLegalActionsCache();
   SPIEL_CHECK_EQ(actions.size(), 2);
   SPIEL_CHECK_TRUE(actions[0] >= 0);
   SPIEL_CHECK_TRUE(actions[1] >= 0);
@@ -106,7 +102,7 @@ void OshiZumoState::DoApplyActions(const std::vector<Action>& actions) {
   // Check winner.
   if (wrestler_pos_ == 0) {
     winner_ = 0;
-  } else if (wrestler_pos_ == (2 * size_ + 2)) {
+  } else if (wrestler_pos_ == (2 * parent_game_.size() + 2)) {
     winner_ = 1;
   }
 
@@ -120,7 +116,7 @@ std::vector<Action> OshiZumoState::LegalActions(Player player) const {
   SPIEL_CHECK_TRUE(player == Player{0} || player == Player{1});
 
   std::vector<Action> movelist;
-  for (int bet = min_bid_; bet <= coins_[player]; bet++) {
+  for (int bet = parent_game_.min_bid(); bet <= coins_[player]; bet++) {
     movelist.push_back(bet);
   }
 
@@ -151,10 +147,10 @@ std::string OshiZumoState::ToString() const {
   absl::StrAppend(&result, coins_[1]);
   absl::StrAppend(&result, ", Field: ");
 
-  for (int p = 0; p <= 2 * size_ + 2; p++) {
+  for (int p = 0; p <= 2 * parent_game_.size() + 2; p++) {
     if (p == wrestler_pos_) {
       result += kWrestler;
-    } else if (p == 0 || p == (2 * size_ + 2)) {
+    } else if (p == 0 || p == (2 * parent_game_.size() + 2)) {
       result += kBoundaryPos;
     } else {
       result += kOpenPos;
@@ -166,7 +162,7 @@ std::string OshiZumoState::ToString() const {
 }
 
 bool OshiZumoState::IsTerminal() const {
-  return (total_moves_ >= horizon_ || winner_ != kNoWinner ||
+  return (total_moves_ >= parent_game_.horizon() || winner_ != kNoWinner ||
           (coins_[0] == 0 && coins_[1] == 0));
 }
 
@@ -181,11 +177,11 @@ std::vector<double> OshiZumoState::Returns() const {
     return {-1.0, 1.0};
   } else {
     // Wrestler not off the edge.
-    if (alesia_) {
+    if (parent_game_.alesia()) {
       return {0.0, 0.0};
-    } else if (wrestler_pos_ > (size_ + 1)) {
+    } else if (wrestler_pos_ > (parent_game_.size() + 1)) {
       return {1.0, -1.0};
-    } else if (wrestler_pos_ < (size_ + 1)) {
+    } else if (wrestler_pos_ < (parent_game_.size() + 1)) {
       return {-1.0, 1.0};
     } else {
       return {0.0, 0.0};
@@ -213,17 +209,17 @@ void OshiZumoState::ObservationTensor(Player player,
   values->resize(parent_game_.ObservationTensorShape()[0]);
   std::fill(values->begin(), values->end(), 0.);
 
-  // 1 bit per coin value of player 1. { 0, 1, ... , starting_coins_ }
-  // 1 bit per coin value of player 2. { 0, 1, ... , starting_coins_ }
-  // 1 bit per position of the field. { 0, 1, ... , 2*size_+2 }
+  // 1 bit per coin value of player 1. { 0, 1, ... , starting_coins }
+  // 1 bit per coin value of player 2. { 0, 1, ... , starting_coins }
+  // 1 bit per position of the field. { 0, 1, ... , 2*size+2 }
 
   int offset = 0;
   (*values)[offset + coins_[0]] = 1;
 
-  offset += (starting_coins_ + 1);
+  offset += (parent_game_.starting_coins() + 1);
   (*values)[offset + coins_[1]] = 1;
 
-  offset += (starting_coins_ + 1);
+  offset += (parent_game_.starting_coins() + 1);
   (*values)[offset + wrestler_pos_] = 1;
 }
 
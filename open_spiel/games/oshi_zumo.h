@@ -70,14 +70,11 @@ class OshiZumoState : public SimMoveState {
   void DoApplyActions(const std::vector<Action>& actions) override;
 
  private:
+  // The parameters are read from the game, so that the state only holds the
+  // position of the wrestler, the coins and the move count.
   const OshiZumoGame& parent_game_;
   int winner_;
   int total_moves_;
-  int horizon_;
-  int starting_coins_;
-  int size_;
-  bool alesia_;
-  int min_bid_;
   int wrestler_pos_;
   std::array<int, 2> coins_;
 };
@@ -56,19 +56,21 @@ OwareState::OwareState(std::shared_ptr<const Game> game,
       num_houses_per_player_(num_houses_per_player),
       total_seeds_(kNumPlayers * num_seeds_per_house * num_houses_per_player),
       board_(/*num_houses_per_player=*/num_houses_per_player,
-             /*num_seeds_per_house=*/num_seeds_per_house) {
-  boards_since_last_capture_.insert(board_);
+             /*num_seeds_per_house=*/num_seeds_per_house),
+      hash_(board_.HashValue()) {
+  hashes_since_last_capture_.insert(hash_);
 }
 
 OwareState::OwareState(std::shared_ptr<const Game> game,
                        const OwareBoard& board)
     : State(game),
-      num_houses_per_player_(board.seeds.size() / kNumPlayers),
+      num_houses_per_player_(board.NumHouses() / kNumPlayers),
       total_seeds_(board.TotalSeeds()),
-      board_(board) {
-  SPIEL_CHECK_EQ(0, board.seeds.size() % kNumPlayers);
+      board_(board),
+      hash_(board_.HashValue()) {
+  SPIEL_CHECK_EQ(0, board.NumHouses() % kNumPlayers);
   SPIEL_CHECK_TRUE(IsTerminal() || !LegalActions().empty());
-  boards_since_last_capture_.insert(board_);
+  hashes_since_last_capture_.insert(hash_);
 }
 
 std::vector<Action> OwareState::LegalActions() const {
@@ -172,16 +174,41 @@ std::unique_ptr<State> OwareState::Clone() const {
   return std::unique_ptr<State>(new OwareState(*this));
 }
 
+bool OwareState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const OwareState&>(other);
+  State::operator=(state);
+  hashes_since_last_capture_ = state.hashes_since_last_capture_;
+  board_ = state.board_;
+  hash_ = state.hash_;
+  undo_info_ = state.undo_info_;
+  return true;
+}
+
+void OwareState::SetSeeds(int house, int seeds) {
+  hash_ ^= OwareBoard::HouseKey(house, board_.seeds[house]) ^
+           OwareBoard::HouseKey(house, seeds);
+  board_.seeds[house] = seeds;
+}
+
+void OwareState::AddScore(Player player, int seeds) {
+  hash_ ^= OwareBoard::ScoreKey(player, board_.score[player]) ^
+           OwareBoard::ScoreKey(player, board_.score[player] + seeds);
+  board_.score[player] += seeds;
+}
+
 int OwareState::DistributeSeeds(int house) {
   int to_distribute = board_.seeds[house];
   SPIEL_CHECK_NE(to_distribute, 0);
-  board_.seeds[house] = 0;
+  SetSeeds(house, 0);
   int index = house;
   while (to_distribute > 0) {
     index = (index + 1) % NumHouses();
     // Seeds are never sown into the house they were drawn from.
     if (index != house) {
-      board_.seeds[index]++;
+      SetSeeds(index, board_.seeds[index] + 1);
       to_distribute--;
     }
   }
@@ -231,18 +258,20 @@ int OwareState::DoCaptureFrom(int house) {
   for (int index = house; index >= lower; index--) {
     if (ShouldCapture(board_.seeds[index])) {
       captured += board_.seeds[index];
-      board_.seeds[index] = 0;
+      SetSeeds(index, 0);
     } else {
       break;
     }
   }
-  board_.score[board_.current_player] += captured;
+  AddScore(board_.current_player, captured);
   return captured;
 }
 
 void OwareState::DoApplyAction(Action action) {
   SPIEL_CHECK_LT(history_.size(), kMaxGameLength);
 
+  undo_info_.push_back({board_, hash_, 0, false, false});
+  UndoInfo& undo_info = undo_info_.back();
   int last_house = DistributeSeeds(ActionToHouse(CurrentPlayer(), action));
 
   if (InOpponentRow(last_house) && !IsGrandSlam(last_house)) {
@@ -250,13 +279,17 @@ void OwareState::DoApplyAction(Action action) {
     if (captured > 0) {
       // No need to keep previous boards for checking game repetition because
       // captured seeds do not re-enter the game.
-      boards_since_last_capture_.clear();
+      hashes_since_last_capture_.clear();
+      undo_info.captured = true;
     }
   }
+  hash_ ^= OwareBoard::PlayerKey(0) ^ OwareBoard::PlayerKey(1);
   board_.current_player = 1 - board_.current_player;
 
-  if (!boards_since_last_capture_.insert(board_).second) {
+  undo_info.next_hash = hash_;
+  if (!hashes_since_last_capture_.insert(hash_).second) {
     // We have game repetition, the game is ended.
+    undo_info.repeated = true;
     CollectAndTerminate();
   }
 
@@ -265,11 +298,29 @@ void OwareState::DoApplyAction(Action action) {
   }
 }
 
+void OwareState::UndoAction(Player player, Action action) {
+  const UndoInfo& undo_info = undo_info_.back();
+  if (undo_info.captured) {
+    // Collect the hashes of the positions since the previous capture.
+    hashes_since_last_capture_.clear();
+    for (int i = undo_info_.size() - 1; i >= 0; --i) {
+      hashes_since_last_capture_.insert(undo_info_[i].hash);
+      if (i == 0 || undo_info_[i - 1].captured) break;
+    }
+  } else if (!undo_info.repeated) {
+    hashes_since_last_capture_.erase(undo_info.next_hash);
+  }
+  board_ = undo_info.board;
+  hash_ = undo_info.hash;
+  undo_info_.pop_back();
+  history_.pop_back();
+}
+
 void OwareState::CollectAndTerminate() {
   for (int house = 0; house < NumHouses(); house++) {
     const Player player = house / num_houses_per_player_;
-    board_.score[player] += board_.seeds[house];
-    board_.seeds[house] = 0;
+    AddScore(player, board_.seeds[house]);
+    SetSeeds(house, 0);
   }
 }
 
@@ -292,7 +343,10 @@ void OwareState::ObservationTensor(Player player,
 OwareGame::OwareGame(const GameParameters& params)
     : Game(kGameType, params),
       num_houses_per_player_(ParameterValue<int>("num_houses_per_player")),
-      num_seeds_per_house_(ParameterValue<int>("num_seeds_per_house")) {}
+      num_seeds_per_house_(ParameterValue<int>("num_seeds_per_house")) {
+  SPIEL_CHECK_GT(num_houses_per_player_, 0);
+  SPIEL_CHECK_LE(num_houses_per_player_, kMaxHousesPerPlayer);
+}
 
 std::vector<int> OwareGame::ObservationTensorShape() const {
   return {/*seeds*/ num_houses_per_player_ * kNumPlayers +
@@ -15,9 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_OWARE_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_OWARE_H_
 
+#include <cstdint>
 #include <memory>
-#include <unordered_set>
 
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_set.h"
 #include "open_spiel/games/oware/oware_board.h"
 #include "open_spiel/spiel.h"
 
@@ -70,7 +71,12 @@ class OwareState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
+  void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   const OwareBoard& Board() const { return board_; }
+  // A Zobrist hash of the board, updated incrementally.
+  uint64_t Hash() const override { return hash_; }
   std::string ObservationString(Player player) const override;
 
   // The game board is provided as a vector, encoding the players' seeds
@@ -87,6 +93,10 @@ class OwareState : public State {
  private:
   void WritePlayerScore(std::ostringstream& out, Player player) const;
 
+  // Change the board, keeping hash_ up to date.
+  void SetSeeds(int house, int seeds);
+  void AddScore(Player player, int seeds);
+
   // Collects the seeds from the given house and distributes them
   // counterclockwise, skipping the starting position in all cases.
   // Returns the index of the last house in which a seed was dropped.
@@ -139,22 +149,30 @@ class OwareState : public State {
 
   int NumHouses() const { return kNumPlayers * num_houses_per_player_; }
 
-  class OwareBoardHash {
-   public:
-    std::size_t operator()(const OwareBoard& board) const {
-      return board.HashValue();
-    }
-  };
-
   const int num_houses_per_player_;
   const int total_seeds_;
 
-  // We keep the set of visited board states to detect repetition, at which
-  // point the game ends and both players collect the seeds on their own row.
-  // Because captured seeds never enter the game again, this set is reset
+  // We keep the hashes of the visited board states to detect repetition, at
+  // which point the game ends and both players collect the seeds on their own
+  // row. Because captured seeds never enter the game again, this set is reset
   // on any capture.
-  std::unordered_set<OwareBoard, OwareBoardHash> boards_since_last_capture_;
+  absl::flat_hash_set<uint64_t> hashes_since_last_capture_;
   OwareBoard board_;
+  uint64_t hash_;
+
+  // The positions before each move, with how the move changed
+  // hashes_since_last_capture_, for UndoAction.
+  struct UndoInfo {
+    OwareBoard board;
+    uint64_t hash;
+    // The hash looked up in hashes_since_last_capture_ after the move.
+    uint64_t next_hash;
+    // Whether the move captured seeds, clearing hashes_since_last_capture_.
+    bool captured;
+    // Whether next_hash was already there, ending the game.
+    bool repeated;
+  };
+  std::vector<UndoInfo> undo_info_;
 };
 
 // Game object.
@@ -14,22 +14,33 @@
 
 #include "open_spiel/games/oware/oware_board.h"
 
+#include <algorithm>
+
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+
 namespace open_spiel {
 namespace oware {
 
 OwareBoard::OwareBoard(int num_houses_per_player, int num_seeds_per_house)
     : current_player(Player{0}),
-      score(kNumPlayers, 0),
-      seeds(kNumPlayers * num_houses_per_player, num_seeds_per_house) {}
+      num_houses(kNumPlayers * num_houses_per_player) {
+  SPIEL_CHECK_GT(num_houses_per_player, 0);
+  SPIEL_CHECK_LE(num_houses_per_player, kMaxHousesPerPlayer);
+  std::fill(seeds.begin(), seeds.begin() + num_houses, num_seeds_per_house);
+}
 
 OwareBoard::OwareBoard(Player current_player, const std::vector<int>& score,
                        const std::vector<int>& seeds)
-    : current_player(current_player), score(score), seeds(seeds) {
+    : current_player(current_player), num_houses(seeds.size()) {
   SPIEL_CHECK_EQ(score.size(), kNumPlayers);
+  SPIEL_CHECK_LE(seeds.size(), kMaxNumHouses);
+  std::copy(score.begin(), score.end(), this->score.begin());
+  std::copy(seeds.begin(), seeds.end(), this->seeds.begin());
 }
 
 bool OwareBoard::operator==(const OwareBoard& other) const {
-  return current_player == other.current_player && score == other.score &&
+  return current_player == other.current_player &&
+         num_houses == other.num_houses && score == other.score &&
          seeds == other.seeds;
 }
 
@@ -38,21 +49,34 @@ bool OwareBoard::operator!=(const OwareBoard& other) const {
 }
 
 std::string OwareBoard::ToString() const {
-  return absl::StrCat(current_player, " | ", absl::StrJoin(score, " "), " | ",
-                      absl::StrJoin(seeds, " "));
+  return absl::StrCat(
+      current_player, " | ", absl::StrJoin(score, " "), " | ",
+      absl::StrJoin(absl::MakeConstSpan(seeds.data(), num_houses), " "));
 }
 
-size_t OwareBoard::HashValue() const {
-  // Hashing similar to boost::hash_combine.
-  size_t hash = current_player;
-  for (int player_score : score) {
-    hash ^= (size_t)player_score + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+uint64_t OwareBoard::HashValue() const {
+  uint64_t hash = PlayerKey(current_player);
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    hash ^= ScoreKey(player, score[player]);
   }
-  for (int house_seeds : seeds) {
-    hash ^= (size_t)house_seeds + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  for (int house = 0; house < num_houses; ++house) {
+    hash ^= HouseKey(house, seeds[house]);
   }
   return hash;
 }
+
+uint64_t OwareBoard::HouseKey(int house, int seeds) {
+  return HashMix((uint64_t{static_cast<uint32_t>(house)} << 32) | seeds);
+}
+
+uint64_t OwareBoard::ScoreKey(Player player, int score) {
+  return HouseKey(kMaxNumHouses + player, score);
+}
+
+uint64_t OwareBoard::PlayerKey(Player player) {
+  return player == 0 ? 0 : HashMix(~uint64_t{0});
+}
+
 int OwareBoard::TotalSeeds() const {
   int total = 0;
   for (int house_seeds : seeds) {
@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_OWARE_OWARE_BOARD_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_OWARE_OWARE_BOARD_H_
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,6 +26,8 @@ namespace open_spiel {
 namespace oware {
 
 inline constexpr int kNumPlayers = 2;
+inline constexpr int kMaxHousesPerPlayer = 16;
+inline constexpr int kMaxNumHouses = kNumPlayers * kMaxHousesPerPlayer;
 
 // Simple Oware board struct storing the current player, scores and seeds.
 struct OwareBoard {
@@ -37,20 +41,28 @@ struct OwareBoard {
   bool operator==(const OwareBoard& other) const;
   bool operator!=(const OwareBoard& other) const;
   std::string ToString() const;
-  size_t HashValue() const;
+  // A Zobrist hash of the current player, scores and seeds, computed from
+  // scratch. The keys below allow it to be updated incrementally instead.
+  uint64_t HashValue() const;
+  static uint64_t HouseKey(int house, int seeds);
+  static uint64_t ScoreKey(Player player, int score);
+  static uint64_t PlayerKey(Player player);
+
+  int NumHouses() const { return num_houses; }
 
   // Returns total number of seeds, both those
   // captured and the ones still in play.
   int TotalSeeds() const;
 
   Player current_player;
+  int num_houses;
   // The number of seeds each player has in their score house, one entry
   // for each player.
-  std::vector<int> score;
+  std::array<int, kNumPlayers> score{};
   // The number of seeds in each house. First the (kNumHousesPerPlayer) houses
   // for player 0, then for player 1, in counterclockwise order (i.e. the order
-  // in which seeds are sown).
-  std::vector<int> seeds;
+  // in which seeds are sown). The entries past num_houses are always 0.
+  std::array<int, kMaxNumHouses> seeds{};
 };
 
 std::ostream& operator<<(std::ostream& os, const OwareBoard& board);
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/oware.h"
 
+#include <random>
+
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -25,12 +27,18 @@ namespace testing = open_spiel::testing;
 void BasicOwareTests() {
   testing::LoadGameTest("oware");
   testing::RandomSimTest(*LoadGame("oware"), 10);
+  testing::RandomSimTestWithUndo(*LoadGame("oware"), 10);
   testing::NoChanceOutcomesTest(*LoadGame("oware"));
 
   testing::RandomSimTest(
       *LoadGame("oware", {{"num_houses_per_player", GameParameter(2)},
                           {"num_seeds_per_house", GameParameter(2)}}),
       10);
+  // Small boards repeat positions, which ends the game.
+  testing::RandomSimTestWithUndo(
+      *LoadGame("oware", {{"num_houses_per_player", GameParameter(2)},
+                          {"num_seeds_per_house", GameParameter(2)}}),
+      10);
 }
 
 void LegalActionsNoConstraintsTest() {
@@ -122,6 +130,41 @@ void GameEndsByRepetitionTest() {
                  OwareBoard(0, {24, 24}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 }
 
+void IncrementalHashTest() {
+  std::shared_ptr<const Game> game = LoadGame("oware");
+  std::mt19937 rng(0);
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      const auto& oware_state = static_cast<const OwareState&>(*state);
+      SPIEL_CHECK_EQ(oware_state.Hash(), oware_state.Board().HashValue());
+      const std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[rng() % actions.size()]);
+    }
+    const auto& oware_state = static_cast<const OwareState&>(*state);
+    SPIEL_CHECK_EQ(oware_state.Hash(), oware_state.Board().HashValue());
+  }
+}
+
+void CopyFromThenUndoTest() {
+  std::shared_ptr<const Game> game = LoadGame("oware");
+  std::mt19937 rng(0);
+  std::unique_ptr<State> recycled = game->NewInitialState();
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    std::unique_ptr<State> previous = state->Clone();
+    const std::vector<Action> actions = state->LegalActions();
+    const Action action = actions[rng() % actions.size()];
+    state->ApplyAction(action);
+
+    SPIEL_CHECK_TRUE(recycled->CopyFrom(*state));
+    recycled->UndoAction(previous->CurrentPlayer(), action);
+    SPIEL_CHECK_EQ(recycled->ToString(), previous->ToString());
+    SPIEL_CHECK_EQ(recycled->Hash(), previous->Hash());
+    SPIEL_CHECK_EQ(recycled->History(), previous->History());
+  }
+}
+
 }  // namespace
 }  // namespace oware
 }  // namespace open_spiel
@@ -136,4 +179,6 @@ int main(int argc, char** argv) {
   open_spiel::oware::NoCaptureBecauseTooFewSeedsTest();
   open_spiel::oware::NoCaptureBecauseTooManySeedsTest();
   open_spiel::oware::NoCaptureBecauseGrandSlamTest();
+  open_spiel::oware::IncrementalHashTest();
+  open_spiel::oware::CopyFromThenUndoTest();
 }
@@ -134,6 +134,55 @@ constexpr uint64_t win_mask[kPossibleWinConditions] = {
     bl_tr(0, 4), bl_tr(1, 5),  // Offset diagonals
 };
 
+// The xy location of each bit.
+constexpr std::array<int, kBoardPositions> BitToXy() {
+  std::array<int, kBoardPositions> bit_to_xy{};
+  for (int xy = 0; xy < kBoardPositions; ++xy) bit_to_xy[xy_to_bit[xy]] = xy;
+  return bit_to_xy;
+}
+constexpr std::array<int, kBoardPositions> bit_to_xy = BitToXy();
+
+// Each quadrant takes 9 bits: its ring of 8 cells, clockwise from the corner
+// of the board, then its center. The quadrants follow each other clockwise
+// from the top-left one, so rotating the board clockwise moves each quadrant
+// to the next 9 bits, and mirroring it swaps pairs of quadrants and reverses
+// the direction of their rings.
+constexpr int kQuadrantBits = 9;
+constexpr uint64_t kBoardMask = (1ull << kBoardPositions) - 1;
+
+// The ring of a quadrant mirrored, keeping its corner.
+constexpr std::array<uint8_t, 256> MirroredRings() {
+  std::array<uint8_t, 256> mirrored{};
+  for (int ring = 0; ring < 256; ++ring) {
+    for (int i = 0; i < 8; ++i) {
+      if (ring & (1 << i)) mirrored[ring] |= 1 << ((8 - i) % 8);
+    }
+  }
+  return mirrored;
+}
+constexpr std::array<uint8_t, 256> mirrored_ring = MirroredRings();
+
+uint64_t mirror_board(uint64_t b) {
+  uint64_t mirrored = 0;
+  for (int quadrant = 0; quadrant < 4; ++quadrant) {
+    const uint64_t bits = (b >> (quadrant * kQuadrantBits)) & 0x1FF;
+    mirrored |= (mirrored_ring[bits & 0xFF] | (bits & 0x100))
+                << ((quadrant ^ 1) * kQuadrantBits);
+  }
+  return mirrored;
+}
+
+uint64_t rotate_board_cw(uint64_t b, int quarter_turns) {
+  const int shift = quarter_turns * kQuadrantBits;
+  return shift == 0
+             ? b
+             : ((b << shift) | (b >> (kBoardPositions - shift))) & kBoardMask;
+}
+
+uint64_t symmetric_board(uint64_t b, int symmetry) {
+  return rotate_board_cw(symmetry >= 4 ? mirror_board(b) : b, symmetry % 4);
+}
+
 // Rotate a quadrant clockwise or counter-clockwise.
 // Pulls a 8-bit segment and rotates it by 2 bits.
 uint64_t rotate_quadrant_cw(uint64_t b, int quadrant) {
@@ -171,6 +220,44 @@ std::vector<Action> PentagoState::LegalActions() const {
   return moves;
 }
 
+uint64_t PentagoState::SymmetricHash(int symmetry) const {
+  return HashMix(symmetric_board(board_[0], symmetry) ^
+                 HashMix(symmetric_board(board_[1], symmetry)));
+}
+
+int PentagoState::CanonicalSymmetry() const {
+  // The canonical position has the least boards, in lexicographic order.
+  int best_symmetry = 0;
+  std::pair<uint64_t, uint64_t> best_boards = {board_[0], board_[1]};
+  for (int symmetry = 1; symmetry < kNumSymmetries; ++symmetry) {
+    const std::pair<uint64_t, uint64_t> boards = {
+        symmetric_board(board_[0], symmetry),
+        symmetric_board(board_[1], symmetry)};
+    if (boards < best_boards) {
+      best_symmetry = symmetry;
+      best_boards = boards;
+    }
+  }
+  return best_symmetry;
+}
+
+Action PentagoState::SymmetricAction(Action action, int symmetry) {
+  SPIEL_CHECK_GE(symmetry, 0);
+  SPIEL_CHECK_LT(symmetry, kNumSymmetries);
+  const Move move(action);
+  const int xy = bit_to_xy[__builtin_ctzll(
+      symmetric_board(xy_bit_mask[move.xy], symmetry))];
+  int quadrant = move.quadrant;
+  int dir = move.dir;
+  if (symmetry >= 4) {
+    // Mirroring swaps the quadrants side by side, and the directions.
+    quadrant ^= 1;
+    dir ^= 1;
+  }
+  quadrant = (quadrant + symmetry) % 4;
+  return Move(xy % kBoardSize, xy / kBoardSize, quadrant * 2 + dir).ToAction();
+}
+
 std::string PentagoState::ActionToString(Player player,
                                          Action action_id) const {
   return Move(action_id).ToString();
@@ -263,15 +350,30 @@ int PlayerRelative(PentagoPlayer state, Player current) {
   }
 }
 
+template <class T>
+void PentagoState::WriteObservationTensor(Player player,
+                                          TensorView<2, T>& view) const {
+  for (int i = 0; i < kBoardPositions; i++) {
+    view[{PlayerRelative(get(i), player), i}] = 1.0;
+  }
+}
+
 void PentagoState::ObservationTensor(Player player,
                                      std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   TensorView<2> view(values, {kCellStates, kBoardPositions}, true);
-  for (int i = 0; i < kBoardPositions; i++) {
-    view[{PlayerRelative(get(i), player), i}] = 1.0;
-  }
+  WriteObservationTensor(player, view);
+}
+
+void PentagoState::ObservationTensor(Player player,
+                                     absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(values, {kCellStates, kBoardPositions}, true);
+  WriteObservationTensor(player, view);
 }
 
 void PentagoState::DoApplyAction(Action action) {
@@ -318,6 +420,19 @@ std::unique_ptr<State> PentagoState::Clone() const {
   return std::unique_ptr<State>(new PentagoState(*this));
 }
 
+bool PentagoState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const PentagoState&>(other);
+  State::operator=(state);
+  board_ = state.board_;
+  current_player_ = state.current_player_;
+  outcome_ = state.outcome_;
+  moves_made_ = state.moves_made_;
+  return true;
+}
+
 PentagoGame::PentagoGame(const GameParameters& params)
     : Game(kGameType, params),
       ansi_color_output_(ParameterValue<bool>("ansi_color_output")) {}
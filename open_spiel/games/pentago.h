@@ -22,7 +22,9 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // https://en.wikipedia.org/wiki/Pentago
 // Does not implement pie rule to balance the game
@@ -40,6 +42,7 @@ inline constexpr int kPossibleRotations = 8;
 inline constexpr int kPossibleActions = kBoardPositions * kPossibleRotations;
 inline constexpr int kPossibleWinConditions = 32;
 inline constexpr int kCellStates = 1 + kNumPlayers;
+inline constexpr int kNumSymmetries = 8;
 
 enum PentagoPlayer {
   kPlayer1,
@@ -70,9 +73,35 @@ class PentagoState : public State {
   // specified player, the other player, and empty.
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
   std::vector<Action> LegalActions() const override;
 
+  // A hash of the position.
+  uint64_t Hash() const override { return SymmetricHash(0); }
+
+  // The board has 8 symmetries: symmetry s rotates the board clockwise by
+  // s % 4 quarter turns, after mirroring it left to right if s >= 4. These
+  // map positions to positions of the same value and actions to the
+  // corresponding actions, so that searches and tablebases can keep a single
+  // position of each class.
+  //
+  // Returns the hash of the position after the symmetry.
+  uint64_t SymmetricHash(int symmetry) const;
+  // Returns the symmetry that maps the position to the canonical one of its
+  // class, and the hash of the latter, which is equal for all the positions
+  // of a class.
+  int CanonicalSymmetry() const;
+  uint64_t CanonicalHash() const { return SymmetricHash(CanonicalSymmetry()); }
+  // Returns the action corresponding to `action` after the symmetry, and the
+  // symmetry undoing `symmetry`.
+  static Action SymmetricAction(Action action, int symmetry);
+  static int InverseSymmetry(int symmetry) {
+    return symmetry < 4 ? (4 - symmetry) % 4 : symmetry;
+  }
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -80,6 +109,10 @@ class PentagoState : public State {
   PentagoPlayer get(int i) const;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
   std::array<uint64_t, kNumPlayers> board_;
   PentagoPlayer current_player_ = kPlayer1;
   PentagoPlayer outcome_ = kPlayerNone;
@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/games/pentago.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
@@ -33,8 +40,54 @@ void BasicPentagoTests() {
   testing::RandomSimTest(*LoadGame("pentago(ansi_color_output=True)"), 10);
 }
 
+// Plays random games along with their symmetric images.
+void SymmetryTest() {
+  std::shared_ptr<const Game> game = LoadGame("pentago");
+  std::mt19937 rng(0);
+  for (int i = 0; i < 20; ++i) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    std::vector<std::unique_ptr<State>> images;
+    for (int symmetry = 0; symmetry < kNumSymmetries; ++symmetry) {
+      images.push_back(game->NewInitialState());
+    }
+    while (true) {
+      const auto& pentago_state = static_cast<const PentagoState&>(*state);
+      const uint64_t canonical_hash = pentago_state.CanonicalHash();
+      std::vector<Action> actions = state->LegalActions();
+      for (int symmetry = 0; symmetry < kNumSymmetries; ++symmetry) {
+        const auto& image = static_cast<const PentagoState&>(*images[symmetry]);
+        SPIEL_CHECK_EQ(image.Hash(), pentago_state.SymmetricHash(symmetry));
+        SPIEL_CHECK_EQ(image.CanonicalHash(), canonical_hash);
+        SPIEL_CHECK_EQ(image.Returns(), state->Returns());
+        std::vector<Action> symmetric_actions;
+        for (Action action : actions) {
+          const Action symmetric_action =
+              PentagoState::SymmetricAction(action, symmetry);
+          SPIEL_CHECK_EQ(PentagoState::SymmetricAction(
+                             symmetric_action,
+                             PentagoState::InverseSymmetry(symmetry)),
+                         action);
+          symmetric_actions.push_back(symmetric_action);
+        }
+        std::sort(symmetric_actions.begin(), symmetric_actions.end());
+        SPIEL_CHECK_EQ(image.LegalActions(), symmetric_actions);
+      }
+      if (state->IsTerminal()) break;
+      const Action action = actions[rng() % actions.size()];
+      state->ApplyAction(action);
+      for (int symmetry = 0; symmetry < kNumSymmetries; ++symmetry) {
+        images[symmetry]->ApplyAction(
+            PentagoState::SymmetricAction(action, symmetry));
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace pentago
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::pentago::BasicPentagoTests(); }
+int main(int argc, char** argv) {
+  open_spiel::pentago::BasicPentagoTests();
+  open_spiel::pentago::SymmetryTest();
+}
@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/phantom_ttt.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -60,6 +63,27 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// The lines of three cells, as sets of cells with bit `cell` set.
+constexpr std::array<int, 8> kLines = {0007, 0070, 0700, 0111,
+                                       0222, 0444, 0421, 0124};
+
+bool HasLine(int cells) {
+  for (int line : kLines) {
+    if ((cells & line) == line) return true;
+  }
+  return false;
+}
+
+// The n-th cell of `cells`, in increasing order.
+int NthCell(int cells, int n) {
+  for (; n > 0; --n) cells &= cells - 1;
+  return __builtin_ctz(cells);
+}
+
+int UniformIndex(int n, const std::function<double()>& rng) {
+  return std::min(static_cast<int>(rng() * n), n - 1);
+}
+
 }  // namespace
 
 PhantomTTTState::PhantomTTTState(std::shared_ptr<const Game> game,
@@ -242,6 +266,96 @@ void PhantomTTTState::UndoAction(Player player, Action move) {
   // if necessary.
 }
 
+std::unique_ptr<State> PhantomTTTState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  SPIEL_CHECK_FALSE(IsTerminal());
+  // The player's moves give the cells they took, and the cells they found
+  // taken by the opponent, each after a number of the opponent's turns.
+  int own_cells = 0;
+  int found_cells = 0;
+  int opponent_turns = 0;
+  std::array<int, kNumCells> deadline;
+  for (const auto& [player, move] : action_sequence_) {
+    const bool succeeded = state_.BoardAt(move) == PlayerToState(player);
+    if (player == player_id) {
+      if (succeeded) {
+        own_cells |= 1 << move;
+      } else {
+        found_cells |= 1 << move;
+        deadline[move] = opponent_turns;
+      }
+    } else if (succeeded) {
+      ++opponent_turns;
+    }
+  }
+
+  // The opponent's other cells are drawn uniformly among those without a
+  // line of three, which would have ended the game.
+  const int free_cells = ((1 << kNumCells) - 1) & ~own_cells & ~found_cells;
+  const int num_other_cells = opponent_turns - __builtin_popcount(found_cells);
+  auto consistent = [&](int cells) {
+    return __builtin_popcount(cells) == num_other_cells &&
+           !HasLine(cells | found_cells);
+  };
+  int num_choices = 0;
+  for (int cells = free_cells;; cells = (cells - 1) & free_cells) {
+    num_choices += consistent(cells);
+    if (cells == 0) break;
+  }
+  SPIEL_CHECK_GT(num_choices, 0);
+  int opponent_cells = found_cells;
+  for (int cells = free_cells, n = UniformIndex(num_choices, rng);;
+       cells = (cells - 1) & free_cells) {
+    if (consistent(cells) && n-- == 0) {
+      opponent_cells |= cells;
+      break;
+    }
+  }
+
+  // Each found cell must be taken before it was found. The cells are given
+  // turns in increasing order of deadline, each a uniform free turn before its
+  // own, which draws the orders uniformly.
+  std::array<int, kNumCells> cell_of_turn;
+  std::fill(cell_of_turn.begin(), cell_of_turn.end(), -1);
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    if (!(found_cells & (1 << cell))) deadline[cell] = opponent_turns;
+  }
+  int num_placed = 0;
+  for (int turns = 0; turns <= opponent_turns; ++turns) {
+    for (int cell = 0; cell < kNumCells; ++cell) {
+      if (!(opponent_cells & (1 << cell)) || deadline[cell] != turns) continue;
+      int n = UniformIndex(turns - num_placed++, rng);
+      int turn = 0;
+      while (cell_of_turn[turn] >= 0 || n-- > 0) ++turn;
+      cell_of_turn[turn] = cell;
+    }
+  }
+
+  // Replays the game with the opponent's moves: the same number of tries
+  // each turn, which the information state tensor and the reveal-numturns
+  // variant show, the failed ones on the player's marks.
+  std::unique_ptr<State> state = game_->NewInitialState();
+  int placed_cells = 0;
+  int tried_cells = 0;
+  int turn = 0;
+  for (const auto& [player, move] : action_sequence_) {
+    if (player == player_id) {
+      state->ApplyAction(move);
+      if (own_cells & (1 << move)) placed_cells |= 1 << move;
+    } else if (state_.BoardAt(move) == PlayerToState(player)) {
+      state->ApplyAction(cell_of_turn[turn++]);
+    } else {
+      const int untried_cells = placed_cells & ~tried_cells;
+      const int cell = NthCell(
+          untried_cells,
+          UniformIndex(__builtin_popcount(untried_cells), rng));
+      tried_cells |= 1 << cell;
+      state->ApplyAction(cell);
+    }
+  }
+  return state;
+}
+
 PhantomTTTGame::PhantomTTTGame(const GameParameters& params)
     : Game(kGameType, params),
       game_(std::static_pointer_cast<const tic_tac_toe::TicTacToeGame>(
@@ -25,6 +25,11 @@ void BasicPhantomTTTTests() {
   testing::LoadGameTest("phantom_ttt");
   testing::NoChanceOutcomesTest(*LoadGame("phantom_ttt"));
   testing::RandomSimTest(*LoadGame("phantom_ttt"), 100);
+  testing::ResampleInfostateTest(*LoadGame("phantom_ttt"), /*num_sims=*/100);
+  testing::ResampleInfostateTest(
+      *LoadGame("phantom_ttt",
+                {{"obstype", GameParameter(std::string("reveal-numturns"))}}),
+      /*num_sims=*/100);
 }
 
 }  // namespace
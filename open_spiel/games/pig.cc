@@ -16,6 +16,7 @@
 
 #include <sys/types.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "open_spiel/game_parameters.h"
@@ -66,6 +67,19 @@ static std::shared_ptr<const Game> Factory(const GameParameters& params) {
 }
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
+
+// The outcomes of a roll of the die.
+std::vector<std::pair<Action, double>> RollOutcomes(int dice_outcomes) {
+  std::vector<std::pair<Action, double>> outcomes;
+
+  // All the chance outcomes come after roll and stop.
+  outcomes.reserve(dice_outcomes);
+  for (int i = 0; i < dice_outcomes; i++) {
+    outcomes.push_back(std::make_pair(i + 1, 1.0 / dice_outcomes));
+  }
+
+  return outcomes;
+}
 }  // namespace
 
 std::string PigState::ActionToString(Player player, Action move_id) const {
@@ -92,22 +106,25 @@ bool PigState::IsTerminal() const {
 }
 
 std::vector<double> PigState::Returns() const {
-  if (!IsTerminal()) {
-    return std::vector<double>(num_players_, 0.0);
-  }
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
 
-  // For (n>2)-player games, must keep it zero-sum.
-  std::vector<double> returns(num_players_, -1.0 / (num_players_ - 1));
+void PigState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  std::fill(returns.begin(), returns.end(), 0.0);
+  if (!IsTerminal()) return;
 
   for (auto player = Player{0}; player < num_players_; ++player) {
     if (scores_[player] >= win_score_) {
+      // For (n>2)-player games, must keep it zero-sum.
+      std::fill(returns.begin(), returns.end(), -1.0 / (num_players_ - 1));
       returns[player] = 1.0;
-      return returns;
+      return;
     }
   }
-
   // Nobody has won? (e.g. over horizon length.) Then everyone gets 0.
-  return std::vector<double>(num_players_, 0.0);
 }
 
 std::string PigState::ObservationString(Player player) const {
@@ -232,15 +249,13 @@ std::vector<Action> PigState::LegalActions() const {
 
 std::vector<std::pair<Action, double>> PigState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
-  std::vector<std::pair<Action, double>> outcomes;
-
-  // All the chance outcomes come after roll and stop.
-  outcomes.reserve(dice_outcomes_);
-  for (int i = 0; i < dice_outcomes_; i++) {
-    outcomes.push_back(std::make_pair(i + 1, 1.0 / dice_outcomes_));
-  }
+  return RollOutcomes(dice_outcomes_);
+}
 
-  return outcomes;
+std::pair<Action, double> PigState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  return static_cast<const PigGame&>(*game_).roll_distribution().Sample(rng);
 }
 
 std::string PigState::ToString() const {
@@ -259,7 +274,8 @@ PigGame::PigGame(const GameParameters& params)
       dice_outcomes_(ParameterValue<int>("diceoutcomes")),
       horizon_(ParameterValue<int>("horizon")),
       num_players_(ParameterValue<int>("players")),
-      win_score_(ParameterValue<int>("winscore")) {}
+      win_score_(ParameterValue<int>("winscore")),
+      roll_distribution_(RollOutcomes(dice_outcomes_)) {}
 
 }  // namespace pig
 }  // namespace open_spiel
@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/spiel.h"
 
 // A simple jeopardy dice game that includes chance nodes.
@@ -45,9 +47,12 @@ class PigState : public State {
   Player CurrentPlayer() const override;
   std::string ActionToString(Player player, Action move_id) const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
@@ -99,6 +104,11 @@ class PigGame : public Game {
   }
   std::vector<int> ObservationTensorShape() const override;
 
+  // The distribution of every roll, shared by the states.
+  const ChanceDistribution& roll_distribution() const {
+    return roll_distribution_;
+  }
+
  private:
   // Number of different dice outcomes, i.e. 6.
   int dice_outcomes_;
@@ -111,6 +121,8 @@ class PigGame : public Game {
 
   // The amount needed to win.
   int win_score_;
+
+  ChanceDistribution roll_distribution_;
 };
 
 }  // namespace pig
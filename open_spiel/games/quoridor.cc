@@ -15,10 +15,7 @@
 #include "open_spiel/games/quoridor.h"
 
 #include <algorithm>
-#include <functional>
 #include <memory>
-#include <queue>
-#include <utility>
 #include <vector>
 
 #include "open_spiel/game_parameters.h"
@@ -58,71 +55,47 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
-}  // namespace
-
-class QuoridorState::SearchState {
-  using DistanceAndMove = std::pair<int, Move>;
-
-  class SearchQueue
-      : public std::priority_queue<DistanceAndMove,
-                                   std::vector<DistanceAndMove>,
-                                   std::greater<DistanceAndMove>> {
-   public:
-    void clear() { c.clear(); }
-    void reserve(int capacity) { c.reserve(capacity); }
-  };
-
- public:
-  explicit SearchState(int board_diameter) {
-    int size = board_diameter * board_diameter;
-    mark_.resize(size, false);
-    on_shortest_path_.resize(size, false);
-    distance_.resize(size, UndefinedDistance());
-    queue_.reserve(size);
-  }
-
-  bool IsEmpty() const { return queue_.empty(); }
-
-  void ClearSearchQueue() { queue_.clear(); }
+bool HasCell(const CellSet& cells, int cell) {
+  return (cells[cell / 64] >> (cell % 64)) & 1;
+}
 
-  bool Push(int dist, Move move) {
-    if (mark_[move.xy] == false) {
-      mark_[move.xy] = true;
-      queue_.emplace(dist, move);
-      return true;
-    } else {
-      return false;
-    }
-  }
+void AddCell(int cell, CellSet* cells) {
+  (*cells)[cell / 64] |= uint64_t{1} << (cell % 64);
+}
 
-  Move Pop() {
-    Move move = queue_.top().second;
-    queue_.pop();
-    return move;
-  }
+void RemoveCell(int cell, CellSet* cells) {
+  (*cells)[cell / 64] &= ~(uint64_t{1} << (cell % 64));
+}
 
-  void ResetSearchQueue() {
-    std::fill(mark_.begin(), mark_.end(), false);
-    queue_.clear();
+bool Intersects(const CellSet& a, const CellSet& b, int num_words) {
+  for (int i = 0; i < num_words; ++i) {
+    if (a[i] & b[i]) return true;
   }
+  return false;
+}
 
-  void ResetDists() {
-    std::fill(distance_.begin(), distance_.end(), UndefinedDistance());
+// Sets next to the cells in reach and those one step away from them through
+// the open passages, on a board of the given width. Returns whether any cell
+// was added.
+bool Expand(const CellSet& reach, const CellSet& x_open, const CellSet& y_open,
+            int width, int num_words, CellSet* next) {
+  bool grew = false;
+  for (int i = 0; i < num_words; ++i) {
+    const uint64_t prev_x = i > 0 ? reach[i - 1] & x_open[i - 1] : 0;
+    const uint64_t prev_y = i > 0 ? reach[i - 1] & y_open[i - 1] : 0;
+    const uint64_t following = i + 1 < num_words ? reach[i + 1] : 0;
+    (*next)[i] = reach[i] | ((reach[i] & x_open[i]) << 1) | (prev_x >> 63) |
+                 ((reach[i] & y_open[i]) << width) |
+                 (prev_y >> (64 - width)) |
+                 (((reach[i] >> 1) | (following << 63)) & x_open[i]) |
+                 (((reach[i] >> width) | (following << (64 - width))) &
+                  y_open[i]);
+    grew |= (*next)[i] != reach[i];
   }
+  return grew;
+}
 
-  void SetDist(Move move, int dist) { distance_[move.xy] = dist; }
-  int GetDist(Move move) const { return distance_[move.xy]; }
-  void SetOnShortestPath(Move move) { on_shortest_path_[move.xy] = true; }
-  bool IsOnShortestPath(Move move) const { return on_shortest_path_[move.xy]; }
-
-  static constexpr int UndefinedDistance() { return -1; }
-
- private:
-  SearchQueue queue_;
-  std::vector<bool> mark_;     // Whether this position has been pushed before.
-  std::vector<int> distance_;  // Distance from player.
-  std::vector<bool> on_shortest_path_;  // Is this position on a shortest path?
-};
+}  // namespace
 
 std::string Move::ToString() const {
   std::string out = absl::StrCat(
@@ -142,7 +115,10 @@ QuoridorState::QuoridorState(std::shared_ptr<const Game> game, int board_size,
     : State(game),
       board_size_(board_size),
       board_diameter_(board_size * 2 - 1),
-      ansi_color_output_(ansi_color_output) {
+      ansi_color_output_(ansi_color_output),
+      num_cell_words_((board_size * board_size + 63) / 64) {
+  SPIEL_CHECK_GE(board_size, kMinBoardSize);
+  SPIEL_CHECK_LE(board_size, kMaxBoardSize);
   board_.resize(board_diameter_ * board_diameter_, kPlayerNone);
   wall_count_[kPlayer1] = wall_count;
   wall_count_[kPlayer2] = wall_count;
@@ -153,6 +129,23 @@ QuoridorState::QuoridorState(std::shared_ptr<const Game> game, int board_size,
   SetPlayer(player_loc_[kPlayer2], kPlayer2, kPlayerNone);
   end_zone_[kPlayer1] = player_loc_[kPlayer2].y;
   end_zone_[kPlayer2] = player_loc_[kPlayer1].y;
+
+  for (int y = 0; y < board_size; ++y) {
+    for (int x = 0; x < board_size; ++x) {
+      const int cell = x + y * board_size;
+      if (x + 1 < board_size) AddCell(cell, &x_open_);
+      if (y + 1 < board_size) AddCell(cell, &y_open_);
+    }
+  }
+  for (int p = 0; p < kNumPlayers; ++p) {
+    for (int x = 0; x < board_size; ++x) {
+      AddCell(CellIndex(GetMove(2 * x, end_zone_[p])), &end_zone_cells_[p]);
+    }
+  }
+  if (wall_count > 0) {
+    UpdateShortestPath(kPlayer1);
+    UpdateShortestPath(kPlayer2);
+  }
 }
 
 Move QuoridorState::ActionToMove(Action action_id) const {
@@ -177,17 +170,14 @@ std::vector<Action> QuoridorState::LegalActions() const {
 
   // Wall placements.
   if (wall_count_[current_player_] > 0) {
-    SearchState search_state(board_diameter_);
-    SearchShortestPath(kPlayer1, &search_state);
-    SearchShortestPath(kPlayer2, &search_state);
     for (int y = 0; y < board_diameter_ - 2; y += 2) {
       for (int x = 0; x < board_diameter_ - 2; x += 2) {
         Move h = GetMove(x, y + 1);
-        if (IsValidWall(h, &search_state)) {
+        if (IsValidWall(h)) {
           moves.push_back(h.xy);
         }
         Move v = GetMove(x + 1, y);
-        if (IsValidWall(v, &search_state)) {
+        if (IsValidWall(v)) {
           moves.push_back(v.xy);
         }
       }
@@ -233,7 +223,7 @@ void QuoridorState::AddActions(Move cur, Offset offset,
   }
 }
 
-bool QuoridorState::IsValidWall(Move m, SearchState* search_state) const {
+bool QuoridorState::IsValidWall(Move m) const {
   Offset offset = (m.IsHorizontalWall() ? Offset(1, 0) : Offset(0, 1));
 
   if (IsWall(m + offset * 0) || IsWall(m + offset * 1) ||
@@ -245,10 +235,14 @@ bool QuoridorState::IsValidWall(Move m, SearchState* search_state) const {
   // Any wall that doesn't intersect with a shortest path is clearly legal.
   // Walls that do intersect might still be legal because there's another way
   // around, but that's more expensive to check.
-  if (!search_state->IsOnShortestPath(m) &&
-      !search_state->IsOnShortestPath(m + offset * 2)) {
-    return true;
+  const int cell1 = CellIndex(m);
+  const int cell2 = CellIndex(m + offset * 2);
+  bool cuts_path[kNumPlayers];
+  for (int p = 0; p < kNumPlayers; ++p) {
+    const CellSet& path = m.IsHorizontalWall() ? path_y_[p] : path_x_[p];
+    cuts_path[p] = HasCell(path, cell1) || HasCell(path, cell2);
   }
+  if (!cuts_path[kPlayer1] && !cuts_path[kPlayer2]) return true;
 
   // If this wall doesn't connect two existing walls/edges, then it can't cut
   // any paths. Even connecting to a node where 3 other walls meet, but without
@@ -266,90 +260,102 @@ bool QuoridorState::IsValidWall(Move m, SearchState* search_state) const {
        IsWall(m + offset + offset.rotate_right())));
   if (count <= 1) return true;
 
-  // Do a full search to verify both players can get to their respective goals.
-  return (SearchEndZone(kPlayer1, m, m + offset * 2, search_state) &&
-          SearchEndZone(kPlayer2, m, m + offset * 2, search_state));
+  // Do a full search to verify that the players whose path is cut can still
+  // get to their respective goals.
+  CellSet x_open = x_open_;
+  CellSet y_open = y_open_;
+  CellSet* open = m.IsHorizontalWall() ? &y_open : &x_open;
+  RemoveCell(cell1, open);
+  RemoveCell(cell2, open);
+  for (int p = 0; p < kNumPlayers; ++p) {
+    if (cuts_path[p] &&
+        !CanReachEndZone(static_cast<QuoridorPlayer>(p), x_open, y_open)) {
+      return false;
+    }
+  }
+  return true;
 }
 
-bool QuoridorState::SearchEndZone(QuoridorPlayer p, Move wall1, Move wall2,
-                                  SearchState* search_state) const {
-  search_state->ResetSearchQueue();
-  Offset dir(1, 0);  // Direction is arbitrary. Queue will make it fast.
-  int goal = end_zone_[p];
-  int goal_dir = (goal == 0 ? -1 : 1);  // Sort for shortest dist in a min-heap.
-  search_state->Push(0, player_loc_[p]);
-  while (!search_state->IsEmpty()) {
-    Move c = search_state->Pop();
-    for (int i = 0; i < 4; ++i) {
-      Move wall = c + dir;
-      if (!IsWall(wall) && wall != wall1 && wall != wall2) {
-        Move move = c + dir * 2;
-        if (move.y == goal) {
-          return true;
-        }
-        search_state->Push(goal_dir * (goal - move.y), move);
-      }
-      dir = dir.rotate_left();
+bool QuoridorState::CanReachEndZone(QuoridorPlayer p, const CellSet& x_open,
+                                    const CellSet& y_open) const {
+  // Flood fills the board from the player, a step in every direction at a
+  // time.
+  CellSet reach{};
+  CellSet next{};
+  AddCell(CellIndex(player_loc_[p]), &reach);
+  while (!Intersects(reach, end_zone_cells_[p], num_cell_words_)) {
+    if (!Expand(reach, x_open, y_open, board_size_, num_cell_words_, &next)) {
+      return false;
     }
+    reach = next;
   }
-
-  return false;
+  return true;
 }
 
-void QuoridorState::SearchShortestPath(QuoridorPlayer p,
-                                       SearchState* search_state) const {
-  search_state->ResetSearchQueue();
-  search_state->ResetDists();
-  Offset dir(1, 0);  // Direction is arbitrary. Queue will make it fast.
-  int goal = end_zone_[p];
-  int goal_dir = (goal == 0 ? -1 : 1);  // Sort for shortest dist in a min-heap.
-  search_state->Push(0, player_loc_[p]);
-  search_state->SetDist(player_loc_[p], 0);
-  Move goal_found = GetMove(-1, -1);  // invalid
-
-  // A* search for the end-zone, keeping distances to each cell.
-  while (!search_state->IsEmpty()) {
-    Move c = search_state->Pop();
-    int dist = search_state->GetDist(c);
-    for (int i = 0; i < 4; ++i) {
-      Move wall = c + dir;
-      if (!IsWall(wall)) {
-        Move move = c + dir * 2;
-        if (move.y == goal) {
-          search_state->SetDist(move, dist + 1);
-          search_state->ClearSearchQueue();  // Break out of the search.
-          goal_found = move;
-          break;
-        }
-        if (search_state->Push(dist + 1 + goal_dir * (goal - move.y), move)) {
-          search_state->SetDist(move, dist + 1);
-        }
-      }
-      dir = dir.rotate_left();
-    }
+void QuoridorState::UpdateShortestPath(QuoridorPlayer p) {
+  // Breadth-first search by flood filling, keeping the cells reached after
+  // each step.
+  std::vector<CellSet> reached(1);
+  AddCell(CellIndex(player_loc_[p]), &reached[0]);
+  while (!Intersects(reached.back(), end_zone_cells_[p], num_cell_words_)) {
+    CellSet next{};
+    SPIEL_CHECK_TRUE(Expand(reached.back(), x_open_, y_open_, board_size_,
+                            num_cell_words_, &next));
+    reached.push_back(next);
   }
 
-  // Trace the way back, setting them to be on a shortest path.
-  Move current = goal_found;
-  int dist = search_state->GetDist(current);
-  while (current != player_loc_[p]) {
-    for (int i = 0; i < 4; ++i) {
-      Move wall = current + dir;
-      if (!IsWall(wall)) {
-        Move move = current + dir * 2;
-        int dist2 = search_state->GetDist(move);
-        if (dist2 != search_state->UndefinedDistance() && dist2 + 1 == dist) {
-          search_state->SetOnShortestPath(wall);
-          current = move;
-          dist = dist2;
-          break;
-        }
-      }
-      dir = dir.rotate_left();
+  // Trace the way back from a cell of the end zone, through cells each a step
+  // closer to the player.
+  path_x_[p] = CellSet{};
+  path_y_[p] = CellSet{};
+  int cell = 0;
+  while (!(HasCell(reached.back(), cell) &&
+           HasCell(end_zone_cells_[p], cell))) {
+    ++cell;
+  }
+  for (int step = reached.size() - 2; step >= 0; --step) {
+    const CellSet& closer = reached[step];
+    const int x = cell % board_size_;
+    if (x + 1 < board_size_ && HasCell(x_open_, cell) &&
+        HasCell(closer, cell + 1)) {
+      AddCell(cell, &path_x_[p]);
+      cell = cell + 1;
+    } else if (x > 0 && HasCell(x_open_, cell - 1) &&
+               HasCell(closer, cell - 1)) {
+      cell = cell - 1;
+      AddCell(cell, &path_x_[p]);
+    } else if (HasCell(y_open_, cell) && HasCell(closer, cell + board_size_)) {
+      AddCell(cell, &path_y_[p]);
+      cell = cell + board_size_;
+    } else {
+      cell = cell - board_size_;
+      SPIEL_CHECK_TRUE(HasCell(y_open_, cell) && HasCell(closer, cell));
+      AddCell(cell, &path_y_[p]);
     }
   }
 }
 
+void QuoridorState::UpdateShortestPathAfterMove(QuoridorPlayer p, Move from,
+                                                Move to) {
+  // A shortest path only passes by the player's cell at its start, so if the
+  // player took a step along it, the rest is a shortest path from there.
+  const int from_cell = CellIndex(from);
+  const int to_cell = CellIndex(to);
+  if (to_cell == from_cell + 1 && HasCell(path_x_[p], from_cell)) {
+    RemoveCell(from_cell, &path_x_[p]);
+  } else if (to_cell == from_cell - 1 && HasCell(path_x_[p], to_cell)) {
+    RemoveCell(to_cell, &path_x_[p]);
+  } else if (to_cell == from_cell + board_size_ &&
+             HasCell(path_y_[p], from_cell)) {
+    RemoveCell(from_cell, &path_y_[p]);
+  } else if (to_cell == from_cell - board_size_ &&
+             HasCell(path_y_[p], to_cell)) {
+    RemoveCell(to_cell, &path_y_[p]);
+  } else {
+    UpdateShortestPath(p);
+  }
+}
+
 std::string QuoridorState::ActionToString(Player player,
                                           Action action_id) const {
   return ActionToMove(action_id).ToString();
@@ -433,6 +439,18 @@ std::string QuoridorState::ObservationString(Player player) const {
   return ToString();
 }
 
+template <class T>
+void QuoridorState::WriteObservationTensor(Player player,
+                                           TensorView<2, T>& view) const {
+  for (int i = 0; i < board_.size(); ++i) {
+    if (board_[i] < kCellStates) {
+      view[{static_cast<int>(board_[i]), i}] = 1.0;
+    }
+    view[{kCellStates + kPlayer1, i}] = wall_count_[kPlayer1];
+    view[{kCellStates + kPlayer2, i}] = wall_count_[kPlayer2];
+  }
+}
+
 void QuoridorState::ObservationTensor(Player player,
                                       std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
@@ -441,14 +459,18 @@ void QuoridorState::ObservationTensor(Player player,
   TensorView<2> view(
       values, {kCellStates + kNumPlayers, static_cast<int>(board_.size())},
       true);
+  WriteObservationTensor(player, view);
+}
 
-  for (int i = 0; i < board_.size(); ++i) {
-    if (board_[i] < kCellStates) {
-      view[{static_cast<int>(board_[i]), i}] = 1.0;
-    }
-    view[{kCellStates + kPlayer1, i}] = wall_count_[kPlayer1];
-    view[{kCellStates + kPlayer2, i}] = wall_count_[kPlayer2];
-  }
+void QuoridorState::ObservationTensor(Player player,
+                                      absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(
+      values, {kCellStates + kNumPlayers, static_cast<int>(board_.size())},
+      true);
+  WriteObservationTensor(player, view);
 }
 
 void QuoridorState::DoApplyAction(Action action) {
@@ -464,10 +486,29 @@ void QuoridorState::DoApplyAction(Action action) {
     SetPlayer(move + offset * 1, kPlayerWall, kPlayerNone);
     SetPlayer(move + offset * 2, kPlayerWall, kPlayerNone);
     wall_count_[current_player_] -= 1;
+
+    const int cell1 = CellIndex(move);
+    const int cell2 = CellIndex(move + offset * 2);
+    CellSet* open = move.IsHorizontalWall() ? &y_open_ : &x_open_;
+    RemoveCell(cell1, open);
+    RemoveCell(cell2, open);
+    if (wall_count_[kPlayer1] > 0 || wall_count_[kPlayer2] > 0) {
+      for (int p = 0; p < kNumPlayers; ++p) {
+        const CellSet& path =
+            move.IsHorizontalWall() ? path_y_[p] : path_x_[p];
+        if (HasCell(path, cell1) || HasCell(path, cell2)) {
+          UpdateShortestPath(static_cast<QuoridorPlayer>(p));
+        }
+      }
+    }
   } else {
-    SetPlayer(player_loc_[current_player_], kPlayerNone, current_player_);
+    const Move from = player_loc_[current_player_];
+    SetPlayer(from, kPlayerNone, current_player_);
     SetPlayer(move, current_player_, kPlayerNone);
     player_loc_[current_player_] = move;
+    if (wall_count_[kPlayer1] > 0 || wall_count_[kPlayer2] > 0) {
+      UpdateShortestPathAfterMove(current_player_, from, move);
+    }
 
     if (move.y == end_zone_[current_player_]) {
       outcome_ = current_player_;
@@ -486,6 +527,33 @@ std::unique_ptr<State> QuoridorState::Clone() const {
   return std::unique_ptr<State>(new QuoridorState(*this));
 }
 
+bool QuoridorState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const QuoridorState&>(other);
+  State::operator=(state);
+  board_ = state.board_;
+  std::copy(std::begin(state.wall_count_), std::end(state.wall_count_),
+            std::begin(wall_count_));
+  std::copy(std::begin(state.end_zone_), std::end(state.end_zone_),
+            std::begin(end_zone_));
+  std::copy(std::begin(state.player_loc_), std::end(state.player_loc_),
+            std::begin(player_loc_));
+  current_player_ = state.current_player_;
+  outcome_ = state.outcome_;
+  moves_made_ = state.moves_made_;
+  x_open_ = state.x_open_;
+  y_open_ = state.y_open_;
+  std::copy(std::begin(state.end_zone_cells_), std::end(state.end_zone_cells_),
+            std::begin(end_zone_cells_));
+  std::copy(std::begin(state.path_x_), std::end(state.path_x_),
+            std::begin(path_x_));
+  std::copy(std::begin(state.path_y_), std::end(state.path_y_),
+            std::begin(path_y_));
+  return true;
+}
+
 QuoridorGame::QuoridorGame(const GameParameters& params)
     : Game(kGameType, params),
       board_size_(ParameterValue<int>("board_size")),
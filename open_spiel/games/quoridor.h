@@ -15,12 +15,15 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_QUORIDOR_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_QUORIDOR_H_
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // https://en.wikipedia.org/wiki/Quoridor
 //
@@ -38,6 +41,12 @@ inline constexpr int kMinBoardSize = 3;
 inline constexpr int kMaxBoardSize = 25;
 inline constexpr int kMaxGameLengthFactor = 4;
 inline constexpr int kCellStates = 1 + kNumPlayers;
+inline constexpr int kMaxCellWords =
+    (kMaxBoardSize * kMaxBoardSize + 63) / 64;
+
+// A set of the cells a pawn can stand on, one bit per cell, numbered
+// x + y * board_size in cell coordinates (i.e. half the Move coordinates).
+using CellSet = std::array<uint64_t, kMaxCellWords>;
 
 enum QuoridorPlayer : uint8_t {
   kPlayer1,
@@ -102,7 +111,10 @@ class QuoridorState : public State {
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
   std::vector<Action> LegalActions() const override;
 
  protected:
@@ -124,18 +136,25 @@ class QuoridorState : public State {
     board_[m.xy] = p;
   }
 
- private:
-  // SearchState contains details that are only used in the .cc file.
-  // A different technique in the same area is called pimpl (pointer to
-  // implementation).
-  class SearchState;
+  // The cell of a pawn position, or the lower cell of the passage that a
+  // wall segment between two cells blocks.
+  int CellIndex(Move m) const { return m.x / 2 + (m.y / 2) * board_size_; }
 
+ private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
   // Helpers for `LegaLActions`.
   void AddActions(Move cur, Offset offset, std::vector<Action>* moves) const;
-  bool IsValidWall(Move m, SearchState*) const;
-  bool SearchEndZone(QuoridorPlayer p, Move wall1, Move wall2,
-                     SearchState*) const;
-  void SearchShortestPath(QuoridorPlayer p, SearchState* search_state) const;
+  bool IsValidWall(Move m) const;
+  bool CanReachEndZone(QuoridorPlayer p, const CellSet& x_open,
+                       const CellSet& y_open) const;
+
+  // Recomputes a shortest path of the player to its end zone.
+  void UpdateShortestPath(QuoridorPlayer p);
+  // Keeps the shortest path of the player up to date after a pawn move.
+  void UpdateShortestPathAfterMove(QuoridorPlayer p, Move from, Move to);
 
   std::vector<QuoridorPlayer> board_;
   int wall_count_[kNumPlayers];
@@ -147,6 +166,19 @@ class QuoridorState : public State {
   const int board_size_;
   const int board_diameter_;
   const bool ansi_color_output_;
+  const int num_cell_words_;
+
+  // The passages between neighbouring cells that no wall blocks: bit c of
+  // x_open_ is set if a pawn can move between cells c and c + 1, and of
+  // y_open_ between cells c and c + board_size_.
+  CellSet x_open_{};
+  CellSet y_open_{};
+  CellSet end_zone_cells_[kNumPlayers] = {};
+  // The passages of a shortest path of each player to its end zone, kept up
+  // to date while walls can be placed. A wall blocking none of them cannot
+  // cut the player off from its end zone.
+  CellSet path_x_[kNumPlayers] = {};
+  CellSet path_y_[kNumPlayers] = {};
 };
 
 // Game object.
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <iostream>
 
 #include "open_spiel/spiel.h"
@@ -45,8 +46,32 @@ void BasicQuoridorTests() {
       *LoadGame("quoridor(board_size=5,ansi_color_output=True)"), 3);
 }
 
+bool IsLegal(const State& state, const std::string& action) {
+  for (Action legal_action : state.LegalActions()) {
+    if (state.ActionToString(state.CurrentPlayer(), legal_action) == action) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WallsCannotEnclosePlayerTest() {
+  std::shared_ptr<const Game> game = LoadGame("quoridor(board_size=3)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_TRUE(IsLegal(*state, "b1v"));
+  state->ApplyAction(state->StringToAction("a1h"));
+  // The second player, on b1, would be shut in the first row with a1.
+  SPIEL_CHECK_FALSE(IsLegal(*state, "b1v"));
+  // The first player, on b3, can only go around the wall by c2 and c1.
+  SPIEL_CHECK_FALSE(IsLegal(*state, "b2v"));
+  SPIEL_CHECK_TRUE(IsLegal(*state, "b2h"));
+}
+
 }  // namespace
 }  // namespace quoridor
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::quoridor::BasicQuoridorTests(); }
+int main(int argc, char** argv) {
+  open_spiel::quoridor::BasicQuoridorTests();
+  open_spiel::quoridor::WallsCannotEnclosePlayerTest();
+}
@@ -14,11 +14,18 @@
 
 #include "open_spiel/games/skat.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+
+#include "open_spiel/abseil-cpp/absl/container/inlined_vector.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/card_deal.h"
 
 
 namespace open_spiel {
@@ -178,6 +185,19 @@ std::string SkatGameTypeToString(SkatGameType trump_game) {
   }
 }
 
+// The cards of a suit, and the jacks.
+constexpr uint32_t SuitMask(Suit suit) {
+  return ((uint32_t{1} << kNumRanks) - 1)
+         << (static_cast<int>(suit) * kNumRanks);
+}
+constexpr uint32_t kJacksMask = 0x80808080;
+
+// Calls `f` on each card of `cards` in increasing order.
+template <typename F>
+void ForEachCard(uint32_t cards, F f) {
+  for (; cards != 0; cards &= cards - 1) f(__builtin_ctz(cards));
+}
+
 CardLocation PlayerToLocation(int player) {
   switch (player) {
     case 0:
@@ -194,7 +214,7 @@ CardLocation PlayerToLocation(int player) {
 // *********************************** Trick ***********************************
 
 int Trick::FirstCard() const {
-  if (cards_.empty()) {
+  if (num_cards_ == 0) {
     return -1;
   } else {
     return cards_[0];
@@ -202,8 +222,8 @@ int Trick::FirstCard() const {
 }
 
 void Trick::PlayCard(int card) {
-  SPIEL_CHECK_LE(cards_.size(), kNumPlayers);
-  cards_.push_back(card);
+  SPIEL_CHECK_LT(num_cards_, kNumPlayers);
+  cards_[num_cards_++] = card;
 }
 
 int Trick::PlayerAtPosition(int position) const {
@@ -214,7 +234,7 @@ int Trick::PlayerAtPosition(int position) const {
 
 int Trick::Points() const {
   int sum = 0;
-  for (auto& card : cards_) {
+  for (int card : GetCards()) {
     sum += CardValue(card);
   }
   return sum;
@@ -222,7 +242,7 @@ int Trick::Points() const {
 
 std::string Trick::ToString() const {
   std::string result = absl::StrFormat("Leader: %d, ", leader_);
-  for (auto& card : cards_) {
+  for (int card : GetCards()) {
     if (card >= 0 < kNumCards)
       absl::StrAppendFormat(&result, "%s ", ToCardSymbol(card));
     else
@@ -338,7 +358,7 @@ int SkatState::NullOrder(Rank rank) const {
 }
 
 int SkatState::WinsTrick() const {
-  std::vector<int> cards = PreviousTrick().GetCards();
+  absl::Span<const int> cards = PreviousTrick().GetCards();
   if (cards.empty()) return -1;
   int winning_position = 0;
   for (int i = 1; i < cards.size(); i++) {
@@ -365,30 +385,35 @@ void SkatState::DoApplyAction(Action action) {
   }
 }
 
-void SkatState::ApplyDealAction(int card) {
-  SPIEL_CHECK_EQ(card_locations_[card], kDeck);
-  int deal_round = history_.size();
-  // Cards 0-2, 11-14, 23-25 to player 1.
-  // Cards 3-5, 15-18, 26-28 to player 2.
-  // Cards 6-8, 19-22, 29-31 to player 3.
-  // Cards 9-10 into the Skat.
-  // While this might seem a bit weird, this is the official order Skat cards
-  // are dealt.
+// Where the card of each round of the deal goes:
+// Cards 0-2, 11-14, 23-25 to player 1.
+// Cards 3-5, 15-18, 26-28 to player 2.
+// Cards 6-8, 19-22, 29-31 to player 3.
+// Cards 9-10 into the Skat.
+// While this might seem a bit weird, this is the official order Skat cards
+// are dealt.
+CardLocation DealLocation(int deal_round) {
   if ((deal_round >= 0 && deal_round <= 2) ||
       (deal_round >= 11 && deal_round <= 14) ||
       (deal_round >= 23 && deal_round <= 25)) {
-    card_locations_[card] = kHand0;
+    return kHand0;
   } else if ((deal_round >= 3 && deal_round <= 5) ||
       (deal_round >= 15 && deal_round <= 18) ||
       (deal_round >= 26 && deal_round <= 28)) {
-    card_locations_[card] = kHand1;
+    return kHand1;
   } else if ((deal_round >= 6 && deal_round <= 8) ||
       (deal_round >= 19 && deal_round <= 22) ||
       (deal_round >= 29 && deal_round <= 31)) {
-    card_locations_[card] = kHand2;
-  } else if (deal_round == 9 || deal_round == 10) {
-    card_locations_[card] = kSkat;
+    return kHand2;
+  } else {
+    return kSkat;
   }
+}
+
+void SkatState::ApplyDealAction(int card) {
+  SPIEL_CHECK_EQ(card_locations_[card], kDeck);
+  int deal_round = history_.size();
+  MoveCard(card, DealLocation(deal_round));
   if (deal_round == kNumCards - 1) {
     current_player_ = 0;
     phase_ = kBidding;
@@ -416,9 +441,9 @@ void SkatState::EndBidding(Player winner, SkatGameType game_type) {
     current_player_ = winner;
     game_type_ = game_type;
     // Winner takes up Skat cards.
-    for (int card = 0; card <= kNumCards; card++) {
+    for (int card = 0; card < kNumCards; card++) {
       if (card_locations_[card] == kSkat) {
-        card_locations_[card] = PlayerToLocation(winner);
+        MoveCard(card, PlayerToLocation(winner));
       }
     }
     phase_ = kDiscardCards;
@@ -426,7 +451,7 @@ void SkatState::EndBidding(Player winner, SkatGameType game_type) {
 
 int SkatState::CardsInSkat() const {
   int cards_in_skat = 0;
-  for (int card = 0; card <= kNumCards; card++) {
+  for (int card = 0; card < kNumCards; card++) {
     if (card_locations_[card] == kSkat) cards_in_skat++;
   }
   return cards_in_skat;
@@ -436,7 +461,7 @@ void SkatState::ApplyDiscardCardsAction(int card) {
   SPIEL_CHECK_LT(CardsInSkat(), 2);
   SPIEL_CHECK_TRUE(current_player_ == solo_player_);
   SPIEL_CHECK_TRUE(card_locations_[card] == PlayerToLocation(solo_player_));
-  card_locations_[card] = kSkat;
+  MoveCard(card, kSkat);
 
   if (CardsInSkat() == 2) {
     phase_ = kPlay;
@@ -446,7 +471,7 @@ void SkatState::ApplyDiscardCardsAction(int card) {
 
 void SkatState::ApplyPlayAction(int card) {
   SPIEL_CHECK_TRUE(card_locations_[card] == PlayerToLocation(current_player_));
-  card_locations_[card] = kTrick;
+  MoveCard(card, kTrick);
   if (num_cards_played_ == 0) {
     CurrentTrick() = Trick(current_player_);
   }
@@ -484,6 +509,17 @@ void SkatState::ApplyPlayAction(int card) {
   }
 }
 
+void SkatState::MoveCard(int card, CardLocation location) {
+  const uint32_t bit = uint32_t{1} << card;
+  if (card_locations_[card] >= kHand0 && card_locations_[card] <= kHand2) {
+    hands_[card_locations_[card] - kHand0] &= ~bit;
+  }
+  if (location >= kHand0 && location <= kHand2) {
+    hands_[location - kHand0] |= bit;
+  }
+  card_locations_[card] = location;
+}
+
 void SkatState::ScoreUp() {
   if (game_type_ == kNullGame) {
     // Since we're using points as a reward we need to come up with some special
@@ -581,53 +617,43 @@ std::vector<Action> SkatState::BiddingLegalActions() const {
 
 std::vector<Action> SkatState::DiscardCardsLegalActions() const {
   std::vector<Action> legal_actions;
-  for (int card = 0; card < kNumCards; ++card) {
-    if (card_locations_[card] == current_player_ + 1) {
-      legal_actions.push_back(card);
-    }
-  }
+  ForEachCard(hands_[current_player_],
+              [&legal_actions](int card) { legal_actions.push_back(card); });
   return legal_actions;
 }
 
-std::vector<Action> SkatState::PlayLegalActions() const {
-  std::vector<Action> legal_actions;
-  legal_actions.reserve(kNumTricks - num_cards_played_ / kNumPlayers);
-  if (num_cards_played_ % kNumPlayers != 0) {
-    // Check if we can follow suit.
-    int first_card = CurrentTrick().FirstCard();
-    int suit = CardSuit(first_card);
-    if (game_type_ == kNullGame) {
-      for (int rank = 0; rank < kNumRanks; ++rank) {
-        int card = rank * kNumSuits + static_cast<int>(suit);
-        if (card_locations_[card] == PlayerToLocation(current_player_)) {
-          legal_actions.push_back(card);
-        }
-      }
-    } else {
-      // This is a bid fidely but it makes sure the legal actions are sorted
-      // (which is required), which the special status of jacks makes hard
-      // otherwise.
-      for (int card = 0; card < kNumCards; ++card) {
-        if ((IsTrump(first_card) && CardRank(card) == kJack) ||
-            (suit == CardSuit(card) && CardRank(card) != kJack)) {
-          if (card_locations_[card] == PlayerToLocation(current_player_)) {
-            legal_actions.push_back(card);
-          }
-        }
-      }
-    }
+uint32_t SkatState::FollowingCards(int first_card) const {
+  const Suit suit = CardSuit(first_card);
+  // Jacks are trumps unless Null is played, and then belong to no suit.
+  if (game_type_ == kNullGame) return SuitMask(suit);
+  if (!IsTrump(first_card)) return SuitMask(suit) & ~kJacksMask;
+  switch (game_type_) {
+    case kDiamondsTrump:
+      return kJacksMask | SuitMask(kDiamonds);
+    case kHeartsTrump:
+      return kJacksMask | SuitMask(kHearts);
+    case kSpadesTrump:
+      return kJacksMask | SuitMask(kSpades);
+    case kClubsTrump:
+      return kJacksMask | SuitMask(kClubs);
+    default:
+      return kJacksMask;
   }
+}
 
-  if (!legal_actions.empty()) {
-    return legal_actions;
+std::vector<Action> SkatState::PlayLegalActions() const {
+  uint32_t cards = hands_[current_player_];
+  if (num_cards_played_ % kNumPlayers != 0) {
+    // Follow suit if we can, otherwise we can play any of our cards.
+    const uint32_t following_cards =
+        cards & FollowingCards(CurrentTrick().FirstCard());
+    if (following_cards != 0) cards = following_cards;
   }
 
-  // Otherwise, we can play any of our cards.
-  for (int card = 0; card < kNumCards; ++card) {
-    if (card_locations_[card] == current_player_ + 1) {
-      legal_actions.push_back(card);
-    }
-  }
+  std::vector<Action> legal_actions;
+  legal_actions.reserve(__builtin_popcount(cards));
+  ForEachCard(cards,
+              [&legal_actions](int card) { legal_actions.push_back(card); });
   return legal_actions;
 }
 
@@ -642,6 +668,101 @@ std::vector<std::pair<Action, double>> SkatState::ChanceOutcomes() const {
   return outcomes;
 }
 
+std::unique_ptr<State> SkatState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  SPIEL_CHECK_FALSE(IsTerminal());
+  // The player knows their hand, the cards played, and the Skat once they
+  // have taken it up. The other hands, and otherwise the Skat, are dealt
+  // again, keeping from each player the cards of the suits they did not
+  // follow.
+  std::array<uint32_t, kNumPlayers> played{};
+  std::array<uint64_t, kNumPlayers> excluded{};
+  for (int i = 0; i < num_cards_played_; ++i) {
+    const Trick& trick = tricks_[i / kNumPlayers];
+    const int position = i % kNumPlayers;
+    const int card = trick.GetCards()[position];
+    const Player player = trick.PlayerAtPosition(position);
+    played[player] |= uint32_t{1} << card;
+    const uint32_t following_cards = FollowingCards(trick.FirstCard());
+    if (position > 0 && !(following_cards & (uint32_t{1} << card))) {
+      excluded[player] |= following_cards;
+    }
+  }
+  uint32_t skat = 0;
+  for (int card = 0; card < kNumCards; ++card) {
+    if (card_locations_[card] == kSkat) skat |= uint32_t{1} << card;
+  }
+  const bool skat_hidden = player_id != solo_player_;
+
+  // The hidden hands, then the Skat if hidden.
+  uint64_t hidden_cards = 0;
+  absl::InlinedVector<CardLocation, kNumPlayers> locations;
+  absl::InlinedVector<int, kNumPlayers> sizes;
+  absl::InlinedVector<uint64_t, kNumPlayers> exclusions;
+  for (Player player = 0; player < kNumPlayers; ++player) {
+    if (player == player_id) continue;
+    hidden_cards |= hands_[player];
+    locations.push_back(PlayerToLocation(player));
+    sizes.push_back(__builtin_popcount(hands_[player]));
+    exclusions.push_back(excluded[player]);
+  }
+  if (skat_hidden) {
+    hidden_cards |= skat;
+    locations.push_back(kSkat);
+    sizes.push_back(__builtin_popcount(skat));
+    exclusions.push_back(0);
+  }
+  const absl::InlinedVector<uint64_t, 4> dealt =
+      DealCards(hidden_cards, sizes, exclusions, rng);
+
+  auto state = std::make_unique<SkatState>(*this);
+  // The cards dealt to each location in the new history, where they change,
+  // and the cards discarded if they change.
+  std::array<uint32_t, kTrick> deal{};
+  std::array<bool, kTrick> changed{};
+  uint32_t discarded = 0;
+  for (int i = 0; i < locations.size(); ++i) {
+    ForEachCard(dealt[i], [&state, location = locations[i]](int card) {
+      state->MoveCard(card, location);
+    });
+    if (locations[i] != kSkat) {
+      const Player player = locations[i] - kHand0;
+      deal[locations[i]] = dealt[i] | played[player];
+      changed[locations[i]] = true;
+    } else if (solo_player_ == kChancePlayerId) {
+      deal[kSkat] = dealt[i];
+      changed[kSkat] = true;
+    } else {
+      // The solo player took up the Skat: any two of the cards they had were
+      // the Skat, and they discarded the new one.
+      discarded = dealt[i];
+      uint64_t cards = deal[PlayerToLocation(solo_player_)] | dealt[i];
+      deal[kSkat] = TakeRandomCards(&cards, kNumCardsInSkat, rng);
+      deal[PlayerToLocation(solo_player_)] = cards;
+      changed[kSkat] = true;
+    }
+  }
+  const int num_dealt = std::min<int>(history_.size(), kNumCards);
+  for (int deal_round = 0; deal_round < num_dealt; ++deal_round) {
+    const CardLocation location = DealLocation(deal_round);
+    if (!changed[location]) continue;
+    SPIEL_CHECK_NE(deal[location], 0);
+    state->history_[deal_round] = __builtin_ctz(deal[location]);
+    deal[location] &= deal[location] - 1;
+  }
+  if (discarded != 0) {
+    // The discards are the card actions between the bids and the play.
+    const int play_start = history_.size() - num_cards_played_;
+    for (int i = kNumCards; i < play_start; ++i) {
+      if (history_[i] >= kBiddingActionBase) continue;
+      SPIEL_CHECK_NE(discarded, 0);
+      state->history_[i] = __builtin_ctz(discarded);
+      discarded &= discarded - 1;
+    }
+  }
+  return state;
+}
+
 void SkatState::ObservationTensor(Player player,
                                   std::vector<double>* values) const {
   std::fill(values->begin(), values->end(), 0.0);
@@ -655,8 +776,7 @@ void SkatState::ObservationTensor(Player player,
   if (phase_ >= kBidding && phase_ <= kPlay) ptr[phase_ - kBidding] = 1;
   ptr += 3;
   // Players Cards
-  for (int i = 0; i < kNumCards; ++i)
-    if (card_locations_[i] == PlayerToLocation(player)) ptr[i] = 1;
+  ForEachCard(hands_[player], [&ptr](int card) { ptr[card] = 1; });
   ptr += kNumCards;
   // All player bids.
   for (int i = 0; i < kNumPlayers; i++) {
@@ -15,8 +15,11 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_SKAT_H_
 
+#include <array>
+#include <cstdint>
 #include <string>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 
 // A slightly simplified version of Skat.
@@ -114,11 +117,13 @@ class Trick {
   int FirstCard() const;
   Player Leader() const { return leader_; }
   // How many cards have been played in the trick. Between 0 and 3.
-  int CardsPlayed() const { return cards_.size(); }
-  // Returns a vector of the cards played in this trick. These are ordered by
-  // the order of play, i.e. the first card is not necessarily played by player
-  // 1 but by the player who played first in this trick.
-  std::vector<int> GetCards() const { return cards_; }
+  int CardsPlayed() const { return num_cards_; }
+  // Returns the cards played in this trick. These are ordered by the order of
+  // play, i.e. the first card is not necessarily played by player 1 but by the
+  // player who played first in this trick.
+  absl::Span<const int> GetCards() const {
+    return absl::MakeConstSpan(cards_.data(), num_cards_);
+  }
   // Adds `card` to the trick as played by player with id `player`.
   void PlayCard(int card);
   // Returns the player id of the player who was at position `position` in this
@@ -131,7 +136,8 @@ class Trick {
   std::string ToString() const;
 
  private:
-  std::vector<int> cards_{};
+  std::array<int, kNumPlayers> cards_{};
+  int num_cards_ = 0;
   Player leader_;
   Suit led_suit_;
 };
@@ -154,11 +160,22 @@ class SkatState : public State {
   std::string ToString() const override;
   std::vector<Action> LegalActions() const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
 
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
 
+  // The cards in the hand of a player, with bit `card` set for each card.
+  uint32_t Hand(Player player) const { return hands_[player]; }
+  // The player who won the bidding and plays against the two others, or
+  // kChancePlayerId before then.
+  Player SoloPlayer() const { return solo_player_; }
+  // The cards that may be played to a trick led by `first_card`, i.e. those of
+  // its suit, or the trumps if it is a trump.
+  uint32_t FollowingCards(int first_card) const;
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -171,6 +188,7 @@ class SkatState : public State {
   void ApplyBiddingAction(int game_type);
   void ApplyDiscardCardsAction(int card);
   void ApplyPlayAction(int card);
+  void MoveCard(int card, CardLocation location);
 
   void EndBidding(Player winner, SkatGameType game_type);
   int NextPlayer() { return (current_player_ + 1) % kNumPlayers; }
@@ -195,6 +213,8 @@ class SkatState : public State {
   Phase phase_ = kDeal;
   // CardLocation for each card.
   std::array<CardLocation, kNumCards> card_locations_;
+  // The cards held by each player, kept in sync with card_locations_.
+  std::array<uint32_t, kNumPlayers> hands_{};
   std::array<int, kNumPlayers> player_bids_;
 
   // Play related.
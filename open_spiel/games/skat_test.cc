@@ -26,6 +26,7 @@ namespace testing = open_spiel::testing;
 void BasicSkatTests() {
   testing::LoadGameTest("skat");
   testing::RandomSimTest(*LoadGame("skat"), 10);
+  testing::ResampleInfostateTest(*LoadGame("skat"), /*num_sims=*/10);
 }
 
 }  // namespace
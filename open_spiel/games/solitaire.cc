@@ -1,13 +1,9 @@
 #include "solitaire.h"
 
-#include <deque>
-#include <random>
 #include <algorithm>
-#include <optional>
 #include <utility>
-#include <math.h>
 
-#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -22,41 +18,6 @@
 #define WHITE   "\033[37m"
 
 
-/* OPTIMIZATION NOTES
-
- The biggest issues are FindLocation and LegalChildren. FindLocation is slow because
- it iterates through all cards in the state and checks for equality. It'd probably be faster to maintain
- a map of cards to their current location in the state. Then we would only have to search a portion of the state
- to find the card. Or we could map the card directly to its pile and then use the pile type to get location.
-
- LegalChildren could be faster by simply storing the rank and suit of child cards given the location. This
- should be faster than having to look up the index of rank and suit.
-
-- LegalActions                   42%
-  - CandidateMoves               89%
-    - FindLocation               44%
-      - std::find                 73%
-    - LegalChildren              18%
-    - std::find                   12%
-    - SolitaireState::Sources    10%
-    - SolitaireState::Targets     8%
-
-Most of the time spent is in LegalActions, which is what is broken down above.
-
-- ApplyAction                    27%
-  - DoApplyAction               100%
-    - LegalActions               86%
-
-The problem with this is that it has to repeatedly type cast to int which recomputes the card index from its
-rank and suit. Once a card has been revealed though, its index never changes. Better to store it after its computed
-the first time.
-
-- ObservationTensor              24%
-  - ToCardIndices                86%
-    - Card::operator int         72%
-      - GetIndex                 35%
-*/
-
 /* TODO LIST
 - [√] Hidden cards shouldn't show up as sources or target.
 - [~] Can't move a source that isn't the top card of its pile to the foundation
@@ -104,737 +65,191 @@ namespace open_spiel::solitaire {
         REGISTER_SPIEL_GAME(kGameType, Factory)
     }
 
-    // Flags ===========================================================================================================
-
-    bool LOG_FLAG = false;
-
     // Miscellaneous Functions =========================================================================================
 
-    void log(const std::string & text) {
-        if (LOG_FLAG) {
-            std::cout << CYAN << "LOG : " << text << RESET << std::endl;
-        }
-    }
-
-    std::vector<std::string> GetOppositeSuits(const std::string & suit) {
-        log("Entering GetOppositeSuits()");
-
-        if (suit == "s" or suit == "c") {
-            return {"h", "d"};
-        } else if (suit == "h" or suit == "d") {
-            return {"s", "c"};
-        } else {
-            std::cout << YELLOW << "WARNING: `suit` is not in (s, h, c, d)" << RESET << std::endl;
-        }
-
-    }
-
-    std::string LocationString(Location location) {
-        log("Entering LocationString()");
-
-        switch (location) {
-            case kDeck : {
-                return "kDeck";
-            }
-            case kWaste : {
-                return "kWaste";
-            }
-            case kFoundation : {
-                return "kFoundation";
-            }
-            case kTableau : {
-                return "kTableau";
-            }
-            case kMissing : {
-                return "kMissing";
-            }
-            default : {
-                return "n/a";
-            }
-        }
-    }
-
-    std::vector<double> ToCardIndices(const std::deque<Card> & pile, int length) {
-        // TODO: Handle empty piles
-
-        log("Entering ToCardIndices()");
-        std::vector<double> index_vector;
-        for (auto & card : pile) {
-            if (card.hidden) {
-                index_vector.push_back(HIDDEN_CARD);
-            } else {
-                index_vector.push_back((int) card);
-            }
-        }
-        index_vector.resize(length, NO_CARD);
-        return index_vector;
-
-    }
-
-    // Card Methods ====================================================================================================
-
-    Card::Card(std::string rank, std::string suit) :
-        rank(std::move(rank)),
-        suit(std::move(suit)),
-        hidden(true),
-        location(kMissing) {
-        log("Entering Card(std::string rank, std::string suit)");
-    }
-
-    Card::Card() : rank(""), suit(""), hidden(true), location(kMissing) {
-        log("Entering Card()");
-    }
-
-    Card::Card(int index) : hidden(false), location(kMissing) {
-        log("Entering Card(int index)");
-
-        // Handles special cards
-        if (index < 0) {
-            rank = "";
-            switch (index) {
-                case -1 : { suit = "s"; break; }
-                case -2 : { suit = "h"; break; }
-                case -3 : { suit = "c"; break; }
-                case -4 : { suit = "d"; break; }
-                case -5 : { suit =  ""; break; }
-                default : {
-                    std::cout << YELLOW << "WARNING: Incorrect index for special card";
-                    break;
-                }
-            }
-        }
-        // Handles ordinary cards
-        else {
-            int rank_value = index % 13;
-            int suit_value = floor(index / 13);
-            rank = RANKS.at(rank_value);
-            suit = SUITS.at(suit_value);
-        }
-
-
-    }
-
-    Card::operator int() const {
-        // OPTIMIZE
-
-        log("Entering Card::operator int()");
-
-        // Handles special cards
-        if (rank.empty()) {
-            if      (suit == "s")  { return -1; }
-            else if (suit == "h")  { return -2; }
-            else if (suit == "c")  { return -3; }
-            else if (suit == "d")  { return -4; }
-            else if (suit.empty()) { return -5; }
-        }
-        // Handles ordinary cards
-        else {
-            int rank_value = GetIndex(RANKS, rank);
-            int suit_value = GetIndex(SUITS, suit);
-            return 13 * suit_value + rank_value;
-        }
-    }
-
-    bool Card::operator==(Card & other_card) const {
-        // log("Entering Card::operator==");
-
-        return rank == other_card.rank and suit == other_card.suit;
-    }
-
-    bool Card::operator==(const Card & other_card) const {
-        // log("Entering Card::operator==");
-
-        return rank == other_card.rank and suit == other_card.suit;
-    }
-
-    std::vector<Card> Card::LegalChildren() const {
-        log("Entering LegalChildren");
-
-        std::vector<Card>        legal_children = {};
-        std::string              child_rank;
-        std::vector<std::string> child_suits;
-
-        // A hidden card has no legal children
-        if (hidden) {
-            return legal_children;
-        }
-
-        switch (location) {
-            case kTableau:
+    namespace {
 
-                // Handles empty tableau cards (children are kings of all suits)
-                if (rank.empty()) {
-                    child_rank  = "K";
-                    child_suits = SUITS;
-                }
-                // Handles regular cards (except aces)
-                else if (rank != "A") {
-                    child_rank  = RANKS.at(GetIndex(RANKS, rank) - 1);
-                    child_suits = GetOppositeSuits(suit);
-                }
-                break;
+        constexpr int Rank(int card) { return card % kNumRanks; }
+        constexpr int Suit(int card) { return card / kNumRanks; }
+        constexpr int MakeCard(int rank, int suit) { return kNumRanks * suit + rank; }
 
-            case kFoundation:
+        // Black suits (s, c) have an even index and red suits (h, d) an odd one.
+        constexpr bool IsRed(int suit) { return suit % 2 == 1; }
 
-                // Handles empty foundation cards (children are aces of same suit)
-                if (rank.empty()) {
-                    child_rank  = "A";
-                    child_suits = {suit};
-                }
-                // Handles regular cards (except kings)
-                else if (rank != "K") {
-                    child_rank  = RANKS.at(GetIndex(RANKS, rank) + 1);
-                    child_suits = {suit};
-                }
-                break;
+        constexpr double kFoundationPoints[kNumRanks] = {
+            100.0, 90.0, 80.0, 70.0, 60.0, 50.0, 40.0, 30.0, 20.0, 10.0, 10.0, 10.0, 10.0
+        };
 
-            default:
-                return legal_children;
-        }
+        // The suits of the empty foundation moves in the order of their actions, from kMove__Ah.
+        constexpr int kEmptyFoundationSuits[kNumSuits] = {1, 0, 2, 3};
 
-        // TODO: Child suits could technically be empty if OppositeSuits() returns {}
-        for (const auto & child_suit : child_suits) {
-            auto child   = Card(child_rank, child_suit);
-            child.hidden = false;
-            legal_children.push_back(child);
+        std::string CardName(int card) {
+            return absl::StrCat(RANKS[Rank(card)], SUITS[Suit(card)]);
         }
 
-        return legal_children;
-    }
-
-    std::string Card::ToString() const {
-        /* // Old Implementation
-        if (hidden) {
-            return "[] ";
-        } else {
+        // Returns the string of a card, kHiddenCard or the target of a move to an empty pile.
+        std::string CardString(int card) {
             std::string result;
-            if (suit == "s" or suit == "c") {
-                absl::StrAppend(&result, WHITE, rank, suit, RESET, " ");
-            } else if (suit == "h" or suit == "d") {
-                absl::StrAppend(&result, RED, rank, suit, RESET, " ");
-            }
-            return result;
-        }
-        */
-
-        log("Entering Card::ToString()");
-
-        std::string result;
-
-        if (hidden) {
-            // Representation of a hidden card
-            absl::StrAppend(&result, "\U0001F0A0", " ");
-        }
-        else {
-            // Suit Color
-            if (suit == "s" or suit == "c") {
-                absl::StrAppend(&result, WHITE);
-            } else if (suit == "h" or suit == "d") {
-                absl::StrAppend(&result, RED);
-            }
-
-            // Special Cards
-            if (rank.empty()) {
-                // Handles special tableau cards which have no rank or suit
-                if (suit.empty()) {
-                    absl::StrAppend(&result, "\U0001F0BF");
-                }
-                // Handles special foundation cards which have a suit but not a rank
-                else {
-                    if (suit == "s") {
-                        absl::StrAppend(&result, "\U00002660");
-                    } else if (suit == "h") {
-                        absl::StrAppend(&result, "\U00002665");
-                    } else if (suit == "c") {
-                        absl::StrAppend(&result, "\U00002663");
-                    } else if (suit == "d") {
-                        absl::StrAppend(&result, "\U00002666");
-                    }
-                }
-            }
-
-            // Ordinary Cards
-            else {
-                absl::StrAppend(&result, rank, suit);
-            }
-
-
-
-        }
-
-        absl::StrAppend(&result, RESET, " ");
-        return result;
-    }
-
-    // Deck Methods ====================================================================================================
-
-    Deck::Deck() {
-        log("Entering Deck()");
-
-        for (int i = 1; i <= 24; i++) {
-            cards.emplace_back();
-        }
-        for (auto & card : cards) {
-            card.location = kDeck;
-        }
-    }
-
-    std::vector<Card> Deck::Sources() const {
-        log("Entering Deck::Sources()");
-
-        // TODO: Can simplify this if statement
-
-        // If the waste is not empty, sources is just a vector of the top card of the waste
-        if (not waste.empty()) {
-            if (waste.front().hidden) {
-                return {};
+            if (card == kHiddenCard) {
+                absl::StrAppend(&result, "\U0001F0A0", " ");
+            } else if (card == kEmptyTableau) {
+                absl::StrAppend(&result, "\U0001F0BF");
             } else {
-                return {waste.front()};
-            }
-        }
-        // If it is empty, sources is just an empty vector
-        else {
-            return {};
-        }
-
-    }
-
-    std::vector<Card> Deck::Split(Card card) {
-        log("Entering Deck::Split()");
-
-        std::vector<Card> split_cards;
-        if (waste.front() == card) {
-            split_cards = {waste.front()};
-            waste.pop_front();
-            return split_cards;
-        }
-    }
-
-    void Deck::draw(unsigned long num_cards) {
-        log("Entering Deck::draw()");
-
-        std::deque<Card> drawn_cards;
-        num_cards = std::min(num_cards, cards.size());
-
-        int i = 1;
-        while (i <= num_cards) {
-            auto card = cards.front();
-            card.location = kWaste;
-            drawn_cards.push_back(card);
-            cards.pop_front();
-            i++;
-        }
-
-        waste.insert(waste.begin(), drawn_cards.begin(), drawn_cards.end());
-    }
-
-    void Deck::rebuild() {
-        log("Entering Deck::rebuild()");
-
-        // TODO: Make sure cards and initial_order are never both empty at the same time.
-        if (cards.empty()) {
-            for (Card & card : initial_order) {
-                if (std::find(waste.begin(), waste.end(), card) != waste.end()) {
-                    card.location = kDeck;
-                    cards.push_back(card);
-                }
-            }
-            waste.clear();
-            times_rebuilt += 1;
-        } else {
-            std::cout << YELLOW << "WARNING: Cannot rebuild a non-empty deck" << RESET << std::endl;
-        }
-    }
-
-    // Foundation Methods ==============================================================================================
-
-    Foundation::Foundation() {
-        log("Entering Foundation()");
-
-        cards = {};
-    }
-
-    Foundation::Foundation(std::string suit) : suit(std::move(suit)) {
-        log("Entering Foundation(std::string suit)");
-
-        cards = {};
-    }
-
-    std::vector<Card> Foundation::Sources() const {
-        log("Entering Foundation::Sources()");
-
-        // If the foundation is not empty, sources is just a vector of the top card of the foundation
-        if (not cards.empty()) {
-            return {cards.back()};
-        }
-        // If it is empty, then sources is just an empty vector
-        else {
-            return {};
-        }
-    }
-
-    std::vector<Card> Foundation::Targets() const {
-        log("Entering Foundation::Targets()");
-
-        // If the foundation is not empty, targets is just the top card of the foundation
-        if (not cards.empty()) {
-            return {cards.back()};
-        }
-        // If it is empty, then targets is just a special card with no rank and a suit matching this foundation
-        else {
-            auto card     = Card("", suit);
-            card.hidden   = false;
-            card.location = kFoundation;
-            return {card};
-        }
-    }
-
-    std::vector<Card> Foundation::Split(Card card) {
-        log("Entering Foundation::Split()");
-
-        std::vector<Card> split_cards;
-        if (cards.back() == card) {
-            split_cards = {cards.back()};
-            cards.pop_back();
-            return split_cards;
-        }
-    }
-
-    void Foundation::Extend(const std::vector<Card> & source_cards) {
-        log("Entering Foundation::Extend()");
-
-        // TODO: Can only extend with ordinary cards
-        // TODO: Probably no use for setting hidden to false.
-
-        for (auto card : source_cards) {
-            card.location = kFoundation;
-            cards.push_back(card);
-        }
-    }
-
-    // Tableau Methods =================================================================================================
-
-    Tableau::Tableau() {
-        log("Entering Tableau()");
-    }
-
-    Tableau::Tableau(int num_cards) {
-        log("Entering Tableau(int num_cards)");
-
-        for (int i = 1; i <= num_cards; i++) {
-            cards.emplace_back();
-        }
-        for (auto & card : cards) {
-            card.location = kTableau;
-        }
-    }
-
-    std::vector<Card> Tableau::Sources() const {
-        log("Entering Tableau::Sources()");
-
-        // If the tableau is not empty, sources is just a vector of all cards that are not hidden
-        if (not cards.empty()) {
-            std::vector<Card> sources;
-            for (auto & card : cards) {
-                if (not card.hidden) {
-                    sources.push_back(card);
-                }
-            }
-            return sources;
-        }
-        // If it is empty, then sources is just an empty vector
-        else {
-            return {};
-        }
-    }
-
-    std::vector<Card> Tableau::Targets() const {
-        /*
-        DECISION: Should targets return a vector, even though it will only return one card?
-        */
-        log("Entering Tableau::Targets()");
-
-        // If the tableau is not empty, targets is just a vector of the top card of the tableau
-        if (not cards.empty()) {
-            if (cards.back().hidden) {
-                return {};
-            } else {
-                return {cards.back()};
-            }
-        }
-        // If it is empty, then targets is just a special card with no rank or suit
-        else {
-            auto card     = Card();
-            card.hidden   = false;
-            card.location = kTableau;
-            return {card};
-        }
-    }
-
-    std::vector<Card> Tableau::Split(Card card) {
-        log("Entering Tableau::Split()");
-
-        // TODO: How to handle a split when card isn't in this tableau?
-
-        std::vector<Card> split_cards;
-        if (not cards.empty()) {
-            bool split_flag = false;
-            for (auto it = cards.begin(); it != cards.end();) {
-                if (*it == card) {
-                    split_flag = true;
-                }
-                if (split_flag) {
-                    split_cards.push_back(*it);
-                    it = cards.erase(it);
+                const int suit = card < 0 ? -1 - card : Suit(card);
+                absl::StrAppend(&result, IsRed(suit) ? RED : WHITE);
+                if (card < 0) {
+                    constexpr const char * kSuitSymbols[kNumSuits] = {
+                        "\U00002660", "\U00002665", "\U00002663", "\U00002666"
+                    };
+                    absl::StrAppend(&result, kSuitSymbols[suit]);
                 } else {
-                    ++it;
+                    absl::StrAppend(&result, CardName(card));
                 }
             }
-        } else {
-            std::cout << YELLOW << "WARNING: Cannot split an empty tableau" << RESET << std::endl;
+            absl::StrAppend(&result, RESET, " ");
+            return result;
         }
 
-        return split_cards;
-    }
-
-    void Tableau::Extend(const std::vector<Card> & source_cards) {
-        log("Entering Tableau::Extend()");
-
-        for (auto card : source_cards) {
-            card.location = kTableau;
-            cards.push_back(card);
-        }
     }
 
     // Move Methods ====================================================================================================
 
-    Move::Move(Card target_card, Card source_card) {
-        log("Entering Move(target_card, source_card)");
-
-        target = std::move(target_card);
-        source = std::move(source_card);
-    }
+    Move::Move(int target_card, int source_card) : target(target_card), source(source_card) {}
 
     Move::Move(Action action_id) {
-        log("Entering Move(action_id)");
-
-        auto card_pair = ACTION_TO_MOVE.at(action_id);
-        target = Card(card_pair.first);
-        source = Card(card_pair.second);
+        if (action_id >= kMove__Ks and action_id <= kMove__Kd) {
+            target = kEmptyTableau;
+            source = MakeCard(kNumRanks - 1, action_id - kMove__Ks);
+        } else if (action_id >= kMove__Ah and action_id <= kMove__Ad) {
+            const int suit = kEmptyFoundationSuits[action_id - kMove__Ah];
+            target = EmptyFoundation(suit);
+            source = MakeCard(0, suit);
+        } else if (action_id >= kMoveAs2s and action_id < kMove2sAh) {
+            // 12 moves onto each foundation, by the rank of the target.
+            const int index = action_id - kMoveAs2s;
+            target = MakeCard(index % (kNumRanks - 1), index / (kNumRanks - 1));
+            source = target + 1;
+        } else if (action_id >= kMove2sAh and action_id <= kMoveKdQc) {
+            // 24 moves onto each suit of tableau card, 12 from each of the opposite suits by the rank of the target.
+            const int index = action_id - kMove2sAh;
+            const int target_suit = index / (2 * (kNumRanks - 1));
+            const int source_suit = 2 * (index / (kNumRanks - 1) % 2) + (IsRed(target_suit) ? 0 : 1);
+            const int rank = index % (kNumRanks - 1) + 1;
+            target = MakeCard(rank, target_suit);
+            source = MakeCard(rank - 1, source_suit);
+        } else {
+            SpielFatalError(absl::StrCat("Action ", action_id, " is not a move."));
+        }
     }
 
     std::string Move::ToString() const {
-        log("Entering Move::ToString()");
-
         std::string result;
-        absl::StrAppend(&result, target.ToString(), "\U00002190", " ",source.ToString());
+        absl::StrAppend(&result, CardString(target), "\U00002190", " ", CardString(source));
         return result;
     }
 
     Action Move::ActionId() const {
-        log("Entering Move::ActionId()");
-
-        return MOVE_TO_ACTION.at(std::make_pair((int) target, (int) source));
+        if (target == kEmptyTableau) {
+            return kMove__Ks + Suit(source);
+        } else if (target < 0) {
+            const int suit = -1 - target;
+            return kMove__Ah + (std::find(kEmptyFoundationSuits, kEmptyFoundationSuits + kNumSuits, suit) -
+                                kEmptyFoundationSuits);
+        } else if (Suit(target) == Suit(source)) {
+            return kMoveAs2s + (kNumRanks - 1) * Suit(target) + Rank(target);
+        } else {
+            return kMove2sAh + 2 * (kNumRanks - 1) * Suit(target) + (kNumRanks - 1) * (Suit(source) / 2) +
+                   Rank(target) - 1;
+        }
     }
 
     // SolitaireState Methods ==========================================================================================
 
     SolitaireState::SolitaireState(std::shared_ptr<const Game> game) :
         State(game),
-        deck(),
-        foundations(),
-        tableaus() {
-            log("Entering SolitaireState(game)");
-            is_started = false;
-            is_setup = false;
-            previous_score = 0.0;
+        is_setup(false),
+        previous_score(0.0) {
+            cards_.fill(kHiddenCard);
+            card_piles_.fill(kNoPile);
+            card_slots_.fill(0);
+            initial_order_.fill(kHiddenCard);
+            pile_sizes_[kDeck] = kMaxDeckSize;
         }
 
     // Overriden Methods -----------------------------------------------------------------------------------------------
 
     Player                  SolitaireState::CurrentPlayer() const {
-        log("Entering CurrentPlayer()");
-
         // There are only two players in this game: chance and player 1.
-        if (IsChanceNode()) {
-            // Index of the chance player
-            return kChancePlayerId;
-        } else {
-            // Index of the player
-            return 0;
+        if (IsTerminal()) {
+            return kTerminalPlayerId;
         }
+        return IsChanceNode() ? kChancePlayerId : 0;
     }
 
     std::unique_ptr<State>  SolitaireState::Clone() const {
-        log("Entering Clone()");
-
         return std::unique_ptr<State>(new SolitaireState(*this));
     }
 
     bool                    SolitaireState::IsTerminal() const {
-        log("Entering IsTerminal()");
-
-
         if (is_finished or draw_counter >= 8) {
             return true;
         }
 
-        else if (History().size() >= 8) {
-
-            std::vector<Action> history = History();
-            std::vector<Action> recent_history(history.end() - 8, history.end());
-
-            for (auto action : recent_history) {
-                if (action != kDraw) {
-                    return false;
-                }
-            }
-
-            // If all 8 recent actions are kDraw, then the state is terminal
-            return true;
-
-        }
-
-        else {
+        // The state is also terminal if all 8 recent actions are kDraw
+        const std::vector<Action> & history = History();
+        if (history.size() < 8) {
             return false;
         }
-
+        return std::all_of(history.end() - 8, history.end(), [](Action action) { return action == kDraw; });
     }
 
     bool                    SolitaireState::IsChanceNode() const {
-        log("Entering IsChanceNode()");
-
         if (not is_setup) {
-            // If setup is not started, this is a chance node
             return true;
         }
 
-        else {
-
-            // If there is a hidden card on the top of a tableau, this is a chance ndoe
-            for (auto & tableau : tableaus) {
-                if (tableau.cards.empty()) {
-                    continue;
-                }
-                else if (tableau.cards.back().hidden) {
-                    return true;
-                }
-            }
-
-            // If any card in the waste is hidden, this is a chance node
-            if (not deck.waste.empty()) {
-                for (auto & card : deck.waste) {
-                    if (card.hidden) {
-                        return true;
-                    }
-                }
-            }
-
-            // Otherwise, this is node a chance node; it's a decision node
-            return false;
-
-        }
-    }
-
-    std::string             SolitaireState::ToString() const {
-        log("Entering ToString()");
-
-        std::string result;
-
-        //absl::StrAppend(&result, "\nIS_SETUP       : ", is_setup);
-        //absl::StrAppend(&result, "\nIS_STARTED     : ", is_started);
-
-        absl::StrAppend(&result, "\nCURRENT PLAYER : ", CurrentPlayer());
-        absl::StrAppend(&result, "\nDRAW COUNTER   : ", draw_counter);
-
-        absl::StrAppend(&result, "\n\nDECK        : ");
-        for (const Card & card : deck.cards) {
-            absl::StrAppend(&result, card.ToString());
-        }
-
-        absl::StrAppend(&result, "\nWASTE       : ");
-        for (const Card & card : deck.waste) {
-            absl::StrAppend(&result, card.ToString());
-        }
-
-        absl::StrAppend(&result, "\nORDER       : ");
-        for (const Card & card : deck.initial_order) {
-            absl::StrAppend(&result, card.ToString());
-        }
-
-        absl::StrAppend(&result, "\nFOUNDATIONS : ");
-        for (const Foundation & foundation : foundations) {
-            if (foundation.cards.empty()) {
-                Card foundation_base = Card("", foundation.suit);
-                foundation_base.hidden = false;
-                absl::StrAppend(&result, foundation_base.ToString());
-            } else {
-                absl::StrAppend(&result, foundation.cards.back().ToString());
+        // If there is a hidden card on the top of a tableau, this is a chance node
+        for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+            if (pile_sizes_[tableau] > 0 and TopCard(tableau) == kHiddenCard) {
+                return true;
             }
         }
 
-        absl::StrAppend(&result, "\nTABLEAUS    : ");
-        for (const Tableau & tableau : tableaus) {
-            if (not tableau.cards.empty()) {
-                absl::StrAppend(&result, "\n");
-                for (const Card & card : tableau.cards) {
-                    absl::StrAppend(&result, card.ToString());
-                }
+        // If any card in the waste is hidden, this is a chance node
+        for (int i = 0; i < pile_sizes_[kWaste]; ++i) {
+            if (PileCard(kWaste, i) == kHiddenCard) {
+                return true;
             }
         }
 
-        /*
-        absl::StrAppend(&result, "\n\nTARGETS : ");
-        for (const Card & card : Targets()) {
-            absl::StrAppend(&result, card.ToString());
-        }
+        return false;
+    }
 
-        absl::StrAppend(&result, "\nSOURCES : ");
-        for (const Card & card : Sources()) {
-            absl::StrAppend(&result, card.ToString());
-        }
+    std::string             SolitaireState::ToString() const {
+        std::string result;
 
-        absl::StrAppend(&result, "\n\nCANDIDATE MOVES : ");
-        for (const Move & move : CandidateMoves()) {
-            absl::StrAppend(&result, "\n", move.ToString(), ": ", move.ActionId());
-            absl::StrAppend(&result, ", ", IsReversible(move));
-        }
-        */
+        absl::StrAppend(&result, "\nCURRENT PLAYER : ", CurrentPlayer());
+        absl::StrAppend(&result, "\nDRAW COUNTER   : ", draw_counter);
+        absl::StrAppend(&result, PilesString(/*show_order=*/true));
 
         return result;
     }
 
     std::string             SolitaireState::ActionToString(Player player, Action action_id) const {
-        // TODO: Probably use the enum names instead of the values the represent
-
-        log("Entering ActionToString()");
-
         switch (action_id) {
             case kSetup : {
                 return "kSetup";
             }
             case kRevealAs ... kRevealKd : {
                 // Reveal starts at 1 while card indices start at 0, so we subtract one here
-                Card revealed_card = Card(action_id - 1);
-
-                std::string result;
-                absl::StrAppend(&result, "kReveal", revealed_card.rank, revealed_card.suit);
-
-                return result;
+                return absl::StrCat("kReveal", CardName(action_id - 1));
             }
             case kDraw : {
                 return "kDraw";
             }
             case kMove__Ks ... kMoveKdQc : {
                 Move move = Move(action_id);
-                std::string result;
-
-                absl::StrAppend(&result, "kMove");
-                if (move.target.rank.empty()) { absl::StrAppend(&result, "__"); }
-                else { absl::StrAppend(&result, move.target.rank, move.target.suit); }
-                absl::StrAppend(&result, move.source.rank, move.source.suit);
-
-                return result;
+                return absl::StrCat("kMove", move.target < 0 ? "__" : CardName(move.target), CardName(move.source));
             }
             default : {
                 return "kMissingAction";
@@ -843,54 +258,14 @@ namespace open_spiel::solitaire {
     }
 
     std::string             SolitaireState::InformationStateString(Player player) const {
-        log("Entering InformationStateString()");
-
         return HistoryString();
     }
 
     std::string             SolitaireState::ObservationString(Player player) const {
-        log("Entering ObservationString()");
-
-        std::string result;
-
-        absl::StrAppend(&result, "\n\nDECK        : ");
-        for (const Card & card : deck.cards) {
-            absl::StrAppend(&result, card.ToString());
-        }
-
-        absl::StrAppend(&result, "\nWASTE       : ");
-        for (const Card & card : deck.waste) {
-            absl::StrAppend(&result, card.ToString());
-        }
-
-        absl::StrAppend(&result, "\nFOUNDATIONS : ");
-        for (const Foundation & foundation : foundations) {
-            if (foundation.cards.empty()) {
-                Card foundation_base = Card("", foundation.suit);
-                foundation_base.hidden = false;
-                absl::StrAppend(&result, foundation_base.ToString());
-            } else {
-                absl::StrAppend(&result, foundation.cards.back().ToString());
-            }
-        }
-
-        absl::StrAppend(&result, "\nTABLEAUS    : ");
-        for (const Tableau & tableau : tableaus) {
-            if (not tableau.cards.empty()) {
-                absl::StrAppend(&result, "\n");
-                for (const Card & card : tableau.cards) {
-                    absl::StrAppend(&result, card.ToString());
-                }
-            }
-        }
-
-        return result;
-
+        return PilesString(/*show_order=*/false);
     }
 
     void                    SolitaireState::InformationStateTensor(Player player, std::vector<double> *values) const {
-        log("Entering InformationStateTensor()");
-
         values->resize(game_->InformationStateTensorShape()[0]);
         std::fill(values->begin(), values->end(), kInvalidAction);
 
@@ -899,161 +274,105 @@ namespace open_spiel::solitaire {
             (*values)[i] = action;
             ++i;
         }
-
     }
 
     void                    SolitaireState::ObservationTensor(Player player, std::vector<double> *values) const {
-
-        log("Entering ObservationTensor()");
-
-        // TODO: Not sure if any pile being empty would have an effect on the final result
-
-        for (const auto & tableau : tableaus) {
-            std::vector<double> tableau_obs = ToCardIndices(tableau.cards, 19);
-            values->insert(values->end(), tableau_obs.begin(), tableau_obs.end());
-        }
-
-        for (const auto & foundation : foundations) {
-            std::vector<double> foundation_obs = ToCardIndices(foundation.cards, 13);
-            values->insert(values->end(), foundation_obs.begin(), foundation_obs.end());
+        // Each pile takes as many entries as it has slots, from its bottom card for the tableaus and foundations, and
+        // from the top card of the waste and the next card drawn from the deck, padded with NO_CARD.
+        values->assign(kNumSlots, NO_CARD);
+        for (int pile = 0; pile < kNumPiles; ++pile) {
+            const int size = pile_sizes_[pile];
+            for (int i = 0; i < size; ++i) {
+                const int card = pile < kWaste ? PileCard(pile, i) : PileCard(pile, size - 1 - i);
+                (*values)[PileOffset(pile) + i] = card == kHiddenCard ? HIDDEN_CARD : card;
+            }
         }
-
-        std::vector<double> waste_obs = ToCardIndices(deck.waste, 24);
-        values->insert(values->end(), waste_obs.begin(), waste_obs.end());
-
-        std::vector<double> deck_obs = ToCardIndices(deck.cards, 24);
-        values->insert(values->end(), deck_obs.begin(), deck_obs.end());
-
     }
 
     void                    SolitaireState::DoApplyAction(Action move) {
-        log("Entering DoApplyAction()");
-
-        // Set previous_score to be equal to the returns from this state
-
-        previous_score = Returns().front();
+        // Set previous_score to be equal to the returns from this state, unless it's a chance node, so that the
+        // rewards of a decision node count from the previous one.
+        if (not IsChanceNode()) {
+            previous_score = Returns().front();
+        }
 
         // Action Handling =============================================================================================
 
         // Handles kSetup
         if (move == kSetup) {
-            log("DoApplyAction() - if (move == kSetup)");
-
-            // Creates tableaus
-            for (int i = 1; i <= 7; i++) {
-                tableaus.emplace_back(i);
-            }
-
-            // Creates foundations
-            for (const auto & suit : SUITS) {
-                foundations.emplace_back(suit);
+            // Deals i + 1 hidden cards to the i-th tableau
+            for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+                pile_sizes_[tableau] = tableau + 1;
             }
 
             is_setup       = true;
             is_started     = false;
-            is_finished     = false;
+            is_finished    = false;
             is_reversible  = false;
             draw_counter   = 0;
             previous_score = 0.0;
-
         }
 
         // Handles kReveal
-        else if (1 <= move and move <= 52) {
-            log("DoApplyAction() - else if (1 <= move and move <= 52)");
-
+        else if (kRevealAs <= move and move <= kRevealKd) {
             // Cards start at 0 instead of 1 which is why we subtract 1 to move here.
-            Card revealed_card = Card(move - 1);
-            bool found_hidden_card = false;
-
-            // For tableau in tableaus ...
-            for (auto & tableau : tableaus) {
-
-                // If it isn't empty ...
-                if (not tableau.cards.empty()) {
-
-                    // If the last card is hidden ...
-                    if (tableau.cards.back().hidden) {
-
-                        // Then reveal it
-                        tableau.cards.back().rank = revealed_card.rank;
-                        tableau.cards.back().suit = revealed_card.suit;
-                        tableau.cards.back().hidden = false;
-
-                        // And indicate that we found a hidden card so we don't have to search for one in the waste
-                        found_hidden_card = true;
-
-                        // Breaks out and goes to check the waste, if applicable
-                        break;
-                    }
+            const int card = move - 1;
+
+            // Reveals the top card of the first tableau where it's hidden, or else the first hidden card of the waste
+            // from its top, which is added to the initial order.
+            int pile = kNoPile;
+            int slot = 0;
+            for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+                if (pile_sizes_[tableau] > 0 and TopCard(tableau) == kHiddenCard) {
+                    pile = tableau;
+                    slot = pile_sizes_[tableau] - 1;
+                    break;
                 }
             }
-
-            // If we didn't find a hidden card in the tableau and the waste isn't empty ...
-            if ((not found_hidden_card) and not deck.waste.empty()) {
-
-                // Then for card in the waste ...
-                for (auto & card : deck.waste) {
-
-                    // If the card is hidden ...
-                    if (card.hidden) {
-
-                        // Reveal it by setting its rank and suit
-                        card.rank = revealed_card.rank;
-                        card.suit = revealed_card.suit;
-                        card.hidden = false;
-
-                        // Add the revealed card to the initial order
-                        deck.initial_order.push_back(card);
+            if (pile == kNoPile) {
+                for (int i = pile_sizes_[kWaste] - 1; i >= 0; --i) {
+                    if (PileCard(kWaste, i) == kHiddenCard) {
+                        pile = kWaste;
+                        slot = i;
+                        initial_order_[initial_order_size_++] = card;
                         break;
-
                     }
                 }
             }
+            if (pile != kNoPile) {
+                cards_[PileOffset(pile) + slot] = card;
+                card_piles_[card] = pile;
+                card_slots_[card] = slot;
+            }
 
             // Add move to revealed cards so we don't try to reveal it again
-            revealed_cards.push_back(move);
-
+            revealed_cards_ |= uint64_t{1} << card;
 
-            // TODO: There shouldn't ever be a time before `is_started` where a tableau is empty
-            // If the game hasn't been started ...
+            // The game starts once the top cards of all tableaus are revealed
             if (not is_started) {
-                // For every tableau in tableaus ...
-                for (auto & tableau : tableaus) {
-                    // If the last card is hidden ...
-                    if (tableau.cards.back().hidden) {
-                        // Then we are not ready to start the game.
-                        // Return with is_started still false;
-                        return;
-                    }
-                    // If the last card is not hidden, continue the loop and check the next tableau
-                    else {
-                        continue;
+                bool all_revealed = true;
+                for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+                    if (TopCard(tableau) == kHiddenCard) {
+                        all_revealed = false;
+                        break;
                     }
                 }
-
-                // This is only reached if all cards at the back of the tableaus are not hidden.
-                is_started = true;
-                previous_score = 0.0;
+                if (all_revealed) {
+                    is_started = true;
+                    previous_score = 0.0;
+                }
             }
-
         }
 
         // Handles kDraw
         else if (move == kDraw) {
-            log("DoApplyAction() - else if (move == kDraw)");
-            // kDraw is not reversible (well, you'd have to go through the deck again)
-            // is_reversible = false;
-            if (deck.cards.empty()) {
-                deck.rebuild();
+            if (pile_sizes_[kDeck] == 0) {
+                Rebuild();
             }
-            deck.draw(3);
-
-            // Loop Detection
-            std::vector<Action> legal_actions = LegalActions();
+            Draw(3);
 
-            // We check here if there are any other legal actions besides kDraw
-            if (legal_actions.size() == 1) {
+            // Loop Detection: we check here if there are any other legal actions besides kDraw
+            if (NumLegalActions() == 1) {
                 draw_counter += 1;
             }
 
@@ -1064,534 +383,351 @@ namespace open_spiel::solitaire {
 
         // Handles kMove
         else {
-            log("DoApplyAction() - else");
-            // Create a move from the action id provided by 'move'
-
             Move selected_move = Move(move);
 
             // If the move we are about to execute is reversible, set to true, else set to false
             is_reversible = IsReversible(selected_move);
 
-            // Execute the selected move
             MoveCards(selected_move);
 
-            // Reset the draw_counter if it's not below 8
+            // Reset the draw_counter if it's not above 8
             if (draw_counter <= 8) {
                 draw_counter = 0;
             }
-
         }
 
         // Finish Game =================================================================================================
 
         if (IsSolvable()) {
-            // Clear Tableaus
-            for (auto & tableau : tableaus) {
-                tableau.cards.clear();
+            // Clears the tableaus and fills the foundations
+            for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+                pile_sizes_[tableau] = 0;
             }
-
-            // Clear Foundations & Repopulate
-            for (auto & foundation : foundations) {
-                foundation.cards.clear();
-                for (const auto & rank : RANKS) {
-                    Card card = Card(rank, foundation.suit);
-                    card.hidden = false;
-                    card.location = kFoundation;
-                    foundation.cards.push_back(card);
+            for (int suit = 0; suit < kNumSuits; ++suit) {
+                pile_sizes_[kFirstFoundation + suit] = 0;
+                for (int rank = 0; rank < kNumRanks; ++rank) {
+                    PushCard(kFirstFoundation + suit, MakeCard(rank, suit));
                 }
             }
 
-            // Set Game to Finished
             is_finished = true;
         }
-
-
-
     }
 
     std::vector<double>     SolitaireState::Returns() const {
         // Equal to the sum of all rewards up to the current state
+        if (not is_started) {
+            return {0.0};
+        }
 
-        log("Entering Returns()");
-
-        if (is_started) {
-
-            double returns = 0.0;
-
-            // Foundation Score
-            double foundation_score = 0.0;
-            for (auto & foundation : foundations) {
-                for (auto & card : foundation.cards) {
-                    foundation_score += FOUNDATION_POINTS.at(card.rank);
-                }
+        // Foundation Score
+        double foundation_score = 0.0;
+        for (int foundation = kFirstFoundation; foundation < kWaste; ++foundation) {
+            for (int i = 0; i < pile_sizes_[foundation]; ++i) {
+                foundation_score += kFoundationPoints[Rank(PileCard(foundation, i))];
             }
+        }
 
-            // Tableau Score
-            double tableau_score = 0.0;
-            int num_hidden_cards = 0;
-            for (auto & tableau : tableaus) {
-                if (not tableau.cards.empty()) {
-                    for (auto & card : tableau.cards) {
-                        // Cards that will be revealed by a chance node next turn are not counted
-                        if (card.hidden) {
-                            num_hidden_cards += 1;
-                        }
-                    }
-                    if (tableau.cards.back().hidden) {
-                        num_hidden_cards += -1;
-                    }
+        // Tableau Score: cards that will be revealed by a chance node next turn are not counted
+        int num_hidden_cards = 0;
+        for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+            for (int i = 0; i < pile_sizes_[tableau] - 1; ++i) {
+                if (PileCard(tableau, i) == kHiddenCard) {
+                    num_hidden_cards += 1;
                 }
             }
-            tableau_score = (21 - num_hidden_cards) * 20;
-
-            // Waste Score
-            double waste_score = 0.0;
-            int waste_cards_remaning;
-            waste_cards_remaning = deck.cards.size() + deck.waste.size();
-            waste_score = (24 - waste_cards_remaning) * 20;
-
-            // Total Score
-            returns = foundation_score + tableau_score + waste_score;
-            return {returns};
         }
+        const double tableau_score = (21 - num_hidden_cards) * 20;
 
-        else {
-            return {0.0};
-        }
+        // Waste Score
+        const int waste_cards_remaining = pile_sizes_[kDeck] + pile_sizes_[kWaste];
+        const double waste_score = (24 - waste_cards_remaining) * 20;
 
+        return {foundation_score + tableau_score + waste_score};
     }
 
     std::vector<double>     SolitaireState::Rewards() const {
         // TODO: Should not be called on chance nodes (undefined and crashes)
         // Highest possible reward per action is 120.0 (e.g. ♠ ← As where As is on a hidden card)
         // Lowest possible reward per action is -100.0 (e.g. 2h ← As where As is in foundation initially) */
-        log("Entering Rewards()");
-
         if (is_started) {
-            std::vector<double> current_returns = Returns();
-            double current_score = current_returns.front();
-            return {current_score - previous_score};
+            return {Returns().front() - previous_score};
         } else {
             return {0.0};
         }
-
     }
 
     std::vector<Action>     SolitaireState::LegalActions() const {
-        log("Entering LegalActions()");
-
         if (IsTerminal()) {
             return {};
         }
 
-        else {
-            // TODO: What is CandidateMoves() is empty?
-
-            std::vector<Action> legal_actions;
-
-            for (const auto & move : CandidateMoves()) {
-
-                if (is_reversible) {
-                    if (IsReversible(move)) {
-                        continue;
-                    } else {
-                        legal_actions.push_back(move.ActionId());
-                    }
-                } else {
-                    legal_actions.push_back(move.ActionId());
-                }
-            }
-
-            if (deck.cards.size() + deck.waste.size() > 0 and draw_counter < 8) {
-                legal_actions.push_back(kDraw);
+        std::vector<Action> legal_actions;
+        GenerateMoves([this, &legal_actions](const Move & move) {
+            // A reversible move can't follow another one
+            if (not is_reversible or not IsReversible(move)) {
+                legal_actions.push_back(move.ActionId());
             }
+            return true;
+        });
 
-            return legal_actions;
+        if (pile_sizes_[kDeck] + pile_sizes_[kWaste] > 0 and draw_counter < 8) {
+            legal_actions.push_back(kDraw);
         }
 
+        std::sort(legal_actions.begin(), legal_actions.end());
+        return legal_actions;
     }
 
     std::vector<std::pair<Action, double>> SolitaireState::ChanceOutcomes() const {
-        log("Entering ChanceOutcomes");
-
         if (!is_setup) {
             return {{kSetup, 1.0}};
-        } else {
-            std::vector<std::pair<Action, double>> outcomes;
-            const double p = 1.0 / (52 - revealed_cards.size());
+        }
 
-            for (int i = 1; i <= 52; i++) {
-                if (std::find(revealed_cards.begin(), revealed_cards.end(), i) != revealed_cards.end()) {
-                    continue;
-                } else {
-                    outcomes.emplace_back(i, p);
-                }
+        std::vector<std::pair<Action, double>> outcomes;
+        const int num_hidden_cards = kNumCards - __builtin_popcountll(revealed_cards_);
+        outcomes.reserve(num_hidden_cards);
+        const double p = 1.0 / num_hidden_cards;
+        for (int card = 0; card < kNumCards; ++card) {
+            if (not (revealed_cards_ >> card & 1)) {
+                outcomes.emplace_back(card + 1, p);
             }
-            return outcomes;
         }
+        return outcomes;
     }
 
     // Other Methods ---------------------------------------------------------------------------------------------------
 
-    std::vector<Card>       SolitaireState::Targets(const std::optional<std::string> & location) const {
-        log("Entering SolitaireState::Targets()");
-
-        std::string loc = location.value_or("all");
-        std::vector<Card> targets;
-
-        // Gets targets from tableaus
-        if (loc == "tableau" or loc == "all") {
-            for (const Tableau & tableau : tableaus) {
-                std::vector<Card> current_targets = tableau.Targets();
-                targets.insert(targets.end(), current_targets.begin(), current_targets.end());
-            }
+    void                    SolitaireState::GenerateMoves(const MoveYieldFn & yield) const {
+        if (not is_setup) {
+            return;
         }
 
-        // Gets targets from foundations
-        if (loc == "foundation" or loc == "all") {
-            for (const Foundation & foundation : foundations) {
-                std::vector<Card> current_targets = foundation.Targets();
-                targets.insert(targets.end(), current_targets.begin(), current_targets.end());
+        // Kings can be moved to any empty tableau, and the moves are the same for all of them.
+        bool has_empty_tableau = false;
+        for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+            if (pile_sizes_[tableau] == 0) {
+                if (has_empty_tableau) {
+                    continue;
+                }
+                has_empty_tableau = true;
+                for (int suit = 0; suit < kNumSuits; ++suit) {
+                    // Kings can't be moved to an empty tableau from the bottom of another one
+                    const int king = MakeCard(kNumRanks - 1, suit);
+                    if (IsMoveSource(king) and not (IsTableau(card_piles_[king]) and card_slots_[king] == 0)) {
+                        if (not yield(Move(kEmptyTableau, king))) return;
+                    }
+                }
+                continue;
             }
-        }
-
-        // Returns targets as a vector of cards in all piles specified by "location"
-        return targets;
 
-    }
-
-    std::vector<Card>       SolitaireState::Sources(const std::optional<std::string> & location) const {
-        log("Entering SolitaireState::Sources()");
-
-        std::string loc = location.value_or("all");
-        std::vector<Card> sources;
-
-        // Gets sources from tableaus
-        if (loc == "tableau" or loc == "all") {
-            for (const Tableau & tableau : tableaus) {
-                std::vector<Card> current_sources = tableau.Sources();
-                sources.insert(sources.end(), current_sources.begin(), current_sources.end());
+            const int target = TopCard(tableau);
+            if (target == kHiddenCard or Rank(target) == 0) {
+                continue;
             }
-        }
-
-        // Gets sources from foundations
-        if (loc == "foundation" or loc == "all") {
-            for (const Foundation & foundation : foundations) {
-                std::vector<Card> current_sources = foundation.Sources();
-                sources.insert(sources.end(), current_sources.begin(), current_sources.end());
+            // Cards of the opposite colour and the next lower rank go onto tableau cards, in the order of SUITS
+            for (int suit = IsRed(Suit(target)) ? 0 : 1; suit < kNumSuits; suit += 2) {
+                const int source = MakeCard(Rank(target) - 1, suit);
+                if (IsMoveSource(source)) {
+                    if (not yield(Move(target, source))) return;
+                }
             }
         }
 
-        // Gets sources from waste
-        if (loc == "waste" or loc == "all") {
-            std::vector<Card> current_sources = deck.Sources();
-            sources.insert(sources.end(), current_sources.begin(), current_sources.end());
-        }
-
-        // Returns sources as a vector of cards in all piles specified by "location"
-        return sources;
-    }
-
-    std::vector<Move>       SolitaireState::CandidateMoves() const {
-        log("Entering CandidateMoves()");
-
-        std::vector<Move> candidate_moves;
-        std::vector<Card> targets = Targets();
-        std::vector<Card> sources = Sources();
-
-        for (const auto & target : targets) {
-            std::vector<Card> legal_children = target.LegalChildren();
-
-            for (auto source : legal_children) {
-
-                source.location = FindLocation(source); // OPTIMIZE
-
-                if (std::find(sources.begin(), sources.end(), source) != sources.end()) {
-
-                    if (target.location == kFoundation and source.location == kTableau) {
-                        if (IsTopCard(source)) {
-                            candidate_moves.emplace_back(target, source);
-                        }
-                    }
-
-                    else if (target == Card("", "") and source.rank == "K") {
-                        if (not IsBottomCard(source)) {
-                            candidate_moves.emplace_back(target, source);
-                        }
-                    }
-
-                    else {
-                        candidate_moves.emplace_back(target, source);
-                    }
-
-                }
-
-                else {
+        for (int suit = 0; suit < kNumFoundations; ++suit) {
+            const int foundation = kFirstFoundation + suit;
+            int target;
+            int source;
+            if (pile_sizes_[foundation] == 0) {
+                target = EmptyFoundation(suit);
+                source = MakeCard(0, suit);
+            } else {
+                target = TopCard(foundation);
+                if (Rank(target) == kNumRanks - 1) {
                     continue;
                 }
-
+                source = target + 1;
+            }
+            // Only the top card of a tableau can be moved to a foundation
+            const int pile = card_piles_[source];
+            if (IsMoveSource(source) and
+                not (IsTableau(pile) and card_slots_[source] != pile_sizes_[pile] - 1)) {
+                if (not yield(Move(target, source))) return;
             }
         }
-
-        return candidate_moves;
-
     }
 
-    Tableau *               SolitaireState::FindTableau(const Card & card) const {
-        log("Entering FindTableau()");
-
-        if (card.rank.empty() and card.suit.empty()) {
-            for (auto & tableau : tableaus) {
-                if (tableau.cards.empty()) {
-                    return const_cast<Tableau *>(& tableau);
-                }
-            }
+    bool                    SolitaireState::IsMoveSource(int card) const {
+        // Revealed tableau cards can be moved along with the cards above them, but only the top cards of the
+        // foundations and the waste can be moved.
+        const int pile = card_piles_[card];
+        if (IsTableau(pile)) {
+            return true;
+        } else if (IsFoundation(pile) or pile == kWaste) {
+            return card_slots_[card] == pile_sizes_[pile] - 1;
+        } else {
+            return false;
         }
+    }
 
-        else {
-            for (auto & tableau : tableaus) {
-                if (not tableau.cards.empty()) {
-                    if (std::find(tableau.cards.begin(), tableau.cards.end(), card) != tableau.cards.end()) {
-                        return const_cast<Tableau *>(& tableau);
-                    }
+    int                     SolitaireState::TargetPile(int target) const {
+        if (target == kEmptyTableau) {
+            for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+                if (pile_sizes_[tableau] == 0) {
+                    return tableau;
                 }
             }
+            return kNoPile;
+        } else if (target < 0) {
+            const int foundation = kFirstFoundation + (-1 - target);
+            return pile_sizes_[foundation] == 0 ? foundation : kNoPile;
+        } else {
+            return card_piles_[target];
         }
-
     }
 
-    Foundation *            SolitaireState::FindFoundation(const Card & card) const {
-        log("Entering FindFoundation");
+    void                    SolitaireState::PushCard(int pile, int card) {
+        const int slot = pile_sizes_[pile]++;
+        SPIEL_CHECK_LT(slot, PileCapacity(pile));
+        cards_[PileOffset(pile) + slot] = card;
+        if (card != kHiddenCard) {
+            card_piles_[card] = pile;
+            card_slots_[card] = slot;
+        }
+    }
 
-        if (card.rank.empty()) {
-            for (auto & foundation : foundations) {
-                if (foundation.cards.empty() and foundation.suit == card.suit) {
-                    return const_cast<Foundation *>(& foundation);
-                }
-            }
+    void                    SolitaireState::MoveCards(const Move & move) {
+        const int source_pile = card_piles_[move.source];
+        const int target_pile = TargetPile(move.target);
+        if (not (IsTableau(source_pile) or IsFoundation(source_pile) or source_pile == kWaste) or
+            not IsMoveSource(move.source)) {
+            SpielFatalError(absl::StrCat("Can't move ", CardName(move.source), " from its pile."));
         }
-        else {
-            for (auto & foundation : foundations) {
-                if (not foundation.cards.empty() and foundation.suit == card.suit) {
-                    if (std::find(foundation.cards.begin(), foundation.cards.end(), card) != foundation.cards.end()) {
-                        return const_cast<Foundation *>(& foundation);
-                    }
-                }
-            }
+        if (not (IsTableau(target_pile) or IsFoundation(target_pile))) {
+            SpielFatalError(absl::StrCat("Can't move ", CardName(move.source), " onto its target."));
         }
 
+        // Moves the source card with the cards above it in a tableau, which is only its top card otherwise
+        const int first_slot = card_slots_[move.source];
+        const int num_cards = pile_sizes_[source_pile];
+        for (int i = first_slot; i < num_cards; ++i) {
+            PushCard(target_pile, PileCard(source_pile, i));
+        }
+        pile_sizes_[source_pile] = first_slot;
     }
 
-    Location                SolitaireState::FindLocation(const Card & card) const {
-        // OPTIMIZE
-
-        log("Entering FindLocation()");
-
-        // Handles special cards
-        if (card.rank.empty()) {
-            if (card.suit.empty()) {
-                return kTableau;
-            } else {
-                return kFoundation;
+    void                    SolitaireState::Rebuild() {
+        // The waste cards are put back into the deck in the order they were first drawn and revealed
+        int num_cards = 0;
+        std::array<int8_t, kMaxDeckSize> deck_cards;
+        for (int i = 0; i < initial_order_size_; ++i) {
+            const int card = initial_order_[i];
+            if (card_piles_[card] == kWaste) {
+                deck_cards[num_cards++] = card;
             }
         }
 
-        // Attempts to find the card in a tableau
-        for (auto & tableau : tableaus) {
-            if (std::find(tableau.cards.begin(), tableau.cards.end(), card) != tableau.cards.end()) {
-                return kTableau;
-            }
+        pile_sizes_[kWaste] = 0;
+        for (int i = num_cards - 1; i >= 0; --i) {
+            PushCard(kDeck, deck_cards[i]);
         }
+    }
 
-        // Attempts to find the card in a foundation
-        for (auto & foundation : foundations) {
-            if (std::find(foundation.cards.begin(), foundation.cards.end(), card) != foundation.cards.end()) {
-                return kFoundation;
-            }
+    void                    SolitaireState::Draw(int num_cards) {
+        num_cards = std::min(num_cards, static_cast<int>(pile_sizes_[kDeck]));
+        // The first card drawn ends up on top of the waste, above the others
+        for (int i = num_cards - 1; i >= 0; --i) {
+            PushCard(kWaste, PileCard(kDeck, pile_sizes_[kDeck] - 1 - i));
         }
+        pile_sizes_[kDeck] -= num_cards;
+    }
 
-        // Attempts to find the card in the waste
-        if (std::find(deck.waste.begin(), deck.waste.end(), card) != deck.waste.end()) {
-            return kWaste;
+    int                     SolitaireState::NumLegalActions() const {
+        if (IsTerminal()) {
+            return 0;
         }
 
-        // Attempts to find the card in the deck
-        if (std::find(deck.cards.begin(), deck.cards.end(), card) != deck.cards.end()) {
-            return kDeck;
+        int num_legal_actions = 0;
+        GenerateMoves([this, &num_legal_actions](const Move & move) {
+            if (not is_reversible or not IsReversible(move)) {
+                ++num_legal_actions;
+            }
+            return true;
+        });
+        if (pile_sizes_[kDeck] + pile_sizes_[kWaste] > 0 and draw_counter < 8) {
+            ++num_legal_actions;
         }
-
-        // Default value is returned if the card isn't found
-        return kMissing;
-
+        return num_legal_actions;
     }
 
-    void                    SolitaireState::MoveCards(const Move & move) {
-        log("Entering MoveCards()");
-
-        // Unpack target and source from move
-        Card target = move.target;
-        Card source = move.source;
+    std::string             SolitaireState::PilesString(bool show_order) const {
+        std::string result;
 
-        // Find their locations in this state
-        target.location = FindLocation(target);
-        source.location = FindLocation(source);
+        // The deck is shown from the next card drawn and the waste from its top card
+        absl::StrAppend(&result, "\n\nDECK        : ");
+        for (int i = pile_sizes_[kDeck] - 1; i >= 0; --i) {
+            absl::StrAppend(&result, CardString(PileCard(kDeck, i)));
+        }
 
-        std::vector<Card> split_cards;
+        absl::StrAppend(&result, "\nWASTE       : ");
+        for (int i = pile_sizes_[kWaste] - 1; i >= 0; --i) {
+            absl::StrAppend(&result, CardString(PileCard(kWaste, i)));
+        }
 
-        switch (source.location) {
-            case kTableau : {
-                split_cards = FindTableau(source)->Split(source);
-                break;
-            }
-            case kFoundation : {
-                split_cards = FindFoundation(source)->Split(source);
-                break;
-            }
-            case kWaste : {
-                split_cards = deck.Split(source);
-                break;
-            }
-            default : {
-                std::cout << YELLOW << "WARNING: 'source' is not in a tableau, foundation, or waste" << RESET << std::endl;
-                std::cout << YELLOW << "WARNING: 'source' = " << source.ToString() << RESET << std::endl;
+        if (show_order) {
+            absl::StrAppend(&result, "\nORDER       : ");
+            for (int i = 0; i < initial_order_size_; ++i) {
+                absl::StrAppend(&result, CardString(initial_order_[i]));
             }
         }
 
-        switch (target.location) {
-            case kTableau : {
-                auto target_container = FindTableau(target);
-                target_container->Extend(split_cards);
-                break;
-            }
-            case kFoundation : {
-                auto target_container = FindFoundation(target);
-                target_container->Extend(split_cards);
-                break;
-            }
-            default : {
-                std::cout << YELLOW << "WARNING: 'target' is not in a tableau or foundation" << RESET << std::endl;
-                std::cout << YELLOW << "WARNING: 'target' = " << target.ToString() << RESET << std::endl;
+        absl::StrAppend(&result, "\nFOUNDATIONS : ");
+        if (is_setup) {
+            for (int suit = 0; suit < kNumFoundations; ++suit) {
+                const int foundation = kFirstFoundation + suit;
+                absl::StrAppend(&result, CardString(pile_sizes_[foundation] == 0 ? EmptyFoundation(suit)
+                                                                                  : TopCard(foundation)));
             }
         }
 
-    }
-
-    bool                    SolitaireState::IsOverHidden(const Card & card) const {
-        log("Entering IsOverHidden()");
-
-        if (card.location == kTableau) {
-            auto container = FindTableau(card);
-            auto p = std::find(container->cards.begin(), container->cards.end(), card);
-            auto previous_card = std::prev(p);
-            return previous_card->hidden;
+        absl::StrAppend(&result, "\nTABLEAUS    : ");
+        for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+            if (pile_sizes_[tableau] > 0) {
+                absl::StrAppend(&result, "\n");
+                for (int i = 0; i < pile_sizes_[tableau]; ++i) {
+                    absl::StrAppend(&result, CardString(PileCard(tableau, i)));
+                }
+            }
         }
 
-        return false;
+        return result;
     }
 
     bool                    SolitaireState::IsReversible(const Move & move) const {
-        log("Entering IsReversible()");
-
-        Card target = move.target;
-        Card source = move.source;
-
-        target.location = FindLocation(target);
-        source.location = FindLocation(source);
-
-        switch (source.location) {
-            // Cards cannot be moved back to the waste, therefore this is not reversible
-            case kWaste : {
-                return false;
-            }
-            // Cards can always be moved back from the foundation on the next state
-            case kFoundation : {
-                return true;
-            }
+        const int pile = card_piles_[move.source];
+        if (IsTableau(pile)) {
             // Cards can be moved back if they don't reveal a hidden card upon being moved
-            case kTableau : {
-                if (IsBottomCard(source) or IsOverHidden(source)) {
-                    return false;
-                } else {
-                    return true;
-                }
-            }
-            // Cards can't be moved at all if they are in kDeck or kMissing
-            default : {
-                std::cout << YELLOW << "WARNING: 'source' is not in a tableau, foundation, or waste" << RESET << std::endl;
-                // I guess we return false here since it's not even a valid move?
-                return false;
-            }
-
-        }
-    }
-
-    bool                    SolitaireState::IsBottomCard(Card card) const {
-        log("Entering IsBottomCard()");
-
-        // Only implemented for cards in a tableau at the moment.
-        if (card.location == kTableau) {
-            auto container = FindTableau(card);
-            // This line assumes three things:
-            //  - That `FindTableau()` actually found a tableau (TODO: add exception to it later)
-            //  - That the tableau found is not empty, otherwise we could not call `cards.front()`
-            //  - That `card` is an ordinary card (e.g. its suit and rank are defined)
-            return container->cards.front() == card;
+            const int slot = card_slots_[move.source];
+            return slot > 0 and PileCard(pile, slot - 1) != kHiddenCard;
         } else {
-            // While it a card could be the bottom one in different locations, there isn't much use
-            return false;
-        }
-    }
-
-    bool                    SolitaireState::IsTopCard(const Card & card) const {
-        // Assumes that card is found in a container, meaning container.back() will be defined
-        // This isn't true for special cards (e.g. Card("", "") or Card("", "s") etc.)
-
-        log("Entering IsTopCard()");
-
-        std::deque<Card> container;
-        switch (card.location) {
-            case kTableau : {
-                container = FindTableau(card)->cards;
-                return card == container.back();
-            }
-            case kFoundation : {
-                container = FindFoundation(card)->cards;
-                return card == container.back();
-            }
-            case kWaste : {
-                container = deck.waste;
-                return card == container.front();
-            }
-            default : {
-                return false;
-            }
+            // Cards can always be moved back from the foundation on the next state, but not to the waste
+            return IsFoundation(pile);
         }
     }
 
     bool                    SolitaireState::IsSolvable() const {
-        log("Entering IsSolvable()");
-
-        if (deck.cards.empty() and deck.waste.empty()) {
-            for (auto & tableau : tableaus) {
-                if (not tableau.cards.empty()) {
-                    for (auto & card : tableau.cards) {
-                        // Returns false if at least one tableau card is hidden
-                        if (card.hidden) {
-                            return false;
-                        }
-                    }
-                } else {
-                    continue;
+        // Only true if all cards are revealed and there are no cards in deck or waste
+        if (pile_sizes_[kDeck] > 0 or pile_sizes_[kWaste] > 0) {
+            return false;
+        }
+        for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+            for (int i = 0; i < pile_sizes_[tableau]; ++i) {
+                if (PileCard(tableau, i) == kHiddenCard) {
+                    return false;
                 }
             }
-            // Only returns true if all cards are revealed and there are no cards in deck or waste
-            return true;
-        }
-        else {
-            // Returned if there are cards in deck or waste
-            return false;
         }
-
+        return true;
     }
 
     // SolitaireGame Methods ===========================================================================================
@@ -1606,6 +742,11 @@ namespace open_spiel::solitaire {
         return 206;
     }
 
+    int     SolitaireGame::MaxChanceOutcomes() const {
+        // kSetup and the reveal actions
+        return kRevealKd + 1;
+    }
+
     int     SolitaireGame::MaxGameLength() const {
         return 300;
     }
@@ -2,13 +2,12 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_SOLITAIRE_H
 
 #include <array>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
-#include <deque>
-#include <variant>
-#include <any>
-#include <unordered_map>
+#include <map>
 #include "open_spiel/spiel.h"
 
 namespace open_spiel::solitaire {
@@ -291,126 +290,63 @@ namespace open_spiel::solitaire {
         kMoveKdQc,
     };
 
-    enum Location {
-        kDeck       = 0,
-        kWaste      = 1,
-        kFoundation = 2,
-        kTableau    = 3,
-        kMissing    = 4,
-    };
-
-    // Support Classes =================================================================================================
-
-    class Card {
-    public:
-
-        // Attributes ==================================================================================================
-
-        std::string rank;       // Indicates the rank of the card, cannot be changed once set
-        std::string suit;       // Indicates the suit of the card, cannot be changed once set
-        bool        hidden;     // Indicates whether the card is hidden or not
-        Location    location;   // Indicates the type of pile the card is in
-
-        // Constructors ================================================================================================
-
-        Card();                                     // Create an empty card, default constructor
-        Card(std::string rank, std::string suit);   // Create a card from rank, suit, and hidden
-        explicit Card(int index);                   // Create a card from its index (e.g. 0 -> As)
-
-        // Type Casting ================================================================================================
-
-        explicit operator int() const;  // Represent a card as its integer index
-
-        // Operators ===================================================================================================
-
-        bool operator==(Card & other_card) const;                                   // Compare two cards for equality
-        bool operator==(const Card & other_card) const;
-
-        // Other Methods ===============================================================================================
-
-        std::vector<Card> LegalChildren() const;    // Get legal children of the card depending on its location
-        std::string ToString() const;
-
-    };
-
-    class Deck {
-    public:
-
-        // Attributes ==================================================================================================
-
-        std::deque<Card> cards;             // Holds the card current in the deck
-        std::deque<Card> waste;             // Holds the waste cards, the top of which can be played
-        std::deque<Card> initial_order;     // Holds the initial order of the deck, so that it can be rebuilt
-        int times_rebuilt = 0;                  // Number of times Rebuild() is called, used for score or terminality
-
-        // Constructors ================================================================================================
-
-        Deck();     // Default constructor
-
-        // Other Methods ===============================================================================================
-
-        std::vector<Card> Sources() const;      // Returns vector containing the top card of the waste pile
-        std::vector<Card> Split(Card card);     // Returns split card from waste
-        void draw(unsigned long num_cards);     // Moves cards to the waste
-        void rebuild();                         // Repopulates the deck in the order cards were originally drawn
-
-    };
-
-    class Foundation {
-    public:
-
-        // Attributes ==================================================================================================
-
-        const std::string suit;                         // Indicates the suit of cards that can be added
-        std::deque<Card>  cards;                        // Contains the cards inside the foundation
-
-        // Constructors ================================================================================================
-
-        Foundation();
-        explicit Foundation(std::string suit);          // Construct an empty foundation of a given suit
-
-        // Other Methods ===============================================================================================
-
-        std::vector<Card> Sources() const;              // Cards in the foundation that can be moved
-        std::vector<Card> Targets() const;              // A card in the foundation that can have cards moved to it
-
-        std::vector<Card> Split(Card card);             // Splits on given card and returns it and all cards beneath it
-        void Extend(const std::vector<Card>& source_cards);    // Adds cards to the foundation
-
-    };
-
-    class Tableau {
-    public:
-
-        // Attributes ==================================================================================================
-
-        std::deque<Card> cards;                     // Contains the cards inside the foundation
-
-        // Constructors ================================================================================================
-
-        Tableau();
-        explicit Tableau(int num_cards);            // Construct a tableau with the given cards
+    // Card Layout =====================================================================================================
+
+    // Cards are indexed from 0 (As) to 51 (Kd) as 13 * suit + rank, in the orders of SUITS and RANKS.
+    inline constexpr int kNumSuits  = 4;
+    inline constexpr int kNumRanks  = 13;
+    inline constexpr int kNumCards  = kNumSuits * kNumRanks;
+    inline constexpr int kHiddenCard = kNumCards;      // A card that has not been revealed yet
+
+    // The targets of moves to an empty tableau or foundation, used in place of a card.
+    inline constexpr int kEmptyTableau = -5;
+    constexpr int EmptyFoundation(int suit) { return -1 - suit; }
+
+    // The piles of a state. Their cards are laid out from the bottom of each pile in one flat array, in this order,
+    // each pile taking as many slots as it can ever hold. The top card of the waste and the next card drawn from the
+    // deck are the last of their piles.
+    inline constexpr int kNumTableaus     = 7;
+    inline constexpr int kNumFoundations  = kNumSuits;
+    inline constexpr int kFirstFoundation = kNumTableaus;
+    inline constexpr int kWaste           = kFirstFoundation + kNumFoundations;
+    inline constexpr int kDeck            = kWaste + 1;
+    inline constexpr int kNumPiles        = kDeck + 1;
+    inline constexpr int kNoPile          = -1;
+
+    inline constexpr int kMaxTableauSize    = 19;
+    inline constexpr int kMaxFoundationSize = kNumRanks;
+    inline constexpr int kMaxDeckSize       = 24;
+
+    constexpr bool IsTableau(int pile)    { return pile >= 0 and pile < kFirstFoundation; }
+    constexpr bool IsFoundation(int pile) { return pile >= kFirstFoundation and pile < kWaste; }
+
+    constexpr int PileCapacity(int pile) {
+        return IsTableau(pile) ? kMaxTableauSize : IsFoundation(pile) ? kMaxFoundationSize : kMaxDeckSize;
+    }
 
-        // Other Methods ===============================================================================================
+    constexpr int PileOffset(int pile) {
+        int offset = 0;
+        for (int i = 0; i < pile; ++i) {
+            offset += PileCapacity(i);
+        }
+        return offset;
+    }
 
-        std::vector<Card> Sources() const;                // Cards in the foundation that can be moved
-        std::vector<Card> Targets() const;                // A card in the foundation that can have cards moved to it
+    inline constexpr int kNumSlots = PileOffset(kNumPiles);
 
-        std::vector<Card> Split(Card card);       // Splits on given card and returns it and all cards beneath it
-        void Extend(const std::vector<Card>& source_cards);       // Adds cards to the foundation
-    };
+    // Support Classes =================================================================================================
 
     class Move {
     public:
 
         // Attributes ==================================================================================================
 
-        Card target;
-        Card source;
+        int target;     // The card to move onto, or kEmptyTableau or EmptyFoundation(suit)
+        int source;     // The card to move, along with the cards above it in its tableau
 
         // Constructors ================================================================================================
 
-        Move(Card target_card, Card source_card);
+        Move(int target_card, int source_card);
         explicit Move(Action action_id);
 
         // Other Methods ===============================================================================================
@@ -418,367 +354,6 @@ namespace open_spiel::solitaire {
         std::string ToString() const;
         Action      ActionId() const;
 
-
-    };
-
-    const std::map<std::pair<int, int>, Action> MOVE_TO_ACTION = {
-            //region Mapping of std::pair<int, int> where ints are card indices to an action declared in ActionType
-
-            // Special Moves ===========================================================================================
-            // To Empty Tableau ----------------------------------------------------------------------------------------
-            {{(int) Card("", ""), (int) Card("K", "s")}, kMove__Ks},
-            {{(int) Card("", ""), (int) Card("K", "h")}, kMove__Kh},
-            {{(int) Card("", ""), (int) Card("K", "c")}, kMove__Kc},
-            {{(int) Card("", ""), (int) Card("K", "d")}, kMove__Kd},
-
-            // To Empty Foundation -------------------------------------------------------------------------------------
-            {{(int) Card("", "h"), (int) Card("A", "h")}, kMove__Ah},
-            {{(int) Card("", "s"), (int) Card("A", "s")}, kMove__As},
-            {{(int) Card("", "c"), (int) Card("A", "c")}, kMove__Ac},
-            {{(int) Card("", "d"), (int) Card("A", "d")}, kMove__Ad},
-
-            // Foundation Moves ========================================================================================
-            // To Spades -----------------------------------------------------------------------------------------------
-            {{(int) Card("A", "s"), (int) Card("2", "s")}, kMoveAs2s},
-            {{(int) Card("2", "s"), (int) Card("3", "s")}, kMove2s3s},
-            {{(int) Card("3", "s"), (int) Card("4", "s")}, kMove3s4s},
-            {{(int) Card("4", "s"), (int) Card("5", "s")}, kMove4s5s},
-            {{(int) Card("5", "s"), (int) Card("6", "s")}, kMove5s6s},
-            {{(int) Card("6", "s"), (int) Card("7", "s")}, kMove6s7s},
-            {{(int) Card("7", "s"), (int) Card("8", "s")}, kMove7s8s},
-            {{(int) Card("8", "s"), (int) Card("9", "s")}, kMove8s9s},
-            {{(int) Card("9", "s"), (int) Card("T", "s")}, kMove9sTs},
-            {{(int) Card("T", "s"), (int) Card("J", "s")}, kMoveTsJs},
-            {{(int) Card("J", "s"), (int) Card("Q", "s")}, kMoveJsQs},
-            {{(int) Card("Q", "s"), (int) Card("K", "s")}, kMoveQsKs},
-
-            // To Hearts -----------------------------------------------------------------------------------------------
-            {{(int) Card("A", "h"), (int) Card("2", "h")}, kMoveAh2h},
-            {{(int) Card("2", "h"), (int) Card("3", "h")}, kMove2h3h},
-            {{(int) Card("3", "h"), (int) Card("4", "h")}, kMove3h4h},
-            {{(int) Card("4", "h"), (int) Card("5", "h")}, kMove4h5h},
-            {{(int) Card("5", "h"), (int) Card("6", "h")}, kMove5h6h},
-            {{(int) Card("6", "h"), (int) Card("7", "h")}, kMove6h7h},
-            {{(int) Card("7", "h"), (int) Card("8", "h")}, kMove7h8h},
-            {{(int) Card("8", "h"), (int) Card("9", "h")}, kMove8h9h},
-            {{(int) Card("9", "h"), (int) Card("T", "h")}, kMove9hTh},
-            {{(int) Card("T", "h"), (int) Card("J", "h")}, kMoveThJh},
-            {{(int) Card("J", "h"), (int) Card("Q", "h")}, kMoveJhQh},
-            {{(int) Card("Q", "h"), (int) Card("K", "h")}, kMoveQhKh},
-
-            // To Clubs ------------------------------------------------------------------------------------------------
-            {{(int) Card("A", "c"), (int) Card("2", "c")}, kMoveAc2c},
-            {{(int) Card("2", "c"), (int) Card("3", "c")}, kMove2c3c},
-            {{(int) Card("3", "c"), (int) Card("4", "c")}, kMove3c4c},
-            {{(int) Card("4", "c"), (int) Card("5", "c")}, kMove4c5c},
-            {{(int) Card("5", "c"), (int) Card("6", "c")}, kMove5c6c},
-            {{(int) Card("6", "c"), (int) Card("7", "c")}, kMove6c7c},
-            {{(int) Card("7", "c"), (int) Card("8", "c")}, kMove7c8c},
-            {{(int) Card("8", "c"), (int) Card("9", "c")}, kMove8c9c},
-            {{(int) Card("9", "c"), (int) Card("T", "c")}, kMove9cTc},
-            {{(int) Card("T", "c"), (int) Card("J", "c")}, kMoveTcJc},
-            {{(int) Card("J", "c"), (int) Card("Q", "c")}, kMoveJcQc},
-            {{(int) Card("Q", "c"), (int) Card("K", "c")}, kMoveQcKc},
-
-            // To Diamonds ---------------------------------------------------------------------------------------------
-            {{(int) Card("A", "d"), (int) Card("2", "d")}, kMoveAd2d},
-            {{(int) Card("2", "d"), (int) Card("3", "d")}, kMove2d3d},
-            {{(int) Card("3", "d"), (int) Card("4", "d")}, kMove3d4d},
-            {{(int) Card("4", "d"), (int) Card("5", "d")}, kMove4d5d},
-            {{(int) Card("5", "d"), (int) Card("6", "d")}, kMove5d6d},
-            {{(int) Card("6", "d"), (int) Card("7", "d")}, kMove6d7d},
-            {{(int) Card("7", "d"), (int) Card("8", "d")}, kMove7d8d},
-            {{(int) Card("8", "d"), (int) Card("9", "d")}, kMove8d9d},
-            {{(int) Card("9", "d"), (int) Card("T", "d")}, kMove9dTd},
-            {{(int) Card("T", "d"), (int) Card("J", "d")}, kMoveTdJd},
-            {{(int) Card("J", "d"), (int) Card("Q", "d")}, kMoveJdQd},
-            {{(int) Card("Q", "d"), (int) Card("K", "d")}, kMoveQdKd},
-
-            // Tableau Moves ===========================================================================================
-            // To Spades -----------------------------------------------------------------------------------------------
-            {{(int) Card("2", "s"), (int) Card("A", "h")}, kMove2sAh},
-            {{(int) Card("3", "s"), (int) Card("2", "h")}, kMove3s2h},
-            {{(int) Card("4", "s"), (int) Card("3", "h")}, kMove4s3h},
-            {{(int) Card("5", "s"), (int) Card("4", "h")}, kMove5s4h},
-            {{(int) Card("6", "s"), (int) Card("5", "h")}, kMove6s5h},
-            {{(int) Card("7", "s"), (int) Card("6", "h")}, kMove7s6h},
-            {{(int) Card("8", "s"), (int) Card("7", "h")}, kMove8s7h},
-            {{(int) Card("9", "s"), (int) Card("8", "h")}, kMove9s8h},
-            {{(int) Card("T", "s"), (int) Card("9", "h")}, kMoveTs9h},
-            {{(int) Card("J", "s"), (int) Card("T", "h")}, kMoveJsTh},
-            {{(int) Card("Q", "s"), (int) Card("J", "h")}, kMoveQsJh},
-            {{(int) Card("K", "s"), (int) Card("Q", "h")}, kMoveKsQh},
-            {{(int) Card("2", "s"), (int) Card("A", "d")}, kMove2sAd},
-            {{(int) Card("3", "s"), (int) Card("2", "d")}, kMove3s2d},
-            {{(int) Card("4", "s"), (int) Card("3", "d")}, kMove4s3d},
-            {{(int) Card("5", "s"), (int) Card("4", "d")}, kMove5s4d},
-            {{(int) Card("6", "s"), (int) Card("5", "d")}, kMove6s5d},
-            {{(int) Card("7", "s"), (int) Card("6", "d")}, kMove7s6d},
-            {{(int) Card("8", "s"), (int) Card("7", "d")}, kMove8s7d},
-            {{(int) Card("9", "s"), (int) Card("8", "d")}, kMove9s8d},
-            {{(int) Card("T", "s"), (int) Card("9", "d")}, kMoveTs9d},
-            {{(int) Card("J", "s"), (int) Card("T", "d")}, kMoveJsTd},
-            {{(int) Card("Q", "s"), (int) Card("J", "d")}, kMoveQsJd},
-            {{(int) Card("K", "s"), (int) Card("Q", "d")}, kMoveKsQd},
-
-            // To Hearts -----------------------------------------------------------------------------------------------
-            {{(int) Card("2", "h"), (int) Card("A", "s")}, kMove2hAs},
-            {{(int) Card("3", "h"), (int) Card("2", "s")}, kMove3h2s},
-            {{(int) Card("4", "h"), (int) Card("3", "s")}, kMove4h3s},
-            {{(int) Card("5", "h"), (int) Card("4", "s")}, kMove5h4s},
-            {{(int) Card("6", "h"), (int) Card("5", "s")}, kMove6h5s},
-            {{(int) Card("7", "h"), (int) Card("6", "s")}, kMove7h6s},
-            {{(int) Card("8", "h"), (int) Card("7", "s")}, kMove8h7s},
-            {{(int) Card("9", "h"), (int) Card("8", "s")}, kMove9h8s},
-            {{(int) Card("T", "h"), (int) Card("9", "s")}, kMoveTh9s},
-            {{(int) Card("J", "h"), (int) Card("T", "s")}, kMoveJhTs},
-            {{(int) Card("Q", "h"), (int) Card("J", "s")}, kMoveQhJs},
-            {{(int) Card("K", "h"), (int) Card("Q", "s")}, kMoveKhQs},
-            {{(int) Card("2", "h"), (int) Card("A", "c")}, kMove2hAc},
-            {{(int) Card("3", "h"), (int) Card("2", "c")}, kMove3h2c},
-            {{(int) Card("4", "h"), (int) Card("3", "c")}, kMove4h3c},
-            {{(int) Card("5", "h"), (int) Card("4", "c")}, kMove5h4c},
-            {{(int) Card("6", "h"), (int) Card("5", "c")}, kMove6h5c},
-            {{(int) Card("7", "h"), (int) Card("6", "c")}, kMove7h6c},
-            {{(int) Card("8", "h"), (int) Card("7", "c")}, kMove8h7c},
-            {{(int) Card("9", "h"), (int) Card("8", "c")}, kMove9h8c},
-            {{(int) Card("T", "h"), (int) Card("9", "c")}, kMoveTh9c},
-            {{(int) Card("J", "h"), (int) Card("T", "c")}, kMoveJhTc},
-            {{(int) Card("Q", "h"), (int) Card("J", "c")}, kMoveQhJc},
-            {{(int) Card("K", "h"), (int) Card("Q", "c")}, kMoveKhQc},
-
-            // To Clubs ------------------------------------------------------------------------------------------------
-            {{(int) Card("2", "c"), (int) Card("A", "h")}, kMove2cAh},
-            {{(int) Card("3", "c"), (int) Card("2", "h")}, kMove3c2h},
-            {{(int) Card("4", "c"), (int) Card("3", "h")}, kMove4c3h},
-            {{(int) Card("5", "c"), (int) Card("4", "h")}, kMove5c4h},
-            {{(int) Card("6", "c"), (int) Card("5", "h")}, kMove6c5h},
-            {{(int) Card("7", "c"), (int) Card("6", "h")}, kMove7c6h},
-            {{(int) Card("8", "c"), (int) Card("7", "h")}, kMove8c7h},
-            {{(int) Card("9", "c"), (int) Card("8", "h")}, kMove9c8h},
-            {{(int) Card("T", "c"), (int) Card("9", "h")}, kMoveTc9h},
-            {{(int) Card("J", "c"), (int) Card("T", "h")}, kMoveJcTh},
-            {{(int) Card("Q", "c"), (int) Card("J", "h")}, kMoveQcJh},
-            {{(int) Card("K", "c"), (int) Card("Q", "h")}, kMoveKcQh},
-            {{(int) Card("2", "c"), (int) Card("A", "d")}, kMove2cAd},
-            {{(int) Card("3", "c"), (int) Card("2", "d")}, kMove3c2d},
-            {{(int) Card("4", "c"), (int) Card("3", "d")}, kMove4c3d},
-            {{(int) Card("5", "c"), (int) Card("4", "d")}, kMove5c4d},
-            {{(int) Card("6", "c"), (int) Card("5", "d")}, kMove6c5d},
-            {{(int) Card("7", "c"), (int) Card("6", "d")}, kMove7c6d},
-            {{(int) Card("8", "c"), (int) Card("7", "d")}, kMove8c7d},
-            {{(int) Card("9", "c"), (int) Card("8", "d")}, kMove9c8d},
-            {{(int) Card("T", "c"), (int) Card("9", "d")}, kMoveTc9d},
-            {{(int) Card("J", "c"), (int) Card("T", "d")}, kMoveJcTd},
-            {{(int) Card("Q", "c"), (int) Card("J", "d")}, kMoveQcJd},
-            {{(int) Card("K", "c"), (int) Card("Q", "d")}, kMoveKcQd},
-
-            // To Diamonds ---------------------------------------------------------------------------------------------
-            {{(int) Card("2", "d"), (int) Card("A", "s")}, kMove2dAs},
-            {{(int) Card("3", "d"), (int) Card("2", "s")}, kMove3d2s},
-            {{(int) Card("4", "d"), (int) Card("3", "s")}, kMove4d3s},
-            {{(int) Card("5", "d"), (int) Card("4", "s")}, kMove5d4s},
-            {{(int) Card("6", "d"), (int) Card("5", "s")}, kMove6d5s},
-            {{(int) Card("7", "d"), (int) Card("6", "s")}, kMove7d6s},
-            {{(int) Card("8", "d"), (int) Card("7", "s")}, kMove8d7s},
-            {{(int) Card("9", "d"), (int) Card("8", "s")}, kMove9d8s},
-            {{(int) Card("T", "d"), (int) Card("9", "s")}, kMoveTd9s},
-            {{(int) Card("J", "d"), (int) Card("T", "s")}, kMoveJdTs},
-            {{(int) Card("Q", "d"), (int) Card("J", "s")}, kMoveQdJs},
-            {{(int) Card("K", "d"), (int) Card("Q", "s")}, kMoveKdQs},
-            {{(int) Card("2", "d"), (int) Card("A", "c")}, kMove2dAc},
-            {{(int) Card("3", "d"), (int) Card("2", "c")}, kMove3d2c},
-            {{(int) Card("4", "d"), (int) Card("3", "c")}, kMove4d3c},
-            {{(int) Card("5", "d"), (int) Card("4", "c")}, kMove5d4c},
-            {{(int) Card("6", "d"), (int) Card("5", "c")}, kMove6d5c},
-            {{(int) Card("7", "d"), (int) Card("6", "c")}, kMove7d6c},
-            {{(int) Card("8", "d"), (int) Card("7", "c")}, kMove8d7c},
-            {{(int) Card("9", "d"), (int) Card("8", "c")}, kMove9d8c},
-            {{(int) Card("T", "d"), (int) Card("9", "c")}, kMoveTd9c},
-            {{(int) Card("J", "d"), (int) Card("T", "c")}, kMoveJdTc},
-            {{(int) Card("Q", "d"), (int) Card("J", "c")}, kMoveQdJc},
-            {{(int) Card("K", "d"), (int) Card("Q", "c")}, kMoveKdQc},
-            //endregion
-    };
-
-    const std::map<Action, std::pair<int, int>> ACTION_TO_MOVE = {
-            //region Mapping of Action to a std::pair<int, int>, representing target & source card indices
-
-            // Special Moves ===============================================================================================
-            // To Empty Tableau --------------------------------------------------------------------------------------------
-            {kMove__Ks, {(int) Card("", ""), (int) Card("K", "s")}},
-            {kMove__Kh, {(int) Card("", ""), (int) Card("K", "h")}},
-            {kMove__Kc, {(int) Card("", ""), (int) Card("K", "c")}},
-            {kMove__Kd, {(int) Card("", ""), (int) Card("K", "d")}},
-
-            // To Empty Foundation -------------------------------------------------------------------------------------
-            {kMove__Ah, {(int) Card("", "h"), (int) Card("A", "h")}},
-            {kMove__As, {(int) Card("", "s"), (int) Card("A", "s")}},
-            {kMove__Ac, {(int) Card("", "c"), (int) Card("A", "c")}}, // <-----
-            {kMove__Ad, {(int) Card("", "d"), (int) Card("A", "d")}},
-
-            // Foundation Moves ========================================================================================
-            // To Spades -----------------------------------------------------------------------------------------------
-            {kMoveAs2s, {(int) Card("A", "s"), (int) Card("2", "s")}},
-            {kMove2s3s, {(int) Card("2", "s"), (int) Card("3", "s")}},
-            {kMove3s4s, {(int) Card("3", "s"), (int) Card("4", "s")}},
-            {kMove4s5s, {(int) Card("4", "s"), (int) Card("5", "s")}},
-            {kMove5s6s, {(int) Card("5", "s"), (int) Card("6", "s")}},
-            {kMove6s7s, {(int) Card("6", "s"), (int) Card("7", "s")}},
-            {kMove7s8s, {(int) Card("7", "s"), (int) Card("8", "s")}},
-            {kMove8s9s, {(int) Card("8", "s"), (int) Card("9", "s")}},
-            {kMove9sTs, {(int) Card("9", "s"), (int) Card("T", "s")}},
-            {kMoveTsJs, {(int) Card("T", "s"), (int) Card("J", "s")}},
-            {kMoveJsQs, {(int) Card("J", "s"), (int) Card("Q", "s")}},
-            {kMoveQsKs, {(int) Card("Q", "s"), (int) Card("K", "s")}},
-
-            // To Hearts -----------------------------------------------------------------------------------------------
-            {kMoveAh2h, {(int) Card("A", "h"), (int) Card("2", "h")}},
-            {kMove2h3h, {(int) Card("2", "h"), (int) Card("3", "h")}},
-            {kMove3h4h, {(int) Card("3", "h"), (int) Card("4", "h")}},
-            {kMove4h5h, {(int) Card("4", "h"), (int) Card("5", "h")}},
-            {kMove5h6h, {(int) Card("5", "h"), (int) Card("6", "h")}},
-            {kMove6h7h, {(int) Card("6", "h"), (int) Card("7", "h")}},
-            {kMove7h8h, {(int) Card("7", "h"), (int) Card("8", "h")}},
-            {kMove8h9h, {(int) Card("8", "h"), (int) Card("9", "h")}},
-            {kMove9hTh, {(int) Card("9", "h"), (int) Card("T", "h")}},
-            {kMoveThJh, {(int) Card("T", "h"), (int) Card("J", "h")}},
-            {kMoveJhQh, {(int) Card("J", "h"), (int) Card("Q", "h")}},
-            {kMoveQhKh, {(int) Card("Q", "h"), (int) Card("K", "h")}},
-
-            // To Clubs ------------------------------------------------------------------------------------------------
-            {kMoveAc2c, {(int) Card("A", "c"), (int) Card("2", "c")}},
-            {kMove2c3c, {(int) Card("2", "c"), (int) Card("3", "c")}},
-            {kMove3c4c, {(int) Card("3", "c"), (int) Card("4", "c")}},
-            {kMove4c5c, {(int) Card("4", "c"), (int) Card("5", "c")}},
-            {kMove5c6c, {(int) Card("5", "c"), (int) Card("6", "c")}},
-            {kMove6c7c, {(int) Card("6", "c"), (int) Card("7", "c")}},
-            {kMove7c8c, {(int) Card("7", "c"), (int) Card("8", "c")}},
-            {kMove8c9c, {(int) Card("8", "c"), (int) Card("9", "c")}},
-            {kMove9cTc, {(int) Card("9", "c"), (int) Card("T", "c")}},
-            {kMoveTcJc, {(int) Card("T", "c"), (int) Card("J", "c")}},
-            {kMoveJcQc, {(int) Card("J", "c"), (int) Card("Q", "c")}},
-            {kMoveQcKc, {(int) Card("Q", "c"), (int) Card("K", "c")}},
-
-            // To Diamonds ---------------------------------------------------------------------------------------------
-            {kMoveAd2d, {(int) Card("A", "d"), (int) Card("2", "d")}},
-            {kMove2d3d, {(int) Card("2", "d"), (int) Card("3", "d")}},
-            {kMove3d4d, {(int) Card("3", "d"), (int) Card("4", "d")}},
-            {kMove4d5d, {(int) Card("4", "d"), (int) Card("5", "d")}},
-            {kMove5d6d, {(int) Card("5", "d"), (int) Card("6", "d")}},
-            {kMove6d7d, {(int) Card("6", "d"), (int) Card("7", "d")}},
-            {kMove7d8d, {(int) Card("7", "d"), (int) Card("8", "d")}},
-            {kMove8d9d, {(int) Card("8", "d"), (int) Card("9", "d")}},
-            {kMove9dTd, {(int) Card("9", "d"), (int) Card("T", "d")}},
-            {kMoveTdJd, {(int) Card("T", "d"), (int) Card("J", "d")}},
-            {kMoveJdQd, {(int) Card("J", "d"), (int) Card("Q", "d")}},
-            {kMoveQdKd, {(int) Card("Q", "d"), (int) Card("K", "d")}},
-
-            // Tableau Moves ===========================================================================================
-            // To Spades -----------------------------------------------------------------------------------------------
-            {kMove2sAh, {(int) Card("2", "s"), (int) Card("A", "h")}},
-            {kMove3s2h, {(int) Card("3", "s"), (int) Card("2", "h")}},
-            {kMove4s3h, {(int) Card("4", "s"), (int) Card("3", "h")}},
-            {kMove5s4h, {(int) Card("5", "s"), (int) Card("4", "h")}},
-            {kMove6s5h, {(int) Card("6", "s"), (int) Card("5", "h")}},
-            {kMove7s6h, {(int) Card("7", "s"), (int) Card("6", "h")}},
-            {kMove8s7h, {(int) Card("8", "s"), (int) Card("7", "h")}},
-            {kMove9s8h, {(int) Card("9", "s"), (int) Card("8", "h")}},
-            {kMoveTs9h, {(int) Card("T", "s"), (int) Card("9", "h")}},
-            {kMoveJsTh, {(int) Card("J", "s"), (int) Card("T", "h")}},
-            {kMoveQsJh, {(int) Card("Q", "s"), (int) Card("J", "h")}},
-            {kMoveKsQh, {(int) Card("K", "s"), (int) Card("Q", "h")}},
-            {kMove2sAd, {(int) Card("2", "s"), (int) Card("A", "d")}},
-            {kMove3s2d, {(int) Card("3", "s"), (int) Card("2", "d")}},
-            {kMove4s3d, {(int) Card("4", "s"), (int) Card("3", "d")}},
-            {kMove5s4d, {(int) Card("5", "s"), (int) Card("4", "d")}},
-            {kMove6s5d, {(int) Card("6", "s"), (int) Card("5", "d")}},
-            {kMove7s6d, {(int) Card("7", "s"), (int) Card("6", "d")}},
-            {kMove8s7d, {(int) Card("8", "s"), (int) Card("7", "d")}},
-            {kMove9s8d, {(int) Card("9", "s"), (int) Card("8", "d")}},
-            {kMoveTs9d, {(int) Card("T", "s"), (int) Card("9", "d")}},
-            {kMoveJsTd, {(int) Card("J", "s"), (int) Card("T", "d")}},
-            {kMoveQsJd, {(int) Card("Q", "s"), (int) Card("J", "d")}},
-            {kMoveKsQd, {(int) Card("K", "s"), (int) Card("Q", "d")}},
-
-            // To Hearts -----------------------------------------------------------------------------------------------
-            {kMove2hAs, {(int) Card("2", "h"), (int) Card("A", "s")}},
-            {kMove3h2s, {(int) Card("3", "h"), (int) Card("2", "s")}},
-            {kMove4h3s, {(int) Card("4", "h"), (int) Card("3", "s")}},
-            {kMove5h4s, {(int) Card("5", "h"), (int) Card("4", "s")}},
-            {kMove6h5s, {(int) Card("6", "h"), (int) Card("5", "s")}},
-            {kMove7h6s, {(int) Card("7", "h"), (int) Card("6", "s")}},
-            {kMove8h7s, {(int) Card("8", "h"), (int) Card("7", "s")}},
-            {kMove9h8s, {(int) Card("9", "h"), (int) Card("8", "s")}},
-            {kMoveTh9s, {(int) Card("T", "h"), (int) Card("9", "s")}},
-            {kMoveJhTs, {(int) Card("J", "h"), (int) Card("T", "s")}},
-            {kMoveQhJs, {(int) Card("Q", "h"), (int) Card("J", "s")}},
-            {kMoveKhQs, {(int) Card("K", "h"), (int) Card("Q", "s")}},
-            {kMove2hAc, {(int) Card("2", "h"), (int) Card("A", "c")}},
-            {kMove3h2c, {(int) Card("3", "h"), (int) Card("2", "c")}},
-            {kMove4h3c, {(int) Card("4", "h"), (int) Card("3", "c")}},
-            {kMove5h4c, {(int) Card("5", "h"), (int) Card("4", "c")}},
-            {kMove6h5c, {(int) Card("6", "h"), (int) Card("5", "c")}},
-            {kMove7h6c, {(int) Card("7", "h"), (int) Card("6", "c")}},
-            {kMove8h7c, {(int) Card("8", "h"), (int) Card("7", "c")}},
-            {kMove9h8c, {(int) Card("9", "h"), (int) Card("8", "c")}},
-            {kMoveTh9c, {(int) Card("T", "h"), (int) Card("9", "c")}},
-            {kMoveJhTc, {(int) Card("J", "h"), (int) Card("T", "c")}},
-            {kMoveQhJc, {(int) Card("Q", "h"), (int) Card("J", "c")}},
-            {kMoveKhQc, {(int) Card("K", "h"), (int) Card("Q", "c")}},
-
-            // To Clubs ------------------------------------------------------------------------------------------------
-            {kMove2cAh, {(int) Card("2", "c"), (int) Card("A", "h")}},
-            {kMove3c2h, {(int) Card("3", "c"), (int) Card("2", "h")}},
-            {kMove4c3h, {(int) Card("4", "c"), (int) Card("3", "h")}},
-            {kMove5c4h, {(int) Card("5", "c"), (int) Card("4", "h")}},
-            {kMove6c5h, {(int) Card("6", "c"), (int) Card("5", "h")}},
-            {kMove7c6h, {(int) Card("7", "c"), (int) Card("6", "h")}},
-            {kMove8c7h, {(int) Card("8", "c"), (int) Card("7", "h")}},
-            {kMove9c8h, {(int) Card("9", "c"), (int) Card("8", "h")}},
-            {kMoveTc9h, {(int) Card("T", "c"), (int) Card("9", "h")}},
-            {kMoveJcTh, {(int) Card("J", "c"), (int) Card("T", "h")}},
-            {kMoveQcJh, {(int) Card("Q", "c"), (int) Card("J", "h")}},
-            {kMoveKcQh, {(int) Card("K", "c"), (int) Card("Q", "h")}},
-            {kMove2cAd, {(int) Card("2", "c"), (int) Card("A", "d")}},
-            {kMove3c2d, {(int) Card("3", "c"), (int) Card("2", "d")}},
-            {kMove4c3d, {(int) Card("4", "c"), (int) Card("3", "d")}},
-            {kMove5c4d, {(int) Card("5", "c"), (int) Card("4", "d")}},
-            {kMove6c5d, {(int) Card("6", "c"), (int) Card("5", "d")}},
-            {kMove7c6d, {(int) Card("7", "c"), (int) Card("6", "d")}},
-            {kMove8c7d, {(int) Card("8", "c"), (int) Card("7", "d")}},
-            {kMove9c8d, {(int) Card("9", "c"), (int) Card("8", "d")}},
-            {kMoveTc9d, {(int) Card("T", "c"), (int) Card("9", "d")}},
-            {kMoveJcTd, {(int) Card("J", "c"), (int) Card("T", "d")}},
-            {kMoveQcJd, {(int) Card("Q", "c"), (int) Card("J", "d")}},
-            {kMoveKcQd, {(int) Card("K", "c"), (int) Card("Q", "d")}},
-
-            // To Diamonds ---------------------------------------------------------------------------------------------
-            {kMove2dAs, {(int) Card("2", "d"), (int) Card("A", "s")}},
-            {kMove3d2s, {(int) Card("3", "d"), (int) Card("2", "s")}},
-            {kMove4d3s, {(int) Card("4", "d"), (int) Card("3", "s")}},
-            {kMove5d4s, {(int) Card("5", "d"), (int) Card("4", "s")}},
-            {kMove6d5s, {(int) Card("6", "d"), (int) Card("5", "s")}},
-            {kMove7d6s, {(int) Card("7", "d"), (int) Card("6", "s")}},
-            {kMove8d7s, {(int) Card("8", "d"), (int) Card("7", "s")}},
-            {kMove9d8s, {(int) Card("9", "d"), (int) Card("8", "s")}},
-            {kMoveTd9s, {(int) Card("T", "d"), (int) Card("9", "s")}},
-            {kMoveJdTs, {(int) Card("J", "d"), (int) Card("T", "s")}},
-            {kMoveQdJs, {(int) Card("Q", "d"), (int) Card("J", "s")}},
-            {kMoveKdQs, {(int) Card("K", "d"), (int) Card("Q", "s")}},
-            {kMove2dAc, {(int) Card("2", "d"), (int) Card("A", "c")}},
-            {kMove3d2c, {(int) Card("3", "d"), (int) Card("2", "c")}},
-            {kMove4d3c, {(int) Card("4", "d"), (int) Card("3", "c")}},
-            {kMove5d4c, {(int) Card("5", "d"), (int) Card("4", "c")}},
-            {kMove6d5c, {(int) Card("6", "d"), (int) Card("5", "c")}},
-            {kMove7d6c, {(int) Card("7", "d"), (int) Card("6", "c")}},
-            {kMove8d7c, {(int) Card("8", "d"), (int) Card("7", "c")}},
-            {kMove9d8c, {(int) Card("9", "d"), (int) Card("8", "c")}},
-            {kMoveTd9c, {(int) Card("T", "d"), (int) Card("9", "c")}},
-            {kMoveJdTc, {(int) Card("J", "d"), (int) Card("T", "c")}},
-            {kMoveQdJc, {(int) Card("Q", "d"), (int) Card("J", "c")}},
-            {kMoveKdQc, {(int) Card("K", "d"), (int) Card("Q", "c")}},
-            //endregion
     };
 
     // OpenSpiel Classes ===============================================================================================
@@ -788,13 +363,6 @@ namespace open_spiel::solitaire {
     class SolitaireState : public State {
     public:
 
-        // Attributes ==================================================================================================
-
-        Deck                    deck;
-        std::vector<Foundation> foundations;
-        std::vector<Tableau>    tableaus;
-        std::vector<Action>     revealed_cards;
-
         // Constructors ================================================================================================
 
         explicit SolitaireState(std::shared_ptr<const Game> game);
@@ -819,20 +387,39 @@ namespace open_spiel::solitaire {
 
         // Other Methods ===============================================================================================
 
-        std::vector<Card>      Targets(const std::optional<std::string> & location = {}) const;
-        std::vector<Card>      Sources(const std::optional<std::string> & location = {}) const;
-        std::vector<Move>      CandidateMoves() const;
-        Tableau *              FindTableau(const Card & card) const;
-        Foundation *           FindFoundation(const Card & card) const;
-        Location               FindLocation(const Card & card) const;
-        void                   MoveCards(const Move & move);
-        bool                   IsOverHidden(const Card & card) const;
+        // Calls `yield` on the moves of sources onto targets that fit them, by target (the tableaus, then the
+        // foundations) and child card, allowed or not by IsReversible, until it returns false.
+        using MoveYieldFn = std::function<bool(const Move &)>;
+        void                   GenerateMoves(const MoveYieldFn & yield) const;
         bool                   IsReversible(const Move & move) const;
-        bool                   IsBottomCard(Card card) const;
-        bool                   IsTopCard(const Card & card) const;
         bool                   IsSolvable() const;
 
+        int                    PileSize(int pile) const { return pile_sizes_[pile]; }
+        // The i-th card of a pile from its bottom, which may be kHiddenCard.
+        int                    PileCard(int pile, int i) const { return cards_[PileOffset(pile) + i]; }
+        // The pile of a revealed card, or kNoPile.
+        int                    CardPile(int card) const { return card_piles_[card]; }
+
     private:
+
+        int                    TopCard(int pile) const { return PileCard(pile, pile_sizes_[pile] - 1); }
+        int                    TargetPile(int target) const;
+        bool                   IsMoveSource(int card) const;
+        void                   PushCard(int pile, int card);
+        void                   MoveCards(const Move & move);
+        void                   Rebuild();
+        void                   Draw(int num_cards);
+        int                    NumLegalActions() const;
+        std::string            PilesString(bool show_order) const;
+
+        std::array<int8_t, kNumSlots>    cards_;
+        std::array<int8_t, kNumPiles>    pile_sizes_ = {};
+        std::array<int8_t, kNumCards>    card_piles_;           // By revealed card, or kNoPile
+        std::array<int8_t, kNumCards>    card_slots_;           // The index of each revealed card in its pile
+        std::array<int8_t, kMaxDeckSize> initial_order_;        // The waste cards in the order they were revealed
+        int                              initial_order_size_ = 0;
+        uint64_t                         revealed_cards_ = 0;   // The mask of the revealed cards
+
         bool   is_setup;
         bool   is_started = false;
         bool   is_finished = false;
@@ -852,6 +439,7 @@ namespace open_spiel::solitaire {
         // Overriden Methods ===========================================================================================
 
         int     NumDistinctActions() const override;
+        int     MaxChanceOutcomes() const override;
         int     MaxGameLength() const override;
         int     NumPlayers() const override;
         double  MinUtility() const override;
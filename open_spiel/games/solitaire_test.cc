@@ -1,4 +1,9 @@
+#include "open_spiel/games/solitaire.h"
+
+#include <algorithm>
+
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel::solitaire {
@@ -6,17 +11,70 @@ namespace {
 
     namespace testing = open_spiel::testing;
 
-    /*
     void BasicSolitaireTests() {
         // Tests that the game can be loaded (i.e. LoadGame doesn't return nullptr)
         testing::LoadGameTest("solitaire");
 
         // Tests that there are chance outcomes
         testing::ChanceOutcomesTest(*LoadGame("solitaire"));
+
+        testing::RandomSimTest(*LoadGame("solitaire"), 10);
+    }
+
+    void MoveActionsTest() {
+        // Moves and their action ids convert back and forth
+        for (Action action = kMove__Ks; action <= kMoveKdQc; ++action) {
+            SPIEL_CHECK_EQ(Move(action).ActionId(), action);
+        }
+        SPIEL_CHECK_EQ(Move(kEmptyTableau, 12).ActionId(), kMove__Ks);
+        SPIEL_CHECK_EQ(Move(EmptyFoundation(1), 13).ActionId(), kMove__Ah);
+        SPIEL_CHECK_EQ(Move(46, 47).ActionId(), kMove8d9d);
+        SPIEL_CHECK_EQ(Move(1, 13).ActionId(), kMove2sAh);
+        SPIEL_CHECK_EQ(Move(51, 37).ActionId(), kMoveKdQc);
+    }
+
+    void PilesTest() {
+        std::shared_ptr<const Game> game = LoadGame("solitaire");
+        std::unique_ptr<State> state = game->NewInitialState();
+        state->ApplyAction(kSetup);
+
+        // Reveals the top card of each tableau, from the first
+        for (Action action = kRevealAs; action < kRevealAs + kNumTableaus; ++action) {
+            state->ApplyAction(action);
+        }
+        SPIEL_CHECK_EQ(state->CurrentPlayer(), 0);
+
+        const auto & solitaire_state = static_cast<const SolitaireState &>(*state);
+        for (int tableau = 0; tableau < kNumTableaus; ++tableau) {
+            SPIEL_CHECK_EQ(solitaire_state.PileSize(tableau), tableau + 1);
+            SPIEL_CHECK_EQ(solitaire_state.PileCard(tableau, tableau), tableau);
+            SPIEL_CHECK_EQ(solitaire_state.CardPile(tableau), tableau);
+        }
+        SPIEL_CHECK_EQ(solitaire_state.PileSize(kDeck), kMaxDeckSize);
+
+        // The first card drawn is on top of the waste
+        state->ApplyAction(kDraw);
+        for (Action action = kRevealKd; action > kRevealKd - 3; --action) {
+            state->ApplyAction(action);
+        }
+        SPIEL_CHECK_EQ(solitaire_state.PileSize(kWaste), 3);
+        SPIEL_CHECK_EQ(solitaire_state.PileCard(kWaste, 2), kNumCards - 1);
+        SPIEL_CHECK_EQ(solitaire_state.PileCard(kWaste, 0), kNumCards - 3);
+
+        // The As is moved to its foundation from the bottom of the first tableau, which can't be reversed
+        const std::vector<Action> legal_actions = state->LegalActions();
+        SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(), kMove__As) != legal_actions.end());
+        state->ApplyAction(kMove__As);
+        SPIEL_CHECK_EQ(solitaire_state.CardPile(0), kFirstFoundation);
+        SPIEL_CHECK_EQ(solitaire_state.PileSize(0), 0);
+        SPIEL_CHECK_EQ(state->Returns()[0], 100.0);
     }
-    */
 
 } // namespace
 } // namespace open_spiel::solitaire
 
-// int main(int argc, char** argv) { open_spiel::solitaire::BasicSolitaireTests(); }
\ No newline at end of file
+int main(int argc, char** argv) {
+    open_spiel::solitaire::BasicSolitaireTests();
+    open_spiel::solitaire::MoveActionsTest();
+    open_spiel::solitaire::PilesTest();
+}
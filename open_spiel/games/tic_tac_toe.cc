@@ -50,6 +50,11 @@ std::shared_ptr<const Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// Zobrist key of a (non-empty) cell state, used to update the hash
+// incrementally.
+uint64_t CellKey(int cell, CellState state) {
+  return HashMix(cell * kCellStates + static_cast<int>(state));
+}
 }  // namespace
 
 CellState PlayerToState(Player player) {
@@ -80,6 +85,7 @@ std::string StateToString(CellState state) {
 void TicTacToeState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(board_[move], CellState::kEmpty);
   board_[move] = PlayerToState(CurrentPlayer());
+  hash_ ^= CellKey(move, board_[move]);
   if (HasLine(current_player_)) {
     outcome_ = current_player_;
   }
@@ -141,13 +147,15 @@ bool TicTacToeState::IsTerminal() const {
 }
 
 std::vector<double> TicTacToeState::Returns() const {
-  if (outcome_ == Player{0}) {
-    return {1.0, -1.0};
-  } else if (outcome_ == Player{1}) {
-    return {-1.0, 1.0};
-  } else {
-    return {0.0, 0.0};
-  }
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void TicTacToeState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  returns[0] = outcome_ == Player{0} ? 1.0 : outcome_ == Player{1} ? -1.0 : 0.0;
+  returns[1] = outcome_ == Player{1} ? 1.0 : outcome_ == Player{0} ? -1.0 : 0.0;
 }
 
 std::string TicTacToeState::InformationStateString(Player player) const {
@@ -160,6 +168,14 @@ std::string TicTacToeState::ObservationString(Player player) const {
   return ToString();
 }
 
+template <class T>
+void TicTacToeState::WriteObservationTensor(Player player,
+                                            TensorView<2, T>& view) const {
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    view[{static_cast<int>(board_[cell]), cell}] = 1.0;
+  }
+}
+
 void TicTacToeState::ObservationTensor(Player player,
                                        std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
@@ -167,12 +183,20 @@ void TicTacToeState::ObservationTensor(Player player,
 
   // Treat `values` as a 2-d tensor.
   TensorView<2> view(values, {kCellStates, kNumCells}, true);
-  for (int cell = 0; cell < kNumCells; ++cell) {
-    view[{static_cast<int>(board_[cell]), cell}] = 1.0;
-  }
+  WriteObservationTensor(player, view);
+}
+
+void TicTacToeState::ObservationTensor(Player player,
+                                       absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(values, {kCellStates, kNumCells}, true);
+  WriteObservationTensor(player, view);
 }
 
 void TicTacToeState::UndoAction(Player player, Action move) {
+  hash_ ^= CellKey(move, board_[move]);
   board_[move] = CellState::kEmpty;
   current_player_ = player;
   outcome_ = kInvalidPlayer;
@@ -184,6 +208,12 @@ std::unique_ptr<State> TicTacToeState::Clone() const {
   return std::unique_ptr<State>(new TicTacToeState(*this));
 }
 
+bool TicTacToeState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  *this = static_cast<const TicTacToeState&>(other);
+  return true;
+}
+
 TicTacToeGame::TicTacToeGame(const GameParameters& params)
     : Game(kGameType, params) {}
 
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -27,10 +29,25 @@ void BasicTicTacToeTests() {
   testing::RandomSimTest(*LoadGame("tic_tac_toe"), 100);
 }
 
+void TranspositionsHaveTheSameHash() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state1 = game->NewInitialState();
+  std::unique_ptr<State> state2 = game->NewInitialState();
+  for (Action action : {0, 4, 8}) state1->ApplyAction(action);
+  for (Action action : {8, 4, 0}) state2->ApplyAction(action);
+  SPIEL_CHECK_EQ(state1->Hash(), state2->Hash());
+
+  state2->UndoAction(0, 0);
+  SPIEL_CHECK_NE(state1->Hash(), state2->Hash());
+  state2->ApplyAction(1);
+  SPIEL_CHECK_NE(state1->Hash(), state2->Hash());
+}
+
 }  // namespace
 }  // namespace tic_tac_toe
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::tic_tac_toe::BasicTicTacToeTests();
+  open_spiel::tic_tac_toe::TranspositionsHaveTheSameHash();
 }
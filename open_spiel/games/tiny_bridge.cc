@@ -14,8 +14,14 @@
 
 #include "open_spiel/games/tiny_bridge.h"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -480,6 +486,30 @@ std::vector<Action> TinyBridgeAuctionState::LegalActions() const {
 
 std::vector<std::pair<Action, double>> TinyBridgeAuctionState::ChanceOutcomes()
     const {
+  return DealDistribution().outcomes();
+}
+
+std::pair<Action, double> TinyBridgeAuctionState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  return DealDistribution().Sample(rng);
+}
+
+const ChanceDistribution& TinyBridgeAuctionState::DealDistribution() const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // The deals only depend on the cards already dealt, whatever the game, so
+  // all the games share the distributions, of which there are at most
+  // 2^kDeckSize.
+  static const auto* deal_distributions = new ChanceDistributionCache();
+  int64_t dealt = 0;
+  for (int i = 0; i < actions_.size() && i < num_players_; ++i) {
+    const auto cards = ChanceOutcomeToCards(actions_[i]);
+    dealt |= (int64_t{1} << cards.first) | (int64_t{1} << cards.second);
+  }
+  return deal_distributions->Get(dealt, [this]() { return DealOutcomes(); });
+}
+
+std::vector<std::pair<Action, double>> TinyBridgeAuctionState::DealOutcomes()
+    const {
   std::vector<Action> actions;
   auto holder = CardHolders();
   for (int card1 = 0; card1 < kDeckSize; ++card1) {
@@ -601,30 +631,26 @@ std::string TinyBridgeAuctionState::ObservationString(Player player) const {
 //     For each bid, 4 bits showing who made it, 4 bits showing who doubled it,
 //     and 4 bits showing who redoubled it.
 //     Each set of 4 bits is relative the the current player.
-void TinyBridgeAuctionState::InformationStateTensor(
-    Player player, std::vector<double>* values) const {
+template <typename SetValue>
+void TinyBridgeAuctionState::EncodeInformationStateTensor(
+    Player player, SetValue set_value) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   const int hand_size = is_abstracted_ ? kNumAbstractHands : kDeckSize;
-  const int auction_size = (num_players_ == 2)
-                               ? kNumActions2p * num_players_
-                               : num_players_ + kNumBids * num_players_ * 3;
-  std::fill(values->begin(), values->end(), 0);
-  values->resize(hand_size + auction_size);
   if (IsDealt(player)) {
     if (is_abstracted_) {
       const int abstraction = ChanceOutcomeToHandAbstraction(actions_[player]);
-      values->at(abstraction) = 1;
+      set_value(abstraction, 1);
     } else {
       const auto cards = ChanceOutcomeToCards(actions_[player]);
-      values->at(cards.first) = 1;
-      values->at(cards.second) = 1;
+      set_value(cards.first, 1);
+      set_value(cards.second, 1);
     }
   }
   if (num_players_ == 2) {
     for (int i = num_players_; i < actions_.size(); ++i) {
-      values->at(hand_size + actions_[i] * 2 + (i - player) % num_players_) = 1;
+      set_value(hand_size + actions_[i] * 2 + (i - player) % num_players_, 1);
     }
   } else {
     auto last_bid = Call::kPass;
@@ -633,20 +659,20 @@ void TinyBridgeAuctionState::InformationStateTensor(
       int bidder = RelativeSeatIndex(Seat(i % num_players_), observer);
       if (actions_[i] == Call::kPass) {
         if (last_bid == Call::kPass) {
-          values->at(hand_size + bidder) = 1;
+          set_value(hand_size + bidder, 1);
         }
       } else if (actions_[i] == Call::kDouble) {
-        values->at(hand_size + num_players_ +
-                   (last_bid - 1) * (3 * num_players_) + bidder) = 1;
+        set_value(hand_size + num_players_ +
+                  (last_bid - 1) * (3 * num_players_) + bidder, 1);
       } else if (actions_[i] == Call::kRedouble) {
-        values->at(hand_size + num_players_ +
-                   (last_bid - 1) * (3 * num_players_) + num_players_ +
-                   bidder) = 1;
+        set_value(hand_size + num_players_ +
+                  (last_bid - 1) * (3 * num_players_) + num_players_ +
+                  bidder, 1);
       } else {
         last_bid = Call(actions_[i]);
-        values->at(hand_size + num_players_ +
-                   (last_bid - 1) * (3 * num_players_) + num_players_ * 2 +
-                   bidder) = 1;
+        set_value(hand_size + num_players_ +
+                  (last_bid - 1) * (3 * num_players_) + num_players_ * 2 +
+                  bidder, 1);
       }
     }
   }
@@ -662,52 +688,121 @@ void TinyBridgeAuctionState::InformationStateTensor(
 //   4 bits showing who doubled it (relative to the observing player)
 //   4 bits showing who redoubled it (relative to the observing player)
 //   4 bits for the dealer
-void TinyBridgeAuctionState::ObservationTensor(
-    Player player, std::vector<double>* values) const {
+template <typename SetValue>
+void TinyBridgeAuctionState::EncodeObservationTensor(
+    Player player, SetValue set_value) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
   const int hand_size = is_abstracted_ ? kNumAbstractHands : kDeckSize;
-  const int auction_size =
-      num_players_ == 2 ? kNumActions2p : kNumBids + 4 * num_players_;
-  std::fill(values->begin(), values->end(), 0);
-  values->resize(hand_size + auction_size);
   if (IsDealt(player)) {
     if (is_abstracted_) {
       const int abstraction = ChanceOutcomeToHandAbstraction(actions_[player]);
-      values->at(abstraction) = 1;
+      set_value(abstraction, 1);
     } else {
       const auto cards = ChanceOutcomeToCards(actions_[player]);
-      values->at(cards.first) = 1;
-      values->at(cards.second) = 1;
+      set_value(cards.first, 1);
+      set_value(cards.second, 1);
     }
   }
   if (num_players_ == 2) {
     if (HasAuctionStarted()) {
-      values->at(hand_size + actions_.back()) = 1;
+      set_value(hand_size + actions_.back(), 1);
     }
   } else {
     auto state = AnalyzeAuction();
     auto seat = PlayerToSeat(player);
     if (state.last_bidder != kInvalidSeat)
-      values->at(hand_size + RelativeSeatIndex(state.last_bidder, seat)) = 1;
+      set_value(hand_size + RelativeSeatIndex(state.last_bidder, seat), 1);
     if (state.doubler != kInvalidSeat)
-      values->at(hand_size + kNumSeats +
-                 RelativeSeatIndex(state.doubler, seat)) = 1;
+      set_value(hand_size + kNumSeats +
+                RelativeSeatIndex(state.doubler, seat), 1);
     if (state.redoubler != kInvalidSeat)
-      values->at(hand_size + kNumSeats * 2 +
-                 RelativeSeatIndex(state.redoubler, seat)) = 1;
-    values->at(hand_size + kNumSeats * 3 +
-               RelativeSeatIndex(Seat::kWest, seat)) = 1;
+      set_value(hand_size + kNumSeats * 2 +
+                RelativeSeatIndex(state.redoubler, seat), 1);
+    set_value(hand_size + kNumSeats * 3 +
+              RelativeSeatIndex(Seat::kWest, seat), 1);
     if (state.last_bidder != kInvalidSeat)
-      values->at(hand_size + kNumSeats * 4 + state.last_bid - 1) = 1;
+      set_value(hand_size + kNumSeats * 4 + state.last_bid - 1, 1);
   }
 }
 
+void TinyBridgeAuctionState::InformationStateTensor(
+    Player player, std::vector<double>* values) const {
+  values->resize(game_->InformationStateTensorSize());
+  std::fill(values->begin(), values->end(), 0);
+  EncodeInformationStateTensor(
+      player, [values](int index, double value) { values->at(index) = value; });
+}
+
+void TinyBridgeAuctionState::ObservationTensor(
+    Player player, std::vector<double>* values) const {
+  values->resize(game_->ObservationTensorSize());
+  std::fill(values->begin(), values->end(), 0);
+  EncodeObservationTensor(
+      player, [values](int index, double value) { values->at(index) = value; });
+}
+
+void TinyBridgeAuctionState::SparseInformationStateTensor(
+    Player player, SparseTensor* tensor) const {
+  tensor->Clear();
+  EncodeInformationStateTensor(
+      player, [tensor](int index, float value) { tensor->Add(index, value); });
+}
+
+void TinyBridgeAuctionState::SparseObservationTensor(
+    Player player, SparseTensor* tensor) const {
+  tensor->Clear();
+  EncodeObservationTensor(
+      player, [tensor](int index, float value) { tensor->Add(index, value); });
+}
+
 std::unique_ptr<State> TinyBridgeAuctionState::Clone() const {
   return std::unique_ptr<State>{new TinyBridgeAuctionState(*this)};
 }
 
+std::unique_ptr<State> TinyBridgeAuctionState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  std::vector<Action> deal(
+      actions_.begin(),
+      actions_.begin() + std::min<int>(actions_.size(), num_players_));
+  // Returns a uniformly random hand among those for which accept(hand).
+  auto draw = [&rng](auto accept) {
+    std::vector<Action> hands;
+    for (Action hand = 0; hand < kNumPrivates; ++hand) {
+      if (accept(hand)) hands.push_back(hand);
+    }
+    SPIEL_CHECK_FALSE(hands.empty());
+    return hands[std::min<int>(rng() * hands.size(), hands.size() - 1)];
+  };
+  // The player only knows the abstraction of their hand, if abstracted.
+  if (is_abstracted_ && player_id < deal.size()) {
+    const int abstraction = ChanceOutcomeToHandAbstraction(deal[player_id]);
+    deal[player_id] = draw([abstraction](Action hand) {
+      return ChanceOutcomeToHandAbstraction(hand) == abstraction;
+    });
+  }
+  // Drawing each other hand uniformly among those disjoint from the hands
+  // drawn so far makes the deal uniform, as they are equally many.
+  for (int p = 0; p < deal.size(); ++p) {
+    if (p == player_id) continue;
+    deal[p] = draw([&deal, p, player_id](Action hand) {
+      for (int q = 0; q < deal.size(); ++q) {
+        if ((q < p || q == player_id) && !IsConsistent(hand, deal[q])) {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+  std::unique_ptr<State> state = game_->NewInitialState();
+  for (Action hand : deal) state->ApplyAction(hand);
+  for (int i = deal.size(); i < actions_.size(); ++i) {
+    state->ApplyAction(actions_[i]);
+  }
+  return state;
+}
+
 void TinyBridgeAuctionState::UndoAction(Player player, Action action) {
   actions_.pop_back();
   is_terminal_ = false;
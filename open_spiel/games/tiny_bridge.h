@@ -16,8 +16,10 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_TINY_BRIDGE_H_
 
 #include <array>
+#include <functional>
 #include <memory>
 
+#include "open_spiel/chance_distribution.h"
 #include "open_spiel/spiel.h"
 
 // A very small version of bridge, with 8 cards in total, created by Edward
@@ -98,6 +100,8 @@ class TinyBridgeGame2p : public Game {
   std::vector<int> ObservationTensorShape() const override {
     return {(is_abstracted_ ? kNumAbstractHands : kDeckSize) + kNumActions2p};
   }
+  bool InformationStateTensorIsSparse() const override { return true; }
+  bool ObservationTensorIsSparse() const override { return true; }
 
  private:
   const bool is_abstracted_;
@@ -124,6 +128,8 @@ class TinyBridgeGame4p : public Game {
   std::vector<int> ObservationTensorShape() const override {
     return {kDeckSize + kNumBids + 4 * NumPlayers()};
   }
+  bool InformationStateTensorIsSparse() const override { return true; }
+  bool ObservationTensorIsSparse() const override { return true; }
 };
 
 // Play phase as a 2-player perfect-information game.
@@ -167,9 +173,18 @@ class TinyBridgeAuctionState : public State {
   std::string ObservationString(Player player) const override;
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void SparseInformationStateTensor(Player player,
+                                    SparseTensor* tensor) const override;
+  void SparseObservationTensor(Player player,
+                               SparseTensor* tensor) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
   std::string AuctionString() const;
   std::string PlayerHandString(Player player, bool abstracted) const;
   std::string DealString() const;
@@ -186,9 +201,20 @@ class TinyBridgeAuctionState : public State {
   bool IsDealt(Player player) const { return actions_.size() > player; }
   bool HasAuctionStarted() const { return actions_.size() > num_players_; }
   AuctionState AnalyzeAuction() const;
+  // The distribution of the next hand dealt, shared by all the states with
+  // the same cards dealt.
+  const ChanceDistribution& DealDistribution() const;
+  std::vector<std::pair<Action, double>> DealOutcomes() const;
   std::array<Seat, kDeckSize> CardHolders() const;
   Seat PlayerToSeat(Player player) const;
   Player SeatToPlayer(Seat seat) const;
+
+  // Call set_value(index, 1) for the elements of the tensors that are 1,
+  // which are shared by the dense and sparse versions.
+  template <typename SetValue>
+  void EncodeInformationStateTensor(Player player, SetValue set_value) const;
+  template <typename SetValue>
+  void EncodeObservationTensor(Player player, SetValue set_value) const;
 };
 
 // State of in-progress play.
@@ -210,6 +236,7 @@ class TinyBridgePlayState : public State {
   std::vector<double> Returns() const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
   std::string ToString() const override;
   std::vector<Action> LegalActions() const override;
 
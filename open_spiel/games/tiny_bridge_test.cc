@@ -30,12 +30,16 @@ void BasicTinyBridge2pTests() {
   testing::ChanceOutcomesTest(*LoadGame("tiny_bridge_2p"));
   testing::CheckChanceOutcomes(*LoadGame("tiny_bridge_2p"));
   testing::RandomSimTest(*LoadGame("tiny_bridge_2p"), 100);
+  testing::ResampleInfostateTest(*LoadGame("tiny_bridge_2p"), 10);
+  testing::ResampleInfostateTest(
+      *LoadGame("tiny_bridge_2p", {{"abstracted", GameParameter(true)}}), 10);
 }
 
 void BasicTinyBridge4pTests() {
   testing::LoadGameTest("tiny_bridge_4p");
   testing::ChanceOutcomesTest(*LoadGame("tiny_bridge_4p"));
   testing::RandomSimTest(*LoadGame("tiny_bridge_4p"), 100);
+  testing::ResampleInfostateTest(*LoadGame("tiny_bridge_4p"), 10);
 }
 
 void CountStates2p() {
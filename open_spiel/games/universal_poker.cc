@@ -17,9 +17,12 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <utility>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
@@ -102,7 +105,14 @@ const GameType kGameType{
      // Specify which actions are available to the player, in both limit and
      // nolimit games. Available options are: "fc" for fold and check/call.
      // "fcpa" for fold, check/call, bet pot and all in (default).
-     {"bettingAbstraction", GameParameter(std::string("fcpa"))}}};
+     {"bettingAbstraction", GameParameter(std::string("fcpa"))},
+     // A file of hand buckets written by logic::CardAbstraction::Save (see
+     // universal_poker/build_card_abstraction.cc), with one round per
+     // betting round. When present, the information state strings tell the
+     // buckets of the player's hands in each round instead of the cards,
+     // and the observation strings the bucket of the current round. The
+     // tensors still encode the cards. It can be given along with gamedef.
+     {"cardAbstraction", GameParameter(std::string(kEmptyString))}}};
 
 std::shared_ptr<const Game> Factory(const GameParameters &params) {
   return std::shared_ptr<const Game>(new UniversalPokerGame(params));
@@ -130,7 +140,9 @@ UniversalPokerState::UniversalPokerState(std::shared_ptr<const Game> game)
       cur_player_(kChancePlayerId),
       possibleActions_(ACTION_DEAL),
       betting_abstraction_(static_cast<const UniversalPokerGame *>(game.get())
-                               ->betting_abstraction()) {}
+                               ->betting_abstraction()),
+      card_abstraction_(static_cast<const UniversalPokerGame *>(game.get())
+                            ->card_abstraction()) {}
 
 std::string UniversalPokerState::ToString() const {
   std::ostringstream buf;
@@ -207,6 +219,18 @@ std::vector<double> UniversalPokerState::Returns() const {
     return std::vector<double>(NumPlayers(), 0.0);
   }
 
+  if (NumPlayers() == 2 && !hand_values_.empty() &&
+      acpc_state_.NumFolded() == 0) {
+    // At a heads-up showdown, the best hand wins what both players spent,
+    // which is the smaller amount if one went all-in for less, and ties split
+    // the pot.
+    const double pot = std::min(acpc_state_.CurrentSpent(0),
+                                acpc_state_.CurrentSpent(1));
+    const int winner = (hand_values_[0] > hand_values_[1]) -
+                       (hand_values_[0] < hand_values_[1]);
+    return {winner * pot, -winner * pot};
+  }
+
   std::vector<double> returns(NumPlayers());
   for (Player player = 0; player < NumPlayers(); ++player) {
     // Money vs money at start.
@@ -348,6 +372,14 @@ std::string UniversalPokerState::InformationStateString(Player player) const {
     sequences.emplace_back(acpc_state_.BettingSequence(r));
   }
 
+  if (card_abstraction_ != nullptr) {
+    return absl::StrFormat(
+        "[Round %i][Player: %i][Pot: %i][Money: %s][Buckets: %s][Sequences: "
+        "%s]",
+        acpc_state_.GetRound(), CurrentPlayer(), pot,
+        absl::StrJoin(money, " "), absl::StrJoin(Buckets(player), " "),
+        absl::StrJoin(sequences, "|"));
+  }
   return absl::StrFormat(
       "[Round %i][Player: %i][Pot: %i][Money: %s][Private: %s][Public: "
       "%s][Sequences: %s]",
@@ -356,6 +388,32 @@ std::string UniversalPokerState::InformationStateString(Player player) const {
       absl::StrJoin(sequences, "|"));
 }
 
+std::vector<int> UniversalPokerState::Buckets(Player player) const {
+  std::vector<int> buckets;
+  if (hole_cards_[player].NumCards() < acpc_game_->GetNbHoleCardsRequired()) {
+    return buckets;
+  }
+  // The board cards in the order they were dealt, after the hole cards.
+  std::vector<uint8_t> board;
+  const int num_hole_deals =
+      acpc_game_->GetNbPlayers() * acpc_game_->GetNbHoleCardsRequired();
+  int num_deals = 0;
+  for (int i = 0; i < history_.size(); ++i) {
+    if (actionSequence_[i] == 'd' && num_deals++ >= num_hole_deals) {
+      board.push_back(history_[i]);
+    }
+  }
+  for (int round = 0; round <= acpc_state_.GetRound(); ++round) {
+    const int num_board_cards = acpc_game_->GetNbBoardCardsRequired(round);
+    if (board.size() < num_board_cards) break;
+    logic::CardSet board_cards(std::vector<int>(
+        board.begin(), board.begin() + num_board_cards));
+    buckets.push_back(
+        card_abstraction_->Bucket(round, hole_cards_[player], board_cards));
+  }
+  return buckets;
+}
+
 std::string UniversalPokerState::ObservationString(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, acpc_game_->GetNbPlayers());
@@ -368,8 +426,13 @@ std::string UniversalPokerState::ObservationString(Player player) const {
   for (auto p = Player{0}; p < acpc_game_->GetNbPlayers(); p++) {
     absl::StrAppend(&result, " ", acpc_state_.Money(p));
   }
-  // Add the player's private cards
-  if (player != kChancePlayerId) {
+  // Add the player's private cards, or the bucket of its hand.
+  if (card_abstraction_ != nullptr) {
+    const std::vector<int> buckets = Buckets(player);
+    if (!buckets.empty()) {
+      absl::StrAppend(&result, "[Bucket: ", buckets.back(), "]");
+    }
+  } else if (player != kChancePlayerId) {
     absl::StrAppend(&result, "[Private: ", hole_cards_[player].ToString(), "]");
   }
   // Adding the contribution of each players to the pot
@@ -386,6 +449,42 @@ std::unique_ptr<State> UniversalPokerState::Clone() const {
   return std::unique_ptr<State>(new UniversalPokerState(*this));
 }
 
+std::unique_ptr<State> UniversalPokerState::ResampleFromInfostate(
+    int player_id, std::function<double()> rng) const {
+  SPIEL_CHECK_FALSE(IsTerminal());
+  // The hole cards of the other players are dealt again from the cards the
+  // player has not seen. They are the first chance actions, dealt to each
+  // player in turn (see DoApplyAction).
+  const int num_players = acpc_game_->GetNbPlayers();
+  const int num_hole_cards = acpc_game_->GetNbHoleCardsRequired();
+  std::vector<uint8_t> unseen_cards = deck_.ToCardArray();
+  for (Player player = 0; player < num_players; ++player) {
+    if (player == player_id) continue;
+    for (uint8_t card : hole_cards_[player].ToCardArray()) {
+      unseen_cards.push_back(card);
+    }
+  }
+  auto state = std::make_unique<UniversalPokerState>(*this);
+  const int num_deals =
+      std::min<int>(history_.size(), num_players * num_hole_cards);
+  for (int i = 0; i < num_deals; ++i) {
+    const Player player = i / num_hole_cards;
+    if (player == player_id) continue;
+    if (i % num_hole_cards == 0) state->hole_cards_[player] = logic::CardSet();
+    const int index = std::min<int>(rng() * unseen_cards.size(),
+                                    unseen_cards.size() - 1);
+    std::swap(unseen_cards[index], unseen_cards.back());
+    state->history_[i] = unseen_cards.back();
+    state->hole_cards_[player].AddCard(unseen_cards.back());
+    unseen_cards.pop_back();
+  }
+  state->deck_ = logic::CardSet();
+  for (uint8_t card : unseen_cards) state->deck_.AddCard(card);
+  state->hand_values_.clear();
+  state->MaybeEvaluateHands();
+  return state;
+}
+
 std::vector<std::pair<Action, double>> UniversalPokerState::ChanceOutcomes()
     const {
   SPIEL_CHECK_TRUE(IsChanceNode());
@@ -402,6 +501,17 @@ std::vector<std::pair<Action, double>> UniversalPokerState::ChanceOutcomes()
   return outcomes;
 }
 
+std::pair<Action, double> UniversalPokerState::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // Deals are uniform over the deck, so the card is drawn like SampleAction
+  // would from ChanceOutcomes(), without building them.
+  const int num_cards = deck_.NumCards();
+  const double z = absl::Uniform(rng, 0.0, 1.0);
+  const int index = std::min(static_cast<int>(z * num_cards), num_cards - 1);
+  return {Action{deck_.NthCard(index)}, 1.0 / num_cards};
+}
+
 std::vector<Action> UniversalPokerState::LegalActions() const {
   if (IsChanceNode()) {
     std::vector<uint8_t> available_cards = deck_.ToCardArray();
@@ -434,6 +544,7 @@ void UniversalPokerState::DoApplyAction(Action action_id) {
     for (int p = 0; p < acpc_game_->GetNbPlayers(); ++p) {
       if (hole_cards_[p].NumCards() < acpc_game_->GetNbHoleCardsRequired()) {
         hole_cards_[p].AddCard(card);
+        MaybeEvaluateHands();
         _CalculateActionsAndNodeType();
         return;
       }
@@ -442,6 +553,7 @@ void UniversalPokerState::DoApplyAction(Action action_id) {
     if (board_cards_.NumCards() <
         acpc_game_->GetNbBoardCardsRequired(acpc_state_.GetRound())) {
       board_cards_.AddCard(card);
+      MaybeEvaluateHands();
       _CalculateActionsAndNodeType();
       return;
     }
@@ -467,6 +579,27 @@ void UniversalPokerState::DoApplyAction(Action action_id) {
   }
 }
 
+void UniversalPokerState::UndoAction(Player player, Action action) {
+  if (player == kChancePlayerId) {
+    const uint8_t card = action;
+    if (board_cards_.ContainsCards(card)) {
+      board_cards_.RemoveCard(card);
+    } else {
+      for (logic::CardSet &hole_cards : hole_cards_) {
+        if (hole_cards.ContainsCards(card)) hole_cards.RemoveCard(card);
+      }
+    }
+    deck_.AddCard(card);
+    // They are evaluated again once the cards are dealt.
+    hand_values_.clear();
+  } else {
+    acpc_state_.UndoAction();
+  }
+  actionSequence_.pop_back();
+  _CalculateActionsAndNodeType();
+  history_.pop_back();
+}
+
 double UniversalPokerState::GetTotalReward(Player player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, acpc_game_->GetNbPlayers());
@@ -492,6 +625,22 @@ double UniversalPokerState::GetTotalReward(Player player) const {
   return acpc_state_.ValueOfState(player);
 }
 
+void UniversalPokerState::MaybeEvaluateHands() {
+  if (!hand_values_.empty() ||
+      hole_cards_.back().NumCards() < acpc_game_->GetNbHoleCardsRequired() ||
+      board_cards_.NumCards() < acpc_game_->GetTotalNbBoardCards() ||
+      acpc_game_->GetNbHoleCardsRequired() + board_cards_.NumCards() >
+          logic::kMaxEvaluatedCards) {
+    return;
+  }
+  hand_values_.reserve(hole_cards_.size());
+  for (const logic::CardSet &hole_cards : hole_cards_) {
+    logic::CardSet cards = board_cards_;
+    cards.cs.cards |= hole_cards.cs.cards;
+    hand_values_.push_back(cards.EvaluateHand());
+  }
+}
+
 std::unique_ptr<HistoryDistribution>
 UniversalPokerState::GetHistoriesConsistentWithInfostate(int player_id) const {
   // This is only implemented for 2 players.
@@ -551,6 +700,17 @@ UniversalPokerGame::UniversalPokerGame(const GameParameters &params)
     SpielFatalError(absl::StrFormat("bettingAbstraction: %s not supported.",
                                     betting_abstraction));
   }
+  const std::string card_abstraction =
+      ParameterValue<std::string>("cardAbstraction");
+  if (!card_abstraction.empty()) {
+    card_abstraction_ = std::make_shared<const logic::CardAbstraction>(
+        logic::CardAbstraction::Load(card_abstraction));
+    if (card_abstraction_->NumRounds() != acpc_game_.NumRounds()) {
+      SpielFatalError(absl::StrCat(
+          "The card abstraction has ", card_abstraction_->NumRounds(),
+          " rounds, but the game has ", acpc_game_.NumRounds()));
+    }
+  }
 }
 
 std::unique_ptr<State> UniversalPokerGame::NewInitialState() const {
@@ -649,8 +809,9 @@ int UniversalPokerGame::MaxGameLength() const {
  */
 std::string UniversalPokerGame::parseParameters(const GameParameters &map) {
   if (map.find("gamedef") != map.end()) {
-    // We check for sanity that all parameters are empty
-    if (map.size() != 1) {
+    // We check for sanity that all parameters are empty, except for the card
+    // abstraction, which is not part of the gamedef.
+    if (map.size() != 1 + map.count("cardAbstraction")) {
       std::vector<std::string> game_parameter_keys;
       game_parameter_keys.reserve(map.size());
       for (auto const &imap : map) {
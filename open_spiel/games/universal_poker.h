@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_UNIVERSAL_POKER_H_
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,6 +24,7 @@
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
 #include "open_spiel/games/universal_poker/acpc_cpp/acpc_game.h"
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
 #include "open_spiel/games/universal_poker/logic/card_set.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -64,11 +66,18 @@ class UniversalPokerState : public State {
   void ObservationTensor(Player player,
                          std::vector<double> *values) const override;
   std::unique_ptr<State> Clone() const override;
+  void UndoAction(Player player, Action action) override;
+  bool SupportsUndoAction() const override { return true; }
 
   // The probability of taking each possible action in a particular info state.
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const override;
   std::vector<Action> LegalActions() const override;
 
+  std::unique_ptr<State> ResampleFromInfostate(
+      int player_id, std::function<double()> rng) const override;
+
   // Used to make UpdateIncrementalStateDistribution much faster.
   std::unique_ptr<HistoryDistribution> GetHistoriesConsistentWithInfostate(
       int player_id) const override;
@@ -103,12 +112,24 @@ class UniversalPokerState : public State {
   int32_t potSize_ = 0;
   int32_t allInSize_ = 0;
   std::string actionSequence_;
+  // The value of each player's hand with the board, by
+  // logic::CardSet::EvaluateHand, once all the cards are dealt. They are
+  // computed once per deal, and copied to the states that follow, rather than
+  // ranked again by ACPC at each showdown.
+  std::vector<int> hand_values_;
 
   BettingAbstraction betting_abstraction_;
+  // The game's card abstraction, or nullptr if it has none.
+  const logic::CardAbstraction *card_abstraction_;
 
   void _CalculateActionsAndNodeType();
 
+  // The buckets of the player's hands in each round whose cards are all
+  // dealt, by the card abstraction.
+  std::vector<int> Buckets(Player player) const;
+
   double GetTotalReward(Player player) const;
+  void MaybeEvaluateHands();
 
   const uint32_t &GetPossibleActionsMask() const { return possibleActions_; }
   const int GetPossibleActionCount() const;
@@ -135,12 +156,18 @@ class UniversalPokerGame : public Game {
   BettingAbstraction betting_abstraction() const {
     return betting_abstraction_;
   }
+  // The card abstraction loaded from the cardAbstraction parameter, or
+  // nullptr if it is empty.
+  const logic::CardAbstraction *card_abstraction() const {
+    return card_abstraction_.get();
+  }
 
  private:
   std::string gameDesc_;
   const acpc_cpp::ACPCGame acpc_game_;
   std::optional<int> max_game_length_;
   BettingAbstraction betting_abstraction_ = BettingAbstraction::kFCPA;
+  std::shared_ptr<const logic::CardAbstraction> card_abstraction_;
 
  public:
   const acpc_cpp::ACPCGame *GetACPCGame() const { return &acpc_game_; }
@@ -239,6 +239,30 @@ void ACPCState::DoAction(const ACPCState::ACPCActionType actionType,
   project_acpc_server::doAction(game_->acpc_game_.get(), &a, acpcState_.get());
 }
 
+void ACPCState::UndoAction() {
+  // The ACPC states do not support undoing actions, so the betting is played
+  // again from the start of the hand, without the last action.
+  const RawACPCState previous = *acpcState_;
+  int round = previous.round;
+  while (previous.numActions[round] == 0) {
+    SPIEL_CHECK_GT(round, 0);
+    --round;
+  }
+  project_acpc_server::initState(game_->acpc_game_.get(), game_->handId_,
+                                 acpcState_.get());
+  for (int r = 0; r <= round; ++r) {
+    const int num_actions = previous.numActions[r] - (r == round ? 1 : 0);
+    for (int i = 0; i < num_actions; ++i) {
+      project_acpc_server::doAction(game_->acpc_game_.get(),
+                                    &previous.action[r][i], acpcState_.get());
+    }
+  }
+  // The cards are not part of the betting.
+  memcpy(acpcState_->holeCards, previous.holeCards, sizeof(previous.holeCards));
+  memcpy(acpcState_->boardCards, previous.boardCards,
+         sizeof(previous.boardCards));
+}
+
 int ACPCState::IsValidAction(const ACPCState::ACPCActionType actionType,
                              const int32_t size) const {
   RawACPCAction a = GetAction(actionType, size);
@@ -51,6 +51,8 @@ class ACPCState {
   int RaiseIsValid(int32_t* minSize, int32_t* maxSize) const;
   int IsValidAction(const ACPCActionType actionType, const int32_t size) const;
   void DoAction(const ACPCActionType actionType, const int32_t size);
+  // Undoes the last action given to DoAction.
+  void UndoAction();
   double ValueOfState(const uint8_t player) const;
   uint32_t MaxSpend() const;
   // Returns the current round 0-indexed round id (<= game.NumRounds() - 1).
@@ -0,0 +1,116 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Builds the card abstraction of a universal_poker game with
+// logic::BuildCardAbstraction, and writes it to a file to be given to the
+// game as its cardAbstraction parameter, e.g.
+//
+//   build_card_abstraction --game="universal_poker(numRanks=13,...)"
+//       --buckets="169,200,200,200" --output=/tmp/buckets.txt
+//   LoadGame("universal_poker(numRanks=13,...,cardAbstraction=/tmp/...)")
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/flags/flag.h"
+#include "open_spiel/abseil-cpp/absl/flags/parse.h"
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/games/universal_poker.h"
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+ABSL_FLAG(std::string, game,
+          "universal_poker(betting=limit,numPlayers=2,numRounds=2,"
+          "blind=1 1,raiseSize=2 4,firstPlayer=1 1,maxRaises=2 2,numSuits=2,"
+          "numRanks=6,numHoleCards=2,numBoardCards=0 3,stack=20 20)",
+          "The universal_poker game to abstract the cards of.");
+ABSL_FLAG(std::string, buckets, "10,20",
+          "The number of buckets of each round, comma separated.");
+ABSL_FLAG(int, bins, 30, "The number of bins of the hand strength histograms.");
+ABSL_FLAG(int, rollouts, 0,
+          "The board completions sampled per hand, or 0 for all of them.");
+ABSL_FLAG(int, kmeans_iterations, 100, "The maximum k-means iterations.");
+ABSL_FLAG(int, threads, 1, "The number of threads.");
+ABSL_FLAG(int, seed, 0, "The seed of the k-means initialization.");
+ABSL_FLAG(std::string, output, "", "The file to write the buckets to.");
+
+namespace open_spiel {
+namespace universal_poker {
+namespace {
+
+void BuildAndSave() {
+  std::shared_ptr<const Game> game = LoadGame(absl::GetFlag(FLAGS_game));
+  const auto* poker_game = dynamic_cast<const UniversalPokerGame*>(game.get());
+  if (poker_game == nullptr) {
+    SpielFatalError("--game must be a universal_poker game.");
+  }
+  const acpc_cpp::ACPCGame& acpc_game = *poker_game->GetACPCGame();
+
+  logic::CardAbstractionConfig config;
+  config.num_suits = acpc_game.NumSuitsDeck();
+  config.num_ranks = acpc_game.NumRanksDeck();
+  config.num_hole_cards = acpc_game.GetNbHoleCardsRequired();
+  for (int round = 0; round < acpc_game.NumRounds(); ++round) {
+    config.num_board_cards.push_back(
+        acpc_game.GetNbBoardCardsRequired(round) -
+        (round == 0 ? 0 : acpc_game.GetNbBoardCardsRequired(round - 1)));
+  }
+  for (absl::string_view buckets :
+       absl::StrSplit(absl::GetFlag(FLAGS_buckets), ',')) {
+    int num_buckets;
+    SPIEL_CHECK_TRUE(absl::SimpleAtoi(buckets, &num_buckets));
+    config.num_buckets.push_back(num_buckets);
+  }
+  if (config.num_buckets.size() != acpc_game.NumRounds()) {
+    SpielFatalError(absl::StrCat("--buckets should have ",
+                                 acpc_game.NumRounds(), " numbers."));
+  }
+  config.num_histogram_bins = absl::GetFlag(FLAGS_bins);
+  config.num_rollouts = absl::GetFlag(FLAGS_rollouts);
+  config.max_kmeans_iterations = absl::GetFlag(FLAGS_kmeans_iterations);
+  config.num_threads = absl::GetFlag(FLAGS_threads);
+  config.seed = absl::GetFlag(FLAGS_seed);
+
+  const absl::Time start = absl::Now();
+  const logic::CardAbstraction abstraction =
+      logic::BuildCardAbstraction(config);
+  std::cout << "Built in " << absl::ToDoubleSeconds(absl::Now() - start)
+            << "s" << std::endl;
+  for (int round = 0; round < abstraction.NumRounds(); ++round) {
+    std::cout << "Round " << round << ": " << abstraction.NumHands(round)
+              << " canonical hands in " << abstraction.NumBuckets(round)
+              << " buckets" << std::endl;
+  }
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (!output.empty()) {
+    abstraction.Save(output);
+    std::cout << "Wrote " << output << std::endl;
+  }
+}
+
+}  // namespace
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  open_spiel::universal_poker::BuildAndSave();
+}
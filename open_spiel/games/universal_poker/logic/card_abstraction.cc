@@ -0,0 +1,473 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+#include "open_spiel/utils/thread_pool.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+namespace {
+
+CardSet Union(const CardSet& a, const CardSet& b) {
+  CardSet cards;
+  cards.cs.cards = a.cs.cards | b.cs.cards;
+  return cards;
+}
+
+CardSet Difference(const CardSet& a, const CardSet& b) {
+  CardSet cards;
+  cards.cs.cards = a.cs.cards & ~b.cs.cards;
+  return cards;
+}
+
+// Calls fn on each subset of `num` of the cards.
+void ForEachSubset(const std::vector<uint8_t>& cards, int num,
+                   const std::function<void(const CardSet&)>& fn) {
+  const int n = cards.size();
+  if (num > n) return;
+  std::vector<int> indices(num);
+  std::iota(indices.begin(), indices.end(), 0);
+  while (true) {
+    CardSet subset;
+    for (int i : indices) subset.AddCard(cards[i]);
+    fn(subset);
+    // Move to the next subset in lexicographic order.
+    int i = num - 1;
+    while (i >= 0 && indices[i] == n - num + i) --i;
+    if (i < 0) return;
+    ++indices[i];
+    for (int j = i + 1; j < num; ++j) indices[j] = indices[j - 1] + 1;
+  }
+}
+
+// The earth mover's distance between two cumulative histograms, or the
+// distance between two hand strengths.
+double Distance(const double* a, const double* b, int dim) {
+  double distance = 0;
+  for (int i = 0; i < dim; ++i) distance += std::abs(a[i] - b[i]);
+  return distance;
+}
+
+// The points of a round: the features of its hands, [num_hands, dim], and
+// their expected hand strengths.
+struct RoundFeatures {
+  int dim = 0;
+  std::vector<double> points;
+  std::vector<double> ehs;
+
+  int NumPoints() const { return ehs.size(); }
+  const double* Point(int i) const { return &points[i * dim]; }
+};
+
+// Assigns each point to its nearest center, returning the distances, in
+// parallel. The nearest center with the smallest index is chosen on ties.
+std::vector<double> Assign(const RoundFeatures& features,
+                           const std::vector<double>& centers, int k,
+                           ThreadPool* pool, std::vector<int>* assignment) {
+  std::vector<double> distances(features.NumPoints());
+  pool->ParallelFor(
+      0, features.NumPoints(),
+      [&](int i) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int c = 0; c < k; ++c) {
+          const double distance =
+              Distance(features.Point(i), &centers[c * features.dim],
+                       features.dim);
+          if (distance < best) {
+            best = distance;
+            (*assignment)[i] = c;
+          }
+        }
+        distances[i] = best;
+      },
+      /*grain_size=*/64);
+  return distances;
+}
+
+// Clusters the points into k clusters, k <= NumPoints(), with centers
+// initialized by k-means++.
+std::vector<int> KMeans(const RoundFeatures& features, int k,
+                        int max_iterations, std::mt19937* rng,
+                        ThreadPool* pool) {
+  const int n = features.NumPoints();
+  const int dim = features.dim;
+  std::vector<double> centers(k * dim);
+  auto set_center = [&](int c, int i) {
+    std::copy_n(features.Point(i), dim, &centers[c * dim]);
+  };
+
+  // k-means++: each new center is drawn with probability proportional to the
+  // squared distance to the nearest one so far.
+  set_center(0, std::uniform_int_distribution<int>(0, n - 1)(*rng));
+  std::vector<double> nearest(n);
+  pool->ParallelFor(
+      0, n,
+      [&](int i) {
+        nearest[i] = Distance(features.Point(i), &centers[0], dim);
+      },
+      /*grain_size=*/64);
+  for (int c = 1; c < k; ++c) {
+    std::vector<double> weights(n);
+    for (int i = 0; i < n; ++i) weights[i] = nearest[i] * nearest[i];
+    int next = 0;
+    if (std::any_of(weights.begin(), weights.end(),
+                    [](double w) { return w > 0; })) {
+      next = std::discrete_distribution<int>(weights.begin(),
+                                             weights.end())(*rng);
+    }
+    set_center(c, next);
+    pool->ParallelFor(
+        0, n,
+        [&](int i) {
+          nearest[i] = std::min(
+              nearest[i], Distance(features.Point(i), &centers[c * dim], dim));
+        },
+        /*grain_size=*/64);
+  }
+
+  std::vector<int> assignment(n, -1);
+  for (int iteration = 0; iteration < max_iterations; ++iteration) {
+    std::vector<int> previous = assignment;
+    std::vector<double> distances =
+        Assign(features, centers, k, pool, &assignment);
+
+    // An empty cluster takes the point farthest from its center.
+    std::vector<int> sizes(k, 0);
+    for (int c : assignment) ++sizes[c];
+    for (int c = 0; c < k; ++c) {
+      if (sizes[c] > 0) continue;
+      const int farthest =
+          std::max_element(distances.begin(), distances.end()) -
+          distances.begin();
+      --sizes[assignment[farthest]];
+      assignment[farthest] = c;
+      distances[farthest] = 0;
+      sizes[c] = 1;
+    }
+    if (assignment == previous) break;
+
+    std::fill(centers.begin(), centers.end(), 0);
+    for (int i = 0; i < n; ++i) {
+      double* center = &centers[assignment[i] * dim];
+      for (int d = 0; d < dim; ++d) center[d] += features.Point(i)[d];
+    }
+    for (int c = 0; c < k; ++c) {
+      for (int d = 0; d < dim; ++d) centers[c * dim + d] /= sizes[c];
+    }
+  }
+  return assignment;
+}
+
+// The features of the hand: its hand strength on a complete board, and
+// otherwise the cumulative histogram of the hand strengths of its
+// completions.
+void ComputeFeatures(const CardAbstractionConfig& config,
+                     const CardSet& deck, const CardSet& hole_cards,
+                     const CardSet& board_cards, int num_board_cards_to_come,
+                     std::mt19937* rng, double* point, double* ehs) {
+  if (num_board_cards_to_come == 0) {
+    *ehs = *point = HandStrength(hole_cards, board_cards, deck);
+    return;
+  }
+  const int num_bins = config.num_histogram_bins;
+  std::vector<double> histogram(num_bins, 0);
+  int num_completions = 0;
+  double total_strength = 0;
+  auto add_completion = [&](const CardSet& cards) {
+    const double strength =
+        HandStrength(hole_cards, Union(board_cards, cards), deck);
+    ++histogram[std::min(static_cast<int>(strength * num_bins),
+                         num_bins - 1)];
+    total_strength += strength;
+    ++num_completions;
+  };
+  std::vector<uint8_t> remaining =
+      Difference(deck, Union(hole_cards, board_cards)).ToCardArray();
+  if (config.num_rollouts == 0) {
+    ForEachSubset(remaining, num_board_cards_to_come, add_completion);
+  } else {
+    for (int r = 0; r < config.num_rollouts; ++r) {
+      // A partial Fisher-Yates shuffle draws the cards to come.
+      CardSet cards;
+      for (int i = 0; i < num_board_cards_to_come; ++i) {
+        const int j =
+            std::uniform_int_distribution<int>(i, remaining.size() - 1)(*rng);
+        std::swap(remaining[i], remaining[j]);
+        cards.AddCard(remaining[i]);
+      }
+      add_completion(cards);
+    }
+  }
+  SPIEL_CHECK_GT(num_completions, 0);
+  double cumulative = 0;
+  for (int b = 0; b < num_bins; ++b) {
+    cumulative += histogram[b] / num_completions;
+    point[b] = cumulative;
+  }
+  *ehs = total_strength / num_completions;
+}
+
+}  // namespace
+
+std::pair<uint64_t, uint64_t> CanonicalHand(const CardSet& hole_cards,
+                                            const CardSet& board_cards) {
+  std::array<uint32_t, kMaxSuits> suits;
+  for (int s = 0; s < kMaxSuits; ++s) {
+    suits[s] = (static_cast<uint32_t>(hole_cards.cs.bySuit[s]) << 16) |
+               board_cards.cs.bySuit[s];
+  }
+  std::sort(suits.begin(), suits.end(), std::greater<uint32_t>());
+  CardSet hole;
+  CardSet board;
+  for (int s = 0; s < kMaxSuits; ++s) {
+    hole.cs.bySuit[s] = suits[s] >> 16;
+    board.cs.bySuit[s] = suits[s] & 0xffff;
+  }
+  return {hole.cs.cards, board.cs.cards};
+}
+
+double HandStrength(const CardSet& hole_cards, const CardSet& board_cards,
+                    const CardSet& deck) {
+  const int value = Union(hole_cards, board_cards).EvaluateHand();
+  double wins = 0;
+  int num_opponents = 0;
+  ForEachSubset(
+      Difference(deck, Union(hole_cards, board_cards)).ToCardArray(),
+      hole_cards.NumCards(), [&](const CardSet& opponent_cards) {
+        const int opponent_value =
+            Union(opponent_cards, board_cards).EvaluateHand();
+        wins += value > opponent_value ? 1 : value == opponent_value ? 0.5 : 0;
+        ++num_opponents;
+      });
+  SPIEL_CHECK_GT(num_opponents, 0);
+  return wins / num_opponents;
+}
+
+CardAbstraction::CardAbstraction(std::vector<int> num_buckets)
+    : num_buckets_(std::move(num_buckets)), buckets_(num_buckets_.size()) {}
+
+int CardAbstraction::Bucket(int round, const CardSet& hole_cards,
+                            const CardSet& board_cards) const {
+  SPIEL_CHECK_GE(round, 0);
+  SPIEL_CHECK_LT(round, NumRounds());
+  auto it = buckets_[round].find(CanonicalHand(hole_cards, board_cards));
+  if (it == buckets_[round].end()) {
+    SpielFatalError(absl::StrCat("No bucket for hole cards ",
+                                 hole_cards.ToString(), " and board cards ",
+                                 board_cards.ToString(), " at round ",
+                                 round));
+  }
+  return it->second;
+}
+
+void CardAbstraction::SetBucket(int round, const CardSet& hole_cards,
+                                const CardSet& board_cards, int bucket) {
+  SPIEL_CHECK_GE(round, 0);
+  SPIEL_CHECK_LT(round, NumRounds());
+  SPIEL_CHECK_GE(bucket, 0);
+  SPIEL_CHECK_LT(bucket, num_buckets_[round]);
+  buckets_[round][CanonicalHand(hole_cards, board_cards)] = bucket;
+}
+
+// The table is written as text:
+//   card_abstraction <num rounds>
+// then for each round
+//   round <num buckets> <num hands>
+// followed by a line per hand, sorted
+//   <hole cards> <board cards> <bucket>
+// where the cards are the bits of the canonical CardSets, in decimal.
+void CardAbstraction::Save(const std::string& filename) const {
+  std::string contents = absl::StrCat("card_abstraction ", NumRounds(), "\n");
+  for (int round = 0; round < NumRounds(); ++round) {
+    absl::StrAppend(&contents, "round ", num_buckets_[round], " ",
+                    buckets_[round].size(), "\n");
+    std::vector<std::pair<std::pair<uint64_t, uint64_t>, int>> hands(
+        buckets_[round].begin(), buckets_[round].end());
+    std::sort(hands.begin(), hands.end());
+    for (const auto& [hand, bucket] : hands) {
+      absl::StrAppend(&contents, hand.first, " ", hand.second, " ", bucket,
+                      "\n");
+    }
+  }
+  file::File(filename, "w").Write(contents);
+}
+
+CardAbstraction CardAbstraction::Load(const std::string& filename) {
+  const std::string contents = file::File(filename, "r").ReadContents();
+  std::vector<absl::string_view> lines =
+      absl::StrSplit(contents, '\n', absl::SkipEmpty());
+  auto fail = [&filename](absl::string_view line) {
+    SpielFatalError(absl::StrCat("Bad card abstraction file ", filename,
+                                 " at line: ", line));
+  };
+  int line = 0;
+  auto next_fields = [&]() {
+    if (line >= lines.size()) fail("<end of file>");
+    return std::vector<absl::string_view>(absl::StrSplit(lines[line++], ' '));
+  };
+
+  std::vector<absl::string_view> fields = next_fields();
+  int num_rounds;
+  if (fields.size() != 2 || fields[0] != "card_abstraction" ||
+      !absl::SimpleAtoi(fields[1], &num_rounds)) {
+    fail(lines[0]);
+  }
+  std::vector<int> num_buckets(num_rounds);
+  std::vector<int> num_hands(num_rounds);
+  std::vector<int> first_line(num_rounds);
+  for (int round = 0; round < num_rounds; ++round) {
+    fields = next_fields();
+    if (fields.size() != 3 || fields[0] != "round" ||
+        !absl::SimpleAtoi(fields[1], &num_buckets[round]) ||
+        !absl::SimpleAtoi(fields[2], &num_hands[round])) {
+      fail(lines[line - 1]);
+    }
+    first_line[round] = line;
+    line += num_hands[round];
+  }
+  CardAbstraction abstraction(num_buckets);
+  for (int round = 0; round < num_rounds; ++round) {
+    auto& buckets = abstraction.buckets_[round];
+    buckets.reserve(num_hands[round]);
+    line = first_line[round];
+    for (int h = 0; h < num_hands[round]; ++h) {
+      fields = next_fields();
+      std::pair<uint64_t, uint64_t> hand;
+      int bucket;
+      if (fields.size() != 3 || !absl::SimpleAtoi(fields[0], &hand.first) ||
+          !absl::SimpleAtoi(fields[1], &hand.second) ||
+          !absl::SimpleAtoi(fields[2], &bucket) || bucket < 0 ||
+          bucket >= num_buckets[round]) {
+        fail(lines[line - 1]);
+      }
+      buckets[hand] = bucket;
+    }
+  }
+  return abstraction;
+}
+
+CardAbstraction BuildCardAbstraction(const CardAbstractionConfig& config) {
+  const int num_rounds = config.num_board_cards.size();
+  SPIEL_CHECK_EQ(config.num_buckets.size(), num_rounds);
+  SPIEL_CHECK_GE(config.num_histogram_bins, 1);
+  SPIEL_CHECK_GE(config.num_rollouts, 0);
+  const int total_board_cards = std::accumulate(
+      config.num_board_cards.begin(), config.num_board_cards.end(), 0);
+  SPIEL_CHECK_LE(config.num_hole_cards + total_board_cards,
+                 kMaxEvaluatedCards);
+  const CardSet deck(config.num_suits, config.num_ranks);
+  const std::vector<uint8_t> deck_cards = deck.ToCardArray();
+  ThreadPool pool(config.num_threads);
+
+  std::vector<std::vector<int>> round_buckets(num_rounds);
+  std::vector<std::vector<std::pair<CardSet, CardSet>>> round_hands(
+      num_rounds);
+  std::vector<int> num_buckets(num_rounds);
+  int num_board_cards = 0;
+  for (int round = 0; round < num_rounds; ++round) {
+    num_board_cards += config.num_board_cards[round];
+    // The canonical hands of the round.
+    std::vector<std::pair<CardSet, CardSet>>& hands = round_hands[round];
+    absl::flat_hash_map<std::pair<uint64_t, uint64_t>, int> seen;
+    ForEachSubset(deck_cards, config.num_hole_cards, [&](const CardSet& hole) {
+      ForEachSubset(
+          Difference(deck, hole).ToCardArray(), num_board_cards,
+          [&](const CardSet& board) {
+            const std::pair<uint64_t, uint64_t> canonical =
+                CanonicalHand(hole, board);
+            if (seen.emplace(canonical, hands.size()).second) {
+              CardSet canonical_hole;
+              CardSet canonical_board;
+              canonical_hole.cs.cards = canonical.first;
+              canonical_board.cs.cards = canonical.second;
+              hands.push_back({canonical_hole, canonical_board});
+            }
+          });
+    });
+
+    RoundFeatures features;
+    const int num_to_come = total_board_cards - num_board_cards;
+    features.dim = num_to_come == 0 ? 1 : config.num_histogram_bins;
+    features.points.resize(hands.size() * features.dim);
+    features.ehs.resize(hands.size());
+    pool.ParallelFor(0, hands.size(), [&](int i) {
+      std::seed_seq seed{config.seed, round, i};
+      std::mt19937 rng(seed);
+      ComputeFeatures(config, deck, hands[i].first, hands[i].second,
+                      num_to_come, &rng, &features.points[i * features.dim],
+                      &features.ehs[i]);
+    });
+
+    const int k = std::min<int>(config.num_buckets[round], hands.size());
+    SPIEL_CHECK_GE(k, 1);
+    std::seed_seq seed{config.seed, round};
+    std::mt19937 rng(seed);
+    std::vector<int> clusters =
+        KMeans(features, k, config.max_kmeans_iterations, &rng, &pool);
+
+    // Number the clusters by increasing average EHS.
+    std::vector<double> ehs(k, 0);
+    std::vector<int> sizes(k, 0);
+    for (int i = 0; i < clusters.size(); ++i) {
+      ehs[clusters[i]] += features.ehs[i];
+      ++sizes[clusters[i]];
+    }
+    for (int c = 0; c < k; ++c) ehs[c] /= sizes[c];
+    std::vector<int> order(k);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&ehs](int a, int b) { return ehs[a] < ehs[b]; });
+    std::vector<int> bucket_of_cluster(k);
+    for (int b = 0; b < k; ++b) bucket_of_cluster[order[b]] = b;
+    for (int& cluster : clusters) cluster = bucket_of_cluster[cluster];
+    round_buckets[round] = std::move(clusters);
+    num_buckets[round] = k;
+  }
+
+  CardAbstraction abstraction(num_buckets);
+  for (int round = 0; round < num_rounds; ++round) {
+    for (int i = 0; i < round_hands[round].size(); ++i) {
+      abstraction.SetBucket(round, round_hands[round][i].first,
+                            round_hands[round][i].second,
+                            round_buckets[round][i]);
+    }
+  }
+  return abstraction;
+}
+
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
@@ -0,0 +1,121 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPEN_SPIEL_CARD_ABSTRACTION_H
+#define OPEN_SPIEL_CARD_ABSTRACTION_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+
+// Card abstraction for universal_poker: the hands of each round, a player's
+// hole cards with the board cards dealt so far, are grouped into buckets of
+// hands of similar strength, and the information states then only tell the
+// buckets of the player's hands instead of the cards.
+//
+// The buckets are built by BuildCardAbstraction, as in Johanson et al.,
+// "Evaluating State-Space Abstractions in Extensive-Form Games", 2013:
+// - On the last round, a hand is described by its hand strength, the
+//   probability of beating the hole cards of a random opponent, counting
+//   ties as half.
+// - On the other rounds, it is described by the histogram of the hand
+//   strengths of its completions to a whole board, the board cards to come
+//   being enumerated or sampled. The mean of the histogram is the expected
+//   hand strength (EHS), but hands of the same EHS might differ in how
+//   drawing they are, which the histograms tell apart.
+// - The hands are clustered by k-means, under the earth mover's distance
+//   between the histograms, which for one-dimensional histograms is the L1
+//   distance between their cumulative sums (and |a - b| between strengths).
+//   The centroids are means of the cumulative histograms.
+//
+// Hands equal up to a permutation of the suits play the same, so they are
+// put in the same bucket, and only the first of them is evaluated and stored:
+// the suits are renumbered canonically by CanonicalHand.
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+
+// The hole and board cards of a hand, with the suits renumbered by the
+// decreasing order of their (hole, board) cards, so that hands equal up to
+// a permutation of the suits have the same canonical hand.
+std::pair<uint64_t, uint64_t> CanonicalHand(const CardSet& hole_cards,
+                                            const CardSet& board_cards);
+
+// Returns the probability that the hand beats the hole cards of a random
+// opponent, drawn from the cards of `deck` not in the hand, with ties
+// counting as half. The board must be complete.
+double HandStrength(const CardSet& hole_cards, const CardSet& board_cards,
+                    const CardSet& deck);
+
+// The buckets of the canonical hands of each round.
+class CardAbstraction {
+ public:
+  explicit CardAbstraction(std::vector<int> num_buckets = {});
+
+  // Reads a table written by Save.
+  static CardAbstraction Load(const std::string& filename);
+  void Save(const std::string& filename) const;
+
+  int NumRounds() const { return num_buckets_.size(); }
+  int NumBuckets(int round) const { return num_buckets_[round]; }
+  int NumHands(int round) const { return buckets_[round].size(); }
+
+  // The bucket of the hand at `round`, whose board cards are those dealt up
+  // to that round. Fails if the hand is not in the table.
+  int Bucket(int round, const CardSet& hole_cards,
+             const CardSet& board_cards) const;
+  void SetBucket(int round, const CardSet& hole_cards,
+                 const CardSet& board_cards, int bucket);
+
+ private:
+  std::vector<int> num_buckets_;
+  std::vector<absl::flat_hash_map<std::pair<uint64_t, uint64_t>, int>>
+      buckets_;
+};
+
+struct CardAbstractionConfig {
+  int num_suits = 4;
+  int num_ranks = 13;
+  int num_hole_cards = 2;
+  // The number of board cards dealt in each round, e.g. {0, 3, 1, 1} for
+  // hold'em, and the number of buckets in each round.
+  std::vector<int> num_board_cards;
+  std::vector<int> num_buckets;
+  // The resolution of the hand strength histograms.
+  int num_histogram_bins = 30;
+  // The number of board completions sampled for the histogram of each hand,
+  // or 0 to enumerate them all.
+  int num_rollouts = 0;
+  int max_kmeans_iterations = 100;
+  // The hands are evaluated and the k-means assignments made in parallel,
+  // which does not change the buckets.
+  int num_threads = 1;
+  int seed = 0;
+};
+
+// Builds the buckets of all the hands of each round, numbered by increasing
+// average EHS of their hands. Rounds with fewer distinct hands than buckets
+// get a bucket per hand.
+CardAbstraction BuildCardAbstraction(const CardAbstractionConfig& config);
+
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+#endif  // OPEN_SPIEL_CARD_ABSTRACTION_H
@@ -0,0 +1,170 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/games/universal_poker/logic/card_set.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel {
+namespace universal_poker {
+namespace logic {
+namespace {
+
+// Cards are numbered rank * kMaxSuits + suit.
+CardSet Cards(std::vector<int> cards) { return CardSet(cards); }
+int Card(int rank, int suit) { return rank * kMaxSuits + suit; }
+
+bool SameCanonicalHand(const std::string& hole_a, const std::string& board_a,
+                       const std::string& hole_b, const std::string& board_b) {
+  return CanonicalHand(CardSet(hole_a), CardSet(board_a)) ==
+         CanonicalHand(CardSet(hole_b), CardSet(board_b));
+}
+
+void CanonicalHandTests() {
+  SPIEL_CHECK_TRUE(SameCanonicalHand("AhKh", "2c", "AsKs", "2d"));
+  SPIEL_CHECK_TRUE(SameCanonicalHand("AhKs", "", "AcKd", ""));
+  SPIEL_CHECK_FALSE(SameCanonicalHand("AhKh", "", "AhKs", ""));
+  // The board cards matter for the suits too.
+  SPIEL_CHECK_FALSE(SameCanonicalHand("AhKs", "2h", "AhKs", "2c"));
+  SPIEL_CHECK_TRUE(SameCanonicalHand("AhKs", "2h", "AsKh", "2s"));
+}
+
+void HandStrengthTests() {
+  // A deck of three ranks and two suits, with one hole card and no board:
+  // the highest card only ties with the other of its rank.
+  const CardSet deck(/*num_suits=*/2, /*num_ranks=*/3);
+  SPIEL_CHECK_FLOAT_EQ(HandStrength(Cards({Card(2, 0)}), CardSet(), deck),
+                       4.5 / 5);
+  SPIEL_CHECK_FLOAT_EQ(HandStrength(Cards({Card(0, 1)}), CardSet(), deck),
+                       0.5 / 5);
+  // A pair with the board beats everything.
+  SPIEL_CHECK_FLOAT_EQ(
+      HandStrength(Cards({Card(0, 0)}), Cards({Card(0, 1)}), deck), 1.0);
+}
+
+CardAbstractionConfig LeducConfig() {
+  CardAbstractionConfig config;
+  config.num_suits = 2;
+  config.num_ranks = 3;
+  config.num_hole_cards = 1;
+  config.num_board_cards = {0, 1};
+  config.num_buckets = {5, 2};
+  config.num_histogram_bins = 4;
+  return config;
+}
+
+void BuildLeducAbstraction() {
+  CardAbstractionConfig config = LeducConfig();
+  const CardAbstraction abstraction = BuildCardAbstraction(config);
+  SPIEL_CHECK_EQ(abstraction.NumRounds(), 2);
+  // One hand per rank before the flop, so as many buckets.
+  SPIEL_CHECK_EQ(abstraction.NumHands(0), 3);
+  SPIEL_CHECK_EQ(abstraction.NumBuckets(0), 3);
+  for (int rank = 0; rank < 3; ++rank) {
+    for (int suit = 0; suit < 2; ++suit) {
+      SPIEL_CHECK_EQ(
+          abstraction.Bucket(0, Cards({Card(rank, suit)}), CardSet()), rank);
+    }
+  }
+  // After the flop, a hand is a pair, or two ranks of the same or different
+  // suits.
+  SPIEL_CHECK_EQ(abstraction.NumHands(1), 3 + 3 * 2 * 2);
+  SPIEL_CHECK_EQ(abstraction.NumBuckets(1), 2);
+  const int pair = abstraction.Bucket(1, Cards({Card(0, 0)}),
+                                      Cards({Card(0, 1)}));
+  const int low_card = abstraction.Bucket(1, Cards({Card(1, 0)}),
+                                          Cards({Card(2, 1)}));
+  SPIEL_CHECK_EQ(pair, 1);
+  SPIEL_CHECK_EQ(low_card, 0);
+
+  // The buckets do not depend on the number of threads.
+  config.num_threads = 3;
+  const CardAbstraction parallel = BuildCardAbstraction(config);
+  for (int hole = 0; hole < 3; ++hole) {
+    for (int board = 0; board < 3; ++board) {
+      for (int suit = 0; suit < 2; ++suit) {
+        const CardSet hole_cards = Cards({Card(hole, 0)});
+        const CardSet board_cards = Cards({Card(board, suit)});
+        if (hole == board && suit == 0) continue;
+        SPIEL_CHECK_EQ(abstraction.Bucket(1, hole_cards, board_cards),
+                       parallel.Bucket(1, hole_cards, board_cards));
+      }
+    }
+  }
+}
+
+// Sampled completions of a hold'em-like deck before the turn.
+void SampledHistograms() {
+  CardAbstractionConfig config;
+  config.num_suits = 2;
+  config.num_ranks = 6;
+  config.num_hole_cards = 2;
+  config.num_board_cards = {0, 2, 1};
+  config.num_buckets = {4, 6, 6};
+  config.num_rollouts = 50;
+  config.num_threads = 2;
+  const CardAbstraction abstraction = BuildCardAbstraction(config);
+  SPIEL_CHECK_EQ(abstraction.NumBuckets(0), 4);
+  // Pocket aces are in the best bucket, and 2-3 offsuit in the worst.
+  const int top_rank = config.num_ranks - 1;
+  SPIEL_CHECK_EQ(abstraction.Bucket(0, Cards({Card(top_rank, 0),
+                                              Card(top_rank, 1)}),
+                                    CardSet()),
+                 3);
+  SPIEL_CHECK_EQ(abstraction.Bucket(0, Cards({Card(0, 0), Card(1, 1)}),
+                                    CardSet()),
+                 0);
+}
+
+void SaveAndLoad() {
+  const CardAbstraction abstraction = BuildCardAbstraction(LeducConfig());
+  const char* tmp_dir = std::getenv("TMPDIR");
+  const std::string filename =
+      absl::StrCat(tmp_dir != nullptr ? tmp_dir : "/tmp",
+                   "/open_spiel-test-card-abstraction-", std::rand());
+  abstraction.Save(filename);
+  const CardAbstraction loaded = CardAbstraction::Load(filename);
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+  SPIEL_CHECK_EQ(loaded.NumRounds(), abstraction.NumRounds());
+  for (int round = 0; round < loaded.NumRounds(); ++round) {
+    SPIEL_CHECK_EQ(loaded.NumBuckets(round), abstraction.NumBuckets(round));
+    SPIEL_CHECK_EQ(loaded.NumHands(round), abstraction.NumHands(round));
+  }
+  for (int hole = 0; hole < 3; ++hole) {
+    SPIEL_CHECK_EQ(loaded.Bucket(1, Cards({Card(hole, 1)}),
+                                 Cards({Card(2, 0)})),
+                   abstraction.Bucket(1, Cards({Card(hole, 1)}),
+                                      Cards({Card(2, 0)})));
+  }
+}
+
+}  // namespace
+}  // namespace logic
+}  // namespace universal_poker
+}  // namespace open_spiel
+
+int main(int argc, char **argv) {
+  open_spiel::universal_poker::logic::CanonicalHandTests();
+  open_spiel::universal_poker::logic::HandStrengthTests();
+  open_spiel::universal_poker::logic::BuildLeducAbstraction();
+  open_spiel::universal_poker::logic::SampledHistograms();
+  open_spiel::universal_poker::logic::SaveAndLoad();
+}
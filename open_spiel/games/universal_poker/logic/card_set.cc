@@ -14,10 +14,13 @@
 
 #include "open_spiel/games/universal_poker/logic/card_set.h"
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/spiel_utils.h"
@@ -45,6 +48,214 @@ uint64_t bit_twiddle_permute(uint64_t v) {
   return w;
 }
 
+namespace {
+
+enum HandCategory {
+  kHighCard,
+  kPair,
+  kTwoPair,
+  kThreeOfAKind,
+  kStraight,
+  kFlush,
+  kFullHouse,
+  kFourOfAKind,
+  kStraightFlush
+};
+
+constexpr int kMaxRankCount = MAX_SUITS;
+
+// Packs the category of a hand with the ranks that break ties, most
+// significant first, in 4 bits each so that missing ranks come lowest.
+int HandValue(HandCategory category, const std::vector<int>& ranks) {
+  int value = category;
+  for (int i = 0; i < 5; ++i) {
+    value = (value << 4) | (i < ranks.size() ? ranks[i] + 1 : 0);
+  }
+  return value;
+}
+
+int HighestRank(uint32_t ranks) { return 31 - __builtin_clz(ranks); }
+
+// Appends the `n` highest ranks in `ranks`, highest first.
+void AppendHighestRanks(uint32_t ranks, int n, std::vector<int>* result) {
+  for (int rank = MAX_RANKS - 1; rank >= 0 && n > 0; --rank) {
+    if (ranks & (1 << rank)) {
+      result->push_back(rank);
+      --n;
+    }
+  }
+}
+
+// Returns the highest rank of a straight in `ranks`, or -1. The ace also
+// plays below the 2.
+int StraightHighRank(uint32_t ranks) {
+  const uint32_t shifted = (ranks << 1) | ((ranks >> (MAX_RANKS - 1)) & 1);
+  for (int rank = MAX_RANKS - 1; rank >= 3; --rank) {
+    const uint32_t straight = 0x1F << (rank - 3);
+    if ((shifted & straight) == straight) return rank;
+  }
+  return -1;
+}
+
+// The value of the best flush or straight flush in the ranks of a suit.
+int ComputeFlushValue(uint32_t ranks) {
+  std::vector<int> tie_ranks;
+  const int straight_rank = StraightHighRank(ranks);
+  if (straight_rank >= 0) {
+    tie_ranks.push_back(straight_rank);
+    return HandValue(kStraightFlush, tie_ranks);
+  }
+  AppendHighestRanks(ranks, 5, &tie_ranks);
+  return HandValue(kFlush, tie_ranks);
+}
+
+// The value of the best hand other than a flush with the given number of
+// cards of each rank.
+int ComputeRankCountsValue(const std::array<int, MAX_RANKS>& counts) {
+  uint32_t present = 0, pairs = 0, trips = 0, quads = 0;
+  for (int rank = 0; rank < MAX_RANKS; ++rank) {
+    if (counts[rank] >= 1) present |= 1 << rank;
+    if (counts[rank] >= 2) pairs |= 1 << rank;
+    if (counts[rank] >= 3) trips |= 1 << rank;
+    if (counts[rank] >= 4) quads |= 1 << rank;
+  }
+  std::vector<int> ranks;
+  if (quads) {
+    ranks.push_back(HighestRank(quads));
+    AppendHighestRanks(present & ~(1 << ranks[0]), 1, &ranks);
+    return HandValue(kFourOfAKind, ranks);
+  }
+  if (trips && (pairs & ~(1 << HighestRank(trips)))) {
+    ranks.push_back(HighestRank(trips));
+    ranks.push_back(HighestRank(pairs & ~(1 << ranks[0])));
+    return HandValue(kFullHouse, ranks);
+  }
+  const int straight_rank = StraightHighRank(present);
+  if (straight_rank >= 0) {
+    ranks.push_back(straight_rank);
+    return HandValue(kStraight, ranks);
+  }
+  if (trips) {
+    ranks.push_back(HighestRank(trips));
+    AppendHighestRanks(present & ~trips, 2, &ranks);
+    return HandValue(kThreeOfAKind, ranks);
+  }
+  if (__builtin_popcount(pairs) >= 2) {
+    AppendHighestRanks(pairs, 2, &ranks);
+    AppendHighestRanks(present & ~(1 << ranks[0]) & ~(1 << ranks[1]), 1,
+                       &ranks);
+    return HandValue(kTwoPair, ranks);
+  }
+  if (pairs) {
+    ranks.push_back(HighestRank(pairs));
+    AppendHighestRanks(present & ~pairs, 3, &ranks);
+    return HandValue(kPair, ranks);
+  }
+  AppendHighestRanks(present, 5, &ranks);
+  return HandValue(kHighCard, ranks);
+}
+
+// The tables of EvaluateHand.
+//
+// The multisets of ranks are numbered by a perfect hash: those of n cards
+// come after those of fewer cards, and are ordered lexicographically by their
+// counts of each rank. The index of a multiset is then a sum of terms, one per
+// rank, given by the rank, its count and the number of cards of the higher
+// ranks.
+class HandTables {
+ public:
+  HandTables();
+
+  int FlushValue(uint16_t ranks) const { return flush_values_[ranks]; }
+  int RankCountsValue(int index) const { return rank_counts_values_[index]; }
+  // The index of a multiset, by adding the terms of each rank from the
+  // highest, given the number of cards of that rank and below.
+  int FirstIndex(int num_cards) const { return first_index_[num_cards]; }
+  int IndexTerm(int rank, int num_cards, int count) const {
+    return index_terms_[rank][num_cards][count];
+  }
+
+ private:
+  void AddRankCounts(int rank, int num_cards,
+                     std::array<int, MAX_RANKS>* counts);
+
+  // The number of multisets of n cards over r ranks, by [r][n].
+  std::array<std::array<int, kMaxEvaluatedCards + 1>, MAX_RANKS + 1>
+      num_multisets_{};
+  std::array<int, kMaxEvaluatedCards + 1> first_index_{};
+  // By [rank][cards of that rank and below][count of the rank].
+  std::array<std::array<std::array<int, kMaxRankCount + 1>,
+                        kMaxEvaluatedCards + 1>,
+             MAX_RANKS>
+      index_terms_{};
+  std::vector<int> flush_values_;
+  std::vector<int> rank_counts_values_;
+};
+
+HandTables::HandTables() : flush_values_(1 << MAX_RANKS, 0) {
+  for (uint32_t ranks = 0; ranks < flush_values_.size(); ++ranks) {
+    if (__builtin_popcount(ranks) >= 5) {
+      flush_values_[ranks] = ComputeFlushValue(ranks);
+    }
+  }
+
+  num_multisets_[0][0] = 1;
+  for (int r = 1; r <= MAX_RANKS; ++r) {
+    for (int n = 0; n <= kMaxEvaluatedCards; ++n) {
+      for (int count = 0; count <= std::min(n, kMaxRankCount); ++count) {
+        num_multisets_[r][n] += num_multisets_[r - 1][n - count];
+      }
+    }
+  }
+  for (int n = 1; n <= kMaxEvaluatedCards; ++n) {
+    first_index_[n] = first_index_[n - 1] + num_multisets_[MAX_RANKS][n - 1];
+  }
+  // The multisets with fewer cards of a rank come first, each followed by
+  // the multisets of the ranks below it.
+  for (int rank = 0; rank < MAX_RANKS; ++rank) {
+    for (int n = 0; n <= kMaxEvaluatedCards; ++n) {
+      for (int count = 1; count <= std::min(n, kMaxRankCount); ++count) {
+        index_terms_[rank][n][count] = index_terms_[rank][n][count - 1] +
+                                       num_multisets_[rank][n - count + 1];
+      }
+    }
+  }
+
+  rank_counts_values_.resize(first_index_[kMaxEvaluatedCards] +
+                             num_multisets_[MAX_RANKS][kMaxEvaluatedCards]);
+  std::array<int, MAX_RANKS> counts{};
+  AddRankCounts(MAX_RANKS - 1, 0, &counts);
+}
+
+// Fills in the values of the multisets with the given counts of the ranks
+// above `rank` and any counts below, of `num_cards` cards so far.
+void HandTables::AddRankCounts(int rank, int num_cards,
+                               std::array<int, MAX_RANKS>* counts) {
+  if (rank < 0) {
+    int index = first_index_[num_cards];
+    for (int r = MAX_RANKS - 1; r >= 0; --r) {
+      index += index_terms_[r][num_cards][(*counts)[r]];
+      num_cards -= (*counts)[r];
+    }
+    rank_counts_values_[index] = ComputeRankCountsValue(*counts);
+    return;
+  }
+  const int max_count =
+      std::min(kMaxRankCount, kMaxEvaluatedCards - num_cards);
+  for (int count = 0; count <= max_count; ++count) {
+    (*counts)[rank] = count;
+    AddRankCounts(rank - 1, num_cards + count, counts);
+  }
+  (*counts)[rank] = 0;
+}
+
+const HandTables& GetHandTables() {
+  static const auto* tables = new HandTables();
+  return *tables;
+}
+
+}  // namespace
+
 CardSet::CardSet(std::string cardString) : cs() {
   for (int i = 0; i < cardString.size(); i += 2) {
     char rankChr = cardString[i];
@@ -104,6 +315,17 @@ std::vector<uint8_t> CardSet::ToCardArray() const {
   return result;
 }
 
+uint8_t CardSet::NthCard(int n) const {
+  SPIEL_CHECK_GE(n, 0);
+  for (int r = 0; r < MAX_RANKS; ++r) {
+    for (int s = 0; s < MAX_SUITS; ++s) {
+      uint32_t mask = (uint32_t)1 << r;
+      if ((cs.bySuit[s] & mask) && n-- == 0) return makeCard(r, s);
+    }
+  }
+  SpielFatalError("CardSet::NthCard: n is not less than NumCards().");
+}
+
 void CardSet::AddCard(uint8_t card) {
   int rank = rankOfCard(card);
   int suit = suitOfCard(card);
@@ -148,6 +370,31 @@ std::vector<CardSet> CardSet::SampleCards(int nbCards) {
   return combinations;
 }
 
+int CardSet::EvaluateHand() const {
+  const int num_cards = NumCards();
+  SPIEL_CHECK_LE(num_cards, kMaxEvaluatedCards);
+  const HandTables& tables = GetHandTables();
+  int value = 0;
+  for (int suit = 0; suit < MAX_SUITS; ++suit) {
+    // Only one suit can have 5 of the cards.
+    if (__builtin_popcount(cs.bySuit[suit]) >= 5) {
+      value = tables.FlushValue(cs.bySuit[suit]);
+      break;
+    }
+  }
+  int index = tables.FirstIndex(num_cards);
+  int cards_left = num_cards;
+  for (int rank = MAX_RANKS - 1; rank >= 0 && cards_left > 0; --rank) {
+    int count = 0;
+    for (int suit = 0; suit < MAX_SUITS; ++suit) {
+      count += (cs.bySuit[suit] >> rank) & 1;
+    }
+    index += tables.IndexTerm(rank, cards_left, count);
+    cards_left -= count;
+  }
+  return std::max(value, tables.RankCountsValue(index));
+}
+
 bool CardSet::ContainsCards(uint8_t card) const {
   int rank = rankOfCard(card);
   int suit = suitOfCard(card);
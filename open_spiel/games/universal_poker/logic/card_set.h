@@ -24,6 +24,8 @@ namespace universal_poker {
 namespace logic {
 
 constexpr int kMaxSuits = 4;  // Also defined in ACPC game.h
+// The most cards that EvaluateHand accepts.
+constexpr int kMaxEvaluatedCards = 7;
 
 // This is an equivalent wrapper to acpc evalHandTables.Cardset.
 // It stores the cards for each color over 16 * 4 bits. The use of a Union
@@ -47,6 +49,8 @@ class CardSet {
   std::string ToString() const;
   // Returns the cards present in this set in ascending order.
   std::vector<uint8_t> ToCardArray() const;
+  // Returns ToCardArray()[n], without building the array.
+  uint8_t NthCard(int n) const;
 
   // Add a card, as MAX_RANKS * <suite> + <rank> to the CardSet.
   void AddCard(uint8_t card);
@@ -57,6 +61,12 @@ class CardSet {
   int NumCards() const;
   // Returns the ranking value of this set of cards as evaluated by ACPC.
   int RankCards() const;
+  // Returns the value of the best five-card hand in this set of at most
+  // kMaxEvaluatedCards cards. Hands compare as by RankCards, although the
+  // values differ, but are evaluated by a few table lookups: a table of the
+  // flushes by the ranks of a suit, and a perfect hash of the multiset of
+  // ranks for the other hands.
+  int EvaluateHand() const;
 
   // TODO(author2): Remove?
   std::vector<CardSet> SampleCards(int nbCards);
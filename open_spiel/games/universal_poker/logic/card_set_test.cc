@@ -14,7 +14,13 @@
 
 #include "open_spiel/games/universal_poker/logic/card_set.h"
 
+#include <algorithm>
 #include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 namespace universal_poker {
@@ -44,10 +50,46 @@ void BasicCardSetTests() {
   }
 }
 
+void EvaluateHandTests() {
+  // Ordered from the weakest hand.
+  const std::vector<std::string> hands = {
+      "2c3d4h5s7c", "AcKdQhJs9c", "2c2d", "2c2d3h", "AcAdKhQsJc",
+      "2c2d3h3s",   "AcAdKhKs",   "AcAdKhKs2c", "7c7d7h", "Ac2d3h4s5c",
+      "2c3d4h5s6c", "TcJdQhKsAc", "2c3c4c5c7c", "AcKcQcJc9c", "2c2d2h3s3c",
+      "AcAdAhKsKc", "2c2d2h2s",   "2c2d2h2s3c", "Ac2c3c4c5c", "TcJcQcKcAc"};
+  for (int i = 1; i < hands.size(); ++i) {
+    SPIEL_CHECK_LT(CardSet(hands[i - 1]).EvaluateHand(),
+                   CardSet(hands[i]).EvaluateHand());
+  }
+  // The best five cards decide.
+  SPIEL_CHECK_EQ(CardSet("AcAdKhKsQc2d2h").EvaluateHand(),
+                 CardSet("AhAsKcKdQs").EvaluateHand());
+  SPIEL_CHECK_EQ(CardSet("AcKcQcJcTc9c8c").EvaluateHand(),
+                 CardSet("AhKhQhJhTh").EvaluateHand());
+
+  // Hands compare as ranked by ACPC.
+  std::mt19937 rng(0);
+  std::vector<int> deck(kMaxSuits * 13);
+  for (int card = 0; card < deck.size(); ++card) deck[card] = card;
+  for (int i = 0; i < 100000; ++i) {
+    const int num_cards = 1 + i % kMaxEvaluatedCards;
+    std::shuffle(deck.begin(), deck.end(), rng);
+    const CardSet first(
+        std::vector<int>(deck.begin(), deck.begin() + num_cards));
+    const CardSet second(std::vector<int>(deck.begin() + num_cards,
+                                          deck.begin() + 2 * num_cards));
+    SPIEL_CHECK_EQ(first.EvaluateHand() < second.EvaluateHand(),
+                   first.RankCards() < second.RankCards());
+    SPIEL_CHECK_EQ(first.EvaluateHand() == second.EvaluateHand(),
+                   first.RankCards() == second.RankCards());
+  }
+}
+
 }  // namespace logic
 }  // namespace universal_poker
 }  // namespace open_spiel
 
 int main(int argc, char **argv) {
   open_spiel::universal_poker::logic::BasicCardSetTests();
+  open_spiel::universal_poker::logic::EvaluateHandTests();
 }
@@ -14,15 +14,24 @@
 
 #include "open_spiel/games/universal_poker.h"
 
+#include <cstdlib>
 #include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/game_parameters.h"
+#include "open_spiel/games/universal_poker/logic/card_abstraction.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/utils/file.h"
 
 namespace open_spiel {
 namespace universal_poker {
@@ -191,6 +200,11 @@ void BasicUniversalPokerTests() {
   testing::LoadGameTest("universal_poker");
   testing::ChanceOutcomesTest(*LoadGame("universal_poker"));
   testing::RandomSimTest(*LoadGame("universal_poker"), 100);
+  testing::RandomSimTestWithUndo(*LoadGame("universal_poker"), 100);
+  testing::RandomSimTestWithUndo(
+      *LoadGame("universal_poker", HoldemNoLimit6PParameters()), 3);
+  testing::ResampleInfostateTest(*LoadGame("universal_poker"),
+                                 /*num_sims=*/10);
 
   // testing::RandomSimBenchmark("leduc_poker", 10000, false);
   // testing::RandomSimBenchmark("universal_poker", 10000, false);
@@ -230,6 +244,88 @@ void ChumpPolicyTests() {
   }
 }
 
+// The returns at heads-up showdowns come from the cached hand values rather
+// than from ACPC.
+void ShowdownReturnsMatchACPCTest() {
+  for (const std::string &game_string :
+       {std::string(kHULHString),
+        std::string("universal_poker(betting=nolimit,numPlayers=2,numRounds=4,"
+                    "blind=100 50,firstPlayer=2 1 1 1,numSuits=4,numRanks=13,"
+                    "numHoleCards=2,numBoardCards=0 3 1 1,stack=400 1200)")}) {
+    std::shared_ptr<const Game> game = LoadGame(game_string);
+    std::mt19937 rng(0);
+    for (int i = 0; i < 1000; ++i) {
+      std::unique_ptr<State> state = game->NewInitialState();
+      while (!state->IsTerminal()) {
+        std::vector<Action> actions = state->LegalActions();
+        // Never folding, to reach showdowns.
+        if (!state->IsChanceNode() && actions[0] == kFold) {
+          actions.erase(actions.begin());
+        }
+        state->ApplyAction(actions[absl::Uniform<int>(rng, 0, actions.size())]);
+      }
+      const auto &poker_state = down_cast<const UniversalPokerState &>(*state);
+      const std::vector<double> returns = state->Returns();
+      for (Player player = 0; player < 2; ++player) {
+        SPIEL_CHECK_EQ(returns[player], poker_state.GetTotalReward(player));
+      }
+    }
+  }
+}
+
+// Adds the information state strings of the players below `state`.
+void CollectInfoStates(const State &state, std::set<std::string> *info_states) {
+  if (state.IsTerminal()) return;
+  if (!state.IsChanceNode()) {
+    info_states->insert(state.InformationStateString());
+  }
+  for (Action action : state.LegalActions()) {
+    CollectInfoStates(*state.Child(action), info_states);
+  }
+}
+
+// The buckets of a card abstraction replace the cards in the information
+// states, of which there are then fewer.
+void CardAbstractionTest() {
+  GameParameters params = {
+      {"betting", GameParameter(std::string("limit"))},
+      {"numPlayers", GameParameter(2)},
+      {"numRounds", GameParameter(2)},
+      {"blind", GameParameter(std::string("1 1"))},
+      {"raiseSize", GameParameter(std::string("2 4"))},
+      {"firstPlayer", GameParameter(std::string("1 1"))},
+      {"maxRaises", GameParameter(std::string("2 2"))},
+      {"numSuits", GameParameter(2)},
+      {"numRanks", GameParameter(3)},
+      {"numHoleCards", GameParameter(1)},
+      {"numBoardCards", GameParameter(std::string("0 1"))}};
+  logic::CardAbstractionConfig config;
+  config.num_suits = 2;
+  config.num_ranks = 3;
+  config.num_hole_cards = 1;
+  config.num_board_cards = {0, 1};
+  config.num_buckets = {2, 3};
+  const char *tmp_dir = std::getenv("TMPDIR");
+  const std::string filename =
+      absl::StrCat(tmp_dir != nullptr ? tmp_dir : "/tmp",
+                   "/open_spiel-test-universal-poker-", std::rand());
+  logic::BuildCardAbstraction(config).Save(filename);
+
+  std::shared_ptr<const Game> game = LoadGame("universal_poker", params);
+  params["cardAbstraction"] = GameParameter(filename);
+  std::shared_ptr<const Game> abstract_game =
+      LoadGame("universal_poker", params);
+  std::set<std::string> info_states;
+  CollectInfoStates(*game->NewInitialState(), &info_states);
+  std::set<std::string> abstract_info_states;
+  CollectInfoStates(*abstract_game->NewInitialState(), &abstract_info_states);
+  SPIEL_CHECK_LT(abstract_info_states.size(), info_states.size());
+  SPIEL_CHECK_NE(abstract_info_states.begin()->find("[Buckets: "),
+                 std::string::npos);
+  testing::RandomSimTest(*abstract_game, 20);
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+}
+
 }  // namespace
 }  // namespace universal_poker
 }  // namespace open_spiel
@@ -244,4 +340,6 @@ int main(int argc, char **argv) {
   open_spiel::universal_poker::BasicUniversalPokerTests();
   open_spiel::universal_poker::HUNLRegressionTests();
   open_spiel::universal_poker::ChumpPolicyTests();
+  open_spiel::universal_poker::ShowdownReturnsMatchACPCTest();
+  open_spiel::universal_poker::CardAbstractionTest();
 }
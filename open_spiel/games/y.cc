@@ -221,9 +221,16 @@ std::string YState::ToString() const {
 }
 
 std::vector<double> YState::Returns() const {
-  if (outcome_ == kPlayer1) return {1, -1};
-  if (outcome_ == kPlayer2) return {-1, 1};
-  return {0, 0};  // Unfinished
+  std::vector<double> returns(num_players_);
+  Returns(absl::MakeSpan(returns));
+  return returns;
+}
+
+void YState::Returns(absl::Span<double> returns) const {
+  SPIEL_CHECK_EQ(returns.size(), num_players_);
+  // Unfinished games are worth 0.
+  returns[0] = outcome_ == kPlayer1 ? 1.0 : outcome_ == kPlayer2 ? -1.0 : 0.0;
+  returns[1] = outcome_ == kPlayer2 ? 1.0 : outcome_ == kPlayer1 ? -1.0 : 0.0;
 }
 
 std::string YState::InformationStateString(Player player) const {
@@ -249,6 +256,16 @@ int PlayerRelative(YPlayer state, Player current) {
   }
 }
 
+template <class T>
+void YState::WriteObservationTensor(Player player,
+                                    TensorView<2, T>& view) const {
+  for (int i = 0; i < board_.size(); ++i) {
+    if (board_[i].player != kPlayerInvalid) {
+      view[{PlayerRelative(board_[i].player, player), i}] = 1.0;
+    }
+  }
+}
+
 void YState::ObservationTensor(Player player,
                                std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
@@ -256,11 +273,17 @@ void YState::ObservationTensor(Player player,
 
   TensorView<2> view(values, {kCellStates, static_cast<int>(board_.size())},
                      true);
-  for (int i = 0; i < board_.size(); ++i) {
-    if (board_[i].player != kPlayerInvalid) {
-      view[{PlayerRelative(board_[i].player, player), i}] = 1.0;
-    }
-  }
+  WriteObservationTensor(player, view);
+}
+
+void YState::ObservationTensor(Player player,
+                               absl::Span<float> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  TensorView<2, float> view(
+      values, {kCellStates, static_cast<int>(board_.size())}, true);
+  WriteObservationTensor(player, view);
 }
 
 void YState::DoApplyAction(Action action) {
@@ -323,6 +346,20 @@ std::unique_ptr<State> YState::Clone() const {
   return std::unique_ptr<State>(new YState(*this));
 }
 
+bool YState::CopyFrom(const State& other) {
+  SPIEL_CHECK_EQ(other.GetGame(), game_);
+  // The const members only depend on the game parameters, so they already
+  // match those of `other`.
+  const auto& state = static_cast<const YState&>(other);
+  State::operator=(state);
+  board_ = state.board_;
+  current_player_ = state.current_player_;
+  outcome_ = state.outcome_;
+  moves_made_ = state.moves_made_;
+  last_move_ = state.last_move_;
+  return true;
+}
+
 YGame::YGame(const GameParameters& params)
     : Game(kGameType, params),
       board_size_(ParameterValue<int>("board_size")),
@@ -22,7 +22,9 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/utils/tensor_view.h"
 
 // https://en.wikipedia.org/wiki/Y_(game)
 // Does not implement pie rule to balance the game
@@ -128,6 +130,7 @@ class YState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override { return outcome_ != kPlayerNone; }
   std::vector<double> Returns() const override;
+  void Returns(absl::Span<double> returns) const override;
   std::string InformationStateString(Player player) const override;
   std::string ObservationString(Player player) const override;
 
@@ -135,7 +138,10 @@ class YState : public State {
   // specified player, the other player, and empty.
   void ObservationTensor(Player player,
                          std::vector<double>* values) const override;
+  void ObservationTensor(Player player,
+                         absl::Span<float> values) const override;
   std::unique_ptr<State> Clone() const override;
+  bool CopyFrom(const State& other) override;
   std::vector<Action> LegalActions() const override;
 
  protected:
@@ -152,6 +158,10 @@ class YState : public State {
   Move ActionToMove(Action action_id) const;
 
  private:
+  // Writes the observation into `view`, for both the double and the float32
+  // versions of ObservationTensor.
+  template <class T>
+  void WriteObservationTensor(Player player, TensorView<2, T>& view) const;
   std::vector<Cell> board_;
   YPlayer current_player_ = kPlayer1;
   YPlayer outcome_ = kPlayerNone;
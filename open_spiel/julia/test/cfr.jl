@@ -35,4 +35,27 @@ end
     test_exploitability_kuhn_poker(game, avg_policy)
 end
 
+@testset "run_iterations" begin
+    game = load_game("kuhn_poker")
+    solver = CFRSolver(game)
+    run_iterations(solver, 300)
+    avg_policy = average_policy(solver)
+    test_nash_kuhn_poker(game, avg_policy)
+    test_exploitability_kuhn_poker(game, avg_policy)
+end
+
+@testset "ExternalSamplingMCCFRSolver" begin
+    game = load_game("kuhn_poker")
+    solver = ExternalSamplingMCCFRSolver(game, 1234, SIMPLE_AVERAGE)
+    run_iterations(solver, 10000, 1)
+    @test exploitability(game, average_policy(solver)) <= 0.05
+end
+
+@testset "OutcomeSamplingMCCFRSolver" begin
+    game = load_game("kuhn_poker")
+    solver = OutcomeSamplingMCCFRSolver(game, 0.6, 1234)
+    run_iterations(solver, 10000, 1)
+    @test exploitability(game, average_policy(solver)) <= 0.05
+end
+
 end
@@ -75,4 +75,36 @@ end
     @test num_cols(kuhn_matrix_game) == 64
 end
 
+@testset "in-place tensors" begin
+    game = load_game("kuhn_poker")
+    state = new_initial_state(game)
+    apply_action(state, 0)
+    apply_action(state, 1)
+    info_state = zeros(Float32, information_state_tensor_size(game))
+    information_state_tensor!(state, 0, info_state)
+    @test info_state == information_state_tensor(state, 0)
+    observation = zeros(Float32, observation_tensor_size(game))
+    observation_tensor!(state, 1, observation)
+    @test observation == observation_tensor(state, 1)
+    mask = zeros(Float32, num_distinct_actions(game))
+    legal_actions_mask!(state, 0, mask)
+    @test mask == legal_actions_mask(state, 0)
+end
+
+@testset "RLEnvironment" begin
+    game = load_game("tic_tac_toe")
+    env = RLEnvironment(game, 4, 1234, true, 1.0)
+    @test num_envs(env) == 4
+    @test all(step_types(env) .== 0)
+    masks = reshape(legal_actions_masks(env), num_distinct_actions(game), 2, 4)
+    @test all(masks[:, 1, :] .== 1)
+    step!(env, fill(4, 4))
+    # The views track the buffers of the environment.
+    @test all(masks[5, :, :] .== 0)
+    @test all(current_players(env) .== 1)
+    @test all(step_types(env) .== 1)
+    reset!(env)
+    @test all(masks[5, 1, :] .== 1)
+end
+
 end
@@ -14,13 +14,17 @@
 
 #include "jlcxx/jlcxx.hpp"
 #include "jlcxx/stl.hpp"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/algorithms/cfr_br.h"
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
 #include "open_spiel/algorithms/matrix_game_utils.h"
 #include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/outcome_sampling_mccfr.h"
+#include "open_spiel/algorithms/rl_environment.h"
 #include "open_spiel/algorithms/tabular_exploitability.h"
 #include "open_spiel/algorithms/trajectories.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
@@ -100,6 +104,10 @@ template <>
 struct jlcxx::IsMirroredType<open_spiel::algorithms::ChildSelectionPolicy>
     : std::true_type {};
 
+template <>
+struct jlcxx::IsMirroredType<open_spiel::algorithms::AverageType>
+    : std::true_type {};
+
 template <>
 struct jlcxx::IsMirroredType<std::pair<open_spiel::Action, double>>
     : std::true_type {};
@@ -113,6 +121,16 @@ struct jlcxx::julia_type_factory<std::pair<K, V>> {
   }
 };
 
+namespace {
+
+// Wraps a buffer owned by C++ as a Julia array without copying it.
+template <typename T>
+jlcxx::ArrayRef<T, 1> ArrayView(const std::vector<T>& values) {
+  return jlcxx::ArrayRef<T, 1>(const_cast<T*>(values.data()), values.size());
+}
+
+}  // namespace
+
 JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
   jlcxx::stl::apply_stl<std::pair<open_spiel::Action, double>>(mod);
   jlcxx::stl::apply_stl<std::vector<std::pair<open_spiel::Action, double>>>(
@@ -300,13 +318,16 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
               })
       .method("to_string", &open_spiel::State::ToString)
       .method("is_terminal", &open_spiel::State::IsTerminal)
-      .method("rewards", &open_spiel::State::Rewards)
-      .method("returns", &open_spiel::State::Returns)
+      .method("rewards", [](open_spiel::State& s) { return s.Rewards(); })
+      .method("returns", [](open_spiel::State& s) { return s.Returns(); })
       .method("player_reward", &open_spiel::State::PlayerReward)
       .method("player_return", &open_spiel::State::PlayerReturn)
       .method("is_chance_node", &open_spiel::State::IsChanceNode)
       .method("is_simultaneous_node", &open_spiel::State::IsSimultaneousNode)
-      .method("history", &open_spiel::State::History)
+      .method("history",
+              [](open_spiel::State& s) {
+                return std::vector<open_spiel::Action>(s.History());
+              })
       .method("history_str", &open_spiel::State::HistoryString)
       .method("information_state_string",
               [](open_spiel::State& s, open_spiel::Player p) {
@@ -342,6 +363,26 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
                  std::vector<double> data) {
                 return s.ObservationTensor(p, &data);
               })
+      // In-place fills of Float32 arrays owned by Julia, which avoid
+      // allocating and converting a vector per call.
+      .method("information_state_tensor!",
+              [](open_spiel::State& s, open_spiel::Player p,
+                 jlcxx::ArrayRef<float, 1> data) {
+                s.InformationStateTensor(
+                    p, absl::MakeSpan(data.data(), data.size()));
+              })
+      .method("observation_tensor!",
+              [](open_spiel::State& s, open_spiel::Player p,
+                 jlcxx::ArrayRef<float, 1> data) {
+                s.ObservationTensor(p,
+                                    absl::MakeSpan(data.data(), data.size()));
+              })
+      .method("legal_actions_mask!",
+              [](open_spiel::State& s, open_spiel::Player p,
+                 jlcxx::ArrayRef<float, 1> data) {
+                s.LegalActionsMask(p,
+                                   absl::MakeSpan(data.data(), data.size()));
+              })
       .method("clone", &open_spiel::State::Clone)
       .method("child", &open_spiel::State::Child)
       .method("undo_action", &open_spiel::State::UndoAction)
@@ -351,7 +392,8 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
               })
       .method("num_distinct_actions", &open_spiel::State::NumDistinctActions)
       .method("num_players", &open_spiel::State::NumPlayers)
-      .method("chance_outcomes", &open_spiel::State::ChanceOutcomes)
+      .method("chance_outcomes",
+              [](open_spiel::State& s) { return s.ChanceOutcomes(); })
       .method("get_type", &open_spiel::State::GetType)
       .method("serialize", &open_spiel::State::Serialize);
 
@@ -427,8 +469,9 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
                return open_spiel::LoadGameAsTurnBased(s, ps);
              });
   mod.method("load_matrix_game", &open_spiel::algorithms::LoadMatrixGame);
-  mod.method("extensive_to_matrix_game",
-             &open_spiel::algorithms::ExtensiveToMatrixGame);
+  mod.method("extensive_to_matrix_game", [](const open_spiel::Game& game) {
+    return open_spiel::algorithms::ExtensiveToMatrixGame(game);
+  });
   mod.method("registered_names", &open_spiel::GameRegisterer::RegisteredNames);
   mod.method("registered_games", &open_spiel::GameRegisterer::RegisteredGames);
 
@@ -599,6 +642,10 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
                    double, int, int64_t, bool, int, bool,
                    open_spiel::algorithms::ChildSelectionPolicy, double,
                    double>()
+      .constructor<const open_spiel::Game&, open_spiel::algorithms::Evaluator*,
+                   double, int, int64_t, bool, int, bool,
+                   open_spiel::algorithms::ChildSelectionPolicy, double,
+                   double, int, double, int, bool, double, bool, bool, int>()
       .method("restart", &open_spiel::algorithms::MCTSBot::Restart)
       .method("restart_at", &open_spiel::algorithms::MCTSBot::RestartAt)
       .method("step", &open_spiel::algorithms::MCTSBot::Step)
@@ -640,7 +687,15 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
       .method("current_policy",
               &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .method("average_policy",
-              &open_spiel::algorithms::CFRSolver::AveragePolicy);
+              &open_spiel::algorithms::CFRSolver::AveragePolicy)
+      // Runs the iterations in a single call rather than one per iteration.
+      .method("run_iterations",
+              [](open_spiel::algorithms::CFRSolverBase& solver,
+                 int num_iterations) {
+                for (int i = 0; i < num_iterations; ++i) {
+                  solver.EvaluateAndUpdatePolicy();
+                }
+              });
 
   mod.add_type<open_spiel::algorithms::CFRSolver>(
          "CFRSolver",
@@ -659,6 +714,81 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
       .method("evaluate_and_update_policy",
               &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy);
 
+  mod.add_bits<open_spiel::algorithms::AverageType>(
+      "AverageType", jlcxx::julia_type("CppEnum"));
+  mod.set_const("SIMPLE_AVERAGE", open_spiel::algorithms::AverageType::kSimple);
+  mod.set_const("FULL_AVERAGE", open_spiel::algorithms::AverageType::kFull);
+
+  mod.add_type<open_spiel::algorithms::ExternalSamplingMCCFRSolver>(
+         "ExternalSamplingMCCFRSolver")
+      .constructor<const open_spiel::Game&, int,
+                   open_spiel::algorithms::AverageType>()
+      .method("run_iteration",
+              [](open_spiel::algorithms::ExternalSamplingMCCFRSolver& solver) {
+                solver.RunIteration();
+              })
+      .method("run_iterations",
+              [](open_spiel::algorithms::ExternalSamplingMCCFRSolver& solver,
+                 int num_iterations, int num_threads) {
+                solver.RunIterationsInParallel(num_iterations, num_threads);
+              })
+      .method("average_policy",
+              &open_spiel::algorithms::ExternalSamplingMCCFRSolver::
+                  AveragePolicy);
+
+  mod.add_type<open_spiel::algorithms::OutcomeSamplingMCCFRSolver>(
+         "OutcomeSamplingMCCFRSolver")
+      .constructor<const open_spiel::Game&, double, int>()
+      .method("run_iteration",
+              [](open_spiel::algorithms::OutcomeSamplingMCCFRSolver& solver) {
+                solver.RunIteration();
+              })
+      .method("run_iterations",
+              &open_spiel::algorithms::OutcomeSamplingMCCFRSolver::
+                  RunIterations)
+      .method("average_policy",
+              &open_spiel::algorithms::OutcomeSamplingMCCFRSolver::
+                  AveragePolicy);
+
+  // The batched outputs are returned as Julia arrays viewing the buffers of
+  // the environment, without copies. They are overwritten by the next call to
+  // reset! or step!, and must not outlive the environment.
+  mod.add_type<open_spiel::algorithms::RLEnvironment>("RLEnvironment")
+      .constructor<std::shared_ptr<const open_spiel::Game>, int, int, bool,
+                   double>()
+      .method("reset!", &open_spiel::algorithms::RLEnvironment::Reset)
+      .method("step!",
+              [](open_spiel::algorithms::RLEnvironment& env,
+                 jlcxx::ArrayRef<int64_t, 1> actions) {
+                env.Step(absl::MakeConstSpan(actions.data(), actions.size()));
+              })
+      .method("num_envs", &open_spiel::algorithms::RLEnvironment::num_envs)
+      .method("info_state_size",
+              &open_spiel::algorithms::RLEnvironment::info_state_size)
+      .method("info_states",
+              [](open_spiel::algorithms::RLEnvironment& env) {
+                return ArrayView(env.info_states());
+              })
+      .method("legal_actions_masks",
+              [](open_spiel::algorithms::RLEnvironment& env) {
+                return ArrayView(env.legal_actions_masks());
+              })
+      .method("rewards",
+              [](open_spiel::algorithms::RLEnvironment& env) {
+                return ArrayView(env.rewards());
+              })
+      .method("discounts",
+              [](open_spiel::algorithms::RLEnvironment& env) {
+                return ArrayView(env.discounts());
+              })
+      .method("current_players",
+              [](open_spiel::algorithms::RLEnvironment& env) {
+                return ArrayView(env.current_players());
+              })
+      .method("step_types", [](open_spiel::algorithms::RLEnvironment& env) {
+        return ArrayView(env.step_types());
+      });
+
   mod.add_type<open_spiel::algorithms::TrajectoryRecorder>("TrajectoryRecorder")
       .constructor<const open_spiel::Game&,
                    const std::unordered_map<std::string, int>&, int>();
@@ -14,12 +14,15 @@
 
 #include "open_spiel/matrix_game.h"
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -120,6 +123,64 @@ std::vector<double> FlattenMatrix(
   return utilities;
 }
 
+std::array<double, 2> MatrixGame::ExpectedPayoffs(
+    absl::Span<const double> row_strategy,
+    absl::Span<const double> col_strategy) const {
+  SPIEL_CHECK_EQ(row_strategy.size(), NumRows());
+  SPIEL_CHECK_EQ(col_strategy.size(), NumCols());
+  std::array<double, 2> payoffs = {0, 0};
+  for (int row = 0; row < NumRows(); ++row) {
+    if (row_strategy[row] == 0) continue;
+    payoffs[0] += row_strategy[row] *
+                  internal::Dot(&row_utilities_[Index(row, 0)],
+                                col_strategy.data(), NumCols());
+    payoffs[1] += row_strategy[row] *
+                  internal::Dot(&col_utilities_[Index(row, 0)],
+                                col_strategy.data(), NumCols());
+  }
+  return payoffs;
+}
+
+void MatrixGame::ActionValues(Player player,
+                              absl::Span<const double> opponent_strategy,
+                              absl::Span<double> values) const {
+  SPIEL_CHECK_TRUE(player == Player{0} || player == Player{1});
+  if (player == kRowPlayer) {
+    SPIEL_CHECK_EQ(opponent_strategy.size(), NumCols());
+    SPIEL_CHECK_EQ(values.size(), NumRows());
+    for (int row = 0; row < NumRows(); ++row) {
+      values[row] = internal::Dot(&row_utilities_[Index(row, 0)],
+                                  opponent_strategy.data(), NumCols());
+    }
+  } else {
+    // The rows are added in turn, so that the utilities are read in order.
+    SPIEL_CHECK_EQ(opponent_strategy.size(), NumRows());
+    SPIEL_CHECK_EQ(values.size(), NumCols());
+    std::fill(values.begin(), values.end(), 0);
+    for (int row = 0; row < NumRows(); ++row) {
+      const double probability = opponent_strategy[row];
+      if (probability == 0) continue;
+      const double* utilities = &col_utilities_[Index(row, 0)];
+      for (int col = 0; col < NumCols(); ++col) {
+        values[col] += probability * utilities[col];
+      }
+    }
+  }
+}
+
+std::vector<double> MatrixGame::ActionValues(
+    Player player, absl::Span<const double> opponent_strategy) const {
+  std::vector<double> values(player == kRowPlayer ? NumRows() : NumCols());
+  ActionValues(player, opponent_strategy, absl::MakeSpan(values));
+  return values;
+}
+
+Action MatrixGame::BestResponse(
+    Player player, absl::Span<const double> opponent_strategy) const {
+  const std::vector<double> values = ActionValues(player, opponent_strategy);
+  return std::max_element(values.begin(), values.end()) - values.begin();
+}
+
 std::shared_ptr<const MatrixGame> CreateMatrixGame(
     const std::vector<std::vector<double>>& row_player_utils,
     const std::vector<std::vector<double>>& col_player_utils) {
@@ -146,10 +207,19 @@ std::shared_ptr<const MatrixGame> CreateMatrixGame(
     const std::vector<std::string>& col_names,
     const std::vector<std::vector<double>>& row_player_utils,
     const std::vector<std::vector<double>>& col_player_utils) {
+  return CreateMatrixGame(short_name, long_name, row_names, col_names,
+                          FlattenMatrix(row_player_utils),
+                          FlattenMatrix(col_player_utils));
+}
+
+std::shared_ptr<const MatrixGame> CreateMatrixGame(
+    const std::string& short_name, const std::string& long_name,
+    const std::vector<std::string>& row_names,
+    const std::vector<std::string>& col_names,
+    const std::vector<double>& flat_row_utils,
+    const std::vector<double>& flat_col_utils) {
   int rows = row_names.size();
   int columns = col_names.size();
-  std::vector<double> flat_row_utils = FlattenMatrix(row_player_utils);
-  std::vector<double> flat_col_utils = FlattenMatrix(col_player_utils);
   SPIEL_CHECK_EQ(flat_row_utils.size(), rows * columns);
   SPIEL_CHECK_EQ(flat_col_utils.size(), rows * columns);
 
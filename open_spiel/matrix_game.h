@@ -16,12 +16,14 @@
 #define THIRD_PARTY_OPEN_SPIEL_MATRIX_GAME_H_
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/normal_form_game.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -117,6 +119,24 @@ class MatrixGame : public NormalFormGame {
     return col_action_names_[col];
   }
 
+  // Kernels for solvers that play mixed strategies, given as probabilities
+  // of the rows and columns, many times.
+  //
+  // The expected utilities of both players.
+  std::array<double, 2> ExpectedPayoffs(
+      absl::Span<const double> row_strategy,
+      absl::Span<const double> col_strategy) const;
+  // Sets values to the expected utility of each action of the player against
+  // the strategy of the other player.
+  void ActionValues(Player player, absl::Span<const double> opponent_strategy,
+                    absl::Span<double> values) const;
+  std::vector<double> ActionValues(
+      Player player, absl::Span<const double> opponent_strategy) const;
+  // The first of the best actions of the player against the strategy of the
+  // other player.
+  Action BestResponse(Player player,
+                      absl::Span<const double> opponent_strategy) const;
+
  private:
   int Index(int row, int col) const { return row * NumCols() + col; }
   std::vector<std::string> row_action_names_;
@@ -191,6 +211,14 @@ std::shared_ptr<const MatrixGame> CreateMatrixGame(
     const std::vector<std::string>& col_names,
     const std::vector<std::vector<double>>& row_player_utils,
     const std::vector<std::vector<double>>& col_player_utils);
+// The same, with the utilities already flattened in row-major order, which
+// avoids copying large matrices twice.
+std::shared_ptr<const MatrixGame> CreateMatrixGame(
+    const std::string& short_name, const std::string& long_name,
+    const std::vector<std::string>& row_names,
+    const std::vector<std::string>& col_names,
+    const std::vector<double>& flat_row_utils,
+    const std::vector<double>& flat_col_utils);
 
 // Create a matrix game with the specified utilities, with default names
 // ("short_name", "Long Name", row0, row1.., col0, col1, ...).
@@ -76,6 +76,26 @@ class NFGState : public SimMoveState {
   }
 };
 
+namespace internal {
+
+// The dot product of two arrays, used by the payoff kernels of the matrix and
+// tensor games. The independent partial sums let the compiler keep several
+// in vector registers, as it may not reorder a single sum.
+inline double Dot(const double* a, const double* b, int size) {
+  double sums[4] = {0, 0, 0, 0};
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    sums[0] += a[i] * b[i];
+    sums[1] += a[i + 1] * b[i + 1];
+    sums[2] += a[i + 2] * b[i + 2];
+    sums[3] += a[i + 3] * b[i + 3];
+  }
+  for (; i < size; ++i) sums[0] += a[i] * b[i];
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+}  // namespace internal
+
 class NormalFormGame : public SimMoveGame {
  public:
   // Game has one state.
@@ -14,6 +14,9 @@
 
 #include "open_spiel/policy.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <list>
 #include <memory>
@@ -24,11 +27,394 @@
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/random/distributions.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 
+ActionSampler::ActionSampler(const ActionsAndProbs& actions_and_probs) {
+  const int n = actions_and_probs.size();
+  SPIEL_CHECK_GT(n, 0);
+  actions_.reserve(n);
+  thresholds_.reserve(n);
+  double sum = 0;
+  for (const auto& [action, prob] : actions_and_probs) {
+    SPIEL_CHECK_GE(prob, 0);
+    actions_.push_back(action);
+    thresholds_.push_back(prob * n);
+    sum += prob;
+  }
+  SPIEL_CHECK_FLOAT_EQ(sum, 1.0);
+  aliases_ = actions_;
+  // Each column under 1 is filled up by the alias of a column over 1.
+  std::vector<int> small;
+  std::vector<int> large;
+  for (int i = 0; i < n; ++i) {
+    if (thresholds_[i] < 1) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+  while (!small.empty() && !large.empty()) {
+    const int s = small.back();
+    const int l = large.back();
+    small.pop_back();
+    aliases_[s] = actions_[l];
+    thresholds_[l] -= 1 - thresholds_[s];
+    if (thresholds_[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // The columns left are full, up to rounding.
+  for (int i : small) thresholds_[i] = 1;
+  for (int i : large) thresholds_[i] = 1;
+}
+
+Action ActionSampler::Sample(double z) const {
+  SPIEL_CHECK_GE(z, 0);
+  SPIEL_CHECK_LT(z, 1);
+  const double scaled = z * actions_.size();
+  const int column = std::min<int>(scaled, actions_.size() - 1);
+  return scaled - column < thresholds_[column] ? actions_[column]
+                                               : aliases_[column];
+}
+
+Action ActionSampler::Sample(absl::BitGenRef rng) const {
+  return Sample(absl::Uniform(rng, 0.0, 1.0));
+}
+
+const ActionSampler* TabularPolicySampler::Find(const std::string& info_state) {
+  auto iter = samplers_.find(info_state);
+  if (iter != samplers_.end()) return &iter->second;
+  const ActionsAndProbs* actions_and_probs =
+      policy_.FindStatePolicy(info_state);
+  if (actions_and_probs == nullptr || actions_and_probs->empty()) {
+    return nullptr;
+  }
+  return &samplers_.emplace(info_state, ActionSampler(*actions_and_probs))
+              .first->second;
+}
+
+Action TabularPolicySampler::Sample(const std::string& info_state,
+                                    absl::BitGenRef rng) {
+  const ActionSampler* sampler = Find(info_state);
+  if (sampler == nullptr) {
+    SpielFatalError(
+        absl::StrCat("No policy for information state ", info_state));
+  }
+  return sampler->Sample(rng);
+}
+
+namespace {
+constexpr char kDensePolicyMagic[8] = {'O', 'S', 'D', 'P', 'O', 'L', '0', '1'};
+
+template <typename T>
+void AppendArray(const std::vector<T>& values, std::string* data) {
+  data->append(reinterpret_cast<const char*>(values.data()),
+               values.size() * sizeof(T));
+}
+
+// Reads `values.size()` values at `*position`, and moves it past them.
+template <typename T>
+void ReadArray(absl::string_view data, int64_t* position,
+               std::vector<T>* values) {
+  const int64_t size = values->size() * sizeof(T);
+  SPIEL_CHECK_LE(*position + size, data.size());
+  std::memcpy(values->data(), data.data() + *position, size);
+  *position += size;
+}
+
+// Returns a view of `size` values at `*position`, and moves it past them.
+template <typename T>
+absl::Span<const T> ViewArray(absl::string_view data, int64_t* position,
+                              int64_t size) {
+  SPIEL_CHECK_GE(size, 0);
+  SPIEL_CHECK_LE(*position + size * static_cast<int64_t>(sizeof(T)),
+                 data.size());
+  absl::Span<const T> values(
+      reinterpret_cast<const T*>(data.data() + *position), size);
+  *position += size * sizeof(T);
+  return values;
+}
+
+// Binary search for the index of a key among sorted keys, concatenated in
+// `keys`, or -1 if it is not one of them.
+int SortedKeyIndex(absl::Span<const int64_t> key_offsets,
+                   absl::string_view keys, absl::string_view key) {
+  auto key_at = [&](int index) {
+    return keys.substr(key_offsets[index],
+                       key_offsets[index + 1] - key_offsets[index]);
+  };
+  const int num_keys = key_offsets.size() - 1;
+  int low = 0;
+  int high = num_keys;
+  while (low < high) {
+    const int middle = low + (high - low) / 2;
+    if (key_at(middle) < key) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low < num_keys && key_at(low) == key) return low;
+  return -1;
+}
+}  // namespace
+
+DenseTabularPolicy::DenseTabularPolicy(const TabularPolicy& policy)
+    : DenseTabularPolicy() {
+  std::vector<const std::pair<const std::string, ActionsAndProbs>*> entries;
+  entries.reserve(policy.PolicyTable().size());
+  for (const auto& entry : policy.PolicyTable()) entries.push_back(&entry);
+  std::sort(entries.begin(), entries.end(),
+            [](const auto* a, const auto* b) { return a->first < b->first; });
+  key_offsets_.reserve(entries.size() + 1);
+  offsets_.reserve(entries.size() + 1);
+  for (const auto* entry : entries) {
+    keys_.append(entry->first);
+    key_offsets_.push_back(keys_.size());
+    for (const auto& [action, prob] : entry->second) {
+      actions_.push_back(action);
+      probs_.push_back(prob);
+    }
+    offsets_.push_back(actions_.size());
+  }
+}
+
+DenseTabularPolicy::DenseTabularPolicy(
+    const std::vector<std::string>& info_states, const Policy& policy)
+    : DenseTabularPolicy() {
+  std::vector<const std::string*> sorted;
+  sorted.reserve(info_states.size());
+  for (const std::string& info_state : info_states) {
+    sorted.push_back(&info_state);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+  for (const std::string* info_state : sorted) {
+    if (key_offsets_.size() > 1 && InfoStateString(NumInfoStates() - 1) ==
+                                       absl::string_view(*info_state)) {
+      continue;
+    }
+    keys_.append(*info_state);
+    key_offsets_.push_back(keys_.size());
+    for (const auto& [action, prob] : policy.GetStatePolicy(*info_state)) {
+      actions_.push_back(action);
+      probs_.push_back(prob);
+    }
+    offsets_.push_back(actions_.size());
+  }
+}
+
+int DenseTabularPolicy::InfoStateIndex(absl::string_view info_state) const {
+  return SortedKeyIndex(key_offsets_, keys_, info_state);
+}
+
+ActionsAndProbs DenseTabularPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  const int index = InfoStateIndex(info_state);
+  if (index < 0) return {};
+  ActionsAndProbs policy;
+  policy.reserve(offsets_[index + 1] - offsets_[index]);
+  for (int64_t i = offsets_[index]; i < offsets_[index + 1]; ++i) {
+    policy.emplace_back(actions_[i], probs_[i]);
+  }
+  return policy;
+}
+
+void DenseTabularPolicy::GetStatePolicies(
+    absl::Span<const State* const> states,
+    absl::Span<ActionsAndProbs> policies) const {
+  SPIEL_CHECK_EQ(states.size(), policies.size());
+  for (int i = 0; i < states.size(); ++i) {
+    policies[i].clear();
+    const int index = InfoStateIndex(states[i]->InformationStateString());
+    if (index < 0) continue;
+    for (int64_t k = offsets_[index]; k < offsets_[index + 1]; ++k) {
+      policies[i].emplace_back(actions_[k], probs_[k]);
+    }
+  }
+}
+
+TabularPolicy DenseTabularPolicy::ToTabularPolicy() const {
+  std::unordered_map<std::string, ActionsAndProbs> table;
+  table.reserve(NumInfoStates());
+  for (int index = 0; index < NumInfoStates(); ++index) {
+    const std::string info_state(InfoStateString(index));
+    table[info_state] = GetStatePolicy(info_state);
+  }
+  return TabularPolicy(table);
+}
+
+std::string DenseTabularPolicy::Serialize() const {
+  const std::vector<int64_t> sizes = {NumInfoStates(),
+                                      static_cast<int64_t>(keys_.size()),
+                                      static_cast<int64_t>(actions_.size())};
+  const int64_t padded_keys = (keys_.size() + 7) / 8 * 8;
+  std::string data;
+  data.reserve(sizeof(kDensePolicyMagic) + 8 * (3 + 2 * (NumInfoStates() + 1)) +
+               padded_keys + 16 * actions_.size());
+  data.append(kDensePolicyMagic, sizeof(kDensePolicyMagic));
+  AppendArray(sizes, &data);
+  AppendArray(key_offsets_, &data);
+  data.append(keys_);
+  data.append(padded_keys - keys_.size(), '\0');
+  AppendArray(offsets_, &data);
+  AppendArray(actions_, &data);
+  AppendArray(probs_, &data);
+  return data;
+}
+
+DenseTabularPolicy DenseTabularPolicy::Deserialize(absl::string_view data) {
+  if (data.size() < sizeof(kDensePolicyMagic) ||
+      std::memcmp(data.data(), kDensePolicyMagic,
+                  sizeof(kDensePolicyMagic)) != 0) {
+    SpielFatalError("Not a serialized DenseTabularPolicy.");
+  }
+  int64_t position = sizeof(kDensePolicyMagic);
+  std::vector<int64_t> sizes(3);
+  ReadArray(data, &position, &sizes);
+  SPIEL_CHECK_GE(sizes[0], 0);
+  SPIEL_CHECK_GE(sizes[1], 0);
+  SPIEL_CHECK_GE(sizes[2], 0);
+  DenseTabularPolicy policy;
+  policy.key_offsets_.resize(sizes[0] + 1);
+  ReadArray(data, &position, &policy.key_offsets_);
+  const int64_t padded_keys = (sizes[1] + 7) / 8 * 8;
+  SPIEL_CHECK_LE(position + padded_keys, data.size());
+  policy.keys_.assign(data.data() + position, sizes[1]);
+  position += padded_keys;
+  policy.offsets_.resize(sizes[0] + 1);
+  ReadArray(data, &position, &policy.offsets_);
+  policy.actions_.resize(sizes[2]);
+  ReadArray(data, &position, &policy.actions_);
+  policy.probs_.resize(sizes[2]);
+  ReadArray(data, &position, &policy.probs_);
+  SPIEL_CHECK_EQ(position, data.size());
+  SPIEL_CHECK_EQ(policy.key_offsets_.back(), sizes[1]);
+  SPIEL_CHECK_EQ(policy.offsets_.back(), sizes[2]);
+  return policy;
+}
+
+ArrayTabularPolicy::ArrayTabularPolicy(
+    std::unordered_map<std::string, int> state_lookup,
+    const std::vector<std::vector<Action>>& legal_actions,
+    absl::Span<const double> action_probability_array)
+    : state_lookup_(std::move(state_lookup)), row_offsets_(1, 0) {
+  SPIEL_CHECK_FALSE(legal_actions.empty());
+  SPIEL_CHECK_EQ(action_probability_array.size() % legal_actions.size(), 0);
+  num_actions_ = action_probability_array.size() / legal_actions.size();
+  for (const std::vector<Action>& actions : legal_actions) {
+    for (Action action : actions) {
+      SPIEL_CHECK_GE(action, 0);
+      SPIEL_CHECK_LT(action, num_actions_);
+      legal_actions_.push_back(action);
+    }
+    row_offsets_.push_back(legal_actions_.size());
+  }
+  for (const auto& [info_state, row] : state_lookup_) {
+    SPIEL_CHECK_GE(row, 0);
+    SPIEL_CHECK_LT(row, NumStates());
+  }
+  probs_ = action_probability_array;
+}
+
+void ArrayTabularPolicy::SetActionProbabilityArray(
+    absl::Span<const double> array) {
+  SPIEL_CHECK_EQ(array.size(), probs_.size());
+  probs_ = array;
+}
+
+void ArrayTabularPolicy::AppendRowPolicy(int row,
+                                         ActionsAndProbs* policy) const {
+  const double* probs =
+      probs_.data() + static_cast<int64_t>(row) * num_actions_;
+  for (int64_t i = row_offsets_[row]; i < row_offsets_[row + 1]; ++i) {
+    policy->emplace_back(legal_actions_[i], probs[legal_actions_[i]]);
+  }
+}
+
+ActionsAndProbs ArrayTabularPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  auto iter = state_lookup_.find(info_state);
+  if (iter == state_lookup_.end()) return {};
+  ActionsAndProbs policy;
+  policy.reserve(row_offsets_[iter->second + 1] - row_offsets_[iter->second]);
+  AppendRowPolicy(iter->second, &policy);
+  return policy;
+}
+
+void ArrayTabularPolicy::GetStatePolicies(
+    absl::Span<const State* const> states,
+    absl::Span<ActionsAndProbs> policies) const {
+  SPIEL_CHECK_EQ(states.size(), policies.size());
+  for (int i = 0; i < states.size(); ++i) {
+    policies[i].clear();
+    auto iter = state_lookup_.find(states[i]->InformationStateString());
+    if (iter != state_lookup_.end()) {
+      AppendRowPolicy(iter->second, &policies[i]);
+    }
+  }
+}
+
+DenseTabularPolicyView::DenseTabularPolicyView(absl::string_view data) {
+  if (data.size() < sizeof(kDensePolicyMagic) ||
+      std::memcmp(data.data(), kDensePolicyMagic,
+                  sizeof(kDensePolicyMagic)) != 0) {
+    SpielFatalError("Not a serialized DenseTabularPolicy.");
+  }
+  SPIEL_CHECK_EQ(reinterpret_cast<uintptr_t>(data.data()) % 8, 0);
+  int64_t position = sizeof(kDensePolicyMagic);
+  absl::Span<const int64_t> sizes = ViewArray<int64_t>(data, &position, 3);
+  key_offsets_ = ViewArray<int64_t>(data, &position, sizes[0] + 1);
+  const int64_t padded_keys = (sizes[1] + 7) / 8 * 8;
+  SPIEL_CHECK_LE(position + padded_keys, data.size());
+  keys_ = data.substr(position, sizes[1]);
+  position += padded_keys;
+  offsets_ = ViewArray<int64_t>(data, &position, sizes[0] + 1);
+  actions_ = ViewArray<Action>(data, &position, sizes[2]);
+  probs_ = ViewArray<double>(data, &position, sizes[2]);
+  SPIEL_CHECK_EQ(position, data.size());
+  SPIEL_CHECK_EQ(key_offsets_.back(), sizes[1]);
+  SPIEL_CHECK_EQ(offsets_.back(), sizes[2]);
+}
+
+int DenseTabularPolicyView::InfoStateIndex(
+    absl::string_view info_state) const {
+  return SortedKeyIndex(key_offsets_, keys_, info_state);
+}
+
+ActionsAndProbs DenseTabularPolicyView::GetStatePolicy(
+    const std::string& info_state) const {
+  const int index = InfoStateIndex(info_state);
+  if (index < 0) return {};
+  ActionsAndProbs policy;
+  policy.reserve(offsets_[index + 1] - offsets_[index]);
+  for (int64_t i = offsets_[index]; i < offsets_[index + 1]; ++i) {
+    policy.emplace_back(actions_[i], probs_[i]);
+  }
+  return policy;
+}
+
+void DenseTabularPolicyView::GetStatePolicies(
+    absl::Span<const State* const> states,
+    absl::Span<ActionsAndProbs> policies) const {
+  SPIEL_CHECK_EQ(states.size(), policies.size());
+  for (int i = 0; i < states.size(); ++i) {
+    policies[i].clear();
+    const int index = InfoStateIndex(states[i]->InformationStateString());
+    if (index < 0) continue;
+    for (int64_t k = offsets_[index]; k < offsets_[index + 1]; ++k) {
+      policies[i].emplace_back(actions_[k], probs_[k]);
+    }
+  }
+}
+
 double GetProb(const ActionsAndProbs& action_and_probs, Action action) {
   auto it = absl::c_find_if(action_and_probs,
                             [&action](const std::pair<Action, double>& p) {
@@ -41,6 +427,21 @@ double GetProb(const ActionsAndProbs& action_and_probs, Action action) {
 TabularPolicy::TabularPolicy(const Game& game)
     : TabularPolicy(GetRandomPolicy(game)) {}
 
+void TabularPolicy::GetStatePolicies(
+    absl::Span<const State* const> states,
+    absl::Span<ActionsAndProbs> policies) const {
+  SPIEL_CHECK_EQ(states.size(), policies.size());
+  for (int i = 0; i < states.size(); ++i) {
+    const ActionsAndProbs* policy =
+        FindStatePolicy(states[i]->InformationStateString());
+    if (policy == nullptr) {
+      policies[i].clear();
+    } else {
+      policies[i].assign(policy->begin(), policy->end());
+    }
+  }
+}
+
 TabularPolicy GetEmptyTabularPolicy(const Game& game,
                                     bool initialize_to_uniform) {
   std::unordered_map<std::string, ActionsAndProbs> policy;
@@ -15,12 +15,16 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_POLICY_H_
 #define THIRD_PARTY_OPEN_SPIEL_POLICY_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/random/bit_gen_ref.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -78,6 +82,27 @@ class Policy {
     return GetStatePolicy(state.InformationStateString());
   }
 
+  // Same as `GetStatePolicy(state)`, but writes the policy into a
+  // caller-owned ActionsAndProbsSoA, whose storage is reused across calls.
+  // Defaults to converting the result of `GetStatePolicy(state)`.
+  virtual void GetStatePolicy(const State& state,
+                              ActionsAndProbsSoA* policy) const {
+    policy->Assign(GetStatePolicy(state));
+  }
+
+  // Writes the policies at several states into `policies`, of the same size,
+  // so that a policy can evaluate them together, e.g. in one batch of a
+  // network. The vectors of `policies` are reused, so the policies of
+  // repeated calls with the same buffer need no new allocations. Defaults to
+  // calling GetStatePolicy on each state.
+  virtual void GetStatePolicies(absl::Span<const State* const> states,
+                                absl::Span<ActionsAndProbs> policies) const {
+    SPIEL_CHECK_EQ(states.size(), policies.size());
+    for (int i = 0; i < states.size(); ++i) {
+      policies[i] = GetStatePolicy(*states[i]);
+    }
+  }
+
   // Returns a list of (action, prob) pairs for the policy at this info state.
   // If the policy is not available at the state, returns and empty list.
   // It is sufficient for subclasses to override only this method, but not all
@@ -133,6 +158,19 @@ class TabularPolicy : public Policy {
     }
   }
 
+  // Copies the policies of the tables into the vectors of `policies`, whose
+  // capacity is reused.
+  void GetStatePolicies(absl::Span<const State* const> states,
+                        absl::Span<ActionsAndProbs> policies) const override;
+
+  // Same as GetStatePolicy without copying the policy, which stays valid
+  // until the table is changed. Returns nullptr if the information state is
+  // not in the table.
+  const ActionsAndProbs* FindStatePolicy(const std::string& info_state) const {
+    auto iter = policy_table_.find(info_state);
+    return iter == policy_table_.end() ? nullptr : &iter->second;
+  }
+
   std::unordered_map<std::string, ActionsAndProbs>& PolicyTable() {
     return policy_table_;
   }
@@ -145,6 +183,185 @@ class TabularPolicy : public Policy {
   std::unordered_map<std::string, ActionsAndProbs> policy_table_;
 };
 
+// A tabular policy in flat arrays rather than a map, which is more compact
+// and faster to copy, e.g. to keep or send an average policy: the information
+// states are sorted, with their keys in a single string, and the actions and
+// probabilities of each are a range of a single array. Lookups by information
+// state are binary searches. The set of information states and their actions
+// is fixed at construction, but the probabilities can be changed in place.
+class DenseTabularPolicy : public Policy {
+ public:
+  DenseTabularPolicy() : key_offsets_(1, 0), offsets_(1, 0) {}
+  explicit DenseTabularPolicy(const TabularPolicy& policy);
+  // The policy of `policy` at each of the information states.
+  DenseTabularPolicy(const std::vector<std::string>& info_states,
+                     const Policy& policy);
+
+  int NumInfoStates() const { return key_offsets_.size() - 1; }
+  absl::string_view InfoStateString(int index) const {
+    return absl::string_view(keys_).substr(
+        key_offsets_[index], key_offsets_[index + 1] - key_offsets_[index]);
+  }
+  // Returns the index of an information state, or -1 if it is not in the
+  // table.
+  int InfoStateIndex(absl::string_view info_state) const;
+
+  // The actions and probabilities of an information state, without copies.
+  absl::Span<const Action> StateActions(int index) const {
+    return absl::MakeConstSpan(actions_).subspan(
+        offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+  absl::Span<const double> StateProbs(int index) const {
+    return absl::MakeConstSpan(probs_).subspan(
+        offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+  absl::Span<double> MutableStateProbs(int index) {
+    return absl::MakeSpan(probs_).subspan(
+        offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+  void GetStatePolicies(absl::Span<const State* const> states,
+                        absl::Span<ActionsAndProbs> policies) const override;
+  TabularPolicy ToTabularPolicy() const;
+
+  // Returns the policy as a binary string: a header, the 8-byte magic
+  // "OSDPOL01" then the numbers of information states, key bytes and actions
+  // as 64-bit integers, followed by the key offsets, the keys (zero-padded to
+  // a multiple of 8 bytes), the action offsets, the actions and the
+  // probabilities, in the machine's native byte order.
+  std::string Serialize() const;
+  static DenseTabularPolicy Deserialize(absl::string_view data);
+
+ private:
+  std::string keys_;
+  std::vector<int64_t> key_offsets_;
+  std::vector<int64_t> offsets_;
+  std::vector<Action> actions_;
+  std::vector<double> probs_;
+};
+
+// A read-only DenseTabularPolicy over its serialized form, which is used in
+// place rather than copied: building the view only checks the sizes, so it
+// takes constant time however large the policy. The data must be 8-byte
+// aligned, as the contents of a file::MappedFile are, and must outlive the
+// view. See algorithms/mapped_tabular_policy.h to serve a policy file.
+class DenseTabularPolicyView : public Policy {
+ public:
+  explicit DenseTabularPolicyView(absl::string_view data);
+
+  int NumInfoStates() const { return key_offsets_.size() - 1; }
+  absl::string_view InfoStateString(int index) const {
+    return keys_.substr(key_offsets_[index],
+                        key_offsets_[index + 1] - key_offsets_[index]);
+  }
+  // Returns the index of an information state, or -1 if it is not in the
+  // table.
+  int InfoStateIndex(absl::string_view info_state) const;
+
+  absl::Span<const Action> StateActions(int index) const {
+    return actions_.subspan(offsets_[index],
+                            offsets_[index + 1] - offsets_[index]);
+  }
+  absl::Span<const double> StateProbs(int index) const {
+    return probs_.subspan(offsets_[index],
+                          offsets_[index + 1] - offsets_[index]);
+  }
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+  void GetStatePolicies(absl::Span<const State* const> states,
+                        absl::Span<ActionsAndProbs> policies) const override;
+
+ private:
+  absl::string_view keys_;
+  absl::Span<const int64_t> key_offsets_;
+  absl::Span<const int64_t> offsets_;
+  absl::Span<const Action> actions_;
+  absl::Span<const double> probs_;
+};
+
+// A tabular policy read in place from a dense array of shape
+// [num_states, num_actions], as the action_probability_array of the Python
+// TabularPolicy, whose rows are looked up by information state. The array is
+// not copied: it must outlive the policy, and changes made to it in place are
+// seen by later calls, so that one policy can be evaluated after each step of
+// training without converting the table. The legal actions of each row are
+// copied at construction, and the policy of a state only has those.
+class ArrayTabularPolicy : public Policy {
+ public:
+  // Row state_lookup[s] of the array is the policy of information state s,
+  // with legal actions legal_actions[state_lookup[s]].
+  ArrayTabularPolicy(std::unordered_map<std::string, int> state_lookup,
+                     const std::vector<std::vector<Action>>& legal_actions,
+                     absl::Span<const double> action_probability_array);
+
+  int NumStates() const { return row_offsets_.size() - 1; }
+  int NumActions() const { return num_actions_; }
+
+  // Points the policy at another array of the same shape, e.g. one that the
+  // Python policy was rebound to.
+  void SetActionProbabilityArray(absl::Span<const double> array);
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+  void GetStatePolicies(absl::Span<const State* const> states,
+                        absl::Span<ActionsAndProbs> policies) const override;
+
+ private:
+  void AppendRowPolicy(int row, ActionsAndProbs* policy) const;
+
+  std::unordered_map<std::string, int> state_lookup_;
+  // The legal actions of row i are the range [row_offsets_[i],
+  // row_offsets_[i + 1]) of legal_actions_.
+  std::vector<int64_t> row_offsets_;
+  std::vector<Action> legal_actions_;
+  int num_actions_;
+  absl::Span<const double> probs_;
+};
+
+// Samples from a fixed distribution over actions in constant time, with the
+// alias method of Walker and Vose, built in linear time. A draw picks one of
+// the n columns of the table, which holds an action with probability
+// threshold and its alias otherwise.
+class ActionSampler {
+ public:
+  ActionSampler() = default;
+  // The probabilities must sum to 1, as for SampleAction.
+  explicit ActionSampler(const ActionsAndProbs& actions_and_probs);
+
+  // Returns the action of z, uniform in [0, 1): the integer part of z * n is
+  // the column, and the fractional part is compared to its threshold. This is
+  // a different action than SampleAction(actions_and_probs, z) returns, with
+  // the same distribution.
+  Action Sample(double z) const;
+  Action Sample(absl::BitGenRef rng) const;
+
+  int NumActions() const { return actions_.size(); }
+
+ private:
+  std::vector<Action> actions_;
+  std::vector<Action> aliases_;
+  std::vector<double> thresholds_;
+};
+
+// The alias tables of the information states of a tabular policy, for
+// policies that are sampled many times, e.g. by PolicyBot. The table of an
+// information state is built from the policy on its first lookup, so only the
+// states looked up are checked, and later changes to them are not seen. The
+// policy must outlive the sampler. Not thread-safe.
+class TabularPolicySampler {
+ public:
+  explicit TabularPolicySampler(const TabularPolicy& policy)
+      : policy_(policy) {}
+
+  // Returns nullptr if the information state is not in the policy.
+  const ActionSampler* Find(const std::string& info_state);
+  Action Sample(const std::string& info_state, absl::BitGenRef rng);
+
+ private:
+  const TabularPolicy& policy_;
+  std::unordered_map<std::string, ActionSampler> samplers_;
+};
+
 // Chooses all legal actions with equal probability. This is equivalent to the
 // tabular version, except that this works for large games.
 class UniformPolicy : public Policy {
@@ -50,6 +50,17 @@ class FictitiousPlayTest(absltest.TestCase):
     self.assertTrue(
         np.allclose(average_policy_values, [-1 / 18, 1 / 18], atol=1e-3))
 
+  def test_cpp_xfp(self):
+    game = pyspiel.load_game("kuhn_poker")
+    xfp_solver = pyspiel.XFPSolver(game)
+    for _ in range(100):
+      xfp_solver.run_iteration()
+    average_policy = xfp_solver.average_policy()
+    average_policy_values = pyspiel.expected_returns(
+        game.new_initial_state(), [average_policy, average_policy], -1, True)
+    self.assertTrue(
+        np.allclose(average_policy_values, [-1 / 18, 1 / 18], atol=1e-3))
+
   def test_meta_game_kuhn2p(self):
     print("Kuhn 2p")
     game = pyspiel.load_game("kuhn_poker")
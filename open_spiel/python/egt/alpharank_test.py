@@ -96,6 +96,28 @@ class AlphaRankTest(absltest.TestCase):
     np.testing.assert_array_almost_equal(c1, c2)
     np.testing.assert_array_almost_equal(rhos1, rhos2)
 
+  def test_cpp_alpha_rank(self):
+    """Tests the C++ alpha-rank against the Python one."""
+    payoff_tables = [
+        np.asarray([[3., 0.], [5., 1.]]),
+        np.asarray([[3., 5.], [0., 1.]])
+    ]
+    game = pyspiel.create_matrix_game(payoff_tables[0].tolist(),
+                                      payoff_tables[1].tolist())
+    options = pyspiel.AlphaRankOptions()
+    options.alpha = 1.
+    options.population_size = 10
+    result = pyspiel.alpha_rank(game, options)
+    _, _, pi, _, _ = alpharank.compute(payoff_tables, m=10, alpha=1.)
+    np.testing.assert_array_almost_equal(result.pi, pi)
+    pi = pi.reshape(2, 2)
+    np.testing.assert_array_almost_equal(result.marginals[0], pi.sum(axis=1))
+    np.testing.assert_array_almost_equal(result.marginals[1], pi.sum(axis=0))
+
+    game = pyspiel.load_matrix_game("matrix_rps")
+    result = pyspiel.single_population_alpha_rank(game)
+    np.testing.assert_array_almost_equal(result.pi, np.ones(3) / 3)
+
 
 if __name__ == "__main__":
   absltest.main()
@@ -411,6 +411,26 @@ def python_policy_to_pyspiel_policy(python_tabular_policy):
   return pyspiel.TabularPolicy(infostates_to_probabilities)
 
 
+def python_policy_to_pyspiel_array_policy(python_tabular_policy):
+  """Returns a pyspiel.Policy reading a TabularPolicy's array in place.
+
+  Unlike `python_policy_to_pyspiel_policy`, the probabilities are not copied:
+  the returned policy reads `action_probability_array` directly, so updates
+  made to the array in place are seen by `pyspiel.exploitability` and
+  `pyspiel.nash_conv` without converting the policy again. If the attribute is
+  rebound to another array, call `set_action_probability_array` on the
+  returned policy.
+
+  Args:
+    python_tabular_policy: A `TabularPolicy` keyed by information state
+      strings, whose `action_probability_array` is C-contiguous float64.
+  """
+  return pyspiel.ArrayTabularPolicy(
+      python_tabular_policy.state_lookup,
+      python_tabular_policy.legal_actions_mask,
+      python_tabular_policy.action_probability_array)
+
+
 def policy_from_pyspiel_policy(pyspiel_policy):
   """Returns a `policy.Policy` object from a `pyspiel.Policy` object."""
   return PolicyFromCallable(None, pyspiel_policy.get_state_policy_as_map)
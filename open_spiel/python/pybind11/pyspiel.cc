@@ -12,19 +12,35 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
+#include <random>
+#include <string>
 #include <unordered_map>
 
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/algorithms/alpha_rank.h"
+#include "open_spiel/algorithms/batched_inference.h"
 #include "open_spiel/algorithms/best_response.h"
 #include "open_spiel/algorithms/cfr.h"
 #include "open_spiel/algorithms/cfr_br.h"
+#include "open_spiel/algorithms/deep_cfr.h"
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/algorithms/fictitious_play.h"
+#include "open_spiel/algorithms/is_mcts.h"
 #include "open_spiel/algorithms/matrix_game_utils.h"
 #include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/meta_game_solvers.h"
+#include "open_spiel/algorithms/policy_aggregator.h"
+#include "open_spiel/algorithms/rl_environment.h"
+#include "open_spiel/algorithms/sm_mcts.h"
 #include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/algorithms/tabular_learner.h"
 #include "open_spiel/algorithms/tensor_game_utils.h"
 #include "open_spiel/algorithms/trajectories.h"
+#include "open_spiel/algorithms/vector_env.h"
 #include "open_spiel/game_transforms/normal_form_extensive_game.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/matrix_game.h"
@@ -48,6 +64,7 @@ using ::open_spiel::algorithms::Exploitability;
 using ::open_spiel::algorithms::NashConv;
 using ::open_spiel::algorithms::TabularBestResponse;
 using ::open_spiel::matrix_game::MatrixGame;
+using ::open_spiel::tensor_game::LazyTensorGame;
 using ::open_spiel::tensor_game::TensorGame;
 
 namespace py = ::pybind11;
@@ -65,6 +82,34 @@ class SpielException : public std::exception {
   std::string message_;
 };
 
+// Loads the game, sharing the game object with all the other live games
+// loaded from the same string here, so that unpickling many states or games
+// only loads the game once. The GIL guards the cache. The entries of the
+// games no longer alive are dropped whenever the cache doubles in size, so it
+// only grows with the live games.
+std::shared_ptr<const Game> LoadInternedGame(const std::string& game_string) {
+  static auto* games =
+      new absl::flat_hash_map<std::string, std::weak_ptr<const Game>>();
+  static size_t prune_size = 64;
+  std::weak_ptr<const Game>& cached = (*games)[game_string];
+  std::shared_ptr<const Game> game = cached.lock();
+  if (game == nullptr) {
+    game = LoadGame(game_string);
+    cached = game;
+    if (games->size() >= prune_size) {
+      for (auto it = games->begin(); it != games->end();) {
+        if (it->second.expired()) {
+          games->erase(it++);
+        } else {
+          ++it;
+        }
+      }
+      prune_size = std::max<size_t>(64, 2 * games->size());
+    }
+  }
+  return game;
+}
+
 // Trampoline helper class to allow implementing Bots in Python. See
 // https://pybind11.readthedocs.io/en/stable/advanced/classes.html#overriding-virtual-functions-in-python
 class PyBot : public Bot {
@@ -165,6 +210,105 @@ class PyBot : public Bot {
   }
 };
 
+// Trampoline helper class to allow implementing MCTS evaluators in Python.
+// Like the other trampolines it acquires the GIL for each call, so bindings
+// may release the GIL around searches that call it, e.g. MCTSBot.step, and
+// searches may call it from several threads, which take turns.
+class PyEvaluator : public Evaluator {
+ public:
+  using Evaluator::Evaluator;
+  ~PyEvaluator() override = default;
+
+  std::vector<double> Evaluate(const State& state) override {
+    PYBIND11_OVERLOAD_PURE_NAME(
+        std::vector<double>,  // Return type (must be a simple token)
+        Evaluator,            // Parent class
+        "evaluate",           // Name of function in Python
+        Evaluate,             // Name of function in C++
+        state                 // Arguments
+    );
+  }
+
+  ActionsAndProbs Prior(const State& state) override {
+    PYBIND11_OVERLOAD_PURE_NAME(
+        ActionsAndProbs,  // Return type (must be a simple token)
+        Evaluator,        // Parent class
+        "prior",          // Name of function in Python
+        Prior,            // Name of function in C++
+        state             // Arguments
+    );
+  }
+};
+
+// An InferenceModel calling a Python function, e.g. running a PyTorch or JAX
+// network, so that the C++ MCTSBot can evaluate batches of leaves with it:
+//   fn(inputs, legal_masks) -> (policies, values)
+// takes [batch_size, input_size] and [batch_size, num_actions] float32 arrays
+// and returns arrays of shape [batch_size, num_actions] and [batch_size].
+// Infer holds the GIL only during the call, so the tree work of a search
+// runs without it.
+class PyInferenceModel : public algorithms::InferenceModel {
+ public:
+  PyInferenceModel(int input_size, int num_actions, py::function fn)
+      : input_size_(input_size),
+        num_actions_(num_actions),
+        fn_(std::move(fn)) {}
+
+  // The model may be released by a search that doesn't hold the GIL.
+  ~PyInferenceModel() override {
+    py::gil_scoped_acquire gil;
+    fn_ = py::function();
+  }
+
+  int InputSize() const override { return input_size_; }
+  int NumActions() const override { return num_actions_; }
+
+  void Infer(int batch_size, absl::Span<const float> inputs,
+             absl::Span<const float> legal_masks, absl::Span<float> policies,
+             absl::Span<float> values) const override {
+    using FloatArray =
+        py::array_t<float, py::array::c_style | py::array::forcecast>;
+    py::gil_scoped_acquire gil;
+    const py::tuple outputs = fn_(
+        py::array_t<float>({batch_size, input_size_}, inputs.data()),
+        py::array_t<float>({batch_size, num_actions_}, legal_masks.data()));
+    SPIEL_CHECK_EQ(outputs.size(), 2);
+    const FloatArray py_policies = outputs[0].cast<FloatArray>();
+    SPIEL_CHECK_EQ(py_policies.size(), policies.size());
+    std::copy_n(py_policies.data(), policies.size(), policies.begin());
+    if (!values.empty()) {
+      const FloatArray py_values = outputs[1].cast<FloatArray>();
+      SPIEL_CHECK_EQ(py_values.size(), values.size());
+      std::copy_n(py_values.data(), values.size(), values.begin());
+    }
+  }
+
+ private:
+  const int input_size_;
+  const int num_actions_;
+  py::function fn_;
+};
+
+using ContiguousTrajectory =
+    ::open_spiel::algorithms::ContiguousBatchedTrajectory;
+
+// Returns a numpy array viewing a [batch, time, step_size] field of a
+// trajectory, or [batch, time] for a step_size of 0, without copies. It keeps
+// `owner`, the Python trajectory, alive.
+template <typename T>
+py::array_t<T> TrajectoryField(const ContiguousTrajectory& trajectory,
+                               const std::vector<T>& buffer, int step_size,
+                               py::handle owner) {
+  std::vector<int64_t> shape = trajectory.FieldShape(std::max(step_size, 1));
+  std::vector<int64_t> strides = trajectory.FieldStrides(shape[2]);
+  for (int64_t& stride : strides) stride *= sizeof(T);
+  if (step_size == 0) {
+    shape.pop_back();
+    strides.pop_back();
+  }
+  return py::array_t<T>(shape, strides, buffer.data(), owner);
+}
+
 // Definintion of our Python module.
 PYBIND11_MODULE(pyspiel, m) {
   m.doc() = "Open Spiel";
@@ -289,6 +433,17 @@ PYBIND11_MODULE(pyspiel, m) {
            (std::vector<int>(State::*)(int) const) & State::LegalActionsMask)
       .def("legal_actions_mask",
            (std::vector<int>(State::*)(void) const) & State::LegalActionsMask)
+      .def(
+          "write_legal_actions_mask",
+          [](const State& state, Player player,
+             py::array_t<float, py::array::c_style> mask) {
+            state.LegalActionsMask(
+                player, absl::MakeSpan(mask.mutable_data(), mask.size()));
+          },
+          py::arg("player"), py::arg("mask").noconvert())
+      .def("legal_actions_bitmask",
+           (std::vector<uint64_t>(State::*)(Player) const) &
+               State::LegalActionsBitmask)
       .def("action_to_string", (std::string(State::*)(Player, Action) const) &
                                    State::ActionToString)
       .def("action_to_string",
@@ -300,18 +455,22 @@ PYBIND11_MODULE(pyspiel, m) {
            (Action(State::*)(const std::string&) const) & State::StringToAction)
       .def("__str__", &State::ToString)
       .def("is_terminal", &State::IsTerminal)
-      .def("rewards", &State::Rewards)
-      .def("returns", &State::Returns)
+      .def("rewards",
+           (std::vector<double>(State::*)() const) & State::Rewards)
+      .def("returns",
+           (std::vector<double>(State::*)() const) & State::Returns)
       .def("player_reward", &State::PlayerReward)
       .def("player_return", &State::PlayerReturn)
       .def("is_chance_node", &State::IsChanceNode)
       .def("is_simultaneous_node", &State::IsSimultaneousNode)
       .def("history", &State::History)
       .def("history_str", &State::HistoryString)
+      .def("hash", &State::Hash)
       .def("information_state_string",
            (std::string(State::*)(int) const) & State::InformationStateString)
       .def("information_state_string",
            (std::string(State::*)() const) & State::InformationStateString)
+      .def("information_state_index", &State::InformationStateIndex)
       .def("information_state_tensor",
            (std::vector<double>(State::*)(int) const) &
                State::InformationStateTensor)
@@ -325,25 +484,116 @@ PYBIND11_MODULE(pyspiel, m) {
                                      State::ObservationTensor)
       .def("observation_tensor",
            (std::vector<double>(State::*)() const) & State::ObservationTensor)
+      // Fill a caller-owned float32 buffer in place (e.g. a row of a batch).
+      // The buffer is not converted, so writes are visible to the caller.
+      .def(
+          "write_information_state_tensor",
+          [](const State& state, Player player,
+             py::array_t<float, py::array::c_style> values) {
+            state.InformationStateTensor(
+                player, absl::MakeSpan(values.mutable_data(), values.size()));
+          },
+          py::arg("player"), py::arg("values").noconvert())
+      .def(
+          "write_observation_tensor",
+          [](const State& state, Player player,
+             py::array_t<float, py::array::c_style> values) {
+            state.ObservationTensor(
+                player, absl::MakeSpan(values.mutable_data(), values.size()));
+          },
+          py::arg("player"), py::arg("values").noconvert())
+      // As information_state_tensor and observation_tensor, but returning a
+      // new flat float32 array rather than a list of Python floats.
+      .def("information_state_tensor_array",
+           [](const State& state, Player player) {
+             py::array_t<float> values(
+                 state.GetGame()->InformationStateTensorSize());
+             state.InformationStateTensor(
+                 player, absl::MakeSpan(values.mutable_data(), values.size()));
+             return values;
+           }, py::arg("player"))
+      .def("information_state_tensor_array",
+           [](const State& state) {
+             py::array_t<float> values(
+                 state.GetGame()->InformationStateTensorSize());
+             state.InformationStateTensor(
+                 state.CurrentPlayer(),
+                 absl::MakeSpan(values.mutable_data(), values.size()));
+             return values;
+           })
+      .def("observation_tensor_array",
+           [](const State& state, Player player) {
+             py::array_t<float> values(
+                 state.GetGame()->ObservationTensorSize());
+             state.ObservationTensor(
+                 player, absl::MakeSpan(values.mutable_data(), values.size()));
+             return values;
+           }, py::arg("player"))
+      .def("observation_tensor_array",
+           [](const State& state) {
+             py::array_t<float> values(
+                 state.GetGame()->ObservationTensorSize());
+             state.ObservationTensor(
+                 state.CurrentPlayer(),
+                 absl::MakeSpan(values.mutable_data(), values.size()));
+             return values;
+           })
+      // The nonzero elements as a pair of (indices, values) arrays.
+      .def("sparse_information_state_tensor",
+           [](const State& state, Player player) {
+             SparseTensor tensor;
+             state.SparseInformationStateTensor(player, &tensor);
+             return py::make_tuple(py::array_t<int>(tensor.indices.size(),
+                                                    tensor.indices.data()),
+                                   py::array_t<float>(tensor.values.size(),
+                                                      tensor.values.data()));
+           })
+      .def("sparse_observation_tensor",
+           [](const State& state, Player player) {
+             SparseTensor tensor;
+             state.SparseObservationTensor(player, &tensor);
+             return py::make_tuple(py::array_t<int>(tensor.indices.size(),
+                                                    tensor.indices.data()),
+                                   py::array_t<float>(tensor.values.size(),
+                                                      tensor.values.data()));
+           })
       .def("clone", &State::Clone)
       .def("child", &State::Child)
       .def("undo_action", &State::UndoAction)
       .def("apply_actions", &State::ApplyActions)
       .def("num_distinct_actions", &State::NumDistinctActions)
       .def("num_players", &State::NumPlayers)
-      .def("chance_outcomes", &State::ChanceOutcomes)
+      .def("chance_outcomes",
+           (ActionsAndProbs(State::*)() const) & State::ChanceOutcomes)
       .def("get_game", &State::GetGame)
       .def("get_type", &State::GetType)
       .def("serialize", &State::Serialize)
+      .def("serialize_binary",
+           [](const State& state) {
+             return py::bytes(state.SerializeBinary());
+           })
       .def("resample_from_infostate", &State::ResampleFromInfostate)
       .def(py::pickle(              // Pickle support
+          // The game is pickled as a Python object, so that the states of a
+          // game pickled together store it once, and the state in the compact
+          // binary format.
           [](const State& state) {  // __getstate__
-            return SerializeGameAndState(*state.GetGame(), state);
+            return py::make_tuple(state.GetGame(),
+                                  py::bytes(state.SerializeBinary()));
           },
-          [](const std::string& data) {  // __setstate__
-            std::pair<std::shared_ptr<const Game>, std::unique_ptr<State>>
-                game_and_state = DeserializeGameAndState(data);
-            return std::move(game_and_state.second);
+          [](const py::object& data) {  // __setstate__
+            // Pickles from before the binary format hold a single string.
+            if (py::isinstance<py::str>(data)) {
+              std::pair<std::shared_ptr<const Game>, std::unique_ptr<State>>
+                  game_and_state =
+                      DeserializeGameAndState(data.cast<std::string>());
+              return std::move(game_and_state.second);
+            }
+            const py::tuple game_and_state = data.cast<py::tuple>();
+            SPIEL_CHECK_EQ(game_and_state.size(), 2);
+            const auto game = game_and_state[0].cast<std::shared_ptr<Game>>();
+            return game->DeserializeStateBinary(
+                game_and_state[1].cast<std::string>());
           }));
 
   py::class_<Game, std::shared_ptr<Game>> game(m, "Game");
@@ -360,11 +610,19 @@ PYBIND11_MODULE(pyspiel, m) {
       .def("information_state_tensor_layout",
            &Game::InformationStateTensorLayout)
       .def("information_state_tensor_size", &Game::InformationStateTensorSize)
+      .def("information_state_tensor_is_sparse",
+           &Game::InformationStateTensorIsSparse)
+      .def("num_information_states", &Game::NumInformationStates)
       .def("observation_tensor_shape", &Game::ObservationTensorShape)
       .def("observation_tensor_layout", &Game::ObservationTensorLayout)
       .def("observation_tensor_size", &Game::ObservationTensorSize)
+      .def("observation_tensor_is_sparse", &Game::ObservationTensorIsSparse)
       .def("policy_tensor_shape", &Game::PolicyTensorShape)
       .def("deserialize_state", &Game::DeserializeState)
+      .def("deserialize_state_binary",
+           [](const Game& game, const py::bytes& data) {
+             return game.DeserializeStateBinary(std::string(data));
+           })
       .def("max_game_length", &Game::MaxGameLength)
       .def("__str__", &Game::ToString)
       .def("__eq__",
@@ -379,7 +637,7 @@ PYBIND11_MODULE(pyspiel, m) {
             // Have to remove the const here for this to compile, presumably
             // because the holder type is non-const. But seems like you can't
             // set the holder type to std::shared_ptr<const Game> either.
-            return std::const_pointer_cast<Game>(LoadGame(data));
+            return std::const_pointer_cast<Game>(LoadInternedGame(data));
           }));
 
   py::class_<NormalFormGame, std::shared_ptr<NormalFormGame>> normal_form_game(
@@ -432,6 +690,21 @@ PYBIND11_MODULE(pyspiel, m) {
            })
       .def("row_action_name", &MatrixGame::RowActionName)
       .def("col_action_name", &MatrixGame::ColActionName)
+      .def("expected_payoffs",
+           [](const MatrixGame& game, const std::vector<double>& row_strategy,
+              const std::vector<double>& col_strategy) {
+             return game.ExpectedPayoffs(row_strategy, col_strategy);
+           })
+      .def("action_values",
+           [](const MatrixGame& game, Player player,
+              const std::vector<double>& opponent_strategy) {
+             return game.ActionValues(player, opponent_strategy);
+           })
+      .def("best_response",
+           [](const MatrixGame& game, Player player,
+              const std::vector<double>& opponent_strategy) {
+             return game.BestResponse(player, opponent_strategy);
+           })
       .def(py::pickle(                                  // Pickle support
           [](std::shared_ptr<const MatrixGame> game) {  // __getstate__
             return game->ToString();
@@ -459,6 +732,24 @@ PYBIND11_MODULE(pyspiel, m) {
              return py::array_t<double>(game.Shape(), &utilities[0]);
            })
       .def("action_name", &TensorGame::ActionName)
+      .def("expected_payoffs",
+           [](const TensorGame& game,
+              const std::vector<std::vector<double>>& strategies) {
+             return game.ExpectedPayoffs(
+                 {strategies.begin(), strategies.end()});
+           })
+      .def("action_values",
+           [](const TensorGame& game, Player player,
+              const std::vector<std::vector<double>>& strategies) {
+             return game.ActionValues(player,
+                                      {strategies.begin(), strategies.end()});
+           })
+      .def("best_response",
+           [](const TensorGame& game, Player player,
+              const std::vector<std::vector<double>>& strategies) {
+             return game.BestResponse(player,
+                                      {strategies.begin(), strategies.end()});
+           })
       .def(py::pickle(                                  // Pickle support
           [](std::shared_ptr<const TensorGame> game) {  // __getstate__
             return game->ToString();
@@ -471,6 +762,16 @@ PYBIND11_MODULE(pyspiel, m) {
                 algorithms::LoadTensorGame(data));
           }));
 
+  py::class_<LazyTensorGame, std::shared_ptr<LazyTensorGame>>(
+      m, "LazyTensorGame", normal_form_game)
+      .def("shape", &LazyTensorGame::Shape)
+      .def("utilities", &LazyTensorGame::Utilities)
+      .def("player_utility", &LazyTensorGame::PlayerUtility)
+      .def("action_name", &LazyTensorGame::ActionName)
+      .def("add_sample", &LazyTensorGame::AddSample)
+      .def("num_samples", &LazyTensorGame::NumSamples)
+      .def("num_entries", &LazyTensorGame::NumEntries);
+
   py::class_<Bot, PyBot> bot(m, "Bot");
   bot.def(py::init<>())
       .def("step", &Bot::Step)
@@ -483,10 +784,60 @@ PYBIND11_MODULE(pyspiel, m) {
       .def("get_policy", &Bot::GetPolicy)
       .def("step_with_policy", &Bot::StepWithPolicy);
 
-  py::class_<algorithms::Evaluator> mcts_evaluator(m, "Evaluator");
+  py::class_<algorithms::Evaluator, PyEvaluator> mcts_evaluator(m,
+                                                               "Evaluator");
+  mcts_evaluator.def(py::init<>())
+      .def("evaluate", &algorithms::Evaluator::Evaluate)
+      .def("prior", &algorithms::Evaluator::Prior);
   py::class_<algorithms::RandomRolloutEvaluator, algorithms::Evaluator>(
       m, "RandomRolloutEvaluator")
       .def(py::init<int, int>(), py::arg("n_rollouts"), py::arg("seed"));
+  py::class_<algorithms::CachingEvaluator, algorithms::Evaluator>(
+      m, "CachingEvaluator")
+      .def(py::init<algorithms::Evaluator*, int, int>(), py::arg("evaluator"),
+           py::arg("cache_size"), py::arg("cache_shards") = 16,
+           // The wrapper only keeps a pointer to the evaluator.
+           py::keep_alive<1, 2>())
+      .def("value_cache_hit_rate",
+           [](algorithms::CachingEvaluator& self) {
+             return self.ValueCacheInfo().HitRate();
+           })
+      .def("prior_cache_hit_rate",
+           [](algorithms::CachingEvaluator& self) {
+             return self.PriorCacheInfo().HitRate();
+           })
+      .def("clear_cache", &algorithms::CachingEvaluator::ClearCache);
+
+  py::class_<algorithms::InferenceModel,
+             std::shared_ptr<algorithms::InferenceModel>>(m, "InferenceModel")
+      .def("input_size", &algorithms::InferenceModel::InputSize)
+      .def("num_actions", &algorithms::InferenceModel::NumActions);
+  py::class_<PyInferenceModel, algorithms::InferenceModel,
+             std::shared_ptr<PyInferenceModel>>(m, "PyInferenceModel")
+      .def(py::init<int, int, py::function>(), py::arg("input_size"),
+           py::arg("num_actions"), py::arg("fn"));
+  py::class_<algorithms::UniformInferenceModel, algorithms::InferenceModel,
+             std::shared_ptr<algorithms::UniformInferenceModel>>(
+      m, "UniformInferenceModel")
+      .def(py::init<const Game&>(), py::arg("game"));
+  m.def(
+      "load_inference_model",
+      [](const std::string& backend, const Game& game,
+         const std::string& path) {
+        return std::shared_ptr<algorithms::InferenceModel>(
+            algorithms::LoadInferenceModel(backend, game, path));
+      },
+      py::arg("backend"), py::arg("game"), py::arg("path"));
+  m.def("inference_input_size", &algorithms::InferenceInputSize,
+        "The size of the inputs of the game's InferenceModels.");
+  // One call to the model for all the leaves of a batch of MCTSBot.
+  py::class_<algorithms::InferenceEvaluator, algorithms::Evaluator>(
+      m, "InferenceEvaluator")
+      .def(py::init([](std::shared_ptr<algorithms::InferenceModel> model) {
+             return std::make_unique<algorithms::InferenceEvaluator>(
+                 std::move(model));
+           }),
+           py::arg("model"));
 
   py::enum_<algorithms::ChildSelectionPolicy>(m, "ChildSelectionPolicy")
       .value("UCT", algorithms::ChildSelectionPolicy::UCT)
@@ -495,26 +846,212 @@ PYBIND11_MODULE(pyspiel, m) {
   py::class_<algorithms::MCTSBot, Bot>(m, "MCTSBot")
       .def(
           py::init<const Game&, Evaluator*, double, int, int64_t, bool,
-                   int, bool, ::open_spiel::algorithms::ChildSelectionPolicy>(),
+                   int, bool, ::open_spiel::algorithms::ChildSelectionPolicy,
+                   double, double, int, double, int, bool, double, bool, bool,
+                   int>(),
           py::arg("game"), py::arg("evaluator"),
           py::arg("uct_c"), py::arg("max_simulations"),
           py::arg("max_memory_mb"), py::arg("solve"), py::arg("seed"),
           py::arg("verbose"),
           py::arg("child_selection_policy") =
-              algorithms::ChildSelectionPolicy::UCT)
-      .def("step", &algorithms::MCTSBot::Step)
-      .def("mcts_search", &algorithms::MCTSBot::MCTSearch);
+              algorithms::ChildSelectionPolicy::UCT,
+          py::arg("dirichlet_alpha") = 0, py::arg("dirichlet_epsilon") = 0,
+          py::arg("num_threads") = 1, py::arg("virtual_loss") = 1,
+          py::arg("batch_size") = 1, py::arg("reuse_tree") = false,
+          py::arg("max_seconds") = 0, py::arg("stop_early") = false,
+          py::arg("use_transpositions") = false,
+          py::arg("gumbel_num_actions") = 0,
+          // The bot only keeps a pointer to the evaluator.
+          py::keep_alive<1, 3>())
+      // Searches release the GIL, so bots can search in parallel from Python
+      // threads.
+      .def("step", &algorithms::MCTSBot::Step,
+           py::call_guard<py::gil_scoped_release>())
+      .def("mcts_search", &algorithms::MCTSBot::MCTSearch,
+           py::call_guard<py::gil_scoped_release>());
+
+  py::enum_<algorithms::ISMCTSVariant>(m, "ISMCTSVariant")
+      .value("SINGLE_OBSERVER", algorithms::ISMCTSVariant::kSingleObserver)
+      .value("MULTI_OBSERVER", algorithms::ISMCTSVariant::kMultiObserver);
+
+  py::enum_<algorithms::ISMCTSFinalPolicyType>(m, "ISMCTSFinalPolicyType")
+      .value("NORMALIZED_VISIT_COUNT",
+             algorithms::ISMCTSFinalPolicyType::kNormalizedVisitCount)
+      .value("MAX_VISIT_COUNT",
+             algorithms::ISMCTSFinalPolicyType::kMaxVisitCount)
+      .value("MAX_VALUE", algorithms::ISMCTSFinalPolicyType::kMaxValue);
+
+  py::class_<algorithms::ISMCTSBot, Bot>(m, "ISMCTSBot")
+      .def(py::init<const Game&, Evaluator*, double, int, int,
+                    algorithms::ISMCTSVariant,
+                    algorithms::ISMCTSFinalPolicyType, int, bool>(),
+           py::arg("game"), py::arg("evaluator"), py::arg("uct_c"),
+           py::arg("max_simulations"), py::arg("seed"),
+           py::arg("variant") = algorithms::ISMCTSVariant::kSingleObserver,
+           py::arg("final_policy_type") =
+               algorithms::ISMCTSFinalPolicyType::kNormalizedVisitCount,
+           py::arg("max_world_samples") =
+               algorithms::ISMCTSBot::kUnlimitedNumWorldSamples,
+           py::arg("use_observation_string") = false,
+           // The bot only keeps a pointer to the evaluator.
+           py::keep_alive<1, 3>())
+      .def("step", &algorithms::ISMCTSBot::Step,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_search", &algorithms::ISMCTSBot::RunSearch,
+           py::call_guard<py::gil_scoped_release>());
+
+  py::enum_<algorithms::SMMCTSSelection>(m, "SMMCTSSelection")
+      .value("DECOUPLED_UCT", algorithms::SMMCTSSelection::kDecoupledUCT)
+      .value("EXP3", algorithms::SMMCTSSelection::kExp3)
+      .value("REGRET_MATCHING", algorithms::SMMCTSSelection::kRegretMatching);
+
+  py::class_<algorithms::SMMCTSBot, Bot>(m, "SMMCTSBot")
+      .def(py::init<const Game&, Evaluator*, Player, int, int,
+                    algorithms::SMMCTSSelection, double, double>(),
+           py::arg("game"), py::arg("evaluator"), py::arg("player_id"),
+           py::arg("max_simulations"), py::arg("seed"),
+           py::arg("selection") = algorithms::SMMCTSSelection::kDecoupledUCT,
+           py::arg("uct_c") = 2, py::arg("exploration") = 0.1,
+           // The bot only keeps a pointer to the evaluator.
+           py::keep_alive<1, 3>())
+      .def("step", &algorithms::SMMCTSBot::Step,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_search", &algorithms::SMMCTSBot::RunSearch,
+           py::call_guard<py::gil_scoped_release>());
+
+  // The batched outputs are returned as [num_envs, ...] numpy arrays.
+  py::class_<algorithms::VectorEnv>(m, "VectorEnv")
+      .def(py::init<std::shared_ptr<const Game>, int, int, int>(),
+           py::arg("game"), py::arg("num_envs"), py::arg("seed"),
+           py::arg("num_stacked_frames") = 1)
+      .def("reset", &algorithms::VectorEnv::Reset)
+      .def("step",
+           [](algorithms::VectorEnv& env, const std::vector<Action>& actions) {
+             env.Step(actions);
+           })
+      .def("num_envs", &algorithms::VectorEnv::num_envs)
+      .def("num_stacked_frames", &algorithms::VectorEnv::num_stacked_frames)
+      .def("state", &algorithms::VectorEnv::state,
+           py::return_value_policy::reference_internal)
+      .def("observations",
+           [](const algorithms::VectorEnv& env) {
+             const int size = env.observations().size() / env.num_envs();
+             return py::array_t<float>({env.num_envs(), size},
+                                       env.observations().data());
+           })
+      .def("legal_actions_masks",
+           [](const algorithms::VectorEnv& env) {
+             const int size = env.legal_actions_masks().size() / env.num_envs();
+             return py::array_t<float>({env.num_envs(), size},
+                                       env.legal_actions_masks().data());
+           })
+      .def("rewards",
+           [](const algorithms::VectorEnv& env) {
+             const int size = env.rewards().size() / env.num_envs();
+             return py::array_t<float>({env.num_envs(), size},
+                                       env.rewards().data());
+           })
+      .def("current_players",
+           [](const algorithms::VectorEnv& env) {
+             return py::array_t<int>(env.num_envs(),
+                                     env.current_players().data());
+           })
+      .def("dones", [](const algorithms::VectorEnv& env) {
+        return py::array_t<int>(env.num_envs(), env.dones().data());
+      });
+
+  py::enum_<algorithms::TabularAlgorithm>(m, "TabularAlgorithm")
+      .value("Q_LEARNING", algorithms::TabularAlgorithm::kQLearning)
+      .value("SARSA", algorithms::TabularAlgorithm::kSarsa)
+      .export_values();
+
+  py::class_<algorithms::TabularLearnerConfig>(m, "TabularLearnerConfig")
+      .def(py::init<>())
+      .def_readwrite("algorithm", &algorithms::TabularLearnerConfig::algorithm)
+      .def_readwrite("step_size", &algorithms::TabularLearnerConfig::step_size)
+      .def_readwrite("epsilon", &algorithms::TabularLearnerConfig::epsilon)
+      .def_readwrite("discount_factor",
+                     &algorithms::TabularLearnerConfig::discount_factor)
+      .def_readwrite("num_envs", &algorithms::TabularLearnerConfig::num_envs)
+      .def_readwrite("seed", &algorithms::TabularLearnerConfig::seed);
+
+  py::class_<algorithms::TabularLearner>(m, "TabularLearner")
+      .def(py::init<std::shared_ptr<const Game>,
+                    const algorithms::TabularLearnerConfig&>(),
+           py::arg("game"),
+           py::arg("config") = algorithms::TabularLearnerConfig())
+      .def("train", &algorithms::TabularLearner::Train, py::arg("num_steps"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("q_values", &algorithms::TabularLearner::QValues)
+      .def("greedy_action", &algorithms::TabularLearner::GreedyAction)
+      .def("num_states", &algorithms::TabularLearner::NumStates)
+      .def("num_steps", &algorithms::TabularLearner::NumSteps)
+      .def("num_episodes", &algorithms::TabularLearner::NumEpisodes);
+
+  // reset and step return the TimeStep of the whole batch in one call, as a
+  // dict of [num_envs, ...] numpy arrays.
+  auto rl_time_step = [](const algorithms::RLEnvironment& env) {
+    const int num_envs = env.num_envs();
+    const int num_players = env.num_players();
+    const int num_actions =
+        env.legal_actions_masks().size() / (num_envs * num_players);
+    py::dict time_step;
+    time_step["info_state"] = py::array_t<float>(
+        {num_envs, num_players, env.info_state_size()},
+        env.info_states().data());
+    time_step["legal_actions_mask"] = py::array_t<float>(
+        {num_envs, num_players, num_actions}, env.legal_actions_masks().data());
+    time_step["current_player"] =
+        py::array_t<int>(num_envs, env.current_players().data());
+    time_step["rewards"] = py::array_t<float>({num_envs, num_players},
+                                              env.rewards().data());
+    time_step["discounts"] = py::array_t<float>({num_envs, num_players},
+                                                env.discounts().data());
+    time_step["step_type"] =
+        py::array_t<int>(num_envs, env.step_types().data());
+    return time_step;
+  };
+  py::class_<algorithms::RLEnvironment>(m, "RLEnvironment")
+      .def(py::init<std::shared_ptr<const Game>, int, int, bool, double>(),
+           py::arg("game"), py::arg("num_envs"), py::arg("seed"),
+           py::arg("use_observation_tensor") = false,
+           py::arg("discount") = 1.0)
+      .def("reset",
+           [rl_time_step](algorithms::RLEnvironment& env) {
+             {
+               py::gil_scoped_release release;
+               env.Reset();
+             }
+             return rl_time_step(env);
+           })
+      .def("step",
+           [rl_time_step](algorithms::RLEnvironment& env,
+                          const std::vector<Action>& actions) {
+             {
+               py::gil_scoped_release release;
+               env.Step(actions);
+             }
+             return rl_time_step(env);
+           })
+      .def("num_envs", &algorithms::RLEnvironment::num_envs)
+      .def("num_players", &algorithms::RLEnvironment::num_players)
+      .def("info_state_size", &algorithms::RLEnvironment::info_state_size)
+      .def("state", &algorithms::RLEnvironment::state,
+           py::return_value_policy::reference_internal);
 
   py::class_<TabularBestResponse>(m, "TabularBestResponse")
       .def(py::init<const open_spiel::Game&, int,
                     const std::unordered_map<std::string,
                                              open_spiel::ActionsAndProbs>&>())
       .def(py::init<const open_spiel::Game&, int, const open_spiel::Policy*>())
-      .def("value", &TabularBestResponse::Value)
+      .def("value", &TabularBestResponse::Value,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_best_response_policy",
-           &TabularBestResponse::GetBestResponsePolicy)
+           &TabularBestResponse::GetBestResponsePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_best_response_actions",
-           &TabularBestResponse::GetBestResponseActions)
+           &TabularBestResponse::GetBestResponseActions,
+           py::call_guard<py::gil_scoped_release>())
       .def("set_policy", py::overload_cast<const std::unordered_map<
                              std::string, open_spiel::ActionsAndProbs>&>(
                              &TabularBestResponse::SetPolicy))
@@ -544,17 +1081,61 @@ PYBIND11_MODULE(pyspiel, m) {
            py::overload_cast<>(&open_spiel::TabularPolicy::PolicyTable));
   m.def("UniformRandomPolicy", &open_spiel::GetUniformPolicy);
 
+  // Reads the action_probability_array of a Python TabularPolicy in place,
+  // see policy.python_policy_to_pyspiel_array_policy. The array must be a
+  // C-contiguous float64 array, and is kept alive by the policy.
+  py::class_<open_spiel::ArrayTabularPolicy, open_spiel::Policy>(
+      m, "ArrayTabularPolicy")
+      .def(py::init([](std::unordered_map<std::string, int> state_lookup,
+                       py::array_t<bool, py::array::c_style |
+                                             py::array::forcecast>
+                           legal_actions_mask,
+                       py::array_t<double, py::array::c_style>
+                           action_probability_array) {
+             SPIEL_CHECK_EQ(legal_actions_mask.ndim(), 2);
+             auto mask = legal_actions_mask.unchecked<2>();
+             std::vector<std::vector<Action>> legal_actions(mask.shape(0));
+             for (py::ssize_t row = 0; row < mask.shape(0); ++row) {
+               for (py::ssize_t action = 0; action < mask.shape(1); ++action) {
+                 if (mask(row, action)) legal_actions[row].push_back(action);
+               }
+             }
+             SPIEL_CHECK_EQ(action_probability_array.size(),
+                            legal_actions_mask.size());
+             return open_spiel::ArrayTabularPolicy(
+                 std::move(state_lookup), legal_actions,
+                 absl::MakeConstSpan(action_probability_array.data(),
+                                     action_probability_array.size()));
+           }),
+           py::arg("state_lookup"), py::arg("legal_actions_mask"),
+           py::arg("action_probability_array").noconvert(),
+           py::keep_alive<1, 4>())
+      .def(
+          "set_action_probability_array",
+          [](open_spiel::ArrayTabularPolicy& policy,
+             py::array_t<double, py::array::c_style> action_probability_array) {
+            policy.SetActionProbabilityArray(
+                absl::MakeConstSpan(action_probability_array.data(),
+                                    action_probability_array.size()));
+          },
+          py::arg("action_probability_array").noconvert(),
+          py::keep_alive<1, 2>())
+      .def("num_states", &open_spiel::ArrayTabularPolicy::NumStates)
+      .def("num_actions", &open_spiel::ArrayTabularPolicy::NumActions);
+
   py::class_<open_spiel::algorithms::CFRSolver>(m, "CFRSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRSolver::EvaluateAndUpdatePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy", &open_spiel::algorithms::CFRSolver::AveragePolicy);
 
   py::class_<open_spiel::algorithms::CFRPlusSolver>(m, "CFRPlusSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy",
            &open_spiel::algorithms::CFRPlusSolver::AveragePolicy);
@@ -562,11 +1143,93 @@ PYBIND11_MODULE(pyspiel, m) {
   py::class_<open_spiel::algorithms::CFRBRSolver>(m, "CFRBRSolver")
       .def(py::init<const Game&>())
       .def("evaluate_and_update_policy",
-           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy)
+           &open_spiel::algorithms::CFRPlusSolver::EvaluateAndUpdatePolicy,
+           py::call_guard<py::gil_scoped_release>())
       .def("current_policy", &open_spiel::algorithms::CFRSolver::CurrentPolicy)
       .def("average_policy",
            &open_spiel::algorithms::CFRPlusSolver::AveragePolicy);
 
+  py::class_<open_spiel::algorithms::XFPSolver>(m, "XFPSolver")
+      .def(py::init<const Game&, int>(), py::arg("game"),
+           py::arg("num_threads") = 1)
+      .def("run_iteration", &open_spiel::algorithms::XFPSolver::RunIteration,
+           py::call_guard<py::gil_scoped_release>())
+      .def("num_iterations",
+           &open_spiel::algorithms::XFPSolver::NumIterations)
+      .def("average_policy",
+           &open_spiel::algorithms::XFPSolver::AveragePolicy,
+           py::return_value_policy::copy)
+      .def("best_response_policy",
+           &open_spiel::algorithms::XFPSolver::BestResponsePolicy);
+
+  // Samples are returned as a tuple of numpy arrays: the [size, input_size]
+  // info states, [size] iterations and [size, num_actions] targets.
+  using FloatArray =
+      py::array_t<float, py::array::c_style | py::array::forcecast>;
+  using IntArray = py::array_t<int, py::array::c_style | py::array::forcecast>;
+  auto deep_cfr_batch = [](const algorithms::DeepCFRReservoir& reservoir,
+                           const algorithms::DeepCFRBatch& batch) {
+    return py::make_tuple(
+        py::array_t<float>({batch.size, reservoir.InputSize()},
+                           batch.info_states.data()),
+        py::array_t<int>(batch.size, batch.iterations.data()),
+        py::array_t<float>({batch.size, reservoir.NumActions()},
+                           batch.targets.data()));
+  };
+  py::class_<algorithms::DeepCFRReservoir>(m, "DeepCFRReservoir")
+      .def(py::init<int, int, int, int>(), py::arg("capacity"),
+           py::arg("input_size"), py::arg("num_actions"), py::arg("seed") = 0)
+      .def("add",
+           [](algorithms::DeepCFRReservoir& reservoir, FloatArray info_states,
+              IntArray iterations, FloatArray targets) {
+             reservoir.Add(
+                 iterations.size(),
+                 absl::MakeConstSpan(info_states.data(), info_states.size()),
+                 absl::MakeConstSpan(iterations.data(), iterations.size()),
+                 absl::MakeConstSpan(targets.data(), targets.size()));
+           },
+           py::arg("info_states"), py::arg("iterations"), py::arg("targets"))
+      .def("sample",
+           [deep_cfr_batch](const algorithms::DeepCFRReservoir& reservoir,
+                            int num, int seed) {
+             std::mt19937 rng(seed);
+             return deep_cfr_batch(reservoir, reservoir.Sample(num, &rng));
+           },
+           py::arg("num"), py::arg("seed"))
+      .def("contents",
+           [deep_cfr_batch](const algorithms::DeepCFRReservoir& reservoir) {
+             return deep_cfr_batch(reservoir, reservoir.Contents());
+           })
+      .def("clear", &algorithms::DeepCFRReservoir::Clear)
+      .def("__len__", &algorithms::DeepCFRReservoir::Size)
+      .def("total_added", &algorithms::DeepCFRReservoir::TotalAdded)
+      .def("capacity", &algorithms::DeepCFRReservoir::Capacity);
+
+  // The traversals run with the GIL released, so that PyInferenceModels can
+  // be called from the traversal threads.
+  py::class_<algorithms::DeepCFRSampler>(m, "DeepCFRSampler")
+      .def(py::init<const Game&, int, int, int>(), py::arg("game"),
+           py::arg("advantage_capacity"), py::arg("strategy_capacity"),
+           py::arg("seed") = 0)
+      .def("set_advantage_model",
+           [](algorithms::DeepCFRSampler& sampler, Player player,
+              std::shared_ptr<algorithms::InferenceModel> model) {
+             sampler.SetAdvantageModel(player, std::move(model));
+           },
+           py::arg("player"), py::arg("model"))
+      .def("traverse", &algorithms::DeepCFRSampler::Traverse,
+           py::arg("player"), py::arg("iteration"), py::arg("num_traversals"),
+           py::arg("num_threads") = 1,
+           py::call_guard<py::gil_scoped_release>())
+      .def("advantage_reservoir",
+           &algorithms::DeepCFRSampler::AdvantageReservoir,
+           py::return_value_policy::reference_internal)
+      .def("strategy_reservoir",
+           &algorithms::DeepCFRSampler::StrategyReservoir,
+           py::return_value_policy::reference_internal)
+      .def("num_traversals", &algorithms::DeepCFRSampler::NumTraversals)
+      .def("num_nodes_visited", &algorithms::DeepCFRSampler::NumNodesVisited);
+
   py::class_<open_spiel::algorithms::TrajectoryRecorder>(m,
                                                          "TrajectoryRecorder")
       .def(py::init<const Game&, const std::unordered_map<std::string, int>&,
@@ -639,6 +1302,15 @@ PYBIND11_MODULE(pyspiel, m) {
         "Returns a new game object for the specified short name using given "
         "parameters");
 
+  m.def("load_game_cached",
+        py::overload_cast<const std::string&>(&open_spiel::LoadGameCached),
+        py::call_guard<py::gil_scoped_release>(),
+        "Returns the game object for the specified game string, shared by all "
+        "the calls for the same game.");
+
+  m.def("clear_game_cache", &open_spiel::ClearGameCache,
+        "Drops the games cached by load_game_cached.");
+
   m.def("load_game_as_turn_based",
         py::overload_cast<const std::string&>(&open_spiel::LoadGameAsTurnBased),
         "Converts a simultaneous game into an turn-based game with infosets.");
@@ -655,15 +1327,142 @@ PYBIND11_MODULE(pyspiel, m) {
         "Loads a game as a tensor game (will fail if not a tensor game.");
 
   m.def("extensive_to_matrix_game",
-        open_spiel::algorithms::ExtensiveToMatrixGame,
+        open_spiel::algorithms::ExtensiveToMatrixGame, py::arg("game"),
+        py::arg("num_threads") = 1,
         "Converts a two-player extensive-game to its equivalent matrix game, "
         "which is exponentially larger. Use only with small games.");
 
   m.def("extensive_to_tensor_game",
-        open_spiel::ExtensiveToTensorGame,
+        open_spiel::ExtensiveToTensorGame, py::arg("game"),
+        py::arg("reduced") = false,
         "Converts an extensive-game to its equivalent tensor game, "
         "which is exponentially larger. Use only with small games.");
 
+  m.def("create_lazy_tensor_game",
+        &open_spiel::tensor_game::CreateLazyTensorGame, py::arg("short_name"),
+        py::arg("long_name"), py::arg("action_names"), py::arg("oracle"),
+        py::arg("min_utility"), py::arg("max_utility"),
+        py::arg("num_oracle_samples") = 1,
+        py::arg("utility") = GameType::Utility::kGeneralSum,
+        "Creates a tensor game whose utilities are sampled from a payoff "
+        "oracle, a function of the joint action, when first needed.");
+
+  m.def("projected_replicator_dynamics",
+        py::overload_cast<const MatrixGame&, int, double, double, int,
+                          const open_spiel::algorithms::MixedStrategies&>(
+            &open_spiel::algorithms::ProjectedReplicatorDynamics),
+        py::arg("game"), py::arg("num_iterations") = 100000,
+        py::arg("dt") = 1e-3, py::arg("gamma") = 1e-6,
+        py::arg("average_over_last_n") = 0,
+        py::arg("initial_strategies") =
+            open_spiel::algorithms::MixedStrategies(),
+        "Runs projected replicator dynamics on a matrix game.");
+  m.def("projected_replicator_dynamics",
+        py::overload_cast<const TensorGame&, int, double, double, int,
+                          const open_spiel::algorithms::MixedStrategies&>(
+            &open_spiel::algorithms::ProjectedReplicatorDynamics),
+        py::arg("game"), py::arg("num_iterations") = 100000,
+        py::arg("dt") = 1e-3, py::arg("gamma") = 1e-6,
+        py::arg("average_over_last_n") = 0,
+        py::arg("initial_strategies") =
+            open_spiel::algorithms::MixedStrategies(),
+        "Runs projected replicator dynamics on a tensor game.");
+  m.def("regret_matching",
+        py::overload_cast<const MatrixGame&, int,
+                          const open_spiel::algorithms::MixedStrategies&>(
+            &open_spiel::algorithms::RegretMatching),
+        py::arg("game"), py::arg("num_iterations"),
+        py::arg("initial_strategies") =
+            open_spiel::algorithms::MixedStrategies(),
+        "Returns the average strategies of regret matching on a matrix game.");
+  m.def("regret_matching",
+        py::overload_cast<const TensorGame&, int,
+                          const open_spiel::algorithms::MixedStrategies&>(
+            &open_spiel::algorithms::RegretMatching),
+        py::arg("game"), py::arg("num_iterations"),
+        py::arg("initial_strategies") =
+            open_spiel::algorithms::MixedStrategies(),
+        "Returns the average strategies of regret matching on a tensor game.");
+  m.def("fictitious_play",
+        py::overload_cast<const MatrixGame&, int>(
+            &open_spiel::algorithms::FictitiousPlay),
+        py::arg("game"), py::arg("num_iterations"),
+        "Returns the average strategies of fictitious play on a matrix game.");
+  m.def("fictitious_play",
+        py::overload_cast<const TensorGame&, int>(
+            &open_spiel::algorithms::FictitiousPlay),
+        py::arg("game"), py::arg("num_iterations"),
+        "Returns the average strategies of fictitious play on a tensor game.");
+
+  py::enum_<open_spiel::algorithms::StationaryDistributionSolver>(
+      m, "StationaryDistributionSolver")
+      .value("POWER_ITERATION",
+             open_spiel::algorithms::StationaryDistributionSolver::
+                 kPowerIteration)
+      .value("GMRES",
+             open_spiel::algorithms::StationaryDistributionSolver::kGmres)
+      .export_values();
+
+  py::class_<open_spiel::algorithms::AlphaRankOptions>(m, "AlphaRankOptions")
+      .def(py::init<>())
+      .def_readwrite("alpha", &open_spiel::algorithms::AlphaRankOptions::alpha)
+      .def_readwrite("population_size",
+                     &open_spiel::algorithms::AlphaRankOptions::population_size)
+      .def_readwrite("use_inf_alpha",
+                     &open_spiel::algorithms::AlphaRankOptions::use_inf_alpha)
+      .def_readwrite("inf_alpha_eps",
+                     &open_spiel::algorithms::AlphaRankOptions::inf_alpha_eps)
+      .def_readwrite(
+          "use_local_selection_model",
+          &open_spiel::algorithms::AlphaRankOptions::use_local_selection_model)
+      .def_readwrite("solver",
+                     &open_spiel::algorithms::AlphaRankOptions::solver)
+      .def_readwrite("tolerance",
+                     &open_spiel::algorithms::AlphaRankOptions::tolerance)
+      .def_readwrite("max_iterations",
+                     &open_spiel::algorithms::AlphaRankOptions::max_iterations)
+      .def_readwrite("gmres_restart",
+                     &open_spiel::algorithms::AlphaRankOptions::gmres_restart)
+      .def_readwrite("num_threads",
+                     &open_spiel::algorithms::AlphaRankOptions::num_threads);
+
+  py::class_<open_spiel::algorithms::AlphaRankResult>(m, "AlphaRankResult")
+      .def_readonly("num_strategies",
+                    &open_spiel::algorithms::AlphaRankResult::num_strategies)
+      .def_readonly("pi", &open_spiel::algorithms::AlphaRankResult::pi)
+      .def_readonly("marginals",
+                    &open_spiel::algorithms::AlphaRankResult::marginals)
+      .def_readonly("num_iterations",
+                    &open_spiel::algorithms::AlphaRankResult::num_iterations)
+      .def_readonly("residual",
+                    &open_spiel::algorithms::AlphaRankResult::residual);
+
+  // The solvers release the GIL, as they can run for long on many threads.
+  m.def("alpha_rank",
+        py::overload_cast<const MatrixGame&,
+                          const open_spiel::algorithms::AlphaRankOptions&>(
+            &open_spiel::algorithms::AlphaRank),
+        py::arg("game"),
+        py::arg("options") = open_spiel::algorithms::AlphaRankOptions(),
+        py::call_guard<py::gil_scoped_release>(),
+        "Ranks the joint actions of a matrix game with alpha-rank, with a "
+        "population per player.");
+  m.def("alpha_rank",
+        py::overload_cast<const TensorGame&,
+                          const open_spiel::algorithms::AlphaRankOptions&>(
+            &open_spiel::algorithms::AlphaRank),
+        py::arg("game"),
+        py::arg("options") = open_spiel::algorithms::AlphaRankOptions(),
+        py::call_guard<py::gil_scoped_release>(),
+        "Ranks the joint actions of a tensor game with alpha-rank, with a "
+        "population per player.");
+  m.def("single_population_alpha_rank",
+        &open_spiel::algorithms::SinglePopulationAlphaRank, py::arg("game"),
+        py::arg("options") = open_spiel::algorithms::AlphaRankOptions(),
+        py::call_guard<py::gil_scoped_release>(),
+        "Ranks the strategies of a symmetric matrix game with alpha-rank, "
+        "with a single population using the row player's payoffs.");
+
   m.def("registered_names", GameRegisterer::RegisteredNames,
         "Returns the names of all available games.");
 
@@ -690,6 +1489,7 @@ PYBIND11_MODULE(pyspiel, m) {
 
   m.def("exploitability",
         py::overload_cast<const Game&, const Policy&>(&Exploitability),
+        py::call_guard<py::gil_scoped_release>(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -702,6 +1502,7 @@ PYBIND11_MODULE(pyspiel, m) {
       py::overload_cast<
           const Game&, const std::unordered_map<std::string, ActionsAndProbs>&>(
           &Exploitability),
+      py::call_guard<py::gil_scoped_release>(),
       "Returns the sum of the utility that a best responder wins when when "
       "playing against 1) the player 0 policy contained in `policy` and 2) "
       "the player 1 policy contained in `policy`."
@@ -710,6 +1511,7 @@ PYBIND11_MODULE(pyspiel, m) {
       "to it.");
 
   m.def("nash_conv", py::overload_cast<const Game&, const Policy&>(&NashConv),
+        py::call_guard<py::gil_scoped_release>(),
         "Returns the sum of the utility that a best responder wins when when "
         "playing against 1) the player 0 policy contained in `policy` and 2) "
         "the player 1 policy contained in `policy`."
@@ -722,6 +1524,7 @@ PYBIND11_MODULE(pyspiel, m) {
       py::overload_cast<
           const Game&, const std::unordered_map<std::string, ActionsAndProbs>&>(
           &NashConv),
+      py::call_guard<py::gil_scoped_release>(),
       "Calculates a measure of how far the given policy is from a Nash "
       "equilibrium by returning the sum of the improvements in the value "
       "that each player could obtain by unilaterally changing their strategy "
@@ -737,6 +1540,13 @@ PYBIND11_MODULE(pyspiel, m) {
         "Computes the undiscounted expected returns from a depth-limited "
         "search.");
 
+  m.def("aggregate_policies", &open_spiel::algorithms::AggregatePolicies,
+        py::arg("game"), py::arg("policies"), py::arg("weights"),
+        py::arg("num_threads") = 1,
+        py::call_guard<py::gil_scoped_release>(),
+        "Returns the behaviour policy equivalent to each player's mixture of "
+        "policies.");
+
   py::class_<open_spiel::algorithms::BatchedTrajectory>(m, "BatchedTrajectory")
       .def(py::init<int>())
       .def_readwrite("observations",
@@ -773,6 +1583,94 @@ PYBIND11_MODULE(pyspiel, m) {
             &open_spiel::algorithms::RecordBatchedTrajectory),
         "Records a batch of trajectories.");
 
+  py::class_<open_spiel::algorithms::ContiguousBatchedTrajectory>(
+      m, "ContiguousBatchedTrajectory")
+      .def_readonly(
+          "batch_size",
+          &open_spiel::algorithms::ContiguousBatchedTrajectory::batch_size)
+      .def_readonly("max_trajectory_length",
+                    &open_spiel::algorithms::ContiguousBatchedTrajectory::
+                        max_trajectory_length)
+      .def_property_readonly(
+          "observations",
+          [](py::object self) -> py::object {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            // None when the state indices were recorded instead.
+            if (t.observation_size == 0) return py::none();
+            return TrajectoryField(t, t.observations, t.observation_size,
+                                   self);
+          })
+      .def_property_readonly(
+          "state_indices",
+          [](py::object self) -> py::object {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            // None when the observations were recorded instead.
+            if (t.observation_size > 0) return py::none();
+            return TrajectoryField(t, t.state_indices, 0, self);
+          })
+      .def_property_readonly(
+          "legal_actions",
+          [](py::object self) {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            return TrajectoryField(t, t.legal_actions, t.num_distinct_actions,
+                                   self);
+          })
+      .def_property_readonly(
+          "actions",
+          [](py::object self) {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            return TrajectoryField(t, t.actions, 0, self);
+          })
+      .def_property_readonly(
+          "player_policies",
+          [](py::object self) {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            return TrajectoryField(t, t.player_policies,
+                                   t.num_distinct_actions, self);
+          })
+      .def_property_readonly(
+          "player_ids",
+          [](py::object self) {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            return TrajectoryField(t, t.player_ids, 0, self);
+          })
+      .def_property_readonly(
+          "rewards",
+          [](py::object self) {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            const int64_t row_stride = t.num_players * sizeof(float);
+            return py::array_t<float>(
+                std::vector<int64_t>{t.batch_size, t.num_players},
+                std::vector<int64_t>{row_stride, sizeof(float)},
+                t.rewards.data(), self);
+          })
+      .def_property_readonly(
+          "valid",
+          [](py::object self) {
+            const auto& t = self.cast<const ContiguousTrajectory&>();
+            return TrajectoryField(t, t.valid, 0, self);
+          })
+      .def_property_readonly("next_is_terminal", [](py::object self) {
+        const auto& t = self.cast<const ContiguousTrajectory&>();
+        return TrajectoryField(t, t.next_is_terminal, 0, self);
+      });
+
+  m.def("record_contiguous_batched_trajectories",
+        py::overload_cast<
+            const Game&, const std::vector<open_spiel::TabularPolicy>&,
+            const std::unordered_map<std::string, int>&, int, bool, int, int>(
+            &open_spiel::algorithms::RecordContiguousBatchedTrajectory),
+        "Records a batch of trajectories into contiguous numpy arrays.");
+
+  m.def("record_parallel_batched_trajectories",
+        py::overload_cast<
+            const Game&, const std::vector<open_spiel::TabularPolicy>&,
+            const std::unordered_map<std::string, int>&, int, bool, int, int,
+            int>(&open_spiel::algorithms::RecordParallelBatchedTrajectory),
+        py::call_guard<py::gil_scoped_release>(),
+        "Records a batch of trajectories with several threads, "
+        "deterministically for a seed.");
+
   // Game-Specific Query API.
   m.def("negotiation_item_pool", &open_spiel::query::NegotiationItemPool);
   m.def("negotiation_agent_utils", &open_spiel::query::NegotiationAgentUtils);
@@ -147,6 +147,7 @@ class Environment(object):
                discount=1.0,
                chance_event_sampler=None,
                observation_type=None,
+               use_numpy_observations=False,
                **kwargs):
     """Constructor.
 
@@ -157,6 +158,8 @@ class Environment(object):
         to sample chance events.
       observation_type: what kind of observation to use. If not specified, will
         default to INFORMATION_STATE unless the game doesn't provide it.
+      use_numpy_observations: whether the "info_state" observations are float32
+        numpy arrays rather than lists, which is much cheaper for large tensors.
       **kwargs: dict, additional settings passed to the Open Spiel game.
     """
     self._chance_event_sampler = chance_event_sampler or ChanceEventSampler()
@@ -196,6 +199,17 @@ class Environment(object):
       if not self._game.get_type().provides_information_state_tensor:
         raise ValueError("information_state_tensor not supported by " + game)
     self._use_observation = (observation_type == ObservationType.OBSERVATION)
+    self._use_numpy_observations = use_numpy_observations
+
+  def _info_state(self, player_id):
+    """Returns the tensor observed by the player, as configured."""
+    if self._use_numpy_observations:
+      if self._use_observation:
+        return self._state.observation_tensor_array(player_id)
+      return self._state.information_state_tensor_array(player_id)
+    if self._use_observation:
+      return self._state.observation_tensor(player_id)
+    return self._state.information_state_tensor(player_id)
 
   def get_time_step(self):
     """Returns a `TimeStep` without updating the environment.
@@ -218,9 +232,7 @@ class Environment(object):
     cur_rewards = self._state.rewards()
     for player_id in range(self.num_players):
       rewards.append(cur_rewards[player_id])
-      observations["info_state"].append(
-          self._state.observation_tensor(player_id) if self._use_observation
-          else self._state.information_state_tensor(player_id))
+      observations["info_state"].append(self._info_state(player_id))
 
       observations["legal_actions"].append(self._state.legal_actions(player_id))
     observations["current_player"] = self._state.current_player()
@@ -289,9 +301,7 @@ class Environment(object):
 
     observations = {"info_state": [], "legal_actions": [], "current_player": []}
     for player_id in range(self.num_players):
-      observations["info_state"].append(
-          self._state.observation_tensor(player_id) if self._use_observation
-          else self._state.information_state_tensor(player_id))
+      observations["info_state"].append(self._info_state(player_id))
       observations["legal_actions"].append(self._state.legal_actions(player_id))
     observations["current_player"] = self._state.current_player()
 
@@ -19,7 +19,11 @@ from __future__ import division
 from __future__ import print_function
 
 import os
+import pickle
+import threading
+
 from absl.testing import absltest
+import numpy as np
 import six
 
 from open_spiel.python import policy
@@ -159,6 +163,64 @@ class PyspielTest(absltest.TestCase):
     self.assertFalse(state.is_terminal())
     self.assertEqual(state.legal_actions(), [0, 1, 2, 3, 4, 5, 6, 7, 8])
 
+  def test_write_tensors_into_batch(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    state = game.new_initial_state()
+    state.apply_action(4)
+    batch = np.zeros((2, game.observation_tensor_size()), dtype=np.float32)
+    state.write_observation_tensor(0, batch[1])
+    np.testing.assert_array_equal(batch[0], 0)
+    np.testing.assert_array_equal(batch[1], state.observation_tensor(0))
+    with self.assertRaises(TypeError):
+      state.write_observation_tensor(0, np.zeros(batch.shape[1]))
+
+  def test_tensor_arrays(self):
+    game = pyspiel.load_game("kuhn_poker")
+    state = game.new_initial_state()
+    state.apply_action(0)
+    state.apply_action(1)
+    for player in range(2):
+      info_state = state.information_state_tensor_array(player)
+      self.assertEqual(info_state.dtype, np.float32)
+      np.testing.assert_array_equal(info_state,
+                                    state.information_state_tensor(player))
+      np.testing.assert_array_equal(state.observation_tensor_array(player),
+                                    state.observation_tensor(player))
+    np.testing.assert_array_equal(state.observation_tensor_array(),
+                                  state.observation_tensor())
+
+  def test_legal_actions_masks(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    state = game.new_initial_state()
+    state.apply_action(4)
+    mask = np.zeros(game.num_distinct_actions(), dtype=np.float32)
+    state.write_legal_actions_mask(1, mask)
+    np.testing.assert_array_equal(mask, state.legal_actions_mask(1))
+    self.assertEqual(state.legal_actions_bitmask(1), [0b111101111])
+
+  def test_sparse_information_state_tensor(self):
+    game = pyspiel.load_game("kuhn_poker")
+    self.assertTrue(game.information_state_tensor_is_sparse())
+    state = game.new_initial_state()
+    state.apply_action(2)
+    state.apply_action(0)
+    indices, values = state.sparse_information_state_tensor(0)
+    dense = np.zeros(game.information_state_tensor_size())
+    dense[indices] = values
+    np.testing.assert_array_equal(dense, state.information_state_tensor(0))
+
+  def test_vector_env(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    env = pyspiel.VectorEnv(game, num_envs=3, seed=0)
+    self.assertEqual(env.observations().shape,
+                     (3, game.observation_tensor_size()))
+    np.testing.assert_array_equal(env.legal_actions_masks(), 1)
+    env.step([0, 4, 8])
+    np.testing.assert_array_equal(env.current_players(), [1, 1, 1])
+    np.testing.assert_array_equal(env.dones(), [0, 0, 0])
+    self.assertEqual(env.legal_actions_masks()[1, 4], 0)
+    self.assertEqual(env.state(2).history(), [8])
+
   def test_game_parameter_representation(self):
     param = pyspiel.GameParameter(True)
     self.assertEqual(repr(param), "GameParameter(bool_value=True)")
@@ -203,6 +265,20 @@ class PyspielTest(absltest.TestCase):
       # We just test that we can create a tabular policy.
       policy.python_policy_to_pyspiel_policy(policy.TabularPolicy(game))
 
+  def test_array_policy_reads_python_policy_in_place(self):
+    game = pyspiel.load_game("kuhn_poker")
+    python_policy = policy.TabularPolicy(game)
+    array_policy = policy.python_policy_to_pyspiel_array_policy(python_policy)
+    # Updated in place, as by a training step.
+    probs = python_policy.action_probability_array
+    mask = python_policy.legal_actions_mask
+    probs[:] = mask * np.random.RandomState(7).uniform(size=mask.shape)
+    probs /= np.sum(probs, axis=-1, keepdims=True)
+    self.assertAlmostEqual(
+        pyspiel.exploitability(game, array_policy),
+        pyspiel.exploitability(
+            game, policy.python_policy_to_pyspiel_policy(python_policy)))
+
   def test_simultaneous_game_history(self):
     game = pyspiel.load_game("coop_box_pushing")
     state = game.new_initial_state()
@@ -227,6 +303,141 @@ class PyspielTest(absltest.TestCase):
                                           batch_size, include_full_observations,
                                           seed, -1)
 
+  def test_contiguous_batched_trajectories_fields(self):
+    game = pyspiel.load_game("kuhn_poker")
+    python_policy = policy.TabularPolicy(game)
+    policies = [policy.python_policy_to_pyspiel_policy(python_policy)] * 2
+    batch_size = 8
+    for include_full_observations in [False, True]:
+      trajectory = pyspiel.record_contiguous_batched_trajectories(
+          game, policies,
+          {} if include_full_observations else python_policy.state_lookup,
+          batch_size, include_full_observations, 0, -1)
+      length = trajectory.max_trajectory_length
+      self.assertEqual(trajectory.actions.shape, (batch_size, length))
+      # Only one of the observations and the state indices is recorded.
+      if include_full_observations:
+        self.assertIsNone(trajectory.state_indices)
+        self.assertEqual(
+            trajectory.observations.shape,
+            (batch_size, length, game.information_state_tensor_size()))
+      else:
+        self.assertIsNone(trajectory.observations)
+        self.assertEqual(trajectory.state_indices.shape, (batch_size, length))
+
+
+  def test_pickle_states(self):
+    game = pyspiel.load_game("kuhn_poker")
+    states = [game.new_initial_state() for _ in range(3)]
+    for i, state in enumerate(states):
+      state.apply_action(i)
+    unpickled = pickle.loads(pickle.dumps(states))
+    for state, unpickled_state in zip(states, unpickled):
+      self.assertEqual(state.history(), unpickled_state.history())
+      self.assertEqual(str(state), str(unpickled_state))
+    self.assertEqual(str(unpickled[0].get_game()), str(game))
+    # Separately pickled states still share their game once unpickled.
+    first = pickle.loads(pickle.dumps(states[0]))
+    second = pickle.loads(pickle.dumps(states[1]))
+    self.assertEqual(str(first.get_game()), str(second.get_game()))
+    # States pickled in the old text format can still be unpickled.
+    old_state = states[2].__new__(type(states[2]))
+    old_state.__setstate__(
+        pyspiel.serialize_game_and_state(game, states[2]))
+    self.assertEqual(old_state.history(), states[2].history())
+
+  def test_python_evaluator_in_threads(self):
+
+    class UniformEvaluator(pyspiel.Evaluator):
+
+      def evaluate(self, state):
+        del state
+        return [0.0, 0.0]
+
+      def prior(self, state):
+        actions = state.legal_actions()
+        return [(action, 1.0 / len(actions)) for action in actions]
+
+    game = pyspiel.load_game("tic_tac_toe")
+    actions = [None] * 4
+
+    def search(i):
+      bot = pyspiel.MCTSBot(game, UniformEvaluator(), 2.0, 50, 10, False, i,
+                            False)
+      actions[i] = bot.step(game.new_initial_state())
+
+    threads = [threading.Thread(target=search, args=(i,)) for i in range(4)]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    for action in actions:
+      self.assertIn(action, range(9))
+
+  def test_mcts_with_python_model(self):
+    game = pyspiel.load_game("tic_tac_toe")
+    batch_sizes = []
+
+    def uniform_model(inputs, legal_masks):
+      batch_sizes.append(inputs.shape[0])
+      self.assertEqual(inputs.shape[1], pyspiel.inference_input_size(game))
+      policies = legal_masks / legal_masks.sum(axis=1, keepdims=True)
+      return policies, np.zeros(inputs.shape[0], dtype=np.float32)
+
+    model = pyspiel.PyInferenceModel(pyspiel.inference_input_size(game),
+                                     game.num_distinct_actions(),
+                                     uniform_model)
+    bot = pyspiel.MCTSBot(
+        game, pyspiel.InferenceEvaluator(model), uct_c=2.0,
+        max_simulations=64, max_memory_mb=10, solve=False, seed=0,
+        verbose=False, batch_size=8)
+    self.assertIn(bot.step(game.new_initial_state()), range(9))
+    self.assertGreater(max(batch_sizes), 1)
+
+  def test_deep_cfr_sampler_with_python_model(self):
+    game = pyspiel.load_game("kuhn_poker")
+    input_size = pyspiel.inference_input_size(game)
+    num_actions = game.num_distinct_actions()
+
+    def advantage_model(inputs, legal_masks):
+      # Always prefer the first action.
+      advantages = np.zeros_like(legal_masks)
+      advantages[:, 0] = 1
+      return advantages, np.zeros(inputs.shape[0], dtype=np.float32)
+
+    sampler = pyspiel.DeepCFRSampler(game, advantage_capacity=1000,
+                                     strategy_capacity=1000, seed=0)
+    model = pyspiel.PyInferenceModel(input_size, num_actions, advantage_model)
+    sampler.set_advantage_model(1, model)
+    sampler.traverse(player=0, iteration=1, num_traversals=20, num_threads=2)
+    self.assertEqual(sampler.num_traversals(), 20)
+
+    info_states, iterations, targets = (
+        sampler.advantage_reservoir(0).contents())
+    self.assertEqual(info_states.dtype, np.float32)
+    self.assertEqual(info_states.shape, (len(iterations), input_size))
+    self.assertEqual(targets.shape, (len(iterations), num_actions))
+    np.testing.assert_array_equal(iterations, 1)
+    # The strategy samples are those of player 1, who always passes.
+    _, _, strategies = sampler.strategy_reservoir().sample(num=10, seed=0)
+    np.testing.assert_array_equal(strategies, [[1, 0]] * 10)
+
+  def test_cfr_in_threads(self):
+    game = pyspiel.load_game("kuhn_poker")
+    solvers = [pyspiel.CFRSolver(game) for _ in range(2)]
+
+    def solve(solver):
+      for _ in range(10):
+        solver.evaluate_and_update_policy()
+
+    threads = [threading.Thread(target=solve, args=(s,)) for s in solvers]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    self.assertAlmostEqual(
+        pyspiel.exploitability(game, solvers[0].average_policy()),
+        pyspiel.exploitability(game, solvers[1].average_policy()))
 
 if __name__ == "__main__":
   absltest.main()
@@ -19,6 +19,7 @@ from __future__ import division
 from __future__ import print_function
 
 from absl.testing import absltest
+import numpy as np
 
 from open_spiel.python import rl_environment
 import pyspiel
@@ -52,6 +53,45 @@ class RLEnvironmentTest(absltest.TestCase):
     self.assertEqual(time_step.discounts, None)
     self.assertEqual(time_step.step_type.first(), True)
 
+  def test_numpy_observations(self):
+    env = rl_environment.Environment("tic_tac_toe")
+    numpy_env = rl_environment.Environment(
+        "tic_tac_toe", use_numpy_observations=True)
+    for e in (env, numpy_env):
+      e.reset()
+    time_step = env.step([4])
+    numpy_time_step = numpy_env.step([4])
+    for player in range(2):
+      info_state = numpy_time_step.observations["info_state"][player]
+      self.assertEqual(info_state.dtype, np.float32)
+      np.testing.assert_array_equal(
+          info_state, time_step.observations["info_state"][player])
+
+  def test_batched_cpp_environment(self):
+    game = pyspiel.load_game("kuhn_poker")
+    env = pyspiel.RLEnvironment(game, num_envs=4, seed=1)
+    time_step = env.reset()
+    self.assertEqual(time_step["info_state"].shape,
+                     (4, 2, game.information_state_tensor_size()))
+    self.assertEqual(time_step["legal_actions_mask"].shape,
+                     (4, 2, game.num_distinct_actions()))
+    np.testing.assert_array_equal(time_step["step_type"],
+                                  rl_environment.StepType.FIRST.value)
+    np.testing.assert_array_equal(time_step["current_player"], 0)
+    for i in range(4):
+      np.testing.assert_array_equal(
+          time_step["info_state"][i, 1],
+          env.state(i).information_state_tensor(1))
+    # Pass, pass ends every episode.
+    env.step([0] * 4)
+    time_step = env.step([0] * 4)
+    np.testing.assert_array_equal(time_step["step_type"],
+                                  rl_environment.StepType.LAST.value)
+    np.testing.assert_array_equal(time_step["rewards"].sum(axis=1), 0)
+    time_step = env.step([0] * 4)
+    np.testing.assert_array_equal(time_step["step_type"],
+                                  rl_environment.StepType.FIRST.value)
+
   def test_initial_info_state_is_decision_node(self):
     env = rl_environment.Environment("kuhn_poker")
     time_step = env.reset()
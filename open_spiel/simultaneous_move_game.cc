@@ -24,12 +24,26 @@
 
 namespace open_spiel {
 
+const std::vector<std::vector<Action>>& SimMoveState::PlayerLegalActions()
+    const {
+  if (!legal_actions_cached_) {
+    legal_actions_cache_.resize(num_players_);
+    for (Player player = 0; player < num_players_; ++player) {
+      legal_actions_cache_[player] = LegalActions(player);
+    }
+    legal_actions_cached_ = legal_actions_cache_enabled_;
+  }
+  return legal_actions_cache_;
+}
+
 std::vector<Action> SimMoveState::FlatJointActionToActions(
     Action flat_action) const {
+  const std::vector<std::vector<Action>>& player_legal_actions =
+      PlayerLegalActions();
   std::vector<Action> actions(num_players_, kInvalidAction);
   for (Player player = 0; player < num_players_; ++player) {
     // For each player with legal actions available:
-    const auto legal_actions = LegalActions(player);
+    const std::vector<Action>& legal_actions = player_legal_actions[player];
     int num_actions = legal_actions.size();
     if (num_actions > 0) {
       // Extract the least-significant digit (radix = the number legal actions
@@ -51,8 +65,8 @@ std::vector<Action> SimMoveState::LegalFlatJointActions() const {
   // Compute the number of possible joint actions = \prod #actions(i)
   // over all players with any legal actions available.
   int number_joint_actions = 1;
-  for (auto player = Player{0}; player < num_players_; ++player) {
-    int num_actions = LegalActions(player).size();
+  for (const std::vector<Action>& legal_actions : PlayerLegalActions()) {
+    int num_actions = legal_actions.size();
     if (num_actions > 1) number_joint_actions *= num_actions;
   }
   // The possible joint actions are just numbered 0, 1, 2, ....
@@ -66,10 +80,12 @@ std::string SimMoveState::FlatJointActionToString(Action flat_action) const {
   // Assembles the string for each individual player action into a single
   // string. For example, [Heads, Tails] would mean than player 0 chooses Heads,
   // and player 1 chooses Tails.
+  const std::vector<std::vector<Action>>& player_legal_actions =
+      PlayerLegalActions();
   std::string str;
   for (auto player = Player{0}; player < num_players_; ++player) {
     if (!str.empty()) str.append(", ");
-    const auto legal_actions = LegalActions(player);
+    const std::vector<Action>& legal_actions = player_legal_actions[player];
     int num_actions = legal_actions.size();
     str.append(
         ActionToString(player, legal_actions[flat_action % num_actions]));
@@ -108,6 +108,23 @@ class SimMoveState : public State {
   void ApplyFlatJointAction(Action flat_action);
 
   void DoApplyActions(const std::vector<Action>& actions) override = 0;
+
+  // The functions above decode flat joint actions with the legal actions of
+  // every player, which they compute on each call. Games whose states are
+  // walked through many flat joint actions, as by CFR, can instead keep them
+  // for the current node by calling EnableLegalActionsCache() on
+  // construction, and must then call InvalidateLegalActionsCache() whenever
+  // the state changes, e.g. at the start of DoApplyAction(s).
+  void EnableLegalActionsCache() { legal_actions_cache_enabled_ = true; }
+  void InvalidateLegalActionsCache() { legal_actions_cached_ = false; }
+
+ private:
+  // The legal actions of each player at the current node.
+  const std::vector<std::vector<Action>>& PlayerLegalActions() const;
+
+  bool legal_actions_cache_enabled_ = false;
+  mutable bool legal_actions_cached_ = false;
+  mutable std::vector<std::vector<Action>> legal_actions_cache_;
 };
 
 class SimMoveGame : public Game {
@@ -15,6 +15,7 @@
 #include "open_spiel/spiel.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -24,11 +25,16 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/state_arena.h"
 
 namespace open_spiel {
 namespace {
@@ -37,6 +43,37 @@ constexpr const int kSerializationVersion = 1;
 constexpr const char* kSerializeMetaSectionHeader = "[Meta]";
 constexpr const char* kSerializeGameSectionHeader = "[Game]";
 constexpr const char* kSerializeStateSectionHeader = "[State]";
+constexpr const int kBinarySerializationVersion = 1;
+
+// Helpers for the binary state serialization: unsigned LEB128 varints, with
+// signed values zigzag-encoded so that small negative actions stay short.
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+uint64_t ReadVarint(absl::string_view data, int* pos) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    SPIEL_CHECK_LT(*pos, data.size());
+    const uint8_t byte = static_cast<uint8_t>(data[(*pos)++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+  }
+  SpielFatalError("Malformed varint in binary serialized state.");
+}
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
 
 // Returns the available parameter keys, to be used as a utility function.
 std::string ListValidParameters(
@@ -79,6 +116,13 @@ void ValidateParams(const GameParameters& params,
   }
 }
 
+void DenseToSparse(const std::vector<double>& dense, SparseTensor* tensor) {
+  tensor->Clear();
+  for (int i = 0; i < dense.size(); ++i) {
+    if (dense[i] != 0) tensor->Add(i, dense[i]);
+  }
+}
+
 }  // namespace
 
 std::ostream& operator<<(std::ostream& os, const StateType& type) {
@@ -203,6 +247,50 @@ std::shared_ptr<const Game> LoadGame(GameParameters params) {
   return result;
 }
 
+namespace {
+
+// The games loaded by LoadGameCached, keyed by their canonical parameters.
+// It is never destroyed, so that games can be loaded during static
+// destruction too.
+struct GameCache {
+  absl::Mutex mutex;
+  absl::flat_hash_map<std::string, std::shared_ptr<const Game>> games
+      ABSL_GUARDED_BY(mutex);
+};
+
+GameCache& GetGameCache() {
+  static GameCache* cache = new GameCache();
+  return *cache;
+}
+
+}  // namespace
+
+std::shared_ptr<const Game> LoadGameCached(const std::string& game_string) {
+  return LoadGameCached(GameParametersFromString(game_string));
+}
+
+std::shared_ptr<const Game> LoadGameCached(GameParameters params) {
+  const std::string key = GameParametersToString(params);
+  GameCache& cache = GetGameCache();
+  {
+    absl::MutexLock lock(&cache.mutex);
+    auto it = cache.games.find(key);
+    if (it != cache.games.end()) return it->second;
+  }
+  // The game is created without holding the lock, so that loading a slow
+  // game doesn't block the loads of the others. If two threads load the same
+  // game at once, the first one cached is returned to both.
+  std::shared_ptr<const Game> game = LoadGame(std::move(params));
+  absl::MutexLock lock(&cache.mutex);
+  return cache.games.emplace(key, std::move(game)).first->second;
+}
+
+void ClearGameCache() {
+  GameCache& cache = GetGameCache();
+  absl::MutexLock lock(&cache.mutex);
+  cache.games.clear();
+}
+
 State::State(std::shared_ptr<const Game> game)
     : num_distinct_actions_(game->NumDistinctActions()),
       num_players_(game->NumPlayers()),
@@ -372,6 +460,11 @@ std::pair<Action, double> SampleAction(const ActionsAndProbs& outcomes,
       absl::StrCat("Internal error: failed to sample an outcome; z=", z));
 }
 
+std::pair<Action, double> State::SampleChanceOutcome(
+    absl::BitGenRef rng) const {
+  return SampleAction(ChanceOutcomes(), rng);
+}
+
 std::string State::Serialize() const {
   // This simple serialization doesn't work for games with sampled chance
   // nodes, since the history doesn't give us enough information to reconstruct
@@ -382,6 +475,134 @@ std::string State::Serialize() const {
   return absl::StrCat(absl::StrJoin(History(), "\n"), "\n");
 }
 
+std::string State::SerializeBinary() const {
+  const std::string snapshot = BinarySnapshot();
+  // See State::Serialize: replaying the history is not enough to rebuild
+  // states of games with sampled chance nodes.
+  if (snapshot.empty()) {
+    SPIEL_CHECK_NE(game_->GetType().chance_mode,
+                   GameType::ChanceMode::kSampledStochastic);
+  }
+  std::string data;
+  data.reserve(2 * history_.size() + snapshot.size() + 8);
+  AppendVarint(kBinarySerializationVersion, &data);
+  AppendVarint(history_.size(), &data);
+  for (Action action : history_) AppendVarint(ZigZagEncode(action), &data);
+  AppendVarint(snapshot.size(), &data);
+  data.append(snapshot);
+  return data;
+}
+
+namespace {
+// The arena of a state, or nullptr, is stored in front of it, in a header
+// which keeps the state aligned.
+constexpr std::size_t kStateHeaderSize = alignof(std::max_align_t);
+static_assert(sizeof(StateArena*) <= kStateHeaderSize);
+}  // namespace
+
+void* State::operator new(std::size_t size) {
+  StateArena* arena = CurrentStateArena();
+  void* block = arena != nullptr ? arena->Allocate(size + kStateHeaderSize)
+                                 : ::operator new(size + kStateHeaderSize);
+  *static_cast<StateArena**>(block) = arena;
+  return static_cast<char*>(block) + kStateHeaderSize;
+}
+
+void State::operator delete(void* ptr) {
+  if (ptr == nullptr) return;
+  void* block = static_cast<char*>(ptr) - kStateHeaderSize;
+  StateArena* arena = *static_cast<StateArena**>(block);
+  if (arena != nullptr) {
+    arena->Release();
+  } else {
+    ::operator delete(block);
+  }
+}
+
+void State::Rewards(absl::Span<double> rewards) const {
+  SPIEL_CHECK_EQ(rewards.size(), num_players_);
+  if (game_->GetType().reward_model == GameType::RewardModel::kTerminal) {
+    if (IsTerminal()) {
+      Returns(rewards);
+    } else {
+      SPIEL_CHECK_FALSE(IsChanceNode());
+      std::fill(rewards.begin(), rewards.end(), 0.0);
+    }
+    return;
+  }
+  const std::vector<double> values = Rewards();
+  SPIEL_CHECK_EQ(values.size(), rewards.size());
+  std::copy(values.begin(), values.end(), rewards.begin());
+}
+
+void State::Returns(absl::Span<double> returns) const {
+  const std::vector<double> values = Returns();
+  SPIEL_CHECK_EQ(values.size(), returns.size());
+  std::copy(values.begin(), values.end(), returns.begin());
+}
+
+uint64_t State::Hash() const {
+  uint64_t hash = HashMix(history_.size());
+  for (Action action : history_) {
+    hash = HashMix(hash ^ static_cast<uint64_t>(action));
+  }
+  return hash;
+}
+
+void State::InformationStateTensor(Player player,
+                                   absl::Span<float> values) const {
+  std::vector<double> tensor;
+  InformationStateTensor(player, &tensor);
+  SPIEL_CHECK_EQ(values.size(), tensor.size());
+  std::copy(tensor.begin(), tensor.end(), values.begin());
+}
+
+void State::ObservationTensor(Player player, absl::Span<float> values) const {
+  std::vector<double> tensor;
+  ObservationTensor(player, &tensor);
+  SPIEL_CHECK_EQ(values.size(), tensor.size());
+  std::copy(tensor.begin(), tensor.end(), values.begin());
+}
+
+void SparseTensor::ToDense(absl::Span<float> dense) const {
+  std::fill(dense.begin(), dense.end(), 0.0f);
+  for (int i = 0; i < indices.size(); ++i) {
+    SPIEL_CHECK_LT(indices[i], dense.size());
+    dense[indices[i]] = values[i];
+  }
+}
+
+void State::SparseInformationStateTensor(Player player,
+                                         SparseTensor* tensor) const {
+  DenseToSparse(InformationStateTensor(player), tensor);
+}
+
+void State::SparseObservationTensor(Player player,
+                                    SparseTensor* tensor) const {
+  DenseToSparse(ObservationTensor(player), tensor);
+}
+
+void State::LegalActionsMask(Player player, absl::Span<float> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), num_distinct_actions_);
+  std::fill(mask.begin(), mask.end(), 0.0f);
+  for (Action action : LegalActions(player)) mask[action] = 1.0f;
+}
+
+std::vector<uint64_t> State::LegalActionsBitmask(Player player) const {
+  std::vector<uint64_t> mask((num_distinct_actions_ + 63) / 64);
+  LegalActionsBitmask(player, absl::MakeSpan(mask));
+  return mask;
+}
+
+void State::LegalActionsBitmask(Player player,
+                                absl::Span<uint64_t> mask) const {
+  SPIEL_CHECK_EQ(mask.size(), (num_distinct_actions_ + 63) / 64);
+  std::fill(mask.begin(), mask.end(), 0);
+  for (Action action : LegalActions(player)) {
+    mask[action / 64] |= uint64_t{1} << (action % 64);
+  }
+}
+
 Action State::StringToAction(Player player,
                              const std::string& action_str) const {
   for (const Action action : LegalActions()) {
@@ -423,6 +644,49 @@ std::unique_ptr<State> Game::DeserializeState(const std::string& str) const {
   return state;
 }
 
+std::unique_ptr<State> Game::DeserializeStateBinary(
+    absl::string_view data) const {
+  int pos = 0;
+  const uint64_t version = ReadVarint(data, &pos);
+  if (version != kBinarySerializationVersion) {
+    SpielFatalError(
+        absl::StrCat("Unsupported binary serialization version: ", version));
+  }
+  const uint64_t history_size = ReadVarint(data, &pos);
+  // Every action takes at least one byte.
+  SPIEL_CHECK_LE(history_size, data.size() - pos);
+  std::vector<Action> history;
+  history.reserve(history_size);
+  for (uint64_t i = 0; i < history_size; ++i) {
+    history.push_back(
+        static_cast<Action>(ZigZagDecode(ReadVarint(data, &pos))));
+  }
+  const uint64_t snapshot_size = ReadVarint(data, &pos);
+  SPIEL_CHECK_EQ(snapshot_size, data.size() - pos);
+
+  std::unique_ptr<State> state = NewInitialState();
+  if (snapshot_size > 0) {
+    state->RestoreBinarySnapshot(history, data.substr(pos));
+    return state;
+  }
+
+  SPIEL_CHECK_NE(game_type_.chance_mode,
+                 GameType::ChanceMode::kSampledStochastic);
+  std::vector<Action> joint_action;
+  for (int i = 0; i < history.size();) {
+    if (state->IsSimultaneousNode()) {
+      SPIEL_CHECK_LE(i + state->NumPlayers(), history.size());
+      joint_action.assign(history.begin() + i,
+                          history.begin() + i + state->NumPlayers());
+      i += state->NumPlayers();
+      state->ApplyActions(joint_action);
+    } else {
+      state->ApplyAction(history[i++]);
+    }
+  }
+  return state;
+}
+
 std::string SerializeGameAndState(const Game& game, const State& state) {
   std::string str = "";
 
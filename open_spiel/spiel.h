@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 #define THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -30,6 +31,9 @@
 
 #include "open_spiel/abseil-cpp/absl/random/bit_gen_ref.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/actions_and_probs.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -137,9 +141,6 @@ std::ostream& operator<<(std::ostream& stream, GameType::ChanceMode value);
 std::ostream& operator<<(std::ostream& stream, GameType::Information value);
 std::ostream& operator<<(std::ostream& stream, GameType::Utility value);
 
-// The probability of taking each possible action in a particular info state.
-using ActionsAndProbs = std::vector<std::pair<Action, double>>;
-
 // Layouts for 3-D tensors. For 2-D tensors, we assume that the layout is a
 // single spatial dimension and a channel dimension. If a 2-D tensor should be
 // interpreted as a 2-D space, report it as 3-D with a channel dimension of
@@ -149,6 +150,27 @@ enum class TensorLayout {
   kCHW,  // indexes are in the order (channels, height, width)
 };
 
+// A tensor given by its nonzero elements: their indices into the flat dense
+// tensor (as laid out by its shape and TensorLayout) and their values. For the
+// mostly one-hot tensors of many games, this is much smaller than the dense
+// tensor, and embedding-based networks can consume the indices directly.
+// Indices are unique, but in no particular order.
+struct SparseTensor {
+  std::vector<int> indices;
+  std::vector<float> values;
+
+  void Clear() {
+    indices.clear();
+    values.clear();
+  }
+  void Add(int index, float value = 1.0f) {
+    indices.push_back(index);
+    values.push_back(value);
+  }
+  // Writes the dense tensor into `dense`, which must be large enough.
+  void ToDense(absl::Span<float> dense) const;
+};
+
 // Forward declaration needed for the backpointer within State.
 class Game;
 
@@ -168,6 +190,16 @@ class State {
   State(std::shared_ptr<const Game> game);
   State(const State&) = default;
 
+  // States are allocated from the arena of the current thread's
+  // StateArenaScope, if any, or from the global heap. See state_arena.h.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr);
+  // The placement forms, hidden by the above.
+  static void* operator new(std::size_t size, void* ptr) noexcept {
+    return ptr;
+  }
+  static void operator delete(void* ptr, void* place) noexcept {}
+
   // Returns current player. Player numbers start from 0.
   // Negative numbers are for chance (-1) or simultaneous (-2).
   // kTerminalState should be returned on a TerminalNode().
@@ -222,6 +254,20 @@ class State {
   // is added.
   virtual std::vector<Action> LegalActions() const = 0;
 
+  // Same as `LegalActions()`, but writes the actions into a caller-owned
+  // vector, which is cleared first. Reusing the same vector across calls (e.g.
+  // one per thread in a rollout loop) avoids a heap allocation per call.
+  //
+  // The default implementation copies the result of `LegalActions()`, so it is
+  // correct for every game but not allocation-free. Games on hot paths should
+  // override this method and implement `LegalActions()` in terms of it.
+  // As above, a using directive is needed for this overload to be visible in
+  // derived classes which override `LegalActions()` only.
+  virtual void LegalActions(std::vector<Action>* actions) const {
+    std::vector<Action> legal_actions = LegalActions();
+    actions->assign(legal_actions.begin(), legal_actions.end());
+  }
+
   // Returns a vector of length `game.NumDistinctActions()` containing 1 for
   // legal actions and 0 for illegal actions.
   std::vector<int> LegalActionsMask(Player player) const {
@@ -239,6 +285,16 @@ class State {
     return LegalActionsMask(CurrentPlayer());
   }
 
+  // Writes the same mask as floats into `mask`, which must have size
+  // `game.NumDistinctActions()` (e.g. a row of a batch of policy head masks).
+  void LegalActionsMask(Player player, absl::Span<float> mask) const;
+
+  // Packed form of the mask, with action `a` legal if bit `a % 64` of word
+  // `a / 64` is set. The span version requires exactly
+  // `(game.NumDistinctActions() + 63) / 64` words.
+  std::vector<uint64_t> LegalActionsBitmask(Player player) const;
+  void LegalActionsBitmask(Player player, absl::Span<uint64_t> mask) const;
+
   // Returns a string representation of the specified action for the player.
   // The representation may depend on the current state of the game, e.g.
   // for chess the string "Nf3" would correspond to different starting squares
@@ -291,6 +347,20 @@ class State {
   // non-terminal states, and the terminal utility for the final state.
   virtual std::vector<double> Returns() const = 0;
 
+  // Same as `Rewards()` and `Returns()`, but write the values of the players
+  // into a caller-owned span of NumPlayers() doubles, so that a rollout loop
+  // can reuse a buffer rather than allocate a vector at every terminal.
+  //
+  // The default of Returns copies the result of `Returns()`, so it is correct
+  // for every game but not allocation-free. Games on hot paths should override
+  // it and implement `Returns()` in terms of it. The default of Rewards uses
+  // Returns for games with terminal rewards, and copies the result of
+  // `Rewards()` otherwise. As for LegalActions, a using directive is needed
+  // for these overloads to be visible in derived classes which override only
+  // the vector versions.
+  virtual void Rewards(absl::Span<double> rewards) const;
+  virtual void Returns(absl::Span<double> returns) const;
+
   // Returns Reward for one player (see above for definition). If Rewards for
   // multiple players are required it is more efficient to use Rewards() above.
   virtual double PlayerReward(Player player) const {
@@ -325,10 +395,24 @@ class State {
   // A string representation for the history. There should be a one to one
   // mapping between an history (i.e. a sequence of actions for all players,
   // including chance) and the `State` objects.
-  virtual std::vector<Action> History() const { return history_; }
+  // This returns a reference, so reading the history of long games does not
+  // copy it; take a copy if it must outlive the state or survive further
+  // actions.
+  virtual const std::vector<Action>& History() const { return history_; }
 
   std::string HistoryString() const { return absl::StrJoin(history_, " "); }
 
+  // Returns a 64-bit hash of the state, meant to key transposition tables and
+  // duplicate detection without building ToString(). Equal states have equal
+  // hashes; distinct states have distinct hashes with high probability.
+  //
+  // The default implementation hashes the history, so it never merges
+  // transpositions. Games should override it with a hash of the position
+  // (ideally maintained incrementally, e.g. Zobrist hashing), so that the same
+  // position reached by different move orders has the same hash. Values are
+  // deterministic, but not guaranteed to be stable across code versions.
+  virtual uint64_t Hash() const;
+
   // For imperfect information games. Returns an identifier for the current
   // information state for the specified player.
   // Different ground states can yield the same information state for a player
@@ -362,6 +446,25 @@ class State {
     return InformationStateString(CurrentPlayer());
   }
 
+  // Appends InformationStateString(player) to `str`, so that callers looking
+  // up many states by string can reuse one buffer instead of allocating a new
+  // string per state. Games may override this to append directly, and then
+  // implement InformationStateString with it; the default implementation
+  // appends the result of InformationStateString.
+  virtual void AppendInformationStateString(Player player,
+                                            std::string* str) const {
+    str->append(InformationStateString(player));
+  }
+
+  // Integer form of the information state, for tabular algorithms: a dense
+  // index in [0, Game::NumInformationStates()) such that two states have the
+  // same index if and only if they have the same InformationStateString (for
+  // any players). Only games for which Game::NumInformationStates() is
+  // positive need to implement this.
+  virtual int64_t InformationStateIndex(Player player) const {
+    SpielFatalError("InformationStateIndex is not implemented.");
+  }
+
   // Vector form, useful for neural-net function approximation approaches.
   // The size of the vector must match Game::InformationStateShape()
   // with values in lexicographic order. E.g. for 2x4x3, order would be:
@@ -384,6 +487,22 @@ class State {
     return InformationStateTensor(CurrentPlayer());
   }
 
+  // Writes the information state tensor as float32 into `values`, which must
+  // have exactly Game::InformationStateTensorSize() elements, e.g. one row of
+  // a caller-owned [batch_size, tensor_size] buffer. Games may override this to
+  // write directly into the span; the default implementation converts the
+  // result of the std::vector<double> version above.
+  virtual void InformationStateTensor(Player player,
+                                      absl::Span<float> values) const;
+
+  // Writes the nonzero elements of the information state tensor into
+  // `tensor`, replacing its contents. Games whose
+  // Game::InformationStateTensorIsSparse() is true override this to encode
+  // them directly; the default implementation extracts them from the dense
+  // tensor, so is no faster.
+  virtual void SparseInformationStateTensor(Player player,
+                                            SparseTensor* tensor) const;
+
   // We have functions for observations which are parallel to those for
   // information states. An observation should have the following properties:
   //  - It has at most the same information content as the information state
@@ -403,6 +522,12 @@ class State {
     return ObservationString(CurrentPlayer());
   }
 
+  // Appends ObservationString(player) to `str`, as for
+  // AppendInformationStateString.
+  virtual void AppendObservationString(Player player, std::string* str) const {
+    str->append(ObservationString(player));
+  }
+
   // Returns the view of the game, preferably from `player`'s perspective.
   virtual void ObservationTensor(Player player,
                                  std::vector<double>* values) const {
@@ -424,9 +549,31 @@ class State {
     return ObservationTensor(CurrentPlayer());
   }
 
+  // Writes the observation tensor as float32 into `values`, which must have
+  // exactly Game::ObservationTensorSize() elements. See the float32 version of
+  // InformationStateTensor above.
+  virtual void ObservationTensor(Player player, absl::Span<float> values) const;
+
+  // As SparseInformationStateTensor, for the observation tensor.
+  virtual void SparseObservationTensor(Player player,
+                                       SparseTensor* tensor) const;
+
   // Return a copy of this state.
   virtual std::unique_ptr<State> Clone() const = 0;
 
+  // Overwrites this state in place with a copy of `other`, which must have
+  // been created by the same game object. Unlike Clone(), this does not
+  // allocate a new State and reuses this state's buffers (e.g. the history),
+  // so search algorithms can recycle a fixed set of states.
+  //
+  // Returns false, leaving this state unchanged, if the game does not support
+  // in-place copies; callers should then fall back to Clone(). Games whose
+  // states are copy-assignable can implement it as:
+  //   SPIEL_CHECK_EQ(other.GetGame(), game_);
+  //   *this = static_cast<const MyGameState&>(other);
+  //   return true;
+  virtual bool CopyFrom(const State& other) { return false; }
+
   // Creates the child from State corresponding to action.
   std::unique_ptr<State> Child(Action action) const {
     std::unique_ptr<State> child = Clone();
@@ -442,6 +589,19 @@ class State {
     SpielFatalError("UndoAction function is not overridden; not undoing.");
   }
 
+  // Whether UndoAction is implemented, so that algorithms walking the game
+  // tree can apply and undo actions on a single state instead of cloning one
+  // per node.
+  virtual bool SupportsUndoAction() const { return false; }
+
+  // Undoes the last joint action of a simultaneous node, which must be
+  // supplied as it was given to ApplyActions. Like UndoAction, it is
+  // implemented when SupportsUndoAction() is true, and implementations must
+  // remove the actions from history_.
+  virtual void UndoActions(const std::vector<Action>& actions) {
+    SpielFatalError("UndoActions function is not overridden; not undoing.");
+  }
+
   // Change the state of the game by applying the specified actions, one per
   // player, for simultaneous action games. This function encodes the logic of
   // the game rules. Element i of the vector is the action for player i.
@@ -482,6 +642,24 @@ class State {
     SpielFatalError("ChanceOutcomes unimplemented!");
   }
 
+  // Same as `ChanceOutcomes()`, but writes the outcomes into a caller-owned
+  // ActionsAndProbsSoA (see actions_and_probs.h), whose storage is reused
+  // across calls. The default converts the result of `ChanceOutcomes()`;
+  // games can override it to fill the arrays directly. As for Returns, a
+  // using directive is needed for this overload to be visible in derived
+  // classes which override only `ChanceOutcomes()`.
+  virtual void ChanceOutcomes(ActionsAndProbsSoA* outcomes) const {
+    outcomes->Assign(ChanceOutcomes());
+  }
+
+  // Samples a chance outcome, returning it with its probability, as
+  // SampleAction(ChanceOutcomes(), rng) does. Games whose chance nodes share
+  // a few distributions can override this to sample without building the
+  // outcomes, e.g. from a ChanceDistribution (see chance_distribution.h);
+  // overrides must draw from the same distribution.
+  virtual std::pair<Action, double> SampleChanceOutcome(
+      absl::BitGenRef rng) const;
+
   // Lists the valid chance outcomes at the current state.
   // Derived classes may substitute this with a more efficient implementation.
   virtual std::vector<Action> LegalChanceOutcomes() const {
@@ -509,6 +687,29 @@ class State {
   // If overridden, this must be the inverse of Game::DeserializeState.
   virtual std::string Serialize() const;
 
+  // Serializes a state into a compact binary string, to be read back with
+  // Game::DeserializeStateBinary.
+  //
+  // The encoding is a format version, the varint-encoded action history and
+  // the (possibly empty) game-specific snapshot returned by BinarySnapshot().
+  // When a snapshot is present the state is rebuilt from it directly rather
+  // than by replaying the history. Without a snapshot the same restriction on
+  // kSampledStochastic games as for Serialize() applies.
+  std::string SerializeBinary() const;
+
+  // Returns a game-specific encoding of everything in this state apart from
+  // its history, or an empty string if the game does not provide one (the
+  // default). Games overriding this must also override RestoreBinarySnapshot.
+  virtual std::string BinarySnapshot() const { return ""; }
+
+  // Sets this state, which must be an initial state of the game, to the one
+  // described by history and a snapshot previously returned by
+  // BinarySnapshot().
+  virtual void RestoreBinarySnapshot(const std::vector<Action>& history,
+                                     absl::string_view snapshot) {
+    SpielFatalError("RestoreBinarySnapshot is not implemented.");
+  }
+
   // Resamples a new history from the information state from player_id's view.
   // This resamples a private for the other players, but holds player_id's
   // privates constant, and the public information constant.
@@ -519,6 +720,8 @@ class State {
   // be interpreted as a cumulative distribution function, and will be used to
   // sample from the legal chance actions. A good choice would be
   // absl/std::uniform_real_distribution<double>(0., 1.).
+  // Some games only resample non-terminal states; the resampled state is the
+  // one its History() leads to.
   virtual std::unique_ptr<State> ResampleFromInfostate(
       int player_id, std::function<double()> rng) const {
     SpielFatalError("ResampleFromInfostate() not implemented.");
@@ -560,6 +763,18 @@ class State {
   std::shared_ptr<const Game> game_;
 };
 
+// Sizes that algorithms can use to reserve capacity up front rather than
+// growing buffers in their inner loops. These are only used for preallocation,
+// so an occasional underestimate costs a reallocation, not correctness.
+struct GameResourceHints {
+  // Maximum number of legal actions at any decision node.
+  int max_legal_actions;
+  // Maximum number of outcomes at any chance node.
+  int max_chance_outcomes;
+  // Typical number of legal actions at a decision node.
+  int typical_branching;
+};
+
 // A class that refers to a particular game instantiation, for example
 // Breakthrough(8x8).
 //
@@ -589,6 +804,13 @@ class Game : public std::enable_shared_from_this<Game> {
   // Maximum number of chance outcomes for each chance node.
   virtual int MaxChanceOutcomes() const { return 0; }
 
+  // Capacity hints for preallocation. The default derives them from
+  // NumDistinctActions() and MaxChanceOutcomes(); games with a large action
+  // space but few legal actions per node should override it.
+  virtual GameResourceHints ResourceHints() const {
+    return {NumDistinctActions(), MaxChanceOutcomes(), NumDistinctActions()};
+  }
+
   // If the game is parametrizable, returns an object with the current parameter
   // values, including defaulted values. Returns empty parameters otherwise.
   GameParameters GetParameters() const {
@@ -635,6 +857,10 @@ class Game : public std::enable_shared_from_this<Game> {
   virtual TensorLayout InformationStateTensorLayout() const {
     return TensorLayout::kCHW;
   }
+  // Whether the states encode the nonzero elements of the information state
+  // tensor directly in State::SparseInformationStateTensor, which is then
+  // cheaper than writing the dense tensor.
+  virtual bool InformationStateTensorIsSparse() const { return false; }
 
   // The size of (flat) vector needed for the information state tensor-like
   // format.
@@ -645,6 +871,10 @@ class Game : public std::enable_shared_from_this<Game> {
                                            std::multiplies<double>());
   }
 
+  // The number of values taken by State::InformationStateIndex, or 0 if the
+  // game does not provide information state indices (the default).
+  virtual int64_t NumInformationStates() const { return 0; }
+
   // Describes the structure of the observation representation in a
   // tensor-like format. This is especially useful for experiments involving
   // reinforcement learning and neural networks. Note: the actual observation is
@@ -656,6 +886,8 @@ class Game : public std::enable_shared_from_this<Game> {
   virtual TensorLayout ObservationTensorLayout() const {
     return TensorLayout::kCHW;
   }
+  // As InformationStateTensorIsSparse, for State::SparseObservationTensor.
+  virtual bool ObservationTensorIsSparse() const { return false; }
 
   // The size of (flat) vector needed for the observation tensor-like
   // format.
@@ -686,6 +918,10 @@ class Game : public std::enable_shared_from_this<Game> {
   // Game::SerializeState (i.e. it should also be overridden).
   virtual std::unique_ptr<State> DeserializeState(const std::string& str) const;
 
+  // Builds a state from a string returned by State::SerializeBinary. Games do
+  // not need to override this; see State::BinarySnapshot instead.
+  std::unique_ptr<State> DeserializeStateBinary(absl::string_view data) const;
+
   // Maximum length of any one game (in terms of number of decision nodes
   // visited in the game tree). For a simultaneous action game, this is the
   // maximum number of joint decisions. In a turn-based game, this is the
@@ -772,6 +1008,20 @@ std::shared_ptr<const Game> LoadGame(const std::string& short_name,
 // implementation).
 std::shared_ptr<const Game> LoadGame(GameParameters params);
 
+// Like LoadGame, but returns the same game object for all the calls with the
+// same game, from a process-wide cache, so that it is only constructed once.
+// Game strings are canonicalized first, so that e.g. "kuhn_poker" and
+// "kuhn_poker()" share an entry, as do parameters given in different orders.
+// Thread-safe. Games are immutable, so sharing them is safe, except for the
+// few which keep mutable state in the Game object (e.g. the deal generator
+// of bridge_uncontested_bidding), whose users would see each other's draws.
+std::shared_ptr<const Game> LoadGameCached(const std::string& game_string);
+std::shared_ptr<const Game> LoadGameCached(GameParameters params);
+
+// Drops all the games of the LoadGameCached cache. Those still referenced
+// elsewhere stay alive, but later loads construct new ones.
+void ClearGameCache();
+
 // Normalize a policy into a proper discrete distribution where the
 // probabilities sum to 1.
 void NormalizePolicy(ActionsAndProbs* policy);
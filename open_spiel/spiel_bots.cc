@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <random>
+#include <typeinfo>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -104,11 +105,22 @@ class StatefulRandomBot : public UniformRandomBot {
 class PolicyBot : public Bot {
  public:
   PolicyBot(int seed, std::unique_ptr<Policy> policy)
-      : Bot(), rng_(seed), policy_(std::move(policy)) {}
+      : Bot(), rng_(seed), policy_(std::move(policy)) {
+    // The actions of a tabular policy are sampled from alias tables, without
+    // copying the policy of the state. Subclasses may look up other states.
+    // The tables are built as the states are visited.
+    if (typeid(*policy_) == typeid(TabularPolicy)) {
+      sampler_ = std::make_unique<TabularPolicySampler>(
+          static_cast<const TabularPolicy&>(*policy_));
+    }
+  }
   ~PolicyBot() = default;
 
   void RestartAt(const State&) override {}
   Action Step(const State& state) override {
+    if (sampler_ != nullptr) {
+      return sampler_->Sample(state.InformationStateString(), rng_);
+    }
     return StepWithPolicy(state).second;
   }
   bool ProvidesPolicy() override { return true; }
@@ -119,12 +131,17 @@ class PolicyBot : public Bot {
   std::pair<ActionsAndProbs, Action> StepWithPolicy(
       const State& state) override {
     ActionsAndProbs actions_and_probs = GetPolicy(state);
+    if (sampler_ != nullptr) {
+      return {actions_and_probs,
+              sampler_->Sample(state.InformationStateString(), rng_)};
+    }
     return {actions_and_probs, SampleAction(actions_and_probs, rng_).first};
   }
 
  private:
   std::mt19937 rng_;
   std::unique_ptr<Policy> policy_;
+  std::unique_ptr<TabularPolicySampler> sampler_;
 };
 
 class FixedActionPreferenceBot : public Bot {
@@ -0,0 +1,76 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/state_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+thread_local StateArena* current_state_arena = nullptr;
+
+constexpr int64_t kAlignment = alignof(std::max_align_t);
+
+}  // namespace
+
+StateArena::StateArena(int64_t block_size) {
+  SPIEL_CHECK_GT(block_size, 0);
+  blocks_.push_back({std::make_unique<char[]>(block_size), block_size});
+  capacity_ = block_size;
+}
+
+StateArena::~StateArena() { SPIEL_CHECK_EQ(num_live_states_.load(), 0); }
+
+void StateArena::Reset() {
+  SPIEL_CHECK_EQ(num_live_states_.load(), 0);
+  current_block_ = 0;
+  offset_ = 0;
+  bytes_allocated_ = 0;
+}
+
+void* StateArena::Allocate(std::size_t bytes) {
+  const int64_t size = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  while (offset_ + size > blocks_[current_block_].size) {
+    ++current_block_;
+    offset_ = 0;
+    if (current_block_ == blocks_.size()) {
+      const int64_t block_size = std::max(2 * blocks_.back().size, size);
+      blocks_.push_back({std::make_unique<char[]>(block_size), block_size});
+      capacity_ += block_size;
+    }
+  }
+  // new char[] is aligned for any fundamental type, and so are the offsets.
+  void* data = blocks_[current_block_].data.get() + offset_;
+  offset_ += size;
+  bytes_allocated_ += size;
+  ++num_live_states_;
+  return data;
+}
+
+StateArenaScope::StateArenaScope(StateArena* arena)
+    : previous_(current_state_arena) {
+  current_state_arena = arena;
+}
+
+StateArenaScope::~StateArenaScope() { current_state_arena = previous_; }
+
+StateArena* CurrentStateArena() { return current_state_arena; }
+
+}  // namespace open_spiel
@@ -0,0 +1,103 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_STATE_ARENA_H_
+#define THIRD_PARTY_OPEN_SPIEL_STATE_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Arena allocation of State objects.
+//
+// While a StateArenaScope is alive, the States that its thread creates with
+// new, e.g. through Game::NewInitialState, State::Clone or State::Child, are
+// allocated from its StateArena rather than from the global heap. Deleting
+// them still runs their destructors, but does not free their memory: the
+// arena frees the memory of all its states at once when it is reset, which
+// takes constant time and keeps its blocks for the next states. A search or
+// an episode creating many short-lived states can thus reset a per-thread
+// arena at its end, and its threads do not contend on malloc for the states.
+//
+// Only the State objects themselves are in the arena: the buffers they own,
+// like their history, are still allocated by their containers. The arena is
+// a bump allocator whose memory is only reused after a reset, so it suits
+// scopes that create a bounded number of states.
+
+namespace open_spiel {
+
+class StateArena {
+ public:
+  // The first block holds block_size bytes, and each later one twice as many
+  // as the previous one.
+  explicit StateArena(int64_t block_size = 1 << 16);
+  // The arena must not hold live states.
+  ~StateArena();
+
+  StateArena(const StateArena&) = delete;
+  StateArena& operator=(const StateArena&) = delete;
+
+  // Frees the memory of all the states, which must have been deleted.
+  void Reset();
+
+  // The bytes allocated since the last reset, and the states not yet
+  // deleted.
+  int64_t BytesAllocated() const { return bytes_allocated_; }
+  int NumLiveStates() const { return num_live_states_; }
+  // The bytes of the blocks held by the arena.
+  int64_t Capacity() const { return capacity_; }
+
+  // Allocates `bytes` aligned to alignof(std::max_align_t), for a state.
+  // Only called by the thread that uses the arena.
+  void* Allocate(std::size_t bytes);
+  // Records that a state was deleted, from any thread.
+  void Release() { --num_live_states_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    int64_t size;
+  };
+
+  std::vector<Block> blocks_;
+  int current_block_ = 0;
+  int64_t offset_ = 0;  // In the current block.
+  int64_t bytes_allocated_ = 0;
+  int64_t capacity_ = 0;
+  std::atomic<int> num_live_states_{0};
+};
+
+// Makes the current thread allocate its new states from `arena`, or from the
+// global heap if it is nullptr, until the scope ends. Scopes can be nested.
+class StateArenaScope {
+ public:
+  explicit StateArenaScope(StateArena* arena);
+  ~StateArenaScope();
+
+  StateArenaScope(const StateArenaScope&) = delete;
+  StateArenaScope& operator=(const StateArenaScope&) = delete;
+
+ private:
+  StateArena* previous_;
+};
+
+// The arena of the innermost StateArenaScope of the current thread, or
+// nullptr.
+StateArena* CurrentStateArena();
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_STATE_ARENA_H_
@@ -18,10 +18,12 @@
 #include <memory>
 #include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -91,6 +93,278 @@ std::unique_ptr<State> TensorGame::NewInitialState() const {
   return std::unique_ptr<State>(new TensorState(shared_from_this()));
 }
 
+void TensorGame::ContractTrailingPlayers(
+    Player player, Player first_player,
+    const std::vector<absl::Span<const double>>& strategies,
+    std::vector<double>* contracted) const {
+  SPIEL_CHECK_EQ(strategies.size(), NumPlayers());
+  if (first_player == NumPlayers()) {
+    *contracted = utilities_[player];
+    return;
+  }
+  // The actions of the last player are contiguous, so each contraction is a
+  // dot product of successive slices with its strategy. The slices are read
+  // ahead of the results, so all but the first are done in place.
+  const double* utilities = utilities_[player].data();
+  int size = utilities_[player].size();
+  contracted->resize(size / shape_.back());
+  for (Player p = NumPlayers() - 1; p >= first_player; --p) {
+    SPIEL_CHECK_EQ(strategies[p].size(), shape_[p]);
+    const int num_actions = shape_[p];
+    size /= num_actions;
+    for (int i = 0; i < size; ++i) {
+      (*contracted)[i] = internal::Dot(utilities + i * num_actions,
+                                       strategies[p].data(), num_actions);
+    }
+    utilities = contracted->data();
+  }
+  contracted->resize(size);
+}
+
+std::vector<double> TensorGame::ExpectedPayoffs(
+    const std::vector<absl::Span<const double>>& strategies) const {
+  std::vector<double> payoffs(NumPlayers());
+  std::vector<double> contracted;
+  for (Player player = 0; player < NumPlayers(); ++player) {
+    ContractTrailingPlayers(player, /*first_player=*/0, strategies,
+                            &contracted);
+    payoffs[player] = contracted[0];
+  }
+  return payoffs;
+}
+
+void TensorGame::ActionValues(
+    Player player, const std::vector<absl::Span<const double>>& strategies,
+    absl::Span<double> values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, NumPlayers());
+  SPIEL_CHECK_EQ(values.size(), shape_[player]);
+  std::vector<double> contracted;
+  ContractTrailingPlayers(player, player + 1, strategies, &contracted);
+
+  // The earlier players' joint actions, weighted by the product of their
+  // probabilities, each give a contiguous slice of action values.
+  std::vector<double> weights = {1};
+  for (Player p = 0; p < player; ++p) {
+    SPIEL_CHECK_EQ(strategies[p].size(), shape_[p]);
+    std::vector<double> next_weights(weights.size() * shape_[p]);
+    for (int i = 0; i < weights.size(); ++i) {
+      for (int a = 0; a < shape_[p]; ++a) {
+        next_weights[i * shape_[p] + a] = weights[i] * strategies[p][a];
+      }
+    }
+    weights = std::move(next_weights);
+  }
+  const int num_actions = shape_[player];
+  std::fill(values.begin(), values.end(), 0);
+  for (int i = 0; i < weights.size(); ++i) {
+    if (weights[i] == 0) continue;
+    const double* slice = contracted.data() + i * num_actions;
+    for (int a = 0; a < num_actions; ++a) values[a] += weights[i] * slice[a];
+  }
+}
+
+std::vector<double> TensorGame::ActionValues(
+    Player player,
+    const std::vector<absl::Span<const double>>& strategies) const {
+  std::vector<double> values(shape_[player]);
+  ActionValues(player, strategies, absl::MakeSpan(values));
+  return values;
+}
+
+Action TensorGame::BestResponse(
+    Player player,
+    const std::vector<absl::Span<const double>>& strategies) const {
+  const std::vector<double> values = ActionValues(player, strategies);
+  return std::max_element(values.begin(), values.end()) - values.begin();
+}
+
+LazyTensorGame::LazyTensorGame(
+    GameType game_type, GameParameters game_parameters,
+    std::vector<std::vector<std::string>> action_names, PayoffOracle oracle,
+    double min_utility, double max_utility, int num_oracle_samples)
+    : NormalFormGame(std::move(game_type), std::move(game_parameters)),
+      action_names_(std::move(action_names)),
+      oracle_(std::move(oracle)),
+      min_utility_(min_utility),
+      max_utility_(max_utility),
+      num_oracle_samples_(num_oracle_samples) {
+  SPIEL_CHECK_GE(num_oracle_samples_, 1);
+  SPIEL_CHECK_LE(min_utility_, max_utility_);
+  for (const std::vector<std::string>& player_action_names : action_names_) {
+    SPIEL_CHECK_FALSE(player_action_names.empty());
+    shape_.push_back(player_action_names.size());
+  }
+}
+
+LazyTensorGame::LazyTensorGame(const LazyTensorGame& other)
+    : NormalFormGame(other.GetType(), other.GetParameters()),
+      action_names_(other.action_names_),
+      shape_(other.shape_),
+      oracle_(other.oracle_),
+      min_utility_(other.min_utility_),
+      max_utility_(other.max_utility_),
+      num_oracle_samples_(other.num_oracle_samples_) {
+  absl::MutexLock lock(&other.mutex_);
+  entries_ = other.entries_;
+}
+
+std::unique_ptr<State> LazyTensorGame::NewInitialState() const {
+  return std::unique_ptr<State>(new LazyTensorState(shared_from_this()));
+}
+
+void LazyTensorGame::CheckActions(const std::vector<Action>& actions) const {
+  SPIEL_CHECK_EQ(actions.size(), NumPlayers());
+  for (Player player = 0; player < NumPlayers(); ++player) {
+    SPIEL_CHECK_GE(actions[player], 0);
+    SPIEL_CHECK_LT(actions[player], shape_[player]);
+  }
+}
+
+std::vector<double> LazyTensorGame::Average(const Entry& entry) {
+  std::vector<double> utilities = entry.utility_sums;
+  for (double& utility : utilities) utility /= entry.num_samples;
+  return utilities;
+}
+
+std::vector<double> LazyTensorGame::Utilities(
+    const std::vector<Action>& actions) const {
+  CheckActions(actions);
+  {
+    absl::MutexLock lock(&mutex_);
+    const auto it = entries_.find(actions);
+    if (it != entries_.end()) return Average(it->second);
+  }
+  if (!oracle_) {
+    SpielFatalError(absl::StrCat("No utilities for the joint action ",
+                                 absl::StrJoin(actions, ","),
+                                 " and no payoff oracle."));
+  }
+  // The oracle is called without the lock, as it may be slow. If another
+  // thread sampled the same entry in the meantime, both samples are kept.
+  std::vector<std::vector<double>> samples;
+  for (int i = 0; i < num_oracle_samples_; ++i) {
+    samples.push_back(oracle_(actions));
+  }
+  absl::MutexLock lock(&mutex_);
+  for (const std::vector<double>& sample : samples) {
+    AddSampleLocked(actions, sample);
+  }
+  return Average(entries_[actions]);
+}
+
+double LazyTensorGame::PlayerUtility(
+    Player player, const std::vector<Action>& actions) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, NumPlayers());
+  return Utilities(actions)[player];
+}
+
+void LazyTensorGame::AddSample(const std::vector<Action>& actions,
+                               const std::vector<double>& utilities) {
+  CheckActions(actions);
+  absl::MutexLock lock(&mutex_);
+  AddSampleLocked(actions, utilities);
+}
+
+void LazyTensorGame::AddSampleLocked(
+    const std::vector<Action>& actions,
+    const std::vector<double>& utilities) const {
+  SPIEL_CHECK_EQ(utilities.size(), NumPlayers());
+  Entry& entry = entries_[actions];
+  if (entry.num_samples == 0) entry.utility_sums.assign(NumPlayers(), 0);
+  for (Player player = 0; player < NumPlayers(); ++player) {
+    SPIEL_CHECK_GE(utilities[player], min_utility_);
+    SPIEL_CHECK_LE(utilities[player], max_utility_);
+    entry.utility_sums[player] += utilities[player];
+  }
+  ++entry.num_samples;
+}
+
+int LazyTensorGame::NumSamples(const std::vector<Action>& actions) const {
+  CheckActions(actions);
+  absl::MutexLock lock(&mutex_);
+  const auto it = entries_.find(actions);
+  return it == entries_.end() ? 0 : it->second.num_samples;
+}
+
+int LazyTensorGame::NumEntries() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+LazyTensorState::LazyTensorState(std::shared_ptr<const Game> game)
+    : NFGState(game),
+      lazy_tensor_game_(static_cast<const LazyTensorGame*>(game.get())) {}
+
+std::vector<Action> LazyTensorState::LegalActions(Player player) const {
+  if (IsTerminal()) return {};
+  if (player == kSimultaneousPlayerId) return LegalFlatJointActions();
+  std::vector<Action> moves(lazy_tensor_game_->Shape()[player]);
+  std::iota(moves.begin(), moves.end(), 0);
+  return moves;
+}
+
+std::string LazyTensorState::ToString() const {
+  std::string result = "";
+  absl::StrAppend(&result, "Terminal? ", IsTerminal() ? "true" : "false", "\n");
+  if (IsTerminal()) {
+    absl::StrAppend(&result, "History: ", HistoryString(), "\n");
+    absl::StrAppend(&result, "Returns: ", absl::StrJoin(Returns(), ","), "\n");
+  }
+  return result;
+}
+
+std::string LazyTensorState::ActionToString(Player player,
+                                            Action action_id) const {
+  if (player == kSimultaneousPlayerId) {
+    return FlatJointActionToString(action_id);
+  }
+  return lazy_tensor_game_->ActionName(player, action_id);
+}
+
+std::vector<double> LazyTensorState::Returns() const {
+  if (!IsTerminal()) return std::vector<double>(NumPlayers(), 0);
+  return lazy_tensor_game_->Utilities(joint_move_);
+}
+
+void LazyTensorState::DoApplyActions(const std::vector<Action>& moves) {
+  SPIEL_CHECK_EQ(moves.size(), NumPlayers());
+  for (Player player = 0; player < NumPlayers(); player++) {
+    SPIEL_CHECK_GE(moves[player], 0);
+    SPIEL_CHECK_LT(moves[player], lazy_tensor_game_->Shape()[player]);
+  }
+  joint_move_ = moves;
+}
+
+std::shared_ptr<LazyTensorGame> CreateLazyTensorGame(
+    const std::string& short_name, const std::string& long_name,
+    const std::vector<std::vector<std::string>>& action_names,
+    LazyTensorGame::PayoffOracle oracle, double min_utility,
+    double max_utility, int num_oracle_samples, GameType::Utility utility) {
+  const int num_players = action_names.size();
+  const GameType game_type{
+      /*short_name=*/short_name,
+      /*long_name=*/long_name,
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      utility,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/num_players,
+      /*min_num_players=*/num_players,
+      /*provides_information_state_string=*/true,
+      /*provides_information_state_tensor=*/true,
+      /*provides_observation_string=*/false,
+      /*provides_observation_tensor=*/false,
+      /*parameter_specification=*/{}  // no parameters
+  };
+  return std::make_shared<LazyTensorGame>(game_type, GameParameters{},
+                                          action_names, std::move(oracle),
+                                          min_utility, max_utility,
+                                          num_oracle_samples);
+}
+
 std::shared_ptr<const TensorGame> CreateTensorGame(
     const std::vector<std::vector<double>>& utils,
     const std::vector<int>& shape) {
@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_TENSOR_GAME_H_
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <numeric>
@@ -23,6 +24,9 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/normal_form_game.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -107,7 +111,35 @@ class TensorGame : public NormalFormGame {
     return action_names_[player][action];
   }
 
+  // Kernels for solvers that play mixed strategies, given as probabilities
+  // of the actions of each player, many times.
+  //
+  // The expected utilities of all the players.
+  std::vector<double> ExpectedPayoffs(
+      const std::vector<absl::Span<const double>>& strategies) const;
+  // Sets values to the expected utility of each action of the player against
+  // the strategies of the other players; strategies[player] is ignored.
+  void ActionValues(Player player,
+                    const std::vector<absl::Span<const double>>& strategies,
+                    absl::Span<double> values) const;
+  std::vector<double> ActionValues(
+      Player player,
+      const std::vector<absl::Span<const double>>& strategies) const;
+  // The first of the best actions of the player against the strategies of
+  // the other players.
+  Action BestResponse(
+      Player player,
+      const std::vector<absl::Span<const double>>& strategies) const;
+
  private:
+  // Sums the utilities of the player over the actions of the players from
+  // `first_player` on, weighted by their strategies, into `contracted`, in
+  // the order of the actions of the earlier players.
+  void ContractTrailingPlayers(
+      Player player, Player first_player,
+      const std::vector<absl::Span<const double>>& strategies,
+      std::vector<double>* contracted) const;
+
   const int index(const std::vector<Action>& args) const {
     int ind = 0;
     for (int i = 0; i < NumPlayers(); ++i) {
@@ -179,6 +211,116 @@ class TensorState : public NFGState {
   const TensorGame* tensor_game_;
 };
 
+// A tensor game for games with too many joint actions to hold all of their
+// utilities, such as empirical games with many players. The utilities of a
+// joint action are the average of its samples, which are added explicitly or
+// drawn from a payoff oracle the first time that the joint action is played
+// or queried, and kept.
+class LazyTensorGame : public NormalFormGame {
+ public:
+  // Returns a sample of the utilities of all the players for a joint action,
+  // which may be exact or, e.g., the returns of a simulation.
+  using PayoffOracle =
+      std::function<std::vector<double>(const std::vector<Action>&)>;
+
+  // The oracle, if any, is called num_oracle_samples times for the entries
+  // without samples. The utilities must be within the bounds given.
+  LazyTensorGame(GameType game_type, GameParameters game_parameters,
+                 std::vector<std::vector<std::string>> action_names,
+                 PayoffOracle oracle, double min_utility, double max_utility,
+                 int num_oracle_samples = 1);
+  LazyTensorGame(const LazyTensorGame& other);
+
+  // Implementation of Game interface
+  int NumDistinctActions() const override {
+    return *std::max_element(begin(shape_), end(shape_));
+  }
+  std::unique_ptr<State> NewInitialState() const override;
+  int NumPlayers() const override { return shape_.size(); }
+  double MinUtility() const override { return min_utility_; }
+  double MaxUtility() const override { return max_utility_; }
+  // The clone shares the oracle, and starts with the same samples.
+  std::shared_ptr<const Game> Clone() const override {
+    return std::shared_ptr<const Game>(new LazyTensorGame(*this));
+  }
+
+  const std::vector<int>& Shape() const { return shape_; }
+  const std::string& ActionName(const Player player,
+                                const Action& action) const {
+    SPIEL_CHECK_GE(player, 0);
+    SPIEL_CHECK_LT(player, NumPlayers());
+    return action_names_[player][action];
+  }
+
+  // The average utilities of the samples of a joint action, which are drawn
+  // from the oracle if there are none yet. It is a fatal error if there are
+  // neither samples nor an oracle.
+  std::vector<double> Utilities(const std::vector<Action>& actions) const;
+  double PlayerUtility(Player player, const std::vector<Action>& actions) const;
+
+  // Adds a sample of the utilities of a joint action.
+  void AddSample(const std::vector<Action>& actions,
+                 const std::vector<double>& utilities);
+  int NumSamples(const std::vector<Action>& actions) const;
+  // The number of joint actions with samples.
+  int NumEntries() const;
+
+ private:
+  struct Entry {
+    std::vector<double> utility_sums;
+    int num_samples = 0;
+  };
+
+  void CheckActions(const std::vector<Action>& actions) const;
+  void AddSampleLocked(const std::vector<Action>& actions,
+                       const std::vector<double>& utilities) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  static std::vector<double> Average(const Entry& entry);
+
+  const std::vector<std::vector<std::string>> action_names_;
+  std::vector<int> shape_;
+  const PayoffOracle oracle_;
+  const double min_utility_;
+  const double max_utility_;
+  const int num_oracle_samples_;
+
+  mutable absl::Mutex mutex_;
+  // Filled in on demand, as the game is otherwise immutable.
+  mutable absl::flat_hash_map<std::vector<Action>, Entry> entries_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+class LazyTensorState : public NFGState {
+ public:
+  explicit LazyTensorState(std::shared_ptr<const Game> game);
+  LazyTensorState(const LazyTensorState&) = default;
+
+  std::vector<Action> LegalActions(Player player) const override;
+  std::string ToString() const override;
+  std::string ActionToString(Player player, Action action_id) const override;
+  bool IsTerminal() const override { return !joint_move_.empty(); }
+  std::vector<double> Returns() const override;
+  std::unique_ptr<State> Clone() const override {
+    return std::unique_ptr<State>(new LazyTensorState(*this));
+  }
+
+ protected:
+  void DoApplyActions(const std::vector<Action>& moves) override;
+
+ private:
+  std::vector<Action> joint_move_{};  // joint move that was chosen
+  const LazyTensorGame* lazy_tensor_game_;
+};
+
+// Creates a lazy tensor game with the specified action names and payoff
+// oracle, of general-sum utility unless specified.
+std::shared_ptr<LazyTensorGame> CreateLazyTensorGame(
+    const std::string& short_name, const std::string& long_name,
+    const std::vector<std::vector<std::string>>& action_names,
+    LazyTensorGame::PayoffOracle oracle, double min_utility,
+    double max_utility, int num_oracle_samples = 1,
+    GameType::Utility utility = GameType::Utility::kGeneralSum);
+
 // Create a tensor game with the specified utilities and action names.
 // utils[player] is a flattened tensor of utilities for player, in
 // row-major/C-style/lexicographic order of all players' actions.
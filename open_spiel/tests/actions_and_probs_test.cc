@@ -0,0 +1,102 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/actions_and_probs.h"
+
+#include <memory>
+#include <random>
+#include <utility>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+void ConversionTest() {
+  const ActionsAndProbs outcomes = {{3, 0.1}, {1, 0.6}, {8, 0.0}, {2, 0.3}};
+  ActionsAndProbsSoA soa(outcomes);
+  SPIEL_CHECK_EQ(soa.size(), 4);
+  SPIEL_CHECK_EQ(soa.action(1), 1);
+  SPIEL_CHECK_EQ(soa.prob(3), 0.3);
+  SPIEL_CHECK_TRUE(soa.ToActionsAndProbs() == outcomes);
+
+  // More outcomes than are stored inline.
+  ActionsAndProbs many;
+  for (int i = 0; i < 3 * ActionsAndProbsSoA::kInlineSize; ++i) {
+    many.push_back({i * 2, 1.0 / (i + 1)});
+  }
+  soa.Assign(many);
+  SPIEL_CHECK_TRUE(soa.ToActionsAndProbs() == many);
+  soa.clear();
+  SPIEL_CHECK_TRUE(soa.empty());
+}
+
+void NormalizePolicyTest() {
+  ActionsAndProbs policy = {{0, 1.0}, {4, 3.0}, {5, 0.0}, {7, 4.0}};
+  ActionsAndProbsSoA soa(policy);
+  NormalizePolicy(&policy);
+  NormalizePolicy(&soa);
+  SPIEL_CHECK_TRUE(soa.ToActionsAndProbs() == policy);
+
+  ActionsAndFloatProbsSoA float_soa;
+  float_soa.push_back(2, 1.0f);
+  float_soa.push_back(9, 3.0f);
+  NormalizePolicy(&float_soa);
+  SPIEL_CHECK_FLOAT_EQ(float_soa.prob(0), 0.25);
+  SPIEL_CHECK_FLOAT_EQ(float_soa.prob(1), 0.75);
+}
+
+// Both layouts must sample the same outcomes from the same draws.
+void SampleActionTest() {
+  const ActionsAndProbs outcomes = {{3, 0.1}, {1, 0.6}, {8, 0.0}, {2, 0.3}};
+  const ActionsAndProbsSoA soa(outcomes);
+  constexpr int kNumDraws = 1000;
+  for (int i = 0; i < kNumDraws; ++i) {
+    const double z = (i + 0.5) / kNumDraws;
+    SPIEL_CHECK_TRUE(SampleAction(soa, z) == SampleAction(outcomes, z));
+  }
+  std::mt19937 rng(7);
+  const ActionsAndFloatProbsSoA float_soa(outcomes);
+  for (int i = 0; i < kNumDraws; ++i) {
+    const auto [action, prob] = SampleAction(float_soa, rng);
+    SPIEL_CHECK_NE(action, 8);
+  }
+}
+
+void ChanceOutcomesAndPolicyTest() {
+  std::shared_ptr<const Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<State> state = game->NewInitialState();
+  ActionsAndProbsSoA soa;
+  state->ChanceOutcomes(&soa);
+  SPIEL_CHECK_TRUE(soa.ToActionsAndProbs() == state->ChanceOutcomes());
+
+  state->ApplyAction(0);
+  state->ApplyAction(1);
+  const TabularPolicy policy = GetUniformPolicy(*game);
+  const Policy& base = policy;
+  base.GetStatePolicy(*state, &soa);
+  SPIEL_CHECK_TRUE(soa.ToActionsAndProbs() == base.GetStatePolicy(*state));
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::ConversionTest();
+  open_spiel::NormalizePolicyTest();
+  open_spiel::SampleActionTest();
+  open_spiel::ChanceOutcomesAndPolicyTest();
+}
@@ -14,6 +14,9 @@
 
 #include "open_spiel/tests/basic_tests.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <numeric>
@@ -21,12 +24,17 @@
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "open_spiel/abseil-cpp/absl/random/uniform_int_distribution.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread_pool.h"
 
 namespace open_spiel {
 namespace testing {
@@ -137,10 +145,80 @@ void LegalActionsMaskTest(const Game& game, const State& state,
   }
 
   SPIEL_CHECK_EQ(num_ones, legal_actions.size());
+
+  // The float and packed masks must agree with the integer one.
+  std::vector<float> float_mask(game.NumDistinctActions(), -1.0f);
+  state.LegalActionsMask(state.CurrentPlayer(), absl::MakeSpan(float_mask));
+  std::vector<uint64_t> bitmask =
+      state.LegalActionsBitmask(state.CurrentPlayer());
+  SPIEL_CHECK_EQ(bitmask.size(), (game.NumDistinctActions() + 63) / 64);
+  for (int i = 0; i < game.NumDistinctActions(); ++i) {
+    SPIEL_CHECK_EQ(float_mask[i], legal_actions_mask[i]);
+    SPIEL_CHECK_EQ(static_cast<int>((bitmask[i / 64] >> (i % 64)) & 1),
+                   legal_actions_mask[i]);
+  }
+}
+
+// Check that the buffer-filling LegalActions overload agrees with the
+// returning one, and that it clears any previous contents of the buffer.
+void LegalActionsBufferTest(const State& state,
+                            const std::vector<Action>& legal_actions) {
+  std::vector<Action> buffer = {kInvalidAction};
+  state.LegalActions(&buffer);
+  SPIEL_CHECK_EQ(buffer, legal_actions);
+}
+
+// Check that a float32 tensor written via the absl::Span overloads matches the
+// std::vector<double> version.
+void CheckFloatTensor(const std::vector<double>& expected,
+                      const std::vector<float>& actual) {
+  SPIEL_CHECK_EQ(expected.size(), actual.size());
+  for (int i = 0; i < expected.size(); ++i) {
+    SPIEL_CHECK_FLOAT_EQ(static_cast<float>(expected[i]), actual[i]);
+  }
+}
+
+// Check that a sparse tensor has unique indices and matches the dense one.
+void CheckSparseTensor(const std::vector<double>& expected,
+                       const SparseTensor& actual) {
+  SPIEL_CHECK_EQ(actual.indices.size(), actual.values.size());
+  std::vector<float> dense(expected.size());
+  actual.ToDense(absl::MakeSpan(dense));
+  CheckFloatTensor(expected, dense);
+  std::vector<int> indices = actual.indices;
+  std::sort(indices.begin(), indices.end());
+  SPIEL_CHECK_TRUE(std::adjacent_find(indices.begin(), indices.end()) ==
+                   indices.end());
+}
+
+// Check that the appending string overloads match the others.
+void AppendedStringsTest(const State& state, Player player) {
+  const GameType& type = state.GetGame()->GetType();
+  const std::string prefix = "prefix";
+  if (type.provides_information_state_string) {
+    std::string str = prefix;
+    state.AppendInformationStateString(player, &str);
+    SPIEL_CHECK_EQ(str, prefix + state.InformationStateString(player));
+  }
+  if (type.provides_observation_string) {
+    std::string str = prefix;
+    state.AppendObservationString(player, &str);
+    SPIEL_CHECK_EQ(str, prefix + state.ObservationString(player));
+  }
 }
 
 bool IsPowerOfTwo(int n) { return n == 0 || (n & (n - 1)) == 0; }
 
+// Format chance outcomes as a string, for error messages.
+std::string ChanceOutcomeStr(const ActionsAndProbs& chance_outcomes) {
+  std::string str;
+  for (auto outcome : chance_outcomes) {
+    if (!str.empty()) str.append(", ");
+    absl::StrAppend(&str, "(", outcome.first, ", ", outcome.second, ")");
+  }
+  return str;
+}
+
 }  // namespace
 
 // Checks that the game can be loaded.
@@ -167,10 +245,22 @@ void TestUndo(std::unique_ptr<State> state,
               const std::vector<HistoryItem>& history) {
   // TODO(author2): We can just check each UndoAction.
   for (auto prev = history.rbegin(); prev != history.rend(); ++prev) {
-    state->UndoAction(prev->player, prev->action);
+    if (prev->player == kInvalidHistoryPlayer) {
+      // A joint action, whose first item holds the state it was taken in.
+      std::vector<Action> joint_action = {prev->action};
+      while (prev->state == nullptr) {
+        ++prev;
+        joint_action.push_back(prev->action);
+      }
+      std::reverse(joint_action.begin(), joint_action.end());
+      state->UndoActions(joint_action);
+    } else {
+      state->UndoAction(prev->player, prev->action);
+    }
     SPIEL_CHECK_EQ(state->ToString(), prev->state->ToString());
     // We also check that UndoActions correctly updates history_.
     SPIEL_CHECK_EQ(state->History(), prev->state->History());
+    SPIEL_CHECK_EQ(state->Hash(), prev->state->Hash());
   }
 }
 
@@ -180,6 +270,15 @@ void TestSerializeDeserialize(const Game& game, const State* state) {
       game_and_state = DeserializeGameAndState(ser_str);
   SPIEL_CHECK_EQ(game.ToString(), game_and_state.first->ToString());
   SPIEL_CHECK_EQ(state->ToString(), game_and_state.second->ToString());
+
+  // The binary format keeps the history, unlike some custom Serialize().
+  if (game.GetType().chance_mode != GameType::ChanceMode::kSampledStochastic ||
+      !state->BinarySnapshot().empty()) {
+    std::unique_ptr<State> binary_state =
+        game.DeserializeStateBinary(state->SerializeBinary());
+    SPIEL_CHECK_EQ(state->ToString(), binary_state->ToString());
+    SPIEL_CHECK_EQ(state->History(), binary_state->History());
+  }
 }
 
 void TestHistoryContainsActions(const Game& game,
@@ -219,36 +318,63 @@ void CheckReturnsSum(const Game& game, const State& state) {
   }
 }
 
-void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
-                      bool serialize) {
+// Zero returns are +0.0: -0.0 compares equal to it but prints as "-0", which
+// shows up in playthroughs and in the returns seen from Python.
+void CheckNoNegativeZeroReturns(const State& state) {
+  for (double value : state.Returns()) {
+    SPIEL_CHECK_FALSE(value == 0 && std::signbit(value));
+  }
+}
+
+// Plays a random game to the end, checking everything along the way, and
+// returns the number of actions applied (chance outcomes and joint actions
+// included).
+int RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
+                     bool serialize, bool verbose = true) {
   std::vector<HistoryItem> history;
   std::vector<double> episode_returns(game.NumPlayers(), 0);
 
   int infostate_vector_size = game.GetType().provides_information_state_tensor
                                   ? game.InformationStateTensorSize()
                                   : 0;
-  std::cout << "Information state vector size: " << infostate_vector_size
-            << std::endl;
+  if (verbose) {
+    std::cout << "Information state vector size: " << infostate_vector_size
+              << std::endl;
+  }
 
   int observation_vector_size = game.GetType().provides_observation_tensor
                                     ? game.ObservationTensorSize()
                                     : 0;
-  std::cout << "Observation vector size: " << observation_vector_size
-            << std::endl;
+  if (verbose) {
+    std::cout << "Observation vector size: " << observation_vector_size
+              << std::endl;
+  }
 
   SPIEL_CHECK_TRUE(game.MinUtility() < game.MaxUtility());
-  std::cout << "Utility range: " << game.MinUtility() << " "
-            << game.MaxUtility() << std::endl;
-
-  std::cout << "Starting new game.." << std::endl;
+  GameResourceHints hints = game.ResourceHints();
+  SPIEL_CHECK_GT(hints.max_legal_actions, 0);
+  SPIEL_CHECK_GE(hints.max_chance_outcomes, 0);
+  SPIEL_CHECK_GT(hints.typical_branching, 0);
+  SPIEL_CHECK_LE(hints.typical_branching, hints.max_legal_actions);
+  if (verbose) {
+    std::cout << "Utility range: " << game.MinUtility() << " "
+              << game.MaxUtility() << std::endl;
+    std::cout << "Starting new game.." << std::endl;
+  }
   std::unique_ptr<open_spiel::State> state = game.NewInitialState();
+  CheckNoNegativeZeroReturns(*state);
 
-  std::cout << "Initial state:" << std::endl;
-  std::cout << "State:" << std::endl << state->ToString() << std::endl;
+  if (verbose) {
+    std::cout << "Initial state:" << std::endl;
+    std::cout << "State:" << std::endl << state->ToString() << std::endl;
+  }
   int game_length = 0;
+  int num_steps = 0;
 
   while (!state->IsTerminal()) {
-    std::cout << "player " << state->CurrentPlayer() << std::endl;
+    if (verbose) {
+      std::cout << "player " << state->CurrentPlayer() << std::endl;
+    }
 
     LegalActionsIsEmptyForOtherPlayers(game, *state);
     LegalActionsAreSorted(game, *state);
@@ -257,6 +383,15 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     std::unique_ptr<open_spiel::State> state_copy = state->Clone();
     SPIEL_CHECK_EQ(state->ToString(), state_copy->ToString());
     SPIEL_CHECK_EQ(state->History(), state_copy->History());
+    SPIEL_CHECK_EQ(state->Hash(), state_copy->Hash());
+
+    // Test copying the state in place, if supported.
+    std::unique_ptr<open_spiel::State> recycled = game.NewInitialState();
+    if (recycled->CopyFrom(*state)) {
+      SPIEL_CHECK_EQ(state->ToString(), recycled->ToString());
+      SPIEL_CHECK_EQ(state->History(), recycled->History());
+      SPIEL_CHECK_EQ(state->Hash(), recycled->Hash());
+    }
 
     if (serialize && (history.size() < 10 || IsPowerOfTwo(history.size()))) {
       TestSerializeDeserialize(game, state.get());
@@ -265,13 +400,30 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     if (state->IsChanceNode()) {
       // Chance node; sample one according to underlying distribution
       std::vector<std::pair<Action, double>> outcomes = state->ChanceOutcomes();
-      Action action = open_spiel::SampleAction(outcomes, *rng).first;
+      const std::pair<Action, double> outcome =
+          state->SampleChanceOutcome(*rng);
+      Action action = outcome.first;
+      auto it = std::find_if(outcomes.begin(), outcomes.end(),
+                             [action](const std::pair<Action, double>& o) {
+                               return o.first == action;
+                             });
+      if (it == outcomes.end()) {
+        SpielFatalError(absl::StrCat("SampleChanceOutcome returned ", action,
+                                     " not in ChanceOutcomes()=",
+                                     ChanceOutcomeStr(outcomes)));
+      }
+      SPIEL_CHECK_FLOAT_EQ(outcome.second, it->second);
+      LegalActionsBufferTest(*state, state->LegalActions());
 
-      std::cout << "sampled outcome: "
-                << state->ActionToString(kChancePlayerId, action) << std::endl;
+      if (verbose) {
+        std::cout << "sampled outcome: "
+                  << state->ActionToString(kChancePlayerId, action)
+                  << std::endl;
+      }
 
       history.emplace_back(state->Clone(), kChancePlayerId, action);
       state->ApplyAction(action);
+      num_steps++;
 
       if (undo && (history.size() < 10 || IsPowerOfTwo(history.size()))) {
         TestUndo(state->Clone(), history);
@@ -279,7 +431,9 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
     } else if (state->CurrentPlayer() == open_spiel::kSimultaneousPlayerId) {
       std::vector<double> rewards = state->Rewards();
       SPIEL_CHECK_EQ(rewards.size(), game.NumPlayers());
-      std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      if (verbose) {
+        std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      }
       for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
         episode_returns[p] += rewards[p];
       }
@@ -298,8 +452,10 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
         } else {
           history.emplace_back(nullptr, kInvalidHistoryPlayer, action);
         }
-        std::cout << "player " << p << " chose "
-                  << state->ActionToString(p, action) << std::endl;
+          if (verbose) {
+          std::cout << "player " << p << " chose "
+                    << state->ActionToString(p, action) << std::endl;
+        }
 
         // Check the information state, if supported.
         if (infostate_vector_size > 0) {
@@ -317,10 +473,17 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
 
       ApplyActionTestClone(game, state.get(), joint_action);
       game_length++;
+      num_steps++;
+
+      if (undo && (history.size() < 10 || IsPowerOfTwo(history.size()))) {
+        TestUndo(state->Clone(), history);
+      }
     } else {
       std::vector<double> rewards = state->Rewards();
       SPIEL_CHECK_EQ(rewards.size(), game.NumPlayers());
-      std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      if (verbose) {
+        std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+      }
       for (auto p = Player{0}; p < game.NumPlayers(); ++p) {
         episode_returns[p] += rewards[p];
       }
@@ -333,17 +496,36 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
         std::vector<double> infostate_vector =
             state->InformationStateTensor(player);
         SPIEL_CHECK_EQ(infostate_vector.size(), infostate_vector_size);
+        std::vector<float> infostate_floats(infostate_vector_size);
+        state->InformationStateTensor(player, absl::MakeSpan(infostate_floats));
+        CheckFloatTensor(infostate_vector, infostate_floats);
+        if (game.InformationStateTensorIsSparse()) {
+          SparseTensor sparse;
+          state->SparseInformationStateTensor(player, &sparse);
+          CheckSparseTensor(infostate_vector, sparse);
+        }
       }
 
       // Check the observation state vector, if supported.
       if (observation_vector_size > 0) {
         std::vector<double> obs_vector = state->ObservationTensor(player);
         SPIEL_CHECK_EQ(obs_vector.size(), observation_vector_size);
+        std::vector<float> obs_floats(observation_vector_size);
+        state->ObservationTensor(player, absl::MakeSpan(obs_floats));
+        CheckFloatTensor(obs_vector, obs_floats);
+        if (game.ObservationTensorIsSparse()) {
+          SparseTensor sparse;
+          state->SparseObservationTensor(player, &sparse);
+          CheckSparseTensor(obs_vector, sparse);
+        }
       }
 
+      if (!state->IsTerminal()) AppendedStringsTest(*state, player);
+
       // Sample an action uniformly.
       std::vector<Action> actions = state->LegalActions();
       LegalActionsMaskTest(game, *state, actions);
+      LegalActionsBufferTest(*state, actions);
       if (state->IsTerminal())
         SPIEL_CHECK_TRUE(actions.empty());
       else
@@ -351,27 +533,35 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
       std::uniform_int_distribution<int> dis(0, actions.size() - 1);
       Action action = actions[dis(*rng)];
 
-      std::cout << "chose action: " << action << " ("
-                << state->ActionToString(player, action) << ")" << std::endl;
+      if (verbose) {
+        std::cout << "chose action: " << action << " ("
+                  << state->ActionToString(player, action) << ")"
+                  << std::endl;
+      }
 
       history.emplace_back(state->Clone(), player, action);
       ApplyActionTestClone(game, state.get(), action);
       game_length++;
+      num_steps++;
 
       if (undo && (history.size() < 10 || IsPowerOfTwo(history.size()))) {
         TestUndo(state->Clone(), history);
       }
     }
 
-    std::cout << "State: " << std::endl << state->ToString() << std::endl;
+    if (verbose) {
+      std::cout << "State: " << std::endl << state->ToString() << std::endl;
+    }
   }
 
   SPIEL_CHECK_LE(game_length, game.MaxGameLength());
 
-  std::cout << "Reached a terminal state!" << std::endl;
   SPIEL_CHECK_EQ(state->CurrentPlayer(), kTerminalPlayerId);
   std::vector<double> rewards = state->Rewards();
-  std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+  if (verbose) {
+    std::cout << "Reached a terminal state!" << std::endl;
+    std::cout << "Rewards: " << absl::StrJoin(rewards, " ") << std::endl;
+  }
 
   history.emplace_back(state->Clone(), kTerminalPlayerId,
                        kInvalidHistoryAction);
@@ -388,20 +578,30 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
 
   // Check that the returns satisfy the constraints based on the game type.
   CheckReturnsSum(game, *state);
+  CheckNoNegativeZeroReturns(*state);
 
   // Now, check each individual return is within bounds.
   auto returns = state->Returns();
   SPIEL_CHECK_EQ(returns.size(), game.NumPlayers());
+  // The span overloads agree with the vectors.
+  std::vector<double> values(game.NumPlayers());
+  state->Returns(absl::MakeSpan(values));
+  SPIEL_CHECK_TRUE(values == returns);
+  state->Rewards(absl::MakeSpan(values));
+  SPIEL_CHECK_TRUE(values == rewards);
   for (Player player = 0; player < game.NumPlayers(); player++) {
     double final_return = returns[player];
     SPIEL_CHECK_FLOAT_EQ(final_return, state->PlayerReturn(player));
     SPIEL_CHECK_GE(final_return, game.MinUtility());
     SPIEL_CHECK_LE(final_return, game.MaxUtility());
-    std::cout << "Final return to player " << player << " is " << final_return
-              << std::endl;
+    if (verbose) {
+      std::cout << "Final return to player " << player << " is "
+                << final_return << std::endl;
+    }
     episode_returns[player] += rewards[player];
     SPIEL_CHECK_TRUE(Near(episode_returns[player], final_return));
   }
+  return num_steps;
 }
 
 // Perform sims random simulations of the specified game.
@@ -432,14 +632,45 @@ void RandomSimTestNoSerialize(const Game& game, int num_sims) {
   }
 }
 
-// Format chance outcomes as a string, for error messages.
-std::string ChanceOutcomeStr(const ActionsAndProbs& chance_outcomes) {
-  std::string str;
-  for (auto outcome : chance_outcomes) {
-    if (!str.empty()) str.append(", ");
-    absl::StrAppend(&str, "(", outcome.first, ", ", outcome.second, ")");
+std::string RandomSimStats::ToString() const {
+  return absl::StrFormat(
+      "%d simulations, %d steps, %d threads, %.3fs: %.1f steps/s, "
+      "%.3fms per simulation (max %.3fms), %.2fus per step",
+      num_sims, num_steps, num_threads, wall_seconds, StepsPerSecond(),
+      1e3 * mean_sim_seconds, 1e3 * max_sim_seconds, 1e6 * SecondsPerStep());
+}
+
+RandomSimStats ParallelRandomSimTest(const Game& game, int num_sims,
+                                     const RandomSimOptions& options) {
+  SPIEL_CHECK_GE(num_sims, 0);
+  ThreadPool pool(options.num_threads);
+  std::cout << "ParallelRandomSimTest, game = " << game.GetType().short_name
+            << ", num_sims = " << num_sims
+            << ", num_threads = " << pool.NumThreads() << std::endl;
+  std::vector<double> sim_seconds(num_sims);
+  std::vector<int> sim_steps(num_sims);
+  const absl::Time start = absl::Now();
+  pool.ParallelFor(0, num_sims, [&](int sim) {
+    std::seed_seq seed{options.seed, sim};
+    std::mt19937 rng(seed);
+    const absl::Time sim_start = absl::Now();
+    sim_steps[sim] = RandomSimulation(&rng, game, options.undo,
+                                      options.serialize, /*verbose=*/false);
+    sim_seconds[sim] = absl::ToDoubleSeconds(absl::Now() - sim_start);
+  });
+
+  RandomSimStats stats;
+  stats.num_sims = num_sims;
+  stats.num_threads = pool.NumThreads();
+  stats.wall_seconds = absl::ToDoubleSeconds(absl::Now() - start);
+  for (int sim = 0; sim < num_sims; ++sim) {
+    stats.num_steps += sim_steps[sim];
+    stats.total_sim_seconds += sim_seconds[sim];
+    stats.max_sim_seconds = std::max(stats.max_sim_seconds, sim_seconds[sim]);
   }
-  return str;
+  if (num_sims > 0) stats.mean_sim_seconds = stats.total_sim_seconds / num_sims;
+  std::cout << stats.ToString() << std::endl;
+  return stats;
 }
 
 // Check chance outcomes in a state and all child states.
@@ -514,10 +745,43 @@ void CheckChanceOutcomes(const Game& game) {
   CheckChanceOutcomes(*game.NewInitialState());
 }
 
+void CheckInformationStateIndices(
+    const State& state,
+    std::unordered_map<int64_t, std::string>* index_to_string,
+    std::unordered_map<std::string, int64_t>* string_to_index) {
+  if (!state.IsChanceNode()) {
+    for (Player p = 0; p < state.NumPlayers(); ++p) {
+      const int64_t index = state.InformationStateIndex(p);
+      const std::string info_state = state.InformationStateString(p);
+      SPIEL_CHECK_GE(index, 0);
+      SPIEL_CHECK_LT(index, state.GetGame()->NumInformationStates());
+      // The first state seen with this index or string sets the expectation.
+      SPIEL_CHECK_EQ(index_to_string->emplace(index, info_state).first->second,
+                     info_state);
+      SPIEL_CHECK_EQ(string_to_index->emplace(info_state, index).first->second,
+                     index);
+    }
+  }
+  if (state.IsTerminal()) return;
+  for (auto action : state.LegalActions()) {
+    CheckInformationStateIndices(*state.Child(action), index_to_string,
+                                 string_to_index);
+  }
+}
+
+void CheckInformationStateIndices(const Game& game) {
+  SPIEL_CHECK_GT(game.NumInformationStates(), 0);
+  std::unordered_map<int64_t, std::string> index_to_string;
+  std::unordered_map<std::string, int64_t> string_to_index;
+  CheckInformationStateIndices(*game.NewInitialState(), &index_to_string,
+                               &string_to_index);
+}
+
 // Verifies that ResampleFromInfostate is correctly implemented.
 void ResampleInfostateTest(const Game& game, int num_sims) {
   std::mt19937 rng;
   UniformProbabilitySampler sampler;
+  const GameType& type = game.GetType();
   for (int i = 0; i < num_sims; ++i) {
     std::unique_ptr<State> state = game.NewInitialState();
     while (!state->IsTerminal()) {
@@ -525,11 +789,36 @@ void ResampleInfostateTest(const Game& game, int num_sims) {
         for (int p = 0; p < state->NumPlayers(); ++p) {
           std::unique_ptr<State> other_state =
               state->ResampleFromInfostate(p, sampler);
-          SPIEL_CHECK_EQ(state->InformationStateString(p),
-                         other_state->InformationStateString(p));
-          SPIEL_CHECK_EQ(state->InformationStateTensor(p),
-                         other_state->InformationStateTensor(p));
+          // The games without information states are checked on their
+          // observations, which are necessary but not sufficient.
+          if (type.provides_information_state_string) {
+            SPIEL_CHECK_EQ(state->InformationStateString(p),
+                           other_state->InformationStateString(p));
+          }
+          if (type.provides_information_state_tensor) {
+            SPIEL_CHECK_EQ(state->InformationStateTensor(p),
+                           other_state->InformationStateTensor(p));
+          }
+          if (type.provides_observation_string) {
+            SPIEL_CHECK_EQ(state->ObservationString(p),
+                           other_state->ObservationString(p));
+          }
+          if (type.provides_observation_tensor) {
+            SPIEL_CHECK_EQ(state->ObservationTensor(p),
+                           other_state->ObservationTensor(p));
+          }
           SPIEL_CHECK_EQ(state->CurrentPlayer(), other_state->CurrentPlayer());
+          if (state->CurrentPlayer() == p) {
+            SPIEL_CHECK_EQ(state->LegalActions(), other_state->LegalActions());
+          }
+          // The resampled state is the one its history leads to.
+          if (type.dynamics == GameType::Dynamics::kSequential) {
+            std::unique_ptr<State> replayed = game.NewInitialState();
+            for (Action action : other_state->History()) {
+              replayed->ApplyAction(action);
+            }
+            SPIEL_CHECK_EQ(replayed->ToString(), other_state->ToString());
+          }
         }
       }
       std::vector<Action> actions = state->LegalActions();
@@ -540,5 +829,12 @@ void ResampleInfostateTest(const Game& game, int num_sims) {
   }
 }
 
+std::string TempFilename(const std::string& name,
+                         const std::string& extension) {
+  const char* tmp_dir = std::getenv("TMPDIR");
+  return absl::StrCat(tmp_dir != nullptr ? tmp_dir : "/tmp", "/open_spiel-",
+                      name, "-", std::rand(), extension);  // NOLINT
+}
+
 }  // namespace testing
 }  // namespace open_spiel
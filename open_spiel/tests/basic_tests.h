@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_TESTS_BASIC_TESTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_TESTS_BASIC_TESTS_H_
 
+#include <cstdint>
 #include <random>
 #include <string>
 
@@ -43,11 +44,55 @@ void RandomSimTest(const Game& game, int num_sims);
 // is very slow! Please use sparingly.
 void RandomSimTestWithUndo(const Game& game, int num_sims);
 
+struct RandomSimOptions {
+  // The number of threads, or 0 for one per hardware thread.
+  int num_threads = 0;
+  int seed = 0;
+  // As in RandomSimTestWithUndo and RandomSimTestNoSerialize.
+  bool undo = false;
+  bool serialize = true;
+};
+
+// The timings of ParallelRandomSimTest. The time per step, which includes the
+// checks done at every step, can be tracked as a benchmark of the game.
+struct RandomSimStats {
+  int num_sims = 0;
+  int num_threads = 0;
+  // Actions applied, chance outcomes and joint actions included.
+  int64_t num_steps = 0;
+  double wall_seconds = 0;
+  // The sum, mean and max of the times of the individual simulations.
+  double total_sim_seconds = 0;
+  double mean_sim_seconds = 0;
+  double max_sim_seconds = 0;
+
+  double StepsPerSecond() const {
+    return wall_seconds > 0 ? num_steps / wall_seconds : 0;
+  }
+  double SecondsPerStep() const {
+    return num_steps > 0 ? total_sim_seconds / num_steps : 0;
+  }
+  std::string ToString() const;
+};
+
+// Runs the simulations of RandomSimTest (or its variants, see options) on a
+// pool of threads, printing only the stats. Simulation i has its own random
+// number generator seeded with (options.seed, i), so the games played do not
+// depend on the number of threads.
+RandomSimStats ParallelRandomSimTest(
+    const Game& game, int num_sims,
+    const RandomSimOptions& options = RandomSimOptions());
+
 // Check that chance outcomes are valid and consistent.
 // Performs an exhaustive search of the game tree, so should only be
 // used for smallish games.
 void CheckChanceOutcomes(const Game& game);
 
+// Checks that State::InformationStateIndex is in range and in one-to-one
+// correspondence with InformationStateString. Performs an exhaustive search of
+// the game tree, so should only be used for smallish games.
+void CheckInformationStateIndices(const Game& game);
+
 // Same as above but without checking the serialization functions. Every game
 // should support serialization: only use this function when developing a new
 // game, in order to test the implementation using the basic tests before having
@@ -58,6 +103,11 @@ void RandomSimTestNoSerialize(const Game& game, int num_sims);
 // Verifies that ResampleFromInfostate is correctly implemented.
 void ResampleInfostateTest(const Game& game, int num_sims);
 
+// Returns a path in $TMPDIR (or /tmp) for a test to write a file to, e.g.
+// TempFilename("cfr", ".ckpt") for a checkpoint.
+std::string TempFilename(const std::string& name,
+                         const std::string& extension);
+
 }  // namespace testing
 }  // namespace open_spiel
 
@@ -0,0 +1,100 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/chance_distribution.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+// The draws of a fine grid over [0, 1) must land on each outcome in
+// proportion to its probability.
+void CheckGridFrequencies(const ActionsAndProbs& outcomes) {
+  ChanceDistribution distribution(outcomes);
+  constexpr int kNumDraws = 100000;
+  absl::flat_hash_map<Action, int> counts;
+  for (int i = 0; i < kNumDraws; ++i) {
+    const auto [action, prob] = distribution.Sample((i + 0.5) / kNumDraws);
+    ++counts[action];
+    bool found = false;
+    for (const auto& [a, p] : outcomes) {
+      if (a == action) {
+        SPIEL_CHECK_EQ(prob, p);
+        found = true;
+      }
+    }
+    SPIEL_CHECK_TRUE(found);
+  }
+  for (const auto& [action, prob] : outcomes) {
+    SPIEL_CHECK_FLOAT_NEAR(static_cast<double>(counts[action]) / kNumDraws,
+                           prob, 1e-4);
+  }
+}
+
+void ChanceDistributionFrequencyTest() {
+  CheckGridFrequencies({{7, 1.0}});
+  CheckGridFrequencies({{0, 0.5}, {1, 0.25}, {2, 0.125}, {3, 0.125}});
+  CheckGridFrequencies({{3, 0.1}, {1, 0.6}, {8, 0.0}, {2, 0.3}});
+  // The backgammon rolls: doubles are half as likely as the others.
+  ActionsAndProbs rolls;
+  for (int i = 0; i < 21; ++i) {
+    rolls.push_back({i, i < 15 ? 1.0 / 18 : 1.0 / 36});
+  }
+  CheckGridFrequencies(rolls);
+}
+
+void ChanceDistributionMatchesSampleActionWhenUniformTest() {
+  ActionsAndProbs outcomes;
+  for (int i = 0; i < 6; ++i) outcomes.push_back({i + 1, 1.0 / 6});
+  ChanceDistribution distribution(outcomes);
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> uniform;
+  for (int i = 0; i < 1000; ++i) {
+    const double z = uniform(rng);
+    SPIEL_CHECK_EQ(distribution.Sample(z).first,
+                   SampleAction(outcomes, z).first);
+  }
+}
+
+void ChanceDistributionCacheTest() {
+  ChanceDistributionCache cache;
+  int num_builds = 0;
+  auto build = [&num_builds] {
+    ++num_builds;
+    return ActionsAndProbs{{0, 0.5}, {1, 0.5}};
+  };
+  const ChanceDistribution& first = cache.Get(3, build);
+  SPIEL_CHECK_EQ(&cache.Get(3, build), &first);
+  SPIEL_CHECK_EQ(num_builds, 1);
+  SPIEL_CHECK_NE(&cache.Get(4, build), &first);
+  SPIEL_CHECK_EQ(num_builds, 2);
+  SPIEL_CHECK_EQ(cache.size(), 2);
+  SPIEL_CHECK_EQ(first.outcomes().size(), 2);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::ChanceDistributionFrequencyTest();
+  open_spiel::ChanceDistributionMatchesSampleActionWhenUniformTest();
+  open_spiel::ChanceDistributionCacheTest();
+}
@@ -18,6 +18,7 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "open_spiel/games/kuhn_poker.h"
@@ -26,8 +27,10 @@
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/policy.h"
 #include "open_spiel/simultaneous_move_game.h"
+#include "open_spiel/spiel_bots.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace testing {
@@ -208,6 +211,147 @@ void PolicyTest() {
   }
 }
 
+// The alias tables must sample the actions with their probabilities, and
+// never those of probability 0.
+void ActionSamplerTest() {
+  const ActionsAndProbs actions_and_probs = {
+      {3, 0.5}, {7, 0.0}, {1, 0.125}, {4, 0.375}};
+  ActionSampler sampler(actions_and_probs);
+  SPIEL_CHECK_EQ(sampler.NumActions(), 4);
+  std::mt19937 rng(17);
+  constexpr int kNumSamples = 100000;
+  std::unordered_map<Action, int> counts;
+  for (int i = 0; i < kNumSamples; ++i) ++counts[sampler.Sample(rng)];
+  for (const auto& [action, prob] : actions_and_probs) {
+    SPIEL_CHECK_FLOAT_NEAR(static_cast<double>(counts[action]) / kNumSamples,
+                           prob, 0.01);
+  }
+  SPIEL_CHECK_EQ(counts[7], 0);
+
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+  TabularPolicySampler policy_sampler(policy);
+  for (const auto& [info_state, state_policy] : policy.PolicyTable()) {
+    SPIEL_CHECK_EQ(policy.FindStatePolicy(info_state), &state_policy);
+    const Action action = policy_sampler.Sample(info_state, rng);
+    SPIEL_CHECK_GT(GetProb(state_policy, action), 0);
+  }
+  SPIEL_CHECK_TRUE(policy.FindStatePolicy("not an information state") ==
+                   nullptr);
+  SPIEL_CHECK_TRUE(policy_sampler.Find("not an information state") ==
+                   nullptr);
+
+  // Only the information states that are looked up are checked, so a bot
+  // never reaching a malformed one plays as usual.
+  std::shared_ptr<const Game> kuhn = LoadGame("kuhn_poker");
+  TabularPolicy malformed = GetUniformPolicy(*kuhn);
+  malformed.PolicyTable()["never reached"] = {{0, 2.0}};
+  std::unique_ptr<Bot> bot =
+      MakePolicyBot(*kuhn, /*player_id=*/0, /*seed=*/3,
+                    std::make_unique<TabularPolicy>(malformed));
+  std::unique_ptr<State> state = kuhn->NewInitialState();
+  while (!state->IsTerminal()) {
+    state->ApplyAction(state->IsChanceNode() ? state->LegalActions()[0]
+                                             : bot->Step(*state));
+  }
+}
+
+void DenseTabularPolicyTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+  DenseTabularPolicy dense(policy);
+  SPIEL_CHECK_EQ(dense.NumInfoStates(), policy.PolicyTable().size());
+  for (const auto& [info_state, state_policy] : policy.PolicyTable()) {
+    SPIEL_CHECK_TRUE(dense.GetStatePolicy(info_state) == state_policy);
+    const int index = dense.InfoStateIndex(info_state);
+    SPIEL_CHECK_EQ(dense.InfoStateString(index), info_state);
+    SPIEL_CHECK_EQ(dense.StateActions(index).size(), state_policy.size());
+  }
+  SPIEL_CHECK_EQ(dense.InfoStateIndex("not an information state"), -1);
+  SPIEL_CHECK_TRUE(dense.GetStatePolicy("not an information state").empty());
+  TestPoliciesCanPlay(dense, *game);
+  SPIEL_CHECK_TRUE(dense.ToTabularPolicy().PolicyTable() ==
+                   policy.PolicyTable());
+
+  DenseTabularPolicy copy = DenseTabularPolicy::Deserialize(dense.Serialize());
+  SPIEL_CHECK_EQ(copy.NumInfoStates(), dense.NumInfoStates());
+  SPIEL_CHECK_TRUE(copy.ToTabularPolicy().PolicyTable() ==
+                   policy.PolicyTable());
+
+  // The probabilities can be changed in place.
+  absl::Span<double> probs = copy.MutableStateProbs(0);
+  probs[0] = 1;
+  for (int i = 1; i < probs.size(); ++i) probs[i] = 0;
+  SPIEL_CHECK_EQ(copy.GetStatePolicy(std::string(copy.InfoStateString(0)))
+                     .front().second, 1);
+}
+
+void ArrayTabularPolicyTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+  const int num_actions = game->NumDistinctActions();
+  std::unordered_map<std::string, int> state_lookup;
+  std::vector<std::vector<Action>> legal_actions;
+  std::vector<double> array;
+  for (const auto& [info_state, state_policy] : policy.PolicyTable()) {
+    state_lookup[info_state] = legal_actions.size();
+    legal_actions.emplace_back();
+    array.resize(array.size() + num_actions, 0);
+    for (const auto& [action, prob] : state_policy) {
+      legal_actions.back().push_back(action);
+      array[array.size() - num_actions + action] = prob;
+    }
+  }
+  ArrayTabularPolicy array_policy(state_lookup, legal_actions, array);
+  SPIEL_CHECK_EQ(array_policy.NumStates(), policy.PolicyTable().size());
+  SPIEL_CHECK_EQ(array_policy.NumActions(), num_actions);
+  for (const auto& [info_state, state_policy] : policy.PolicyTable()) {
+    SPIEL_CHECK_TRUE(array_policy.GetStatePolicy(info_state) == state_policy);
+  }
+  SPIEL_CHECK_TRUE(
+      array_policy.GetStatePolicy("not an information state").empty());
+  TestPoliciesCanPlay(array_policy, *game);
+
+  // Changes to the array are seen without building the policy again.
+  const auto& [info_state, state_policy] = *policy.PolicyTable().begin();
+  const Action first_action = state_policy.front().first;
+  for (const auto& [action, prob] : state_policy) {
+    array[state_lookup[info_state] * num_actions + action] =
+        action == first_action ? 1 : 0;
+  }
+  SPIEL_CHECK_EQ(array_policy.GetStatePolicy(info_state).front().second, 1);
+}
+
+// The policies of a batch must be those of the states queried one by one,
+// also when the buffer is reused.
+void GetStatePoliciesTest() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  TabularPolicy tabular = GetRandomPolicy(*game);
+  DenseTabularPolicy dense(tabular);
+  UniformPolicy uniform;
+  std::vector<std::unique_ptr<State>> states;
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::mt19937 rng(11);
+  while (!state->IsTerminal()) {
+    if (!state->IsChanceNode()) states.push_back(state->Clone());
+    state->ApplyAction(SampleAction(state->IsChanceNode()
+                                        ? state->ChanceOutcomes()
+                                        : uniform.GetStatePolicy(*state),
+                                    rng)
+                           .first);
+  }
+  std::vector<const State*> state_ptrs;
+  for (const auto& s : states) state_ptrs.push_back(s.get());
+  std::vector<ActionsAndProbs> policies(state_ptrs.size());
+  for (const Policy* policy :
+       std::vector<const Policy*>{&tabular, &dense, &uniform, &tabular}) {
+    policy->GetStatePolicies(state_ptrs, absl::MakeSpan(policies));
+    for (int i = 0; i < state_ptrs.size(); ++i) {
+      SPIEL_CHECK_TRUE(policies[i] == policy->GetStatePolicy(*state_ptrs[i]));
+    }
+  }
+}
+
 void LeducPokerDeserializeTest() {
   // Example Leduc state: player 1 gets the 0th card, player 2 gets the 3rd card
   // and the first two actions are: check, check.
@@ -282,6 +426,62 @@ void GameParametersTest() {
   SPIEL_CHECK_EQ(game2["param"].string_value(), "val");
 }
 
+void ParallelRandomSimTests() {
+  std::shared_ptr<const Game> game = LoadGame("leduc_poker");
+  RandomSimOptions options;
+  options.num_threads = 1;
+  RandomSimStats serial = ParallelRandomSimTest(*game, /*num_sims=*/50,
+                                                options);
+  SPIEL_CHECK_EQ(serial.num_sims, 50);
+  SPIEL_CHECK_EQ(serial.num_threads, 1);
+  SPIEL_CHECK_GT(serial.num_steps, 50);
+  SPIEL_CHECK_GE(serial.max_sim_seconds, serial.mean_sim_seconds);
+
+  // The games played only depend on the seed.
+  options.num_threads = 4;
+  options.serialize = false;
+  RandomSimStats parallel = ParallelRandomSimTest(*game, /*num_sims=*/50,
+                                                  options);
+  SPIEL_CHECK_EQ(parallel.num_threads, 4);
+  SPIEL_CHECK_EQ(parallel.num_steps, serial.num_steps);
+  options.seed = 1;
+  SPIEL_CHECK_NE(ParallelRandomSimTest(*game, /*num_sims=*/50, options)
+                     .num_steps,
+                 serial.num_steps);
+}
+
+void LoadGameCachedTest() {
+  std::shared_ptr<const Game> game = LoadGameCached("kuhn_poker");
+  SPIEL_CHECK_EQ(game->GetType().short_name, "kuhn_poker");
+  SPIEL_CHECK_TRUE(LoadGameCached("kuhn_poker()") == game);
+  SPIEL_CHECK_TRUE(LoadGameCached(GameParametersFromString("kuhn_poker")) ==
+                   game);
+  SPIEL_CHECK_TRUE(LoadGame("kuhn_poker") != game);
+
+  // Parameters are canonicalized, and different ones are different games.
+  std::shared_ptr<const Game> dice =
+      LoadGameCached("liars_dice(players=2,numdice=2)");
+  SPIEL_CHECK_EQ(dice->NumPlayers(), 2);
+  SPIEL_CHECK_TRUE(LoadGameCached("liars_dice(numdice=2,players=2)") == dice);
+  SPIEL_CHECK_TRUE(LoadGameCached("liars_dice(players=2,numdice=1)") != dice);
+
+  // Concurrent loads all get the same game.
+  ClearGameCache();
+  std::vector<std::shared_ptr<const Game>> games(8);
+  {
+    std::vector<Thread> threads;
+    for (int t = 0; t < games.size(); ++t) {
+      threads.emplace_back(
+          [&games, t]() { games[t] = LoadGameCached("tic_tac_toe"); });
+    }
+    for (Thread& thread : threads) thread.join();
+  }
+  for (const auto& loaded : games) SPIEL_CHECK_TRUE(loaded == games[0]);
+
+  ClearGameCache();
+  SPIEL_CHECK_TRUE(LoadGameCached("kuhn_poker") != game);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace open_spiel
@@ -290,8 +490,14 @@ int main(int argc, char** argv) {
   open_spiel::testing::GeneralTests();
   open_spiel::testing::KuhnTests();
   open_spiel::testing::TicTacToeTests();
+  open_spiel::testing::ParallelRandomSimTests();
   open_spiel::testing::FlatJointactionTest();
   open_spiel::testing::PolicyTest();
+  open_spiel::testing::ActionSamplerTest();
+  open_spiel::testing::DenseTabularPolicyTest();
+  open_spiel::testing::ArrayTabularPolicyTest();
+  open_spiel::testing::GetStatePoliciesTest();
   open_spiel::testing::LeducPokerDeserializeTest();
   open_spiel::testing::GameParametersTest();
+  open_spiel::testing::LoadGameCachedTest();
 }
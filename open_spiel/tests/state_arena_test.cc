@@ -0,0 +1,118 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/state_arena.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace testing {
+namespace {
+
+// Plays a random game from `state` with Child, returning its final state.
+std::unique_ptr<State> PlayRandomGame(std::unique_ptr<State> state,
+                                      std::mt19937* rng) {
+  while (!state->IsTerminal()) {
+    std::vector<Action> actions = state->LegalActions();
+    state = state->Child(actions[std::uniform_int_distribution<int>(
+        0, actions.size() - 1)(*rng)]);
+  }
+  return state;
+}
+
+void StatesInScopeUseTheArena() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  SPIEL_CHECK_TRUE(CurrentStateArena() == nullptr);
+  StateArena arena(/*block_size=*/256);
+  std::unique_ptr<State> outside = game->NewInitialState();
+  std::unique_ptr<State> state;
+  std::unique_ptr<State> clone;
+  {
+    StateArenaScope scope(&arena);
+    SPIEL_CHECK_TRUE(CurrentStateArena() == &arena);
+    state = game->NewInitialState();
+    SPIEL_CHECK_EQ(arena.NumLiveStates(), 1);
+    clone = outside->Clone();
+    clone->ApplyAction(4);
+    SPIEL_CHECK_EQ(arena.NumLiveStates(), 2);
+    {
+      StateArenaScope heap(nullptr);
+      SPIEL_CHECK_TRUE(CurrentStateArena() == nullptr);
+      std::unique_ptr<State> on_heap = game->NewInitialState();
+      SPIEL_CHECK_EQ(arena.NumLiveStates(), 2);
+    }
+    std::mt19937 rng(0);
+    std::unique_ptr<State> terminal = PlayRandomGame(clone->Clone(), &rng);
+    SPIEL_CHECK_TRUE(terminal->IsTerminal());
+    SPIEL_CHECK_EQ(terminal->History()[0], 4);
+  }
+  SPIEL_CHECK_TRUE(CurrentStateArena() == nullptr);
+  SPIEL_CHECK_EQ(arena.NumLiveStates(), 2);
+  SPIEL_CHECK_GT(arena.BytesAllocated(), 0);
+  SPIEL_CHECK_EQ(clone->ToString(), outside->Child(4)->ToString());
+
+  // The states can be deleted out of the scope, and then the arena reset.
+  state.reset();
+  clone.reset();
+  SPIEL_CHECK_EQ(arena.NumLiveStates(), 0);
+  const int64_t capacity = arena.Capacity();
+  arena.Reset();
+  SPIEL_CHECK_EQ(arena.BytesAllocated(), 0);
+
+  // The blocks are reused after a reset.
+  {
+    StateArenaScope scope(&arena);
+    std::mt19937 rng(0);
+    PlayRandomGame(game->NewInitialState(), &rng);
+  }
+  SPIEL_CHECK_EQ(arena.Capacity(), capacity);
+  SPIEL_CHECK_EQ(arena.NumLiveStates(), 0);
+}
+
+// Each thread plays games in its own arena, reset after each game.
+void ArenasPerThread() {
+  std::shared_ptr<const Game> game = LoadGame("tic_tac_toe");
+  std::vector<Thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&game, t]() {
+      StateArena arena;
+      std::mt19937 rng(t);
+      for (int i = 0; i < 100; ++i) {
+        {
+          StateArenaScope scope(&arena);
+          std::unique_ptr<State> state =
+              PlayRandomGame(game->NewInitialState(), &rng);
+          SPIEL_CHECK_TRUE(state->IsTerminal());
+        }
+        arena.Reset();
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::testing::StatesInScopeUseTheArena();
+  open_spiel::testing::ArenasPerThread();
+}
@@ -0,0 +1,221 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/card_deal.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+constexpr int kMaxCards = 64;
+
+// The binomial coefficients as doubles, since the numbers of deals of a deck
+// quickly overflow 64 bits.
+double Binomial(int n, int k) {
+  static const auto* table = [] {
+    auto* table =
+        new std::array<std::array<double, kMaxCards + 1>, kMaxCards + 1>();
+    for (int n = 0; n <= kMaxCards; ++n) {
+      (*table)[n][0] = 1;
+      for (int k = 1; k <= n; ++k) {
+        (*table)[n][k] = (*table)[n - 1][k - 1] + (*table)[n - 1][k];
+      }
+    }
+    return table;
+  }();
+  return (*table)[n][k];
+}
+
+int UniformIndex(int n, const std::function<double()>& rng) {
+  return std::min(static_cast<int>(rng() * n), n - 1);
+}
+
+// The bit of the n-th card of `cards`, in increasing order.
+uint64_t NthCard(uint64_t cards, int n) {
+  for (; n > 0; --n) cards &= cards - 1;
+  return cards & (~cards + 1);
+}
+
+}  // namespace
+
+uint64_t TakeRandomCards(uint64_t* cards, int count,
+                         const std::function<double()>& rng) {
+  int num_cards = __builtin_popcountll(*cards);
+  SPIEL_CHECK_LE(count, num_cards);
+  uint64_t taken = 0;
+  for (int i = 0; i < count; ++i) {
+    const uint64_t card = NthCard(*cards, UniformIndex(num_cards--, rng));
+    *cards &= ~card;
+    taken |= card;
+  }
+  return taken;
+}
+
+absl::InlinedVector<uint64_t, 4> DealCards(
+    uint64_t cards, absl::Span<const int> hand_sizes,
+    absl::Span<const uint64_t> excluded_cards,
+    const std::function<double()>& rng) {
+  const int num_hands = hand_sizes.size();
+  SPIEL_CHECK_TRUE(excluded_cards.empty() ||
+                   excluded_cards.size() == num_hands);
+  int num_cards = 0;
+  for (int size : hand_sizes) {
+    SPIEL_CHECK_GE(size, 0);
+    num_cards += size;
+  }
+  SPIEL_CHECK_EQ(num_cards, __builtin_popcountll(cards));
+
+  // The cards are dealt to holders: one per hand with excluded cards, and one
+  // shared by the others, whose cards are split between them at the end.
+  // Unused holders get no cards.
+  std::array<int, kMaxConstrainedHands> holder_size{};
+  std::array<uint64_t, kMaxConstrainedHands> holder_excluded;
+  holder_excluded.fill(~uint64_t{0});
+  absl::InlinedVector<int, 4> holder(num_hands, -1);
+  int num_holders = 0;
+  auto new_holder = [&num_holders]() {
+    if (num_holders == kMaxConstrainedHands) {
+      SpielFatalError("Too many hands with excluded cards to deal.");
+    }
+    return num_holders++;
+  };
+  for (int h = 0; h < num_hands; ++h) {
+    if (!excluded_cards.empty() && (excluded_cards[h] & cards) != 0) {
+      holder[h] = new_holder();
+      holder_size[holder[h]] = hand_sizes[h];
+      holder_excluded[holder[h]] = excluded_cards[h] & cards;
+    }
+  }
+  int shared_holder = -1;
+  for (int h = 0; h < num_hands; ++h) {
+    if (holder[h] >= 0) continue;
+    if (shared_holder < 0) {
+      shared_holder = new_holder();
+      holder_excluded[shared_holder] = 0;
+    }
+    holder[h] = shared_holder;
+    holder_size[shared_holder] += hand_sizes[h];
+  }
+
+  // Groups the cards by the set of holders which may get them.
+  std::array<uint64_t, 1 << kMaxConstrainedHands> groups{};
+  for (uint64_t rest = cards; rest != 0; rest &= rest - 1) {
+    const int card = __builtin_ctzll(rest);
+    int holders = 0;
+    for (int i = 0; i < kMaxConstrainedHands; ++i) {
+      if (((holder_excluded[i] >> card) & 1) == 0) holders |= 1 << i;
+    }
+    groups[holders] |= uint64_t{1} << card;
+  }
+  if (groups[0] != 0) SpielFatalError("No deal avoids the excluded cards.");
+  std::vector<int> group_holders;
+  for (int holders = 1; holders < groups.size(); ++holders) {
+    if (groups[holders] != 0) group_holders.push_back(holders);
+  }
+  const int num_groups = group_holders.size();
+  std::vector<int> cards_left(num_groups + 1, 0);
+  for (int g = num_groups - 1; g >= 0; --g) {
+    cards_left[g] =
+        cards_left[g + 1] + __builtin_popcountll(groups[group_holders[g]]);
+  }
+
+  // ways[g][a][b] is the number of deals of the groups from g on, when the
+  // first two holders have room for a and b more cards, and the third for the
+  // rest.
+  const int size0 = holder_size[0];
+  const int size1 = holder_size[1];
+  std::vector<double> ways((num_groups + 1) * (size0 + 1) * (size1 + 1), 0);
+  auto index = [size0, size1](int g, int a, int b) {
+    return (g * (size0 + 1) + a) * (size1 + 1) + b;
+  };
+  // Calls f(n0, n1, weight) for each number of cards n0 and n1 of group g
+  // given to the first two holders, the third taking the rest.
+  auto for_each_split = [&](int g, int a, int b, auto f) {
+    const int room2 = cards_left[g] - a - b;
+    if (room2 < 0) return;
+    const int holders = group_holders[g];
+    const int n = __builtin_popcountll(groups[holders]);
+    const int max0 = (holders & 1) ? std::min(a, n) : 0;
+    for (int n0 = 0; n0 <= max0; ++n0) {
+      const int max1 = (holders & 2) ? std::min(b, n - n0) : 0;
+      for (int n1 = 0; n1 <= max1; ++n1) {
+        const int n2 = n - n0 - n1;
+        if (n2 > room2 || (n2 > 0 && !(holders & 4))) continue;
+        f(n0, n1,
+          Binomial(n, n0) * Binomial(n - n0, n1) *
+              ways[index(g + 1, a - n0, b - n1)]);
+      }
+    }
+  };
+  ways[index(num_groups, 0, 0)] = 1;
+  for (int g = num_groups - 1; g >= 0; --g) {
+    for (int a = 0; a <= size0; ++a) {
+      for (int b = 0; b <= size1; ++b) {
+        double total = 0;
+        for_each_split(g, a, b,
+                       [&total](int, int, double weight) { total += weight; });
+        ways[index(g, a, b)] = total;
+      }
+    }
+  }
+  if (ways[index(0, size0, size1)] == 0) {
+    SpielFatalError("No deal avoids the excluded cards.");
+  }
+
+  std::array<uint64_t, kMaxConstrainedHands> dealt{};
+  int a = size0;
+  int b = size1;
+  for (int g = 0; g < num_groups; ++g) {
+    double z = rng() * ways[index(g, a, b)];
+    int chosen0 = -1;
+    int chosen1 = -1;
+    for_each_split(g, a, b, [&](int n0, int n1, double weight) {
+      if (weight > 0 && (chosen0 < 0 || z >= 0)) {
+        chosen0 = n0;
+        chosen1 = n1;
+      }
+      z -= weight;
+    });
+    uint64_t group = groups[group_holders[g]];
+    dealt[0] |= TakeRandomCards(&group, chosen0, rng);
+    dealt[1] |= TakeRandomCards(&group, chosen1, rng);
+    dealt[2] |= group;
+    a -= chosen0;
+    b -= chosen1;
+  }
+
+  absl::InlinedVector<uint64_t, 4> hands(num_hands, 0);
+  int shared_sizes_left = shared_holder < 0 ? 0 : holder_size[shared_holder];
+  for (int h = 0; h < num_hands; ++h) {
+    if (holder[h] != shared_holder) {
+      hands[h] = dealt[holder[h]];
+    } else {
+      // The last of these hands takes what is left, without drawing.
+      shared_sizes_left -= hand_sizes[h];
+      hands[h] = shared_sizes_left == 0
+                     ? std::exchange(dealt[shared_holder], 0)
+                     : TakeRandomCards(&dealt[shared_holder], hand_sizes[h],
+                                       rng);
+    }
+  }
+  return hands;
+}
+
+}  // namespace open_spiel
@@ -0,0 +1,55 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_CARD_DEAL_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_CARD_DEAL_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "open_spiel/abseil-cpp/absl/container/inlined_vector.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+
+// Dealing the hidden cards of a card game again, for the implementations of
+// State::ResampleFromInfostate. Sets of cards are bitsets, with bit c set for
+// card c, of up to 64 cards.
+
+namespace open_spiel {
+
+// The most hands that can have excluded cards in a deal, counting all the
+// hands without any as one.
+inline constexpr int kMaxConstrainedHands = 3;
+
+// Deals `cards` into hands of the given sizes, which add up to the number of
+// cards, uniformly at random among the deals in which no hand gets any of its
+// `excluded_cards`, e.g. the suits that a player was seen not to follow.
+// excluded_cards is either empty or has one set per hand.
+//
+// The deal is drawn directly rather than by rejection: the cards are grouped
+// by the hands that may get them, and the number of cards of each group going
+// to each hand is drawn in proportion to the number of deals completing it.
+// rng returns doubles in [0, 1), as for ResampleFromInfostate. Fails if no
+// deal meets the exclusions.
+absl::InlinedVector<uint64_t, 4> DealCards(
+    uint64_t cards, absl::Span<const int> hand_sizes,
+    absl::Span<const uint64_t> excluded_cards,
+    const std::function<double()>& rng);
+
+// Removes `count` cards drawn uniformly from `*cards`, and returns them.
+uint64_t TakeRandomCards(uint64_t* cards, int count,
+                         const std::function<double()>& rng);
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_CARD_DEAL_H_
@@ -0,0 +1,107 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/card_deal.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+std::function<double()> MakeRng(int seed) {
+  auto gen = std::make_shared<std::mt19937>(seed);
+  return [gen] { return std::uniform_real_distribution<double>()(*gen); };
+}
+
+void TakeRandomCardsTest() {
+  std::function<double()> rng = MakeRng(0);
+  uint64_t cards = 0xF0F0;
+  const uint64_t taken = TakeRandomCards(&cards, 3, rng);
+  SPIEL_CHECK_EQ(__builtin_popcountll(taken), 3);
+  SPIEL_CHECK_EQ(taken & cards, 0);
+  SPIEL_CHECK_EQ(taken | cards, 0xF0F0);
+}
+
+void DealMeetsSizesAndExclusionsTest() {
+  std::function<double()> rng = MakeRng(1);
+  // A bridge deal of three hidden hands, the first void in the first suit
+  // and the last void in the two others, as seen from the player holding
+  // the lowest 13 cards.
+  const uint64_t cards = ((uint64_t{1} << 52) - 1) & ~uint64_t{0x1FFF};
+  const std::vector<int> sizes = {13, 13, 13};
+  const uint64_t suit0 = 0x1111111111111;
+  const uint64_t suit1 = suit0 << 1;
+  const uint64_t suit2 = suit0 << 2;
+  const std::vector<uint64_t> excluded = {suit0, 0, suit1 | suit2};
+  for (int i = 0; i < 100; ++i) {
+    auto hands = DealCards(cards, sizes, excluded, rng);
+    SPIEL_CHECK_EQ(hands.size(), 3);
+    uint64_t dealt = 0;
+    for (int h = 0; h < 3; ++h) {
+      SPIEL_CHECK_EQ(__builtin_popcountll(hands[h]), sizes[h]);
+      SPIEL_CHECK_EQ(hands[h] & excluded[h], 0);
+      SPIEL_CHECK_EQ(hands[h] & dealt, 0);
+      dealt |= hands[h];
+    }
+    SPIEL_CHECK_EQ(dealt, cards);
+  }
+}
+
+void DealIsUniformTest() {
+  std::function<double()> rng = MakeRng(2);
+  // Hand 0 excludes card 0, so gets two of cards 1 to 3, and hands 1 and 2
+  // share the others. The 3 * 2 deals are equally likely.
+  const std::vector<int> sizes = {2, 1, 1};
+  const std::vector<uint64_t> excluded = {1, 0, 0};
+  std::map<std::vector<uint64_t>, int> counts;
+  constexpr int kNumDeals = 60000;
+  for (int i = 0; i < kNumDeals; ++i) {
+    auto hands = DealCards(0xF, sizes, excluded, rng);
+    ++counts[std::vector<uint64_t>(hands.begin(), hands.end())];
+  }
+  SPIEL_CHECK_EQ(counts.size(), 6);
+  for (const auto& [hands, count] : counts) {
+    SPIEL_CHECK_EQ(hands[0] & 1, 0);
+    SPIEL_CHECK_FLOAT_NEAR(count / static_cast<double>(kNumDeals), 1.0 / 6,
+                           0.01);
+  }
+}
+
+void DealWithoutExclusionsTest() {
+  std::function<double()> rng = MakeRng(3);
+  const std::vector<int> sizes = {3, 0, 4, 1, 2};
+  auto hands = DealCards(0x3FF, sizes, {}, rng);
+  uint64_t dealt = 0;
+  for (int h = 0; h < sizes.size(); ++h) {
+    SPIEL_CHECK_EQ(__builtin_popcountll(hands[h]), sizes[h]);
+    dealt |= hands[h];
+  }
+  SPIEL_CHECK_EQ(dealt, 0x3FF);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TakeRandomCardsTest();
+  open_spiel::DealMeetsSizesAndExclusionsTest();
+  open_spiel::DealIsUniformTest();
+  open_spiel::DealWithoutExclusionsTest();
+}
@@ -14,8 +14,12 @@
 
 #include "open_spiel/utils/data_logger.h"
 
+#include <cstring>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/abseil-cpp/absl/time/clock.h"
 #include "open_spiel/abseil-cpp/absl/time/time.h"
 #include "open_spiel/spiel_utils.h"
@@ -48,4 +52,250 @@ void DataLoggerJsonLines::Flush() { fd_.Flush(); }
 
 DataLoggerJsonLines::~DataLoggerJsonLines() { Flush(); }
 
+namespace {
+
+constexpr char kBinaryMagic[] = "OSDL";
+constexpr uint32_t kBinaryVersion = 1;
+constexpr char kSchemaBlock = 'S';
+constexpr char kRecordBlock = 'R';
+
+enum FieldType : uint8_t {
+  kNullField,
+  kBoolField,
+  kIntField,
+  kDoubleField,
+  kStringField,
+  kJsonField,
+};
+
+FieldType TypeOf(const json::Value& value) {
+  if (value.IsNull()) return kNullField;
+  if (value.IsBool()) return kBoolField;
+  if (value.IsInt()) return kIntField;
+  if (value.IsDouble()) return kDoubleField;
+  if (value.IsString()) return kStringField;
+  return kJsonField;
+}
+
+template <class T>
+void Append(T value, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendString(absl::string_view str, std::string* out) {
+  Append<uint32_t>(str.size(), out);
+  out->append(str.data(), str.size());
+}
+
+// Reads the values appended above, failing on a truncated file.
+class Reader {
+ public:
+  explicit Reader(absl::string_view data) : data_(data) {}
+
+  bool Done() const { return data_.empty(); }
+
+  template <class T>
+  T Read() {
+    T value;
+    std::memcpy(&value, Take(sizeof(value)).data(), sizeof(value));
+    return value;
+  }
+
+  std::string ReadString() { return std::string(Take(Read<uint32_t>())); }
+
+  absl::string_view Take(int size) {
+    if (size > data_.size()) {
+      SpielFatalError("Truncated DataLoggerBinary file.");
+    }
+    absl::string_view out = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return out;
+  }
+
+ private:
+  absl::string_view data_;
+};
+
+}  // namespace
+
+DataLoggerBinary::DataLoggerBinary(const std::string& path,
+                                   const std::string& name, bool flush)
+    : fd_(absl::StrFormat("%s/%s.bin", path, name), "wb"),
+      flush_(flush),
+      start_time_(absl::Now()),
+      writer_([this]() { WriterLoop(); }) {}
+
+DataLoggerBinary::~DataLoggerBinary() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+    work_cv_.Signal();
+  }
+  writer_.join();
+}
+
+void DataLoggerBinary::Write(DataLogger::Record record) {
+  absl::Time now = absl::Now();
+  absl::MutexLock lock(&mu_);
+  queue_.push_back({std::move(record), now});
+  ++num_queued_;
+  // The writer only waits once the queue is empty.
+  if (queue_.size() == 1) work_cv_.Signal();
+}
+
+void DataLoggerBinary::Flush() {
+  absl::MutexLock lock(&mu_);
+  flush_target_ = std::max(flush_target_, num_queued_);
+  work_cv_.Signal();
+  while (num_flushed_ < flush_target_) flushed_cv_.Wait(&mu_);
+}
+
+void DataLoggerBinary::WriterLoop() {
+  std::vector<Entry> batch;
+  std::string buffer(kBinaryMagic, 4);
+  Append(kBinaryVersion, &buffer);
+  Append<int64_t>(absl::ToUnixMicros(start_time_), &buffer);
+  while (true) {
+    bool stop;
+    bool flush;
+    int64_t num_written;
+    {
+      absl::MutexLock lock(&mu_);
+      while (queue_.empty() && !stop_ && flush_target_ <= num_flushed_) {
+        work_cv_.Wait(&mu_);
+      }
+      batch.swap(queue_);
+      stop = stop_;
+      flush = flush_ || stop_ || flush_target_ > num_flushed_;
+      num_written = num_queued_;
+    }
+
+    for (const Entry& entry : batch) Encode(entry, &buffer);
+    batch.clear();
+    fd_.Write(buffer);
+    buffer.clear();
+    if (flush) {
+      fd_.Flush();
+      absl::MutexLock lock(&mu_);
+      num_flushed_ = num_written;
+      flushed_cv_.SignalAll();
+    }
+    if (stop) return;
+  }
+}
+
+void DataLoggerBinary::Encode(const Entry& entry, std::string* out) {
+  std::vector<std::pair<std::string, uint8_t>> fields;
+  fields.reserve(entry.record.size());
+  for (const auto& [key, value] : entry.record) {
+    fields.emplace_back(key, TypeOf(value));
+  }
+  auto [it, inserted] = schemas_.try_emplace(fields, schemas_.size());
+  const uint32_t schema_id = it->second;
+  if (inserted) {
+    out->push_back(kSchemaBlock);
+    Append(schema_id, out);
+    Append<uint32_t>(fields.size(), out);
+    for (const auto& [key, type] : fields) {
+      Append(type, out);
+      AppendString(key, out);
+    }
+  }
+
+  out->push_back(kRecordBlock);
+  Append(schema_id, out);
+  Append<int64_t>(absl::ToUnixMicros(entry.time), out);
+  for (const auto& [key, value] : entry.record) {
+    switch (TypeOf(value)) {
+      case kNullField:
+        break;
+      case kBoolField:
+        Append<uint8_t>(value.GetBool(), out);
+        break;
+      case kIntField:
+        Append(value.GetInt(), out);
+        break;
+      case kDoubleField:
+        Append(value.GetDouble(), out);
+        break;
+      case kStringField:
+        AppendString(value.GetString(), out);
+        break;
+      case kJsonField:
+        AppendString(json::ToString(value), out);
+        break;
+    }
+  }
+}
+
+std::vector<DataLogger::Record> ReadDataLoggerBinary(
+    const std::string& filename) {
+  static absl::TimeZone utc = absl::UTCTimeZone();
+  file::MappedFile file(filename);
+  Reader reader(file.Contents());
+  if (reader.Take(4) != absl::string_view(kBinaryMagic, 4)) {
+    SpielFatalError(absl::StrCat("Not a DataLoggerBinary file: ", filename));
+  }
+  const uint32_t version = reader.Read<uint32_t>();
+  if (version != kBinaryVersion) {
+    SpielFatalError(absl::StrCat("Unsupported DataLoggerBinary version: ",
+                                 version));
+  }
+  const absl::Time start_time = absl::FromUnixMicros(reader.Read<int64_t>());
+
+  std::vector<std::vector<std::pair<std::string, uint8_t>>> schemas;
+  std::vector<DataLogger::Record> records;
+  while (!reader.Done()) {
+    const char block = reader.Read<char>();
+    const uint32_t schema_id = reader.Read<uint32_t>();
+    if (block == kSchemaBlock) {
+      SPIEL_CHECK_EQ(schema_id, schemas.size());
+      std::vector<std::pair<std::string, uint8_t>>& fields =
+          schemas.emplace_back(reader.Read<uint32_t>());
+      for (auto& [key, type] : fields) {
+        type = reader.Read<uint8_t>();
+        key = reader.ReadString();
+      }
+    } else if (block == kRecordBlock) {
+      SPIEL_CHECK_LT(schema_id, schemas.size());
+      const absl::Time time = absl::FromUnixMicros(reader.Read<int64_t>());
+      DataLogger::Record& record = records.emplace_back();
+      for (const auto& [key, type] : schemas[schema_id]) {
+        json::Value& value = record[key];
+        switch (type) {
+          case kNullField:
+            break;
+          case kBoolField:
+            value = static_cast<bool>(reader.Read<uint8_t>());
+            break;
+          case kIntField:
+            value = reader.Read<int64_t>();
+            break;
+          case kDoubleField:
+            value = reader.Read<double>();
+            break;
+          case kStringField:
+            value = reader.ReadString();
+            break;
+          case kJsonField:
+            value = *json::FromString(reader.ReadString());
+            break;
+          default:
+            SpielFatalError(
+                absl::StrCat("Unknown field type: ", static_cast<int>(type)));
+        }
+      }
+      record.insert({
+          {"time_str", absl::FormatTime("%Y-%m-%d %H:%M:%E3S %z", time, utc)},
+          {"time_abs", absl::ToUnixMicros(time) / 1000000.},
+          {"time_rel", absl::ToDoubleSeconds(time - start_time)},
+      });
+    } else {
+      SpielFatalError(absl::StrCat("Unknown DataLoggerBinary block: ",
+                                   static_cast<int>(block)));
+    }
+  }
+  return records;
+}
+
 }  // namespace open_spiel
@@ -75,9 +75,59 @@ void TestDataLogger() {
   SPIEL_CHECK_TRUE(file::Remove(dir));
 }
 
+void TestDataLoggerBinary() {
+  std::string val = std::to_string(std::rand());  // NOLINT
+  std::string tmp_dir = GetEnv("TMPDIR", "/tmp");
+  std::string dir = tmp_dir + "/open_spiel-test-" + val;
+  std::string filename = dir + "/data-test.bin";
+  SPIEL_CHECK_TRUE(file::Mkdir(dir));
+
+  {
+    DataLoggerBinary logger(dir, "data-test");
+    logger.Write({{"step", 1}, {"avg", 1.5}, {"name", "a"}});
+    logger.Flush();
+    SPIEL_CHECK_EQ(ReadDataLoggerBinary(filename).size(), 1);
+    logger.Write({{"step", 2}, {"avg", 2.5}, {"name", "b"}});
+    logger.Write({{"done", true}, {"list", json::Array({1, 2})},
+                  {"none", json::Null()}});
+    for (int i = 3; i < 100; ++i) {
+      logger.Write({{"step", i}, {"avg", i + 0.5}, {"name", "c"}});
+    }
+  }
+
+  std::vector<DataLogger::Record> records = ReadDataLoggerBinary(filename);
+  SPIEL_CHECK_EQ(records.size(), 100);
+
+  json::Object& obj1 = records[0];
+  SPIEL_CHECK_EQ(obj1["step"], 1);
+  SPIEL_CHECK_EQ(obj1["avg"], 1.5);
+  SPIEL_CHECK_EQ(obj1["name"], "a");
+  SPIEL_CHECK_TRUE(obj1["time_str"].IsString());
+  SPIEL_CHECK_GT(obj1["time_abs"].GetDouble(), 1'500'000'000);  // July 2017
+  SPIEL_CHECK_GE(obj1["time_rel"].GetDouble(), 0);
+
+  json::Object& obj2 = records[1];
+  SPIEL_CHECK_EQ(obj2["step"], 2);
+  SPIEL_CHECK_EQ(obj2["name"], "b");
+  SPIEL_CHECK_LE(obj1["time_abs"].GetDouble(), obj2["time_abs"].GetDouble());
+
+  json::Object& obj3 = records[2];
+  SPIEL_CHECK_EQ(obj3.size(), 6);
+  SPIEL_CHECK_EQ(obj3["done"], true);
+  SPIEL_CHECK_EQ(obj3["list"], json::Array({1, 2}));
+  SPIEL_CHECK_TRUE(obj3["none"].IsNull());
+
+  SPIEL_CHECK_EQ(records[99]["step"], 99);
+  SPIEL_CHECK_EQ(records[99]["avg"], 99.5);
+
+  SPIEL_CHECK_TRUE(file::Remove(filename));
+  SPIEL_CHECK_TRUE(file::Remove(dir));
+}
+
 }  // namespace
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::TestDataLogger();
+  open_spiel::TestDataLoggerBinary();
 }
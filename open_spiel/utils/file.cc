@@ -14,10 +14,15 @@
 
 #include "open_spiel/utils/file.h"
 
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #ifdef _WIN32
 // https://stackoverflow.com/a/42906151
 #include <windows.h>
@@ -27,6 +32,7 @@
 #endif
 
 #include <cstdio>
+#include <utility>
 
 #include "open_spiel/spiel_utils.h"
 
@@ -81,6 +87,84 @@ std::int64_t File::Length() {
   return length;
 }
 
+MappedFile::MappedFile(const std::string& filename) {
+#ifdef _WIN32
+  contents_ = File(filename, "rb").ReadContents();
+  data_ = contents_.data();
+  size_ = contents_.size();
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  SPIEL_CHECK_GE(fd, 0);
+  struct stat info;
+  SPIEL_CHECK_EQ(fstat(fd, &info), 0);
+  size_ = info.st_size;
+  if (size_ > 0) {  // Empty files can't be mapped.
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    SPIEL_CHECK_NE(data, MAP_FAILED);
+    data_ = static_cast<const char*>(data);
+  }
+  close(fd);  // The mapping stays valid.
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+  if (this != &other) {
+    Unmap();
+    contents_ = std::move(other.contents_);
+    data_ = contents_.empty() ? other.data_ : contents_.data();
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { Unmap(); }
+
+void MappedFile::Unmap() {
+#ifndef _WIN32
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+BufferedWriter::BufferedWriter(const std::string& filename,
+                               const std::string& mode, int buffer_size)
+    : file_(filename, mode), buffer_size_(buffer_size) {
+  SPIEL_CHECK_GT(buffer_size, 0);
+  buffer_.reserve(buffer_size_);
+}
+
+BufferedWriter::~BufferedWriter() {
+  // Moved from writers have nothing left to write.
+  if (!buffer_.empty()) WriteBuffer();
+}
+
+bool BufferedWriter::Write(absl::string_view str) {
+  if (buffer_.size() + str.size() > buffer_size_) {
+    if (!WriteBuffer()) return false;
+    // Large writes go straight to the file rather than through the buffer.
+    if (str.size() >= buffer_size_) return file_.Write(str);
+  }
+  buffer_.append(str.data(), str.size());
+  return true;
+}
+
+bool BufferedWriter::WriteBuffer() {
+  bool ok = file_.Write(buffer_);
+  buffer_.clear();
+  return ok;
+}
+
+bool BufferedWriter::Flush() { return WriteBuffer() && file_.Flush(); }
+
+std::int64_t BufferedWriter::Tell() { return file_.Tell() + buffer_.size(); }
+
 bool Exists(const std::string& path) {
   struct stat info;
   return stat(path.c_str(), &info) == 0;
@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_FILE_H_
 #define THIRD_PARTY_OPEN_SPIEL_UTILS_FILE_H_
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -54,6 +55,62 @@ class File {
   std::unique_ptr<FileImpl> fd_;
 };
 
+// A read-only view of the entire contents of a file, memory mapped where
+// supported, so large files can be used without copying them through strings.
+// The contents are valid for the lifetime of the MappedFile.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& filename);
+
+  // MappedFile is move only.
+  MappedFile(MappedFile&& other);
+  MappedFile& operator=(MappedFile&& other);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile();  // Unmap.
+
+  absl::string_view Contents() const { return {data_, size_}; }
+  std::int64_t Length() const { return size_; }
+
+ private:
+  void Unmap();
+
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::string contents_;  // Used instead where mmap isn't available.
+};
+
+// Writes to a file through a large buffer, so that many small writes, e.g. one
+// per record, turn into few large block writes.
+class BufferedWriter {
+ public:
+  explicit BufferedWriter(const std::string& filename,
+                          const std::string& mode = "w",
+                          int buffer_size = 1 << 20);
+
+  // BufferedWriter is move only.
+  BufferedWriter(BufferedWriter&& other) = default;
+  BufferedWriter& operator=(BufferedWriter&& other) = default;
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  ~BufferedWriter();  // Flush and Close.
+
+  bool Write(absl::string_view str);  // Write to the buffer.
+  bool Flush();  // Write the buffer to the file, and flush it to disk.
+
+  // Offset of the current point in the file, including the buffer.
+  std::int64_t Tell();
+
+ private:
+  bool WriteBuffer();
+
+  File file_;
+  std::string buffer_;
+  std::size_t buffer_size_;
+};
+
 bool Exists(const std::string& path);  // Does the file/directory exist?
 bool IsDirectory(const std::string& path);  // Is it a directory?
 bool Mkdir(const std::string& path, int mode = 0755);  // Make a directory.
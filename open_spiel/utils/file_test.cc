@@ -74,6 +74,15 @@ void TestFile() {
     File f3(std::move(f2));
   }
 
+  {
+    MappedFile f(filename);
+    SPIEL_CHECK_EQ(f.Length(), expected.size());
+    SPIEL_CHECK_EQ(f.Contents(), expected);
+    MappedFile f2 = std::move(f);
+    SPIEL_CHECK_EQ(f2.Contents(), expected);
+    SPIEL_CHECK_EQ(f.Length(), 0);
+  }
+
   SPIEL_CHECK_TRUE(Remove(filename));
   SPIEL_CHECK_FALSE(Remove(filename));  // already gone
   SPIEL_CHECK_FALSE(Exists(filename));
@@ -90,9 +99,44 @@ void TestFile() {
   SPIEL_CHECK_FALSE(Exists(dir));
 }
 
+void TestBufferedWriter() {
+  std::string val = std::to_string(std::rand());  // NOLINT
+  std::string tmp_dir = GetEnv("TMPDIR", "/tmp");
+  std::string filename = tmp_dir + "/open_spiel-test-" + val + ".txt";
+
+  std::string expected;
+  {
+    BufferedWriter writer(filename, "w", /*buffer_size=*/16);
+    for (int i = 0; i < 100; ++i) {
+      std::string line = std::string(i % 20, 'a' + i % 26) + "\n";
+      SPIEL_CHECK_TRUE(writer.Write(line));
+      expected += line;
+      SPIEL_CHECK_EQ(writer.Tell(), expected.size());
+    }
+    SPIEL_CHECK_TRUE(writer.Flush());
+    MappedFile f(filename);
+    SPIEL_CHECK_EQ(f.Contents(), expected);
+    SPIEL_CHECK_TRUE(writer.Write("unflushed"));
+    expected += "unflushed";
+  }
+  {
+    MappedFile f(filename);
+    SPIEL_CHECK_EQ(f.Contents(), expected);
+  }
+
+  { File f(filename, "w"); }
+  {
+    MappedFile f(filename);
+    SPIEL_CHECK_EQ(f.Length(), 0);
+    SPIEL_CHECK_TRUE(f.Contents().empty());
+  }
+  SPIEL_CHECK_TRUE(Remove(filename));
+}
+
 }  // namespace
 }  // namespace open_spiel::file
 
 int main(int argc, char** argv) {
   open_spiel::file::TestFile();
+  open_spiel::file::TestBufferedWriter();
 }
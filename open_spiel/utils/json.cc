@@ -14,13 +14,18 @@
 
 #include "open_spiel/utils/json.h"
 
+#include <charconv>
 #include <cmath>
 #include <cstdint>
+#include <iterator>
 #include <optional>
 #include <string>
+#include <system_error>
 
-#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/charconv.h"
+#include "open_spiel/abseil-cpp/absl/strings/match.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
 #include "open_spiel/abseil-cpp/absl/strings/string_view.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -28,214 +33,329 @@ namespace open_spiel::json {
 
 namespace {
 
-std::string Escape(const std::string& input) {
-  std::string out;
-  out.reserve(input.length());
-  for (const char c : input) {
-    switch (c) {
-      case '"': out.append("\\\""); break;
-      case '\\': out.append("\\\\"); break;
-      case '\b': out.append("\\b"); break;
-      case '\f': out.append("\\f"); break;
-      case '\n': out.append("\\n"); break;
-      case '\r': out.append("\\r"); break;
-      case '\t': out.append("\\t"); break;
-      default: out.push_back(c); break;
+void AppendEscaped(absl::string_view input, std::string* out) {
+  // Copy runs of characters that don't need escaping in one go.
+  size_t begin = 0;
+  while (true) {
+    size_t end = input.find_first_of("\"\\\b\f\n\r\t", begin);
+    if (end == absl::string_view::npos) {
+      out->append(input.data() + begin, input.size() - begin);
+      return;
+    }
+    out->append(input.data() + begin, end - begin);
+    switch (input[end]) {
+      case '"': out->append("\\\""); break;
+      case '\\': out->append("\\\\"); break;
+      case '\b': out->append("\\b"); break;
+      case '\f': out->append("\\f"); break;
+      case '\n': out->append("\\n"); break;
+      case '\r': out->append("\\r"); break;
+      case '\t': out->append("\\t"); break;
     }
+    begin = end + 1;
   }
-  return out;
 }
 
-void ConsumeWhitespace(absl::string_view* str) {
-  for (const char* c = str->begin(); c < str->end(); ++c) {
-    switch (*c) {
-      case ' ':
-      case '\n':
-      case '\r':
-      case '\t':
-        break;
-      default:
-        str->remove_prefix(c - str->begin());
-        return;
+void AppendIndent(bool wrap, int indent, std::string* out) {
+  if (wrap) {
+    out->push_back('\n');
+    out->append(indent, ' ');
+  }
+}
+
+void AppendDouble(double v, std::string* out) {
+  // The same format as std::to_string, without the temporary.
+  if (std::isfinite(v)) {
+    absl::StrAppendFormat(out, "%f", v);
+  } else {
+    // It'd be nice to show an error with a path, but at least this is
+    // debuggable by looking at the json. Crashing doesn't tell you where
+    // the problem is.
+    absl::StrAppendFormat(out, "\"%f\"", v);
+  }
+}
+
+// Appends the value to a single output string, where ToString used to build
+// and copy a string per nested value.
+void Append(const Value& value, bool wrap, int indent, std::string* out);
+
+void Append(const Array& array, bool wrap, int indent, std::string* out) {
+  out->push_back('[');
+  bool first = true;
+  for (const Value& v : array) {
+    if (!first) {
+      out->push_back(',');
     }
+    if (wrap) {
+      AppendIndent(wrap, indent + 2, out);
+    } else if (!first) {
+      out->push_back(' ');
+    }
+    first = false;
+    Append(v, wrap, indent + 2, out);
+  }
+  AppendIndent(wrap, indent, out);
+  out->push_back(']');
+}
+
+void Append(const Object& obj, bool wrap, int indent, std::string* out) {
+  out->push_back('{');
+  bool first = true;
+  for (const auto& [key, value] : obj) {
+    if (!first) {
+      out->push_back(',');
+    }
+    if (wrap) {
+      AppendIndent(wrap, indent + 2, out);
+    } else if (!first) {
+      out->push_back(' ');
+    }
+    first = false;
+    out->push_back('"');
+    AppendEscaped(key, out);
+    out->append("\": ");
+    Append(value, wrap, indent + 2, out);
+  }
+  AppendIndent(wrap, indent, out);
+  out->push_back('}');
+}
+
+void Append(const Value& value, bool wrap, int indent, std::string* out) {
+  if (value.IsNull()) {
+    out->append("null");
+  } else if (value.IsBool()) {
+    out->append(value.GetBool() ? "true" : "false");
+  } else if (value.IsInt()) {
+    absl::StrAppend(out, value.GetInt());
+  } else if (value.IsDouble()) {
+    AppendDouble(value.GetDouble(), out);
+  } else if (value.IsString()) {
+    out->push_back('"');
+    AppendEscaped(value.GetString(), out);
+    out->push_back('"');
+  } else if (value.IsArray()) {
+    Append(value.GetArray(), wrap, indent, out);
+  } else if (value.IsObject()) {
+    Append(value.GetObject(), wrap, indent, out);
+  } else {
+    SpielFatalError("json::ToString is missing a type.");
   }
 }
 
-std::nullopt_t ParseError(absl::string_view error, absl::string_view str) {
+bool ParseError(absl::string_view error, absl::string_view str) {
   // Comment out this check if you want parse errors to return nullopt instead
   // of crash with an error message of where the problem is.
   SPIEL_CHECK_EQ(error, str.substr(0, std::min(30ul, str.size())));
 
   // TODO(author7): Maybe return a variant of error string or Value?
-  return std::nullopt;
-}
-
-bool ConsumeToken(absl::string_view* str, absl::string_view token) {
-  if (absl::StartsWith(*str, token)) {
-    str->remove_prefix(token.size());
-    return true;
-  }
   return false;
 }
 
-template <typename T>
-std::optional<Value> ParseConstant(absl::string_view* str,
-                                   absl::string_view token, T value) {
-  if (ConsumeToken(str, token)) {
-    return value;
-  }
-  return ParseError("Invalid constant: ", *str);
-}
+// A recursive descent parser, which parses each value in place in its parent
+// rather than returning it, so values are never copied, and parses numbers
+// and strings without temporaries.
+class Parser {
+ public:
+  explicit Parser(absl::string_view str) : str_(str) {}
 
-std::optional<Value> ParseNumber(absl::string_view* str) {
-  size_t valid_double =
-      std::min(str->find_first_not_of("-+.0123456789eE"), str->size());
-  size_t valid_int =
-      std::min(str->find_first_not_of("-0123456789"), str->size());
-  if (valid_double == valid_int) {
-    if (int64_t v; absl::SimpleAtoi(str->substr(0, valid_int), &v)) {
-      str->remove_prefix(valid_int);
-      return Value(v);
+  bool ParseValue(Value* out) {
+    ConsumeWhitespace();
+    if (str_.empty()) {
+      return ParseError("Empty string", str_);
     }
-  } else {
-    if (double v; absl::SimpleAtod(str->substr(0, valid_double), &v)) {
-      str->remove_prefix(valid_double);
-      return Value(v);
+    switch (str_[0]) {
+      case '-':
+      case '0':
+      case '1':
+      case '2':
+      case '3':
+      case '4':
+      case '5':
+      case '6':
+      case '7':
+      case '8':
+      case '9': return ParseNumber(out);
+      case 'n': return ParseConstant("null", Null(), out);
+      case 't': return ParseConstant("true", true, out);
+      case 'f': return ParseConstant("false", false, out);
+      case '"': return ParseString(&out->emplace<std::string>());
+      case '[': return ParseArray(&out->emplace<Array>());
+      case '{': return ParseObject(&out->emplace<Object>());
+      default: return ParseError("Unexpected char: ", str_);
     }
   }
-  return ParseError("Invalid number", *str);
-}
 
-std::optional<std::string> ParseString(absl::string_view* str) {
-  if (!ConsumeToken(str, "\"")) {
-    return ParseError("Expected '\"'", *str);
-  }
-  std::string out;
-  bool escape = false;
-  for (const char* c = str->begin(); c < str->end(); ++c) {
-    switch (*c) {
-      case '\\':
-        if (escape) {
-          out.push_back('\\');
-        }
-        escape = !escape;
-        break;
-      case '"':
-        if (escape) {
-          out.push_back('"');
-          escape = false;
-          break;
-        } else {
-          str->remove_prefix(c - str->begin() + 1);
-          return out;
-        }
-      default:
-        if (escape) {
-          switch (*c) {
-            case 'b': out.append("\b"); break;
-            case 'f': out.append("\f"); break;
-            case 'n': out.append("\n"); break;
-            case 'r': out.append("\r"); break;
-            case 't': out.append("\t"); break;
-            default: out.push_back(*c); break;
-          }
-          escape = false;
-        } else {
-          out.push_back(*c);
-        }
-        break;
+ private:
+  void ConsumeWhitespace() {
+    size_t n = 0;
+    while (n < str_.size() && (str_[n] == ' ' || str_[n] == '\n' ||
+                               str_[n] == '\r' || str_[n] == '\t')) {
+      ++n;
     }
+    str_.remove_prefix(n);
   }
-  return ParseError("Unfinished string", *str);
-}
 
-std::optional<Value> ParseValue(absl::string_view* str);
+  bool ConsumeToken(char token) {
+    if (!str_.empty() && str_[0] == token) {
+      str_.remove_prefix(1);
+      return true;
+    }
+    return false;
+  }
 
-std::optional<Array> ParseArray(absl::string_view* str) {
-  if (!ConsumeToken(str, "[")) {
-    return ParseError("Expected '['", *str);
+  bool ConsumeToken(absl::string_view token) {
+    if (absl::StartsWith(str_, token)) {
+      str_.remove_prefix(token.size());
+      return true;
+    }
+    return false;
   }
-  Array out;
-  bool first = true;
-  while (!str->empty()) {
-    ConsumeWhitespace(str);
-    if (ConsumeToken(str, "]")) {
-      return out;
+
+  template <typename T>
+  bool ParseConstant(absl::string_view token, T value, Value* out) {
+    if (ConsumeToken(token)) {
+      *out = value;
+      return true;
     }
-    if (!first && !ConsumeToken(str, ",")) {
-      return ParseError("Expected ','", *str);
+    return ParseError("Invalid constant: ", str_);
+  }
+
+  bool ParseNumber(Value* out) {
+    size_t size = 0;
+    bool is_int = true;
+    for (; size < str_.size(); ++size) {
+      const char c = str_[size];
+      if (c == '.' || c == 'e' || c == 'E' || c == '+') {
+        is_int = false;
+      } else if (c != '-' && (c < '0' || c > '9')) {
+        break;
+      }
     }
-    first = false;
-    ConsumeWhitespace(str);
-    std::optional<Value> v = ParseValue(str);
-    if (!v) {
-      return std::nullopt;
+    const char* begin = str_.data();
+    const char* end = begin + size;
+    if (is_int) {
+      int64_t v;
+      std::from_chars_result result = std::from_chars(begin, end, v);
+      if (result.ec == std::errc() && result.ptr == end) {
+        str_.remove_prefix(size);
+        *out = v;
+        return true;
+      }
+    } else {
+      double v;
+      absl::from_chars_result result = absl::from_chars(begin, end, v);
+      if (result.ec == std::errc() && result.ptr == end) {
+        str_.remove_prefix(size);
+        *out = v;
+        return true;
+      }
     }
-    out.push_back(*v);
+    return ParseError("Invalid number", str_);
   }
-  return ParseError("Unfinished array", *str);
-}
 
-std::optional<Object> ParseObject(absl::string_view* str) {
-  if (!ConsumeToken(str, "{")) {
-    return ParseError("Expected '{'", *str);
-  }
-  Object out;
-  bool first = true;
-  while (!str->empty()) {
-    ConsumeWhitespace(str);
-    if (ConsumeToken(str, "}")) {
-      return out;
+  bool ParseString(std::string* out) {
+    if (!ConsumeToken('"')) {
+      return ParseError("Expected '\"'", str_);
     }
-    if (!first && !ConsumeToken(str, ",")) {
-      return ParseError("Expected ','", *str);
+    while (true) {
+      // Copy runs of plain characters in one go.
+      size_t end = str_.find_first_of("\"\\");
+      if (end == absl::string_view::npos) {
+        return ParseError("Unfinished string", str_);
+      }
+      out->append(str_.data(), end);
+      const char c = str_[end];
+      str_.remove_prefix(end + 1);
+      if (c == '"') {
+        return true;
+      }
+      if (str_.empty()) {
+        return ParseError("Unfinished string", str_);
+      }
+      switch (str_[0]) {
+        case 'b': out->push_back('\b'); break;
+        case 'f': out->push_back('\f'); break;
+        case 'n': out->push_back('\n'); break;
+        case 'r': out->push_back('\r'); break;
+        case 't': out->push_back('\t'); break;
+        default: out->push_back(str_[0]); break;
+      }
+      str_.remove_prefix(1);
     }
-    first = false;
-    ConsumeWhitespace(str);
-    std::optional<std::string> key = ParseString(str);
-    if (!key) {
-      return std::nullopt;
-    }
-    ConsumeWhitespace(str);
-    if (!ConsumeToken(str, ":")) {
-      return ParseError("Expected ':'", *str);
+  }
+
+  bool ParseArray(Array* out) {
+    if (!ConsumeToken('[')) {
+      return ParseError("Expected '['", str_);
     }
-    ConsumeWhitespace(str);
-    std::optional<Value> v = ParseValue(str);
-    if (!v) {
-      return std::nullopt;
+    bool first = true;
+    while (!str_.empty()) {
+      ConsumeWhitespace();
+      if (ConsumeToken(']')) {
+        return true;
+      }
+      if (!first && !ConsumeToken(',')) {
+        return ParseError("Expected ','", str_);
+      }
+      first = false;
+      ConsumeWhitespace();
+      if (!ParseValue(&out->emplace_back())) {
+        return false;
+      }
     }
-    out.emplace(*key, *v);
+    return ParseError("Unfinished array", str_);
   }
-  return ParseError("Unfinished object", *str);
-}
 
-std::optional<Value> ParseValue(absl::string_view* str) {
-  ConsumeWhitespace(str);
-  if (str->empty()) {
-    return ParseError("Empty string", *str);
-  }
-  switch (str->at(0)) {
-    case '-':
-    case '0':
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9': return ParseNumber(str);
-    case 'n': return ParseConstant(str, "null", Null());
-    case 't': return ParseConstant(str, "true", true);
-    case 'f': return ParseConstant(str, "false", false);
-    case '"': return ParseString(str);
-    case '[': return ParseArray(str);
-    case '{': return ParseObject(str);
-    default: return ParseError("Unexpected char: ", *str);
+  bool ParseObject(Object* out) {
+    if (!ConsumeToken('{')) {
+      return ParseError("Expected '{'", str_);
+    }
+    bool first = true;
+    std::string key;
+    while (!str_.empty()) {
+      ConsumeWhitespace();
+      if (ConsumeToken('}')) {
+        return true;
+      }
+      if (!first && !ConsumeToken(',')) {
+        return ParseError("Expected ','", str_);
+      }
+      first = false;
+      ConsumeWhitespace();
+      key.clear();
+      if (!ParseString(&key)) {
+        return false;
+      }
+      ConsumeWhitespace();
+      if (!ConsumeToken(':')) {
+        return ParseError("Expected ':'", str_);
+      }
+      ConsumeWhitespace();
+      // Keys are usually sorted, as ToString writes them, so inserting at the
+      // end is constant time. As before, the first of duplicate keys wins.
+      auto it = out->end();
+      if (out->empty() || std::prev(it)->first < key) {
+        it = out->emplace_hint(it, key, Value());
+      } else {
+        auto [found, inserted] = out->try_emplace(key);
+        if (!inserted) {
+          Value ignored;
+          if (!ParseValue(&ignored)) {
+            return false;
+          }
+          continue;
+        }
+        it = found;
+      }
+      if (!ParseValue(&it->second)) {
+        return false;
+      }
+    }
+    return ParseError("Unfinished object", str_);
   }
-}
+
+  absl::string_view str_;
+};
 
 }  // namespace
 
@@ -243,77 +363,87 @@ bool Null::operator==(const Null& o) const { return true; }
 bool Null::operator!=(const Null& o) const { return false; }
 
 std::string ToString(const Array& array, bool wrap, int indent) {
-  std::string out = "[";
-  bool first = true;
-  for (const Value& v : array) {
-    if (!first) {
-      absl::StrAppend(&out, ",");
-    }
-    if (wrap) {
-      absl::StrAppend(&out, "\n", std::string(indent + 2, ' '));
-    } else if (!first) {
-      absl::StrAppend(&out, " ");
-    }
-    first = false;
-    absl::StrAppend(&out, json::ToString(v, wrap, indent + 2));
-  }
-  if (wrap) {
-    absl::StrAppend(&out, "\n", std::string(indent, ' '));
-  }
-  absl::StrAppend(&out, "]");
+  std::string out;
+  Append(array, wrap, indent, &out);
   return out;
 }
 
 std::string ToString(const Object& obj, bool wrap, int indent) {
-  std::string out = "{";
-  bool first = true;
-  for (const auto& [key, value] : obj) {
-    if (!first) {
-      absl::StrAppend(&out, ",");
-    }
-    if (wrap) {
-      absl::StrAppend(&out, "\n", std::string(indent + 2, ' '));
-    } else if (!first) {
-      absl::StrAppend(&out, " ");
-    }
-    first = false;
-    absl::StrAppend(&out, "\"", Escape(key), "\": ",
-                    json::ToString(value, wrap, indent + 2));
-  }
-  if (wrap) {
-    absl::StrAppend(&out, "\n", std::string(indent, ' '));
-  }
-  absl::StrAppend(&out, "}");
+  std::string out;
+  Append(obj, wrap, indent, &out);
   return out;
 }
 
-
 std::string ToString(const Value& value, bool wrap, int indent) {
-  if (value.IsNull()) {
-    return "null";
-  } else if (value.IsBool()) {
-    return (value.GetBool() ? "true" : "false");
-  } else if (value.IsInt()) {
-    return std::to_string(value.GetInt());
-  } else if (value.IsDouble()) {
-    double v = value.GetDouble();
-    if (std::isfinite(v)) {
-      return std::to_string(v);
-    } else {
-      // It'd be nice to show an error with a path, but at least this is
-      // debuggable by looking at the json. Crashing doesn't tell you where
-      // the problem is.
-      return absl::StrCat("\"", std::to_string(v), "\"");
-    }
-  } else if (value.IsString()) {
-    return absl::StrCat("\"", Escape(value.GetString()), "\"");
-  } else if (value.IsArray()) {
-    return ToString(value.GetArray(), wrap, indent);
-  } else if (value.IsObject()) {
-    return ToString(value.GetObject(), wrap, indent);
-  } else {
-    SpielFatalError("json::ToString is missing a type.");
+  std::string out;
+  Append(value, wrap, indent, &out);
+  return out;
+}
+
+void AppendToString(const Value& value, std::string* out, bool wrap,
+                    int indent) {
+  Append(value, wrap, indent, out);
+}
+
+void Writer::StartValue() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
   }
+  if (containers_.empty()) return;
+  auto& [is_object, size] = containers_.back();
+  SPIEL_CHECK_FALSE(is_object);  // Object values need a Key first.
+  if (size++ > 0) out_->append(", ");
+}
+
+Writer& Writer::BeginArray() {
+  StartValue();
+  out_->push_back('[');
+  containers_.push_back({false, 0});
+  return *this;
+}
+
+Writer& Writer::EndArray() {
+  SPIEL_CHECK_FALSE(containers_.empty());
+  SPIEL_CHECK_FALSE(containers_.back().first);
+  containers_.pop_back();
+  out_->push_back(']');
+  return *this;
+}
+
+Writer& Writer::BeginObject() {
+  StartValue();
+  out_->push_back('{');
+  containers_.push_back({true, 0});
+  return *this;
+}
+
+Writer& Writer::EndObject() {
+  SPIEL_CHECK_FALSE(containers_.empty());
+  SPIEL_CHECK_TRUE(containers_.back().first);
+  SPIEL_CHECK_FALSE(after_key_);
+  containers_.pop_back();
+  out_->push_back('}');
+  return *this;
+}
+
+Writer& Writer::Key(absl::string_view key) {
+  SPIEL_CHECK_FALSE(containers_.empty());
+  SPIEL_CHECK_FALSE(after_key_);
+  auto& [is_object, size] = containers_.back();
+  SPIEL_CHECK_TRUE(is_object);
+  if (size++ > 0) out_->append(", ");
+  out_->push_back('"');
+  AppendEscaped(key, out_);
+  out_->append("\": ");
+  after_key_ = true;
+  return *this;
+}
+
+Writer& Writer::Write(const Value& value) {
+  StartValue();
+  Append(value, /*wrap=*/false, /*indent=*/0, out_);
+  return *this;
 }
 
 std::ostream& operator<<(std::ostream& os, const Null& n) {
@@ -333,7 +463,11 @@ std::ostream& operator<<(std::ostream& os, const Value& v) {
 }
 
 std::optional<Value> FromString(absl::string_view str) {
-  return ParseValue(&str);
+  Value value;
+  if (!Parser(str).ParseValue(&value)) {
+    return std::nullopt;
+  }
+  return value;
 }
 
 }  // namespace open_spiel::json
@@ -18,8 +18,10 @@
 #include <cstdint>
 
 #include <map>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -120,6 +122,40 @@ std::string ToString(const Array& array, bool wrap = false, int indent = 0);
 std::string ToString(const Object& obj, bool wrap = false, int indent = 0);
 std::string ToString(const Value& value, bool wrap = false, int indent = 0);
 
+// As ToString, but appends to `out`, e.g. to reuse a buffer across records.
+void AppendToString(const Value& value, std::string* out, bool wrap = false,
+                    int indent = 0);
+
+// Writes JSON incrementally into a string, in the same format as ToString
+// without wrapping, without building the whole Value first. For example:
+//   Writer(&out).BeginObject().Key("step").Write(1).Key("losses")
+//       .BeginArray().Write(0.5).Write(0.25).EndArray().EndObject();
+// Keys are written in the order given, so should be sorted to match ToString.
+class Writer {
+ public:
+  explicit Writer(std::string* out) : out_(out) {}
+
+  Writer& BeginArray();
+  Writer& EndArray();
+  Writer& BeginObject();
+  Writer& EndObject();
+  Writer& Key(absl::string_view key);
+  Writer& Write(const Value& value);
+
+  // Whether all the arrays and objects begun have been ended.
+  bool Done() const { return containers_.empty(); }
+
+ private:
+  // Writes the separator before a value, if needed.
+  void StartValue();
+
+  std::string* out_;
+  // For each array and object begun, whether it is an object, and its number
+  // of elements so far.
+  std::vector<std::pair<bool, int>> containers_;
+  bool after_key_ = false;
+};
+
 std::ostream& operator<<(std::ostream& os, const Null& n);
 std::ostream& operator<<(std::ostream& os, const Array& a);
 std::ostream& operator<<(std::ostream& os, const Object& o);
@@ -127,6 +127,46 @@ void TestFromString() {
                                          {"foo", Array({1, true, false})}}));
 }
 
+void TestRoundTrip() {
+  Object obj({{"a \"quoted\"\n key", Array({1.5, -2, 1e300, "\t\\"})},
+              {"b", Object({{"c", Null()}, {"d", Array()}, {"e", Object()}})},
+              {"f", false}});
+  for (bool wrap : {false, true}) {
+    std::string str = ToString(obj, wrap);
+    std::optional<Value> v = FromString(str);
+    SPIEL_CHECK_TRUE(v);
+    SPIEL_CHECK_EQ(ToString(*v, wrap), str);
+  }
+
+  std::optional<Value> v = FromString("[1e3, -2.5E-1, 12345678901234]");
+  SPIEL_CHECK_TRUE(v);
+  SPIEL_CHECK_EQ(v->GetArray(), Array({1000.0, -0.25, 12345678901234}));
+
+  // The first of duplicate keys is kept, and keys needn't be sorted.
+  v = FromString(R"({"b": 1, "a": 2, "b": 3})");
+  SPIEL_CHECK_TRUE(v);
+  SPIEL_CHECK_EQ(v->GetObject(), Object({{"a", 2}, {"b", 1}}));
+
+  std::string out = "x";
+  AppendToString(Array({1, 2}), &out);
+  SPIEL_CHECK_EQ(out, "x[1, 2]");
+}
+
+void TestWriter() {
+  std::string out;
+  Writer writer(&out);
+  writer.BeginObject()
+      .Key("asdf").BeginObject().Key("bar").Write(6).EndObject()
+      .Key("foo").BeginArray().Write(1).Write(true).BeginArray().EndArray()
+      .EndArray()
+      .Key("q\"").Write("x\ny")
+      .EndObject();
+  SPIEL_CHECK_TRUE(writer.Done());
+  SPIEL_CHECK_EQ(out, ToString(Object({{"asdf", Object({{"bar", 6}})},
+                                       {"foo", Array({1, true, Array()})},
+                                       {"q\"", "x\ny"}})));
+}
+
 void TestValue() {
   SPIEL_CHECK_EQ(Value(true), Value(true));
   SPIEL_CHECK_EQ(Value(true), true);
@@ -220,5 +260,7 @@ void TestValue() {
 int main(int argc, char** argv) {
   open_spiel::json::TestToString();
   open_spiel::json::TestFromString();
+  open_spiel::json::TestRoundTrip();
+  open_spiel::json::TestWriter();
   open_spiel::json::TestValue();
 }
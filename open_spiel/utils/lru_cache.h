@@ -15,9 +15,16 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_LRU_CACHE_H_
 #define THIRD_PARTY_OPEN_SPIEL_UTILS_LRU_CACHE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/container/flat_hash_map.h"
+#include "open_spiel/abseil-cpp/absl/hash/hash.h"
 #include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
 
 namespace open_spiel {
@@ -47,7 +54,7 @@ struct LRUCacheInfo {
 template <typename K, typename V>
 class LRUCache {  // Least Recently Used Cache.
   // TODO(author7): Consider the performance implications here. Some ideas:
-  // - Shard the cache to avoid lock contention. Can be done by the user.
+  // - Shard the cache to avoid lock contention. See ShardedLRUCache below.
   // - Use shared pointers to avoid copying data out, and shorten the lock.
   // - Use two generations to avoid order updates on hot items. The mature
   //   generation wouldn't be ordered or evicted so can use a reader/writer lock
@@ -131,6 +138,210 @@ class LRUCache {  // Least Recently Used Cache.
   absl::Mutex m_;
 };
 
+enum class CacheEvictionPolicy {
+  // Evicts the least recently used entry. Hits reorder the entries, so they
+  // lock their shard exclusively.
+  kLRU,
+  // Evicts the first entry the clock hand finds that was not used since the
+  // hand last passed it (CLOCK, or second chance), which approximates LRU.
+  // Hits only set a flag, so they share their shard's lock with other hits.
+  kClock,
+};
+
+// A cache with the interface of LRUCache that can be shared by many threads,
+// e.g. as the neural network evaluation cache of parallel MCTS actors. The
+// entries are spread over shards by the hash of their key, each with its own
+// lock and max_size / num_shards entries, so that threads rarely wait for each
+// other. The entries of a shard are embedded in a fixed array, without
+// allocations once it is full, and the hit and miss counters are atomics.
+// Keys and values must be default constructible.
+template <typename K, typename V>
+class ShardedLRUCache {
+ public:
+  explicit ShardedLRUCache(
+      int max_size, int num_shards = 16,
+      CacheEvictionPolicy policy = CacheEvictionPolicy::kLRU)
+      : policy_(policy) {
+    num_shards = std::max(num_shards, 1);
+    const int shard_size =
+        std::max((max_size + num_shards - 1) / num_shards, 1);
+    shards_.reserve(num_shards);
+    for (int i = 0; i < num_shards; ++i) {
+      shards_.push_back(std::make_unique<Shard>(shard_size));
+    }
+  }
+
+  ShardedLRUCache(const ShardedLRUCache&) = delete;
+  ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+  int NumShards() const { return shards_.size(); }
+
+  int Size() {
+    int size = 0;
+    for (auto& shard : shards_) {
+      absl::ReaderMutexLock lock(&shard->mutex);
+      size += shard->size;
+    }
+    return size;
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      absl::MutexLock lock(&shard->mutex);
+      shard->index.clear();
+      shard->size = 0;
+      shard->head = shard->tail = kNone;
+      shard->hand = 0;
+      shard->hits = 0;
+      shard->misses = 0;
+    }
+  }
+
+  // Adds the entry, or replaces the value of the key if it is already cached.
+  void Set(const K& key, const V& value) {
+    Shard& shard = ShardFor(key);
+    absl::MutexLock lock(&shard.mutex);
+    auto pos = shard.index.find(key);
+    if (pos != shard.index.end()) {
+      Slot& slot = shard.slots[pos->second];
+      slot.value = value;
+      Touch(shard, pos->second);
+      return;
+    }
+    int i;
+    if (shard.size < shard.slots.size()) {
+      i = shard.size++;
+    } else {
+      i = Evict(shard);
+      shard.index.erase(shard.slots[i].key);
+    }
+    Slot& slot = shard.slots[i];
+    slot.key = key;
+    slot.value = value;
+    slot.referenced.store(false, std::memory_order_relaxed);
+    if (policy_ == CacheEvictionPolicy::kLRU) PushFront(shard, i);
+    shard.index.emplace(key, i);
+  }
+
+  std::optional<const V> Get(const K& key) {
+    Shard& shard = ShardFor(key);
+    std::optional<const V> value = Find(shard, key);
+    (value ? shard.hits : shard.misses).fetch_add(1, std::memory_order_relaxed);
+    return value;
+  }
+
+  // The statistics summed over the shards.
+  LRUCacheInfo Info() {
+    LRUCacheInfo info;
+    for (auto& shard : shards_) {
+      absl::ReaderMutexLock lock(&shard->mutex);
+      info += LRUCacheInfo{shard->hits.load(std::memory_order_relaxed),
+                           shard->misses.load(std::memory_order_relaxed),
+                           shard->size, static_cast<int>(shard->slots.size())};
+    }
+    return info;
+  }
+
+ private:
+  static constexpr int kNone = -1;
+
+  struct Slot {
+    K key;
+    V value;
+    // Whether the entry was used since the clock hand passed it, for kClock.
+    // Set by hits under a shared lock, hence atomic.
+    std::atomic<bool> referenced{false};
+    // The neighbours towards the most and least recently used entries, for
+    // kLRU.
+    int prev = kNone;
+    int next = kNone;
+  };
+
+  // Aligned so that the locks and counters of shards do not share cache
+  // lines.
+  struct alignas(64) Shard {
+    explicit Shard(int capacity) : slots(capacity) {}
+
+    absl::Mutex mutex;
+    absl::flat_hash_map<K, int> index;  // Into slots.
+    std::vector<Slot> slots;
+    int size = 0;  // The slots in use, which are the first ones.
+    int head = kNone;  // The most recently used slot, for kLRU.
+    int tail = kNone;  // The least recently used slot, for kLRU.
+    int hand = 0;  // The next slot the clock hand considers, for kClock.
+    std::atomic<int64_t> hits{0};
+    std::atomic<int64_t> misses{0};
+  };
+
+  Shard& ShardFor(const K& key) {
+    // The high bits, as the hash map of the shard uses the low ones.
+    const uint64_t hash = absl::Hash<K>()(key);
+    return *shards_[(hash >> 32) % shards_.size()];
+  }
+
+  // Returns the value of key and marks it as used.
+  std::optional<const V> Find(Shard& shard, const K& key) {
+    if (policy_ == CacheEvictionPolicy::kClock) {
+      absl::ReaderMutexLock lock(&shard.mutex);
+      return FindLocked(shard, key);
+    }
+    absl::MutexLock lock(&shard.mutex);
+    return FindLocked(shard, key);
+  }
+
+  std::optional<const V> FindLocked(Shard& shard, const K& key) {
+    auto pos = shard.index.find(key);
+    if (pos == shard.index.end()) return std::nullopt;
+    Touch(shard, pos->second);
+    return shard.slots[pos->second].value;
+  }
+
+  void Touch(Shard& shard, int i) {
+    if (policy_ == CacheEvictionPolicy::kClock) {
+      shard.slots[i].referenced.store(true, std::memory_order_relaxed);
+    } else if (shard.head != i) {
+      Unlink(shard, i);
+      PushFront(shard, i);
+    }
+  }
+
+  // Returns the slot of the entry to evict from a full shard.
+  int Evict(Shard& shard) {
+    if (policy_ == CacheEvictionPolicy::kLRU) {
+      const int i = shard.tail;
+      Unlink(shard, i);
+      return i;
+    }
+    while (shard.slots[shard.hand].referenced.exchange(
+        false, std::memory_order_relaxed)) {
+      shard.hand = (shard.hand + 1) % shard.slots.size();
+    }
+    const int i = shard.hand;
+    shard.hand = (shard.hand + 1) % shard.slots.size();
+    return i;
+  }
+
+  void Unlink(Shard& shard, int i) {
+    Slot& slot = shard.slots[i];
+    (slot.prev == kNone ? shard.head : shard.slots[slot.prev].next) =
+        slot.next;
+    (slot.next == kNone ? shard.tail : shard.slots[slot.next].prev) =
+        slot.prev;
+    slot.prev = slot.next = kNone;
+  }
+
+  void PushFront(Shard& shard, int i) {
+    Slot& slot = shard.slots[i];
+    slot.prev = kNone;
+    slot.next = shard.head;
+    (shard.head == kNone ? shard.tail : shard.slots[shard.head].prev) = i;
+    shard.head = i;
+  }
+
+  const CacheEvictionPolicy policy_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_LRU_CACHE_H_
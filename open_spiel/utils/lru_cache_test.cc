@@ -14,7 +14,11 @@
 
 #include "open_spiel/utils/lru_cache.h"
 
+#include <string>
+#include <vector>
+
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace {
@@ -73,7 +77,82 @@ void TestLRUCache() {
   SPIEL_CHECK_FALSE(cache.Get(18));  // evicted
 }
 
+void TestShardedLRUCacheEviction() {
+  // A single shard evicts exactly as LRUCache.
+  ShardedLRUCache<int, std::string> cache(4, /*num_shards=*/1);
+  SPIEL_CHECK_EQ(cache.Info().max_size, 4);
+  for (int i = 13; i <= 16; ++i) cache.Set(i, std::to_string(i));
+  SPIEL_CHECK_EQ(cache.Size(), 4);
+  SPIEL_CHECK_EQ(*cache.Get(13), "13");
+  cache.Set(17, "17");
+  SPIEL_CHECK_FALSE(cache.Get(14));  // evicted
+  SPIEL_CHECK_TRUE(cache.Get(13));   // older but more recently used
+  cache.Set(13, "thirteen");
+  SPIEL_CHECK_EQ(*cache.Get(13), "thirteen");
+  SPIEL_CHECK_EQ(cache.Size(), 4);
+
+  LRUCacheInfo info = cache.Info();
+  SPIEL_CHECK_EQ(info.hits, 3);
+  SPIEL_CHECK_EQ(info.misses, 1);
+  SPIEL_CHECK_EQ(info.Usage(), 1);
+
+  cache.Clear();
+  SPIEL_CHECK_EQ(cache.Size(), 0);
+  SPIEL_CHECK_FALSE(cache.Get(13));
+}
+
+void TestShardedClockCacheEviction() {
+  ShardedLRUCache<int, std::string> cache(4, /*num_shards=*/1,
+                                          CacheEvictionPolicy::kClock);
+  for (int i = 1; i <= 4; ++i) cache.Set(i, std::to_string(i));
+  SPIEL_CHECK_TRUE(cache.Get(1));
+  SPIEL_CHECK_TRUE(cache.Get(3));
+  // The hand skips the used entries, 1 and then 3, clearing their flags.
+  cache.Set(5, "5");
+  SPIEL_CHECK_FALSE(cache.Get(2));
+  cache.Set(6, "6");
+  SPIEL_CHECK_FALSE(cache.Get(4));
+  cache.Set(7, "7");
+  SPIEL_CHECK_FALSE(cache.Get(1));
+  SPIEL_CHECK_EQ(*cache.Get(3), "3");
+  SPIEL_CHECK_EQ(cache.Size(), 4);
+}
+
+void TestShardedLRUCacheThreads(CacheEvictionPolicy policy) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumGets = 20000;
+  ShardedLRUCache<int, int> cache(256, /*num_shards=*/8, policy);
+  std::vector<Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < kNumGets; ++i) {
+        const int key = (i * 7919 + t * 104729) % 1000;
+        std::optional<const int> value = cache.Get(key);
+        if (value) {
+          SPIEL_CHECK_EQ(*value, key * key);
+        } else {
+          cache.Set(key, key * key);
+        }
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+
+  const LRUCacheInfo info = cache.Info();
+  SPIEL_CHECK_EQ(info.Total(), kNumThreads * kNumGets);
+  SPIEL_CHECK_GT(info.hits, 0);
+  SPIEL_CHECK_LE(info.size, info.max_size);
+  SPIEL_CHECK_EQ(info.max_size, 256);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::TestLRUCache(); }
+int main(int argc, char** argv) {
+  open_spiel::TestLRUCache();
+  open_spiel::TestShardedLRUCacheEviction();
+  open_spiel::TestShardedClockCacheEviction();
+  open_spiel::TestShardedLRUCacheThreads(open_spiel::CacheEvictionPolicy::kLRU);
+  open_spiel::TestShardedLRUCacheThreads(
+      open_spiel::CacheEvictionPolicy::kClock);
+}
@@ -0,0 +1,125 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/memory_placement.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+#ifdef __linux__
+// From <linux/mempolicy.h>, which libc does not wrap.
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolInterleave = 3;
+constexpr int kMaxNodes = 64;
+
+// Returns the first line of a sysfs file, or "" if it cannot be read.
+std::string ReadSysfsLine(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+bool SetMemPolicy(int mode, const std::vector<int>& nodes) {
+  unsigned long mask = 0;  // NOLINT: the kernel ABI uses unsigned long.
+  for (int node : nodes) {
+    if (node >= kMaxNodes) return false;
+    mask |= 1ul << node;
+  }
+  // The kernel ignores the last bit of `maxnode`, hence the + 1.
+  return syscall(SYS_set_mempolicy, mode, &mask, kMaxNodes + 1) == 0;
+}
+
+bool PinToNode(int node) {
+  std::vector<int> cpus = ParseIdList(ReadSysfsLine(
+      absl::StrCat("/sys/devices/system/node/node", node, "/cpulist")));
+  if (cpus.empty()) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+#endif
+
+}  // namespace
+
+std::vector<int> ParseIdList(absl::string_view list) {
+  std::vector<int> ids;
+  for (absl::string_view range :
+       absl::StrSplit(list, ',', absl::SkipWhitespace())) {
+    std::vector<absl::string_view> bounds = absl::StrSplit(range, '-');
+    int first, last;
+    if (bounds.size() > 2 ||
+        !absl::SimpleAtoi(bounds.front(), &first) ||
+        !absl::SimpleAtoi(bounds.back(), &last) || first < 0 ||
+        last < first) {
+      SpielFatalError(absl::StrCat("Malformed id list: ", list));
+    }
+    for (int id = first; id <= last; ++id) ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+std::vector<int> NumaNodes() {
+#ifdef __linux__
+  std::vector<int> nodes =
+      ParseIdList(ReadSysfsLine("/sys/devices/system/node/online"));
+  if (!nodes.empty()) return nodes;
+#endif
+  return {0};
+}
+
+bool SetThreadMemoryPlacement(MemoryPlacement placement, int worker) {
+  SPIEL_CHECK_GE(worker, 0);
+  if (placement == MemoryPlacement::kDefault) return true;
+#ifdef __linux__
+  std::vector<int> nodes = NumaNodes();
+  if (nodes.size() == 1) return true;
+  switch (placement) {
+    case MemoryPlacement::kInterleaved:
+      return SetMemPolicy(kMpolInterleave, nodes);
+    case MemoryPlacement::kPartitioned: {
+      int node = nodes[worker % nodes.size()];
+      return PinToNode(node) && SetMemPolicy(kMpolPreferred, {node});
+    }
+    default:
+      SpielFatalError("Unknown memory placement");
+  }
+#else
+  return false;
+#endif
+}
+
+}  // namespace open_spiel
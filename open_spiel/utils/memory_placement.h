@@ -0,0 +1,57 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_MEMORY_PLACEMENT_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_MEMORY_PLACEMENT_H_
+
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+
+namespace open_spiel {
+
+// Where the memory first touched by a worker thread should live on machines
+// with several NUMA nodes. Tables shared by the threads of a solver grow as
+// the workers insert into them, so the pages of each entry are placed by the
+// policy of the thread that allocated it.
+enum class MemoryPlacement {
+  // The operating system default: pages on the node of the allocating CPU,
+  // wherever the scheduler happens to run the thread.
+  kDefault,
+  // Pages spread round-robin over all nodes, so that no single memory
+  // controller serves the whole table and every thread sees the same mix of
+  // local and remote accesses.
+  kInterleaved,
+  // Worker i runs on the CPUs of node (i modulo the number of nodes) and
+  // prefers to allocate there, so the entries it creates are local to it.
+  kPartitioned,
+};
+
+// Parses a Linux CPU or node list such as "0-3,8,10-11", as found in
+// /sys/devices/system/node. Returns the ids in increasing order.
+std::vector<int> ParseIdList(absl::string_view list);
+
+// The online NUMA nodes, or {0} when they cannot be determined (including on
+// platforms other than Linux).
+std::vector<int> NumaNodes();
+
+// Applies `placement` to the calling thread, the `worker`-th of a group.
+// Returns false, leaving the thread untouched, if the placement is not
+// supported here. Non-default placements are only supported on Linux, and are
+// a successful no-op on a single node.
+bool SetThreadMemoryPlacement(MemoryPlacement placement, int worker);
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_MEMORY_PLACEMENT_H_
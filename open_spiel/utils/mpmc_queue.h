@@ -0,0 +1,241 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_MPMC_QUEUE_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_MPMC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+
+namespace open_spiel {
+
+// A bounded multi-producer multi-consumer queue, for high message rates
+// between threads, e.g. from actors to a learner or from searches to a batched
+// evaluator. It has the interface of ThreadedQueue, but is a lock-free ring
+// buffer (Dmitry Vyukov's bounded MPMC queue): producers and consumers only
+// contend on an atomic counter each, values are moved in and out rather than
+// copied, and PopUpTo takes a batch at once. Blocking calls spin, then yield,
+// then sleep for growing periods until they can proceed, only reading the
+// clock once they have stopped spinning.
+template <class T>
+class MPMCQueue {
+ public:
+  // The capacity is rounded up to a power of two.
+  explicit MPMCQueue(int max_size)
+      : mask_(RoundUpToPowerOfTwo(max_size) - 1), cells_(mask_ + 1) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~MPMCQueue() { Clear(); }
+
+  MPMCQueue(const MPMCQueue&) = delete;
+  MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+  int Capacity() const { return mask_ + 1; }
+
+  // Adds an element to the queue if it is not full, in which case `value` is
+  // moved from. Returns false, leaving `value` untouched, otherwise or if new
+  // values are blocked.
+  bool TryPush(T&& value) {
+    if (block_new_values_.load(std::memory_order_relaxed)) return false;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // Full.
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    new (cell->value()) T(std::move(value));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Adds an element to the queue, waiting for space until the deadline.
+  bool Push(T&& value) {
+    return Push(std::move(value), absl::InfiniteFuture());
+  }
+  bool Push(T&& value, absl::Duration wait) {
+    return Push(std::move(value), absl::Now() + wait);
+  }
+  bool Push(T&& value, absl::Time deadline) {
+    Backoff backoff;
+    while (!TryPush(std::move(value))) {
+      if (block_new_values_.load(std::memory_order_relaxed) ||
+          !backoff.Wait(deadline)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Removes the oldest element, if any.
+  std::optional<T> TryPop() {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return std::nullopt;  // Empty.
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    T* value = cell->value();
+    std::optional<T> result(std::move(*value));
+    value->~T();
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return result;
+  }
+
+  // Removes the oldest element, waiting for one until the deadline. As for
+  // ThreadedQueue, this fails at once on an empty queue once new values are
+  // blocked.
+  std::optional<T> Pop() { return Pop(absl::InfiniteFuture()); }
+  std::optional<T> Pop(absl::Duration wait) { return Pop(absl::Now() + wait); }
+  std::optional<T> Pop(absl::Time deadline) {
+    Backoff backoff;
+    while (true) {
+      std::optional<T> value = TryPop();
+      if (value || (block_new_values_.load(std::memory_order_relaxed) &&
+                    Empty()) ||
+          !backoff.Wait(deadline)) {
+        return value;
+      }
+    }
+  }
+
+  // Waits for an element as Pop, then removes up to n - 1 more that are
+  // already in the queue. Returns the elements, oldest first, which are none
+  // if the wait failed.
+  std::vector<T> PopUpTo(int n) { return PopUpTo(n, absl::InfiniteFuture()); }
+  std::vector<T> PopUpTo(int n, absl::Duration wait) {
+    return PopUpTo(n, absl::Now() + wait);
+  }
+  std::vector<T> PopUpTo(int n, absl::Time deadline) {
+    std::vector<T> values;
+    if (n <= 0) return values;
+    std::optional<T> value = Pop(deadline);
+    while (value) {
+      values.push_back(std::move(*value));
+      if (values.size() >= static_cast<size_t>(n)) break;
+      value = TryPop();
+    }
+    return values;
+  }
+
+  // The number of elements, which may be outdated as soon as it is returned
+  // if other threads use the queue.
+  int Size() const {
+    const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+  }
+  bool Empty() const { return Size() == 0; }
+
+  void Clear() {
+    while (TryPop()) {
+    }
+  }
+
+  // Causes pushing new values to fail. Useful for shutting down the queue.
+  void BlockNewValues() {
+    block_new_values_.store(true, std::memory_order_relaxed);
+  }
+
+ private:
+  // Values are at most constructed in the cell between a push and a pop,
+  // which its sequence number orders.
+  struct Cell {
+    std::atomic<size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  // Waits longer each time it is called.
+  class Backoff {
+   public:
+    // Returns false, without waiting, if the deadline has passed.
+    bool Wait(absl::Time deadline) {
+      ++num_waits_;
+      if (num_waits_ <= kNumSpins) return true;
+      if (absl::Now() > deadline) return false;
+      if (num_waits_ <= kNumSpins + kNumYields) {
+        std::this_thread::yield();
+      } else {
+        absl::SleepFor(std::min(sleep_, deadline - absl::Now()));
+        sleep_ = std::min(sleep_ * 2, kMaxSleep);
+      }
+      return true;
+    }
+
+   private:
+    static constexpr int kNumSpins = 64;
+    static constexpr int kNumYields = 64;
+    static constexpr absl::Duration kMaxSleep = absl::Milliseconds(1);
+
+    int num_waits_ = 0;
+    absl::Duration sleep_ = absl::Microseconds(1);
+  };
+
+  static size_t RoundUpToPowerOfTwo(int n) {
+    size_t size = 2;
+    while (size < static_cast<size_t>(n)) size *= 2;
+    return size;
+  }
+
+  // The producer and consumer counters are on their own cache lines, so that
+  // they do not slow down each other.
+  const size_t mask_;
+  std::vector<Cell> cells_;
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+  alignas(64) std::atomic<bool> block_new_values_{false};
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_MPMC_QUEUE_H_
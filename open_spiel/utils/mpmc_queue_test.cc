@@ -0,0 +1,163 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/mpmc_queue.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace {
+
+void TestMPMCQueue() {
+  MPMCQueue<int> q(3);
+  SPIEL_CHECK_EQ(q.Capacity(), 4);
+
+  auto CheckPopEq = [&q](int expected) {
+    std::optional<int> v = q.Pop();
+    SPIEL_CHECK_TRUE(v);
+    SPIEL_CHECK_EQ(*v, expected);
+  };
+
+  SPIEL_CHECK_TRUE(q.Empty());
+  SPIEL_CHECK_EQ(q.Size(), 0);
+
+  SPIEL_CHECK_FALSE(q.TryPop());
+  SPIEL_CHECK_FALSE(q.Pop(absl::Milliseconds(1)));
+  SPIEL_CHECK_FALSE(q.Pop(absl::Now() + absl::Milliseconds(1)));
+
+  SPIEL_CHECK_TRUE(q.Push(10, absl::Now() + absl::Milliseconds(1)));
+  SPIEL_CHECK_FALSE(q.Empty());
+  SPIEL_CHECK_EQ(q.Size(), 1);
+
+  CheckPopEq(10);
+
+  SPIEL_CHECK_TRUE(q.Push(11));
+  SPIEL_CHECK_TRUE(q.Push(12));
+  SPIEL_CHECK_EQ(q.Size(), 2);
+  SPIEL_CHECK_TRUE(q.TryPush(13));
+  SPIEL_CHECK_TRUE(q.Push(14));
+  SPIEL_CHECK_EQ(q.Size(), 4);
+  SPIEL_CHECK_FALSE(q.TryPush(15));
+  SPIEL_CHECK_FALSE(q.Push(15, absl::Milliseconds(1)));
+
+  CheckPopEq(11);
+
+  SPIEL_CHECK_TRUE(q.Push(16, absl::Milliseconds(1)));
+
+  std::vector<int> values = q.PopUpTo(3);
+  SPIEL_CHECK_EQ(values, std::vector<int>({12, 13, 14}));
+  values = q.PopUpTo(3, absl::Milliseconds(1));
+  SPIEL_CHECK_EQ(values, std::vector<int>({16}));
+  SPIEL_CHECK_TRUE(q.PopUpTo(3, absl::Milliseconds(1)).empty());
+  SPIEL_CHECK_EQ(q.Size(), 0);
+
+  SPIEL_CHECK_TRUE(q.Push(17));
+  SPIEL_CHECK_TRUE(q.Push(18));
+  SPIEL_CHECK_EQ(q.Size(), 2);
+
+  q.Clear();
+
+  SPIEL_CHECK_TRUE(q.Empty());
+  SPIEL_CHECK_EQ(q.Size(), 0);
+
+  SPIEL_CHECK_TRUE(q.Push(19));
+  SPIEL_CHECK_TRUE(q.Push(20));
+
+  q.BlockNewValues();
+
+  SPIEL_CHECK_EQ(q.Size(), 2);
+  SPIEL_CHECK_FALSE(q.Push(21));
+  SPIEL_CHECK_EQ(q.Size(), 2);
+  CheckPopEq(19);
+  CheckPopEq(20);
+  SPIEL_CHECK_FALSE(q.Pop());
+}
+
+void TestMPMCQueueMoveOnly() {
+  MPMCQueue<std::unique_ptr<int>> q(2);
+  auto value = std::make_unique<int>(1);
+  SPIEL_CHECK_TRUE(q.Push(std::move(value)));
+  SPIEL_CHECK_TRUE(q.Push(std::make_unique<int>(2)));
+
+  // A failed push leaves the value with the caller.
+  value = std::make_unique<int>(3);
+  SPIEL_CHECK_FALSE(q.TryPush(std::move(value)));
+  SPIEL_CHECK_TRUE(value != nullptr);
+
+  std::optional<std::unique_ptr<int>> popped = q.Pop();
+  SPIEL_CHECK_TRUE(popped);
+  SPIEL_CHECK_EQ(**popped, 1);
+
+  // The remaining value is destroyed with the queue.
+  SPIEL_CHECK_TRUE(q.Push(std::move(value)));
+}
+
+void TestMPMCQueueThreads() {
+  constexpr int kNumProducers = 4;
+  constexpr int kNumConsumers = 3;
+  constexpr int kNumValues = 10000;
+  MPMCQueue<int> q(64);
+
+  std::vector<std::vector<int>> popped(kNumConsumers);
+  std::vector<Thread> threads;
+  for (int c = 0; c < kNumConsumers; ++c) {
+    threads.emplace_back([&q, &popped, c]() {
+      while (true) {
+        std::vector<int> values = q.PopUpTo(16);
+        if (values.empty()) return;
+        popped[c].insert(popped[c].end(), values.begin(), values.end());
+      }
+    });
+  }
+  std::vector<Thread> producers;
+  for (int p = 0; p < kNumProducers; ++p) {
+    producers.emplace_back([&q, p]() {
+      for (int i = 0; i < kNumValues; ++i) {
+        SPIEL_CHECK_TRUE(q.Push(p * kNumValues + i));
+      }
+    });
+  }
+  for (Thread& thread : producers) thread.join();
+  q.BlockNewValues();
+  for (Thread& thread : threads) thread.join();
+
+  // Every value is popped once, and each producer's values in order.
+  std::vector<int> count(kNumProducers * kNumValues, 0);
+  for (const std::vector<int>& values : popped) {
+    std::vector<int> last(kNumProducers, -1);
+    for (int value : values) {
+      ++count[value];
+      int p = value / kNumValues;
+      SPIEL_CHECK_GT(value, last[p]);
+      last[p] = value;
+    }
+  }
+  for (int n : count) SPIEL_CHECK_EQ(n, 1);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestMPMCQueue();
+  open_spiel::TestMPMCQueueMoveOnly();
+  open_spiel::TestMPMCQueueThreads();
+}
@@ -0,0 +1,202 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_format.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/utils/file.h"
+
+namespace open_spiel::profiler {
+namespace internal {
+
+std::atomic<bool> enabled{true};
+std::atomic<bool> tracing{false};
+
+}  // namespace internal
+
+namespace {
+
+struct Event {
+  const Site* site;
+  int64_t start_ns;
+  int64_t duration_ns;
+  int thread;
+};
+
+struct Registry {
+  absl::Mutex mu;
+  std::map<std::string, std::unique_ptr<Site>> sites ABSL_GUARDED_BY(mu);
+  std::vector<Event> events ABSL_GUARDED_BY(mu);
+  int64_t max_events ABSL_GUARDED_BY(mu) = 0;
+  int64_t num_dropped ABSL_GUARDED_BY(mu) = 0;
+};
+
+// Never destroyed, as timers may still run during static destruction.
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+// Small ids for the threads in the trace, in the order they first record.
+int ThreadId() {
+  static std::atomic<int> next_id{0};
+  thread_local int id = next_id.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+// The sites in order of decreasing total time.
+std::vector<const Site*> SortedSites() {
+  Registry& registry = GetRegistry();
+  std::vector<const Site*> sites;
+  {
+    absl::MutexLock lock(&registry.mu);
+    for (const auto& [name, site] : registry.sites) sites.push_back(site.get());
+  }
+  std::stable_sort(sites.begin(), sites.end(),
+                   [](const Site* a, const Site* b) {
+                     return a->total_ns.load() > b->total_ns.load();
+                   });
+  return sites;
+}
+
+}  // namespace
+
+namespace internal {
+
+void Record(Site* site, int64_t start_ns, int64_t duration_ns) {
+  site->count.fetch_add(1, std::memory_order_relaxed);
+  site->total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  int64_t max_ns = site->max_ns.load(std::memory_order_relaxed);
+  while (duration_ns > max_ns &&
+         !site->max_ns.compare_exchange_weak(max_ns, duration_ns,
+                                             std::memory_order_relaxed)) {
+  }
+  if (tracing.load(std::memory_order_relaxed)) {
+    const int thread = ThreadId();
+    Registry& registry = GetRegistry();
+    absl::MutexLock lock(&registry.mu);
+    if (registry.events.size() < registry.max_events) {
+      registry.events.push_back({site, start_ns, duration_ns, thread});
+    } else {
+      ++registry.num_dropped;
+    }
+  }
+}
+
+}  // namespace internal
+
+Site* GetSite(const std::string& name) {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mu);
+  std::unique_ptr<Site>& site = registry.sites[name];
+  if (site == nullptr) site = std::make_unique<Site>(name);
+  return site.get();
+}
+
+void SetEnabled(bool enabled) {
+  internal::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Enabled() { return internal::enabled.load(std::memory_order_relaxed); }
+
+void StartTracing(int64_t max_events) {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mu);
+  registry.max_events = max_events;
+  internal::tracing.store(true, std::memory_order_relaxed);
+}
+
+void StopTracing() { internal::tracing.store(false); }
+
+bool Tracing() { return internal::tracing.load(std::memory_order_relaxed); }
+
+void Reset() {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mu);
+  for (auto& [name, site] : registry.sites) {
+    site->count = 0;
+    site->total_ns = 0;
+    site->max_ns = 0;
+  }
+  registry.events.clear();
+  registry.num_dropped = 0;
+}
+
+std::string Report() {
+  std::string out = absl::StrFormat("%-40s %12s %12s %12s %12s\n", "name",
+                                    "count", "total ms", "mean us", "max us");
+  for (const Site* site : SortedSites()) {
+    const int64_t count = site->count.load();
+    if (count == 0) continue;
+    const int64_t total_ns = site->total_ns.load();
+    absl::StrAppendFormat(&out, "%-40s %12d %12.3f %12.3f %12.3f\n",
+                          site->name, count, total_ns / 1e6,
+                          total_ns / 1e3 / count, site->max_ns.load() / 1e3);
+  }
+  return out;
+}
+
+json::Object ReportJson() {
+  json::Object out;
+  for (const Site* site : SortedSites()) {
+    const int64_t count = site->count.load();
+    if (count == 0) continue;
+    out[site->name] = json::Object({
+        {"count", count},
+        {"total_ns", site->total_ns.load()},
+        {"max_ns", site->max_ns.load()},
+    });
+  }
+  return out;
+}
+
+std::string ChromeTrace() {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mu);
+  std::string out;
+  json::Writer writer(&out);
+  writer.BeginObject().Key("traceEvents").BeginArray();
+  for (const Event& event : registry.events) {
+    // Complete events, with times in microseconds.
+    writer.BeginObject()
+        .Key("name").Write(event.site->name)
+        .Key("ph").Write("X")
+        .Key("ts").Write(event.start_ns / 1e3)
+        .Key("dur").Write(event.duration_ns / 1e3)
+        .Key("pid").Write(0)
+        .Key("tid").Write(event.thread)
+        .EndObject();
+  }
+  writer.EndArray();
+  writer.Key("otherData").BeginObject()
+      .Key("num_dropped_events").Write(registry.num_dropped)
+      .EndObject();
+  writer.EndObject();
+  return out;
+}
+
+void WriteChromeTrace(const std::string& filename) {
+  file::File(filename, "w").Write(ChromeTrace());
+}
+
+}  // namespace open_spiel::profiler
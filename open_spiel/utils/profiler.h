@@ -0,0 +1,156 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_PROFILER_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_PROFILER_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <string>
+
+#include "open_spiel/utils/json.h"
+
+// Timers and counters for the hot paths of the algorithms, e.g. how long MCTS
+// spends cloning states or CFR computing information state strings.
+//
+// The library's call sites use the macros below, which compile to nothing
+// unless OPEN_SPIEL_PROFILING is defined, e.g. by configuring with
+// -DOPEN_SPIEL_PROFILING=ON, so they cost nothing in normal builds:
+//
+//   void Foo(const State& state) {
+//     OPEN_SPIEL_PROFILE_SCOPE("foo/Foo");
+//     std::unique_ptr<State> child =
+//         OPEN_SPIEL_PROFILE("foo/Child", state.Child(0));
+//   }
+//
+// Each name counts its calls and their total and longest time, on all
+// threads, for a report at the end of the run. With tracing started, every
+// call is also recorded as an event, to be written as a Chrome trace and
+// viewed in chrome://tracing or Perfetto.
+//
+// The functions below are always available, so binaries can write reports
+// whether or not the timers were compiled in; they are just empty otherwise.
+
+namespace open_spiel::profiler {
+
+// The counts of one timed name, shared by all its call sites.
+struct Site {
+  explicit Site(std::string name) : name(std::move(name)) {}
+
+  const std::string name;
+  std::atomic<int64_t> count{0};
+  std::atomic<int64_t> total_ns{0};
+  std::atomic<int64_t> max_ns{0};
+};
+
+// Returns the site with the given name, creating it on first use. The site
+// lives until the end of the program.
+Site* GetSite(const std::string& name);
+
+// Whether timers record anything, on by default. Disabled timers only cost
+// a relaxed atomic load.
+void SetEnabled(bool enabled);
+bool Enabled();
+
+// Starts or stops recording an event per timed call, for WriteChromeTrace.
+// At most max_events are kept, after which further events are dropped.
+void StartTracing(int64_t max_events = 1 << 20);
+void StopTracing();
+bool Tracing();
+
+// Clears the counts of all the sites and the recorded events.
+void Reset();
+
+// A table of the sites with their counts, total, mean and longest times,
+// sorted by total time.
+std::string Report();
+
+// The same as a json object keyed by site name.
+json::Object ReportJson();
+
+// The recorded events in the Chrome trace event format.
+std::string ChromeTrace();
+void WriteChromeTrace(const std::string& filename);
+
+namespace internal {
+
+extern std::atomic<bool> enabled;
+extern std::atomic<bool> tracing;
+
+inline int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Record(Site* site, int64_t start_ns, int64_t duration_ns);
+
+}  // namespace internal
+
+// Times its own lifetime into the site, if enabled when it is created.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Site* site)
+      : site_(internal::enabled.load(std::memory_order_relaxed) ? site
+                                                                : nullptr),
+        start_ns_(site_ != nullptr ? internal::NowNanos() : 0) {}
+
+  ~ScopedTimer() {
+    if (site_ != nullptr) {
+      internal::Record(site_, start_ns_, internal::NowNanos() - start_ns_);
+    }
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Site* const site_;
+  const int64_t start_ns_;
+};
+
+}  // namespace open_spiel::profiler
+
+#define OPEN_SPIEL_PROFILE_CONCAT_INNER(a, b) a##b
+#define OPEN_SPIEL_PROFILE_CONCAT(a, b) OPEN_SPIEL_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef OPEN_SPIEL_PROFILING
+
+// Times the rest of the enclosing scope.
+#define OPEN_SPIEL_PROFILE_SCOPE(name)                                      \
+  static ::open_spiel::profiler::Site* const OPEN_SPIEL_PROFILE_CONCAT(     \
+      open_spiel_profile_site_, __LINE__) =                                 \
+      ::open_spiel::profiler::GetSite(name);                                \
+  ::open_spiel::profiler::ScopedTimer OPEN_SPIEL_PROFILE_CONCAT(            \
+      open_spiel_profile_timer_, __LINE__)(                                 \
+      OPEN_SPIEL_PROFILE_CONCAT(open_spiel_profile_site_, __LINE__))
+
+// Times the expression, and evaluates to its value.
+#define OPEN_SPIEL_PROFILE(name, expr)                          \
+  ([&]() -> decltype(auto) {                                    \
+    OPEN_SPIEL_PROFILE_SCOPE(name);                             \
+    return expr;                                                \
+  }())
+
+#else  // OPEN_SPIEL_PROFILING
+
+#define OPEN_SPIEL_PROFILE_SCOPE(name) \
+  do {                                 \
+  } while (false)
+#define OPEN_SPIEL_PROFILE(name, expr) (expr)
+
+#endif  // OPEN_SPIEL_PROFILING
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_PROFILER_H_
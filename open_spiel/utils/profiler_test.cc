@@ -0,0 +1,117 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compile the macros in, whatever the rest of the build does.
+#ifndef OPEN_SPIEL_PROFILING
+#define OPEN_SPIEL_PROFILING
+#endif
+
+#include "open_spiel/utils/profiler.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/strings/match.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/json.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel::profiler {
+namespace {
+
+int Square(int x) {
+  OPEN_SPIEL_PROFILE_SCOPE("test/Square");
+  return x * x;
+}
+
+void TestCounts() {
+  Reset();
+  int sum = 0;
+  for (int i = 0; i < 10; ++i) sum += Square(i);
+  const std::vector<int> v = OPEN_SPIEL_PROFILE("test/Vector",
+                                                std::vector<int>(3, 1));
+  SPIEL_CHECK_EQ(sum, 285);
+  SPIEL_CHECK_EQ(v.size(), 3);
+
+  const Site* square = GetSite("test/Square");
+  SPIEL_CHECK_EQ(square->count.load(), 10);
+  SPIEL_CHECK_GE(square->total_ns.load(), square->max_ns.load());
+  SPIEL_CHECK_EQ(GetSite("test/Vector")->count.load(), 1);
+
+  json::Object report = ReportJson();
+  SPIEL_CHECK_EQ(report["test/Square"].GetObject()["count"], 10);
+  SPIEL_CHECK_TRUE(absl::StrContains(Report(), "test/Square"));
+
+  SetEnabled(false);
+  Square(1);
+  SetEnabled(true);
+  SPIEL_CHECK_EQ(square->count.load(), 10);
+
+  Reset();
+  SPIEL_CHECK_EQ(square->count.load(), 0);
+  SPIEL_CHECK_EQ(ReportJson().count("test/Square"), 0);
+}
+
+void TestThreads() {
+  Reset();
+  constexpr int kNumThreads = 4;
+  constexpr int kNumCalls = 1000;
+  std::vector<Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([]() {
+      for (int i = 0; i < kNumCalls; ++i) Square(i);
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+  SPIEL_CHECK_EQ(GetSite("test/Square")->count.load(),
+                 kNumThreads * kNumCalls);
+}
+
+void TestChromeTrace() {
+  Reset();
+  StartTracing(/*max_events=*/3);
+  for (int i = 0; i < 5; ++i) Square(i);
+  StopTracing();
+  Square(5);
+
+  std::optional<json::Value> trace = json::FromString(ChromeTrace());
+  SPIEL_CHECK_TRUE(trace.has_value());
+  const json::Array& events =
+      trace->GetObject().at("traceEvents").GetArray();
+  SPIEL_CHECK_EQ(events.size(), 3);
+  for (const json::Value& event : events) {
+    const json::Object& object = event.GetObject();
+    SPIEL_CHECK_EQ(object.at("name"), "test/Square");
+    SPIEL_CHECK_EQ(object.at("ph"), "X");
+    SPIEL_CHECK_TRUE(object.at("ts").IsNumber());
+    SPIEL_CHECK_TRUE(object.at("dur").IsNumber());
+  }
+  SPIEL_CHECK_EQ(trace->GetObject()
+                     .at("otherData")
+                     .GetObject()
+                     .at("num_dropped_events"),
+                 2);
+  SPIEL_CHECK_EQ(GetSite("test/Square")->count.load(), 6);
+  Reset();
+}
+
+}  // namespace
+}  // namespace open_spiel::profiler
+
+int main(int argc, char** argv) {
+  open_spiel::profiler::TestCounts();
+  open_spiel::profiler::TestThreads();
+  open_spiel::profiler::TestChromeTrace();
+}
@@ -0,0 +1,146 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_RANDOM_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_RANDOM_H_
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#include "open_spiel/abseil-cpp/absl/numeric/bits.h"
+#include "open_spiel/abseil-cpp/absl/numeric/int128.h"
+#include "open_spiel/spiel_utils.h"
+
+// Fast random number generation for the sampling algorithms, which draw a
+// few numbers per node: a small generator that is cheap to seed and copy, with
+// independent streams for threads, and bounded integers and reals taking a
+// single draw each, rather than the std:: distributions.
+
+namespace open_spiel {
+
+// The xoshiro256++ generator of Blackman and Vigna
+// (https://prng.di.unimi.it/), meeting the UniformRandomBitGenerator
+// requirements. Its state is 32 bytes and its period 2^256 - 1. Unlike
+// SplitMix64 (see spiel_utils.h), which seeds it, it can be split into
+// non-overlapping streams with Jump().
+class Xoshiro256PlusPlus {
+ public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256PlusPlus(uint64_t seed = 0) {
+    SplitMix64 seeder(seed);
+    for (uint64_t& word : state_) word = seeder();
+  }
+
+  // The generator of stream `stream` of `seed`, as a seed derived from both:
+  // the streams are not guaranteed disjoint as with Jump(), but overlaps are
+  // vanishingly unlikely. For many short streams, e.g. one per episode.
+  static Xoshiro256PlusPlus Stream(uint64_t seed, uint64_t stream) {
+    return Xoshiro256PlusPlus(HashMix(HashMix(seed) ^ stream));
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~result_type{0}; }
+
+  result_type operator()() {
+    const uint64_t result = absl::rotl(state_[0] + state_[3], 23) + state_[0];
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = absl::rotl(state_[3], 45);
+    return result;
+  }
+
+  // Advances the generator by 2^128 draws. Copies of a generator jumped
+  // 0, 1, 2, ... times give non-overlapping streams, e.g. one per thread.
+  void Jump() {
+    static constexpr uint64_t kJump[] = {
+        0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+        0x39abdc4529b1661c};
+    std::array<uint64_t, 4> jumped = {0, 0, 0, 0};
+    for (uint64_t word : kJump) {
+      for (int bit = 0; bit < 64; ++bit) {
+        if (word & (uint64_t{1} << bit)) {
+          for (int i = 0; i < 4; ++i) jumped[i] ^= state_[i];
+        }
+        (*this)();
+      }
+    }
+    state_ = jumped;
+  }
+
+  bool operator==(const Xoshiro256PlusPlus& other) const {
+    return state_ == other.state_;
+  }
+  bool operator!=(const Xoshiro256PlusPlus& other) const {
+    return !(*this == other);
+  }
+
+  // Writes and reads the state as text, as for the std:: engines, e.g. for
+  // checkpoints.
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const Xoshiro256PlusPlus& rng) {
+    return os << rng.state_[0] << " " << rng.state_[1] << " " << rng.state_[2]
+              << " " << rng.state_[3];
+  }
+  friend std::istream& operator>>(std::istream& is, Xoshiro256PlusPlus& rng) {
+    std::array<uint64_t, 4> state;
+    if (is >> state[0] >> state[1] >> state[2] >> state[3]) {
+      rng.state_ = state;
+    }
+    return is;
+  }
+
+ private:
+  std::array<uint64_t, 4> state_;
+};
+
+// The helpers below take a single draw, but for UniformInt's rare rejections,
+// of a generator of 64 random bits, such as Xoshiro256PlusPlus or SplitMix64.
+template <typename URBG>
+constexpr bool IsFull64BitGenerator() {
+  return URBG::min() == 0 && URBG::max() == ~uint64_t{0};
+}
+
+// Returns an integer uniformly in [0, n), for n > 0, by Lemire's
+// multiply-and-shift method, which avoids the division of the modulo method
+// except to reject the few values that would bias the result.
+template <typename URBG>
+uint64_t UniformInt(URBG& rng, uint64_t n) {
+  static_assert(IsFull64BitGenerator<URBG>(), "Requires 64 random bits.");
+  absl::uint128 product = absl::uint128(rng()) * n;
+  if (absl::Uint128Low64(product) < n) {
+    const uint64_t threshold = -n % n;
+    while (absl::Uint128Low64(product) < threshold) {
+      product = absl::uint128(rng()) * n;
+    }
+  }
+  return absl::Uint128High64(product);
+}
+
+// Returns a double uniformly in [0, 1), as a multiple of 2^-53.
+template <typename URBG>
+double UniformDouble(URBG& rng) {
+  static_assert(IsFull64BitGenerator<URBG>(), "Requires 64 random bits.");
+  return (rng() >> 11) * 0x1.0p-53;
+}
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_RANDOM_H_
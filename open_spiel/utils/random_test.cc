@@ -0,0 +1,136 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/random.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+Xoshiro256PlusPlus FromState(const std::string& state) {
+  Xoshiro256PlusPlus rng;
+  std::istringstream stream(state);
+  stream >> rng;
+  SPIEL_CHECK_FALSE(stream.fail());
+  return rng;
+}
+
+void TestXoshiroReferenceValues() {
+  // The outputs of the reference implementation from the state {1, 2, 3, 4}.
+  Xoshiro256PlusPlus rng = FromState("1 2 3 4");
+  SPIEL_CHECK_EQ(rng(), 41943041ULL);
+  SPIEL_CHECK_EQ(rng(), 58720359ULL);
+  SPIEL_CHECK_EQ(rng(), 3588806011781223ULL);
+
+  Xoshiro256PlusPlus jumped = FromState("1 2 3 4");
+  jumped.Jump();
+  std::ostringstream state;
+  state << jumped;
+  SPIEL_CHECK_EQ(state.str(),
+                 "10122426448480695249 8079205330032121950 "
+                 "7289065458748526725 9477464255293849680");
+}
+
+void TestSplitMix64ReferenceValues() {
+  // The outputs of the reference implementation from the seeds 1234567 and 0.
+  SplitMix64 rng(1234567);
+  SPIEL_CHECK_EQ(rng(), 6457827717110365317ULL);
+  SPIEL_CHECK_EQ(rng(), 3203168211198807973ULL);
+  SPIEL_CHECK_EQ(rng(), 9817491932198370423ULL);
+
+  SplitMix64 zero(0);
+  SPIEL_CHECK_EQ(zero(), 0xe220a8397b1dcdafULL);
+  SPIEL_CHECK_EQ(zero(), 0x6e789e6aa1b965f4ULL);
+  SPIEL_CHECK_EQ(zero(), 0x06c45d188009454fULL);
+}
+
+void TestXoshiroSeedsAndStreams() {
+  Xoshiro256PlusPlus a(7);
+  Xoshiro256PlusPlus b(7);
+  SPIEL_CHECK_TRUE(a == b);
+  SPIEL_CHECK_TRUE(a != Xoshiro256PlusPlus(8));
+  for (int i = 0; i < 10; ++i) SPIEL_CHECK_EQ(a(), b());
+
+  Xoshiro256PlusPlus jumped = a;
+  jumped.Jump();
+  SPIEL_CHECK_TRUE(jumped != a);
+  SPIEL_CHECK_NE(jumped(), a());
+
+  SPIEL_CHECK_TRUE(Xoshiro256PlusPlus::Stream(1, 0) ==
+                   Xoshiro256PlusPlus::Stream(1, 0));
+  SPIEL_CHECK_TRUE(Xoshiro256PlusPlus::Stream(1, 0) !=
+                   Xoshiro256PlusPlus::Stream(1, 1));
+  SPIEL_CHECK_TRUE(Xoshiro256PlusPlus::Stream(1, 0) !=
+                   Xoshiro256PlusPlus::Stream(2, 0));
+
+  // The state round-trips through text, as for checkpoints.
+  std::stringstream stream;
+  stream << a;
+  Xoshiro256PlusPlus restored;
+  stream >> restored;
+  SPIEL_CHECK_TRUE(restored == a);
+}
+
+void TestUniformInt() {
+  Xoshiro256PlusPlus rng(0);
+  constexpr int kNumDraws = 60000;
+  for (uint64_t n : {1, 2, 3, 6, 7}) {
+    std::vector<int> counts(n, 0);
+    for (int i = 0; i < kNumDraws; ++i) {
+      const uint64_t value = UniformInt(rng, n);
+      SPIEL_CHECK_LT(value, n);
+      ++counts[value];
+    }
+    for (int count : counts) {
+      SPIEL_CHECK_FLOAT_NEAR(static_cast<double>(count) / kNumDraws,
+                             1.0 / n, 0.01);
+    }
+  }
+  // The largest bounds reject about half of the draws.
+  const uint64_t n = (uint64_t{1} << 63) + 1;
+  for (int i = 0; i < 100; ++i) SPIEL_CHECK_LT(UniformInt(rng, n), n);
+
+  SplitMix64 split_mix(0);
+  for (int i = 0; i < 100; ++i) SPIEL_CHECK_LT(UniformInt(split_mix, 10), 10);
+}
+
+void TestUniformDouble() {
+  Xoshiro256PlusPlus rng(0);
+  constexpr int kNumDraws = 100000;
+  double sum = 0;
+  for (int i = 0; i < kNumDraws; ++i) {
+    const double value = UniformDouble(rng);
+    SPIEL_CHECK_GE(value, 0);
+    SPIEL_CHECK_LT(value, 1);
+    sum += value;
+  }
+  SPIEL_CHECK_FLOAT_NEAR(sum / kNumDraws, 0.5, 0.01);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestXoshiroReferenceValues();
+  open_spiel::TestSplitMix64ReferenceValues();
+  open_spiel::TestXoshiroSeedsAndStreams();
+  open_spiel::TestUniformInt();
+  open_spiel::TestUniformDouble();
+}
@@ -0,0 +1,255 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_REPLAY_BUFFER_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_REPLAY_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/container/flat_hash_set.h"
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+
+// A circular buffer of fixed size like CircularBuffer, which any number of
+// threads can add to and sample from at once, e.g. actors filling it with
+// trajectories while a learner samples batches of them.
+//
+// Adding only takes an atomic counter to claim the slot of the oldest element
+// and a lock on that slot, so writers don't contend with each other and
+// readers only wait for a write to the slot they are reading. Sampling k
+// elements takes O(k) time, however large the buffer.
+template <class T>
+class ReplayBuffer {
+ public:
+  explicit ReplayBuffer(int max_size) : slots_(max_size) {
+    SPIEL_CHECK_GT(max_size, 0);
+  }
+
+  ReplayBuffer(const ReplayBuffer&) = delete;
+  ReplayBuffer& operator=(const ReplayBuffer&) = delete;
+
+  // Add one element, replacing the oldest once it's full. Returns the index
+  // it was written to.
+  int Add(T value) {
+    const int64_t n = total_added_.fetch_add(1, std::memory_order_relaxed);
+    const int index = n % MaxSize();
+    Slot& slot = slots_[index];
+    slot.Lock();
+    slot.value = std::move(value);
+    slot.Unlock();
+    return index;
+  }
+
+  // Return a copy of the element at index, which is in [0, Size()).
+  T Get(int index) const {
+    const Slot& slot = slots_[index];
+    while (true) {
+      slot.Lock();
+      if (slot.value.has_value()) {
+        T value = *slot.value;
+        slot.Unlock();
+        return value;
+      }
+      // The slot has been claimed by a writer, which hasn't filled it yet.
+      slot.Unlock();
+      std::this_thread::yield();
+    }
+  }
+
+  // Return `num` elements without replacement, or all of them if there are
+  // fewer, in the order of their indices.
+  std::vector<T> Sample(std::mt19937* rng, int num) const {
+    std::vector<int> indices = SampleIndices(rng, num);
+    std::sort(indices.begin(), indices.end());
+    std::vector<T> out;
+    out.reserve(indices.size());
+    for (int index : indices) out.push_back(Get(index));
+    return out;
+  }
+
+  // How many elements are in the buffer. Elements whose writes are still in
+  // progress are counted.
+  int Size() const {
+    return std::min<int64_t>(TotalAdded(), MaxSize());
+  }
+
+  bool Empty() const { return TotalAdded() == 0; }
+
+  int MaxSize() const { return slots_.size(); }
+
+  // How many elements have ever been added to the buffer.
+  int64_t TotalAdded() const {
+    return total_added_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    void Lock() const {
+      while (locked.exchange(true, std::memory_order_acquire)) {
+        while (locked.load(std::memory_order_relaxed)) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    void Unlock() const { locked.store(false, std::memory_order_release); }
+
+    mutable std::atomic<bool> locked{false};
+    std::optional<T> value;
+  };
+
+  // Floyd's algorithm: a uniform sample of distinct indices, in O(num).
+  std::vector<int> SampleIndices(std::mt19937* rng, int num) const {
+    const int size = Size();
+    num = std::min(num, size);
+    std::vector<int> indices;
+    indices.reserve(num);
+    absl::flat_hash_set<int> chosen;
+    chosen.reserve(num);
+    for (int j = size - num; j < size; ++j) {
+      int index = std::uniform_int_distribution<int>(0, j)(*rng);
+      if (!chosen.insert(index).second) {
+        index = j;
+        chosen.insert(index);
+      }
+      indices.push_back(index);
+    }
+    return indices;
+  }
+
+  std::vector<Slot> slots_;
+  std::atomic<int64_t> total_added_{0};
+};
+
+// A binary tree over a fixed number of non-negative priorities, where each
+// node holds the sum of its children, to sample indices in proportion to
+// their priority and update priorities in O(log n). Not thread-safe.
+class SumTree {
+ public:
+  explicit SumTree(int size) : size_(size), nodes_(2 * size, 0.0) {}
+
+  int Size() const { return size_; }
+  double Total() const { return nodes_[1]; }
+  double Get(int index) const { return nodes_[size_ + index]; }
+
+  void Set(int index, double priority) {
+    SPIEL_CHECK_GE(priority, 0);
+    int node = size_ + index;
+    nodes_[node] = priority;
+    for (node /= 2; node >= 1; node /= 2) {
+      nodes_[node] = nodes_[2 * node] + nodes_[2 * node + 1];
+    }
+  }
+
+  // Returns the index whose priority covers `value` in [0, Total()), with
+  // the indices' priorities laid end to end.
+  int Find(double value) const {
+    int node = 1;
+    while (node < size_) {
+      const double left = nodes_[2 * node];
+      if (value < left || nodes_[2 * node + 1] <= 0) {
+        node = 2 * node;
+      } else {
+        value -= left;
+        node = 2 * node + 1;
+      }
+    }
+    return node - size_;
+  }
+
+ private:
+  // The leaves are at [size_, 2 * size_) and the nodes above them at
+  // [1, size_), so the root is at 1. Sizes that aren't powers of two spread
+  // the leaves over two levels, which the sums don't mind.
+  const int size_;
+  std::vector<double> nodes_;
+};
+
+// A ReplayBuffer where elements are sampled with replacement in proportion
+// to a priority, as in prioritized experience replay; the learner usually
+// updates the priorities of the elements it sampled. Writers and samplers
+// share a lock over the priorities, held briefly.
+template <class T>
+class PrioritizedReplayBuffer {
+ public:
+  explicit PrioritizedReplayBuffer(int max_size)
+      : buffer_(max_size), priorities_(max_size) {}
+
+  // Add one element with the given priority, replacing the oldest once it's
+  // full. Returns the index it was written to.
+  int Add(T value, double priority) {
+    const int index = buffer_.Add(std::move(value));
+    absl::MutexLock lock(&mu_);
+    priorities_.Set(index, priority);
+    return index;
+  }
+
+  void UpdatePriority(int index, double priority) {
+    absl::MutexLock lock(&mu_);
+    priorities_.Set(index, priority);
+  }
+
+  double Priority(int index) const {
+    absl::ReaderMutexLock lock(&mu_);
+    return priorities_.Get(index);
+  }
+
+  double TotalPriority() const {
+    absl::ReaderMutexLock lock(&mu_);
+    return priorities_.Total();
+  }
+
+  // Return `num` elements sampled with replacement in proportion to their
+  // priorities, and optionally their indices, e.g. for UpdatePriority. There
+  // must be an element with nonzero priority.
+  std::vector<T> Sample(std::mt19937* rng, int num,
+                        std::vector<int>* indices = nullptr) const {
+    std::vector<int> sampled(num);
+    {
+      absl::ReaderMutexLock lock(&mu_);
+      const double total = priorities_.Total();
+      SPIEL_CHECK_GT(total, 0);
+      std::uniform_real_distribution<double> dist(0, total);
+      for (int i = 0; i < num; ++i) sampled[i] = priorities_.Find(dist(*rng));
+    }
+    std::vector<T> out;
+    out.reserve(num);
+    for (int index : sampled) out.push_back(buffer_.Get(index));
+    if (indices != nullptr) *indices = std::move(sampled);
+    return out;
+  }
+
+  T Get(int index) const { return buffer_.Get(index); }
+  int Size() const { return buffer_.Size(); }
+  bool Empty() const { return buffer_.Empty(); }
+  int MaxSize() const { return buffer_.MaxSize(); }
+  int64_t TotalAdded() const { return buffer_.TotalAdded(); }
+
+ private:
+  ReplayBuffer<T> buffer_;
+  mutable absl::Mutex mu_;
+  SumTree priorities_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_REPLAY_BUFFER_H_
@@ -0,0 +1,159 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/replay_buffer.h"
+
+#include <random>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+namespace {
+
+void TestReplayBuffer() {
+  ReplayBuffer<int> buffer(4);
+  std::mt19937 rng;
+  std::vector<int> sample;
+
+  SPIEL_CHECK_TRUE(buffer.Empty());
+  SPIEL_CHECK_EQ(buffer.Size(), 0);
+  SPIEL_CHECK_TRUE(buffer.Sample(&rng, 2).empty());
+
+  SPIEL_CHECK_EQ(buffer.Add(13), 0);
+  SPIEL_CHECK_FALSE(buffer.Empty());
+  SPIEL_CHECK_EQ(buffer.Size(), 1);
+  SPIEL_CHECK_EQ(buffer.TotalAdded(), 1);
+  SPIEL_CHECK_EQ(buffer.Get(0), 13);
+
+  sample = buffer.Sample(&rng, 2);
+  SPIEL_CHECK_EQ(sample, std::vector<int>({13}));
+
+  buffer.Add(14);
+  buffer.Add(15);
+  buffer.Add(16);
+  SPIEL_CHECK_EQ(buffer.Size(), 4);
+  SPIEL_CHECK_EQ(buffer.Sample(&rng, 4), std::vector<int>({13, 14, 15, 16}));
+
+  SPIEL_CHECK_EQ(buffer.Add(17), 0);
+  SPIEL_CHECK_EQ(buffer.Add(18), 1);
+  SPIEL_CHECK_EQ(buffer.Size(), 4);
+  SPIEL_CHECK_EQ(buffer.TotalAdded(), 6);
+
+  for (int i = 0; i < 100; ++i) {
+    sample = buffer.Sample(&rng, 2);
+    SPIEL_CHECK_EQ(sample.size(), 2);
+    SPIEL_CHECK_NE(sample[0], sample[1]);
+    for (int value : sample) {
+      SPIEL_CHECK_GE(value, 15);
+      SPIEL_CHECK_LE(value, 18);
+    }
+  }
+}
+
+void TestReplayBufferUniform() {
+  ReplayBuffer<int> buffer(10);
+  for (int i = 0; i < 10; ++i) buffer.Add(i);
+  std::mt19937 rng;
+  std::vector<int> count(10, 0);
+  for (int i = 0; i < 10000; ++i) {
+    for (int value : buffer.Sample(&rng, 3)) ++count[value];
+  }
+  for (int n : count) {
+    SPIEL_CHECK_GT(n, 2700);
+    SPIEL_CHECK_LT(n, 3300);
+  }
+}
+
+void TestReplayBufferThreads() {
+  constexpr int kNumWriters = 4;
+  constexpr int kNumValues = 5000;
+  ReplayBuffer<std::vector<int>> buffer(1000);
+  std::vector<Thread> threads;
+  for (int w = 0; w < kNumWriters; ++w) {
+    threads.emplace_back([&buffer, w]() {
+      for (int i = 0; i < kNumValues; ++i) {
+        buffer.Add(std::vector<int>(8, w * kNumValues + i));
+      }
+    });
+  }
+  threads.emplace_back([&buffer]() {
+    std::mt19937 rng;
+    for (int i = 0; i < 1000; ++i) {
+      // Elements are never seen half written.
+      for (const std::vector<int>& value : buffer.Sample(&rng, 16)) {
+        SPIEL_CHECK_EQ(value.size(), 8);
+        SPIEL_CHECK_EQ(value.front(), value.back());
+      }
+    }
+  });
+  for (Thread& thread : threads) thread.join();
+  SPIEL_CHECK_EQ(buffer.TotalAdded(), kNumWriters * kNumValues);
+  SPIEL_CHECK_EQ(buffer.Size(), 1000);
+}
+
+void TestSumTree() {
+  SumTree tree(5);
+  for (int i = 0; i < 5; ++i) tree.Set(i, i + 1);
+  SPIEL_CHECK_EQ(tree.Total(), 15);
+  tree.Set(4, 0);
+  SPIEL_CHECK_EQ(tree.Total(), 10);
+  std::vector<double> covered(5, 0);
+  for (int i = 0; i < 100; ++i) covered[tree.Find(i / 10.)] += 0.1;
+  for (int i = 0; i < 5; ++i) {
+    SPIEL_CHECK_FLOAT_NEAR(covered[i], tree.Get(i), 1e-6);
+  }
+}
+
+void TestPrioritizedReplayBuffer() {
+  PrioritizedReplayBuffer<int> buffer(4);
+  std::mt19937 rng;
+  buffer.Add(10, 1);
+  buffer.Add(11, 3);
+  buffer.Add(12, 0);
+  SPIEL_CHECK_EQ(buffer.TotalPriority(), 4);
+
+  std::vector<int> count(3, 0);
+  std::vector<int> indices;
+  for (int value : buffer.Sample(&rng, 4000, &indices)) ++count[value - 10];
+  SPIEL_CHECK_EQ(indices.size(), 4000);
+  SPIEL_CHECK_EQ(buffer.Get(indices[0]), 10 + indices[0]);
+  SPIEL_CHECK_GT(count[0], 850);
+  SPIEL_CHECK_LT(count[0], 1150);
+  SPIEL_CHECK_EQ(count[2], 0);
+
+  buffer.UpdatePriority(0, 0);
+  buffer.UpdatePriority(1, 0);
+  buffer.UpdatePriority(2, 2);
+  SPIEL_CHECK_EQ(buffer.Priority(2), 2);
+  SPIEL_CHECK_EQ(buffer.Sample(&rng, 3), std::vector<int>({12, 12, 12}));
+
+  // Replacing the oldest element replaces its priority.
+  buffer.Add(13, 0);
+  buffer.Add(14, 5);
+  SPIEL_CHECK_EQ(buffer.Get(0), 14);
+  SPIEL_CHECK_EQ(buffer.TotalPriority(), 7);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestReplayBuffer();
+  open_spiel::TestReplayBufferUniform();
+  open_spiel::TestReplayBufferThreads();
+  open_spiel::TestSumTree();
+  open_spiel::TestPrioritizedReplayBuffer();
+}
@@ -16,9 +16,19 @@
 #define THIRD_PARTY_OPEN_SPIEL_UTILS_STATS_H_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "open_spiel/abseil-cpp/absl/algorithm/container.h"
+#include "open_spiel/abseil-cpp/absl/numeric/bits.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/utils/json.h"
 
 namespace open_spiel {
@@ -77,6 +87,8 @@ class BasicStats {
   }
 
  private:
+  friend class ConcurrentBasicStats;
+
   int64_t num_;
   double min_;
   double max_;
@@ -117,6 +129,328 @@ class HistogramNamed {
   std::vector<std::string> names_;
 };
 
+// Track the count, min, max, average and percentiles of non-negative integer
+// values, e.g. latencies in microseconds, in HDR histogram style buckets: each
+// power of two range is split into 2^precision_bits equal buckets, so the
+// values are kept to a relative precision of 2^-precision_bits (3% by
+// default) in a fixed amount of memory, whatever their range. Histograms of
+// the same precision can be merged, e.g. per thread histograms.
+class LatencyHistogram {
+ public:
+  explicit LatencyHistogram(int precision_bits = 5)
+      : precision_bits_(precision_bits),
+        counts_(NumBuckets(precision_bits), 0) {
+    Reset();
+  }
+
+  void Reset() {
+    absl::c_fill(counts_, 0);
+    num_ = 0;
+    sum_ = 0;
+    min_ = std::numeric_limits<int64_t>::max();
+    max_ = 0;
+  }
+
+  LatencyHistogram& operator+=(const LatencyHistogram& o) {
+    SPIEL_CHECK_EQ(precision_bits_, o.precision_bits_);
+    for (int i = 0; i < counts_.size(); ++i) counts_[i] += o.counts_[i];
+    num_ += o.num_;
+    sum_ += o.sum_;
+    min_ = std::min(min_, o.min_);
+    max_ = std::max(max_, o.max_);
+    return *this;
+  }
+
+  // Negative values are counted as 0.
+  void Add(int64_t value) {
+    value = std::max<int64_t>(value, 0);
+    counts_[BucketIndex(value, precision_bits_)] += 1;
+    num_ += 1;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  int64_t Num() const { return num_; }
+  int64_t Min() const { return (num_ == 0 ? 0 : min_); }
+  int64_t Max() const { return max_; }
+  double Avg() const {
+    return (num_ == 0 ? 0 : static_cast<double>(sum_) / num_);
+  }
+
+  // The smallest bucket's upper bound that at least `fraction` of the values
+  // are at most, e.g. 0.99 for the 99th percentile.
+  int64_t Percentile(double fraction) const {
+    if (num_ == 0) return 0;
+    const int64_t rank = std::max<int64_t>(1, std::ceil(fraction * num_));
+    int64_t seen = 0;
+    for (int i = 0; i < counts_.size(); ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return std::clamp(BucketUpperBound(i, precision_bits_), Min(), max_);
+      }
+    }
+    return max_;
+  }
+
+  json::Object ToJson() const {
+    return {
+        {"num", Num()},
+        {"min", Min()},
+        {"max", Max()},
+        {"avg", Avg()},
+        {"p50", Percentile(0.5)},
+        {"p90", Percentile(0.9)},
+        {"p99", Percentile(0.99)},
+        {"p999", Percentile(0.999)},
+    };
+  }
+
+  // Values below 2^(precision_bits + 1) have their own buckets. Above that,
+  // the bucket of a value is given by its highest precision_bits + 1 bits.
+  static int NumBuckets(int precision_bits) {
+    return (64 - precision_bits) << precision_bits;
+  }
+  static int BucketIndex(int64_t value, int precision_bits) {
+    const int64_t sub_buckets = int64_t{1} << precision_bits;
+    if (value < sub_buckets) return value;
+    const int shift =
+        absl::bit_width(static_cast<uint64_t>(value)) - 1 - precision_bits;
+    return ((shift + 1) << precision_bits) + (value >> shift) - sub_buckets;
+  }
+  static int64_t BucketUpperBound(int index, int precision_bits) {
+    const int64_t sub_buckets = int64_t{1} << precision_bits;
+    if (index < sub_buckets) return index;
+    const int shift = (index >> precision_bits) - 1;
+    const uint64_t top_bits = sub_buckets + (index & (sub_buckets - 1));
+    // Unsigned, as the top bucket's bound would overflow before the - 1.
+    return ((top_bits + 1) << shift) - 1;
+  }
+
+ private:
+  friend class ConcurrentLatencyHistogram;
+
+  int precision_bits_;
+  std::vector<int64_t> counts_;
+  int64_t num_;
+  int64_t sum_;
+  int64_t min_;
+  int64_t max_;
+};
+
+namespace internal {
+
+// Concurrent stats spread their updates over this many copies, each on its
+// own cache line, so that threads rarely update the same memory. Reads merge
+// the copies.
+constexpr int kNumStatsShards = 16;
+
+// The shard the calling thread updates. Threads are numbered in the order
+// they first use a concurrent stat, so up to kNumStatsShards threads never
+// share a shard.
+inline int StatsShard() {
+  static std::atomic<int> num_threads{0};
+  thread_local const int shard =
+      num_threads.fetch_add(1, std::memory_order_relaxed) % kNumStatsShards;
+  return shard;
+}
+
+inline void AtomicAdd(std::atomic<double>* a, double value) {
+  double old = a->load(std::memory_order_relaxed);
+  while (!a->compare_exchange_weak(old, old + value,
+                                   std::memory_order_relaxed)) {
+  }
+}
+
+template <class T>
+void AtomicMin(std::atomic<T>* a, T value) {
+  T old = a->load(std::memory_order_relaxed);
+  while (value < old &&
+         !a->compare_exchange_weak(old, value, std::memory_order_relaxed)) {
+  }
+}
+
+template <class T>
+void AtomicMax(std::atomic<T>* a, T value) {
+  T old = a->load(std::memory_order_relaxed);
+  while (value > old &&
+         !a->compare_exchange_weak(old, value, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace internal
+
+// A counter that many threads can add to at once without contending, e.g. for
+// the number of simulations across MCTS threads. Lock-free.
+class ConcurrentCounter {
+ public:
+  void Add(int64_t value = 1) {
+    shards_[internal::StatsShard()].value.fetch_add(value,
+                                                    std::memory_order_relaxed);
+  }
+
+  int64_t Value() const {
+    int64_t total = 0;
+    for (const Shard& shard : shards_) {
+      total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  void Reset() {
+    for (Shard& shard : shards_) shard.value.store(0);
+  }
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value{0};
+  };
+  std::array<Shard, internal::kNumStatsShards> shards_;
+};
+
+// BasicStats that many threads can add to at once, lock-free. Snapshot returns
+// the merged BasicStats; values added concurrently may be partially included.
+class ConcurrentBasicStats {
+ public:
+  ConcurrentBasicStats() { Reset(); }
+
+  void Reset() {
+    for (Shard& shard : shards_) {
+      shard.num.store(0);
+      shard.sum.store(0);
+      shard.sum_sq.store(0);
+      shard.min.store(std::numeric_limits<double>::max());
+      shard.max.store(std::numeric_limits<double>::min());
+    }
+  }
+
+  void Add(double val) {
+    Shard& shard = shards_[internal::StatsShard()];
+    internal::AtomicMin(&shard.min, val);
+    internal::AtomicMax(&shard.max, val);
+    internal::AtomicAdd(&shard.sum, val);
+    internal::AtomicAdd(&shard.sum_sq, val * val);
+    shard.num.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  BasicStats Snapshot() const {
+    BasicStats stats;
+    for (const Shard& shard : shards_) {
+      BasicStats s;
+      s.num_ = shard.num.load(std::memory_order_relaxed);
+      s.sum_ = shard.sum.load(std::memory_order_relaxed);
+      s.sum_sq_ = shard.sum_sq.load(std::memory_order_relaxed);
+      s.min_ = shard.min.load(std::memory_order_relaxed);
+      s.max_ = shard.max.load(std::memory_order_relaxed);
+      stats += s;
+    }
+    return stats;
+  }
+
+  json::Object ToJson() const { return Snapshot().ToJson(); }
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<int64_t> num;
+    std::atomic<double> sum;
+    std::atomic<double> sum_sq;
+    std::atomic<double> min;
+    std::atomic<double> max;
+  };
+  std::array<Shard, internal::kNumStatsShards> shards_;
+};
+
+// A LatencyHistogram that many threads can add to at once, lock-free.
+// Snapshot returns the merged histogram; values added concurrently may be
+// partially included.
+class ConcurrentLatencyHistogram {
+ public:
+  explicit ConcurrentLatencyHistogram(int precision_bits = 5)
+      : precision_bits_(precision_bits) {
+    const int num_buckets = LatencyHistogram::NumBuckets(precision_bits);
+    for (Shard& shard : shards_) {
+      shard.counts = std::make_unique<std::atomic<int64_t>[]>(num_buckets);
+    }
+    Reset();
+  }
+
+  void Reset() {
+    const int num_buckets = LatencyHistogram::NumBuckets(precision_bits_);
+    for (Shard& shard : shards_) {
+      for (int i = 0; i < num_buckets; ++i) shard.counts[i].store(0);
+      shard.num.store(0);
+      shard.sum.store(0);
+      shard.min.store(std::numeric_limits<int64_t>::max());
+      shard.max.store(0);
+    }
+  }
+
+  // Negative values are counted as 0.
+  void Add(int64_t value) {
+    value = std::max<int64_t>(value, 0);
+    Shard& shard = shards_[internal::StatsShard()];
+    shard.counts[LatencyHistogram::BucketIndex(value, precision_bits_)]
+        .fetch_add(1, std::memory_order_relaxed);
+    shard.num.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    internal::AtomicMin(&shard.min, value);
+    internal::AtomicMax(&shard.max, value);
+  }
+
+  LatencyHistogram Snapshot() const {
+    LatencyHistogram hist(precision_bits_);
+    for (const Shard& shard : shards_) {
+      for (int i = 0; i < hist.counts_.size(); ++i) {
+        hist.counts_[i] += shard.counts[i].load(std::memory_order_relaxed);
+      }
+      hist.num_ += shard.num.load(std::memory_order_relaxed);
+      hist.sum_ += shard.sum.load(std::memory_order_relaxed);
+      hist.min_ =
+          std::min(hist.min_, shard.min.load(std::memory_order_relaxed));
+      hist.max_ =
+          std::max(hist.max_, shard.max.load(std::memory_order_relaxed));
+    }
+    return hist;
+  }
+
+  json::Object ToJson() const { return Snapshot().ToJson(); }
+
+ private:
+  struct alignas(64) Shard {
+    std::unique_ptr<std::atomic<int64_t>[]> counts;
+    std::atomic<int64_t> num;
+    std::atomic<int64_t> sum;
+    std::atomic<int64_t> min;
+    std::atomic<int64_t> max;
+  };
+
+  const int precision_bits_;
+  std::array<Shard, internal::kNumStatsShards> shards_;
+};
+
+// Adds the time from its construction to its destruction, in microseconds, to
+// a LatencyHistogram or ConcurrentLatencyHistogram. For example:
+//   {
+//     ScopedLatencyTimer timer(&evaluator_latency);
+//     evaluator->Evaluate(state);
+//   }
+template <class Histogram>
+class ScopedLatencyTimer {
+ public:
+  explicit ScopedLatencyTimer(Histogram* histogram)
+      : histogram_(histogram), start_(absl::Now()) {}
+  ~ScopedLatencyTimer() {
+    histogram_->Add(absl::ToInt64Microseconds(absl::Now() - start_));
+  }
+
+  ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+  ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+ private:
+  Histogram* histogram_;
+  const absl::Time start_;
+};
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_STATS_H_
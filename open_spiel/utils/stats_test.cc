@@ -14,8 +14,13 @@
 
 #include "open_spiel/utils/stats.h"
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/utils/json.h"
+#include "open_spiel/utils/thread.h"
 
 namespace open_spiel {
 namespace {
@@ -106,6 +111,94 @@ void TestHistogramNamed() {
   }));
 }
 
+void TestLatencyHistogram() {
+  LatencyHistogram hist(/*precision_bits=*/3);
+  SPIEL_CHECK_EQ(hist.Num(), 0);
+  SPIEL_CHECK_EQ(hist.Percentile(0.5), 0);
+
+  // Values below 16 are exact.
+  for (int i = 1; i <= 10; ++i) hist.Add(i);
+  SPIEL_CHECK_EQ(hist.Num(), 10);
+  SPIEL_CHECK_EQ(hist.Min(), 1);
+  SPIEL_CHECK_EQ(hist.Max(), 10);
+  SPIEL_CHECK_EQ(hist.Avg(), 5.5);
+  SPIEL_CHECK_EQ(hist.Percentile(0.5), 5);
+  SPIEL_CHECK_EQ(hist.Percentile(0.9), 9);
+  SPIEL_CHECK_EQ(hist.Percentile(1), 10);
+
+  // Larger values are within 1/8 of the truth.
+  hist.Reset();
+  for (int i = 1; i <= 10000; ++i) hist.Add(i * 100);
+  SPIEL_CHECK_EQ(hist.Max(), 1000000);
+  for (double fraction : {0.1, 0.5, 0.9, 0.99}) {
+    double expected = fraction * 1000000;
+    SPIEL_CHECK_GE(hist.Percentile(fraction), expected);
+    SPIEL_CHECK_LE(hist.Percentile(fraction), expected * 1.125);
+  }
+
+  // Each value is in the bucket up to its upper bound.
+  for (int64_t value : {int64_t{0}, int64_t{17}, int64_t{1} << 40,
+                        std::numeric_limits<int64_t>::max()}) {
+    int index = LatencyHistogram::BucketIndex(value, 3);
+    SPIEL_CHECK_LT(index, LatencyHistogram::NumBuckets(3));
+    SPIEL_CHECK_GE(LatencyHistogram::BucketUpperBound(index, 3), value);
+    if (index > 0) {
+      SPIEL_CHECK_LT(LatencyHistogram::BucketUpperBound(index - 1, 3), value);
+    }
+  }
+
+  LatencyHistogram other(3);
+  other.Add(5000000);
+  hist += other;
+  SPIEL_CHECK_EQ(hist.Num(), 10001);
+  SPIEL_CHECK_EQ(hist.Max(), 5000000);
+  SPIEL_CHECK_EQ(hist.ToJson()["p999"], hist.Percentile(0.999));
+}
+
+void TestConcurrentStats() {
+  constexpr int kNumThreads = 20;
+  constexpr int kNumValues = 1000;
+  ConcurrentCounter counter;
+  ConcurrentBasicStats stats;
+  ConcurrentLatencyHistogram hist;
+  std::vector<Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 1; i <= kNumValues; ++i) {
+        counter.Add();
+        stats.Add(i);
+        hist.Add(i);
+      }
+    });
+  }
+  for (Thread& thread : threads) thread.join();
+
+  SPIEL_CHECK_EQ(counter.Value(), kNumThreads * kNumValues);
+  BasicStats basic = stats.Snapshot();
+  SPIEL_CHECK_EQ(basic.Num(), kNumThreads * kNumValues);
+  SPIEL_CHECK_EQ(basic.Min(), 1);
+  SPIEL_CHECK_EQ(basic.Max(), kNumValues);
+  SPIEL_CHECK_FLOAT_EQ(basic.Avg(), (kNumValues + 1) / 2.0);
+  LatencyHistogram latencies = hist.Snapshot();
+  SPIEL_CHECK_EQ(latencies.Num(), kNumThreads * kNumValues);
+  SPIEL_CHECK_EQ(latencies.Min(), 1);
+  SPIEL_CHECK_EQ(latencies.Max(), kNumValues);
+  SPIEL_CHECK_GE(latencies.Percentile(0.5), kNumValues / 2);
+  SPIEL_CHECK_LE(latencies.Percentile(0.5), kNumValues / 2 * 1.04);
+
+  {
+    ScopedLatencyTimer timer(&hist);
+  }
+  SPIEL_CHECK_EQ(hist.Snapshot().Num(), kNumThreads * kNumValues + 1);
+
+  counter.Reset();
+  stats.Reset();
+  hist.Reset();
+  SPIEL_CHECK_EQ(counter.Value(), 0);
+  SPIEL_CHECK_EQ(stats.Snapshot().Num(), 0);
+  SPIEL_CHECK_EQ(hist.Snapshot().Num(), 0);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
@@ -113,4 +206,6 @@ int main(int argc, char** argv) {
   open_spiel::TestBasicStats();
   open_spiel::TestHistogramNumbered();
   open_spiel::TestHistogramNamed();
+  open_spiel::TestLatencyHistogram();
+  open_spiel::TestConcurrentStats();
 }
@@ -0,0 +1,220 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/tcp.h"
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel::tcp {
+
+std::pair<std::string, int> ParseAddress(const std::string& address) {
+  const size_t colon = address.rfind(':');
+  int port;
+  if (colon == std::string::npos ||
+      !absl::SimpleAtoi(address.substr(colon + 1), &port)) {
+    SpielFatalError(absl::StrCat("Expected host:port, got ", address));
+  }
+  return {address.substr(0, colon), port};
+}
+
+std::unique_ptr<Connection> Connection::Connect(const std::string& address,
+                                                absl::Duration timeout) {
+  const auto [host, port] = ParseAddress(address);
+  const absl::Time deadline = absl::Now() + timeout;
+  while (true) {
+    if (std::unique_ptr<Connection> connection = Connect(host, port)) {
+      return connection;
+    }
+    if (absl::Now() > deadline) {
+      SpielFatalError(absl::StrCat("Failed to connect to ", address));
+    }
+    absl::SleepFor(absl::Milliseconds(100));
+  }
+}
+
+#ifndef _WIN32
+
+namespace {
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // Linux only: elsewhere, ignore SIGPIPE instead.
+#endif
+
+constexpr int kHeaderSize = 8;
+
+void EncodeLength(uint64_t length, char* out) {
+  for (int i = 0; i < kHeaderSize; ++i) out[i] = (length >> (8 * i)) & 0xff;
+}
+
+uint64_t DecodeLength(const char* in) {
+  uint64_t length = 0;
+  for (int i = 0; i < kHeaderSize; ++i) {
+    length |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+  }
+  return length;
+}
+
+}  // namespace
+
+std::unique_ptr<Connection> Connection::Connect(const std::string& host,
+                                                int port) {
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* addresses = nullptr;
+  if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints,
+                  &addresses) != 0) {
+    return nullptr;
+  }
+  int fd = -1;
+  for (addrinfo* address = addresses; address != nullptr;
+       address = address->ai_next) {
+    fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (fd < 0) continue;
+    if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(addresses);
+  if (fd < 0) return nullptr;
+  // Requests are small and wait for their reply.
+  const int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return std::make_unique<Connection>(fd);
+}
+
+Connection::~Connection() { close(fd_); }
+
+void Connection::Shutdown() { shutdown(fd_, SHUT_RDWR); }
+
+bool Connection::SendAll(const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t sent = send(fd_, data, size, MSG_NOSIGNAL);
+    if (sent <= 0) return false;
+    data += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+bool Connection::ReceiveAll(char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t received = recv(fd_, data, size, 0);
+    if (received <= 0) return false;
+    data += received;
+    size -= received;
+  }
+  return true;
+}
+
+bool Connection::Send(absl::string_view message) {
+  char header[kHeaderSize];
+  EncodeLength(message.size(), header);
+  return SendAll(header, kHeaderSize) &&
+         SendAll(message.data(), message.size());
+}
+
+std::optional<std::string> Connection::Receive() {
+  char header[kHeaderSize];
+  if (!ReceiveAll(header, kHeaderSize)) return std::nullopt;
+  std::string message(DecodeLength(header), '\0');
+  if (!ReceiveAll(message.data(), message.size())) return std::nullopt;
+  return message;
+}
+
+std::optional<std::string> Connection::Call(absl::string_view message) {
+  if (!Send(message)) return std::nullopt;
+  return Receive();
+}
+
+Listener::Listener(int port) {
+  fd_ = socket(AF_INET6, SOCK_STREAM, 0);
+  SPIEL_CHECK_GE(fd_, 0);
+  const int one = 1;
+  setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  // Accept IPv4 connections too.
+  const int zero = 0;
+  setsockopt(fd_, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+  sockaddr_in6 address = {};
+  address.sin6_family = AF_INET6;
+  address.sin6_addr = in6addr_any;
+  address.sin6_port = htons(port);
+  if (bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) !=
+          0 ||
+      listen(fd_, SOMAXCONN) != 0) {
+    SpielFatalError(absl::StrCat("Failed to listen on port ", port));
+  }
+  socklen_t length = sizeof(address);
+  getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+  port_ = ntohs(address.sin6_port);
+}
+
+Listener::~Listener() { close(fd_); }
+
+void Listener::Shutdown() { shutdown(fd_, SHUT_RDWR); }
+
+std::unique_ptr<Connection> Listener::Accept() {
+  const int fd = accept(fd_, nullptr, nullptr);
+  if (fd < 0) return nullptr;
+  const int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return std::make_unique<Connection>(fd);
+}
+
+#else  // _WIN32
+
+std::unique_ptr<Connection> Connection::Connect(const std::string& host,
+                                                int port) {
+  return nullptr;
+}
+Connection::~Connection() {}
+void Connection::Shutdown() {}
+bool Connection::SendAll(const char* data, size_t size) { return false; }
+bool Connection::ReceiveAll(char* data, size_t size) { return false; }
+bool Connection::Send(absl::string_view message) { return false; }
+std::optional<std::string> Connection::Receive() { return std::nullopt; }
+std::optional<std::string> Connection::Call(absl::string_view message) {
+  return std::nullopt;
+}
+
+Listener::Listener(int port) : fd_(-1), port_(port) {
+  SpielFatalError("TCP listeners are not supported on this platform.");
+}
+Listener::~Listener() {}
+void Listener::Shutdown() {}
+std::unique_ptr<Connection> Listener::Accept() { return nullptr; }
+
+#endif  // _WIN32
+
+}  // namespace open_spiel::tcp
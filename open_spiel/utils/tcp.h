@@ -0,0 +1,148 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_TCP_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_TCP_H_
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/string_view.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/abseil-cpp/absl/types/span.h"
+#include "open_spiel/spiel_utils.h"
+
+// Blocking TCP connections exchanging whole messages, to spread work like
+// self-play over several machines. Each message is sent as its length, as a
+// 64-bit little-endian integer, followed by its bytes. Only supported on
+// POSIX systems: elsewhere, connecting and listening fail.
+
+namespace open_spiel::tcp {
+
+class Connection {
+ public:
+  // Connects to host:port, or returns nullptr.
+  static std::unique_ptr<Connection> Connect(const std::string& host,
+                                             int port);
+
+  // Connects to "host:port", retrying until `timeout`, e.g. for a server to
+  // start, or fails.
+  static std::unique_ptr<Connection> Connect(const std::string& address,
+                                             absl::Duration timeout);
+
+  explicit Connection(int fd) : fd_(fd) {}
+  ~Connection();  // Closes the connection.
+
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+
+  // Returns false if the connection is closed.
+  bool Send(absl::string_view message);
+
+  // Returns the next message, or nothing once the connection is closed.
+  std::optional<std::string> Receive();
+
+  // Sends a message and returns the reply, for request/reply protocols.
+  std::optional<std::string> Call(absl::string_view message);
+
+  // Makes pending and future Sends and Receives fail, from any thread.
+  void Shutdown();
+
+ private:
+  bool SendAll(const char* data, size_t size);
+  bool ReceiveAll(char* data, size_t size);
+
+  const int fd_;
+};
+
+class Listener {
+ public:
+  // Listens on `port` of all interfaces, or on a free port if 0. Fails if the
+  // port cannot be bound.
+  explicit Listener(int port);
+  ~Listener();
+
+  Listener(const Listener&) = delete;
+  Listener& operator=(const Listener&) = delete;
+
+  // The port listened on.
+  int Port() const { return port_; }
+
+  // Waits for the next connection, or returns nullptr once shut down.
+  std::unique_ptr<Connection> Accept();
+
+  // Makes pending and future Accepts fail, from any thread.
+  void Shutdown();
+
+ private:
+  int fd_;
+  int port_;
+};
+
+// Splits "host:port", or fails.
+std::pair<std::string, int> ParseAddress(const std::string& address);
+
+// Writing and reading numbers and arrays of them in native byte order, to
+// encode messages between machines of the same architecture.
+template <typename T>
+void Append(T value, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void AppendArray(absl::Span<const T> values, std::string* out) {
+  out->append(reinterpret_cast<const char*>(values.data()),
+              values.size() * sizeof(T));
+}
+
+// Reads what Append and AppendArray wrote, failing past the end.
+class Reader {
+ public:
+  explicit Reader(absl::string_view data) : data_(data) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    ReadArray(absl::MakeSpan(&value, 1));
+    return value;
+  }
+
+  template <typename T>
+  void ReadArray(absl::Span<T> values) {
+    const size_t size = values.size() * sizeof(T);
+    SPIEL_CHECK_LE(size, data_.size());
+    std::memcpy(values.data(), data_.data(), size);
+    data_.remove_prefix(size);
+  }
+
+  // Returns the next `size` bytes.
+  absl::string_view ReadBytes(size_t size) {
+    SPIEL_CHECK_LE(size, data_.size());
+    absl::string_view bytes = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return bytes;
+  }
+
+  absl::string_view Rest() const { return data_; }
+
+ private:
+  absl::string_view data_;
+};
+
+}  // namespace open_spiel::tcp
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_TCP_H_
@@ -0,0 +1,68 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/tcp.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel::tcp {
+namespace {
+
+void EchoesMessages() {
+  Listener listener(0);
+  SPIEL_CHECK_GT(listener.Port(), 0);
+  Thread server([&listener]() {
+    std::unique_ptr<Connection> connection = listener.Accept();
+    SPIEL_CHECK_TRUE(connection != nullptr);
+    while (std::optional<std::string> message = connection->Receive()) {
+      SPIEL_CHECK_TRUE(connection->Send(*message));
+    }
+  });
+
+  std::unique_ptr<Connection> client =
+      Connection::Connect("localhost", listener.Port());
+  SPIEL_CHECK_TRUE(client != nullptr);
+  SPIEL_CHECK_EQ(*client->Call("hello"), "hello");
+  SPIEL_CHECK_EQ(*client->Call(""), "");
+  // Larger than the socket buffers, and with every byte value.
+  std::string large(3 << 20, '\0');
+  for (int i = 0; i < large.size(); ++i) large[i] = i % 256;
+  SPIEL_CHECK_TRUE(*client->Call(large) == large);
+  client.reset();
+  server.join();
+}
+
+void ShutsDown() {
+  Listener listener(0);
+  Thread server([&listener]() {
+    SPIEL_CHECK_TRUE(listener.Accept() == nullptr);
+  });
+  listener.Shutdown();
+  server.join();
+  SPIEL_CHECK_TRUE(Connection::Connect("localhost", listener.Port()) ==
+                   nullptr);
+}
+
+}  // namespace
+}  // namespace open_spiel::tcp
+
+int main(int argc, char** argv) {
+  open_spiel::tcp::EchoesMessages();
+  open_spiel::tcp::ShutsDown();
+}
@@ -17,6 +17,7 @@
 #include <array>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/types/span.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
@@ -134,7 +135,30 @@ void TestTensorView() {
   }
 }
 
+void TestTensorViewOfSpan() {
+  // Views the second row of a batch, leaving the other rows alone.
+  std::vector<float> batch(3 * 6, -1.0f);
+  absl::Span<float> row = absl::MakeSpan(batch).subspan(6, 6);
+
+  TensorView<2, float> view(row, {2, 3}, true);
+  SPIEL_CHECK_EQ(view.size(), 6);
+  for (int i = 0; i < batch.size(); ++i) {
+    SPIEL_CHECK_EQ(batch[i], i >= 6 && i < 12 ? 0.0f : -1.0f);
+  }
+
+  view[{1, 2}] = 5.0f;
+  SPIEL_CHECK_EQ(batch[6 + 5], 5.0f);
+  SPIEL_CHECK_EQ((view[{1, 2}]), 5.0f);
+
+  // Keeps the previous values.
+  TensorView<1, float> view_keep(row, {6}, false);
+  SPIEL_CHECK_EQ(view_keep[{5}], 5.0f);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::TestTensorView(); }
+int main(int argc, char** argv) {
+  open_spiel::TestTensorView();
+  open_spiel::TestTensorViewOfSpan();
+}
@@ -0,0 +1,214 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/thread_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>  // NOLINT
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "open_spiel/abseil-cpp/absl/time/clock.h"
+#include "open_spiel/abseil-cpp/absl/time/time.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+// The pool and index of the worker running on this thread, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+int NumHardwareThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void PinToCpu(int cpu) {
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads)
+    : ThreadPool(ThreadPoolOptions{num_threads}) {}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) {
+  SPIEL_CHECK_GE(options.num_threads, 0);
+  int num_threads =
+      options.num_threads > 0 ? options.num_threads : NumHardwareThreads();
+  for (int i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  // The queues are all created first, as workers steal from each other.
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this, i, options]() { WorkerLoop(i, options); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mu_);
+    stop_ = true;
+    wake_.SignalAll();
+  }
+  for (Thread& thread : threads_) thread.join();
+}
+
+ThreadPool& ThreadPool::Default() {
+  static ThreadPool* pool = new ThreadPool(ThreadPoolOptions());
+  return *pool;
+}
+
+int ThreadPool::CurrentWorker() const {
+  return current_pool == this ? current_worker : NumThreads();
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  int worker = CurrentWorker();
+  if (worker == NumThreads()) {
+    worker = static_cast<unsigned>(next_queue_.fetch_add(
+                 1, std::memory_order_relaxed)) % NumThreads();
+  }
+  {
+    WorkQueue& queue = *queues_[worker];
+    absl::MutexLock lock(&queue.mu);
+    queue.tasks.push_back(std::move(task));
+  }
+  // Sleeping workers count themselves idle before checking for tasks, so
+  // either they see this task or it sees them.
+  num_pending_.fetch_add(1);
+  if (num_idle_.load() > 0) {
+    absl::MutexLock lock(&mu_);
+    wake_.Signal();
+  }
+}
+
+bool ThreadPool::TryGetTask(int worker, std::function<void()>* task) {
+  const int num_threads = NumThreads();
+  if (worker < num_threads) {
+    WorkQueue& queue = *queues_[worker];
+    absl::MutexLock lock(&queue.mu);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      num_pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  for (int i = 1; i <= num_threads; ++i) {
+    WorkQueue& queue = *queues_[(worker + i) % num_threads];
+    absl::MutexLock lock(&queue.mu);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      num_pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::RunPendingTask() {
+  if (num_pending_.load(std::memory_order_relaxed) <= 0) return false;
+  std::function<void()> task;
+  if (!TryGetTask(CurrentWorker(), &task)) return false;
+  task();
+  return true;
+}
+
+void ThreadPool::WorkerLoop(int worker, const ThreadPoolOptions& options) {
+  current_pool = this;
+  current_worker = worker;
+  if (options.pin_threads) {
+    PinToCpu((options.first_cpu + worker) % NumHardwareThreads());
+  }
+  std::function<void()> task;
+  while (true) {
+    if (TryGetTask(worker, &task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    absl::MutexLock lock(&mu_);
+    num_idle_.fetch_add(1);
+    while (num_pending_.load() <= 0 && !stop_) wake_.Wait(&mu_);
+    num_idle_.fetch_sub(1);
+    if (stop_ && num_pending_.load() <= 0) return;
+  }
+}
+
+void ThreadPool::ParallelFor(int begin, int end,
+                             const std::function<void(int)>& fn,
+                             int grain_size, int max_threads) {
+  if (begin >= end) return;
+  grain_size = std::max(grain_size, 1);
+  const int64_t num_chunks =
+      (static_cast<int64_t>(end) - begin + grain_size - 1) / grain_size;
+
+  // Every thread takes the next chunk until there are none left, so the
+  // chunks balance themselves between threads.
+  std::atomic<int64_t> next{begin};
+  auto run_chunks = [&]() {
+    while (true) {
+      const int64_t start = next.fetch_add(grain_size);
+      if (start >= end) return;
+      const int stop = std::min<int64_t>(start + grain_size, end);
+      for (int i = start; i < stop; ++i) fn(i);
+    }
+  };
+  TaskGroup group(this);
+  int num_helpers = std::min<int64_t>(NumThreads(), num_chunks - 1);
+  if (max_threads > 0) num_helpers = std::min(num_helpers, max_threads - 1);
+  for (int i = 0; i < num_helpers; ++i) group.Run(run_chunks);
+  run_chunks();
+  group.Wait();
+}
+
+void TaskGroup::Run(std::function<void()> task) {
+  num_pending_.fetch_add(1, std::memory_order_relaxed);
+  pool_->Schedule([this, task = std::move(task)]() mutable {
+    task();
+    task = nullptr;
+    // The group may be destroyed as soon as this reaches zero.
+    num_pending_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+}
+
+void TaskGroup::Wait() {
+  int num_waits = 0;
+  absl::Duration sleep = absl::Microseconds(1);
+  while (num_pending_.load(std::memory_order_acquire) > 0) {
+    if (pool_->RunPendingTask()) {
+      num_waits = 0;
+      sleep = absl::Microseconds(1);
+    } else if (++num_waits <= 64) {
+      std::this_thread::yield();
+    } else {
+      absl::SleepFor(sleep);
+      sleep = std::min(sleep * 2, absl::Microseconds(100));
+    }
+  }
+}
+
+}  // namespace open_spiel
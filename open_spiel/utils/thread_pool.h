@@ -0,0 +1,155 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_UTILS_THREAD_POOL_H_
+#define THIRD_PARTY_OPEN_SPIEL_UTILS_THREAD_POOL_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/abseil-cpp/absl/synchronization/mutex.h"
+#include "open_spiel/utils/thread.h"
+
+namespace open_spiel {
+
+struct ThreadPoolOptions {
+  // The number of worker threads, or 0 for one per hardware thread.
+  int num_threads = 0;
+
+  // Whether to pin worker i to CPU (first_cpu + i) modulo the number of
+  // hardware threads. Only supported on Linux, and ignored elsewhere.
+  bool pin_threads = false;
+  int first_cpu = 0;
+};
+
+// A work-stealing thread pool, to be shared by the parallel parts of the
+// library rather than each starting their own threads.
+//
+// Each worker has its own task queue. Tasks scheduled from a worker go to the
+// back of its queue and it runs its newest task first, which keeps recursive
+// work local, while idle workers steal the oldest tasks from the others.
+// Threads waiting for tasks, in ParallelFor or TaskGroup::Wait, run queued
+// tasks in the meantime, so these can be nested without deadlocking.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  explicit ThreadPool(const ThreadPoolOptions& options);
+
+  // Runs all the scheduled tasks before returning.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // A pool with one worker per hardware thread, created on first use and
+  // never destroyed.
+  static ThreadPool& Default();
+
+  int NumThreads() const { return queues_.size(); }
+
+  // The index of the calling thread in [0, NumThreads()) if it is one of the
+  // workers, otherwise NumThreads().
+  int CurrentWorker() const;
+
+  // Runs the task on some worker at some point. Use a TaskGroup to wait for
+  // it.
+  void Schedule(std::function<void()> task);
+
+  // Runs fn(i) for each i in [begin, end) in parallel, including on the
+  // calling thread, and returns once all have finished. Indices are handed
+  // out in chunks of grain_size, so fn can be cheap. A positive max_threads
+  // caps the number of threads running fn at once, including the calling
+  // one, e.g. for the functions taking a number of threads; 1 runs them all
+  // on the calling thread.
+  void ParallelFor(int begin, int end, const std::function<void(int)>& fn,
+                   int grain_size = 1, int max_threads = 0);
+
+  // Runs a single queued task on the calling thread, if there is one.
+  bool RunPendingTask();
+
+ private:
+  struct alignas(64) WorkQueue {
+    absl::Mutex mu;
+    std::deque<std::function<void()>> tasks ABSL_GUARDED_BY(mu);
+  };
+
+  void WorkerLoop(int worker, const ThreadPoolOptions& options);
+  bool TryGetTask(int worker, std::function<void()>* task);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<Thread> threads_;
+  std::atomic<int> next_queue_{0};
+
+  // The number of tasks in the queues, and the workers waiting for some.
+  std::atomic<int> num_pending_{0};
+  std::atomic<int> num_idle_{0};
+  absl::Mutex mu_;
+  absl::CondVar wake_ ABSL_GUARDED_BY(mu_);
+  bool stop_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+// Tasks that can be waited for together. The tasks may themselves add more
+// tasks to the group.
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool* pool) : pool_(pool) {}
+
+  // Waits for the tasks.
+  ~TaskGroup() { Wait(); }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void Run(std::function<void()> task);
+
+  // Returns once all the tasks have finished, running queued tasks from the
+  // pool in the meantime.
+  void Wait();
+
+ private:
+  ThreadPool* pool_;
+  std::atomic<int> num_pending_{0};
+};
+
+// A value per worker of a pool, plus one shared by the threads outside it,
+// for scratch space that tasks can use without synchronization. Values are
+// on separate cache lines. Local() is only safe to use from outside the pool
+// on one thread at a time.
+template <class T>
+class PerWorker {
+ public:
+  explicit PerWorker(const ThreadPool* pool, const T& value = T())
+      : pool_(pool), slots_(pool->NumThreads() + 1, Slot{value}) {}
+
+  T& Local() { return slots_[pool_->CurrentWorker()].value; }
+
+  int Size() const { return slots_.size(); }
+  T& operator[](int i) { return slots_[i].value; }
+  const T& operator[](int i) const { return slots_[i].value; }
+
+ private:
+  struct alignas(64) Slot {
+    T value;
+  };
+
+  const ThreadPool* pool_;
+  std::vector<Slot> slots_;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_UTILS_THREAD_POOL_H_
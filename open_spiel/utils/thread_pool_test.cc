@@ -0,0 +1,120 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/utils/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+void TestParallelFor() {
+  ThreadPool pool(4);
+  SPIEL_CHECK_EQ(pool.NumThreads(), 4);
+  SPIEL_CHECK_EQ(pool.CurrentWorker(), 4);
+
+  for (int grain_size : {1, 7, 1000}) {
+    std::vector<int> count(1000, 0);
+    pool.ParallelFor(0, count.size(), [&](int i) { ++count[i]; }, grain_size);
+    for (int n : count) SPIEL_CHECK_EQ(n, 1);
+  }
+
+  // Empty ranges do nothing.
+  pool.ParallelFor(5, 5, [](int i) { SpielFatalError("Unexpected call"); });
+
+  // At most max_threads threads run at once, only the calling one for 1.
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  pool.ParallelFor(
+      0, 1000,
+      [&](int i) {
+        const int now = ++running;
+        int seen = max_running.load();
+        while (now > seen && !max_running.compare_exchange_weak(seen, now)) {
+        }
+        --running;
+      },
+      /*grain_size=*/1, /*max_threads=*/2);
+  SPIEL_CHECK_LE(max_running.load(), 2);
+  pool.ParallelFor(
+      0, 100, [&](int i) { SPIEL_CHECK_EQ(pool.CurrentWorker(), 4); },
+      /*grain_size=*/1, /*max_threads=*/1);
+}
+
+void TestNestedParallelFor() {
+  ThreadPool pool(2);
+  std::atomic<int> sum{0};
+  pool.ParallelFor(0, 10, [&](int i) {
+    pool.ParallelFor(0, 10, [&](int j) { sum += i * 10 + j; });
+  });
+  SPIEL_CHECK_EQ(sum.load(), 99 * 100 / 2);
+}
+
+int Fibonacci(ThreadPool* pool, int n) {
+  if (n < 2) return n;
+  int a, b;
+  TaskGroup group(pool);
+  group.Run([&]() { a = Fibonacci(pool, n - 1); });
+  b = Fibonacci(pool, n - 2);
+  group.Wait();
+  return a + b;
+}
+
+void TestTaskGroup() {
+  ThreadPool pool(3);
+  SPIEL_CHECK_EQ(Fibonacci(&pool, 20), 6765);
+
+  std::atomic<int> count{0};
+  {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 100; ++i) group.Run([&]() { ++count; });
+  }
+  SPIEL_CHECK_EQ(count.load(), 100);
+}
+
+void TestPerWorker() {
+  ThreadPool pool(ThreadPoolOptions{/*num_threads=*/3, /*pin_threads=*/true});
+  PerWorker<std::vector<int>> scratch(&pool);
+  SPIEL_CHECK_EQ(scratch.Size(), 4);
+  pool.ParallelFor(0, 1000, [&](int i) {
+    SPIEL_CHECK_LE(pool.CurrentWorker(), 3);
+    scratch.Local().push_back(i);
+  });
+  int total = 0;
+  for (int w = 0; w < scratch.Size(); ++w) total += scratch[w].size();
+  SPIEL_CHECK_EQ(total, 1000);
+}
+
+void TestScheduleBeforeDestruction() {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool(2);
+    for (int i = 0; i < 100; ++i) pool.Schedule([&]() { ++count; });
+  }
+  SPIEL_CHECK_EQ(count.load(), 100);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::TestParallelFor();
+  open_spiel::TestNestedParallelFor();
+  open_spiel::TestTaskGroup();
+  open_spiel::TestPerWorker();
+  open_spiel::TestScheduleBeforeDestruction();
+}